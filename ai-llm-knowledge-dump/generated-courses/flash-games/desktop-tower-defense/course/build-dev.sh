@@ -2,14 +2,16 @@
 # build-dev.sh  —  Desktop Tower Defense | Developer Build Script
 #
 # This is a DEV build script — it ALWAYS builds with debug flags.
-# Output is ALWAYS: ./build/game
+# Output is ./build/game (./build/<name> for the bench backends).
 # There is no release mode here; use a separate build-release.sh for that.
 #
 # Usage:
-#   ./build-dev.sh [--backend=x11|raylib] [-r] [-d]
+#   ./build-dev.sh [--backend=x11|raylib|audio-bench|render-bench] [-r] [-d]
 #
 #   --backend=raylib  Build the Raylib backend (default)
 #   --backend=x11     Build the X11 backend
+#   --backend=audio-bench  Headless mixer benchmark (src/audio_bench.c), -O2
+#   --backend=render-bench Headless draw benchmark (src/render_bench.c), -O2
 #   -r / --run        Run the game after a successful build
 #   -d / --debug-asan Enable AddressSanitizer + UBSan (off by default)
 #
@@ -19,6 +21,9 @@
 #   ./build-dev.sh -d                    # Raylib, debug + sanitizers
 #   ./build-dev.sh --backend=x11 -r      # X11,    debug, then run
 #   ./build-dev.sh --backend=x11 -d -r   # X11,    debug + sanitizers, then run
+#
+# The game itself takes --session FILE: resume the session saved there and
+# save it back on quit (./build/game --session soak.dtd).
 
 set -e  # exit immediately on any error
 
@@ -36,11 +41,13 @@ for arg in "$@"; do
     case "$arg" in
         --backend=x11)    BACKEND="x11"    ;;
         --backend=raylib) BACKEND="raylib" ;;
+        --backend=audio-bench) BACKEND="audio-bench" ;;
+        --backend=render-bench) BACKEND="render-bench" ;;
         -r|--run)         RUN_AFTER_BUILD=1 ;;
         -d|--debug-asan)  DEBUG_ASAN=1 ;;
         *)
             echo "Unknown argument: $arg"
-            echo "Usage: $0 [--backend=x11|raylib] [-r] [-d]"
+            echo "Usage: $0 [--backend=x11|raylib|audio-bench|render-bench] [-r] [-d]"
             exit 1
         ;;
     esac
@@ -67,7 +74,8 @@ fi
 #                  ASan:  buffer overflows, use-after-free, double-free
 #                  UBSan: signed overflow, null deref, misaligned access
 # -Wall -Wextra  : catch common mistakes (uninitialized vars, wrong types)
-# -std=c99       : C99 standard (designated initializers, // comments, etc.)
+# -std=c11       : C11 standard (the engine headers the sprites and the
+#                  background loader build on use _Generic)
 if [ "$DEBUG_ASAN" = "1" ]; then
     DEBUG_FLAGS="-O0 -g -DDEBUG -fsanitize=address,undefined"
     MODE_LABEL="debug + ASan/UBSan"
@@ -75,10 +83,10 @@ else
     DEBUG_FLAGS="-O0 -g -DDEBUG"
     MODE_LABEL="debug (no sanitizers)"
 fi
-COMMON_FLAGS="-Wall -Wextra -std=c99 $DEBUG_FLAGS"
+COMMON_FLAGS="-Wall -Wextra -std=c11 $DEBUG_FLAGS"
 
 # --------------------------------------------------------------------------
-# Output directory — always build/game
+# Output directory — build/game (the bench backend renames it below)
 # --------------------------------------------------------------------------
 mkdir -p build
 OUT="build/game"
@@ -86,20 +94,44 @@ OUT="build/game"
 # --------------------------------------------------------------------------
 # Source files (shared for both backends)
 # --------------------------------------------------------------------------
-SHARED_SRCS="src/game.c src/levels.c src/audio.c src/sprites.c src/utils/draw-shapes.c src/utils/draw-text.c"
+ENGINE_DIR="../../../../../engine"
+SHARED_SRCS="src/game.c src/levels.c src/audio.c src/sprites.c src/utils/draw-shapes.c src/utils/draw-text.c src/utils/background-load.c src/utils/state-file.c"
+
+# The frame and map arenas grow their commit frontier through engine/_common;
+# streamed sprites go through the engine's asset stream (and the pack
+# reader and file mapping it links)
+SHARED_SRCS="$SHARED_SRCS $ENGINE_DIR/_common/memory.c $ENGINE_DIR/_common/file.c $ENGINE_DIR/_common/time.c $ENGINE_DIR/game/asset-stream.c $ENGINE_DIR/game/asset-pack.c"
+
+# The engine's asset watcher (the windowed backends' atlas hot reload) and
+# what else it needs from engine/_common
+WATCHER_SRCS="$ENGINE_DIR/platforms/_common/asset-watcher.c $ENGINE_DIR/_common/file-watch.c $ENGINE_DIR/_common/path.c $ENGINE_DIR/_common/log.c"
 
 # --------------------------------------------------------------------------
 # Backend-specific settings
 # --------------------------------------------------------------------------
 if [ "$BACKEND" = "x11" ]; then
-    SRCS="src/main_x11.c $SHARED_SRCS"
+    SRCS="src/main_x11.c $SHARED_SRCS $WATCHER_SRCS"
     # -lX11:    Xlib window management and event handling
     # -lm:      math library (sinf, fminf, etc.)
     # -lasound: ALSA audio (procedural synthesis pushed to hardware each frame)
     LIBS="-lX11 -lm -lasound -lpthread"
     COMMON_FLAGS="$COMMON_FLAGS -DALSA_AVAILABLE"
+elif [ "$BACKEND" = "audio-bench" ]; then
+    SRCS="src/audio_bench.c $SHARED_SRCS"
+    # No window or device: times game_get_audio_samples under synthetic
+    # voice loads.  Optimised, with the voice cap raised for the big loads.
+    LIBS="-lm -lpthread"
+    COMMON_FLAGS="$COMMON_FLAGS -O2 -DMAX_SIMULTANEOUS_SOUNDS=256"
+    OUT="build/audio-bench"
+elif [ "$BACKEND" = "render-bench" ]; then
+    SRCS="src/render_bench.c $SHARED_SRCS"
+    # No window: times draw_rect/_blend, draw_text and the sprite blits
+    # over a range of buffer sizes.  Optimised.
+    LIBS="-lm -lpthread"
+    COMMON_FLAGS="$COMMON_FLAGS -O2"
+    OUT="build/render-bench"
 else
-    SRCS="src/main_raylib.c $SHARED_SRCS"
+    SRCS="src/main_raylib.c $SHARED_SRCS $WATCHER_SRCS"
     # -lraylib:  Raylib window, input, GPU texture, and audio
     # -lm:       math library
     # -lpthread: POSIX threads (Raylib uses them internally)
@@ -2,13 +2,14 @@
  *
  * All sounds are synthesized — no WAV files loaded.
  * Each SoundDef describes a tone by frequency, slide, duration, and volume.
- * game_get_audio_samples() fills the AudioOutputBuffer using phase accumulators.
- * Click prevention: each SoundInstance has a brief fade-out envelope.
- *   (Fade-in would require storing total_duration in SoundInstance.)
+ * A SoundDef always synthesizes the same samples, so each one is rendered
+ * once per sample rate into a PCM cache; a playing SoundInstance just reads
+ * it back with its pan gains.  Only the music drone is synthesized live.
+ * Click prevention: every cached sound ends on a brief fade-out envelope.
  *
  * Synthesis rules:
  *   • Sine wave for all SFX — smooth, no harmonic aliasing.
- *   • Trapezoidal envelope: 4 ms fade-out on every sound instance.
+ *   • Trapezoidal envelope: 4 ms fade-out baked into every cached SFX.
  *   • Background music: sine-wave drone at ~110 Hz, slowly frequency-drifting.
  *   • Phase accumulators NEVER reset between calls — discontinuity = click.
  *
@@ -49,6 +50,77 @@ static const SoundDef SOUND_DEFS[SFX_COUNT] = {
     /* SFX_TOWER_UPGRADE      */ { 880.0f, 1200.0f, 100.0f,  0.35f },/* rising tone */
 };
 
+/* =========================================================================
+ * Sound cache  —  pre-rendered SFX
+ * =========================================================================
+ * Static and shared by every GameAudioState.  Rendered for one sample rate
+ * at a time: a different output rate drops the entries and re-renders them
+ * on demand.  Sized for 96 kHz; the defs add up to 3.27 s.
+ */
+#define SOUND_CACHE_MAX_SAMPLES 320000
+
+typedef struct {
+    int offset; /* into the pool */
+    int length; /* 0 = not rendered yet */
+} SoundCacheEntry;
+
+static struct {
+    float           samples[SOUND_CACHE_MAX_SAMPLES];
+    SoundCacheEntry entries[SFX_COUNT];
+    int             samples_per_second; /* rate the entries were rendered at */
+    int             used;
+} g_sound_cache;
+
+/* Sine with a linear frequency slide and a 4 ms fade-out, volume baked in */
+static void sound_render(const SoundDef *def, int samples_per_second,
+                         float *out, int total_samples) {
+    float inv_sample_rate = 1.0f / (float)samples_per_second;
+    float fade_samples    = 0.004f * (float)samples_per_second; /* 4 ms */
+    float phase           = 0.0f;
+    float frequency       = def->frequency;
+
+    /* Linear frequency slide: Hz/sample from start to end over full duration */
+    float frequency_slide = 0.0f;
+    if (def->frequency_end > 0.0f)
+        frequency_slide = (def->frequency_end - def->frequency) / (float)total_samples;
+
+    for (int i = 0; i < total_samples; ++i) {
+        float remaining = (float)(total_samples - i);
+        float envelope  = remaining < fade_samples ? remaining / fade_samples : 1.0f;
+
+        out[i] = sinf(phase * 2.0f * 3.14159f) * def->volume * envelope;
+
+        phase += frequency * inv_sample_rate;
+        if (phase >= 1.0f) phase -= 1.0f;
+        frequency += frequency_slide;
+    }
+}
+
+/* Rendered samples of `id`; NULL if the pool is full */
+static const float *sound_cache_get(SfxId id, int samples_per_second, int *length) {
+    if (g_sound_cache.samples_per_second != samples_per_second) {
+        memset(g_sound_cache.entries, 0, sizeof(g_sound_cache.entries));
+        g_sound_cache.samples_per_second = samples_per_second;
+        g_sound_cache.used               = 0;
+    }
+
+    SoundCacheEntry *entry = &g_sound_cache.entries[id];
+    if (entry->length == 0) {
+        const SoundDef *def = &SOUND_DEFS[id];
+        int total = (int)ceilf(def->duration_ms * (float)samples_per_second / 1000.0f);
+        if (total <= 0 || g_sound_cache.used + total > SOUND_CACHE_MAX_SAMPLES)
+            return NULL;
+        entry->offset = g_sound_cache.used;
+        entry->length = total;
+        g_sound_cache.used += total;
+        sound_render(def, samples_per_second,
+                     g_sound_cache.samples + entry->offset, total);
+    }
+
+    *length = entry->length;
+    return g_sound_cache.samples + entry->offset;
+}
+
 /* =========================================================================
  * game_audio_init  —  called once at startup
  * =========================================================================
@@ -67,14 +139,21 @@ void game_audio_init(GameAudioState *audio) {
     audio->music_tone.target_volume = 0.3f;
     audio->music_tone.is_playing    = 1;
     /* current_volume starts at 0 and ramps up via game_audio_update() */
+
+    /* Render the effects now, not on their first play */
+    for (int id = 0; id < SFX_COUNT; ++id) {
+        int length;
+        sound_cache_get((SfxId)id, AUDIO_SAMPLE_RATE, &length);
+    }
 }
 
 /* =========================================================================
  * game_play_sound / game_play_sound_at
  * =========================================================================
- * Trigger a one-shot SFX.  Finds a free slot in active_sounds[] and
- * initialises it from SOUND_DEFS[id].  If all slots are occupied the new
- * sound is dropped silently — brief SFX loss is preferable to eviction glitches.
+ * Trigger a one-shot SFX.  Finds a free slot in active_sounds[] and points
+ * it at the start of the effect's cached PCM; volume and pan are folded into
+ * two gains here, once.  If all slots are occupied the new sound is dropped
+ * silently — brief SFX loss is preferable to eviction glitches.
  */
 void game_play_sound(GameAudioState *audio, SfxId id) {
     game_play_sound_at(audio, id, 0.0f);
@@ -90,24 +169,18 @@ void game_play_sound_at(GameAudioState *audio, SfxId id, float pan) {
     }
     if (slot < 0) return; /* pool full — drop new sound silently */
 
-    const SoundDef *def = &SOUND_DEFS[id];
-    SoundInstance  *s   = &audio->active_sounds[slot];
+    SoundInstance *s    = &audio->active_sounds[slot];
+    float          gain = audio->sfx_volume * audio->master_volume;
 
-    s->phase          = 0.0f;
-    s->frequency      = def->frequency;
-    s->time_remaining = def->duration_ms / 1000.0f;
-    s->volume         = def->volume * audio->sfx_volume * audio->master_volume;
-    s->pan_position   = pan;
-    s->active         = 1;
+    /* Linear stereo panning: -1 = full left, 0 = center, +1 = full right */
+    pan = CLAMP(pan, -1.0f, 1.0f);
 
-    /* Linear frequency slide: Hz/sample from start to end over full duration */
-    if (def->frequency_end > 0.0f) {
-        float duration_secs  = def->duration_ms / 1000.0f;
-        float total_samples  = duration_secs * (float)AUDIO_SAMPLE_RATE;
-        s->frequency_slide   = (def->frequency_end - def->frequency) / total_samples;
-    } else {
-        s->frequency_slide = 0.0f;
-    }
+    s->sfx_id       = (int)id;
+    s->position     = 0;
+    s->left_gain    = gain * (1.0f - MAX(0.0f,  pan));
+    s->right_gain   = gain * (1.0f - MAX(0.0f, -pan));
+    s->pan_position = pan;
+    s->active       = 1;
 }
 
 /* =========================================================================
@@ -153,9 +226,9 @@ void game_audio_update(GameAudioState *audio, float dt) {
  * Fills out->samples with interleaved stereo int16 PCM.
  * out->sample_count is the number of stereo FRAMES; each frame = 2 int16_t.
  *
- * Envelope: 4 ms fade-out at end of each SFX prevents end-of-sound clicks.
+ * SFX are reads from the sound cache, resolved once per call per voice.
  *
- * CRITICAL: phase accumulators are NEVER reset between calls.
+ * CRITICAL: the music phase accumulator is NEVER reset between calls.
  * Resetting phase mid-waveform creates a discontinuity → audible click.
  */
 void game_get_audio_samples(GameState *state, AudioOutputBuffer *out) {
@@ -165,39 +238,33 @@ void game_get_audio_samples(GameState *state, AudioOutputBuffer *out) {
     static float music_phase = 0.0f;
 
     float inv_sample_rate = 1.0f / (float)out->samples_per_second;
-    float attack_samples  = 0.004f * (float)out->samples_per_second; /* 4 ms */
+
+    /* Each voice's PCM for this call (a rate change re-renders it here) */
+    const float *pcm[MAX_SIMULTANEOUS_SOUNDS];
+    int          pcm_length[MAX_SIMULTANEOUS_SOUNDS];
+    for (int si = 0; si < MAX_SIMULTANEOUS_SOUNDS; ++si) {
+        SoundInstance *inst = &audio->active_sounds[si];
+        if (!inst->active) continue;
+        pcm[si] = sound_cache_get((SfxId)inst->sfx_id, out->samples_per_second,
+                                  &pcm_length[si]);
+        if (!pcm[si] || inst->position >= pcm_length[si]) inst->active = 0;
+    }
 
     for (int i = 0; i < out->sample_count; ++i) {
         float left  = 0.0f;
         float right = 0.0f;
 
-        /* ── Sound effects (sine wave, trapezoidal envelope) ─────────────── */
+        /* ── Sound effects (cached PCM × pan gains) ──────────────────────── */
         for (int si = 0; si < MAX_SIMULTANEOUS_SOUNDS; ++si) {
             SoundInstance *inst = &audio->active_sounds[si];
             if (!inst->active) continue;
 
-            /* Fade-out: ramp amplitude to zero during the last 4 ms */
-            float envelope = 1.0f;
-            if (inst->time_remaining * (float)out->samples_per_second < attack_samples)
-                envelope = inst->time_remaining * (float)out->samples_per_second / attack_samples;
-
-            float sample = sinf(inst->phase * 2.0f * 3.14159f) * inst->volume * envelope;
-
-            /* Linear stereo panning: -1 = full left, 0 = center, +1 = full right */
-            float pan = CLAMP(inst->pan_position, -1.0f, 1.0f);
-            left  += sample * (1.0f - MAX(0.0f,  pan));
-            right += sample * (1.0f - MAX(0.0f, -pan));
-
-            /* Advance oscillator — NEVER reset between samples or calls */
-            inst->phase += inst->frequency * inv_sample_rate;
-            if (inst->phase >= 1.0f) inst->phase -= 1.0f;
-
-            /* Linear frequency slide toward frequency_end */
-            inst->frequency += inst->frequency_slide;
+            float sample = pcm[si][inst->position];
+            left  += sample * inst->left_gain;
+            right += sample * inst->right_gain;
 
-            /* Tick lifetime and deactivate when sound expires */
-            inst->time_remaining -= inv_sample_rate;
-            if (inst->time_remaining <= 0.0f) inst->active = 0;
+            /* Deactivate when the sound's samples run out */
+            if (++inst->position >= pcm_length[si]) inst->active = 0;
         }
 
         /* ── Background music drone (sine wave, current_volume already ramped) */
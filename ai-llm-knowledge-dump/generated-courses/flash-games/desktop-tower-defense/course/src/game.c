@@ -12,6 +12,8 @@
 #include "game.h"
 #include "utils/draw-shapes.h"
 #include "utils/draw-text.h"
+#include "../../../../../../engine/game/tilemap.h"
+#include "../../../../../../engine/game/render-cull.h"
 #include "sprites.h"
 
 /* Set USE_SPRITES to 1 to replace procedural rect/circle drawing with
@@ -20,9 +22,10 @@
 #define USE_SPRITES 0
 
 #include <math.h>    /* atan2f, cosf, sinf, sqrtf, powf */
+#include <stddef.h>  /* offsetof                        */
 #include <stdio.h>   /* snprintf                        */
 #include <stdlib.h>  /* (nothing needed at runtime)     */
-#include <string.h>  /* memset                          */
+#include <string.h>  /* memset, memcpy                  */
 
 /* =========================================================================
  * LOCAL CONSTANTS
@@ -45,6 +48,10 @@
 #define UPGRADE_BTN_H 20
 #define START_BTN_Y  (CANVAS_H - 42)
 #define START_BTN_H  36
+#define SPEED_BTN_W  50           /* fast-forward toggle, beside the title */
+#define SPEED_BTN_H  18
+#define SPEED_BTN_X  (PANEL_X + PANEL_W - SPEED_BTN_W - 4)
+#define SPEED_BTN_Y  4
 
 /* Mod-select screen layout (grid area: 0..GRID_PIXEL_W x 0..GRID_PIXEL_H) */
 #define MOD_BTN_X    30
@@ -54,21 +61,215 @@
 #define MOD_BTN_Y0   80   /* y of first mod button */
 
 /* =========================================================================
- * PSEUDO-RANDOM NUMBER GENERATOR
- * ========================================================================= */
+ * RANDOM STREAMS
+ * =========================================================================
+ *
+ * xoshiro128** (the engine's engine/game/random.h, cut down for the course).
+ * The state lives in GameState instead of a file-static, so it is part of
+ * the one struct a save / replay snapshot copies, and a restart reseeds it.
+ *
+ * Two streams from one seed:
+ *   rng_gameplay   — anything that changes the simulation (child creeps)
+ *   rng_particles  — cosmetic only (explosion sparks)
+ * Turning particles up or down can't change where creeps spawn.
+ *
+ * JS analogy: two seeded generators instead of sharing Math.random(). */
+
+#define RNG_SEED             12345u
+#define RNG_STREAM_GAMEPLAY  0u
+#define RNG_STREAM_PARTICLES 1u
+
+static uint32_t rng_rotl(uint32_t x, int k) { return (x << k) | (x >> (32 - k)); }
+
+static uint32_t rng_next(Rng *r)
+{
+    uint32_t *s     = r->s;
+    uint32_t result = rng_rotl(s[1] * 5u, 7) * 9u;
+    uint32_t t      = s[1] << 9;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3]  = rng_rotl(s[3], 11);
+    return result;
+}
+
+/* splitmix32 over (seed, stream) fills the four state words — never all 0 */
+static void rng_seed(Rng *r, uint32_t seed, uint32_t stream)
+{
+    uint32_t x = seed ^ (stream * 0x9E3779B9u);
+    for (int i = 0; i < 4; i++) {
+        uint32_t z = (x += 0x9E3779B9u);
+        z = (z ^ (z >> 16)) * 0x85EBCA6Bu;
+        z = (z ^ (z >> 13)) * 0xC2B2AE35u;
+        r->s[i] = z ^ (z >> 16);
+    }
+    if (!(r->s[0] | r->s[1] | r->s[2] | r->s[3])) r->s[0] = 1;
+}
+
+/* =========================================================================
+ * TIMER WHEEL
+ * =========================================================================
+ *
+ * See TIMER WHEEL in game.h.  A timer is filed at the level picked by the
+ * highest bit where its due tick differs from the next tick to process,
+ * so its bucket always comes up (and cascades it down) before it is due.
+ * Handles are generation << 16 | node, like CreepHandle. */
+
+static void timer_bucket_append(TimerWheel *w, int i, int level, int slot)
+{
+    TimerNode *n = &w->nodes[i];
+    n->level = (uint8_t)level;
+    n->slot  = (uint8_t)slot;
+    n->next  = TIMER_NONE;
+    n->prev  = w->tail[level][slot];
+    if (n->prev == TIMER_NONE) w->head[level][slot] = (uint16_t)i;
+    else                       w->nodes[n->prev].next = (uint16_t)i;
+    w->tail[level][slot] = (uint16_t)i;
+    w->occupied[level] |= 1ull << slot;
+}
+
+static void timer_bucket_unlink(TimerWheel *w, int i)
+{
+    TimerNode *n = &w->nodes[i];
+    if (n->prev == TIMER_NONE) w->head[n->level][n->slot] = n->next;
+    else                       w->nodes[n->prev].next = n->next;
+    if (n->next == TIMER_NONE) w->tail[n->level][n->slot] = n->prev;
+    else                       w->nodes[n->next].prev = n->prev;
+    if (w->head[n->level][n->slot] == TIMER_NONE)
+        w->occupied[n->level] &= ~(1ull << n->slot);
+}
+
+static void timer_file(TimerWheel *w, int i)
+{
+    uint32_t base = w->now + 1;
+    uint32_t due  = w->nodes[i].due;
+    if ((int32_t)(due - base) < 0) due = base;   /* overdue: next tick */
+
+    uint32_t diff = due ^ base;
+    if (diff >= TIMER_SPAN) {
+        /* Top bucket 0 only holds these; it cascades when the wheel wraps */
+        timer_bucket_append(w, i, TIMER_LEVELS - 1, 0);
+        return;
+    }
+    int level = 0;
+    while (diff >= TIMER_SLOTS) { diff >>= TIMER_SLOT_BITS; level++; }
+    timer_bucket_append(w, i, level,
+                        (int)((due >> (TIMER_SLOT_BITS * level)) & TIMER_SLOT_MASK));
+}
+
+static void timer_wheel_init(TimerWheel *w)
+{
+    memset(w, 0, sizeof(*w));
+    memset(w->head, 0xFF, sizeof(w->head));
+    memset(w->tail, 0xFF, sizeof(w->tail));
+    for (int i = 0; i < MAX_TIMERS; i++) {
+        w->nodes[i].next       = (uint16_t)(i + 1 < MAX_TIMERS ? i + 1 : (int)TIMER_NONE);
+        w->nodes[i].prev       = TIMER_NONE;
+        w->nodes[i].generation = 1;
+    }
+}
+
+/* Fire at wave tick `due` (<= now: on the next advance). */
+static TimerHandle timer_schedule(TimerWheel *w, uint32_t due, TimerKind kind,
+                                  int user)
+{
+    int i = w->free_head;
+    if (i == TIMER_NONE) { ASSERT(!"timer wheel full"); return TIMER_HANDLE_NONE; }
+    TimerNode *n = &w->nodes[i];
+    w->free_head = n->next;
+    n->due  = due;
+    n->kind = (uint16_t)kind;
+    n->user = (uint16_t)user;
+    timer_file(w, i);
+    w->count++;
+    return ((TimerHandle)n->generation << 16) | (TimerHandle)i;
+}
 
-static int s_rng = 12345;
+static void timer_release(TimerWheel *w, int i)
+{
+    TimerNode *n = &w->nodes[i];
+    n->generation = (uint16_t)(n->generation + 1);
+    if (n->generation == 0) n->generation = 1;
+    n->next = w->free_head;
+    n->prev = TIMER_NONE;
+    w->free_head = (uint16_t)i;
+    w->count--;
+}
 
-static int rng_next(void)
+/* No-op for a timer that already fired or was cancelled. */
+static void timer_cancel(TimerWheel *w, TimerHandle h)
 {
-    s_rng = s_rng * 1664525 + 1013904223;
-    return s_rng;
+    int i = (int)(h & 0xFFFFu);
+    if (h == TIMER_HANDLE_NONE || i >= MAX_TIMERS ||
+        w->nodes[i].generation != (uint16_t)(h >> 16)) return;
+    timer_bucket_unlink(w, i);
+    timer_release(w, i);
+}
+
+/* Move the wheel to tick `now`, writing due timers to out[] in tick
+ * order (FIFO within a tick).  Returns max_events when out[] filled
+ * early; call again for the rest. */
+static int timer_advance(TimerWheel *w, uint32_t now, TimerEvent *out,
+                         int max_events)
+{
+    int emitted = 0;
+    while ((int32_t)(now - w->now) > 0) {
+        uint32_t tick = w->now + 1;
+        if (w->count == 0) { w->now = now; break; }
+
+        /* Level 0 wrapped: cascade this tick's bucket of every level that
+         * wrapped too, top first.  Repeating it after an early return
+         * finds those buckets already empty. */
+        int wrapped = 0;
+        while (wrapped + 1 < TIMER_LEVELS &&
+               (tick & ((1u << (TIMER_SLOT_BITS * (wrapped + 1))) - 1)) == 0)
+            wrapped++;
+        for (int level = wrapped; level > 0; level--) {
+            int slot = (int)((tick >> (TIMER_SLOT_BITS * level)) & TIMER_SLOT_MASK);
+            if (!(w->occupied[level] & (1ull << slot))) continue;
+            int i = w->head[level][slot];
+            w->head[level][slot] = w->tail[level][slot] = TIMER_NONE;
+            w->occupied[level] &= ~(1ull << slot);
+            while (i != TIMER_NONE) {
+                int next = w->nodes[i].next;
+                timer_file(w, i);
+                i = next;
+            }
+        }
+
+        int slot = (int)(tick & TIMER_SLOT_MASK);
+        while (w->occupied[0] & (1ull << slot)) {
+            if (emitted == max_events) return emitted;
+            int i = w->head[0][slot];
+            timer_bucket_unlink(w, i);
+            out[emitted].due  = tick;
+            out[emitted].kind = (TimerKind)w->nodes[i].kind;
+            out[emitted].user = w->nodes[i].user;
+            emitted++;
+            timer_release(w, i);
+        }
+        w->now = tick;
+    }
+    return emitted;
+}
+
+/* Seconds to wave ticks, at least one (a 0-tick period would never end) */
+static uint32_t timer_ticks(float seconds)
+{
+    uint32_t t = (uint32_t)(seconds * (float)TIMER_HZ + 0.5f);
+    return t > 0 ? t : 1;
 }
 
 /* Set by game_update each frame; read by game_render to draw hover overlay.
  * Using a file-static avoids a const-cast inside the render function. */
 static int s_hover_valid = 0;
 
+/* Bumped whenever grid[], terrain[] or weather_flood[] changes; the
+ * renderer's map tiles (see MAP LAYER) are re-derived when it moves. */
+static unsigned s_map_version = 1;
+
 /* =========================================================================
  * DATA TABLES
  * ========================================================================= */
@@ -104,25 +305,33 @@ const CreepDef CREEP_DEFS[CREEP_COUNT] = {
 
 static void bfs_fill_distance(GameState *s);
 static int  can_place_tower(GameState *s, int col, int row);
+static void placement_fill_legal(GameState *s, uint8_t *legal);
+static int  cell_is_passable(const GameState *s, int idx);
+static void dist_mark_dirty(GameState *s, int idx);
+static void dist_repair(GameState *s);
 static void change_phase(GameState *s, GamePhase p);
 static int  spawn_creep(GameState *s, CreepType type, float hp_override);
+static int  creep_lookup(const CreepPool *cp, CreepHandle h);
 static void compact_creeps(GameState *s);
 static void compact_projectiles(GameState *s);
-static void compact_particles(GameState *s);
-static int  in_range(Tower *t, Creep *c);
+static int  in_range(const Tower *t, const CreepPool *cp, int i);
+static void creep_grid_rebuild(GameState *s);
+static int  creep_grid_query(GameState *s, Tower *t, int *out);
 static int  find_best_target(GameState *s, Tower *t);
 static int  effective_damage(int raw, CreepType ct, TowerType tt);
-static void spawn_projectile(GameState *s, float sx, float sy, int target_id,
+static void spawn_projectile(GameState *s, float sx, float sy, CreepHandle target,
                              int dmg, float splash_r, TowerType tt);
 static void spawn_particle(GameState *s, float x, float y, float vx, float vy,
                            float lifetime, uint32_t color, int sz, const char *text);
 static void spawn_explosion(GameState *s, float x, float y, uint32_t color, int count);
 static void kill_creep(GameState *s, int idx);
 static void apply_damage(GameState *s, int creep_idx, int dmg, TowerType tt);
-static void creep_move_toward_exit(GameState *s, Creep *c, float dt);
-static void creep_flying_move(GameState *s, Creep *c, float dt);
+static void creep_move_toward_exit(GameState *s, int i, float dt);
+static void creep_flying_move(GameState *s, int i, float dt);
 static void tower_update(GameState *s, Tower *t, float dt);
-static void projectile_update(GameState *s, Projectile *p, float dt);
+static void projectiles_home(GameState *s);
+static void projectiles_move(GameState *s, float dt);
+static void particles_update(GameState *s, float dt);
 static int  check_wave_complete(GameState *s);
 static void start_wave(GameState *s);
 static void send_wave_early(GameState *s);
@@ -161,6 +370,49 @@ static void apply_night_bonus(GameState *s, Tower *t)
     }
 }
 
+/* =========================================================================
+ * FRAME ARENAS
+ *
+ * Scratch for one frame (BFS queues, DFS stacks, query results): the
+ * engine's frame_arena / previous_frame_arena pair (engine/game/memory.h),
+ * over bytes inside GameState instead of transient storage.  The top of
+ * game_update makes the older arena current and empties it, so scratch
+ * stays valid for its frame and the next and is never freed by hand:
+ *
+ *   De100TemporaryMemory scratch = de100_arena_begin_temp(frame_arena(s));
+ *   int *queue = de100_arena_push_array(scratch.arena, N, int);
+ *   ...
+ *   de100_arena_end_temp(scratch);   // give it back within the frame
+ *
+ * The arenas are the one thing in GameState holding pointers, into its own
+ * frame_memory.  A copied or restored state still points at the bytes of
+ * the one it came from, so every rotation re-points them first.
+ * ========================================================================= */
+
+static void frame_arenas_init(GameState *s)
+{
+    for (int i = 0; i < 2; i++)
+        de100_arena_init(&s->frame_arenas[i], sizeof(s->frame_memory[i]),
+                         s->frame_memory[i]);
+    s->frame_current = 0;
+}
+
+/* engine_rotate_frame_arenas, for the pair in GameState */
+static void frame_arenas_rotate(GameState *s)
+{
+    for (int i = 0; i < 2; i++)
+        s->frame_arenas[i].base = (uint8_t *)s->frame_memory[i];
+    de100_arena_check_temps(&s->frame_arenas[s->frame_current]);
+    s->frame_current ^= 1;
+    /* No commit frontier over these bytes: resetting is popping to 0 */
+    de100_arena_pop_to(&s->frame_arenas[s->frame_current], 0);
+}
+
+static De100MemoryArena *frame_arena(GameState *s)
+{
+    return &s->frame_arenas[s->frame_current];
+}
+
 /* =========================================================================
  * BFS DISTANCE FIELD
  *
@@ -174,7 +426,9 @@ static void bfs_fill_distance(GameState *s)
     int total = GRID_ROWS * GRID_COLS;
     for (int i = 0; i < total; i++) s->dist[i] = -1;
 
-    static int queue[GRID_ROWS * GRID_COLS];
+    De100TemporaryMemory scratch = de100_arena_begin_temp(frame_arena(s));
+    int *queue = de100_arena_push_array(scratch.arena, total, int);
+    ASSERT(queue);
     int head = 0, tail = 0;
 
     int exit_idx = EXIT_ROW * GRID_COLS + EXIT_COL;
@@ -204,63 +458,293 @@ static void bfs_fill_distance(GameState *s)
             queue[tail++] = ni;
         }
     }
+    de100_arena_end_temp(scratch);
+
+    s->placement_valid = 0; /* walls changed: legality cache is stale */
+
+    /* Fresh field: nothing left to repair */
+    memset(s->dist_dirty, 0, sizeof(s->dist_dirty));
+    s->dist_dirty_count = 0;
 }
 
 /* =========================================================================
- * PLACEMENT LEGALITY  (double-BFS)
+ * INCREMENTAL DISTANCE REPAIR
+ *
+ * Tower placement/sale and weather floods flip a handful of cells; instead
+ * of a fresh full-grid BFS each time, the changed cells are queued with
+ * dist_mark_dirty() and dist_repair() (once per frame, before creeps move)
+ * fixes only the region they influence, LPA*-style:
+ *
+ *   1. Invalidate.  Newly blocked cells lose their distance.  Walking
+ *      outward level by level, a cell at distance d keeps its value if some
+ *      passable, still-valid neighbour sits at d-1 (it still has a parent);
+ *      otherwise it is invalidated and its d+1 children are checked next.
+ *   2. Relax.  Invalidated and newly freed cells are seeded from their
+ *      valid neighbours and a BFS pushes any improvement outward, also
+ *      lowering cells a freed cell now gives a shortcut to.
  *
- * Temporarily places the tower, runs a forward BFS from entry to exit, then
- * restores the cell.  Returns 1 only if the exit is still reachable.
- * NOTE: temporarily mutates s->grid[] but always restores it.
+ * Both sweeps pop cells in distance order by merging a sorted seed list
+ * with a FIFO (whose keys only grow), so every cell is settled once.
+ * The result is identical to bfs_fill_distance().
  * ========================================================================= */
 
-static int can_place_tower(GameState *s, int col, int row)
+typedef struct { int cell, key; } DistEntry;
+
+static int dist_entry_cmp(const void *a, const void *b)
 {
-    if (col < 0 || col >= GRID_COLS || row < 0 || row >= GRID_ROWS) return 0;
-    int idx = row * GRID_COLS + col;
-    if (s->grid[idx] != CELL_EMPTY) return 0;
-    /* MOD_TERRAIN: cannot place on water or swamp cells */
-    if (s->active_mod == MOD_TERRAIN &&
-        (s->terrain[idx] == CELL_WATER || s->terrain[idx] == CELL_SWAMP)) return 0;
+    return ((const DistEntry *)a)->key - ((const DistEntry *)b)->key;
+}
 
-    s->grid[idx] = CELL_TOWER; /* temporary block */
+/* Pop the smallest key from (sorted seeds, FIFO); 0 when both are empty */
+static int dist_pop(DistEntry *seeds, int n_seeds, int *seed_head,
+                    DistEntry *fifo, int fifo_tail, int *fifo_head,
+                    DistEntry *out)
+{
+    int has_seed = *seed_head < n_seeds;
+    int has_fifo = *fifo_head < fifo_tail;
+    if (!has_seed && !has_fifo) return 0;
+    if (has_seed && (!has_fifo || seeds[*seed_head].key <= fifo[*fifo_head].key))
+        *out = seeds[(*seed_head)++];
+    else
+        *out = fifo[(*fifo_head)++];
+    return 1;
+}
 
-    static int visited[GRID_ROWS * GRID_COLS];
-    static int queue[GRID_ROWS * GRID_COLS];
+static void dist_mark_dirty(GameState *s, int idx)
+{
+    s->placement_valid = 0; /* walls changed: legality cache is stale */
+    s_map_version++;        /* ...and so is the map layer */
+    if (s->dist_dirty[idx]) return;
+    s->dist_dirty[idx] = 1;
+    s->dist_dirty_cells[s->dist_dirty_count++] = (uint16_t)idx;
+}
+
+static void dist_repair(GameState *s)
+{
+    enum { N = GRID_ROWS * GRID_COLS };
+    enum { FRESH = 0, QUEUED, INVALID };
     static const int dr[4] = { -1,  1,  0,  0 };
     static const int dc[4] = {  0,  0, -1,  1 };
 
-    int total = GRID_ROWS * GRID_COLS;
-    for (int i = 0; i < total; i++) visited[i] = 0;
+    if (s->dist_dirty_count == 0) return;
+
+    De100TemporaryMemory scratch = de100_arena_begin_temp(frame_arena(s));
+    uint8_t   *state   = de100_arena_push_array(scratch.arena, N, uint8_t);
+    DistEntry *seeds   = de100_arena_push_array(scratch.arena, N, DistEntry);
+    DistEntry *fifo    = de100_arena_push_array(scratch.arena, 5 * N, DistEntry); /* relax: <= 4 pushes per settled cell */
+    int       *invalid = de100_arena_push_array(scratch.arena, N, int);
+    ASSERT(state && seeds && fifo && invalid);
+    memset(state, FRESH, N);
+
+    int exit_idx = EXIT_ROW * GRID_COLS + EXIT_COL;
+    int n_seeds = 0, n_invalid = 0;
+    DistEntry e;
+
+    /* ---- 1. Invalidate, starting from cells that became walls ---- */
+    for (int i = 0; i < s->dist_dirty_count; i++) {
+        int v = s->dist_dirty_cells[i];
+        if (!cell_is_passable(s, v) && s->dist[v] >= 0) {
+            state[v] = QUEUED;
+            seeds[n_seeds++] = (DistEntry){ v, s->dist[v] };
+        }
+    }
+    qsort(seeds, (size_t)n_seeds, sizeof(seeds[0]), dist_entry_cmp);
+
+    int seed_head = 0, fifo_head = 0, fifo_tail = 0;
+    while (dist_pop(seeds, n_seeds, &seed_head, fifo, fifo_tail, &fifo_head, &e)) {
+        int v = e.cell, row = v / GRID_COLS, col = v % GRID_COLS;
+
+        if (cell_is_passable(s, v)) {
+            int supported = 0;
+            for (int d = 0; d < 4 && !supported; d++) {
+                int nr = row + dr[d], nc = col + dc[d];
+                if (nr < 0 || nr >= GRID_ROWS || nc < 0 || nc >= GRID_COLS) continue;
+                int m = nr * GRID_COLS + nc;
+                supported = state[m] != INVALID && s->dist[m] == e.key - 1 &&
+                            cell_is_passable(s, m);
+            }
+            if (supported) { state[v] = FRESH; continue; }
+        }
+
+        state[v] = INVALID;
+        invalid[n_invalid++] = v;
+        for (int d = 0; d < 4; d++) {
+            int nr = row + dr[d], nc = col + dc[d];
+            if (nr < 0 || nr >= GRID_ROWS || nc < 0 || nc >= GRID_COLS) continue;
+            int n = nr * GRID_COLS + nc;
+            if (state[n] != FRESH || s->dist[n] != e.key + 1) continue;
+            state[n] = QUEUED;
+            fifo[fifo_tail++] = (DistEntry){ n, e.key + 1 };
+        }
+    }
+    for (int i = 0; i < n_invalid; i++) s->dist[invalid[i]] = -1;
+
+    /* ---- 2. Relax from invalidated + newly freed cells ---- */
+    n_seeds = 0;
+    for (int i = 0; i < n_invalid + s->dist_dirty_count; i++) {
+        int v = i < n_invalid ? invalid[i] : s->dist_dirty_cells[i - n_invalid];
+        if (v == exit_idx || !cell_is_passable(s, v)) continue;
+
+        int row = v / GRID_COLS, col = v % GRID_COLS, best = -1;
+        for (int d = 0; d < 4; d++) {
+            int nr = row + dr[d], nc = col + dc[d];
+            if (nr < 0 || nr >= GRID_ROWS || nc < 0 || nc >= GRID_COLS) continue;
+            int m = nr * GRID_COLS + nc;
+            if (s->dist[m] >= 0 && cell_is_passable(s, m) &&
+                (best < 0 || s->dist[m] + 1 < best))
+                best = s->dist[m] + 1;
+        }
+        if (best >= 0 && (s->dist[v] < 0 || best < s->dist[v])) {
+            s->dist[v] = best;
+            seeds[n_seeds++] = (DistEntry){ v, best };
+        }
+    }
+    qsort(seeds, (size_t)n_seeds, sizeof(seeds[0]), dist_entry_cmp);
+
+    seed_head = fifo_head = fifo_tail = 0;
+    while (dist_pop(seeds, n_seeds, &seed_head, fifo, fifo_tail, &fifo_head, &e)) {
+        if (s->dist[e.cell] != e.key) continue;      /* superseded */
+        int row = e.cell / GRID_COLS, col = e.cell % GRID_COLS;
+        for (int d = 0; d < 4; d++) {
+            int nr = row + dr[d], nc = col + dc[d];
+            if (nr < 0 || nr >= GRID_ROWS || nc < 0 || nc >= GRID_COLS) continue;
+            int n = nr * GRID_COLS + nc;
+            if (!cell_is_passable(s, n)) continue;
+            if (s->dist[n] >= 0 && s->dist[n] <= e.key + 1) continue;
+            s->dist[n] = e.key + 1;
+            fifo[fifo_tail++] = (DistEntry){ n, e.key + 1 };
+        }
+    }
+
+    de100_arena_end_temp(scratch);
+    for (int i = 0; i < s->dist_dirty_count; i++)
+        s->dist_dirty[s->dist_dirty_cells[i]] = 0;
+    s->dist_dirty_count = 0;
+}
+
+/* =========================================================================
+ * PLACEMENT LEGALITY  (articulation points)
+ *
+ * A tower on cell X is illegal iff every entry->exit path goes through X,
+ * i.e. X is an articulation point separating entry from exit.  One
+ * iterative Tarjan DFS from the entry finds all of them at once:
+ *
+ *   disc[v]  DFS discovery time          low[v]  earliest disc reachable
+ *   X seals the path iff some DFS child C of X has low[C] >= disc[X]
+ *   (C's subtree can't get around X) and that subtree holds the exit.
+ *
+ * Such cells necessarily lie on every shortest path, so only that part of
+ * the grid ever reports 1.  The result is cached in seals_path[] and
+ * rebuilt on the next query after the walls change (dist_mark_dirty),
+ * so hover previews and the legal-cell overlay are O(1) per cell instead
+ * of a fresh BFS per query.
+ * ========================================================================= */
+
+/* Exit-reachability walls; shared by the distance field and legality */
+static int cell_is_passable(const GameState *s, int idx)
+{
+    if (s->grid[idx] == CELL_TOWER) return 0;
+    /* MOD_TERRAIN: mountains block the path like towers do */
+    if (s->active_mod == MOD_TERRAIN && s->terrain[idx] == CELL_MOUNTAIN) return 0;
+    /* MOD_WEATHER: flooded cells block path for legality check */
+    if (s->active_mod == MOD_WEATHER && s->weather_flood[idx]) return 0;
+    return 1;
+}
+
+static void placement_rebuild(GameState *s)
+{
+    enum { N = GRID_ROWS * GRID_COLS };
+    static const int dr[4] = { -1,  1,  0,  0 };
+    static const int dc[4] = {  0,  0, -1,  1 };
+
+    De100TemporaryMemory scratch = de100_arena_begin_temp(frame_arena(s));
+    int     *disc     = de100_arena_push_array(scratch.arena, N, int);
+    int     *low      = de100_arena_push_array(scratch.arena, N, int);
+    int     *parent   = de100_arena_push_array(scratch.arena, N, int);
+    int     *stack    = de100_arena_push_array(scratch.arena, N, int);
+    uint8_t *next_dir = de100_arena_push_array(scratch.arena, N, uint8_t);
+    uint8_t *has_exit = de100_arena_push_array(scratch.arena, N, uint8_t);
+    ASSERT(disc && low && parent && stack && next_dir && has_exit);
+
+    memset(disc, 0, N * sizeof(int));
+    memset(next_dir, 0, N);
+    memset(has_exit, 0, N);
+    memset(s->seals_path, 0, sizeof(s->seals_path));
 
-    int head = 0, tail = 0;
     int entry_idx = ENTRY_ROW * GRID_COLS + ENTRY_COL;
     int exit_idx  = EXIT_ROW  * GRID_COLS + EXIT_COL;
-    visited[entry_idx] = 1;
-    queue[tail++] = entry_idx;
 
-    int reachable = 0;
-    while (head < tail) {
-        int ci = queue[head++];
-        if (ci == exit_idx) { reachable = 1; break; }
-        int r = ci / GRID_COLS, c = ci % GRID_COLS;
-        for (int d = 0; d < 4; d++) {
-            int nr = r + dr[d], nc = c + dc[d];
+    int time = 0, top = 0;
+    disc[entry_idx] = low[entry_idx] = ++time;
+    parent[entry_idx] = -1;
+    has_exit[entry_idx] = (entry_idx == exit_idx);
+    stack[top++] = entry_idx;
+
+    while (top > 0) {
+        int v = stack[top - 1];
+
+        if (next_dir[v] < 4) {
+            int d  = next_dir[v]++;
+            int nr = v / GRID_COLS + dr[d], nc = v % GRID_COLS + dc[d];
             if (nr < 0 || nr >= GRID_ROWS || nc < 0 || nc >= GRID_COLS) continue;
-            int ni = nr * GRID_COLS + nc;
-            if (visited[ni] || s->grid[ni] == CELL_TOWER) continue;
-            /* MOD_TERRAIN: mountains block the path like towers do */
-            if (s->active_mod == MOD_TERRAIN &&
-                s->terrain[ni] == CELL_MOUNTAIN) continue;
-            /* MOD_WEATHER: flooded cells block path for legality check */
-            if (s->active_mod == MOD_WEATHER && s->weather_flood[ni]) continue;
-            visited[ni] = 1;
-            queue[tail++] = ni;
+            int n = nr * GRID_COLS + nc;
+            if (!cell_is_passable(s, n)) continue;
+
+            if (!disc[n]) {                      /* tree edge: descend */
+                disc[n] = low[n] = ++time;
+                parent[n] = v;
+                has_exit[n] = (n == exit_idx);
+                stack[top++] = n;
+            } else if (n != parent[v] && disc[n] < low[v]) {
+                low[v] = disc[n];                /* back edge */
+            }
+            continue;
+        }
+
+        /* v finished: report to its parent */
+        top--;
+        int p = parent[v];
+        if (p < 0) continue;
+        if (low[v] < low[p]) low[p] = low[v];
+        if (has_exit[v]) {
+            has_exit[p] = 1;
+            if (p != entry_idx && low[v] >= disc[p]) s->seals_path[p] = 1;
         }
     }
 
-    s->grid[idx] = CELL_EMPTY; /* restore */
-    return reachable;
+    /* Exit already unreachable: nothing is legal (matches the old BFS) */
+    if (!disc[exit_idx]) memset(s->seals_path, 1, sizeof(s->seals_path));
+
+    de100_arena_end_temp(scratch);
+    s->placement_valid = 1;
+}
+
+/* Rules that don't depend on connectivity */
+static int cell_accepts_tower(const GameState *s, int idx)
+{
+    if (s->grid[idx] != CELL_EMPTY) return 0;
+    /* MOD_TERRAIN: cannot place on water or swamp cells */
+    if (s->active_mod == MOD_TERRAIN &&
+        (s->terrain[idx] == CELL_WATER || s->terrain[idx] == CELL_SWAMP)) return 0;
+    return 1;
+}
+
+static int can_place_tower(GameState *s, int col, int row)
+{
+    if (col < 0 || col >= GRID_COLS || row < 0 || row >= GRID_ROWS) return 0;
+    int idx = row * GRID_COLS + col;
+    if (!cell_accepts_tower(s, idx)) return 0;
+
+    if (!s->placement_valid) placement_rebuild(s);
+    return !s->seals_path[idx];
+}
+
+/* Batch query: legal[i] = can_place_tower() for every cell, in one pass */
+static void placement_fill_legal(GameState *s, uint8_t *legal)
+{
+    if (!s->placement_valid) placement_rebuild(s);
+    for (int i = 0; i < GRID_ROWS * GRID_COLS; i++)
+        legal[i] = (uint8_t)(cell_accepts_tower(s, i) && !s->seals_path[i]);
 }
 
 /* =========================================================================
@@ -277,6 +761,9 @@ static void init_mod_state(GameState *s)
     /* Clear any leftover terrain from a previous game */
     memset(s->terrain, 0, sizeof(s->terrain));
     memset(s->weather_flood, 0, sizeof(s->weather_flood));
+    s_map_version++;
+    /* The mod is this game's "level": compile its waves */
+    levels_compile_spawns(&s->spawns, s->active_mod);
 
     if (s->active_mod == MOD_TERRAIN) {
         /* =================================================================
@@ -371,9 +858,15 @@ static void init_mod_state(GameState *s)
 void game_init(GameState *s)
 {
     memset(s, 0, sizeof(*s));
+    frame_arenas_init(s);
+    timer_wheel_init(&s->timers);
+
+    rng_seed(&s->rng_gameplay,  RNG_SEED, RNG_STREAM_GAMEPLAY);
+    rng_seed(&s->rng_particles, RNG_SEED, RNG_STREAM_PARTICLES);
 
     s->grid[ENTRY_ROW * GRID_COLS + ENTRY_COL] = CELL_ENTRY;
     s->grid[EXIT_ROW  * GRID_COLS + EXIT_COL]  = CELL_EXIT;
+    s_map_version++;
 
     s->player_gold        = STARTING_GOLD;
     s->player_lives       = STARTING_LIVES;
@@ -382,6 +875,8 @@ void game_init(GameState *s)
     s->selected_tower_idx  = -1;
     s->hover_col           = -1;
     s->hover_row           = -1;
+    s->time_scale           = 1;
+    s->effective_time_scale = 1.0f;
 
     bfs_fill_distance(s);
     s->phase = GAME_PHASE_TITLE;
@@ -398,10 +893,95 @@ void game_init(GameState *s)
     game_audio_init(&s->audio);
 
     /* Sprite system: NULL = placeholder mode (colored rects).
-     * Change to sprites_init("assets/sprites.png") once you have an atlas. */
+     * Change to sprites_load_async("assets/sprites.png") once you have an
+     * atlas: it decodes on a loader thread while the first frames draw
+     * placeholders (sprites_init() would block startup on the decode).
+     * Or sprites_stream_init("assets/sprites") for one PNG per sprite,
+     * streamed in on first draw within SPRITE_STREAM_BUDGET. */
     sprites_init(NULL);
 }
 
+/* =========================================================================
+ * SAVED SESSIONS — LAYOUT MIGRATION
+ * =========================================================================
+ *
+ * A saved session is GameState's bytes plus the GAME_STATE_VERSION they
+ * were written with (utils/state-file.h).  The current layout is a plain
+ * copy; each older one gets a migrate_vN that copies what is unchanged and
+ * gives the new fields the values game_init would.  A layout with no
+ * migration is refused and the caller keeps the fresh game.
+ *
+ * JS analogy: the versioned-reducer pattern — `if (saved.v === 1)
+ * saved = {...saved, timeScale: 1}` before hydrating the store. */
+
+/* v1 and v2 kept the frame scratch as one struct where v3 has the engine
+ * arenas; everything before it sits at the same offsets.  Scratch never
+ * outlives a frame, so its old bytes are skipped. */
+typedef struct {
+    uint64_t words[2][FRAME_ARENA_SIZE / 8];
+    size_t   used[2];
+    int      current;
+} StateV2FrameArena;
+
+#define STATE_PREFIX  offsetof(GameState, frame_memory)
+#define STATE_V2_TAIL (STATE_PREFIX + sizeof(StateV2FrameArena))
+
+/* v1 ended `FrameArena frame; int should_quit;` */
+static int migrate_v1(GameState *s, const uint8_t *old, size_t old_size)
+{
+    if (old_size < STATE_V2_TAIL + sizeof(int) ||
+        old_size > sizeof(GameState)) return 0;
+
+    memcpy(s, old, STATE_PREFIX);
+    memcpy(&s->should_quit, old + STATE_V2_TAIL, sizeof(int));
+    s->time_scale           = 1;
+    s->effective_time_scale = 1.0f;
+    return 1;
+}
+
+/* v2 ended `FrameArena frame; int time_scale; float effective_time_scale;
+ * int should_quit;` */
+static int migrate_v2(GameState *s, const uint8_t *old, size_t old_size)
+{
+    const uint8_t *tail = old + STATE_V2_TAIL;
+    if (old_size < STATE_V2_TAIL + 3 * sizeof(int) ||
+        old_size > sizeof(GameState)) return 0;
+
+    memcpy(s, old, STATE_PREFIX);
+    memcpy(&s->time_scale,           tail,                   sizeof(int));
+    memcpy(&s->effective_time_scale, tail + sizeof(int),     sizeof(float));
+    memcpy(&s->should_quit,          tail + 2 * sizeof(int), sizeof(int));
+    return 1;
+}
+
+int game_restore_state(GameState *s, uint32_t version,
+                       const void *saved, size_t size)
+{
+    int ok;
+    switch (version) {
+        case GAME_STATE_VERSION:
+            ok = size == sizeof(*s);
+            if (ok) memcpy(s, saved, sizeof(*s));
+            break;
+        case 1:  ok = migrate_v1(s, (const uint8_t *)saved, size); break;
+        case 2:  ok = migrate_v2(s, (const uint8_t *)saved, size); break;
+        default: ok = 0; break;
+    }
+    if (!ok) return 0;
+
+    /* The saved arenas point into the writer's copy of frame_memory */
+    frame_arenas_init(s);
+
+    /* The renderer's caches were built from the fresh game's map */
+    s_map_version++;
+    s_hover_valid = 0;
+
+    /* Transient: the session was saved on the way out, mid-click */
+    memset(&s->mouse, 0, sizeof(s->mouse));
+    s->should_quit = 0;
+    return 1;
+}
+
 /* =========================================================================
  * PHASE CHANGE
  * ========================================================================= */
@@ -438,85 +1018,158 @@ static void change_phase(GameState *s, GamePhase p)
  * CREEP SPAWNING
  * ========================================================================= */
 
-static int spawn_creep(GameState *s, CreepType type, float hp_override)
+/* An unused slot (recycled first), or -1 when every slot is taken */
+static int creep_slot_take(CreepPool *cp)
 {
-    /* Reuse the first inactive slot; otherwise extend the pool. */
-    int idx = -1;
-    for (int i = 0; i < s->creep_count; i++) {
-        if (!s->creeps[i].active) { idx = i; break; }
-    }
-    if (idx < 0) {
-        if (s->creep_count >= MAX_CREEPS) return -1;
-        idx = s->creep_count++;
-    }
+    if (cp->free_count > 0)                 return cp->free_slots[--cp->free_count];
+    else if (cp->slot_count < MAX_CREEPS)   return cp->slot_count++;
+    else                                    return -1;
+}
+
+/* Append a zeroed creep in `slot` (from creep_slot_take); returns its
+ * dense index or -1 when there is no slot */
+static int creep_alloc(CreepPool *cp, int slot)
+{
+    if (slot < 0 || cp->count >= MAX_CREEPS) return -1;
+    if (cp->generation[slot] == 0) cp->generation[slot] = 1;
+
+    int i = cp->count++;
+    cp->dense_of[slot] = (uint16_t)i;
+    cp->handle[i] = ((CreepHandle)cp->generation[slot] << 16) | (CreepHandle)slot;
+
+    cp->x[i] = cp->y[i] = 0.0f;
+    cp->col[i] = cp->row[i] = 0;
+    cp->speed[i] = 0.0f;
+    cp->slow_timer[i] = cp->stun_timer[i] = 0.0f;
+    cp->slow_factor[i] = 1.0f;
+    cp->fly_dx[i] = cp->fly_dy[i] = 0.0f;
+    cp->hp[i] = cp->max_hp[i] = 0.0f;
+    cp->type[i] = CREEP_NONE;
+    cp->is_flying[i] = 0;
+    cp->lives_cost[i] = 0;
+    cp->shield_timer[i] = 0.0f;
+    cp->half_hp_spawned[i] = 0;
+    cp->active[i] = 1;
+    return i;
+}
+
+/* Dense index of a live creep, or -1 if it died (or never existed) */
+static int creep_lookup(const CreepPool *cp, CreepHandle h)
+{
+    int slot = (int)(h & 0xFFFFu);
+    if (h == CREEP_HANDLE_NONE || slot >= cp->slot_count) return -1;
+    if (cp->generation[slot] != (uint16_t)(h >> 16)) return -1;
+    int i = cp->dense_of[slot];
+    return cp->active[i] ? i : -1;
+}
+
+static int spawn_creep_in(GameState *s, int slot, CreepType type, float hp_override)
+{
+    CreepPool *cp = &s->creeps;
+    int i = creep_alloc(cp, slot);
+    if (i < 0) return -1;
 
     const CreepDef *def = &CREEP_DEFS[type];
-    Creep *c = &s->creeps[idx];
-    memset(c, 0, sizeof(*c));
-
-    c->x          = ENTRY_COL * CELL_SIZE + CELL_SIZE * 0.5f;
-    c->y          = ENTRY_ROW * CELL_SIZE + CELL_SIZE * 0.5f;
-    c->col        = ENTRY_COL;
-    c->row        = ENTRY_ROW;
-    c->type       = type;
-    c->hp         = hp_override > 0.0f ? hp_override : (float)def->base_hp;
-    c->max_hp     = c->hp;
-    c->speed      = def->speed;
-    c->active     = 1;
-    c->id         = s->next_creep_id++;
-    c->is_flying  = def->is_flying;
-    c->slow_factor = 1.0f;
-    c->lives_cost = def->lives_cost;
+    cp->x[i]          = ENTRY_COL * CELL_SIZE + CELL_SIZE * 0.5f;
+    cp->y[i]          = ENTRY_ROW * CELL_SIZE + CELL_SIZE * 0.5f;
+    cp->col[i]        = ENTRY_COL;
+    cp->row[i]        = ENTRY_ROW;
+    cp->type[i]       = (uint8_t)type;
+    cp->hp[i]         = hp_override > 0.0f ? hp_override : (float)def->base_hp;
+    cp->max_hp[i]     = cp->hp[i];
+    cp->speed[i]      = def->speed;
+    cp->is_flying[i]  = (uint8_t)def->is_flying;
+    cp->lives_cost[i] = (uint8_t)def->lives_cost;
 
     if (def->is_flying) {
         float ex = EXIT_COL * CELL_SIZE + CELL_SIZE * 0.5f;
         float ey = EXIT_ROW * CELL_SIZE + CELL_SIZE * 0.5f;
-        float dx = ex - c->x, dy = ey - c->y;
+        float dx = ex - cp->x[i], dy = ey - cp->y[i];
         float d  = sqrtf(dx * dx + dy * dy);
-        if (d > 0.001f) { c->fly_dx = dx / d; c->fly_dy = dy / d; }
-        else             { c->fly_dx = 1.0f;   c->fly_dy = 0.0f;   }
+        if (d > 0.001f) { cp->fly_dx[i] = dx / d; cp->fly_dy[i] = dy / d; }
+        else             { cp->fly_dx[i] = 1.0f;   cp->fly_dy[i] = 0.0f;   }
     }
 
     /* MOD_BOSS: boss creeps spawn with a 5-second damage shield, +30% speed
      * and +50% HP to make them more threatening. */
     if (type == CREEP_BOSS && s->active_mod == MOD_BOSS) {
-        c->shield_timer = 5.0f;
-        c->speed       *= 1.3f;
-        c->hp          *= 1.5f;
-        c->max_hp       = c->hp;
+        cp->shield_timer[i] = 5.0f;
+        cp->speed[i]       *= 1.3f;
+        cp->hp[i]          *= 1.5f;
+        cp->max_hp[i]       = cp->hp[i];
     }
 
-    return idx;
+    return i;
+}
+
+static int spawn_creep(GameState *s, CreepType type, float hp_override)
+{
+    return spawn_creep_in(s, creep_slot_take(&s->creeps), type, hp_override);
+}
+
+/* Hand back whatever the last wave left unspawned, then hold a slot for
+ * every creep of the current one, so its spawns never compete with
+ * SPAWN / boss children for the pool. */
+static void wave_reserve_slots(GameState *s)
+{
+    CreepPool *cp = &s->creeps;
+    while (s->wave_slot_count > 0)
+        cp->free_slots[cp->free_count++] = s->wave_slots[--s->wave_slot_count];
+
+    const SpawnTable *st = &s->spawns;
+    int need = st->wave_first[s->current_wave] - st->wave_first[s->current_wave - 1];
+    while (s->wave_slot_count < need) {
+        int slot = creep_slot_take(cp);
+        if (slot < 0) break;
+        s->wave_slots[s->wave_slot_count++] = (uint16_t)slot;
+    }
 }
 
 /* =========================================================================
  * COMPACT (swap-remove inactive entities)
  * ========================================================================= */
 
+/* Every creep column, for moving an entity between dense slots */
+#define CREEP_COLUMNS(X) \
+    X(x) X(y) X(col) X(row) X(speed) X(slow_timer) X(slow_factor)  \
+    X(stun_timer) X(fly_dx) X(fly_dy) X(active) X(hp) X(max_hp)     \
+    X(type) X(is_flying) X(lives_cost) X(shield_timer)              \
+    X(half_hp_spawned) X(handle)
+
 static void compact_creeps(GameState *s)
 {
+    CreepPool *cp = &s->creeps;
     int i = 0;
-    while (i < s->creep_count) {
-        if (!s->creeps[i].active) s->creeps[i] = s->creeps[--s->creep_count];
-        else                      i++;
+    while (i < cp->count) {
+        if (cp->active[i]) { i++; continue; }
+
+        /* Retire the dead creep's slot: its handles stop resolving */
+        int slot = (int)(cp->handle[i] & 0xFFFFu);
+        if (++cp->generation[slot] == 0) cp->generation[slot] = 1;
+        cp->free_slots[cp->free_count++] = (uint16_t)slot;
+
+        int last = --cp->count;
+        if (i != last) {
+#define MOVE_COLUMN(f) cp->f[i] = cp->f[last];
+            CREEP_COLUMNS(MOVE_COLUMN)
+#undef MOVE_COLUMN
+            cp->dense_of[cp->handle[i] & 0xFFFFu] = (uint16_t)i;
+        }
     }
 }
 
 static void compact_projectiles(GameState *s)
 {
+    ProjectilePool *pp = &s->projectiles;
     int i = 0;
-    while (i < s->projectile_count) {
-        if (!s->projectiles[i].active) s->projectiles[i] = s->projectiles[--s->projectile_count];
-        else                           i++;
-    }
-}
-
-static void compact_particles(GameState *s)
-{
-    int i = 0;
-    while (i < s->particle_count) {
-        if (!s->particles[i].active) s->particles[i] = s->particles[--s->particle_count];
-        else                         i++;
+    while (i < pp->count) {
+        if (pp->active[i]) { i++; continue; }
+        int last = --pp->count;
+        pp->x[i] = pp->x[last];             pp->y[i] = pp->y[last];
+        pp->vx[i] = pp->vx[last];           pp->vy[i] = pp->vy[last];
+        pp->active[i] = pp->active[last];   pp->damage[i] = pp->damage[last];
+        pp->splash_radius[i] = pp->splash_radius[last];
+        pp->target[i] = pp->target[last];   pp->tower_type[i] = pp->tower_type[last];
     }
 }
 
@@ -524,35 +1177,114 @@ static void compact_particles(GameState *s)
  * TARGETING
  * ========================================================================= */
 
-static int in_range(Tower *t, Creep *c)
+static int in_range(const Tower *t, const CreepPool *cp, int i)
 {
-    float dx = (float)t->cx - c->x;
-    float dy = (float)t->cy - c->y;
+    float dx = (float)t->cx - cp->x[i];
+    float dy = (float)t->cy - cp->y[i];
     float r  = t->range;
     return (dx * dx + dy * dy) <= (r * r);
 }
 
+/* =========================================================================
+ * CREEP SPATIAL GRID
+ *
+ * Towers used to test every creep (MAX_TOWERS x MAX_CREEPS range checks a
+ * frame).  Instead, once per frame after creeps move, creep indices are
+ * bucketed by the grid cell under them with a counting sort (O(n), no
+ * per-cell lists); a tower then visits only the cells its range square
+ * overlaps.  Off-grid creeps (spawning, flying) clamp into the border
+ * cells, which the clamped query rectangle still covers.
+ *
+ * Buckets hold indices, so slots freed or reused later in the frame are
+ * fine: queries re-check active + in_range on the live creep.  Children
+ * spawned this frame are picked up by next frame's rebuild.
+ * ========================================================================= */
+
+static int s_creep_cell_start[GRID_ROWS * GRID_COLS + 1];
+static int s_creep_cell_items[MAX_CREEPS];
+
+static int creep_grid_col(float x)
+{
+    int col = (int)floorf(x / (float)CELL_SIZE);
+    return col < 0 ? 0 : (col >= GRID_COLS ? GRID_COLS - 1 : col);
+}
+
+static int creep_grid_row(float y)
+{
+    int row = (int)floorf(y / (float)CELL_SIZE);
+    return row < 0 ? 0 : (row >= GRID_ROWS ? GRID_ROWS - 1 : row);
+}
+
+static void creep_grid_rebuild(GameState *s)
+{
+    De100TemporaryMemory scratch = de100_arena_begin_temp(frame_arena(s));
+    int   *cell_of = de100_arena_push_array(scratch.arena, MAX_CREEPS, int);
+    int   *cursor  = de100_arena_push_array(scratch.arena, GRID_ROWS * GRID_COLS, int);
+    ASSERT(cell_of && cursor);
+    memset(s_creep_cell_start, 0, sizeof(s_creep_cell_start));
+
+    const CreepPool *cp = &s->creeps;
+    for (int i = 0; i < cp->count; i++) {
+        if (!cp->active[i]) { cell_of[i] = -1; continue; }
+        cell_of[i] = creep_grid_row(cp->y[i]) * GRID_COLS + creep_grid_col(cp->x[i]);
+        s_creep_cell_start[cell_of[i] + 1]++;
+    }
+    for (int i = 0; i < GRID_ROWS * GRID_COLS; i++)
+        s_creep_cell_start[i + 1] += s_creep_cell_start[i];
+
+    /* Scatter in index order, so each bucket is sorted by creep index */
+    memcpy(cursor, s_creep_cell_start, GRID_ROWS * GRID_COLS * sizeof(int));
+    for (int i = 0; i < cp->count; i++)
+        if (cell_of[i] >= 0) s_creep_cell_items[cursor[cell_of[i]]++] = i;
+    de100_arena_end_temp(scratch);
+}
+
+/* Indices of active creeps within t's range; returns the count */
+static int creep_grid_query(GameState *s, Tower *t, int *out)
+{
+    int c0 = creep_grid_col((float)t->cx - t->range);
+    int c1 = creep_grid_col((float)t->cx + t->range);
+    int r0 = creep_grid_row((float)t->cy - t->range);
+    int r1 = creep_grid_row((float)t->cy + t->range);
+
+    int n = 0;
+    for (int r = r0; r <= r1; r++) {
+        for (int c = c0; c <= c1; c++) {
+            int cell = r * GRID_COLS + c;
+            for (int k = s_creep_cell_start[cell]; k < s_creep_cell_start[cell + 1]; k++) {
+                int i = s_creep_cell_items[k];
+                if (s->creeps.active[i] && in_range(t, &s->creeps, i)) out[n++] = i;
+            }
+        }
+    }
+    return n;
+}
+
 static int find_best_target(GameState *s, Tower *t)
 {
+    De100TemporaryMemory scratch = de100_arena_begin_temp(frame_arena(s));
+    int *candidates = de100_arena_push_array(scratch.arena, MAX_CREEPS, int);
+    ASSERT(candidates);
     int   best     = -1;
     float best_val = 0.0f;
 
-    for (int i = 0; i < s->creep_count; i++) {
-        Creep *c = &s->creeps[i];
-        if (!c->active || !in_range(t, c)) continue;
+    const CreepPool *cp = &s->creeps;
+    int n = creep_grid_query(s, t, candidates);
+    for (int k = 0; k < n; k++) {
+        int i = candidates[k];
 
         float val;
         switch (t->target_mode) {
             case TARGET_FIRST: {
                 /* Smallest dist[] = closest to exit */
                 float d;
-                if (c->is_flying) {
+                if (cp->is_flying[i]) {
                     float ex = EXIT_COL * CELL_SIZE + CELL_SIZE * 0.5f;
                     float ey = EXIT_ROW * CELL_SIZE + CELL_SIZE * 0.5f;
-                    float dx2 = ex - c->x, dy2 = ey - c->y;
+                    float dx2 = ex - cp->x[i], dy2 = ey - cp->y[i];
                     d = sqrtf(dx2 * dx2 + dy2 * dy2);
                 } else {
-                    int ci = c->row * GRID_COLS + c->col;
+                    int ci = cp->row[i] * GRID_COLS + cp->col[i];
                     d = (float)(s->dist[ci] >= 0 ? s->dist[ci] : 99999);
                 }
                 val = -d;
@@ -561,34 +1293,36 @@ static int find_best_target(GameState *s, Tower *t)
             case TARGET_LAST: {
                 /* Largest dist[] = farthest from exit */
                 float d;
-                if (c->is_flying) {
+                if (cp->is_flying[i]) {
                     float ex = EXIT_COL * CELL_SIZE + CELL_SIZE * 0.5f;
                     float ey = EXIT_ROW * CELL_SIZE + CELL_SIZE * 0.5f;
-                    float dx2 = ex - c->x, dy2 = ey - c->y;
+                    float dx2 = ex - cp->x[i], dy2 = ey - cp->y[i];
                     d = sqrtf(dx2 * dx2 + dy2 * dy2);
                 } else {
-                    int ci = c->row * GRID_COLS + c->col;
+                    int ci = cp->row[i] * GRID_COLS + cp->col[i];
                     d = (float)(s->dist[ci] >= 0 ? s->dist[ci] : 0);
                 }
                 val = d;
                 break;
             }
-            case TARGET_STRONGEST: val =  c->hp;                          break;
-            case TARGET_WEAKEST:   val = -c->hp;                          break;
+            case TARGET_STRONGEST: val =  cp->hp[i];                      break;
+            case TARGET_WEAKEST:   val = -cp->hp[i];                      break;
             case TARGET_CLOSEST: {
-                float dx2 = (float)t->cx - c->x, dy2 = (float)t->cy - c->y;
+                float dx2 = (float)t->cx - cp->x[i], dy2 = (float)t->cy - cp->y[i];
                 val = -(dx2 * dx2 + dy2 * dy2);
                 break;
             }
             default: val = 0.0f; break;
         }
 
-        if (best < 0 || val > best_val) {
+        /* Ties go to the lowest index, as with the old linear scan */
+        if (best < 0 || val > best_val || (val == best_val && i < best)) {
             best     = i;
             best_val = val;
         }
     }
 
+    de100_arena_end_temp(scratch);
     return best;
 }
 
@@ -610,76 +1344,73 @@ static int effective_damage(int raw, CreepType ct, TowerType tt)
 static void spawn_particle(GameState *s, float x, float y, float vx, float vy,
                            float lifetime, uint32_t color, int sz, const char *text)
 {
-    int idx = -1;
-    for (int i = 0; i < s->particle_count; i++) {
-        if (!s->particles[i].active) { idx = i; break; }
-    }
-    if (idx < 0) {
-        if (s->particle_count >= MAX_PARTICLES) return;
-        idx = s->particle_count++;
-    }
-
-    Particle *p = &s->particles[idx];
-    memset(p, 0, sizeof(*p));
-    p->x = x; p->y = y; p->vx = vx; p->vy = vy;
-    p->lifetime = p->max_lifetime = lifetime;
-    p->color    = color;
-    p->size     = sz;
+    ParticlePool *pp = &s->particles;
+    if (pp->count == MAX_PARTICLES) {       /* full: drop the oldest */
+        pp->head = (pp->head + 1) & (MAX_PARTICLES - 1);
+        pp->count--;
+    }
+    int idx = (pp->head + pp->count++) & (MAX_PARTICLES - 1);
+
+    pp->x0[idx] = x; pp->y0[idx] = y; pp->vx[idx] = vx; pp->vy[idx] = vy;
+    pp->born[idx]     = pp->clock;
+    pp->lifetime[idx] = lifetime;
+    pp->color[idx]    = color;
+    pp->size[idx]     = sz;
+    int n = 0;
     if (text) {
-        int i = 0;
-        while (text[i] && i < 11) { p->text[i] = text[i]; i++; }
-        p->text[i] = '\0';
+        while (text[n] && n < 11) { pp->text[idx][n] = text[n]; n++; }
     }
-    p->active = 1;
+    pp->text[idx][n] = '\0';
 }
 
+#define MAX_EXPLOSION_SPARKS 16
+
 static void spawn_explosion(GameState *s, float x, float y, uint32_t color, int count)
 {
+    /* Draw every random number first (one tight loop over the particle
+     * stream), then spawn.  Each spark uses one word: 16 bits of angle,
+     * 8 of speed, 8 of lifetime. */
+    uint32_t r[MAX_EXPLOSION_SPARKS];
+    if (count > MAX_EXPLOSION_SPARKS) count = MAX_EXPLOSION_SPARKS;
+    for (int i = 0; i < count; i++) r[i] = rng_next(&s->rng_particles);
+
     for (int i = 0; i < count; i++) {
-        int r1    = rng_next();
-        float ang = (float)((unsigned)r1 & 0xFFFF) / 65536.0f * 6.28318f;
-        int r2    = rng_next();
-        float spd = 30.0f + (float)((unsigned)r2 & 0xFF) * 0.5f;
-        float lt  = 0.25f + (float)(((unsigned)r2 >> 8) & 0xFF) / 512.0f;
+        float ang = (float)(r[i] & 0xFFFF) / 65536.0f * 6.28318f;
+        float spd = 30.0f + (float)((r[i] >> 16) & 0xFF) * 0.5f;
+        float lt  = 0.25f + (float)(r[i] >> 24) / 512.0f;
         spawn_particle(s, x, y, cosf(ang) * spd, sinf(ang) * spd, lt, color, 2, NULL);
     }
 }
 
-static void spawn_projectile(GameState *s, float sx, float sy, int target_id,
+static void spawn_projectile(GameState *s, float sx, float sy, CreepHandle target,
                              int dmg, float splash_r, TowerType tt)
 {
+    ProjectilePool *pp = &s->projectiles;
     int idx = -1;
-    for (int i = 0; i < s->projectile_count; i++) {
-        if (!s->projectiles[i].active) { idx = i; break; }
+    for (int i = 0; i < pp->count; i++) {
+        if (!pp->active[i]) { idx = i; break; }
     }
     if (idx < 0) {
-        if (s->projectile_count >= MAX_PROJECTILES) return;
-        idx = s->projectile_count++;
+        if (pp->count >= MAX_PROJECTILES) return;
+        idx = pp->count++;
     }
 
-    Projectile *p = &s->projectiles[idx];
-    memset(p, 0, sizeof(*p));
-    p->x            = sx;
-    p->y            = sy;
-    p->damage       = dmg;
-    p->splash_radius = splash_r;
-    p->target_id    = target_id;
-    p->tower_type   = tt;
-    p->active       = 1;
+    pp->x[idx]             = sx;
+    pp->y[idx]             = sy;
+    pp->damage[idx]        = dmg;
+    pp->splash_radius[idx] = splash_r;
+    pp->target[idx]        = target;
+    pp->tower_type[idx]    = (uint8_t)tt;
+    pp->active[idx]        = 1;
 
     /* Initial velocity toward target's current position */
     float tx = sx, ty = sy;
-    for (int i = 0; i < s->creep_count; i++) {
-        if (s->creeps[i].id == target_id && s->creeps[i].active) {
-            tx = s->creeps[i].x;
-            ty = s->creeps[i].y;
-            break;
-        }
-    }
+    int ti = creep_lookup(&s->creeps, target);
+    if (ti >= 0) { tx = s->creeps.x[ti]; ty = s->creeps.y[ti]; }
     float dx = tx - sx, dy = ty - sy;
     float d  = sqrtf(dx * dx + dy * dy);
-    if (d > 0.001f) { p->vx = dx / d * PROJECTILE_SPEED; p->vy = dy / d * PROJECTILE_SPEED; }
-    else             { p->vx = PROJECTILE_SPEED;           p->vy = 0.0f;                      }
+    if (d > 0.001f) { pp->vx[idx] = dx / d * PROJECTILE_SPEED; pp->vy[idx] = dy / d * PROJECTILE_SPEED; }
+    else             { pp->vx[idx] = PROJECTILE_SPEED;           pp->vy[idx] = 0.0f;                      }
 }
 
 /* =========================================================================
@@ -688,83 +1419,87 @@ static void spawn_projectile(GameState *s, float sx, float sy, int target_id,
 
 static void apply_damage(GameState *s, int creep_idx, int dmg, TowerType tt)
 {
-    if (creep_idx < 0 || creep_idx >= s->creep_count) return;
-    Creep *c = &s->creeps[creep_idx];
-    if (!c->active) return;
+    CreepPool *cp = &s->creeps;
+    int i = creep_idx;
+    if (i < 0 || i >= cp->count) return;
+    if (!cp->active[i]) return;
     /* MOD_BOSS: boss is immune while its spawn shield is active */
-    if (s->active_mod == MOD_BOSS && c->shield_timer > 0.0f) return;
-    c->hp -= (float)effective_damage(dmg, c->type, tt);
+    if (s->active_mod == MOD_BOSS && cp->shield_timer[i] > 0.0f) return;
+    cp->hp[i] -= (float)effective_damage(dmg, (CreepType)cp->type[i], tt);
     /* MOD_BOSS: when boss HP first crosses 50%, spawn 3 child creeps */
-    if (s->active_mod == MOD_BOSS && c->type == CREEP_BOSS &&
-        c->hp > 0.0f && c->hp <= c->max_hp * 0.5f && c->half_hp_spawned == 0)
+    if (s->active_mod == MOD_BOSS && cp->type[i] == CREEP_BOSS &&
+        cp->hp[i] > 0.0f && cp->hp[i] <= cp->max_hp[i] * 0.5f &&
+        cp->half_hp_spawned[i] == 0)
     {
-        c->half_hp_spawned = 1;
-        float bx   = c->x;   float by   = c->y;
-        int   bcol = c->col;  int   brow = c->row;
+        cp->half_hp_spawned[i] = 1;
+        float bx   = cp->x[i];    float by   = cp->y[i];
+        int   bcol = cp->col[i];  int   brow = cp->row[i];
         for (int k = 0; k < 3; k++) {
             int ci = spawn_creep(s, CREEP_SPAWN_CHILD, 0.0f);
             if (ci >= 0) {
-                s->creeps[ci].x   = bx;
-                s->creeps[ci].y   = by;
-                s->creeps[ci].col = bcol;
-                s->creeps[ci].row = brow;
+                cp->x[ci]   = bx;
+                cp->y[ci]   = by;
+                cp->col[ci] = bcol;
+                cp->row[ci] = brow;
             }
         }
     }
-    if (c->hp <= 0.0f) kill_creep(s, creep_idx);
+    if (cp->hp[i] <= 0.0f) kill_creep(s, i);
 }
 
 static void kill_creep(GameState *s, int idx)
 {
-    Creep *c = &s->creeps[idx];
-    if (!c->active) return;
+    CreepPool *cp = &s->creeps;
+    if (!cp->active[idx]) return;
 
-    int gold = CREEP_DEFS[c->type].kill_gold;
+    CreepType type = (CreepType)cp->type[idx];
+    int gold = CREEP_DEFS[type].kill_gold;
     s->player_gold += gold;
 
     char txt[8];
     snprintf(txt, sizeof(txt), "+%d", gold);
-    spawn_particle(s, c->x, c->y - 10.0f, 0.0f, -28.0f, 1.2f, COLOR_GOLD_TEXT, 1, txt);
-    spawn_explosion(s, c->x, c->y, CREEP_DEFS[c->type].color, 5);
-
-    if (c->type == CREEP_SPAWN) {
-        /* Snap parent info before zeroing the slot */
-        int   pcol = c->col, prow = c->row;
-        float px   = c->x,   py   = c->y;
-        c->active = 0; /* mark before spawning children to free the slot */
+    spawn_particle(s, cp->x[idx], cp->y[idx] - 10.0f, 0.0f, -28.0f, 1.2f, COLOR_GOLD_TEXT, 1, txt);
+    spawn_explosion(s, cp->x[idx], cp->y[idx], CREEP_DEFS[type].color, 5);
+
+    if (type == CREEP_SPAWN) {
+        /* Snap parent info before the children are appended */
+        int   pcol = cp->col[idx], prow = cp->row[idx];
+        float px   = cp->x[idx],   py   = cp->y[idx];
+        cp->active[idx] = 0;
         for (int i = 0; i < 4; i++) {
             int ci = spawn_creep(s, CREEP_SPAWN_CHILD, 0.0f);
             if (ci >= 0) {
-                s->creeps[ci].x   = px + (float)((rng_next() & 7) - 3);
-                s->creeps[ci].y   = py + (float)((rng_next() & 7) - 3);
-                s->creeps[ci].col = pcol;
-                s->creeps[ci].row = prow;
+                cp->x[ci]   = px + (float)((int)(rng_next(&s->rng_gameplay) & 7) - 3);
+                cp->y[ci]   = py + (float)((int)(rng_next(&s->rng_gameplay) & 7) - 3);
+                cp->col[ci] = pcol;
+                cp->row[ci] = prow;
             }
         }
         return; /* already marked inactive */
     }
 
-    game_play_sound(&s->audio, c->type == CREEP_BOSS ? SFX_BOSS_DEATH : SFX_CREEP_DEATH);
-    c->active = 0;
+    game_play_sound(&s->audio, type == CREEP_BOSS ? SFX_BOSS_DEATH : SFX_CREEP_DEATH);
+    cp->active[idx] = 0;
 }
 
 /* =========================================================================
  * CREEP MOVEMENT
  * ========================================================================= */
 
-static void creep_move_toward_exit(GameState *s, Creep *c, float dt)
+static void creep_move_toward_exit(GameState *s, int i, float dt)
 {
-    if (c->stun_timer > 0.0f) { c->stun_timer -= dt; return; }
+    CreepPool *cp = &s->creeps;
+    if (cp->stun_timer[i] > 0.0f) { cp->stun_timer[i] -= dt; return; }
 
-    float spd = c->speed;
-    if (c->slow_timer > 0.0f) {
-        spd *= c->slow_factor;
-        c->slow_timer -= dt;
-        if (c->slow_timer < 0.0f) c->slow_timer = 0.0f;
+    float spd = cp->speed[i];
+    if (cp->slow_timer[i] > 0.0f) {
+        spd *= cp->slow_factor[i];
+        cp->slow_timer[i] -= dt;
+        if (cp->slow_timer[i] < 0.0f) cp->slow_timer[i] = 0.0f;
     }
     /* MOD_TERRAIN: apply per-cell terrain slow factor (water=0.5, swamp=0.25) */
     if (s->active_mod == MOD_TERRAIN) {
-        int ci_t = c->row * GRID_COLS + c->col;
+        int ci_t = cp->row[i] * GRID_COLS + cp->col[i];
         spd *= s->terrain_slow[ci_t];
     }
     /* MOD_WEATHER: global weather speed multiplier */
@@ -774,12 +1509,12 @@ static void creep_move_toward_exit(GameState *s, Creep *c, float dt)
     static const int dr[4] = { -1,  1,  0,  0 };
     static const int dc[4] = {  0,  0, -1,  1 };
 
-    int best_col = c->col, best_row = c->row;
-    int ci       = c->row * GRID_COLS + c->col;
+    int best_col = cp->col[i], best_row = cp->row[i];
+    int ci       = cp->row[i] * GRID_COLS + cp->col[i];
     int best_d   = s->dist[ci] >= 0 ? s->dist[ci] : 99999;
 
     for (int d = 0; d < 4; d++) {
-        int nr = c->row + dr[d], nc = c->col + dc[d];
+        int nr = cp->row[i] + dr[d], nc = cp->col[i] + dc[d];
         if (nr < 0 || nr >= GRID_ROWS || nc < 0 || nc >= GRID_COLS) continue;
         int ni = nr * GRID_COLS + nc;
         if (s->grid[ni] == CELL_TOWER) continue;
@@ -794,63 +1529,64 @@ static void creep_move_toward_exit(GameState *s, Creep *c, float dt)
     /* Interpolate toward the centre of the best cell. */
     float tx = best_col * CELL_SIZE + CELL_SIZE * 0.5f;
     float ty = best_row * CELL_SIZE + CELL_SIZE * 0.5f;
-    float dx = tx - c->x, dy = ty - c->y;
+    float dx = tx - cp->x[i], dy = ty - cp->y[i];
     float dist = sqrtf(dx * dx + dy * dy);
 
     if (dist < 1.5f) {
         /* Arrived: commit to cell */
-        c->x   = tx;  c->y   = ty;
-        c->col = best_col; c->row = best_row;
+        cp->x[i]   = tx;  cp->y[i]   = ty;
+        cp->col[i] = best_col; cp->row[i] = best_row;
 
-        if (c->col == EXIT_COL && c->row == EXIT_ROW) {
-            s->player_lives -= c->lives_cost;
+        if (cp->col[i] == EXIT_COL && cp->row[i] == EXIT_ROW) {
+            s->player_lives -= cp->lives_cost[i];
             if (s->player_lives < 0) s->player_lives = 0;
             game_play_sound(&s->audio, SFX_LIFE_LOST);
-            spawn_particle(s, c->x, c->y - 8.0f, 0.0f, -30.0f, 1.0f,
+            spawn_particle(s, cp->x[i], cp->y[i] - 8.0f, 0.0f, -30.0f, 1.0f,
                            COLOR_LIVES_TEXT, 1, "-1");
-            c->active = 0;
+            cp->active[i] = 0;
         }
     } else {
         float move = spd * dt;
         if (move > dist) move = dist;
-        c->x += dx / dist * move;
-        c->y += dy / dist * move;
+        cp->x[i] += dx / dist * move;
+        cp->y[i] += dy / dist * move;
     }
 }
 
-static void creep_flying_move(GameState *s, Creep *c, float dt)
+static void creep_flying_move(GameState *s, int i, float dt)
 {
-    if (c->stun_timer > 0.0f) { c->stun_timer -= dt; return; }
+    CreepPool *cp = &s->creeps;
+    if (cp->stun_timer[i] > 0.0f) { cp->stun_timer[i] -= dt; return; }
 
-    float spd = c->speed;
-    if (c->slow_timer > 0.0f) {
-        spd *= c->slow_factor;
-        c->slow_timer -= dt;
-        if (c->slow_timer < 0.0f) c->slow_timer = 0.0f;
+    float spd = cp->speed[i];
+    if (cp->slow_timer[i] > 0.0f) {
+        spd *= cp->slow_factor[i];
+        cp->slow_timer[i] -= dt;
+        if (cp->slow_timer[i] < 0.0f) cp->slow_timer[i] = 0.0f;
     }
     /* MOD_WEATHER: global weather speed multiplier (flying creeps feel the wind too) */
     spd *= get_weather_speed_mult(s);
 
-    c->x += c->fly_dx * spd * dt;
-    c->y += c->fly_dy * spd * dt;
+    cp->x[i] += cp->fly_dx[i] * spd * dt;
+    cp->y[i] += cp->fly_dy[i] * spd * dt;
 
     /* Update integer grid cell for targeting purposes */
-    int gc = (int)(c->x / CELL_SIZE);
-    int gr = (int)(c->y / CELL_SIZE);
-    c->col = (gc >= 0 && gc < GRID_COLS) ? gc : c->col;
-    c->row = (gr >= 0 && gr < GRID_ROWS) ? gr : c->row;
+    int gc = (int)(cp->x[i] / CELL_SIZE);
+    int gr = (int)(cp->y[i] / CELL_SIZE);
+    cp->col[i] = (gc >= 0 && gc < GRID_COLS) ? gc : cp->col[i];
+    cp->row[i] = (gr >= 0 && gr < GRID_ROWS) ? gr : cp->row[i];
 
     /* Arrival: within half a cell of exit centre */
     float ex = EXIT_COL * CELL_SIZE + CELL_SIZE * 0.5f;
     float ey = EXIT_ROW * CELL_SIZE + CELL_SIZE * 0.5f;
-    float ddx = ex - c->x, ddy = ey - c->y;
+    float ddx = ex - cp->x[i], ddy = ey - cp->y[i];
     if (ddx * ddx + ddy * ddy < (float)(CELL_SIZE * CELL_SIZE / 4)) {
-        s->player_lives -= c->lives_cost;
+        s->player_lives -= cp->lives_cost[i];
         if (s->player_lives < 0) s->player_lives = 0;
         game_play_sound(&s->audio, SFX_LIFE_LOST);
-        spawn_particle(s, c->x, c->y - 8.0f, 0.0f, -30.0f, 1.0f,
+        spawn_particle(s, cp->x[i], cp->y[i] - 8.0f, 0.0f, -30.0f, 1.0f,
                        COLOR_LIVES_TEXT, 1, "-1");
-        c->active = 0;
+        cp->active[i] = 0;
     }
 }
 
@@ -858,59 +1594,61 @@ static void creep_flying_move(GameState *s, Creep *c, float dt)
  * TOWER UPDATE
  * ========================================================================= */
 
-static void tower_update(GameState *s, Tower *t, float dt)
+/* FROST / BASH: one AOE pulse, from a TIMER_TOWER_PULSE event.  These
+ * towers have no per-frame work, so an idle one costs nothing. */
+static void tower_pulse(GameState *s, Tower *t)
 {
-    if (!t->active) return;
-    if (t->place_flash > 0.0f) t->place_flash -= dt;
-    t->cooldown_timer -= dt;
+    De100TemporaryMemory scratch = de100_arena_begin_temp(frame_arena(s));
+    int *hit = de100_arena_push_array(scratch.arena, MAX_CREEPS, int);
+    ASSERT(hit);
+    int n = creep_grid_query(s, t, hit);
 
     if (t->type == TOWER_FROST) {
         /* AOE slow pulse — no projectile */
-        if (t->cooldown_timer <= 0.0f) {
-            t->cooldown_timer = 1.0f / t->fire_rate;
-            for (int i = 0; i < s->creep_count; i++) {
-                Creep *c = &s->creeps[i];
-                if (c->active && in_range(t, c)) {
-                    c->slow_timer  = 2.0f;
-                    c->slow_factor = 0.5f;
-                }
-            }
-            game_play_sound(&s->audio, SFX_FROST_PULSE);
+        for (int k = 0; k < n; k++) {
+            s->creeps.slow_timer[hit[k]]  = 2.0f;
+            s->creeps.slow_factor[hit[k]] = 0.5f;
         }
+        de100_arena_end_temp(scratch);
+        game_play_sound(&s->audio, SFX_FROST_PULSE);
         return;
     }
 
-    if (t->type == TOWER_BASH) {
-        /* AOE stun + damage pulse — no projectile */
-        if (t->cooldown_timer <= 0.0f) {
-            t->cooldown_timer = 1.0f / t->fire_rate;
-            for (int i = 0; i < s->creep_count; i++) {
-                Creep *c = &s->creeps[i];
-                if (c->active && in_range(t, c)) {
-                    c->stun_timer = 0.5f;
-                    apply_damage(s, i, t->damage, t->type);
-                }
-            }
-            spawn_explosion(s, (float)t->cx, (float)t->cy,
-                            TOWER_DEFS[TOWER_BASH].color, 8);
-            game_play_sound(&s->audio, SFX_BASH_HIT);
-        }
-        return;
+    /* AOE stun + damage pulse — no projectile */
+    for (int k = 0; k < n; k++) {
+        if (!s->creeps.active[hit[k]]) continue; /* killed earlier in this pulse */
+        s->creeps.stun_timer[hit[k]] = 0.5f;
+        apply_damage(s, hit[k], t->damage, t->type);
     }
+    de100_arena_end_temp(scratch);
+    spawn_explosion(s, (float)t->cx, (float)t->cy,
+                    TOWER_DEFS[TOWER_BASH].color, 8);
+    game_play_sound(&s->audio, SFX_BASH_HIT);
+}
+
+static void tower_update(GameState *s, Tower *t, float dt)
+{
+    if (!t->active) return;
+    if (t->place_flash > 0.0f) t->place_flash -= dt;
+    if (t->type == TOWER_FROST || t->type == TOWER_BASH) return; /* timers */
 
-    /* Standard: find target, rotate barrel, fire when cooldown expires */
+    /* Standard: find target, rotate barrel, fire once ready_tick passes */
     int ti = find_best_target(s, t);
     if (ti >= 0) {
-        Creep *tc = &s->creeps[ti];
-        float dx = tc->x - (float)t->cx;
-        float dy = tc->y - (float)t->cy;
-        t->angle     = atan2f(dy, dx);
-        t->target_id = tc->id;
-
-        if (t->cooldown_timer <= 0.0f) {
-            t->cooldown_timer = 1.0f / t->fire_rate;
+        float dx = s->creeps.x[ti] - (float)t->cx;
+        float dy = s->creeps.y[ti] - (float)t->cy;
+        t->angle  = atan2f(dy, dx);
+        t->target = s->creeps.handle[ti];
+
+        uint32_t now = s->timers.now;
+        if ((int32_t)(now - t->ready_tick) >= 0) {
+            /* Firing steadily: step from the last ready tick, so frame
+             * length doesn't stretch the period.  Idle since: restart. */
+            uint32_t period = timer_ticks(1.0f / t->fire_rate);
+            t->ready_tick = (now - t->ready_tick < period)
+                            ? t->ready_tick + period : now + period;
             spawn_projectile(s, (float)t->cx, (float)t->cy,
-                             tc->id, t->damage,
+                             t->target, t->damage,
                              TOWER_DEFS[t->type].splash_radius, t->type);
             SfxId sfx;
             switch (t->type) {
@@ -929,59 +1667,80 @@ static void tower_update(GameState *s, Tower *t, float dt)
  * PROJECTILE UPDATE
  * ========================================================================= */
 
-static void projectile_update(GameState *s, Projectile *p, float dt)
+/* Re-aim every live projectile at its target and resolve hits. Handles
+ * make the lookup O(1) and stop a recycled slot from being chased. */
+static void projectiles_home(GameState *s)
 {
-    if (!p->active) return;
-
-    /* Home toward live target, check hit */
-    if (p->target_id >= 0) {
-        int target_alive = 0;
-        for (int i = 0; i < s->creep_count; i++) {
-            Creep *c = &s->creeps[i];
-            if (!c->active || c->id != p->target_id) continue;
-            target_alive = 1;
-
-            float dx = c->x - p->x, dy = c->y - p->y;
-            float d2 = dx * dx + dy * dy;
-
-            /* Re-aim */
-            if (d2 > 0.001f) {
-                float d = sqrtf(d2);
-                p->vx = dx / d * PROJECTILE_SPEED;
-                p->vy = dy / d * PROJECTILE_SPEED;
-            }
+    ProjectilePool *pp = &s->projectiles;
+    CreepPool      *cp = &s->creeps;
+    int np = pp->count; /* snapshot */
+    for (int p = 0; p < np; p++) {
+        if (!pp->active[p]) continue;
+
+        int i = creep_lookup(cp, pp->target[p]);
+        if (i < 0) { pp->active[p] = 0; continue; }
+
+        float dx = cp->x[i] - pp->x[p], dy = cp->y[i] - pp->y[p];
+        float d2 = dx * dx + dy * dy;
+
+        /* Re-aim */
+        if (d2 > 0.001f) {
+            float d = sqrtf(d2);
+            pp->vx[p] = dx / d * PROJECTILE_SPEED;
+            pp->vy[p] = dy / d * PROJECTILE_SPEED;
+        }
 
-            /* Hit threshold: 8 px radius */
-            if (d2 <= 64.0f) {
-                if (p->splash_radius > 0.0f) {
-                    float sr2 = p->splash_radius * p->splash_radius;
-                    int   nc  = s->creep_count; /* snapshot — avoid re-counting children */
-                    for (int j = 0; j < nc; j++) {
-                        if (!s->creeps[j].active) continue;
-                        float ex = s->creeps[j].x - p->x;
-                        float ey = s->creeps[j].y - p->y;
-                        if (ex * ex + ey * ey <= sr2)
-                            apply_damage(s, j, p->damage, p->tower_type);
-                    }
-                    spawn_explosion(s, p->x, p->y, COLOR_PROJECTILE, 6);
-                } else {
-                    apply_damage(s, i, p->damage, p->tower_type);
+        /* Hit threshold: 8 px radius */
+        if (d2 <= 64.0f) {
+            TowerType tt = (TowerType)pp->tower_type[p];
+            if (pp->splash_radius[p] > 0.0f) {
+                float sr2 = pp->splash_radius[p] * pp->splash_radius[p];
+                int   nc  = cp->count; /* snapshot — avoid re-counting children */
+                for (int j = 0; j < nc; j++) {
+                    if (!cp->active[j]) continue;
+                    float ex = cp->x[j] - pp->x[p];
+                    float ey = cp->y[j] - pp->y[p];
+                    if (ex * ex + ey * ey <= sr2)
+                        apply_damage(s, j, pp->damage[p], tt);
                 }
-                p->active = 0;
-                return;
+                spawn_explosion(s, pp->x[p], pp->y[p], COLOR_PROJECTILE, 6);
+            } else {
+                apply_damage(s, i, pp->damage[p], tt);
             }
-            break; /* target found but not yet in range — keep flying */
+            pp->active[p] = 0;
         }
-        if (!target_alive) { p->active = 0; return; }
     }
+}
 
-    p->x += p->vx * dt;
-    p->y += p->vy * dt;
+/* Integrate and cull. Branch-free over plain float columns, so the
+ * compiler can vectorise it. */
+static void projectiles_move(GameState *s, float dt)
+{
+    ProjectilePool *pp = &s->projectiles;
+    for (int p = 0; p < pp->count; p++) {
+        pp->x[p] += pp->vx[p] * dt;
+        pp->y[p] += pp->vy[p] * dt;
+    }
+    for (int p = 0; p < pp->count; p++) {
+        int on_screen = (pp->x[p] >= -20.0f) & (pp->x[p] <= CANVAS_W + 20.0f) &
+                        (pp->y[p] >= -20.0f) & (pp->y[p] <= CANVAS_H + 20.0f);
+        pp->active[p] &= (uint8_t)on_screen;
+    }
+}
 
-    /* Cull off-screen */
-    if (p->x < -20.0f || p->x > CANVAS_W + 20.0f ||
-        p->y < -20.0f || p->y > CANVAS_H + 20.0f)
-        p->active = 0;
+/* Particles are analytic (see ParticlePool): advance the clock and pop
+ * the expired ones off the front of the ring.  Restarting the clock when
+ * the ring empties keeps it small, and `born` precise. */
+static void particles_update(GameState *s, float dt)
+{
+    ParticlePool *pp = &s->particles;
+    pp->clock += dt;
+    while (pp->count > 0 &&
+           pp->clock - pp->born[pp->head] >= pp->lifetime[pp->head]) {
+        pp->head = (pp->head + 1) & (MAX_PARTICLES - 1);
+        pp->count--;
+    }
+    if (pp->count == 0) pp->clock = 0.0f;
 }
 
 /* =========================================================================
@@ -991,13 +1750,11 @@ static void projectile_update(GameState *s, Projectile *p, float dt)
 static int check_wave_complete(GameState *s)
 {
     if (s->current_wave < 1 || s->current_wave > WAVE_COUNT) return 0;
-    const WaveDef *wd = &g_waves[s->current_wave - 1];
-    static const WaveDef boss_mod_wave = { CREEP_BOSS, 1, 0.5f, 0 };
-    if (s->active_mod == MOD_BOSS && (s->current_wave % 5 == 0))
-        wd = &boss_mod_wave;
-    if (s->wave_spawn_index < wd->count) return 0;
-    for (int i = 0; i < s->creep_count; i++) {
-        if (s->creeps[i].active) return 0;
+    const SpawnTable *st = &s->spawns;
+    int count = st->wave_first[s->current_wave] - st->wave_first[s->current_wave - 1];
+    if (s->wave_spawn_index < count) return 0;
+    for (int i = 0; i < s->creeps.count; i++) {
+        if (s->creeps.active[i]) return 0;
     }
     return 1;
 }
@@ -1017,15 +1774,12 @@ static void start_wave(GameState *s)
         game_play_sound(&s->audio, SFX_INTEREST_EARN);
     }
 
-    const WaveDef *wd = &g_waves[s->current_wave - 1];
-    /* MOD_BOSS: force a boss wave every 5 waves */
-    static const WaveDef boss_mod_wave = { CREEP_BOSS, 1, 0.5f, 0 };
-    if (s->active_mod == MOD_BOSS && (s->current_wave % 5 == 0))
-        wd = &boss_mod_wave;
-
     s->wave_spawn_index    = 0;
-    s->wave_spawn_timer    = 0.0f;
-    s->remaining_wave_time = (float)wd->count * wd->spawn_interval + 10.0f;
+    wave_reserve_slots(s);
+    timer_cancel(&s->timers, s->wave_spawn_event);
+    s->wave_spawn_event    = timer_schedule(&s->timers, s->timers.now,
+                                            TIMER_WAVE_SPAWN, 0);
+    s->remaining_wave_time = s->spawns.wave_seconds[s->current_wave - 1] + 10.0f;
 
     change_phase(s, GAME_PHASE_WAVE);
 }
@@ -1045,19 +1799,60 @@ static void send_wave_early(GameState *s)
 
     s->current_wave++;
     s->wave_spawn_index = 0;
-    s->wave_spawn_timer = 0.0f;
-    const WaveDef *wd = &g_waves[s->current_wave - 1];
-    s->remaining_wave_time = (float)wd->count * wd->spawn_interval + 10.0f;
+    wave_reserve_slots(s);
+    timer_cancel(&s->timers, s->wave_spawn_event);
+    s->wave_spawn_event = timer_schedule(&s->timers, s->timers.now,
+                                         TIMER_WAVE_SPAWN, 0);
+    s->remaining_wave_time = s->spawns.wave_seconds[s->current_wave - 1] + 10.0f;
+}
+
+/* Run the wave clock forward by dt and handle what came due: creep
+ * spawns and FROST/BASH pulses, in tick order. */
+static void update_wave_timers(GameState *s, float dt)
+{
+    TimerWheel *tw = &s->timers;
+    tw->tick_frac += dt * (float)TIMER_HZ;
+    uint32_t ticks = (uint32_t)tw->tick_frac;
+    tw->tick_frac -= (float)ticks;
+    uint32_t now = tw->now + ticks;
+
+    TimerEvent due[32];
+    int n;
+    do {
+        n = timer_advance(tw, now, due, 32);
+        for (int k = 0; k < n; k++) {
+            const TimerEvent *e = &due[k];
+            if (e->kind == TIMER_WAVE_SPAWN) {
+                /* Every table entry due on this tick, then wait for the next */
+                const SpawnTable *st = &s->spawns;
+                int k   = st->wave_first[s->current_wave - 1] + s->wave_spawn_index;
+                int end = st->wave_first[s->current_wave];
+                uint32_t tick = st->tick[k];
+                for (; k < end && st->tick[k] == tick; k++) {
+                    int slot = s->wave_slot_count > 0
+                               ? s->wave_slots[--s->wave_slot_count]
+                               : creep_slot_take(&s->creeps);
+                    spawn_creep_in(s, slot, (CreepType)st->type[k], st->hp[k]);
+                    s->wave_spawn_index++;
+                }
+                s->wave_spawn_event = k < end
+                    ? timer_schedule(tw, e->due + (st->tick[k] - tick),
+                                     TIMER_WAVE_SPAWN, 0)
+                    : TIMER_HANDLE_NONE;
+            } else {
+                Tower *t = &s->towers[e->user];
+                tower_pulse(s, t);
+                t->pulse_timer = timer_schedule(tw,
+                                                e->due + timer_ticks(1.0f / t->fire_rate),
+                                                TIMER_TOWER_PULSE, e->user);
+            }
+        }
+    } while (n == 32);
 }
 
 static void update_wave(GameState *s, float dt)
 {
     if (s->current_wave < 1 || s->current_wave > WAVE_COUNT) return;
-    const WaveDef *wd = &g_waves[s->current_wave - 1];
-    /* MOD_BOSS: use boss wave data for multiples of 5 */
-    static const WaveDef boss_mod_wave = { CREEP_BOSS, 1, 0.5f, 0 };
-    if (s->active_mod == MOD_BOSS && (s->current_wave % 5 == 0))
-        wd = &boss_mod_wave;
 
     /* MOD_WEATHER: advance 4-phase weather cycle (60 s total):
      *   0-20 s  = CLEAR (phase 0) — normal speed
@@ -1102,8 +1897,10 @@ static void update_wave(GameState *s, float dt)
                 };
                 for (int fi = 0; fi < (int)(sizeof(flood_indices)/sizeof(flood_indices[0])); fi++) {
                     int idx = flood_indices[fi];
-                    if (s->grid[idx] == CELL_EMPTY)
+                    if (s->grid[idx] == CELL_EMPTY && !s->weather_flood[idx]) {
                         s->weather_flood[idx] = 1;
+                        dist_mark_dirty(s, idx);
+                    }
                 }
                 /* Storm: even wider flood area (add 4 more cells) */
                 if (new_phase == 3) {
@@ -1113,20 +1910,24 @@ static void update_wave(GameState *s, float dt)
                     };
                     for (int fi = 0; fi < 4; fi++) {
                         int idx = storm_extra[fi];
-                        if (s->grid[idx] == CELL_EMPTY)
+                        if (s->grid[idx] == CELL_EMPTY && !s->weather_flood[idx]) {
                             s->weather_flood[idx] = 1;
+                            dist_mark_dirty(s, idx);
+                        }
                     }
                 }
-                bfs_fill_distance(s);
                 /* Spawn "flooded path!" particle notification */
                 spawn_particle(s, GRID_PIXEL_W * 0.5f, GRID_PIXEL_H * 0.35f,
                                0.0f, -20.0f, 2.5f,
                                GAME_RGB(0x44, 0xAA, 0xFF), 1,
                                (new_phase == 3) ? "STORM: path flooded!" : "Rain: path flooded!");
             } else if (was_wet) {
-                /* Clear flood cells and restore BFS */
-                memset(s->weather_flood, 0, sizeof(s->weather_flood));
-                bfs_fill_distance(s);
+                /* Clear flood cells; dist_repair() restores the paths */
+                for (int i = 0; i < GRID_ROWS * GRID_COLS; i++) {
+                    if (!s->weather_flood[i]) continue;
+                    s->weather_flood[i] = 0;
+                    dist_mark_dirty(s, i);
+                }
                 if (new_phase == 2) {
                     spawn_particle(s, GRID_PIXEL_W * 0.5f, GRID_PIXEL_H * 0.35f,
                                    0.0f, -20.0f, 2.0f,
@@ -1150,56 +1951,38 @@ static void update_wave(GameState *s, float dt)
         }
     }
 
-    /* ---- Spawn ---- */
-    if (s->wave_spawn_index < wd->count) {
-        s->wave_spawn_timer -= dt;
-        if (s->wave_spawn_timer <= 0.0f) {
-            float hp = wd->base_hp_override > 0.0f
-                       ? wd->base_hp_override
-                       : (float)CREEP_DEFS[wd->creep_type].base_hp
-                         * powf(HP_SCALE_PER_WAVE, (float)(s->current_wave - 1));
-            spawn_creep(s, wd->creep_type, hp);
-            s->wave_spawn_index++;
-            s->wave_spawn_timer = wd->spawn_interval;
-        }
-    }
+    /* ---- Bring dist[] up to date with this frame's wall changes ---- */
+    dist_repair(s);
 
     /* ---- Move creeps (snapshot count; newly spawned children skip this frame) ---- */
-    int nc = s->creep_count;
+    CreepPool *cp = &s->creeps;
+    int nc = cp->count;
     for (int i = 0; i < nc; i++) {
-        Creep *c = &s->creeps[i];
-        if (!c->active) continue;
+        if (!cp->active[i]) continue;
         /* MOD_BOSS: tick down the spawn shield */
-        if (s->active_mod == MOD_BOSS && c->shield_timer > 0.0f) {
-            c->shield_timer -= dt;
-            if (c->shield_timer < 0.0f) c->shield_timer = 0.0f;
+        if (s->active_mod == MOD_BOSS && cp->shield_timer[i] > 0.0f) {
+            cp->shield_timer[i] -= dt;
+            if (cp->shield_timer[i] < 0.0f) cp->shield_timer[i] = 0.0f;
         }
-        if (c->is_flying) creep_flying_move(s, c, dt);
-        else              creep_move_toward_exit(s, c, dt);
+        if (cp->is_flying[i]) creep_flying_move(s, i, dt);
+        else                  creep_move_toward_exit(s, i, dt);
     }
 
-    /* ---- Tower fire ---- */
+    /* ---- Tower fire (bucket creeps once, towers query their cells) ---- */
+    creep_grid_rebuild(s);
+    update_wave_timers(s, dt);
     for (int i = 0; i < s->tower_count; i++)
         tower_update(s, &s->towers[i], dt);
 
-    /* ---- Projectiles (snapshot count) ---- */
-    int np = s->projectile_count;
-    for (int i = 0; i < np; i++)
-        projectile_update(s, &s->projectiles[i], dt);
+    /* ---- Projectiles: home and hit, then integrate the survivors ---- */
+    projectiles_home(s);
+    projectiles_move(s, dt);
 
     /* ---- Particles ---- */
-    for (int i = 0; i < s->particle_count; i++) {
-        Particle *p = &s->particles[i];
-        if (!p->active) continue;
-        p->x += p->vx * dt;
-        p->y += p->vy * dt;
-        p->lifetime -= dt;
-        if (p->lifetime <= 0.0f) p->active = 0;
-    }
+    particles_update(s, dt);
 
     compact_creeps(s);
     compact_projectiles(s);
-    compact_particles(s);
 
     s->remaining_wave_time -= dt;
     if (s->remaining_wave_time < 0.0f) s->remaining_wave_time = 0.0f;
@@ -1264,6 +2047,13 @@ static void handle_placement_input(GameState *s)
 
     /* ---- Panel ---- */
     if (m->x >= PANEL_X) {
+        /* Fast-forward: 1x → 2x → 4x → 8x → 1x */
+        if (m->x >= SPEED_BTN_X && m->x < SPEED_BTN_X + SPEED_BTN_W &&
+            m->y >= SPEED_BTN_Y && m->y < SPEED_BTN_Y + SPEED_BTN_H) {
+            s->time_scale = s->time_scale >= MAX_TIME_SCALE ? 1 : s->time_scale * 2;
+            return;
+        }
+
         /* Shop: one button per tower type (skip TOWER_NONE=0) */
         for (int ti = 1; ti < TOWER_COUNT; ti++) {
             int by = SHOP_BTN_Y0 + (ti - 1) * SHOP_BTN_H;
@@ -1288,9 +2078,10 @@ static void handle_placement_input(GameState *s)
             if (m->y >= SELL_BTN_Y && m->y < SELL_BTN_Y + SELL_BTN_H) {
                 s->player_gold += t->sell_value;
                 s->grid[t->row * GRID_COLS + t->col] = CELL_EMPTY;
+                timer_cancel(&s->timers, t->pulse_timer);
                 t->active = 0;
                 s->selected_tower_idx = -1;
-                bfs_fill_distance(s);
+                dist_mark_dirty(s, t->row * GRID_COLS + t->col);
                 game_play_sound(&s->audio, SFX_TOWER_SELL);
                 return;
             }
@@ -1355,14 +2146,19 @@ static void handle_placement_input(GameState *s)
     t->damage      = def->damage;
     t->fire_rate   = def->fire_rate;
     t->target_mode = TARGET_FIRST;
-    t->target_id   = -1;
+    t->target      = CREEP_HANDLE_NONE;
     t->active      = 1;
     t->sell_value  = (int)((float)def->cost * SELL_RATIO);
     t->place_flash = 0.3f;
+    /* Ready at once: the first shot / pulse goes out on the next wave frame */
+    t->ready_tick  = s->timers.now;
+    if (t->type == TOWER_FROST || t->type == TOWER_BASH)
+        t->pulse_timer = timer_schedule(&s->timers, s->timers.now,
+                                        TIMER_TOWER_PULSE, idx);
 
     s->grid[row * GRID_COLS + col] = CELL_TOWER;
     s->player_gold -= def->cost;
-    bfs_fill_distance(s);
+    dist_mark_dirty(s, row * GRID_COLS + col);
     /* MOD_TERRAIN: mountain towers get +20% range */
     if (s->active_mod == MOD_TERRAIN &&
         s->terrain[row * GRID_COLS + col] == CELL_MOUNTAIN) {
@@ -1379,14 +2175,12 @@ static void handle_placement_input(GameState *s)
 
 void game_update(GameState *s, float dt)
 {
+    /* Last frame's scratch stays readable; the one before is recycled */
+    frame_arenas_rotate(s);
+
     /* Cap dt so a debugger pause can't explode the simulation */
     if (dt > 0.1f) dt = 0.1f;
 
-    /* Advance music sequencer and ramp music volume each frame.
-     * Without this call the ambient drone never reaches its target_volume
-     * and game_audio_update()'s static freq_timer never ticks. */
-    game_audio_update(&s->audio, dt);
-
     /* Hover cell under mouse cursor */
     if (s->mouse.x >= 0 && s->mouse.x < GRID_PIXEL_W &&
         s->mouse.y >= 0 && s->mouse.y < GRID_PIXEL_H)
@@ -1402,6 +2196,8 @@ void game_update(GameState *s, float dt)
     s_hover_valid = 0;
     if (s->hover_col >= 0 && s->selected_tower_type != TOWER_NONE)
         s_hover_valid = can_place_tower(s, s->hover_col, s->hover_row);
+    if (s->selected_tower_type != TOWER_NONE)
+        placement_fill_legal(s, s->place_legal);
 
     if (s->shop_error_timer > 0.0f) s->shop_error_timer -= dt;
 
@@ -1437,19 +2233,12 @@ void game_update(GameState *s, float dt)
         case GAME_PHASE_PLACING:
             handle_placement_input(s);
             /* Keep particles alive between waves */
-            for (int i = 0; i < s->particle_count; i++) {
-                Particle *p = &s->particles[i];
-                if (!p->active) continue;
-                p->x += p->vx * dt; p->y += p->vy * dt;
-                p->lifetime -= dt;
-                if (p->lifetime <= 0.0f) p->active = 0;
-            }
+            particles_update(s, dt);
             /* Tick place_flash on towers */
             for (int i = 0; i < s->tower_count; i++) {
                 if (s->towers[i].active && s->towers[i].place_flash > 0.0f)
                     s->towers[i].place_flash -= dt;
             }
-            compact_particles(s);
             break;
 
         case GAME_PHASE_WAVE:
@@ -1461,14 +2250,7 @@ void game_update(GameState *s, float dt)
 
         case GAME_PHASE_WAVE_CLEAR:
             s->phase_timer -= dt;
-            for (int i = 0; i < s->particle_count; i++) {
-                Particle *p = &s->particles[i];
-                if (!p->active) continue;
-                p->x += p->vx * dt; p->y += p->vy * dt;
-                p->lifetime -= dt;
-                if (p->lifetime <= 0.0f) p->active = 0;
-            }
-            compact_particles(s);
+            particles_update(s, dt);
             if (s->phase_timer <= 0.0f) {
                 s->current_wave++;
                 if (s->current_wave > WAVE_COUNT)
@@ -1487,6 +2269,12 @@ void game_update(GameState *s, float dt)
         default:
             break;
     }
+
+    /* Edges are consumed: later ticks of the same frame (fast-forward) see
+     * the held state only, so one click is one click */
+    s->mouse.left_pressed  = 0;
+    s->mouse.left_released = 0;
+    s->mouse.right_pressed = 0;
 }
 
 /* =========================================================================
@@ -1506,97 +2294,188 @@ static const char *target_mode_name(TargetMode m)
 }
 
 /* =========================================================================
- * PUBLIC: GAME RENDER
+ * MAP LAYER
+ *
+ * The clear, the 600 grid cells and the terrain decorations are a tilemap
+ * (engine/game/tilemap.h): one tile number per cell, from a tileset of
+ * every cell look rendered once (base colour x decoration), and the HUD
+ * rows below the grid left DE100_TILEMAP_EMPTY (the clear colour).  The map covers
+ * the play area left of the panel, which covers the rest.
+ *
+ * The tiles only change when a tower is placed or sold, the mod scatters
+ * its terrain, or the weather floods / drains cells; all of those bump
+ * s_map_version, and the next draw re-derives the 600 tile numbers.  Only
+ * the chunks whose tiles actually changed re-render: a tower doesn't
+ * change the cell under it, so placing or selling one re-renders nothing.
+ *
+ * The only cells that animate are water shimmer (MOD_TERRAIN) and flood
+ * water (MOD_WEATHER).  The refresh lists them in s_map_anim[], and they
+ * are redrawn individually on top of the map.
  * ========================================================================= */
 
-void game_render(const GameState *s, Backbuffer *bb)
+enum {
+    MAP_BASE_EVEN, MAP_BASE_ODD, MAP_BASE_ENTRY, MAP_BASE_EXIT,
+    MAP_BASE_MOUNTAIN_ODD, MAP_BASE_MOUNTAIN_EVEN,
+    MAP_BASE_SWAMP_ODD, MAP_BASE_SWAMP_EVEN,
+    MAP_BASE_COUNT
+};
+enum { MAP_DECO_NONE, MAP_DECO_PEAK, MAP_DECO_BUBBLES, MAP_DECO_COUNT };
+
+#define MAP_TILE_COUNT (MAP_BASE_COUNT * MAP_DECO_COUNT)
+#define MAP_ROWS       (CANVAS_H / CELL_SIZE)   /* grid + HUD rows */
+
+/* What de100_tilemap_init() pushes: the tiles, a stale flag and a cache
+ * per chunk, plus slack for the cache's 64-byte alignment. */
+#define MAP_CHUNKS(tiles) \
+    (((tiles) + DE100_TILEMAP_CHUNK_TILES - 1) / DE100_TILEMAP_CHUNK_TILES)
+#define MAP_CHUNK_PX   (DE100_TILEMAP_CHUNK_TILES * CELL_SIZE)
+#define MAP_ARENA_SIZE \
+    (GRID_COLS * MAP_ROWS * sizeof(De100Tile) + \
+     MAP_CHUNKS(GRID_COLS) * MAP_CHUNKS(MAP_ROWS) * \
+         (1 + MAP_CHUNK_PX * MAP_CHUNK_PX * sizeof(uint32_t)) + 128)
+
+static uint32_t          s_map_tileset[CELL_SIZE * MAP_TILE_COUNT * CELL_SIZE];
+static uint8_t           s_map_memory[MAP_ARENA_SIZE];
+static De100MemoryArena  s_map_arena;
+static De100Tilemap      s_map;
+static uint16_t s_map_anim[GRID_ROWS * GRID_COLS];
+static int      s_map_anim_count;
+static unsigned s_map_layer_version; /* 0 = never built */
+
+/* Tile (base * MAP_DECO_COUNT + deco): the base colour, then the small
+ * terrain mark on top of it. */
+static void map_tileset_build(void)
 {
-    /* ---- Clear canvas ---- */
-    draw_rect(bb, 0, 0, CANVAS_W, CANVAS_H, GAME_RGB(0x22, 0x22, 0x22));
-
-    /* ==================================================================
-     * GRID
-     * ================================================================== */
-    for (int r = 0; r < GRID_ROWS; r++) {
-        for (int c = 0; c < GRID_COLS; c++) {
-            int px  = c * CELL_SIZE;
-            int py  = r * CELL_SIZE;
-            int idx = r * GRID_COLS + c;
-
-            uint32_t cell_col;
-            switch (s->grid[idx]) {
-                case CELL_ENTRY: cell_col = COLOR_ENTRY_CELL; break;
-                case CELL_EXIT:  cell_col = COLOR_EXIT_CELL;  break;
-                default:
-                    /* MOD_TERRAIN: draw solid terrain base colors instead of overlay */
-                    if (s->active_mod == MOD_TERRAIN) {
-                        switch (s->terrain[idx]) {
-                            case CELL_WATER:
-                                /* Animated shimmer: alternate between two blues each ~1 s */
-                                cell_col = ((r + c + (int)(s->weather_timer)) & 1)
-                                           ? GAME_RGB(0x22, 0x88, 0xCC)
-                                           : GAME_RGB(0x11, 0x66, 0xAA);
-                                break;
-                            case CELL_MOUNTAIN:
-                                /* Rocky grey with slight texture via checkerboard */
-                                cell_col = ((r + c) & 1)
-                                           ? GAME_RGB(0x66, 0x60, 0x58)
-                                           : GAME_RGB(0x50, 0x4A, 0x44);
-                                break;
-                            case CELL_SWAMP:
-                                /* Dark greenish-brown bog */
-                                cell_col = ((r + c) & 1)
-                                           ? GAME_RGB(0x2A, 0x3A, 0x18)
-                                           : GAME_RGB(0x20, 0x2E, 0x12);
-                                break;
-                            default:
-                                cell_col = ((c + r) & 1) ? COLOR_GRID_ODD : COLOR_GRID_EVEN;
-                        }
-                    } else {
-                        cell_col = ((c + r) & 1) ? COLOR_GRID_ODD : COLOR_GRID_EVEN;
-                    }
-                    break;
-            }
-            draw_rect(bb, px, py, CELL_SIZE, CELL_SIZE, cell_col);
+    static const uint32_t base_col[MAP_BASE_COUNT] = {
+        [MAP_BASE_EVEN]          = COLOR_GRID_EVEN,
+        [MAP_BASE_ODD]           = COLOR_GRID_ODD,
+        [MAP_BASE_ENTRY]         = COLOR_ENTRY_CELL,
+        [MAP_BASE_EXIT]          = COLOR_EXIT_CELL,
+        /* Rocky grey with slight texture via checkerboard */
+        [MAP_BASE_MOUNTAIN_ODD]  = GAME_RGB(0x66, 0x60, 0x58),
+        [MAP_BASE_MOUNTAIN_EVEN] = GAME_RGB(0x50, 0x4A, 0x44),
+        /* Dark greenish-brown bog */
+        [MAP_BASE_SWAMP_ODD]     = GAME_RGB(0x2A, 0x3A, 0x18),
+        [MAP_BASE_SWAMP_EVEN]    = GAME_RGB(0x20, 0x2E, 0x12),
+    };
+    Backbuffer sheet = { s_map_tileset, CELL_SIZE * MAP_TILE_COUNT, CELL_SIZE,
+                         CELL_SIZE * MAP_TILE_COUNT * 4 };
+
+    for (int t = 0; t < MAP_TILE_COUNT; t++) {
+        int x = t * CELL_SIZE;
+        draw_rect(&sheet, x, 0, CELL_SIZE, CELL_SIZE,
+                  base_col[t / MAP_DECO_COUNT]);
+        switch (t % MAP_DECO_COUNT) {
+            case MAP_DECO_PEAK:
+                /* White "peak" dot at center-top of mountain cell */
+                draw_rect(&sheet, x + CELL_SIZE / 2 - 1, 3, 3, 2,
+                          GAME_RGB(0xDD, 0xDD, 0xCC));
+                break;
+            case MAP_DECO_BUBBLES:
+                /* Small bubbles indicator for swamp */
+                draw_rect(&sheet, x + 4, CELL_SIZE - 5, 2, 2,
+                          GAME_RGB(0x40, 0x58, 0x28));
+                break;
         }
     }
 
-    /* MOD_TERRAIN: mountain peak indicator (small dark triangle drawn at top of each cell) */
-    if (s->active_mod == MOD_TERRAIN) {
-        for (int r = 0; r < GRID_ROWS; r++) {
-            for (int c = 0; c < GRID_COLS; c++) {
-                int idx2 = r * GRID_COLS + c;
-                if (s->terrain[idx2] == CELL_MOUNTAIN) {
-                    /* White "peak" dot at center-top of mountain cell */
-                    int px2 = c * CELL_SIZE + CELL_SIZE / 2;
-                    int py2 = r * CELL_SIZE + 3;
-                    draw_rect(bb, px2 - 1, py2, 3, 2, GAME_RGB(0xDD, 0xDD, 0xCC));
-                } else if (s->terrain[idx2] == CELL_SWAMP) {
-                    /* Small bubbles indicator for swamp */
-                    int px2 = c * CELL_SIZE + 4;
-                    int py2 = r * CELL_SIZE + CELL_SIZE - 5;
-                    if ((r * 7 + c * 13) % 3 == 0)
-                        draw_rect(bb, px2, py2, 2, 2, GAME_RGB(0x40, 0x58, 0x28));
+    De100Sprite   sheet_sprite = de100_sprite_make(s_map_tileset,
+                                                   sheet.width, sheet.height,
+                                                   sheet.pitch);
+    De100Tileset  tileset = de100_tileset_make(&sheet_sprite, CELL_SIZE,
+                                               CELL_SIZE);
+    de100_arena_init(&s_map_arena, sizeof(s_map_memory), s_map_memory);
+    bool ok = de100_tilemap_init(&s_map, &s_map_arena, GRID_COLS, MAP_ROWS,
+                                 &tileset, GAME_RGB(0x22, 0x22, 0x22));
+    ASSERT(ok);
+    (void)ok;
+}
+
+/* Re-derive every cell's tile; only chunks with a changed tile go stale. */
+static void map_layer_refresh(const GameState *s)
+{
+    if (!s_map.tiles) map_tileset_build();
+    s_map_anim_count = 0;
+
+    for (int r = 0; r < GRID_ROWS; r++) {
+        for (int c = 0; c < GRID_COLS; c++) {
+            int idx  = r * GRID_COLS + c;
+            int odd  = (r + c) & 1;
+            int base = odd ? MAP_BASE_ODD : MAP_BASE_EVEN;
+            int deco = MAP_DECO_NONE;
+
+            if (s->active_mod == MOD_TERRAIN) {
+                /* MOD_TERRAIN: solid terrain base colors instead of overlay */
+                if (s->terrain[idx] == CELL_MOUNTAIN) {
+                    base = odd ? MAP_BASE_MOUNTAIN_ODD : MAP_BASE_MOUNTAIN_EVEN;
+                    deco = MAP_DECO_PEAK;
+                } else if (s->terrain[idx] == CELL_SWAMP) {
+                    base = odd ? MAP_BASE_SWAMP_ODD : MAP_BASE_SWAMP_EVEN;
+                    if ((r * 7 + c * 13) % 3 == 0) deco = MAP_DECO_BUBBLES;
                 }
             }
+            if (s->grid[idx] == CELL_ENTRY) base = MAP_BASE_ENTRY;
+            if (s->grid[idx] == CELL_EXIT)  base = MAP_BASE_EXIT;
+            de100_tilemap_set(&s_map, c, r,
+                              (De100Tile)(base * MAP_DECO_COUNT + deco));
+
+            /* Water shimmers and flood water ripples: redrawn every frame */
+            int is_water = s->active_mod == MOD_TERRAIN && s->terrain[idx] == CELL_WATER &&
+                           s->grid[idx] != CELL_ENTRY && s->grid[idx] != CELL_EXIT;
+            int is_flood = s->active_mod == MOD_WEATHER && s->weather_flood[idx];
+            if (is_water || is_flood) s_map_anim[s_map_anim_count++] = (uint16_t)idx;
         }
     }
 
-    /* MOD_WEATHER: flood cells visible during rain/storm */
-    if (s->active_mod == MOD_WEATHER) {
-        for (int r = 0; r < GRID_ROWS; r++) {
-            for (int c = 0; c < GRID_COLS; c++) {
-                if (s->weather_flood[r * GRID_COLS + c]) {
-                    /* Animated flood water (slightly different shade) */
-                    uint32_t flood_col = ((r + c + (int)(s->weather_timer * 2)) & 1)
-                                         ? GAME_RGB(0x22, 0x66, 0xBB)
-                                         : GAME_RGB(0x18, 0x55, 0xAA);
-                    draw_rect(bb, c * CELL_SIZE, r * CELL_SIZE,
-                              CELL_SIZE, CELL_SIZE, flood_col);
-                }
-            }
+    s_map_layer_version = s_map_version;
+}
+
+static void map_layer_draw(const GameState *s, Backbuffer *bb)
+{
+    if (s_map_layer_version != s_map_version) map_layer_refresh(s);
+    GameBackBuffer view = de100_backbuffer_view(bb->pixels, bb->width,
+                                                bb->height, bb->pitch);
+    de100_tilemap_draw(&view, &s_map, 0, 0);
+
+    for (int k = 0; k < s_map_anim_count; k++) {
+        int idx = s_map_anim[k];
+        int r   = idx / GRID_COLS, c = idx % GRID_COLS;
+        uint32_t col;
+        if (s->weather_flood[idx]) {
+            /* Animated flood water (slightly different shade) */
+            col = ((r + c + (int)(s->weather_timer * 2)) & 1)
+                  ? GAME_RGB(0x22, 0x66, 0xBB)
+                  : GAME_RGB(0x18, 0x55, 0xAA);
+        } else {
+            /* Animated shimmer: alternate between two blues each ~1 s */
+            col = ((r + c + (int)(s->weather_timer)) & 1)
+                  ? GAME_RGB(0x22, 0x88, 0xCC)
+                  : GAME_RGB(0x11, 0x66, 0xAA);
         }
+        draw_rect(bb, c * CELL_SIZE, r * CELL_SIZE, CELL_SIZE, CELL_SIZE, col);
     }
+}
+
+/* =========================================================================
+ * PUBLIC: GAME RENDER
+ * ========================================================================= */
+
+void game_render(const GameState *s, Backbuffer *bb)
+{
+    /* Entities wholly off screen or under the side panel (opaque, drawn
+     * last, so on a higher cull layer) are skipped.  Bounds below cover
+     * every pixel each one draws. */
+    enum { CULL_LAYER_WORLD, CULL_LAYER_PANEL };
+    De100RenderCull cull;
+    de100_render_cull_begin(&cull, bb->width, bb->height, 0.0f, 0.0f, 1.0f);
+    de100_render_cull_add_occluder(&cull, PANEL_X, 0, PANEL_W, CANVAS_H,
+                                   CULL_LAYER_PANEL);
+
+    /* Streamed sprites drawn last frame may be evicted from here on */
+    sprites_begin_frame();
+
+    /* ---- Clear + grid + terrain: the cached map layer ---- */
+    map_layer_draw(s, bb);
 
     /* Night overlay (MOD_NIGHT): dark blue semi-transparent wash */
     if (s->active_mod == MOD_NIGHT) {
@@ -1611,6 +2490,16 @@ void game_render(const GameState *s, Backbuffer *bb)
                         GAME_RGBA(0xFF, 0xFF, 0xDD, alpha));
     }
 
+    /* Cells where the selected tower would seal the path */
+    if (s->selected_tower_type != TOWER_NONE) {
+        for (int i = 0; i < GRID_ROWS * GRID_COLS; i++) {
+            if (s->place_legal[i] || !cell_accepts_tower(s, i)) continue;
+            draw_rect_blend(bb, (i % GRID_COLS) * CELL_SIZE,
+                            (i / GRID_COLS) * CELL_SIZE, CELL_SIZE, CELL_SIZE,
+                            COLOR_PREVIEW_SEAL);
+        }
+    }
+
     /* Hover placement preview */
     if (s->hover_col >= 0 && s->selected_tower_type != TOWER_NONE) {
         int px = s->hover_col * CELL_SIZE;
@@ -1632,6 +2521,12 @@ void game_render(const GameState *s, Backbuffer *bb)
     for (int i = 0; i < s->tower_count; i++) {
         const Tower *t = &s->towers[i];
         if (!t->active) continue;
+        /* Cell + highlight, barrel, night glow */
+        int reach = BARREL_LEN + 1 > CELL_SIZE ? BARREL_LEN + 1 : CELL_SIZE;
+        if (!de100_render_cull_is_visible(&cull, t->cx - reach, t->cy - reach,
+                                          2 * reach, 2 * reach,
+                                          CULL_LAYER_WORLD))
+            continue;
 
         int px = t->col * CELL_SIZE;
         int py = t->row * CELL_SIZE;
@@ -1655,7 +2550,9 @@ void game_render(const GameState *s, Backbuffer *bb)
         if (t->place_flash > 0.0f)
             draw_rect(bb, px + 2, py + 2, CELL_SIZE - 4, CELL_SIZE - 4, COLOR_WHITE);
         else
-            draw_sprite(bb, s_tower_spr[t->type], px + 2, py + 2, CELL_SIZE - 4, CELL_SIZE - 4);
+            draw_sprite_rotated(bb, s_tower_spr[t->type],
+                                (float)t->cx, (float)t->cy,
+                                CELL_SIZE - 4, CELL_SIZE - 4, t->angle);
 #else
         /* Body: brief flash on placement */
         uint32_t body_col = (t->place_flash > 0.0f) ? COLOR_WHITE
@@ -1678,14 +2575,20 @@ void game_render(const GameState *s, Backbuffer *bb)
     /* ==================================================================
      * CREEPS
      * ================================================================== */
-    for (int i = 0; i < s->creep_count; i++) {
-        const Creep *c = &s->creeps[i];
-        if (!c->active) continue;
+    const CreepPool *cp = &s->creeps;
+    for (int i = 0; i < cp->count; i++) {
+        if (!cp->active[i]) continue;
 
-        int cx = (int)c->x;
-        int cy = (int)c->y;
-        int r  = CREEP_DEFS[c->type].size / 2;
+        int cx = (int)cp->x[i];
+        int cy = (int)cp->y[i];
+        int r  = CREEP_DEFS[cp->type[i]].size / 2;
         if (r < 1) r = 1;
+        /* Body, boss shield (r + 4), HP bar (CELL_SIZE wide, above) */
+        int half = r + 5 > CELL_SIZE / 2 ? r + 5 : CELL_SIZE / 2;
+        if (!de100_render_cull_is_visible(&cull, cx - half - 1, cy - half - 1,
+                                          2 * half + 2, 2 * half + 2,
+                                          CULL_LAYER_WORLD))
+            continue;
 
 #if USE_SPRITES
         /* Map CreepType (1-based) to SpriteId */
@@ -1699,20 +2602,20 @@ void game_render(const GameState *s, Backbuffer *bb)
             SPR_CREEP_SPAWN,     /* CREEP_SPAWN_CHILD */
             SPR_CREEP_BOSS,      /* CREEP_BOSS        */
         };
-        draw_sprite(bb, s_creep_spr[c->type], cx - r, cy - r, r * 2, r * 2);
+        draw_sprite(bb, s_creep_spr[cp->type[i]], cx - r, cy - r, r * 2, r * 2);
 #else
-        draw_circle(bb, cx, cy, r, CREEP_DEFS[c->type].color);
+        draw_circle(bb, cx, cy, r, CREEP_DEFS[cp->type[i]].color);
 #endif
 
         /* Status tints (applied in both modes) */
-        if (c->slow_timer  > 0.0f)
+        if (cp->slow_timer[i]  > 0.0f)
             draw_circle(bb, cx, cy, r, GAME_RGBA(0x88, 0xCC, 0xFF, 0x70));
-        if (c->stun_timer > 0.0f)
+        if (cp->stun_timer[i] > 0.0f)
             draw_circle(bb, cx, cy, r, GAME_RGBA(0xFF, 0xFF, 0x00, 0x70));
 
         /* MOD_BOSS: yellow shield outline when spawn immunity is active */
-        if (s->active_mod == MOD_BOSS && c->type == CREEP_BOSS &&
-            c->shield_timer > 0.0f) {
+        if (s->active_mod == MOD_BOSS && cp->type[i] == CREEP_BOSS &&
+            cp->shield_timer[i] > 0.0f) {
             draw_circle_outline(bb, cx, cy, r + 4, GAME_RGB(0xFF, 0xFF, 0x00));
         }
 
@@ -1721,7 +2624,7 @@ void game_render(const GameState *s, Backbuffer *bb)
         int bar_x = cx - bar_w / 2;
         int bar_y = cy - r - 5;
         draw_rect(bb, bar_x, bar_y, bar_w, 3, GAME_RGB(0x33, 0x33, 0x33));
-        float hp_ratio = (c->max_hp > 0.0f) ? (c->hp / c->max_hp) : 0.0f;
+        float hp_ratio = (cp->max_hp[i] > 0.0f) ? (cp->hp[i] / cp->max_hp[i]) : 0.0f;
         if (hp_ratio < 0.0f) hp_ratio = 0.0f;
         if (hp_ratio > 1.0f) hp_ratio = 1.0f;
         int filled = (int)((float)bar_w * hp_ratio);
@@ -1733,29 +2636,43 @@ void game_render(const GameState *s, Backbuffer *bb)
     /* ==================================================================
      * PROJECTILES  — small 4×4 dots
      * ================================================================== */
-    for (int i = 0; i < s->projectile_count; i++) {
-        const Projectile *p = &s->projectiles[i];
-        if (!p->active) continue;
+    const ProjectilePool *prj = &s->projectiles;
+    for (int i = 0; i < prj->count; i++) {
+        if (!prj->active[i]) continue;
+        if (!de100_render_cull_is_visible(&cull, (int)prj->x[i] - 4, (int)prj->y[i] - 4,
+                                          8, 8, CULL_LAYER_WORLD))
+            continue;
 #if USE_SPRITES
-        draw_sprite(bb, SPR_PROJECTILE, (int)p->x - 4, (int)p->y - 4, 8, 8);
+        draw_sprite(bb, SPR_PROJECTILE, (int)prj->x[i] - 4, (int)prj->y[i] - 4, 8, 8);
 #else
-        draw_rect(bb, (int)p->x - 2, (int)p->y - 2, 4, 4, COLOR_PROJECTILE);
+        draw_rect(bb, (int)prj->x[i] - 2, (int)prj->y[i] - 2, 4, 4, COLOR_PROJECTILE);
 #endif
     }
 
     /* ==================================================================
      * PARTICLES
      * ================================================================== */
-    for (int i = 0; i < s->particle_count; i++) {
-        const Particle *p = &s->particles[i];
-        if (!p->active) continue;
-        if (p->text[0] != '\0') {
-            draw_text(bb, (int)p->x, (int)p->y, p->text, p->color, 1);
+    const ParticlePool *pp = &s->particles;
+    for (int k = 0; k < pp->count; k++) {
+        int i = (pp->head + k) & (MAX_PARTICLES - 1);
+        float age = pp->clock - pp->born[i];
+        if (age >= pp->lifetime[i]) continue;   /* expired, not yet popped */
+        int x = (int)(pp->x0[i] + pp->vx[i] * age);
+        int y = (int)(pp->y0[i] + pp->vy[i] * age);
+        if (pp->text[i][0] != '\0') {
+            if (!de100_render_cull_is_visible(&cull, x, y, text_width(pp->text[i], 1), 8,
+                                              CULL_LAYER_WORLD))
+                continue;
+            draw_text(bb, x, y, pp->text[i], pp->color[i], 1);
         } else {
-            int half = p->size / 2;
+            int half = pp->size[i] / 2;
             if (half < 1) half = 1;
-            draw_rect(bb, (int)p->x - half, (int)p->y - half,
-                      p->size, p->size, p->color);
+            if (!de100_render_cull_is_visible(&cull, x - half, y - half,
+                                              pp->size[i], pp->size[i],
+                                              CULL_LAYER_WORLD))
+                continue;
+            draw_rect(bb, x - half, y - half,
+                      pp->size[i], pp->size[i], pp->color[i]);
         }
     }
 
@@ -1817,6 +2734,22 @@ void game_render(const GameState *s, Backbuffer *bb)
     /* Title */
     draw_text(bb, PANEL_X + 4, 5, "DTD", COLOR_WHITE, 2);
 
+    /* Fast-forward toggle; below it the speed actually reached, when the
+     * CPU can't tick fast enough for the one asked for */
+    {
+        char buf[16];
+        snprintf(buf, sizeof(buf), s->time_scale > 1 ? ">>%dx" : "%dx", s->time_scale);
+        draw_rect(bb, SPEED_BTN_X, SPEED_BTN_Y, SPEED_BTN_W, SPEED_BTN_H,
+                  s->time_scale > 1 ? COLOR_BTN_SELECTED : COLOR_BTN_NORMAL);
+        draw_text(bb, SPEED_BTN_X + 4, SPEED_BTN_Y + (SPEED_BTN_H - 8) / 2,
+                  buf, COLOR_WHITE, 1);
+        if (s->time_scale > 1 &&
+            s->effective_time_scale < (float)s->time_scale * 0.9f) {
+            snprintf(buf, sizeof(buf), "(%.1fx)", s->effective_time_scale);
+            draw_text(bb, SPEED_BTN_X + 4, 26, buf, COLOR_GOLD_TEXT, 1);
+        }
+    }
+
     /* Counters */
     {
         char buf[32];
@@ -40,6 +40,9 @@
 #  define ASSERT(expr)   do {} while (0)
 #endif
 
+/* After ASSERT: the engine's base.h keeps a host's own ASSERT */
+#include "../../../../../../engine/game/memory-arena.h"
+
 /* =========================================================================
  * CANVAS + GRID CONSTANTS
  * ========================================================================= */
@@ -60,13 +63,21 @@
 #define EXIT_COL       (GRID_COLS - 1)
 #define EXIT_ROW       9
 
+/* =========================================================================
+ * SIMULATION RATE  (see engine/platforms/_common/fixed-step.h)
+ * ========================================================================= */
+#define SIM_HZ           60    /* game_update runs in fixed 1/60 s ticks      */
+#define SIM_MAX_TICKS    4     /* per frame at 1x; a longer stall is dropped  */
+#define MAX_TIME_SCALE   8     /* fast-forward speeds: 1x, 2x, 4x, 8x         */
+
 /* =========================================================================
  * ENTITY POOL LIMITS
  * ========================================================================= */
 #define MAX_TOWERS       256
-#define MAX_CREEPS       256
+#define MAX_CREEPS       4096  /* endless mode; targeting is bucketed (game.c) */
 #define MAX_PROJECTILES  512
-#define MAX_PARTICLES    256
+#define MAX_PARTICLES    256   /* power of two: the particle ring wraps by mask */
+#define MAX_TIMERS       (MAX_TOWERS + 1)  /* a pulse per tower + wave spawn */
 
 /* =========================================================================
  * ECONOMY CONSTANTS
@@ -116,6 +127,7 @@
 #define COLOR_BTN_ERROR     GAME_RGB(0x88, 0x22, 0x22)
 #define COLOR_PREVIEW_OK    GAME_RGBA(0x00, 0xFF, 0x00, 0x60)
 #define COLOR_PREVIEW_BAD   GAME_RGBA(0xFF, 0x00, 0x00, 0x60)
+#define COLOR_PREVIEW_SEAL  GAME_RGBA(0xFF, 0x00, 0x00, 0x24)
 #define COLOR_BARREL        GAME_RGB(0xFF, 0xFF, 0xFF)
 #define COLOR_PROJECTILE    GAME_RGB(0xFF, 0xFF, 0x00)
 
@@ -262,6 +274,14 @@ typedef struct {
     int right_pressed;     /* right-click this frame */
 } MouseState;
 
+/* Stable reference to a scheduled timer (see TIMER WHEEL below) */
+typedef uint32_t TimerHandle;
+#define TIMER_HANDLE_NONE 0u
+
+/* Stable reference to a creep (see ENTITY POOLS below) */
+typedef uint32_t CreepHandle;
+#define CREEP_HANDLE_NONE 0u
+
 /* A placed tower on the grid */
 typedef struct {
     int        col, row;        /* grid cell (integer) */
@@ -270,9 +290,10 @@ typedef struct {
     float      range;           /* pixels (= range_cells * CELL_SIZE) */
     int        damage;
     float      fire_rate;       /* shots/s */
-    float      cooldown_timer;  /* seconds until next shot */
+    uint32_t   ready_tick;      /* wave tick of the next shot (standard) */
+    TimerHandle pulse_timer;    /* next AOE pulse (FROST/BASH) */
     float      angle;           /* current barrel angle (radians) */
-    int        target_id;       /* id of current target creep (-1 = none) */
+    CreepHandle target;         /* current target creep (NONE = none) */
     TargetMode target_mode;
     int        active;          /* 0 = slot empty */
     int        sell_value;      /* gold returned on sell */
@@ -280,51 +301,152 @@ typedef struct {
     int        upgrade_level;   /* 0 = base, 1 = upgraded, 2 = max */
 } Tower;
 
-/* A creep moving toward the exit */
+/* =========================================================================
+ * ENTITY POOLS  (Struct-of-Arrays, like sugar-sugar's GrainPool)
+ *
+ * Creeps and projectiles live in dense SoA columns: slots 0..count-1 are
+ * in use, kills only clear active[], and compact_*() swap the last entity
+ * into each hole once per frame.  Hot loops (projectile motion, range
+ * tests) then stream a few float columns instead of striding over whole
+ * structs, and the compiler can vectorize them.  Particles are SoA too,
+ * but analytic (see ParticlePool): nothing to integrate or compact.
+ *
+ * Dense indices move on compaction, so anything that remembers a creep
+ * across frames (tower and projectile targets) holds a CreepHandle:
+ *
+ *   handle = generation << 16 | slot        (0 = CREEP_HANDLE_NONE)
+ *   slot   -> dense index via dense_of[]    (updated by compaction)
+ *   generation bumps when a slot is recycled, so a stale handle to a dead
+ *   creep never resolves to whoever reused its slot.
+ * ========================================================================= */
+
 typedef struct {
-    float     x, y;            /* float pixel position */
-    int       col, row;        /* current integer grid cell */
-    CreepType type;
-    float     hp;
-    float     max_hp;
-    float     speed;           /* base speed px/s */
-    int       active;
-    int       id;              /* unique ID for target tracking */
-    int       is_flying;
-    float     slow_timer;      /* seconds of slow remaining */
-    float     slow_factor;     /* speed multiplier when slowed (0.5) */
-    float     stun_timer;      /* seconds of stun remaining (speed=0) */
-    float     death_timer;     /* counting-down death animation */
-    int       lives_cost;      /* lives lost if this creep exits */
-    /* Flying creep direction (unit vector) */
-    float     fly_dx, fly_dy;
-    /* MOD_BOSS fields */
-    float     shield_timer;    /* if > 0, immune to all damage (boss spawn shield) */
-    int       half_hp_spawned; /* 1 once the 50%-HP child-spawn has triggered */
-} Creep;
-
-/* A projectile in flight */
+    /* Hot: movement, targeting */
+    float       x[MAX_CREEPS], y[MAX_CREEPS];   /* float pixel position */
+    int         col[MAX_CREEPS], row[MAX_CREEPS]; /* current integer grid cell */
+    float       speed[MAX_CREEPS];              /* base speed px/s */
+    float       slow_timer[MAX_CREEPS];         /* seconds of slow remaining */
+    float       slow_factor[MAX_CREEPS];        /* speed multiplier when slowed (0.5) */
+    float       stun_timer[MAX_CREEPS];         /* seconds of stun remaining (speed=0) */
+    float       fly_dx[MAX_CREEPS], fly_dy[MAX_CREEPS]; /* flying direction (unit) */
+    uint8_t     active[MAX_CREEPS];
+
+    /* Cold: damage, rendering, bookkeeping */
+    float       hp[MAX_CREEPS];
+    float       max_hp[MAX_CREEPS];
+    uint8_t     type[MAX_CREEPS];               /* CreepType */
+    uint8_t     is_flying[MAX_CREEPS];
+    uint8_t     lives_cost[MAX_CREEPS];         /* lives lost if this creep exits */
+    float       shield_timer[MAX_CREEPS];       /* MOD_BOSS: if > 0, immune to damage */
+    uint8_t     half_hp_spawned[MAX_CREEPS];    /* MOD_BOSS: 50%-HP children spawned */
+
+    /* Handles */
+    CreepHandle handle[MAX_CREEPS];             /* dense index -> handle */
+    uint16_t    dense_of[MAX_CREEPS];           /* slot -> dense index */
+    uint16_t    generation[MAX_CREEPS];         /* per slot, never 0 once used */
+    uint16_t    free_slots[MAX_CREEPS];
+    int         free_count;
+    int         slot_count;                     /* slots ever handed out */
+
+    int         count;
+} CreepPool;
+
+typedef struct {
+    float       x[MAX_PROJECTILES], y[MAX_PROJECTILES];
+    float       vx[MAX_PROJECTILES], vy[MAX_PROJECTILES];
+    uint8_t     active[MAX_PROJECTILES];
+    int         damage[MAX_PROJECTILES];
+    float       splash_radius[MAX_PROJECTILES]; /* 0 = single target */
+    CreepHandle target[MAX_PROJECTILES];        /* NONE = no tracking */
+    uint8_t     tower_type[MAX_PROJECTILES];    /* which tower fired (damage calc) */
+    int         count;
+} ProjectilePool;
+
+/* Visual-only cosmetic particles (the engine's engine/game/particles.h
+ * ANALYTIC pool, cut down).  A particle never changes after it spawns:
+ * its position is evaluated from its age when drawn,
+ *
+ *   age = clock - born,   pos = (x0, y0) + (vx, vy) * age,
+ *
+ * so an update only advances `clock`.  Live particles form a ring in
+ * spawn order (head .. head + count - 1, mod MAX_PARTICLES); the update
+ * pops the expired ones off the front, and the draw skips any expired one
+ * still queued behind a longer-lived neighbour.  A full ring overwrites
+ * its oldest particle. */
 typedef struct {
-    float     x, y;
-    float     vx, vy;
-    int       damage;
-    float     splash_radius;   /* 0 = single target */
-    int       target_id;       /* -1 = no tracking (splash on proximity) */
-    int       active;
-    TowerType tower_type;      /* which tower fired this (for damage calc) */
-} Projectile;
-
-/* A visual-only cosmetic particle */
+    float       x0[MAX_PARTICLES], y0[MAX_PARTICLES];  /* at spawn      */
+    float       vx[MAX_PARTICLES], vy[MAX_PARTICLES];
+    float       born[MAX_PARTICLES];            /* clock at spawn        */
+    float       lifetime[MAX_PARTICLES];
+    uint32_t    color[MAX_PARTICLES];
+    int         size[MAX_PARTICLES];
+    char        text[MAX_PARTICLES][12];        /* non-empty = floating text particle */
+    int         head, count;
+    float       clock;                          /* s; restarts at 0 when empty */
+} ParticlePool;
+
+/* xoshiro128** generator state — 16 bytes, lives in GameState (see
+ * RANDOM STREAMS in game.c).  All-zero is invalid; rng_seed avoids it. */
 typedef struct {
-    float    x, y;
-    float    vx, vy;
-    float    lifetime;
-    float    max_lifetime;
-    uint32_t color;
-    int      size;
-    char     text[12];         /* non-empty = floating text particle */
-    int      active;
-} Particle;
+    uint32_t s[4];
+} Rng;
+
+/* =========================================================================
+ * TIMER WHEEL  (the engine's engine/game/timer-wheel.h, cut down)
+ *
+ * "Do X at tick T" without a countdown per owner: a timer sits in the
+ * bucket for its tick and is only touched when that bucket comes up.
+ * Ticks are 1 ms of WAVE time (the clock stops between waves, like the
+ * old per-tower cooldowns did).
+ *
+ *   level 0: 64 buckets x 1 tick      (due within 64 ms)
+ *   level 1: 64 buckets x 64 ticks    (within ~4 s)
+ *   level 2: 64 buckets x 4096 ticks  (within ~4.5 min; later = re-filed)
+ *
+ * When level 0 wraps, the next level-1 bucket is re-filed ("cascaded")
+ * into level 0, and likewise upwards.  Schedule, cancel and fire are O(1);
+ * occupied[] bitmasks make empty buckets one bit test per tick.  Due
+ * timers come out as TimerEvent data (kind + user), never callbacks.
+ * ========================================================================= */
+
+#define TIMER_HZ          1000
+#define TIMER_LEVELS      3
+#define TIMER_SLOT_BITS   6
+#define TIMER_SLOTS       (1u << TIMER_SLOT_BITS)
+#define TIMER_SLOT_MASK   (TIMER_SLOTS - 1)
+#define TIMER_SPAN        (1u << (TIMER_SLOT_BITS * TIMER_LEVELS))
+#define TIMER_NONE        0xFFFFu
+
+typedef enum {
+    TIMER_TOWER_PULSE,   /* user = tower index (FROST/BASH fire) */
+    TIMER_WAVE_SPAWN,    /* next creep of the current wave */
+} TimerKind;
+
+typedef struct {
+    uint32_t due;
+    uint16_t kind;        /* TimerKind */
+    uint16_t user;
+    uint16_t next, prev;  /* bucket links / free list, TIMER_NONE ends */
+    uint16_t generation;  /* never 0 once used */
+    uint8_t  level, slot; /* bucket while scheduled */
+} TimerNode;
+
+typedef struct {
+    uint32_t due;         /* tick it fired on (later than asked if overdue) */
+    TimerKind kind;
+    int      user;
+} TimerEvent;
+
+typedef struct {
+    uint32_t  now;                 /* last tick fully processed */
+    float     tick_frac;           /* sub-tick carry of frame dt */
+    int       count;
+    uint16_t  free_head;
+    uint64_t  occupied[TIMER_LEVELS];
+    uint16_t  head[TIMER_LEVELS][TIMER_SLOTS];
+    uint16_t  tail[TIMER_LEVELS][TIMER_SLOTS];
+    TimerNode nodes[MAX_TIMERS];
+} TimerWheel;
 
 /* Wave definition (one per wave, stored in levels.c) */
 typedef struct {
@@ -334,10 +456,39 @@ typedef struct {
     float     base_hp_override; /* 0 = use CREEP_DEFS[type].base_hp */
 } WaveDef;
 
+#define WAVE_COUNT        40
+#define MAX_SPAWN_ENTRIES 1024  /* every creep of every wave (886 today) */
+
+/* g_waves compiled into one flat list of spawns, once per game when the
+ * mod is picked (levels_compile_spawns in levels.c): the creep type, the
+ * HP with its per-wave scaling and the tick it is due are all decided
+ * there, so spawning a creep is a cursor step.  Wave w (1-based) owns
+ * entries [wave_first[w - 1], wave_first[w]), in tick order. */
+typedef struct {
+    int      wave_first[WAVE_COUNT + 1];
+    float    wave_seconds[WAVE_COUNT];  /* spawn span, for the early-send bonus */
+    uint32_t tick[MAX_SPAWN_ENTRIES];   /* wave-clock ticks after the wave starts */
+    uint8_t  type[MAX_SPAWN_ENTRIES];   /* CreepType */
+    float    hp[MAX_SPAWN_ENTRIES];
+} SpawnTable;
+
 /* =========================================================================
  * GAME STATE
  * ========================================================================= */
 
+/* Layout version of GameState, written with every saved session.  Bump it
+ * whenever a field (or anything inside one) is added, removed, resized or
+ * reordered, and teach game_restore_state to read the old layout.
+ *   1  original
+ *   2  time_scale, effective_time_scale (fast-forward)
+ *   3  frame scratch as two engine arenas (frame_memory, frame_arenas) */
+#define GAME_STATE_VERSION 3
+
+#define FRAME_ARENA_SIZE (64 * 1024)   /* bytes per frame arena */
+
+/* Pointer-free on purpose: a snapshot is a plain byte copy.  (Except the
+ * frame arenas, which point into frame_memory and are re-pointed at the
+ * copy's own bytes before use; see FRAME ARENAS in game.c.) */
 typedef struct {
     /* Phase */
     GamePhase  phase;
@@ -351,6 +502,22 @@ typedef struct {
     uint8_t    grid[GRID_ROWS * GRID_COLS];
     int        dist[GRID_ROWS * GRID_COLS];  /* BFS distance from exit */
 
+    /* Cells whose passability changed since dist[] was last repaired
+     * (see INCREMENTAL DISTANCE REPAIR in game.c).  dist_dirty[] dedups. */
+    uint8_t    dist_dirty[GRID_ROWS * GRID_COLS];
+    uint16_t   dist_dirty_cells[GRID_ROWS * GRID_COLS];
+    int        dist_dirty_count;
+
+    /* Placement legality cache (see PLACEMENT LEGALITY in game.c).
+     * seals_path[i] = 1 if a tower on cell i would cut entry from exit.
+     * Rebuilt lazily after bfs_fill_distance() clears placement_valid. */
+    uint8_t    seals_path[GRID_ROWS * GRID_COLS];
+    int        placement_valid;
+
+    /* Legal-cell overlay: filled by game_update each frame while a tower
+     * type is selected, drawn by game_render. */
+    uint8_t    place_legal[GRID_ROWS * GRID_COLS];
+
     /* MOD_TERRAIN: per-cell terrain type and pre-computed slow multiplier */
     uint8_t    terrain[GRID_ROWS * GRID_COLS];      /* CellState: CELL_WATER/MOUNTAIN/SWAMP */
     float      terrain_slow[GRID_ROWS * GRID_COLS]; /* 0.5 water, 0.25 swamp, 1.0 otherwise */
@@ -372,26 +539,24 @@ typedef struct {
     int        selected_tower_idx;  /* index into towers[] if player clicked a placed tower */
     float      shop_error_timer;    /* brief red flash when can't afford */
 
-    /* Creeps */
-    Creep      creeps[MAX_CREEPS];
-    int        creep_count;
-    int        next_creep_id;       /* incremented to give each creep a unique ID */
-
-    /* Projectiles */
-    Projectile projectiles[MAX_PROJECTILES];
-    int        projectile_count;
-
-    /* Particles */
-    Particle   particles[MAX_PARTICLES];
-    int        particle_count;
+    /* Entity pools (SoA) */
+    CreepPool      creeps;
+    ProjectilePool projectiles;
+    ParticlePool   particles;
 
     /* Wave system */
+    SpawnTable spawns;             /* this game's waves (levels_compile_spawns) */
     int        current_wave;       /* 1-based; 0 = before first wave */
     int        wave_spawn_index;   /* how many creeps have been spawned this wave */
-    float      wave_spawn_timer;   /* time until next creep spawn */
+    uint16_t   wave_slots[MAX_CREEPS]; /* creep slots held for the rest of the wave */
+    int        wave_slot_count;
+    TimerHandle wave_spawn_event;  /* next creep spawn (in timers) */
     float      wave_clear_timer;   /* countdown in WAVE_CLEAR phase */
     float      remaining_wave_time;/* used for early-send gold bonus */
 
+    /* Tower pulses and wave spawns, on the wave clock */
+    TimerWheel timers;
+
     /* Economy */
     int        player_gold;
     int        player_lives;
@@ -403,6 +568,24 @@ typedef struct {
     /* Audio */
     GameAudioState audio;
 
+    /* Random streams: one per system, so cosmetic particles never shift
+     * the gameplay sequence.  Reseeded by game_init(). */
+    Rng        rng_gameplay;
+    Rng        rng_particles;
+
+    /* Per-frame scratch (BFS queues, DFS stacks, query results): two
+     * arenas taking turns, rotated at the top of game_update (see FRAME
+     * ARENAS in game.c).  uint64_t: 8-byte aligned. */
+    uint64_t         frame_memory[2][FRAME_ARENA_SIZE / 8];
+    De100MemoryArena frame_arenas[2];
+    int              frame_current;
+
+    /* Fast-forward: the speed the panel button asks for (1/2/4/8), and
+     * the one the platform achieved — auto-capped to what the CPU can tick
+     * within the frame (the engine's fixed-step.h). */
+    int        time_scale;
+    float      effective_time_scale;
+
     /* Misc */
     int        should_quit;
 } GameState;
@@ -413,9 +596,9 @@ typedef struct {
 extern const TowerDef TOWER_DEFS[TOWER_COUNT];
 extern const CreepDef CREEP_DEFS[CREEP_COUNT];
 
-/* Wave table (defined in levels.c) */
-#define WAVE_COUNT 40
+/* Wave table and its compiler (defined in levels.c) */
 extern const WaveDef g_waves[WAVE_COUNT];
+void levels_compile_spawns(SpawnTable *table, GameMod mod);
 
 /* =========================================================================
  * GAME API (implemented in game.c)
@@ -424,12 +607,20 @@ extern const WaveDef g_waves[WAVE_COUNT];
 /* Initialise all game state (zero fill + set starting values). */
 void game_init(GameState *state);
 
-/* Advance simulation by dt seconds. */
+/* Advance simulation by one fixed tick of dt seconds (1 / SIM_HZ): the
+ * platform runs time_scale of these per rendered frame.  Mouse edges are
+ * consumed by the first tick that sees them. */
 void game_update(GameState *state, float dt);
 
 /* Draw everything to the backbuffer (pure read of state — no mutations). */
 void game_render(const GameState *state, Backbuffer *bb);
 
+/* Replace *state (already game_init'ed) with a saved snapshot of layout
+ * `version`, migrating older layouts field by field.  Returns 0 and leaves
+ * *state untouched if the layout is unknown or the size doesn't match. */
+int  game_restore_state(GameState *state, uint32_t version,
+                        const void *saved, size_t size);
+
 /* =========================================================================
  * AUDIO API (implemented in audio.c)
  * ========================================================================= */
@@ -438,7 +629,8 @@ void game_render(const GameState *state, Backbuffer *bb);
 void game_play_sound(GameAudioState *audio, SfxId id);
 void game_play_sound_at(GameAudioState *audio, SfxId id, float pan);
 
-/* Called every frame to advance music sequencer. */
+/* Called once per rendered frame, with wall-clock dt, to advance the music
+ * sequencer — not per tick, so fast-forward doesn't speed the music up. */
 void game_audio_update(GameAudioState *audio, float dt);
 
 /* Fill AudioOutputBuffer with PCM samples (called by platform audio update). */
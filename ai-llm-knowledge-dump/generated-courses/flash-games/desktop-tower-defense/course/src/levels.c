@@ -5,6 +5,8 @@
  */
 #include "game.h"
 
+#include <math.h>  /* powf */
+
 const WaveDef g_waves[WAVE_COUNT] = {
     /* Wave 1  */ [0]  = { CREEP_NORMAL,   10, 0.8f,  0 },
     /* Wave 2  */ [1]  = { CREEP_NORMAL,   12, 0.75f, 0 },
@@ -47,3 +49,37 @@ const WaveDef g_waves[WAVE_COUNT] = {
     /* Wave 39 */ [38] = { CREEP_FAST,     50, 0.3f,  0 },
     /* Wave 40 */ [39] = { CREEP_BOSS,      1, 0.0f,  10000 }, /* Final boss */
 };
+
+/* MOD_BOSS: every fifth wave is a lone boss instead */
+static const WaveDef boss_mod_wave = { CREEP_BOSS, 1, 0.5f, 0 };
+
+/* Seconds to wave ticks, at least one (as game.c's timer_ticks) */
+static uint32_t spawn_ticks(float seconds)
+{
+    uint32_t t = (uint32_t)(seconds * (float)TIMER_HZ + 0.5f);
+    return t > 0 ? t : 1;
+}
+
+void levels_compile_spawns(SpawnTable *table, GameMod mod)
+{
+    int n = 0;
+    for (int w = 0; w < WAVE_COUNT; w++) {
+        const WaveDef *wd = &g_waves[w];
+        if (mod == MOD_BOSS && (w + 1) % 5 == 0) wd = &boss_mod_wave;
+
+        float hp = wd->base_hp_override > 0.0f
+                   ? wd->base_hp_override
+                   : (float)CREEP_DEFS[wd->creep_type].base_hp
+                     * powf(HP_SCALE_PER_WAVE, (float)w);
+        uint32_t step = spawn_ticks(wd->spawn_interval);
+
+        table->wave_first[w]   = n;
+        table->wave_seconds[w] = (float)wd->count * wd->spawn_interval;
+        for (int k = 0; k < wd->count && n < MAX_SPAWN_ENTRIES; k++, n++) {
+            table->tick[n] = (uint32_t)k * step;
+            table->type[n] = (uint8_t)wd->creep_type;
+            table->hp[n]   = hp;
+        }
+    }
+    table->wave_first[WAVE_COUNT] = n;
+}
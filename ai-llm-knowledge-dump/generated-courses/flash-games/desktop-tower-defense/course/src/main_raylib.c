@@ -22,10 +22,21 @@
 
 #include "raylib.h"
 
-#include <stdlib.h>  /* malloc, free */
-#include <string.h>  /* memset       */
+#include <stdio.h>   /* fprintf        */
+#include <stdlib.h>  /* malloc, free   */
+#include <string.h>  /* memset, strcmp */
 
 #include "platform.h"
+#include "sprites.h"
+#include "utils/background-load.h"
+#include "utils/state-file.h"
+
+/* Fixed ticks + fast-forward: the engine's stepping, run by this loop */
+#include "../../../../../../engine/platforms/_common/fixed-step.h"
+
+/* Atlas hot reload: the engine's asset watcher feeds the sprites' slot */
+#include "../../../../../../engine/game/asset-reload.h"
+#include "../../../../../../engine/platforms/_common/asset-watcher.h"
 
 /* ===================================================================
  * PLATFORM GLOBALS
@@ -229,7 +240,42 @@ void platform_audio_shutdown(void) {
  * MAIN LOOP
  * =================================================================== */
 
-int main(void) {
+static void tick_game(void *user, float dt) {
+    game_update((GameState *)user, dt);
+}
+
+/* Saved atlas files reload in place (sprites_set_reload_host): watched by
+ * the engine's asset watcher, decoded on our background loader */
+static const De100AssetReloadHost g_reload_host = {
+    .watcher                = &g_asset_watcher,
+    .asset_watch            = asset_watcher_watch,
+    .asset_watch_version    = asset_watcher_version,
+    .background_loader      = NULL,
+    .background_load_submit = background_load_platform_submit,
+};
+
+/* --session FILE: resume the soak session saved there (older GameState
+ * layouts are migrated, see game_restore_state) and save it back on quit */
+static const char *session_path(int argc, char **argv) {
+    for (int i = 1; i + 1 < argc; i++)
+        if (strcmp(argv[i], "--session") == 0) return argv[i + 1];
+    return NULL;
+}
+
+static void session_restore(GameState *state, const char *path) {
+    uint32_t version;
+    size_t   size;
+    void    *saved = state_file_load(path, &version, &size);
+    if (!saved) return;
+    if (!game_restore_state(state, version, saved, size))
+        fprintf(stderr, "%s: GameState layout %u not restorable, starting fresh\n",
+                path, (unsigned)version);
+    free(saved);
+}
+
+int main(int argc, char **argv) {
+    const char *session = session_path(argc, argv);
+
     static GameState state;
     static Backbuffer bb;
 
@@ -242,7 +288,16 @@ int main(void) {
 
     platform_init("Desktop Tower Defense", CANVAS_W, CANVAS_H);
     platform_audio_init(&state, AUDIO_SAMPLE_RATE);
+    sprites_set_reload_host(&g_reload_host);
     game_init(&state);
+    if (session) session_restore(&state, session);
+
+    /* The platform's mouse: edge detection needs last frame's state */
+    static MouseState mouse;
+
+    /* Ticks may use half the 60 fps frame; render, audio and present the rest */
+    De100FixedStep step;
+    de100_fixed_step_init(&step, SIM_HZ, SIM_MAX_TICKS, 0.5 / 60.0);
 
     double prev_time = platform_get_time();
 
@@ -254,15 +309,29 @@ int main(void) {
         /* Cap delta-time: prevent physics explosion after debugger pauses */
         if (dt > 0.1f) dt = 0.1f;
 
-        platform_get_input(&state.mouse);
-        game_update(&state, dt);
+        platform_get_input(&mouse);
+        platform_latch_mouse(&state.mouse, &mouse);
+
+        /* Fixed ticks, time_scale of them per frame when fast-forwarding
+         * (auto-capped to the tick budget); music runs on wall time */
+        de100_fixed_step_run(&step, dt, (float)state.time_scale, tick_game,
+                             &state, platform_get_time);
+        state.effective_time_scale = step.effective_time_scale;
+        game_audio_update(&state.audio, dt);
+
         game_render(&state, &bb);
         platform_display_backbuffer(&bb);
         platform_audio_update(&state);
     }
 
     /* Cleanup */
+    if (session && !state_file_save(session, GAME_STATE_VERSION, &state, sizeof(state)))
+        fprintf(stderr, "%s: could not save session\n", session);
     platform_audio_shutdown();
+    sprites_shutdown();
+    sprites_set_reload_host(NULL);
+    background_load_shutdown();
+    asset_watcher_shutdown(&g_asset_watcher);
     UnloadTexture(g_texture);
     CloseWindow();
     free(bb.pixels);
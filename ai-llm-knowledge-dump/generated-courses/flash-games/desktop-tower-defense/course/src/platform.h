@@ -24,6 +24,24 @@
         (was_down) = (is_down_now);                              \
     } while (0)
 
+/* -------------------------------------------------------------------------
+ * platform_latch_mouse — hand this frame's mouse to the game.
+ * Position and held state are replaced; edges are OR-ed in, because a frame
+ * can run no fixed tick at all (the engine's fixed-step.h) and a click must
+ * then wait for the next one.  game_update clears the edges it consumed.
+ * -------------------------------------------------------------------------*/
+static inline void platform_latch_mouse(MouseState *game, const MouseState *frame)
+{
+    game->x              = frame->x;
+    game->y              = frame->y;
+    game->prev_x         = frame->prev_x;
+    game->prev_y         = frame->prev_y;
+    game->left_down      = frame->left_down;
+    game->left_pressed  |= frame->left_pressed;
+    game->left_released |= frame->left_released;
+    game->right_pressed |= frame->right_pressed;
+}
+
 /* Open a window of the given pixel dimensions with the given title.
  * Allocates and initialises the pixel backbuffer. */
 void platform_init(const char *title, int width, int height);
@@ -32,7 +50,8 @@ void platform_init(const char *title, int width, int height);
 double platform_get_time(void);
 
 /* Read OS input events; fill *mouse with the current mouse state.
- * Must be called once per frame, before game_update(). */
+ * Must be called once per frame, on the platform's own MouseState (edge
+ * detection needs last frame's), then platform_latch_mouse() into the game. */
 void platform_get_input(MouseState *mouse);
 
 /* Upload bb->pixels to the GPU and flip the display.
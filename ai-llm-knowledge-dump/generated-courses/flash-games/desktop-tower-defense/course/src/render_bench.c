@@ -0,0 +1,296 @@
+/* src/render_bench.c  —  Desktop Tower Defense | Render Benchmark
+ *
+ * Build & run:  ./build-dev.sh --backend=render-bench -r
+ *               ./build/render-bench [frames] [seed]
+ *
+ * For each backbuffer size (320x240 .. 3840x2160), each overdraw level
+ * (every pixel covered 1x / 4x on average) and each primitive:
+ *
+ *   rect            draw_rect, opaque
+ *   rect_blend      draw_rect_blend, alpha 128
+ *   text            draw_text, short panel strings at scale 1
+ *   sprite          draw_sprite, 16x16 atlas cell scaled to a CELL_SIZE tile
+ *   sprite_rotated  draw_sprite_rotated, CELL_SIZE - 4 at a random angle
+ *
+ * draws `frames` frames of the same scene and prints Mpix/s and cycles/px
+ * (__rdtsc ticks: compare runs on one machine only) from the fastest frame,
+ * plus an FNV-1a checksum of the frame.  Same seed ⇒ same checksum, so a
+ * drawing change that alters output shows up in the diff.
+ *
+ * No atlas PNG ships with the course, so the sprites blit from a generated
+ * 256x256 one handed to sprites_init_pixels(): every 16x16 cell a disc
+ * with a translucent rim on a transparent ground — opaque, blended and
+ * skipped spans, like a real atlas.  Pixels are what each call nominally
+ * covers: the rect or destination box, or an 8x8 box per glyph.
+ */
+#define _POSIX_C_SOURCE 199309L   /* clock_gettime under -std=c99 */
+#include "game.h"
+#include "sprites.h"
+#include "utils/draw-shapes.h"
+#include "utils/draw-text.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>   /* __rdtsc() */
+#endif
+
+#define BENCH_ATLAS_SIZE 256
+#define BENCH_CELL       16
+
+typedef enum {
+    BENCH_RECT = 0,
+    BENCH_RECT_BLEND,
+    BENCH_TEXT,
+    BENCH_SPRITE,
+    BENCH_SPRITE_ROTATED,
+    BENCH_PRIM_COUNT
+} BenchPrimitive;
+
+static const char *bench_prim_names[BENCH_PRIM_COUNT] = {
+    "rect", "rect_blend", "text", "sprite", "sprite_rotated"
+};
+
+static const int bench_sizes[][2] = {
+    { 320, 240 }, { 640, 480 }, { 1280, 720 }, { 1920, 1080 }, { 3840, 2160 }
+};
+
+static const int bench_overdraws[] = { 1, 4 };
+
+static const char *bench_strings[] = {
+    "Gold: 120", "Lives: 20", "Wave 14", "SELL 75", "Pellet"
+};
+
+typedef struct {
+    int         x, y;
+    uint32_t    color;
+    const char *text;
+    SpriteId    sprite;
+    float       angle;
+} BenchItem;
+
+static uint32_t bench_rand(uint32_t *state)
+{
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return *state = x;
+}
+
+static double bench_seconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static uint64_t bench_cycles(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return 0;   /* cycles/px reads 0: no counter on this target */
+#endif
+}
+
+static uint32_t bench_checksum(const Backbuffer *bb)
+{
+    uint32_t hash = 2166136261u;
+    for (int y = 0; y < bb->height; y++) {
+        const uint8_t *row = (const uint8_t *)bb->pixels + y * bb->pitch;
+        for (int i = 0; i < bb->width * 4; i++)
+            hash = (hash ^ row[i]) * 16777619u;
+    }
+    return hash;
+}
+
+/* Premultiplied 0xAARRGGBB: a radius-7 disc per cell with an alpha-128
+ * rim, transparent outside. */
+static void bench_build_atlas(uint32_t *pix)
+{
+    for (int y = 0; y < BENCH_ATLAS_SIZE; y++) {
+        for (int x = 0; x < BENCH_ATLAS_SIZE; x++) {
+            int   cell = (y / BENCH_CELL) * (BENCH_ATLAS_SIZE / BENCH_CELL) + x / BENCH_CELL;
+            float dx   = (float)(x % BENCH_CELL) - 7.5f;
+            float dy   = (float)(y % BENCH_CELL) - 7.5f;
+            float d    = sqrtf(dx * dx + dy * dy);
+            uint32_t r = (uint32_t)(cell * 37) & 0xFF, g = (uint32_t)(cell * 91) & 0xFF;
+            uint32_t b = (uint32_t)(cell * 53) & 0xFF;
+            if (d < 6.5f)
+                pix[y * BENCH_ATLAS_SIZE + x] = GAME_RGBA(r, g, b, 0xFF);
+            else if (d < 7.5f)
+                pix[y * BENCH_ATLAS_SIZE + x] = GAME_RGBA(r / 2, g / 2, b / 2, 0x80);
+            else
+                pix[y * BENCH_ATLAS_SIZE + x] = 0;
+        }
+    }
+}
+
+static long long bench_text_pixels(const char *text)
+{
+    long long glyphs = 0;
+    for (; *text; text++)
+        if (*text != ' ') glyphs++;
+    return glyphs * 8 * 8;
+}
+
+/* Items until they nominally cover overdraw × buffer; all fully on-screen */
+static int bench_build_scene(BenchPrimitive prim, int width, int height,
+                             int overdraw, uint32_t seed, BenchItem *items,
+                             int max_items, long long *out_pixels)
+{
+    long long target = (long long)width * height * overdraw;
+    long long pixels = 0;
+    int count = 0;
+
+    while (pixels < target && count < max_items) {
+        BenchItem *item = &items[count];
+        item->color  = GAME_RGBA(bench_rand(&seed) & 0xFF, bench_rand(&seed) & 0xFF,
+                                 bench_rand(&seed) & 0xFF,
+                                 prim == BENCH_RECT_BLEND ? 128 : 255);
+        item->text   = bench_strings[bench_rand(&seed) % 5];
+        item->sprite = (SpriteId)(bench_rand(&seed) % SPR_MISSING);
+        item->angle  = (float)(bench_rand(&seed) % 6283) / 1000.0f;
+
+        int item_w, item_h;
+        switch (prim) {
+        case BENCH_TEXT:
+            item_w  = text_width(item->text, 1);
+            item_h  = 8;
+            pixels += bench_text_pixels(item->text);
+            break;
+        case BENCH_SPRITE:
+            item_w  = item_h = CELL_SIZE;
+            pixels += (long long)CELL_SIZE * CELL_SIZE;
+            break;
+        case BENCH_SPRITE_ROTATED:
+            item_w  = item_h = CELL_SIZE;   /* the rotated box stays inside */
+            pixels += (long long)(CELL_SIZE - 4) * (CELL_SIZE - 4);
+            break;
+        default:
+            item_w  = width / 8;
+            item_h  = height / 8;
+            pixels += (long long)item_w * item_h;
+            break;
+        }
+        item->x = (int)(bench_rand(&seed) % (uint32_t)(width  - item_w + 1));
+        item->y = (int)(bench_rand(&seed) % (uint32_t)(height - item_h + 1));
+        count++;
+    }
+
+    *out_pixels = pixels;
+    return count;
+}
+
+static void bench_draw(BenchPrimitive prim, Backbuffer *bb,
+                       const BenchItem *items, int count)
+{
+    int rect_w = bb->width / 8, rect_h = bb->height / 8;
+    for (int i = 0; i < count; i++) {
+        const BenchItem *item = &items[i];
+        switch (prim) {
+        case BENCH_RECT:
+            draw_rect(bb, item->x, item->y, rect_w, rect_h, item->color);
+            break;
+        case BENCH_RECT_BLEND:
+            draw_rect_blend(bb, item->x, item->y, rect_w, rect_h, item->color);
+            break;
+        case BENCH_TEXT:
+            draw_text(bb, item->x, item->y, item->text, item->color, 1);
+            break;
+        case BENCH_SPRITE:
+            draw_sprite(bb, item->sprite, item->x, item->y, CELL_SIZE, CELL_SIZE);
+            break;
+        default:
+            draw_sprite_rotated(bb, item->sprite,
+                                (float)(item->x + CELL_SIZE / 2),
+                                (float)(item->y + CELL_SIZE / 2),
+                                CELL_SIZE - 4, CELL_SIZE - 4, item->angle);
+            break;
+        }
+    }
+}
+
+int main(int argc, char **argv)
+{
+    int      frames = argc > 1 ? atoi(argv[1]) : 10;
+    uint32_t seed   = argc > 2 ? (uint32_t)strtoul(argv[2], NULL, 10) : 1;
+    if (seed == 0) seed = 1;   /* xorshift's only fixed point */
+    if (frames <= 0) frames = 10;
+
+    int size_count = (int)(sizeof(bench_sizes) / sizeof(bench_sizes[0]));
+    int max_width  = bench_sizes[size_count - 1][0];
+    int max_height = bench_sizes[size_count - 1][1];
+    /* Smallest item is a 5-glyph string: 320 px */
+    int max_items  = max_width * max_height * 4 / 256;
+
+    BenchItem *items  = malloc(sizeof(BenchItem) * (size_t)max_items);
+    uint32_t  *pixels = malloc(sizeof(uint32_t) * (size_t)max_width * max_height);
+    uint32_t  *atlas  = malloc(sizeof(uint32_t) * BENCH_ATLAS_SIZE * BENCH_ATLAS_SIZE);
+    if (!items || !pixels || !atlas) {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+    bench_build_atlas(atlas);
+    if (!sprites_init_pixels(atlas, BENCH_ATLAS_SIZE, BENCH_ATLAS_SIZE)) return 1;
+
+    printf("%d frames per case (fastest kept), seed %u\n\n", frames, seed);
+    printf("%-10s %8s %-15s %12s %10s %10s\n", "size", "overdraw", "primitive",
+           "Mpix/s", "cycles/px", "checksum");
+
+    int overdraw_count = (int)(sizeof(bench_overdraws) / sizeof(bench_overdraws[0]));
+    for (int s = 0; s < size_count; s++) {
+        Backbuffer bb = {
+            .pixels = pixels,
+            .width  = bench_sizes[s][0],
+            .height = bench_sizes[s][1],
+            .pitch  = bench_sizes[s][0] * 4,
+        };
+        char size_name[16];
+        snprintf(size_name, sizeof(size_name), "%dx%d", bb.width, bb.height);
+
+        for (int o = 0; o < overdraw_count; o++) {
+            for (int prim = 0; prim < BENCH_PRIM_COUNT; prim++) {
+                long long scene_pixels = 0;
+                int count = bench_build_scene((BenchPrimitive)prim, bb.width, bb.height,
+                                              bench_overdraws[o], seed, items,
+                                              max_items, &scene_pixels);
+
+                double   best_seconds = 1e30;
+                uint64_t best_cycles  = UINT64_MAX;
+                uint32_t checksum     = 0;
+                for (int frame = 0; frame < frames; frame++) {
+                    /* Same starting frame every time, so the checksum is stable */
+                    memset(pixels, 0x20, (size_t)bb.pitch * bb.height);
+
+                    double   start        = bench_seconds();
+                    uint64_t start_cycles = bench_cycles();
+                    bench_draw((BenchPrimitive)prim, &bb, items, count);
+                    uint64_t cycles  = bench_cycles() - start_cycles;
+                    double   seconds = bench_seconds() - start;
+
+                    if (seconds < best_seconds) best_seconds = seconds;
+                    if (cycles  < best_cycles)  best_cycles  = cycles;
+                    if (frame == 0) checksum = bench_checksum(&bb);
+                }
+                if (best_seconds <= 0.0) best_seconds = 1e-9;
+
+                printf("%-10s %7dx %-15s %12.1f %10.2f %10u\n", size_name,
+                       bench_overdraws[o], bench_prim_names[prim],
+                       (double)scene_pixels / best_seconds * 1e-6,
+                       (double)best_cycles / (double)scene_pixels, checksum);
+            }
+        }
+    }
+
+    sprites_shutdown();
+    free(atlas);
+    free(pixels);
+    free(items);
+    return 0;
+}
@@ -2,11 +2,16 @@
  *
  * How it works:
  *   sprites_init(path)        — synchronous load (or placeholder if path==NULL)
- *   sprites_load_async(path)  — background pthread load; game keeps running
+ *   sprites_init_pixels(...)  — synchronous, from an atlas already in memory
+ *   sprites_load_async(path)  — decoded on a loader thread (utils/
+ *                               background-load.h); game keeps running
+ *   sprites_stream_init(dir)  — one PNG per sprite, streamed on first draw
+ *                               into a fixed budget (the engine's
+ *                               engine/game/asset-stream.h)
  *
  * On any load failure:
- *   - g_sprite_atlas.load_state = SPRITE_LOAD_ERROR
- *   - g_sprite_atlas.error_msg  = human-readable error
+ *   - g_sprite_atlas->load_state = SPRITE_LOAD_ERROR
+ *   - g_sprite_atlas->error_msg  = human-readable error
  *   - fprintf(stderr, "[SPRITES] ...")  — logged for debugging
  *   - draw_sprite() falls back to placeholder rects so the game remains playable
  *
@@ -30,10 +35,18 @@
 #pragma clang diagnostic pop
 
 #include "sprites.h"
+#include "utils/background-load.h"
 #include "utils/draw-shapes.h"
 #include "utils/draw-text.h"
 
-#include <pthread.h>
+/* Watched atlas file: reload slot, decoded on our loader, swapped by
+ * sprites_begin_frame() */
+#include "../../../../../../engine/game/asset-reload.h"
+
+/* Streamed mode: the engine's LRU budget, each sprite decoded on our loader */
+#include "../../../../../../engine/game/asset-stream.h"
+
+#include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -42,7 +55,10 @@
  * GLOBALS
  * ========================================================================= */
 
-SpriteAtlas g_sprite_atlas = {0};
+/* The live atlas draws come from, and the spare a hot reload decodes
+ * into (see HOT RELOAD) */
+static SpriteAtlas s_atlas_buffers[2];
+SpriteAtlas *g_sprite_atlas = &s_atlas_buffers[0];
 
 /* Placeholder colors mirror the COLOR_* constants in game.h.
  * src_x / src_y describe where this sprite lives in a 256×256 atlas
@@ -74,129 +90,449 @@ const SpriteDef SPRITE_DEFS[SPR_COUNT] = {
     [SPR_MISSING]              = {   0,  0, 16, 16, GAME_RGB(0xFF,0x00,0xFF), "???"  },
 };
 
+/* File per sprite for streamed mode: <dir>/<name>.png, src_w x src_h */
+static const char *const SPRITE_FILES[SPR_COUNT] = {
+    [SPR_TOWER_PELLET]         = "tower_pellet",
+    [SPR_TOWER_SQUIRT]         = "tower_squirt",
+    [SPR_TOWER_DART]           = "tower_dart",
+    [SPR_TOWER_SNAP]           = "tower_snap",
+    [SPR_TOWER_SWARM]          = "tower_swarm",
+    [SPR_TOWER_FROST]          = "tower_frost",
+    [SPR_TOWER_BASH]           = "tower_bash",
+    [SPR_CREEP_NORMAL]         = "creep_normal",
+    [SPR_CREEP_FAST]           = "creep_fast",
+    [SPR_CREEP_FLYING]         = "creep_flying",
+    [SPR_CREEP_ARMOURED]       = "creep_armoured",
+    [SPR_CREEP_SPAWN]          = "creep_spawn",
+    [SPR_CREEP_BOSS]           = "creep_boss",
+    [SPR_PROJECTILE]           = "projectile",
+    [SPR_EXPLOSION]            = "explosion",
+    [SPR_BACKGROUND_TILE_EVEN] = "tile_even",
+    [SPR_BACKGROUND_TILE_ODD]  = "tile_odd",
+    [SPR_MISSING]              = NULL,
+};
+
 /* =========================================================================
  * ASYNC LOADING
  * ========================================================================= */
 
-/* Path stored for the background thread — enough for any filesystem path */
-static char g_async_path[512] = {0};
+/* Path stored for the loader thread — enough for any filesystem path */
+static char g_async_path[SPRITE_PATH_MAX] = {0};
+
+/* Runs can't outnumber half the pixels, rounded up */
+static size_t span_capacity(int w, int h)
+{
+    size_t cap = ((size_t)w + 1) / 2 * (size_t)h;
+    return cap ? cap : 1;
+}
 
-/* Marks when the background thread is finished (success or failure).
- * Written only by the thread; read only by the main thread after thread joins
- * or via sprites_is_ready(). Using volatile to avoid optimizer removing reads. */
-static volatile int g_load_done = 0;
-static pthread_t    g_load_thread;
-static int          g_thread_started = 0;
+/* stb_image RGBA → premultiplied 0xAARRGGBB (the same format the
+ * backbuffer and game.h colors use, with color scaled by alpha so
+ * blending is one multiply per channel). */
+static void premultiply_rgba(const uint8_t *src, uint32_t *dst, int pixel_count)
+{
+    for (int i = 0; i < pixel_count; i++, src += 4) {
+        uint32_t a = src[3];
+        dst[i] = GAME_RGBA((src[0] * a + 127) / 255, (src[1] * a + 127) / 255,
+                           (src[2] * a + 127) / 255, a);
+    }
+}
 
-/* Attempt to load the atlas PNG.  Runs on the background thread. */
-static void *load_thread_fn(void *arg)
+/* Record every row's runs of non-transparent pixels (spans / row_spans,
+ * span_capacity() and h + 1 entries) so the blits skip transparent pixels
+ * without looking at them. */
+static void build_spans(const uint32_t *pix, int w, int h,
+                        AtlasSpan *spans, int *row_spans)
+{
+    int n = 0;
+    for (int y = 0; y < h; y++) {
+        const uint32_t *row = pix + (size_t)y * w;
+        row_spans[y] = n;
+        for (int x = 0; x < w;) {
+            if ((row[x] >> 24) == 0) { x++; continue; }
+            AtlasSpan *sp = &spans[n++];
+            sp->x0    = (uint16_t)x;
+            sp->blend = 0;
+            for (; x < w && (row[x] >> 24) != 0; x++)
+                if ((row[x] >> 24) != 0xFF) sp->blend = 1;
+            sp->x1 = (uint16_t)x;
+        }
+    }
+    row_spans[h] = n;
+}
+
+/* build_spans() into `atlas`.  Returns 0 when out of memory. */
+static int atlas_build_spans(SpriteAtlas *atlas, const uint32_t *pix,
+                             int w, int h)
+{
+    AtlasSpan *spans = (AtlasSpan *)malloc(span_capacity(w, h) * sizeof(AtlasSpan));
+    int *row_spans   = (int *)malloc(((size_t)h + 1) * sizeof(int));
+    if (!spans || !row_spans) {
+        free(spans);
+        free(row_spans);
+        return 0;
+    }
+    build_spans(pix, w, h, spans, row_spans);
+
+    atlas->spans     = spans;
+    atlas->row_spans = row_spans;
+    return 1;
+}
+
+/* Free what a load put in `atlas` and empty it */
+static void atlas_free(SpriteAtlas *atlas)
+{
+    free(atlas->pixels);
+    free(atlas->spans);
+    free(atlas->row_spans);
+    memset(atlas, 0, sizeof(*atlas));
+}
+
+/* Decode the atlas PNG at `path` into the empty `atlas`.  Runs on a
+ * loader thread for sprites_load_async() and hot reloads, inline for
+ * sprites_init().  The atlas is only published (loaded = 1) if `task`
+ * wasn't cancelled meanwhile; on failure `atlas` keeps no memory. */
+static int atlas_decode(SpriteAtlas *atlas, const char *path,
+                        const De100BackgroundLoad *task)
 {
-    const char *path = (const char *)arg;
     int w, h, channels;
     uint8_t *data = stbi_load(path, &w, &h, &channels, 4); /* force RGBA */
 
     if (!data) {
         const char *reason = stbi_failure_reason();
-        snprintf(g_sprite_atlas.error_msg, sizeof(g_sprite_atlas.error_msg),
+        snprintf(atlas->error_msg, sizeof(atlas->error_msg),
                  "stbi_load(\"%s\") failed: %s", path, reason ? reason : "unknown");
-        fprintf(stderr, "[SPRITES] ERROR: %s\n", g_sprite_atlas.error_msg);
-        g_sprite_atlas.load_state = SPRITE_LOAD_ERROR;
-    } else {
-        /* stb_image returns RGBA uint8_t; convert to 0xAARRGGBB uint32_t
-         * (the same format the backbuffer and game.h colors use). */
-        int pixel_count = w * h;
-        uint32_t *pix = (uint32_t *)malloc((size_t)pixel_count * sizeof(uint32_t));
-        if (!pix) {
-            snprintf(g_sprite_atlas.error_msg, sizeof(g_sprite_atlas.error_msg),
-                     "Out of memory allocating atlas (%d×%d)", w, h);
-            fprintf(stderr, "[SPRITES] ERROR: %s\n", g_sprite_atlas.error_msg);
-            stbi_image_free(data);
-            g_sprite_atlas.load_state = SPRITE_LOAD_ERROR;
-        } else {
-            const uint8_t *src = data;
-            for (int i = 0; i < pixel_count; i++, src += 4) {
-                pix[i] = GAME_RGBA(src[0], src[1], src[2], src[3]);
-            }
-            stbi_image_free(data);
-
-            g_sprite_atlas.pixels     = pix;
-            g_sprite_atlas.width      = w;
-            g_sprite_atlas.height     = h;
-            g_sprite_atlas.loaded     = 1;
-            g_sprite_atlas.load_state = SPRITE_LOAD_READY;
-            fprintf(stderr, "[SPRITES] Loaded atlas: %s (%d×%d)\n", path, w, h);
-        }
+        fprintf(stderr, "[SPRITES] ERROR: %s\n", atlas->error_msg);
+        atlas->load_state = SPRITE_LOAD_ERROR;
+        return 0;
+    }
+
+    /* stb_image returns RGBA uint8_t; convert to premultiplied 0xAARRGGBB */
+    int pixel_count = w * h;
+    uint32_t *pix = (uint32_t *)malloc((size_t)pixel_count * sizeof(uint32_t));
+    if (!pix) {
+        snprintf(atlas->error_msg, sizeof(atlas->error_msg),
+                 "Out of memory allocating atlas (%d×%d)", w, h);
+        fprintf(stderr, "[SPRITES] ERROR: %s\n", atlas->error_msg);
+        stbi_image_free(data);
+        atlas->load_state = SPRITE_LOAD_ERROR;
+        return 0;
+    }
+    premultiply_rgba(data, pix, pixel_count);
+    stbi_image_free(data);
+
+    if (!atlas_build_spans(atlas, pix, w, h)) {
+        snprintf(atlas->error_msg, sizeof(atlas->error_msg),
+                 "Out of memory building atlas spans (%d×%d)", w, h);
+        fprintf(stderr, "[SPRITES] ERROR: %s\n", atlas->error_msg);
+        atlas->load_state = SPRITE_LOAD_ERROR;
+        free(pix);
+        return 0;
+    }
+
+    if (de100_background_load_should_cancel(task)) {
+        free(pix);
+        atlas_free(atlas);
+        return 0;
+    }
+
+    atlas->pixels     = pix;
+    atlas->width      = w;
+    atlas->height     = h;
+    atlas->load_state = SPRITE_LOAD_READY;
+    __atomic_store_n(&atlas->loaded, 1, __ATOMIC_RELEASE);
+    fprintf(stderr, "[SPRITES] Loaded atlas: %s (%d×%d)\n", path, w, h);
+    return 1;
+}
+
+static DE100_BACKGROUND_LOAD_CALLBACK(decode_atlas)
+{
+    (void)thread_context;
+    return atlas_decode(&s_atlas_buffers[0], (const char *)task->data, task);
+}
+
+static De100BackgroundLoad g_atlas_load = { decode_atlas, g_async_path, 0, 0 };
+
+/* =========================================================================
+ * HOT RELOAD
+ *
+ * A file-loaded atlas is watched through the engine's reload slot
+ * (engine/game/asset-reload.h) once the platform hands us a host: saving
+ * the PNG decodes it again into the spare buffer on a loader thread, and
+ * sprites_begin_frame() makes that the live atlas before anything draws.
+ * A save that fails to decode keeps the atlas on screen.
+ * ========================================================================= */
+
+static const De100AssetReloadHost *g_reload_host;
+static De100AssetReload            g_atlas_reload;
+static int                         g_atlas_watched;
+
+static DE100_BACKGROUND_LOAD_CALLBACK(reload_atlas)
+{
+    (void)thread_context;
+    De100AssetReload *slot  = (De100AssetReload *)task->data;
+    SpriteAtlas      *atlas = (SpriteAtlas *)de100_asset_reload_staging(slot);
+    memset(atlas, 0, sizeof(*atlas));  /* a failed decode's error_msg */
+    return atlas_decode(atlas, slot->path, task) != 0;
+}
+
+/* Main thread, right after the swap: the atlas that was live */
+static DE100_ASSET_RELOAD_RELEASE(release_atlas)
+{
+    atlas_free((SpriteAtlas *)retired);
+}
+
+/* =========================================================================
+ * STREAMED MODE
+ *
+ * Each sprite's block in the budget: its premultiplied pixels, then its
+ * row_spans and spans — everything blit_sprite() needs, in one asset.
+ * ========================================================================= */
+
+static struct {
+    De100AssetStream stream;
+    GameMemory       memory;   /* only the loader: background_load_submit */
+    char             dir[SPRITE_PATH_MAX];
+    int              active;
+} g_sprite_stream;
+
+/* The budget, plus the stream's per-sprite tables and their alignment */
+#define SPRITE_STREAM_ARENA_SIZE                                          \
+    (SPRITE_STREAM_BUDGET +                                               \
+     SPR_COUNT * (sizeof(uint16_t) + sizeof(uint64_t)) + 4 * DE100_PAK_ALIGNMENT)
+
+static uint8_t g_sprite_stream_storage[SPRITE_STREAM_ARENA_SIZE]
+    __attribute__((aligned(DE100_PAK_ALIGNMENT)));
+
+static size_t streamed_sprite_size(const SpriteDef *def)
+{
+    return (size_t)def->src_w * (size_t)def->src_h * sizeof(uint32_t) +
+           ((size_t)def->src_h + 1) * sizeof(int) +
+           span_capacity(def->src_w, def->src_h) * sizeof(AtlasSpan);
+}
+
+/* An atlas made of one streamed sprite, laid out as above */
+static void streamed_sprite_view(const SpriteDef *def, const void *block,
+                                 SpriteAtlas *view)
+{
+    uint32_t *pix = (uint32_t *)block;
+    int *row_spans = (int *)(pix + def->src_w * def->src_h);
+    view->pixels    = pix;
+    view->width     = def->src_w;
+    view->height    = def->src_h;
+    view->row_spans = row_spans;
+    view->spans     = (AtlasSpan *)(row_spans + def->src_h + 1);
+}
+
+/* Loader thread: decode <dir>/<name>.png into the sprite's block */
+static DE100_ASSET_STREAM_LOAD(decode_streamed_sprite)
+{
+    (void)thread_context;
+    (void)size;
+    (void)user;
+    const SpriteDef *def = &SPRITE_DEFS[id];
+    char path[SPRITE_PATH_MAX + 64];
+    snprintf(path, sizeof(path), "%s/%s.png", g_sprite_stream.dir, SPRITE_FILES[id]);
+
+    int w, h, channels;
+    uint8_t *data = stbi_load(path, &w, &h, &channels, 4); /* force RGBA */
+    if (!data) {
+        const char *reason = stbi_failure_reason();
+        fprintf(stderr, "[SPRITES] ERROR: stbi_load(\"%s\") failed: %s\n",
+                path, reason ? reason : "unknown");
+        return 0;
     }
+    if (w != def->src_w || h != def->src_h) {
+        fprintf(stderr, "[SPRITES] ERROR: %s is %d×%d, expected %d×%d\n",
+                path, w, h, def->src_w, def->src_h);
+        stbi_image_free(data);
+        return 0;
+    }
+
+    SpriteAtlas view;
+    streamed_sprite_view(def, destination, &view);
+    premultiply_rgba(data, view.pixels, w * h);
+    stbi_image_free(data);
+    build_spans(view.pixels, w, h, view.spans, view.row_spans);
+    return 1;
+}
+
+/* Streamed sprite `id` as an atlas view.  0 while it streams in; *failed
+ * is set if it never will. */
+static int stream_sprite(SpriteId id, SpriteAtlas *view, int *failed)
+{
+    const SpriteDef *def = &SPRITE_DEFS[id];
+    const void *block = de100_asset_stream_get(&g_sprite_stream.stream,
+                                               &g_sprite_stream.memory,
+                                               (u32)id, NULL);
+    *failed = de100_asset_stream_state(&g_sprite_stream.stream, (u32)id) ==
+              DE100_ASSET_STREAM_SLOT_FAILED;
+    if (!block) return 0;
+    streamed_sprite_view(def, block, view);
+    return 1;
+}
 
-    g_load_done = 1;
-    return NULL;
+static void stream_reset(void)
+{
+    if (g_sprite_stream.active)
+        de100_asset_stream_flush(&g_sprite_stream.stream, &g_sprite_stream.memory);
+    g_sprite_stream.active = 0;
 }
 
 /* =========================================================================
  * LIFECYCLE
  * ========================================================================= */
 
+/* Stop any load in flight and free the atlas it (or an earlier one) made,
+ * and leave streamed mode */
+static void atlas_reset(void)
+{
+    stream_reset();
+    de100_background_load_cancel(&g_atlas_load);
+    background_load_wait(&g_atlas_load);
+    de100_asset_reload_cancel(&g_atlas_reload);
+    background_load_wait(&g_atlas_reload.load);
+    atlas_free(&s_atlas_buffers[0]);
+    atlas_free(&s_atlas_buffers[1]);
+    g_sprite_atlas  = &s_atlas_buffers[0];
+    g_atlas_watched = 0;
+    g_atlas_load.status = DE100_BACKGROUND_LOAD_STATUS_IDLE;
+    g_atlas_load.cancel_requested = 0;
+}
+
+/* Watch the file an atlas was loaded from (see HOT RELOAD) */
+static void atlas_watch(const char *path)
+{
+    g_atlas_watched = de100_asset_reload_init(&g_atlas_reload, path,
+                                              &s_atlas_buffers[0],
+                                              &s_atlas_buffers[1]);
+}
+
 void sprites_init(const char *atlas_path)
 {
-    memset(&g_sprite_atlas, 0, sizeof(g_sprite_atlas));
-    g_load_done      = 0;
-    g_thread_started = 0;
+    atlas_reset();
 
     if (!atlas_path) {
         /* NULL → intentional placeholder mode; no file I/O needed */
-        g_sprite_atlas.load_state = SPRITE_LOAD_IDLE;
+        g_sprite_atlas->load_state = SPRITE_LOAD_IDLE;
         return;
     }
 
-    /* Synchronous: call the same loading logic that the thread would use,
-     * but from the main thread.  Simple and safe for startup. */
+    /* Synchronous: run the same decode the loader thread would, but from
+     * the main thread.  Simple and safe for startup. */
     strncpy(g_async_path, atlas_path, sizeof(g_async_path) - 1);
-    load_thread_fn((void *)g_async_path);
-    g_load_done = 1;
+    g_atlas_load.status = decode_atlas(NULL, &g_atlas_load)
+                              ? DE100_BACKGROUND_LOAD_STATUS_COMPLETE
+                              : DE100_BACKGROUND_LOAD_STATUS_FAILED;
+    atlas_watch(atlas_path);
+}
+
+int sprites_init_pixels(const uint32_t *pixels, int w, int h)
+{
+    atlas_reset();
+
+    uint32_t *pix = (uint32_t *)malloc((size_t)w * (size_t)h * sizeof(uint32_t));
+    if (!pix || !atlas_build_spans(g_sprite_atlas, pixels, w, h)) {
+        free(pix);
+        snprintf(g_sprite_atlas->error_msg, sizeof(g_sprite_atlas->error_msg),
+                 "Out of memory adopting atlas (%d×%d)", w, h);
+        fprintf(stderr, "[SPRITES] ERROR: %s\n", g_sprite_atlas->error_msg);
+        g_sprite_atlas->load_state = SPRITE_LOAD_ERROR;
+        return 0;
+    }
+    memcpy(pix, pixels, (size_t)w * (size_t)h * sizeof(uint32_t));
+
+    g_sprite_atlas->pixels     = pix;
+    g_sprite_atlas->width      = w;
+    g_sprite_atlas->height     = h;
+    g_sprite_atlas->load_state = SPRITE_LOAD_READY;
+    __atomic_store_n(&g_sprite_atlas->loaded, 1, __ATOMIC_RELEASE);
+    return 1;
 }
 
 void sprites_load_async(const char *atlas_path)
 {
-    memset(&g_sprite_atlas, 0, sizeof(g_sprite_atlas));
-    g_load_done      = 0;
-    g_thread_started = 0;
+    atlas_reset();
 
     if (!atlas_path) {
-        g_sprite_atlas.load_state = SPRITE_LOAD_IDLE;
-        g_load_done = 1;
+        g_sprite_atlas->load_state = SPRITE_LOAD_IDLE;
         return;
     }
 
     strncpy(g_async_path, atlas_path, sizeof(g_async_path) - 1);
-    g_sprite_atlas.load_state = SPRITE_LOAD_LOADING;
-
-    int rc = pthread_create(&g_load_thread, NULL, load_thread_fn, (void *)g_async_path);
-    if (rc != 0) {
-        snprintf(g_sprite_atlas.error_msg, sizeof(g_sprite_atlas.error_msg),
-                 "pthread_create failed (rc=%d)", rc);
-        fprintf(stderr, "[SPRITES] ERROR: %s\n", g_sprite_atlas.error_msg);
-        g_sprite_atlas.load_state = SPRITE_LOAD_ERROR;
-        g_load_done = 1;
+    g_sprite_atlas->load_state = SPRITE_LOAD_LOADING;
+
+    if (!background_load_submit(&g_atlas_load)) {
+        snprintf(g_sprite_atlas->error_msg, sizeof(g_sprite_atlas->error_msg),
+                 "background_load_submit(\"%s\") failed", g_async_path);
+        fprintf(stderr, "[SPRITES] ERROR: %s\n", g_sprite_atlas->error_msg);
+        g_sprite_atlas->load_state = SPRITE_LOAD_ERROR;
+    }
+    atlas_watch(atlas_path);
+}
+
+void sprites_stream_init(const char *sprite_dir)
+{
+    atlas_reset();
+
+    if (!sprite_dir) {
+        g_sprite_atlas->load_state = SPRITE_LOAD_IDLE;
         return;
     }
-    g_thread_started = 1;
+
+    u64 sizes[SPR_COUNT];
+    for (int i = 0; i < SPR_COUNT; i++)
+        sizes[i] = streamed_sprite_size(&SPRITE_DEFS[i]);
+
+    De100MemoryArena arena;
+    de100_arena_init(&arena, sizeof(g_sprite_stream_storage),
+                     g_sprite_stream_storage);
+    if (!de100_asset_stream_init_loader(&g_sprite_stream.stream,
+                                        decode_streamed_sprite, NULL, sizes,
+                                        SPR_COUNT, &arena, SPRITE_STREAM_BUDGET)) {
+        fprintf(stderr, "[SPRITES] ERROR: no room for the %d-byte stream budget\n",
+                SPRITE_STREAM_BUDGET);
+        g_sprite_atlas->load_state = SPRITE_LOAD_IDLE;
+        return;
+    }
+    g_sprite_stream.memory = (GameMemory){
+        .background_load_submit = background_load_platform_submit,
+    };
+    strncpy(g_sprite_stream.dir, sprite_dir, sizeof(g_sprite_stream.dir) - 1);
+    g_sprite_stream.active = 1;
+}
+
+void sprites_begin_frame(void)
+{
+    if (g_sprite_stream.active)
+        de100_asset_stream_begin_frame(&g_sprite_stream.stream);
+
+    /* The frame boundary: nothing is drawing from the atlas, so a finished
+     * reload can go live.  Not before the first load is done. */
+    if (g_atlas_watched && g_reload_host && sprites_is_ready()) {
+        de100_asset_reload_poll(&g_atlas_reload, g_reload_host, reload_atlas,
+                                release_atlas);
+        g_sprite_atlas = (SpriteAtlas *)de100_asset_reload_live(&g_atlas_reload);
+    }
+}
+
+void sprites_set_reload_host(const De100AssetReloadHost *host)
+{
+    g_reload_host = host;
 }
 
 int sprites_is_ready(void)
 {
-    return g_load_done;
+    /* Never submitted (placeholder mode) counts as finished */
+    De100BackgroundLoadStatus status = background_load_status(&g_atlas_load);
+    return status == DE100_BACKGROUND_LOAD_STATUS_IDLE ||
+           status >= DE100_BACKGROUND_LOAD_STATUS_COMPLETE;
 }
 
 void sprites_shutdown(void)
 {
-    /* Wait for background thread before freeing */
-    if (g_thread_started) {
-        pthread_join(g_load_thread, NULL);
-        g_thread_started = 0;
-    }
-    free(g_sprite_atlas.pixels);
-    memset(&g_sprite_atlas, 0, sizeof(g_sprite_atlas));
-    g_load_done = 0;
+    /* Wait for the loader before freeing */
+    atlas_reset();
 }
 
 /* =========================================================================
@@ -273,24 +609,148 @@ static void draw_missing_placeholder(Backbuffer *bb,
 
 /* =========================================================================
  * INTERNAL: ATLAS BLIT (nearest-neighbour)
+ *
+ * From the loaded atlas, or a one-sprite view of a streamed sprite.  Clips the destination rect once, then per destination row walks only
+ * that atlas row's span table (atlas_build_spans): transparent pixels are
+ * never read, and a row whose spans miss the sprite rect costs a couple
+ * of compares.  Each span maps back to the destination columns it covers
+ * (nearest: sx = src_x + dx * src_w / dst_w, so span [a, b) covers
+ * dx in [ceil((a - src_x) * dst_w / src_w), ceil((b - src_x) * ...))) and
+ * is drawn by one of three paths:
+ *
+ *   opaque span, 1:1 scale  → memcpy
+ *   opaque span, scaled     → plain nearest copy, no per-pixel tests
+ *   translucent span        → premultiplied over: dst = src + dst*(1 - a)
  * ========================================================================= */
 
-static void blit_sprite(Backbuffer *bb, const SpriteDef *def,
+/* Premultiplied "over" onto an opaque backbuffer pixel */
+static inline uint32_t blend_premultiplied(uint32_t dst, uint32_t src)
+{
+    uint32_t inv = 255 - (src >> 24);
+    uint32_t rb  = (dst & 0x00FF00FF) * inv + 0x00800080;
+    uint32_t g   = (dst & 0x0000FF00) * inv + 0x00008000;
+    rb = ((rb + ((rb >> 8) & 0x00FF00FF)) >> 8) & 0x00FF00FF;
+    g  = ((g  + ((g  >> 8) & 0x0000FF00)) >> 8) & 0x0000FF00;
+    return 0xFF000000u | ((src & 0x00FFFFFF) + rb + g);
+}
+
+/* First destination column whose nearest source column is >= sx */
+static inline int blit_first_dx(int sx, const SpriteDef *def, int dst_w)
+{
+    return ((sx - def->src_x) * dst_w + def->src_w - 1) / def->src_w;
+}
+
+static void blit_sprite(Backbuffer *bb, const SpriteAtlas *atlas,
+                        const SpriteDef *def,
                         int dst_x, int dst_y, int dst_w, int dst_h)
 {
-    int stride = g_sprite_atlas.width;
-    for (int dy = 0; dy < dst_h; dy++) {
-        int sy = def->src_y + dy * def->src_h / dst_h;
-        if (sy < 0 || sy >= g_sprite_atlas.height) continue;
-        for (int dx = 0; dx < dst_w; dx++) {
-            int sx = def->src_x + dx * def->src_w / dst_w;
-            if (sx < 0 || sx >= g_sprite_atlas.width) continue;
-            uint32_t pixel = g_sprite_atlas.pixels[sy * stride + sx];
-            int bx = dst_x + dx, by = dst_y + dy;
-            if (bx < 0 || bx >= bb->width || by < 0 || by >= bb->height) continue;
-            /* Skip fully transparent pixels */
+    if (dst_w <= 0 || dst_h <= 0 || def->src_w <= 0 || def->src_h <= 0) return;
+
+    /* Destination clip, once */
+    int bx0 = dst_x < 0 ? 0 : dst_x;
+    int by0 = dst_y < 0 ? 0 : dst_y;
+    int bx1 = dst_x + dst_w > bb->width  ? bb->width  : dst_x + dst_w;
+    int by1 = dst_y + dst_h > bb->height ? bb->height : dst_y + dst_h;
+    if (bx0 >= bx1 || by0 >= by1) return;
+
+    /* Source columns that exist in the atlas */
+    int sx0 = def->src_x < 0 ? 0 : def->src_x;
+    int sx1 = def->src_x + def->src_w;
+    if (sx1 > atlas->width) sx1 = atlas->width;
+    if (sx0 >= sx1) return;
+
+    int stride  = bb->pitch / 4;
+    int one2one = dst_w == def->src_w;
+    for (int by = by0; by < by1; by++) {
+        int sy = def->src_y + (by - dst_y) * def->src_h / dst_h;
+        if (sy < 0 || sy >= atlas->height) continue;
+
+        const AtlasSpan *sp  = atlas->spans + atlas->row_spans[sy];
+        const AtlasSpan *end = atlas->spans + atlas->row_spans[sy + 1];
+        const uint32_t  *src = atlas->pixels + sy * atlas->width;
+        uint32_t        *row = bb->pixels + by * stride;
+
+        for (; sp < end && sp->x0 < sx1; sp++) {
+            if (sp->x1 <= sx0) continue;
+            int a = sp->x0 > sx0 ? sp->x0 : sx0;
+            int b = sp->x1 < sx1 ? sp->x1 : sx1;
+            int x0 = dst_x + blit_first_dx(a, def, dst_w);
+            int x1 = dst_x + blit_first_dx(b, def, dst_w);
+            if (x0 < bx0) x0 = bx0;
+            if (x1 > bx1) x1 = bx1;
+            if (x0 >= x1) continue;
+
+            if (!sp->blend && one2one) {
+                memcpy(row + x0, src + def->src_x + (x0 - dst_x),
+                       (size_t)(x1 - x0) * sizeof(uint32_t));
+            } else if (!sp->blend) {
+                for (int x = x0; x < x1; x++)
+                    row[x] = src[def->src_x + (x - dst_x) * def->src_w / dst_w];
+            } else {
+                for (int x = x0; x < x1; x++) {
+                    uint32_t pixel = src[def->src_x + (x - dst_x) * def->src_w / dst_w];
+                    row[x] = blend_premultiplied(row[x], pixel);
+                }
+            }
+        }
+    }
+}
+
+/* =========================================================================
+ * INTERNAL: ROTATED ATLAS BLIT (nearest-neighbour, affine)
+ *
+ * Walks the DESTINATION pixels of the rotated rect's bounding box (clipped
+ * to the backbuffer once, up front) and maps each back into the atlas
+ * rect.  The inverse mapping is affine, so along a row the source position
+ * just moves by a constant (du, dv): one float evaluation per row, then
+ * two integer adds per pixel in 16.16 fixed point.  Nearest, not bilinear:
+ * the atlas is 16x16 pixel art and filtering would blur it.
+ * ========================================================================= */
+
+static void blit_sprite_rotated(Backbuffer *bb, const SpriteAtlas *atlas,
+                                const SpriteDef *def,
+                                float cx, float cy, int dst_w, int dst_h,
+                                float angle)
+{
+    float c = cosf(angle), s = sinf(angle);
+    float inv_sx = (float)def->src_w / (float)dst_w;
+    float inv_sy = (float)def->src_h / (float)dst_h;
+
+    /* Bounding box of the rotated rect, clipped to the backbuffer */
+    float hx = 0.5f * (float)dst_w, hy = 0.5f * (float)dst_h;
+    float ex = fabsf(c) * hx + fabsf(s) * hy;
+    float ey = fabsf(s) * hx + fabsf(c) * hy;
+    int x0 = (int)floorf(cx - ex), x1 = (int)ceilf(cx + ex);
+    int y0 = (int)floorf(cy - ey), y1 = (int)ceilf(cy + ey);
+    if (x0 < 0) x0 = 0;
+    if (y0 < 0) y0 = 0;
+    if (x1 > bb->width)  x1 = bb->width;
+    if (y1 > bb->height) y1 = bb->height;
+    if (x1 <= x0 || y1 <= y0) return;
+
+    /* Atlas step per destination pixel (16.16) */
+    int du = (int)lrintf(c * inv_sx * 65536.0f);
+    int dv = (int)lrintf(-s * inv_sy * 65536.0f);
+    int stride = bb->pitch / 4;
+
+    for (int py = y0; py < y1; py++) {
+        /* Sprite-local position of this row's first pixel center */
+        float rx = (float)x0 + 0.5f - cx, ry = (float)py + 0.5f - cy;
+        int u = (int)floorf(((c * rx + s * ry) * inv_sx +
+                             0.5f * (float)def->src_w) * 65536.0f);
+        int v = (int)floorf(((c * ry - s * rx) * inv_sy +
+                             0.5f * (float)def->src_h) * 65536.0f);
+        uint32_t *row = bb->pixels + py * stride;
+        for (int px = x0; px < x1; px++, u += du, v += dv) {
+            /* One unsigned compare per axis covers < 0 too */
+            if ((unsigned)u >= (unsigned)def->src_w << 16 ||
+                (unsigned)v >= (unsigned)def->src_h << 16) continue;
+            uint32_t pixel = atlas->pixels[
+                (def->src_y + (v >> 16)) * atlas->width +
+                def->src_x + (u >> 16)];
             if ((pixel >> 24) == 0) continue;
-            bb->pixels[by * (bb->pitch / 4) + bx] = pixel;
+            row[px] = (pixel >> 24) == 0xFF ? pixel
+                                            : blend_premultiplied(row[px], pixel);
         }
     }
 }
@@ -299,12 +759,46 @@ static void blit_sprite(Backbuffer *bb, const SpriteDef *def,
  * DRAWING
  * ========================================================================= */
 
+/* Colored rect + label: placeholder mode, or the sprite is still loading */
+static void draw_loading_placeholder(Backbuffer *bb, const SpriteDef *def,
+                                     int dst_x, int dst_y, int dst_w, int dst_h)
+{
+    draw_rect(bb, dst_x, dst_y, dst_w, dst_h, def->placeholder_color);
+    if (def->label && def->label[0] != '\0') {
+        int tw = text_width(def->label, 1);
+        int tx = dst_x + (dst_w - tw) / 2;
+        int ty = dst_y + (dst_h - 8) / 2;
+        draw_text(bb, tx, ty, def->label, GAME_RGB(0x00, 0x00, 0x00), 1);
+    }
+}
+
+/* Streamed mode: the sprite's own view, with src rect at its origin.
+ * Returns 0 after drawing the right placeholder if it isn't resident. */
+static int streamed_sprite_or_placeholder(Backbuffer *bb, SpriteId id,
+                                          SpriteAtlas *view, SpriteDef *view_def,
+                                          int dst_x, int dst_y, int dst_w, int dst_h)
+{
+    const SpriteDef *def = &SPRITE_DEFS[id];
+    int failed;
+    if (!stream_sprite(id, view, &failed)) {
+        if (failed)
+            draw_missing_placeholder(bb, dst_x, dst_y, dst_w, dst_h, def->label);
+        else
+            draw_loading_placeholder(bb, def, dst_x, dst_y, dst_w, dst_h);
+        return 0;
+    }
+    *view_def       = *def;
+    view_def->src_x = 0;
+    view_def->src_y = 0;
+    return 1;
+}
+
 void draw_sprite(Backbuffer *bb, SpriteId id,
                  int dst_x, int dst_y, int dst_w, int dst_h)
 {
     /* Out-of-range ID or atlas load error → magenta "???" */
     if (id < 0 || id >= SPR_COUNT || id == SPR_MISSING ||
-        g_sprite_atlas.load_state == SPRITE_LOAD_ERROR) {
+        g_sprite_atlas->load_state == SPRITE_LOAD_ERROR) {
         const char *lbl = (id >= 0 && id < SPR_COUNT) ? SPRITE_DEFS[id].label : "???";
         draw_missing_placeholder(bb, dst_x, dst_y, dst_w, dst_h, lbl);
         return;
@@ -312,20 +806,23 @@ void draw_sprite(Backbuffer *bb, SpriteId id,
 
     const SpriteDef *def = &SPRITE_DEFS[id];
 
-    if (!g_sprite_atlas.loaded) {
+    if (g_sprite_stream.active) {
+        SpriteAtlas view;
+        SpriteDef   view_def;
+        if (streamed_sprite_or_placeholder(bb, id, &view, &view_def,
+                                           dst_x, dst_y, dst_w, dst_h))
+            blit_sprite(bb, &view, &view_def, dst_x, dst_y, dst_w, dst_h);
+        return;
+    }
+
+    if (!g_sprite_atlas->loaded) {
         /* Placeholder mode or still loading → colored rect + label */
-        draw_rect(bb, dst_x, dst_y, dst_w, dst_h, def->placeholder_color);
-        if (def->label && def->label[0] != '\0') {
-            int tw = text_width(def->label, 1);
-            int tx = dst_x + (dst_w - tw) / 2;
-            int ty = dst_y + (dst_h - 8) / 2;
-            draw_text(bb, tx, ty, def->label, GAME_RGB(0x00, 0x00, 0x00), 1);
-        }
+        draw_loading_placeholder(bb, def, dst_x, dst_y, dst_w, dst_h);
         return;
     }
 
     /* Atlas is ready — blit the src rect */
-    blit_sprite(bb, def, dst_x, dst_y, dst_w, dst_h);
+    blit_sprite(bb, g_sprite_atlas, def, dst_x, dst_y, dst_w, dst_h);
 }
 
 void draw_sprite_frame(Backbuffer *bb, SpriteId id, int frame,
@@ -336,8 +833,8 @@ void draw_sprite_frame(Backbuffer *bb, SpriteId id, int frame,
         return;
     }
 
-    if (!g_sprite_atlas.loaded) {
-        /* Placeholder: ignore frame number */
+    if (!g_sprite_atlas->loaded) {
+        /* Placeholder or streamed (one frame per file): ignore frame number */
         (void)frame;
         draw_sprite(bb, id, dst_x, dst_y, dst_w, dst_h);
         return;
@@ -347,5 +844,31 @@ void draw_sprite_frame(Backbuffer *bb, SpriteId id, int frame,
     const SpriteDef *def = &SPRITE_DEFS[id];
     SpriteDef frame_def  = *def;
     frame_def.src_x     += frame * def->src_w;
-    blit_sprite(bb, &frame_def, dst_x, dst_y, dst_w, dst_h);
+    blit_sprite(bb, g_sprite_atlas, &frame_def, dst_x, dst_y, dst_w, dst_h);
+}
+
+void draw_sprite_rotated(Backbuffer *bb, SpriteId id,
+                         float cx, float cy, int dst_w, int dst_h,
+                         float angle)
+{
+    int dst_x = (int)(cx - 0.5f * (float)dst_w);
+    int dst_y = (int)(cy - 0.5f * (float)dst_h);
+
+    if (g_sprite_stream.active && id >= 0 && id < SPR_COUNT && id != SPR_MISSING) {
+        SpriteAtlas view;
+        SpriteDef   view_def;
+        if (streamed_sprite_or_placeholder(bb, id, &view, &view_def,
+                                           dst_x, dst_y, dst_w, dst_h))
+            blit_sprite_rotated(bb, &view, &view_def, cx, cy, dst_w, dst_h, angle);
+        return;
+    }
+
+    /* Placeholders and the loading state don't rotate */
+    if (!g_sprite_atlas->loaded || id < 0 || id >= SPR_COUNT ||
+        id == SPR_MISSING) {
+        draw_sprite(bb, id, dst_x, dst_y, dst_w, dst_h);
+        return;
+    }
+    blit_sprite_rotated(bb, g_sprite_atlas, &SPRITE_DEFS[id], cx, cy,
+                        dst_w, dst_h, angle);
 }
@@ -1,9 +1,12 @@
 /* src/sprites.h — Sprite sheet system with async loading
  *
- * Three modes of operation:
+ * Four modes of operation:
  *   1. Placeholder mode (atlas_path == NULL)  — colored rects + label text.
  *   2. Loading mode                            — placeholder while thread loads.
  *   3. Atlas mode (loaded == 1)               — nearest-neighbour blit from PNG.
+ *   4. Streamed mode (sprites_stream_init)    — one PNG per sprite, loaded on
+ *      its first draw into a fixed SPRITE_STREAM_BUDGET; least recently drawn
+ *      sprites are evicted to make room.  Placeholder until resident.
  *
  * Quick-start to replace placeholders with real sprites:
  *   a) Drop a PNG atlas into course/assets/sprites/atlas.png
@@ -13,6 +16,9 @@
  * On load failure: a magenta "MISSING" placeholder is drawn and the error is
  * logged to stderr so you can see exactly which file is absent.
  *
+ * An atlas loaded from a file reloads when the file is saved, if the
+ * platform set a reload host (sprites_set_reload_host).
+ *
  * Asset replacement workflow → course/assets/sprites/README.md
  */
 #ifndef DTD_SPRITES_H
@@ -20,6 +26,15 @@
 
 #include "utils/backbuffer.h"
 
+/* Bytes of streamed sprites kept resident (pixels + span tables).  The
+ * current set needs ~40 KB; past that, unused sprites are evicted. */
+#ifndef SPRITE_STREAM_BUDGET
+#define SPRITE_STREAM_BUDGET (64 * 1024)
+#endif
+
+/* Longest atlas path / sprite directory kept, NUL included */
+#define SPRITE_PATH_MAX 512
+
 /* ─── Sprite IDs ────────────────────────────────────────────────────────── */
 typedef enum {
     SPR_TOWER_PELLET = 0,
@@ -59,16 +74,32 @@ typedef enum {
     SPRITE_LOAD_ERROR   = 3,  /* failed — error_msg has details  */
 } SpriteLoadState;
 
+/* ─── Atlas span table ───────────────────────────────────────────────────── */
+/* One run of non-transparent atlas pixels [x0, x1) on one atlas row.
+ * blend = 0: every pixel is opaque → straight copy (alpha-test sprites are
+ * all runs like this); blend = 1: the run holds translucent pixels →
+ * premultiplied "over".  Built once when the atlas loads. */
+typedef struct {
+    uint16_t x0, x1;
+    uint8_t  blend;
+} AtlasSpan;
+
 /* ─── Atlas state ────────────────────────────────────────────────────────── */
 typedef struct {
     uint32_t       *pixels;         /* NULL → placeholders in use     */
+                                    /* premultiplied 0xAARRGGBB       */
     int             width, height;
+    AtlasSpan      *spans;          /* all rows' runs, top to bottom  */
+    int            *row_spans;      /* row y: spans[row_spans[y]] ..
+                                     * spans[row_spans[y + 1] - 1]    */
     int             loaded;         /* 1 when pixels is valid         */
     SpriteLoadState load_state;
-    char            error_msg[256]; /* set on SPRITE_LOAD_ERROR       */
+    char            error_msg[SPRITE_PATH_MAX + 64];
+                                    /* set on SPRITE_LOAD_ERROR: the
+                                     * path and what went wrong        */
 } SpriteAtlas;
 
-extern SpriteAtlas       g_sprite_atlas;
+extern SpriteAtlas      *g_sprite_atlas;   /* the live atlas            */
 extern const SpriteDef   SPRITE_DEFS[SPR_COUNT];
 
 /* ─── API ────────────────────────────────────────────────────────────────── */
@@ -76,13 +107,36 @@ extern const SpriteDef   SPRITE_DEFS[SPR_COUNT];
 /* Synchronous: blocks until load completes.  NULL → placeholder mode. */
 void sprites_init(const char *atlas_path);
 
-/* Asynchronous: spawns a pthread and returns immediately.
+/* Asynchronous: queues the decode on a loader thread (utils/background-
+ * load.h) and returns immediately.
  * Call sprites_is_ready() each frame to check completion. */
 void sprites_load_async(const char *atlas_path);
 
+/* Synchronous, from pixels already in memory (premultiplied 0xAARRGGBB,
+ * copied): for generated atlases — the render bench builds one.  Returns 0
+ * (and placeholder mode) when out of memory. */
+int  sprites_init_pixels(const uint32_t *pixels, int w, int h);
+
+/* Streamed: each sprite decodes from <sprite_dir>/<name>.png (src_w x
+ * src_h; names in sprites.c) on a loader thread the first time it is
+ * drawn.  NULL → placeholder mode. */
+void sprites_stream_init(const char *sprite_dir);
+
+/* Once per frame before drawing: advances the streamed mode's LRU clock
+ * (no-op in the other modes). */
+void sprites_begin_frame(void);
+
 /* Returns 1 once loading finished (success or failure). */
 int  sprites_is_ready(void);
 
+/* Hot reload: with a host (the platform's asset watcher and our loader,
+ * engine/game/asset-reload.h), an atlas loaded from a file is watched;
+ * each save is decoded on a loader thread and swapped in by
+ * sprites_begin_frame().  NULL (the default) turns it off.  The host must
+ * stay valid while set. */
+struct De100AssetReloadHost;
+void sprites_set_reload_host(const struct De100AssetReloadHost *host);
+
 void sprites_shutdown(void);
 
 void draw_sprite(Backbuffer *bb, SpriteId id,
@@ -91,4 +145,11 @@ void draw_sprite(Backbuffer *bb, SpriteId id,
 void draw_sprite_frame(Backbuffer *bb, SpriteId id, int frame,
                        int dst_x, int dst_y, int dst_w, int dst_h);
 
+/* Rotated by `angle` (radians, same convention as Tower.angle: 0 = facing
+ * +x) and scaled to dst_w x dst_h about its center, which lands on
+ * (cx, cy).  Replaces pre-baked per-angle frames in the atlas. */
+void draw_sprite_rotated(Backbuffer *bb, SpriteId id,
+                         float cx, float cy, int dst_w, int dst_h,
+                         float angle);
+
 #endif /* DTD_SPRITES_H */
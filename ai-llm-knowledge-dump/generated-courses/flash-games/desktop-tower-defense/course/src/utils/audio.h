@@ -4,7 +4,9 @@
 
 #include <stdint.h>
 
+#ifndef MAX_SIMULTANEOUS_SOUNDS   /* the audio bench builds with 256 */
 #define MAX_SIMULTANEOUS_SOUNDS  16
+#endif
 #define AUDIO_CHUNK_SIZE         2048   /* samples per Raylib audio stream fill */
 #define AUDIO_SAMPLE_RATE        44100
 
@@ -16,13 +18,13 @@ typedef struct {
     float volume;           /* 0.0–1.0 */
 } SoundDef;
 
-/* A live playing instance of a sound. */
+/* A live playing instance of a sound.  It reads the effect's pre-rendered
+ * PCM (the sound cache in audio.c) — no synthesis happens in the mixer. */
 typedef struct {
-    float  phase;           /* oscillator phase 0.0–1.0 */
-    float  frequency;       /* current frequency (Hz) */
-    float  frequency_slide; /* Hz/sample slide toward frequency_end */
-    float  time_remaining;  /* seconds until silence */
-    float  volume;          /* 0.0–1.0 */
+    int    sfx_id;          /* SfxId: which cached effect */
+    int    position;        /* next cached sample to mix */
+    float  left_gain;       /* volume × pan, fixed at play time */
+    float  right_gain;
     float  pan_position;    /* -1.0 = full left, 0.0 = center, 1.0 = full right */
     int    active;
 } SoundInstance;
@@ -0,0 +1,131 @@
+/* src/utils/background-load.c  —  Desktop Tower Defense | Background Loads
+ *
+ * A fixed ring of queued tasks behind one mutex, and BACKGROUND_LOAD_THREADS
+ * workers that pop from it.  Status changes are atomic stores (release) so
+ * the main thread can poll them without taking the lock; the condition
+ * variable is only for the workers waiting on work and for
+ * background_load_wait().
+ */
+#include "background-load.h"
+
+#include <pthread.h>
+#include <stdint.h>
+
+static pthread_mutex_t  s_lock    = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t   s_wake    = PTHREAD_COND_INITIALIZER; /* work / quit */
+static pthread_cond_t   s_done    = PTHREAD_COND_INITIALIZER; /* a task ended */
+static De100BackgroundLoad *s_queue[BACKGROUND_LOAD_MAX_TASKS];
+static int              s_head, s_count;
+static pthread_t        s_threads[BACKGROUND_LOAD_THREADS];
+static int              s_thread_count;
+static int              s_quit;
+
+static void set_status(De100BackgroundLoad *task,
+                       De100BackgroundLoadStatus status)
+{
+    __atomic_store_n(&task->status, (u32)status, __ATOMIC_RELEASE);
+}
+
+/* Called with s_lock held */
+static void finish(De100BackgroundLoad *task, De100BackgroundLoadStatus status)
+{
+    set_status(task, status);
+    pthread_cond_broadcast(&s_done);
+}
+
+static void *worker_fn(void *arg)
+{
+    ThreadContext thread_context = { (i32)(intptr_t)arg, NULL };
+    pthread_mutex_lock(&s_lock);
+    for (;;) {
+        while (s_count == 0 && !s_quit)
+            pthread_cond_wait(&s_wake, &s_lock);
+        if (s_count == 0) break;   /* quit, and nothing left to run */
+
+        De100BackgroundLoad *task = s_queue[s_head];
+        s_head = (s_head + 1) % BACKGROUND_LOAD_MAX_TASKS;
+        s_count--;
+
+        if (s_quit || de100_background_load_should_cancel(task)) {
+            finish(task, DE100_BACKGROUND_LOAD_STATUS_CANCELLED);
+            continue;
+        }
+        set_status(task, DE100_BACKGROUND_LOAD_STATUS_RUNNING);
+        pthread_mutex_unlock(&s_lock);
+
+        bool ok = task->callback(&thread_context, task);
+
+        pthread_mutex_lock(&s_lock);
+        finish(task, ok ? DE100_BACKGROUND_LOAD_STATUS_COMPLETE
+                        : de100_background_load_should_cancel(task)
+                              ? DE100_BACKGROUND_LOAD_STATUS_CANCELLED
+                              : DE100_BACKGROUND_LOAD_STATUS_FAILED);
+    }
+    pthread_mutex_unlock(&s_lock);
+    return NULL;
+}
+
+int background_load_submit(De100BackgroundLoad *task)
+{
+    De100BackgroundLoadStatus status = background_load_status(task);
+    if (status == DE100_BACKGROUND_LOAD_STATUS_QUEUED ||
+        status == DE100_BACKGROUND_LOAD_STATUS_RUNNING || !task->callback) {
+        return 0;
+    }
+
+    pthread_mutex_lock(&s_lock);
+    s_quit = 0;
+    while (s_thread_count < BACKGROUND_LOAD_THREADS &&
+           pthread_create(&s_threads[s_thread_count], NULL, worker_fn,
+                          (void *)(intptr_t)(s_thread_count + 1)) == 0) {
+        s_thread_count++;
+    }
+    if (s_thread_count == 0 || s_count == BACKGROUND_LOAD_MAX_TASKS) {
+        finish(task, DE100_BACKGROUND_LOAD_STATUS_FAILED);
+        pthread_mutex_unlock(&s_lock);
+        return 0;
+    }
+
+    __atomic_store_n(&task->cancel_requested, 0, __ATOMIC_RELAXED);
+    set_status(task, DE100_BACKGROUND_LOAD_STATUS_QUEUED);
+    s_queue[(s_head + s_count) % BACKGROUND_LOAD_MAX_TASKS] = task;
+    s_count++;
+    pthread_cond_signal(&s_wake);
+    pthread_mutex_unlock(&s_lock);
+    return 1;
+}
+
+DE100_PLATFORM_BACKGROUND_LOAD_SUBMIT(background_load_platform_submit)
+{
+    (void)loader;
+    return background_load_submit(task) != 0;
+}
+
+De100BackgroundLoadStatus background_load_status(const De100BackgroundLoad *task)
+{
+    return (De100BackgroundLoadStatus)__atomic_load_n(&task->status,
+                                                      __ATOMIC_ACQUIRE);
+}
+
+void background_load_wait(De100BackgroundLoad *task)
+{
+    pthread_mutex_lock(&s_lock);
+    while (background_load_status(task) == DE100_BACKGROUND_LOAD_STATUS_QUEUED ||
+           background_load_status(task) == DE100_BACKGROUND_LOAD_STATUS_RUNNING)
+        pthread_cond_wait(&s_done, &s_lock);
+    pthread_mutex_unlock(&s_lock);
+}
+
+void background_load_shutdown(void)
+{
+    pthread_mutex_lock(&s_lock);
+    s_quit = 1;
+    pthread_cond_broadcast(&s_wake);
+    int count = s_thread_count;
+    s_thread_count = 0;
+    pthread_mutex_unlock(&s_lock);
+
+    /* Workers drain the queue as CANCELLED, then exit */
+    for (int i = 0; i < count; i++)
+        pthread_join(s_threads[i], NULL);
+}
@@ -0,0 +1,55 @@
+/* src/utils/background-load.h  —  Desktop Tower Defense | Background Loads
+ *
+ * Long-running work (decoding an atlas, building a level) that spans
+ * frames.  A small pool of loader threads runs the submitted tasks; the
+ * game polls each task's status and keeps drawing in the meantime.
+ * The tasks are the engine's (engine/game/background-load.h); this is
+ * the loader behind them, a few pthreads of our own where the engine's
+ * platform layer has its job system.
+ *
+ *   static DE100_BACKGROUND_LOAD_CALLBACK(decode_atlas) {
+ *       ...
+ *       if (de100_background_load_should_cancel(task)) return false;
+ *       ...
+ *       return true;
+ *   }
+ *
+ *   static De100BackgroundLoad s_atlas_load = { decode_atlas, path };
+ *   background_load_submit(&s_atlas_load);
+ *   ...
+ *   if (de100_background_load_is_done(&s_atlas_load)) { ... }
+ *
+ * Callbacks get the loader thread's index (1..BACKGROUND_LOAD_THREADS)
+ * and no scratch arena.  Several submitted tasks decode concurrently, one
+ * per loader thread.  The task and its `data` must stay valid until the
+ * task is done.
+ */
+#ifndef DTD_BACKGROUND_LOAD_H
+#define DTD_BACKGROUND_LOAD_H
+
+#include "../../../../../../../engine/game/background-load.h"
+
+#define BACKGROUND_LOAD_THREADS   2   /* concurrent decodes            */
+#define BACKGROUND_LOAD_MAX_TASKS 16  /* queued, not yet picked up     */
+
+/* Queue `task` (status becomes QUEUED), starting the loader threads on
+ * first use.  Returns 0 if the task is still in flight (left alone), and
+ * 0 with status FAILED if the queue is full or no thread could start. */
+int  background_load_submit(De100BackgroundLoad *task);
+
+/* background_load_submit() as the engine's platform hook, for callers
+ * that take one (De100AssetReloadHost).  There is one loader per
+ * process, so `loader` is ignored. */
+DE100_PLATFORM_BACKGROUND_LOAD_SUBMIT(background_load_platform_submit);
+
+/* The task's current De100BackgroundLoadStatus (safe from any thread) */
+De100BackgroundLoadStatus background_load_status(const De100BackgroundLoad *task);
+
+/* Block until `task` is done (returns at once if it was never submitted). */
+void background_load_wait(De100BackgroundLoad *task);
+
+/* Cancel everything still queued, let the running tasks finish and join
+ * the loader threads.  Submitting again restarts them. */
+void background_load_shutdown(void);
+
+#endif /* DTD_BACKGROUND_LOAD_H */
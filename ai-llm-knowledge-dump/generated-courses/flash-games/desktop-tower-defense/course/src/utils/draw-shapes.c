@@ -31,23 +31,20 @@ void draw_rect_blend(Backbuffer *bb, int x, int y, int w, int h, uint32_t color)
     int y1 = (y + h) > bb->height ? bb->height : (y + h);
     if (x0 >= x1 || y0 >= y1) return;
 
+    /* R and B are 16 bits apart: masked with 0x00FF00FF they blend in one
+     * multiply, each in its own 16-bit lane (at most 255*255, no carry). */
     int      stride    = bb->pitch / 4;
     uint32_t inv_alpha = 255 - alpha;
-    uint32_t src_r     = (color >> 16) & 0xFF;
-    uint32_t src_g     = (color >>  8) & 0xFF;
-    uint32_t src_b     =  color        & 0xFF;
+    uint32_t src_rb    = (color & 0x00FF00FF) * alpha;
+    uint32_t src_g     = ((color >> 8) & 0xFF) * alpha;
 
     for (int row = y0; row < y1; row++) {
         uint32_t *line = bb->pixels + row * stride;
         for (int col = x0; col < x1; col++) {
-            uint32_t dst   = line[col];
-            uint32_t dst_r = (dst >> 16) & 0xFF;
-            uint32_t dst_g = (dst >>  8) & 0xFF;
-            uint32_t dst_b =  dst        & 0xFF;
-            uint32_t out_r = (src_r * alpha + dst_r * inv_alpha) >> 8;
-            uint32_t out_g = (src_g * alpha + dst_g * inv_alpha) >> 8;
-            uint32_t out_b = (src_b * alpha + dst_b * inv_alpha) >> 8;
-            line[col] = ((uint32_t)0xFF << 24) | (out_r << 16) | (out_g << 8) | out_b;
+            uint32_t dst    = line[col];
+            uint32_t out_rb = ((src_rb + (dst & 0x00FF00FF) * inv_alpha) >> 8) & 0x00FF00FF;
+            uint32_t out_g  = ((src_g + ((dst >> 8) & 0xFF) * inv_alpha) >> 8) & 0xFF;
+            line[col] = ((uint32_t)0xFF << 24) | out_rb | (out_g << 8);
         }
     }
 }
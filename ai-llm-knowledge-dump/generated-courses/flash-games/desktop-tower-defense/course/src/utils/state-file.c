@@ -0,0 +1,64 @@
+/* src/utils/state-file.c  —  Desktop Tower Defense | Saved State Files
+ *
+ * Written to `path`.tmp and renamed over `path`, so quitting mid-write
+ * never leaves a half file where the last good save was.
+ */
+#include "state-file.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define STATE_FILE_MAGIC 0x53445444u  /* "DTDS" */
+#define STATE_FILE_MAX   (64u << 20)  /* refuse anything absurd */
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;  /* layout version the blob was written with */
+    uint64_t size;     /* bytes following the header */
+} StateFileHeader;
+
+int state_file_save(const char *path, uint32_t version,
+                    const void *data, size_t size)
+{
+    char tmp[1024];
+    if ((size_t)snprintf(tmp, sizeof(tmp), "%s.tmp", path) >= sizeof(tmp))
+        return 0;
+
+    FILE *f = fopen(tmp, "wb");
+    if (!f) return 0;
+
+    StateFileHeader header = { STATE_FILE_MAGIC, version, (uint64_t)size };
+    int ok = fwrite(&header, sizeof(header), 1, f) == 1 &&
+             fwrite(data, 1, size, f) == size;
+    if (fclose(f) != 0) ok = 0;
+
+    if (ok && rename(tmp, path) != 0) ok = 0;
+    if (!ok) remove(tmp);
+    return ok;
+}
+
+void *state_file_load(const char *path, uint32_t *version, size_t *size)
+{
+    FILE *f = fopen(path, "rb");
+    if (!f) return NULL;
+
+    StateFileHeader header;
+    void *data = NULL;
+    if (fread(&header, sizeof(header), 1, f) == 1 &&
+        header.magic == STATE_FILE_MAGIC &&
+        header.size > 0 && header.size <= STATE_FILE_MAX) {
+        data = malloc((size_t)header.size);
+        if (data && fread(data, 1, (size_t)header.size, f) != (size_t)header.size) {
+            free(data);
+            data = NULL;
+        }
+    }
+    fclose(f);
+
+    if (data) {
+        *version = header.version;
+        *size    = (size_t)header.size;
+    }
+    return data;
+}
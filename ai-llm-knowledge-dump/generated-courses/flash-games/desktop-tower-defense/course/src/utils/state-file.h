@@ -0,0 +1,36 @@
+/* src/utils/state-file.h  —  Desktop Tower Defense | Saved State Files
+ *
+ * One raw state blob on disk behind a small header, so a long soak
+ * session survives quitting and rebuilding the game:
+ *
+ *   state_file_save(path, GAME_STATE_VERSION, &state, sizeof(state));
+ *   ...
+ *   uint32_t version;  size_t size;
+ *   void *saved = state_file_load(path, &version, &size);
+ *   if (saved) { game_restore_state(&state, version, saved, size); free(saved); }
+ *
+ * The header records the layout version and size the blob was written
+ * with; deciding whether (and how) an older layout can be read back is
+ * the game's job, not this file's.  Native byte order — a file is only
+ * read back on the machine (and build flags) that wrote it.
+ * (The engine's hot reload carries the state across a rebuild in memory,
+ * see engine/game/game-loader.h; DTD is one executable, so it goes
+ * through a file instead.)
+ */
+#ifndef DTD_STATE_FILE_H
+#define DTD_STATE_FILE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Write `size` bytes of `data` to `path`, tagged with `version`.
+ * Returns 1 on success, 0 on any I/O error. */
+int   state_file_save(const char *path, uint32_t version,
+                      const void *data, size_t size);
+
+/* Read a blob written by state_file_save.  Returns a malloc'd copy (free
+ * it) and sets *version / *size, or NULL if the file is missing, not a
+ * state file, or truncated. */
+void *state_file_load(const char *path, uint32_t *version, size_t *size);
+
+#endif /* DTD_STATE_FILE_H */
@@ -2,14 +2,15 @@
 # build-dev.sh  —  Sugar, Sugar | Developer Build Script
 #
 # This is a DEV build script — it ALWAYS builds with debug flags.
-# Output is ALWAYS: ./build/game
+# Output is ./build/game (./build/render-bench for the render-bench backend).
 # There is no release mode here; use a separate build-release.sh for that.
 #
 # Usage:
-#   ./build-dev.sh [--backend=x11|raylib] [-r]
+#   ./build-dev.sh [--backend=x11|raylib|render-bench] [-r]
 #
 #   --backend=raylib  Build the Raylib backend (default)
 #   --backend=x11     Build the X11 backend
+#   --backend=render-bench  Headless render_lines benchmark, -O2
 #   -r / --run        Run the game after a successful build
 #
 # Examples:
@@ -32,10 +33,11 @@ for arg in "$@"; do
     case "$arg" in
         --backend=x11)    BACKEND="x11"    ;;
         --backend=raylib) BACKEND="raylib" ;;
+        --backend=render-bench) BACKEND="render-bench" ;;
         -r|--run)         RUN_AFTER_BUILD=1 ;;
         *)
             echo "Unknown argument: $arg"
-            echo "Usage: $0 [--backend=x11|raylib] [-r]"
+            echo "Usage: $0 [--backend=x11|raylib|render-bench] [-r]"
             exit 1
         ;;
     esac
@@ -62,12 +64,13 @@ fi
 #                  ASan:  buffer overflows, use-after-free, double-free
 #                  UBSan: signed overflow, null deref, misaligned access
 # -Wall -Wextra  : catch common mistakes (uninitialized vars, wrong types)
-# -std=c99       : C99 standard (designated initializers, // comments, etc.)
+# -std=c11       : C11 standard (the engine headers game.c draws through
+#                  use _Generic)
 DEBUG_FLAGS="-O0 -g -DDEBUG -fsanitize=address,undefined"
-COMMON_FLAGS="-Wall -Wextra -std=c99 $DEBUG_FLAGS"
+COMMON_FLAGS="-Wall -Wextra -std=c11 $DEBUG_FLAGS"
 
 # --------------------------------------------------------------------------
-# Output directory — always build/game
+# Output directory — build/game (the bench backend renames it below)
 # --------------------------------------------------------------------------
 mkdir -p build
 OUT="build/game"
@@ -75,7 +78,7 @@ OUT="build/game"
 # --------------------------------------------------------------------------
 # Source files (shared for both backends)
 # --------------------------------------------------------------------------
-SHARED_SRCS="src/game.c src/levels.c src/audio.c"
+SHARED_SRCS="src/game.c src/levels.c src/audio.c src/sand.c src/utils/jobs.c"
 
 # --------------------------------------------------------------------------
 # Backend-specific settings
@@ -85,15 +88,25 @@ if [ "$BACKEND" = "x11" ]; then
     # -lX11: Xlib window management and event handling
     # -lm:   math library (sinf, fminf, etc.)
     # -lasound: ALSA audio (procedural synthesis pushed to hardware each frame)
-    LIBS="-lX11 -lm -lasound"
+    # -lpthread: POSIX threads (utils/jobs.c worker pool)
+    LIBS="-lX11 -lm -lasound -lpthread"
     COMMON_FLAGS="$COMMON_FLAGS -DALSA_AVAILABLE"
+elif [ "$BACKEND" = "render-bench" ]; then
+    # No window: times render_lines (src/render_bench.c).  render_lines is
+    # private to game.c, so the bench #includes game.c in place of it.
+    # Optimised and without sanitizers, or the timings mean nothing.
+    SRCS="src/render_bench.c src/levels.c src/audio.c src/sand.c src/utils/jobs.c"
+    LIBS="-lm -lpthread"
+    COMMON_FLAGS="-Wall -Wextra -std=c11 -O2 -g"
+    OUT="build/render-bench"
 else
-    SRCS="src/main_raylib.c $SHARED_SRCS"
+    SRCS="src/main_raylib.c $SHARED_SRCS src/utils/gpu_grains.c"
     # -lraylib:  Raylib window, input, GPU texture, and audio
+    # -lGL:      compute shaders for freeplay's grains (utils/gpu_grains.c)
     # -lm:       math library
-    # -lpthread: POSIX threads (Raylib uses them internally)
+    # -lpthread: POSIX threads (Raylib, and the utils/jobs.c worker pool)
     # -ldl:      dynamic linking (dlopen/dlclose used by Raylib on Linux)
-    LIBS="-lraylib -lm -lpthread -ldl"
+    LIBS="-lraylib -lGL -lm -lpthread -ldl"
 fi
 
 # --------------------------------------------------------------------------
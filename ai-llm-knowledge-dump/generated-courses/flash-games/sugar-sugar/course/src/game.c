@@ -14,6 +14,11 @@
 #include "game.h"
 #include "utils/font.h"
 
+/* The engine's span kernels (SSE2 / AVX2 / NEON, picked at first use) do
+ * the per-pixel work; this game keeps its GameBackbuffer and draws through
+ * a view of its pixels.  Header-only, so nothing extra to link. */
+#include "../../../../../../engine/game/raster.h"
+
 #include <math.h>   /* fabsf()         */
 #include <stdlib.h> /* rand()          */
 #include <string.h> /* memset, strlen  */
@@ -32,12 +37,6 @@
                                  * Large jitter fans grains over 40+ px, giving
                                  * <5% pixel coverage and looking like sparse
                                  * trickles rather than one solid pour.          */
-#define EMITTER_SPREAD  3      /* random x position offset at spawn (±1 px);
-                                * grains start at different pixels across the
-                                * nozzle width so they never all pile on the same
-                                * column, eliminating the "3 discrete streams"
-                                * artifact caused by all grains colliding at
-                                * the exact same (em->x, em->y) pixel           */
 
 /* ===================================================================
  * GRAIN COLOR → PIXEL COLOR  lookup table
@@ -49,6 +48,24 @@ static const uint32_t g_grain_colors[GRAIN_COLOR_COUNT] = {
     [GRAIN_ORANGE] = COLOR_ORANGE,
 };
 
+/* ===================================================================
+ * LINE BITMAP → PALETTE INDEX
+ *
+ * render_lines turns the bit planes into one byte per pixel and hands
+ * the row to the engine's indexed_row kernel.  Index 0 is transparent
+ * (no solid bit).
+ * =================================================================== */
+#define LINE_INDEX_SOLID 1 /* obstacle / cup wall / brush stroke   */
+#define LINE_INDEX_BAKED 2 /* + GRAIN_COLOR: a baked settled grain */
+
+static const uint32_t g_line_palette[256] = {
+    [LINE_INDEX_SOLID] = COLOR_LINE,
+    [LINE_INDEX_BAKED + GRAIN_WHITE] = COLOR_CREAM,
+    [LINE_INDEX_BAKED + GRAIN_RED] = COLOR_RED,
+    [LINE_INDEX_BAKED + GRAIN_GREEN] = COLOR_GREEN,
+    [LINE_INDEX_BAKED + GRAIN_ORANGE] = COLOR_ORANGE,
+};
+
 /* ===================================================================
  * FORWARD DECLARATIONS  (internal helpers)
  * =================================================================== */
@@ -59,15 +76,27 @@ static void update_playing(GameState *state, GameInput *input, float dt);
 static void update_level_complete(GameState *state, GameInput *input, float dt);
 static void update_freeplay(GameState *state, GameInput *input, float dt);
 
+static void freeplay_load(GameState *state);
+static void simulate_grains(GameState *state, float dt);
 static void spawn_grains(GameState *state, float dt);
 static void update_grains(GameState *state, float dt);
+static void gpu_grains_load(GameState *state);
+static void gpu_grains_update(GameState *state, float dt);
+static void wake_grains_near_stroke(GrainPool *p, int x0, int y0, int x1,
+                                    int y1, int radius);
 static int check_win(GameState *state);
 
-static void stamp_circle(LineBitmap *lb, int cx, int cy, int r, uint8_t val);
+static void line_fill_span(LineBitmap *lb, int y, int x0, int x1);
+static uint32_t solid_span(const LineBitmap *lb, const uint64_t *occ, int y,
+                           int x0, int n);
+static void stamp_circle(LineBitmap *lb, int cx, int cy, int r);
 static void draw_brush_line(LineBitmap *lb, int x0, int y0, int x1, int y1,
                             int radius);
 static void stamp_obstacles(GameState *state);
 static void stamp_cups(GameState *state);
+static void rasterize_zones(GameState *state);
+static void level_bake_all(GameState *state);
+static int level_unbake(GameState *state, int index);
 
 /* rendering helpers */
 static void draw_pixel(GameBackbuffer *bb, int x, int y, uint32_t color);
@@ -120,6 +149,7 @@ void game_init(GameState *state, GameBackbuffer *backbuffer) {
   state->gravity_sign = 1;   /* gravity pulls downward          */
   state->title_hover = -1;
 
+  level_bake_all(state);
   change_phase(state, PHASE_TITLE);
 }
 
@@ -209,6 +239,7 @@ static void level_load(GameState *state, int index) {
   /* Clear all grains and drawn lines. */
   memset(&state->grains, 0, sizeof(state->grains));
   memset(&state->lines, 0, sizeof(state->lines));
+  bitset_clear_all(state->occ.bits, CANVAS_W * CANVAS_H);
 
   /* Reset emitter timers inside the copied level. */
   for (int i = 0; i < state->level.emitter_count; i++)
@@ -221,9 +252,17 @@ static void level_load(GameState *state, int index) {
   /* Gravity is reset to normal on each level load. */
   state->gravity_sign = 1;
 
-  /* Stamp pre-set obstacles and cup walls into the line bitmap. */
-  stamp_obstacles(state);
-  stamp_cups(state);
+  /* The cell grid is cleared either way, so switching engines between
+   * levels never leaves stale sand behind. */
+  sand_reset(&state->sand, &state->level);
+
+  /* Obstacles, cup walls and the zone map come from the bake game_init
+   * made; a level that didn't fit is rasterised here instead. */
+  if (!level_unbake(state, index)) {
+    stamp_obstacles(state);
+    stamp_cups(state);
+    rasterize_zones(state); /* one zone id per pixel */
+  }
 }
 
 static void stamp_obstacles(GameState *state) {
@@ -233,12 +272,8 @@ static void stamp_obstacles(GameState *state) {
   LevelDef *lv = &state->level;
   for (int i = 0; i < lv->obstacle_count; i++) {
     Obstacle *o = &lv->obstacles[i];
-    for (int py = o->y; py < o->y + o->h; py++) {
-      for (int px = o->x; px < o->x + o->w; px++) {
-        if (px >= 0 && px < CANVAS_W && py >= 0 && py < CANVAS_H)
-          state->lines.pixels[py * CANVAS_W + px] = 1;
-      }
-    }
+    for (int py = o->y; py < o->y + o->h; py++)
+      line_fill_span(&state->lines, py, o->x, o->x + o->w);
   }
 }
 
@@ -269,23 +304,255 @@ static void stamp_cups(GameState *state) {
 
     /* Left wall: x = cx, rows [cy .. cy+ch) */
     for (int py = cy; py < cy + ch; py++)
-      if (cx >= 0 && cx < CANVAS_W && py >= 0 && py < CANVAS_H)
-        lb->pixels[py * CANVAS_W + cx] = 1;
+      line_fill_span(lb, py, cx, cx + 1);
 
     /* Right wall: x = cx+cw-1 */
-    for (int py = cy; py < cy + ch; py++) {
-      int rx = cx + cw - 1;
-      if (rx >= 0 && rx < CANVAS_W && py >= 0 && py < CANVAS_H)
-        lb->pixels[py * CANVAS_W + rx] = 1;
-    }
+    for (int py = cy; py < cy + ch; py++)
+      line_fill_span(lb, py, cx + cw - 1, cx + cw);
 
     /* Bottom wall: y = cy+ch-1, all columns */
-    for (int px = cx; px < cx + cw; px++) {
-      int by = cy + ch - 1;
-      if (px >= 0 && px < CANVAS_W && by >= 0 && by < CANVAS_H)
-        lb->pixels[by * CANVAS_W + px] = 1;
+    line_fill_span(lb, cy + ch - 1, cx, cx + cw);
+  }
+}
+
+/* ---- Zone map (see ZONE MAP in game.h) ----
+ *
+ * Each region repaints its pixels with "their current zone, plus me":
+ * the zone is looked up (or added) once per distinct id the region
+ * covers, through remap[].  Painting order gives the precedence the
+ * per-grain loops had: cups and portals back to front (the first one
+ * wins), filters front to back (the last one wins). */
+
+typedef enum {
+  ZONE_FIELD_CUP,
+  ZONE_FIELD_FILTER,
+  ZONE_FIELD_PORTAL,
+} ZONE_FIELD;
+
+typedef struct {
+  ZoneMap *zm;
+  ZONE_FIELD field;
+  int value;
+  int16_t remap[MAX_ZONES]; /* old id → new id, -1 = not seen yet */
+} ZonePaint;
+
+static void zone_paint_begin(ZonePaint *zp, ZoneMap *zm, ZONE_FIELD field,
+                             int value) {
+  zp->zm = zm;
+  zp->field = field;
+  zp->value = value;
+  memset(zp->remap, 0xFF, sizeof(zp->remap));
+}
+
+static void zone_paint_pixel(ZonePaint *zp, int x, int y) {
+  if (x < 0 || x >= CANVAS_W || y < 0 || y >= CANVAS_H)
+    return;
+  ZoneMap *zm = zp->zm;
+  uint8_t *id = &zm->id[y][x];
+  if (zp->remap[*id] < 0) {
+    Zone z = zm->zones[*id];
+    if (zp->field == ZONE_FIELD_CUP)
+      z.cup = (int8_t)zp->value;
+    else if (zp->field == ZONE_FIELD_FILTER)
+      z.filter = (int8_t)zp->value;
+    else
+      z.portal = (int8_t)zp->value;
+
+    int found = 0;
+    while (found < zm->zone_count &&
+           memcmp(&zm->zones[found], &z, sizeof(z)) != 0)
+      found++;
+    if (found == zm->zone_count)
+      zm->zones[zm->zone_count++] = z; /* fits: see the #if in game.h */
+    zp->remap[*id] = (int16_t)found;
+  }
+  *id = (uint8_t)zp->remap[*id];
+}
+
+/* Pixels with x0 <= x < x1, y0 <= y < y1. */
+static void zone_paint_rect(ZonePaint *zp, int x0, int y0, int x1, int y1) {
+  for (int y = y0; y < y1; y++)
+    for (int x = x0; x < x1; x++)
+      zone_paint_pixel(zp, x, y);
+}
+
+/* Pixels with dx² + dy² <= r², the portal trigger test. */
+static void zone_paint_circle(ZonePaint *zp, int cx, int cy, int r) {
+  for (int dy = -r; dy <= r; dy++)
+    for (int dx = -r; dx <= r; dx++)
+      if (dx * dx + dy * dy <= r * r)
+        zone_paint_pixel(zp, cx + dx, cy + dy);
+}
+
+static void rasterize_zones(GameState *state) {
+  const LevelDef *lv = &state->level;
+  ZoneMap *zm = &state->zones;
+  ZonePaint zp;
+
+  memset(zm->id, 0, sizeof(zm->id));
+  zm->zones[0] = (Zone){-1, -1, -1};
+  zm->zone_count = 1;
+
+  /* Cup interiors: one pixel inside each wall, above the bottom (see
+   * stamp_cups). */
+  for (int c = lv->cup_count - 1; c >= 0; c--) {
+    const Cup *cup = &lv->cups[c];
+    zone_paint_begin(&zp, zm, ZONE_FIELD_CUP, c);
+    zone_paint_rect(&zp, cup->x + 1, cup->y, cup->x + cup->w - 1,
+                    cup->y + cup->h - 1);
+  }
+
+  for (int f = 0; f < lv->filter_count; f++) {
+    const ColorFilter *flt = &lv->filters[f];
+    zone_paint_begin(&zp, zm, ZONE_FIELD_FILTER, f);
+    zone_paint_rect(&zp, flt->x, flt->y, flt->x + flt->w, flt->y + flt->h);
+  }
+
+  /* End b, then end a: a grain inside both leaves through b. */
+  for (int t = lv->teleporter_count - 1; t >= 0; t--) {
+    const Teleporter *tp = &lv->teleporters[t];
+    zone_paint_begin(&zp, zm, ZONE_FIELD_PORTAL, t * 2);
+    zone_paint_circle(&zp, tp->bx, tp->by, tp->radius);
+    zone_paint_begin(&zp, zm, ZONE_FIELD_PORTAL, t * 2 + 1);
+    zone_paint_circle(&zp, tp->ax, tp->ay, tp->radius);
+  }
+}
+
+/* ---- Level bakes (see LEVEL BAKES in game.h) ----
+ *
+ * Native byte order: the bytes never leave this process.  The writer
+ * stops at the end of data[] and reports it, so a level that doesn't fit
+ * is simply left unbaked. */
+
+typedef struct {
+  uint8_t *p, *end;
+  int overflow;
+} BakeWriter;
+
+static void bake_bytes(BakeWriter *w, const void *src, size_t n) {
+  if (w->overflow || (size_t)(w->end - w->p) < n) {
+    w->overflow = 1;
+    return;
+  }
+  memcpy(w->p, src, n);
+  w->p += n;
+}
+
+static void bake_u16(BakeWriter *w, int v) {
+  uint16_t u = (uint16_t)v;
+  bake_bytes(w, &u, sizeof(u));
+}
+
+static int unbake_u16(const uint8_t **p) {
+  uint16_t u;
+  memcpy(&u, *p, sizeof(u));
+  *p += sizeof(u);
+  return u;
+}
+
+/* Pack state->lines (solid only) and state->zones as they stand. */
+static uint32_t level_bake_pack(const GameState *state, uint8_t *out,
+                                uint8_t *end) {
+  const LineBitmap *lb = &state->lines;
+  const ZoneMap *zm = &state->zones;
+  BakeWriter w = {out, end, 0};
+
+  uint8_t zone_count = (uint8_t)(zm->zone_count - 1); /* 1..MAX_ZONES */
+  bake_bytes(&w, &zone_count, 1);
+  for (int z = 0; z < zm->zone_count; z++)
+    bake_bytes(&w, &zm->zones[z], sizeof(Zone));
+
+  /* Span count first, patched in once the rows are walked. */
+  uint8_t *span_count_at = w.p;
+  int span_count = 0;
+  bake_u16(&w, 0);
+  for (int y = 0; y < CANVAS_H; y++) {
+    for (int x = 0; x < CANVAS_W;) {
+      if (lb->solid[y][x >> 6] == 0 && (x & 63) == 0) {
+        x += 64;
+        continue;
+      }
+      if (!((lb->solid[y][x >> 6] >> (x & 63)) & 1)) {
+        x++;
+        continue;
+      }
+      int x0 = x;
+      while (x < CANVAS_W && ((lb->solid[y][x >> 6] >> (x & 63)) & 1))
+        x++;
+      bake_u16(&w, y);
+      bake_u16(&w, x0);
+      bake_u16(&w, x);
+      span_count++;
     }
   }
+  if (span_count > 0xFFFF)
+    w.overflow = 1;
+  if (!w.overflow) {
+    uint16_t u = (uint16_t)span_count;
+    memcpy(span_count_at, &u, sizeof(u));
+  }
+
+  const uint8_t *id = &zm->id[0][0];
+  for (int i = 0; i < CANVAS_W * CANVAS_H;) {
+    int run = 1;
+    while (i + run < CANVAS_W * CANVAS_H && id[i + run] == id[i] &&
+           run < 0xFFFF)
+      run++;
+    bake_u16(&w, run);
+    bake_bytes(&w, &id[i], 1);
+    i += run;
+  }
+
+  return w.overflow ? 0 : (uint32_t)(w.p - out);
+}
+
+static void level_bake_all(GameState *state) {
+  LevelBakes *bakes = &state->bakes;
+  bakes->used = 0;
+  for (int i = 0; i < TOTAL_LEVELS; i++) {
+    /* Rasterise into the live bitmaps: nothing is loaded yet. */
+    state->level = g_levels[i];
+    memset(&state->lines, 0, sizeof(state->lines));
+    stamp_obstacles(state);
+    stamp_cups(state);
+    rasterize_zones(state);
+
+    uint32_t size = level_bake_pack(state, bakes->data + bakes->used,
+                                    bakes->data + LEVEL_BAKE_BYTES);
+    bakes->levels[i] = (LevelBake){bakes->used, size};
+    bakes->used += size;
+  }
+  memset(&state->level, 0, sizeof(state->level));
+  memset(&state->lines, 0, sizeof(state->lines));
+}
+
+/* Expects state->lines already cleared.  0 if the level wasn't baked. */
+static int level_unbake(GameState *state, int index) {
+  const LevelBake *bake = &state->bakes.levels[index];
+  if (bake->size == 0)
+    return 0;
+  const uint8_t *p = state->bakes.data + bake->offset;
+  ZoneMap *zm = &state->zones;
+
+  zm->zone_count = *p++ + 1;
+  for (int z = 0; z < zm->zone_count; z++, p += sizeof(Zone))
+    memcpy(&zm->zones[z], p, sizeof(Zone));
+
+  int span_count = unbake_u16(&p);
+  for (int s = 0; s < span_count; s++) {
+    int y = unbake_u16(&p);
+    int x0 = unbake_u16(&p);
+    int x1 = unbake_u16(&p);
+    line_fill_span(&state->lines, y, x0, x1);
+  }
+
+  uint8_t *id = &zm->id[0][0];
+  for (int i = 0; i < CANVAS_W * CANVAS_H;) {
+    int run = unbake_u16(&p);
+    memset(id + i, *p++, (size_t)run);
+    i += run;
+  }
+  return 1;
 }
 
 /* ===================================================================
@@ -392,11 +659,15 @@ static void update_playing(GameState *state, GameInput *input, float dt) {
   if (input->mouse.left.ended_down && !over_ui) {
     draw_brush_line(&state->lines, input->mouse.prev_x, input->mouse.prev_y,
                     input->mouse.x, input->mouse.y, BRUSH_RADIUS);
+    wake_grains_near_stroke(&state->grains, input->mouse.prev_x,
+                            input->mouse.prev_y, input->mouse.x,
+                            input->mouse.y, BRUSH_RADIUS);
+    sand_wake_stroke(&state->sand, input->mouse.prev_x, input->mouse.prev_y,
+                     input->mouse.x, input->mouse.y, BRUSH_RADIUS);
   }
 
   /* ---- Simulation ---- */
-  spawn_grains(state, dt);
-  update_grains(state, dt);
+  simulate_grains(state, dt);
 
   /* ---- Win check ---- */
   if (check_win(state)) {
@@ -419,6 +690,7 @@ static void update_level_complete(GameState *state, GameInput *input, float dt)
   if (advance) {
     int next = state->current_level + 1;
     if (next >= TOTAL_LEVELS) {
+      freeplay_load(state);
       change_phase(state, PHASE_FREEPLAY);
     } else {
       level_load(state, next);
@@ -438,7 +710,7 @@ static void update_freeplay(GameState *state, GameInput *input, float dt) {
                         my >= UI_BTN_Y && my < UI_BTN_Y + UI_BTN_H);
 
   if (BUTTON_PRESSED(input->mouse.left) && state->reset_hover) {
-    level_load(state, state->current_level);
+    freeplay_load(state);
     return;
   }
 
@@ -447,7 +719,7 @@ static void update_freeplay(GameState *state, GameInput *input, float dt) {
     return;
   }
   if (BUTTON_PRESSED(input->reset)) {
-    level_load(state, state->current_level);
+    freeplay_load(state);
     return;
   }
   if (BUTTON_PRESSED(input->gravity))
@@ -457,37 +729,138 @@ static void update_freeplay(GameState *state, GameInput *input, float dt) {
   if (input->mouse.left.ended_down && !over_ui) {
     draw_brush_line(&state->lines, input->mouse.prev_x, input->mouse.prev_y,
                     input->mouse.x, input->mouse.y, BRUSH_RADIUS);
+    wake_grains_near_stroke(&state->grains, input->mouse.prev_x,
+                            input->mouse.prev_y, input->mouse.x,
+                            input->mouse.y, BRUSH_RADIUS);
+    sand_wake_stroke(&state->sand, input->mouse.prev_x, input->mouse.prev_y,
+                     input->mouse.x, input->mouse.y, BRUSH_RADIUS);
   }
 
-  spawn_grains(state, dt);
-  update_grains(state, dt);
+  simulate_grains(state, dt);
   /* No win check in freeplay. */
 }
 
+/* Freeplay reuses the last level's layout, but pours FREEPLAY_POUR_SCALE
+ * times faster into an engine with room for it: the GPU pool when the
+ * platform offers one, else the cell engine, which has no grain limit. */
+#define FREEPLAY_POUR_SCALE 8
+
+static void freeplay_load(GameState *state) {
+  level_load(state, state->current_level);
+  state->level.engine =
+      state->gpu.reset ? GRAIN_ENGINE_GPU : GRAIN_ENGINE_CELLS;
+  for (int e = 0; e < state->level.emitter_count; e++)
+    state->level.emitters[e].grains_per_second *= FREEPLAY_POUR_SCALE;
+  if (state->level.engine == GRAIN_ENGINE_GPU)
+    gpu_grains_load(state);
+}
+
+int game_grains_on_gpu(const GameState *state) {
+  return state->phase == PHASE_FREEPLAY &&
+         state->level.engine == GRAIN_ENGINE_GPU;
+}
+
 /* ===================================================================
  * GRAIN SIMULATION
  * =================================================================== */
 
+static void simulate_grains(GameState *state, float dt) {
+  if (state->level.engine == GRAIN_ENGINE_CELLS) {
+    sand_update(state, dt); /* sand.c */
+  } else if (state->level.engine == GRAIN_ENGINE_GPU) {
+    gpu_grains_update(state, dt);
+  } else {
+    spawn_grains(state, dt);
+    update_grains(state, dt);
+  }
+}
+
 static int grain_alloc(GrainPool *p) {
-  /* Scan for a free slot.  We keep a "high watermark" (count) so the scan
-   * stays short during the early frames when most slots are empty. */
-  for (int i = 0; i < p->count; i++) {
-    if (!p->active[i])
+  /* The lowest free slot, so grains keep their update order.  We keep a
+   * "high watermark" (count) so the scan stays short during the early
+   * frames when most slots are empty, and resume from free_hint: slots
+   * below it were all taken by this frame's earlier allocations, so a
+   * burst of spawns scans the pool once instead of once per grain.  Slots
+   * are freed all over (band workers, events, baking), so spawn_grains
+   * and bake_sleeping_grains reset the hint rather than every free site.
+   * Fully occupied runs are skipped 8 slots per test (active[] is 0/1). */
+  int i = p->free_hint;
+  for (; i + 8 <= p->count; i += 8) {
+    uint64_t run;
+    memcpy(&run, p->active + i, 8);
+    if (run != 0x0101010101010101ULL)
+      break;
+  }
+  for (; i < p->count; i++) {
+    if (!p->active[i]) {
+      p->free_hint = i + 1;
       return i;
+    }
   }
+  p->free_hint = p->count;
   if (p->count < MAX_GRAINS) {
+    p->free_hint++;
     return p->count++;
   }
   return -1; /* pool full */
 }
 
+/* Pool full: bake every sleeping grain into the line bitmap (the old
+ * settle behaviour) to free its slot.  Returns how many were freed. */
+static int bake_sleeping_grains(GameState *state) {
+  GrainPool *p = &state->grains;
+  int freed = 0;
+  for (int i = 0; i < p->count; i++) {
+    if (!p->active[i] || !p->asleep[i])
+      continue;
+    int bx = (int)p->x[i], by = (int)p->y[i];
+    if (bx >= 0 && bx < CANVAS_W && by >= 0 && by < CANVAS_H) {
+      LineBitmap *lb = &state->lines;
+      uint64_t bit = (uint64_t)1 << (bx & 63);
+      int w = bx >> 6;
+      lb->solid[by][w] |= bit;
+      lb->baked[by][w] |= bit;
+      for (int k = 0; k < 2; k++) {
+        if ((p->color[i] >> k) & 1)
+          lb->color[k][by][w] |= bit;
+        else
+          lb->color[k][by][w] &= ~bit;
+      }
+      bitset_clear(state->occ.bits, by * CANVAS_W + bx);
+    }
+    p->active[i] = 0;
+    freed++;
+  }
+  p->free_hint = 0;
+  return freed;
+}
+
+/* Wake sleepers inside the stroke's bounding box (grown by the brush
+ * radius plus one pixel of support).  Only runs on frames with drawing. */
+static void wake_grains_near_stroke(GrainPool *p, int x0, int y0, int x1,
+                                    int y1, int radius) {
+  int r = radius + 1;
+  int minx = (x0 < x1 ? x0 : x1) - r, maxx = (x0 > x1 ? x0 : x1) + r;
+  int miny = (y0 < y1 ? y0 : y1) - r, maxy = (y0 > y1 ? y0 : y1) + r;
+  for (int i = 0; i < p->count; i++) {
+    if (!p->asleep[i])
+      continue;
+    int gx = (int)p->x[i], gy = (int)p->y[i];
+    if (gx >= minx && gx <= maxx && gy >= miny && gy <= maxy) {
+      p->asleep[i] = 0;
+      p->still[i] = 0;
+    }
+  }
+}
+
 static void spawn_grains(GameState *state, float dt) {
   LevelDef *lv = &state->level;
   GrainPool *p = &state->grains;
 
-  /* Sugar falls continuously — no artificial cap.  The pool stays healthy
-   * because settled grains are baked into the line bitmap and freed (see
-   * update_grains).  A free slot is almost always available. */
+  /* Sugar falls continuously — no artificial cap.  Settled grains sleep
+   * (see update_grains) and keep their slots; when the pool fills up the
+   * sleepers are baked into the line bitmap to make room. */
+  p->free_hint = 0; /* last frame's update freed slots anywhere */
 
   for (int e = 0; e < lv->emitter_count; e++) {
     Emitter *em = &lv->emitters[e];
@@ -496,10 +869,13 @@ static void spawn_grains(GameState *state, float dt) {
     while (em->spawn_timer >= interval) {
       em->spawn_timer -= interval;
       int slot = grain_alloc(&state->grains);
+      if (slot < 0 && bake_sleeping_grains(state) > 0)
+        slot = grain_alloc(&state->grains);
       if (slot < 0)
-        break; /* pool full */
+        break; /* pool full of awake grains */
 
       p->active[slot] = 1;
+      p->asleep[slot] = 0;
       p->color[slot] = GRAIN_WHITE;
       p->tpcd[slot] = 0;
       p->still[slot] = 0;
@@ -522,47 +898,174 @@ static void spawn_grains(GameState *state, float dt) {
       p->y[slot] = (float)em->y;
       p->vx[slot] = jitter;
       p->vy[slot] = (state->gravity_sign > 0) ? 40.0f : -40.0f;
+
+      int sx = (int)p->x[slot], sy = (int)p->y[slot];
+      if (sx >= 0 && sx < CANVAS_W && sy >= 0 && sy < CANVAS_H)
+        bitset_set(state->occ.bits, sy * CANVAS_W + sx);
     }
   }
 }
 
-static void update_grains(GameState *state, float dt) {
-  GrainPool *p = &state->grains;
-  LineBitmap *lb = &state->lines;
+/* ===================================================================
+ * GPU GRAINS  (freeplay, when the platform sets state->gpu)
+ *
+ * The pool lives in the platform's GL buffers (utils/gpu_grains.c):
+ * the game only hands it the level once, then each frame's spawns and
+ * line bitmap, and gets back how many grains each cup took.  The rules
+ * are update_grain_band's, run one grain per GPU thread.
+ * =================================================================== */
+#if MAX_CUPS > GPU_GRAINS_MAX_CUPS || MAX_ZONES > GPU_GRAINS_MAX_ZONES
+#error "GPU GRAINS: the pool's cup/zone tables are too small"
+#endif
+
+/* Resolve the zone map for the GPU: cup index, filter output color and
+ * teleport exit per zone id. */
+static void gpu_grains_load(GameState *state) {
+  const LevelDef *lv = &state->level;
+  const ZoneMap *zm = &state->zones;
+  GpuGrainZone zones[MAX_ZONES];
+  GpuGrainCup cups[MAX_CUPS];
+
+  for (int z = 0; z < zm->zone_count; z++) {
+    const Zone *zone = &zm->zones[z];
+    GpuGrainZone *out = &zones[z];
+    out->cup = zone->cup;
+    out->color = zone->filter >= 0
+                     ? (int)lv->filters[zone->filter].output_color
+                     : -1;
+    out->exit_x = out->exit_y = -1;
+    if (zone->portal >= 0) {
+      /* Inside end a → out at b, and the other way round. */
+      const Teleporter *tp = &lv->teleporters[zone->portal / 2];
+      int to_b = zone->portal & 1;
+      out->exit_x = to_b ? tp->bx : tp->ax;
+      out->exit_y = to_b ? tp->by : tp->ay;
+    }
+  }
+  for (int c = 0; c < lv->cup_count; c++) {
+    cups[c].color = (int)lv->cups[c].required_color;
+    cups[c].room = lv->cups[c].required_count - lv->cups[c].collected;
+  }
+
+  GpuGrainLevel level = {
+      .zone_ids = &zm->id[0][0],
+      .zones = zones,
+      .zone_count = zm->zone_count,
+      .cups = cups,
+      .cup_count = lv->cup_count,
+      .palette = g_grain_colors,
+      .palette_count = GRAIN_COLOR_COUNT,
+  };
+  state->gpu.reset(state->gpu.pool, &level);
+}
+
+static void gpu_grains_update(GameState *state, float dt) {
   LevelDef *lv = &state->level;
-  int W = CANVAS_W, H = CANVAS_H;
-  float grav = GRAVITY * (float)state->gravity_sign;
+  GpuGrainSpawn spawns[GPU_GRAINS_MAX_SPAWNS];
+  int spawn_count = 0;
 
-  /* ---- Grain-occupancy bitmap ----
-   * This lets grains collide with *each other*, not just with drawn lines.
-   * The bitmap is declared static so it lives in BSS (not 307 KB on the stack).
-   * We rebuild it from scratch every frame to reflect the latest positions. */
-  static uint8_t s_occ[CANVAS_W * CANVAS_H];
-  __builtin_memset(s_occ, 0, sizeof(s_occ));
-  for (int i = 0; i < p->count; i++) {
-    if (!p->active[i])
+  /* Same pour as spawn_grains; the slots are found on the GPU. */
+  for (int e = 0; e < lv->emitter_count; e++) {
+    Emitter *em = &lv->emitters[e];
+    em->spawn_timer += dt;
+    float interval = 1.0f / (float)em->grains_per_second;
+    while (em->spawn_timer >= interval) {
+      em->spawn_timer -= interval;
+      if (spawn_count == GPU_GRAINS_MAX_SPAWNS)
+        continue; /* a long frame: drop the excess, don't bank it */
+      float jitter =
+          ((float)(rand() % 1000) / 1000.0f - 0.5f) * EMITTER_JITTER * 2.0f;
+      int x_spread = (rand() % (2 * EMITTER_SPREAD + 1)) - EMITTER_SPREAD;
+      spawns[spawn_count++] = (GpuGrainSpawn){
+          .x = (float)(em->x + x_spread),
+          .y = (float)em->y,
+          .vx = jitter,
+          .vy = (state->gravity_sign > 0) ? 40.0f : -40.0f,
+          .color = GRAIN_WHITE,
+      };
+    }
+  }
+
+  GpuGrainStep step = {
+      .dt = dt,
+      .gravity = GRAVITY * (float)state->gravity_sign,
+      .max_vx = MAX_VX,
+      .max_vy = MAX_VY,
+      .drag = GRAIN_HORIZ_DRAG,
+      .slide_min = GRAIN_SLIDE_MIN,
+      .bounce = GRAIN_BOUNCE,
+      .bounce_min = GRAIN_BOUNCE_MIN,
+      .settle_speed = GRAIN_SETTLE_SPEED,
+      .settle_frames = GRAIN_SETTLE_FRAMES,
+      .slide_reach = GRAIN_SLIDE_REACH,
+      .teleport_cooldown = 6, /* as GRAIN_EVENT_TELEPORT */
+      .is_cyclic = lv->is_cyclic,
+      .solid = &state->lines.solid[0][0],
+      .spawns = spawns,
+      .spawn_count = spawn_count,
+  };
+  int absorbed[GPU_GRAINS_MAX_CUPS] = {0};
+  state->gpu.step(state->gpu.pool, &step, absorbed);
+
+  /* The GPU never lets a cup take more than its room. */
+  for (int c = 0; c < lv->cup_count; c++) {
+    Cup *cup = &lv->cups[c];
+    if (absorbed[c] == 0 || cup->collected >= cup->required_count)
       continue;
-    int ix = (int)p->x[i], iy = (int)p->y[i];
-    if (ix >= 0 && ix < W && iy >= 0 && iy < H)
-      s_occ[iy * W + ix] = 1;
+    cup->collected += absorbed[c];
+    if (cup->collected >= cup->required_count) {
+      cup->collected = cup->required_count;
+      game_play_sound(&state->audio, SOUND_CUP_FILL);
+    }
   }
+}
+
+/* Simulate the grains that start this frame in `band`.  Runs on a worker
+ * thread alongside the other bands of the same parity, so it may only
+ * touch its own grains and the rows within GRAIN_BAND_REACH of the band;
+ * everything else goes into state->bands.event[] (see GRAIN BANDS). */
+static void update_grain_band(GameState *state, int band, float dt) {
+  GrainPool *p = &state->grains;
+  const LineBitmap *lb = &state->lines;
+  const LevelDef *lv = &state->level;
+  GrainBands *gb = &state->bands;
+  int W = CANVAS_W, H = CANVAS_H;
+  float grav = GRAVITY * (float)state->gravity_sign;
+  uint64_t *occ = state->occ.bits;
 
 /* Solid = player-drawn / obstacle line pixel  OR  another settled grain.
  * Out-of-bounds in X is treated as solid (wall); out-of-bounds in Y is
- * handled separately (ceiling / floor logic). */
+ * handled separately (ceiling / floor logic).  Both bitmaps share the
+ * row-word layout, so this is two loads from the same word index. */
 #define IS_SOLID(xx, yy)                                                       \
-  ((xx) < 0 || (xx) >= W || lb->pixels[(yy) * W + (xx)] ||                     \
-   s_occ[(yy) * W + (xx)])
-
-  for (int i = 0; i < p->count; i++) {
-    if (!p->active[i])
-      continue;
+  ((xx) < 0 || (xx) >= W ||                                                    \
+   (((lb->solid[yy][(xx) >> 6] | occ[(yy) * LINE_ROW_WORDS + ((xx) >> 6)]) >> \
+     ((xx) & 63)) & 1))
+
+  int below = state->gravity_sign; /* row offset a grain rests on */
+
+  for (int k = gb->start[band]; k < gb->start[band + 1]; k++) {
+    int i = gb->order[k];
+
+    /* ---- Sleeping grain: skip it unless it could move again ----
+     * A resting grain is blocked straight "down" (in gravity direction)
+     * and on both diagonals (the slide rule below only ever needs the ±1
+     * diagonal free).  If any of those three pixels opened up, wake it. */
+    if (p->asleep[i]) {
+      int sx = (int)p->x[i], sy = (int)p->y[i] + below;
+      if (sy < 0)
+        continue; /* resting against the ceiling */
+      if (sy < H && solid_span(lb, occ, sy, sx - 1, 3) == 7u)
+        continue;
+      p->asleep[i] = 0;
+      p->still[i] = 0;
+    }
 
     /* Unmark this grain's current position so it doesn't block itself. */
     {
       int cx = (int)p->x[i], cy = (int)p->y[i];
       if (cx >= 0 && cx < W && cy >= 0 && cy < H)
-        s_occ[cy * W + cx] = 0;
+        bitset_clear(occ, cy * W + cx);
     }
 
     /* ---- Apply gravity ---- */
@@ -590,6 +1093,11 @@ static void update_grains(GameState *state, float dt) {
      * that a fast grain cannot "tunnel" through a 1-px thick line. */
     float total_dx = p->vx[i] * dt;
     float total_dy = p->vy[i] * dt;
+    /* Stay inside the band footprint; only bites below ~20 FPS. */
+    if (total_dy > (float)GRAIN_BAND_REACH)
+      total_dy = (float)GRAIN_BAND_REACH;
+    if (total_dy < -(float)GRAIN_BAND_REACH)
+      total_dy = -(float)GRAIN_BAND_REACH;
     float abs_dx = total_dx < 0 ? -total_dx : total_dx;
     float abs_dy = total_dy < 0 ? -total_dy : total_dy;
     int steps = (int)(abs_dx + abs_dy) + 1;
@@ -623,12 +1131,14 @@ static void update_grains(GameState *state, float dt) {
         break;
       }
 
-      /* ---- Screen boundary: floor → wrap or remove ---- */
+      /* ---- Screen boundary: floor → wrap or remove ----
+       * The top rows belong to another band, so the wrap itself waits
+       * for the event pass; the grain resumes from there next frame. */
       if (iy >= H) {
         if (lv->is_cyclic) {
-          p->y[i] = 1.f;
           p->x[i] = nx;
-          continue; /* restart sub-step from top of screen */
+          gb->event[i] = GRAIN_EVENT_WRAP;
+          goto next_grain;
         } else {
           p->active[i] = 0;
           goto next_grain;
@@ -680,21 +1190,21 @@ static void update_grains(GameState *state, float dt) {
           int d2 = -d1;
           int slid = 0;
 
+          /* The whole ±REACH window of the target row in one read:
+           * bit GRAIN_SLIDE_REACH + k is pixel ox + k (walls read solid). */
+          uint32_t row = solid_span(lb, occ, iy, ox - GRAIN_SLIDE_REACH,
+                                    2 * GRAIN_SLIDE_REACH + 1);
+
           for (int dist = 1; dist <= GRAIN_SLIDE_REACH && !slid; dist++) {
             for (int attempt = 0; attempt < 2 && !slid; attempt++) {
               int d = (attempt == 0) ? d1 : d2;
               int sx = ox + d * dist;
-              if (sx < 0 || sx >= W)
-                continue;
               /* All pixels between ox and sx at the same row must be free
                * — we don't want the grain to teleport through a wall. */
-              int path_clear = 1;
-              for (int px = ox + d; px != sx + d; px += d) {
-                if (IS_SOLID(px, iy)) { path_clear = 0; break; }
-              }
-              if (!path_clear)
-                continue;
-              if (!IS_SOLID(sx, iy)) {
+              uint32_t path = ((1u << dist) - 1u)
+                              << (d > 0 ? GRAIN_SLIDE_REACH + 1
+                                        : GRAIN_SLIDE_REACH - dist);
+              if ((row & path) == 0) {
                 /* Slide speed: use max(|vy|, GRAIN_SLIDE_MIN) so grains
                  * always move fast enough to register as "moving" by the
                  * displacement-based settle check — even on shallow
@@ -744,14 +1254,14 @@ static void update_grains(GameState *state, float dt) {
     {
       int fx = (int)p->x[i], fy = (int)p->y[i];
       if (fx >= 0 && fx < W && fy >= 0 && fy < H)
-        s_occ[fy * W + fx] = 1;
+        bitset_set(occ, fy * W + fx);
     }
 
     /* ---- Teleport cooldown ---- */
     if (p->tpcd[i] > 0)
       p->tpcd[i]--;
 
-    /* ---- Cup check (AABB — interior only, walls excluded) ----
+    /* ---- Cup check (zone map: interior only, walls excluded) ----
      * We test against the *interior* of the cup (x+1 .. x+w-2, y .. y+h-2)
      * because stamp_cups() placed solid wall pixels at the exact edges.
      * Checking the interior avoids double-processing a grain that is still
@@ -759,77 +1269,52 @@ static void update_grains(GameState *state, float dt) {
      *
      * When the cup is full the grain is NOT absorbed — it will rest on
      * the solid bottom wall or the pile of earlier overflow grains and
-     * eventually spill back out over the open top rim. */
+     * eventually spill back out over the open top rim.
+     *
+     * Absorbing bumps a counter every band reads, so it is deferred: the
+     * grain stays put (and solid) until the event pass, which re-checks
+     * the cup in case earlier grains filled it first. */
     {
       int gx = (int)p->x[i], gy = (int)p->y[i];
-      for (int c = 0; c < lv->cup_count; c++) {
-        Cup *cup = &lv->cups[c];
-        /* Interior bounds: one pixel inside each wall. */
-        int ix0 = cup->x + 1, ix1 = cup->x + cup->w - 1;
-        int iy0 = cup->y, iy1 = cup->y + cup->h - 1;
-        if (gx >= ix0 && gx < ix1 && gy >= iy0 && gy < iy1) {
-          int right_color = (cup->required_color == GRAIN_WHITE ||
-                             p->color[i] == (uint8_t)cup->required_color);
-          if (right_color && cup->collected < cup->required_count) {
-            /* Absorb: count this grain, clear its occupancy, remove from sim. */
-            int was_full_before = (cup->collected + 1 >= cup->required_count);
-            cup->collected++;
-            if (was_full_before) {
-              /* Cup just reached 100% — play chime */
-              game_play_sound(&state->audio, SOUND_CUP_FILL);
-            }
-            s_occ[gy * W + gx] = 0; /* clear occupancy — grain is gone now */
-            p->active[i] = 0;
-            goto next_grain;
-          } else if (!right_color) {
-            /* Wrong color: discard silently (no penalty). */
-            s_occ[gy * W + gx] = 0;
-            p->active[i] = 0;
-            goto next_grain;
-          }
-          /* Cup is full with correct color: grain stays active.
-           * The solid walls/bottom will cause it to pile up and
-           * eventually spill over the open top rim. */
+      /* One lookup gives the cup, filter and portal under the grain. */
+      const Zone *zone =
+          (gx >= 0 && gx < W && gy >= 0 && gy < H)
+              ? &state->zones.zones[state->zones.id[gy][gx]]
+              : &state->zones.zones[0];
+
+      if (zone->cup >= 0) {
+        const Cup *cup = &lv->cups[zone->cup];
+        int right_color = (cup->required_color == GRAIN_WHITE ||
+                           p->color[i] == (uint8_t)cup->required_color);
+        if (right_color && cup->collected < cup->required_count) {
+          gb->event[i] = GRAIN_EVENT_CUP;
+          gb->event_arg[i] = zone->cup;
+          goto next_grain;
+        } else if (!right_color) {
+          /* Wrong color: discard silently (no penalty). */
+          bitset_clear(occ, gy * W + gx);
+          p->active[i] = 0;
+          goto next_grain;
         }
+        /* Cup is full with correct color: grain stays active.
+         * The solid walls/bottom will cause it to pile up and
+         * eventually spill over the open top rim. */
       }
-    }
 
-    /* ---- Color filter check (AABB) ---- */
-    {
-      int gx = (int)p->x[i], gy = (int)p->y[i];
-      for (int f = 0; f < lv->filter_count; f++) {
-        ColorFilter *flt = &lv->filters[f];
-        if (gx >= flt->x && gx < flt->x + flt->w && gy >= flt->y &&
-            gy < flt->y + flt->h) {
-          p->color[i] = (uint8_t)flt->output_color;
-        }
-      }
-    }
+      /* ---- Color filter (the zone map's AABB) ---- */
+      if (zone->filter >= 0)
+        p->color[i] = (uint8_t)lv->filters[zone->filter].output_color;
 
-    /* ---- Teleporter check (circle distance) ---- */
-    if (p->tpcd[i] == 0) {
-      int gx = (int)p->x[i], gy = (int)p->y[i];
-      for (int t = 0; t < lv->teleporter_count; t++) {
-        Teleporter *tp = &lv->teleporters[t];
-        int da = (gx - tp->ax) * (gx - tp->ax) + (gy - tp->ay) * (gy - tp->ay);
-        int db = (gx - tp->bx) * (gx - tp->bx) + (gy - tp->by) * (gy - tp->by);
-        int r2 = tp->radius * tp->radius;
-        if (da <= r2) {
-          p->x[i] = (float)tp->bx;
-          p->y[i] = (float)tp->by;
-          p->tpcd[i] = 6;
-          break;
-        }
-        if (db <= r2) {
-          p->x[i] = (float)tp->ax;
-          p->y[i] = (float)tp->ay;
-          p->tpcd[i] = 6;
-          break;
-        }
+      /* ---- Teleporter (the zone map's circles) ----
+       * The exit is anywhere on the canvas — jump in the event pass. */
+      if (p->tpcd[i] == 0 && zone->portal >= 0) {
+        gb->event[i] = GRAIN_EVENT_TELEPORT;
+        gb->event_arg[i] = zone->portal;
+        goto next_grain;
       }
     }
 
-    /* ---- Settled grain: bake into line bitmap and free slot ---- */
+    /* ---- Settled grain: put it to sleep ---- */
     {
       /* ---- Displacement-based settle detection (frame-rate independent) ----
        * Compare displacement this frame vs. a threshold that scales with dt.
@@ -851,11 +1336,9 @@ static void update_grains(GameState *state, float dt) {
         p->still[i] = 0;
       }
       if (p->still[i] >= GRAIN_SETTLE_FRAMES) {
-        int bx = (int)p->x[i], by = (int)p->y[i];
-        if (bx >= 0 && bx < W && by >= 0 && by < H)
-          lb->pixels[by * W + bx] = (uint8_t)(p->color[i] + 2);
-        p->active[i] = 0;
-        goto next_grain;
+        p->asleep[i] = 1;
+        p->vx[i] = 0.0f;
+        p->vy[i] = 0.0f;
       }
     }
 
@@ -865,6 +1348,125 @@ static void update_grains(GameState *state, float dt) {
 #undef IS_SOLID
 }
 
+typedef struct {
+  GameState *state;
+  float dt;
+  int parity; /* 0 = even bands this pass, 1 = odd bands */
+} GrainBandPass;
+
+static int grain_band_of(float y) {
+  int band = (int)y / GRAIN_BAND_H;
+  if (band < 0)
+    band = 0;
+  if (band >= GRAIN_BAND_COUNT)
+    band = GRAIN_BAND_COUNT - 1;
+  return band;
+}
+
+static void grain_band_job(void *data, int index) {
+  GrainBandPass *pass = (GrainBandPass *)data;
+  update_grain_band(pass->state, index * 2 + pass->parity, pass->dt);
+}
+
+static void update_grains(GameState *state, float dt) {
+  GrainPool *p = &state->grains;
+  LevelDef *lv = &state->level;
+  GrainBands *gb = &state->bands;
+  int W = CANVAS_W, H = CANVAS_H;
+
+  /* ---- Grain-occupancy bitmap ----
+   * This lets grains collide with *each other*, not just with drawn lines.
+   * It persists across frames (see GrainOccupancy): each grain clears its
+   * bit, moves, and sets the bit at its new pixel.
+   *
+   * Two grains sharing a pixel (emitter spread, wrap, teleport) share one
+   * bit, so the first to leave clears it for both.  A set-only pass at
+   * the end restores those; it touches only x[]/y[] and the L1-resident
+   * bits, where the old per-frame rebuild first cleared 300 KB. */
+  uint64_t *occ = state->occ.bits;
+
+  /* ---- Bucket grains by starting band ----
+   * Counting sort keeps grain-index order inside each band, so the
+   * per-band update order — and the event order — is fixed. */
+  int cursor[GRAIN_BAND_COUNT + 1] = {0};
+  for (int i = 0; i < p->count; i++) {
+    gb->event[i] = GRAIN_EVENT_NONE;
+    if (!p->active[i])
+      continue;
+    cursor[grain_band_of(p->y[i]) + 1]++;
+  }
+  for (int b = 0; b < GRAIN_BAND_COUNT; b++)
+    cursor[b + 1] += cursor[b];
+  memcpy(gb->start, cursor, sizeof(gb->start));
+  for (int i = 0; i < p->count; i++) {
+    if (!p->active[i])
+      continue;
+    gb->order[cursor[grain_band_of(p->y[i])]++] = i;
+  }
+
+  /* ---- Checkerboard passes: even bands in parallel, then odd ---- */
+  GrainBandPass pass = {state, dt, 0};
+  game_parallel_for(&state->jobs, (GRAIN_BAND_COUNT + 1) / 2, grain_band_job,
+                    &pass);
+  pass.parity = 1;
+  game_parallel_for(&state->jobs, GRAIN_BAND_COUNT / 2, grain_band_job,
+                    &pass);
+
+  /* ---- Deferred events, in band order then grain order ---- */
+  for (int k = 0; k < gb->start[GRAIN_BAND_COUNT]; k++) {
+    int i = gb->order[k];
+    int gx = (int)p->x[i], gy = (int)p->y[i];
+    int in_canvas = gx >= 0 && gx < W && gy >= 0 && gy < H;
+
+    switch ((GRAIN_EVENT)gb->event[i]) {
+    case GRAIN_EVENT_CUP: {
+      Cup *cup = &lv->cups[gb->event_arg[i]];
+      if (cup->collected >= cup->required_count)
+        break; /* filled by an earlier grain: stays and spills over */
+      /* Absorb: count this grain, clear its occupancy, remove from sim. */
+      cup->collected++;
+      if (cup->collected >= cup->required_count) {
+        /* Cup just reached 100% — play chime */
+        game_play_sound(&state->audio, SOUND_CUP_FILL);
+      }
+      if (in_canvas)
+        bitset_clear(occ, gy * W + gx); /* grain is gone now */
+      p->active[i] = 0;
+    } break;
+
+    case GRAIN_EVENT_TELEPORT: {
+      const Teleporter *tp = &lv->teleporters[gb->event_arg[i] / 2];
+      int to_b = gb->event_arg[i] & 1;
+      int tx = to_b ? tp->bx : tp->ax, ty = to_b ? tp->by : tp->ay;
+      /* Move the occupancy bit along with the grain. */
+      if (in_canvas)
+        bitset_clear(occ, gy * W + gx);
+      if (tx >= 0 && tx < W && ty >= 0 && ty < H)
+        bitset_set(occ, ty * W + tx);
+      p->x[i] = (float)tx;
+      p->y[i] = (float)ty;
+      p->tpcd[i] = 6;
+      p->still[i] = 0;
+    } break;
+
+    case GRAIN_EVENT_WRAP:
+      /* Its bit was already cleared at the floor; restart at the top. */
+      p->y[i] = 1.f;
+      p->still[i] = 0;
+      break;
+
+    case GRAIN_EVENT_NONE:
+      break;
+    }
+  }
+
+  for (int i = 0; i < p->count; i++) {
+    int ix = (int)p->x[i], iy = (int)p->y[i];
+    if (p->active[i] && ix >= 0 && ix < W && iy >= 0 && iy < H)
+      bitset_set(occ, iy * W + ix);
+  }
+}
+
 static int check_win(GameState *state) {
   LevelDef *lv = &state->level;
   for (int c = 0; c < lv->cup_count; c++) {
@@ -878,16 +1480,60 @@ static int check_win(GameState *state) {
  * LINE BITMAP DRAWING
  * =================================================================== */
 
-static void stamp_circle(LineBitmap *lb, int cx, int cy, int r, uint8_t val) {
-  int W = CANVAS_W, H = CANVAS_H;
+/* Make pixels [x0, x1) of row y solid line (clipped to the canvas), one
+ * word mask per 64 pixels.  A stroke over a baked grain repaints it. */
+static void line_fill_span(LineBitmap *lb, int y, int x0, int x1) {
+  if (y < 0 || y >= CANVAS_H)
+    return;
+  if (x0 < 0)
+    x0 = 0;
+  if (x1 > CANVAS_W)
+    x1 = CANVAS_W;
+  for (int x = x0; x < x1;) {
+    int w = x >> 6, lo = x & 63;
+    int hi = (x1 - (w << 6) < 64) ? x1 - (w << 6) : 64; /* exclusive */
+    uint64_t mask = (hi == 64 ? ~(uint64_t)0 : ((uint64_t)1 << hi) - 1) &
+                    ~(((uint64_t)1 << lo) - 1);
+    lb->solid[y][w] |= mask;
+    lb->baked[y][w] &= ~mask;
+    x = (w + 1) << 6;
+  }
+}
+
+/* Bit k of the result is set when pixel (x0 + k, y) is solid: a line
+ * pixel, an occupied grain pixel, or past a side wall.  n <= 32, and the
+ * span is read with at most two word loads per bitmap. */
+static uint32_t solid_span(const LineBitmap *lb, const uint64_t *occ, int y,
+                           int x0, int n) {
+  uint32_t span = n >= 32 ? ~0u : (1u << n) - 1u; /* all solid so far */
+  int a = x0 < 0 ? 0 : x0;
+  int b = x0 + n > CANVAS_W ? CANVAS_W : x0 + n;
+  if (a >= b)
+    return span;
+
+  const uint64_t *ls = lb->solid[y];
+  const uint64_t *os = occ + y * LINE_ROW_WORDS;
+  int w = a >> 6, sh = a & 63;
+  uint64_t v = (ls[w] | os[w]) >> sh; /* bit 0 = pixel a */
+  if (sh && w + 1 < LINE_ROW_WORDS)
+    v |= (ls[w + 1] | os[w + 1]) << (64 - sh);
+
+  int inside_n = b - a;
+  uint32_t inside =
+      (inside_n >= 32 ? ~0u : (1u << inside_n) - 1u) << (a - x0);
+  return (span & ~inside) | (((uint32_t)v << (a - x0)) & inside);
+}
+
+static void stamp_circle(LineBitmap *lb, int cx, int cy, int r) {
+  /* One span per row: the widest |dx| with dx² + dy² <= r². */
+  int hw = r;
   for (int dy = -r; dy <= r; dy++) {
-    for (int dx = -r; dx <= r; dx++) {
-      if (dx * dx + dy * dy <= r * r) {
-        int px = cx + dx, py = cy + dy;
-        if (px >= 0 && px < W && py >= 0 && py < H)
-          lb->pixels[py * W + px] = val;
-      }
-    }
+    int rem = r * r - dy * dy;
+    while (hw * hw > rem)
+      hw--;
+    while ((hw + 1) * (hw + 1) <= rem)
+      hw++;
+    line_fill_span(lb, cy + dy, cx - hw, cx + hw + 1);
   }
 }
 
@@ -904,7 +1550,7 @@ static void draw_brush_line(LineBitmap *lb, int x0, int y0, int x1, int y1,
   int x = x0, y = y0;
 
   for (;;) {
-    stamp_circle(lb, x, y, radius, 255);
+    stamp_circle(lb, x, y, radius);
     if (x == x1 && y == y1)
       break;
     int e2 = 2 * err;
@@ -934,36 +1580,21 @@ static void draw_rect(GameBackbuffer *bb, int x, int y, int w, int h,
   int y0 = y < 0 ? 0 : y;
   int x1 = (x + w) > bb->width ? bb->width : (x + w);
   int y1 = (y + h) > bb->height ? bb->height : (y + h);
-  for (int py = y0; py < y1; py++) {
-    uint32_t *row = bb->pixels + py * bb->width;
-    for (int px = x0; px < x1; px++)
-      row[px] = color;
-  }
+  if (x1 <= x0)
+    return;
+  De100PixelKernels *kernels = de100_pixel_kernels_get();
+  for (int py = y0; py < y1; py++)
+    kernels->fill_row(bb->pixels + py * bb->width + x0, x1 - x0, color);
 }
 
 static void draw_rect_blend(GameBackbuffer *bb, int x, int y, int w, int h,
                             uint32_t color, int alpha) {
-  /* Alpha-blend: out = (src * a + dst * (255-a)) >> 8 */
-  uint32_t sr = (color >> 16) & 0xFF;
-  uint32_t sg = (color >> 8) & 0xFF;
-  uint32_t sb = color & 0xFF;
-  int x0 = x < 0 ? 0 : x;
-  int y0 = y < 0 ? 0 : y;
-  int x1 = (x + w) > bb->width ? bb->width : (x + w);
-  int y1 = (y + h) > bb->height ? bb->height : (y + h);
-  for (int py = y0; py < y1; py++) {
-    uint32_t *row = bb->pixels + py * bb->width;
-    for (int px = x0; px < x1; px++) {
-      uint32_t dst = row[px];
-      uint32_t dr = (dst >> 16) & 0xFF;
-      uint32_t dg = (dst >> 8) & 0xFF;
-      uint32_t db = dst & 0xFF;
-      uint32_t or_ = (sr * alpha + dr * (255 - alpha)) >> 8;
-      uint32_t og = (sg * alpha + dg * (255 - alpha)) >> 8;
-      uint32_t ob = (sb * alpha + db * (255 - alpha)) >> 8;
-      row[px] = GAME_RGB(or_, og, ob);
-    }
-  }
+  /* out = (src * alpha + dst * (255 - alpha)) / 255 per channel, output
+   * alpha 255; alpha 255 is a plain fill and alpha 0 draws nothing. */
+  GameBackBuffer view = de100_backbuffer_view(bb->pixels, bb->width,
+                                              bb->height, bb->width * 4);
+  de100_raster_rect(&view, x, y, w, h,
+                    (color & 0x00FFFFFFu) | ((uint32_t)alpha << 24));
 }
 
 static void draw_rect_outline(GameBackbuffer *bb, int x, int y, int w, int h,
@@ -974,25 +1605,57 @@ static void draw_rect_outline(GameBackbuffer *bb, int x, int y, int w, int h,
   draw_rect(bb, x + w - 1, y, 1, h, color); /* right  */
 }
 
+/* Pixels [x0, x1) of row y, clipped once */
+static void draw_hspan(GameBackbuffer *bb, int y, int x0, int x1,
+                       uint32_t color) {
+  if ((unsigned)y >= (unsigned)bb->height)
+    return;
+  if (x0 < 0)
+    x0 = 0;
+  if (x1 > bb->width)
+    x1 = bb->width;
+  if (x1 > x0)
+    de100_pixel_kernels_get()->fill_row(bb->pixels + y * bb->width + x0,
+                                        x1 - x0, color);
+}
+
+/* Largest h >= 0 with h * h <= n (n >= 0) */
+static int isqrt_floor(int n) {
+  int h = (int)sqrtf((float)n);
+  while (h * h > n)
+    h--;
+  while ((h + 1) * (h + 1) <= n)
+    h++;
+  return h;
+}
+
 static void draw_circle(GameBackbuffer *bb, int cx, int cy, int r,
                         uint32_t color) {
-  for (int dy = -r; dy <= r; dy++)
-    for (int dx = -r; dx <= r; dx++)
-      if (dx * dx + dy * dy <= r * r)
-        draw_pixel(bb, cx + dx, cy + dy, color);
+  /* One span per row, like stamp_circle: |dx| <= widest with
+   * dx² + dy² <= r². */
+  for (int dy = -r; dy <= r; dy++) {
+    int hw = isqrt_floor(r * r - dy * dy);
+    draw_hspan(bb, cy + dy, cx - hw, cx + hw + 1, color);
+  }
 }
 
 static void draw_circle_outline(GameBackbuffer *bb, int cx, int cy, int r,
                                 uint32_t color) {
-  /* Draw only the pixels that lie on the circumference (within 1 px). */
+  /* The ring (r-1)² <= dx² + dy² <= (r+1)², as spans: per row the outer
+   * span, minus the inner disc's (d² < (r-1)²) when the row crosses it. */
   int r2_outer = (r + 1) * (r + 1);
   int r2_inner = (r - 1) * (r - 1);
-  for (int dy = -r - 1; dy <= r + 1; dy++)
-    for (int dx = -r - 1; dx <= r + 1; dx++) {
-      int d2 = dx * dx + dy * dy;
-      if (d2 >= r2_inner && d2 <= r2_outer)
-        draw_pixel(bb, cx + dx, cy + dy, color);
+  for (int dy = -r - 1; dy <= r + 1; dy++) {
+    int hw_out = isqrt_floor(r2_outer - dy * dy);
+    int inner = r2_inner - dy * dy; /* |dx|² < inner is the hole */
+    if (inner <= 0) {
+      draw_hspan(bb, cy + dy, cx - hw_out, cx + hw_out + 1, color);
+      continue;
     }
+    int hw_in = isqrt_floor(inner - 1);
+    draw_hspan(bb, cy + dy, cx - hw_out, cx - hw_in, color);
+    draw_hspan(bb, cy + dy, cx + hw_in + 1, cx + hw_out + 1, color);
+  }
 }
 
 static void draw_char(GameBackbuffer *bb, int x, int y, char c,
@@ -1182,31 +1845,49 @@ static void render_teleporters(const LevelDef *lv, GameBackbuffer *bb,
   }
 }
 
+/* 8 bits → 8 bytes of 0/1, bit k into byte k: broadcast the byte, keep
+ * bit k of byte k, then carry any set bit up to bit 7 and down to bit 0 */
+static inline uint64_t spread_bits8(uint64_t bits) {
+  uint64_t x = ((bits & 0xFF) * 0x0101010101010101ULL) & 0x8040201008040201ULL;
+  return ((x + 0x7F7F7F7F7F7F7F7FULL) >> 7) & 0x0101010101010101ULL;
+}
+
 static void render_lines(const LineBitmap *lb, GameBackbuffer *bb) {
-  /* Walk every set pixel and paint it.
+  /* Turn each row's bit planes into palette indices (g_line_palette),
+   * then blit them:
    *
-   * LineBitmap pixel value encoding:
-   *   0        → empty (skip)
-   *   1        → obstacle / cup wall  → COLOR_LINE
-   *   255      → player-drawn brush   → COLOR_LINE
-   *   2 .. 5   → baked settled grain, color index = value − 2
-   *              GRAIN_WHITE(0)+2=2 → g_grain_colors[0] = COLOR_CREAM
-   *              GRAIN_RED  (1)+2=3 → g_grain_colors[1] = COLOR_RED
-   *              GRAIN_GREEN(2)+2=4 → g_grain_colors[2] = COLOR_GREEN
-   *              GRAIN_ORANGE(3)+2=5→ g_grain_colors[3] = COLOR_ORANGE
+   *   solid, not baked  → LINE_INDEX_SOLID → COLOR_LINE
+   *   solid and baked   → LINE_INDEX_BAKED + GRAIN_COLOR, where
+   *                       GRAIN_COLOR = color[0] bit | color[1] bit << 1
    *
-   * Previously everything non-zero rendered as COLOR_LINE, which made
-   * settled grains appear as black blobs.  Now they keep their original color.
-   *
-   * Cost: one extra compare per non-zero pixel — negligible at 307,200 pixels.
-   */
-  int total = CANVAS_W * CANVAS_H;
-  for (int i = 0; i < total; i++) {
-    uint8_t v = lb->pixels[i];
-    if (!v) continue;
-    bb->pixels[i] = (v >= 2 && v <= 5)
-                        ? g_grain_colors[v - 2]  /* baked grain: original color */
-                        : COLOR_LINE;            /* drawn line or obstacle wall  */
+   * With baked masked to solid, per pixel the index is just
+   *   solid + baked + (baked & c0) + 2 * (baked & c1)
+   * and eight pixels are done at once as bytes (no carries: max 5).
+   * Empty words (most of the canvas) are skipped before and during the
+   * blit, and a row with no solid bits at all is never blitted. */
+  De100PixelKernels *kernels = de100_pixel_kernels_get();
+  uint8_t index[CANVAS_W];
+  for (int y = 0; y < CANVAS_H; y++) {
+    int any = 0;
+    for (int w = 0; w < LINE_ROW_WORDS; w++) {
+      uint64_t solid = lb->solid[y][w];
+      uint8_t *out = index + (w << 6);
+      if (!solid) {
+        memset(out, 0, 64);
+        continue;
+      }
+      any = 1;
+      uint64_t baked = lb->baked[y][w] & solid;
+      uint64_t c0 = lb->color[0][y][w] & baked, c1 = lb->color[1][y][w] & baked;
+      for (int g = 0; g < 64; g += 8) {
+        uint64_t bytes = spread_bits8(solid >> g) + spread_bits8(baked >> g) +
+                         spread_bits8(c0 >> g) + 2 * spread_bits8(c1 >> g);
+        memcpy(out + g, &bytes, 8);
+      }
+    }
+    if (any)
+      kernels->indexed_row(bb->pixels + y * CANVAS_W, index, CANVAS_W,
+                           g_line_palette);
   }
 }
 
@@ -1241,6 +1922,26 @@ static void render_grains(const GrainPool *p, GameBackbuffer *bb) {
   }
 }
 
+static void render_sand(const SandGrid *sd, GameBackbuffer *bb) {
+  /* One pixel per cell — the grid IS the picture.  Air is skipped eight
+   * cells per load, like the simulation scan. */
+  for (int y = 0; y < CANVAS_H; y++) {
+    const uint8_t *row = sd->cells[y];
+    uint32_t *out = bb->pixels + y * CANVAS_W;
+    for (int x = 0; x < CANVAS_W; x += 8) {
+      uint64_t eight;
+      memcpy(&eight, row + x, 8);
+      if (!eight)
+        continue;
+      for (int k = 0; k < 8; k++) {
+        uint8_t c = row[x + k] & SAND_CELL_COLOR_MASK;
+        if (c)
+          out[x + k] = g_grain_colors[c - 1];
+      }
+    }
+  }
+}
+
 static void render_emitters(const LevelDef *lv, GameBackbuffer *bb) {
   for (int e = 0; e < lv->emitter_count; e++) {
     /* Draw a small triangle / wedge indicating the spout. */
@@ -1391,7 +2092,10 @@ static void render_playing(const GameState *state, GameBackbuffer *bb) {
   render_lines(&state->lines, bb);
 
   /* 7. Sugar grains */
-  render_grains(&state->grains, bb);
+  if (state->level.engine == GRAIN_ENGINE_CELLS)
+    render_sand(&state->sand, bb);
+  else if (state->level.engine != GRAIN_ENGINE_GPU) /* platform draws */
+    render_grains(&state->grains, bb);
 
   /* 8. Emitter spout indicators */
   render_emitters(&state->level, bb);
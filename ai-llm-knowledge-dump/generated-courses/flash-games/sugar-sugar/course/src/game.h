@@ -16,6 +16,9 @@
 
 #include <stdint.h> /* uint32_t, uint8_t  — like TypeScript's number types */
 #include "utils/audio.h" /* GameAudioState, SOUND_ID, AudioOutputBuffer     */
+#include "utils/bitset.h" /* BITSET_WORDS, bitset_test/set/clear           */
+#include "utils/jobs.h"   /* GameJobs, game_parallel_for                    */
+#include "utils/gpu_grains.h" /* GameGpuGrains, GpuGrainStep            */
 
 /* ===================================================================
  * DEBUG HELPERS
@@ -166,7 +169,7 @@ typedef struct {
  *   The minimum ONLY runs inside the "free diagonal found" branch.
  *   When both diagonals are blocked (flat pile), vx and vy are zeroed by
  *   the !slid branch regardless — the minimum never fires, so the grain
- *   settles and bakes correctly.
+ *   settles (and goes to sleep) correctly.
  *
  * Why 25 px/s (not higher):
  *   50 px/s caused sliding grains to fly far from the pile, forming
@@ -212,7 +215,21 @@ typedef struct {
  * so a grain at 50 px/s never settles whether running at 60 fps or 1000 fps.
  * A truly stuck grain (dist ≈ 0) always settles. */
 #define GRAIN_SETTLE_SPEED  10.0f  /* px/s below which a grain is "still"   */
-#define GRAIN_SETTLE_FRAMES 8      /* consecutive "stuck" frames → bake      */
+#define GRAIN_SETTLE_FRAMES 8      /* consecutive "stuck" frames → sleep     */
+
+/* Random x offset at spawn (±EMITTER_SPREAD px), shared by both grain
+ * engines: grains start at different pixels across the nozzle width so
+ * they never all pile on the same column, eliminating the "3 discrete
+ * streams" artifact of every grain colliding at (em->x, em->y). */
+#define EMITTER_SPREAD 3
+
+/* Grain sleep: a settled grain is skipped by the simulation until it could
+ * move again — the pixel below it (in the gravity direction) or one of its
+ * two slide diagonals opens up.  That covers a neighbour leaving, a cup
+ * absorbing the grain underneath, and a gravity flip; brush strokes wake
+ * the grains they touch.  Sleepers stay active (rendered, solid, able to
+ * react later) instead of being baked into the line bitmap, which now only
+ * happens when the pool runs out of free slots. */
 
 /* ===================================================================
  * GRAIN COLORS
@@ -243,10 +260,11 @@ typedef enum {
  *     Those 4 arrays fit in L1/L2 cache together.  Color/active are
  *     never loaded, so no cache pollution.
  *
- * For 4096 grains the gravity pass reads 4×4096×4 = 64 KB — fits in
- * typical 256 KB L2 cache perfectly.
+ * The four float columns total 4×16384×4 = 256 KB, but sleeping grains
+ * (see GRAIN_SETTLE_FRAMES) are skipped, so a frame only streams the
+ * awake ones — typically a few thousand falling grains.
  * =================================================================== */
-#define MAX_GRAINS 4096
+#define MAX_GRAINS 16384
 
 typedef struct {
   float x[MAX_GRAINS];  /* horizontal position (pixels, float for sub-pixel) */
@@ -257,7 +275,9 @@ typedef struct {
   uint8_t active[MAX_GRAINS]; /* 1 = alive, 0 = free slot */
   uint8_t tpcd[MAX_GRAINS]; /* teleport cooldown (frames) to prevent re-entry */
   uint8_t still[MAX_GRAINS]; /* consecutive frames with near-zero velocity */
+  uint8_t asleep[MAX_GRAINS]; /* 1 = settled; skipped until it can move  */
   int count; /* high-watermark: slots 0..count-1 are valid      */
+  int free_hint; /* no free slot below this (see grain_alloc)   */
 } GrainPool;
 
 /* ===================================================================
@@ -298,6 +318,13 @@ typedef struct {
 #define MAX_TELEPORTERS 2
 #define MAX_OBSTACLES 12
 
+/* Which simulation moves this level's sugar (see SAND GRID below). */
+typedef enum {
+  GRAIN_ENGINE_PARTICLES = 0, /* float particles (GrainPool) — the default */
+  GRAIN_ENGINE_CELLS,         /* falling-sand automaton (SandGrid)         */
+  GRAIN_ENGINE_GPU,           /* compute shaders (GameGpuGrains), freeplay */
+} GRAIN_ENGINE;
+
 typedef struct {
   int index;
   Emitter emitters[MAX_EMITTERS];
@@ -312,31 +339,214 @@ typedef struct {
   int obstacle_count;
   int has_gravity_switch; /* 1 = show the gravity flip button */
   int is_cyclic;          /* 1 = sugar wraps bottom → top     */
+  GRAIN_ENGINE engine;    /* zero (PARTICLES) unless a level opts in */
 } LevelDef;
 
 /* ===================================================================
  * LINE BITMAP  (player-drawn + obstacle + baked-grain pixels)
  *
- * Each byte encodes one pixel of the collision + render layer:
- *
- *   0        → empty
- *   1        → obstacle / cup wall (stamped at level load)
- *   255      → player-drawn line (stamped by the brush)
- *   2..5     → baked settled grain, color index = pixels[…] − 2
- *              (GRAIN_WHITE=0 → stored as 2, GRAIN_RED→3, etc.)
+ * Bit planes, one bit per pixel, LINE_ROW_WORDS 64-bit words per row:
  *
- * Physics:  any non-zero value is solid (IS_SOLID checks `!= 0`).
- * Renderer: value 1 or 255 → COLOR_LINE; value 2..5 → grain color.
+ *   solid     → collides: obstacle, cup wall, brush stroke, baked grain
+ *   baked     → subset of solid: a settled grain baked in by the
+ *               pool-full fallback (bake_sleeping_grains)
+ *   color[k]  → bit k of that grain's GRAIN_COLOR (only where baked)
  *
- * This single-byte encoding avoids a second parallel array for
- * "what color was this settled grain?" while keeping O(1) lookup.
+ * Physics reads only `solid`, so one load answers 64 pixels ("is this
+ * 3-pixel slide path clear?" is a shift and a mask).  The renderer skips
+ * all-zero words, and the brush writes each circle row as a word mask.
+ * Obstacles and brush strokes both render as COLOR_LINE, so they share
+ * the plain solid bit.
  *
- * At 640×480 = 307,200 bytes ≈ 300 KB — fits entirely in L2 cache.
+ * Each plane is 640×480 bits = 38 KB (vs 300 KB for a byte per pixel).
+ * Rows use the same word layout as GrainOccupancy, so word w of row y is
+ * occ.bits[y * LINE_ROW_WORDS + w].
  * =================================================================== */
+#define LINE_ROW_WORDS (CANVAS_W / 64)
+
 typedef struct {
-  uint8_t pixels[CANVAS_W * CANVAS_H];
+  uint64_t solid[CANVAS_H][LINE_ROW_WORDS];
+  uint64_t baked[CANVAS_H][LINE_ROW_WORDS];
+  uint64_t color[2][CANVAS_H][LINE_ROW_WORDS]; /* GRAIN_COLOR bit planes */
 } LineBitmap;
 
+/* ===================================================================
+ * GRAIN OCCUPANCY  (one bit per pixel: an active grain is here)
+ *
+ * Lets grains collide with each other.  Kept up to date incrementally:
+ * spawning sets a bit, every grain move clears its old bit and sets the
+ * new one, and every way a grain leaves the simulation clears it.  It
+ * is only wiped on level load — never rebuilt per frame.
+ *
+ * 640×480 bits = 38 KB (vs 300 KB as bytes) — stays cache-resident.
+ * =================================================================== */
+typedef struct {
+  uint64_t bits[BITSET_WORDS(CANVAS_W * CANVAS_H)];
+} GrainOccupancy;
+
+/* ===================================================================
+ * ZONE MAP  (cups, filters and portals, rasterised on level load)
+ *
+ * Every pixel holds a zone id: which cup interior, filter and portal
+ * end cover it (id 0 = none of them).  A moving grain does one byte
+ * load instead of testing every cup, filter and teleporter, so the
+ * per-grain cost no longer grows with the number of zones in a level.
+ *
+ * Overlaps resolve like the per-region loops did: the first cup, the
+ * last filter (it recoloured last), the first teleporter and its end a
+ * over end b.  Distinct combinations are few, so an id fits a byte.
+ *
+ * 640×480 bytes = 300 KB, rebuilt only by level_load.
+ * =================================================================== */
+#define MAX_ZONES 256
+
+#if (MAX_CUPS + 1) * (MAX_FILTERS + 1) * (2 * MAX_TELEPORTERS + 1) >     \
+    MAX_ZONES
+#error "ZONE MAP: every cup/filter/portal combination needs a byte id"
+#endif
+
+typedef struct {
+  int8_t cup;    /* interior of cups[cup], or -1                 */
+  int8_t filter; /* filters[filter] recolours grains here, or -1 */
+  int8_t portal; /* teleporter * 2 + (1 if inside end a), or -1  */
+} Zone;
+
+typedef struct {
+  uint8_t id[CANVAS_H][CANVAS_W]; /* index into zones[]          */
+  Zone zones[MAX_ZONES];          /* zones[0]: no cup/filter/portal */
+  int zone_count;
+} ZoneMap;
+
+/* ===================================================================
+ * LEVEL BAKES  (each level's static pixels, packed once by game_init)
+ *
+ * Obstacles, cup walls and the zone map depend only on the LevelDef,
+ * so game_init rasterises every level once and keeps the result packed:
+ *
+ *   zone table   zone_count, then 3 bytes per Zone
+ *   solid spans  span count, then (y, x0, x1) per run of solid pixels
+ *   zone runs    (length, id) in raster order until the canvas is full
+ *
+ * Loading or restarting a level is then a span fill and a run of
+ * memsets, however many shapes the level has.  A level that doesn't
+ * fit in LEVEL_BAKE_BYTES keeps size 0 and is stamped live as before.
+ * =================================================================== */
+#define TOTAL_LEVELS     30
+#define LEVEL_BAKE_BYTES (256 * 1024) /* all 30 levels pack into ~105 KB */
+
+typedef struct {
+  uint32_t offset; /* into LevelBakes.data                       */
+  uint32_t size;   /* 0 = not baked: level_load stamps it live   */
+} LevelBake;
+
+typedef struct {
+  LevelBake levels[TOTAL_LEVELS];
+  uint32_t used;
+  uint8_t data[LEVEL_BAKE_BYTES];
+} LevelBakes;
+
+/* ===================================================================
+ * GRAIN BANDS  (parallel simulation scratch)
+ *
+ * The canvas is split into horizontal bands of GRAIN_BAND_H rows and
+ * every grain is simulated by the band it starts the frame in.  A grain
+ * moves at most GRAIN_BAND_REACH rows per frame, so everything it reads
+ * or writes lies within REACH rows of its band:
+ *
+ *   band 0  ██████  ← pass 1        while band 0 runs, band 2 runs too:
+ *   band 1  ░░░░░░  ← pass 2        0's footprint ends REACH rows below
+ *   band 2  ██████  ← pass 1        row 60, 2's starts REACH rows above
+ *   band 3  ░░░░░░  ← pass 2        row 120 — they never touch.
+ *
+ * Needs 2 × REACH < GRAIN_BAND_H.  Rows are whole occupancy words
+ * (CANVAS_W is a multiple of 64), so bands never share a word either.
+ *
+ * Anything that touches shared state — cup counters, sounds, and moves
+ * that jump across the canvas (teleport, cyclic wrap) — is recorded as
+ * an event and applied afterwards, band by band, grain by grain.  The
+ * result is identical for any number of threads.
+ * =================================================================== */
+#define GRAIN_BAND_H     60 /* rows per band                             */
+#define GRAIN_BAND_REACH 28 /* max rows a grain moves per frame          */
+#define GRAIN_BAND_COUNT ((CANVAS_H + GRAIN_BAND_H - 1) / GRAIN_BAND_H)
+
+#if CANVAS_W % 64 != 0
+#error "GRAIN BANDS: occupancy rows must not share a 64-bit word"
+#endif
+#if 2 * GRAIN_BAND_REACH >= GRAIN_BAND_H
+#error "GRAIN BANDS: a band's footprint must not reach the band after next"
+#endif
+
+typedef enum {
+  GRAIN_EVENT_NONE = 0,
+  GRAIN_EVENT_CUP,      /* arg = cup index: absorb if it still has room */
+  GRAIN_EVENT_TELEPORT, /* arg = teleporter * 2 + (1 if exiting at b)  */
+  GRAIN_EVENT_WRAP,     /* fell off a cyclic floor: re-enter at the top */
+} GRAIN_EVENT;
+
+typedef struct {
+  int order[MAX_GRAINS];              /* grain indices, grouped by band */
+  int start[GRAIN_BAND_COUNT + 1];    /* band b = order[start[b]..b+1)  */
+  uint8_t event[MAX_GRAINS];          /* GRAIN_EVENT, per grain index   */
+  int event_arg[MAX_GRAINS];
+} GrainBands;
+
+/* ===================================================================
+ * SAND GRID  (cellular-automaton grain engine, sand.c)
+ *
+ * The alternative to GrainPool for huge grain counts: every canvas pixel
+ * is a byte-sized cell, and a grain is just a non-empty cell.  Each step
+ * a grain moves one cell down, else one cell diagonally down, else
+ * stays — so there is no per-grain float state and no pool limit (the
+ * canvas holds up to 307,200 grains).  Obstacles, brush strokes and cup
+ * walls come from the same LineBitmap; cups, filters and portals act on
+ * the cell a grain moves into, with the particle engine's rules.
+ *
+ * Cell byte:  bits 0-2 = GRAIN_COLOR + 1 (0 = empty)
+ *             bit  6   = SAND_CELL_TELEPORTED (ignore portals until out)
+ *
+ * The grid is split into SAND_CHUNK × SAND_CHUNK chunks.  Only chunks
+ * where something moved last step (or that a stroke or gravity flip
+ * woke) are scanned, so a settled pile costs nothing:
+ *
+ *   ┌────┬────┬────┐   █ active: a grain moved in or next to it
+ *   │    │ ██ │    │   · idle: skipped outright
+ *   ├────┼────┼────┤
+ *   │    │ ██ │ ██ │   A move at a chunk edge also wakes the neighbour,
+ *   └────┴────┴────┘   since grains there may now fall into the hole.
+ *
+ * Steps run at a fixed SAND_STEPS_PER_SECOND, so fall speed is the same
+ * at any frame rate.  Teleports and cyclic wraps land far from the scan
+ * position, so they are queued and applied after each step.
+ * =================================================================== */
+#define SAND_CHUNK 64
+#define SAND_CHUNKS_X ((CANVAS_W + SAND_CHUNK - 1) / SAND_CHUNK)
+#define SAND_CHUNKS_Y ((CANVAS_H + SAND_CHUNK - 1) / SAND_CHUNK)
+#define SAND_STEPS_PER_SECOND 300 /* = fall speed in px/s            */
+#define SAND_MAX_STEPS 30         /* per frame, after the dt cap      */
+#define SAND_MAX_JUMPS 2048       /* queued teleports/wraps per step  */
+
+#define SAND_CELL_COLOR_MASK 0x07
+#define SAND_CELL_TELEPORTED 0x40
+
+typedef struct {
+  int16_t x, y;   /* cell the grain is in now            */
+  int16_t tx, ty; /* where it lands if that cell is free */
+  uint8_t portal; /* 1 = teleport, 0 = cyclic wrap       */
+} SandJump;
+
+typedef struct {
+  uint8_t cells[CANVAS_H][CANVAS_W];
+  uint8_t active[SAND_CHUNKS_Y][SAND_CHUNKS_X];    /* scan this step     */
+  uint8_t touched[SAND_CHUNKS_Y][SAND_CHUNKS_X];   /* scan next step     */
+  uint8_t has_zone[SAND_CHUNKS_Y][SAND_CHUNKS_X];  /* cup/filter/portal  */
+  SandJump jumps[SAND_MAX_JUMPS];
+  int jump_count;
+  float step_timer;   /* seconds not yet simulated                */
+  unsigned step;      /* step counter: alternates diagonal bias   */
+  int gravity_sign;   /* gravity the last step ran with           */
+} SandGrid;
+
 /* ===================================================================
  * GAME STATE MACHINE
  * =================================================================== */
@@ -351,7 +561,7 @@ typedef enum {
 /* ===================================================================
  * GAME STATE  (the whole world)
  *
- * Declared as a static local in main() so the ~460 KB of arrays lives in
+ * Declared as a static local in main() so the ~1 MB of arrays lives in
  * the BSS segment (zero-initialised at program start), not on the stack.
  * =================================================================== */
 typedef struct {
@@ -367,6 +577,11 @@ typedef struct {
   /* ---- simulation ---- */
   GrainPool grains; /* SoA particle pool                        */
   LineBitmap lines; /* player-drawn + obstacle pixels           */
+  GrainOccupancy occ; /* pixels holding an active grain          */
+  ZoneMap zones;      /* cup/filter/portal id per pixel          */
+  LevelBakes bakes;   /* lines + zones per level, from game_init */
+  GrainBands bands;   /* per-frame parallel update scratch       */
+  SandGrid sand;      /* cells, when level.engine == CELLS       */
   int gravity_sign; /* +1 = down (normal), -1 = up (flipped)   */
 
   /* ---- UI hover state ---- */
@@ -379,6 +594,10 @@ typedef struct {
 
   /* ---- audio ---- */
   GameAudioState audio; /* procedural sound + music state           */
+
+  /* ---- platform services ---- */
+  GameJobs jobs; /* set by the platform after game_init; zero = inline */
+  GameGpuGrains gpu; /* same; zero = freeplay stays on the CPU       */
 } GameState;
 
 /* ===================================================================
@@ -404,10 +623,26 @@ void game_update(GameState *state, GameInput *input, float delta_time);
  * READ-ONLY on GameState — never modifies simulation data. */
 void game_render(const GameState *state, GameBackbuffer *backbuffer);
 
+/* 1 while the grains live on the GPU: game_render leaves them out and
+ * the platform draws them over the backbuffer (gpu_grains_draw). */
+int game_grains_on_gpu(const GameState *state);
+
 /* Level definitions — defined in levels.c, referenced in game.c */
-#define TOTAL_LEVELS 30
 extern LevelDef g_levels[TOTAL_LEVELS];
 
+/* ===================================================================
+ * SAND API  (implemented in sand.c)
+ *
+ * sand_reset       — empty the grid, mark chunks near cups/filters/portals
+ *                    (call from level_load, after the level is copied)
+ * sand_update      — emit, then run the fixed-rate steps due for dt
+ * sand_wake_stroke — re-scan chunks a brush stroke touched
+ * =================================================================== */
+void sand_reset(SandGrid *sand, const LevelDef *level);
+void sand_update(GameState *state, float delta_time);
+void sand_wake_stroke(SandGrid *sand, int x0, int y0, int x1, int y1,
+                      int radius);
+
 /* ===================================================================
  * AUDIO API  (implemented in audio.c)
  *
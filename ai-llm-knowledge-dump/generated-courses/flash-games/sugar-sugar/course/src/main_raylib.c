@@ -9,6 +9,8 @@
  *   → UpdateTexture() uploads them to the GPU
  *   → DrawTextureEx() renders the texture with letterbox scaling
  *   → channels are swapped back so game state is unaffected
+ *   → in freeplay, gpu_grains_draw() adds the grains straight out of the
+ *     compute pool's buffers (utils/gpu_grains.h), over the texture
  *
  * Audio (AudioStream model):
  *   InitAudioDevice → SetAudioStreamBufferSizeDefault(AUDIO_CHUNK_SIZE)
@@ -21,10 +23,12 @@
  *   clang -Wall -Wextra -O0 -g -DDEBUG -fsanitize=address,undefined \
  *         -o build/game \
  *         src/main_raylib.c src/game.c src/levels.c src/audio.c \
- *         -lraylib -lm -lpthread -ldl
+ *         src/sand.c src/utils/jobs.c src/utils/gpu_grains.c \
+ *         -lraylib -lGL -lm -lpthread -ldl
  */
 
 #include "raylib.h"
+#include "rlgl.h"    /* rlDrawRenderBatchActive */
 
 #include <math.h>    /* fminf  */
 #include <stdlib.h>  /* malloc, free */
@@ -74,6 +78,11 @@ static float g_scale    = 1.0f;
 static int   g_offset_x = 0;
 static int   g_offset_y = 0;
 
+/* Compute-shader grain pool (NULL: no GL 4.3 — freeplay runs on the CPU).
+ * main sets g_gpu_grains_visible each frame from game_grains_on_gpu. */
+static GpuGrainPool *g_gpu_grains;
+static int           g_gpu_grains_visible = 0;
+
 /* Audio globals */
 static AudioStream g_stream;
 static int16_t     g_sample_buffer[AUDIO_CHUNK_SIZE * 4]; /* stereo; 4× for headroom */
@@ -204,6 +213,13 @@ void platform_display_backbuffer(const GameBackbuffer *backbuffer) {
                   0.0f,     /* rotation */
                   g_scale,
                   WHITE);
+    if (g_gpu_grains_visible) {
+        /* Raylib batches the textured quad; flush it so the grains land
+         * on top.  GL's viewport y runs up from the window's bottom. */
+        rlDrawRenderBatchActive();
+        gpu_grains_draw(g_gpu_grains, g_offset_x, win_h - g_offset_y - dst_h,
+                        dst_w, dst_h, 2.0f * g_scale);
+    }
     EndDrawing();
 }
 
@@ -297,6 +313,15 @@ int main(void) {
 
     platform_init("Sugar, Sugar", CANVAS_W, CANVAS_H);
     game_init(&state, &bb);
+    /* Worker threads for the banded grain simulation.  NULL (one core,
+     * or thread creation failed) makes the game run the bands inline. */
+    JobPool *jobs = job_pool_create(job_pool_default_workers());
+    state.jobs = job_pool_service(jobs);
+    /* Raylib's context is current now.  The pool's buffers are sized once
+     * for the canvas; NULL keeps freeplay on the cell engine. */
+    g_gpu_grains = gpu_grains_create(CANVAS_W, CANVAS_H, GPU_GRAINS_CAPACITY);
+    state.gpu = gpu_grains_service(g_gpu_grains);
+
     platform_audio_init(&state, SAMPLES_PER_SECOND);
     /* game_audio_init (called inside platform_audio_init) resets audio state
      * with memset — it wipes the is_playing flag that game_init set via
@@ -321,9 +346,12 @@ int main(void) {
         platform_get_input(&input);
         game_update(&state, &input, delta_time);
         game_render(&state, &bb);
+        g_gpu_grains_visible = g_gpu_grains && game_grains_on_gpu(&state);
         platform_display_backbuffer(&bb);
     }
 
+    job_pool_destroy(jobs);
+    gpu_grains_destroy(g_gpu_grains); /* before the context goes */
     platform_audio_shutdown();
     UnloadTexture(g_texture);
     CloseWindow();
@@ -446,6 +446,11 @@ int main(void) {
      * the entire GameAudioState — including the is_playing flag set by
      * game_init via change_phase(PHASE_TITLE).  Retrigger title music here
      * after audio is fully initialised so music starts on launch. */
+    /* Worker threads for the banded grain simulation.  NULL (one core,
+     * or thread creation failed) makes the game run the bands inline. */
+    JobPool *jobs = job_pool_create(job_pool_default_workers());
+    state.jobs = job_pool_service(jobs);
+
     platform_audio_init(&state, 44100);
     game_music_play_title(&state.audio);
 
@@ -506,6 +511,7 @@ int main(void) {
     }
 
     /* Cleanup */
+    job_pool_destroy(jobs);
     platform_audio_shutdown();
     if (g_ximage) {
         /* Prevent XDestroyImage from freeing our pixel data
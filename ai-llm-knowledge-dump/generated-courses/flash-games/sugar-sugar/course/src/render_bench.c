@@ -0,0 +1,149 @@
+/*
+ * render_bench.c  —  Sugar, Sugar | render_lines Benchmark
+ *
+ * Build & run:  ./build-dev.sh --backend=render-bench -r
+ *               ./build/render-bench [frames] [seed]
+ *
+ * render_lines always walks the whole 640x480 line bitmap, so instead of
+ * buffer sizes this sweeps how much of it is drawn on: the share of 64-px
+ * words holding any solid bits (0% = an empty level, 100% = every word
+ * busy).  A quarter of the busy words also hold baked grains with random
+ * colors, so both palette paths run.
+ *
+ * For each coverage level draws `frames` frames and prints Mpix/s and
+ * cycles/px over the whole canvas (__rdtsc ticks: compare runs on one
+ * machine only) from the fastest frame, the solid pixel count, and an
+ * FNV-1a checksum of the frame.  Same seed ⇒ same checksum, so a change
+ * that alters output shows up in the diff.
+ *
+ * render_lines is private to game.c, so this file compiles game.c into
+ * itself rather than linking it; the render-bench backend leaves game.c
+ * out of its sources for that reason.
+ */
+#define _POSIX_C_SOURCE 199309L /* clock_gettime under -std=c99 */
+#include "game.c"
+
+#include <stdio.h>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h> /* __rdtsc() */
+#endif
+
+static const int bench_coverages[] = {0, 5, 25, 100}; /* % of words busy */
+
+static LineBitmap bench_lines;
+static uint32_t bench_pixels[CANVAS_W * CANVAS_H];
+
+static uint32_t bench_rand(uint32_t *state) {
+  uint32_t x = *state;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  return *state = x;
+}
+
+static uint64_t bench_rand64(uint32_t *state) {
+  uint64_t hi = bench_rand(state);
+  return (hi << 32) | bench_rand(state);
+}
+
+static double bench_seconds(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static uint64_t bench_cycles(void) {
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  return 0; /* cycles/px reads 0: no counter on this target */
+#endif
+}
+
+static uint32_t bench_checksum(const GameBackbuffer *bb) {
+  uint32_t hash = 2166136261u;
+  const uint8_t *bytes = (const uint8_t *)bb->pixels;
+  for (int i = 0; i < bb->height * bb->pitch; i++)
+    hash = (hash ^ bytes[i]) * 16777619u;
+  return hash;
+}
+
+/* Returns the number of solid pixels */
+static long long bench_build_lines(LineBitmap *lb, int coverage,
+                                   uint32_t seed) {
+  long long solid_pixels = 0;
+  memset(lb, 0, sizeof(*lb));
+  for (int y = 0; y < CANVAS_H; y++) {
+    for (int w = 0; w < LINE_ROW_WORDS; w++) {
+      if ((int)(bench_rand(&seed) % 100) >= coverage)
+        continue;
+      uint64_t solid = bench_rand64(&seed) | 1; /* never an empty word */
+      lb->solid[y][w] = solid;
+      if (bench_rand(&seed) % 4 == 0) {
+        lb->baked[y][w] = solid & bench_rand64(&seed);
+        lb->color[0][y][w] = bench_rand64(&seed);
+        lb->color[1][y][w] = bench_rand64(&seed);
+      }
+      solid_pixels += __builtin_popcountll(solid);
+    }
+  }
+  return solid_pixels;
+}
+
+int main(int argc, char **argv) {
+  int frames = argc > 1 ? atoi(argv[1]) : 100;
+  uint32_t seed = argc > 2 ? (uint32_t)strtoul(argv[2], NULL, 10) : 1;
+  if (seed == 0)
+    seed = 1; /* xorshift's only fixed point */
+  if (frames <= 0)
+    frames = 100;
+
+  GameBackbuffer bb = {
+      .pixels = bench_pixels,
+      .width = CANVAS_W,
+      .height = CANVAS_H,
+      .pitch = CANVAS_W * 4,
+  };
+  long long canvas_pixels = (long long)CANVAS_W * CANVAS_H;
+
+  printf("%d frames per case (fastest kept), seed %u, canvas %dx%d\n\n",
+         frames, seed, CANVAS_W, CANVAS_H);
+  printf("%-9s %12s %12s %10s %10s\n", "coverage", "solid px", "Mpix/s",
+         "cycles/px", "checksum");
+
+  int coverage_count =
+      (int)(sizeof(bench_coverages) / sizeof(bench_coverages[0]));
+  for (int c = 0; c < coverage_count; c++) {
+    long long solid = bench_build_lines(&bench_lines, bench_coverages[c], seed);
+
+    double best_seconds = 1e30;
+    uint64_t best_cycles = UINT64_MAX;
+    uint32_t checksum = 0;
+    for (int frame = 0; frame < frames; frame++) {
+      /* Same starting frame every time, so the checksum is stable */
+      memset(bench_pixels, 0x20, sizeof(bench_pixels));
+
+      double start = bench_seconds();
+      uint64_t start_cycles = bench_cycles();
+      render_lines(&bench_lines, &bb);
+      uint64_t cycles = bench_cycles() - start_cycles;
+      double seconds = bench_seconds() - start;
+
+      if (seconds < best_seconds)
+        best_seconds = seconds;
+      if (cycles < best_cycles)
+        best_cycles = cycles;
+      if (frame == 0)
+        checksum = bench_checksum(&bb);
+    }
+    if (best_seconds <= 0.0)
+      best_seconds = 1e-9;
+
+    printf("%8d%% %12lld %12.1f %10.2f %10u\n", bench_coverages[c], solid,
+           (double)canvas_pixels / best_seconds * 1e-6,
+           (double)best_cycles / (double)canvas_pixels, checksum);
+  }
+  return 0;
+}
@@ -0,0 +1,324 @@
+/*
+ * sand.c  —  Sugar, Sugar | Falling-Sand Grain Engine
+ *
+ * The cellular-automaton alternative to the particle simulation in
+ * game.c, picked per level with LevelDef.engine = GRAIN_ENGINE_CELLS.
+ * See SAND GRID in game.h for the data layout.
+ *
+ * One step, gravity down (reversed gravity mirrors every row):
+ *
+ *   . G .     G moves to the first free cell of:
+ *   1 . 2       below, then one diagonal, then the other
+ *
+ * Rows are scanned against gravity (bottom row first), so a grain that
+ * moves lands in a row that was already scanned and cannot move twice in
+ * one step.  Which diagonal is tried first alternates with the step and
+ * column, so piles grow symmetrically with no random numbers in the
+ * update — the same input always gives the same sand.
+ *
+ * JS analogy: a Uint8Array "game of life" where only dirty tiles tick.
+ */
+
+#include "game.h"
+
+#include <stdlib.h> /* rand()         */
+#include <string.h> /* memset, memcpy */
+
+#define W CANVAS_W
+#define H CANVAS_H
+
+/* ===================================================================
+ * CELL HELPERS
+ * =================================================================== */
+
+static inline int sand_line_solid(const LineBitmap *lb, int x, int y) {
+  return (int)((lb->solid[y][x >> 6] >> (x & 63)) & 1);
+}
+
+/* Free = inside the side walls, no line pixel, no grain. */
+static inline int sand_free(const SandGrid *sd, const LineBitmap *lb, int x,
+                            int y) {
+  return x >= 0 && x < W && !sd->cells[y][x] && !sand_line_solid(lb, x, y);
+}
+
+/* Something changed at (x, y): scan its chunk next step, plus any
+ * neighbour chunk within one cell (a grain there may now fall in). */
+static void sand_touch(SandGrid *sd, int x, int y) {
+  int cx0 = (x > 0 ? x - 1 : 0) / SAND_CHUNK;
+  int cx1 = (x < W - 1 ? x + 1 : W - 1) / SAND_CHUNK;
+  int cy0 = (y > 0 ? y - 1 : 0) / SAND_CHUNK;
+  int cy1 = (y < H - 1 ? y + 1 : H - 1) / SAND_CHUNK;
+  for (int cy = cy0; cy <= cy1; cy++)
+    for (int cx = cx0; cx <= cx1; cx++)
+      sd->touched[cy][cx] = 1;
+}
+
+static void sand_queue_jump(SandGrid *sd, int x, int y, int tx, int ty,
+                            int portal) {
+  if (sd->jump_count >= SAND_MAX_JUMPS)
+    return; /* retried the next time the grain moves */
+  SandJump *j = &sd->jumps[sd->jump_count++];
+  j->x = (int16_t)x;
+  j->y = (int16_t)y;
+  j->tx = (int16_t)tx;
+  j->ty = (int16_t)ty;
+  j->portal = (uint8_t)portal;
+}
+
+/* ===================================================================
+ * LEVEL ZONES  (cups, filters, portals)
+ *
+ * Same rules as the particle engine: a grain inside a cup interior is
+ * absorbed (right colour, room left) or discarded (wrong colour); inside
+ * a filter it takes the filter's colour; inside a portal it jumps to the
+ * other end unless it just arrived through one.
+ * =================================================================== */
+
+/* Apply zones to the grain that just moved into (x, y).  Returns 0 if
+ * the grain is gone. */
+static int sand_apply_zones(GameState *state, int x, int y) {
+  SandGrid *sd = &state->sand;
+  LevelDef *lv = &state->level;
+  uint8_t *cell = &sd->cells[y][x];
+  int color = (*cell & SAND_CELL_COLOR_MASK) - 1;
+
+  /* One lookup: the cup, filter and portal under this cell. */
+  const Zone *zone = &state->zones.zones[state->zones.id[y][x]];
+
+  if (zone->cup >= 0) {
+    Cup *cup = &lv->cups[zone->cup];
+    int right_color = (cup->required_color == GRAIN_WHITE ||
+                       color == (int)cup->required_color);
+    /* Full: pile up and spill over the rim. */
+    if (!right_color || cup->collected < cup->required_count) {
+      if (right_color) {
+        cup->collected++;
+        if (cup->collected >= cup->required_count)
+          game_play_sound(&state->audio, SOUND_CUP_FILL);
+      }
+      *cell = 0;
+      sand_touch(sd, x, y);
+      return 0;
+    }
+  }
+
+  if (zone->filter >= 0)
+    *cell = (uint8_t)((*cell & ~SAND_CELL_COLOR_MASK) |
+                      (lv->filters[zone->filter].output_color + 1));
+
+  if (zone->portal >= 0) {
+    const Teleporter *tp = &lv->teleporters[zone->portal / 2];
+    if (!(*cell & SAND_CELL_TELEPORTED)) {
+      if (zone->portal & 1) /* inside end a */
+        sand_queue_jump(sd, x, y, tp->bx, tp->by, 1);
+      else
+        sand_queue_jump(sd, x, y, tp->ax, tp->ay, 1);
+    }
+  } else {
+    *cell &= (uint8_t)~SAND_CELL_TELEPORTED;
+  }
+  return 1;
+}
+
+/* Flag every chunk overlapping pixels [x0, x1) × [y0, y1). */
+static void sand_mark_zone(SandGrid *sd, int x0, int y0, int x1, int y1) {
+  if (x0 < 0) x0 = 0;
+  if (y0 < 0) y0 = 0;
+  if (x1 > W) x1 = W;
+  if (y1 > H) y1 = H;
+  for (int cy = y0 / SAND_CHUNK; y0 < y1 && cy <= (y1 - 1) / SAND_CHUNK; cy++)
+    for (int cx = x0 / SAND_CHUNK; x0 < x1 && cx <= (x1 - 1) / SAND_CHUNK;
+         cx++)
+      sd->has_zone[cy][cx] = 1;
+}
+
+/* ===================================================================
+ * STEP
+ * =================================================================== */
+
+/* Try to move the grain at (x, y) one cell with gravity. */
+static void sand_move(GameState *state, int x, int y, int g) {
+  SandGrid *sd = &state->sand;
+  const LineBitmap *lb = &state->lines;
+  int ny = y + g;
+
+  if (ny < 0)
+    return; /* resting against the ceiling */
+  if (ny >= H) {
+    if (state->level.is_cyclic) {
+      sand_queue_jump(sd, x, y, x, 0, 0);
+    } else {
+      sd->cells[y][x] = 0; /* fell off the bottom */
+      sand_touch(sd, x, y);
+    }
+    return;
+  }
+
+  int d = ((sd->step + (unsigned)x) & 1) ? 1 : -1;
+  int nx;
+  if (sand_free(sd, lb, x, ny))
+    nx = x;
+  else if (sand_free(sd, lb, x + d, ny))
+    nx = x + d;
+  else if (sand_free(sd, lb, x - d, ny))
+    nx = x - d;
+  else
+    return; /* blocked on all three: stays (its chunk may go idle) */
+
+  uint8_t c = sd->cells[y][x];
+  sd->cells[y][x] = 0;
+  sd->cells[ny][nx] = c;
+  sand_touch(sd, x, y);
+  sand_touch(sd, nx, ny);
+
+  if (sd->has_zone[ny / SAND_CHUNK][nx / SAND_CHUNK])
+    sand_apply_zones(state, nx, ny);
+  else
+    sd->cells[ny][nx] &= (uint8_t)~SAND_CELL_TELEPORTED;
+}
+
+static void sand_apply_jumps(GameState *state) {
+  SandGrid *sd = &state->sand;
+  const LineBitmap *lb = &state->lines;
+  for (int i = 0; i < sd->jump_count; i++) {
+    const SandJump *j = &sd->jumps[i];
+    uint8_t c = sd->cells[j->y][j->x];
+    if (!c || j->ty < 0 || j->ty >= H || !sand_free(sd, lb, j->tx, j->ty))
+      continue; /* moved on, or the exit is blocked: try again later */
+    sd->cells[j->y][j->x] = 0;
+    sd->cells[j->ty][j->tx] =
+        j->portal ? (uint8_t)(c | SAND_CELL_TELEPORTED) : c;
+    sand_touch(sd, j->x, j->y);
+    sand_touch(sd, j->tx, j->ty);
+    if (sd->has_zone[j->ty / SAND_CHUNK][j->tx / SAND_CHUNK])
+      sand_apply_zones(state, j->tx, j->ty);
+  }
+  sd->jump_count = 0;
+}
+
+static void sand_step(GameState *state) {
+  SandGrid *sd = &state->sand;
+  int g = state->gravity_sign;
+
+  memcpy(sd->active, sd->touched, sizeof(sd->active));
+  memset(sd->touched, 0, sizeof(sd->touched));
+
+  int y_first = g > 0 ? H - 1 : 0;
+  for (int y = y_first; y >= 0 && y < H; y -= g) {
+    const uint8_t *chunk_row = sd->active[y / SAND_CHUNK];
+    uint8_t *row = sd->cells[y];
+    for (int cx = 0; cx < SAND_CHUNKS_X; cx++) {
+      if (!chunk_row[cx])
+        continue;
+      int x0 = cx * SAND_CHUNK;
+      int x1 = x0 + SAND_CHUNK < W ? x0 + SAND_CHUNK : W;
+      for (int x = x0; x < x1;) {
+        /* Eight empty cells per load — most of an active chunk is air. */
+        uint64_t eight;
+        if (x + 8 <= x1) {
+          memcpy(&eight, row + x, 8);
+          if (!eight) {
+            x += 8;
+            continue;
+          }
+        }
+        if (row[x])
+          sand_move(state, x, y, g);
+        x++;
+      }
+    }
+  }
+
+  sand_apply_jumps(state);
+  sd->step++;
+}
+
+/* ===================================================================
+ * EMITTERS
+ * =================================================================== */
+
+static void sand_emit(GameState *state, float dt) {
+  SandGrid *sd = &state->sand;
+  LevelDef *lv = &state->level;
+  for (int e = 0; e < lv->emitter_count; e++) {
+    Emitter *em = &lv->emitters[e];
+    em->spawn_timer += dt;
+    float interval = 1.0f / (float)em->grains_per_second;
+    while (em->spawn_timer >= interval) {
+      em->spawn_timer -= interval;
+      int x = em->x + (rand() % (2 * EMITTER_SPREAD + 1)) - EMITTER_SPREAD;
+      int y = em->y;
+      if (y < 0 || y >= H || !sand_free(sd, &state->lines, x, y))
+        continue; /* spout blocked: this grain is lost */
+      sd->cells[y][x] = (uint8_t)(GRAIN_WHITE + 1);
+      sand_touch(sd, x, y);
+    }
+  }
+}
+
+/* ===================================================================
+ * PUBLIC API
+ * =================================================================== */
+
+void sand_reset(SandGrid *sd, const LevelDef *lv) {
+  memset(sd, 0, sizeof(*sd));
+  sd->gravity_sign = 1;
+
+  /* Chunks overlapping any zone's bounding box run sand_apply_zones. */
+  for (int c = 0; c < lv->cup_count; c++) {
+    const Cup *cup = &lv->cups[c];
+    sand_mark_zone(sd, cup->x, cup->y, cup->x + cup->w, cup->y + cup->h);
+  }
+  for (int f = 0; f < lv->filter_count; f++) {
+    const ColorFilter *flt = &lv->filters[f];
+    sand_mark_zone(sd, flt->x, flt->y, flt->x + flt->w, flt->y + flt->h);
+  }
+  for (int t = 0; t < lv->teleporter_count; t++) {
+    const Teleporter *tp = &lv->teleporters[t];
+    int r = tp->radius;
+    sand_mark_zone(sd, tp->ax - r, tp->ay - r, tp->ax + r + 1, tp->ay + r + 1);
+    sand_mark_zone(sd, tp->bx - r, tp->by - r, tp->bx + r + 1, tp->by + r + 1);
+  }
+}
+
+void sand_wake_stroke(SandGrid *sd, int x0, int y0, int x1, int y1,
+                      int radius) {
+  /* Bounding box of the stroke, grown by the brush plus one cell for the
+   * grains resting on (or under) it. */
+  int minx = (x0 < x1 ? x0 : x1) - radius - 1;
+  int maxx = (x0 > x1 ? x0 : x1) + radius + 1;
+  int miny = (y0 < y1 ? y0 : y1) - radius - 1;
+  int maxy = (y0 > y1 ? y0 : y1) + radius + 1;
+  if (minx < 0) minx = 0;
+  if (miny < 0) miny = 0;
+  if (maxx > W - 1) maxx = W - 1;
+  if (maxy > H - 1) maxy = H - 1;
+  if (minx > maxx || miny > maxy)
+    return;
+  for (int cy = miny / SAND_CHUNK; cy <= maxy / SAND_CHUNK; cy++)
+    for (int cx = minx / SAND_CHUNK; cx <= maxx / SAND_CHUNK; cx++)
+      sd->touched[cy][cx] = 1;
+}
+
+void sand_update(GameState *state, float dt) {
+  SandGrid *sd = &state->sand;
+
+  /* A gravity flip can unsettle every pile. */
+  if (sd->gravity_sign != state->gravity_sign) {
+    sd->gravity_sign = state->gravity_sign;
+    memset(sd->touched, 1, sizeof(sd->touched));
+  }
+
+  sand_emit(state, dt);
+
+  float step_dt = 1.0f / (float)SAND_STEPS_PER_SECOND;
+  sd->step_timer += dt;
+  int steps = 0;
+  while (sd->step_timer >= step_dt && steps < SAND_MAX_STEPS) {
+    sd->step_timer -= step_dt;
+    sand_step(state);
+    steps++;
+  }
+  if (steps == SAND_MAX_STEPS)
+    sd->step_timer = 0.0f; /* don't spiral after a long stall */
+}
@@ -0,0 +1,43 @@
+/*
+ * utils/bitset.h  —  Sugar, Sugar | One-Bit-Per-Cell Bitmaps
+ *
+ * A packed set of flags, 64 per word.  Used for the grain-occupancy map:
+ * 640×480 pixels cost 38 KB as bits instead of 300 KB as bytes, so the
+ * random "is this pixel taken?" probes of the grain simulation stay in
+ * L1/L2 cache instead of streaming through memory.
+ *
+ * Usage:
+ *   uint64_t bits[BITSET_WORDS(CANVAS_W * CANVAS_H)];
+ *   bitset_clear_all(bits, CANVAS_W * CANVAS_H);
+ *   bitset_set(bits, y * CANVAS_W + x);
+ *   if (bitset_test(bits, y * CANVAS_W + x)) ...
+ *
+ * JS analogy: a Uint32Array used as a bitfield, with `i >> 5` / `i & 31`.
+ */
+
+#ifndef UTILS_BITSET_H
+#define UTILS_BITSET_H
+
+#include <stdint.h>
+#include <string.h>
+
+/* Words needed to hold `n` bits. */
+#define BITSET_WORDS(n) (((n) + 63) / 64)
+
+static inline int bitset_test(const uint64_t *bits, int i) {
+  return (int)((bits[i >> 6] >> (i & 63)) & 1u);
+}
+
+static inline void bitset_set(uint64_t *bits, int i) {
+  bits[i >> 6] |= (uint64_t)1 << (i & 63);
+}
+
+static inline void bitset_clear(uint64_t *bits, int i) {
+  bits[i >> 6] &= ~((uint64_t)1 << (i & 63));
+}
+
+static inline void bitset_clear_all(uint64_t *bits, int n) {
+  memset(bits, 0, (size_t)BITSET_WORDS(n) * sizeof(uint64_t));
+}
+
+#endif /* UTILS_BITSET_H */
@@ -0,0 +1,716 @@
+/*
+ * utils/gpu_grains.c  —  Sugar, Sugar | Compute-Shader Grain Pool
+ *
+ * Storage buffers (std430), bound at the same points in every program:
+ *
+ *   0 pos    vec2 per grain        4 occ    occupancy bit plane
+ *   1 vel    vec2 per grain        5 zones  zone id per pixel (4 a word)
+ *   2 meta   packed flags/color    6 world  counters, cups, zones, spawns
+ *   3 solid  LineBitmap.solid      7 free   stack of released slots
+ *
+ * A step is three dispatches: the spawn pass pops slots off the free
+ * stack (or takes new ones past high_water) for this frame's spawns, the
+ * step pass moves every slot below high_water, and the mark pass re-sets
+ * every live grain's occupancy bit.  Grains that leave push their slot
+ * back.  Pops and pushes never share a dispatch, so the stack needs
+ * nothing stronger than atomicAdd.
+ *
+ * A move claims its pixel with atomicOr before letting go of the old
+ * one, and the loser of a race stays put.  Spawns claim theirs the same
+ * way, so only a teleport or wrap can land two grains on one pixel.
+ *
+ * The bit planes are the CPU's 64-bit row words read as pairs of 32-bit
+ * words: on a little-endian machine bit x of a row is the same bit.
+ */
+
+#ifdef GPU_GRAINS_GLES
+#include <GLES3/gl31.h>
+#else
+#define GL_GLEXT_PROTOTYPES
+#include <GL/glcorearb.h>
+#endif
+
+#include "gpu_grains.h"
+
+#include <stddef.h> /* offsetof */
+#include <stdlib.h> /* calloc, free */
+#include <string.h> /* memset */
+
+#define GPU_GRAINS_GROUP 64 /* local_size_x of the compute passes */
+
+enum {
+  GPU_BUF_POS = 0,
+  GPU_BUF_VEL,
+  GPU_BUF_META,
+  GPU_BUF_SOLID,
+  GPU_BUF_OCC,
+  GPU_BUF_ZONES,
+  GPU_BUF_WORLD,
+  GPU_BUF_FREE,
+  GPU_BUF_COUNT
+};
+
+/* Mirrors the shader's World block (std430: ints pack at 4 bytes, the
+ * Zone structs and vec4s start on 16). */
+typedef struct {
+  uint32_t high_water; /* slots handed out so far (may overshoot) */
+  int32_t free_count;
+  int32_t spawn_count;
+  int32_t pad;
+  int32_t cup_room[GPU_GRAINS_MAX_CUPS];
+  uint32_t cup_absorbed[GPU_GRAINS_MAX_CUPS];
+  int32_t cup_color[GPU_GRAINS_MAX_CUPS];
+  GpuGrainZone zones[GPU_GRAINS_MAX_ZONES];
+  float spawn_motion[GPU_GRAINS_MAX_SPAWNS][4]; /* x, y, vx, vy */
+  int32_t spawn_color[GPU_GRAINS_MAX_SPAWNS];
+} GpuWorld;
+
+typedef char gpu_world_zones_aligned[offsetof(GpuWorld, zones) % 16 ? -1 : 1];
+typedef char gpu_world_spawns_aligned
+    [offsetof(GpuWorld, spawn_motion) % 16 ? -1 : 1];
+
+struct GpuGrainPool {
+  int width, height, capacity;
+  int high_water; /* upper bound on the GPU's high_water */
+  int cup_count;
+  GLuint buffers[GPU_BUF_COUNT];
+  GLuint spawn_program, step_program, mark_program, draw_program;
+  GLuint vao;
+  GpuWorld world; /* upload scratch */
+};
+
+/* ===================================================================
+ * SHADERS
+ * =================================================================== */
+
+#ifdef GPU_GRAINS_GLES
+static const char *g_preamble = "#version 310 es\n"
+                                "precision highp float;\n"
+                                "precision highp int;\n";
+#else
+static const char *g_preamble = "#version 430\n";
+#endif
+
+static const char *g_meta_glsl =
+    "const uint ACTIVE = 0x100u;\n"
+    "const uint ASLEEP = 0x200u;\n"
+    "const uint COLOR_MASK = 0xFFu;\n" /* tpcd: bits 16-23, still: 24-31 */
+    "const uint TPCD_SHIFT = 16u;\n"
+    "const uint STILL_SHIFT = 24u;\n";
+
+static const char *g_buffers_glsl =
+    "layout(local_size_x = 64) in;\n"
+    "layout(std430, binding = 0) buffer Pos { vec2 pos[]; };\n"
+    "layout(std430, binding = 1) buffer Vel { vec2 vel[]; };\n"
+    "layout(std430, binding = 2) buffer Meta { uint meta[]; };\n"
+    "layout(std430, binding = 3) readonly buffer Solid { uint solid[]; };\n"
+    "layout(std430, binding = 4) coherent buffer Occ { uint occ[]; };\n"
+    "layout(std430, binding = 5) readonly buffer Zones { uint zone_ids[]; };\n"
+    "struct Zone { int cup; int color; int exit_x; int exit_y; };\n"
+    "layout(std430, binding = 6) coherent buffer World {\n"
+    "  uint high_water;\n"
+    "  int free_count;\n"
+    "  int spawn_count;\n"
+    "  int pad;\n"
+    "  int cup_room[8];\n"
+    "  uint cup_absorbed[8];\n"
+    "  int cup_color[8];\n"
+    "  Zone zones[256];\n"
+    "  vec4 spawn_motion[1024];\n"
+    "  int spawn_color[1024];\n"
+    "};\n"
+    "layout(std430, binding = 7) coherent buffer Free { uint free_slots[]; };\n"
+    "uniform ivec2 u_size;\n"
+    "uniform uint u_capacity;\n"
+    "bool in_canvas(ivec2 p) {\n"
+    "  return p.x >= 0 && p.x < u_size.x && p.y >= 0 && p.y < u_size.y;\n"
+    "}\n"
+    "int word_of(int x, int y) { return y * (u_size.x >> 5) + (x >> 5); }\n"
+    "uint bit_of(int x) { return 1u << uint(x & 31); }\n"
+    "void set_occ(ivec2 p) { atomicOr(occ[word_of(p.x, p.y)], bit_of(p.x)); }\n"
+    "bool claim(ivec2 p) {\n" /* set the bit; false if it already was */
+    "  uint b = bit_of(p.x);\n"
+    "  return (atomicOr(occ[word_of(p.x, p.y)], b) & b) == 0u;\n"
+    "}\n"
+    "void clear_occ(ivec2 p) {\n"
+    "  atomicAnd(occ[word_of(p.x, p.y)], ~bit_of(p.x));\n"
+    "}\n";
+
+/* Unlike the CPU, a spawn never lands on a grain: stacked grains race
+ * for the same pixels every frame and can't pull apart.  It takes the
+ * nearest free pixel within SPAWN_REACH columns, or is dropped while the
+ * spout is choked. */
+static const char *g_spawn_glsl =
+    "const int SPAWN_REACH = 3;\n"
+    "void main() {\n"
+    "  int s = int(gl_GlobalInvocationID.x);\n"
+    "  if (s >= spawn_count) return;\n"
+    "  vec4 m = spawn_motion[s];\n"
+    "  ivec2 p = ivec2(m.xy);\n"
+    "  if (!in_canvas(p)) return;\n"
+    "  bool placed = false;\n"
+    "  for (int k = 0; k <= 2 * SPAWN_REACH && !placed; k++) {\n"
+    "    int dx = (k & 1) != 0 ? (k + 1) / 2 : -(k / 2);\n" /* 0,1,-1,2.. */
+    "    ivec2 at = ivec2(p.x + dx, p.y);\n"
+    "    if (in_canvas(at) &&\n"
+    "        (solid[word_of(at.x, at.y)] & bit_of(at.x)) == 0u &&\n"
+    "        claim(at)) {\n"
+    "      m.x += float(dx);\n"
+    "      p = at;\n"
+    "      placed = true;\n"
+    "    }\n"
+    "  }\n"
+    "  if (!placed) return;\n"
+    "  uint slot;\n"
+    "  int top = atomicAdd(free_count, -1) - 1;\n"
+    "  if (top >= 0) {\n"
+    "    slot = free_slots[top];\n"
+    "  } else {\n"
+    "    atomicAdd(free_count, 1);\n" /* nothing to pop: undo */
+    "    slot = high_water < u_capacity ? atomicAdd(high_water, 1u)\n"
+    "                                    : u_capacity;\n"
+    "    if (slot >= u_capacity) {\n" /* pool full: dropped */
+    "      clear_occ(p);\n"
+    "      return;\n"
+    "    }\n"
+    "  }\n"
+    "  pos[slot] = m.xy;\n"
+    "  vel[slot] = m.zw;\n"
+    "  meta[slot] = uint(spawn_color[s]) | ACTIVE;\n"
+    "}\n";
+
+/* The CPU engine's set-only pass: two grains that ended up on one pixel
+ * share its bit, and the first to leave clears it for both. */
+static const char *g_mark_glsl =
+    "void main() {\n"
+    "  uint i = gl_GlobalInvocationID.x;\n"
+    "  if (i >= min(high_water, u_capacity) || (meta[i] & ACTIVE) == 0u)\n"
+    "    return;\n"
+    "  ivec2 p = ivec2(pos[i]);\n"
+    "  if (in_canvas(p)) set_occ(p);\n"
+    "}\n";
+
+/* update_grain_band, one grain per invocation.  The CPU clears a grain's
+ * bit, moves it and sets the new one — run concurrently, every moving
+ * grain's pixel would look free to its neighbours for the whole pass.
+ * Here a grain keeps its pixel (`home`, ignored by its own tests) until
+ * it has claimed the next; losing that race counts as a collision and
+ * it stays.  Cups, teleports and wraps, deferred to a serial pass on the
+ * CPU, apply at once, with cup room claimed atomically. */
+static const char *g_step_glsl =
+    "uniform float u_dt, u_gravity, u_max_vx, u_max_vy, u_drag;\n"
+    "uniform float u_slide_min, u_bounce, u_bounce_min, u_settle_sq;\n"
+    "uniform int u_settle_frames, u_slide_reach, u_tp_cooldown, u_cyclic;\n"
+    "ivec2 home;\n"
+    "bool is_solid(int x, int y) {\n"
+    "  if (x < 0 || x >= u_size.x) return true;\n"
+    "  int w = word_of(x, y);\n"
+    "  uint grains = ivec2(x, y) == home ? 0u : occ[w];\n"
+    "  return ((solid[w] | grains) & bit_of(x)) != 0u;\n"
+    "}\n"
+    "void leave_home() {\n"
+    "  if (in_canvas(home)) clear_occ(home);\n"
+    "}\n"
+    "void release(uint i) {\n"
+    "  meta[i] = 0u;\n"
+    "  free_slots[atomicAdd(free_count, 1)] = i;\n"
+    "}\n"
+    "float bounce(float impact) {\n"
+    "  return impact > u_bounce_min ? -impact * u_bounce : 0.0;\n"
+    "}\n"
+    "void main() {\n"
+    "  uint i = gl_GlobalInvocationID.x;\n"
+    "  if (i >= min(high_water, u_capacity)) return;\n"
+    "  uint m = meta[i];\n"
+    "  if ((m & ACTIVE) == 0u) return;\n"
+    "  int W = u_size.x, H = u_size.y;\n"
+    "  int below = u_gravity >= 0.0 ? 1 : -1;\n"
+    "  vec2 p = pos[i], v = vel[i];\n"
+    "  uint color = m & COLOR_MASK;\n"
+    "  uint tpcd = (m >> TPCD_SHIFT) & 0xFFu;\n"
+    "  uint still = m >> STILL_SHIFT;\n"
+    "  home = ivec2(p);\n"
+    "  if ((m & ASLEEP) != 0u) {\n"
+    "    int sx = home.x, sy = home.y + below;\n"
+    "    if (sy < 0) return;\n"
+    "    if (sy < H && is_solid(sx - 1, sy) && is_solid(sx, sy) &&\n"
+    "        is_solid(sx + 1, sy)) return;\n"
+    "    still = 0u;\n"
+    "  }\n"
+    "  v.y = clamp(v.y + u_gravity * u_dt, -u_max_vy, u_max_vy);\n"
+    "  v.x = clamp(v.x, -u_max_vx, u_max_vx) * u_drag;\n"
+    "  vec2 pre = p;\n"
+    "  vec2 total = v * u_dt;\n"
+    "  int steps = min(int(abs(total.x) + abs(total.y)) + 1, 32);\n"
+    "  vec2 sd = total / float(steps);\n"
+    "  bool wrapped = false;\n"
+    "  for (int s = 0; s < steps; s++) {\n"
+    "    vec2 n = p + sd;\n"
+    "    int ix = int(n.x), iy = int(n.y);\n"
+    "    if (ix < 0) { p.x = 0.0; v.x = 0.0; break; }\n"
+    "    if (ix >= W) { p.x = float(W - 1); v.x = 0.0; break; }\n"
+    "    if (iy < 0) { p.y = 0.0; v.y = 0.0; break; }\n"
+    "    if (iy >= H) {\n"
+    "      if (u_cyclic == 0) { leave_home(); release(i); return; }\n"
+    "      p = vec2(n.x, 1.0);\n"
+    "      still = 0u;\n"
+    "      wrapped = true;\n"
+    "      break;\n"
+    "    }\n"
+    "    if (!is_solid(ix, iy)) { p = n; continue; }\n"
+    "    int ox = int(p.x), oy = int(p.y);\n"
+    "    if (iy != oy) {\n"
+    "      int d1 = v.x >= 0.0 ? 1 : -1;\n"
+    "      bool slid = false;\n"
+    "      for (int dist = 1; dist <= u_slide_reach && !slid; dist++) {\n"
+    "        for (int attempt = 0; attempt < 2 && !slid; attempt++) {\n"
+    "          int d = attempt == 0 ? d1 : -d1;\n"
+    "          bool clear = true;\n"
+    "          for (int k = 1; k <= dist; k++)\n"
+    "            if (is_solid(ox + d * k, iy)) clear = false;\n"
+    "          if (clear) {\n"
+    "            float impact = abs(v.y);\n"
+    "            v.x = float(d) * clamp(impact, u_slide_min, u_max_vx);\n"
+    "            v.y = bounce(impact);\n"
+    "            p = vec2(float(ox + d * dist), float(iy));\n"
+    "            slid = true;\n"
+    "          }\n"
+    "        }\n"
+    "      }\n"
+    "      if (!slid) { v.y = bounce(abs(v.y)); v.x = 0.0; }\n"
+    "    } else {\n"
+    "      v.x = 0.0;\n"
+    "    }\n"
+    "    break;\n"
+    "  }\n"
+    "  ivec2 cell = ivec2(p);\n"
+    "  bool lost = false;\n"
+    "  if (cell != home) {\n"
+    "    if (!in_canvas(cell) || claim(cell) || wrapped) {\n"
+    "      leave_home();\n"
+    "    } else {\n" /* lost the pixel to another grain: retry next */
+    "      p = pre;\n"
+    "      cell = home;\n"
+    "      lost = true;\n"
+    "    }\n"
+    "  }\n"
+    "  if (!wrapped) {\n"
+    "    if (tpcd > 0u) tpcd--;\n"
+    "    Zone z = zones[0];\n"
+    "    if (in_canvas(cell)) {\n"
+    "      int at = cell.y * W + cell.x;\n"
+    "      z = zones[(zone_ids[at >> 2] >> uint((at & 3) * 8)) & 0xFFu];\n"
+    "    }\n"
+    "    if (z.cup >= 0) {\n"
+    "      int want = cup_color[z.cup];\n"
+    "      if (want != 0 && uint(want) != color) {\n"
+    "        clear_occ(cell);\n" /* wrong color: discarded */
+    "        release(i);\n"
+    "        return;\n"
+    "      }\n"
+    "      if (atomicAdd(cup_room[z.cup], -1) > 0) {\n"
+    "        atomicAdd(cup_absorbed[z.cup], 1u);\n"
+    "        clear_occ(cell);\n"
+    "        release(i);\n"
+    "        return;\n"
+    "      }\n"
+    "      atomicAdd(cup_room[z.cup], 1);\n" /* full: stays, spills over */
+    "    }\n"
+    "    if (z.color >= 0) color = uint(z.color);\n"
+    "    if (tpcd == 0u && z.exit_x >= 0) {\n"
+    "      if (in_canvas(cell)) clear_occ(cell);\n"
+    "      p = vec2(float(z.exit_x), float(z.exit_y));\n"
+    "      if (in_canvas(ivec2(p))) set_occ(ivec2(p));\n"
+    "      tpcd = uint(u_tp_cooldown);\n"
+    "      still = 0u;\n"
+    "    } else {\n"
+    "      vec2 dd = p - pre;\n"
+    "      if (lost) {\n" /* blocked by a race, not resting */
+    "      } else if (dot(dd, dd) < u_settle_sq) {\n"
+    "        if (still < 255u) still++;\n"
+    "      } else {\n"
+    "        still = 0u;\n"
+    "      }\n"
+    "    }\n"
+    "  }\n"
+    "  bool asleep = still >= uint(u_settle_frames);\n"
+    "  if (asleep) v = vec2(0.0);\n"
+    "  pos[i] = p;\n"
+    "  vel[i] = v;\n"
+    "  meta[i] = color | ACTIVE | (asleep ? ASLEEP : 0u) |\n"
+    "            (tpcd << TPCD_SHIFT) | (still << STILL_SHIFT);\n"
+    "}\n";
+
+/* The 2×2 block render_grains draws, as one point at its centre. */
+static const char *g_vertex_glsl =
+    "layout(location = 0) in vec2 a_pos;\n"
+    "layout(location = 1) in uint a_meta;\n"
+    "uniform vec2 u_canvas;\n"
+    "uniform float u_point_size;\n"
+    "uniform vec4 u_palette[8];\n"
+    "out vec4 v_color;\n"
+    "void main() {\n"
+    "  gl_PointSize = u_point_size;\n"
+    "  if ((a_meta & ACTIVE) == 0u) {\n"
+    "    gl_Position = vec4(2.0, 2.0, 2.0, 1.0);\n" /* clipped */
+    "    v_color = vec4(0.0);\n"
+    "    return;\n"
+    "  }\n"
+    "  vec2 c = (floor(a_pos) + 1.0) / u_canvas;\n"
+    "  gl_Position = vec4(c.x * 2.0 - 1.0, 1.0 - c.y * 2.0, 0.0, 1.0);\n"
+    "  v_color = u_palette[min(a_meta & COLOR_MASK, 7u)];\n"
+    "}\n";
+
+static const char *g_fragment_glsl = "in vec4 v_color;\n"
+                                     "out vec4 o_color;\n"
+                                     "void main() { o_color = v_color; }\n";
+
+static GLuint compile_shader(GLenum type, const char **parts, int count) {
+  GLuint shader = glCreateShader(type);
+  glShaderSource(shader, count, parts, NULL);
+  glCompileShader(shader);
+  GLint ok = 0;
+  glGetShaderiv(shader, GL_COMPILE_STATUS, &ok);
+  if (!ok) {
+    glDeleteShader(shader);
+    return 0;
+  }
+  return shader;
+}
+
+/* Link `a` (and `b`, if non-zero) into a program; consumes both. */
+static GLuint link_program(GLuint a, GLuint b) {
+  if (!a) {
+    if (b)
+      glDeleteShader(b);
+    return 0;
+  }
+  GLuint program = glCreateProgram();
+  glAttachShader(program, a);
+  if (b)
+    glAttachShader(program, b);
+  glLinkProgram(program);
+  glDeleteShader(a);
+  if (b)
+    glDeleteShader(b);
+  GLint ok = 0;
+  glGetProgramiv(program, GL_LINK_STATUS, &ok);
+  if (!ok) {
+    glDeleteProgram(program);
+    return 0;
+  }
+  return program;
+}
+
+static GLuint build_compute(const char *body) {
+  const char *parts[] = {g_preamble, g_meta_glsl, g_buffers_glsl, body};
+  return link_program(compile_shader(GL_COMPUTE_SHADER, parts, 4), 0);
+}
+
+static GLuint build_draw(void) {
+  const char *vs[] = {g_preamble, g_meta_glsl, g_vertex_glsl};
+  const char *fs[] = {g_preamble, g_fragment_glsl};
+  GLuint vertex = compile_shader(GL_VERTEX_SHADER, vs, 3);
+  GLuint fragment = compile_shader(GL_FRAGMENT_SHADER, fs, 2);
+  if (!fragment) {
+    if (vertex)
+      glDeleteShader(vertex);
+    return 0;
+  }
+  return link_program(vertex, fragment);
+}
+
+/* ===================================================================
+ * BUFFERS
+ * =================================================================== */
+
+static GLuint make_buffer(GLsizeiptr size) {
+  GLuint buffer = 0;
+  glGenBuffers(1, &buffer);
+  glBindBuffer(GL_SHADER_STORAGE_BUFFER, buffer);
+  glBufferData(GL_SHADER_STORAGE_BUFFER, size, NULL, GL_DYNAMIC_DRAW);
+  return buffer;
+}
+
+/* Zero `size` bytes (glClearBufferData is not in GLES 3.1). */
+static void zero_buffer(GLuint buffer, GLsizeiptr size) {
+  static const uint8_t zeros[65536];
+  glBindBuffer(GL_SHADER_STORAGE_BUFFER, buffer);
+  for (GLsizeiptr at = 0; at < size; at += (GLsizeiptr)sizeof(zeros)) {
+    GLsizeiptr n = size - at < (GLsizeiptr)sizeof(zeros)
+                       ? size - at
+                       : (GLsizeiptr)sizeof(zeros);
+    glBufferSubData(GL_SHADER_STORAGE_BUFFER, at, n, zeros);
+  }
+}
+
+static void upload(GLuint buffer, size_t offset, size_t size,
+                   const void *data) {
+  glBindBuffer(GL_SHADER_STORAGE_BUFFER, buffer);
+  glBufferSubData(GL_SHADER_STORAGE_BUFFER, (GLintptr)offset,
+                  (GLsizeiptr)size, data);
+}
+
+static GLint uniform(GLuint program, const char *name) {
+  return glGetUniformLocation(program, name);
+}
+
+/* ===================================================================
+ * PUBLIC API
+ * =================================================================== */
+
+GpuGrainPool *gpu_grains_create(int width, int height, int capacity) {
+  GLint major = 0, minor = 0, blocks = 0;
+  glGetIntegerv(GL_MAJOR_VERSION, &major);
+  glGetIntegerv(GL_MINOR_VERSION, &minor);
+#ifdef GPU_GRAINS_GLES
+  if (major * 10 + minor < 31)
+    return NULL;
+#else
+  if (major * 10 + minor < 43)
+    return NULL;
+#endif
+  glGetIntegerv(GL_MAX_COMPUTE_SHADER_STORAGE_BLOCKS, &blocks);
+  if (blocks < GPU_BUF_COUNT || width % 32 != 0 || capacity <= 0)
+    return NULL;
+
+  GpuGrainPool *pool = (GpuGrainPool *)calloc(1, sizeof(*pool));
+  if (!pool)
+    return NULL;
+  pool->width = width;
+  pool->height = height;
+  pool->capacity = capacity;
+
+  pool->spawn_program = build_compute(g_spawn_glsl);
+  pool->step_program = build_compute(g_step_glsl);
+  pool->mark_program = build_compute(g_mark_glsl);
+  pool->draw_program = build_draw();
+  if (!pool->spawn_program || !pool->step_program || !pool->mark_program ||
+      !pool->draw_program) {
+    gpu_grains_destroy(pool);
+    return NULL;
+  }
+
+  GLsizeiptr plane = (GLsizeiptr)height * (width / 32) * 4;
+  pool->buffers[GPU_BUF_POS] = make_buffer((GLsizeiptr)capacity * 8);
+  pool->buffers[GPU_BUF_VEL] = make_buffer((GLsizeiptr)capacity * 8);
+  pool->buffers[GPU_BUF_META] = make_buffer((GLsizeiptr)capacity * 4);
+  pool->buffers[GPU_BUF_SOLID] = make_buffer(plane);
+  pool->buffers[GPU_BUF_OCC] = make_buffer(plane);
+  pool->buffers[GPU_BUF_ZONES] = make_buffer((GLsizeiptr)width * height);
+  pool->buffers[GPU_BUF_WORLD] = make_buffer(sizeof(GpuWorld));
+  pool->buffers[GPU_BUF_FREE] = make_buffer((GLsizeiptr)capacity * 4);
+  glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+  /* The draw reads the pos and meta columns as vertex attributes. */
+  glGenVertexArrays(1, &pool->vao);
+  glBindVertexArray(pool->vao);
+  glBindBuffer(GL_ARRAY_BUFFER, pool->buffers[GPU_BUF_POS]);
+  glEnableVertexAttribArray(0);
+  glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 0, NULL);
+  glBindBuffer(GL_ARRAY_BUFFER, pool->buffers[GPU_BUF_META]);
+  glEnableVertexAttribArray(1);
+  glVertexAttribIPointer(1, 1, GL_UNSIGNED_INT, 0, NULL);
+  glBindVertexArray(0);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+  GLuint programs[] = {pool->spawn_program, pool->step_program,
+                       pool->mark_program};
+  for (int k = 0; k < 3; k++) {
+    glProgramUniform2i(programs[k], uniform(programs[k], "u_size"), width,
+                       height);
+    glProgramUniform1ui(programs[k], uniform(programs[k], "u_capacity"),
+                        (GLuint)capacity);
+  }
+  glProgramUniform2f(pool->draw_program,
+                     uniform(pool->draw_program, "u_canvas"), (float)width,
+                     (float)height);
+
+  gpu_grains_reset(pool, &(GpuGrainLevel){0});
+  if (glGetError() != GL_NO_ERROR) {
+    gpu_grains_destroy(pool);
+    return NULL;
+  }
+  return pool;
+}
+
+void gpu_grains_destroy(GpuGrainPool *pool) {
+  if (!pool)
+    return;
+  glDeleteBuffers(GPU_BUF_COUNT, pool->buffers);
+  if (pool->vao)
+    glDeleteVertexArrays(1, &pool->vao);
+  glDeleteProgram(pool->spawn_program);
+  glDeleteProgram(pool->step_program);
+  glDeleteProgram(pool->mark_program);
+  glDeleteProgram(pool->draw_program);
+  free(pool);
+}
+
+void gpu_grains_reset(void *opaque, const GpuGrainLevel *level) {
+  GpuGrainPool *pool = (GpuGrainPool *)opaque;
+  GpuWorld *world = &pool->world;
+  memset(world, 0, offsetof(GpuWorld, spawn_motion));
+
+  pool->cup_count = level->cup_count < GPU_GRAINS_MAX_CUPS
+                        ? level->cup_count
+                        : GPU_GRAINS_MAX_CUPS;
+  for (int c = 0; c < pool->cup_count; c++) {
+    world->cup_room[c] = level->cups[c].room;
+    world->cup_color[c] = level->cups[c].color;
+  }
+  /* Zone 0 (no cup, filter or portal) also stands in for ids past the
+   * table. */
+  for (int z = 0; z < GPU_GRAINS_MAX_ZONES; z++)
+    world->zones[z] = (GpuGrainZone){-1, -1, -1, -1};
+  int zone_count = level->zone_count < GPU_GRAINS_MAX_ZONES
+                       ? level->zone_count
+                       : GPU_GRAINS_MAX_ZONES;
+  for (int z = 0; z < zone_count; z++)
+    world->zones[z] = level->zones[z];
+  upload(pool->buffers[GPU_BUF_WORLD], 0, offsetof(GpuWorld, spawn_motion),
+         world);
+
+  size_t pixels = (size_t)pool->width * (size_t)pool->height;
+  if (level->zone_ids)
+    upload(pool->buffers[GPU_BUF_ZONES], 0, pixels, level->zone_ids);
+  else
+    zero_buffer(pool->buffers[GPU_BUF_ZONES], (GLsizeiptr)pixels);
+  zero_buffer(pool->buffers[GPU_BUF_META], (GLsizeiptr)pool->capacity * 4);
+  zero_buffer(pool->buffers[GPU_BUF_OCC], (GLsizeiptr)pixels / 8);
+  glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+  pool->high_water = 0;
+
+  float palette[GPU_GRAINS_MAX_COLORS][4] = {{0}};
+  for (int k = 0; k < level->palette_count && k < GPU_GRAINS_MAX_COLORS;
+       k++) {
+    uint32_t c = level->palette[k];
+    palette[k][0] = (float)((c >> 16) & 0xFF) / 255.0f;
+    palette[k][1] = (float)((c >> 8) & 0xFF) / 255.0f;
+    palette[k][2] = (float)(c & 0xFF) / 255.0f;
+    palette[k][3] = (float)((c >> 24) & 0xFF) / 255.0f;
+  }
+  glProgramUniform4fv(pool->draw_program,
+                      uniform(pool->draw_program, "u_palette"),
+                      GPU_GRAINS_MAX_COLORS, &palette[0][0]);
+}
+
+void gpu_grains_step(void *opaque, const GpuGrainStep *step, int *absorbed) {
+  GpuGrainPool *pool = (GpuGrainPool *)opaque;
+  GpuWorld *world = &pool->world;
+  GLuint world_buffer = pool->buffers[GPU_BUF_WORLD];
+
+  /* ---- Cups: what the previous step absorbed ----
+   * That dispatch went out a frame ago, so the map rarely waits. */
+  size_t absorbed_at = offsetof(GpuWorld, cup_absorbed);
+  size_t absorbed_size = sizeof(world->cup_absorbed);
+  glBindBuffer(GL_SHADER_STORAGE_BUFFER, world_buffer);
+  const uint32_t *counts = (const uint32_t *)glMapBufferRange(
+      GL_SHADER_STORAGE_BUFFER, (GLintptr)absorbed_at,
+      (GLsizeiptr)absorbed_size, GL_MAP_READ_BIT);
+  for (int c = 0; c < pool->cup_count; c++)
+    absorbed[c] = counts ? (int)counts[c] : 0;
+  if (counts)
+    glUnmapBuffer(GL_SHADER_STORAGE_BUFFER);
+  memset(world->cup_absorbed, 0, absorbed_size);
+  upload(world_buffer, absorbed_at, absorbed_size, world->cup_absorbed);
+
+  /* ---- This frame's spawns and the solid plane ---- */
+  int spawn_count = step->spawn_count < GPU_GRAINS_MAX_SPAWNS
+                        ? step->spawn_count
+                        : GPU_GRAINS_MAX_SPAWNS;
+  for (int s = 0; s < spawn_count; s++) {
+    const GpuGrainSpawn *spawn = &step->spawns[s];
+    world->spawn_motion[s][0] = spawn->x;
+    world->spawn_motion[s][1] = spawn->y;
+    world->spawn_motion[s][2] = spawn->vx;
+    world->spawn_motion[s][3] = spawn->vy;
+    world->spawn_color[s] = spawn->color;
+  }
+  world->spawn_count = spawn_count;
+  upload(world_buffer, offsetof(GpuWorld, spawn_count),
+         sizeof(world->spawn_count), &world->spawn_count);
+  if (spawn_count > 0) {
+    upload(world_buffer, offsetof(GpuWorld, spawn_motion),
+           (size_t)spawn_count * sizeof(world->spawn_motion[0]),
+           world->spawn_motion);
+    upload(world_buffer, offsetof(GpuWorld, spawn_color),
+           (size_t)spawn_count * sizeof(world->spawn_color[0]),
+           world->spawn_color);
+  }
+  upload(pool->buffers[GPU_BUF_SOLID], 0,
+         (size_t)pool->height * (size_t)(pool->width / 8), step->solid);
+  glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+  for (GLuint b = 0; b < GPU_BUF_COUNT; b++)
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, b, pool->buffers[b]);
+
+  /* ---- Spawn pass ---- */
+  if (spawn_count > 0) {
+    glUseProgram(pool->spawn_program);
+    glDispatchCompute(
+        (GLuint)((spawn_count + GPU_GRAINS_GROUP - 1) / GPU_GRAINS_GROUP), 1,
+        1);
+    glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+    pool->high_water += spawn_count;
+    if (pool->high_water > pool->capacity)
+      pool->high_water = pool->capacity;
+  }
+
+  /* ---- Step pass ---- */
+  if (pool->high_water > 0) {
+    GLuint program = pool->step_program;
+    glUseProgram(program);
+    glUniform1f(uniform(program, "u_dt"), step->dt);
+    glUniform1f(uniform(program, "u_gravity"), step->gravity);
+    glUniform1f(uniform(program, "u_max_vx"), step->max_vx);
+    glUniform1f(uniform(program, "u_max_vy"), step->max_vy);
+    glUniform1f(uniform(program, "u_drag"), step->drag);
+    glUniform1f(uniform(program, "u_slide_min"), step->slide_min);
+    glUniform1f(uniform(program, "u_bounce"), step->bounce);
+    glUniform1f(uniform(program, "u_bounce_min"), step->bounce_min);
+    glUniform1f(uniform(program, "u_settle_sq"),
+                step->settle_speed * step->settle_speed * step->dt *
+                    step->dt);
+    glUniform1i(uniform(program, "u_settle_frames"), step->settle_frames);
+    glUniform1i(uniform(program, "u_slide_reach"), step->slide_reach);
+    glUniform1i(uniform(program, "u_tp_cooldown"), step->teleport_cooldown);
+    glUniform1i(uniform(program, "u_cyclic"), step->is_cyclic);
+    GLuint groups =
+        (GLuint)((pool->high_water + GPU_GRAINS_GROUP - 1) / GPU_GRAINS_GROUP);
+    glDispatchCompute(groups, 1, 1);
+    glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+
+    /* ---- Mark pass ---- */
+    glUseProgram(pool->mark_program);
+    glDispatchCompute(groups, 1, 1);
+  }
+  glUseProgram(0);
+
+  /* The draw reads pos/meta as attributes; the next step maps World. */
+  glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT |
+                  GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT |
+                  GL_BUFFER_UPDATE_BARRIER_BIT);
+}
+
+void gpu_grains_draw(GpuGrainPool *pool, int x, int y, int w, int h,
+                     float point_size) {
+  if (pool->high_water == 0)
+    return;
+  GLint viewport[4];
+  glGetIntegerv(GL_VIEWPORT, viewport);
+  glViewport(x, y, w, h);
+#ifndef GPU_GRAINS_GLES
+  glEnable(GL_PROGRAM_POINT_SIZE);
+#endif
+  glUseProgram(pool->draw_program);
+  glUniform1f(uniform(pool->draw_program, "u_point_size"), point_size);
+  glBindVertexArray(pool->vao);
+  glDrawArrays(GL_POINTS, 0, pool->high_water);
+  glBindVertexArray(0);
+  glUseProgram(0);
+#ifndef GPU_GRAINS_GLES
+  glDisable(GL_PROGRAM_POINT_SIZE);
+#endif
+  glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+}
@@ -0,0 +1,120 @@
+/*
+ * utils/gpu_grains.h  —  Sugar, Sugar | Compute-Shader Grain Pool
+ *
+ * An optional platform service, handed to the game after game_init like
+ * GameJobs.  A backend with a GL 4.3 / GLES 3.1 context creates the pool
+ * and the game moves freeplay's sugar onto the GPU:
+ *
+ *   platform:  GpuGrainPool *gpu = gpu_grains_create(CANVAS_W, CANVAS_H,
+ *                                                    GPU_GRAINS_CAPACITY);
+ *              state.gpu = gpu_grains_service(gpu);   // NULL → CPU only
+ *
+ *   game:      state->gpu.reset(state->gpu.pool, &level);   // on load
+ *              state->gpu.step(state->gpu.pool, &step, absorbed);
+ *
+ *   platform:  gpu_grains_draw(gpu, x, y, w, h, point_size);
+ *
+ * The grain columns (position, velocity, packed color/flags) and the
+ * solid + occupancy bit planes live in shader storage buffers; one
+ * compute pass spawns, one moves every grain with the particle rules of
+ * update_grain_band, and the positions are drawn straight out of the same
+ * buffers as points — the pool never comes back to the CPU.  Only the
+ * per-cup absorbed counts are read back, one frame late.
+ *
+ * Grains race each other for occupancy bits, so results depend on the
+ * GPU's thread scheduling.  The game only offloads freeplay; the levels
+ * keep the deterministic CPU engines.
+ */
+
+#ifndef UTILS_GPU_GRAINS_H
+#define UTILS_GPU_GRAINS_H
+
+#include <stdint.h>
+
+#define GPU_GRAINS_CAPACITY   262144 /* default pool size              */
+#define GPU_GRAINS_MAX_SPAWNS 1024   /* per step; extra spawns dropped */
+#define GPU_GRAINS_MAX_ZONES  256
+#define GPU_GRAINS_MAX_CUPS   8
+#define GPU_GRAINS_MAX_COLORS 8
+
+/* One grain the emitters poured this frame. */
+typedef struct {
+  float x, y, vx, vy;
+  int color;
+} GpuGrainSpawn;
+
+/* What a zone id does to a grain (the game's ZoneMap, resolved). */
+typedef struct {
+  int cup;            /* index into GpuGrainLevel.cups, or -1          */
+  int color;          /* filter output color, or -1                    */
+  int exit_x, exit_y; /* portal exit, or exit_x = -1                   */
+} GpuGrainZone;
+
+typedef struct {
+  int color; /* required color; 0 (white) takes any */
+  int room;  /* grains it can still take            */
+} GpuGrainCup;
+
+/* Everything fixed for a level: uploaded once by reset. */
+typedef struct {
+  const uint8_t *zone_ids; /* height × width zone ids, row-major       */
+  const GpuGrainZone *zones;
+  int zone_count;
+  const GpuGrainCup *cups;
+  int cup_count;
+  const uint32_t *palette; /* 0xAARRGGBB per color, for drawing        */
+  int palette_count;
+} GpuGrainLevel;
+
+/* One frame.  The tuning mirrors the CPU engine's constants. */
+typedef struct {
+  float dt;
+  float gravity; /* px/s², negative when flipped */
+  float max_vx, max_vy, drag;
+  float slide_min, bounce, bounce_min, settle_speed;
+  int settle_frames, slide_reach, teleport_cooldown;
+  int is_cyclic;
+  const uint64_t *solid; /* height rows of width/64 words (LineBitmap) */
+  const GpuGrainSpawn *spawns;
+  int spawn_count;
+} GpuGrainStep;
+
+typedef void GpuGrainsResetFn(void *pool, const GpuGrainLevel *level);
+/* `absorbed[c]`: grains cup c took during the previous step. */
+typedef void GpuGrainsStepFn(void *pool, const GpuGrainStep *step,
+                             int *absorbed);
+
+typedef struct {
+  void *pool;              /* opaque platform object              */
+  GpuGrainsResetFn *reset; /* NULL → no GPU: the CPU engines run  */
+  GpuGrainsStepFn *step;
+} GameGpuGrains;
+
+/* ---- Platform-side pool (utils/gpu_grains.c, needs a current GL
+ *      4.3 / GLES 3.1 context; build with -DGPU_GRAINS_GLES for ES) ---- */
+typedef struct GpuGrainPool GpuGrainPool;
+
+/* NULL when the context is too old or a shader fails to build. */
+GpuGrainPool *gpu_grains_create(int width, int height, int capacity);
+void gpu_grains_destroy(GpuGrainPool *pool);
+
+void gpu_grains_reset(void *pool, const GpuGrainLevel *level);
+void gpu_grains_step(void *pool, const GpuGrainStep *step, int *absorbed);
+
+/* Draw every live grain as a point_size square into the viewport rect
+ * (x, y from the framebuffer's bottom-left) the canvas is shown in. */
+void gpu_grains_draw(GpuGrainPool *pool, int x, int y, int w, int h,
+                     float point_size);
+
+/* GameGpuGrains for `pool`, or the CPU-only service when pool is NULL. */
+static inline GameGpuGrains gpu_grains_service(GpuGrainPool *pool) {
+  GameGpuGrains gpu = {0};
+  if (pool) {
+    gpu.pool = pool;
+    gpu.reset = gpu_grains_reset;
+    gpu.step = gpu_grains_step;
+  }
+  return gpu;
+}
+
+#endif /* UTILS_GPU_GRAINS_H */
@@ -0,0 +1,155 @@
+/*
+ * utils/jobs.c  —  Sugar, Sugar | POSIX-Thread Job Pool
+ *
+ * Workers sleep on a condition variable.  parallel_for publishes a batch
+ * (fn, data, count), bumps `batch` to wake everyone, and then claims
+ * indices itself alongside the workers from one atomic counter.  It
+ * returns once every index has finished AND every worker has left the
+ * batch, so the caller can treat it as an ordinary (blocking) function
+ * call and the next batch never overwrites fields a straggler still reads.
+ */
+
+#ifndef _DEFAULT_SOURCE
+#define _DEFAULT_SOURCE /* sysconf(_SC_NPROCESSORS_ONLN) */
+#endif
+
+#include "jobs.h"
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#define JOB_POOL_MAX_WORKERS 32
+
+struct JobPool {
+  pthread_t threads[JOB_POOL_MAX_WORKERS];
+  int worker_count;
+
+  pthread_mutex_t mutex;
+  pthread_cond_t wake;  /* workers: a new batch (or quit) is posted */
+  pthread_cond_t done;  /* caller: the batch finished and drained    */
+
+  /* Current batch — written under `mutex` before `batch` is bumped */
+  GameJobFn *fn;
+  void *data;
+  int count;
+  unsigned batch;
+  int quit;
+  int busy; /* workers inside job_pool_drain (under `mutex`) */
+
+  int next;     /* atomic: next index to claim */
+  int finished; /* atomic: indices completed   */
+};
+
+/* Claim and run indices until none are left. */
+static void job_pool_drain(JobPool *pool) {
+  for (;;) {
+    int i = __atomic_fetch_add(&pool->next, 1, __ATOMIC_ACQ_REL);
+    if (i >= pool->count)
+      return;
+    pool->fn(pool->data, i);
+    __atomic_add_fetch(&pool->finished, 1, __ATOMIC_ACQ_REL);
+  }
+}
+
+static void *job_pool_worker(void *arg) {
+  JobPool *pool = (JobPool *)arg;
+  unsigned seen = 0;
+  for (;;) {
+    pthread_mutex_lock(&pool->mutex);
+    while (pool->batch == seen && !pool->quit)
+      pthread_cond_wait(&pool->wake, &pool->mutex);
+    if (pool->quit) {
+      pthread_mutex_unlock(&pool->mutex);
+      return NULL;
+    }
+    seen = pool->batch;
+    pool->busy++;
+    pthread_mutex_unlock(&pool->mutex);
+
+    job_pool_drain(pool);
+
+    pthread_mutex_lock(&pool->mutex);
+    if (--pool->busy == 0)
+      pthread_cond_signal(&pool->done);
+    pthread_mutex_unlock(&pool->mutex);
+  }
+}
+
+int job_pool_default_workers(void) {
+  long cores = sysconf(_SC_NPROCESSORS_ONLN);
+  if (cores < 2)
+    return 0;
+  return cores - 1 > JOB_POOL_MAX_WORKERS ? JOB_POOL_MAX_WORKERS
+                                          : (int)(cores - 1);
+}
+
+JobPool *job_pool_create(int worker_count) {
+  if (worker_count < 1)
+    return NULL;
+  if (worker_count > JOB_POOL_MAX_WORKERS)
+    worker_count = JOB_POOL_MAX_WORKERS;
+
+  JobPool *pool = (JobPool *)calloc(1, sizeof(*pool));
+  if (!pool)
+    return NULL;
+  pthread_mutex_init(&pool->mutex, NULL);
+  pthread_cond_init(&pool->wake, NULL);
+  pthread_cond_init(&pool->done, NULL);
+
+  for (int i = 0; i < worker_count; i++) {
+    if (pthread_create(&pool->threads[i], NULL, job_pool_worker, pool) != 0)
+      break;
+    pool->worker_count++;
+  }
+  if (pool->worker_count == 0) {
+    job_pool_destroy(pool);
+    return NULL;
+  }
+  return pool;
+}
+
+void job_pool_destroy(JobPool *pool) {
+  if (!pool)
+    return;
+  pthread_mutex_lock(&pool->mutex);
+  pool->quit = 1;
+  pthread_cond_broadcast(&pool->wake);
+  pthread_mutex_unlock(&pool->mutex);
+  for (int i = 0; i < pool->worker_count; i++)
+    pthread_join(pool->threads[i], NULL);
+
+  pthread_cond_destroy(&pool->done);
+  pthread_cond_destroy(&pool->wake);
+  pthread_mutex_destroy(&pool->mutex);
+  free(pool);
+}
+
+void job_pool_parallel_for(void *opaque, int count, GameJobFn *fn,
+                           void *data) {
+  JobPool *pool = (JobPool *)opaque;
+  if (count <= 0)
+    return;
+
+  pthread_mutex_lock(&pool->mutex);
+  while (pool->busy > 0) /* a straggler from the last batch */
+    pthread_cond_wait(&pool->done, &pool->mutex);
+  pool->fn = fn;
+  pool->data = data;
+  pool->count = count;
+  __atomic_store_n(&pool->next, 0, __ATOMIC_RELEASE);
+  __atomic_store_n(&pool->finished, 0, __ATOMIC_RELEASE);
+  pool->batch++;
+  pthread_cond_broadcast(&pool->wake);
+  pthread_mutex_unlock(&pool->mutex);
+
+  job_pool_drain(pool);
+
+  /* Every index is claimed, so each worker still busy is finishing one
+   * (or about to see the counter is spent) and will signal on leaving. */
+  pthread_mutex_lock(&pool->mutex);
+  while (pool->busy > 0 ||
+         __atomic_load_n(&pool->finished, __ATOMIC_ACQUIRE) < count)
+    pthread_cond_wait(&pool->done, &pool->mutex);
+  pthread_mutex_unlock(&pool->mutex);
+}
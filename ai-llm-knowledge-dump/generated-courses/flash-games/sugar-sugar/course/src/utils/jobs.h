@@ -0,0 +1,64 @@
+/*
+ * utils/jobs.h  —  Sugar, Sugar | Parallel-For Job Pool
+ *
+ * The game never creates threads.  Instead the platform hands it a
+ * GameJobs service (a function pointer + opaque pool) after game_init,
+ * exactly like Handmade Hero's PlatformWorkQueue:
+ *
+ *   platform:  JobPool *pool = job_pool_create(job_pool_default_workers());
+ *              state.jobs = job_pool_service(pool);
+ *
+ *   game:      game_parallel_for(&state->jobs, 4, update_band, &ctx);
+ *              // runs update_band(&ctx, 0..3), returns when all are done
+ *
+ * With no pool (jobs.parallel_for == NULL) game_parallel_for runs the
+ * indices in order on the calling thread, so results never depend on
+ * how many cores the machine has — only on what the jobs touch.
+ *
+ * JS analogy: Promise.all() over a fixed array of Web Worker tasks.
+ */
+
+#ifndef UTILS_JOBS_H
+#define UTILS_JOBS_H
+
+/* One unit of work: `index` in [0, count) of a parallel_for call. */
+typedef void GameJobFn(void *data, int index);
+
+typedef void GameParallelForFn(void *pool, int count, GameJobFn *fn,
+                               void *data);
+
+typedef struct {
+  void *pool;                      /* opaque platform object           */
+  GameParallelForFn *parallel_for; /* NULL → run inline, in order      */
+} GameJobs;
+
+static inline void game_parallel_for(const GameJobs *jobs, int count,
+                                     GameJobFn *fn, void *data) {
+  if (jobs->parallel_for && count > 1) {
+    jobs->parallel_for(jobs->pool, count, fn, data);
+  } else {
+    for (int i = 0; i < count; i++)
+      fn(data, i);
+  }
+}
+
+/* ---- Platform-side pool (utils/jobs.c, POSIX threads) ---- */
+typedef struct JobPool JobPool;
+
+/* Worker threads to start: online cores minus the calling thread. */
+int job_pool_default_workers(void);
+
+/* NULL when worker_count < 1 or thread creation fails. */
+JobPool *job_pool_create(int worker_count);
+void job_pool_destroy(JobPool *pool);
+
+/* GameParallelForFn; the calling thread works too. */
+void job_pool_parallel_for(void *pool, int count, GameJobFn *fn, void *data);
+
+/* GameJobs for `pool`, or the inline fallback when pool is NULL. */
+static inline GameJobs job_pool_service(JobPool *pool) {
+  GameJobs jobs = {pool, pool ? job_pool_parallel_for : 0};
+  return jobs;
+}
+
+#endif /* UTILS_JOBS_H */
@@ -61,7 +61,7 @@ while [[ $# -gt 0 ]]; do
             echo "Usage: $0 [options]"
             echo ""
             echo "Options:"
-            echo "  --backend=NAME   Select backend: x11, raylib (default: raylib)"
+            echo "  --backend=NAME   Select backend: x11, raylib, audio-bench, render-bench (default: raylib)"
             echo "  -r, --run        Run the game after a successful build"
             echo "  -d, --debug      Enable AddressSanitizer + UBSan (-DDEBUG)"
             echo "  --help, -h       Show this help message"
@@ -84,10 +84,19 @@ done
 # Compile order matters to the linker: list object files before libraries.
 SOURCES="src/game.c src/audio.c src/utils/draw-shapes.c src/utils/draw-text.c"
 
+# The asteroid pool's arena (engine/game/memory-arena.h) grows its commit
+# frontier through engine/_common.
+ENGINE_SOURCES="../../../../../engine/_common/memory.c"
+SOURCES="$SOURCES $ENGINE_SOURCES"
+
 # -lm: C math library (sinf, cosf, fabsf, fmodf used in game and audio code).
 # Unlike JS, C's math functions are NOT built-in — you must explicitly link.
 LIBS="-lm"
 
+# Output name and extra flags; the bench backend overrides these.
+OUTPUT="./build/game"
+BACKEND_FLAGS=""
+
 # ══════ Backend Selection ══════════════════════════════════════════════════
 
 case "$BACKEND" in
@@ -112,10 +121,30 @@ case "$BACKEND" in
         esac
         SOURCES="$SOURCES src/main_raylib.c"
     ;;
-    
+
+    # ── Audio Bench (headless) ────────────────────────────────────────────
+    # No window, no audio device: times game_get_audio_samples under
+    # synthetic voice loads (see src/audio_bench.c).  Optimised, and the
+    # voice cap is raised so the heavier loads fit.
+    audio-bench)
+        SOURCES="$SOURCES src/audio_bench.c"
+        OUTPUT="./build/audio-bench"
+        BACKEND_FLAGS="-O2 -DMAX_SIMULTANEOUS_SOUNDS=256"
+    ;;
+
+    # ── Render Bench (headless) ───────────────────────────────────────────
+    # Times draw_wireframe / draw_wireframe_batch over a range of buffer
+    # sizes (see src/render_bench.c).  Those are private to game.c, so the
+    # bench #includes game.c instead of linking it.
+    render-bench)
+        SOURCES="src/render_bench.c src/audio.c src/utils/draw-shapes.c src/utils/draw-text.c $ENGINE_SOURCES"
+        OUTPUT="./build/render-bench"
+        BACKEND_FLAGS="-O2"
+    ;;
+
     *)
         echo "Error: Unknown backend '$BACKEND'" >&2
-        echo "Available backends: x11, raylib" >&2
+        echo "Available backends: x11, raylib, audio-bench, render-bench" >&2
         exit 1
     ;;
 esac
@@ -127,7 +156,7 @@ esac
 #   -Wextra    Additional warnings
 #   -g         Debug symbols (file names + line numbers in binary)
 #   -O0        Disable optimisations (debugger step-through works correctly)
-FLAGS="-Wall -Wextra -g -O0"
+FLAGS="-Wall -Wextra -g -O0 $BACKEND_FLAGS"
 
 if [[ "$DEBUG_BUILD" == true ]]; then
     FLAGS="$FLAGS -fsanitize=address,undefined -DDEBUG"
@@ -136,8 +165,6 @@ fi
 
 # ══════ Build ═══════════════════════════════════════════════════════════════
 
-OUTPUT="./build/game"
-
 # Argument order matters to the linker (single-pass):
 # flags → output path → source files → libraries last.
 # Libraries after sources: the linker resolves symbols in order; placing
@@ -6,8 +6,13 @@
  *   - prepare_input_frame   input double-buffer preparation
  *   - compact_pool          dead-object compaction (swap-with-tail idiom)
  *   - add_asteroid          spawn a new asteroid into the pool
- *   - add_bullet            spawn a new bullet into the pool
+ *   - add_bullet            spawn a new bullet into the ring
+ *   - bullets_update        integrate, wrap and expire the bullet ring
+ *   - grid_build            file asteroids into the collision grid
+ *   - grid_first_hit        broadphase + narrowphase circle query
  *   - draw_wireframe        rotate + scale + draw a polygon (game-specific)
+ *   - draw_wireframe_batch  same, for many objects sharing one model
+ *   - draw_polygon_wrapped  closed polygon, only its on-screen wrap copies
  *   - reset_game            selective game logic reset (no memset)
  *   - asteroids_init        full init (memset + model build + reset_game)
  *   - asteroids_update      per-frame game simulation
@@ -22,8 +27,10 @@
 
 #include "game.h"
 #include "utils/draw-shapes.h"
+#include "../../../../../../engine/_common/fixed.h"
 #include "utils/draw-text.h"
-#include <math.h>    /* sinf, cosf, fabsf, sqrtf */
+#include "../../../../../../engine/game/render-cull.h"
+#include <math.h>    /* sinf, cosf, sqrtf, floorf, fmodf */
 #include <string.h>  /* memset                    */
 #include <stdio.h>   /* snprintf                  */
 #include <stdlib.h>  /* rand, srand               */
@@ -64,9 +71,10 @@ void prepare_input_frame(const GameInput *old, GameInput *current) {
 
 /* ══════ compact_pool ═══════════════════════════════════════════════════════
  *
- * Removes inactive (dead) objects from a pool using the swap-with-tail idiom:
- * replace the dead slot with the last live element, decrement count.
- * This avoids shifting elements and keeps compaction O(n).
+ * Removes inactive (dead) asteroids from the pool using the swap-with-tail
+ * idiom: asteroid_pool_remove moves the last live rock into the dead slot
+ * (every column) and decrements the count.  This avoids shifting elements
+ * and keeps compaction O(n).
  *
  * COURSE NOTE: The reference C code iterates and removes inline during
  * the update loop, which can cause double-updates of swapped elements.
@@ -77,14 +85,13 @@ void prepare_input_frame(const GameInput *old, GameInput *current) {
  *   pool = pool.filter(obj => obj.active);   // O(n), creates new array
  *   // The C version is O(n) but mutates in-place with no allocation.
  */
-static void compact_pool(SpaceObject *pool, int *count) {
-    int i = 0;
-    while (i < *count) {
-        if (!pool[i].active) {
+static void compact_pool(AsteroidPool *pool) {
+    uint32_t i = 0;
+    while (i < pool->index.count) {
+        if (!pool->active[i]) {
             /* Replace with the last element and shrink the pool by one.
                DO NOT increment i — the swapped element must be checked too. */
-            pool[i] = pool[*count - 1];
-            (*count)--;
+            asteroid_pool_remove(pool, i);
         } else {
             i++;
         }
@@ -96,7 +103,7 @@ static void compact_pool(SpaceObject *pool, int *count) {
  * Append a new asteroid to the pool.  Returns 0 if the pool is full.
  *
  * Parameters:
- *   state  — game state (asteroids[] pool + count)
+ *   state  — game state (asteroids pool)
  *   x, y   — spawn position
  *   dx, dy — initial velocity
  *   size   — collision radius (controls draw scale too)
@@ -106,16 +113,17 @@ static int add_asteroid(GameState *state,
                         float dx, float dy,
                         float size)
 {
-    if (state->asteroid_count >= MAX_ASTEROIDS) return 0;
-
-    SpaceObject *a = &state->asteroids[state->asteroid_count++];
-    a->x      = x;
-    a->y      = y;
-    a->dx     = dx;
-    a->dy     = dy;
-    a->size   = size;
-    a->angle  = 0.0f;
-    a->active = 1;
+    AsteroidPool *pool = &state->asteroids;
+    int i = asteroid_pool_alloc(pool, NULL);
+    if (i < 0) return 0;
+
+    pool->x[i]      = x;
+    pool->y[i]      = y;
+    pool->dx[i]     = dx;
+    pool->dy[i]     = dy;
+    pool->size[i]   = size;
+    pool->angle[i]  = 0.0f;
+    pool->active[i] = 1;
     return 1;
 }
 
@@ -128,7 +136,8 @@ static int add_asteroid(GameState *state,
  * ship model (ship_model[0]) rotated by the ship's current angle.
  */
 static int add_bullet(GameState *state) {
-    if (state->bullet_count >= MAX_BULLETS) return 0;
+    BulletPool *bp = &state->bullets;
+    if (bp->live >= MAX_BULLETS || bp->count >= BULLET_RING) return 0;
 
     /* Compute ship nose direction */
     float ca = cosf(state->player.angle);
@@ -140,17 +149,191 @@ static int add_bullet(GameState *state) {
     float tip_x = state->player.x + ( sa * 5.0f);
     float tip_y = state->player.y + (-ca * 5.0f);
 
-    SpaceObject *b = &state->bullets[state->bullet_count++];
-    b->x      = tip_x;
-    b->y      = tip_y;
-    b->dx     =  sa * BULLET_SPEED;
-    b->dy     = -ca * BULLET_SPEED;
-    b->angle  = 0.0f;
-    b->size   = 2.0f;
-    b->active = 1;
+    int i = (bp->head + bp->count++) & (BULLET_RING - 1);
+    bp->live++;
+    bp->x[i]    = tip_x;
+    bp->y[i]    = tip_y;
+    bp->dx[i]   =  sa * BULLET_SPEED;
+    bp->dy[i]   = -ca * BULLET_SPEED;
+    bp->life[i] = BULLET_LIFE_S;
+    bp->hit[i]  = 0;
     return 1;
 }
 
+/* ══════ bullets_update ═════════════════════════════════════════════════════
+ *
+ * Integrate and wrap every ring slot (free ones too — branch-free), then
+ * pop expired and hit bullets off the front.  All bullets share one life,
+ * so the expired ones are always a prefix of the ring (see BulletPool).
+ */
+static void bullets_update(BulletPool *bp, float dt) {
+    for (int i = 0; i < BULLET_RING; i++) {
+        bp->x[i] += bp->dx[i] * dt;
+        bp->y[i] += bp->dy[i] * dt;
+        bp->life[i] -= dt;
+        bp->x[i] = fmodf(bp->x[i] + (float)SCREEN_W, (float)SCREEN_W);
+        bp->y[i] = fmodf(bp->y[i] + (float)SCREEN_H, (float)SCREEN_H);
+    }
+    while (bp->count > 0 &&
+           (bp->hit[bp->head] || bp->life[bp->head] <= 0.0f)) {
+        if (!bp->hit[bp->head]) bp->live--;
+        bp->head = (bp->head + 1) & (BULLET_RING - 1);
+        bp->count--;
+    }
+}
+
+/* ══════ wrap_delta ═════════════════════════════════════════════════════════
+ *
+ * Shortest signed distance from b to a along one axis of a wrapping world.
+ * Without this, a rock straddling the right edge could never hit a ship
+ * sitting just across the seam on the left — they are 2px apart on screen
+ * but SCREEN_W - 2 apart in raw coordinates.
+ *
+ * JS equivalent:
+ *   let d = a - b;
+ *   if (d >  size / 2) d -= size;
+ *   if (d < -size / 2) d += size;
+ */
+static float wrap_delta(float a, float b, float size) {
+    float d = a - b;
+    if (d >  0.5f * size) d -= size;
+    if (d < -0.5f * size) d += size;
+    return d;
+}
+
+/* Grid cell coordinate for a position.  Positions are already wrapped into
+   [0, size) by the physics step; the clamp only guards float edge cases. */
+static int grid_coord(float v, float size, int cells) {
+    int c = (int)(v * (float)cells / size);
+    return CLAMP(c, 0, cells - 1);
+}
+
+/* ══════ grid_build ═════════════════════════════════════════════════════════
+ *
+ * File every active asteroid under the cell holding its centre.
+ * Counting sort in three passes (see AsteroidGrid in game.h):
+ *   1. count asteroids per cell       (cell_start[c + 1]++)
+ *   2. prefix sum                     (cell_start[c] = first slot of cell c)
+ *   3. scatter indices into items[]   (using a moving cursor per cell)
+ *
+ * Called once per frame, after physics has moved everything.  O(cells + n).
+ */
+static void grid_build(GameState *state) {
+    AsteroidGrid       *grid = &state->asteroid_grid;
+    const AsteroidPool *pool = &state->asteroids;
+    int count = (int)pool->index.count;
+    memset(grid->cell_start, 0, sizeof(grid->cell_start));
+
+    /* Pass 1: count (shifted by one so pass 2 yields start offsets) */
+    for (int i = 0; i < count; i++) {
+        if (!pool->active[i]) { grid->cell_of[i] = -1; continue; }
+        int cx = grid_coord(pool->x[i], (float)SCREEN_W, ASTEROID_GRID_COLS);
+        int cy = grid_coord(pool->y[i], (float)SCREEN_H, ASTEROID_GRID_ROWS);
+        int c  = cy * ASTEROID_GRID_COLS + cx;
+        grid->cell_of[i] = c;
+        grid->cell_start[c + 1]++;
+    }
+
+    /* Pass 2: prefix sum */
+    for (int c = 0; c < ASTEROID_GRID_CELLS; c++)
+        grid->cell_start[c + 1] += grid->cell_start[c];
+
+    /* Pass 3: scatter.  cursor[] starts as a copy of cell_start[] and walks
+       forward as each cell fills, leaving cell_start[] untouched.         */
+    int cursor[ASTEROID_GRID_CELLS];
+    memcpy(cursor, grid->cell_start, sizeof(cursor));
+    for (int i = 0; i < count; i++) {
+        int c = grid->cell_of[i];
+        if (c >= 0) grid->items[cursor[c]++] = i;
+    }
+}
+
+/* ══════ grid_first_hit ═════════════════════════════════════════════════════
+ *
+ * Return the index of the active asteroid that overlaps the circle
+ * (x, y, radius), or -1 if none does.
+ *
+ *   Broadphase:  only asteroids filed in the 3×3 cells around (x, y),
+ *                with wrap-around at the screen edges.
+ *   Narrowphase: wrapped distance² < (size[i] + radius)², no sqrtf needed.
+ *
+ * When several overlap, the LOWEST pool index wins — the same asteroid the
+ * old "test every asteroid in order" loop would have picked, so the grid
+ * changes only the cost, not which rock gets hit.
+ *
+ * Asteroids spawned after grid_build (split fragments) are not in the grid
+ * until next frame, so a bullet can't chain through a fresh fragment.
+ */
+static int grid_first_hit(const GameState *state,
+                          float x, float y, float radius)
+{
+    const AsteroidGrid *grid = &state->asteroid_grid;
+    const AsteroidPool *pool = &state->asteroids;
+    int cx = grid_coord(x, (float)SCREEN_W, ASTEROID_GRID_COLS);
+    int cy = grid_coord(y, (float)SCREEN_H, ASTEROID_GRID_ROWS);
+    int best = -1;
+
+    for (int oy = -1; oy <= 1; oy++) {
+        int gy = (cy + oy + ASTEROID_GRID_ROWS) % ASTEROID_GRID_ROWS;
+        for (int ox = -1; ox <= 1; ox++) {
+            int gx = (cx + ox + ASTEROID_GRID_COLS) % ASTEROID_GRID_COLS;
+            int c  = gy * ASTEROID_GRID_COLS + gx;
+
+            for (int k = grid->cell_start[c]; k < grid->cell_start[c + 1]; k++) {
+                int ai = grid->items[k];
+                if (best >= 0 && ai >= best) continue;  /* can't improve */
+
+                if (!pool->active[ai]) continue;  /* already destroyed this frame */
+
+                float dx = wrap_delta(x, pool->x[ai], (float)SCREEN_W);
+                float dy = wrap_delta(y, pool->y[ai], (float)SCREEN_H);
+                float r  = pool->size[ai] + radius;
+                if (dx * dx + dy * dy < r * r) best = ai;
+            }
+        }
+    }
+    return best;
+}
+
+/* ══════ draw_polygon_wrapped ════════════════════════════════════════════════
+ *
+ * Closed polygon through integer vertices, on the wrapping screen.
+ *
+ * Rather than wrap every pixel (draw_line → draw_pixel_w), take the
+ * polygon's bounds, ask de100_render_cull_wrap_offsets which of its 9
+ * wrapped placements touch the screen, and draw just those with clipped
+ * lines (the screen is the world here: origin 0, scale 1).
+ * A rock in mid-screen is one copy; one straddling an edge is two.  The
+ * offsets are whole screens, so the pixels are exactly draw_line's.     */
+static void draw_polygon_wrapped(AsteroidsBackbuffer *bb,
+                                 const int *ix, const int *iy, int n,
+                                 uint32_t color)
+{
+    int x0 = ix[0], x1 = ix[0], y0 = iy[0], y1 = iy[0];
+    for (int v = 1; v < n; v++) {
+        if (ix[v] < x0) x0 = ix[v];
+        if (ix[v] > x1) x1 = ix[v];
+        if (iy[v] < y0) y0 = iy[v];
+        if (iy[v] > y1) y1 = iy[v];
+    }
+
+    De100RenderCull cull;
+    de100_render_cull_begin(&cull, bb->width, bb->height, 0.0f, 0.0f, 1.0f);
+
+    f32 offsets[9][2];
+    int copies = (int)de100_render_cull_wrap_offsets(
+        &cull, (f32)x0, (f32)y0, (f32)(x1 - x0 + 1), (f32)(y1 - y0 + 1),
+        (f32)bb->width, (f32)bb->height, 0, offsets);
+    for (int c = 0; c < copies; c++) {
+        int dx = (int)offsets[c][0], dy = (int)offsets[c][1];
+        for (int v = 0; v < n; v++) {
+            int j = (v + 1 == n) ? 0 : v + 1;
+            draw_line_clip(bb, ix[v] + dx, iy[v] + dy, ix[j] + dx, iy[j] + dy,
+                           color);
+        }
+    }
+}
+
 /* ══════ draw_wireframe ══════════════════════════════════════════════════════
  *
  * Draw a polygon wireframe defined by a vertex model in local space.
@@ -159,7 +342,8 @@ static int add_bullet(GameState *state) {
  * Steps:
  *   1. Compute cos/sin of angle once (expensive trig, amortised over all verts)
  *   2. For each vertex v: rotate → scale → translate
- *   3. Draw a line from each transformed vertex to the next (closing at wrap)
+ *   3. Draw a line from each transformed vertex to the next (closing at wrap),
+ *      via draw_polygon_wrapped
  *
  * JS equivalent:
  *   ctx.save();
@@ -170,37 +354,192 @@ static int add_bullet(GameState *state) {
  *   ctx.restore();
  *
  * COURSE NOTE: The reference source computes trig per draw_wireframe call.
- * For this course we keep the same approach; a performance version would
- * pre-compute cos/sin in the update step and store in SpaceObject.        */
+ * We keep that here for the ship (one object); the asteroids go through
+ * draw_wireframe_batch below, which is the performance version.
+ *
+ * With DE100_FIXED_POINT_RENDER (engine/_common/fixed.h) the transform is
+ * Q16.16
+ * integer maths instead: the object's float state is converted once, the
+ * model once per vertex (the ship has three), then it is all integer
+ * multiply-adds and a shift down to whole pixels.                         */
 static void draw_wireframe(AsteroidsBackbuffer *bb,
                            const Vec2 *model, int vert_count,
                            float cx, float cy,
                            float angle, float scale,
                            uint32_t color)
 {
+#if DE100_FIXED_POINT_RENDER
+    De100FxMat2 m  = de100_fx_mat2_rotation_scale(
+        de100_fx_angle_from_radians(angle), de100_fx_from_f32(scale));
+    fx32        ox = de100_fx_from_f32(cx);
+    fx32        oy = de100_fx_from_f32(cy);
+
+    int wx[64], wy[64];  /* 64 is safe for any model in this game */
+    for (int i = 0; i < vert_count; i++) {
+        De100FxV2 v = de100_fx_v2(de100_fx_from_f32(model[i].x),
+                                  de100_fx_from_f32(model[i].y));
+        De100FxV2 r = de100_fx_mat2_mul(m, v);
+        wx[i] = de100_fx_floor(ox + r.x);
+        wy[i] = de100_fx_floor(oy + r.y);
+    }
+
+    draw_polygon_wrapped(bb, wx, wy, vert_count, color);
+#else
     /* Pre-compute rotation matrix entries (only once per object) */
     float ca = cosf(angle);
     float sa = sinf(angle);
 
-    /* Transform all vertices from local to world space */
-    Vec2 world[64];  /* 64 is safe for any model in this game */
+    /* Transform all vertices from local to world space, to whole pixels */
+    int wx[64], wy[64];  /* 64 is safe for any model in this game */
     for (int i = 0; i < vert_count; i++) {
         /* Rotate using 2×2 matrix: [cos -sin] [x]   [x·cos - y·sin]
                                     [sin  cos] [y] = [x·sin + y·cos] */
         float rx = model[i].x * ca - model[i].y * sa;
         float ry = model[i].x * sa + model[i].y * ca;
         /* Scale then translate to world position */
-        world[i].x = cx + rx * scale;
-        world[i].y = cy + ry * scale;
+        wx[i] = (int)(cx + rx * scale);
+        wy[i] = (int)(cy + ry * scale);
     }
 
     /* Draw edges: connect each vertex to the next, close by connecting last→first */
-    for (int i = 0; i < vert_count; i++) {
-        int j = (i + 1) % vert_count;  /* % wraps the last vertex back to 0 */
-        draw_line(bb,
-                  (int)world[i].x, (int)world[i].y,
-                  (int)world[j].x, (int)world[j].y,
-                  color);
+    draw_polygon_wrapped(bb, wx, wy, vert_count, color);
+#endif
+}
+
+/* ══════ fast_sincos ═════════════════════════════════════════════════════════
+ *
+ * sin and cos of any angle, to ~2e-4 — under 0.01px on a radius-20 rock.
+ *
+ *   1. Range-reduce to [-π, π]   (angles grow without bound as rocks spin)
+ *   2. Fold into [-π/2, π/2]     (sin(π - x) = sin(x))
+ *   3. Taylor polynomial to x⁷   (just multiplies and adds)
+ * cos(a) is sin(a + π/2) through the same path.
+ *
+ * Only used for drawing; physics keeps the exact sinf/cosf.  The fixed-point
+ * build uses de100_fx_sin / de100_fx_cos (engine/_common/fixed.h).      */
+#if !DE100_FIXED_POINT_RENDER
+static float fast_sin(float a) {
+    a -= 2.0f * PI * floorf((a + PI) / (2.0f * PI));   /* → [-π, π)      */
+    if (a >  0.5f * PI) a =  PI - a;                    /* → [-π/2, π/2]  */
+    if (a < -0.5f * PI) a = -PI - a;
+    float a2 = a * a;
+    return a * (1.0f - a2 / 6.0f * (1.0f - a2 / 20.0f * (1.0f - a2 / 42.0f)));
+}
+
+static void fast_sincos(float a, float *s, float *c) {
+    *s = fast_sin(a);
+    *c = fast_sin(a + 0.5f * PI);
+}
+#endif
+
+/* ══════ draw_wireframe_batch ════════════════════════════════════════════════
+ *
+ * draw_wireframe for every active rock in an AsteroidPool, all sharing one
+ * model (asteroid_model), split into three stages so each one
+ * is a tight loop doing a single job:
+ *
+ *   1. Per object:  sincos once, pre-multiplied by scale → (x, y, c, s)
+ *   2. Per vertex:  world = pos + rotate(model) in structure-of-arrays
+ *                   form — plain arrays with no branches, which the
+ *                   compiler can vectorise (several vertices per instruction)
+ *   3. Per object:  the closed polygon, on-screen wrap copies only
+ *
+ * Objects are processed WIREFRAME_BATCH at a time so the scratch arrays
+ * stay small and on the stack, however large the pool is.
+ *
+ * Output pixels are identical to calling draw_wireframe per object, up to
+ * the (sub-pixel) sincos approximation.
+ *
+ * WireScalar is float, or fx32 under DE100_FIXED_POINT_RENDER: then
+ * the model is converted once per call and each object's state once in
+ * stage 1, and stages 2-3 are integer multiply-adds and shifts.
+ *
+ * JS equivalent:
+ *   const xf  = rocks.x.map((x, i) => ({ x, y: rocks.y[i], c: cos(rocks.angle[i]) * rocks.size[i], … }));
+ *   const wx  = new Float32Array(n * verts);   // stage 2 fills these
+ *   const wy  = new Float32Array(n * verts);
+ *   // stage 3 walks wx/wy drawing closed polygons
+ */
+#define WIREFRAME_BATCH     64
+#define WIREFRAME_MAX_VERTS 32
+
+#if DE100_FIXED_POINT_RENDER
+typedef fx32 WireScalar;
+#define WIRE_FROM_FLOAT(x)         de100_fx_from_f32(x)
+#define WIRE_AFFINE(o, a, b, c, d) \
+    ((o) + (fx32)(((int64_t)(a) * (b) + (int64_t)(c) * (d)) >> DE100_FX_SHIFT))
+#define WIRE_TO_PIXEL(x)           de100_fx_floor(x)
+#else
+typedef float WireScalar;
+#define WIRE_FROM_FLOAT(x)         (x)
+#define WIRE_AFFINE(o, a, b, c, d) ((o) + (a) * (b) + (c) * (d))
+#define WIRE_TO_PIXEL(x)           ((int)(x))
+#endif
+
+static void draw_wireframe_batch(AsteroidsBackbuffer *bb,
+                                 const Vec2 *model, int vert_count,
+                                 const AsteroidPool *rocks, uint32_t color)
+{
+    ASSERT(vert_count <= WIREFRAME_MAX_VERTS, "model too large for batch");
+
+    /* Model in SoA form: one array of x, one of y */
+    WireScalar mx[WIREFRAME_MAX_VERTS], my[WIREFRAME_MAX_VERTS];
+    for (int v = 0; v < vert_count; v++) {
+        mx[v] = WIRE_FROM_FLOAT(model[v].x);
+        my[v] = WIRE_FROM_FLOAT(model[v].y);
+    }
+
+    WireScalar px[WIREFRAME_BATCH], py[WIREFRAME_BATCH];   /* position          */
+    WireScalar pc[WIREFRAME_BATCH], ps[WIREFRAME_BATCH];   /* cos·scale, sin·scale */
+    WireScalar wx[WIREFRAME_BATCH * WIREFRAME_MAX_VERTS];
+    WireScalar wy[WIREFRAME_BATCH * WIREFRAME_MAX_VERTS];
+
+    uint32_t obj_count = rocks->index.count;
+    uint32_t i = 0;
+    while (i < obj_count) {
+        /* ── Stage 1: gather active objects, one sincos each ──────────── */
+        int n = 0;
+        for (; i < obj_count && n < WIREFRAME_BATCH; i++) {
+            if (!rocks->active[i]) continue;
+#if DE100_FIXED_POINT_RENDER
+            De100FxMat2 m = de100_fx_mat2_rotation_scale(
+                de100_fx_angle_from_radians(rocks->angle[i]),
+                de100_fx_from_f32(rocks->size[i]));
+            pc[n] = m.m00;
+            ps[n] = m.m10;
+#else
+            float sn, cs;
+            fast_sincos(rocks->angle[i], &sn, &cs);
+            pc[n] = cs * rocks->size[i];
+            ps[n] = sn * rocks->size[i];
+#endif
+            px[n] = WIRE_FROM_FLOAT(rocks->x[i]);
+            py[n] = WIRE_FROM_FLOAT(rocks->y[i]);
+            n++;
+        }
+
+        /* ── Stage 2: transform every vertex of the batch ─────────────── */
+        for (int k = 0; k < n; k++) {
+            WireScalar *ox = &wx[k * vert_count];
+            WireScalar *oy = &wy[k * vert_count];
+            WireScalar x = px[k], y = py[k], c = pc[k], sn = ps[k];
+            for (int v = 0; v < vert_count; v++) {
+                ox[v] = WIRE_AFFINE(x, mx[v], c, my[v], -sn);   /* o + a·b + c·d */
+                oy[v] = WIRE_AFFINE(y, mx[v], sn, my[v], c);
+            }
+        }
+
+        /* ── Stage 3: rasterise closed polygons ───────────────────────── */
+        for (int k = 0; k < n; k++) {
+            const WireScalar *ox = &wx[k * vert_count];
+            const WireScalar *oy = &wy[k * vert_count];
+            int ix[WIREFRAME_MAX_VERTS], iy[WIREFRAME_MAX_VERTS];
+            for (int v = 0; v < vert_count; v++) {
+                ix[v] = WIRE_TO_PIXEL(ox[v]);
+                iy[v] = WIRE_TO_PIXEL(oy[v]);
+            }
+            draw_polygon_wrapped(bb, ix, iy, vert_count, color);
+        }
     }
 }
 
@@ -223,8 +562,8 @@ static void reset_game(GameState *state) {
     state->player.active = 1;
 
     /* Clear pools */
-    state->asteroid_count = 0;
-    state->bullet_count   = 0;
+    asteroid_pool_clear(&state->asteroids);
+    memset(&state->bullets, 0, sizeof(state->bullets));
     state->fire_timer     = 0.0f;
 
     /* Spawn 4 large asteroids at screen corners (avoid centre where ship is) */
@@ -300,7 +639,7 @@ void asteroids_init(GameState *state) {
     /* ── Build asteroid model (jagged circle, local space, radius ~1) ──
        20 vertices at equally-spaced angles, each perturbed by a random
        noise factor in [0.8, 1.2].  The model is unit-sized (radius ≈ 1);
-       draw_wireframe scales it by SpaceObject.size at render time.       */
+       draw_wireframe_batch scales it by each rock's size at render.     */
     for (int i = 0; i < ASTEROID_VERTS; i++) {
         float noise = 0.8f + ((float)(rand() % 100) / 100.0f) * 0.4f;
         float t     = ((float)i / (float)ASTEROID_VERTS) * 2.0f * PI;
@@ -308,6 +647,14 @@ void asteroids_init(GameState *state) {
         state->asteroid_model[i].y = cosf(t) * noise;
     }
 
+    /* ── Asteroid pool over asteroid_memory (zeroed by the memset) ──── */
+    de100_arena_init(&state->asteroid_arena, sizeof(state->asteroid_memory),
+                     state->asteroid_memory);
+    int pool_ok = asteroid_pool_init(&state->asteroids, &state->asteroid_arena,
+                                     MAX_ASTEROIDS);
+    ASSERT(pool_ok, "asteroid_memory too small for MAX_ASTEROIDS");
+    (void)pool_ok;
+
     /* ── Reset game state and spawn starting asteroids ──────────────── */
     reset_game(state);
 }
@@ -320,7 +667,7 @@ void asteroids_init(GameState *state) {
  * Structure:
  *   1. Input → ship movement (rotation, thrust, fire)
  *   2. Physics: integrate velocity, wrap positions
- *   3. Bullet → asteroid collision
+ *   3. Bullet → asteroid collision (grid broadphase)
  *   4. Asteroid → ship collision
  *   5. Compact pools (remove dead objects)
  *   6. Win/lose condition checks
@@ -418,123 +765,110 @@ void asteroids_update(GameState *state, const GameInput *input, float dt) {
     state->player.x = fmodf(state->player.x + (float)SCREEN_W, (float)SCREEN_W);
     state->player.y = fmodf(state->player.y + (float)SCREEN_H, (float)SCREEN_H);
 
-    /* Asteroids */
-    for (int i = 0; i < state->asteroid_count; i++) {
-        SpaceObject *a = &state->asteroids[i];
-        a->x += a->dx * dt;
-        a->y += a->dy * dt;
-        a->angle += 0.5f * dt;  /* slow constant spin for visual interest */
-        a->x = fmodf(a->x + (float)SCREEN_W, (float)SCREEN_W);
-        a->y = fmodf(a->y + (float)SCREEN_H, (float)SCREEN_H);
+    /* Asteroids: straight runs over the columns */
+    AsteroidPool *pool = &state->asteroids;
+    uint32_t asteroid_count = pool->index.count;
+    for (uint32_t i = 0; i < asteroid_count; i++) {
+        pool->x[i] += pool->dx[i] * dt;
+        pool->y[i] += pool->dy[i] * dt;
+        pool->angle[i] += 0.5f * dt;  /* slow constant spin for visual interest */
+        pool->x[i] = fmodf(pool->x[i] + (float)SCREEN_W, (float)SCREEN_W);
+        pool->y[i] = fmodf(pool->y[i] + (float)SCREEN_H, (float)SCREEN_H);
     }
 
-    /* Bullets */
-    for (int i = 0; i < state->bullet_count; i++) {
-        SpaceObject *b = &state->bullets[i];
-        b->x += b->dx * dt;
-        b->y += b->dy * dt;
-        b->size -= dt;  /* bullets shrink over time; when size ≤ 0 they die */
-        if (b->size <= 0.0f) b->active = 0;
-        b->x = fmodf(b->x + (float)SCREEN_W, (float)SCREEN_W);
-        b->y = fmodf(b->y + (float)SCREEN_H, (float)SCREEN_H);
-    }
+    /* Bullets: integrate, wrap, and drop the expired ones */
+    bullets_update(&state->bullets, dt);
 
     /* ══════ Collision: Bullets vs Asteroids ═════════════════════════════
-       For each active bullet, test against every active asteroid.
-       Collision: distance between centres < sum of radii.
+       For each active bullet, find an asteroid it overlaps.
+       Collision: wrapped distance between centres < sum of radii.
        On hit: destroy bullet, split asteroid (or remove if small), add score.
 
+       The grid is built once, after physics, so each query only visits the
+       handful of rocks near the bullet.  Testing every bullet against every
+       asteroid is O(bullets × asteroids) — fine for 32 rocks, not for a
+       storm of thousands.
+
        IMPORTANT: Both loops mark objects inactive; actual pool compaction
        happens AFTER both loops to avoid invalidating indices mid-loop.    */
-    for (int bi = 0; bi < state->bullet_count; bi++) {
-        if (!state->bullets[bi].active) continue;
-
-        for (int ai = 0; ai < state->asteroid_count; ai++) {
-            if (!state->asteroids[ai].active) continue;
-
-            SpaceObject *b = &state->bullets[bi];
-            SpaceObject *a = &state->asteroids[ai];
-
-            float dx   = b->x - a->x;
-            float dy   = b->y - a->y;
-            float dist = sqrtf(dx * dx + dy * dy);
-
-            if (dist < a->size + 1.0f) {   /* +1 for bullet "radius" */
-                b->active = 0;   /* destroy bullet */
-                a->active = 0;   /* destroy asteroid */
-
-                /* Spatial pan: asteroid at left edge → pan = -1 (full left) */
-                float pan = (a->x / (float)SCREEN_W) * 2.0f - 1.0f;
-
-                /* Split asteroid or remove, award points */
-                if (a->size >= ASTEROID_LARGE_SIZE) {
-                    state->score += 20;
-                    game_play_sound_panned(&state->audio, SOUND_EXPLODE_LARGE, pan);
-                    /* Spawn 2 medium asteroids at a perpendicular angle */
-                    add_asteroid(state, a->x, a->y,
-                                 a->dy * 0.6f + a->dx * 0.4f,
-                                -a->dx * 0.6f + a->dy * 0.4f,
-                                 ASTEROID_MEDIUM_SIZE);
-                    add_asteroid(state, a->x, a->y,
-                                -a->dy * 0.6f + a->dx * 0.4f,
-                                 a->dx * 0.6f + a->dy * 0.4f,
-                                 ASTEROID_MEDIUM_SIZE);
-                } else if (a->size >= ASTEROID_MEDIUM_SIZE) {
-                    state->score += 50;
-                    game_play_sound_panned(&state->audio, SOUND_EXPLODE_MEDIUM, pan);
-                    /* Spawn 2 small asteroids */
-                    add_asteroid(state, a->x, a->y,
-                                 a->dy * 0.8f + a->dx * 0.3f,
-                                -a->dx * 0.8f + a->dy * 0.3f,
-                                 ASTEROID_SMALL_SIZE);
-                    add_asteroid(state, a->x, a->y,
-                                -a->dy * 0.8f + a->dx * 0.3f,
-                                 a->dx * 0.8f + a->dy * 0.3f,
-                                 ASTEROID_SMALL_SIZE);
-                } else {
-                    /* Small asteroid — destroyed completely */
-                    state->score += 100;
-                    game_play_sound_panned(&state->audio, SOUND_EXPLODE_SMALL, pan);
-                }
-
-                /* One bullet can only destroy one asteroid */
-                break;
-            }
+    grid_build(state);
+
+    BulletPool *bp = &state->bullets;
+    for (int k = 0; k < bp->count; k++) {
+        int bi = (bp->head + k) & (BULLET_RING - 1);
+        if (bp->hit[bi]) continue;
+
+        int ai = grid_first_hit(state, bp->x[bi], bp->y[bi], 1.0f); /* +1 bullet "radius" */
+        if (ai < 0) continue;
+
+        /* One bullet can only destroy one asteroid.  Copied out: the
+           fragments below are allocated into the same columns.           */
+        SpaceObject a = {
+            .x = pool->x[ai], .y = pool->y[ai],
+            .dx = pool->dx[ai], .dy = pool->dy[ai], .size = pool->size[ai],
+        };
+        bp->hit[bi] = 1;       /* destroy bullet (popped once it reaches the front) */
+        bp->live--;
+        pool->active[ai] = 0;  /* destroy asteroid */
+
+        /* Spatial pan: asteroid at left edge → pan = -1 (full left) */
+        float pan = (a.x / (float)SCREEN_W) * 2.0f - 1.0f;
+
+        /* Split asteroid or remove, award points */
+        if (a.size >= ASTEROID_LARGE_SIZE) {
+            state->score += 20;
+            game_play_sound_panned(&state->audio, SOUND_EXPLODE_LARGE, pan);
+            /* Spawn 2 medium asteroids at a perpendicular angle */
+            add_asteroid(state, a.x, a.y,
+                         a.dy * 0.6f + a.dx * 0.4f,
+                        -a.dx * 0.6f + a.dy * 0.4f,
+                         ASTEROID_MEDIUM_SIZE);
+            add_asteroid(state, a.x, a.y,
+                        -a.dy * 0.6f + a.dx * 0.4f,
+                         a.dx * 0.6f + a.dy * 0.4f,
+                         ASTEROID_MEDIUM_SIZE);
+        } else if (a.size >= ASTEROID_MEDIUM_SIZE) {
+            state->score += 50;
+            game_play_sound_panned(&state->audio, SOUND_EXPLODE_MEDIUM, pan);
+            /* Spawn 2 small asteroids */
+            add_asteroid(state, a.x, a.y,
+                         a.dy * 0.8f + a.dx * 0.3f,
+                        -a.dx * 0.8f + a.dy * 0.3f,
+                         ASTEROID_SMALL_SIZE);
+            add_asteroid(state, a.x, a.y,
+                        -a.dy * 0.8f + a.dx * 0.3f,
+                         a.dx * 0.8f + a.dy * 0.3f,
+                         ASTEROID_SMALL_SIZE);
+        } else {
+            /* Small asteroid — destroyed completely */
+            state->score += 100;
+            game_play_sound_panned(&state->audio, SOUND_EXPLODE_SMALL, pan);
         }
     }
 
     /* ══════ Collision: Asteroids vs Ship ════════════════════════════════ */
-    for (int ai = 0; ai < state->asteroid_count; ai++) {
-        if (!state->asteroids[ai].active) continue;
-
-        SpaceObject *a = &state->asteroids[ai];
-        float dx   = state->player.x - a->x;
-        float dy   = state->player.y - a->y;
-        float dist = sqrtf(dx * dx + dy * dy);
+    if (grid_first_hit(state, state->player.x, state->player.y,
+                       state->player.size) >= 0)
+    {
+        /* Ship is hit */
+        state->player.active = 0;
+        game_play_sound(&state->audio, SOUND_SHIP_DEATH);
 
-        if (dist < a->size + state->player.size) {
-            /* Ship is hit */
-            state->player.active = 0;
-            game_play_sound(&state->audio, SOUND_SHIP_DEATH);
+        /* Update best score */
+        if (state->score > state->best_score)
+            state->best_score = state->score;
 
-            /* Update best score */
-            if (state->score > state->best_score)
-                state->best_score = state->score;
-
-            state->phase      = PHASE_DEAD;
-            state->dead_timer = DEATH_DELAY;
-            break;
-        }
+        state->phase      = PHASE_DEAD;
+        state->dead_timer = DEATH_DELAY;
     }
 
     /* ══════ Compact pools ════════════════════════════════════════════════
        Now safe to compact: all detection loops are done.
        The compact_pool function uses swap-with-tail, which is O(n).      */
-    compact_pool(state->bullets,   &state->bullet_count);
-    compact_pool(state->asteroids, &state->asteroid_count);
+    compact_pool(pool);
 
     /* ══════ Win condition: all asteroids cleared ════════════════════════ */
-    if (state->asteroid_count == 0 && state->phase == PHASE_PLAYING) {
+    if (pool->index.count == 0 && state->phase == PHASE_PLAYING) {
         /* Advance to next wave: re-run init (new asteroid model + more spawn) */
         /* COURSE NOTE: A full implementation would have a proper wave counter.
            For simplicity we just restart; students can add wave progression.  */
@@ -567,27 +901,22 @@ void asteroids_render(const GameState *state, AsteroidsBackbuffer *bb) {
     draw_rect(bb, 0, 0, bb->width, bb->height, COLOR_BLACK);
 
     /* ── 2. Asteroids ─────────────────────────────────────────────────── */
-    for (int i = 0; i < state->asteroid_count; i++) {
-        const SpaceObject *a = &state->asteroids[i];
-        if (!a->active) continue;
-        /* The asteroid model has unit radius; multiply by a->size to scale */
-        draw_wireframe(bb,
-                       state->asteroid_model, ASTEROID_VERTS,
-                       a->x, a->y,
-                       a->angle, a->size,
-                       COLOR_WHITE);
-    }
+    /* The asteroid model has unit radius; each rock is scaled by its size column.
+       All rocks share one model, so they go through the batched path.   */
+    draw_wireframe_batch(bb, state->asteroid_model, ASTEROID_VERTS,
+                         &state->asteroids, COLOR_WHITE);
 
     /* ── 3. Bullets ──────────────────────────────────────────────────── */
-    for (int i = 0; i < state->bullet_count; i++) {
-        const SpaceObject *b = &state->bullets[i];
-        if (!b->active) continue;
+    const BulletPool *bp = &state->bullets;
+    for (int k = 0; k < bp->count; k++) {
+        int i = (bp->head + k) & (BULLET_RING - 1);
+        if (bp->hit[i]) continue;
         /* Bullets are just single toroidal pixels; they're too small for
-           a full wireframe.  The size field controls their brightness as
-           they fade — we skip drawing if effectively invisible.          */
-        draw_pixel_w(bb, (int)b->x, (int)b->y, COLOR_YELLOW);
-        draw_pixel_w(bb, (int)b->x+1, (int)b->y, COLOR_YELLOW);
-        draw_pixel_w(bb, (int)b->x, (int)b->y+1, COLOR_YELLOW);
+           a full wireframe.                                              */
+        int x = (int)bp->x[i], y = (int)bp->y[i];
+        draw_pixel_w(bb, x,     y,     COLOR_YELLOW);
+        draw_pixel_w(bb, x + 1, y,     COLOR_YELLOW);
+        draw_pixel_w(bb, x,     y + 1, COLOR_YELLOW);
     }
 
     /* ── 4. Ship ─────────────────────────────────────────────────────── */
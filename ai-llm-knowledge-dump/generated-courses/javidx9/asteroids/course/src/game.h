@@ -49,6 +49,9 @@
   #define ASSERT(cond, msg)     ((void)0)
 #endif
 
+/* After ASSERT: the engine headers keep a host's own ASSERT */
+#include "../../../../../../engine/game/entity-pool.h"
+
 /* ══════ Pool Limits ════════════════════════════════════════════════════════
 
    Fixed-size pools avoid dynamic allocation.  Maximum counts are conservatively
@@ -59,9 +62,16 @@
      • Simple to debug (all state is in one GameState struct)
      • In C, forgetting to free heap memory is a common source of bugs —
        stack/struct pools sidestep that class of error entirely.
-     • JS equivalent:  "preallocated object pool" pattern for game entities.  */
+     • JS equivalent:  "preallocated object pool" pattern for game entities.
+
+   MAX_ASTEROIDS can be raised at build time for stress testing, e.g.
+   -DMAX_ASTEROIDS=4096 ("asteroid storm").  Collision cost stays flat
+   thanks to the spatial grid below; only GameState grows.             */
+#ifndef MAX_ASTEROIDS
 #define MAX_ASTEROIDS    32
+#endif
 #define MAX_BULLETS      8
+#define BULLET_RING     16   /* power of two; see BulletPool            */
 
 /* Model vertex counts:
      SHIP_VERTS      — triangle (3 points make the ship shape)
@@ -95,9 +105,8 @@ typedef enum {
 
 /* ══════ SpaceObject ════════════════════════════════════════════════════════
 
-   Represents any entity in the game: ship, asteroid, or bullet.
-   Using a single struct for all object types keeps the pools uniform
-   and avoids type-tagging logic in the collision system.
+   The ship.  Asteroids keep the same fields as the columns of
+   AsteroidPool below; bullets live in BulletPool.
 
    JS equivalent:
      interface SpaceObject {
@@ -115,6 +124,92 @@ typedef struct {
     int   active;    /* 1 = in-use, 0 = slot is free                         */
 } SpaceObject;
 
+/* ══════ AsteroidPool — the engine entity pool ═════════════════════════════
+
+   The rocks live in an engine/game/entity-pool.h pool: one column per
+   field, dense in [0, index.count), so the physics loop streams plain
+   float arrays.  add_asteroid allocs at the end; a destroyed rock is
+   flagged active = 0 and compact_pool removes it after the collision
+   loops (remove() moves the last rock into the hole: swap-with-tail).
+
+   Columns and bookkeeping are pushed from asteroid_arena, which sits
+   over asteroid_memory inside GameState, so there is no malloc.
+   ASTEROID_POOL_BYTES: 25 bytes of columns plus 14 of pool index per
+   rock, and a cache line of alignment slack for each of the 11 arrays
+   (one more for the arena's own start).
+
+   JS equivalent:
+     const asteroids = { x: new Float32Array(n), y: new Float32Array(n), … };
+                                                                          */
+#define ASTEROID_COLUMNS(X)                                             \
+    X(float, x) X(float, y) X(float, dx) X(float, dy)                   \
+    X(float, angle) X(float, size) X(uint8_t, active)
+DE100_POOL_DECLARE(AsteroidPool, asteroid_pool, ASTEROID_COLUMNS)
+
+#define ASTEROID_POOL_BYTES(capacity) \
+    ((size_t)(capacity) * 40 + 12 * DE100_POOL_COLUMN_ALIGNMENT)
+
+/* ══════ BulletPool — spawn-ordered SoA ring ═══════════════════════════════
+
+   Bullets are the game's particles: points with a velocity and a fixed
+   life (BULLET_LIFE_S).  They live in SoA columns arranged as a ring in
+   spawn order (the engine's engine/game/particles.h pool, cut down):
+
+     • head .. head + count - 1 (mod BULLET_RING) are the queued bullets,
+       oldest first.  Every bullet lives exactly as long, so they expire
+       in spawn order: the update just pops them off the front.  Nothing
+       is ever swapped or compacted.
+     • A bullet that hits a rock is flagged hit[] and skipped; it leaves
+       the ring when it reaches the front.
+     • live counts the unflagged ones; that is what MAX_BULLETS caps.
+       FIRE_COOLDOWN allows at most ceil(BULLET_LIFE_S / FIRE_COOLDOWN)
+       = 14 bullets in flight or flagged at once, so BULLET_RING = 16
+       never overflows.
+
+   The integration loop runs over all BULLET_RING slots, free ones
+   included (harmlessly), so it is branch-free and vectorizes.         */
+#define BULLET_LIFE_S 2.0f   /* seconds in flight (the old size 2 → 0 fade) */
+
+typedef struct {
+    float   x[BULLET_RING], y[BULLET_RING];
+    float   dx[BULLET_RING], dy[BULLET_RING];
+    float   life[BULLET_RING];   /* seconds left                        */
+    uint8_t hit[BULLET_RING];    /* 1 = spent on a rock, awaiting pop    */
+    int     head, count;         /* ring: oldest first                  */
+    int     live;                /* queued and not hit (≤ MAX_BULLETS)  */
+} BulletPool;
+
+/* ══════ AsteroidGrid — collision broadphase ═══════════════════════════════
+
+   A uniform grid over the (wrapping) screen, rebuilt every frame.  Each
+   asteroid is filed under the one cell holding its centre; a query for a
+   circle then only has to look at the 3×3 block of cells around it
+   (wrapping at the edges), instead of every asteroid in the pool.
+
+   That 3×3 block is enough as long as a cell is at least as wide as the
+   largest asteroid radius plus the largest query radius (ship: 5), which
+   is why ASTEROID_GRID_CELL is 32 > 20 + 5.  GRID_COLS/ROWS round down,
+   so cells are never narrower than that.
+
+   Layout is a counting sort, not linked lists:
+     cell_start[c] .. cell_start[c+1]-1  index into items[]
+     items[]                              asteroid indices, grouped by cell
+   One pass counts, one prefix sum, one pass scatters — no allocation.
+
+   JS equivalent:
+     const cells = new Map();   // cellKey → [asteroidIndex, …]
+     // …but flat arrays, so nothing is allocated per frame.             */
+#define ASTEROID_GRID_CELL 32
+#define ASTEROID_GRID_COLS (SCREEN_W / ASTEROID_GRID_CELL)
+#define ASTEROID_GRID_ROWS (SCREEN_H / ASTEROID_GRID_CELL)
+#define ASTEROID_GRID_CELLS (ASTEROID_GRID_COLS * ASTEROID_GRID_ROWS)
+
+typedef struct {
+    int cell_start[ASTEROID_GRID_CELLS + 1]; /* prefix sums into items[]    */
+    int items[MAX_ASTEROIDS];                /* asteroid indices by cell    */
+    int cell_of[MAX_ASTEROIDS];              /* scratch: cell per asteroid  */
+} AsteroidGrid;
+
 /* ══════ GameButtonState ════════════════════════════════════════════════════
 
    Tracks both "is the key held right now" (ended_down) and "how many
@@ -172,13 +267,17 @@ typedef struct {
    makes save/restore trivial and simplifies reasoning about state.
 
    MEMORY NOTE: GameState is allocated on the stack in main().  At roughly
-   3–4 KB for this game it is well within typical stack limits (~1 MB).    */
+   4–5 KB for this game it is well within typical stack limits (~1 MB).
+   A storm build (-DMAX_ASTEROIDS=4096) is ~200 KB — still fine.
+   The asteroid pool points into asteroid_memory, so don't copy a
+   GameState after asteroids_init; the copy would share the original's
+   columns.                                                               */
 typedef struct {
     SpaceObject player;                    /* the ship                      */
-    SpaceObject asteroids[MAX_ASTEROIDS];  /* asteroid pool                 */
-    int         asteroid_count;            /* active entries in asteroids[] */
-    SpaceObject bullets[MAX_BULLETS];      /* bullet pool                   */
-    int         bullet_count;              /* active entries in bullets[]   */
+    AsteroidPool asteroids;                /* asteroid pool (SoA columns)   */
+    De100MemoryArena asteroid_arena;       /* backs asteroids' columns      */
+    BulletPool  bullets;                   /* bullet ring (SoA)             */
+    AsteroidGrid asteroid_grid;            /* rebuilt each update           */
 
     int        score;                      /* current game score            */
     int        best_score;                 /* all-time best (survives init) */
@@ -193,6 +292,8 @@ typedef struct {
     Vec2 asteroid_model[ASTEROID_VERTS];
 
     GameAudioState audio;                  /* all SFX state                 */
+
+    uint64_t asteroid_memory[ASTEROID_POOL_BYTES(MAX_ASTEROIDS) / 8];
 } GameState;
 
 /* ══════ prepare_input_frame ════════════════════════════════════════════════
@@ -0,0 +1,237 @@
+/* =============================================================================
+ * render_bench.c — Wireframe Rendering Benchmark, No Window
+ * =============================================================================
+ *
+ * Build & run:  ./build-dev.sh --backend=render-bench -r
+ *               ./build/render-bench [frames] [seed]
+ *
+ * For each backbuffer size (320x240 .. 3840x2160), each overdraw level
+ * (line pixels adding up to 1x / 4x the buffer) and each path:
+ *
+ *   wireframe        draw_wireframe per rock (exact sincos per object)
+ *   wireframe_batch  draw_wireframe_batch over the whole pool
+ *
+ * draws `frames` frames of the same field of rocks (the game's three sizes,
+ * random spin, anywhere on screen — so some straddle an edge and wrap) and
+ * prints Mpix/s and cycles/px (__rdtsc ticks: compare runs on one machine
+ * only) from the fastest frame, plus an FNV-1a checksum of the frame.  Same
+ * seed ⇒ same checksum, so a drawing change that alters output shows up in
+ * the diff.
+ *
+ * draw_wireframe and draw_wireframe_batch are private to game.c, so this
+ * file compiles game.c into itself rather than linking it; the render-bench
+ * backend leaves game.c out of SOURCES for that reason.
+ *
+ * Pixels are Bresenham's count per edge — max(|dx|, |dy|) + 1 — of each
+ * rock's whole-pixel outline.
+ * =============================================================================
+ */
+
+#include "game.c"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>   /* __rdtsc() */
+#endif
+
+typedef enum {
+    BENCH_WIREFRAME = 0,
+    BENCH_WIREFRAME_BATCH,
+    BENCH_PRIM_COUNT
+} BenchPrimitive;
+
+static const char *bench_prim_names[BENCH_PRIM_COUNT] = {
+    "wireframe", "wireframe_batch"
+};
+
+static const int bench_sizes[][2] = {
+    {320, 240}, {640, 480}, {1280, 720}, {1920, 1080}, {3840, 2160}
+};
+
+static const int bench_overdraws[] = {1, 4};
+
+static const float bench_rock_sizes[] = {
+    ASTEROID_LARGE_SIZE, ASTEROID_MEDIUM_SIZE, ASTEROID_SMALL_SIZE
+};
+
+/* xorshift32 — asteroids_init() reseeds rand() from the clock */
+static uint32_t bench_rand(uint32_t *state) {
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return *state = x;
+}
+
+static double bench_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static uint64_t bench_cycles(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return 0;   /* cycles/px reads 0: no counter on this target */
+#endif
+}
+
+static uint32_t bench_checksum(const AsteroidsBackbuffer *bb) {
+    uint32_t hash = 2166136261u;
+    for (int y = 0; y < bb->height; y++) {
+        const uint8_t *row = (const uint8_t *)bb->pixels + y * bb->pitch;
+        for (int i = 0; i < bb->width * 4; i++)
+            hash = (hash ^ row[i]) * 16777619u;
+    }
+    return hash;
+}
+
+/* The same jagged circle asteroids_init() builds, from xorshift noise */
+static void bench_build_model(Vec2 *model, uint32_t *seed) {
+    for (int i = 0; i < ASTEROID_VERTS; i++) {
+        float noise = 0.8f + ((float)(bench_rand(seed) % 100) / 100.0f) * 0.4f;
+        float t     = ((float)i / (float)ASTEROID_VERTS) * 2.0f * PI;
+        model[i].x = sinf(t) * noise;
+        model[i].y = cosf(t) * noise;
+    }
+}
+
+/* Line pixels of rock i: Bresenham steps along each whole-pixel edge */
+static long long bench_rock_pixels(const Vec2 *model, const AsteroidPool *rocks,
+                                   int i) {
+    float ca = cosf(rocks->angle[i]), sa = sinf(rocks->angle[i]);
+    float x = rocks->x[i], y = rocks->y[i], size = rocks->size[i];
+    int   ix[ASTEROID_VERTS], iy[ASTEROID_VERTS];
+    long long pixels = 0;
+    for (int v = 0; v < ASTEROID_VERTS; v++) {
+        ix[v] = (int)(x + (model[v].x * ca - model[v].y * sa) * size);
+        iy[v] = (int)(y + (model[v].x * sa + model[v].y * ca) * size);
+    }
+    for (int v = 0; v < ASTEROID_VERTS; v++) {
+        int j  = (v + 1) % ASTEROID_VERTS;
+        int dx = abs(ix[j] - ix[v]), dy = abs(iy[j] - iy[v]);
+        pixels += (dx > dy ? dx : dy) + 1;
+    }
+    return pixels;
+}
+
+/* Rocks until their outlines add up to overdraw × buffer (or the pool fills) */
+static void bench_build_scene(const Vec2 *model, int width, int height,
+                              int overdraw, uint32_t seed, AsteroidPool *rocks,
+                              long long *out_pixels) {
+    long long target = (long long)width * height * overdraw;
+    long long pixels = 0;
+    int i;
+
+    asteroid_pool_clear(rocks);
+    while (pixels < target && (i = asteroid_pool_alloc(rocks, NULL)) >= 0) {
+        rocks->x[i]      = (float)(bench_rand(&seed) % (uint32_t)width);
+        rocks->y[i]      = (float)(bench_rand(&seed) % (uint32_t)height);
+        rocks->dx[i]     = 0.0f;
+        rocks->dy[i]     = 0.0f;
+        rocks->angle[i]  = (float)(bench_rand(&seed) % 6283) / 1000.0f;
+        rocks->size[i]   = bench_rock_sizes[bench_rand(&seed) % 3];
+        rocks->active[i] = 1;
+        pixels += bench_rock_pixels(model, rocks, i);
+    }
+
+    *out_pixels = pixels;
+}
+
+static void bench_draw(BenchPrimitive prim, AsteroidsBackbuffer *bb,
+                       const Vec2 *model, const AsteroidPool *rocks) {
+    if (prim == BENCH_WIREFRAME_BATCH) {
+        draw_wireframe_batch(bb, model, ASTEROID_VERTS, rocks, COLOR_WHITE);
+        return;
+    }
+    for (uint32_t i = 0; i < rocks->index.count; i++) {
+        draw_wireframe(bb, model, ASTEROID_VERTS, rocks->x[i], rocks->y[i],
+                       rocks->angle[i], rocks->size[i], COLOR_WHITE);
+    }
+}
+
+int main(int argc, char **argv) {
+    int      frames = argc > 1 ? atoi(argv[1]) : 10;
+    uint32_t seed   = argc > 2 ? (uint32_t)strtoul(argv[2], NULL, 10) : 1;
+    if (seed == 0) seed = 1;   /* xorshift's only fixed point */
+    if (frames <= 0) frames = 10;
+
+    int size_count = (int)(sizeof(bench_sizes) / sizeof(bench_sizes[0]));
+    int max_width  = bench_sizes[size_count - 1][0];
+    int max_height = bench_sizes[size_count - 1][1];
+    /* A small rock outlines ~30 px; 16 is a safe floor.  The engine pool
+       caps a pool at DE100_POOL_MAX_CAPACITY, still ~2x what 4x needs. */
+    int max_rocks  = max_width * max_height * 4 / 16;
+    if (max_rocks > (int)DE100_POOL_MAX_CAPACITY)
+        max_rocks = (int)DE100_POOL_MAX_CAPACITY;
+
+    /* The game's asteroid pool, over a heap arena this size */
+    size_t           rock_bytes  = ASTEROID_POOL_BYTES(max_rocks);
+    void            *rock_memory = malloc(rock_bytes);
+    uint32_t        *pixels = malloc(sizeof(uint32_t) * (size_t)max_width * max_height);
+    De100MemoryArena rock_arena;
+    AsteroidPool     rocks;
+    if (rock_memory)
+        de100_arena_init(&rock_arena, rock_bytes, rock_memory);
+    if (!rock_memory || !pixels ||
+        !asteroid_pool_init(&rocks, &rock_arena, (uint32_t)max_rocks)) {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+
+    Vec2     model[ASTEROID_VERTS];
+    uint32_t model_seed = seed;
+    bench_build_model(model, &model_seed);
+
+    printf("%d frames per case (fastest kept), seed %u\n\n", frames, seed);
+    printf("%-10s %8s %-16s %12s %10s %10s\n", "size", "overdraw", "primitive",
+           "Mpix/s", "cycles/px", "checksum");
+
+    int overdraw_count = (int)(sizeof(bench_overdraws) / sizeof(bench_overdraws[0]));
+    for (int s = 0; s < size_count; s++) {
+        AsteroidsBackbuffer bb = {
+            .pixels = pixels,
+            .width  = bench_sizes[s][0],
+            .height = bench_sizes[s][1],
+            .pitch  = bench_sizes[s][0] * 4,
+        };
+        char size_name[16];
+        snprintf(size_name, sizeof(size_name), "%dx%d", bb.width, bb.height);
+
+        for (int o = 0; o < overdraw_count; o++) {
+            long long scene_pixels = 0;
+            bench_build_scene(model, bb.width, bb.height, bench_overdraws[o],
+                              seed, &rocks, &scene_pixels);
+
+            for (int prim = 0; prim < BENCH_PRIM_COUNT; prim++) {
+                double   best_seconds = 1e30;
+                uint64_t best_cycles  = UINT64_MAX;
+                uint32_t checksum     = 0;
+                for (int frame = 0; frame < frames; frame++) {
+                    /* Same starting frame every time, so the checksum is stable */
+                    memset(pixels, 0, (size_t)bb.pitch * bb.height);
+
+                    double   start        = bench_seconds();
+                    uint64_t start_cycles = bench_cycles();
+                    bench_draw((BenchPrimitive)prim, &bb, model, &rocks);
+                    uint64_t cycles  = bench_cycles() - start_cycles;
+                    double   seconds = bench_seconds() - start;
+
+                    if (seconds < best_seconds) best_seconds = seconds;
+                    if (cycles  < best_cycles)  best_cycles  = cycles;
+                    if (frame == 0) checksum = bench_checksum(&bb);
+                }
+                if (best_seconds <= 0.0) best_seconds = 1e-9;
+
+                printf("%-10s %7dx %-16s %12.1f %10.2f %10u\n", size_name,
+                       bench_overdraws[o], bench_prim_names[prim],
+                       (double)scene_pixels / best_seconds * 1e-6,
+                       (double)best_cycles / (double)scene_pixels, checksum);
+            }
+        }
+    }
+
+    free(pixels);
+    free(rock_memory);
+    return 0;
+}
@@ -66,7 +66,9 @@ typedef enum {
    Asteroids can have many simultaneous explosions (e.g. a bullet hits a large
    asteroid that splits into two mediums, which both get hit by the same burst
    of fire, generating 5 sounds in one frame).  8 slots is safe head-room.  */
+#ifndef MAX_SIMULTANEOUS_SOUNDS   /* the audio bench builds with 256 */
 #define MAX_SIMULTANEOUS_SOUNDS 16
+#endif
 
 /* ══════ SoundInstance — one actively playing sound ════════════════════════
 
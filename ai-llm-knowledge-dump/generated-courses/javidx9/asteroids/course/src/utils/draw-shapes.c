@@ -22,6 +22,11 @@
 
 #include "draw-shapes.h"
 
+/* The engine's span kernels (SSE2 / AVX2 / NEON, picked at first use) do
+ * the per-pixel work for rects; this game keeps its AsteroidsBackbuffer
+ * and draws through a view of its pixels.  Header-only, nothing to link. */
+#include "../../../../../../../engine/game/raster.h"
+
 /* ══════ draw_pixel_w — Toroidal Pixel Write ════════════════════════════════
 
    Wraps x and y into the backbuffer using modular arithmetic.
@@ -95,6 +100,91 @@ void draw_line(AsteroidsBackbuffer *bb,
     }
 }
 
+/* ══════ draw_line_clip — Bresenham's Line Algorithm (Clipped) ═════════════
+ *
+ * draw_line's pixels, minus the off-screen ones — but clipped once per line
+ * rather than tested per pixel, so the stepping loop has no bounds checks.
+ *
+ * Along the major axis (the longer extent, `len`) every step moves one
+ * pixel; after i steps the minor axis (extent `d`) has moved
+ *
+ *   q(i) = (2·d·i + len − 1) / (2·len)        (integer division)
+ *
+ * which is exactly when draw_line's error term steps it.  So the steps that
+ * land on screen form one range [first, last]: intersect the major axis's
+ * range with the one where q(i) keeps the minor axis on screen, then start
+ * the ordinary loop at `first` with the error term it would have had.
+ *
+ * JS analogy: like slicing an array to [first, last] before .forEach()
+ * instead of an if() inside the callback.                                  */
+
+/* Step range [*lo, *hi] (within [0, len]) whose minor coordinate
+ * c0 + s·q(i) is in [0, size).  Empty when *lo > *hi.                      */
+static void clip_minor_steps(int c0, int s, int d, int len, int size,
+                             long long *lo, long long *hi)
+{
+    /* Minor-axis moves k that keep it on screen: kmin <= q(i) <= kmax */
+    long long kmin = s > 0 ? -(long long)c0 : (long long)c0 - (size - 1);
+    long long kmax = s > 0 ? (long long)size - 1 - c0 : (long long)c0;
+    if (kmin < 0) kmin = 0;
+    if (kmax < kmin || (d == 0 && kmin > 0)) { *lo = 1; *hi = 0; return; }
+    if (d == 0) { *lo = 0; *hi = len; return; }
+
+    /* First i with q(i) >= kmin; last i with q(i) <= kmax */
+    long long n = 2LL * len * kmin - len + 1;
+    *lo = n <= 0 ? 0 : (n + 2LL * d - 1) / (2LL * d);
+    *hi = (2LL * len * kmax + len) / (2LL * d);
+}
+
+void draw_line_clip(AsteroidsBackbuffer *bb,
+                    int x0, int y0, int x1, int y1,
+                    uint32_t color)
+{
+    int dx = x1 - x0;  if (dx < 0) dx = -dx;
+    int dy = y1 - y0;  if (dy < 0) dy = -dy;
+    int sx = (x0 < x1) ? 1 : -1;
+    int sy = (y0 < y1) ? 1 : -1;
+    int stride = bb->pitch / 4;
+    int x_major = dx >= dy;
+    int len     = x_major ? dx : dy;
+    int x = x0, y = y0, err = dx - dy, n = len;
+
+    /* Both ends on screen (most edges) → so is the whole line, no clip
+       math.  Otherwise find the on-screen steps and jump to the first.  */
+    if ((unsigned)x0 >= (unsigned)bb->width  || (unsigned)x1 >= (unsigned)bb->width ||
+        (unsigned)y0 >= (unsigned)bb->height || (unsigned)y1 >= (unsigned)bb->height) {
+        long long lo, hi, a, b;
+        if (x_major) {
+            clip_minor_steps(x0, sx, len, len, bb->width,  &lo, &hi);  /* q(i) = i */
+            clip_minor_steps(y0, sy, dy,  len, bb->height, &a,  &b);
+        } else {
+            clip_minor_steps(y0, sy, len, len, bb->height, &lo, &hi);
+            clip_minor_steps(x0, sx, dx,  len, bb->width,  &a,  &b);
+        }
+        if (a > lo) lo = a;
+        if (b < hi) hi = b;
+        if (hi > len) hi = len;
+        if (lo > hi) return;
+
+        /* Step lo: i major-axis moves, q minor-axis moves */
+        int i  = (int)lo;
+        int q  = len ? (int)((2LL * (x_major ? dy : dx) * i + len - 1) / (2LL * len)) : 0;
+        int xs = x_major ? i : q, ys = x_major ? q : i;
+        x   = x0 + sx * xs;
+        y   = y0 + sy * ys;
+        err = dx - dy - xs * dy + ys * dx;
+        n   = (int)(hi - lo);
+    }
+
+    for (;; n--) {
+        bb->pixels[y * stride + x] = color;
+        if (n == 0) break;
+        int e2 = err * 2;
+        if (e2 > -dy) { err -= dy; x += sx; }
+        if (e2 <  dx) { err += dx; y += sy; }
+    }
+}
+
 /* ══════ draw_rect — Clipped Solid Rectangle ════════════════════════════════ */
 void draw_rect(AsteroidsBackbuffer *bb,
                int x, int y, int w, int h,
@@ -106,12 +196,14 @@ void draw_rect(AsteroidsBackbuffer *bb,
     int x1 = x + w;  if (x1 > bb->width)  x1 = bb->width;
     int y1 = y + h;  if (y1 > bb->height) y1 = bb->height;
 
+    if (x1 <= x0) return;
+
+    /* Clipped once: each row is one span, no per-pixel bounds checks.
+       Writes color as-is, alpha included (no blending here). */
+    De100PixelKernels *kernels = de100_pixel_kernels_get();
     int stride = bb->pitch / 4;  /* uint32_t elements per row */
-    for (int py = y0; py < y1; py++) {
-        for (int px = x0; px < x1; px++) {
-            bb->pixels[py * stride + px] = color;
-        }
-    }
+    for (int py = y0; py < y1; py++)
+        kernels->fill_row(bb->pixels + py * stride + x0, x1 - x0, color);
 }
 
 /* ══════ draw_rect_blend — Alpha-Blended Rectangle ══════════════════════════
@@ -126,6 +218,11 @@ void draw_rect(AsteroidsBackbuffer *bb,
  *   B = bits 16-23 → (color >> 16) & 0xFF
  *   A = bits 24-31 → (color >> 24) & 0xFF
  *
+ * The blend is the engine's de100_raster_rect: clipped once, then one
+ * blend_row per row — integer only, several pixels per instruction, and
+ *   out = (src·a + dst·(255 − a)) / 255   (truncated, alpha forced to 255)
+ * An opaque color is a plain fill; alpha 0 draws nothing.
+ *
  * JS equivalent (Canvas 2D API):
  *   ctx.globalAlpha = alpha / 255;
  *   ctx.fillStyle = `rgb(${r}, ${g}, ${b})`;
@@ -135,44 +232,7 @@ void draw_rect_blend(AsteroidsBackbuffer *bb,
                      int x, int y, int w, int h,
                      uint32_t color)
 {
-    /* Extract source channels — R is the LOW byte (bits 0-7) */
-    uint8_t sa = (uint8_t)((color >> 24) & 0xFF);  /* alpha         */
-    uint8_t sr = (uint8_t)((color >>  0) & 0xFF);  /* red   (low)   */
-    uint8_t sg = (uint8_t)((color >>  8) & 0xFF);  /* green (mid)   */
-    uint8_t sb = (uint8_t)((color >> 16) & 0xFF);  /* blue  (high)  */
-
-    if (sa == 0) return;    /* fully transparent — nothing to draw */
-
-    /* Clamp to backbuffer bounds */
-    int x0 = x < 0 ? 0 : x;
-    int y0 = y < 0 ? 0 : y;
-    int x1 = x + w;  if (x1 > bb->width)  x1 = bb->width;
-    int y1 = y + h;  if (y1 > bb->height) y1 = bb->height;
-
-    int stride = bb->pitch / 4;
-
-    for (int py = y0; py < y1; py++) {
-        for (int px = x0; px < x1; px++) {
-            uint32_t dst = bb->pixels[py * stride + px];
-
-            /* Extract destination channels (same byte layout) */
-            uint8_t dr = (uint8_t)((dst >>  0) & 0xFF);
-            uint8_t dg = (uint8_t)((dst >>  8) & 0xFF);
-            uint8_t db = (uint8_t)((dst >> 16) & 0xFF);
-
-            /* Linear blend:  result = src * (alpha/255) + dst * (1 - alpha/255)
-               Integer arithmetic: multiply by alpha, then divide by 255.
-               +127 rounds to nearest rather than truncating.              */
-            uint8_t rr = (uint8_t)((sr * sa + dr * (255 - sa) + 127) / 255);
-            uint8_t rg = (uint8_t)((sg * sa + dg * (255 - sa) + 127) / 255);
-            uint8_t rb = (uint8_t)((sb * sa + db * (255 - sa) + 127) / 255);
-
-            /* Pack result back into GAME_RGBA byte order (R in low byte)  */
-            bb->pixels[py * stride + px] =
-                ((uint32_t)255 << 24) |
-                ((uint32_t)rb  << 16) |
-                ((uint32_t)rg  <<  8) |
-                ((uint32_t)rr  <<  0);
-        }
-    }
+    GameBackBuffer view =
+        de100_backbuffer_view(bb->pixels, bb->width, bb->height, bb->pitch);
+    de100_raster_rect(&view, x, y, w, h, color);
 }
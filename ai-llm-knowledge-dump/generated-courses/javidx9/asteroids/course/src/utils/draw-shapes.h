@@ -11,6 +11,8 @@
  *                   objects cross screen boundaries seamlessly.
  *   draw_pixel    — CLIPPED: does nothing if (x, y) is off-screen.
  *   draw_line     — calls draw_pixel_w internally → lines wrap.
+ *   draw_line_clip — CLIPPED line; the wireframes draw each visible wrapped
+ *                   copy with it (see engine/game/render-cull.h).
  *   draw_rect     — CLIPPED: used for HUD / overlay boxes that must stay
  *                   on screen.
  *   draw_rect_blend — same as draw_rect but alpha-blends with the existing
@@ -43,6 +45,11 @@ void draw_pixel(AsteroidsBackbuffer *bb, int x, int y, uint32_t color);
    via draw_pixel_w so long lines that cross the screen edge wrap around.  */
 void draw_line(AsteroidsBackbuffer *bb, int x0, int y0, int x1, int y1, uint32_t color);
 
+/* ── Bresenham line (clipped) ─────────────────────────────────────────────
+   Same pixels as draw_line, but off-screen ones are skipped instead of
+   wrapped.  Clipped once per line: the pixel loop itself has no tests.  */
+void draw_line_clip(AsteroidsBackbuffer *bb, int x0, int y0, int x1, int y1, uint32_t color);
+
 /* ── Clipped filled rectangle ─────────────────────────────────────────────
    Draws a solid-colour rectangle clamped to the backbuffer bounds.
    (x, y) is the top-left corner; w×h is width×height in pixels.         */
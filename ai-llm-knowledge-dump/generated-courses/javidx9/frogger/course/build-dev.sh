@@ -56,7 +56,7 @@ while [[ $# -gt 0 ]]; do
             echo "Usage: $0 [options]"
             echo ""
             echo "Options:"
-            echo "  --backend=NAME   Select backend: x11, raylib (default: raylib)"
+            echo "  --backend=NAME   Select backend: x11, raylib, audio-bench (default: raylib)"
             echo "  -r, --run        Run the game after a successful build"
             echo "  -d, --debug      Enable AddressSanitizer + UBSan (-DDEBUG)"
             echo "  --help, -h       Show this help message"
@@ -77,6 +77,9 @@ done
 # None of these files include X11 or Raylib headers.
 SOURCES="src/game.c src/audio.c src/utils/draw-shapes.c src/utils/draw-text.c"
 
+# The lane tilemap's arena grows its commit frontier through engine/_common.
+SOURCES="$SOURCES ../../../../../engine/_common/memory.c"
+
 # -lm: C math library (fabsf used in audio synthesis).
 # Unlike JS, C's math functions are NOT built-in — you must link explicitly.
 LIBS="-lm"
@@ -86,6 +89,10 @@ LIBS="-lm"
 # A release build would set this to the installed data directory.
 ASSETS_FLAGS="-DASSETS_DIR=\"$(pwd)/assets\""
 
+# Output name and extra flags; the bench backend overrides these.
+OUTPUT="./build/frogger"
+BACKEND_FLAGS=""
+
 # ══════ Backend Selection ══════════════════════════════════════════════════
 
 case "$BACKEND" in
@@ -111,9 +118,19 @@ case "$BACKEND" in
         SOURCES="$SOURCES src/main_raylib.c"
         ;;
 
+    # ── Audio Bench (headless) ────────────────────────────────────────────
+    # No window, no audio device: times game_get_audio_samples under
+    # synthetic voice loads (see src/audio_bench.c).  Optimised, and the
+    # voice cap is raised so the heavier loads fit.
+    audio-bench)
+        SOURCES="$SOURCES src/audio_bench.c"
+        OUTPUT="./build/audio-bench"
+        BACKEND_FLAGS="-O2 -DMAX_SIMULTANEOUS_SOUNDS=256"
+        ;;
+
     *)
         echo "Error: Unknown backend '$BACKEND'" >&2
-        echo "Available backends: x11, raylib" >&2
+        echo "Available backends: x11, raylib, audio-bench" >&2
         exit 1
         ;;
 esac
@@ -125,7 +142,7 @@ esac
 #   -Wextra  Additional warnings
 #   -g       Debug symbols
 #   -O0      Disable optimisations (debugger step-through works correctly)
-FLAGS="-Wall -Wextra -g -O0 $ASSETS_FLAGS"
+FLAGS="-Wall -Wextra -g -O0 $ASSETS_FLAGS $BACKEND_FLAGS"
 
 if [[ "$DEBUG_BUILD" == true ]]; then
     FLAGS="$FLAGS -fsanitize=address,undefined -DDEBUG"
@@ -134,8 +151,6 @@ fi
 
 # ══════ Build ═══════════════════════════════════════════════════════════════
 
-OUTPUT="./build/frogger"
-
 # Argument order: flags → output path → source files → libraries last.
 # Libraries after sources: the linker resolves symbols in order; placing
 # -lm before object files causes "undefined reference" errors.
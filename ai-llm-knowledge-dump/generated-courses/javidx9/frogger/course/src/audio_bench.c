@@ -0,0 +1,138 @@
+/* =============================================================================
+ * audio_bench.c — game_get_audio_samples Under Synthetic Voice Loads
+ * =============================================================================
+ *
+ * Build & run:  ./build-dev.sh --backend=audio-bench -r
+ *               ./build/audio-bench [seconds_of_audio] [seed]
+ *
+ * For 1, 16, 64 and 256 concurrent voices renders `seconds_of_audio` at
+ * 48 kHz in 800-frame calls — one 60 Hz frame each — and prints:
+ *   ns/sample    per stereo frame
+ *   x realtime   seconds of audio mixed per second of CPU
+ *   voices/core  mean voices playing × realtime: how many voices one core
+ *                could mix live
+ *   checksum     sum of every output sample
+ *
+ * The mix is set up the way game_init() leaves it mid-game: both ambient
+ * loops running and the music sequencer playing.  Those count towards the
+ * load — so the 1-voice load really plays that bed, and voices/core uses
+ * the measured count — and one-shot SFX (random SOUND_ID and pan) fill the
+ * rest, topped back up before every call since they expire.  Loads above
+ * MAX_SIMULTANEOUS_SOUNDS are clamped (this backend raises it to 256).
+ *
+ * WAVE_NOISE draws from rand(), seeded from `seed`: same seed and same libc
+ * ⇒ same checksum, so it doubles as a check that a mixer change didn't alter
+ * the output.
+ * =============================================================================
+ */
+
+#include "game.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_SAMPLE_RATE 48000
+#define BENCH_CALL_FRAMES 800
+
+static const int bench_voice_counts[] = {1, 16, 64, 256};
+
+/* xorshift32 — picks sounds and pans without touching rand()'s sequence */
+static uint32_t bench_rand(uint32_t *state) {
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return *state = x;
+}
+
+static double bench_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/* One-shot SFX only: SOUND_HOP … SOUND_LEVEL_START */
+static void bench_top_up(GameState *state, int voices, uint32_t *seed) {
+    int sfx_count = SOUND_LEVEL_START - SOUND_HOP + 1;
+    while (state->audio.active_sound_count < voices) {
+        SOUND_ID id  = (SOUND_ID)(SOUND_HOP + bench_rand(seed) % sfx_count);
+        float    pan = (float)(bench_rand(seed) % 2001) / 1000.0f - 1.0f;
+        game_play_sound(state, id, pan);
+    }
+}
+
+int main(int argc, char **argv) {
+    double   audio_seconds = argc > 1 ? atof(argv[1]) : 10.0;
+    uint32_t seed = argc > 2 ? (uint32_t)strtoul(argv[2], NULL, 10) : 1;
+    if (seed == 0) seed = 1;   /* xorshift's only fixed point */
+    if (audio_seconds <= 0.0) audio_seconds = 10.0;
+
+    GameState *state   = calloc(1, sizeof(GameState));
+    int16_t   *samples = malloc(sizeof(int16_t) * 2 * BENCH_CALL_FRAMES);
+    if (!state || !samples) {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+
+    long long total_frames = (long long)(audio_seconds * BENCH_SAMPLE_RATE);
+    float     call_seconds = (float)BENCH_CALL_FRAMES / BENCH_SAMPLE_RATE;
+
+    printf("%.1f s of audio per load, %d-frame calls, voice cap %d, seed %u\n\n",
+           audio_seconds, BENCH_CALL_FRAMES, MAX_SIMULTANEOUS_SOUNDS, seed);
+    printf("%6s %12s %12s %12s %14s\n", "voices", "ns/sample", "x realtime",
+           "voices/core", "checksum");
+
+    int load_count = (int)(sizeof(bench_voice_counts) / sizeof(bench_voice_counts[0]));
+    for (int load = 0; load < load_count; load++) {
+        int voices = bench_voice_counts[load];
+        if (voices > MAX_SIMULTANEOUS_SOUNDS) voices = MAX_SIMULTANEOUS_SOUNDS;
+
+        /* Fresh mixer per load: main()'s volumes, game_init()'s loops */
+        uint32_t load_seed = seed;
+        GameAudioState *audio = &state->audio;
+        srand(seed);
+        memset(audio, 0, sizeof(*audio));
+        audio->samples_per_second = BENCH_SAMPLE_RATE;
+        audio->master_volume      = 1.0f;
+        audio->sfx_volume         = 1.0f;
+        audio->music_volume       = 0.40f;
+        audio->ambient_volume     = 0.30f;
+        game_play_looping(state, SOUND_AMBIENT_TRAFFIC, 0.0f, audio->ambient_volume);
+        game_play_looping(state, SOUND_AMBIENT_WATER,   0.0f, audio->ambient_volume);
+        audio->music_playing  = 1;
+        audio->music_note_idx = -1;
+
+        AudioOutputBuffer buffer = {
+            .samples            = samples,
+            .samples_per_second = BENCH_SAMPLE_RATE,
+        };
+
+        long long checksum = 0, voice_calls = 0, calls = 0;
+        double    start    = bench_seconds();
+        for (long long done = 0; done < total_frames;) {
+            long long left = total_frames - done;
+            buffer.sample_count = (int)(left < BENCH_CALL_FRAMES ? left : BENCH_CALL_FRAMES);
+            game_music_update(state, call_seconds);
+            bench_top_up(state, voices, &load_seed);
+            voice_calls += audio->active_sound_count;
+            calls++;
+            game_get_audio_samples(state, &buffer);
+            for (int i = 0; i < buffer.sample_count * 2; i++)
+                checksum += samples[i];
+            done += buffer.sample_count;
+        }
+        double elapsed = bench_seconds() - start;
+        if (elapsed <= 0.0) elapsed = 1e-9;
+
+        double realtime = audio_seconds / elapsed;
+        printf("%6d %12.2f %12.1f %12.0f %14lld\n", voices,
+               elapsed * 1e9 / (double)total_frames, realtime,
+               (double)voice_calls / (double)calls * realtime, checksum);
+    }
+
+    free(samples);
+    free(state);
+    return 0;
+}
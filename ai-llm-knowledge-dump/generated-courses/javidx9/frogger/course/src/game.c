@@ -9,10 +9,11 @@
  * DOD PRINCIPLE:
  *   Lane data is split into two separate arrays:
  *     lane_speeds[]     — floats only; 10 × 4 = 40 bytes (one cache line).
- *     lane_patterns[][] — char grids; touched only during rendering pass.
- *   game_update reads lane_speeds for river drift and danger writes.
- *   game_render reads both for drawing.  Keeping them separate avoids
- *   cache pollution between the two hot inner loops.
+ *     lane_patterns[][] — char grids; read once, to fill the lane tilemap.
+ *   game_init turns the patterns into a tilemap (see "Lane tilemap" in
+ *   game.h).  game_update reads lane_speeds for river drift and danger
+ *   tests; game_render reads lane_speeds + the map for drawing.  Keeping them
+ *   separate avoids cache pollution between the two hot inner loops.
  * =============================================================================
  */
 
@@ -21,6 +22,9 @@
 #include "game.h"
 #include "utils/draw-shapes.h"
 #include "utils/draw-text.h"
+/* Lanes are 10 tiles tall and 64 wide: two-tile chunks fit them exactly */
+#define DE100_TILEMAP_CHUNK_TILES 2
+#include "../../../../../../engine/game/tilemap.h"
 
 #include <math.h>    /* fabsf */
 
@@ -112,6 +116,50 @@ static int tile_to_sprite(char c, int *src_x) {
     }
 }
 
+/* Scroll position of a lane as a single pixel offset into its row.
+   lane_scroll() splits it into tile + pixel; the map wants it whole.    */
+static int lane_scroll_px(float time, float speed) {
+    int tile_start, px_offset;
+    lane_scroll(time, speed, &tile_start, &px_offset);
+    return tile_start * TILE_PX + px_offset;
+}
+
+/* ─── Lane tilemap ─────────────────────────────────────────────────────── */
+
+/* Tile numbers: a tile character's index in LANE_TILE_CHARS.  Road ('.')
+   is DE100_TILEMAP_EMPTY, drawn as the map's black clear colour.        */
+static const char LANE_TILE_CHARS[] = "whp,jlkzxtyasdf";
+#define LANE_TILE_COUNT ((int)sizeof(LANE_TILE_CHARS) - 1)
+
+/* What de100_tilemap_init() pushes for the lanes: the tiles, a stale
+   flag and a cache per chunk, plus slack for the cache's alignment.     */
+#define LANE_CHUNK_COUNT  ((LANE_PATTERN_LEN / DE100_TILEMAP_CHUNK_TILES) * \
+                           (NUM_LANES / DE100_TILEMAP_CHUNK_TILES))
+#define LANE_ARENA_SIZE   (NUM_LANES * LANE_PATTERN_LEN * sizeof(De100Tile) + \
+                           LANE_CHUNK_COUNT + LANE_STRIP_PX * NUM_LANES *     \
+                           TILE_PX * sizeof(uint32_t) + 128)
+
+static uint32_t         s_lane_tileset[TILE_PX][LANE_TILE_COUNT * TILE_PX];
+static uint8_t          s_lane_tile_unsafe[LANE_TILE_COUNT];
+static uint8_t          s_lane_memory[LANE_ARENA_SIZE];
+static De100MemoryArena s_lane_arena;
+static De100Tilemap     s_lanes;
+
+static De100Tile lane_tile_of(char c) {
+    int i;
+    for (i = 0; i < LANE_TILE_COUNT; i++)
+        if (LANE_TILE_CHARS[i] == c) return (De100Tile)i;
+    return DE100_TILEMAP_EMPTY;
+}
+
+/* 1 if screen pixel x (0 <= x < SCREEN_W) of `lane` is unsafe at scroll
+   `sc` — the map pixel game_render's row copy puts at that x.            */
+static int lane_danger_at(int lane, int sc, int x) {
+    int       p    = (sc + TILE_PX + x) % LANE_STRIP_PX;
+    De100Tile tile = de100_tilemap_get(&s_lanes, p / TILE_PX, lane);
+    return tile != DE100_TILEMAP_EMPTY && s_lane_tile_unsafe[tile];
+}
+
 /* ═══════════════════════════════════════════════════════════════════════════
  * SPRITE LOADER
  * ═══════════════════════════════════════════════════════════════════════════
@@ -153,6 +201,62 @@ static int sprite_load(SpriteBank *bank, int spr_id, const char *path) {
     return 1;
 }
 
+/* ═══════════════════════════════════════════════════════════════════════════
+ * LANE TILEMAP SETUP
+ * ═══════════════════════════════════════════════════════════════════════════
+ *
+ * Render one tile per tile character into s_lane_tileset, then fill the
+ * map from lane_patterns.  Runs in game_init, after the sprites are
+ * loaded; the chunks themselves are rendered by the first draw.
+ *
+ * Per tile: resolve the sprite exactly as the per-tile renderer did
+ * (tile_to_sprite), then fill each cell with CELL_PX × CELL_PX pixels of
+ * its palette colour.  Transparent cells become black, which is what the
+ * old clear-then-blit path left there.
+ */
+static void lanes_build(const SpriteBank *bank) {
+    De100Sprite  sheet = de100_sprite_make(&s_lane_tileset[0][0],
+                                           LANE_TILE_COUNT * TILE_PX, TILE_PX,
+                                           (int)sizeof(s_lane_tileset[0]));
+    De100Tileset tileset = de100_tileset_make(&sheet, TILE_PX, TILE_PX);
+    int t, y, sy, sx, px, ry;
+
+    for (t = 0; t < LANE_TILE_COUNT; t++) {
+        char c     = LANE_TILE_CHARS[t];
+        int  src_x = 0;
+        int  spr   = tile_to_sprite(c, &src_x);
+
+        s_lane_tile_unsafe[t] = (uint8_t)!tile_is_safe(c);
+        for (sy = 0; sy < TILE_CELLS; sy++) {
+            uint32_t *row = &s_lane_tileset[sy * CELL_PX][t * TILE_PX];
+            for (sx = 0; sx < TILE_CELLS; sx++) {
+                uint32_t color = COLOR_BLACK;   /* transparent */
+                int idx = bank->offsets[spr] +
+                          sy * bank->widths[spr] + (src_x + sx);
+                if (bank->glyphs[idx] != 0x0020) {
+                    int ci = bank->colors[idx] & 0x0F;
+                    color  = GAME_RGB(CONSOLE_PALETTE[ci][0],
+                                      CONSOLE_PALETTE[ci][1],
+                                      CONSOLE_PALETTE[ci][2]);
+                }
+                for (px = 0; px < CELL_PX; px++)
+                    row[sx * CELL_PX + px] = color;
+            }
+            for (ry = 1; ry < CELL_PX; ry++)
+                memcpy(&s_lane_tileset[sy * CELL_PX + ry][t * TILE_PX], row,
+                       TILE_PX * sizeof(uint32_t));
+        }
+    }
+
+    de100_arena_init(&s_lane_arena, sizeof(s_lane_memory), s_lane_memory);
+    de100_tilemap_init(&s_lanes, &s_lane_arena, LANE_PATTERN_LEN, NUM_LANES,
+                       &tileset, COLOR_BLACK);
+    for (y = 0; y < NUM_LANES; y++)
+        for (t = 0; t < LANE_PATTERN_LEN; t++)
+            de100_tilemap_set(&s_lanes, t, y,
+                              lane_tile_of(lane_patterns[y][t]));
+}
+
 /* ═══════════════════════════════════════════════════════════════════════════
  * prepare_input_frame
  * ═══════════════════════════════════════════════════════════════════════════
@@ -264,6 +368,9 @@ void game_init(GameState *state, const char *assets_dir) {
         }
     }
 
+    /* Lane tiles and map, now that the sprites are in memory */
+    lanes_build(&state->sprites);
+
     /* Start ambient loops at zero volume (game_update_ambients() fades them in) */
     if (state->audio.samples_per_second > 0) {
         game_play_looping(state, SOUND_AMBIENT_TRAFFIC, 0.0f, 0.0f);
@@ -310,7 +417,7 @@ static void trigger_sound(GameState *state, SOUND_ID id, float pan) {
  *   3. Handle per-phase logic:
  *      PHASE_DEAD:    countdown dead_timer; respawn when it reaches 0
  *      PHASE_WIN:     wait for restart key; reset game on press
- *      PHASE_PLAYING: input, river drift, danger rebuild, collision, win check
+ *      PHASE_PLAYING: input, river drift, collision, win check
  */
 void game_update(GameState *state, const GameInput *input, float dt) {
     if (dt > 0.1f) dt = 0.1f;
@@ -384,37 +491,9 @@ void game_update(GameState *state, const GameInput *input, float dt) {
             state->frog_x -= lane_speeds[fy] * dt;
     }
 
-    /* ── Rebuild danger buffer ──────────────────────────────── */
-    /* Start with everything unsafe (1), then mark safe cells (0). */
-    memset(state->danger, 1, SCREEN_CELLS_W * SCREEN_CELLS_H);
-
-    {
-        int y, i, dy, cx, cx_start;
-        for (y = 0; y < NUM_LANES; y++) {
-            int tile_start, px_offset;
-            lane_scroll(state->time, lane_speeds[y], &tile_start, &px_offset);
-            int cell_offset = px_offset / CELL_PX;
-
-            for (i = 0; i < LANE_WIDTH; i++) {
-                char c    = lane_patterns[y][(tile_start + i) % LANE_PATTERN_LEN];
-                int  safe = tile_is_safe(c);
-                cx_start  = (-1 + i) * TILE_CELLS - cell_offset;
-
-                for (dy = 0; dy < TILE_CELLS; dy++) {
-                    int row = y * TILE_CELLS + dy;
-                    for (cx = cx_start; cx < cx_start + TILE_CELLS; cx++) {
-                        if (cx >= 0 && cx < SCREEN_CELLS_W)
-                            state->danger[row * SCREEN_CELLS_W + cx] =
-                                (uint8_t)(!safe);
-                    }
-                }
-            }
-        }
-    }
-
-    /* ── Collision: center-cell check ───────────────────────── */
-    /* Use the frog sprite's center pixel to determine its cell.
-     * Center-cell collision is immune to log-edge flickering.             */
+    /* ── Collision: center-pixel check ──────────────────────── */
+    /* Test the frog sprite's center pixel against its lane's danger bits.
+     * Center-pixel collision is immune to log-edge flickering.           */
     {
         int frog_px_x = (int)(state->frog_x * (float)TILE_PX);
         int frog_px_y = (int)(state->frog_y * (float)TILE_PX);
@@ -430,12 +509,27 @@ void game_update(GameState *state, const GameInput *input, float dt) {
             return;
         }
 
-        int coll_cx = (frog_px_x + TILE_PX / 2) / CELL_PX;
-        int coll_cy = (frog_px_y + TILE_PX / 2) / CELL_PX;
+        /* Sub-steps: the lane moves |speed| * dt tiles under the frog this
+         * frame, so test once per CELL_PX of that (a hazard is a whole tile
+         * wide and can't slip between two tests).  River rows carry the
+         * frog along, so its drift is rewound with the lane's time.       */
+        int   lane    = (frog_px_y + TILE_PX / 2) / TILE_PX;
+        float speed   = lane_speeds[lane];
+        int   river   = (lane >= 1 && lane <= 3);
+        float sweep   = fabsf(speed) * dt * (float)TILE_PX;
+        int   steps   = 1 + (int)(sweep / (float)CELL_PX);
+        int   hit     = 0;
+        int   s;
+        for (s = 0; s < steps && !hit; s++) {
+            float back = dt * (float)(steps - 1 - s) / (float)steps;
+            float fx   = state->frog_x + (river ? speed * back : 0.0f);
+            int   sc   = lane_scroll_px(state->time - back, speed);
+            int   cx   = (int)(fx * (float)TILE_PX) + TILE_PX / 2;
+            hit = lane_danger_at(lane, sc, cx);
+        }
 
-        if (state->danger[coll_cy * SCREEN_CELLS_W + coll_cx]) {
+        if (hit) {
             /* Road lanes 5-8 → squash; river lanes 1-3 and wall → splash */
-            int lane = (int)state->frog_y;
             int on_road = (lane >= 5 && lane <= 8);
             trigger_sound(state, on_road ? SOUND_SQUASH : SOUND_SPLASH,
                           frog_pan(state->frog_x));
@@ -478,42 +572,44 @@ void game_update(GameState *state, const GameInput *input, float dt) {
  *
  * Writes the complete frame into bb->pixels.
  * Rendering order (painter's algorithm — back to front):
- *   1. Clear to black
- *   2. Draw all lanes (background + sprites)
+ *   1. Clear to black (below the lanes)
+ *   2. Draw all lanes (row copies from the lane tilemap)
  *   3. Draw frog (with flash on death)
  *   4. HUD (score, lives, homes)
  *   5. Phase overlays (DEAD flash, WIN / GAME OVER screen)
  */
 void game_render(Backbuffer *bb, const GameState *state) {
-    int y, i;
+    int y;
     char buf[64];
 
-    /* 1. Clear */
-    draw_rect(bb, 0, 0, bb->width, bb->height, COLOR_BLACK);
-
-    /* 2. Draw lanes */
-    for (y = 0; y < NUM_LANES; y++) {
-        int tile_start, px_offset;
-        lane_scroll(state->time, lane_speeds[y], &tile_start, &px_offset);
-        int dest_py = y * TILE_PX;
-
-        for (i = 0; i < LANE_WIDTH; i++) {
-            char c   = lane_patterns[y][(tile_start + i) % LANE_PATTERN_LEN];
-            int src_x = 0;
-            int spr  = tile_to_sprite(c, &src_x);
-            int dest_px = (-1 + i) * TILE_PX - px_offset;
-
-            if (spr >= 0) {
-                int  off     = state->sprites.offsets[spr];
-                int  sheet_w = state->sprites.widths[spr];
-                draw_sprite_partial(bb,
-                    state->sprites.colors + off,
-                    state->sprites.glyphs + off,
-                    CONSOLE_PALETTE, sheet_w,
-                    src_x, 0, TILE_CELLS, TILE_CELLS,
-                    dest_px, dest_py);
-            }
-            /* '.' (road) is left as cleared black */
+    /* 1. Clear — only below the lanes; the lane copies cover the rest */
+    {
+        int lanes_h = MIN(NUM_LANES * TILE_PX, bb->height);
+        if (lanes_h < bb->height)
+            draw_rect(bb, 0, lanes_h, bb->width, bb->height - lanes_h,
+                      COLOR_BLACK);
+    }
+
+    /* 2. Draw lanes — row copies out of the lane tilemap's chunks.
+     * Screen x = 0 is one tile past the scroll position (same window the
+     * per-tile renderer drew, starting a tile off-screen to the left).
+     * Each lane is clipped to its own row and drawn twice: the map at the
+     * scroll offset, then again after it for the wrap past its end.      */
+    {
+        GameBackBuffer view = de100_backbuffer_view(bb->pixels, bb->width,
+                                                    bb->height, bb->pitch);
+        int w = MIN(bb->width, LANE_STRIP_PX);
+        for (y = 0; y < NUM_LANES && y * TILE_PX < bb->height; y++) {
+            int sc  = lane_scroll_px(state->time, lane_speeds[y]);
+            int src = ((sc + TILE_PX) % LANE_STRIP_PX + LANE_STRIP_PX) %
+                      LANE_STRIP_PX;
+            De100RenderClipRect clip = {
+                0, y * TILE_PX, w, MIN((y + 1) * TILE_PX, bb->height)
+            };
+            de100_tilemap_draw_clipped(&view, clip, &s_lanes, -src, 0);
+            if (src + w > LANE_STRIP_PX)
+                de100_tilemap_draw_clipped(&view, clip, &s_lanes,
+                                           LANE_STRIP_PX - src, 0);
         }
     }
 
@@ -60,6 +60,33 @@
 #define LANE_PATTERN_LEN 64    /* tiles in the repeating pattern           */
 #define NUM_LANES        10
 
+/* ══════ Lane tilemap — each lane drawn from cached chunks ═══════════════════
+
+   A lane is its 64-tile pattern repeated forever and scrolled sideways.
+   Instead of resolving and blitting ~18 sprite tiles per lane per frame,
+   the lanes are a tilemap (engine/game/tilemap.h): NUM_LANES rows of
+   LANE_PATTERN_LEN tile numbers, one number per kind of tile character,
+   over a tileset of those tiles pre-rendered once in game_init()
+   (already palette-converted, transparent cells baked to black).
+
+   The map caches its pixels in chunks of 2 × 2 tiles.  A chunk is
+   rendered from the tileset the first time it scrolls on screen, and
+   again only if one of its tiles changes.  Drawing a lane is then a
+   clipped copy per visible chunk, out of the cache at the scroll offset
+   (wrapping past the end of the pattern).  Collision reads the same map:
+   the tile under the frog is its screen x shifted by the same scroll
+   offset, then a table lookup.  That is cheap enough to repeat at
+   sub-steps, so a fast lane can't carry a hazard past the frog between
+   two frames.
+
+   MEMORY: 10 lanes × 64 px × 4096 px × 4 bytes = 10 MB of chunk cache,
+   a static arena in game.c (game_render only gets a const GameState, and
+   the cache fills in as it draws).
+
+   JS analogy: an offscreen <canvas> per chunk, drawn once, then
+     ctx.drawImage(chunkCanvas, sx, 0, w, 64, dx, laneY, w, 64);        */
+#define LANE_STRIP_PX     (LANE_PATTERN_LEN * TILE_PX)     /* 4096 px    */
+
 /* ══════ GAME_PHASE ═════════════════════════════════════════════════════════
 
    Replaces the reference's single `int dead` flag with a proper enum.
@@ -210,8 +237,6 @@ typedef struct {
    • frog_x, frog_y: frog tile position (float so river drift is smooth).
    • time:           accumulated game time for lane_scroll calculations.
    • dead_timer:     countdown for death flash (decrements in PHASE_DEAD).
-   • danger[]:       flat 2D collision grid — 1 = unsafe, 0 = safe.
-                     Rebuilt every frame in game_update, matched to render.
    • sprites:        all sprite sheets packed into a fixed pool.
    • audio:          procedural SFX mixer state.
    • score:          incremented on each successful hop; preserved on death.
@@ -228,11 +253,6 @@ typedef struct {
     int        lives;
     int        best_score;  /* must save/restore across game_init() memset */
 
-    /* Flat 2D danger buffer: danger[row * SCREEN_CELLS_W + col]
-       Written and read within the same game_update() call — always
-       consistent with what game_render() will draw.                       */
-    uint8_t    danger[SCREEN_CELLS_W * SCREEN_CELLS_H];
-
     SpriteBank sprites;
     GameAudioState audio;
 
@@ -243,7 +263,7 @@ typedef struct {
 /* ══════ lane_scroll ════════════════════════════════════════════════════════
  *
  * Pixel-accurate scroll position for a lane.  Used by BOTH game_update
- * (danger buffer write) and game_render (sprite draw) so the collision grid
+ * (danger tile test) and game_render (lane draw) so the collision grid
  * is always consistent with what the player sees on screen.
  *
  * THE BUG THIS FIXES (sub-tile jumping):
@@ -79,7 +79,9 @@ typedef enum {
 /* ══════ Capacity ═══════════════════════════════════════════════════════════
    16 slots: 2 ambient loops + 1 music note + up to 13 simultaneous SFX.
    Frogger rarely fires more than 3 SFX at once, so this is generous.     */
+#ifndef MAX_SIMULTANEOUS_SOUNDS   /* the audio bench builds with 256 */
 #define MAX_SIMULTANEOUS_SOUNDS 16
+#endif
 
 /* ══════ SoundInstance — one actively playing sound ════════════════════════
 
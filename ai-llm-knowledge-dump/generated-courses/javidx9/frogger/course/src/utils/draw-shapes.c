@@ -11,6 +11,7 @@
 
 #include "draw-shapes.h"
 #include <stdint.h>
+#include <string.h> /* memcpy */
 
 /* ══════ draw_rect ══════════════════════════════════════════════════════════
 
@@ -48,6 +49,12 @@ void draw_rect(Backbuffer *bb, int x, int y, int w, int h, uint32_t color) {
      B = bits 16–23
      A = bits 24–31 (high byte)
 
+   R and B are 16 bits apart, so masked with 0x00FF00FF each sits in its
+   own 16-bit lane and one multiply blends both (a lane peaks at 65025, no
+   carry).  The /255 is  (t + (t >> 8)) >> 8  with t = v + 1 — exact for
+   every v up to 65025, so the pixels are unchanged and the loop is
+   integer multiplies and shifts only (no divide: cheap on small ARM).
+
    JS equivalent:
      ctx.globalAlpha = alpha / 255;
      ctx.fillRect(x, y, w, h);
@@ -58,27 +65,26 @@ void draw_rect_blend(Backbuffer *bb, int x, int y, int w, int h, uint32_t color)
     int x1 = (x + w > bb->width)  ? bb->width  : x + w;
     int y1 = (y + h > bb->height) ? bb->height : y + h;
 
-    /* Extract source channels from GAME_RGBA (R=low byte, A=high byte)  */
-    uint8_t sa = (uint8_t)((color >> 24) & 0xFF);
-    uint8_t sb = (uint8_t)((color >> 16) & 0xFF);
-    uint8_t sg = (uint8_t)((color >>  8) & 0xFF);
-    uint8_t sr = (uint8_t)( color        & 0xFF);
+    /* Source side of the blend, once: R and B together, then G (+1: see above) */
+    uint32_t sa     = (color >> 24) & 0xFF;
+    uint32_t inv_a  = 255 - sa;
+    uint32_t src_rb = (color & 0x00FF00FF) * sa + 0x00010001;
+    uint32_t src_g  = ((color >> 8) & 0xFF) * sa + 1;
 
     int row, col;
     int stride = bb->pitch / 4;
     for (row = y0; row < y1; row++) {
+        uint32_t *line = bb->pixels + row * stride;
         for (col = x0; col < x1; col++) {
-            uint32_t dst = bb->pixels[row * stride + col];
-            uint8_t db = (uint8_t)((dst >> 16) & 0xFF);
-            uint8_t dg = (uint8_t)((dst >>  8) & 0xFF);
-            uint8_t dr = (uint8_t)( dst         & 0xFF);
+            uint32_t dst = line[col];
 
             /* Linear blend: out = (src * a + dst * (255-a)) / 255       */
-            uint8_t or_ = (uint8_t)((sr * sa + dr * (255 - sa)) / 255);
-            uint8_t og  = (uint8_t)((sg * sa + dg * (255 - sa)) / 255);
-            uint8_t ob  = (uint8_t)((sb * sa + db * (255 - sa)) / 255);
+            uint32_t rb = src_rb + (dst & 0x00FF00FF) * inv_a;
+            uint32_t g  = src_g  + ((dst >> 8) & 0xFF) * inv_a;
+            rb = ((rb + ((rb >> 8) & 0x00FF00FF)) >> 8) & 0x00FF00FF;
+            g  = ((g  + (g >> 8)) >> 8) & 0xFF;
 
-            bb->pixels[row * stride + col] = GAME_RGB(or_, og, ob);
+            line[col] = 0xFF000000u | rb | (g << 8);
         }
     }
 }
@@ -103,7 +109,15 @@ void draw_rect_blend(Backbuffer *bb, int x, int y, int w, int h, uint32_t color)
 
    CELL_PX EXPANSION:
      Each source "cell" is CELL_PX × CELL_PX pixels (8×8).  So src_w=8 cells
-     → 64 pixels wide in the backbuffer.                                  */
+     → 64 pixels wide in the backbuffer.
+
+   SPANS (the alpha-test fast path):
+     Cells are solid or transparent — there is no partial alpha — so each
+     cell row is a few runs ("spans") of solid cells.  Clipping is done
+     once per cell row and once per span, never per pixel; a cell row that
+     is off-screen is skipped outright.  The first visible pixel row of a
+     span is filled cell by cell (one color per cell), and the other
+     CELL_PX-1 rows are identical, so they are memcpy'd from it.       */
 void draw_sprite_partial(
     Backbuffer *bb,
     const int16_t *colors,
@@ -113,34 +127,52 @@ void draw_sprite_partial(
     int src_x, int src_y, int src_w, int src_h,
     int dest_px_x, int dest_px_y)
 {
-    int sy, sx, py, px;
+    int sy, sx, px, by;
     int stride = bb->pitch / 4;
 
     for (sy = 0; sy < src_h; sy++) {
-        for (sx = 0; sx < src_w; sx++) {
-            int idx    = (src_y + sy) * sheet_w + (src_x + sx);
-            int16_t gl = glyphs[idx];
-            if (gl == 0x0020) continue;  /* transparent cell — skip */
-
-            int16_t c  = colors[idx];
-            int ci     = c & 0x0F;       /* low nibble = FG color index */
-
-            /* Map 4-bit Windows console index → GAME_RGBA via CONSOLE_PALETTE */
-            uint32_t color = GAME_RGB(
-                palette[ci][0],
-                palette[ci][1],
-                palette[ci][2]);
-
-            /* Each cell expands to CELL_PX × CELL_PX pixels in the backbuffer */
-            for (py = 0; py < CELL_PX; py++) {
-                for (px = 0; px < CELL_PX; px++) {
-                    int bx = dest_px_x + sx * CELL_PX + px;
-                    int by = dest_px_y + sy * CELL_PX + py;
-                    if (bx >= 0 && bx < bb->width &&
-                        by >= 0 && by < bb->height)
-                        bb->pixels[by * stride + bx] = color;
-                }
+        /* Row early-out: this cell row's pixel rows, clipped */
+        int y0 = dest_px_y + sy * CELL_PX;
+        int y1 = y0 + CELL_PX;
+        if (y0 < 0) y0 = 0;
+        if (y1 > bb->height) y1 = bb->height;
+        if (y0 >= y1) continue;
+
+        const int16_t *gl_row = glyphs + (src_y + sy) * sheet_w + src_x;
+        const int16_t *co_row = colors + (src_y + sy) * sheet_w + src_x;
+        uint32_t *first = bb->pixels + y0 * stride;
+
+        sx = 0;
+        while (sx < src_w) {
+            /* Skip transparent cells (glyph 0x0020) to the next span */
+            while (sx < src_w && gl_row[sx] == 0x0020) sx++;
+            if (sx == src_w) break;
+
+            int span_sx = sx;
+            for (; sx < src_w && gl_row[sx] != 0x0020; sx++) {
+                int ci = co_row[sx] & 0x0F;  /* low nibble = FG color index */
+
+                /* Map 4-bit Windows console index → GAME_RGBA via CONSOLE_PALETTE */
+                uint32_t color = GAME_RGB(palette[ci][0],
+                                          palette[ci][1],
+                                          palette[ci][2]);
+
+                int x0 = dest_px_x + sx * CELL_PX;
+                int x1 = x0 + CELL_PX;
+                if (x0 < 0) x0 = 0;
+                if (x1 > bb->width) x1 = bb->width;
+                for (px = x0; px < x1; px++) first[px] = color;
             }
+
+            /* Copy the span's finished first row down the cell row */
+            int x0 = dest_px_x + span_sx * CELL_PX;
+            int x1 = dest_px_x + sx * CELL_PX;
+            if (x0 < 0) x0 = 0;
+            if (x1 > bb->width) x1 = bb->width;
+            if (x0 >= x1) continue;
+            for (by = y0 + 1; by < y1; by++)
+                memcpy(bb->pixels + by * stride + x0, first + x0,
+                       (size_t)(x1 - x0) * sizeof(uint32_t));
         }
     }
 }
@@ -79,6 +79,14 @@ void draw_rect(SnakeBackbuffer *bb, int x, int y, int w, int h, uint32_t color)
  *   Floating-point division in a per-pixel loop adds up.  Integer arithmetic
  *   is faster and the /255 loss of precision is imperceptible at 8-bit colour.
  *
+ * TWO CHANNELS PER MULTIPLY
+ *   R and B sit 16 bits apart: masked with 0x00FF00FF each has its own
+ *   16-bit lane, so one 32-bit multiply blends both (a channel peaks at
+ *   255 × 255 = 65025 — it never carries into the next lane).  And the
+ *   divide goes too:  v / 255 == (t + (t >> 8)) >> 8  with t = v + 1,
+ *   exactly, for every v up to 65025.  Same pixels, no division — which
+ *   matters most on ARM boards with no FPU and a slow (or no) divider.
+ *
  * OPTIMISATION — early exit for opaque/transparent
  *   alpha == 255: fully opaque — delegate to draw_rect (no blending needed).
  *   alpha ==   0: fully transparent — nothing to draw.
@@ -98,12 +106,11 @@ void draw_rect_blend(SnakeBackbuffer *bb, int x, int y, int w, int h, uint32_t c
     /* Fast path: fully transparent — nothing to draw */
     if (alpha == 0) return;
 
-    /* Extract source RGB channels.
+    /* Source side of the blend, the same for every pixel: do it once.
      * With GAME_RGBA storing 0xAABBGGRR:  R = bits 0-7, G = bits 8-15, B = bits 16-23 */
-    int src_r = (int)( color        & 0xFF);  /* R in low byte   */
-    int src_g = (int)((color >>  8) & 0xFF);  /* G in next byte  */
-    int src_b = (int)((color >> 16) & 0xFF);  /* B in high byte  */
-    int inv_a = 255 - alpha;  /* complement: weight of the destination */
+    uint32_t inv_a  = (uint32_t)(255 - alpha);  /* complement: weight of the destination */
+    uint32_t src_rb = (color & 0x00FF00FF) * (uint32_t)alpha + 0x00010001;  /* R, B (+1) */
+    uint32_t src_g  = ((color >> 8) & 0xFF) * (uint32_t)alpha + 1;         /* G    (+1) */
 
     /* Clip to buffer bounds (same as draw_rect) */
     int x0 = x < 0       ? 0          : x;
@@ -113,21 +120,18 @@ void draw_rect_blend(SnakeBackbuffer *bb, int x, int y, int w, int h, uint32_t c
 
     int px, py;
     for (py = y0; py < y1; py++) {
+        uint32_t *row = &bb->pixels[py * (bb->pitch / 4)];
         for (px = x0; px < x1; px++) {
-            uint32_t *dst = &bb->pixels[py * (bb->pitch / 4) + px];
-
-            /* Read destination pixel channels (same layout: R=bits 0-7, G=8-15, B=16-23) */
-            int dst_r = (int)( *dst        & 0xFF);
-            int dst_g = (int)((*dst >>  8) & 0xFF);
-            int dst_b = (int)((*dst >> 16) & 0xFF);
+            uint32_t dst = row[px];
 
-            /* Blend: out = (src * a + dst * (255-a)) / 255 */
-            int out_r = (src_r * alpha + dst_r * inv_a) / 255;
-            int out_g = (src_g * alpha + dst_g * inv_a) / 255;
-            int out_b = (src_b * alpha + dst_b * inv_a) / 255;
+            /* Blend: out = (src * a + dst * (255-a)) / 255, R and B together */
+            uint32_t rb = src_rb + (dst & 0x00FF00FF) * inv_a;
+            uint32_t g  = src_g  + ((dst >> 8) & 0xFF) * inv_a;
+            rb = ((rb + ((rb >> 8) & 0x00FF00FF)) >> 8) & 0x00FF00FF;
+            g  = ((g  + (g >> 8)) >> 8) & 0xFF;
 
             /* Write back as fully-opaque packed pixel */
-            *dst = GAME_RGB(out_r, out_g, out_b);
+            row[px] = 0xFF000000u | rb | (g << 8);
         }
     }
 }
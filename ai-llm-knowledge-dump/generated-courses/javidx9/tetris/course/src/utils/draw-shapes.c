@@ -117,17 +117,23 @@ void draw_rect_blend(Backbuffer *bb, int x, int y, int w, int h,
   if (alpha == 0)
     return;
 
-  /* ── Step 2: Extract Source RGB ─────────────────────────────────────────
+  /* ── Step 2: Pre-multiply the Source ───────────────────────────────────
    *
-   * Same shift-and-mask pattern for red, green, blue.
+   * src * alpha is the same for every pixel, so it is done once here.
    *
-   * JS: const src_r = (color >>> 16) & 0xFF;
-   * JS: const src_g = (color >>>  8) & 0xFF;
-   * JS: const src_b =  color         & 0xFF;
+   * TWO CHANNELS IN ONE MULTIPLY: R (bits 23-16) and B (bits 7-0) are 16
+   * bits apart.  Masking with 0x00FF00FF leaves each alone in a 16-bit
+   * "lane", and one 32-bit multiply scales both.  A lane never exceeds
+   * 255 * 255 = 65025, which fits in 16 bits, so R never spills into B's
+   * lane.  G gets its own multiply.
+   *
+   * The +1 in each lane is part of the divide-free /255 in Step 4.
+   *
+   * JS: const srcRB = (color & 0x00FF00FF) * alpha + 0x00010001;
    */
-  uint8_t src_r = (color >> 16) & 0xFF; /* bits 23-16 */
-  uint8_t src_g = (color >>  8) & 0xFF; /* bits 15-8  */
-  uint8_t src_b =  color        & 0xFF; /* bits  7-0  */
+  uint32_t inv_alpha = 255u - alpha;
+  uint32_t src_rb = (color & 0x00FF00FFu) * alpha + 0x00010001u;
+  uint32_t src_g = ((color >> 8) & 0xFFu) * alpha + 1u;
 
   /* ── Step 3: Clip ───────────────────────────────────────────────────────
    * Same clipping logic as draw_rect — see comments there. */
@@ -150,11 +156,6 @@ void draw_rect_blend(Backbuffer *bb, int x, int y, int w, int h,
       /* Read the existing destination pixel. */
       uint32_t dst = row[px];
 
-      /* Extract destination RGB channels using the same shift-and-mask. */
-      uint8_t dst_r = (dst >> 16) & 0xFF;
-      uint8_t dst_g = (dst >>  8) & 0xFF;
-      uint8_t dst_b =  dst        & 0xFF;
-
       /* ── Alpha Blending Formula ────────────────────────────────────────
        *
        * Standard "source over" alpha composite (Porter-Duff SRC_OVER):
@@ -166,30 +167,31 @@ void draw_rect_blend(Backbuffer *bb, int x, int y, int w, int h,
        *   - alpha = 0    (transparent):  out = (src*0 + dst*255) / 255 = dst
        *   - alpha = 128  (50% blend):    out = (src*128 + dst*127) / 255
        *     → roughly 50% source + 50% destination
-       *   - alpha = 64   (75% transparent):
-       *     out = (src*64 + dst*191) / 255 → ~25% src, ~75% dst
        *
        * WHY DIVIDE BY 255 (not 256)?
        *   We work in the 0-255 range. Dividing by 255 keeps the result in
        *   0-255. If we divided by 256 (bit-shift >>8) we'd slightly darken
        *   fully opaque colors (255*255/256 = 254 instead of 255).
        *
+       * DIVIDING BY 255 WITHOUT A DIVIDE:
+       *   For every v from 0 to 65025,  v / 255 == (t + (t >> 8)) >> 8
+       *   where t = v + 1 (the +1 was added in Step 2).  Same result as the
+       *   division, bit for bit, using only an add and two shifts — and it
+       *   works on both 16-bit lanes of `rb` at once.  On small ARM boards
+       *   with no FPU and a slow divider this is the whole cost of the loop.
+       *
        * JS equivalent:
        *   const outR = Math.floor((srcR * alpha + dstR * (255 - alpha)) / 255);
-       *
-       * NOTE: The intermediate products (e.g. src_r * alpha) can be up to
-       * 255 * 255 = 65025, which fits in a uint32_t (max ~4.3 billion) but
-       * NOT in a uint8_t. C automatically promotes uint8_t operands to int in
-       * arithmetic expressions — this is safe here but worth knowing.
        */
-      uint8_t out_r = (uint8_t)((src_r * alpha + dst_r * (255 - alpha)) / 255);
-      uint8_t out_g = (uint8_t)((src_g * alpha + dst_g * (255 - alpha)) / 255);
-      uint8_t out_b = (uint8_t)((src_b * alpha + dst_b * (255 - alpha)) / 255);
+      uint32_t rb = src_rb + (dst & 0x00FF00FFu) * inv_alpha;
+      uint32_t g = src_g + ((dst >> 8) & 0xFFu) * inv_alpha;
+      rb = ((rb + ((rb >> 8) & 0x00FF00FFu)) >> 8) & 0x00FF00FFu;
+      g = ((g + (g >> 8)) >> 8) & 0xFFu;
 
       /* Pack the blended channels back into a uint32 and write to the buffer.
        * Alpha is forced to 255 (fully opaque) since we've already applied the
        * transparency — the resulting pixel in the backbuffer is always opaque. */
-      row[px] = GAME_RGB(out_r, out_g, out_b);
+      row[px] = 0xFF000000u | rb | (g << 8);
     }
   }
 }
@@ -57,6 +57,7 @@
 #if !defined(DE100_NO_ASSERTS)
 #include <stdio.h>
 
+#ifndef ASSERT /* a host that brings its own ASSERT keeps it */
 #define ASSERT(expr)                                                           \
   do {                                                                         \
     if (!(expr)) {                                                             \
@@ -71,6 +72,7 @@
       DEBUG_BREAK();                                                           \
     }                                                                          \
   } while (0)
+#endif
 
 #define ASSERT_MSG(expr, fmt, ...)                                             \
   do {                                                                         \
@@ -89,7 +91,9 @@
   } while (0)
 
 #else
+#ifndef ASSERT
 #define ASSERT(expr) ((void)0)
+#endif
 #define ASSERT_MSG(e, msg) ((void)0)
 #endif /* NDEBUG */
 
@@ -0,0 +1,255 @@
+#include "compression.h"
+
+#include <string.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ERROR MESSAGES
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_global_var const char *g_compress_error_messages[] = {
+    [DE100_COMPRESS_SUCCESS] = "Success",
+    [DE100_COMPRESS_ERROR_NULL_POINTER] = "NULL source or destination",
+    [DE100_COMPRESS_ERROR_OUTPUT_TOO_SMALL] = "Destination buffer too small",
+    [DE100_COMPRESS_ERROR_CORRUPT_INPUT] = "Compressed data is corrupt",
+};
+
+const char *de100_compress_strerror(De100CompressErrorCode code) {
+  if (code >= 0 && code < DE100_COMPRESS_ERROR_COUNT) {
+    return g_compress_error_messages[code];
+  }
+  return "Unknown compression error";
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// INTERNAL HELPERS
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define LZ_HASH_BITS 12
+#define LZ_HASH_SIZE (1u << LZ_HASH_BITS)
+#define LZ_NO_POSITION 0xFFFFFFFFu
+
+de100_file_scoped_fn inline u32 lz_read32(const u8 *p) {
+  u32 value;
+  memcpy(&value, p, sizeof(value)); // Unaligned-safe, compiles to one load
+  return value;
+}
+
+de100_file_scoped_fn inline u32 lz_hash(u32 value) {
+  return (value * 2654435761u) >> (32 - LZ_HASH_BITS);
+}
+
+de100_file_scoped_fn inline De100CompressResult
+make_result(bool success, De100CompressErrorCode code, size_t size) {
+  return (De100CompressResult){
+      .success = success, .error_code = code, .size = size};
+}
+
+/**
+ * Write a length that didn't fit in its nibble: runs of 255, then the rest.
+ */
+de100_file_scoped_fn inline u8 *lz_write_length(u8 *op, size_t length) {
+  while (length >= 255) {
+    *op++ = 255;
+    length -= 255;
+  }
+  *op++ = (u8)length;
+  return op;
+}
+
+/**
+ * Emit one sequence. match_length == 0 means "literals only" (last one).
+ * Returns NULL if the sequence would not fit.
+ */
+de100_file_scoped_fn u8 *lz_emit_sequence(u8 *op, u8 *op_end,
+                                          const u8 *literals,
+                                          size_t literal_length, u32 offset,
+                                          size_t match_length) {
+  size_t needed = 1 + literal_length / 255 + 1 + literal_length + 2 +
+                  match_length / 255 + 1;
+  if ((size_t)(op_end - op) < needed) {
+    return NULL;
+  }
+
+  u8 *token = op++;
+  *token = 0;
+
+  if (literal_length >= 15) {
+    *token = 15 << 4;
+    op = lz_write_length(op, literal_length - 15);
+  } else {
+    *token = (u8)(literal_length << 4);
+  }
+
+  memcpy(op, literals, literal_length);
+  op += literal_length;
+
+  if (match_length == 0) {
+    return op;
+  }
+
+  *op++ = (u8)(offset & 0xFF);
+  *op++ = (u8)(offset >> 8);
+
+  size_t encoded_match = match_length - DE100_LZ_MIN_MATCH;
+  if (encoded_match >= 15) {
+    *token |= 15;
+    op = lz_write_length(op, encoded_match - 15);
+  } else {
+    *token |= (u8)encoded_match;
+  }
+
+  return op;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// COMPRESS
+// ═══════════════════════════════════════════════════════════════════════════
+
+size_t de100_lz_compress_bound(size_t size) { return size + size / 255 + 16; }
+
+De100CompressResult de100_lz_compress(const void *src, size_t src_size,
+                                      void *dst, size_t dst_capacity) {
+  if (!src || !dst) {
+    return make_result(false, DE100_COMPRESS_ERROR_NULL_POINTER, 0);
+  }
+
+  const u8 *in = (const u8 *)src;
+  u8 *op = (u8 *)dst;
+  u8 *op_end = op + dst_capacity;
+
+  // 16KB of positions; small enough for the stack of any thread
+  u32 table[LZ_HASH_SIZE];
+  for (u32 i = 0; i < LZ_HASH_SIZE; ++i) {
+    table[i] = LZ_NO_POSITION;
+  }
+
+  size_t ip = 0;
+  size_t anchor = 0;
+  u32 misses = 0;
+
+  while (ip + DE100_LZ_MIN_MATCH <= src_size) {
+    u32 sequence = lz_read32(in + ip);
+    u32 hash = lz_hash(sequence);
+    u32 ref = table[hash];
+    table[hash] = (u32)ip;
+
+    if (ref == LZ_NO_POSITION || ip - ref > DE100_LZ_MAX_OFFSET ||
+        lz_read32(in + ref) != sequence) {
+      // Skip faster through incompressible data, like LZ4's acceleration
+      ip += 1 + (misses++ >> 6);
+      continue;
+    }
+    misses = 0;
+
+    size_t match_length = DE100_LZ_MIN_MATCH;
+    while (ip + match_length < src_size &&
+           in[ref + match_length] == in[ip + match_length]) {
+      ++match_length;
+    }
+
+    op = lz_emit_sequence(op, op_end, in + anchor, ip - anchor,
+                          (u32)(ip - ref), match_length);
+    if (!op) {
+      return make_result(false, DE100_COMPRESS_ERROR_OUTPUT_TOO_SMALL, 0);
+    }
+
+    ip += match_length;
+    anchor = ip;
+  }
+
+  op = lz_emit_sequence(op, op_end, in + anchor, src_size - anchor, 0, 0);
+  if (!op) {
+    return make_result(false, DE100_COMPRESS_ERROR_OUTPUT_TOO_SMALL, 0);
+  }
+
+  return make_result(true, DE100_COMPRESS_SUCCESS, (size_t)(op - (u8 *)dst));
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// DECOMPRESS
+// ═══════════════════════════════════════════════════════════════════════════
+
+De100CompressResult de100_lz_decompress(const void *src, size_t src_size,
+                                        void *dst, size_t dst_capacity) {
+  if (!src || !dst) {
+    return make_result(false, DE100_COMPRESS_ERROR_NULL_POINTER, 0);
+  }
+
+  const u8 *ip = (const u8 *)src;
+  const u8 *ip_end = ip + src_size;
+  u8 *out = (u8 *)dst;
+  size_t op = 0;
+
+  while (ip < ip_end) {
+    u8 token = *ip++;
+
+    // ─────────────────────────────────────────────────────────────────
+    // Literals
+    // ─────────────────────────────────────────────────────────────────
+    size_t literal_length = token >> 4;
+    if (literal_length == 15) {
+      u8 byte;
+      do {
+        if (ip >= ip_end) {
+          return make_result(false, DE100_COMPRESS_ERROR_CORRUPT_INPUT, op);
+        }
+        byte = *ip++;
+        literal_length += byte;
+      } while (byte == 255);
+    }
+
+    if ((size_t)(ip_end - ip) < literal_length ||
+        dst_capacity - op < literal_length) {
+      return make_result(false, DE100_COMPRESS_ERROR_CORRUPT_INPUT, op);
+    }
+    memcpy(out + op, ip, literal_length);
+    ip += literal_length;
+    op += literal_length;
+
+    if (ip == ip_end) {
+      break; // Last sequence: literals only
+    }
+
+    // ─────────────────────────────────────────────────────────────────
+    // Match
+    // ─────────────────────────────────────────────────────────────────
+    if (ip_end - ip < 2) {
+      return make_result(false, DE100_COMPRESS_ERROR_CORRUPT_INPUT, op);
+    }
+    size_t offset = (size_t)ip[0] | ((size_t)ip[1] << 8);
+    ip += 2;
+    if (offset == 0 || offset > op) {
+      return make_result(false, DE100_COMPRESS_ERROR_CORRUPT_INPUT, op);
+    }
+
+    size_t match_length = token & 15;
+    if (match_length == 15) {
+      u8 byte;
+      do {
+        if (ip >= ip_end) {
+          return make_result(false, DE100_COMPRESS_ERROR_CORRUPT_INPUT, op);
+        }
+        byte = *ip++;
+        match_length += byte;
+      } while (byte == 255);
+    }
+    match_length += DE100_LZ_MIN_MATCH;
+
+    if (dst_capacity - op < match_length) {
+      return make_result(false, DE100_COMPRESS_ERROR_OUTPUT_TOO_SMALL, op);
+    }
+
+    const u8 *match = out + op - offset;
+    if (offset >= match_length) {
+      memcpy(out + op, match, match_length);
+    } else {
+      // Overlapping copy replicates the pattern (e.g. zero runs)
+      for (size_t i = 0; i < match_length; ++i) {
+        out[op + i] = match[i];
+      }
+    }
+    op += match_length;
+  }
+
+  return make_result(true, DE100_COMPRESS_SUCCESS, op);
+}
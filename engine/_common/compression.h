@@ -0,0 +1,88 @@
+#ifndef DE100_COMMON_COMPRESSION_H
+#define DE100_COMMON_COMPRESSION_H
+
+#include "base.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// BLOCK COMPRESSION (LZ4-style, dependency-free)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// Byte-oriented LZ77 in the LZ4 sequence layout:
+//
+//   [token][literal length ext...][literals][offset u16][match length ext...]
+//    └─ high nibble = literal length, low nibble = match length - 4
+//       (15 means "more length bytes follow", each 255 = keep going)
+//
+// The last sequence has literals only. Offsets reach back up to 64KB, so a
+// run of zeros compresses to ~1 byte per 255 (offset 1, overlapping copy).
+//
+// Fast, not dense: meant for replay snapshots and input streams, where most
+// of the data is zero pages or near-identical frames.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define DE100_LZ_MIN_MATCH 4
+#define DE100_LZ_MAX_OFFSET 65535
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ERROR CODES
+// ═══════════════════════════════════════════════════════════════════════════
+
+typedef enum {
+  DE100_COMPRESS_SUCCESS = 0,
+  DE100_COMPRESS_ERROR_NULL_POINTER,
+  DE100_COMPRESS_ERROR_OUTPUT_TOO_SMALL,
+  DE100_COMPRESS_ERROR_CORRUPT_INPUT,
+
+  DE100_COMPRESS_ERROR_COUNT
+} De100CompressErrorCode;
+
+// ═══════════════════════════════════════════════════════════════════════════
+// RESULT STRUCTURES
+// ═══════════════════════════════════════════════════════════════════════════
+
+typedef struct {
+  bool success;
+  De100CompressErrorCode error_code;
+  size_t size; // Bytes written to the destination
+} De100CompressResult;
+
+// ═══════════════════════════════════════════════════════════════════════════
+// API FUNCTIONS
+// ═══════════════════════════════════════════════════════════════════════════
+
+/**
+ * Worst-case compressed size for `size` input bytes (incompressible data).
+ */
+size_t de100_lz_compress_bound(size_t size);
+
+/**
+ * Compress one block.
+ *
+ * @param src           Input bytes
+ * @param src_size      Input size
+ * @param dst           Output buffer
+ * @param dst_capacity  Output capacity (de100_lz_compress_bound() is always
+ *                      enough)
+ * @return              Result with compressed size
+ */
+De100CompressResult de100_lz_compress(const void *src, size_t src_size,
+                                      void *dst, size_t dst_capacity);
+
+/**
+ * Decompress one block. Fully bounds-checked against both buffers.
+ *
+ * @param src           Compressed bytes
+ * @param src_size      Compressed size
+ * @param dst           Output buffer
+ * @param dst_capacity  Output capacity (the original size)
+ * @return              Result with decompressed size
+ */
+De100CompressResult de100_lz_decompress(const void *src, size_t src_size,
+                                        void *dst, size_t dst_capacity);
+
+const char *de100_compress_strerror(De100CompressErrorCode code);
+
+#endif // DE100_COMMON_COMPRESSION_H
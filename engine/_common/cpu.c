@@ -0,0 +1,86 @@
+#include "cpu.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// FEATURE NAMES
+// ═══════════════════════════════════════════════════════════════════════════
+
+typedef struct {
+  u32 feature;
+  const char *name;
+} CpuFeatureName;
+
+de100_file_scoped_global_var const CpuFeatureName g_cpu_feature_names[] = {
+    {DE100_CPU_FEATURE_SSE2, "sse2"},     {DE100_CPU_FEATURE_SSE41, "sse4.1"},
+    {DE100_CPU_FEATURE_AVX2, "avx2"},     {DE100_CPU_FEATURE_AVX512, "avx512"},
+    {DE100_CPU_FEATURE_NEON, "neon"},
+};
+
+#define CPU_FEATURE_NAME_COUNT                                                 \
+  (sizeof(g_cpu_feature_names) / sizeof(g_cpu_feature_names[0]))
+
+/**
+ * Features named in a DE100_CPU_DISABLE list. Unknown names are ignored.
+ */
+de100_file_scoped_fn u32 parse_disabled(const char *list) {
+  u32 disabled = 0;
+  while (list && *list) {
+    u64 length = strcspn(list, ", ");
+    if (length == 3 && strncmp(list, "all", 3) == 0) {
+      disabled |= DE100_CPU_FEATURE_ALL;
+    }
+    for (u32 i = 0; i < CPU_FEATURE_NAME_COUNT; ++i) {
+      const char *name = g_cpu_feature_names[i].name;
+      if (strlen(name) == length && strncmp(list, name, length) == 0) {
+        disabled |= g_cpu_feature_names[i].feature;
+      }
+    }
+    list += length;
+    list += strspn(list, ", ");
+  }
+  return disabled;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// API
+// ═══════════════════════════════════════════════════════════════════════════
+
+u32 de100_cpu_features(void) {
+  // Bit 31 marks "detected"; racing first calls compute the same value
+  local_persist_var u32 cached = 0;
+  u32 features = __atomic_load_n(&cached, __ATOMIC_ACQUIRE);
+  if (features) {
+    return features & ~(1u << 31);
+  }
+
+  features = de100_cpu_detect() & ~parse_disabled(getenv("DE100_CPU_DISABLE"));
+  __atomic_store_n(&cached, features | (1u << 31), __ATOMIC_RELEASE);
+  return features;
+}
+
+const char *de100_cpu_describe(u32 features, char *buffer, u64 buffer_size) {
+  if (!buffer || buffer_size == 0) {
+    return buffer;
+  }
+  buffer[0] = '\0';
+
+  u64 used = 0;
+  for (u32 i = 0; i < CPU_FEATURE_NAME_COUNT; ++i) {
+    if (!(features & g_cpu_feature_names[i].feature) || used >= buffer_size) {
+      continue;
+    }
+    int written = snprintf(buffer + used, (size_t)(buffer_size - used),
+                           used ? " %s" : "%s", g_cpu_feature_names[i].name);
+    if (written > 0) {
+      used += (u64)written;
+    }
+  }
+
+  if (used == 0) {
+    snprintf(buffer, (size_t)buffer_size, "none");
+  }
+  return buffer;
+}
@@ -0,0 +1,96 @@
+#ifndef DE100_COMMON_CPU_H
+#define DE100_COMMON_CPU_H
+
+#include "base.h"
+
+// ═══════════════════════════════════════════════════════════════════════════
+// CPU FEATURE DETECTION
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// One binary, many machines: SIMD kernels beyond the target's baseline
+// (AVX2, AVX-512 on x86-64) are compiled with a per-function target
+// attribute and only called when the running CPU has them.
+//
+//   u32 features = de100_cpu_features();
+//   if (features & DE100_CPU_FEATURE_AVX2) { ... }
+//
+// de100_cpu_detect() is inline so the game library can ask without
+// engine symbols; de100_cpu_features() (engine) caches the answer and
+// applies DE100_CPU_DISABLE, a comma-separated list of feature names to
+// pretend are missing:
+//
+//   DE100_CPU_DISABLE=avx2,avx512 ./game     # run the SSE2 kernels
+//   DE100_CPU_DISABLE=all ./game             # scalar reference paths
+//
+// The engine picks its kernels from that set once at startup and hands
+// them to the game through GameMemory.kernels (see game/kernels.h).
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+typedef enum {
+  DE100_CPU_FEATURE_SSE2 = 1u << 0,
+  DE100_CPU_FEATURE_SSE41 = 1u << 1,
+  DE100_CPU_FEATURE_AVX2 = 1u << 2,
+  DE100_CPU_FEATURE_AVX512 = 1u << 3, // AVX-512 F + BW
+  DE100_CPU_FEATURE_NEON = 1u << 4,
+} De100CpuFeature;
+
+#define DE100_CPU_FEATURE_ALL                                                  \
+  (DE100_CPU_FEATURE_SSE2 | DE100_CPU_FEATURE_SSE41 |                          \
+   DE100_CPU_FEATURE_AVX2 | DE100_CPU_FEATURE_AVX512 |                         \
+   DE100_CPU_FEATURE_NEON)
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) ||            \
+    defined(_M_IX86)
+#define DE100_CPU_X86 1
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define DE100_TARGET_AVX2 __attribute__((target("avx2")))
+#define DE100_TARGET_AVX512 __attribute__((target("avx512f,avx512bw")))
+#else
+#define DE100_TARGET_AVX2
+#define DE100_TARGET_AVX512
+#endif
+
+/**
+ * Query the running CPU (no caching, no DE100_CPU_DISABLE).
+ */
+de100_file_scoped_fn inline u32 de100_cpu_detect(void) {
+  u32 features = 0;
+#if DE100_CPU_X86 && (defined(__GNUC__) || defined(__clang__))
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("sse2")) {
+    features |= DE100_CPU_FEATURE_SSE2;
+  }
+  if (__builtin_cpu_supports("sse4.1")) {
+    features |= DE100_CPU_FEATURE_SSE41;
+  }
+  if (__builtin_cpu_supports("avx2")) {
+    features |= DE100_CPU_FEATURE_AVX2;
+  }
+  if (__builtin_cpu_supports("avx512f") &&
+      __builtin_cpu_supports("avx512bw")) {
+    features |= DE100_CPU_FEATURE_AVX512;
+  }
+#elif DE100_CPU_X86
+  features |= DE100_CPU_FEATURE_SSE2; // x86-64 baseline
+#elif defined(__ARM_NEON) || defined(__aarch64__)
+  features |= DE100_CPU_FEATURE_NEON; // Baseline on AArch64
+#endif
+  return features;
+}
+
+/**
+ * Detected features minus DE100_CPU_DISABLE. Detected once; thread-safe.
+ */
+u32 de100_cpu_features(void);
+
+/**
+ * Space-separated feature names ("sse2 sse4.1 avx2"), or "none".
+ *
+ * @return buffer
+ */
+const char *de100_cpu_describe(u32 features, char *buffer, u64 buffer_size);
+
+#endif // DE100_COMMON_CPU_H
@@ -143,43 +143,33 @@ de100_debug_read_entire_file(const char *filename) {
   }
 
   // ─────────────────────────────────────────────────────────────────────
-  // Check if file exists using file.h API
+  // Existence and size in one stat, using file.h API
   // ─────────────────────────────────────────────────────────────────────
-  De100FileExistsResult exists_result = de100_file_exists(filename);
-  if (!exists_result.success) {
-    SET_ERROR_DETAIL("[debug_read] de100_file_exists() failed for '%s': %s",
-                     filename, de100_file_strerror(exists_result.error_code));
+  De100FileStatResult stat_result = de100_file_stat(filename);
+  if (!stat_result.success) {
+    SET_ERROR_DETAIL("[debug_read] de100_file_stat() failed for '%s': %s",
+                     filename, de100_file_strerror(stat_result.error_code));
     return make_read_error(DEBUG_DE100_FILE_ERROR_NOT_FOUND);
   }
 
-  if (!exists_result.exists) {
+  if (!stat_result.exists || stat_result.is_directory) {
     SET_ERROR_DETAIL("[debug_read] File not found: '%s'", filename);
     return make_read_error(DEBUG_DE100_FILE_ERROR_NOT_FOUND);
   }
 
-  // ─────────────────────────────────────────────────────────────────────
-  // Get file size using file.h API
-  // ─────────────────────────────────────────────────────────────────────
-  De100FileSizeResult size_result = de100_file_get_size(filename);
-  if (!size_result.success) {
-    SET_ERROR_DETAIL("[debug_read] de100_file_get_size() failed for '%s': %s",
-                     filename, de100_file_strerror(size_result.error_code));
-    return make_read_error(DEBUG_DE100_FILE_ERROR_READ_FAILED);
-  }
-
-  if (size_result.value <= 0) {
+  if (stat_result.size <= 0) {
     SET_ERROR_DETAIL("[debug_read] File is empty: '%s'", filename);
     return make_read_error(DEBUG_DE100_FILE_ERROR_EMPTY_FILE);
   }
 
   // Check for 32-bit overflow (debug I/O limited to 4GB)
-  if (size_result.value > (i64)0xFFFFFFFF) {
+  if (stat_result.size > (i64)0xFFFFFFFF) {
     SET_ERROR_DETAIL("[debug_read] File too large: '%s' (%lld bytes, max 4GB)",
-                     filename, (long long)size_result.value);
+                     filename, (long long)stat_result.size);
     return make_read_error(DEBUG_DE100_FILE_ERROR_TOO_LARGE);
   }
 
-  size_t de100_file_size = (size_t)size_result.value;
+  size_t de100_file_size = (size_t)stat_result.size;
 
   // ─────────────────────────────────────────────────────────────────────
   // Allocate memory using memory.h API
@@ -16,7 +16,7 @@
 //   - Hot reload file checks
 //
 // This module uses the common APIs:
-//   - file.h: de100_file_exists(), de100_file_get_size(), de100_file_strerror()
+//   - file.h: de100_file_stat(), de100_file_strerror()
 //   - memory.h: de100_memory_alloc(), de100_memory_free(),
 //   de100_memory_error_str()
 //
@@ -73,7 +73,7 @@ typedef struct {
 /**
  * Read an entire file into memory.
  *
- * Uses de100_file_get_size() to determine size, then allocates via
+ * Uses de100_file_stat() to determine size, then allocates via
  * de100_memory_alloc().
  *
  * @param filename Path to the file to read
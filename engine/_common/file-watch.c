@@ -0,0 +1,344 @@
+#include "file-watch.h"
+#include "file.h"
+#include "memory.h"
+#include "path.h"
+#include "time.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// PLATFORM-SPECIFIC INCLUDES
+// ═══════════════════════════════════════════════════════════════════════════
+
+#if defined(__linux__)
+#include <errno.h>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#elif defined(__APPLE__) || defined(__FreeBSD__) || defined(__OpenBSD__) ||    \
+    defined(__NetBSD__)
+#include <fcntl.h>
+#include <sys/event.h>
+#include <unistd.h>
+#define DE100_FILE_WATCH_KQUEUE 1
+#elif defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#endif
+
+// ═══════════════════════════════════════════════════════════════════════════
+// WATCH STATE
+// ═══════════════════════════════════════════════════════════════════════════
+
+struct De100FileWatch {
+  De100MemoryBlock memory; // Backing block of this struct
+  pthread_t thread;
+
+  char path[DE100_MAX_PATH_LENGTH];
+  char directory[DE100_MAX_PATH_LENGTH];
+  const char *name; // Points into path
+
+#if defined(__linux__)
+  int inotify_fd;
+#elif DE100_FILE_WATCH_KQUEUE
+  int kqueue_fd;
+  int directory_fd;
+#elif defined(_WIN32)
+  HANDLE change_handle;
+#endif
+
+  // Thread → frame (atomics)
+  bool running;
+  u32 change_count;
+  i64 last_change_us; // de100_get_wall_clock(), microseconds
+
+  // Frame side only
+  u32 consumed_count;
+
+  // Thread side only (backends without per-name events)
+  De100TimeSpec last_mod_time;
+};
+
+de100_file_scoped_fn inline De100FileWatchResult
+file_watch_result(De100FileWatchErrorCode code) {
+  return (De100FileWatchResult){.success = code == DE100_FILE_WATCH_SUCCESS,
+                                .error_code = code};
+}
+
+de100_file_scoped_fn inline void file_watch_signal(De100FileWatch *watch) {
+  i64 now_us = (i64)(de100_get_wall_clock() * 1000000.0);
+  __atomic_store_n(&watch->last_change_us, now_us, __ATOMIC_RELAXED);
+  __atomic_add_fetch(&watch->change_count, 1, __ATOMIC_RELEASE);
+}
+
+// Directory-level backends: count it only if the file itself moved on
+de100_file_scoped_fn inline void
+file_watch_check_mod_time(De100FileWatch *watch) {
+  De100FileTimeResult mod_time = de100_file_get_mod_time(watch->path);
+  if (!mod_time.success) {
+    return; // Mid-replace; the write that recreates it signals again
+  }
+  if (de100_timespec_diff_seconds(&watch->last_mod_time, &mod_time.value) !=
+      0.0) {
+    watch->last_mod_time = mod_time.value;
+    file_watch_signal(watch);
+  }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// BACKENDS
+// ═══════════════════════════════════════════════════════════════════════════
+
+#if defined(__linux__)
+
+de100_file_scoped_fn inline bool backend_open(De100FileWatch *watch) {
+  watch->inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (watch->inotify_fd < 0) {
+    return false;
+  }
+  if (inotify_add_watch(watch->inotify_fd, watch->directory,
+                        IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+    close(watch->inotify_fd);
+    return false;
+  }
+  return true;
+}
+
+de100_file_scoped_fn inline void backend_wait(De100FileWatch *watch) {
+  struct pollfd pfd = {.fd = watch->inotify_fd, .events = POLLIN};
+  if (poll(&pfd, 1, DE100_FILE_WATCH_WAIT_MS) <= 0) {
+    return;
+  }
+
+  _Alignas(struct inotify_event) char buffer[4096];
+  ssize_t length;
+  while ((length = read(watch->inotify_fd, buffer, sizeof(buffer))) > 0) {
+    for (char *cursor = buffer; cursor < buffer + length;) {
+      const struct inotify_event *event = (const struct inotify_event *)cursor;
+      if (event->len > 0 && strcmp(event->name, watch->name) == 0) {
+        file_watch_signal(watch);
+      }
+      cursor += sizeof(struct inotify_event) + event->len;
+    }
+  }
+}
+
+de100_file_scoped_fn inline void backend_close(De100FileWatch *watch) {
+  close(watch->inotify_fd);
+}
+
+#elif DE100_FILE_WATCH_KQUEUE
+
+de100_file_scoped_fn inline bool backend_open(De100FileWatch *watch) {
+#if defined(O_EVTONLY)
+  watch->directory_fd = open(watch->directory, O_EVTONLY);
+#else
+  watch->directory_fd = open(watch->directory, O_RDONLY);
+#endif
+  if (watch->directory_fd < 0) {
+    return false;
+  }
+  watch->kqueue_fd = kqueue();
+  if (watch->kqueue_fd < 0) {
+    close(watch->directory_fd);
+    return false;
+  }
+
+  struct kevent change;
+  EV_SET(&change, watch->directory_fd, EVFILT_VNODE, EV_ADD | EV_CLEAR,
+         NOTE_WRITE | NOTE_EXTEND | NOTE_ATTRIB, 0, NULL);
+  if (kevent(watch->kqueue_fd, &change, 1, NULL, 0, NULL) < 0) {
+    close(watch->kqueue_fd);
+    close(watch->directory_fd);
+    return false;
+  }
+  return true;
+}
+
+de100_file_scoped_fn inline void backend_wait(De100FileWatch *watch) {
+  struct kevent event;
+  struct timespec timeout = {0, DE100_FILE_WATCH_WAIT_MS * 1000000L};
+  if (kevent(watch->kqueue_fd, NULL, 0, &event, 1, &timeout) > 0) {
+    file_watch_check_mod_time(watch);
+  }
+}
+
+de100_file_scoped_fn inline void backend_close(De100FileWatch *watch) {
+  close(watch->kqueue_fd);
+  close(watch->directory_fd);
+}
+
+#elif defined(_WIN32)
+
+de100_file_scoped_fn inline bool backend_open(De100FileWatch *watch) {
+  watch->change_handle = FindFirstChangeNotificationA(
+      watch->directory, FALSE,
+      FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME);
+  return watch->change_handle != INVALID_HANDLE_VALUE;
+}
+
+de100_file_scoped_fn inline void backend_wait(De100FileWatch *watch) {
+  if (WaitForSingleObject(watch->change_handle, DE100_FILE_WATCH_WAIT_MS) ==
+      WAIT_OBJECT_0) {
+    file_watch_check_mod_time(watch);
+    FindNextChangeNotification(watch->change_handle);
+  }
+}
+
+de100_file_scoped_fn inline void backend_close(De100FileWatch *watch) {
+  FindCloseChangeNotification(watch->change_handle);
+}
+
+#else
+
+de100_file_scoped_fn inline bool backend_open(De100FileWatch *watch) {
+  (void)watch;
+  return true;
+}
+
+de100_file_scoped_fn inline void backend_wait(De100FileWatch *watch) {
+  de100_sleep_ms(DE100_FILE_WATCH_WAIT_MS);
+  file_watch_check_mod_time(watch);
+}
+
+de100_file_scoped_fn inline void backend_close(De100FileWatch *watch) {
+  (void)watch;
+}
+
+#endif
+
+// ═══════════════════════════════════════════════════════════════════════════
+// THREAD
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn void *file_watch_thread_proc(void *arg) {
+  De100FileWatch *watch = (De100FileWatch *)arg;
+  while (__atomic_load_n(&watch->running, __ATOMIC_ACQUIRE)) {
+    backend_wait(watch);
+  }
+  return NULL;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// PUBLIC API
+// ═══════════════════════════════════════════════════════════════════════════
+
+De100FileWatch *de100_file_watch_start(const char *path,
+                                       De100FileWatchResult *result) {
+  size_t length = path ? strlen(path) : 0;
+  if (length == 0 || length >= DE100_MAX_PATH_LENGTH) {
+    *result = file_watch_result(DE100_FILE_WATCH_ERROR_INVALID_PATH);
+    return NULL;
+  }
+
+  De100MemoryBlock memory = de100_memory_alloc(
+      NULL, sizeof(De100FileWatch),
+      De100_MEMORY_FLAG_READ | De100_MEMORY_FLAG_WRITE |
+          De100_MEMORY_FLAG_ZEROED);
+  if (!de100_memory_is_valid(memory)) {
+    *result = file_watch_result(DE100_FILE_WATCH_ERROR_OUT_OF_MEMORY);
+    return NULL;
+  }
+
+  De100FileWatch *watch = (De100FileWatch *)memory.base;
+  watch->memory = memory;
+  memcpy(watch->path, path, length + 1);
+
+  // Split into directory + name ("name" alone watches ".")
+  const char *separator = strrchr(watch->path, '/');
+#if defined(_WIN32)
+  const char *backslash = strrchr(watch->path, '\\');
+  if (backslash && (!separator || backslash > separator)) {
+    separator = backslash;
+  }
+#endif
+  if (separator) {
+    size_t directory_length = (size_t)(separator - watch->path);
+    memcpy(watch->directory, watch->path,
+           directory_length ? directory_length : 1);
+    watch->name = separator + 1;
+  } else {
+    watch->directory[0] = '.';
+    watch->name = watch->path;
+  }
+
+  De100FileTimeResult mod_time = de100_file_get_mod_time(watch->path);
+  if (mod_time.success) {
+    watch->last_mod_time = mod_time.value;
+  }
+
+  if (!backend_open(watch)) {
+    de100_memory_free(&memory);
+    *result = file_watch_result(DE100_FILE_WATCH_ERROR_BACKEND_FAILED);
+    return NULL;
+  }
+
+  watch->running = true;
+  if (pthread_create(&watch->thread, NULL, file_watch_thread_proc, watch) !=
+      0) {
+    backend_close(watch);
+    de100_memory_free(&memory);
+    *result = file_watch_result(DE100_FILE_WATCH_ERROR_THREAD_CREATE_FAILED);
+    return NULL;
+  }
+
+  *result = file_watch_result(DE100_FILE_WATCH_SUCCESS);
+  return watch;
+}
+
+bool de100_file_watch_consume(De100FileWatch *watch) {
+  if (!watch) {
+    return false;
+  }
+
+  u32 count = __atomic_load_n(&watch->change_count, __ATOMIC_ACQUIRE);
+  if (count == watch->consumed_count) {
+    return false;
+  }
+
+  i64 last_us = __atomic_load_n(&watch->last_change_us, __ATOMIC_RELAXED);
+  f64 quiet_seconds = de100_get_wall_clock() - (f64)last_us / 1000000.0;
+  if (quiet_seconds < DE100_FILE_WATCH_SETTLE_SECONDS) {
+    return false; // Still being written; ask again next frame
+  }
+
+  watch->consumed_count = count;
+  return true;
+}
+
+void de100_file_watch_stop(De100FileWatch *watch) {
+  if (!watch) {
+    return;
+  }
+
+  __atomic_store_n(&watch->running, false, __ATOMIC_RELEASE);
+  pthread_join(watch->thread, NULL);
+  backend_close(watch);
+
+  De100MemoryBlock memory = watch->memory;
+  de100_memory_free(&memory);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ERROR MESSAGES
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_global_var const char *g_file_watch_error_messages[] = {
+    [DE100_FILE_WATCH_SUCCESS] = "Success",
+    [DE100_FILE_WATCH_ERROR_INVALID_PATH] = "Invalid or too long path",
+    [DE100_FILE_WATCH_ERROR_OUT_OF_MEMORY] = "Out of memory",
+    [DE100_FILE_WATCH_ERROR_BACKEND_FAILED] =
+        "Change notification unavailable for directory",
+    [DE100_FILE_WATCH_ERROR_THREAD_CREATE_FAILED] =
+        "Failed to create watch thread",
+};
+
+const char *de100_file_watch_strerror(De100FileWatchErrorCode code) {
+  if (code < 0 || code >= DE100_FILE_WATCH_ERROR_COUNT) {
+    return "Unknown file watch error";
+  }
+  return g_file_watch_error_messages[code];
+}
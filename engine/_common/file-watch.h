@@ -0,0 +1,89 @@
+#ifndef DE100_FILE_WATCH_H
+#define DE100_FILE_WATCH_H
+
+#include "base.h"
+#include <stdbool.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// FILE WATCH (change notification on a background thread)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// Replaces "stat the file every frame" for hot reload. A thread blocks on
+// the OS notification API for the file's DIRECTORY (builds usually write a
+// new file and rename/replace it, which a watch on the old inode would
+// miss) and bumps an atomic counter when the file changes:
+//
+//   Linux:        inotify   IN_CLOSE_WRITE | IN_MOVED_TO, matched by name
+//   macOS / BSD:  kqueue    EVFILT_VNODE NOTE_WRITE on the directory
+//   Windows:      FindFirstChangeNotification (last write / file name)
+//   other:        stat polling (on the watch thread, not the frame)
+//
+// Non-Linux backends only learn "something in the directory changed", so
+// the thread compares the file's mod time before counting an event.
+//
+// The frame side is a pair of atomic loads and a clock read:
+//
+//   De100FileWatchResult result;
+//   De100FileWatch *watch = de100_file_watch_start(path, &result);
+//   ...
+//   if (watch && de100_file_watch_consume(watch)) { reload(); }
+//   ...
+//   de100_file_watch_stop(watch);
+//
+// consume() waits until the file has been quiet for
+// DE100_FILE_WATCH_SETTLE_SECONDS, so a linker still writing in several
+// passes triggers one reload, not three.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#ifndef DE100_FILE_WATCH_SETTLE_SECONDS
+#define DE100_FILE_WATCH_SETTLE_SECONDS 0.05
+#endif
+
+// How long the thread blocks before re-checking the stop flag
+#define DE100_FILE_WATCH_WAIT_MS 100
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ERROR CODES
+// ═══════════════════════════════════════════════════════════════════════════
+
+typedef enum {
+  DE100_FILE_WATCH_SUCCESS = 0,
+  DE100_FILE_WATCH_ERROR_INVALID_PATH,
+  DE100_FILE_WATCH_ERROR_OUT_OF_MEMORY,
+  DE100_FILE_WATCH_ERROR_BACKEND_FAILED, // inotify / kqueue / Win32 refused
+  DE100_FILE_WATCH_ERROR_THREAD_CREATE_FAILED,
+
+  DE100_FILE_WATCH_ERROR_COUNT // Sentinel for validation
+} De100FileWatchErrorCode;
+
+typedef struct {
+  bool success;
+  De100FileWatchErrorCode error_code;
+} De100FileWatchResult;
+
+typedef struct De100FileWatch De100FileWatch;
+
+// ═══════════════════════════════════════════════════════════════════════════
+// API FUNCTIONS
+// ═══════════════════════════════════════════════════════════════════════════
+
+/**
+ * Start watching `path` (the file need not exist yet; its directory must).
+ * Returns NULL on failure; callers fall back to polling.
+ */
+De100FileWatch *de100_file_watch_start(const char *path,
+                                       De100FileWatchResult *result);
+
+/**
+ * True once per settled change since the last true. Never blocks, no
+ * syscalls beyond the wall clock. NULL-safe (returns false).
+ */
+bool de100_file_watch_consume(De100FileWatch *watch);
+
+/** Stop and join the thread, release the watch. NULL-safe. */
+void de100_file_watch_stop(De100FileWatch *watch);
+
+const char *de100_file_watch_strerror(De100FileWatchErrorCode code);
+
+#endif // DE100_FILE_WATCH_H
@@ -57,6 +57,15 @@ typedef struct {
   De100FileErrorCode error_code;
 } De100FileExistsResult;
 
+typedef struct {
+  bool exists;       // Something is at the path (file or directory)
+  bool is_directory;
+  i64 size;                // Bytes (0 for directories / missing paths)
+  De100TimeSpec mod_time;  // Last write
+  bool success; // false if the stat itself failed (e.g., permission error)
+  De100FileErrorCode error_code;
+} De100FileStatResult;
+
 typedef struct {
   i32 fd; // -1 on error
   bool success;
@@ -91,6 +100,31 @@ typedef enum {
   DE100_SEEK_END = 2, // From end
 } De100FileSeekOrigin;
 
+// Buffer, offset and length alignment for de100_file_set_direct reads
+// (the largest logical block size in common use)
+#define DE100_FILE_DIRECT_ALIGNMENT 4096
+
+// ═══════════════════════════════════════════════════════════════════════════
+// MEMORY MAPPING
+// ═══════════════════════════════════════════════════════════════════════════
+
+// Access-pattern hints for de100_file_map_readonly (combine with |).
+// Advisory: ignored where the OS has no equivalent.
+typedef enum {
+  DE100_FILE_MAP_ADVICE_NORMAL = 0,
+  DE100_FILE_MAP_ADVICE_SEQUENTIAL = 1 << 0, // Read-ahead, drop behind
+  DE100_FILE_MAP_ADVICE_RANDOM = 1 << 1,     // No read-ahead
+  DE100_FILE_MAP_ADVICE_WILLNEED = 1 << 2,   // Start paging in now
+  DE100_FILE_MAP_ADVICE_HUGEPAGE = 1 << 3,   // Linux THP (big packs)
+} De100FileMapAdvice;
+
+typedef struct {
+  const void *data; // NULL on error or for an empty file
+  size_t size;
+  bool success;
+  De100FileErrorCode error_code;
+} De100FileMapping;
+
 // ═══════════════════════════════════════════════════════════════════════════
 // API FUNCTIONS - High Level (Path-based)
 // ═══════════════════════════════════════════════════════════════════════════
@@ -107,9 +141,21 @@ f64 de100_file_time_diff(const De100TimeSpec *a, const De100TimeSpec *b);
 
 /**
  * Copy a file from source to destination.
+ *
+ * Kernel-side where available (copy_file_range / sendfile on Linux,
+ * fcopyfile on macOS, CopyFileEx on Windows), else a 1MB buffered loop.
+ * DE100_INTERNAL builds log size, method and throughput.
  */
 De100FileResult de100_file_copy(const char *source, const char *dest);
 
+/**
+ * Hard-link dest to source (replacing dest), falling back to a copy when
+ * the filesystem refuses (cross-volume, FAT, ...). dest shares the
+ * source's inode, so only use it when the source gets replaced rather than
+ * rewritten in place.
+ */
+De100FileResult de100_file_link_or_copy(const char *source, const char *dest);
+
 /**
  * Check if a file exists (and is a regular file, not a directory).
  */
@@ -120,11 +166,60 @@ De100FileExistsResult de100_file_exists(const char *filename);
  */
 De100FileSizeResult de100_file_get_size(const char *filename);
 
+/**
+ * Existence, type, size and mod time in one syscall. A missing path is a
+ * successful answer (exists = false), like de100_file_exists.
+ */
+De100FileStatResult de100_file_stat(const char *filename);
+
 /**
  * Delete a file. Idempotent - returns success if file doesn't exist.
  */
 De100FileResult de100_file_delete(const char *filename);
 
+// ═══════════════════════════════════════════════════════════════════════════
+// STAT CACHE
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// Remembers de100_file_stat answers for `ttl_seconds`, for code that asks
+// about the same paths over and over (the hot-reload check polls the game
+// library every frame when there is no file watch). Entries also go stale
+// when invalidated, e.g. on a file watch notification:
+//
+//   if (de100_file_watch_consume(watch)) {
+//     de100_file_stat_cache_invalidate(&cache, path);
+//   }
+//   De100FileStatResult stat = de100_file_stat_cached(&cache, path);
+//
+// Direct-mapped by a 64-bit hash of the path (a colliding path evicts the
+// other one). Not thread-safe: one cache per thread that uses it.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define DE100_FILE_STAT_CACHE_SIZE 32 // Power of two
+#define DE100_FILE_STAT_CACHE_DEFAULT_TTL 0.25
+
+typedef struct {
+  u64 path_hash; // 0 = empty
+  f64 fetched_at;
+  De100FileStatResult stat;
+} De100FileStatCacheEntry;
+
+typedef struct {
+  f64 ttl_seconds; // 0 = DE100_FILE_STAT_CACHE_DEFAULT_TTL
+  u64 hit_count;
+  u64 miss_count;
+  De100FileStatCacheEntry entries[DE100_FILE_STAT_CACHE_SIZE];
+} De100FileStatCache;
+
+/** de100_file_stat, answered from `cache` while the entry is fresh. */
+De100FileStatResult de100_file_stat_cached(De100FileStatCache *cache,
+                                           const char *filename);
+
+/** Drop the entry for `filename` (NULL = every entry). */
+void de100_file_stat_cache_invalidate(De100FileStatCache *cache,
+                                      const char *filename);
+
 // ═══════════════════════════════════════════════════════════════════════════
 // API FUNCTIONS - Low Level (File Descriptor-based)
 // ═══════════════════════════════════════════════════════════════════════════
@@ -192,6 +287,60 @@ De100FileIOResult de100_file_write_all(i32 fd, const void *buffer, size_t size);
 De100FileSizeResult de100_file_seek(i32 fd, i64 offset,
                                     De100FileSeekOrigin origin);
 
+/**
+ * Size of an open regular file, 64-bit on every platform.
+ *
+ * @return De100FileSizeResult with the size, or DE100_FILE_ERROR_IS_DIRECTORY
+ *         / DE100_FILE_ERROR_NOT_A_FILE for anything that isn't one
+ */
+De100FileSizeResult de100_file_get_size_fd(i32 fd);
+
+/**
+ * Read-ahead hints for the whole file (De100FileMapAdvice flags, the
+ * same ones de100_file_map_readonly takes): SEQUENTIAL widens
+ * read-ahead, WILLNEED starts reading now. Advisory: succeeds without
+ * doing anything where the OS has no equivalent.
+ */
+De100FileResult de100_file_advise(i32 fd, u32 advice);
+
+/**
+ * Turn page-cache bypass on or off for later reads (O_DIRECT on Linux,
+ * F_NOCACHE on macOS). Direct reads need the buffer, the file offset and
+ * the length aligned to DE100_FILE_DIRECT_ALIGNMENT.
+ *
+ * @return false where it isn't supported (Windows, some filesystems);
+ *         the descriptor then keeps reading through the cache
+ */
+bool de100_file_set_direct(i32 fd, bool enable);
+
+// ═══════════════════════════════════════════════════════════════════════════
+// API FUNCTIONS - Memory Mapping
+// ═══════════════════════════════════════════════════════════════════════════
+
+/**
+ * Map a whole file read-only. No allocation, no copy: data points at the
+ * page cache, so loaders can parse in place.
+ *
+ * @param filename  Path to the file
+ * @param advice    De100FileMapAdvice flags
+ * @return          Mapping (success with data = NULL for an empty file)
+ *
+ * Usage:
+ *   De100FileMapping map = de100_file_map_readonly(
+ *       "data/pack.bin", DE100_FILE_MAP_ADVICE_SEQUENTIAL);
+ *   if (map.success) {
+ *       parse(map.data, map.size);
+ *       de100_file_unmap(&map);
+ *   }
+ *
+ * The view stays valid after the file is deleted or replaced (not if it
+ * is truncated in place).
+ */
+De100FileMapping de100_file_map_readonly(const char *filename, u32 advice);
+
+/** Release a mapping and zero it. Idempotent, NULL-safe. */
+void de100_file_unmap(De100FileMapping *mapping);
+
 // ═══════════════════════════════════════════════════════════════════════════
 // ERROR HANDLING
 // ═══════════════════════════════════════════════════════════════════════════
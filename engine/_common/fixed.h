@@ -0,0 +1,234 @@
+#ifndef DE100_COMMON_FIXED_H
+#define DE100_COMMON_FIXED_H
+
+#include "base.h"
+
+// ═══════════════════════════════════════════════════════════════════════════
+// 🔢 FIXED POINT (Q16.16)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// Integer-only counterpart of math.h for targets with a weak or missing
+// FPU (soft-float ARM boards): 16 integer bits, 16 fraction bits, range
+// ±32767.99998 in steps of 1/65536. Enough for screen-space geometry; not
+// for world coordinates that grow unbounded.
+//
+//   fx32 speed = DE100_FX(2.5); // constant, folded at compile time
+//   De100FxMat2 spin = de100_fx_mat2_rotation(state->angle);
+//   De100FxV2 p = de100_fx_v2_add(center, de100_fx_mat2_mul(spin, model[i]));
+//
+// Angles are binary (De100FxAngle): 65536 = one full turn, so wrapping is
+// free integer overflow and sin/cos need no range reduction.
+//
+// DE100_FIXED_POINT_RENDER selects the integer raster paths (raster.h).
+// It defaults to on for ARM builds without hardware floating point; pass
+// -DDE100_FIXED_POINT_RENDER=1 to force it elsewhere.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#ifndef DE100_FIXED_POINT_RENDER
+#if defined(__arm__) && !defined(__ARM_FP)
+#define DE100_FIXED_POINT_RENDER 1
+#else
+#define DE100_FIXED_POINT_RENDER 0
+#endif
+#endif
+
+typedef int32_t fx32;
+typedef uint16_t De100FxAngle; // 65536 = 2π
+
+#define DE100_FX_SHIFT 16
+#define DE100_FX_ONE ((fx32)1 << DE100_FX_SHIFT)
+#define DE100_FX_HALF ((fx32)1 << (DE100_FX_SHIFT - 1))
+#define DE100_FX_FRACTION_MASK (DE100_FX_ONE - 1)
+
+// Compile-time constant from a literal: DE100_FX(0.75)
+#define DE100_FX(value)                                                        \
+  ((fx32)((value) * 65536.0 + ((value) >= 0 ? 0.5 : -0.5)))
+
+// Degrees literal → binary angle: DE100_FX_DEGREES(90) == 16384
+#define DE100_FX_DEGREES(deg) ((De100FxAngle)((i64)((deg) * 65536.0 / 360.0)))
+
+typedef struct {
+  fx32 x, y;
+} De100FxV2;
+
+// Row-major: | m00 m01 |
+//            | m10 m11 |
+typedef struct {
+  fx32 m00, m01;
+  fx32 m10, m11;
+} De100FxMat2;
+
+// ═══════════════════════════════════════════════════════════════════════════
+// SCALARS
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn inline fx32 de100_fx_from_i32(i32 x) {
+  return (fx32)((u32)x << DE100_FX_SHIFT);
+}
+
+// Load-time conversion only (it is the one place a float is touched)
+de100_file_scoped_fn inline fx32 de100_fx_from_f32(f32 x) {
+  return (fx32)(x * 65536.0f + (x >= 0.0f ? 0.5f : -0.5f));
+}
+
+de100_file_scoped_fn inline f32 de100_fx_to_f32(fx32 x) {
+  return (f32)x * (1.0f / 65536.0f);
+}
+
+// Radians → binary angle, through i64 so a float angle that has grown for
+// hours (a spinning object, thousands of radians) converts without overflow
+de100_file_scoped_fn inline De100FxAngle de100_fx_angle_from_radians(f32 a) {
+  return (De100FxAngle)(i64)(a * (65536.0f / 6.28318530718f));
+}
+
+// Arithmetic shift floors toward -inf (GCC/Clang/MSVC all shift signed
+// values arithmetically)
+de100_file_scoped_fn inline i32 de100_fx_floor(fx32 x) {
+  return x >> DE100_FX_SHIFT;
+}
+
+de100_file_scoped_fn inline i32 de100_fx_ceil(fx32 x) {
+  return (i32)(((i64)x + DE100_FX_FRACTION_MASK) >> DE100_FX_SHIFT);
+}
+
+de100_file_scoped_fn inline i32 de100_fx_round(fx32 x) {
+  return (i32)(((i64)x + DE100_FX_HALF) >> DE100_FX_SHIFT);
+}
+
+de100_file_scoped_fn inline fx32 de100_fx_fraction(fx32 x) {
+  return x & DE100_FX_FRACTION_MASK;
+}
+
+de100_file_scoped_fn inline fx32 de100_fx_mul(fx32 a, fx32 b) {
+  return (fx32)(((i64)a * (i64)b) >> DE100_FX_SHIFT);
+}
+
+// Caller guarantees b != 0
+de100_file_scoped_fn inline fx32 de100_fx_div(fx32 a, fx32 b) {
+  return (fx32)(((i64)a * DE100_FX_ONE) / b);
+}
+
+// a + (b - a) * t, t in [0, ONE]
+de100_file_scoped_fn inline fx32 de100_fx_lerp(fx32 a, fx32 b, fx32 t) {
+  return a + de100_fx_mul(b - a, t);
+}
+
+de100_file_scoped_fn inline fx32 de100_fx_abs(fx32 x) {
+  return x < 0 ? -x : x;
+}
+
+de100_file_scoped_fn inline fx32 de100_fx_min(fx32 a, fx32 b) {
+  return a < b ? a : b;
+}
+
+de100_file_scoped_fn inline fx32 de100_fx_max(fx32 a, fx32 b) {
+  return a > b ? a : b;
+}
+
+/**
+ * sin(angle) in Q16.16, max error ~4e-4 (5th-order polynomial per
+ * quarter wave, exact at 0, 90, 180 and 270 degrees).
+ */
+de100_file_scoped_fn inline fx32 de100_fx_sin(De100FxAngle angle) {
+  // Fold into the first quarter: t in [0, ONE] covers 0..90 degrees
+  u32 quarter = (u32)angle >> 14;
+  i64 t = (i64)((u32)angle & 0x3FFF) << 2; // Q16
+  if (quarter & 1) {
+    t = DE100_FX_ONE - t;
+  }
+
+  // sin(t·π/2) ≈ t·(A - t²·(B - t²·C)), with A - B + C = 1:
+  //   A = π/2, B = 2A - 5/2, C = A - 3/2
+  const i64 A = 102944; // 1.5707963 · 65536
+  const i64 B = 42046;  // 0.6415927 · 65536
+  const i64 C = 4634;   // 0.0707963 · 65536
+  i64 t2 = (t * t) >> DE100_FX_SHIFT;
+  i64 inner = B - ((t2 * C) >> DE100_FX_SHIFT);
+  i64 result = (t * (A - ((t2 * inner) >> DE100_FX_SHIFT))) >> DE100_FX_SHIFT;
+  if (result > DE100_FX_ONE) {
+    result = DE100_FX_ONE;
+  }
+
+  return (fx32)(quarter & 2 ? -result : result);
+}
+
+de100_file_scoped_fn inline fx32 de100_fx_cos(De100FxAngle angle) {
+  return de100_fx_sin((De100FxAngle)(angle + 16384));
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// VEC2 / MAT2
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn inline De100FxV2 de100_fx_v2(fx32 x, fx32 y) {
+  return (De100FxV2){x, y};
+}
+
+de100_file_scoped_fn inline De100FxV2 de100_fx_v2_from_i32(i32 x, i32 y) {
+  return (De100FxV2){de100_fx_from_i32(x), de100_fx_from_i32(y)};
+}
+
+de100_file_scoped_fn inline De100FxV2 de100_fx_v2_add(De100FxV2 a,
+                                                      De100FxV2 b) {
+  return (De100FxV2){a.x + b.x, a.y + b.y};
+}
+
+de100_file_scoped_fn inline De100FxV2 de100_fx_v2_sub(De100FxV2 a,
+                                                      De100FxV2 b) {
+  return (De100FxV2){a.x - b.x, a.y - b.y};
+}
+
+de100_file_scoped_fn inline De100FxV2 de100_fx_v2_scale(De100FxV2 v,
+                                                        fx32 s) {
+  return (De100FxV2){de100_fx_mul(v.x, s), de100_fx_mul(v.y, s)};
+}
+
+de100_file_scoped_fn inline De100FxV2 de100_fx_v2_lerp(De100FxV2 a,
+                                                       De100FxV2 b, fx32 t) {
+  return (De100FxV2){de100_fx_lerp(a.x, b.x, t), de100_fx_lerp(a.y, b.y, t)};
+}
+
+de100_file_scoped_fn inline fx32 de100_fx_v2_dot(De100FxV2 a, De100FxV2 b) {
+  return (fx32)(((i64)a.x * b.x + (i64)a.y * b.y) >> DE100_FX_SHIFT);
+}
+
+de100_file_scoped_fn inline De100FxMat2 de100_fx_mat2_identity(void) {
+  return (De100FxMat2){DE100_FX_ONE, 0, 0, DE100_FX_ONE};
+}
+
+// Counter-clockwise in y-up space (clockwise on screen, where y points down)
+de100_file_scoped_fn inline De100FxMat2
+de100_fx_mat2_rotation(De100FxAngle angle) {
+  fx32 s = de100_fx_sin(angle);
+  fx32 c = de100_fx_cos(angle);
+  return (De100FxMat2){c, -s, s, c};
+}
+
+// Rotation then uniform scale in one matrix (a wireframe's model→screen)
+de100_file_scoped_fn inline De100FxMat2
+de100_fx_mat2_rotation_scale(De100FxAngle angle, fx32 scale) {
+  fx32 s = de100_fx_mul(de100_fx_sin(angle), scale);
+  fx32 c = de100_fx_mul(de100_fx_cos(angle), scale);
+  return (De100FxMat2){c, -s, s, c};
+}
+
+de100_file_scoped_fn inline De100FxV2 de100_fx_mat2_mul(De100FxMat2 m,
+                                                        De100FxV2 v) {
+  return (De100FxV2){
+      (fx32)(((i64)m.m00 * v.x + (i64)m.m01 * v.y) >> DE100_FX_SHIFT),
+      (fx32)(((i64)m.m10 * v.x + (i64)m.m11 * v.y) >> DE100_FX_SHIFT),
+  };
+}
+
+de100_file_scoped_fn inline De100FxMat2 de100_fx_mat2_mul_mat2(De100FxMat2 a,
+                                                               De100FxMat2 b) {
+  return (De100FxMat2){
+      de100_fx_mul(a.m00, b.m00) + de100_fx_mul(a.m01, b.m10),
+      de100_fx_mul(a.m00, b.m01) + de100_fx_mul(a.m01, b.m11),
+      de100_fx_mul(a.m10, b.m00) + de100_fx_mul(a.m11, b.m10),
+      de100_fx_mul(a.m10, b.m01) + de100_fx_mul(a.m11, b.m11),
+  };
+}
+
+#endif // DE100_COMMON_FIXED_H
@@ -0,0 +1,317 @@
+#include "hash.h"
+#include "cpu.h"
+
+#include <string.h>
+
+#if !defined(DE100_HASH_FORCE_SCALAR) && DE100_CPU_X86
+#define DE100_HASH_X86 1
+#include <immintrin.h>
+#elif !defined(DE100_HASH_FORCE_SCALAR) &&                                     \
+    (defined(__ARM_NEON) || defined(__aarch64__))
+#define DE100_HASH_NEON 1
+#include <arm_neon.h>
+#endif
+
+// ═══════════════════════════════════════════════════════════════════════════
+// CONSTANTS
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define HASH_STRIPE_SIZE 64
+#define HASH_LANES 8
+#define HASH_STRIPES_PER_BLOCK 16
+#define HASH_BLOCK_SIZE (HASH_STRIPE_SIZE * HASH_STRIPES_PER_BLOCK)
+
+#define HASH_PRIME32_1 0x9E3779B1u
+#define HASH_PRIME32_2 0x85EBCA77u
+#define HASH_PRIME32_3 0xC2B2AE3Du
+#define HASH_PRIME64_1 0x9E3779B185EBCA87ull
+#define HASH_PRIME64_2 0xC2B2AE3D27D4EB4Full
+#define HASH_PRIME64_3 0x165667B19E3779F9ull
+#define HASH_PRIME64_4 0x85EBCA77C2B2AE63ull
+#define HASH_PRIME64_5 0x27D4EB2F165667C5ull
+
+// splitmix64 output; stripe s reads secret[s..s+7], the scramble reads
+// the last 8
+de100_file_scoped_global_var const u64 g_hash_secret[HASH_STRIPES_PER_BLOCK +
+                                                     HASH_LANES] = {
+    0x54703543e1b314dcull, 0xc9108360795f67cbull, 0x41fedd59754befe8ull,
+    0x0fe9ec9a066a7ba7ull, 0xcdac29164d351b05ull, 0xb2940de82f408d35ull,
+    0xe1fa6850509af146ull, 0xbf6dada8768a34deull, 0x3457d91c8903d3b1ull,
+    0x4d7fd52883dceda2ull, 0x3475e4ca54984050ull, 0xa02e586ecf7c2d2cull,
+    0x58a80f9f8b31f042ull, 0xc9503a1f9123b4adull, 0x10ae54df56aa39a9ull,
+    0xcca09d8a5aab4ce8ull, 0xea841c6050afd347ull, 0x59c09bb575de0afeull,
+    0x049e009915035ceaull, 0x77d5987525cfd5a2ull, 0x9faf4a12376f9c13ull,
+    0x61eded2dbd17536dull, 0xe4d15191287c5342ull, 0xaedab72e7289677cull,
+};
+
+#define HASH_SCRAMBLE_SECRET (g_hash_secret + HASH_STRIPES_PER_BLOCK)
+
+// ═══════════════════════════════════════════════════════════════════════════
+// STRIPE ACCUMULATE / SCRAMBLE
+// ═══════════════════════════════════════════════════════════════════════════
+
+// Scalar reference: always built, so DE100_CPU_DISABLE=all can pick it
+
+de100_file_scoped_fn inline void
+accumulate_stripe_scalar(u64 *acc, const u8 *data, const u64 *secret) {
+  for (u32 i = 0; i < HASH_LANES; ++i) {
+    u64 value;
+    memcpy(&value, data + i * sizeof(u64), sizeof(u64));
+    u64 keyed = value ^ secret[i];
+    acc[i ^ 1] += value;
+    acc[i] += (u64)(u32)keyed * (keyed >> 32);
+  }
+}
+
+de100_file_scoped_fn inline void scramble_scalar(u64 *acc) {
+  for (u32 i = 0; i < HASH_LANES; ++i) {
+    u64 value = acc[i];
+    value ^= value >> 47;
+    value ^= HASH_SCRAMBLE_SECRET[i];
+    acc[i] = value * HASH_PRIME32_1;
+  }
+}
+
+#if DE100_HASH_X86
+
+de100_file_scoped_fn inline void
+accumulate_stripe_sse2(u64 *acc, const u8 *data, const u64 *secret) {
+  for (u32 i = 0; i < HASH_LANES / 2; ++i) {
+    __m128i value = _mm_loadu_si128((const __m128i *)data + i);
+    __m128i key = _mm_loadu_si128((const __m128i *)secret + i);
+    __m128i keyed = _mm_xor_si128(value, key);
+    __m128i keyed_hi = _mm_shuffle_epi32(keyed, _MM_SHUFFLE(0, 3, 0, 1));
+    __m128i product = _mm_mul_epu32(keyed, keyed_hi);
+    __m128i swapped = _mm_shuffle_epi32(value, _MM_SHUFFLE(1, 0, 3, 2));
+
+    __m128i *lanes = (__m128i *)acc + i;
+    __m128i sum = _mm_add_epi64(_mm_loadu_si128(lanes), swapped);
+    _mm_storeu_si128(lanes, _mm_add_epi64(sum, product));
+  }
+}
+
+de100_file_scoped_fn inline void scramble_sse2(u64 *acc) {
+  const __m128i prime = _mm_set1_epi32((int)HASH_PRIME32_1);
+  for (u32 i = 0; i < HASH_LANES / 2; ++i) {
+    __m128i *lanes = (__m128i *)acc + i;
+    __m128i value = _mm_loadu_si128(lanes);
+    value = _mm_xor_si128(value, _mm_srli_epi64(value, 47));
+    value = _mm_xor_si128(
+        value, _mm_loadu_si128((const __m128i *)HASH_SCRAMBLE_SECRET + i));
+
+    // 64×32 multiply from two 32×32→64 halves
+    __m128i lo = _mm_mul_epu32(value, prime);
+    __m128i hi = _mm_mul_epu32(_mm_srli_epi64(value, 32), prime);
+    _mm_storeu_si128(lanes, _mm_add_epi64(lo, _mm_slli_epi64(hi, 32)));
+  }
+}
+
+// Same shuffles as SSE2: _mm256_shuffle_epi32 works within 128-bit halves
+
+DE100_TARGET_AVX2 de100_file_scoped_fn inline void
+accumulate_stripe_avx2(u64 *acc, const u8 *data, const u64 *secret) {
+  for (u32 i = 0; i < HASH_LANES / 4; ++i) {
+    __m256i value = _mm256_loadu_si256((const __m256i *)data + i);
+    __m256i key = _mm256_loadu_si256((const __m256i *)secret + i);
+    __m256i keyed = _mm256_xor_si256(value, key);
+    __m256i keyed_hi = _mm256_shuffle_epi32(keyed, _MM_SHUFFLE(0, 3, 0, 1));
+    __m256i product = _mm256_mul_epu32(keyed, keyed_hi);
+    __m256i swapped = _mm256_shuffle_epi32(value, _MM_SHUFFLE(1, 0, 3, 2));
+
+    __m256i *lanes = (__m256i *)acc + i;
+    __m256i sum = _mm256_add_epi64(_mm256_loadu_si256(lanes), swapped);
+    _mm256_storeu_si256(lanes, _mm256_add_epi64(sum, product));
+  }
+}
+
+DE100_TARGET_AVX2 de100_file_scoped_fn inline void scramble_avx2(u64 *acc) {
+  const __m256i prime = _mm256_set1_epi32((int)HASH_PRIME32_1);
+  for (u32 i = 0; i < HASH_LANES / 4; ++i) {
+    __m256i *lanes = (__m256i *)acc + i;
+    __m256i value = _mm256_loadu_si256(lanes);
+    value = _mm256_xor_si256(value, _mm256_srli_epi64(value, 47));
+    value = _mm256_xor_si256(
+        value,
+        _mm256_loadu_si256((const __m256i *)HASH_SCRAMBLE_SECRET + i));
+
+    __m256i lo = _mm256_mul_epu32(value, prime);
+    __m256i hi = _mm256_mul_epu32(_mm256_srli_epi64(value, 32), prime);
+    _mm256_storeu_si256(lanes, _mm256_add_epi64(lo, _mm256_slli_epi64(hi, 32)));
+  }
+}
+
+// All 8 lanes in one register
+
+DE100_TARGET_AVX512 de100_file_scoped_fn inline void
+accumulate_stripe_avx512(u64 *acc, const u8 *data, const u64 *secret) {
+  __m512i value = _mm512_loadu_si512((const void *)data);
+  __m512i keyed = _mm512_xor_si512(value, _mm512_loadu_si512(secret));
+  __m512i keyed_hi = _mm512_shuffle_epi32(
+      keyed, (_MM_PERM_ENUM)_MM_SHUFFLE(0, 3, 0, 1));
+  __m512i product = _mm512_mul_epu32(keyed, keyed_hi);
+  __m512i swapped = _mm512_shuffle_epi32(
+      value, (_MM_PERM_ENUM)_MM_SHUFFLE(1, 0, 3, 2));
+
+  __m512i sum = _mm512_add_epi64(_mm512_loadu_si512(acc), swapped);
+  _mm512_storeu_si512(acc, _mm512_add_epi64(sum, product));
+}
+
+DE100_TARGET_AVX512 de100_file_scoped_fn inline void scramble_avx512(u64 *acc) {
+  const __m512i prime = _mm512_set1_epi32((int)HASH_PRIME32_1);
+  __m512i value = _mm512_loadu_si512(acc);
+  value = _mm512_xor_si512(value, _mm512_srli_epi64(value, 47));
+  value = _mm512_xor_si512(value, _mm512_loadu_si512(HASH_SCRAMBLE_SECRET));
+
+  __m512i lo = _mm512_mul_epu32(value, prime);
+  __m512i hi = _mm512_mul_epu32(_mm512_srli_epi64(value, 32), prime);
+  _mm512_storeu_si512(acc, _mm512_add_epi64(lo, _mm512_slli_epi64(hi, 32)));
+}
+
+#elif DE100_HASH_NEON
+
+de100_file_scoped_fn inline void
+accumulate_stripe_neon(u64 *acc, const u8 *data, const u64 *secret) {
+  for (u32 i = 0; i < HASH_LANES / 2; ++i) {
+    uint64x2_t value = vreinterpretq_u64_u8(vld1q_u8(data + 16 * i));
+    uint64x2_t keyed = veorq_u64(value, vld1q_u64(secret + 2 * i));
+    uint64x2_t product =
+        vmull_u32(vmovn_u64(keyed), vshrn_n_u64(keyed, 32));
+    uint64x2_t swapped = vextq_u64(value, value, 1);
+
+    uint64x2_t lanes = vld1q_u64(acc + 2 * i);
+    lanes = vaddq_u64(vaddq_u64(lanes, swapped), product);
+    vst1q_u64(acc + 2 * i, lanes);
+  }
+}
+
+de100_file_scoped_fn inline void scramble_neon(u64 *acc) {
+  const uint32x2_t prime = vdup_n_u32(HASH_PRIME32_1);
+  for (u32 i = 0; i < HASH_LANES / 2; ++i) {
+    uint64x2_t value = vld1q_u64(acc + 2 * i);
+    value = veorq_u64(value, vshrq_n_u64(value, 47));
+    value = veorq_u64(value, vld1q_u64(HASH_SCRAMBLE_SECRET + 2 * i));
+
+    uint64x2_t hi = vshlq_n_u64(vmull_u32(vshrn_n_u64(value, 32), prime), 32);
+    vst1q_u64(acc + 2 * i, vmlal_u32(hi, vmovn_u64(value), prime));
+  }
+}
+
+#endif
+
+// ═══════════════════════════════════════════════════════════════════════════
+// FINALIZATION
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn inline u64 fold_multiply(u64 a, u64 b) {
+  unsigned __int128 product = (unsigned __int128)a * b;
+  return (u64)product ^ (u64)(product >> 64);
+}
+
+de100_file_scoped_fn inline u64 merge_lanes(const u64 *acc, u64 start) {
+  u64 result = start;
+  for (u32 i = 0; i < HASH_LANES; i += 2) {
+    result += fold_multiply(acc[i] ^ g_hash_secret[i],
+                            acc[i + 1] ^ g_hash_secret[i + 1]);
+  }
+  return de100_hash_mix64(result);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// VARIANTS
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// One full hash per instruction set, so each loop inlines its own stripe
+// kernels (a target attribute can't be inherited through a pointer)
+
+#define HASH64_DEFINE(suffix, target)                                          \
+  target de100_file_scoped_fn u64 hash64_##suffix(const void *data, u64 size, \
+                                                 u64 seed) {                   \
+    const u8 *bytes = (const u8 *)data;                                        \
+    u64 acc[HASH_LANES] = {                                                    \
+        HASH_PRIME32_3,        HASH_PRIME64_1, HASH_PRIME64_2,                 \
+        HASH_PRIME64_3,        HASH_PRIME64_4, HASH_PRIME32_2,                 \
+        HASH_PRIME64_5 ^ seed, HASH_PRIME32_1 ^ seed,                          \
+    };                                                                         \
+                                                                               \
+    u64 block_count = size / HASH_BLOCK_SIZE;                                  \
+    for (u64 block = 0; block < block_count; ++block) {                        \
+      const u8 *stripes = bytes + block * HASH_BLOCK_SIZE;                     \
+      for (u32 stripe = 0; stripe < HASH_STRIPES_PER_BLOCK; ++stripe) {        \
+        accumulate_stripe_##suffix(acc, stripes + stripe * HASH_STRIPE_SIZE,   \
+                                   g_hash_secret + stripe);                    \
+      }                                                                        \
+      scramble_##suffix(acc);                                                  \
+    }                                                                          \
+                                                                               \
+    /* Whole stripes left over, then the zero-padded tail (length is mixed  \
+       in below, so the padding can't collide with real zeros) */             \
+    const u8 *rest = bytes + block_count * HASH_BLOCK_SIZE;                    \
+    u64 rest_size = size - block_count * HASH_BLOCK_SIZE;                      \
+    u32 stripe = 0;                                                            \
+    for (; rest_size >= HASH_STRIPE_SIZE; ++stripe) {                          \
+      accumulate_stripe_##suffix(acc, rest, g_hash_secret + stripe);           \
+      rest += HASH_STRIPE_SIZE;                                                \
+      rest_size -= HASH_STRIPE_SIZE;                                           \
+    }                                                                          \
+    if (rest_size > 0) {                                                       \
+      u8 tail[HASH_STRIPE_SIZE] = {0};                                         \
+      memcpy(tail, rest, (size_t)rest_size);                                   \
+      accumulate_stripe_##suffix(acc, tail, g_hash_secret + stripe);           \
+    }                                                                          \
+                                                                               \
+    return merge_lanes(acc, (size * HASH_PRIME64_1) ^ seed);                   \
+  }
+
+HASH64_DEFINE(scalar, )
+#if DE100_HASH_X86
+HASH64_DEFINE(sse2, )
+HASH64_DEFINE(avx2, DE100_TARGET_AVX2)
+HASH64_DEFINE(avx512, DE100_TARGET_AVX512)
+#elif DE100_HASH_NEON
+HASH64_DEFINE(neon, )
+#endif
+
+// ═══════════════════════════════════════════════════════════════════════════
+// API
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_hash64_t *de100_hash64_select(u32 cpu_features, const char **out_name) {
+  de100_hash64_t *hash64 = hash64_scalar;
+  const char *name = "scalar";
+
+#if DE100_HASH_X86
+  if (cpu_features & DE100_CPU_FEATURE_AVX512) {
+    hash64 = hash64_avx512;
+    name = "avx512";
+  } else if (cpu_features & DE100_CPU_FEATURE_AVX2) {
+    hash64 = hash64_avx2;
+    name = "avx2";
+  } else if (cpu_features & DE100_CPU_FEATURE_SSE2) {
+    hash64 = hash64_sse2;
+    name = "sse2";
+  }
+#elif DE100_HASH_NEON
+  if (cpu_features & DE100_CPU_FEATURE_NEON) {
+    hash64 = hash64_neon;
+    name = "neon";
+  }
+#else
+  (void)cpu_features;
+#endif
+
+  if (out_name) {
+    *out_name = name;
+  }
+  return hash64;
+}
+
+u64 de100_hash64(const void *data, u64 size, u64 seed) {
+  local_persist_var de100_hash64_t *selected = NULL;
+  de100_hash64_t *hash64 = __atomic_load_n(&selected, __ATOMIC_ACQUIRE);
+  if (!hash64) {
+    // Racing first calls pick the same variant
+    hash64 = de100_hash64_select(de100_cpu_features(), NULL);
+    __atomic_store_n(&selected, hash64, __ATOMIC_RELEASE);
+  }
+  return hash64(data, size, seed);
+}
@@ -0,0 +1,59 @@
+#ifndef DE100_COMMON_HASH_H
+#define DE100_COMMON_HASH_H
+
+#include "base.h"
+
+// ═══════════════════════════════════════════════════════════════════════════
+// FAST NON-CRYPTOGRAPHIC HASH (XXH3-style, dependency-free)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// For checksumming large memory ranges (game state, assets), not for
+// anything adversarial. The layout follows XXH3's long-input loop:
+//
+//   8 × u64 accumulators
+//   per 64-byte stripe:  k = data ^ secret[stripe..]
+//                        acc[i]     += lo32(k) * hi32(k)
+//                        acc[i ^ 1] += data[i]
+//   per 16 stripes:      scramble (xorshift, xor secret, × prime)
+//   tail:                zero-padded final stripe
+//   result:              fold accumulator pairs through 64×64→128
+//                        multiplies, avalanche
+//
+// The secret offset moves with the stripe, so swapping two stripes changes
+// the result. Only 32×32→64 multiplies sit in the loop, which SSE2
+// (_mm_mul_epu32) and NEON (vmull_u32) do two lanes at a time, AVX2 four
+// and AVX-512 all eight. Every path produces the same value (not XXH3's,
+// though: own secret and seeding), so a hash recorded on one CPU verifies
+// on another.
+//
+// de100_hash64 runs the widest variant de100_cpu_features() allows.
+// Define DE100_HASH_FORCE_SCALAR to pin the reference path.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+typedef u64 de100_hash64_t(const void *data, u64 size, u64 seed);
+
+/**
+ * Hash `size` bytes. Throughput is memory-bound on large inputs.
+ */
+u64 de100_hash64(const void *data, u64 size, u64 seed);
+
+/**
+ * The variant de100_hash64 would use with `cpu_features` (De100CpuFeature
+ * bits, see cpu.h). For handing to code that can't call engine symbols.
+ *
+ * @param out_name  Receives "scalar" / "sse2" / "avx2" / ... (optional)
+ */
+de100_hash64_t *de100_hash64_select(u32 cpu_features, const char **out_name);
+
+/**
+ * Mix one u64 into a well-distributed u64 (avalanche finalizer).
+ */
+de100_file_scoped_fn inline u64 de100_hash_mix64(u64 value) {
+  value ^= value >> 37;
+  value *= 0x165667919E3779F9ull;
+  value ^= value >> 32;
+  return value;
+}
+
+#endif // DE100_COMMON_HASH_H
@@ -0,0 +1,348 @@
+#include "log.h"
+#include "file.h"
+#include "time.h"
+
+#include <pthread.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ERROR MESSAGES
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_global_var const char *g_log_error_messages[] = {
+    [DE100_LOG_SUCCESS] = "Success",
+    [DE100_LOG_ERROR_ALREADY_ACTIVE] = "Logging is already running",
+    [DE100_LOG_ERROR_OPEN_FAILED] = "Failed to open log file",
+    [DE100_LOG_ERROR_THREAD_CREATE_FAILED] = "Failed to create log writer thread",
+};
+
+const char *de100_log_strerror(De100LogErrorCode code) {
+  if (code >= 0 && code < DE100_LOG_ERROR_COUNT) {
+    return g_log_error_messages[code];
+  }
+  return "Unknown log error";
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// STATE
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define LOG_RING_MASK (DE100_LOG_RING_SIZE - 1)
+#define LOG_WRITE_BUFFER_SIZE (32 * 1024)
+#define LOG_WRITER_IDLE_NS (2 * 1000 * 1000)
+#define LOG_LINE_SIZE (DE100_LOG_MESSAGE_SIZE + 64)
+
+// Bounded MPMC ring (Vyukov): a slot is free for position p when its
+// sequence == p, and holds a message for p when its sequence == p + 1.
+typedef struct {
+  u64 sequence; // __atomic
+  f64 seconds;
+  u32 level;
+  u32 category;
+  char text[DE100_LOG_MESSAGE_SIZE];
+} LogSlot;
+
+typedef struct {
+  u32 level;          // __atomic, runtime floor
+  u32 category_mask;  // __atomic
+  bool is_async;      // __atomic, producers queue instead of writing
+  f64 start_seconds;  // Timestamps are relative to this
+
+  u64 write_index;    // __atomic, claimed by producers
+  u64 read_index;     // Writer only
+  u64 dropped;        // __atomic
+  LogSlot slots[DE100_LOG_RING_SIZE];
+
+  i32 fd;
+  bool owns_fd;
+  pthread_t writer;
+  bool writer_started;
+  bool is_running; // __atomic
+
+  // Writer-only
+  u64 reported_dropped;
+  char buffer[LOG_WRITE_BUFFER_SIZE];
+  u32 buffer_used;
+  bool write_failed;
+} Log;
+
+de100_file_scoped_global_var Log g_log = {
+    .level = DE100_LOG_LEVEL_TRACE,
+    .category_mask = DE100_LOG_ALL,
+    .fd = -1,
+};
+
+de100_file_scoped_global_var const char *g_log_level_names[] = {
+    [DE100_LOG_LEVEL_TRACE] = "TRACE", [DE100_LOG_LEVEL_DEBUG] = "DEBUG",
+    [DE100_LOG_LEVEL_INFO] = "INFO",   [DE100_LOG_LEVEL_WARN] = "WARN",
+    [DE100_LOG_LEVEL_ERROR] = "ERROR",
+};
+
+// Indexed by bit position of De100LogCategory
+de100_file_scoped_global_var const char *g_log_category_names[] = {
+    "engine", "platform", "render", "audio", "input",
+    "replay", "assets",   "timing", "game",  "net",
+};
+
+// ═══════════════════════════════════════════════════════════════════════════
+// FORMATTING
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn const char *log_category_name(u32 category) {
+  for (u32 bit = 0; bit < ArraySize(g_log_category_names); ++bit) {
+    if (category & (1u << bit)) {
+      return g_log_category_names[bit];
+    }
+  }
+  return "-";
+}
+
+/** "[   1.234] WARN  replay   text\n" → line, returns its length. */
+de100_file_scoped_fn u32 log_format_line(char *line, f64 seconds, u32 level,
+                                         u32 category, const char *text) {
+  const char *level_name =
+      level < ArraySize(g_log_level_names) ? g_log_level_names[level] : "?";
+  i32 length = snprintf(line, LOG_LINE_SIZE, "[%8.3f] %-5s %-8s %s\n", seconds,
+                        level_name, log_category_name(category), text);
+  if (length < 0) {
+    return 0;
+  }
+  if (length >= LOG_LINE_SIZE) {
+    length = LOG_LINE_SIZE - 1;
+    line[length - 1] = '\n';
+  }
+  return (u32)length;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// OUTPUT (writer thread)
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn void log_flush(Log *log) {
+  if (log->buffer_used == 0 || log->write_failed) {
+    log->buffer_used = 0;
+    return;
+  }
+  De100FileIOResult result =
+      de100_file_write_all(log->fd, log->buffer, log->buffer_used);
+  if (!result.success) {
+    fprintf(stderr, "[LOG] ⚠️  Write failed, stopping output: %s\n",
+            de100_file_strerror(result.error_code));
+    log->write_failed = true;
+  }
+  log->buffer_used = 0;
+}
+
+de100_file_scoped_fn void log_append(Log *log, const char *line, u32 length) {
+  if (log->buffer_used + length > LOG_WRITE_BUFFER_SIZE) {
+    log_flush(log);
+  }
+  memcpy(log->buffer + log->buffer_used, line, length);
+  log->buffer_used += length;
+}
+
+de100_file_scoped_fn void log_report_dropped(Log *log) {
+  u64 dropped = __atomic_load_n(&log->dropped, __ATOMIC_RELAXED);
+  if (dropped == log->reported_dropped) {
+    return;
+  }
+
+  char text[64];
+  snprintf(text, sizeof(text), "%lu message(s) dropped, ring full",
+           (unsigned long)(dropped - log->reported_dropped));
+  log->reported_dropped = dropped;
+
+  char line[LOG_LINE_SIZE];
+  u32 length =
+      log_format_line(line, de100_get_wall_clock() - log->start_seconds,
+                      DE100_LOG_LEVEL_WARN, DE100_LOG_ENGINE, text);
+  log_append(log, line, length);
+}
+
+/** Write every published message; false when the ring was empty. */
+de100_file_scoped_fn bool log_drain(Log *log) {
+  bool wrote = false;
+  for (;;) {
+    LogSlot *slot = &log->slots[log->read_index & LOG_RING_MASK];
+    u64 sequence = __atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE);
+    if (sequence != log->read_index + 1) {
+      break; // Empty, or the producer is still filling it
+    }
+
+    char line[LOG_LINE_SIZE];
+    u32 length = log_format_line(line, slot->seconds, slot->level,
+                                 slot->category, slot->text);
+    log_append(log, line, length);
+
+    __atomic_store_n(&slot->sequence, log->read_index + DE100_LOG_RING_SIZE,
+                     __ATOMIC_RELEASE);
+    log->read_index++;
+    wrote = true;
+  }
+  log_report_dropped(log);
+  return wrote;
+}
+
+de100_file_scoped_fn void *log_writer_proc(void *arg) {
+  Log *log = (Log *)arg;
+
+  for (;;) {
+    bool running = __atomic_load_n(&log->is_running, __ATOMIC_ACQUIRE);
+    if (!log_drain(log)) {
+      log_flush(log);
+      if (!running) {
+        break; // Stopped and drained
+      }
+      struct timespec idle = {0, LOG_WRITER_IDLE_NS};
+      nanosleep(&idle, NULL);
+    }
+  }
+
+  return NULL;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// PUBLIC API
+// ═══════════════════════════════════════════════════════════════════════════
+
+De100LogResult de100_log_init(const char *path) {
+  De100LogResult result = {0};
+  Log *log = &g_log;
+
+  if (log->writer_started) {
+    result.error_code = DE100_LOG_ERROR_ALREADY_ACTIVE;
+    return result;
+  }
+
+  if (path && path[0]) {
+    De100FileOpenResult open_result = de100_file_open(
+        path, DE100_FILE_WRITE | DE100_FILE_CREATE | DE100_FILE_TRUNCATE);
+    if (!open_result.success) {
+      result.error_code = DE100_LOG_ERROR_OPEN_FAILED;
+      return result;
+    }
+    log->fd = open_result.fd;
+    log->owns_fd = true;
+  } else {
+    fflush(stdout); // Keep order with anything printf'd before us
+    log->fd = 1;
+    log->owns_fd = false;
+  }
+
+  if (log->start_seconds == 0.0) {
+    log->start_seconds = de100_get_wall_clock();
+  }
+  log->read_index = log->write_index = 0;
+  log->reported_dropped = log->dropped = 0;
+  log->buffer_used = 0;
+  log->write_failed = false;
+  for (u64 i = 0; i < DE100_LOG_RING_SIZE; ++i) {
+    log->slots[i].sequence = i;
+  }
+
+  __atomic_store_n(&log->is_running, true, __ATOMIC_RELEASE);
+  if (pthread_create(&log->writer, NULL, log_writer_proc, log) != 0) {
+    __atomic_store_n(&log->is_running, false, __ATOMIC_RELEASE);
+    if (log->owns_fd) {
+      de100_file_close(log->fd);
+    }
+    log->fd = -1;
+    result.error_code = DE100_LOG_ERROR_THREAD_CREATE_FAILED;
+    return result;
+  }
+  log->writer_started = true;
+  __atomic_store_n(&log->is_async, true, __ATOMIC_RELEASE);
+
+  result.success = true;
+  result.error_code = DE100_LOG_SUCCESS;
+  return result;
+}
+
+void de100_log_shutdown(void) {
+  Log *log = &g_log;
+  if (!log->writer_started) {
+    return;
+  }
+
+  // New messages go synchronous; the writer drains what's queued
+  __atomic_store_n(&log->is_async, false, __ATOMIC_RELEASE);
+  __atomic_store_n(&log->is_running, false, __ATOMIC_RELEASE);
+  pthread_join(log->writer, NULL);
+  log->writer_started = false;
+
+  if (log->owns_fd) {
+    de100_file_close(log->fd);
+  }
+  log->fd = -1;
+  log->owns_fd = false;
+}
+
+void de100_log_set_level(u32 level) {
+  __atomic_store_n(&g_log.level, level, __ATOMIC_RELAXED);
+}
+
+void de100_log_set_categories(u32 category_mask) {
+  __atomic_store_n(&g_log.category_mask, category_mask, __ATOMIC_RELAXED);
+}
+
+void de100_log_write(u32 level, u32 category, const char *format, ...) {
+  Log *log = &g_log;
+  if (level < __atomic_load_n(&log->level, __ATOMIC_RELAXED) ||
+      !(category & __atomic_load_n(&log->category_mask, __ATOMIC_RELAXED))) {
+    return;
+  }
+
+  va_list args;
+  va_start(args, format);
+
+  if (!__atomic_load_n(&log->is_async, __ATOMIC_ACQUIRE)) {
+    // No writer: format and write in place
+    char text[DE100_LOG_MESSAGE_SIZE];
+    vsnprintf(text, sizeof(text), format, args);
+    va_end(args);
+
+    if (log->start_seconds == 0.0) {
+      log->start_seconds = de100_get_wall_clock();
+    }
+    char line[LOG_LINE_SIZE];
+    u32 length = log_format_line(
+        line, de100_get_wall_clock() - log->start_seconds, level, category,
+        text);
+    FILE *stream = level >= DE100_LOG_LEVEL_WARN ? stderr : stdout;
+    fwrite(line, 1, length, stream);
+    return;
+  }
+
+  // Claim a slot
+  u64 position = __atomic_load_n(&log->write_index, __ATOMIC_RELAXED);
+  LogSlot *slot;
+  for (;;) {
+    slot = &log->slots[position & LOG_RING_MASK];
+    u64 sequence = __atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE);
+    i64 diff = (i64)(sequence - position);
+    if (diff == 0) {
+      if (__atomic_compare_exchange_n(&log->write_index, &position,
+                                      position + 1, true, __ATOMIC_RELAXED,
+                                      __ATOMIC_RELAXED)) {
+        break;
+      }
+    } else if (diff < 0) {
+      __atomic_fetch_add(&log->dropped, 1, __ATOMIC_RELAXED); // Full
+      va_end(args);
+      return;
+    } else {
+      position = __atomic_load_n(&log->write_index, __ATOMIC_RELAXED);
+    }
+  }
+
+  slot->seconds = de100_get_wall_clock() - log->start_seconds;
+  slot->level = level;
+  slot->category = category;
+  vsnprintf(slot->text, sizeof(slot->text), format, args);
+  va_end(args);
+
+  __atomic_store_n(&slot->sequence, position + 1, __ATOMIC_RELEASE);
+}
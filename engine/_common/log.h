@@ -0,0 +1,152 @@
+#ifndef DE100_COMMON_LOG_H
+#define DE100_COMMON_LOG_H
+
+#include "base.h"
+#include <stdbool.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// LOG (levelled, categorised, written off the frame thread)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+//   DE100_LOG_INFO(DE100_LOG_REPLAY, "Saved state (%.2f MB)", mb);
+//
+// Three filters, cheapest first:
+//
+//   compile time   Calls below DE100_LOG_MIN_LEVEL expand to nothing; the
+//                  arguments are not even evaluated.
+//   level          de100_log_set_level(), for the levels compiled in.
+//   category       de100_log_set_categories(), a bit mask.
+//
+// A message that passes is formatted by the caller into a slot of a
+// bounded multi-producer ring (no locks, no stdio) and a writer thread
+// prefixes it with time / level / category and writes batches to stdout
+// or a file. A full ring drops the message and counts it; the writer
+// reports the count, so a log storm costs lines, never frames.
+//
+//   any thread ──vsnprintf──▶ ring ──▶ writer thread ──▶ fd
+//
+// Before de100_log_init() and after de100_log_shutdown() messages are
+// written synchronously, so early start-up and late shutdown still log.
+//
+// Destination (DE100_LOG environment variable at engine_init):
+//   unset          stdout
+//   path/to/log    File (truncated)
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+// Plain integers so the compile-time filter works in #if
+#define DE100_LOG_LEVEL_TRACE 0
+#define DE100_LOG_LEVEL_DEBUG 1
+#define DE100_LOG_LEVEL_INFO 2
+#define DE100_LOG_LEVEL_WARN 3
+#define DE100_LOG_LEVEL_ERROR 4
+#define DE100_LOG_LEVEL_OFF 5
+
+#ifndef DE100_LOG_MIN_LEVEL
+#if DE100_INTERNAL
+#define DE100_LOG_MIN_LEVEL DE100_LOG_LEVEL_DEBUG
+#else
+#define DE100_LOG_MIN_LEVEL DE100_LOG_LEVEL_INFO
+#endif
+#endif
+
+#define DE100_LOG_RING_SIZE 1024   // Messages, power of two
+#define DE100_LOG_MESSAGE_SIZE 240 // Bytes per message, longer is cut
+
+typedef enum {
+  DE100_LOG_ENGINE = 1u << 0,
+  DE100_LOG_PLATFORM = 1u << 1,
+  DE100_LOG_RENDER = 1u << 2,
+  DE100_LOG_AUDIO = 1u << 3,
+  DE100_LOG_INPUT = 1u << 4,
+  DE100_LOG_REPLAY = 1u << 5,
+  DE100_LOG_ASSETS = 1u << 6,
+  DE100_LOG_TIMING = 1u << 7,
+  DE100_LOG_GAME = 1u << 8,
+  DE100_LOG_NET = 1u << 9,
+
+  DE100_LOG_ALL = 0xFFFFFFFFu
+} De100LogCategory;
+
+typedef enum {
+  DE100_LOG_SUCCESS = 0,
+  DE100_LOG_ERROR_ALREADY_ACTIVE,
+  DE100_LOG_ERROR_OPEN_FAILED,
+  DE100_LOG_ERROR_THREAD_CREATE_FAILED,
+
+  DE100_LOG_ERROR_COUNT
+} De100LogErrorCode;
+
+typedef struct {
+  bool success;
+  De100LogErrorCode error_code;
+} De100LogResult;
+
+// ═══════════════════════════════════════════════════════════════════════════
+// API FUNCTIONS
+// ═══════════════════════════════════════════════════════════════════════════
+
+/**
+ * Start the writer thread. `path` NULL or empty logs to stdout. On
+ * failure logging stays synchronous, which is slower but still works.
+ */
+De100LogResult de100_log_init(const char *path);
+
+/** Drain what's queued, join the writer and close the file. */
+void de100_log_shutdown(void);
+
+/** Runtime floor; levels below DE100_LOG_MIN_LEVEL stay compiled out. */
+void de100_log_set_level(u32 level);
+
+/** Mask of De100LogCategory bits to keep (default DE100_LOG_ALL). */
+void de100_log_set_categories(u32 category_mask);
+
+/**
+ * Queue one message. Use the DE100_LOG_* macros instead so filtered
+ * levels vanish at compile time. Thread safe, never blocks.
+ */
+void de100_log_write(u32 level, u32 category, const char *format, ...)
+    __attribute__((format(printf, 3, 4)));
+
+const char *de100_log_strerror(De100LogErrorCode code);
+
+// ═══════════════════════════════════════════════════════════════════════════
+// MACROS
+// ═══════════════════════════════════════════════════════════════════════════
+
+#if DE100_LOG_MIN_LEVEL <= DE100_LOG_LEVEL_TRACE
+#define DE100_LOG_TRACE(category, ...)                                         \
+  de100_log_write(DE100_LOG_LEVEL_TRACE, (category), __VA_ARGS__)
+#else
+#define DE100_LOG_TRACE(category, ...) ((void)0)
+#endif
+
+#if DE100_LOG_MIN_LEVEL <= DE100_LOG_LEVEL_DEBUG
+#define DE100_LOG_DEBUG(category, ...)                                         \
+  de100_log_write(DE100_LOG_LEVEL_DEBUG, (category), __VA_ARGS__)
+#else
+#define DE100_LOG_DEBUG(category, ...) ((void)0)
+#endif
+
+#if DE100_LOG_MIN_LEVEL <= DE100_LOG_LEVEL_INFO
+#define DE100_LOG_INFO(category, ...)                                          \
+  de100_log_write(DE100_LOG_LEVEL_INFO, (category), __VA_ARGS__)
+#else
+#define DE100_LOG_INFO(category, ...) ((void)0)
+#endif
+
+#if DE100_LOG_MIN_LEVEL <= DE100_LOG_LEVEL_WARN
+#define DE100_LOG_WARN(category, ...)                                          \
+  de100_log_write(DE100_LOG_LEVEL_WARN, (category), __VA_ARGS__)
+#else
+#define DE100_LOG_WARN(category, ...) ((void)0)
+#endif
+
+#if DE100_LOG_MIN_LEVEL <= DE100_LOG_LEVEL_ERROR
+#define DE100_LOG_ERROR(category, ...)                                         \
+  de100_log_write(DE100_LOG_LEVEL_ERROR, (category), __VA_ARGS__)
+#else
+#define DE100_LOG_ERROR(category, ...) ((void)0)
+#endif
+
+#endif // DE100_COMMON_LOG_H
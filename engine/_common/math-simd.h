@@ -0,0 +1,949 @@
+#ifndef DE100_COMMON_MATH_SIMD_H
+#define DE100_COMMON_MATH_SIMD_H
+
+#include "base.h"
+#include "cpu.h"
+#include "math.h"
+
+#include <string.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// SIMD VECTOR MATH (4- and 8-wide lanes, SoA batches)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// The lane-wise companion of math.h, for updating columns of particles,
+// grains, creeps or wireframe points a register at a time:
+//
+//   v4f   4 x f32        v8f   8 x f32
+//   v4i   4 x i32        v8i   8 x i32
+//
+//   for (; i + 8 <= n; i += 8) {
+//     v8f d = de100_v8f_load(dist + i);
+//     v8f speed = de100_v8f_mul(de100_v8f_rsqrt(d), de100_v8f_set1(k));
+//     v8i slow = de100_v8f_lt(speed, de100_v8f_set1(min_speed));
+//     speed = de100_v8f_select(slow, de100_v8f_zero(), speed);
+//     de100_v8f_store(out + i, speed);
+//   }
+//   for (; i < n; ++i) { ... } // Scalar tail, same operations
+//
+// Backends, picked at compile time:
+//
+//   v4*  SSE2 (x86-64 baseline), NEON (AArch64), else a scalar struct
+//   v8*  AVX2 when the build targets it (-mavx2, -march=native), else
+//        two v4 halves, so the same code runs everywhere
+//
+// Comparisons return all-ones / all-zero lanes in the int type of the
+// same width (v4i for v4f): combine them with and/or/andnot, branch on
+// any/all, blend with select.
+//
+// Every operation is exact IEEE add/mul/div/sqrt/convert, and the fast
+// approximations (rsqrt, sincos, floor) are built from those only, so all
+// backends and the scalar tails give the same bits: safe in simulated
+// state and replays. The one exception is a build that contracts a
+// multiply and an add into an FMA (-march with FMA, or AArch64 with
+// -ffp-contract=fast); mul_add is NOT fused on purpose.
+//
+// The SoA batch helpers at the bottom (integrate, axpy, transform,
+// sincos, clamp) run 8 lanes per step plus a scalar tail, with no
+// alignment requirement.
+//
+// Define DE100_SIMD_FORCE_SCALAR to pin the reference path.
+//
+// All functions are static inline for zero overhead if unused.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#if !defined(DE100_SIMD_FORCE_SCALAR) && DE100_CPU_X86
+#define DE100_SIMD_SSE2 1
+#include <emmintrin.h>
+#if defined(__SSE4_1__)
+#include <smmintrin.h>
+#endif
+#if defined(__AVX2__)
+#define DE100_SIMD_AVX2 1
+#include <immintrin.h>
+#endif
+#elif !defined(DE100_SIMD_FORCE_SCALAR) && defined(__aarch64__)
+#define DE100_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+#if DE100_SIMD_SSE2
+typedef __m128 v4f;
+typedef __m128i v4i;
+#elif DE100_SIMD_NEON
+typedef float32x4_t v4f;
+typedef int32x4_t v4i;
+#else
+typedef struct {
+  f32 e[4];
+} v4f;
+typedef struct {
+  i32 e[4];
+} v4i;
+#endif
+
+#if DE100_SIMD_AVX2
+typedef __m256 v8f;
+typedef __m256i v8i;
+#else
+typedef struct {
+  v4f lo, hi;
+} v8f;
+typedef struct {
+  v4i lo, hi;
+} v8i;
+#endif
+
+// ─────────────────────────────────────────────────────────────────────────────
+// v4f / v4i: SSE2
+// ─────────────────────────────────────────────────────────────────────────────
+
+#if DE100_SIMD_SSE2
+
+de100_file_scoped_fn inline v4f de100_v4f_zero(void) {
+  return _mm_setzero_ps();
+}
+de100_file_scoped_fn inline v4f de100_v4f_set1(f32 a) { return _mm_set1_ps(a); }
+de100_file_scoped_fn inline v4f de100_v4f_set(f32 a, f32 b, f32 c, f32 d) {
+  return _mm_setr_ps(a, b, c, d);
+}
+de100_file_scoped_fn inline v4f de100_v4f_load(const f32 *p) {
+  return _mm_loadu_ps(p);
+}
+de100_file_scoped_fn inline void de100_v4f_store(f32 *p, v4f a) {
+  _mm_storeu_ps(p, a);
+}
+de100_file_scoped_fn inline v4f de100_v4f_add(v4f a, v4f b) {
+  return _mm_add_ps(a, b);
+}
+de100_file_scoped_fn inline v4f de100_v4f_sub(v4f a, v4f b) {
+  return _mm_sub_ps(a, b);
+}
+de100_file_scoped_fn inline v4f de100_v4f_mul(v4f a, v4f b) {
+  return _mm_mul_ps(a, b);
+}
+de100_file_scoped_fn inline v4f de100_v4f_div(v4f a, v4f b) {
+  return _mm_div_ps(a, b);
+}
+de100_file_scoped_fn inline v4f de100_v4f_min(v4f a, v4f b) {
+  return _mm_min_ps(a, b);
+}
+de100_file_scoped_fn inline v4f de100_v4f_max(v4f a, v4f b) {
+  return _mm_max_ps(a, b);
+}
+de100_file_scoped_fn inline v4f de100_v4f_sqrt(v4f a) { return _mm_sqrt_ps(a); }
+de100_file_scoped_fn inline v4i de100_v4f_lt(v4f a, v4f b) {
+  return _mm_castps_si128(_mm_cmplt_ps(a, b));
+}
+de100_file_scoped_fn inline v4i de100_v4f_le(v4f a, v4f b) {
+  return _mm_castps_si128(_mm_cmple_ps(a, b));
+}
+de100_file_scoped_fn inline v4i de100_v4f_eq(v4f a, v4f b) {
+  return _mm_castps_si128(_mm_cmpeq_ps(a, b));
+}
+de100_file_scoped_fn inline v4f de100_v4f_select(v4i mask, v4f a, v4f b) {
+  __m128 m = _mm_castsi128_ps(mask);
+  return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b));
+}
+de100_file_scoped_fn inline v4i de100_v4f_to_v4i(v4f a) { // Truncates
+  return _mm_cvttps_epi32(a);
+}
+de100_file_scoped_fn inline v4f de100_v4i_to_v4f(v4i a) {
+  return _mm_cvtepi32_ps(a);
+}
+de100_file_scoped_fn inline v4i de100_v4f_as_v4i(v4f a) {
+  return _mm_castps_si128(a);
+}
+de100_file_scoped_fn inline v4f de100_v4i_as_v4f(v4i a) {
+  return _mm_castsi128_ps(a);
+}
+
+de100_file_scoped_fn inline v4i de100_v4i_zero(void) {
+  return _mm_setzero_si128();
+}
+de100_file_scoped_fn inline v4i de100_v4i_set1(i32 a) {
+  return _mm_set1_epi32(a);
+}
+de100_file_scoped_fn inline v4i de100_v4i_set(i32 a, i32 b, i32 c, i32 d) {
+  return _mm_setr_epi32(a, b, c, d);
+}
+de100_file_scoped_fn inline v4i de100_v4i_load(const i32 *p) {
+  return _mm_loadu_si128((const __m128i *)p);
+}
+de100_file_scoped_fn inline void de100_v4i_store(i32 *p, v4i a) {
+  _mm_storeu_si128((__m128i *)p, a);
+}
+de100_file_scoped_fn inline v4i de100_v4i_add(v4i a, v4i b) {
+  return _mm_add_epi32(a, b);
+}
+de100_file_scoped_fn inline v4i de100_v4i_sub(v4i a, v4i b) {
+  return _mm_sub_epi32(a, b);
+}
+de100_file_scoped_fn inline v4i de100_v4i_mul(v4i a, v4i b) { // Low 32 bits
+#if defined(__SSE4_1__)
+  return _mm_mullo_epi32(a, b);
+#else
+  __m128i even = _mm_mul_epu32(a, b);
+  __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+  return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                            _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+#endif
+}
+de100_file_scoped_fn inline v4i de100_v4i_and(v4i a, v4i b) {
+  return _mm_and_si128(a, b);
+}
+de100_file_scoped_fn inline v4i de100_v4i_or(v4i a, v4i b) {
+  return _mm_or_si128(a, b);
+}
+de100_file_scoped_fn inline v4i de100_v4i_xor(v4i a, v4i b) {
+  return _mm_xor_si128(a, b);
+}
+de100_file_scoped_fn inline v4i de100_v4i_andnot(v4i a, v4i b) { // a & ~b
+  return _mm_andnot_si128(b, a);
+}
+de100_file_scoped_fn inline v4i de100_v4i_shl(v4i a, i32 bits) {
+  return _mm_sll_epi32(a, _mm_cvtsi32_si128(bits));
+}
+de100_file_scoped_fn inline v4i de100_v4i_shr(v4i a, i32 bits) { // Logical
+  return _mm_srl_epi32(a, _mm_cvtsi32_si128(bits));
+}
+de100_file_scoped_fn inline v4i de100_v4i_sra(v4i a, i32 bits) {
+  return _mm_sra_epi32(a, _mm_cvtsi32_si128(bits));
+}
+de100_file_scoped_fn inline v4i de100_v4i_eq(v4i a, v4i b) {
+  return _mm_cmpeq_epi32(a, b);
+}
+de100_file_scoped_fn inline v4i de100_v4i_lt(v4i a, v4i b) {
+  return _mm_cmplt_epi32(a, b);
+}
+de100_file_scoped_fn inline v4i de100_v4i_select(v4i mask, v4i a, v4i b) {
+  return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+// Bit i = sign bit of lane i
+de100_file_scoped_fn inline u32 de100_v4i_movemask(v4i a) {
+  return (u32)_mm_movemask_ps(_mm_castsi128_ps(a));
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// v4f / v4i: NEON
+// ─────────────────────────────────────────────────────────────────────────────
+
+#elif DE100_SIMD_NEON
+
+de100_file_scoped_fn inline v4f de100_v4f_zero(void) { return vdupq_n_f32(0); }
+de100_file_scoped_fn inline v4f de100_v4f_set1(f32 a) { return vdupq_n_f32(a); }
+de100_file_scoped_fn inline v4f de100_v4f_set(f32 a, f32 b, f32 c, f32 d) {
+  f32 lanes[4] = {a, b, c, d};
+  return vld1q_f32(lanes);
+}
+de100_file_scoped_fn inline v4f de100_v4f_load(const f32 *p) {
+  return vld1q_f32(p);
+}
+de100_file_scoped_fn inline void de100_v4f_store(f32 *p, v4f a) {
+  vst1q_f32(p, a);
+}
+de100_file_scoped_fn inline v4f de100_v4f_add(v4f a, v4f b) {
+  return vaddq_f32(a, b);
+}
+de100_file_scoped_fn inline v4f de100_v4f_sub(v4f a, v4f b) {
+  return vsubq_f32(a, b);
+}
+de100_file_scoped_fn inline v4f de100_v4f_mul(v4f a, v4f b) {
+  return vmulq_f32(a, b);
+}
+de100_file_scoped_fn inline v4f de100_v4f_div(v4f a, v4f b) {
+  return vdivq_f32(a, b);
+}
+// SSE semantics: b when either is NaN (vminq would return NaN)
+de100_file_scoped_fn inline v4f de100_v4f_min(v4f a, v4f b) {
+  return vbslq_f32(vcltq_f32(a, b), a, b);
+}
+de100_file_scoped_fn inline v4f de100_v4f_max(v4f a, v4f b) {
+  return vbslq_f32(vcgtq_f32(a, b), a, b);
+}
+de100_file_scoped_fn inline v4f de100_v4f_sqrt(v4f a) { return vsqrtq_f32(a); }
+de100_file_scoped_fn inline v4i de100_v4f_lt(v4f a, v4f b) {
+  return vreinterpretq_s32_u32(vcltq_f32(a, b));
+}
+de100_file_scoped_fn inline v4i de100_v4f_le(v4f a, v4f b) {
+  return vreinterpretq_s32_u32(vcleq_f32(a, b));
+}
+de100_file_scoped_fn inline v4i de100_v4f_eq(v4f a, v4f b) {
+  return vreinterpretq_s32_u32(vceqq_f32(a, b));
+}
+de100_file_scoped_fn inline v4f de100_v4f_select(v4i mask, v4f a, v4f b) {
+  return vbslq_f32(vreinterpretq_u32_s32(mask), a, b);
+}
+de100_file_scoped_fn inline v4i de100_v4f_to_v4i(v4f a) { // Truncates
+  return vcvtq_s32_f32(a);
+}
+de100_file_scoped_fn inline v4f de100_v4i_to_v4f(v4i a) {
+  return vcvtq_f32_s32(a);
+}
+de100_file_scoped_fn inline v4i de100_v4f_as_v4i(v4f a) {
+  return vreinterpretq_s32_f32(a);
+}
+de100_file_scoped_fn inline v4f de100_v4i_as_v4f(v4i a) {
+  return vreinterpretq_f32_s32(a);
+}
+
+de100_file_scoped_fn inline v4i de100_v4i_zero(void) { return vdupq_n_s32(0); }
+de100_file_scoped_fn inline v4i de100_v4i_set1(i32 a) { return vdupq_n_s32(a); }
+de100_file_scoped_fn inline v4i de100_v4i_set(i32 a, i32 b, i32 c, i32 d) {
+  i32 lanes[4] = {a, b, c, d};
+  return vld1q_s32(lanes);
+}
+de100_file_scoped_fn inline v4i de100_v4i_load(const i32 *p) {
+  return vld1q_s32(p);
+}
+de100_file_scoped_fn inline void de100_v4i_store(i32 *p, v4i a) {
+  vst1q_s32(p, a);
+}
+de100_file_scoped_fn inline v4i de100_v4i_add(v4i a, v4i b) {
+  return vaddq_s32(a, b);
+}
+de100_file_scoped_fn inline v4i de100_v4i_sub(v4i a, v4i b) {
+  return vsubq_s32(a, b);
+}
+de100_file_scoped_fn inline v4i de100_v4i_mul(v4i a, v4i b) { // Low 32 bits
+  return vmulq_s32(a, b);
+}
+de100_file_scoped_fn inline v4i de100_v4i_and(v4i a, v4i b) {
+  return vandq_s32(a, b);
+}
+de100_file_scoped_fn inline v4i de100_v4i_or(v4i a, v4i b) {
+  return vorrq_s32(a, b);
+}
+de100_file_scoped_fn inline v4i de100_v4i_xor(v4i a, v4i b) {
+  return veorq_s32(a, b);
+}
+de100_file_scoped_fn inline v4i de100_v4i_andnot(v4i a, v4i b) { // a & ~b
+  return vbicq_s32(a, b);
+}
+de100_file_scoped_fn inline v4i de100_v4i_shl(v4i a, i32 bits) {
+  return vshlq_s32(a, vdupq_n_s32(bits));
+}
+de100_file_scoped_fn inline v4i de100_v4i_shr(v4i a, i32 bits) { // Logical
+  return vreinterpretq_s32_u32(
+      vshlq_u32(vreinterpretq_u32_s32(a), vdupq_n_s32(-bits)));
+}
+de100_file_scoped_fn inline v4i de100_v4i_sra(v4i a, i32 bits) {
+  return vshlq_s32(a, vdupq_n_s32(-bits));
+}
+de100_file_scoped_fn inline v4i de100_v4i_eq(v4i a, v4i b) {
+  return vreinterpretq_s32_u32(vceqq_s32(a, b));
+}
+de100_file_scoped_fn inline v4i de100_v4i_lt(v4i a, v4i b) {
+  return vreinterpretq_s32_u32(vcltq_s32(a, b));
+}
+de100_file_scoped_fn inline v4i de100_v4i_select(v4i mask, v4i a, v4i b) {
+  return vbslq_s32(vreinterpretq_u32_s32(mask), a, b);
+}
+de100_file_scoped_fn inline u32 de100_v4i_movemask(v4i a) {
+  static const u32 bits[4] = {1, 2, 4, 8};
+  uint32x4_t sign = vshrq_n_u32(vreinterpretq_u32_s32(a), 31);
+  return vaddvq_u32(vmulq_u32(sign, vld1q_u32(bits)));
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// v4f / v4i: scalar reference
+// ─────────────────────────────────────────────────────────────────────────────
+
+#else
+
+#define DE100_V4_MAP(type, expr)                                               \
+  type r;                                                                      \
+  for (u32 k = 0; k < 4; ++k) {                                                \
+    r.e[k] = (expr);                                                           \
+  }                                                                            \
+  return r
+
+de100_file_scoped_fn inline v4f de100_v4f_set1(f32 a) {
+  DE100_V4_MAP(v4f, a);
+}
+de100_file_scoped_fn inline v4f de100_v4f_zero(void) {
+  return de100_v4f_set1(0.0f);
+}
+de100_file_scoped_fn inline v4f de100_v4f_set(f32 a, f32 b, f32 c, f32 d) {
+  return (v4f){{a, b, c, d}};
+}
+de100_file_scoped_fn inline v4f de100_v4f_load(const f32 *p) {
+  DE100_V4_MAP(v4f, p[k]);
+}
+de100_file_scoped_fn inline void de100_v4f_store(f32 *p, v4f a) {
+  memcpy(p, a.e, sizeof(a.e));
+}
+de100_file_scoped_fn inline v4f de100_v4f_add(v4f a, v4f b) {
+  DE100_V4_MAP(v4f, a.e[k] + b.e[k]);
+}
+de100_file_scoped_fn inline v4f de100_v4f_sub(v4f a, v4f b) {
+  DE100_V4_MAP(v4f, a.e[k] - b.e[k]);
+}
+de100_file_scoped_fn inline v4f de100_v4f_mul(v4f a, v4f b) {
+  DE100_V4_MAP(v4f, a.e[k] * b.e[k]);
+}
+de100_file_scoped_fn inline v4f de100_v4f_div(v4f a, v4f b) {
+  DE100_V4_MAP(v4f, a.e[k] / b.e[k]);
+}
+de100_file_scoped_fn inline v4f de100_v4f_min(v4f a, v4f b) {
+  DE100_V4_MAP(v4f, a.e[k] < b.e[k] ? a.e[k] : b.e[k]);
+}
+de100_file_scoped_fn inline v4f de100_v4f_max(v4f a, v4f b) {
+  DE100_V4_MAP(v4f, a.e[k] > b.e[k] ? a.e[k] : b.e[k]);
+}
+de100_file_scoped_fn inline v4f de100_v4f_sqrt(v4f a) {
+  DE100_V4_MAP(v4f, __builtin_sqrtf(a.e[k]));
+}
+de100_file_scoped_fn inline v4i de100_v4f_lt(v4f a, v4f b) {
+  DE100_V4_MAP(v4i, -(i32)(a.e[k] < b.e[k]));
+}
+de100_file_scoped_fn inline v4i de100_v4f_le(v4f a, v4f b) {
+  DE100_V4_MAP(v4i, -(i32)(a.e[k] <= b.e[k]));
+}
+de100_file_scoped_fn inline v4i de100_v4f_eq(v4f a, v4f b) {
+  DE100_V4_MAP(v4i, -(i32)(a.e[k] == b.e[k]));
+}
+de100_file_scoped_fn inline v4f de100_v4f_select(v4i mask, v4f a, v4f b) {
+  DE100_V4_MAP(v4f, mask.e[k] < 0 ? a.e[k] : b.e[k]);
+}
+// Out of range gives INT32_MIN, like cvttps
+de100_file_scoped_fn inline v4i de100_v4f_to_v4i(v4f a) {
+  DE100_V4_MAP(v4i, a.e[k] > -2147483648.0f && a.e[k] < 2147483648.0f
+                        ? (i32)a.e[k]
+                        : DE100_I32_MIN);
+}
+de100_file_scoped_fn inline v4f de100_v4i_to_v4f(v4i a) {
+  DE100_V4_MAP(v4f, (f32)a.e[k]);
+}
+de100_file_scoped_fn inline v4i de100_v4f_as_v4i(v4f a) {
+  v4i r;
+  memcpy(&r, &a, sizeof(r));
+  return r;
+}
+de100_file_scoped_fn inline v4f de100_v4i_as_v4f(v4i a) {
+  v4f r;
+  memcpy(&r, &a, sizeof(r));
+  return r;
+}
+
+de100_file_scoped_fn inline v4i de100_v4i_set1(i32 a) {
+  DE100_V4_MAP(v4i, a);
+}
+de100_file_scoped_fn inline v4i de100_v4i_zero(void) {
+  return de100_v4i_set1(0);
+}
+de100_file_scoped_fn inline v4i de100_v4i_set(i32 a, i32 b, i32 c, i32 d) {
+  return (v4i){{a, b, c, d}};
+}
+de100_file_scoped_fn inline v4i de100_v4i_load(const i32 *p) {
+  DE100_V4_MAP(v4i, p[k]);
+}
+de100_file_scoped_fn inline void de100_v4i_store(i32 *p, v4i a) {
+  memcpy(p, a.e, sizeof(a.e));
+}
+// Integer lanes wrap: do the arithmetic unsigned
+de100_file_scoped_fn inline v4i de100_v4i_add(v4i a, v4i b) {
+  DE100_V4_MAP(v4i, (i32)((u32)a.e[k] + (u32)b.e[k]));
+}
+de100_file_scoped_fn inline v4i de100_v4i_sub(v4i a, v4i b) {
+  DE100_V4_MAP(v4i, (i32)((u32)a.e[k] - (u32)b.e[k]));
+}
+de100_file_scoped_fn inline v4i de100_v4i_mul(v4i a, v4i b) {
+  DE100_V4_MAP(v4i, (i32)((u32)a.e[k] * (u32)b.e[k]));
+}
+de100_file_scoped_fn inline v4i de100_v4i_and(v4i a, v4i b) {
+  DE100_V4_MAP(v4i, a.e[k] & b.e[k]);
+}
+de100_file_scoped_fn inline v4i de100_v4i_or(v4i a, v4i b) {
+  DE100_V4_MAP(v4i, a.e[k] | b.e[k]);
+}
+de100_file_scoped_fn inline v4i de100_v4i_xor(v4i a, v4i b) {
+  DE100_V4_MAP(v4i, a.e[k] ^ b.e[k]);
+}
+de100_file_scoped_fn inline v4i de100_v4i_andnot(v4i a, v4i b) {
+  DE100_V4_MAP(v4i, a.e[k] & ~b.e[k]);
+}
+de100_file_scoped_fn inline v4i de100_v4i_shl(v4i a, i32 bits) {
+  DE100_V4_MAP(v4i, (i32)((u32)a.e[k] << bits));
+}
+de100_file_scoped_fn inline v4i de100_v4i_shr(v4i a, i32 bits) {
+  DE100_V4_MAP(v4i, (i32)((u32)a.e[k] >> bits));
+}
+de100_file_scoped_fn inline v4i de100_v4i_sra(v4i a, i32 bits) {
+  DE100_V4_MAP(v4i, a.e[k] >> bits);
+}
+de100_file_scoped_fn inline v4i de100_v4i_eq(v4i a, v4i b) {
+  DE100_V4_MAP(v4i, -(i32)(a.e[k] == b.e[k]));
+}
+de100_file_scoped_fn inline v4i de100_v4i_lt(v4i a, v4i b) {
+  DE100_V4_MAP(v4i, -(i32)(a.e[k] < b.e[k]));
+}
+de100_file_scoped_fn inline v4i de100_v4i_select(v4i mask, v4i a, v4i b) {
+  DE100_V4_MAP(v4i, mask.e[k] < 0 ? a.e[k] : b.e[k]);
+}
+de100_file_scoped_fn inline u32 de100_v4i_movemask(v4i a) {
+  u32 bits = 0;
+  for (u32 k = 0; k < 4; ++k) {
+    bits |= (u32)(a.e[k] < 0) << k;
+  }
+  return bits;
+}
+
+#undef DE100_V4_MAP
+#endif
+
+// ─────────────────────────────────────────────────────────────────────────────
+// v8f / v8i: AVX2
+// ─────────────────────────────────────────────────────────────────────────────
+
+#if DE100_SIMD_AVX2
+
+de100_file_scoped_fn inline v8f de100_v8f_zero(void) {
+  return _mm256_setzero_ps();
+}
+de100_file_scoped_fn inline v8f de100_v8f_set1(f32 a) {
+  return _mm256_set1_ps(a);
+}
+de100_file_scoped_fn inline v8f de100_v8f_load(const f32 *p) {
+  return _mm256_loadu_ps(p);
+}
+de100_file_scoped_fn inline void de100_v8f_store(f32 *p, v8f a) {
+  _mm256_storeu_ps(p, a);
+}
+de100_file_scoped_fn inline v8f de100_v8f_add(v8f a, v8f b) {
+  return _mm256_add_ps(a, b);
+}
+de100_file_scoped_fn inline v8f de100_v8f_sub(v8f a, v8f b) {
+  return _mm256_sub_ps(a, b);
+}
+de100_file_scoped_fn inline v8f de100_v8f_mul(v8f a, v8f b) {
+  return _mm256_mul_ps(a, b);
+}
+de100_file_scoped_fn inline v8f de100_v8f_div(v8f a, v8f b) {
+  return _mm256_div_ps(a, b);
+}
+de100_file_scoped_fn inline v8f de100_v8f_min(v8f a, v8f b) {
+  return _mm256_min_ps(a, b);
+}
+de100_file_scoped_fn inline v8f de100_v8f_max(v8f a, v8f b) {
+  return _mm256_max_ps(a, b);
+}
+de100_file_scoped_fn inline v8f de100_v8f_sqrt(v8f a) {
+  return _mm256_sqrt_ps(a);
+}
+de100_file_scoped_fn inline v8i de100_v8f_lt(v8f a, v8f b) {
+  return _mm256_castps_si256(_mm256_cmp_ps(a, b, _CMP_LT_OQ));
+}
+de100_file_scoped_fn inline v8i de100_v8f_le(v8f a, v8f b) {
+  return _mm256_castps_si256(_mm256_cmp_ps(a, b, _CMP_LE_OQ));
+}
+de100_file_scoped_fn inline v8i de100_v8f_eq(v8f a, v8f b) {
+  return _mm256_castps_si256(_mm256_cmp_ps(a, b, _CMP_EQ_OQ));
+}
+de100_file_scoped_fn inline v8f de100_v8f_select(v8i mask, v8f a, v8f b) {
+  return _mm256_blendv_ps(b, a, _mm256_castsi256_ps(mask));
+}
+de100_file_scoped_fn inline v8i de100_v8f_to_v8i(v8f a) { // Truncates
+  return _mm256_cvttps_epi32(a);
+}
+de100_file_scoped_fn inline v8f de100_v8i_to_v8f(v8i a) {
+  return _mm256_cvtepi32_ps(a);
+}
+de100_file_scoped_fn inline v8i de100_v8f_as_v8i(v8f a) {
+  return _mm256_castps_si256(a);
+}
+de100_file_scoped_fn inline v8f de100_v8i_as_v8f(v8i a) {
+  return _mm256_castsi256_ps(a);
+}
+
+de100_file_scoped_fn inline v8i de100_v8i_zero(void) {
+  return _mm256_setzero_si256();
+}
+de100_file_scoped_fn inline v8i de100_v8i_set1(i32 a) {
+  return _mm256_set1_epi32(a);
+}
+de100_file_scoped_fn inline v8i de100_v8i_load(const i32 *p) {
+  return _mm256_loadu_si256((const __m256i *)p);
+}
+de100_file_scoped_fn inline void de100_v8i_store(i32 *p, v8i a) {
+  _mm256_storeu_si256((__m256i *)p, a);
+}
+de100_file_scoped_fn inline v8i de100_v8i_add(v8i a, v8i b) {
+  return _mm256_add_epi32(a, b);
+}
+de100_file_scoped_fn inline v8i de100_v8i_sub(v8i a, v8i b) {
+  return _mm256_sub_epi32(a, b);
+}
+de100_file_scoped_fn inline v8i de100_v8i_mul(v8i a, v8i b) {
+  return _mm256_mullo_epi32(a, b);
+}
+de100_file_scoped_fn inline v8i de100_v8i_and(v8i a, v8i b) {
+  return _mm256_and_si256(a, b);
+}
+de100_file_scoped_fn inline v8i de100_v8i_or(v8i a, v8i b) {
+  return _mm256_or_si256(a, b);
+}
+de100_file_scoped_fn inline v8i de100_v8i_xor(v8i a, v8i b) {
+  return _mm256_xor_si256(a, b);
+}
+de100_file_scoped_fn inline v8i de100_v8i_andnot(v8i a, v8i b) {
+  return _mm256_andnot_si256(b, a);
+}
+de100_file_scoped_fn inline v8i de100_v8i_shl(v8i a, i32 bits) {
+  return _mm256_sll_epi32(a, _mm_cvtsi32_si128(bits));
+}
+de100_file_scoped_fn inline v8i de100_v8i_shr(v8i a, i32 bits) {
+  return _mm256_srl_epi32(a, _mm_cvtsi32_si128(bits));
+}
+de100_file_scoped_fn inline v8i de100_v8i_sra(v8i a, i32 bits) {
+  return _mm256_sra_epi32(a, _mm_cvtsi32_si128(bits));
+}
+de100_file_scoped_fn inline v8i de100_v8i_eq(v8i a, v8i b) {
+  return _mm256_cmpeq_epi32(a, b);
+}
+de100_file_scoped_fn inline v8i de100_v8i_lt(v8i a, v8i b) {
+  return _mm256_cmpgt_epi32(b, a);
+}
+de100_file_scoped_fn inline v8i de100_v8i_select(v8i mask, v8i a, v8i b) {
+  return _mm256_blendv_epi8(b, a, mask);
+}
+de100_file_scoped_fn inline u32 de100_v8i_movemask(v8i a) {
+  return (u32)_mm256_movemask_ps(_mm256_castsi256_ps(a));
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// v8f / v8i: two v4 halves
+// ─────────────────────────────────────────────────────────────────────────────
+
+#else
+
+#define DE100_V8_UNARY(type, name, arg, half)                                  \
+  de100_file_scoped_fn inline type de100_##name(arg a) {                       \
+    return (type){de100_##half(a.lo), de100_##half(a.hi)};                    \
+  }
+#define DE100_V8_BINARY(type, name, arg, half)                                 \
+  de100_file_scoped_fn inline type de100_##name(arg a, arg b) {                \
+    return (type){de100_##half(a.lo, b.lo), de100_##half(a.hi, b.hi)};        \
+  }
+#define DE100_V8_SHIFT(name, half)                                             \
+  de100_file_scoped_fn inline v8i de100_##name(v8i a, i32 bits) {              \
+    return (v8i){de100_##half(a.lo, bits), de100_##half(a.hi, bits)};         \
+  }
+
+de100_file_scoped_fn inline v8f de100_v8f_zero(void) {
+  return (v8f){de100_v4f_zero(), de100_v4f_zero()};
+}
+de100_file_scoped_fn inline v8f de100_v8f_set1(f32 a) {
+  return (v8f){de100_v4f_set1(a), de100_v4f_set1(a)};
+}
+de100_file_scoped_fn inline v8f de100_v8f_load(const f32 *p) {
+  return (v8f){de100_v4f_load(p), de100_v4f_load(p + 4)};
+}
+de100_file_scoped_fn inline void de100_v8f_store(f32 *p, v8f a) {
+  de100_v4f_store(p, a.lo);
+  de100_v4f_store(p + 4, a.hi);
+}
+DE100_V8_BINARY(v8f, v8f_add, v8f, v4f_add)
+DE100_V8_BINARY(v8f, v8f_sub, v8f, v4f_sub)
+DE100_V8_BINARY(v8f, v8f_mul, v8f, v4f_mul)
+DE100_V8_BINARY(v8f, v8f_div, v8f, v4f_div)
+DE100_V8_BINARY(v8f, v8f_min, v8f, v4f_min)
+DE100_V8_BINARY(v8f, v8f_max, v8f, v4f_max)
+DE100_V8_UNARY(v8f, v8f_sqrt, v8f, v4f_sqrt)
+DE100_V8_BINARY(v8i, v8f_lt, v8f, v4f_lt)
+DE100_V8_BINARY(v8i, v8f_le, v8f, v4f_le)
+DE100_V8_BINARY(v8i, v8f_eq, v8f, v4f_eq)
+de100_file_scoped_fn inline v8f de100_v8f_select(v8i mask, v8f a, v8f b) {
+  return (v8f){de100_v4f_select(mask.lo, a.lo, b.lo),
+               de100_v4f_select(mask.hi, a.hi, b.hi)};
+}
+DE100_V8_UNARY(v8i, v8f_to_v8i, v8f, v4f_to_v4i)
+DE100_V8_UNARY(v8f, v8i_to_v8f, v8i, v4i_to_v4f)
+DE100_V8_UNARY(v8i, v8f_as_v8i, v8f, v4f_as_v4i)
+DE100_V8_UNARY(v8f, v8i_as_v8f, v8i, v4i_as_v4f)
+
+de100_file_scoped_fn inline v8i de100_v8i_zero(void) {
+  return (v8i){de100_v4i_zero(), de100_v4i_zero()};
+}
+de100_file_scoped_fn inline v8i de100_v8i_set1(i32 a) {
+  return (v8i){de100_v4i_set1(a), de100_v4i_set1(a)};
+}
+de100_file_scoped_fn inline v8i de100_v8i_load(const i32 *p) {
+  return (v8i){de100_v4i_load(p), de100_v4i_load(p + 4)};
+}
+de100_file_scoped_fn inline void de100_v8i_store(i32 *p, v8i a) {
+  de100_v4i_store(p, a.lo);
+  de100_v4i_store(p + 4, a.hi);
+}
+DE100_V8_BINARY(v8i, v8i_add, v8i, v4i_add)
+DE100_V8_BINARY(v8i, v8i_sub, v8i, v4i_sub)
+DE100_V8_BINARY(v8i, v8i_mul, v8i, v4i_mul)
+DE100_V8_BINARY(v8i, v8i_and, v8i, v4i_and)
+DE100_V8_BINARY(v8i, v8i_or, v8i, v4i_or)
+DE100_V8_BINARY(v8i, v8i_xor, v8i, v4i_xor)
+DE100_V8_BINARY(v8i, v8i_andnot, v8i, v4i_andnot)
+DE100_V8_SHIFT(v8i_shl, v4i_shl)
+DE100_V8_SHIFT(v8i_shr, v4i_shr)
+DE100_V8_SHIFT(v8i_sra, v4i_sra)
+DE100_V8_BINARY(v8i, v8i_eq, v8i, v4i_eq)
+DE100_V8_BINARY(v8i, v8i_lt, v8i, v4i_lt)
+de100_file_scoped_fn inline v8i de100_v8i_select(v8i mask, v8i a, v8i b) {
+  return (v8i){de100_v4i_select(mask.lo, a.lo, b.lo),
+               de100_v4i_select(mask.hi, a.hi, b.hi)};
+}
+de100_file_scoped_fn inline u32 de100_v8i_movemask(v8i a) {
+  return de100_v4i_movemask(a.lo) | (de100_v4i_movemask(a.hi) << 4);
+}
+
+#undef DE100_V8_UNARY
+#undef DE100_V8_BINARY
+#undef DE100_V8_SHIFT
+#endif
+
+// ═══════════════════════════════════════════════════════════════════════════
+// DERIVED OPERATIONS (same code for every width and backend)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// rsqrt   1/sqrt(x) for x > 0: bit-trick estimate + two Newton steps,
+//         ~5e-6 relative error. 0 gives a large finite value, not inf.
+// floor   exact for |x| < 2^31
+// sincos  Cody-Waite reduction to [-pi/4, pi/4] + minimax polynomials,
+//         ~1e-7 absolute error for |x| < 8192 (degrades beyond)
+
+#define DE100_SIMD_DEFINE_DERIVED(f, i, lanes)                                 \
+  /* a * b + c, never fused */                                                 \
+  de100_file_scoped_fn inline f de100_##f##_mul_add(f a, f b, f c) {           \
+    return de100_##f##_add(de100_##f##_mul(a, b), c);                          \
+  }                                                                            \
+  de100_file_scoped_fn inline f de100_##f##_clamp(f x, f lo, f hi) {          \
+    return de100_##f##_min(de100_##f##_max(x, lo), hi);                        \
+  }                                                                            \
+  de100_file_scoped_fn inline f de100_##f##_abs(f x) {                         \
+    return de100_##i##_as_##f(de100_##i##_and(                                 \
+        de100_##f##_as_##i(x), de100_##i##_set1(0x7fffffff)));                 \
+  }                                                                            \
+  de100_file_scoped_fn inline f de100_##f##_neg(f x) {                         \
+    return de100_##i##_as_##f(de100_##i##_xor(                                 \
+        de100_##f##_as_##i(x), de100_##i##_set1(DE100_I32_MIN)));              \
+  }                                                                            \
+  de100_file_scoped_fn inline i de100_##f##_gt(f a, f b) {                     \
+    return de100_##f##_lt(b, a);                                               \
+  }                                                                            \
+  de100_file_scoped_fn inline i de100_##f##_ge(f a, f b) {                     \
+    return de100_##f##_le(b, a);                                               \
+  }                                                                            \
+  de100_file_scoped_fn inline i de100_##i##_gt(i a, i b) {                     \
+    return de100_##i##_lt(b, a);                                               \
+  }                                                                            \
+  de100_file_scoped_fn inline i de100_##i##_min(i a, i b) {                    \
+    return de100_##i##_select(de100_##i##_lt(a, b), a, b);                     \
+  }                                                                            \
+  de100_file_scoped_fn inline i de100_##i##_max(i a, i b) {                    \
+    return de100_##i##_select(de100_##i##_lt(b, a), a, b);                     \
+  }                                                                            \
+  de100_file_scoped_fn inline i de100_##i##_not(i a) {                         \
+    return de100_##i##_xor(a, de100_##i##_set1(-1));                           \
+  }                                                                            \
+  de100_file_scoped_fn inline bool de100_##i##_any(i mask) {                   \
+    return de100_##i##_movemask(mask) != 0;                                    \
+  }                                                                            \
+  de100_file_scoped_fn inline bool de100_##i##_all(i mask) {                   \
+    return de100_##i##_movemask(mask) == (1u << (lanes)) - 1;                  \
+  }                                                                            \
+  de100_file_scoped_fn inline f de100_##f##_floor(f x) {                       \
+    f t = de100_##i##_to_##f(de100_##f##_to_##i(x));                           \
+    i one = de100_##f##_as_##i(de100_##f##_set1(1.0f));                        \
+    i above = de100_##i##_and(de100_##f##_gt(t, x), one);                      \
+    return de100_##f##_sub(t, de100_##i##_as_##f(above));                      \
+  }                                                                            \
+  de100_file_scoped_fn inline f de100_##f##_rsqrt(f x) {                       \
+    f half_x = de100_##f##_mul(x, de100_##f##_set1(0.5f));                     \
+    f three_halves = de100_##f##_set1(1.5f);                                   \
+    i bits = de100_##i##_shr(de100_##f##_as_##i(x), 1);                       \
+    f y = de100_##i##_as_##f(                                                  \
+        de100_##i##_sub(de100_##i##_set1(0x5f375a86), bits));                  \
+    for (u32 step = 0; step < 2; ++step) {                                     \
+      f yy = de100_##f##_mul(y, y);                                            \
+      y = de100_##f##_mul(                                                     \
+          y, de100_##f##_sub(three_halves, de100_##f##_mul(half_x, yy)));      \
+    }                                                                          \
+    return y;                                                                  \
+  }                                                                            \
+  de100_file_scoped_fn inline void de100_##f##_sincos(f x, f *out_sin,         \
+                                                      f *out_cos) {            \
+    /* x = q * pi/2 + r, pi/2 split in three so q * part is exact */          \
+    f q = de100_##f##_floor(de100_##f##_mul_add(                               \
+        x, de100_##f##_set1(0.63661977236f), de100_##f##_set1(0.5f)));         \
+    f r = de100_##f##_sub(                                                     \
+        x, de100_##f##_mul(q, de100_##f##_set1(1.5703125f)));                  \
+    r = de100_##f##_sub(                                                       \
+        r, de100_##f##_mul(q, de100_##f##_set1(4.837512969970703125e-4f)));    \
+    r = de100_##f##_sub(                                                       \
+        r, de100_##f##_mul(q, de100_##f##_set1(7.54978995489188216e-8f)));     \
+    f r2 = de100_##f##_mul(r, r);                                              \
+    f s = de100_##f##_mul_add(de100_##f##_set1(-1.9515295891e-4f), r2,         \
+                              de100_##f##_set1(8.3321608736e-3f));             \
+    s = de100_##f##_mul_add(s, r2, de100_##f##_set1(-1.6666654611e-1f));       \
+    s = de100_##f##_mul_add(de100_##f##_mul(s, r2), r, r);                     \
+    f c = de100_##f##_mul_add(de100_##f##_set1(2.443315711809948e-5f), r2,     \
+                              de100_##f##_set1(-1.388731625493765e-3f));       \
+    c = de100_##f##_mul_add(c, r2, de100_##f##_set1(4.166664568298827e-2f));   \
+    c = de100_##f##_mul(de100_##f##_mul(c, r2), r2);                           \
+    c = de100_##f##_add(                                                       \
+        de100_##f##_sub(c, de100_##f##_mul(r2, de100_##f##_set1(0.5f))),       \
+        de100_##f##_set1(1.0f));                                               \
+    /* Odd quadrants swap; sin flips in 2-3, cos in 1-2 */                     \
+    i quadrant = de100_##f##_to_##i(q);                                        \
+    i one = de100_##i##_set1(1), two = de100_##i##_set1(2);                    \
+    i swap = de100_##i##_eq(de100_##i##_and(quadrant, one), one);              \
+    i sin_sign = de100_##i##_shl(de100_##i##_and(quadrant, two), 30);          \
+    i cos_sign = de100_##i##_shl(                                              \
+        de100_##i##_and(de100_##i##_add(quadrant, one), two), 30);             \
+    *out_sin = de100_##i##_as_##f(de100_##i##_xor(                             \
+        de100_##f##_as_##i(de100_##f##_select(swap, c, s)), sin_sign));        \
+    *out_cos = de100_##i##_as_##f(de100_##i##_xor(                             \
+        de100_##f##_as_##i(de100_##f##_select(swap, s, c)), cos_sign));        \
+  }
+
+DE100_SIMD_DEFINE_DERIVED(v4f, v4i, 4)
+DE100_SIMD_DEFINE_DERIVED(v8f, v8i, 8)
+
+// Scalar twins, for the tails of the batch loops: same operations, so a
+// value gives the same bits whichever lane (or tail) computes it
+
+de100_file_scoped_fn inline void de100_simd_lane_sincos(f32 x, f32 *out_sin,
+                                                        f32 *out_cos) {
+  v4f s, c;
+  de100_v4f_sincos(de100_v4f_set1(x), &s, &c);
+  f32 lanes[4];
+  de100_v4f_store(lanes, s);
+  *out_sin = lanes[0];
+  de100_v4f_store(lanes, c);
+  *out_cos = lanes[0];
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// SoA BATCHES
+// ═══════════════════════════════════════════════════════════════════════════
+
+/**
+ * Semi-implicit Euler along one axis: vel += acc * dt, then
+ * pos += vel * dt. Call once per axis; columns may be unaligned.
+ */
+de100_file_scoped_fn inline void de100_soa_integrate(f32 *pos, f32 *vel,
+                                                     const f32 *acc, u32 n,
+                                                     f32 dt) {
+  u32 i = 0;
+  v8f vdt = de100_v8f_set1(dt);
+  for (; i + 8 <= n; i += 8) {
+    v8f v = de100_v8f_add(de100_v8f_load(vel + i),
+                          de100_v8f_mul(de100_v8f_load(acc + i), vdt));
+    de100_v8f_store(vel + i, v);
+    de100_v8f_store(pos + i, de100_v8f_add(de100_v8f_load(pos + i),
+                                           de100_v8f_mul(v, vdt)));
+  }
+  // Separate statements: no FMA contraction, same rounding as the vectors
+  for (; i < n; ++i) {
+    f32 dv = acc[i] * dt;
+    vel[i] += dv;
+    f32 dp = vel[i] * dt;
+    pos[i] += dp;
+  }
+}
+
+/** y[i] += a * x[i] */
+de100_file_scoped_fn inline void de100_soa_axpy(f32 *y, const f32 *x, f32 a,
+                                                u32 n) {
+  u32 i = 0;
+  v8f va = de100_v8f_set1(a);
+  for (; i + 8 <= n; i += 8) {
+    v8f d = de100_v8f_mul(va, de100_v8f_load(x + i));
+    de100_v8f_store(y + i, de100_v8f_add(de100_v8f_load(y + i), d));
+  }
+  for (; i < n; ++i) {
+    f32 d = a * x[i];
+    y[i] += d;
+  }
+}
+
+/** x[i] = clamp(x[i], lo, hi) */
+de100_file_scoped_fn inline void de100_soa_clamp(f32 *x, u32 n, f32 lo,
+                                                 f32 hi) {
+  u32 i = 0;
+  v8f vlo = de100_v8f_set1(lo), vhi = de100_v8f_set1(hi);
+  for (; i + 8 <= n; i += 8) {
+    de100_v8f_store(x + i, de100_v8f_clamp(de100_v8f_load(x + i), vlo, vhi));
+  }
+  for (; i < n; ++i) {
+    f32 v = x[i] > lo ? x[i] : lo;
+    x[i] = v < hi ? v : hi;
+  }
+}
+
+/** Sine and cosine of every angle (radians; see sincos above). */
+de100_file_scoped_fn inline void de100_soa_sincos(const f32 *angle,
+                                                  f32 *out_sin, f32 *out_cos,
+                                                  u32 n) {
+  u32 i = 0;
+  for (; i + 8 <= n; i += 8) {
+    v8f s, c;
+    de100_v8f_sincos(de100_v8f_load(angle + i), &s, &c);
+    de100_v8f_store(out_sin + i, s);
+    de100_v8f_store(out_cos + i, c);
+  }
+  for (; i < n; ++i) {
+    de100_simd_lane_sincos(angle[i], &out_sin[i], &out_cos[i]);
+  }
+}
+
+/**
+ * 2D affine transform (row-major 2x3):
+ *   x' = xx * x + xy * y + tx
+ *   y' = yx * x + yy * y + ty
+ */
+typedef struct {
+  f32 xx, xy, tx;
+  f32 yx, yy, ty;
+} De100SimdAffine2;
+
+/**
+ * Rotate by `angle` (radians, +x toward +y), scale, then translate: the
+ * usual model transform for a wireframe or sprite outline.
+ */
+de100_file_scoped_fn inline De100SimdAffine2
+de100_simd_affine2(f32 angle, f32 scale, f32 tx, f32 ty) {
+  f32 s, c;
+  de100_simd_lane_sincos(angle, &s, &c);
+  return (De100SimdAffine2){c * scale, -s * scale, tx,
+                            s * scale, c * scale,  ty};
+}
+
+/**
+ * Transform n points; out may alias in (point by point, same index).
+ */
+de100_file_scoped_fn inline void
+de100_soa_transform2(f32 *out_x, f32 *out_y, const f32 *in_x,
+                     const f32 *in_y, u32 n, const De100SimdAffine2 *m) {
+  u32 i = 0;
+  v8f xx = de100_v8f_set1(m->xx), xy = de100_v8f_set1(m->xy);
+  v8f yx = de100_v8f_set1(m->yx), yy = de100_v8f_set1(m->yy);
+  v8f tx = de100_v8f_set1(m->tx), ty = de100_v8f_set1(m->ty);
+  for (; i + 8 <= n; i += 8) {
+    v8f x = de100_v8f_load(in_x + i), y = de100_v8f_load(in_y + i);
+    v8f rx = de100_v8f_add(de100_v8f_mul(xx, x), de100_v8f_mul(xy, y));
+    v8f ry = de100_v8f_add(de100_v8f_mul(yx, x), de100_v8f_mul(yy, y));
+    de100_v8f_store(out_x + i, de100_v8f_add(rx, tx));
+    de100_v8f_store(out_y + i, de100_v8f_add(ry, ty));
+  }
+  for (; i < n; ++i) {
+    f32 x = in_x[i], y = in_y[i];
+    f32 ax = m->xx * x, bx = m->xy * y;
+    f32 ay = m->yx * x, by = m->yy * y;
+    f32 rx = ax + bx, ry = ay + by;
+    out_x[i] = rx + m->tx;
+    out_y[i] = ry + m->ty;
+  }
+}
+
+#endif // DE100_COMMON_MATH_SIMD_H
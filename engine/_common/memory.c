@@ -1,3 +1,7 @@
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE // mremap, MREMAP_MAYMOVE / MREMAP_FIXED
+#endif
+
 #include "memory.h"
 
 #if DE100_INTERNAL && DE100_SLOW
@@ -11,6 +15,11 @@
 
 #include <string.h>
 
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h> // _mm_stream_si128
+#define DE100_MEM_HAS_STREAMING 1
+#endif
+
 // ═══════════════════════════════════════════════════════════════════════════
 // PLATFORM INCLUDES
 // ═══════════════════════════════════════════════════════════════════════════
@@ -24,6 +33,9 @@
 #include <errno.h>
 #include <sys/mman.h>
 #include <unistd.h>
+#if defined(__linux__)
+#include <sys/syscall.h>
+#endif
 #else
 #error "Unsupported platform"
 #endif
@@ -48,6 +60,25 @@ size_t de100_memory_page_size(void) {
   return g_page_size;
 }
 
+de100_file_scoped_global_var size_t g_large_page_size = 0;
+de100_file_scoped_global_var bool g_large_page_size_queried = false;
+
+size_t de100_memory_large_page_size(void) {
+  if (!g_large_page_size_queried) {
+#if defined(_WIN32)
+    g_large_page_size = (size_t)GetLargePageMinimum();
+#elif defined(__linux__) && (defined(__x86_64__) || defined(__aarch64__))
+    // PMD-sized pages on the default 4 KB granule; other granules simply
+    // get fewer THP hits (the hint is best-effort)
+    g_large_page_size = (size_t)MEGABYTES(2);
+#else
+    g_large_page_size = 0;
+#endif
+    g_large_page_size_queried = true;
+  }
+  return g_large_page_size;
+}
+
 // ═══════════════════════════════════════════════════════════════════════════
 // ERROR MESSAGES
 // ═══════════════════════════════════════════════════════════════════════════
@@ -265,7 +296,90 @@ de100_file_scoped_fn inline int posix_protection_flags(De100MemoryFlags flags) {
   return prot;
 }
 
+/**
+ * Bind [address, address + size) to the calling thread's NUMA node
+ * (MPOL_PREFERRED: other nodes still serve it when this one is full).
+ * Raw syscalls so there is no libnuma dependency; silently a no-op on
+ * single-node machines and kernels without NUMA.
+ */
+de100_file_scoped_fn inline void posix_bind_numa_local(void *address,
+                                                       size_t size) {
+#if defined(__linux__) && defined(SYS_mbind) && defined(SYS_getcpu)
+  unsigned cpu = 0, node = 0;
+  if (syscall(SYS_getcpu, &cpu, &node, NULL) != 0 || node >= 63) {
+    return;
+  }
+  unsigned long node_mask = 1ul << node;
+  const int mpol_preferred = 1; // <linux/mempolicy.h>
+  syscall(SYS_mbind, address, size, mpol_preferred, &node_mask,
+          sizeof(node_mask) * 8, 0);
+#else
+  (void)address;
+  (void)size;
+#endif
+}
+
+#endif
+
+/**
+ * Fault every page in now so gameplay never takes a first-touch fault.
+ * Writes zero, so only call it on fresh (zeroed) memory.
+ */
+de100_file_scoped_fn inline void memory_prefault(void *address, size_t size,
+                                                 size_t page_size) {
+#if defined(__linux__) && defined(MADV_POPULATE_WRITE)
+  if (madvise(address, size, MADV_POPULATE_WRITE) == 0) {
+    return; // Linux 5.14+: one syscall, no per-page user/kernel trips
+  }
+#endif
+  volatile u8 *bytes = (volatile u8 *)address;
+  for (size_t offset = 0; offset < size; offset += page_size) {
+    bytes[offset] = 0;
+  }
+}
+
+// ─────────────────────────────────────────────────────────────────────
+// Commit / decommit inside a reservation
+// ─────────────────────────────────────────────────────────────────────
+//
+// A reservation is address space with no access and no backing. Commit
+// gives a page range the block's protection (backed on first touch);
+// decommit hands the pages back to the OS and makes the range
+// inaccessible again, so the tail past `size` still faults like a guard.
+
+de100_file_scoped_fn De100MemoryError memory_commit(void *address, size_t size,
+                                                    De100MemoryFlags flags) {
+#if defined(_WIN32)
+  if (!VirtualAlloc(address, size, MEM_COMMIT, win32_protection_flags(flags))) {
+    return win32_error_to_de100_memory_error(GetLastError());
+  }
+#elif defined(DE100_IS_GENERIC_POSIX)
+  if (mprotect(address, size, posix_protection_flags(flags)) != 0) {
+    return posix_error_to_de100_memory_error(errno);
+  }
+  if (flags & De100_MEMORY_FLAG_NUMA_LOCAL) {
+    posix_bind_numa_local(address, size);
+  }
+#endif
+  return De100_MEMORY_OK;
+}
+
+de100_file_scoped_fn De100MemoryError memory_decommit(void *address,
+                                                      size_t size) {
+#if defined(_WIN32)
+  if (!VirtualFree(address, size, MEM_DECOMMIT)) {
+    return win32_error_to_de100_memory_error(GetLastError());
+  }
+#elif defined(DE100_IS_GENERIC_POSIX)
+  // A fresh PROT_NONE mapping over the range: pages freed, and zero when
+  // committed again (madvise(MADV_DONTNEED) only promises that on Linux)
+  if (mmap(address, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED,
+           -1, 0) == MAP_FAILED) {
+    return posix_error_to_de100_memory_error(errno);
+  }
 #endif
+  return De100_MEMORY_OK;
+}
 
 // ═══════════════════════════════════════════════════════════════════════════
 // ALLOCATION
@@ -297,6 +411,22 @@ De100MemoryBlock de100_memory_alloc(void *base_hint, size_t size,
   // Align to page boundary: (size + page_size - 1) & ~(page_size - 1)
   size_t aligned_size = (size + page_size - 1) & ~(page_size - 1);
 
+  // Large pages: whole large pages only
+  size_t large_page_size = (flags & De100_MEMORY_FLAG_LARGE_PAGES)
+                               ? de100_memory_large_page_size()
+                               : 0;
+  if (large_page_size > page_size) {
+    size_t large_aligned =
+        (aligned_size + large_page_size - 1) & ~(large_page_size - 1);
+    if (large_aligned < aligned_size) {
+      result.error_code = De100_MEMORY_ERR_SIZE_OVERFLOW;
+      return result;
+    }
+    aligned_size = large_aligned;
+  } else {
+    large_page_size = 0;
+  }
+
   // Total = aligned + 2 guard pages
   size_t total_size = aligned_size + (2 * page_size);
 
@@ -315,6 +445,43 @@ De100MemoryBlock de100_memory_alloc(void *base_hint, size_t size,
   if (flags & (De100_MEMORY_FLAG_BASE_FIXED | De100_MEMORY_FLAG_BASE_HINT)) {
     request_addr = base_hint;
   }
+  DWORD protect = win32_protection_flags(flags);
+
+  // NUMA_LOCAL: commit on the node of the processor we're running on
+  ULONG numa_node = NUMA_NO_PREFERRED_NODE;
+  if (flags & De100_MEMORY_FLAG_NUMA_LOCAL) {
+    PROCESSOR_NUMBER processor;
+    USHORT node;
+    GetCurrentProcessorNumberEx(&processor);
+    if (GetNumaProcessorNodeEx(&processor, &node)) {
+      numa_node = node;
+    }
+  }
+
+  // Large pages must be reserved + committed in one call and can't hold
+  // PAGE_NOACCESS guard pages: the block is exactly the large pages
+  if (large_page_size) {
+    void *large = VirtualAllocExNuma(
+        GetCurrentProcess(), request_addr, aligned_size,
+        MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, protect, numa_node);
+    if (!large && request_addr && (flags & De100_MEMORY_FLAG_BASE_HINT)) {
+      large = VirtualAllocExNuma(GetCurrentProcess(), NULL, aligned_size,
+                                 MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES,
+                                 protect, numa_node);
+    }
+    if (large) {
+      // Large pages are locked and resident already: nothing to prefault
+      result.base = large;
+      result.mapping_base = large;
+      result.size = aligned_size;
+      result.total_size = aligned_size;
+      result.flags = flags;
+      result.error_code = De100_MEMORY_OK;
+      result.is_valid = true;
+      return result;
+    }
+    // No privilege or no contiguous physical memory: normal pages
+  }
 
   // Reserve entire range (including guard pages) with no access
   void *reserved =
@@ -332,21 +499,25 @@ De100MemoryBlock de100_memory_alloc(void *base_hint, size_t size,
 
   // Commit usable region (skip first guard page)
   void *usable = (u8 *)reserved + page_size;
-  DWORD protect = win32_protection_flags(flags);
 
-  void *committed = VirtualAlloc(usable, aligned_size, MEM_COMMIT, protect);
+  void *committed = VirtualAllocExNuma(GetCurrentProcess(), usable,
+                                       aligned_size, MEM_COMMIT, protect,
+                                       numa_node);
   if (!committed) {
     result.error_code = win32_error_to_de100_memory_error(GetLastError());
     VirtualFree(reserved, 0, MEM_RELEASE);
     return result;
   }
 
-  // Zero if requested (VirtualAlloc already zeros, but be explicit)
-  if (flags & De100_MEMORY_FLAG_ZEROED) {
-    ZeroMemory(committed, aligned_size);
+  // Freshly committed pages are zero: De100_MEMORY_FLAG_ZEROED needs no
+  // memset (which would touch, and so fault in, every page up front)
+
+  if (flags & De100_MEMORY_FLAG_PREFAULT) {
+    memory_prefault(committed, aligned_size, page_size);
   }
 
   result.base = committed;
+  result.mapping_base = reserved;
 
 #elif defined(DE100_IS_GENERIC_POSIX)
   // ═════════════════════════════════════════════════════════════════════
@@ -358,24 +529,82 @@ De100MemoryBlock de100_memory_alloc(void *base_hint, size_t size,
     mmap_flags |= MAP_FIXED;
   }
 
+  // Large pages need a large-page-aligned usable range: over-reserve by
+  // one large page, then trim the slack so the block is again exactly
+  // [guard][usable][guard]. A fixed base is taken as-is (only the
+  // aligned interior then gets huge pages).
+  size_t slack = 0;
+  if (large_page_size && !(flags & De100_MEMORY_FLAG_BASE_FIXED)) {
+    slack = large_page_size - page_size;
+    if (total_size + slack < total_size) {
+      result.error_code = De100_MEMORY_ERR_SIZE_OVERFLOW;
+      return result;
+    }
+  }
+
   // Reserve entire range with no access (guard pages)
-  void *reserved = mmap(base_hint, total_size, PROT_NONE, mmap_flags, -1, 0);
+  void *reserved =
+      mmap(base_hint, total_size + slack, PROT_NONE, mmap_flags, -1, 0);
 
   if (reserved == MAP_FAILED) {
     result.error_code = posix_error_to_de100_memory_error(errno);
     return result;
   }
 
+  if (slack) {
+    uintptr_t start = (uintptr_t)reserved + page_size;
+    uintptr_t aligned_start =
+        (start + large_page_size - 1) & ~((uintptr_t)large_page_size - 1);
+    size_t head = (size_t)(aligned_start - start);
+    if (head) {
+      munmap(reserved, head);
+    }
+    if (slack - head) {
+      munmap((u8 *)reserved + head + total_size, slack - head);
+    }
+    reserved = (u8 *)reserved + head;
+  }
+
   // Set protection on usable region (skip first guard page)
   void *usable = (u8 *)reserved + page_size;
   int prot = posix_protection_flags(flags);
 
-  if (mprotect(usable, aligned_size, prot) != 0) {
+  bool on_hugetlb = false;
+  bool is_mapped = false;
+#if defined(__linux__) && defined(MAP_HUGETLB)
+  // hugetlbfs first: a real 2 MB mapping over the reserved range. MAP_FIXED
+  // drops the reservation before the pool is checked, so on failure the
+  // hole is mapped again with normal pages.
+  if (large_page_size && ((uintptr_t)usable & (large_page_size - 1)) == 0) {
+    const int fixed_flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED;
+    on_hugetlb = mmap(usable, aligned_size, prot, fixed_flags | MAP_HUGETLB,
+                      -1, 0) == usable;
+    is_mapped = on_hugetlb ||
+                mmap(usable, aligned_size, prot, fixed_flags, -1, 0) == usable;
+    if (!is_mapped) {
+      result.error_code = posix_error_to_de100_memory_error(errno);
+      munmap(reserved, total_size);
+      return result;
+    }
+  }
+#endif
+
+  if (!is_mapped && mprotect(usable, aligned_size, prot) != 0) {
     result.error_code = posix_error_to_de100_memory_error(errno);
     munmap(reserved, total_size);
     return result;
   }
 
+#if defined(MADV_HUGEPAGE)
+  if (large_page_size && !on_hugetlb) {
+    madvise(usable, aligned_size, MADV_HUGEPAGE); // Best-effort THP
+  }
+#endif
+
+  if (flags & De100_MEMORY_FLAG_NUMA_LOCAL) {
+    posix_bind_numa_local(usable, aligned_size);
+  }
+
   // Note: mmap with MAP_ANONYMOUS guarantees zero-initialized pages
   // No explicit zeroing needed
 
@@ -391,9 +620,19 @@ De100MemoryBlock de100_memory_alloc(void *base_hint, size_t size,
                      check_offsets[i]);
     }
   }
+
+  if (large_page_size) {
+    printf("de100_memory_alloc: %zu MB on %s\n", aligned_size >> 20,
+           on_hugetlb ? "hugetlbfs pages" : "transparent huge pages");
+  }
 #endif
 
+  if (flags & De100_MEMORY_FLAG_PREFAULT) {
+    memory_prefault(usable, aligned_size, page_size);
+  }
+
   result.base = usable;
+  result.mapping_base = reserved;
 
 #endif
 
@@ -402,6 +641,7 @@ De100MemoryBlock de100_memory_alloc(void *base_hint, size_t size,
   // ─────────────────────────────────────────────────────────────────────
 
   result.size = aligned_size;
+  result.reserved_size = aligned_size;
   result.total_size = total_size;
   result.flags = flags;
   result.error_code = De100_MEMORY_OK;
@@ -410,6 +650,101 @@ De100MemoryBlock de100_memory_alloc(void *base_hint, size_t size,
   return result;
 }
 
+// ═══════════════════════════════════════════════════════════════════════════
+// RESERVE (address space now, pages on demand)
+// ═══════════════════════════════════════════════════════════════════════════
+
+De100MemoryBlock de100_memory_reserve(void *base_hint, size_t size,
+                                      size_t capacity,
+                                      De100MemoryFlags flags) {
+  De100MemoryBlock result = {0};
+
+  // Large pages are committed whole (and can't be decommitted on
+  // Windows): nothing to gain from reserving
+  if (flags & De100_MEMORY_FLAG_LARGE_PAGES) {
+    return de100_memory_alloc(base_hint, capacity > size ? capacity : size,
+                              flags);
+  }
+
+  if (size == 0) {
+    result.error_code = De100_MEMORY_ERR_INVALID_SIZE;
+    return result;
+  }
+
+  size_t page_size = de100_memory_page_size();
+  if (page_size == 0) {
+    result.error_code = De100_MEMORY_ERR_PAGE_SIZE_FAILED;
+    return result;
+  }
+
+  capacity = capacity > size ? capacity : size;
+  size_t aligned_size = (size + page_size - 1) & ~(page_size - 1);
+  size_t aligned_capacity = (capacity + page_size - 1) & ~(page_size - 1);
+  size_t total_size = aligned_capacity + (2 * page_size);
+  if (aligned_size < size || aligned_capacity < capacity ||
+      total_size < aligned_capacity) {
+    result.error_code = De100_MEMORY_ERR_SIZE_OVERFLOW;
+    return result;
+  }
+
+  // [guard][committed: size][reserved: capacity - size][guard]
+#if defined(_WIN32)
+  void *request_addr =
+      (flags & (De100_MEMORY_FLAG_BASE_FIXED | De100_MEMORY_FLAG_BASE_HINT))
+          ? base_hint
+          : NULL;
+  void *reserved =
+      VirtualAlloc(request_addr, total_size, MEM_RESERVE, PAGE_NOACCESS);
+  if (!reserved && (flags & De100_MEMORY_FLAG_BASE_HINT)) {
+    reserved = VirtualAlloc(NULL, total_size, MEM_RESERVE, PAGE_NOACCESS);
+  }
+  if (!reserved) {
+    result.error_code = win32_error_to_de100_memory_error(GetLastError());
+    return result;
+  }
+#elif defined(DE100_IS_GENERIC_POSIX)
+  int mmap_flags = MAP_PRIVATE | MAP_ANONYMOUS;
+  if (flags & De100_MEMORY_FLAG_BASE_FIXED) {
+    mmap_flags |= MAP_FIXED;
+  }
+#if defined(MAP_NORESERVE)
+  // No swap/overcommit charge for the part that is never touched
+  mmap_flags |= MAP_NORESERVE;
+#endif
+  void *reserved = mmap(base_hint, total_size, PROT_NONE, mmap_flags, -1, 0);
+  if (reserved == MAP_FAILED) {
+    result.error_code = posix_error_to_de100_memory_error(errno);
+    return result;
+  }
+#endif
+
+  void *usable = (u8 *)reserved + page_size;
+  De100MemoryError error = memory_commit(usable, aligned_size, flags);
+  if (error != De100_MEMORY_OK) {
+#if defined(_WIN32)
+    VirtualFree(reserved, 0, MEM_RELEASE);
+#elif defined(DE100_IS_GENERIC_POSIX)
+    munmap(reserved, total_size);
+#endif
+    result.error_code = error;
+    return result;
+  }
+
+  if (flags & De100_MEMORY_FLAG_PREFAULT) {
+    memory_prefault(usable, aligned_size, page_size);
+  }
+
+  result.base = usable;
+  result.mapping_base = reserved;
+  result.size = aligned_size;
+  result.reserved_size = aligned_capacity;
+  result.total_size = total_size;
+  result.flags = flags;
+  result.error_code = De100_MEMORY_OK;
+  result.is_valid = true;
+  return result;
+}
+
 // ═══════════════════════════════════════════════════════════════════════════
 // RESET (Zero existing block without reallocating)
 // ═══════════════════════════════════════════════════════════════════════════
@@ -433,7 +768,17 @@ De100MemoryError de100_memory_reset(De100MemoryBlock *block) {
 // ═══════════════════════════════════════════════════════════════════════════
 //
 // Updates struct IN PLACE - the De100MemoryBlock* remains valid.
-// Increments generation so holders of old base pointers can detect staleness.
+// Increments generation whenever base moves, so holders of old base
+// pointers can detect staleness.
+//
+// Cheapest first:
+//
+//   fits reserved_size   commit / decommit the difference in place
+//                        (shrinking always fits: the tail is decommitted
+//                        and stays reserved for the next grow)
+//   Linux, preserving    mremap the committed pages into a new, larger
+//                        reservation: page tables move, bytes don't
+//   otherwise            allocate, copy, free
 //
 // ═══════════════════════════════════════════════════════════════════════════
 
@@ -456,7 +801,9 @@ De100MemoryError de100_memory_realloc(De100MemoryBlock *block, size_t new_size,
 
     // Update struct fields in place
     block->base = new_block.base;
+    block->mapping_base = new_block.mapping_base;
     block->size = new_block.size;
+    block->reserved_size = new_block.reserved_size;
     block->total_size = new_block.total_size;
     block->flags = new_block.flags;
     block->error_code = new_block.error_code;
@@ -490,11 +837,81 @@ De100MemoryError de100_memory_realloc(De100MemoryBlock *block, size_t new_size,
   }
 
   // ─────────────────────────────────────────────────────────────────────
-  // Case 3: Different size - must reallocate
+  // Case 3: Fits the reservation - commit or decommit in place
+  // ─────────────────────────────────────────────────────────────────────
+  bool is_large = (block->flags & De100_MEMORY_FLAG_LARGE_PAGES) != 0;
+  if (new_aligned <= block->reserved_size && !is_large) {
+    u8 *base = (u8 *)block->base;
+    De100MemoryError error = De100_MEMORY_OK;
+    if (new_aligned > old_aligned) {
+      // Fresh pages read as zero: nothing to clear
+      error = memory_commit(base + old_aligned, new_aligned - old_aligned,
+                            block->flags);
+    } else {
+      error = memory_decommit(base + new_aligned, old_aligned - new_aligned);
+    }
+    if (error != De100_MEMORY_OK) {
+      block->error_code = error;
+      return error;
+    }
+
+    if (!preserve_data) {
+      size_t kept = old_aligned < new_aligned ? old_aligned : new_aligned;
+      de100_mem_set(base, 0, kept);
+    }
+    block->size = new_aligned;
+    block->error_code = De100_MEMORY_OK;
+    return De100_MEMORY_OK;
+  }
+
+#if defined(__linux__) && defined(MREMAP_MAYMOVE) && defined(MREMAP_FIXED)
+  // ─────────────────────────────────────────────────────────────────────
+  // Case 4 (Linux): Move the pages into a bigger reservation
+  // ─────────────────────────────────────────────────────────────────────
+  //
+  // The committed range must be one mapping (a de100_memory_protect()'d
+  // sub-range splits it: mremap then fails with EFAULT and we copy).
+  if (preserve_data && !is_large) {
+    size_t new_total = new_aligned + (2 * page_size);
+    void *reserved = new_total > new_aligned
+                         ? mmap(NULL, new_total, PROT_NONE,
+                                MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE,
+                                -1, 0)
+                         : MAP_FAILED;
+    if (reserved != MAP_FAILED) {
+      u8 *usable = (u8 *)reserved + page_size;
+      // Grows the moved mapping too: the new tail is zero pages with the
+      // same protection (and NUMA policy)
+      if (mremap(block->base, old_aligned, new_aligned,
+                 MREMAP_MAYMOVE | MREMAP_FIXED, usable) == usable) {
+        // Only what's left of the old mapping: its hole may already
+        // belong to another thread's mmap
+        u8 *old_mapping = (u8 *)block->mapping_base;
+        u8 *old_end = (u8 *)block->base + old_aligned;
+        munmap(old_mapping, (size_t)((u8 *)block->base - old_mapping));
+        munmap(old_end, (size_t)(old_mapping + block->total_size - old_end));
+
+        block->base = usable;
+        block->mapping_base = reserved;
+        block->size = new_aligned;
+        block->reserved_size = new_aligned;
+        block->total_size = new_total;
+        block->error_code = De100_MEMORY_OK;
+        block->generation++;
+        return De100_MEMORY_OK;
+      }
+      munmap(reserved, new_total);
+    }
+  }
+#endif
+
+  // ─────────────────────────────────────────────────────────────────────
+  // Case 5: Reallocate and copy
   // ─────────────────────────────────────────────────────────────────────
 
   // Save old state for copy/cleanup
   void *old_base = block->base;
+  void *old_mapping_base = block->mapping_base;
   size_t old_size = block->size;
   size_t old_total_size = block->total_size;
   size_t copy_size = (old_size < new_aligned) ? old_size : new_aligned;
@@ -518,19 +935,18 @@ De100MemoryError de100_memory_realloc(De100MemoryBlock *block, size_t new_size,
     }
   }
 
-  // Free old memory (calculate original reserved base)
-  size_t guard_page_size = de100_memory_page_size();
-  void *old_reserved_base = (u8 *)old_base - guard_page_size;
-
+  // Free old memory (the whole original mapping)
 #if defined(_WIN32)
-  VirtualFree(old_reserved_base, 0, MEM_RELEASE);
+  VirtualFree(old_mapping_base, 0, MEM_RELEASE);
 #elif defined(DE100_IS_GENERIC_POSIX)
-  munmap(old_reserved_base, old_total_size);
+  munmap(old_mapping_base, old_total_size);
 #endif
 
   // Update struct fields in place (pointer to block stays valid!)
   block->base = new_block.base;
+  block->mapping_base = new_block.mapping_base;
   block->size = new_block.size;
+  block->reserved_size = new_block.reserved_size;
   block->total_size = new_block.total_size;
   // block->flags stays the same
   block->error_code = De100_MEMORY_OK;
@@ -565,21 +981,19 @@ De100MemoryError de100_memory_free(De100MemoryBlock *block) {
   }
 
   // ─────────────────────────────────────────────────────────────────────
-  // Calculate original reserved base
+  // Release the whole mapping (guard pages included)
   // ─────────────────────────────────────────────────────────────────────
 
-  size_t page_size = de100_memory_page_size();
-  if (page_size == 0) {
-    block->error_code = De100_MEMORY_ERR_PAGE_SIZE_FAILED;
-    return De100_MEMORY_ERR_PAGE_SIZE_FAILED;
+  void *reserved_base = block->mapping_base;
+  if (!reserved_base) {
+    block->error_code = De100_MEMORY_ERR_INVALID_BLOCK;
+    return De100_MEMORY_ERR_INVALID_BLOCK;
   }
 
-  void *reserved_base = (u8 *)block->base - page_size;
-
 #if defined(_WIN32)
   if (!VirtualFree(reserved_base, 0, MEM_RELEASE)) {
-    block->error = win32_error_to_de100_memory_error(GetLastError());
-    return block->error;
+    block->error_code = win32_error_to_de100_memory_error(GetLastError());
+    return block->error_code;
   }
 #elif defined(DE100_IS_GENERIC_POSIX)
   if (munmap(reserved_base, block->total_size) != 0) {
@@ -593,7 +1007,9 @@ De100MemoryError de100_memory_free(De100MemoryBlock *block) {
   // ─────────────────────────────────────────────────────────────────────
 
   block->base = NULL;
+  block->mapping_base = NULL;
   block->size = 0;
+  block->reserved_size = 0;
   block->total_size = 0;
   block->is_valid = false;
   block->error_code = De100_MEMORY_OK;
@@ -601,6 +1017,180 @@ De100MemoryError de100_memory_free(De100MemoryBlock *block) {
   return De100_MEMORY_OK;
 }
 
+// ═══════════════════════════════════════════════════════════════════════════
+// PROTECT (Change access rights on a page range)
+// ═══════════════════════════════════════════════════════════════════════════
+
+De100MemoryError de100_memory_protect(void *address, size_t size,
+                                      De100MemoryFlags flags) {
+  if (!address || size == 0) {
+    return De100_MEMORY_ERR_INVALID_ADDRESS;
+  }
+
+  size_t page_size = de100_memory_page_size();
+  if (page_size == 0) {
+    return De100_MEMORY_ERR_PAGE_SIZE_FAILED;
+  }
+
+  if (((uintptr_t)address & (page_size - 1)) != 0) {
+    return De100_MEMORY_ERR_ALIGNMENT_FAILED;
+  }
+
+#if defined(_WIN32)
+  DWORD old_protect;
+  if (!VirtualProtect(address, size, win32_protection_flags(flags),
+                      &old_protect)) {
+    return win32_error_to_de100_memory_error(GetLastError());
+  }
+#elif defined(DE100_IS_GENERIC_POSIX)
+  if (mprotect(address, size, posix_protection_flags(flags)) != 0) {
+    return errno == EACCES ? De100_MEMORY_ERR_PROTECTION_FAILED
+                           : posix_error_to_de100_memory_error(errno);
+  }
+#endif
+
+  return De100_MEMORY_OK;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// DEBUG GUARDS
+// ═══════════════════════════════════════════════════════════════════════════
+
+void *de100_memory_guarded_carve(void *base, size_t capacity, size_t size,
+                                 size_t alignment, size_t *consumed) {
+  *consumed = 0;
+
+  size_t page_size = de100_memory_page_size();
+  if (!base || page_size == 0 || (alignment & (alignment - 1)) != 0) {
+    return NULL;
+  }
+  size_t start_alignment = alignment > page_size ? alignment : page_size;
+
+  uintptr_t begin = (uintptr_t)base;
+  uintptr_t start = (begin + start_alignment - 1) & ~(start_alignment - 1);
+  size_t data_size = size ? size : 1;
+  size_t data_pages = (data_size + page_size - 1) & ~(page_size - 1);
+  if (data_pages < data_size) {
+    return NULL; // Overflow
+  }
+
+  // End flush against the guard, then back off to the requested alignment.
+  // `start` is aligned, so this never moves before it.
+  uintptr_t guard = start + data_pages;
+  uintptr_t result = guard - size;
+  if (alignment > 1) {
+    result &= ~((uintptr_t)alignment - 1);
+  }
+
+  *consumed = (size_t)(guard + page_size - begin);
+  if (*consumed > capacity) {
+    return NULL;
+  }
+
+  de100_memory_protect((void *)guard, page_size, De100_MEMORY_FLAG_NONE);
+  return (void *)result;
+}
+
+De100MemoryError de100_memory_unguard(void *address, size_t size) {
+  size_t page_size = de100_memory_page_size();
+  if (page_size == 0) {
+    return De100_MEMORY_ERR_PAGE_SIZE_FAILED;
+  }
+
+  uintptr_t first = ((uintptr_t)address + page_size - 1) & ~(page_size - 1);
+  uintptr_t last = ((uintptr_t)address + size) & ~(page_size - 1);
+  if (last <= first) {
+    return De100_MEMORY_OK; // No whole page: nothing was guarded
+  }
+
+  return de100_memory_protect((void *)first, (size_t)(last - first),
+                              De100_MEMORY_FLAG_RW);
+}
+
+void de100_memory_poison(void *address, size_t size) {
+  if (address && size) {
+    memset(address, DE100_MEMORY_POISON_BYTE, size);
+  }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// COMMIT FRONTIER
+// ═══════════════════════════════════════════════════════════════════════════
+
+void de100_commit_frontier_init(De100CommitFrontier *frontier, void *base,
+                                u64 reserved, u64 step,
+                                De100MemoryFlags flags) {
+  u64 page_size = de100_memory_page_size();
+  if (step == 0) {
+    step = DE100_COMMIT_FRONTIER_DEFAULT_STEP;
+  }
+  frontier->base = (u8 *)base;
+  frontier->reserved = (reserved + page_size - 1) & ~(page_size - 1);
+  frontier->committed = 0;
+  frontier->step = (step + page_size - 1) & ~(page_size - 1);
+  frontier->flags = flags & (De100_MEMORY_FLAG_RWX |
+                             De100_MEMORY_FLAG_NUMA_LOCAL);
+  frontier->releases_held = false;
+}
+
+bool de100_commit_frontier_grow(De100CommitFrontier *frontier, u64 end) {
+  u64 committed = __atomic_load_n(&frontier->committed, __ATOMIC_ACQUIRE);
+  if (end <= committed) {
+    return true;
+  }
+  if (end > frontier->reserved) {
+    return false;
+  }
+
+  u64 target = (end + frontier->step - 1) / frontier->step * frontier->step;
+  if (target > frontier->reserved) {
+    target = frontier->reserved;
+  }
+  if (memory_commit(frontier->base + committed, (size_t)(target - committed),
+                    frontier->flags) != De100_MEMORY_OK) {
+    return false;
+  }
+
+  // Publish only after the pages are usable; a racing grower that got
+  // further wins (the CAS fails with committed >= target)
+  while (committed < target &&
+         !__atomic_compare_exchange_n(&frontier->committed, &committed, target,
+                                      true, __ATOMIC_RELEASE,
+                                      __ATOMIC_ACQUIRE)) {
+  }
+  return true;
+}
+
+u64 de100_commit_frontier_committed(const De100CommitFrontier *frontier) {
+  return __atomic_load_n(&frontier->committed, __ATOMIC_ACQUIRE);
+}
+
+bool de100_commit_frontier_release(De100CommitFrontier *frontier,
+                                   void *address, u64 size) {
+  if (__atomic_load_n(&frontier->releases_held, __ATOMIC_ACQUIRE)) {
+    return false;
+  }
+
+  u64 page_size = de100_memory_page_size();
+  uintptr_t first = ((uintptr_t)address + page_size - 1) & ~(page_size - 1);
+  uintptr_t last = ((uintptr_t)address + size) & ~(page_size - 1);
+  if (last <= first) {
+    return false;
+  }
+
+#if defined(_WIN32)
+  // MEM_RESET ignores the protection argument but wants a valid one
+  return VirtualAlloc((void *)first, (SIZE_T)(last - first), MEM_RESET,
+                      PAGE_NOACCESS) != NULL;
+#elif defined(__linux__)
+  return madvise((void *)first, (size_t)(last - first), MADV_DONTNEED) == 0;
+#elif defined(MADV_FREE)
+  return madvise((void *)first, (size_t)(last - first), MADV_FREE) == 0;
+#else
+  return false;
+#endif
+}
+
 // ═══════════════════════════════════════════════════════════════════════════
 // UTILITIES
 // ═══════════════════════════════════════════════════════════════════════════
@@ -653,6 +1243,162 @@ void *de100_mem_zero_secure(void *dest, size_t size) {
   return dest;
 }
 
+// ═══════════════════════════════════════════════════════════════════════════
+// LARGE BLOCKS
+// ═══════════════════════════════════════════════════════════════════════════
+
+typedef struct {
+  de100_mem_parallel_for_t *parallel_for;
+  void *context;
+  u32 thread_count;
+} De100MemParallel;
+
+de100_file_scoped_global_var De100MemParallel g_mem_parallel = {0};
+// Set on the thread that installed the hook: the only one that may use it
+de100_file_scoped_global_var __thread bool t_mem_parallel_owner = false;
+
+void de100_mem_set_parallel_for(de100_mem_parallel_for_t *parallel_for,
+                                void *context, u32 thread_count) {
+  g_mem_parallel.parallel_for = parallel_for;
+  g_mem_parallel.context = context;
+  g_mem_parallel.thread_count = parallel_for ? thread_count : 0;
+  t_mem_parallel_owner = parallel_for != NULL;
+}
+
+/**
+ * memcpy with non-temporal stores: the head is copied normally up to a
+ * 64-byte boundary of `dest`, whole cache lines are streamed, the tail
+ * copied normally.
+ */
+de100_file_scoped_fn void mem_stream_copy(u8 *dest, const u8 *src,
+                                          size_t size) {
+#if DE100_MEM_HAS_STREAMING
+  size_t head = (size_t)(-(uintptr_t)dest & 63);
+  if (head > size) {
+    head = size;
+  }
+  memcpy(dest, src, head);
+  dest += head;
+  src += head;
+  size -= head;
+
+  size_t lines = size / 64;
+  for (size_t i = 0; i < lines; ++i) {
+    __m128i a = _mm_loadu_si128((const __m128i *)(src + 0));
+    __m128i b = _mm_loadu_si128((const __m128i *)(src + 16));
+    __m128i c = _mm_loadu_si128((const __m128i *)(src + 32));
+    __m128i d = _mm_loadu_si128((const __m128i *)(src + 48));
+    _mm_stream_si128((__m128i *)(dest + 0), a);
+    _mm_stream_si128((__m128i *)(dest + 16), b);
+    _mm_stream_si128((__m128i *)(dest + 32), c);
+    _mm_stream_si128((__m128i *)(dest + 48), d);
+    dest += 64;
+    src += 64;
+  }
+  // Streaming stores are weakly ordered: fence before anyone reads them
+  _mm_sfence();
+  memcpy(dest, src, size - lines * 64);
+#else
+  memcpy(dest, src, size);
+#endif
+}
+
+de100_file_scoped_fn void mem_stream_set(u8 *dest, int value, size_t size) {
+#if DE100_MEM_HAS_STREAMING
+  size_t head = (size_t)(-(uintptr_t)dest & 63);
+  if (head > size) {
+    head = size;
+  }
+  memset(dest, value, head);
+  dest += head;
+  size -= head;
+
+  __m128i fill = _mm_set1_epi8((char)value);
+  size_t lines = size / 64;
+  for (size_t i = 0; i < lines; ++i) {
+    _mm_stream_si128((__m128i *)(dest + 0), fill);
+    _mm_stream_si128((__m128i *)(dest + 16), fill);
+    _mm_stream_si128((__m128i *)(dest + 32), fill);
+    _mm_stream_si128((__m128i *)(dest + 48), fill);
+    dest += 64;
+  }
+  _mm_sfence();
+  memset(dest, value, size - lines * 64);
+#else
+  memset(dest, value, size);
+#endif
+}
+
+typedef struct {
+  u8 *dest;
+  const u8 *src; // NULL = fill with `value`
+  int value;
+  size_t size;
+  size_t chunk_size;
+} De100MemLargeJob;
+
+de100_file_scoped_fn void mem_large_task(void *data, u32 index) {
+  De100MemLargeJob *job = (De100MemLargeJob *)data;
+  size_t offset = (size_t)index * job->chunk_size;
+  if (offset >= job->size) {
+    return;
+  }
+  size_t size = job->size - offset < job->chunk_size ? job->size - offset
+                                                     : job->chunk_size;
+  if (job->src) {
+    mem_stream_copy(job->dest + offset, job->src + offset, size);
+  } else {
+    mem_stream_set(job->dest + offset, job->value, size);
+  }
+}
+
+de100_file_scoped_fn void mem_large_run(De100MemLargeJob *job) {
+  u32 task_count = 1;
+  if (job->size >= DE100_MEM_PARALLEL_THRESHOLD && t_mem_parallel_owner &&
+      g_mem_parallel.parallel_for && g_mem_parallel.thread_count > 1) {
+    u64 by_size = job->size / DE100_MEM_PARALLEL_MIN_CHUNK;
+    task_count = by_size < g_mem_parallel.thread_count
+                     ? (u32)by_size
+                     : g_mem_parallel.thread_count;
+  }
+
+  if (task_count <= 1) {
+    job->chunk_size = job->size;
+    mem_large_task(job, 0);
+    return;
+  }
+
+  // Page-aligned chunks: no two threads write the same line or page
+  size_t page = de100_memory_page_size();
+  size_t chunk = (job->size + task_count - 1) / task_count;
+  job->chunk_size = (chunk + page - 1) & ~(page - 1);
+  task_count = (u32)((job->size + job->chunk_size - 1) / job->chunk_size);
+  g_mem_parallel.parallel_for(g_mem_parallel.context, task_count,
+                              mem_large_task, job);
+}
+
+void *de100_mem_copy_large(void *dest, const void *src, size_t size) {
+  if (!dest || !src || size == 0)
+    return dest;
+  if (size < DE100_MEM_STREAM_THRESHOLD) {
+    return memcpy(dest, src, size);
+  }
+  De100MemLargeJob job = {(u8 *)dest, (const u8 *)src, 0, size, 0};
+  mem_large_run(&job);
+  return dest;
+}
+
+void *de100_mem_set_large(void *dest, int value, size_t size) {
+  if (!dest || size == 0)
+    return dest;
+  if (size < DE100_MEM_STREAM_THRESHOLD) {
+    return memset(dest, value, size);
+  }
+  De100MemLargeJob job = {(u8 *)dest, NULL, value, size, 0};
+  mem_large_run(&job);
+  return dest;
+}
+
 // TODO: Should the following be implemented?
 // //
 // ═══════════════════════════════════════════════════════════════════════════
@@ -58,10 +58,29 @@ typedef enum {
   De100_MEMORY_FLAG_BASE_FIXED = 1 << 5, // Must use exact base address
 
   // Optimization hints (best-effort)
-  De100_MEMORY_FLAG_LARGE_PAGES = 1 << 6,
+  De100_MEMORY_FLAG_LARGE_PAGES = 1 << 6, // See "Large pages" below
   De100_MEMORY_FLAG_TRANSIENT = 1 << 7,
+  De100_MEMORY_FLAG_PREFAULT = 1 << 8,   // Fault every page in now
+  De100_MEMORY_FLAG_NUMA_LOCAL = 1 << 9, // Prefer the caller's NUMA node
 } De100MemoryFlags;
 
+// Large pages (2 MB on x86-64 / arm64) cut TLB misses on multi-GB blocks:
+//
+//   Linux    hugetlbfs (MAP_HUGETLB) if the pool has room, else
+//            transparent huge pages (madvise MADV_HUGEPAGE) on a
+//            2 MB-aligned range. Guard pages stay.
+//   Windows  MEM_LARGE_PAGES (needs SeLockMemoryPrivilege); committed up
+//            front and WITHOUT guard pages. Falls back to normal pages.
+//
+// Size rounds up to de100_memory_large_page_size(). Don't combine with
+// 4 KB de100_memory_protect() ranges: those split (THP) or reject
+// (hugetlbfs, Windows) large pages.
+//
+// PREFAULT moves the first-touch page faults from gameplay to init
+// (MADV_POPULATE_WRITE, or one write per page). NUMA_LOCAL binds the
+// block to the allocating thread's node, so pages workers fault later
+// still land next to the main thread.
+
 // Common flag combinations
 #define De100_MEMORY_FLAG_RW (De100_MEMORY_FLAG_READ | De100_MEMORY_FLAG_WRITE)
 #define De100_MEMORY_FLAG_RWX                                                  \
@@ -75,11 +94,13 @@ typedef enum {
 
 typedef struct {
   void *base;                  // Pointer to usable memory (after guard page)
+  void *mapping_base;          // Start of the OS mapping (what free releases)
   size_t size;                 // Usable size (page-aligned)
+  size_t reserved_size;        // Size reachable in place (>= size)
   size_t total_size;           // Total size including guard pages
   De100MemoryFlags flags;      // Flags used for allocation
   De100MemoryError error_code; // Error code (De100_MEMORY_OK if valid)
-  u32 generation; // Incremented on each realloc to detect stale refs
+  u32 generation; // Incremented when realloc moves base (stale refs)
   bool is_valid;  // Quick validity check
 } De100MemoryBlock;
 
@@ -102,6 +123,22 @@ typedef struct {
 De100MemoryBlock de100_memory_alloc(void *base_hint, size_t size,
                                     De100MemoryFlags flags);
 
+/**
+ * Allocate `size` bytes inside a reservation of `capacity`.
+ *
+ * Memory layout:
+ *   [Guard Page][Committed: size][Reserved: capacity - size][Guard Page]
+ *
+ * The reserved tail costs address space only. de100_memory_realloc()
+ * grows and shrinks within it without moving base; past it, the block
+ * moves like any other. Use for buffers that resize at runtime (back
+ * buffer, growing logs). LARGE_PAGES falls back to a plain alloc of
+ * `capacity`.
+ */
+De100MemoryBlock de100_memory_reserve(void *base_hint, size_t size,
+                                      size_t capacity,
+                                      De100MemoryFlags flags);
+
 /**
  * @brief Zero an existing memory block without reallocating.
  *
@@ -120,6 +157,11 @@ De100MemoryError de100_memory_reset(De100MemoryBlock *block);
  *
  * @note If new aligned size equals current, no reallocation occurs.
  * @note If preserve_data is false and sizes match, block is zeroed.
+ * @note Within reserved_size (always, when shrinking) pages are committed
+ *       or decommitted in place and base stays put. Beyond it, Linux
+ *       moves the pages with mremap instead of copying; elsewhere (or for
+ *       LARGE_PAGES) the data is copied to a new block. generation only
+ *       changes when base does.
  * @note On failure, original block remains valid and unchanged.
  */
 De100MemoryError de100_memory_realloc(De100MemoryBlock *block, size_t new_size,
@@ -135,6 +177,125 @@ De100MemoryError de100_memory_realloc(De100MemoryBlock *block, size_t new_size,
  */
 De100MemoryError de100_memory_free(De100MemoryBlock *block);
 
+/**
+ * Change access rights on a page range inside an allocation.
+ *
+ * @param address  Page-aligned start address
+ * @param size     Bytes to change (rounded up to whole pages by the OS)
+ * @param flags    New protection (READ/WRITE/EXECUTE; other flags ignored)
+ * @return         Error code
+ *
+ * Used for write-tracking (e.g. incremental replay snapshots).
+ */
+De100MemoryError de100_memory_protect(void *address, size_t size,
+                                      De100MemoryFlags flags);
+
+// ═══════════════════════════════════════════════════════════════════════════
+// DEBUG GUARDS (overrun / use-after-free detection)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// Building blocks for guarded sub-allocation INSIDE an existing block (the
+// arenas' DE100_ARENA_GUARD_PAGES mode). Each carve ends flush against a
+// PROT_NONE page, so writing past it faults on the very first byte:
+//
+//   ┌─ page(s) ─────────────┐┌─ guard ─┐┌─ page(s) ──────┐┌─ guard ─┐
+//   │ pad     [allocation A]││PROT_NONE││ pad [alloc. B] ││PROT_NONE│
+//   └───────────────────────┘└─────────┘└────────────────┘└─────────┘
+//
+// Released ranges get their guards lifted and are filled with
+// DE100_MEMORY_POISON_BYTE, so stale pointers read obvious garbage
+// (0xDDDDDDDD) instead of plausible old values.
+//
+// Costs at least two pages per carve: debug builds only.
+//
+
+#define DE100_MEMORY_POISON_BYTE 0xDD
+
+/**
+ * Carve `size` bytes from [base, base + capacity), ending as close to a
+ * fresh PROT_NONE guard page as `alignment` allows.
+ *
+ * @param consumed  Bytes used from `base` on, guard page included; set
+ *                  even on failure (what the carve would have needed)
+ * @return          The allocation, or NULL if it doesn't fit
+ *
+ * If the guard can't be protected (e.g. hugetlbfs pages) the carve still
+ * succeeds, just unguarded.
+ */
+void *de100_memory_guarded_carve(void *base, size_t capacity, size_t size,
+                                 size_t alignment, size_t *consumed);
+
+/**
+ * Make every whole page in [address, address + size) readable and writable
+ * again (lifts the guards of released carves). Partial pages at either end
+ * are left alone; they were never guards.
+ */
+De100MemoryError de100_memory_unguard(void *address, size_t size);
+
+/** Fill released memory with DE100_MEMORY_POISON_BYTE. */
+void de100_memory_poison(void *address, size_t size);
+
+// ═══════════════════════════════════════════════════════════════════════════
+// COMMIT FRONTIER (reserve once, commit as used)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// A reserved range (de100_memory_reserve) whose committed part is a
+// prefix that only grows. Whoever is about to use bytes past it (arena
+// pushes) calls grow; the frontier moves in `step`-sized jumps so that's
+// a syscall every few MB, not every push:
+//
+//   base                committed               reserved
+//   ├─ usable ──────────┼─ PROT_NONE / MEM_RESERVE ┤
+//
+// Pointers stay put (nothing moves), and the platform can bound anything
+// that walks the range (replay snapshots) by `committed`.
+//
+// Releasing pages (arena reset) keeps them committed but hands the
+// physical memory back: they read as zero (Linux, Windows) or garbage
+// (macOS MADV_FREE) afterwards. Skipped while `releases_held` is set:
+// the replay tracker sets it while it assumes clean pages are unchanged.
+//
+
+#define DE100_COMMIT_FRONTIER_DEFAULT_STEP MEGABYTES(2)
+
+typedef struct De100CommitFrontier {
+  u8 *base;               // Start of the range
+  u64 reserved;           // Bytes reserved (page-aligned)
+  u64 committed;          // [base, base + committed) usable; __atomic only
+  u64 step;               // Commit granularity (page multiple)
+  De100MemoryFlags flags; // Protection to commit with (+ NUMA_LOCAL)
+  bool32 releases_held;   // Set by replay tracking; __atomic only
+} De100CommitFrontier;
+
+/**
+ * Describe [base, base + reserved), already reserved and with nothing
+ * committed yet. `step` 0 = DE100_COMMIT_FRONTIER_DEFAULT_STEP.
+ */
+void de100_commit_frontier_init(De100CommitFrontier *frontier, void *base,
+                                u64 reserved, u64 step,
+                                De100MemoryFlags flags);
+
+/**
+ * Commit so that [base, base + end) is usable. Thread-safe (concurrent
+ * growers may commit overlapping pages; committing twice is harmless).
+ *
+ * @return false if `end` is past the reservation or the OS refused
+ *         (out of commit charge: treat like a full arena)
+ */
+bool de100_commit_frontier_grow(De100CommitFrontier *frontier, u64 end);
+
+/** Bytes usable from base right now. */
+u64 de100_commit_frontier_committed(const De100CommitFrontier *frontier);
+
+/**
+ * Give the physical pages wholly inside [address, address + size) back
+ * to the OS. They stay committed (and readable).
+ *
+ * @return false if nothing was released (held, or no whole page)
+ */
+bool de100_commit_frontier_release(De100CommitFrontier *frontier,
+                                   void *address, u64 size);
+
 // ═══════════════════════════════════════════════════════════════════════════
 // UTILITIES
 // ═══════════════════════════════════════════════════════════════════════════
@@ -142,6 +303,9 @@ De100MemoryError de100_memory_free(De100MemoryBlock *block);
 /** Get system page size (cached after first call). */
 size_t de100_memory_page_size(void);
 
+/** Large page size used for De100_MEMORY_FLAG_LARGE_PAGES (0 = none). */
+size_t de100_memory_large_page_size(void);
+
 /** Check if block is valid and usable. */
 bool de100_memory_is_valid(De100MemoryBlock block);
 
@@ -169,4 +333,56 @@ void *de100_mem_move(void *dest, const void *src, size_t size);
 /** Zero memory (compiler won't optimize away). Returns dest. */
 void *de100_mem_zero_secure(void *dest, size_t size);
 
+// ═══════════════════════════════════════════════════════════════════════════
+// LARGE BLOCKS
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// For snapshot-sized copies and fills (replay state, hundreds of MB):
+//
+//   < DE100_MEM_STREAM_THRESHOLD     plain memcpy / memset
+//   ≥ DE100_MEM_STREAM_THRESHOLD     non-temporal stores (x86 SSE2): the
+//                                    destination bypasses the cache, so
+//                                    the game's working set survives
+//   ≥ DE100_MEM_PARALLEL_THRESHOLD   also split into page-aligned chunks
+//                                    across the parallel-for hook (the
+//                                    work queue), one chunk per thread
+//
+// One core can't saturate memory bandwidth; a few can. The hook is only
+// used from the thread that installed it (the main thread), so the large
+// variants stay safe to call anywhere: elsewhere they just stream.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#ifndef DE100_MEM_STREAM_THRESHOLD
+#define DE100_MEM_STREAM_THRESHOLD MEGABYTES(4)
+#endif
+#ifndef DE100_MEM_PARALLEL_THRESHOLD
+#define DE100_MEM_PARALLEL_THRESHOLD MEGABYTES(64)
+#endif
+#define DE100_MEM_PARALLEL_MIN_CHUNK MEGABYTES(16)
+
+typedef void de100_mem_task_t(void *data, u32 index);
+
+/**
+ * Run task(data, i) for every i < task_count, possibly concurrently, and
+ * return once all have finished.
+ */
+#define DE100_MEM_PARALLEL_FOR(name)                                           \
+  void name(void *context, u32 task_count, de100_mem_task_t *task, void *data)
+typedef DE100_MEM_PARALLEL_FOR(de100_mem_parallel_for_t);
+
+/**
+ * Install the hook the large variants split work through, for calls from
+ * this thread. `thread_count` (helpers + caller) caps the chunk count.
+ * NULL uninstalls (before the work queue shuts down).
+ */
+void de100_mem_set_parallel_for(de100_mem_parallel_for_t *parallel_for,
+                                void *context, u32 thread_count);
+
+/** de100_mem_copy for large blocks (see above). Returns dest. */
+void *de100_mem_copy_large(void *dest, const void *src, size_t size);
+
+/** de100_mem_set for large blocks (see above). Returns dest. */
+void *de100_mem_set_large(void *dest, int value, size_t size);
+
 #endif // DE100_COMMON_De100_MEMORY_H
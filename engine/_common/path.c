@@ -451,15 +451,42 @@ De100PathResult de100_path_join(const char *directory, const char *filename) {
     return make_path_error(DE100_PATH_ERROR_INVALID_ARGUMENT);
   }
 
-  size_t dir_len = strlen(directory);
-  size_t de100_file_len = strlen(filename);
-
   // Empty directory is invalid
-  if (dir_len == 0) {
+  if (directory[0] == '\0') {
     SET_ERROR_DETAIL("[de100_path_join] Empty directory string");
     return make_path_error(DE100_PATH_ERROR_INVALID_ARGUMENT);
   }
 
+  size_t total_len = de100_path_join_into(result.path, sizeof(result.path),
+                                          directory, filename);
+  if (total_len == 0) {
+    SET_ERROR_DETAIL("[de100_path_join] Path too long: max %zu bytes",
+                     sizeof(result.path));
+    return make_path_error(DE100_PATH_ERROR_BUFFER_TOO_SMALL);
+  }
+
+  result.length = total_len;
+  result.success = true;
+  result.error_code = DE100_PATH_SUCCESS;
+
+  CLEAR_ERROR_DETAIL();
+
+  return result;
+}
+
+size_t de100_path_join_into(char *buffer, size_t buffer_size,
+                            const char *directory, const char *filename) {
+  if (!buffer || buffer_size == 0) {
+    return 0;
+  }
+  buffer[0] = '\0';
+  if (!directory || !filename || directory[0] == '\0') {
+    return 0;
+  }
+
+  size_t dir_len = strlen(directory);
+  size_t file_len = strlen(filename);
+
   // ─────────────────────────────────────────────────────────────────────
   // Check if directory already ends with separator
   // ─────────────────────────────────────────────────────────────────────
@@ -475,52 +502,47 @@ De100PathResult de100_path_join(const char *directory, const char *filename) {
   char separator = '/';
 #endif
 
-  // ─────────────────────────────────────────────────────────────────────
-  // Calculate required length and check bounds
-  // ─────────────────────────────────────────────────────────────────────
-
   size_t separator_len = has_trailing_separator ? 0 : 1;
-  size_t total_len = dir_len + separator_len + de100_file_len;
-
-  if (total_len >= sizeof(result.path)) {
-    SET_ERROR_DETAIL(
-        "[de100_path_join] Path too long: need %zu bytes, have %zu",
-        total_len + 1, sizeof(result.path));
-    return make_path_error(DE100_PATH_ERROR_BUFFER_TOO_SMALL);
+  size_t total_len = dir_len + separator_len + file_len;
+  if (total_len >= buffer_size) {
+    return 0;
   }
 
   // ─────────────────────────────────────────────────────────────────────
-  // Build the joined path
+  // Build the joined path (lengths validated: plain copies)
   // ─────────────────────────────────────────────────────────────────────
-  //
-  // Using memcpy for performance (we already validated lengths)
-  // ─────────────────────────────────────────────────────────────────────
-
-  char *write_ptr = result.path;
 
-  // Copy directory
+  char *write_ptr = buffer;
   memcpy(write_ptr, directory, dir_len);
   write_ptr += dir_len;
-
-  // Add separator if needed
   if (!has_trailing_separator) {
     *write_ptr++ = separator;
   }
-
-  // Copy filename
-  memcpy(write_ptr, filename, de100_file_len);
-  write_ptr += de100_file_len;
-
-  // Null-terminate
+  memcpy(write_ptr, filename, file_len);
+  write_ptr += file_len;
   *write_ptr = '\0';
 
-  result.length = (size_t)(write_ptr - result.path);
-  result.success = true;
-  result.error_code = DE100_PATH_SUCCESS;
+  return total_len;
+}
 
-  CLEAR_ERROR_DETAIL();
+// ═══════════════════════════════════════════════════════════════════════════
+// INTERNED PATH TABLE
+// ═══════════════════════════════════════════════════════════════════════════
 
-  return result;
+const char *de100_path_table_add(De100PathTable *table, const char *directory,
+                                 const char *filename) {
+  if (!table || table->used >= sizeof(table->storage)) {
+    return NULL;
+  }
+
+  char *entry = table->storage + table->used;
+  size_t length = de100_path_join_into(
+      entry, sizeof(table->storage) - table->used, directory, filename);
+  if (length == 0) {
+    return NULL;
+  }
+  table->used += length + 1;
+  return entry;
 }
 
 // ═══════════════════════════════════════════════════════════════════════════
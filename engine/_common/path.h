@@ -101,6 +101,46 @@ De100PathResult de100_path_get_executable_directory(void);
  */
 De100PathResult de100_path_join(const char *directory, const char *filename);
 
+/**
+ * de100_path_join into caller memory (a fixed buffer, arena space):
+ * two copies and a separator, no formatting.
+ *
+ * @return Length written, or 0 if it doesn't fit or an argument is
+ *         NULL/empty (buffer then holds "" when buffer_size > 0)
+ */
+size_t de100_path_join_into(char *buffer, size_t buffer_size,
+                            const char *directory, const char *filename);
+
+// ═══════════════════════════════════════════════════════════════════════════
+// INTERNED PATH TABLE
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// Paths needed after startup (replay slot files, ...) are joined once at
+// init into one block and handed out as stable pointers, so toggles and
+// per-frame code never build strings or ask the OS again:
+//
+//   De100PathTable table = {0};
+//   const char *input_file =
+//       de100_path_table_add(&table, exe_directory, "loop_edit_1_input.hmi");
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define DE100_PATH_TABLE_SIZE (16 * 1024)
+
+typedef struct {
+  char storage[DE100_PATH_TABLE_SIZE];
+  size_t used;
+} De100PathTable;
+
+/**
+ * Intern `directory` + `filename`.
+ *
+ * @return Pointer into the table (valid as long as it is), or NULL if
+ *         the table is full or the join fails
+ */
+const char *de100_path_table_add(De100PathTable *table, const char *directory,
+                                 const char *filename);
+
 // ═══════════════════════════════════════════════════════════════════════════
 // ERROR HANDLING
 // ═══════════════════════════════════════════════════════════════════════════
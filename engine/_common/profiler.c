@@ -0,0 +1,488 @@
+#include "profiler.h"
+
+#include <stdio.h>
+#include <string.h>
+
+// Recording is header-only; this file is the platform side and is only
+// built with DE100_INTERNAL (see build-common.sh)
+#if DE100_INTERNAL
+
+// Block ids are 1-based (0 = "not registered"); arrays are indexed id - 1
+#define BLOCK_TABLE_SIZE (DE100_PROFILER_MAX_BLOCKS * 2)
+
+// ═══════════════════════════════════════════════════════════════════════════
+// INTERNAL HELPERS
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn inline void registry_lock(De100Profiler *profiler) {
+  while (__atomic_exchange_n(&profiler->registry_lock, 1, __ATOMIC_ACQUIRE)) {
+    // Registration is rare (first hit of each site); just spin
+  }
+}
+
+de100_file_scoped_fn inline void registry_unlock(De100Profiler *profiler) {
+  __atomic_store_n(&profiler->registry_lock, 0, __ATOMIC_RELEASE);
+}
+
+de100_file_scoped_fn inline u32 hash_site(const char *name, const char *file,
+                                          u32 line) {
+  u32 hash = 2166136261u;
+  for (const char *c = name; *c; ++c) {
+    hash = (hash ^ (u8)*c) * 16777619u;
+  }
+  for (const char *c = file; *c; ++c) {
+    hash = (hash ^ (u8)*c) * 16777619u;
+  }
+  return (hash ^ line) * 16777619u;
+}
+
+/**
+ * Keep the tail of long paths: "…/game/src/draw.c" says more than the
+ * common prefix does.
+ */
+de100_file_scoped_fn inline void copy_tail(char *dest, size_t capacity,
+                                           const char *src) {
+  size_t length = strlen(src);
+  if (length >= capacity) {
+    src += length - (capacity - 1);
+  }
+  strncpy(dest, src, capacity - 1);
+  dest[capacity - 1] = '\0';
+}
+
+de100_file_scoped_fn inline bool
+block_matches(const De100ProfileBlockInfo *info, u32 hash, const char *name,
+              const char *file, u32 line) {
+  char name_tail[DE100_PROFILER_NAME_LENGTH];
+  char file_tail[DE100_PROFILER_FILE_LENGTH];
+  copy_tail(name_tail, sizeof(name_tail), name);
+  copy_tail(file_tail, sizeof(file_tail), file);
+  return info->hash == hash && info->line == line &&
+         strcmp(info->name, name_tail) == 0 &&
+         strcmp(info->file, file_tail) == 0;
+}
+
+/** `name` is in the comma-separated `filter`, or the filter is "*". */
+de100_file_scoped_fn bool filter_matches(const char *filter,
+                                         const char *name) {
+  if (strcmp(filter, "*") == 0) {
+    return true;
+  }
+  size_t name_length = strlen(name);
+  for (const char *item = filter; *item;) {
+    const char *comma = strchr(item, ',');
+    size_t length = comma ? (size_t)(comma - item) : strlen(item);
+    if (length == name_length && strncmp(item, name, length) == 0) {
+      return true;
+    }
+    if (!comma) {
+      break;
+    }
+    item = comma + 1;
+  }
+  return false;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// PLATFORM ENTRY POINTS (called through the profiler's pointers)
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn DE100_PROFILER_REGISTER_BLOCK(profiler_register_block) {
+  u32 hash = hash_site(block_name, file, line);
+  u32 id = 0;
+
+  registry_lock(profiler);
+
+  for (u32 probe = 0; probe < BLOCK_TABLE_SIZE; ++probe) {
+    u32 slot = (hash + probe) & (BLOCK_TABLE_SIZE - 1);
+    u32 existing = profiler->block_table[slot];
+
+    if (existing == 0) {
+      if (profiler->block_count == DE100_PROFILER_MAX_BLOCKS) {
+        break; // Registry full: this site stays unprofiled
+      }
+      id = ++profiler->block_count;
+      De100ProfileBlockInfo *info = &profiler->blocks[id - 1];
+      copy_tail(info->name, sizeof(info->name), block_name);
+      copy_tail(info->file, sizeof(info->file), file);
+      info->line = line;
+      info->hash = hash;
+      profiler->block_samples_counters[id - 1] =
+          profiler->counter_filter[0] &&
+          filter_matches(profiler->counter_filter, info->name);
+      profiler->block_table[slot] = (u16)id;
+      break;
+    }
+
+    if (block_matches(&profiler->blocks[existing - 1], hash, block_name, file,
+                      line)) {
+      id = existing; // Seen before (e.g. previous game library)
+      break;
+    }
+  }
+
+  registry_unlock(profiler);
+  return id;
+}
+
+de100_file_scoped_fn DE100_PROFILER_GET_THREAD(profiler_get_thread) {
+  u64 thread_id = de100_profiler_thread_id();
+
+  // Same OS thread → same slot, whichever module asks
+  u32 count = __atomic_load_n(&profiler->thread_count, __ATOMIC_ACQUIRE);
+  for (u32 i = 0; i < count; ++i) {
+    if (__atomic_load_n(&profiler->threads[i].thread_id, __ATOMIC_ACQUIRE) ==
+        thread_id) {
+      return &profiler->threads[i];
+    }
+  }
+
+  registry_lock(profiler);
+  De100ProfilerThread *thread = NULL;
+  for (u32 i = 0; i < profiler->thread_count; ++i) {
+    if (profiler->threads[i].thread_id == thread_id) {
+      thread = &profiler->threads[i];
+    }
+  }
+  if (!thread && profiler->thread_count < DE100_PROFILER_MAX_THREADS) {
+    thread = &profiler->threads[profiler->thread_count];
+    __atomic_store_n(&thread->thread_id, thread_id, __ATOMIC_RELEASE);
+    __atomic_store_n(&profiler->thread_count, profiler->thread_count + 1,
+                     __ATOMIC_RELEASE);
+  }
+  registry_unlock(profiler);
+
+  return thread;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// LIFECYCLE
+// ═══════════════════════════════════════════════════════════════════════════
+
+void de100_profiler_init(De100Profiler *profiler) {
+  if (!profiler) {
+    return;
+  }
+
+  profiler->register_block = profiler_register_block;
+  profiler->get_thread = profiler_get_thread;
+  profiler->last_frame_end_cycles = de100_profiler_cycles();
+  g_de100_profiler = profiler;
+}
+
+void de100_profiler_enable_counters(De100Profiler *profiler,
+                                    de100_profiler_read_counters_t *read,
+                                    u32 counter_mask, const char *filter) {
+  if (!profiler) {
+    return;
+  }
+  if (!read) {
+    __atomic_store_n(&profiler->read_counters, NULL, __ATOMIC_RELEASE);
+    return;
+  }
+
+  registry_lock(profiler);
+  profiler->counter_mask = counter_mask;
+  size_t length = filter ? strlen(filter) : 0;
+  if (length >= sizeof(profiler->counter_filter)) {
+    length = sizeof(profiler->counter_filter) - 1;
+  }
+  memcpy(profiler->counter_filter, filter, length);
+  profiler->counter_filter[length] = '\0';
+  for (u32 i = 0; i < profiler->block_count; ++i) {
+    profiler->block_samples_counters[i] =
+        length > 0 && filter_matches(profiler->counter_filter,
+                                     profiler->blocks[i].name);
+  }
+  registry_unlock(profiler);
+
+  // Frames count from here, on the thread that ends them
+  if (read(profiler, profiler->frame_counter_base)) {
+    __atomic_store_n(&profiler->read_counters, read, __ATOMIC_RELEASE);
+  }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// AGGREGATION
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn inline void push_span(De100Profiler *profiler,
+                                           u64 start_cycles, u64 end_cycles,
+                                           u32 block_id, u32 depth, u32 type,
+                                           u32 thread_index) {
+  if (profiler->span_count == DE100_PROFILER_MAX_SPANS) {
+    profiler->dropped_span_count++;
+    return;
+  }
+  De100ProfileSpan *span = &profiler->spans[profiler->span_count++];
+  span->start_cycles = start_cycles;
+  span->end_cycles = end_cycles;
+  span->block_id = block_id;
+  span->depth = (u8)(depth < 255 ? depth : 255);
+  span->type = (u8)type;
+  span->thread_index = (u16)thread_index;
+}
+
+de100_file_scoped_fn void drain_thread(De100Profiler *profiler,
+                                       u32 thread_index) {
+  De100ProfilerThread *thread = &profiler->threads[thread_index];
+  u64 read = thread->read_index;
+  u64 write = __atomic_load_n(&thread->write_index, __ATOMIC_ACQUIRE);
+
+  for (; read < write; ++read) {
+    const De100ProfileEvent *event =
+        &thread->events[read & (DE100_PROFILER_RING_SIZE - 1)];
+    u32 id = event->block_id;
+
+    if (event->type == DE100_PROFILE_EVENT_VALUE) {
+      if (id >= 1 && id <= DE100_PROFILE_VALUE_COUNT) {
+        thread->pending_values[id - 1] = event->cycles;
+        thread->pending_mask |= 1u << (id - 1);
+      }
+      continue;
+    }
+
+    // Values belong to the BEGIN/END right after them
+    u32 value_mask = thread->pending_mask;
+    thread->pending_mask = 0;
+
+    if (id == 0 || id > profiler->block_count) {
+      continue;
+    }
+
+    if (event->type == DE100_PROFILE_EVENT_INSTANT) {
+      profiler->last_frame[id - 1].hit_count++;
+      push_span(profiler, event->cycles, event->cycles, id,
+                thread->depth, DE100_PROFILE_EVENT_INSTANT, thread_index);
+      continue;
+    }
+
+    if (event->type == DE100_PROFILE_EVENT_BEGIN) {
+      if (thread->depth < DE100_PROFILER_MAX_DEPTH) {
+        thread->stack_block[thread->depth] = id;
+        thread->stack_start[thread->depth] = event->cycles;
+        thread->stack_child_cycles[thread->depth] = 0;
+        thread->stack_value_mask[thread->depth] = value_mask;
+        if (value_mask) {
+          memcpy(thread->stack_values[thread->depth], thread->pending_values,
+                 sizeof(thread->pending_values));
+        }
+      }
+      thread->depth++; // Counted even past the cap so ENDs stay paired
+      continue;
+    }
+
+    // END: pair with the innermost open scope. A mismatch means ring
+    // overflow dropped events; skip rather than mis-attribute.
+    if (thread->depth == 0) {
+      continue;
+    }
+    u32 top = thread->depth - 1;
+    thread->depth--;
+    if (top >= DE100_PROFILER_MAX_DEPTH || thread->stack_block[top] != id) {
+      continue;
+    }
+
+    u64 elapsed = event->cycles - thread->stack_start[top];
+    u64 child = thread->stack_child_cycles[top];
+    De100ProfileBlockStats *stats = &profiler->last_frame[id - 1];
+    stats->hit_count++;
+    stats->total_cycles += elapsed;
+    stats->self_cycles += elapsed > child ? elapsed - child : 0;
+
+    u32 counter_bits = (1u << DE100_PROFILE_COUNTER_COUNT) - 1;
+    u32 begin_mask = thread->stack_value_mask[top];
+    if ((begin_mask & value_mask & counter_bits) != 0) {
+      De100ProfileCounterStats *counters =
+          &profiler->last_frame_counters[id - 1];
+      const u64 *start = thread->stack_values[top];
+      counters->sample_count++;
+      if (begin_mask & (1u << DE100_PROFILE_VALUE_ITEMS)) {
+        counters->item_count += start[DE100_PROFILE_VALUE_ITEMS];
+      }
+      for (u32 i = 0; i < DE100_PROFILE_COUNTER_COUNT; ++i) {
+        if (begin_mask & value_mask & (1u << i)) {
+          u64 end = thread->pending_values[i];
+          counters->values[i] += end > start[i] ? end - start[i] : 0;
+        }
+      }
+    }
+
+    push_span(profiler, thread->stack_start[top], event->cycles, id, top,
+              DE100_PROFILE_EVENT_END, thread_index);
+
+    if (top > 0 && top - 1 < DE100_PROFILER_MAX_DEPTH) {
+      thread->stack_child_cycles[top - 1] += elapsed;
+    }
+  }
+
+  __atomic_store_n(&thread->read_index, read, __ATOMIC_RELEASE);
+}
+
+void de100_profiler_end_frame(De100Profiler *profiler) {
+  if (!profiler) {
+    return;
+  }
+
+  u32 block_count = profiler->block_count;
+  memset(profiler->last_frame, 0,
+         sizeof(profiler->last_frame[0]) * block_count);
+  memset(profiler->last_frame_counters, 0,
+         sizeof(profiler->last_frame_counters[0]) * block_count);
+  profiler->span_count = 0;
+
+  u32 thread_count =
+      __atomic_load_n(&profiler->thread_count, __ATOMIC_ACQUIRE);
+  for (u32 i = 0; i < thread_count; ++i) {
+    drain_thread(profiler, i);
+  }
+
+  for (u32 i = 0; i < block_count; ++i) {
+    profiler->totals[i].hit_count += profiler->last_frame[i].hit_count;
+    profiler->totals[i].total_cycles += profiler->last_frame[i].total_cycles;
+    profiler->totals[i].self_cycles += profiler->last_frame[i].self_cycles;
+
+    const De100ProfileCounterStats *frame = &profiler->last_frame_counters[i];
+    De100ProfileCounterStats *total = &profiler->total_counters[i];
+    if (frame->sample_count > 0) {
+      total->sample_count += frame->sample_count;
+      total->item_count += frame->item_count;
+      for (u32 c = 0; c < DE100_PROFILE_COUNTER_COUNT; ++c) {
+        total->values[c] += frame->values[c];
+      }
+    }
+  }
+
+  de100_profiler_read_counters_t *read_counters =
+      __atomic_load_n(&profiler->read_counters, __ATOMIC_ACQUIRE);
+  u64 counters[DE100_PROFILE_COUNTER_COUNT] = {0};
+  if (read_counters && read_counters(profiler, counters)) {
+    for (u32 c = 0; c < DE100_PROFILE_COUNTER_COUNT; ++c) {
+      u64 base = profiler->frame_counter_base[c];
+      profiler->frame_counters[c] = counters[c] > base ? counters[c] - base : 0;
+      profiler->total_frame_counters[c] += profiler->frame_counters[c];
+      profiler->frame_counter_base[c] = counters[c];
+    }
+    profiler->counted_frames++;
+  }
+
+  u64 now = de100_profiler_cycles();
+  profiler->frame_start_cycles = profiler->last_frame_end_cycles;
+  profiler->frame_cycles = now - profiler->last_frame_end_cycles;
+  profiler->last_frame_end_cycles = now;
+  profiler->frame_index++;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// REPORT
+// ═══════════════════════════════════════════════════════════════════════════
+
+/** One counters row: `values` summed over `per` units of work. */
+de100_file_scoped_fn void print_counter_row(const char *name, u32 mask,
+                                            const u64 *values, u64 per,
+                                            u64 items) {
+  char ipc[16] = "n/a";
+  char cache[16] = "n/a";
+  char branch[16] = "n/a";
+  char stall[16] = "n/a";
+  f64 cycles = (f64)values[DE100_PROFILE_COUNTER_CYCLES];
+  u32 ipc_bits = (1u << DE100_PROFILE_COUNTER_CYCLES) |
+                 (1u << DE100_PROFILE_COUNTER_INSTRUCTIONS);
+  if ((mask & ipc_bits) == ipc_bits && cycles > 0) {
+    snprintf(ipc, sizeof(ipc), "%.2f",
+             (f64)values[DE100_PROFILE_COUNTER_INSTRUCTIONS] / cycles);
+  }
+  if (mask & (1u << DE100_PROFILE_COUNTER_CACHE_MISSES)) {
+    snprintf(cache, sizeof(cache), "%.3f",
+             (f64)values[DE100_PROFILE_COUNTER_CACHE_MISSES] / (f64)per);
+  }
+  if (mask & (1u << DE100_PROFILE_COUNTER_BRANCH_MISSES)) {
+    snprintf(branch, sizeof(branch), "%.3f",
+             (f64)values[DE100_PROFILE_COUNTER_BRANCH_MISSES] / (f64)per);
+  }
+  if ((mask & (1u << DE100_PROFILE_COUNTER_STALLED_CYCLES)) && cycles > 0) {
+    snprintf(stall, sizeof(stall), "%.1f",
+             (f64)values[DE100_PROFILE_COUNTER_STALLED_CYCLES] / cycles *
+                 100.0);
+  }
+  printf("%-28.28s %6s %12s %12s %7s %10lu\n", name, ipc, cache, branch,
+         stall, (unsigned long)items);
+}
+
+void de100_profiler_print(const De100Profiler *profiler, u32 max_rows,
+                          bool use_totals) {
+  if (!profiler || profiler->block_count == 0) {
+    return;
+  }
+
+  const De100ProfileBlockStats *stats =
+      use_totals ? profiler->totals : profiler->last_frame;
+  u64 frames = use_totals ? profiler->frame_index : 1;
+  if (frames == 0) {
+    return;
+  }
+
+  // Selection by self cycles; the table is small and this is a debug print
+  bool printed[DE100_PROFILER_MAX_BLOCKS] = {0};
+  u64 dropped = 0;
+  for (u32 i = 0; i < profiler->thread_count; ++i) {
+    dropped += profiler->threads[i].dropped_events;
+  }
+
+  printf("\n═══════════════════════════════════════════════════════════\n");
+  printf("⏱️  PROFILE (%s, %lu blocks, %lu dropped events)\n",
+         use_totals ? "average per frame" : "last frame",
+         (unsigned long)profiler->block_count, (unsigned long)dropped);
+  printf("═══════════════════════════════════════════════════════════\n");
+  printf("%-28s %10s %10s %8s  %s\n", "block", "self Mc", "total Mc", "hits",
+         "site");
+
+  for (u32 row = 0; row < max_rows; ++row) {
+    u32 best = DE100_PROFILER_MAX_BLOCKS;
+    for (u32 i = 0; i < profiler->block_count; ++i) {
+      if (!printed[i] && stats[i].hit_count > 0 &&
+          (best == DE100_PROFILER_MAX_BLOCKS ||
+           stats[i].self_cycles > stats[best].self_cycles)) {
+        best = i;
+      }
+    }
+    if (best == DE100_PROFILER_MAX_BLOCKS) {
+      break;
+    }
+    printed[best] = true;
+
+    const De100ProfileBlockInfo *info = &profiler->blocks[best];
+    printf("%-28.28s %10.3f %10.3f %8.1f  %s:%u\n", info->name,
+           (f64)stats[best].self_cycles / (f64)frames / 1e6,
+           (f64)stats[best].total_cycles / (f64)frames / 1e6,
+           (f64)stats[best].hit_count / (f64)frames, info->file, info->line);
+  }
+
+  // Misses per item for DE100_TIMED_BLOCK_ITEMS blocks, per hit otherwise;
+  // the frame row is per frame
+  u64 counted_frames =
+      use_totals ? profiler->counted_frames : (profiler->counted_frames > 0);
+  if (counted_frames > 0) {
+    const De100ProfileCounterStats *counters =
+        use_totals ? profiler->total_counters : profiler->last_frame_counters;
+    printf("───────────────────────────────────────────────────────────\n");
+    printf("%-28s %6s %12s %12s %7s %10s\n", "counters", "IPC",
+           "LLC miss/it", "br miss/it", "stall%", "items");
+    print_counter_row("frame (main thread)", profiler->counter_mask,
+                      use_totals ? profiler->total_frame_counters
+                                 : profiler->frame_counters,
+                      counted_frames, 0);
+    for (u32 i = 0; i < profiler->block_count; ++i) {
+      if (counters[i].sample_count == 0) {
+        continue;
+      }
+      u64 items = counters[i].item_count;
+      print_counter_row(profiler->blocks[i].name, profiler->counter_mask,
+                        counters[i].values,
+                        items > 0 ? items : counters[i].sample_count, items);
+    }
+  }
+  printf("═══════════════════════════════════════════════════════════\n");
+}
+
+#endif // DE100_INTERNAL
@@ -0,0 +1,445 @@
+#ifndef DE100_COMMON_PROFILER_H
+#define DE100_COMMON_PROFILER_H
+
+#include "base.h"
+#include <stdbool.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h> // __rdtsc()
+#elif DE100_IS_GENERIC_POSIX
+#include <time.h>
+#endif
+
+#if DE100_IS_GENERIC_WINDOWS
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+// ═══════════════════════════════════════════════════════════════════════════
+// SCOPED PROFILER (TIMED_BLOCK)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// Usable from engine code and from the hot-reloaded game library:
+//
+//   void draw_text(...) {
+//     DE100_TIMED_FUNCTION();
+//     ...
+//     {
+//       DE100_TIMED_BLOCK("glyph_loop");
+//       ...
+//     } // block ends when the scope does
+//   }
+//
+// Each scope pushes a BEGIN and an END event (cycle count + block id) into
+// a per-thread ring buffer. Once a frame the platform walks the rings,
+// pairs events into a nesting stack and accumulates total ("inclusive")
+// and self ("exclusive", minus children) cycles per block.
+//
+// DE100_PROFILE_INSTANT("name") marks a point in time instead (hot reload,
+// audio underrun); it counts as a hit with no cycles.
+//
+// HARDWARE COUNTERS: with read_counters set (platforms/_common/
+// perf-counters.h), selected blocks also sample the CPU's counters
+// (instructions, cache and branch misses, stalls) at BEGIN and END, as
+// VALUE events ahead of the marker, and the report shows IPC and misses.
+// DE100_TIMED_BLOCK_ITEMS("update_grains", grain_count) adds the work
+// size, so misses come out per grain rather than per call.
+//
+// HOT RELOAD: everything lives in platform-owned memory. Block names and
+// files are copied into the registry on first use, and blocks are keyed by
+// (file, line, name), so after a reload each site finds its old id again
+// and the counters carry on. The game only has to re-bind its global:
+//
+//   GAME_UPDATE_AND_RENDER(game_update_and_render) {
+//     DE100_PROFILER_BIND(memory);
+//     ...
+//   }
+//
+// Compiles away entirely unless DE100_INTERNAL.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define DE100_PROFILER_MAX_BLOCKS 512
+#define DE100_PROFILER_MAX_THREADS 32
+#define DE100_PROFILER_RING_SIZE 16384 // Events per thread, power of two
+#define DE100_PROFILER_MAX_DEPTH 64
+#define DE100_PROFILER_NAME_LENGTH 48
+#define DE100_PROFILER_FILE_LENGTH 80
+#define DE100_PROFILER_MAX_SPANS 4096 // Per frame, all threads
+
+typedef enum {
+  DE100_PROFILE_EVENT_BEGIN = 0,
+  DE100_PROFILE_EVENT_END,
+  DE100_PROFILE_EVENT_INSTANT, // Point in time (hot reload, xrun, ...)
+  // cycles = a value for the next BEGIN/END, block_id = De100ProfileValue
+  // + 1
+  DE100_PROFILE_EVENT_VALUE,
+} De100ProfileEventType;
+
+typedef struct {
+  u64 cycles;
+  u32 block_id;
+  u32 type; // De100ProfileEventType
+} De100ProfileEvent;
+
+typedef enum {
+  DE100_PROFILE_COUNTER_CYCLES = 0,    // Core cycles (IPC denominator)
+  DE100_PROFILE_COUNTER_INSTRUCTIONS,  // Retired
+  DE100_PROFILE_COUNTER_CACHE_MISSES,  // Last-level cache
+  DE100_PROFILE_COUNTER_BRANCH_MISSES, // Mispredicted
+  DE100_PROFILE_COUNTER_STALLED_CYCLES, // Backend stalls (not every CPU)
+
+  DE100_PROFILE_COUNTER_COUNT,
+
+  // Not a counter: a block's work size (DE100_TIMED_BLOCK_ITEMS)
+  DE100_PROFILE_VALUE_ITEMS = DE100_PROFILE_COUNTER_COUNT,
+  DE100_PROFILE_VALUE_COUNT
+} De100ProfileValue;
+
+typedef struct {
+  u64 thread_id; // OS thread id (0 = free slot)
+
+  // Single producer (the owning thread), single consumer (frame end)
+  u64 write_index;
+  u64 read_index;
+  u64 dropped_events;
+  De100ProfileEvent events[DE100_PROFILER_RING_SIZE];
+
+  // Aggregation state (consumer only): open scopes carry across frames
+  u32 depth;
+  u32 stack_block[DE100_PROFILER_MAX_DEPTH];
+  u64 stack_start[DE100_PROFILER_MAX_DEPTH];
+  u64 stack_child_cycles[DE100_PROFILER_MAX_DEPTH];
+
+  // VALUE events waiting for their BEGIN/END, and what each open scope
+  // started with (bit per De100ProfileValue)
+  u32 pending_mask;
+  u64 pending_values[DE100_PROFILE_VALUE_COUNT];
+  u32 stack_value_mask[DE100_PROFILER_MAX_DEPTH];
+  u64 stack_values[DE100_PROFILER_MAX_DEPTH][DE100_PROFILE_VALUE_COUNT];
+} De100ProfilerThread;
+
+typedef struct {
+  char name[DE100_PROFILER_NAME_LENGTH];
+  char file[DE100_PROFILER_FILE_LENGTH];
+  u32 line;
+  u32 hash;
+} De100ProfileBlockInfo;
+
+typedef struct {
+  u64 hit_count;
+  u64 total_cycles; // Inclusive
+  u64 self_cycles;  // Exclusive of nested blocks
+} De100ProfileBlockStats;
+
+typedef struct {
+  u64 sample_count; // Hits measured with counters
+  u64 item_count;   // Sum of DE100_TIMED_BLOCK_ITEMS over those hits
+  u64 values[DE100_PROFILE_COUNTER_COUNT]; // Inclusive deltas
+} De100ProfileCounterStats;
+
+// One closed scope (or instant) of the last frame, for timeline views
+typedef struct {
+  u64 start_cycles;
+  u64 end_cycles; // == start_cycles for instants
+  u32 block_id;
+  u8 depth;
+  u8 type; // DE100_PROFILE_EVENT_END (scope) or _INSTANT
+  u16 thread_index;
+} De100ProfileSpan;
+
+typedef struct De100Profiler De100Profiler;
+
+#define DE100_PROFILER_REGISTER_BLOCK(name)                                    \
+  u32 name(De100Profiler *profiler, const char *block_name,                   \
+           const char *file, u32 line)
+typedef DE100_PROFILER_REGISTER_BLOCK(de100_profiler_register_block_t);
+
+#define DE100_PROFILER_GET_THREAD(name)                                        \
+  De100ProfilerThread *name(De100Profiler *profiler)
+typedef DE100_PROFILER_GET_THREAD(de100_profiler_get_thread_t);
+
+/** The calling thread's counters; false if they can't be read. */
+#define DE100_PROFILER_READ_COUNTERS(name)                                     \
+  bool name(De100Profiler *profiler, u64 *values)
+typedef DE100_PROFILER_READ_COUNTERS(de100_profiler_read_counters_t);
+
+struct De100Profiler {
+  // Platform entry points; stay valid across game reloads
+  de100_profiler_register_block_t *register_block;
+  de100_profiler_get_thread_t *get_thread;
+  de100_profiler_read_counters_t *read_counters; // NULL = counters off
+
+  u32 registry_lock;
+  u32 block_count;
+  De100ProfileBlockInfo blocks[DE100_PROFILER_MAX_BLOCKS];
+  u16 block_table[DE100_PROFILER_MAX_BLOCKS * 2]; // Block id, 0 = empty
+
+  u32 thread_count;
+  De100ProfilerThread threads[DE100_PROFILER_MAX_THREADS];
+
+  // Aggregates (filled by de100_profiler_end_frame)
+  u64 frame_index;
+  u64 frame_cycles; // Cycles spanned by the last frame
+  u64 last_frame_end_cycles;
+  u64 frame_start_cycles; // Start of the frame described by last_frame
+  De100ProfileBlockStats last_frame[DE100_PROFILER_MAX_BLOCKS];
+  u32 span_count; // Excess scopes still count in last_frame
+  u64 dropped_span_count;
+  De100ProfileSpan spans[DE100_PROFILER_MAX_SPANS];
+  De100ProfileBlockStats totals[DE100_PROFILER_MAX_BLOCKS];
+
+  // Hardware counters (de100_profiler_enable_counters)
+  u32 counter_mask; // Bit per De100ProfileCounter the CPU provides
+  char counter_filter[256]; // Block names to sample, comma-separated
+  u8 block_samples_counters[DE100_PROFILER_MAX_BLOCKS];
+  u64 frame_counter_base[DE100_PROFILE_COUNTER_COUNT];
+  u64 frame_counters[DE100_PROFILE_COUNTER_COUNT]; // Main thread, last frame
+  u64 total_frame_counters[DE100_PROFILE_COUNTER_COUNT];
+  u64 counted_frames;
+  De100ProfileCounterStats last_frame_counters[DE100_PROFILER_MAX_BLOCKS];
+  De100ProfileCounterStats total_counters[DE100_PROFILER_MAX_BLOCKS];
+};
+
+// ═══════════════════════════════════════════════════════════════════════════
+// RECORDING (inline so the game library needs no engine symbols)
+// ═══════════════════════════════════════════════════════════════════════════
+
+#if DE100_INTERNAL
+
+// One per module: merged across translation units by the linker, so the
+// game library and the executable each bind their own
+__attribute__((weak)) De100Profiler *g_de100_profiler = NULL;
+
+// Per translation unit and thread; refetched after a reload
+de100_file_scoped_global_var __thread De100ProfilerThread
+    *t_de100_profiler_thread;
+de100_file_scoped_global_var __thread De100Profiler *t_de100_profiler_owner;
+
+de100_file_scoped_fn inline u64 de100_profiler_cycles(void) {
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#elif defined(__clang__)
+  return __builtin_readcyclecounter();
+#elif DE100_IS_GENERIC_POSIX
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (u64)now.tv_sec * 1000000000ull + (u64)now.tv_nsec;
+#else
+  return 0;
+#endif
+}
+
+de100_file_scoped_fn inline u64 de100_profiler_thread_id(void) {
+#if DE100_IS_GENERIC_WINDOWS
+  return (u64)GetCurrentThreadId() + 1;
+#else
+  return (u64)(uintptr_t)pthread_self() | 1; // Never 0
+#endif
+}
+
+de100_file_scoped_fn inline void
+de100_profiler_record_at(u32 block_id, u32 type, u64 cycles) {
+  De100Profiler *profiler = g_de100_profiler;
+  if (!profiler || block_id == 0) {
+    return;
+  }
+
+  if (t_de100_profiler_owner != profiler) {
+    t_de100_profiler_thread = profiler->get_thread(profiler);
+    t_de100_profiler_owner = profiler;
+  }
+  De100ProfilerThread *thread = t_de100_profiler_thread;
+  if (!thread) {
+    return; // Out of thread slots
+  }
+
+  u64 write = thread->write_index;
+  u64 read = __atomic_load_n(&thread->read_index, __ATOMIC_ACQUIRE);
+  if (write - read >= DE100_PROFILER_RING_SIZE) {
+    thread->dropped_events++;
+    return;
+  }
+
+  De100ProfileEvent *event =
+      &thread->events[write & (DE100_PROFILER_RING_SIZE - 1)];
+  event->cycles = cycles;
+  event->block_id = block_id;
+  event->type = type;
+  __atomic_store_n(&thread->write_index, write + 1, __ATOMIC_RELEASE);
+}
+
+de100_file_scoped_fn inline void de100_profiler_record(u32 block_id,
+                                                       u32 type) {
+  de100_profiler_record_at(block_id, type, de100_profiler_cycles());
+}
+
+de100_file_scoped_fn inline u32 de100_profiler_block_id(u32 *cached_id,
+                                                        const char *name,
+                                                        const char *file,
+                                                        u32 line) {
+  De100Profiler *profiler = g_de100_profiler;
+  if (!profiler) {
+    return 0;
+  }
+
+  // Racing threads register the same site to the same id; a stale id from
+  // before a reload is impossible since the static is reset with the DLL
+  u32 id = __atomic_load_n(cached_id, __ATOMIC_RELAXED);
+  if (id == 0) {
+    id = profiler->register_block(profiler, name, file, line);
+    __atomic_store_n(cached_id, id, __ATOMIC_RELAXED);
+  }
+  return id;
+}
+
+/**
+ * A scope measured elsewhere (e.g. frame phases timed between marks).
+ * Emitted as an adjacent BEGIN/END pair, so it nests under nothing.
+ */
+de100_file_scoped_fn inline void
+de100_profiler_record_scope(u32 *cached_id, const char *name,
+                            const char *file, u32 line, u64 start_cycles,
+                            u64 end_cycles) {
+  u32 id = de100_profiler_block_id(cached_id, name, file, line);
+  de100_profiler_record_at(id, DE100_PROFILE_EVENT_BEGIN, start_cycles);
+  de100_profiler_record_at(id, DE100_PROFILE_EVENT_END, end_cycles);
+}
+
+/** VALUE events for the counters, if this block samples them. */
+de100_file_scoped_fn inline bool de100_profiler_record_counters(u32 block_id) {
+  De100Profiler *profiler = g_de100_profiler;
+  if (!profiler || block_id == 0) {
+    return false;
+  }
+  de100_profiler_read_counters_t *read_counters =
+      __atomic_load_n(&profiler->read_counters, __ATOMIC_ACQUIRE);
+  if (!read_counters ||
+      !__atomic_load_n(&profiler->block_samples_counters[block_id - 1],
+                       __ATOMIC_RELAXED)) {
+    return false;
+  }
+
+  u64 values[DE100_PROFILE_COUNTER_COUNT] = {0};
+  if (!read_counters(profiler, values)) {
+    return false;
+  }
+  for (u32 i = 0; i < DE100_PROFILE_COUNTER_COUNT; ++i) {
+    if (profiler->counter_mask & (1u << i)) {
+      de100_profiler_record_at(i + 1, DE100_PROFILE_EVENT_VALUE, values[i]);
+    }
+  }
+  return true;
+}
+
+typedef struct {
+  u32 block_id;
+  bool has_counters;
+} De100TimedBlock;
+
+de100_file_scoped_fn inline De100TimedBlock
+de100_timed_block_begin_items(u32 *cached_id, const char *name,
+                              const char *file, u32 line, u64 items) {
+  u32 id = de100_profiler_block_id(cached_id, name, file, line);
+  if (items > 0 && id != 0) {
+    de100_profiler_record_at(DE100_PROFILE_VALUE_ITEMS + 1,
+                             DE100_PROFILE_EVENT_VALUE, items);
+  }
+  bool has_counters = de100_profiler_record_counters(id);
+  de100_profiler_record(id, DE100_PROFILE_EVENT_BEGIN);
+  return (De100TimedBlock){id, has_counters};
+}
+
+de100_file_scoped_fn inline De100TimedBlock
+de100_timed_block_begin(u32 *cached_id, const char *name, const char *file,
+                        u32 line) {
+  return de100_timed_block_begin_items(cached_id, name, file, line, 0);
+}
+
+de100_file_scoped_fn inline void de100_timed_block_end(De100TimedBlock *block) {
+  if (block->has_counters) {
+    de100_profiler_record_counters(block->block_id);
+  }
+  de100_profiler_record(block->block_id, DE100_PROFILE_EVENT_END);
+}
+
+#define DE100_PROFILER_CONCAT_(a, b) a##b
+#define DE100_PROFILER_CONCAT(a, b) DE100_PROFILER_CONCAT_(a, b)
+
+#define DE100_TIMED_BLOCK(name)                                                \
+  local_persist_var u32 DE100_PROFILER_CONCAT(de100_block_id_, __LINE__);     \
+  De100TimedBlock DE100_PROFILER_CONCAT(de100_timed_block_, __LINE__)         \
+      __attribute__((cleanup(de100_timed_block_end))) =                        \
+          de100_timed_block_begin(                                             \
+              &DE100_PROFILER_CONCAT(de100_block_id_, __LINE__), (name),       \
+              __FILE__, __LINE__)
+
+#define DE100_TIMED_FUNCTION() DE100_TIMED_BLOCK(__func__)
+
+/** A timed block doing `items` units of work (pixels, grains, ...). */
+#define DE100_TIMED_BLOCK_ITEMS(name, items)                                   \
+  local_persist_var u32 DE100_PROFILER_CONCAT(de100_block_id_, __LINE__);     \
+  De100TimedBlock DE100_PROFILER_CONCAT(de100_timed_block_, __LINE__)         \
+      __attribute__((cleanup(de100_timed_block_end))) =                        \
+          de100_timed_block_begin_items(                                       \
+              &DE100_PROFILER_CONCAT(de100_block_id_, __LINE__), (name),       \
+              __FILE__, __LINE__, (u64)(items))
+
+#define DE100_PROFILE_INSTANT(name)                                            \
+  do {                                                                         \
+    local_persist_var u32 de100_instant_id;                                    \
+    de100_profiler_record(de100_profiler_block_id(&de100_instant_id, (name),   \
+                                                  __FILE__, __LINE__),         \
+                          DE100_PROFILE_EVENT_INSTANT);                        \
+  } while (0)
+
+#define DE100_PROFILER_BIND(game_memory)                                       \
+  (g_de100_profiler = (game_memory)->profiler)
+
+#else // !DE100_INTERNAL
+
+#define DE100_TIMED_BLOCK(name)
+#define DE100_TIMED_BLOCK_ITEMS(name, items) ((void)(items))
+#define DE100_TIMED_FUNCTION()
+#define DE100_PROFILE_INSTANT(name)
+#define DE100_PROFILER_BIND(game_memory) ((void)(game_memory))
+
+#endif // DE100_INTERNAL
+
+// ═══════════════════════════════════════════════════════════════════════════
+// PLATFORM API (profiler.c)
+// ═══════════════════════════════════════════════════════════════════════════
+
+/**
+ * Set up a profiler in caller-owned (zeroed) memory of
+ * sizeof(De100Profiler) bytes.
+ */
+void de100_profiler_init(De100Profiler *profiler);
+
+/**
+ * Drain every thread's ring and aggregate the frame. Call on the main
+ * thread once per frame, after all work for the frame has completed.
+ */
+void de100_profiler_end_frame(De100Profiler *profiler);
+
+/**
+ * Turn on hardware counters: `read_counters` reads the calling thread's
+ * (see perf-counters.h), `counter_mask` says which it provides, and the
+ * blocks named in `filter` ("update_grains,find_best_target", "*" for all)
+ * sample them. Frames are always counted. NULL `read_counters` turns
+ * sampling off again (collected stats stay for the report).
+ */
+void de100_profiler_enable_counters(De100Profiler *profiler,
+                                    de100_profiler_read_counters_t *read,
+                                    u32 counter_mask, const char *filter);
+
+/**
+ * Print the `max_rows` most expensive blocks (by self cycles) of the last
+ * frame, or of all frames so far when `use_totals`. With counters, a
+ * second table gives IPC and misses per item (or per hit).
+ */
+void de100_profiler_print(const De100Profiler *profiler, u32 max_rows,
+                          bool use_totals);
+
+#endif // DE100_COMMON_PROFILER_H
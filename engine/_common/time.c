@@ -1,5 +1,8 @@
 #include "time.h"
 
+#include <stdlib.h>
+#include <string.h>
+
 // ═══════════════════════════════════════════════════════════════════════════
 // PLATFORM-SPECIFIC INCLUDES
 // ═══════════════════════════════════════════════════════════════════════════
@@ -121,6 +124,125 @@ f64 de100_get_wall_clock(void) {
 #endif
 }
 
+// ═══════════════════════════════════════════════════════════════════════════
+// FAST TIMESTAMPS
+// ═══════════════════════════════════════════════════════════════════════════
+
+// OS ticks until de100_timestamp_init() says otherwise
+De100TimestampClock g_de100_timestamp_clock = {
+    .source = DE100_TIMESTAMP_SOURCE_OS,
+    .ticks_per_second = 1000000000.0,
+    .seconds_per_tick = 1.0 / 1000000000.0,
+};
+
+u64 de100_timestamp_os_ticks(void) {
+  De100TimeSpec now;
+  de100_get_timespec(&now);
+  return (u64)now.seconds * 1000000000ull + (u64)now.nanoseconds;
+}
+
+#if DE100_TIMESTAMP_X86
+
+// CPUID 0x80000007 EDX bit 8: the TSC ticks at a constant rate in every
+// P-, C- and T-state, so it can stand in for wall time
+de100_file_scoped_fn bool x86_has_invariant_tsc(void) {
+#if defined(_MSC_VER)
+  int regs[4];
+  __cpuid(regs, (int)0x80000000);
+  if ((u32)regs[0] < 0x80000007u) {
+    return false;
+  }
+  __cpuid(regs, (int)0x80000007);
+  return ((u32)regs[3] & (1u << 8)) != 0;
+#else
+  u32 eax, ebx, ecx, edx;
+  __asm__ volatile("cpuid"
+                   : "=a"(eax), "=b"(ebx), "=c"(ecx), "=d"(edx)
+                   : "a"(0x80000000u), "c"(0));
+  if (eax < 0x80000007u) {
+    return false;
+  }
+  __asm__ volatile("cpuid"
+                   : "=a"(eax), "=b"(ebx), "=c"(ecx), "=d"(edx)
+                   : "a"(0x80000007u), "c"(0));
+  return (edx & (1u << 8)) != 0;
+#endif
+}
+
+// One (wall, tsc) pair: the TSC read is bracketed by two wall reads and
+// paired with their midpoint, halving the error of a single read
+de100_file_scoped_fn void x86_sample_tsc(f64 *out_seconds, u64 *out_ticks) {
+  f64 before = de100_get_wall_clock();
+  u64 ticks = __rdtsc();
+  f64 after = de100_get_wall_clock();
+  *out_seconds = (before + after) * 0.5;
+  *out_ticks = ticks;
+}
+
+#endif // DE100_TIMESTAMP_X86
+
+#ifndef DE100_TIMESTAMP_CALIBRATION_SECONDS
+#define DE100_TIMESTAMP_CALIBRATION_SECONDS 0.02
+#endif
+
+void de100_timestamp_init(void) {
+  local_persist_var bool initialized = false;
+  if (initialized) {
+    return;
+  }
+  initialized = true;
+
+  const char *override = getenv("DE100_TIMESTAMP");
+  if (override && strcmp(override, "os") == 0) {
+    return;
+  }
+
+#if DE100_TIMESTAMP_X86
+  if (!x86_has_invariant_tsc()) {
+    return;
+  }
+  f64 start_seconds, end_seconds;
+  u64 start_ticks, end_ticks;
+  x86_sample_tsc(&start_seconds, &start_ticks);
+  // Busy-wait, not sleep: the calibration window is then exactly what
+  // was measured, whatever the scheduler does with a sleep
+  while (de100_get_wall_clock() - start_seconds <
+         DE100_TIMESTAMP_CALIBRATION_SECONDS) {
+  }
+  x86_sample_tsc(&end_seconds, &end_ticks);
+
+  f64 elapsed = end_seconds - start_seconds;
+  if (elapsed <= 0.0 || end_ticks <= start_ticks) {
+    return;
+  }
+  g_de100_timestamp_clock.ticks_per_second =
+      (f64)(end_ticks - start_ticks) / elapsed;
+  g_de100_timestamp_clock.seconds_per_tick =
+      1.0 / g_de100_timestamp_clock.ticks_per_second;
+  g_de100_timestamp_clock.source = DE100_TIMESTAMP_SOURCE_TSC;
+#elif DE100_TIMESTAMP_ARM64
+  u64 frequency;
+  __asm__ volatile("mrs %0, cntfrq_el0" : "=r"(frequency));
+  if (frequency == 0) {
+    return; // Firmware didn't program it
+  }
+  g_de100_timestamp_clock.ticks_per_second = (f64)frequency;
+  g_de100_timestamp_clock.seconds_per_tick = 1.0 / (f64)frequency;
+  g_de100_timestamp_clock.source = DE100_TIMESTAMP_SOURCE_CNTVCT;
+#endif
+}
+
+const char *de100_timestamp_source_name(void) {
+  switch (g_de100_timestamp_clock.source) {
+  case DE100_TIMESTAMP_SOURCE_TSC:
+    return "tsc";
+  case DE100_TIMESTAMP_SOURCE_CNTVCT:
+    return "cntvct";
+  default:
+    return "os";
+  }
+}
+
 // ═══════════════════════════════════════════════════════════════════════════
 // SLEEP FUNCTIONS
 // ═══════════════════════════════════════════════════════════════════════════
@@ -227,10 +349,128 @@ void de100_get_timespec(De100TimeSpec *out_time) {
 #endif
 }
 
+// ═══════════════════════════════════════════════════════════════════════════
+// SLEEP UNTIL (ABSOLUTE, HIGH RESOLUTION)
+// ═══════════════════════════════════════════════════════════════════════════
+
+#if defined(_WIN32)
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+
+// One timer per thread; created on first use
+de100_file_scoped_fn HANDLE win32_get_wait_timer(void) {
+  local_persist_var __declspec(thread) HANDLE timer = NULL;
+
+  if (!timer) {
+    timer = CreateWaitableTimerExW(NULL, NULL,
+                                   CREATE_WAITABLE_TIMER_HIGH_RESOLUTION,
+                                   TIMER_ALL_ACCESS);
+  }
+  if (!timer) {
+    // Pre-1803: regular timer, coarse unless timeBeginPeriod(1) is active
+    timer = CreateWaitableTimerExW(NULL, NULL, 0, TIMER_ALL_ACCESS);
+  }
+  return timer;
+}
+#endif
+
+void de100_sleep_until_timespec(const De100TimeSpec *deadline) {
+  if (!deadline) {
+    return;
+  }
+
+#if defined(_WIN32)
+  // ─────────────────────────────────────────────────────────────────────
+  // WINDOWS: waitable timer with a relative due time
+  // ─────────────────────────────────────────────────────────────────────
+  // Waitable timers take absolute times in the system (wall) clock, not
+  // QPC, so convert to a relative wait in 100ns units (negative = relative).
+  // ─────────────────────────────────────────────────────────────────────
+
+  De100TimeSpec now;
+  de100_get_timespec(&now);
+  f64 remaining = de100_timespec_diff_seconds(&now, deadline);
+  if (remaining <= 0.0) {
+    return;
+  }
+
+  HANDLE timer = win32_get_wait_timer();
+  if (!timer) {
+    de100_sleep_seconds(remaining);
+    return;
+  }
+
+  LARGE_INTEGER due;
+  due.QuadPart = -(LONGLONG)(remaining * 10000000.0);
+  if (due.QuadPart == 0) {
+    return;
+  }
+  if (SetWaitableTimerEx(timer, &due, 0, NULL, NULL, NULL, 0)) {
+    WaitForSingleObject(timer, INFINITE);
+  } else {
+    de100_sleep_seconds(remaining);
+  }
+
+#elif defined(__APPLE__)
+  // ─────────────────────────────────────────────────────────────────────
+  // MACOS: mach_wait_until takes absolute mach ticks
+  // ─────────────────────────────────────────────────────────────────────
+
+  CachedTimebase tb = macos_get_timebase();
+  u64 nanos = (u64)deadline->seconds * 1000000000ULL +
+              (u64)deadline->nanoseconds;
+  mach_wait_until(nanos * tb.denom / tb.numer);
+
+#elif defined(__linux__) || defined(__FreeBSD__) || defined(__unix__)
+  // ─────────────────────────────────────────────────────────────────────
+  // LINUX/BSD: clock_nanosleep with TIMER_ABSTIME
+  // ─────────────────────────────────────────────────────────────────────
+  // Same clock as de100_get_timespec(). Passing the deadline itself (not a
+  // duration) makes EINTR restarts exact. Returns the error directly
+  // rather than via errno.
+  // ─────────────────────────────────────────────────────────────────────
+
+  struct timespec target;
+  target.tv_sec = (time_t)deadline->seconds;
+  target.tv_nsec = (long)deadline->nanoseconds;
+
+  while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &target, NULL) ==
+         EINTR) {
+    // Signal interrupted; sleep again to the same deadline
+  }
+
+#else
+#error "de100_sleep_until_timespec() not implemented for this platform"
+#endif
+}
+
 // ═══════════════════════════════════════════════════════════════════════════
 // TIMESPEC UTILITIES
 // ═══════════════════════════════════════════════════════════════════════════
 
+De100TimeSpec de100_timespec_add_seconds(const De100TimeSpec *time,
+                                         f64 seconds) {
+  De100TimeSpec result = {0};
+  if (!time) {
+    return result;
+  }
+
+  i64 nanos = (i64)(seconds * 1000000000.0);
+  result.seconds = time->seconds + nanos / 1000000000;
+  result.nanoseconds = time->nanoseconds + nanos % 1000000000;
+
+  // Normalise to [0, 1e9)
+  if (result.nanoseconds < 0) {
+    result.seconds -= 1;
+    result.nanoseconds += 1000000000;
+  } else if (result.nanoseconds >= 1000000000) {
+    result.seconds += 1;
+    result.nanoseconds -= 1000000000;
+  }
+  return result;
+}
+
 f64 de100_timespec_to_seconds(const De100TimeSpec *time) {
   if (!time) {
     return 0.0;
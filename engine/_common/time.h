@@ -43,6 +43,102 @@ de100_file_scoped_fn inline f64 de100_get_seconds_elapsed(f64 start, f64 end) {
   return end - start;
 }
 
+// ═══════════════════════════════════════════════════════════════════════════
+// FAST TIMESTAMPS (calibrated CPU counter)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// de100_timestamp() reads the CPU's constant-rate counter directly, a few
+// nanoseconds per call instead of a vDSO clock_gettime / QPC:
+//
+//   x86-64   rdtsc, when CPUID reports an invariant TSC (constant rate
+//            across P-states and sleep states). Frequency calibrated once
+//            against de100_get_wall_clock() (~20 ms, in
+//            de100_timestamp_init()).
+//   AArch64  cntvct_el0, frequency from cntfrq_el0: no calibration.
+//   Other    OS monotonic clock in nanoseconds (also when the TSC isn't
+//            invariant, or with DE100_TIMESTAMP=os in the environment).
+//
+//   u64 start = de100_timestamp();
+//   ...
+//   f64 seconds = de100_timestamp_seconds_between(start, de100_timestamp());
+//
+// Ticks are only meaningful on this machine, in this run. Use them for
+// intervals and deadlines (spin loops, profiler zones); a calibrated
+// rate is within ~10 ppm of the OS clock, so anchor long spans on
+// de100_get_wall_clock() instead. Until de100_timestamp_init() runs,
+// every call takes the OS path, so early callers still get valid
+// (if slower) timestamps.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#if (defined(__x86_64__) || defined(__i386__)) &&                              \
+    (defined(__GNUC__) || defined(__clang__))
+#define DE100_TIMESTAMP_X86 1
+#include <x86intrin.h> // __rdtsc()
+#elif defined(_M_X64) || defined(_M_IX86)
+#define DE100_TIMESTAMP_X86 1
+#include <intrin.h>
+#elif defined(__aarch64__) && (defined(__GNUC__) || defined(__clang__))
+#define DE100_TIMESTAMP_ARM64 1
+#endif
+
+typedef enum {
+  DE100_TIMESTAMP_SOURCE_OS = 0, // Monotonic clock, nanoseconds
+  DE100_TIMESTAMP_SOURCE_TSC,    // rdtsc
+  DE100_TIMESTAMP_SOURCE_CNTVCT, // cntvct_el0
+} De100TimestampSource;
+
+typedef struct {
+  De100TimestampSource source;
+  f64 ticks_per_second;
+  f64 seconds_per_tick;
+} De100TimestampClock;
+
+extern De100TimestampClock g_de100_timestamp_clock;
+
+/**
+ * Pick the counter and calibrate it. Idempotent; call once at startup,
+ * before any thread takes timestamps (the clock is not locked).
+ */
+void de100_timestamp_init(void);
+
+/** Short name of the active source ("tsc", "cntvct", "os"). */
+const char *de100_timestamp_source_name(void);
+
+/** The OS fallback: monotonic clock in nanoseconds. */
+u64 de100_timestamp_os_ticks(void);
+
+de100_file_scoped_fn inline u64 de100_timestamp(void) {
+#if DE100_TIMESTAMP_X86
+  if (g_de100_timestamp_clock.source == DE100_TIMESTAMP_SOURCE_TSC) {
+    return __rdtsc();
+  }
+#elif DE100_TIMESTAMP_ARM64
+  if (g_de100_timestamp_clock.source == DE100_TIMESTAMP_SOURCE_CNTVCT) {
+    u64 ticks;
+    __asm__ volatile("mrs %0, cntvct_el0" : "=r"(ticks));
+    return ticks;
+  }
+#endif
+  return de100_timestamp_os_ticks();
+}
+
+de100_file_scoped_fn inline f64 de100_timestamp_to_seconds(u64 ticks) {
+  return (f64)ticks * g_de100_timestamp_clock.seconds_per_tick;
+}
+
+de100_file_scoped_fn inline u64 de100_timestamp_from_seconds(f64 seconds) {
+  return seconds > 0.0
+             ? (u64)(seconds * g_de100_timestamp_clock.ticks_per_second)
+             : 0;
+}
+
+/** Seconds from `start` to `end` (0 if end is earlier). */
+de100_file_scoped_fn inline f64 de100_timestamp_seconds_between(u64 start,
+                                                                u64 end) {
+  return end > start ? de100_timestamp_to_seconds(end - start) : 0.0;
+}
+
 // ═══════════════════════════════════════════════════════════════════════════
 // SLEEP FUNCTIONS
 // ═══════════════════════════════════════════════════════════════════════════
@@ -83,6 +179,29 @@ void de100_sleep_ms(u32 milliseconds);
  */
 void de100_get_timespec(De100TimeSpec *out_time);
 
+/**
+ * Sleep until an absolute de100_get_timespec() time, using the OS's
+ * high-resolution timer:
+ *   Linux/BSD: clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME)
+ *   Windows:   high-resolution waitable timer (Windows 10 1803+; falls back
+ *              to a regular waitable timer)
+ *   macOS:     mach_wait_until()
+ *
+ * Returns immediately if the deadline has passed. Absolute deadlines don't
+ * drift when the call is interrupted and restarted, but wakeups can still
+ * land late (scheduler latency); callers that need precision should aim
+ * early and spin the rest (see frame_timing_wait_until_target()).
+ *
+ * @param deadline Time to wake at (NULL returns immediately)
+ */
+void de100_sleep_until_timespec(const De100TimeSpec *deadline);
+
+/**
+ * Add seconds (may be negative) to a De100TimeSpec.
+ */
+De100TimeSpec de100_timespec_add_seconds(const De100TimeSpec *time,
+                                         f64 seconds);
+
 /**
  * Convert De100TimeSpec to seconds.
  *
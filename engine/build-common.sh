@@ -111,29 +111,69 @@ DE100_SRC_MAIN="$DE100_ENGINE_DIR/main.c"
 
 DE100_SRC_COMMON=(
     "$DE100_ENGINE_DIR/engine.c"
+    "$DE100_ENGINE_DIR/_common/compression.c"
+    "$DE100_ENGINE_DIR/_common/cpu.c"
     "$DE100_ENGINE_DIR/_common/dll.c"
     "$DE100_ENGINE_DIR/_common/file.c"
+    "$DE100_ENGINE_DIR/_common/file-watch.c"
+    "$DE100_ENGINE_DIR/_common/hash.c"
+    "$DE100_ENGINE_DIR/_common/log.c"
     "$DE100_ENGINE_DIR/_common/memory.c"
     "$DE100_ENGINE_DIR/_common/path.c"
     "$DE100_ENGINE_DIR/_common/time.c"
 )
 
 DE100_SRC_GAME=(
+    "$DE100_ENGINE_DIR/game/asset-pack.c"
+    "$DE100_ENGINE_DIR/game/asset-stream.c"
     "$DE100_ENGINE_DIR/game/audio.c"
+    "$DE100_ENGINE_DIR/game/audio-assets.c"
+    "$DE100_ENGINE_DIR/game/audio-bus.c"
     "$DE100_ENGINE_DIR/game/base.c"
     "$DE100_ENGINE_DIR/game/debug-file-io.c"
     "$DE100_ENGINE_DIR/game/config.c"
+    "$DE100_ENGINE_DIR/game/file-load.c"
+    "$DE100_ENGINE_DIR/game/font.c"
     "$DE100_ENGINE_DIR/game/game-loader.c"
     "$DE100_ENGINE_DIR/game/inputs.c"
+    "$DE100_ENGINE_DIR/game/kernels.c"
     "$DE100_ENGINE_DIR/game/memory.c"
+    "$DE100_ENGINE_DIR/game/save-game.c"
     "$DE100_ENGINE_DIR/game/thread.c"
+    "$DE100_ENGINE_DIR/game/ui.c"
 )
 
 DE100_SRC_PLATFORM_COMMON=(
+    "$DE100_ENGINE_DIR/platforms/_common/replay-archive.c"
+    "$DE100_ENGINE_DIR/platforms/_common/replay-timeline.c"
     "$DE100_ENGINE_DIR/platforms/_common/replay-buffer.c"
+    "$DE100_ENGINE_DIR/platforms/_common/replay-hash.c"
+    "$DE100_ENGINE_DIR/platforms/_common/input-stream.c"
     "$DE100_ENGINE_DIR/platforms/_common/inputs-recording.c"
     "$DE100_ENGINE_DIR/platforms/_common/adaptive-fps.c"
+    "$DE100_ENGINE_DIR/platforms/_common/dynamic-resolution.c"
+    "$DE100_ENGINE_DIR/platforms/_common/engine-instances.c"
+    "$DE100_ENGINE_DIR/platforms/_common/benchmark.c"
+    "$DE100_ENGINE_DIR/platforms/_common/capture.c"
+    "$DE100_ENGINE_DIR/platforms/_common/spectate.c"
+    "$DE100_ENGINE_DIR/platforms/_common/config-file.c"
+    "$DE100_ENGINE_DIR/platforms/_common/async-io.c"
+    "$DE100_ENGINE_DIR/platforms/_common/background-loader.c"
+    "$DE100_ENGINE_DIR/platforms/_common/idle-scheduler.c"
+    "$DE100_ENGINE_DIR/platforms/_common/asset-watcher.c"
+    "$DE100_ENGINE_DIR/platforms/_common/frame-graph.c"
     "$DE100_ENGINE_DIR/platforms/_common/frame-timing.c"
+    "$DE100_ENGINE_DIR/platforms/_common/memory-stats.c"
+    "$DE100_ENGINE_DIR/platforms/_common/netplay.c"
+    "$DE100_ENGINE_DIR/platforms/_common/undo-log.c"
+    "$DE100_ENGINE_DIR/platforms/_common/rewind-ring.c"
+    "$DE100_ENGINE_DIR/platforms/_common/telemetry.c"
+    "$DE100_ENGINE_DIR/platforms/_common/fixed-timestep.c"
+    "$DE100_ENGINE_DIR/platforms/_common/present-scale.c"
+    "$DE100_ENGINE_DIR/platforms/_common/present-thread.c"
+    "$DE100_ENGINE_DIR/platforms/_common/render-pipeline.c"
+    "$DE100_ENGINE_DIR/platforms/_common/thread-placement.c"
+    "$DE100_ENGINE_DIR/platforms/_common/work-queue.c"
 )
 
 # ───────────────────────────────────────────────────────────────────────────────
@@ -144,6 +184,25 @@ DE100_SRC_BACKEND=()
 DE100_BACKEND_LIBS=""
 DE100_BACKEND=""
 
+# xdg-shell client glue for the wayland backend, regenerated when the
+# protocol XML is newer than it
+de100_generate_xdg_shell() {
+    local out_dir="$1"
+    local protocols_dir
+    protocols_dir="$(pkg-config --variable=pkgdatadir wayland-protocols 2>/dev/null)"
+    local xml="${protocols_dir:-/usr/share/wayland-protocols}/stable/xdg-shell/xdg-shell.xml"
+
+    if ! command -v wayland-scanner >/dev/null || [[ ! -f "$xml" ]]; then
+        echo "Error: wayland backend needs wayland-scanner and wayland-protocols" >&2
+        return 1
+    fi
+    mkdir -p "$out_dir"
+    if [[ "$xml" -nt "$out_dir/xdg-shell-protocol.c" ]]; then
+        wayland-scanner client-header "$xml" "$out_dir/xdg-shell-client-protocol.h" &&
+            wayland-scanner private-code "$xml" "$out_dir/xdg-shell-protocol.c"
+    fi
+}
+
 de100_set_backend() {
     local backend="$1"
     local GAME_DIR="$2"
@@ -153,6 +212,12 @@ de100_set_backend() {
     if [[ "$DE100_INTERNAL" == "1" ]]; then
         DE100_SRC_PLATFORM_COMMON+=(
             "$DE100_ENGINE_DIR/platforms/_common/frame-stats.c"
+            "$DE100_ENGINE_DIR/platforms/_common/debug-overlay.c"
+            "$DE100_ENGINE_DIR/platforms/_common/trace-export.c"
+            "$DE100_ENGINE_DIR/platforms/_common/flight-recorder.c"
+            "$DE100_ENGINE_DIR/platforms/_common/perf-counters.c"
+            "$DE100_ENGINE_DIR/platforms/_common/input-latency.c"
+            "$DE100_ENGINE_DIR/_common/profiler.c"
         )
     fi
     
@@ -167,19 +232,67 @@ de100_set_backend() {
     
     local backend_dir="$DE100_ENGINE_DIR/platforms/$backend"
     
-    DE100_SRC_BACKEND=(
-        "$backend_dir/audio.c"
-        "$backend_dir/backend.c"
-        "$backend_dir/inputs/mouse.c"
-        "$backend_dir/hooks/utils.c"
-        "$GAME_DIR/adapters/$backend/inputs/keyboard.c"
-        "$GAME_DIR/adapters/$backend/inputs/joystick.c"
-    )
+    if [[ "$backend" == "headless" ]]; then
+        # No window, audio device or input devices, so no game adapters
+        DE100_SRC_BACKEND=(
+            "$backend_dir/backend.c"
+            "$backend_dir/hooks/utils.c"
+        )
+    elif [[ "$backend" == "drm" ]]; then
+        # Kiosk: X11's ALSA audio, gamepad code and timing hooks, an evdev
+        # keyboard adapter of its own and no mouse
+        local x11_dir="$DE100_ENGINE_DIR/platforms/x11"
+        DE100_SRC_BACKEND=(
+            "$backend_dir/backend.c"
+            "$x11_dir/audio.c"
+            "$x11_dir/audio-pulse.c"
+            "$x11_dir/hooks/utils.c"
+            "$x11_dir/inputs/evdev.c"
+            "$GAME_DIR/adapters/drm/inputs/keyboard.c"
+            "$GAME_DIR/adapters/x11/inputs/joystick.c"
+        )
+    elif [[ "$backend" == "wayland" ]]; then
+        # X11's ALSA audio, gamepad code and timing hooks; Wayland key codes
+        # are evdev codes, so the game's DRM keyboard adapter serves both
+        local x11_dir="$DE100_ENGINE_DIR/platforms/x11"
+        de100_generate_xdg_shell "$backend_dir/protocol" || return 1
+        DE100_SRC_BACKEND=(
+            "$backend_dir/backend.c"
+            "$backend_dir/protocol/xdg-shell-protocol.c"
+            "$x11_dir/audio.c"
+            "$x11_dir/audio-pulse.c"
+            "$x11_dir/hooks/utils.c"
+            "$x11_dir/inputs/evdev.c"
+            "$GAME_DIR/adapters/drm/inputs/keyboard.c"
+            "$GAME_DIR/adapters/x11/inputs/joystick.c"
+        )
+    else
+        DE100_SRC_BACKEND=(
+            "$backend_dir/audio.c"
+            "$backend_dir/backend.c"
+            "$backend_dir/inputs/mouse.c"
+            "$backend_dir/hooks/utils.c"
+            "$GAME_DIR/adapters/$backend/inputs/keyboard.c"
+            "$GAME_DIR/adapters/$backend/inputs/joystick.c"
+        )
+    fi
     
     # Set backend-specific library dependencies
     case "$backend" in
         x11)
-            DE100_BACKEND_LIBS="-lX11 -lXrandr -lGL -lGLX -lasound -ldl"
+            DE100_BACKEND_LIBS="-lX11 -lXext -lXrandr -lXi -lGL -lGLX -lasound -lpthread -ldl"
+            # get_monitor_refresh_hz() for the adaptive FPS tiers
+            DE100_SRC_BACKEND+=("$DE100_ENGINE_DIR/_internal/utils.c")
+            # Background gamepad reader (GameConfig.prefer_threaded_joystick)
+            DE100_SRC_BACKEND+=("$backend_dir/inputs/evdev.c")
+            # Sound server output (GameConfig.prefer_audio_server)
+            DE100_SRC_BACKEND+=("$backend_dir/audio-pulse.c")
+            # MIT-SHM presenter (GameConfig.prefer_shm_present, or no GLX)
+            DE100_SRC_BACKEND+=("$backend_dir/shm-present.c")
+            # epoll / timerfd frame waits (GameConfig.prefer_event_loop)
+            DE100_SRC_BACKEND+=("$backend_dir/event-wait.c")
+            # Keycode → keysym / game button tables (rebuilt on MappingNotify)
+            DE100_SRC_BACKEND+=("$backend_dir/inputs/keymap.c")
         ;;
         raylib)
             case "$DE100_OS" in
@@ -188,9 +301,19 @@ de100_set_backend() {
                 *)       DE100_BACKEND_LIBS="-lraylib -lpthread -ldl" ;;
             esac
         ;;
+        headless)
+            DE100_BACKEND_LIBS="-lpthread -ldl"
+        ;;
+        drm)
+            # KMS through kernel ioctls; ALSA is dlopen'ed like on X11
+            DE100_BACKEND_LIBS="-lpthread -ldl"
+        ;;
+        wayland)
+            DE100_BACKEND_LIBS="-lwayland-client -lpthread -ldl"
+        ;;
         *)
             echo "Error: Unknown backend '$backend'" >&2
-            echo "Available: x11, raylib, auto" >&2
+            echo "Available: x11, raylib, headless, drm, wayland, auto" >&2
             return 1
         ;;
     esac
@@ -236,6 +359,134 @@ de100_get_lib_defines() {
     echo "$defines"
 }
 
+# Hot-reloadable game library with the loader's handshake (see
+# game/game-loader.h): "<output>.lock" exists while the compiler writes a
+# temp file, which is then renamed over <output>. A running game never
+# sees a half-written library, and reloads once per successful build.
+#
+# Usage:
+#   de100_build_game_lib "$BUILD_DIR/$(de100_shared_name main)" \
+#       $DE100_CFLAGS -I"$SCRIPT_DIR/src" "${MAIN_SOURCES[@]}"
+de100_build_game_lib() {
+    local output="$1"
+    shift
+    local lock="${output}.lock"
+    local staging="${output}.building"
+
+    : > "$lock"
+    if "$DE100_CC" -shared -fPIC "$@" -o "$staging"; then
+        mv -f "$staging" "$output"
+        rm -f "$lock"
+    else
+        rm -f "$staging" "$lock"
+        return 1
+    fi
+}
+
+# Shipping build: engine and game linked into one executable. Game code
+# is called directly (DE100_HOT_RELOAD=0, see game/game-loader.h) and LTO
+# inlines across the engine/game boundary; no shared libraries, temp
+# copies or reload polling. Call after de100_set_backend.
+#
+# Usage:
+#   de100_build_release "$BUILD_DIR/$(de100_exe_name game)" \
+#       -I"$SCRIPT_DIR/src" "${GAME_SOURCES[@]}"
+DE100_RELEASE_CFLAGS="-O2 -flto -DNDEBUG -DDE100_HOT_RELOAD=0 -DDE100_INTERNAL=0"
+DE100_RELEASE_LDFLAGS="-flto"
+
+de100_build_release() {
+    local output="$1"
+    shift
+    de100_link_release "$output" "" "$@"
+}
+
+# Release compile + link with extra compiler flags (PGO instrumentation...)
+de100_link_release() {
+    local output="$1"
+    local extra_cflags="$2"
+    shift 2
+
+    # shellcheck disable=SC2046,SC2086
+    "$DE100_CC" $DE100_RELEASE_CFLAGS $extra_cflags \
+        $(de100_get_platform_sources) "$@" \
+        -o "$output" $DE100_RELEASE_LDFLAGS $extra_cflags $DE100_BACKEND_LIBS -lm
+}
+
+de100_find_profdata() {
+    if command -v llvm-profdata &> /dev/null; then
+        command -v llvm-profdata
+    elif [[ "$DE100_OS" == "macos" ]] && xcrun --find llvm-profdata &> /dev/null; then
+        xcrun --find llvm-profdata
+    else
+        echo "Error: llvm-profdata not found (install llvm)" >&2
+        return 1
+    fi
+}
+
+# Profile-guided release build, trained on recorded gameplay:
+#
+#   1. Release build of the headless backend with -fprofile-instr-generate
+#   2. Play every .hmr archive in `replay_dir` through it
+#      (DE100_HEADLESS_REPLAY, one pass each; see platforms/headless)
+#   3. Merge the raw profiles with llvm-profdata
+#   4. Release build of the selected backend with -fprofile-instr-use
+#
+# Branchy, data-dependent loops get their layout from real sessions, so
+# keep the archives representative. Intermediate files go to
+# "$(dirname output)/pgo". Call after de100_set_backend.
+#
+# Usage:
+#   de100_build_pgo "$BUILD_DIR/$(de100_exe_name game)" "$SCRIPT_DIR/replays" \
+#       -I"$SCRIPT_DIR/src" "${GAME_SOURCES[@]}"
+de100_build_pgo() {
+    local output="$1"
+    local replay_dir="$2"
+    shift 2
+
+    local profdata_tool
+    profdata_tool="$(de100_find_profdata)" || return 1
+
+    local replays=("$replay_dir"/*.hmr)
+    if [[ ! -e "${replays[0]}" ]]; then
+        echo "Error: no .hmr replay archives in '$replay_dir'" >&2
+        return 1
+    fi
+
+    local pgo_dir
+    pgo_dir="$(dirname "$output")/pgo"
+    rm -rf "$pgo_dir"
+    mkdir -p "$pgo_dir/raw"
+
+    # 1. Instrumented headless trainer (the shipping backend stays selected)
+    local saved_backend="$DE100_BACKEND"
+    local saved_sources=("${DE100_SRC_BACKEND[@]}")
+    local saved_libs="$DE100_BACKEND_LIBS"
+    de100_set_backend headless "" 0 || return 1
+    local trainer="$pgo_dir/$(de100_exe_name trainer)"
+    echo "PGO: building instrumented trainer..."
+    de100_link_release "$trainer" "-fprofile-instr-generate" "$@" || return 1
+    DE100_BACKEND="$saved_backend"
+    DE100_SRC_BACKEND=("${saved_sources[@]}")
+    DE100_BACKEND_LIBS="$saved_libs"
+
+    # 2. Training runs
+    local replay
+    for replay in "${replays[@]}"; do
+        echo "PGO: training on $(basename "$replay")"
+        LLVM_PROFILE_FILE="$pgo_dir/raw/%p.profraw" \
+            DE100_HEADLESS_REPLAY="$replay" "$trainer" > /dev/null || return 1
+    done
+
+    # 3. Merge
+    "$profdata_tool" merge -o "$pgo_dir/game.profdata" "$pgo_dir"/raw/*.profraw || return 1
+
+    # 4. Optimized build; the shipping backend's own code has no profile
+    echo "PGO: building optimized $DE100_BACKEND binary..."
+    de100_link_release "$output" \
+        "-fprofile-instr-use=$pgo_dir/game.profdata -Wno-profile-instr-unprofiled -Wno-profile-instr-out-of-date" \
+        "$@"
+}
+
 de100_print_config() {
     echo ""
     echo "DE100 Build Configuration:"
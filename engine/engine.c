@@ -1,36 +1,253 @@
 #include "engine.h"
 #include "./platforms/_common/hooks/utils.h"
 
+#include "_common/cpu.h"
+#include "_common/log.h"
 #include "_common/memory.h"
 #include "_common/path.h"
 #include "_common/time.h"
 #include "game/base.h"
 #include "game/game-loader.h"
+#include "platforms/_common/adaptive-fps.h"
+#include "platforms/_common/asset-watcher.h"
+#include "platforms/_common/async-io.h"
+#include "platforms/_common/background-loader.h"
+#include "platforms/_common/capture.h"
+#include "platforms/_common/debug-overlay.h"
+#include "platforms/_common/fixed-timestep.h"
+#include "platforms/_common/flight-recorder.h"
+#include "platforms/_common/idle-scheduler.h"
+#include "platforms/_common/inputs-recording.h"
+#include "platforms/_common/perf-counters.h"
 #include "platforms/_common/replay-buffer.h"
+#include "platforms/_common/replay-timeline.h"
+#include "platforms/_common/spectate.h"
+#include "platforms/_common/telemetry.h"
+#include "platforms/_common/thread-placement.h"
+#include "platforms/_common/trace-export.h"
+#include "platforms/_common/work-queue.h"
+
+#include <pthread.h>
+#include <stdlib.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// STARTUP TIMING
+// ═══════════════════════════════════════════════════════════════════════════
+
+EngineStartupStamp engine_startup_now(void) {
+  EngineStartupStamp stamp = {.seconds = de100_get_wall_clock()};
+#if DE100_INTERNAL
+  stamp.cycles = de100_profiler_cycles();
+#endif
+  return stamp;
+}
+
+void engine_startup_record(EngineState *engine, const char *name,
+                           EngineStartupStamp start, EngineStartupStamp end,
+                           bool is_threaded) {
+  EngineStartupTimings *startup = &engine->platform.startup;
+  if (startup->phase_count >= ENGINE_MAX_STARTUP_PHASES) {
+    return;
+  }
+  startup->phases[startup->phase_count++] = (EngineStartupPhase){
+      .name = name, .start = start, .end = end, .is_threaded = is_threaded};
+}
+
+void engine_startup_report(EngineState *engine) {
+  EngineStartupTimings *startup = &engine->platform.startup;
+  EngineStartupStamp now = engine_startup_now();
+
+  printf("⏱️  Startup: %.1f ms\n",
+         (now.seconds - startup->begin.seconds) * 1000.0);
+  for (u32 i = 0; i < startup->phase_count; ++i) {
+    EngineStartupPhase *phase = &startup->phases[i];
+    printf("   %-20s %7.1f ms (at +%.1f)%s\n", phase->name,
+           (phase->end.seconds - phase->start.seconds) * 1000.0,
+           (phase->start.seconds - startup->begin.seconds) * 1000.0,
+           phase->is_threaded ? " [thread]" : "");
+  }
+
+#if DE100_INTERNAL
+  // Shows up in the first frame's profile; sites are keyed by name, so a
+  // fresh id slot per phase finds (or registers) the right block
+  for (u32 i = 0; i < startup->phase_count; ++i) {
+    EngineStartupPhase *phase = &startup->phases[i];
+    u32 block_id = 0;
+    de100_profiler_record_scope(&block_id, phase->name, __FILE__, __LINE__,
+                                phase->start.cycles, phase->end.cycles);
+  }
+#endif
+}
+
+// ─────────────────────────────────────────────────────────────────────
+// Game main library load, overlapped with the rest of engine_init
+// ─────────────────────────────────────────────────────────────────────
+//
+// Linking + dlopen(RTLD_NOW) of the main library is the slowest step of
+// startup and nothing before the end of engine_init needs it. Config
+// comes from the bootstrap library, which still loads on this thread.
+
+typedef struct {
+  GameMainCode *code;
+  GameCodePaths *paths;
+  EngineStartupStamp start;
+  EngineStartupStamp end;
+  pthread_t thread;
+  bool is_threaded;
+  bool is_joined;
+} EngineGameCodeLoad;
+
+de100_file_scoped_fn void *engine_game_code_load_proc(void *data) {
+  EngineGameCodeLoad *load = (EngineGameCodeLoad *)data;
+  load->start = engine_startup_now();
+  load_game_main_code(load->code, load->paths);
+  load->end = engine_startup_now();
+  return NULL;
+}
+
+de100_file_scoped_fn void engine_game_code_load_start(EngineGameCodeLoad *load,
+                                                      GameMainCode *code,
+                                                      GameCodePaths *paths) {
+  *load = (EngineGameCodeLoad){.code = code, .paths = paths};
+  load->is_threaded = pthread_create(&load->thread, NULL,
+                                     engine_game_code_load_proc, load) == 0;
+  if (!load->is_threaded) {
+    engine_game_code_load_proc(load); // Serially, then
+  }
+}
+
+/** Idempotent; call before any return once the load has started. */
+de100_file_scoped_fn void engine_game_code_load_join(EngineState *engine,
+                                                     EngineGameCodeLoad *load) {
+  if (load->is_joined) {
+    return;
+  }
+  if (load->is_threaded) {
+    pthread_join(load->thread, NULL);
+  }
+  load->is_joined = true;
+  game_code_publish(load->code); // For code readers (game-loader.h)
+  engine_startup_record(engine, "game main library", load->start, load->end,
+                        load->is_threaded);
+}
 
 // ═══════════════════════════════════════════════════════════════════════════
 // ENGINE INIT (Common across all platforms)
 // ═══════════════════════════════════════════════════════════════════════════
 
+// Hot reload barrier: loader and idle job callbacks live in the library
+// being unloaded
+de100_file_scoped_fn void engine_before_game_reload(void *user_data) {
+  EngineState *engine = (EngineState *)user_data;
+  if (engine->game.memory.background_loader) {
+    background_loader_cancel_all(engine->game.memory.background_loader);
+  }
+  idle_scheduler_cancel_all(engine->game.memory.idle_scheduler);
+}
+
+// New code may expect a different permanent-storage layout
+de100_file_scoped_fn void engine_after_game_reload(void *user_data) {
+  EngineState *engine = (EngineState *)user_data;
+  GameMemoryState *memory_state = &engine->platform.memory_state;
+
+  telemetry_counter(TELEMETRY_COUNTER_RELOADS,
+                    ++engine->platform.reload_count);
+  ++engine->game.memory.code_generation;
+
+  GameStateMigration migration =
+      migrate_game_state(&engine->platform.game_main_code,
+                         memory_state->state_version, &engine->game.memory);
+  memory_state->state_version =
+      game_main_code_state_version(&engine->platform.game_main_code);
+  if (migration == GAME_STATE_MIGRATION_UNCHANGED) {
+    return;
+  }
+
+  // Snapshots and keyframes taken so far hold the old layout
+  input_recording_end(memory_state);
+  input_recording_playback_end(memory_state);
+  replay_timeline_clear(&memory_state->timeline);
+  memory_state->timeline_slot_index = 0;
+  rewind_ring_reset(&engine->platform.rewind);
+}
+
+u64 engine_carve_frame_arenas(EngineGameState *game) {
+  // Off the front of transient storage, so with lazy commit they sit in
+  // the first committed pages
+  u64 frame_arena_size = game->config.frame_arena_size;
+  u64 page_size = de100_memory_page_size();
+  frame_arena_size = (frame_arena_size + page_size - 1) & ~(page_size - 1);
+  game->memory.frame_arena = NULL;
+  game->memory.previous_frame_arena = NULL;
+  if (frame_arena_size == 0 ||
+      2 * frame_arena_size >= game->memory.transient_storage_size) {
+    return 0;
+  }
+
+  u8 *frame_base = (u8 *)game->memory.transient_storage;
+  for (u32 i = 0; i < 2; ++i) {
+    de100_arena_init(&game->frame_arenas[i], frame_arena_size,
+                     frame_base + i * frame_arena_size);
+    game->frame_arenas[i].commit = game->memory.transient_commit;
+  }
+  game->memory.frame_arena = &game->frame_arenas[0];
+  game->memory.previous_frame_arena = &game->frame_arenas[1];
+  game->memory.transient_storage = frame_base + 2 * frame_arena_size;
+  game->memory.transient_storage_size -= 2 * frame_arena_size;
+  return frame_arena_size;
+}
+
 int engine_init(EngineState *engine) {
   EngineGameState *game = &engine->game;
   EnginePlatformState *platform = &engine->platform;
   EngineAllocations *allocations = &engine->allocations;
 
   g_initial_game_time_ms = de100_get_wall_clock();
+  EngineStartupStamp init_start = engine_startup_now();
 
   // ─────────────────────────────────────────────────────────────────────
   // ZERO INITIALIZE
   // ─────────────────────────────────────────────────────────────────────
 
   *engine = (EngineState){0};
+  platform->startup.begin = init_start;
   game->inputs = &platform->inputs[0];
   platform->old_inputs = &platform->inputs[1];
 
+  // Frame-thread logging goes through a ring to a writer thread
+  De100LogResult log_result = de100_log_init(getenv("DE100_LOG"));
+  if (!log_result.success) {
+    fprintf(stderr, "⚠️  Log writer not started (%s), logging synchronously\n",
+            de100_log_strerror(log_result.error_code));
+  }
+
+  // ─────────────────────────────────────────────────────────────────────
+  // CPU FEATURES / KERNELS
+  // ─────────────────────────────────────────────────────────────────────
+  //
+  // Picked once, before any worker can draw or mix. The game library
+  // binds the same table (DE100_KERNELS_BIND), also after reloads.
+
+  u32 cpu_features = de100_cpu_features();
+  de100_kernels_init(&game->kernels, cpu_features);
+  de100_kernels_bind(&game->kernels);
+  game->memory.kernels = &game->kernels;
+
+  de100_timestamp_init();
+
+  char cpu_description[64];
+  printf("✅ CPU: %s (pixels %s, mix %s, hash %s, clock %s %.3f MHz)\n",
+         de100_cpu_describe(cpu_features, cpu_description,
+                            sizeof(cpu_description)),
+         game->kernels.pixel.name, game->kernels.audio_mix.name,
+         game->kernels.hash64_name, de100_timestamp_source_name(),
+         g_de100_timestamp_clock.ticks_per_second / 1e6);
+
   // ─────────────────────────────────────────────────────────────────────
   // LOAD GAME CODE
   // ─────────────────────────────────────────────────────────────────────
 
+  EngineStartupStamp phase_start = engine_startup_now();
   De100PathResult exe_full_path = de100_path_get_executable();
   if (!exe_full_path.success) {
     fprintf(stderr, "❌ Failed to get executable directory: %s\n",
@@ -53,30 +270,50 @@ int engine_init(EngineState *engine) {
       .game_main_lib_tmp_path = DE100_GAME_MAIN_TMP_SHARED_LIB_PATH,
       .game_bootstrap_lib_path = DE100_GAME_BOOTSTRAP_SHARED_LIB_PATH,
       .game_bootstrap_lib_tmp_path = DE100_GAME_BOOTSTRAP_TMP_SHARED_LIB_PATH,
-      .exe_full_path = de100_path_get_executable(),
-      .exe_directory = de100_path_get_executable_directory(),
+      .exe_full_path = exe_full_path,
+      .exe_directory = exe_directory,
   };
+  engine_startup_phase(engine, "paths", phase_start, engine_startup_now());
+
+  // Joined at the end of init; every return after this joins first
+  EngineGameCodeLoad main_code_load;
+  engine_game_code_load_start(&main_code_load, &platform->game_main_code,
+                              &platform->paths);
 
+  phase_start = engine_startup_now();
   load_game_bootstrap_code(&platform->game_bootstrap_code, &platform->paths);
+  engine_startup_phase(engine, "game bootstrap library", phase_start,
+                       engine_startup_now());
 
-  load_game_main_code(&platform->game_main_code, &platform->paths);
-  if (!platform->game_main_code.is_valid) {
-    fprintf(stderr, "❌ Failed to load game code\n");
-    return 1;
+#if DE100_HOT_RELOAD
+  De100FileWatchResult watch_result;
+  platform->paths.game_main_lib_watch = de100_file_watch_start(
+      platform->paths.game_main_lib_path, &watch_result);
+  if (!watch_result.success) {
+    printf("⚠️  Hot reload watch unavailable (%s), polling instead\n",
+           de100_file_watch_strerror(watch_result.error_code));
   }
-
-  printf("✅ Game code loaded\n");
+#endif
 
   // ─────────────────────────────────────────────────────────────────────
   // GET GAME CONFIG
   // ─────────────────────────────────────────────────────────────────────
 
+  phase_start = engine_startup_now();
   game->config = get_default_game_config();
-  // #if DE100_HOT_RELOAD
-  platform->game_bootstrap_code.functions.startup(&game->config);
-  // #else
-  // game_startup(&game->config);
-  // #endif
+  DE100_GAME_CALL(&platform->game_bootstrap_code, startup)(&game->config);
+
+  // This machine's overrides of what the game asked for
+  ConfigFileResult config_result = config_file_open(
+      &platform->config_file, exe_directory.path, &game->config);
+  if (!config_result.success) {
+    fprintf(stderr, "⚠️  Config '%s' ignored (line %u): %s\n",
+            platform->config_file.path, config_result.line,
+            config_file_strerror(config_result.error_code));
+  } else if (platform->config_file.path[0]) {
+    printf("✅ Config: %s (%u fields overridden)\n",
+           platform->config_file.path, config_result.applied_count);
+  }
 
   u32 max_allowed_refresh_rate_hz =
       game->config.max_allowed_refresh_rate_hz != 0
@@ -93,45 +330,336 @@ int engine_init(EngineState *engine) {
 
   de100_set_target_fps(max_allowed_refresh_rate_hz);
   g_frame_counter = 0;
+  engine_startup_phase(engine, "game config", phase_start,
+                       engine_startup_now());
 
   // ─────────────────────────────────────────────────────────────────────
   // ALLOCATE GAME STATE MEMORY
   // ─────────────────────────────────────────────────────────────────────
 
+  phase_start = engine_startup_now();
 #if DE100_INTERNAL
   void *base_address = (void *)TERABYTES(2);
 #else
   void *base_address = NULL;
 #endif
 
+  De100MemoryFlags game_memory_flags = De100_MEMORY_FLAG_READ |
+                                       De100_MEMORY_FLAG_WRITE |
+                                       De100_MEMORY_FLAG_ZEROED;
+  bool wants_page_tracking = game->config.prefer_incremental_replay_snapshots ||
+                             game->config.prefer_async_replay_snapshots;
+#if DE100_ARENA_GUARD_PAGES
+  // Arena guards protect single 4 KB pages too
+  wants_page_tracking = true;
+  printf("⚠️  Arena guard pages on: replay snapshots will fault on them; "
+         "don't record loops\n");
+#endif
+  if (game->config.prefer_large_pages && wants_page_tracking) {
+    printf("ℹ️  Large pages disabled: replay tracking / arena guards use "
+           "4 KB pages\n");
+  } else if (game->config.prefer_large_pages) {
+    game_memory_flags |= De100_MEMORY_FLAG_LARGE_PAGES;
+  }
+  if (game->config.prefault_game_memory) {
+    game_memory_flags |= De100_MEMORY_FLAG_PREFAULT;
+  }
+  if (game->config.prefer_numa_local_memory) {
+    game_memory_flags |= De100_MEMORY_FLAG_NUMA_LOCAL;
+  }
+
+  // Transient storage starts on a page (large page when used) boundary,
+  // so both arenas begin cache-line aligned and share no page
+  u64 storage_alignment = de100_memory_page_size();
+  if ((game_memory_flags & De100_MEMORY_FLAG_LARGE_PAGES) &&
+      de100_memory_large_page_size() > storage_alignment) {
+    storage_alignment = de100_memory_large_page_size();
+  }
+  if (storage_alignment) {
+    game->config.permanent_storage_size =
+        (game->config.permanent_storage_size + storage_alignment - 1) &
+        ~(storage_alignment - 1);
+  }
+
   u64 total_size =
       game->config.permanent_storage_size + game->config.transient_storage_size;
 
-  allocations->game_state =
-      de100_memory_alloc(base_address, total_size,
-                         De100_MEMORY_FLAG_READ | De100_MEMORY_FLAG_WRITE |
-                             De100_MEMORY_FLAG_ZEROED);
+  // Lazy transient commit: [frontier page][permanent][transient: reserved].
+  // The frontier lives in the same mapping, so arenas point at it the way
+  // they point at their base (fixed across runs in internal builds).
+  bool lazy_transient = game->config.prefer_lazy_transient_commit &&
+                        !(game_memory_flags & De100_MEMORY_FLAG_LARGE_PAGES) &&
+                        game->config.transient_storage_size > 0;
+  u64 header_size = 0;
+  if (lazy_transient) {
+    header_size = de100_memory_page_size();
+    allocations->game_state = de100_memory_reserve(
+        base_address, header_size + game->config.permanent_storage_size,
+        header_size + total_size, game_memory_flags);
+  } else {
+    allocations->game_state =
+        de100_memory_alloc(base_address, total_size, game_memory_flags);
+  }
 
   if (!de100_memory_is_valid(allocations->game_state)) {
     fprintf(stderr, "❌ Failed to allocate game state\n");
+    engine_game_code_load_join(engine, &main_code_load);
     return 1;
   }
 
-  game->memory.permanent_storage = allocations->game_state.base;
+  u8 *game_memory = (u8 *)allocations->game_state.base + header_size;
+  game->memory.permanent_storage = game_memory;
   game->memory.transient_storage =
-      (u8 *)allocations->game_state.base + game->config.permanent_storage_size;
+      game_memory + game->config.permanent_storage_size;
   game->memory.permanent_storage_size = game->config.permanent_storage_size;
   game->memory.transient_storage_size = game->config.transient_storage_size;
+  game->memory.transient_commit = NULL;
   game->memory.is_initialized = false;
+  if (lazy_transient) {
+    De100CommitFrontier *frontier =
+        (De100CommitFrontier *)allocations->game_state.base;
+    de100_commit_frontier_init(frontier, game->memory.transient_storage,
+                               game->config.transient_storage_size, 0,
+                               game_memory_flags);
+    game->memory.transient_commit = frontier;
+  }
+
+  u64 frame_arena_size = engine_carve_frame_arenas(game);
+  if (frame_arena_size > 0) {
+    printf("✅ Frame arenas: 2 x %lu KB\n",
+           (unsigned long)(frame_arena_size / 1024));
+  } else if (game->config.frame_arena_size > 0) {
+    fprintf(stderr, "⚠️  Transient storage too small for frame arenas\n");
+  }
 
   platform->memory_state.total_size = total_size;
-  platform->memory_state.game_memory = allocations->game_state.base;
-  printf("✅ Game state: %lu MB\n", total_size / (1024 * 1024));
+  platform->memory_state.game_memory = game_memory;
+  if (lazy_transient) {
+    printf("✅ Game state: %lu MB committed, %lu MB transient reserved\n",
+           game->config.permanent_storage_size / (1024 * 1024),
+           game->config.transient_storage_size / (1024 * 1024));
+  } else {
+    printf("✅ Game state: %lu MB\n", total_size / (1024 * 1024));
+  }
+  engine_startup_phase(engine, "game memory", phase_start,
+                       engine_startup_now());
+  phase_start = engine_startup_now();
+
+#if DE100_INTERNAL
+  // ─────────────────────────────────────────────────────────────────────
+  // SCOPED PROFILER
+  // ─────────────────────────────────────────────────────────────────────
+  //
+  // Before the work queue, so workers find it on their first timed block.
+  // Outside game memory: the block registry must survive library reloads
+  // and replay snapshot restores.
+
+  allocations->profiler = de100_memory_alloc(NULL, sizeof(De100Profiler),
+                                             De100_MEMORY_FLAG_RW_ZEROED);
+
+  if (de100_memory_is_valid(allocations->profiler)) {
+    De100Profiler *profiler = (De100Profiler *)allocations->profiler.base;
+    de100_profiler_init(profiler);
+    game->memory.profiler = profiler;
+    printf("✅ Profiler: %lu KB\n",
+           (unsigned long)(sizeof(De100Profiler) / 1024));
+
+    const char *trace_destination = getenv("DE100_TRACE");
+    if (trace_destination && trace_destination[0]) {
+      TraceExportResult trace_result =
+          trace_export_begin(profiler, trace_destination);
+      if (!trace_result.success) {
+        fprintf(stderr, "⚠️  Trace export to '%s' not started: %s\n",
+                trace_destination,
+                trace_export_strerror(trace_result.error_code));
+      }
+    }
+
+    const char *perf_spec = getenv("DE100_PERF_COUNTERS");
+    if (perf_spec && perf_spec[0]) {
+      PerfCountersResult perf_result = perf_counters_begin(profiler, perf_spec);
+      if (!perf_result.success) {
+        fprintf(stderr, "⚠️  Hardware counters not started: %s\n",
+                perf_counters_strerror(perf_result.error_code));
+      }
+    }
+
+    // Always on; DE100_FLIGHT_RECORDER picks the directory (or "off")
+    FlightRecorderResult flight_result =
+        flight_recorder_begin(profiler, getenv("DE100_FLIGHT_RECORDER"));
+    if (!flight_result.success &&
+        flight_result.error_code != FLIGHT_RECORDER_ERROR_DISABLED) {
+      fprintf(stderr, "⚠️  Flight recorder not started: %s\n",
+              flight_recorder_strerror(flight_result.error_code));
+    }
+  } else {
+    fprintf(stderr, "⚠️  Failed to allocate profiler, timed blocks off\n");
+  }
+#endif
+
+  // Remote frame stats, in every build (see telemetry.h)
+  const char *telemetry_destination = getenv("DE100_TELEMETRY");
+  if (telemetry_destination && telemetry_destination[0]) {
+    TelemetryResult telemetry_result = telemetry_begin(telemetry_destination);
+    if (!telemetry_result.success) {
+      fprintf(stderr, "⚠️  Telemetry to '%s' not started: %s\n",
+              telemetry_destination,
+              telemetry_strerror(telemetry_result.error_code));
+    }
+  }
+
+  // Screenshots (F12) and video, in every build (see capture.h)
+  const char *capture_spec = getenv("DE100_CAPTURE");
+  CaptureResult capture_result = capture_begin(capture_spec);
+  if (!capture_result.success) {
+    fprintf(stderr, "⚠️  Capture '%s' not started: %s\n", capture_spec,
+            capture_strerror(capture_result.error_code));
+  }
+
+  // Live frames for spectator screens, in every build (see spectate.h)
+  const char *spectate_spec = getenv("DE100_SPECTATE");
+  if (spectate_spec && spectate_spec[0]) {
+    SpectateResult spectate_result = spectate_begin(spectate_spec);
+    if (!spectate_result.success) {
+      fprintf(stderr, "⚠️  Spectating on '%s' not started: %s\n",
+              spectate_spec, spectate_strerror(spectate_result.error_code));
+    }
+  }
+
+  // ─────────────────────────────────────────────────────────────────────
+  // START WORK QUEUE
+  // ─────────────────────────────────────────────────────────────────────
+  //
+  // Platform-owned worker pool, exposed to the game via GameMemory.
+  // Stays outside game memory so replay snapshots never capture mutexes.
+
+  allocations->work_queue = de100_memory_alloc(NULL, sizeof(De100WorkQueue),
+                                               De100_MEMORY_FLAG_RW_ZEROED);
+
+  if (!de100_memory_is_valid(allocations->work_queue)) {
+    fprintf(stderr, "❌ Failed to allocate work queue\n");
+    engine_game_code_load_join(engine, &main_code_load);
+    return 1;
+  }
+
+  De100WorkQueue *work_queue = (De100WorkQueue *)allocations->work_queue.base;
+
+  // Workers off the main thread's core (and its SMT siblings); the
+  // backends read the same config for their audio thread
+  de100_thread_placement_defaults(&platform->config.threads);
+  De100CpuTopology topology;
+  de100_cpu_topology_query(&topology);
+  platform->config.cpu_core_count = topology.core_count;
+
+  De100ThreadPlan thread_plan;
+  de100_thread_plan_make(&thread_plan, &topology, &platform->config.threads);
+  if (thread_plan.main_cpu >= 0 &&
+      !de100_thread_pin_self((u32)thread_plan.main_cpu)) {
+    thread_plan.main_cpu = -1;
+  }
+  work_queue_set_worker_cpus(work_queue, thread_plan.worker_cpus,
+                             thread_plan.worker_cpu_count);
+
+  WorkQueueInitResult work_queue_result =
+      work_queue_init(work_queue, game->config.worker_thread_count);
+
+  if (!work_queue_result.success) {
+    fprintf(stderr, "❌ Failed to start work queue: %s\n",
+            work_queue_strerror(work_queue_result.error_code));
+    engine_game_code_load_join(engine, &main_code_load);
+    return 1;
+  }
+
+  if (work_queue_result.error_code != WORK_QUEUE_SUCCESS) {
+    fprintf(stderr, "⚠️  Work queue started with fewer workers: %s\n",
+            work_queue_strerror(work_queue_result.error_code));
+  }
+
+  game->memory.work_queue = work_queue;
+  game->memory.add_work_entry = work_queue_add_entry;
+  game->memory.complete_all_work = work_queue_complete_all_work;
+  // Snapshot-sized copies (replay state) split across the workers too
+  de100_mem_set_parallel_for(work_queue_parallel_for, work_queue,
+                             work_queue_result.worker_count + 1);
+  game->thread_context = *work_queue_main_thread_context(work_queue);
+
+  printf("✅ Work queue: %u worker threads (%u cores, %s%s)\n",
+         work_queue_result.worker_count, topology.core_count,
+         thread_plan.worker_cpu_count > 0 ? "pinned" : "unpinned",
+         thread_plan.main_cpu >= 0 ? ", main pinned" : "");
+
+  // ─────────────────────────────────────────────────────────────────────
+  // START ASYNC I/O
+  // ─────────────────────────────────────────────────────────────────────
+  //
+  // Optional: without it the game's async_io stays NULL and loads/saves
+  // have to be synchronous.
+
+  allocations->async_io = de100_memory_alloc(NULL, sizeof(De100AsyncIO),
+                                             De100_MEMORY_FLAG_RW_ZEROED);
+  if (de100_memory_is_valid(allocations->async_io)) {
+    De100AsyncIO *async_io = (De100AsyncIO *)allocations->async_io.base;
+    AsyncIOInitResult async_io_result = async_io_init(async_io);
+    if (async_io_result.success) {
+      game->memory.async_io = async_io;
+      game->memory.async_io_submit = async_io_submit;
+      game->memory.async_io_wait = async_io_wait;
+      printf("✅ Async I/O: %s\n",
+             async_io_backend_name(async_io_result.backend));
+    } else {
+      fprintf(stderr, "⚠️  Async I/O unavailable: %s\n",
+              async_io_strerror(async_io_result.error_code));
+      de100_memory_free(&allocations->async_io);
+    }
+  }
+
+  // ─────────────────────────────────────────────────────────────────────
+  // START BACKGROUND LOADER
+  // ─────────────────────────────────────────────────────────────────────
+  //
+  // Optional, like async I/O; games then decode on the main thread.
+
+  allocations->background_loader = de100_memory_alloc(
+      NULL, sizeof(De100BackgroundLoader), De100_MEMORY_FLAG_RW_ZEROED);
+  if (de100_memory_is_valid(allocations->background_loader)) {
+    De100BackgroundLoader *loader =
+        (De100BackgroundLoader *)allocations->background_loader.base;
+    BackgroundLoaderInitResult loader_result =
+        background_loader_init(loader, 0);
+    if (loader_result.success) {
+      game->memory.background_loader = loader;
+      game->memory.background_load_submit = background_loader_submit;
+      printf("✅ Background loader: %u threads\n", loader_result.worker_count);
+    } else {
+      fprintf(stderr, "⚠️  Background loader unavailable: %s\n",
+              background_loader_strerror(loader_result.error_code));
+      de100_memory_free(&allocations->background_loader);
+    }
+  }
+
+  // Idle jobs need no thread: they run in the frame loop's slack
+  game->memory.idle_scheduler = &g_idle_scheduler;
+  game->memory.idle_job_submit = idle_scheduler_submit;
+  de100_platform_command_queue_init(&platform->commands);
+  game->memory.platform_commands = &platform->commands;
+#if DE100_INTERNAL
+  // Watches start lazily, on the first reload slot per file
+  game->memory.asset_watcher = &g_asset_watcher;
+  game->memory.asset_watch = asset_watcher_watch;
+  game->memory.asset_watch_version = asset_watcher_version;
+#endif
+  platform->paths.before_reload = engine_before_game_reload;
+  platform->paths.before_reload_user_data = engine;
+
+  engine_startup_phase(engine, "engine services", phase_start,
+                       engine_startup_now());
 
   // ─────────────────────────────────────────────────────────────────────
   // INITIALIZE REPLAY BUFFERS
   // ─────────────────────────────────────────────────────────────────────
 
+  phase_start = engine_startup_now();
+
   ReplayBufferInitResult replay_result = replay_buffers_init(
       platform->paths.exe_directory.path, platform->memory_state.game_memory,
       platform->memory_state.total_size, platform->memory_state.replay_buffers);
@@ -146,25 +674,86 @@ int engine_init(EngineState *engine) {
            replay_result.buffers_initialized, MAX_REPLAY_BUFFERS);
   }
 
+  u64 snapshot_size = game->config.transient_storage_is_disposable
+                          ? game->config.permanent_storage_size
+                          : platform->memory_state.total_size;
+  ReplaySnapshotMode snapshot_mode = REPLAY_SNAPSHOT_MODE_FULL;
+  if (game->config.prefer_async_replay_snapshots) {
+    snapshot_mode = REPLAY_SNAPSHOT_MODE_ASYNC;
+  } else if (game->config.prefer_incremental_replay_snapshots) {
+    snapshot_mode = REPLAY_SNAPSHOT_MODE_INCREMENTAL;
+  }
+
+  ReplayBufferResult tracker_result = replay_snapshot_tracker_init(
+      &platform->memory_state.snapshot_tracker,
+      platform->memory_state.game_memory, snapshot_size, snapshot_mode);
+  if (!game->config.transient_storage_is_disposable) {
+    replay_snapshot_tracker_set_frontier(
+        &platform->memory_state.snapshot_tracker,
+        game->memory.transient_commit);
+  }
+
+  if (!tracker_result.success) {
+    fprintf(stderr, "⚠️  Snapshot tracking degraded: %s\n",
+            replay_buffer_strerror(tracker_result.error_code));
+    // Keeps working as full-copy snapshots
+  }
+
+  input_recording_init_paths(&platform->memory_state, &platform->path_table,
+                             platform->paths.exe_directory.path);
+
+  // Keyframes cover the same range as snapshots
+  u32 keyframe_interval_frames = 0;
+  if (game->config.replay_keyframe_interval_seconds > 0.0f &&
+      game->config.target_seconds_per_frame > 0.0f) {
+    keyframe_interval_frames =
+        (u32)(game->config.replay_keyframe_interval_seconds /
+              game->config.target_seconds_per_frame);
+  }
+  replay_timeline_init(&platform->memory_state.timeline,
+                       platform->memory_state.game_memory, snapshot_size,
+                       keyframe_interval_frames);
+  if (!game->config.transient_storage_is_disposable) {
+    replay_timeline_set_frontier(&platform->memory_state.timeline,
+                                 game->memory.transient_commit);
+  }
+
+  // Permanent storage only: transient data may legitimately differ
+  replay_state_hash_init(&platform->memory_state.state_hash,
+                         game->memory.permanent_storage,
+                         game->memory.permanent_storage_size,
+                         game->config.replay_state_hash_interval_frames);
+  engine_startup_phase(engine, "replay buffers", phase_start,
+                       engine_startup_now());
+
   // ─────────────────────────────────────────────────────────────────────
   // ALLOCATE BACKBUFFER
   // ─────────────────────────────────────────────────────────────────────
 
+  phase_start = engine_startup_now();
   int backbuffer_size =
       game->config.window_width * game->config.window_height * 4;
 
+  // Reserved up to 4K so a window resize re-commits pages in place
+  // instead of moving (and copying) the buffer
+  size_t backbuffer_capacity = 3840 * 2160 * 4;
   game->backbuffer.memory =
-      de100_memory_alloc(NULL, backbuffer_size, De100_MEMORY_FLAG_RW_ZEROED);
+      de100_memory_reserve(NULL, backbuffer_size, backbuffer_capacity,
+                           De100_MEMORY_FLAG_RW_ZEROED);
 
   if (!de100_memory_is_valid(game->backbuffer.memory)) {
     fprintf(stderr, "❌ Failed to allocate backbuffer\n");
+    engine_game_code_load_join(engine, &main_code_load);
     return 1;
   }
 
   game->backbuffer.width = game->config.window_width;
   game->backbuffer.height = game->config.window_height;
   game->backbuffer.bytes_per_pixel = 4;
+  game->backbuffer.pixel_format = DE100_PIXEL_FORMAT;
   game->backbuffer.pitch = game->config.window_width * 4;
+  game->backbuffer.dirty.is_tracking = game->config.prefer_dirty_rect_present;
+  de100_backbuffer_mark_all_dirty(&game->backbuffer); // first frame
   printf("✅ Backbuffer: %dx%d\n", game->backbuffer.width,
          game->backbuffer.height);
 
@@ -193,6 +782,7 @@ int engine_init(EngineState *engine) {
 
   if (!de100_memory_is_valid(allocations->audio_samples)) {
     fprintf(stderr, "❌ Failed to allocate audio buffer\n");
+    engine_game_code_load_join(engine, &main_code_load);
     return 1;
   }
 
@@ -202,16 +792,93 @@ int engine_init(EngineState *engine) {
   game->audio.is_initialized = false; // backend sets true after its init
 
   printf("✅ Audio buffer: %d samples max\n", max_sample_count);
+  engine_startup_phase(engine, "backbuffer + audio", phase_start,
+                       engine_startup_now());
+
+  // ─────────────────────────────────────────────────────────────────────
+  // GAME CODE READY
+  // ─────────────────────────────────────────────────────────────────────
+
+  engine_game_code_load_join(engine, &main_code_load);
+  if (!platform->game_main_code.is_valid) {
+    fprintf(stderr, "❌ Failed to load game code\n");
+    return 1;
+  }
+
+  printf("✅ Game code loaded\n");
+
+  platform->memory_state.state_version =
+      game_main_code_state_version(&platform->game_main_code);
+  platform->paths.after_reload = engine_after_game_reload;
+  platform->paths.after_reload_user_data = engine;
+
+  // Code modules: after the main library, before game_init can use them.
+  // Ones that failed are retried by the reload check when rebuilt.
+  phase_start = engine_startup_now();
+  if (game_modules_init(&platform->modules, game->config.modules,
+                        &game->memory) > 0) {
+    engine_startup_phase(engine, "code modules", phase_start,
+                         engine_startup_now());
+  }
+  platform->paths.modules = &platform->modules;
 
   // ─────────────────────────────────────────────────────────────────────
   // RECORDING STATE
   // ─────────────────────────────────────────────────────────────────────
 
   platform->memory_state.recording_fd = -1;
-  platform->memory_state.playback_fd = -1;
+  platform->memory_state.async_io = game->memory.async_io;
   platform->memory_state.input_recording_index = 0;
   platform->memory_state.input_playing_index = 0;
 
+  // ─────────────────────────────────────────────────────────────────────
+  // NETPLAY (after the game code: the frame length depends on it)
+  // ─────────────────────────────────────────────────────────────────────
+
+  const char *netplay_spec = getenv("DE100_NETPLAY");
+  if (netplay_spec && netplay_spec[0]) {
+    NetplayConfig netplay_config = {0};
+    f32 seconds_per_frame = game->config.target_seconds_per_frame;
+    if (fixed_timestep_is_active(&game->config, &platform->game_main_code)) {
+      seconds_per_frame = 1.0f / (f32)game->config.fixed_update_hz;
+    }
+    netplay_config_defaults(&netplay_config, seconds_per_frame);
+    if (!netplay_config_parse(netplay_spec, &netplay_config)) {
+      fprintf(stderr,
+              "⚠️  DE100_NETPLAY: expected \"player,local_port,host:port"
+              "[,delay]\", got \"%s\"\n",
+              netplay_spec);
+    } else {
+      NetplayResult netplay_result =
+          netplay_begin(&platform->netplay, &netplay_config,
+                        &platform->memory_state.snapshot_tracker);
+      if (!netplay_result.success) {
+        fprintf(stderr, "⚠️  Netplay disabled: %s\n",
+                netplay_strerror(netplay_result.error_code));
+      }
+    }
+  }
+
+  // ─────────────────────────────────────────────────────────────────────
+  // REWIND (one frame of history per rendered frame)
+  // ─────────────────────────────────────────────────────────────────────
+
+  if (game->config.rewind_seconds > 0.0f) {
+    RewindRingResult rewind_result = rewind_ring_init(
+        &platform->rewind, &platform->memory_state.snapshot_tracker,
+        game->config.rewind_seconds, game->config.target_seconds_per_frame,
+        (u64)game->config.rewind_log_megabytes * MEGABYTES(1));
+    if (!rewind_result.success) {
+      fprintf(stderr, "⚠️  Rewind disabled: %s\n",
+              rewind_ring_strerror(rewind_result.error_code));
+    }
+  }
+
+  engine_memory_stats_collect(engine);
+#if DE100_INTERNAL
+  g_debug_overlay_memory = &platform->memory_stats;
+#endif
+
   printf("✅ Engine initialized\n");
   return 0;
 }
@@ -229,9 +896,55 @@ void engine_shutdown(EngineState *engine) {
 
   printf("[SHUTDOWN] Engine cleanup...\n");
 
+#if DE100_INTERNAL
+  flight_recorder_end();
+  trace_export_end();
+  g_debug_overlay_memory = NULL;
+#endif
+  telemetry_end();
+  capture_end();
+  spectate_end();
+  config_file_close(&platform->config_file);
+
+  // Before the tracker: their snapshots are synced through it
+  netplay_end(&platform->netplay);
+  rewind_ring_shutdown(&platform->rewind);
+
+  // Flushes a recording still in progress (before async I/O stops)
+  input_recording_end(&platform->memory_state);
+  input_recording_playback_end(&platform->memory_state);
+
+  replay_timeline_shutdown(&platform->memory_state.timeline);
+  replay_state_hash_shutdown(&platform->memory_state.state_hash);
+  replay_snapshot_tracker_shutdown(&platform->memory_state.snapshot_tracker);
   replay_buffers_shutdown(platform->memory_state.replay_buffers,
                           platform->memory_state.total_size);
 
+  if (de100_memory_is_valid(engine->allocations.work_queue)) {
+    de100_mem_set_parallel_for(NULL, NULL, 0);
+    work_queue_shutdown((De100WorkQueue *)engine->allocations.work_queue.base);
+  }
+  if (de100_memory_is_valid(engine->allocations.background_loader)) {
+    background_loader_shutdown(
+        (De100BackgroundLoader *)engine->allocations.background_loader.base);
+  }
+
+  // Lets a save submitted on the last frame reach the disk
+  if (de100_memory_is_valid(engine->allocations.async_io)) {
+    async_io_shutdown((De100AsyncIO *)engine->allocations.async_io.base);
+  }
+
+#if DE100_INTERNAL
+  // Every thread that samples counters has stopped by now
+  perf_counters_end();
+  asset_watcher_shutdown(&g_asset_watcher);
+#endif
+
+  de100_file_watch_stop(platform->paths.game_main_lib_watch);
+  platform->paths.game_main_lib_watch = NULL;
+  game_modules_shutdown(&platform->modules);
+  platform->paths.modules = NULL;
+
 #if DE100_SANITIZE_WAVE_1_MEMORY
   // Clean up temp files
   de100_file_delete(platform->paths.game_main_lib_tmp_path);
@@ -239,6 +952,21 @@ void engine_shutdown(EngineState *engine) {
   de100_file_delete(platform->paths.game_init_lib_tmp_path);
 
   // Free allocations
+#if DE100_INTERNAL
+  if (de100_memory_is_valid(allocations->profiler)) {
+    g_de100_profiler = NULL;
+    de100_memory_free(&allocations->profiler);
+  }
+#endif
+  if (de100_memory_is_valid(allocations->work_queue)) {
+    de100_memory_free(&allocations->work_queue);
+  }
+  if (de100_memory_is_valid(allocations->async_io)) {
+    de100_memory_free(&allocations->async_io);
+  }
+  if (de100_memory_is_valid(allocations->background_loader)) {
+    de100_memory_free(&allocations->background_loader);
+  }
   if (de100_memory_is_valid(allocations->audio_samples)) {
     de100_memory_free(&allocations->audio_samples);
   }
@@ -254,4 +982,398 @@ void engine_shutdown(EngineState *engine) {
 #endif
 
   printf("[SHUTDOWN] Engine cleanup complete\n");
+
+  de100_log_shutdown();
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// REPLAY SEEK
+// ═══════════════════════════════════════════════════════════════════════════
+
+bool engine_replay_seek(EngineState *engine, u64 frame_index) {
+  GameMemoryState *memory_state = &engine->platform.memory_state;
+  EngineGameState *game = &engine->game;
+
+  if (!input_recording_is_playing(memory_state)) {
+    fprintf(stderr, "[REPLAY SEEK] ERROR: Not playing back\n");
+    return false;
+  }
+
+  // Seeking past the end would trigger the loop-back mid fast-forward
+  if (memory_state->playback_frame_count > 0 &&
+      frame_index >= memory_state->playback_frame_count) {
+    frame_index = memory_state->playback_frame_count - 1;
+  }
+
+  u64 frame = 0;
+  if (!input_recording_playback_rewind_to(memory_state, frame_index, &frame)) {
+    return false;
+  }
+
+  u64 simulated_frames = frame_index - frame;
+  f64 start = de100_get_wall_clock();
+
+  // ─────────────────────────────────────────────────────────────────────
+  // Fast-forward: simulate without rendering or audio. Audio state the
+  // game keeps in memory (oscillator phase, ...) therefore drifts from a
+  // live run; everything driven by update_and_render is exact.
+  // ─────────────────────────────────────────────────────────────────────
+  game->backbuffer.is_rendering_disabled = true;
+  while (memory_state->playback_frame_index < frame_index &&
+         input_recording_is_playing(memory_state)) {
+    input_recording_playback_frame(memory_state, game->inputs);
+    DE100_GAME_CALL(&engine->platform.game_main_code, update_and_render)(
+        &game->thread_context, &game->memory, game->inputs, &game->backbuffer);
+  }
+  game->backbuffer.is_rendering_disabled = false;
+  de100_backbuffer_mark_all_dirty(&game->backbuffer);
+
+  printf("[REPLAY SEEK] ⏩ Frame %lu (from %lu, %lu frames in %.1f ms)\n",
+         (unsigned long)frame_index, (unsigned long)frame,
+         (unsigned long)simulated_frames,
+         de100_get_seconds_elapsed(start, de100_get_wall_clock()) * 1000.0);
+
+  return input_recording_is_playing(memory_state);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// NETPLAY
+// ═══════════════════════════════════════════════════════════════════════════
+
+/** One netplay frame: one fixed tick plus a render, or update_and_render. */
+de100_file_scoped_fn void engine_netplay_simulate(void *user_data,
+                                                  GameInput *input,
+                                                  bool is_resimulating) {
+  EngineState *engine = (EngineState *)user_data;
+  EngineGameState *game = &engine->game;
+  GameMainCode *code = &engine->platform.game_main_code;
+
+  bool was_rendering_disabled = game->backbuffer.is_rendering_disabled;
+  game->memory.netplay.is_resimulating = is_resimulating;
+  game->backbuffer.is_rendering_disabled =
+      was_rendering_disabled || is_resimulating;
+  if (fixed_timestep_is_active(&game->config, code)) {
+    DE100_GAME_CALL(code, update)(&game->thread_context, &game->memory, input,
+                                  1.0f / (f32)game->config.fixed_update_hz);
+    if (!is_resimulating) {
+      DE100_GAME_CALL(code, render)(&game->thread_context, &game->memory,
+                                    &game->backbuffer, 0.0f);
+    }
+  } else {
+    DE100_GAME_CALL(code, update_and_render)(&game->thread_context,
+                                             &game->memory, input,
+                                             &game->backbuffer);
+  }
+  game->backbuffer.is_rendering_disabled = was_rendering_disabled;
+  game->memory.netplay.is_resimulating = false;
+
+  if (is_resimulating) {
+    // The live frame's rotation is engine_swap_inputs'
+    engine_rotate_frame_arenas(&game->memory);
+  }
+}
+
+/** Both peers start from the same state: a fresh game_init. */
+de100_file_scoped_fn void engine_netplay_start(void *user_data) {
+  EngineState *engine = (EngineState *)user_data;
+  GameMemory *memory = &engine->game.memory;
+  memset(memory->permanent_storage, 0, memory->permanent_storage_size);
+  memory->is_initialized = false;
+  memory->netplay = (De100NetplayInfo){
+      .player_count = NETPLAY_MAX_PLAYERS,
+      .local_player = engine->platform.netplay.config.local_player,
+  };
+}
+
+bool engine_netplay_frame(EngineState *engine) {
+  NetplaySession *session = &engine->platform.netplay;
+  if (!netplay_is_active(session)) {
+    return false;
+  }
+
+  NetplayAdvanceResult result =
+      netplay_advance(session, engine->game.inputs, engine_netplay_simulate,
+                      engine_netplay_start, engine);
+  if (result == NETPLAY_ADVANCE_FAILED) {
+    // The game keeps running locally from wherever it got to
+    fprintf(stderr, "⚠️  Netplay ended: %s\n",
+            netplay_strerror(session->error_code));
+    netplay_end(session);
+    engine->game.memory.netplay = (De100NetplayInfo){0};
+    return false;
+  }
+  if (result == NETPLAY_ADVANCE_SIMULATED && session->last_rollback_frames) {
+    DE100_LOG_DEBUG(DE100_LOG_NET, "Rolled back %u frames",
+                    session->last_rollback_frames);
+  }
+  return true;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// REWIND
+// ═══════════════════════════════════════════════════════════════════════════
+
+bool engine_rewind_frame(EngineState *engine) {
+  RewindRing *rewind = &engine->platform.rewind;
+  GameMemoryState *memory_state = &engine->platform.memory_state;
+  EngineGameState *game = &engine->game;
+  GameMainCode *code = &engine->platform.game_main_code;
+  if (!rewind->is_enabled) {
+    return false;
+  }
+
+  // They move game memory on their own; history restarts after them
+  if (input_recording_is_recording(memory_state) ||
+      input_recording_is_playing(memory_state) ||
+      netplay_is_active(&engine->platform.netplay)) {
+    rewind_ring_reset(rewind);
+    return false;
+  }
+
+  if (!rewind->is_held) {
+    RewindRingResult result = rewind_ring_capture(rewind, game->inputs);
+    if (!result.success) {
+      DE100_LOG_WARN(DE100_LOG_REPLAY, "Rewind history dropped: %s",
+                     rewind_ring_strerror(result.error_code));
+    }
+    return false;
+  }
+
+  if (fixed_timestep_is_active(&game->config, code)) {
+    // State before the previous frame; render shows it as is
+    if (rewind_ring_step_back(rewind, 1).success) {
+      DE100_GAME_CALL(code, render)(&game->thread_context, &game->memory,
+                                    &game->backbuffer, 0.0f);
+    }
+    return true;
+  }
+
+  // update_and_render can't draw without simulating: go back two frames
+  // and run the older one again with its input, which lands one back
+  if (!rewind_ring_step_back(rewind, 2).success) {
+    return true; // Hold on the oldest frame
+  }
+  GameInput input = *rewind_ring_input(rewind, rewind->frame);
+  if (rewind_ring_capture(rewind, &input).success) {
+    DE100_GAME_CALL(code, update_and_render)(&game->thread_context,
+                                             &game->memory, &input,
+                                             &game->backbuffer);
+  }
+  return true;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// CONFIG FILE
+// ═══════════════════════════════════════════════════════════════════════════
+
+// Re-derive the frame rate after the config's rate fields changed
+de100_file_scoped_fn void engine_apply_frame_rate(GameConfig *config) {
+  if (config->max_allowed_refresh_rate_hz > 0 &&
+      config->target_refresh_rate_hz > config->max_allowed_refresh_rate_hz) {
+    config->target_refresh_rate_hz = config->max_allowed_refresh_rate_hz;
+  }
+  if (config->prefer_adaptive_fps) {
+    // New ladder for the same monitor, from the new target down
+    adaptive_fps_init(config, (u32)(g_adaptive_fps.monitor_hz + 0.5f));
+  } else if (config->target_refresh_rate_hz > 0) {
+    config->target_seconds_per_frame =
+        1.0f / (f32)config->target_refresh_rate_hz;
+    de100_set_target_fps(config->target_refresh_rate_hz);
+  }
+}
+
+void engine_config_file_reload(EngineState *engine) {
+  GameConfig *config = &engine->game.config;
+  GameConfig before = *config;
+  ConfigFileResult result =
+      config_file_reload(&engine->platform.config_file, config);
+  if (!result.success) {
+    DE100_LOG_WARN(DE100_LOG_ENGINE,
+                   "Config '%s' not reloaded (line %u): %s",
+                   engine->platform.config_file.path, result.line,
+                   config_file_strerror(result.error_code));
+    return;
+  }
+  DE100_LOG_INFO(DE100_LOG_ENGINE,
+                 "Config reloaded: %u fields applied, %u need a restart",
+                 result.applied_count, result.restart_count);
+
+  // The rest of the live fields are read every frame; the frame rate is
+  // derived state
+  if (config->target_refresh_rate_hz == before.target_refresh_rate_hz &&
+      config->max_allowed_refresh_rate_hz ==
+          before.max_allowed_refresh_rate_hz &&
+      config->prefer_adaptive_fps == before.prefer_adaptive_fps) {
+    return;
+  }
+  engine_apply_frame_rate(config);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// PLATFORM COMMANDS
+// ═══════════════════════════════════════════════════════════════════════════
+
+void engine_platform_commands_drain(EngineState *engine) {
+  GameConfig *config = &engine->game.config;
+  De100PlatformCommandQueue *queue = &engine->platform.commands;
+  De100PlatformCommand command;
+
+  // At most one ring's worth: pushes from running jobs wait a frame
+  for (u32 i = 0; i < DE100_PLATFORM_COMMAND_CAPACITY &&
+                  de100_platform_command_pop(queue, &command);
+       ++i) {
+    switch ((De100PlatformCommandKind)command.kind) {
+    case DE100_PLATFORM_COMMAND_SET_TARGET_FPS: {
+      if (command.arg.u == 0) {
+        break;
+      }
+      config->target_refresh_rate_hz = command.arg.u;
+      config->prefer_adaptive_fps = false;
+      engine_apply_frame_rate(config);
+      DE100_LOG_DEBUG(DE100_LOG_ENGINE, "Game set %u FPS",
+                      config->target_refresh_rate_hz);
+      break;
+    }
+    case DE100_PLATFORM_COMMAND_SET_ADAPTIVE_FPS: {
+      if (config->prefer_adaptive_fps != command.arg.b) {
+        config->prefer_adaptive_fps = command.arg.b;
+        engine_apply_frame_rate(config);
+      }
+      break;
+    }
+    case DE100_PLATFORM_COMMAND_SET_BACKGROUND_THROTTLE: {
+      config->prefer_background_throttle = command.arg.b;
+      break;
+    }
+    case DE100_PLATFORM_COMMAND_SET_SCANLINES: {
+      f32 intensity = command.arg.f;
+      config->present_scanline_intensity =
+          intensity > 0.0f ? (intensity < 1.0f ? intensity : 1.0f) : 0.0f;
+      break;
+    }
+    case DE100_PLATFORM_COMMAND_CAPTURE_SCREENSHOT: {
+      capture_request_screenshot();
+      break;
+    }
+    case DE100_PLATFORM_COMMAND_RELOAD_CONFIG: {
+      engine_config_file_reload(engine);
+      break;
+    }
+    default: {
+      break; // Rejected by push
+    }
+    }
+  }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// MEMORY TELEMETRY
+// ═══════════════════════════════════════════════════════════════════════════
+
+void engine_memory_stats_collect(EngineState *engine) {
+  EngineGameState *game = &engine->game;
+  EngineAllocations *allocations = &engine->allocations;
+  MemoryStats *stats = &engine->platform.memory_stats;
+
+  memory_stats_begin(stats);
+
+  // Game memory: with lazy transient commit the block's size is the
+  // header + permanent part, and the frontier says how much follows
+  u64 game_committed = 0;
+  if (game->memory.transient_commit) {
+    game_committed = allocations->game_state.size +
+                     de100_commit_frontier_committed(
+                         game->memory.transient_commit);
+  }
+  memory_stats_add_block(stats, "game memory", &allocations->game_state,
+                         game_committed);
+  memory_stats_add_block(stats, "backbuffer", &game->backbuffer.memory, 0);
+  memory_stats_add_block(stats, "audio samples", &allocations->audio_samples,
+                         0);
+  memory_stats_add_block(stats, "work queue", &allocations->work_queue, 0);
+  memory_stats_add_block(stats, "async io", &allocations->async_io, 0);
+  memory_stats_add_block(stats, "background loader",
+                         &allocations->background_loader, 0);
+  memory_stats_add_block(stats, "profiler", &allocations->profiler, 0);
+
+  // Per-thread scratch: one region, one arena per thread
+  De100WorkQueue *queue = game->memory.work_queue;
+  if (queue) {
+    u64 scratch_reserved = 0;
+    u64 scratch_committed = 0;
+    for (u32 i = 0; i < queue->thread_count; ++i) {
+      const De100MemoryBlock *block = &queue->threads[i].scratch_block;
+      if (block->is_valid) {
+        scratch_reserved += block->reserved_size;
+        scratch_committed += block->size;
+      }
+    }
+    if (scratch_committed > 0) {
+      memory_stats_add_region(stats, "thread scratch", scratch_reserved,
+                              scratch_committed);
+    }
+    for (u32 i = 0; i < queue->thread_count; ++i) {
+      char name[MEMORY_STATS_NAME_LENGTH];
+      snprintf(name, sizeof(name), "scratch %u", i);
+      memory_stats_add_arena(stats, name, &queue->threads[i].scratch_arena);
+    }
+  }
+
+  memory_stats_add_arena(stats, "frame", game->memory.frame_arena);
+  memory_stats_add_arena(stats, "previous frame",
+                         game->memory.previous_frame_arena);
+  for (u32 i = 0; i < DE100_DEBUG_MAX_ARENAS; ++i) {
+    char name[MEMORY_STATS_NAME_LENGTH];
+    snprintf(name, sizeof(name), "game %u", i);
+    memory_stats_add_arena(stats, name, game->memory.debug_arenas[i]);
+  }
+  memory_stats_add_pools(stats, &game->memory);
+  memory_stats_add_replay_buffers(stats,
+                                  engine->platform.memory_state.replay_buffers,
+                                  MAX_REPLAY_BUFFERS);
+  memory_stats_read_process(stats);
+  memory_stats_end(stats);
+
+  if (telemetry_is_active()) {
+    // Release builds track no peaks: current use is the next best thing
+    u64 arena_high_water = 0;
+    for (u32 i = 0; i < stats->arena_count; ++i) {
+      const MemoryStatsArena *arena = &stats->arenas[i];
+      u64 peak = arena->high_water > arena->used ? arena->high_water
+                                                 : arena->used;
+      arena_high_water = peak > arena_high_water ? peak : arena_high_water;
+    }
+    telemetry_counter(TELEMETRY_COUNTER_PEAK_RESIDENT_BYTES,
+                      stats->peak_resident_bytes);
+    telemetry_counter(TELEMETRY_COUNTER_COMMITTED_BYTES,
+                      stats->committed_bytes);
+    telemetry_counter(TELEMETRY_COUNTER_ARENA_HIGH_WATER_BYTES,
+                      arena_high_water);
+  }
+
+#if DE100_INTERNAL
+  if (trace_export_is_active()) {
+    f64 mb = 1.0 / (1024.0 * 1024.0);
+    trace_export_counter("memory committed MB",
+                         (f64)stats->committed_bytes * mb);
+    trace_export_counter("memory resident MB",
+                         (f64)stats->resident_bytes * mb);
+    trace_export_counter("replay snapshots MB",
+                         (f64)stats->replay_snapshot_bytes * mb);
+    trace_export_counter("major faults", (f64)stats->major_faults);
+    trace_export_counter("minor faults", (f64)stats->minor_faults);
+
+    u64 arena_used = 0;
+    for (u32 i = 0; i < stats->arena_count; ++i) {
+      arena_used += stats->arenas[i].used;
+    }
+    trace_export_counter("arenas used MB", (f64)arena_used * mb);
+
+    u64 pool_live = 0;
+    for (u32 i = 0; i < stats->pool_count; ++i) {
+      pool_live += stats->pools[i].live;
+    }
+    trace_export_counter("pool entries", (f64)pool_live);
+  }
+#endif
 }
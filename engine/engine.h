@@ -8,9 +8,15 @@
 #include "game/config.h"
 #include "game/game-loader.h"
 #include "game/inputs.h"
+#include "game/kernels.h"
+#include "game/memory-arena.h"
 #include "game/memory.h"
 #include "game/thread.h"
+#include "platforms/_common/config-file.h"
 #include "platforms/_common/config.h"
+#include "platforms/_common/memory-stats.h"
+#include "platforms/_common/netplay.h"
+#include "platforms/_common/rewind-ring.h"
 
 // ═══════════════════════════════════════════════════════════════════════════
 // ENGINE STATE
@@ -48,8 +54,42 @@ typedef struct {
 
   ThreadContext thread_context;
 
+  // CPU-specific kernels, exposed through memory.kernels
+  De100Kernels kernels;
+
+  // Headers of the per-frame arenas (memory.frame_arena); their bytes are
+  // in transient storage
+  De100MemoryArena frame_arenas[2];
+
 } EngineGameState;
 
+// ─────────────────────────────────────────────────────────────────────
+// STARTUP TIMING
+// ─────────────────────────────────────────────────────────────────────
+// Phases of engine_init and backend init. Phases run on helper threads
+// overlap others, so they don't add up to the total.
+// ─────────────────────────────────────────────────────────────────────
+
+#define ENGINE_MAX_STARTUP_PHASES 16
+
+typedef struct {
+  f64 seconds;
+  u64 cycles; // Profiler clock (DE100_INTERNAL), 0 otherwise
+} EngineStartupStamp;
+
+typedef struct {
+  const char *name; // String literal
+  EngineStartupStamp start;
+  EngineStartupStamp end;
+  bool is_threaded;
+} EngineStartupPhase;
+
+typedef struct {
+  EngineStartupStamp begin; // engine_init entry
+  EngineStartupPhase phases[ENGINE_MAX_STARTUP_PHASES];
+  u32 phase_count;
+} EngineStartupTimings;
+
 // ─────────────────────────────────────────────────────────────────────
 // PLATFORM CONTEXT
 // ─────────────────────────────────────────────────────────────────────
@@ -60,8 +100,10 @@ typedef struct {
   PlatformConfig config;
   GameMainCode game_main_code;
   GameBootstrapCode game_bootstrap_code;
+  GameModuleRegistry modules; // GameConfig.modules (see game-loader.h)
   GameCodePaths paths;
   GameMemoryState memory_state; // Recording/playback
+  De100PathTable path_table;   // Paths interned at init (replay slots)
 
   // Double-buffered inputs (platform manages swap)
   GameInput inputs[2];
@@ -69,13 +111,37 @@ typedef struct {
   // ← Platform uses for state preservation
   GameInput *old_inputs;
 
+  EngineStartupTimings startup;
+
+  // Memory telemetry, refreshed every ENGINE_MEMORY_STATS_INTERVAL frames
+  MemoryStats memory_stats;
+  u32 memory_stats_frame;
+
+  // Rollback session (DE100_NETPLAY="player,port,host:port[,delay]")
+  NetplaySession netplay;
+
+  // GameConfig.rewind_seconds of frame history (held REWIND_KEY_NAME)
+  RewindRing rewind;
+
+  u32 reload_count; // Game code hot reloads so far (telemetry)
+
+  // DE100_CONFIG / de100.cfg overrides of GameConfig, watched for edits
+  ConfigFile config_file;
+
+  // Game → platform requests (GameMemory.platform_commands)
+  De100PlatformCommandQueue commands;
+
   // Platform-specific extension (X11State*, Win32State*, etc.)
   void *backend;
 } EnginePlatformState;
 
 typedef struct {
-  De100MemoryBlock game_state;    // Permanent + Transient
-  De100MemoryBlock audio_samples; // Audio sample buffer
+  De100MemoryBlock game_state;        // Permanent + Transient
+  De100MemoryBlock audio_samples;     // Audio sample buffer
+  De100MemoryBlock work_queue;        // De100WorkQueue (deques + thread slots)
+  De100MemoryBlock async_io;          // De100AsyncIO (pending ring + backend)
+  De100MemoryBlock background_loader; // De100BackgroundLoader (own queue)
+  De100MemoryBlock profiler;          // De100Profiler (DE100_INTERNAL only)
 } EngineAllocations;
 
 typedef struct {
@@ -119,6 +185,16 @@ typedef struct {
  */
 int engine_init(EngineState *engine);
 
+/**
+ * Carve memory.frame_arena and memory.previous_frame_arena
+ * (GameConfig.frame_arena_size each, page-rounded) off the front of
+ * transient storage, which shrinks by both.
+ *
+ * @return the size of each arena, 0 if transient storage is too small
+ *         (or none was asked for): both pointers are then NULL
+ */
+u64 engine_carve_frame_arenas(EngineGameState *game);
+
 /**
  * Shutdown engine and free all resources.
  *
@@ -126,21 +202,144 @@ int engine_init(EngineState *engine);
  */
 void engine_shutdown(EngineState *engine);
 
+/**
+ * Jump replay playback to `frame_index` (clamped to the recording).
+ *
+ * Restores the nearest keyframe at or before the target (or the slot's
+ * start state) and re-simulates the frames in between with rendering
+ * disabled. The next regular playback frame is `frame_index`.
+ *
+ * @return false if not playing back or the seek failed
+ */
+bool engine_replay_seek(EngineState *engine, u64 frame_index);
+
+/**
+ * Run this frame through the netplay session, if there is one: exchange
+ * inputs with the peer, roll back and re-simulate when a prediction was
+ * wrong, then simulate one frame (one fixed tick, or one
+ * update_and_render) with both players' inputs. Nothing runs while
+ * connecting or stalled on the peer.
+ *
+ * @return false if no session is running: the backend runs its regular
+ *         update instead
+ */
+bool engine_netplay_frame(EngineState *engine);
+
+/**
+ * Rewind's frame boundary, before the update. While the rewind key is
+ * held, steps game memory back one frame and renders it instead (or holds
+ * on the oldest frame left).
+ *
+ * @return true if this frame was rewound: the backend skips its update
+ */
+bool engine_rewind_frame(EngineState *engine);
+
+// ═══════════════════════════════════════════════════════════════════════════
+// STARTUP TIMING
+// ═══════════════════════════════════════════════════════════════════════════
+//
+//   EngineStartupStamp start = engine_startup_now();
+//   create_window(...);
+//   engine_startup_phase(engine, "window", start, engine_startup_now());
+//   ...
+//   engine_startup_report(engine); // once, before the main loop
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+EngineStartupStamp engine_startup_now(void);
+
+/**
+ * Record a startup phase. Main thread only: helper threads take their
+ * own stamps and the main thread records them (with `is_threaded`) after
+ * joining. Phases past ENGINE_MAX_STARTUP_PHASES are
+ * dropped.
+ */
+void engine_startup_record(EngineState *engine, const char *name,
+                           EngineStartupStamp start, EngineStartupStamp end,
+                           bool is_threaded);
+
+#define engine_startup_phase(engine, name, start, end)                         \
+  engine_startup_record((engine), (name), (start), (end), false)
+
+/**
+ * Print the startup breakdown (engine_init entry to now) and, in
+ * DE100_INTERNAL builds, hand the phases to the profiler as timed blocks.
+ * Backends call it once their own init is done.
+ */
+void engine_startup_report(EngineState *engine);
+
+// ═══════════════════════════════════════════════════════════════════════════
+// MEMORY TELEMETRY
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define ENGINE_MEMORY_STATS_INTERVAL 30 // Frames between snapshots
+
+/**
+ * Refresh engine->platform.memory_stats now (engine_swap_inputs does it
+ * every ENGINE_MEMORY_STATS_INTERVAL frames). Internal builds also emit
+ * the totals as trace counters.
+ */
+void engine_memory_stats_collect(EngineState *engine);
+
 // ═══════════════════════════════════════════════════════════════════════════
 // ENGINE HELPERS
 // ═══════════════════════════════════════════════════════════════════════════
 
+/**
+ * Reset memory.frame_arena for a new frame, keeping the one just filled
+ * as memory.previous_frame_arena.
+ */
+de100_file_scoped_fn inline void
+engine_rotate_frame_arenas(GameMemory *memory) {
+  if (memory->frame_arena) {
+    De100MemoryArena *finished = memory->frame_arena;
+    de100_arena_check_temps(finished);
+    memory->frame_arena = memory->previous_frame_arena;
+    memory->previous_frame_arena = finished;
+    de100_arena_reset(memory->frame_arena);
+  }
+}
+
+/**
+ * Apply the config file's live fields if it changed (see config-file.h).
+ * engine_swap_inputs checks every frame.
+ */
+void engine_config_file_reload(EngineState *engine);
+
+/**
+ * Apply the commands the game queued since the last drain (see
+ * platform-command.h). engine_swap_inputs drains every frame.
+ */
+void engine_platform_commands_drain(EngineState *engine);
+
 /**
  * Swap inputs buffers at end of frame.
  *
  * After calling:
  *   - engine->game.current points to fresh inputs buffer
  *   - engine->game.previous points to last frame's inputs
+ *   - memory.frame_arena is the (reset) arena from two frames ago and
+ *     memory.previous_frame_arena the one the frame just filled
+ *   - platform.memory_stats is refreshed if its interval is up
+ *   - an edited config file's live fields are applied
+ *   - commands the game queued for the platform are applied
  */
 de100_file_scoped_fn inline void engine_swap_inputs(EngineState *engine) {
   GameInput *temp = engine->game.inputs;
   engine->game.inputs = engine->platform.old_inputs;
   engine->platform.old_inputs = temp;
+
+  engine_rotate_frame_arenas(&engine->game.memory);
+
+  if (config_file_poll(&engine->platform.config_file)) {
+    engine_config_file_reload(engine);
+  }
+  engine_platform_commands_drain(engine);
+
+  if (++engine->platform.memory_stats_frame >= ENGINE_MEMORY_STATS_INTERVAL) {
+    engine->platform.memory_stats_frame = 0;
+    engine_memory_stats_collect(engine);
+  }
 }
 
 /**
@@ -0,0 +1,172 @@
+#include "asset-pack.h"
+
+#include <string.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ERROR MESSAGES
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_global_var const char *g_asset_pack_error_messages[] = {
+    [DE100_ASSET_PACK_SUCCESS] = "Success",
+    [DE100_ASSET_PACK_ERROR_NULL_ARGUMENT] = "NULL pack or path",
+    [DE100_ASSET_PACK_ERROR_OPEN_FAILED] = "Failed to map asset pack",
+    [DE100_ASSET_PACK_ERROR_NOT_A_PACK] = "Not a .de100pak file",
+    [DE100_ASSET_PACK_ERROR_VERSION_MISMATCH] =
+        "Asset pack version mismatch (rebuild it with the current packer)",
+    [DE100_ASSET_PACK_ERROR_CORRUPT] =
+        "Asset pack table or entry out of bounds",
+};
+
+const char *de100_asset_pack_strerror(De100AssetPackErrorCode code) {
+  if (code >= 0 && code < DE100_ASSET_PACK_ERROR_COUNT) {
+    return g_asset_pack_error_messages[code];
+  }
+  return "Unknown asset pack error";
+}
+
+de100_file_scoped_fn inline De100AssetPackResult
+asset_pack_result(De100AssetPackErrorCode code) {
+  return (De100AssetPackResult){
+      .success = code == DE100_ASSET_PACK_SUCCESS,
+      .error_code = code,
+  };
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// OPEN / CLOSE
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn De100AssetPackErrorCode
+asset_pack_validate(const u8 *base, u64 file_size) {
+  if (file_size < sizeof(De100PakHeader)) {
+    return DE100_ASSET_PACK_ERROR_NOT_A_PACK;
+  }
+
+  const De100PakHeader *header = (const De100PakHeader *)base;
+  if (header->magic != DE100_PAK_MAGIC) {
+    return DE100_ASSET_PACK_ERROR_NOT_A_PACK;
+  }
+  if (header->version != DE100_PAK_VERSION ||
+      header->header_size != sizeof(De100PakHeader)) {
+    return DE100_ASSET_PACK_ERROR_VERSION_MISMATCH;
+  }
+
+  u64 toc_end = (u64)header->toc_offset +
+                (u64)header->asset_count * sizeof(De100PakEntry);
+  u64 names_end = (u64)header->names_offset + header->names_size;
+  if (header->file_size != file_size || toc_end > file_size ||
+      names_end > file_size || header->toc_offset % 8 != 0) {
+    return DE100_ASSET_PACK_ERROR_CORRUPT;
+  }
+
+  const De100PakEntry *entries =
+      (const De100PakEntry *)(base + header->toc_offset);
+  for (u32 i = 0; i < header->asset_count; ++i) {
+    const De100PakEntry *entry = &entries[i];
+    if (entry->offset > file_size || entry->size > file_size - entry->offset ||
+        entry->name_offset >= header->names_size ||
+        (i > 0 && entries[i - 1].id >= entry->id)) {
+      return DE100_ASSET_PACK_ERROR_CORRUPT;
+    }
+    if ((entry->type == DE100_PAK_ASSET_BITMAP ||
+         entry->type == DE100_PAK_ASSET_BITMAP_BGRA8) &&
+        (entry->pitch < entry->width * 4 ||
+         (u64)entry->pitch * entry->height > entry->size)) {
+      return DE100_ASSET_PACK_ERROR_CORRUPT;
+    }
+  }
+
+  return DE100_ASSET_PACK_SUCCESS;
+}
+
+De100AssetPackResult de100_asset_pack_open(De100AssetPack *pack,
+                                           const char *path) {
+  if (!pack || !path) {
+    return asset_pack_result(DE100_ASSET_PACK_ERROR_NULL_ARGUMENT);
+  }
+  memset(pack, 0, sizeof(*pack));
+
+  // Random: lookups jump straight to the assets a level uses
+  De100FileMapping mapping =
+      de100_file_map_readonly(path, DE100_FILE_MAP_ADVICE_RANDOM);
+  if (!mapping.success) {
+    return asset_pack_result(DE100_ASSET_PACK_ERROR_OPEN_FAILED);
+  }
+
+  const u8 *base = (const u8 *)mapping.data;
+  De100AssetPackErrorCode code =
+      base ? asset_pack_validate(base, mapping.size)
+           : DE100_ASSET_PACK_ERROR_NOT_A_PACK;
+  if (code != DE100_ASSET_PACK_SUCCESS) {
+    de100_file_unmap(&mapping);
+    return asset_pack_result(code);
+  }
+
+  pack->mapping = mapping;
+  pack->header = (const De100PakHeader *)base;
+  pack->entries = (const De100PakEntry *)(base + pack->header->toc_offset);
+  pack->names = (const char *)(base + pack->header->names_offset);
+  pack->asset_count = pack->header->asset_count;
+  return asset_pack_result(DE100_ASSET_PACK_SUCCESS);
+}
+
+void de100_asset_pack_close(De100AssetPack *pack) {
+  if (!pack) {
+    return;
+  }
+  de100_file_unmap(&pack->mapping);
+  memset(pack, 0, sizeof(*pack));
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// LOOKUP
+// ═══════════════════════════════════════════════════════════════════════════
+
+const De100PakEntry *de100_asset_pack_find(const De100AssetPack *pack,
+                                           u32 id) {
+  if (!pack || !pack->entries) {
+    return NULL;
+  }
+
+  u32 low = 0;
+  u32 high = pack->asset_count;
+  while (low < high) {
+    u32 mid = low + (high - low) / 2;
+    u32 mid_id = pack->entries[mid].id;
+    if (mid_id == id) {
+      return &pack->entries[mid];
+    }
+    if (mid_id < id) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  return NULL;
+}
+
+bool de100_asset_pack_bitmap(const De100AssetPack *pack, u32 id,
+                             De100PakBitmap *out_bitmap) {
+  const De100PakEntry *entry = de100_asset_pack_find(pack, id);
+  if (!entry || entry->type != DE100_PAK_ASSET_BITMAP_NATIVE) {
+    return false;
+  }
+
+  out_bitmap->pixels = (const u8 *)pack->mapping.data + entry->offset;
+  out_bitmap->width = (i32)entry->width;
+  out_bitmap->height = (i32)entry->height;
+  out_bitmap->pitch = (i32)entry->pitch;
+  return true;
+}
+
+const void *de100_asset_pack_data(const De100AssetPack *pack, u32 id,
+                                  u64 *out_size) {
+  const De100PakEntry *entry = de100_asset_pack_find(pack, id);
+  if (!entry) {
+    return NULL;
+  }
+  if (out_size) {
+    *out_size = entry->size;
+  }
+  return (const u8 *)pack->mapping.data + entry->offset;
+}
@@ -0,0 +1,150 @@
+#ifndef DE100_GAME_ASSET_PACK_H
+#define DE100_GAME_ASSET_PACK_H
+
+#include "../_common/base.h"
+#include "../_common/file.h"
+#include "backbuffer.h"
+#include <stdbool.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// 📦 ASSET PACKS (.de100pak)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// One file, mapped once, read in place. Everything that costs time
+// (PNG/BMP decode, swizzle, premultiply, alignment) happened at build
+// time in engine/tools/asset-packer.c, so at runtime a bitmap is just a
+// pointer into the page cache in the backbuffer's own pixel format:
+//
+//   ┌────────────────┐ 0
+//   │ De100PakHeader │
+//   ├────────────────┤ toc_offset
+//   │ De100PakEntry  │ × asset_count, sorted by id (binary search)
+//   ├────────────────┤ names_offset
+//   │ "name\0" ...   │ (debug / tooling only)
+//   ├────────────────┤ aligned to DE100_PAK_ALIGNMENT
+//   │ blob           │ bitmap: pixel-format bytes, premultiplied, `pitch`
+//   │ blob           │ raw:    the source file's bytes
+//   └────────────────┘
+//
+//   De100AssetPack pack;
+//   de100_asset_pack_open(&pack, "data/assets.de100pak");
+//   De100PakBitmap hero;
+//   if (de100_asset_pack_bitmap(&pack, de100_asset_id("hero"), &hero)) {...}
+//
+// Ids are the FNV-1a hash of the name given to the packer; the packer
+// refuses collisions. All fields are little-endian.
+//
+// Keep the De100AssetPack in engine/transient memory or re-open it after a
+// hot reload: the mapping belongs to the process, not to game memory, so a
+// replay snapshot must not restore a stale one.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define DE100_PAK_MAGIC 0x50303144u // "D10P"
+#define DE100_PAK_VERSION 1
+#define DE100_PAK_ALIGNMENT 64 // Blob start (cache line, any SIMD load)
+#define DE100_PAK_ROW_ALIGNMENT 16
+
+typedef enum {
+  DE100_PAK_ASSET_RAW = 0,
+  DE100_PAK_ASSET_BITMAP,       // RGBA8, premultiplied
+  DE100_PAK_ASSET_BITMAP_BGRA8, // BGRA8, premultiplied
+
+  DE100_PAK_ASSET_COUNT
+} De100PakAssetType;
+
+// The bitmap type this build can blit as-is (the packer writes it, the
+// runtime accepts only it: a pack built for the other format is rejected,
+// never drawn with swapped channels)
+#if DE100_PIXEL_FORMAT == DE100_PIXEL_FORMAT_BGRA8
+#define DE100_PAK_ASSET_BITMAP_NATIVE DE100_PAK_ASSET_BITMAP_BGRA8
+#else
+#define DE100_PAK_ASSET_BITMAP_NATIVE DE100_PAK_ASSET_BITMAP
+#endif
+
+typedef struct {
+  u32 magic;
+  u16 version;
+  u16 header_size;
+  u32 asset_count;
+  u32 toc_offset;
+  u32 names_offset;
+  u32 names_size;
+  u64 file_size;
+} De100PakHeader;
+
+typedef struct {
+  u32 id;
+  u32 type; // De100PakAssetType
+  u64 offset;
+  u64 size;
+  u32 name_offset; // Into the name table
+  u32 width;       // Bitmaps only
+  u32 height;
+  u32 pitch; // Bytes per row
+} De100PakEntry;
+
+typedef struct {
+  const u8 *pixels; // DE100_PIXEL_FORMAT bytes; premultiplied alpha
+  i32 width;
+  i32 height;
+  i32 pitch;
+} De100PakBitmap;
+
+typedef struct {
+  De100FileMapping mapping;
+  const De100PakHeader *header;
+  const De100PakEntry *entries;
+  const char *names;
+  u32 asset_count;
+} De100AssetPack;
+
+typedef enum {
+  DE100_ASSET_PACK_SUCCESS = 0,
+  DE100_ASSET_PACK_ERROR_NULL_ARGUMENT,
+  DE100_ASSET_PACK_ERROR_OPEN_FAILED,
+  DE100_ASSET_PACK_ERROR_NOT_A_PACK,
+  DE100_ASSET_PACK_ERROR_VERSION_MISMATCH,
+  DE100_ASSET_PACK_ERROR_CORRUPT,
+
+  DE100_ASSET_PACK_ERROR_COUNT
+} De100AssetPackErrorCode;
+
+typedef struct {
+  bool success;
+  De100AssetPackErrorCode error_code;
+} De100AssetPackResult;
+
+/** FNV-1a, the same hash the packer stores. */
+de100_file_scoped_fn inline u32 de100_asset_id(const char *name) {
+  u32 hash = 2166136261u;
+  for (const u8 *c = (const u8 *)name; *c; ++c) {
+    hash = (hash ^ *c) * 16777619u;
+  }
+  return hash;
+}
+
+/**
+ * Map `path` and validate header, table and every entry's bounds once, so
+ * lookups never bounds-check again. Nothing to free on failure.
+ */
+De100AssetPackResult de100_asset_pack_open(De100AssetPack *pack,
+                                           const char *path);
+
+void de100_asset_pack_close(De100AssetPack *pack);
+
+/** NULL if the pack has no asset with that id. */
+const De100PakEntry *de100_asset_pack_find(const De100AssetPack *pack,
+                                           u32 id);
+
+/** False if missing or not a bitmap. */
+bool de100_asset_pack_bitmap(const De100AssetPack *pack, u32 id,
+                             De100PakBitmap *out_bitmap);
+
+/** Any asset's bytes (bitmaps included); NULL if missing. */
+const void *de100_asset_pack_data(const De100AssetPack *pack, u32 id,
+                                  u64 *out_size);
+
+const char *de100_asset_pack_strerror(De100AssetPackErrorCode code);
+
+#endif // DE100_GAME_ASSET_PACK_H
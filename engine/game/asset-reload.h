@@ -0,0 +1,218 @@
+#ifndef DE100_GAME_ASSET_RELOAD_H
+#define DE100_GAME_ASSET_RELOAD_H
+
+#include "../_common/base.h"
+#include "asset-watch.h"
+#include "background-load.h"
+
+#include <string.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ASSET HOT RELOAD (watched files, background decode, frame-boundary swap)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// Game code reloads on rebuild; this does the same for art. A slot owns
+// two buffers for one asset: the LIVE one the game draws from, and a
+// STAGING one a background load decodes into when the file changes on
+// disk. update() swaps them once the decode succeeded, at the top of the
+// frame, so a frame never sees half an asset:
+//
+//   DE100_BACKGROUND_LOAD_CALLBACK(decode_atlas) {
+//     De100AssetReload *slot = (De100AssetReload *)task->data;
+//     Atlas *atlas = (Atlas *)de100_asset_reload_staging(slot);
+//     return atlas_decode(atlas, slot->path, thread_context);
+//   }
+//
+//   // Init: load once into atlas[0] as before, then
+//   de100_asset_reload_init(&state->atlas_reload, "assets/atlas.png",
+//                           &state->atlas[0], &state->atlas[1]);
+//
+//   // Every frame, before anything reads the atlas:
+//   de100_asset_reload_update(&state->atlas_reload, memory, decode_atlas,
+//                             NULL);
+//   const Atlas *atlas = de100_asset_reload_live(&state->atlas_reload);
+//
+// The platform watches the file (De100AssetWatcher: one file watch per
+// path, see file-watch.h) and counts settled changes; a slot reloads when
+// the count moves past the one it last saw. Only that slot reloads:
+// nothing else is decoded again, and several slots may watch one file.
+//
+// A pack works the same way with the packs as buffers: decode opens the
+// rebuilt .de100pak into the staging De100AssetPack, and `release`
+// closes the retired one after the swap (main thread, once no pointer
+// into it is left). Reopening maps the file; unchanged blobs cost nothing.
+//
+// Decoding needs the background loader; without it (or without a
+// watcher: release builds, DE100_INTERNAL=0) update() never reloads.
+// The callbacks are passed on every update rather than stored, so a hot
+// reload of game code can't leave a stale pointer behind; a decode it
+// cancelled is resubmitted by the next update.
+//
+// update() takes the watcher and loader from GameMemory (memory.h must
+// be included first). A host without GameMemory, such as a game with its
+// own platform layer, fills a De100AssetReloadHost with its watcher and
+// loader and calls poll() instead; the slot works the same.
+//
+// When a change lands depends on the disk and the loader, not on inputs:
+// keep reloadable assets to presentation (art, sounds), not simulated
+// state, as for other background loads. The slot and both buffers must
+// live in game memory for as long as the slot is updated.
+//
+// All functions are static inline for zero overhead if unused.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#ifndef DE100_ASSET_RELOAD_PATH_MAX
+#define DE100_ASSET_RELOAD_PATH_MAX 256
+#endif
+
+// Main thread, right after a swap: `retired` held the previous version
+#define DE100_ASSET_RELOAD_RELEASE(name) void name(void *retired)
+typedef DE100_ASSET_RELOAD_RELEASE(de100_asset_reload_release_t);
+
+typedef struct {
+  char path[DE100_ASSET_RELOAD_PATH_MAX]; // Read by the decode callback
+  void *buffers[2];
+  u32 live; // Index into buffers
+
+  u32 watch;            // Platform watch id, 0 until registered
+  u32 seen_version;     // Watch version the last finished decode read
+  u32 decoding_version; // Watch version the decode in flight reads
+  u32 reload_count;
+  u32 failure_count; // Decodes that returned false (live kept)
+
+  De100BackgroundLoad load;
+} De100AssetReload;
+
+// The platform services a slot reloads through
+typedef struct De100AssetReloadHost {
+  De100AssetWatcher *watcher; // NULL: nothing reloads
+  de100_platform_asset_watch_t *asset_watch;
+  de100_platform_asset_watch_version_t *asset_watch_version;
+  De100BackgroundLoader *background_loader; // Passed to submit, may be NULL
+  de100_platform_background_load_submit_t *background_load_submit;
+} De100AssetReloadHost;
+
+/**
+ * `live` holds the asset as loaded by the game; `staging` is the same
+ * type and size, unused until a reload. False if `path` doesn't fit.
+ */
+de100_file_scoped_fn inline bool
+de100_asset_reload_init(De100AssetReload *slot, const char *path, void *live,
+                        void *staging) {
+  *slot = (De100AssetReload){.buffers = {live, staging}};
+  size_t length = strlen(path);
+  if (length >= sizeof(slot->path)) {
+    return false;
+  }
+  memcpy(slot->path, path, length + 1);
+  return true;
+}
+
+de100_file_scoped_fn inline void *
+de100_asset_reload_live(const De100AssetReload *slot) {
+  return slot->buffers[slot->live];
+}
+
+/** The decode target: only the decode callback touches it. */
+de100_file_scoped_fn inline void *
+de100_asset_reload_staging(const De100AssetReload *slot) {
+  return slot->buffers[slot->live ^ 1u];
+}
+
+de100_file_scoped_fn inline bool
+de100_asset_reload_is_loading(const De100AssetReload *slot) {
+  u32 status = __atomic_load_n(&slot->load.status, __ATOMIC_ACQUIRE);
+  return status == DE100_BACKGROUND_LOAD_STATUS_QUEUED ||
+         status == DE100_BACKGROUND_LOAD_STATUS_RUNNING;
+}
+
+/**
+ * Once per frame, before the live buffer is read: notice changes, start
+ * a decode, swap in a finished one (then `release`, may be NULL, gets the
+ * retired buffer).
+ *
+ * @return true on the frame the live buffer changed
+ */
+de100_file_scoped_fn inline bool
+de100_asset_reload_poll(De100AssetReload *slot,
+                        const De100AssetReloadHost *host,
+                        de100_background_load_callback_t *decode,
+                        de100_asset_reload_release_t *release) {
+  De100AssetWatcher *watcher = host->watcher;
+  if (!watcher || !host->background_load_submit) {
+    return false;
+  }
+  if (slot->watch == 0) {
+    slot->watch = host->asset_watch(watcher, slot->path);
+    if (slot->watch == 0) {
+      return false;
+    }
+    slot->seen_version = host->asset_watch_version(watcher, slot->watch);
+  }
+  if (de100_asset_reload_is_loading(slot)) {
+    return false;
+  }
+
+  bool swapped = false;
+  u32 status = __atomic_load_n(&slot->load.status, __ATOMIC_ACQUIRE);
+  if (status == DE100_BACKGROUND_LOAD_STATUS_COMPLETE) {
+    slot->live ^= 1u;
+    slot->seen_version = slot->decoding_version;
+    slot->reload_count++;
+    swapped = true;
+    if (release) {
+      release(de100_asset_reload_staging(slot));
+    }
+  } else if (status == DE100_BACKGROUND_LOAD_STATUS_FAILED) {
+    // Keep the old asset; the next save tries again
+    slot->seen_version = slot->decoding_version;
+    slot->failure_count++;
+  }
+  // CANCELLED (hot reload) leaves seen_version behind: resubmitted below
+  slot->load.status = DE100_BACKGROUND_LOAD_STATUS_IDLE;
+
+  u32 version = host->asset_watch_version(watcher, slot->watch);
+  if (version != slot->seen_version) {
+    slot->load = (De100BackgroundLoad){.callback = decode, .data = slot};
+    slot->decoding_version = version;
+    if (!host->background_load_submit(host->background_loader,
+                                      &slot->load)) {
+      slot->load.status = DE100_BACKGROUND_LOAD_STATUS_IDLE; // Next frame
+    }
+  }
+  return swapped;
+}
+
+#ifdef DE100_GAME_De100_MEMORY_H
+/** poll() with the watcher and loader the platform put in GameMemory. */
+de100_file_scoped_fn inline bool
+de100_asset_reload_update(De100AssetReload *slot, GameMemory *memory,
+                          de100_background_load_callback_t *decode,
+                          de100_asset_reload_release_t *release) {
+  if (!memory->background_loader) {
+    return false;
+  }
+  De100AssetReloadHost host = {
+      .watcher = memory->asset_watcher,
+      .asset_watch = memory->asset_watch,
+      .asset_watch_version = memory->asset_watch_version,
+      .background_loader = memory->background_loader,
+      .background_load_submit = memory->background_load_submit,
+  };
+  return de100_asset_reload_poll(slot, &host, decode, release);
+}
+#endif
+
+/**
+ * Stop decoding before the slot or its buffers go away (level change).
+ * The watch stays with the platform and is reused by path.
+ */
+de100_file_scoped_fn inline void
+de100_asset_reload_cancel(De100AssetReload *slot) {
+  if (de100_asset_reload_is_loading(slot)) {
+    de100_background_load_cancel(&slot->load);
+  }
+}
+
+#endif // DE100_GAME_ASSET_RELOAD_H
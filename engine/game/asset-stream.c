@@ -0,0 +1,467 @@
+#include "asset-stream.h"
+
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// PLACEHOLDER
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_global_var const u8 g_asset_stream_placeholder_pixels[] = {
+    255, 0, 255, 255, 0, 0, 0,   255, // Magenta, black
+    0,   0, 0,   255, 255, 0, 255, 255, // Black, magenta
+};
+
+De100PakBitmap de100_asset_stream_placeholder(void) {
+  return (De100PakBitmap){
+      .pixels = g_asset_stream_placeholder_pixels,
+      .width = 2,
+      .height = 2,
+      .pitch = 8,
+  };
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// INIT / FRAME
+// ═══════════════════════════════════════════════════════════════════════════
+
+bool de100_asset_stream_init(De100AssetStream *stream,
+                             const De100AssetPack *pack, const char *pack_path,
+                             De100MemoryArena *arena, u64 budget) {
+  memset(stream, 0, sizeof(*stream));
+  if (!pack || !pack->entries || !pack_path ||
+      strlen(pack_path) >= DE100_ASSET_STREAM_PATH_MAX) {
+    return false;
+  }
+
+  u64 arena_used = arena->used;
+  u16 *slot_by_entry =
+      de100_arena_push_array_zero(arena, pack->asset_count, u16);
+  u8 *storage = de100_arena_push_size_aligned(arena, budget,
+                                              DE100_PAK_ALIGNMENT);
+  if (!slot_by_entry || !storage) {
+    de100_arena_pop_to(arena, arena_used);
+    return false;
+  }
+
+  stream->pack = pack;
+  strcpy(stream->pack_path, pack_path);
+  stream->storage = storage;
+  stream->storage_size = budget;
+  stream->slot_by_entry = slot_by_entry;
+  stream->frame = 1;
+  return true;
+}
+
+bool de100_asset_stream_init_loader(De100AssetStream *stream,
+                                    de100_asset_stream_load_t *load,
+                                    void *user, const u64 *sizes, u32 id_count,
+                                    De100MemoryArena *arena, u64 budget) {
+  memset(stream, 0, sizeof(*stream));
+  if (!load || !sizes) {
+    return false;
+  }
+
+  u64 arena_used = arena->used;
+  u16 *slot_by_entry = de100_arena_push_array_zero(arena, id_count, u16);
+  u64 *size_by_id = de100_arena_push_array(arena, id_count, u64);
+  u8 *storage = de100_arena_push_size_aligned(arena, budget,
+                                              DE100_PAK_ALIGNMENT);
+  if (!slot_by_entry || !size_by_id || !storage) {
+    de100_arena_pop_to(arena, arena_used);
+    return false;
+  }
+  memcpy(size_by_id, sizes, id_count * sizeof(u64));
+
+  stream->load = load;
+  stream->load_user = user;
+  stream->size_by_id = size_by_id;
+  stream->id_count = id_count;
+  stream->storage = storage;
+  stream->storage_size = budget;
+  stream->slot_by_entry = slot_by_entry;
+  stream->frame = 1;
+  return true;
+}
+
+void de100_asset_stream_begin_frame(De100AssetStream *stream) {
+  stream->frame++;
+  stream->stats.placeholder_returns = 0;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// SOURCE (a pack, or the game's loader)
+// ═══════════════════════════════════════════════════════════════════════════
+
+// The slot_by_entry index for `id`; false if the source has no such asset
+de100_file_scoped_fn bool asset_stream_find(const De100AssetStream *stream,
+                                            u32 id, u32 *out_entry_index) {
+  if (!stream->pack) {
+    *out_entry_index = id;
+    return id < stream->id_count;
+  }
+  const De100PakEntry *entry = de100_asset_pack_find(stream->pack, id);
+  if (!entry) {
+    return false;
+  }
+  *out_entry_index = (u32)(entry - stream->pack->entries);
+  return true;
+}
+
+de100_file_scoped_fn inline u64
+asset_stream_entry_size(const De100AssetStream *stream, u32 entry_index) {
+  return stream->pack ? stream->pack->entries[entry_index].size
+                      : stream->size_by_id[entry_index];
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// BUDGET BLOCK (first fit over the offset-sorted slots)
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn inline u64 asset_stream_footprint(u64 size) {
+  u64 alignment = DE100_PAK_ALIGNMENT;
+  u64 footprint = (size + alignment - 1) & ~(alignment - 1);
+  return footprint ? footprint : alignment;
+}
+
+de100_file_scoped_fn void asset_stream_release(De100AssetStream *stream,
+                                               u32 slot_index) {
+  De100AssetStreamSlot *slot = &stream->slots[slot_index];
+  if (slot->state == DE100_ASSET_STREAM_SLOT_LOADING ||
+      slot->state == DE100_ASSET_STREAM_SLOT_RESIDENT) {
+    for (u32 i = 0; i < stream->by_offset_count; ++i) {
+      if (stream->by_offset[i] == slot_index) {
+        memmove(&stream->by_offset[i], &stream->by_offset[i + 1],
+                (stream->by_offset_count - i - 1) * sizeof(u16));
+        stream->by_offset_count--;
+        break;
+      }
+    }
+    stream->bytes_resident -= asset_stream_footprint(slot->size);
+  }
+  stream->slot_by_entry[slot->entry_index] = 0;
+  memset(slot, 0, sizeof(*slot));
+}
+
+// Oldest RESIDENT/FAILED slot not used this frame. LOADING slots are never
+// evicted: the I/O thread is still writing into them.
+de100_file_scoped_fn bool asset_stream_evict_lru(De100AssetStream *stream) {
+  u32 victim = DE100_ASSET_STREAM_MAX_SLOTS;
+  u64 oldest = stream->frame;
+  for (u32 i = 0; i < DE100_ASSET_STREAM_MAX_SLOTS; ++i) {
+    De100AssetStreamSlot *slot = &stream->slots[i];
+    if ((slot->state == DE100_ASSET_STREAM_SLOT_RESIDENT ||
+         slot->state == DE100_ASSET_STREAM_SLOT_FAILED) &&
+        slot->last_used_frame < oldest) {
+      oldest = slot->last_used_frame;
+      victim = i;
+    }
+  }
+  if (victim == DE100_ASSET_STREAM_MAX_SLOTS) {
+    return false;
+  }
+  if (stream->slots[victim].state == DE100_ASSET_STREAM_SLOT_RESIDENT) {
+    stream->stats.evictions++;
+  }
+  asset_stream_release(stream, victim);
+  return true;
+}
+
+// Finds room for `size` bytes, evicting LRU assets until a gap is big
+// enough. Records the slot in by_offset on success.
+de100_file_scoped_fn bool asset_stream_allocate(De100AssetStream *stream,
+                                                u32 slot_index, u64 size) {
+  u64 footprint = asset_stream_footprint(size);
+  for (;;) {
+    u64 gap_start = 0;
+    u32 insert_at = 0;
+    bool found = false;
+    for (; insert_at < stream->by_offset_count; ++insert_at) {
+      De100AssetStreamSlot *next =
+          &stream->slots[stream->by_offset[insert_at]];
+      if (next->offset - gap_start >= footprint) {
+        found = true;
+        break;
+      }
+      gap_start = next->offset + asset_stream_footprint(next->size);
+    }
+    found |= stream->storage_size - gap_start >= footprint;
+
+    if (found) {
+      memmove(&stream->by_offset[insert_at + 1], &stream->by_offset[insert_at],
+              (stream->by_offset_count - insert_at) * sizeof(u16));
+      stream->by_offset[insert_at] = (u16)slot_index;
+      stream->by_offset_count++;
+      stream->slots[slot_index].offset = gap_start;
+      stream->bytes_resident += footprint;
+      return true;
+    }
+    if (!asset_stream_evict_lru(stream)) {
+      return false; // Everything resident is in use this frame
+    }
+  }
+}
+
+de100_file_scoped_fn u32 asset_stream_acquire_slot(De100AssetStream *stream) {
+  for (int attempt = 0; attempt < 2; ++attempt) {
+    for (u32 i = 0; i < DE100_ASSET_STREAM_MAX_SLOTS; ++i) {
+      if (stream->slots[i].state == DE100_ASSET_STREAM_SLOT_EMPTY) {
+        return i;
+      }
+    }
+    if (!asset_stream_evict_lru(stream)) {
+      break;
+    }
+  }
+  return DE100_ASSET_STREAM_MAX_SLOTS;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// LOADING
+// ═══════════════════════════════════════════════════════════════════════════
+
+// A load that won't land: give the space back, remember the failure (no
+// retry until the slot is evicted)
+de100_file_scoped_fn void asset_stream_fail(De100AssetStream *stream,
+                                            u32 slot_index) {
+  De100AssetStreamSlot *slot = &stream->slots[slot_index];
+  u32 entry_index = slot->entry_index;
+  u64 last_used_frame = slot->last_used_frame;
+  asset_stream_release(stream, slot_index);
+  slot->state = DE100_ASSET_STREAM_SLOT_FAILED;
+  slot->entry_index = entry_index;
+  slot->last_used_frame = last_used_frame;
+  stream->slot_by_entry[entry_index] = (u16)(slot_index + 1);
+  stream->stats.loads_failed++;
+}
+
+// Loader thread: the game fills the slot's range of the budget
+de100_file_scoped_fn DE100_BACKGROUND_LOAD_CALLBACK(asset_stream_load_slot) {
+  De100AssetStream *stream = (De100AssetStream *)task->data;
+  De100AssetStreamSlot *slot =
+      (De100AssetStreamSlot *)((u8 *)task -
+                               offsetof(De100AssetStreamSlot, task));
+  return stream->load(thread_context, slot->entry_index,
+                      stream->storage + slot->offset, slot->size,
+                      stream->load_user);
+}
+
+// A LOADING slot of a loader source: hand it to the background loader
+de100_file_scoped_fn void asset_stream_start_loader(De100AssetStream *stream,
+                                                    GameMemory *memory,
+                                                    u32 slot_index) {
+  De100AssetStreamSlot *slot = &stream->slots[slot_index];
+  if (!memory || !memory->background_load_submit) {
+    // No loader on this platform: fill it in place
+    if (stream->load(NULL, slot->entry_index, stream->storage + slot->offset,
+                     slot->size, stream->load_user)) {
+      slot->state = DE100_ASSET_STREAM_SLOT_RESIDENT;
+    } else {
+      asset_stream_fail(stream, slot_index);
+    }
+    return;
+  }
+
+  slot->task = (De100BackgroundLoad){
+      .callback = asset_stream_load_slot,
+      .data = stream,
+  };
+  if (!memory->background_load_submit(memory->background_loader,
+                                      &slot->task)) {
+    // Loader full: give the space back, try again next frame
+    asset_stream_release(stream, slot_index);
+    stream->stats.loads_started--;
+  }
+}
+
+de100_file_scoped_fn void asset_stream_start_load(De100AssetStream *stream,
+                                                  GameMemory *memory,
+                                                  u32 entry_index) {
+  u64 size = asset_stream_entry_size(stream, entry_index);
+  u32 slot_index = asset_stream_acquire_slot(stream);
+  if (slot_index == DE100_ASSET_STREAM_MAX_SLOTS) {
+    return; // Retry on a later frame
+  }
+
+  De100AssetStreamSlot *slot = &stream->slots[slot_index];
+  slot->entry_index = entry_index;
+  slot->size = size;
+  slot->last_used_frame = stream->frame;
+
+  if (asset_stream_footprint(size) > stream->storage_size) {
+    // Will never fit: remember that instead of retrying every frame
+    slot->state = DE100_ASSET_STREAM_SLOT_FAILED;
+    stream->slot_by_entry[entry_index] = (u16)(slot_index + 1);
+    stream->stats.loads_failed++;
+    return;
+  }
+  if (!asset_stream_allocate(stream, slot_index, size)) {
+    memset(slot, 0, sizeof(*slot));
+    return;
+  }
+
+  slot->state = DE100_ASSET_STREAM_SLOT_LOADING;
+  stream->slot_by_entry[entry_index] = (u16)(slot_index + 1);
+  stream->stats.loads_started++;
+
+  void *destination = stream->storage + slot->offset;
+  if (!stream->pack) {
+    asset_stream_start_loader(stream, memory, slot_index);
+    return;
+  }
+
+  const De100PakEntry *entry = &stream->pack->entries[entry_index];
+  if (!memory || !memory->async_io || !memory->async_io_submit) {
+    // No I/O queue on this platform: the pack is mapped, copy in place
+    memcpy(destination, (const u8 *)stream->pack->mapping.data + entry->offset,
+           entry->size);
+    slot->state = DE100_ASSET_STREAM_SLOT_RESIDENT;
+    return;
+  }
+
+  slot->request = (De100AsyncIORequest){
+      .op = DE100_ASYNC_IO_OP_READ,
+      .path = stream->pack_path,
+      .buffer = destination,
+      .offset = entry->offset,
+      .size = entry->size,
+  };
+  if (!memory->async_io_submit(memory->async_io, &slot->request)) {
+    // Queue full: give the space back, try again next frame
+    asset_stream_release(stream, slot_index);
+    stream->stats.loads_started--;
+  }
+}
+
+// Promote a finished load; true if the slot is now RESIDENT
+de100_file_scoped_fn bool asset_stream_poll(De100AssetStream *stream,
+                                            u32 slot_index) {
+  De100AssetStreamSlot *slot = &stream->slots[slot_index];
+  if (slot->state != DE100_ASSET_STREAM_SLOT_LOADING) {
+    return slot->state == DE100_ASSET_STREAM_SLOT_RESIDENT;
+  }
+
+  if (!stream->pack) {
+    if (de100_background_load_is_done(&slot->task)) {
+      if (__atomic_load_n(&slot->task.status, __ATOMIC_ACQUIRE) ==
+          DE100_BACKGROUND_LOAD_STATUS_COMPLETE) {
+        slot->state = DE100_ASSET_STREAM_SLOT_RESIDENT;
+      } else {
+#if DE100_INTERNAL
+        printf("⚠️  Asset stream: load of id %u failed\n", slot->entry_index);
+#endif
+        asset_stream_fail(stream, slot_index);
+      }
+    }
+  } else if (de100_async_io_is_done(&slot->request)) {
+    if (slot->request.status == DE100_ASYNC_IO_STATUS_COMPLETE &&
+        slot->request.bytes_transferred == slot->size) {
+      slot->state = DE100_ASSET_STREAM_SLOT_RESIDENT;
+    } else {
+#if DE100_INTERNAL
+      printf("⚠️  Asset stream: read of entry %u failed (error %d)\n",
+             slot->entry_index, slot->request.error_code);
+#endif
+      asset_stream_fail(stream, slot_index);
+    }
+  }
+  return slot->state == DE100_ASSET_STREAM_SLOT_RESIDENT;
+}
+
+// Slot for `id` if resident; queues the load otherwise
+de100_file_scoped_fn De100AssetStreamSlot *
+asset_stream_touch(De100AssetStream *stream, GameMemory *memory, u32 id) {
+  u32 entry_index;
+  if (!asset_stream_find(stream, id, &entry_index)) {
+    return NULL;
+  }
+
+  u32 slot_plus_one = stream->slot_by_entry[entry_index];
+  if (!slot_plus_one) {
+    asset_stream_start_load(stream, memory, entry_index);
+    slot_plus_one = stream->slot_by_entry[entry_index];
+    if (!slot_plus_one) {
+      return NULL;
+    }
+  }
+
+  De100AssetStreamSlot *slot = &stream->slots[slot_plus_one - 1];
+  slot->last_used_frame = stream->frame;
+  return asset_stream_poll(stream, slot_plus_one - 1) ? slot : NULL;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// PUBLIC LOOKUPS
+// ═══════════════════════════════════════════════════════════════════════════
+
+const void *de100_asset_stream_get(De100AssetStream *stream,
+                                   GameMemory *memory, u32 id,
+                                   u64 *out_size) {
+  De100AssetStreamSlot *slot = asset_stream_touch(stream, memory, id);
+  if (!slot) {
+    stream->stats.placeholder_returns++;
+    return NULL;
+  }
+  if (out_size) {
+    *out_size = slot->size;
+  }
+  return stream->storage + slot->offset;
+}
+
+bool de100_asset_stream_bitmap(De100AssetStream *stream, GameMemory *memory,
+                               u32 id, De100PakBitmap *out_bitmap) {
+  De100AssetStreamSlot *slot = asset_stream_touch(stream, memory, id);
+  const De100PakEntry *entry =
+      slot && stream->pack ? &stream->pack->entries[slot->entry_index] : NULL;
+  if (!entry || entry->type != DE100_PAK_ASSET_BITMAP_NATIVE) {
+    stream->stats.placeholder_returns++;
+    *out_bitmap = de100_asset_stream_placeholder();
+    return false;
+  }
+
+  out_bitmap->pixels = stream->storage + slot->offset;
+  out_bitmap->width = (i32)entry->width;
+  out_bitmap->height = (i32)entry->height;
+  out_bitmap->pitch = (i32)entry->pitch;
+  return true;
+}
+
+De100AssetStreamSlotState
+de100_asset_stream_state(const De100AssetStream *stream, u32 id) {
+  u32 entry_index;
+  if (!asset_stream_find(stream, id, &entry_index) ||
+      !stream->slot_by_entry[entry_index]) {
+    return DE100_ASSET_STREAM_SLOT_EMPTY;
+  }
+  u32 slot_index = stream->slot_by_entry[entry_index] - 1u;
+  return (De100AssetStreamSlotState)stream->slots[slot_index].state;
+}
+
+void de100_asset_stream_prefetch(De100AssetStream *stream, GameMemory *memory,
+                                 u32 id) {
+  u32 entry_index;
+  if (asset_stream_find(stream, id, &entry_index) &&
+      !stream->slot_by_entry[entry_index]) {
+    asset_stream_start_load(stream, memory, entry_index);
+  }
+}
+
+void de100_asset_stream_flush(De100AssetStream *stream, GameMemory *memory) {
+  for (u32 i = 0; i < DE100_ASSET_STREAM_MAX_SLOTS; ++i) {
+    De100AssetStreamSlot *slot = &stream->slots[i];
+    if (slot->state == DE100_ASSET_STREAM_SLOT_LOADING && !stream->pack) {
+      // The loader has no wait hook: a cancelled task that is still
+      // queued never starts, and a running one ends at its next check
+      de100_background_load_cancel(&slot->task);
+      while (!de100_background_load_is_done(&slot->task)) {
+      }
+    } else if (slot->state == DE100_ASSET_STREAM_SLOT_LOADING && memory &&
+               memory->async_io_wait) {
+      memory->async_io_wait(memory->async_io, &slot->request);
+    }
+    if (slot->state != DE100_ASSET_STREAM_SLOT_EMPTY) {
+      asset_stream_release(stream, i);
+    }
+  }
+}
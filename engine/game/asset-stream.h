@@ -0,0 +1,192 @@
+#ifndef DE100_GAME_ASSET_STREAM_H
+#define DE100_GAME_ASSET_STREAM_H
+
+#include "../_common/base.h"
+#include "asset-pack.h"
+#include "async-io.h"
+#include "background-load.h"
+#include "memory-arena.h"
+#include "memory.h"
+#include <stdbool.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// 🌊 ASSET STREAMING (fixed residency budget, LRU eviction)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// Keeps at most `budget` bytes of a .de100pak resident, however large the
+// pack is. The pack's table comes from the mapping (de100_asset_pack_open
+// touches only the header/TOC pages); blobs are read through the async
+// I/O queue into the budget block, which is carved out of transient
+// storage so RAM use is fixed up front.
+//
+//   // Init (once, with the pack already open):
+//   de100_asset_stream_init(&state->stream, &state->pack,
+//                           "data/assets.de100pak",
+//                           &state->transient_arena, MEGABYTES(64));
+//
+//   // Every frame, before any get:
+//   de100_asset_stream_begin_frame(&state->stream);
+//
+//   De100PakBitmap tile;
+//   if (!de100_asset_stream_bitmap(&state->stream, memory, tile_id, &tile)) {
+//     // `tile` is the magenta checker placeholder until the load lands
+//   }
+//
+// A get that misses queues the load and returns the placeholder; a later
+// frame returns the real data. When the budget is full, the least recently
+// used resident asset that was NOT touched this frame is evicted, so every
+// pointer handed out stays valid until the next begin_frame.
+//
+// Everything is plain data in transient storage: it survives hot reload
+// (in-flight requests keep their buffers). Call
+// de100_asset_stream_flush() before reusing that transient range for
+// something else.
+//
+// LOADER SOURCE: assets that aren't in a pack (one PNG per sprite, say)
+// stream the same way with the game producing the bytes. A callback
+// fills each asset's range of the budget on the background loader
+// (background-load.h), and ids are 0 .. id_count-1 with sizes known up
+// front:
+//
+//   DE100_ASSET_STREAM_LOAD(decode_sprite) {
+//     ... // fill `size` bytes of `destination` for sprite `id`
+//     return true;
+//   }
+//
+//   de100_asset_stream_init_loader(&state->stream, decode_sprite, state,
+//                                  sprite_sizes, SPRITE_COUNT,
+//                                  &state->transient_arena, KILOBYTES(64));
+//   const void *pixels = de100_asset_stream_get(&state->stream, memory,
+//                                               sprite_id, NULL);
+//
+// Gets and prefetches submit to GameMemory's background loader; without
+// one the callback runs in place, on the calling thread. A flush waits
+// for the loads in flight. The callback is stored in the stream: after a
+// hot reload of game code, set stream->load again before the next get.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#ifndef DE100_ASSET_STREAM_MAX_SLOTS
+#define DE100_ASSET_STREAM_MAX_SLOTS 256 // Resident + loading assets
+#endif
+
+#ifndef DE100_ASSET_STREAM_PATH_MAX
+#define DE100_ASSET_STREAM_PATH_MAX 256
+#endif
+
+typedef enum {
+  DE100_ASSET_STREAM_SLOT_EMPTY = 0,
+  DE100_ASSET_STREAM_SLOT_LOADING,
+  DE100_ASSET_STREAM_SLOT_RESIDENT,
+  DE100_ASSET_STREAM_SLOT_FAILED, // Read error or larger than the budget
+
+  DE100_ASSET_STREAM_SLOT_COUNT
+} De100AssetStreamSlotState;
+
+// Loader thread: fill `size` bytes of `destination` with asset `id`.
+// Return false on failure (the asset stays FAILED, as for a bad read).
+// `thread_context` is NULL when there is no loader and it runs in place.
+#define DE100_ASSET_STREAM_LOAD(name)                                          \
+  bool name(ThreadContext *thread_context, u32 id, void *destination,         \
+            u64 size, void *user)
+typedef DE100_ASSET_STREAM_LOAD(de100_asset_stream_load_t);
+
+typedef struct {
+  De100AsyncIORequest request; // Pack source
+  De100BackgroundLoad task;    // Loader source; data = the stream
+  u64 offset; // Into the budget block
+  u64 size;
+  u64 last_used_frame;
+  u32 entry_index; // Into pack->entries (the id, for a loader source)
+  u32 state;       // De100AssetStreamSlotState
+} De100AssetStreamSlot;
+
+typedef struct {
+  u32 loads_started;
+  u32 loads_failed;
+  u32 evictions;
+  u32 placeholder_returns; // Misses this frame
+} De100AssetStreamStats;
+
+typedef struct {
+  const De100AssetPack *pack; // NULL for a loader source
+  char pack_path[DE100_ASSET_STREAM_PATH_MAX]; // Read by the I/O thread
+
+  // Loader source
+  de100_asset_stream_load_t *load;
+  void *load_user;
+  const u64 *size_by_id;
+  u32 id_count;
+
+  u8 *storage; // Budget block, DE100_PAK_ALIGNMENT aligned
+  u64 storage_size;
+  u64 bytes_resident; // Including loads in flight
+
+  // pack entry index (or loader id) → slot index + 1 (0 = not streamed)
+  u16 *slot_by_entry;
+
+  De100AssetStreamSlot slots[DE100_ASSET_STREAM_MAX_SLOTS];
+
+  // Slots that own storage, sorted by offset (gaps = free space)
+  u16 by_offset[DE100_ASSET_STREAM_MAX_SLOTS];
+  u32 by_offset_count;
+
+  u64 frame; // LRU clock
+  De100AssetStreamStats stats;
+} De100AssetStream;
+
+/**
+ * Carve `budget` bytes (plus the per-entry index) out of `arena`.
+ * `pack` must stay open for the stream's lifetime. False if the arena
+ * can't hold it or the path doesn't fit.
+ */
+bool de100_asset_stream_init(De100AssetStream *stream,
+                             const De100AssetPack *pack, const char *pack_path,
+                             De100MemoryArena *arena, u64 budget);
+
+/**
+ * A loader source: ids 0 .. id_count-1, `sizes[id]` bytes each (copied).
+ * Carves `budget` bytes plus the per-id tables out of `arena`. False if
+ * the arena can't hold them.
+ */
+bool de100_asset_stream_init_loader(De100AssetStream *stream,
+                                    de100_asset_stream_load_t *load,
+                                    void *user, const u64 *sizes, u32 id_count,
+                                    De100MemoryArena *arena, u64 budget);
+
+/** Advance the LRU clock: pointers from the previous frame may now move. */
+void de100_asset_stream_begin_frame(De100AssetStream *stream);
+
+/**
+ * Resident bytes for `id`, or NULL (load queued) while streaming, on a
+ * failed load, or if the pack has no such asset.
+ */
+const void *de100_asset_stream_get(De100AssetStream *stream,
+                                   GameMemory *memory, u32 id, u64 *out_size);
+
+/**
+ * Where `id` stands, without queueing or touching it: EMPTY if it isn't
+ * streamed (or doesn't exist), FAILED if it never will load.
+ */
+De100AssetStreamSlotState
+de100_asset_stream_state(const De100AssetStream *stream, u32 id);
+
+/**
+ * Always fills `out_bitmap`: the asset once resident, the placeholder
+ * checker until then. Returns true only for the real asset (pack source
+ * only: a loader's bytes have no bitmap header).
+ */
+bool de100_asset_stream_bitmap(De100AssetStream *stream, GameMemory *memory,
+                               u32 id, De100PakBitmap *out_bitmap);
+
+/** Queue a load without touching the LRU clock (e.g. the next level). */
+void de100_asset_stream_prefetch(De100AssetStream *stream, GameMemory *memory,
+                                 u32 id);
+
+/** Wait for loads in flight, then drop every asset. */
+void de100_asset_stream_flush(De100AssetStream *stream, GameMemory *memory);
+
+/** 2×2 magenta/black checker; scale it to the asset's intended rect. */
+De100PakBitmap de100_asset_stream_placeholder(void);
+
+#endif // DE100_GAME_ASSET_STREAM_H
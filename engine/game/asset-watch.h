@@ -0,0 +1,32 @@
+#ifndef DE100_GAME_ASSET_WATCH_H
+#define DE100_GAME_ASSET_WATCH_H
+
+#include "../_common/base.h"
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ASSET WATCHER (platform service behind asset-reload.h)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// Counts settled changes of asset files, one file watch per distinct
+// path (file-watch.h). Handed to the game as GameMemory.asset_watcher in
+// DE100_INTERNAL builds; NULL otherwise. Use it through the reload slots
+// in asset-reload.h rather than directly.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+typedef struct De100AssetWatcher De100AssetWatcher;
+
+// Watch `path` (idempotent per path). Returns a watch id, 0 if the
+// watcher is full or the file's directory can't be watched.
+#define DE100_PLATFORM_ASSET_WATCH(name)                                       \
+  u32 name(De100AssetWatcher *watcher, const char *path)
+typedef DE100_PLATFORM_ASSET_WATCH(de100_platform_asset_watch_t);
+
+// Settled changes of the watched file since the watch started (0 for an
+// unknown id). Main thread only.
+#define DE100_PLATFORM_ASSET_WATCH_VERSION(name)                               \
+  u32 name(De100AssetWatcher *watcher, u32 watch)
+typedef DE100_PLATFORM_ASSET_WATCH_VERSION(
+    de100_platform_asset_watch_version_t);
+
+#endif // DE100_GAME_ASSET_WATCH_H
@@ -0,0 +1,89 @@
+#ifndef DE100_GAME_ASYNC_IO_H
+#define DE100_GAME_ASYNC_IO_H
+
+#include "../_common/base.h"
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ASYNC FILE I/O
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// Reads and writes that complete in the background while frames keep
+// running. The platform owns the I/O thread(s) (io_uring on Linux, a
+// small blocking thread pool elsewhere); the game sees an opaque handle
+// and two function pointers on GameMemory, like the work queue:
+//
+//   state->load = (De100AsyncIORequest){
+//       .op = DE100_ASYNC_IO_OP_READ,
+//       .path = "data/level2.bin",
+//       .buffer = level_memory,
+//       .size = level_size,
+//   };
+//   memory->async_io_submit(memory->async_io, &state->load);
+//   ...
+//   if (de100_async_io_is_done(&state->load)) {  // Any later frame
+//     if (state->load.status == DE100_ASYNC_IO_STATUS_COMPLETE) { ... }
+//   }
+//
+// Completion is a poll on the request itself, not a callback: requests
+// outlive frames, and a callback would point into a library that a hot
+// reload may have replaced.
+//
+// The request, `path` and `buffer` must stay valid and untouched until
+// the request is done. Keep them in game memory (they survive reloads),
+// but don't restore a replay snapshot over a pending request.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+typedef struct De100AsyncIO De100AsyncIO;
+
+typedef enum {
+  DE100_ASYNC_IO_OP_READ = 0, // size bytes at offset into buffer
+  DE100_ASYNC_IO_OP_WRITE,    // Create if missing, write at offset
+  DE100_ASYNC_IO_OP_SAVE,     // Whole file via "<path>.tmp" + rename:
+                              // a crash mid-save keeps the old file
+
+  DE100_ASYNC_IO_OP_COUNT
+} De100AsyncIOOp;
+
+typedef enum {
+  DE100_ASYNC_IO_STATUS_IDLE = 0, // Never submitted
+  DE100_ASYNC_IO_STATUS_PENDING,
+  DE100_ASYNC_IO_STATUS_COMPLETE,
+  DE100_ASYNC_IO_STATUS_FAILED,
+
+  DE100_ASYNC_IO_STATUS_COUNT
+} De100AsyncIOStatus;
+
+typedef struct {
+  // Filled by the game
+  De100AsyncIOOp op;
+  const char *path;
+  void *buffer;
+  u64 offset; // Ignored by SAVE
+  u64 size;
+
+  // Filled by the platform; read after de100_async_io_is_done()
+  u32 status;            // De100AsyncIOStatus (atomic)
+  u64 bytes_transferred; // Short on READ past end of file
+  i32 error_code;        // De100FileErrorCode when FAILED
+} De100AsyncIORequest;
+
+// Queues the request (status becomes PENDING). Returns false, status
+// FAILED, if the queue is full or the request is malformed.
+#define DE100_PLATFORM_ASYNC_IO_SUBMIT(name)                                   \
+  bool name(De100AsyncIO *io, De100AsyncIORequest *request)
+typedef DE100_PLATFORM_ASYNC_IO_SUBMIT(de100_platform_async_io_submit_t);
+
+// Blocks until the request is done (e.g. a save on quit).
+#define DE100_PLATFORM_ASYNC_IO_WAIT(name)                                     \
+  void name(De100AsyncIO *io, De100AsyncIORequest *request)
+typedef DE100_PLATFORM_ASYNC_IO_WAIT(de100_platform_async_io_wait_t);
+
+de100_file_scoped_fn inline bool
+de100_async_io_is_done(const De100AsyncIORequest *request) {
+  u32 status = __atomic_load_n(&request->status, __ATOMIC_ACQUIRE);
+  return status == DE100_ASYNC_IO_STATUS_COMPLETE ||
+         status == DE100_ASYNC_IO_STATUS_FAILED;
+}
+
+#endif // DE100_GAME_ASYNC_IO_H
@@ -0,0 +1,573 @@
+#include "audio-assets.h"
+#include "../_common/file.h"
+#include "../_common/memory.h"
+#include "../_common/time.h"
+#include "../platforms/_common/audio-ring.h"
+#include "audio-helpers.h"
+#include "audio-resampler.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ERROR MESSAGES
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_global_var const char *g_audio_asset_error_messages[] = {
+    [DE100_AUDIO_ASSET_SUCCESS] = "Success",
+    [DE100_AUDIO_ASSET_ERROR_NULL_ARGUMENT] = "NULL path, arena or output",
+    [DE100_AUDIO_ASSET_ERROR_OPEN_FAILED] = "Failed to open audio file",
+    [DE100_AUDIO_ASSET_ERROR_READ_FAILED] = "Failed to read audio file",
+    [DE100_AUDIO_ASSET_ERROR_NOT_WAV] = "Not a RIFF/WAVE file",
+    [DE100_AUDIO_ASSET_ERROR_UNSUPPORTED_FORMAT] =
+        "Unsupported WAV encoding (PCM 8/16/24/32 or float 32 only)",
+    [DE100_AUDIO_ASSET_ERROR_NO_DATA] = "WAV file has no sample data",
+    [DE100_AUDIO_ASSET_ERROR_OUT_OF_MEMORY] = "Not enough memory for audio",
+    [DE100_AUDIO_ASSET_ERROR_THREAD_CREATE_FAILED] =
+        "Failed to start stream reader thread",
+};
+
+const char *de100_audio_asset_strerror(De100AudioAssetErrorCode code) {
+  if (code >= 0 && code < DE100_AUDIO_ASSET_ERROR_COUNT) {
+    return g_audio_asset_error_messages[code];
+  }
+  return "Unknown audio asset error";
+}
+
+de100_file_scoped_fn inline De100AudioAssetResult
+audio_asset_result(De100AudioAssetErrorCode code) {
+  return (De100AudioAssetResult){
+      .success = code == DE100_AUDIO_ASSET_SUCCESS,
+      .error_code = code,
+  };
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// WAV PARSING
+// ═══════════════════════════════════════════════════════════════════════════
+//
+//   "RIFF" size "WAVE"  { chunk_id chunk_size payload [pad] }*
+//
+// Only "fmt " and "data" matter; everything else (LIST, fact, cue ...) is
+// skipped. Multi-byte fields are little-endian.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define WAV_FORMAT_PCM 0x0001
+#define WAV_FORMAT_IEEE_FLOAT 0x0003
+#define WAV_FORMAT_EXTENSIBLE 0xFFFE
+
+#define WAV_CHUNK_FRAMES 2048 // Frames decoded per read
+
+typedef struct {
+  u16 format;
+  u16 channels;
+  u16 bits_per_sample;
+  u16 block_align; // Bytes per frame
+  i32 samples_per_second;
+  i64 data_offset;
+  u64 data_bytes;
+} WavInfo;
+
+de100_file_scoped_fn inline u16 wav_u16(const u8 *p) {
+  return (u16)(p[0] | (p[1] << 8));
+}
+
+de100_file_scoped_fn inline u32 wav_u32(const u8 *p) {
+  return (u32)p[0] | ((u32)p[1] << 8) | ((u32)p[2] << 16) | ((u32)p[3] << 24);
+}
+
+de100_file_scoped_fn bool wav_read(i32 fd, void *buffer, size_t size) {
+  return de100_file_read_all(fd, buffer, size).success;
+}
+
+de100_file_scoped_fn De100AudioAssetErrorCode wav_parse(i32 fd,
+                                                        WavInfo *info) {
+  memset(info, 0, sizeof(*info));
+
+  u8 header[12];
+  if (!wav_read(fd, header, sizeof(header))) {
+    return DE100_AUDIO_ASSET_ERROR_NOT_WAV;
+  }
+  if (memcmp(header, "RIFF", 4) != 0 || memcmp(header + 8, "WAVE", 4) != 0) {
+    return DE100_AUDIO_ASSET_ERROR_NOT_WAV;
+  }
+
+  bool have_format = false;
+  u8 chunk[8];
+  while (wav_read(fd, chunk, sizeof(chunk))) {
+    u32 size = wav_u32(chunk + 4);
+    u32 padded = size + (size & 1);
+
+    if (memcmp(chunk, "fmt ", 4) == 0 && size >= 16) {
+      u8 fmt[40] = {0};
+      u32 keep = size < sizeof(fmt) ? size : (u32)sizeof(fmt);
+      if (!wav_read(fd, fmt, keep)) {
+        return DE100_AUDIO_ASSET_ERROR_READ_FAILED;
+      }
+      if (padded > keep &&
+          !de100_file_seek(fd, padded - keep, DE100_SEEK_CUR).success) {
+        return DE100_AUDIO_ASSET_ERROR_READ_FAILED;
+      }
+      info->format = wav_u16(fmt + 0);
+      info->channels = wav_u16(fmt + 2);
+      info->samples_per_second = (i32)wav_u32(fmt + 4);
+      info->block_align = wav_u16(fmt + 12);
+      info->bits_per_sample = wav_u16(fmt + 14);
+      if (info->format == WAV_FORMAT_EXTENSIBLE && size >= 26) {
+        info->format = wav_u16(fmt + 24); // SubFormat GUID's first field
+      }
+      have_format = true;
+      continue;
+    }
+
+    if (memcmp(chunk, "data", 4) == 0) {
+      De100FileSizeResult here = de100_file_seek(fd, 0, DE100_SEEK_CUR);
+      if (!here.success) {
+        return DE100_AUDIO_ASSET_ERROR_READ_FAILED;
+      }
+      info->data_offset = here.value;
+      info->data_bytes = size;
+      break;
+    }
+
+    if (!de100_file_seek(fd, padded, DE100_SEEK_CUR).success) {
+      return DE100_AUDIO_ASSET_ERROR_READ_FAILED;
+    }
+  }
+
+  if (!have_format) {
+    return DE100_AUDIO_ASSET_ERROR_NOT_WAV;
+  }
+
+  u16 bits = info->bits_per_sample;
+  bool pcm = info->format == WAV_FORMAT_PCM &&
+             (bits == 8 || bits == 16 || bits == 24 || bits == 32);
+  bool is_float = info->format == WAV_FORMAT_IEEE_FLOAT && bits == 32;
+  if ((!pcm && !is_float) || info->channels == 0 ||
+      info->samples_per_second <= 0 ||
+      info->block_align != info->channels * (bits / 8)) {
+    return DE100_AUDIO_ASSET_ERROR_UNSUPPORTED_FORMAT;
+  }
+  if (info->data_bytes < info->block_align) {
+    return DE100_AUDIO_ASSET_ERROR_NO_DATA;
+  }
+  return DE100_AUDIO_ASSET_SUCCESS;
+}
+
+de100_file_scoped_fn inline i16 wav_sample_to_i16(const WavInfo *info,
+                                                  const u8 *p) {
+  switch (info->bits_per_sample) {
+  case 8:
+    return (i16)(((i32)p[0] - 128) << 8); // 8-bit WAV is unsigned
+  case 16:
+    return (i16)wav_u16(p);
+  case 24:
+    return (i16)wav_u16(p + 1); // Top 16 bits
+  default:
+    if (info->format == WAV_FORMAT_IEEE_FLOAT) {
+      f32 value;
+      memcpy(&value, p, sizeof(value));
+      return de100_audio_clamp_sample(value * 32767.0f);
+    }
+    return (i16)wav_u16(p + 2);
+  }
+}
+
+// Raw frames -> interleaved stereo (mono duplicated, extra channels dropped)
+de100_file_scoped_fn void wav_decode(const WavInfo *info, const u8 *raw,
+                                     u32 frames, i16 *out) {
+  u32 bytes = info->bits_per_sample / 8;
+  u32 right = info->channels > 1 ? bytes : 0;
+  for (u32 i = 0; i < frames; ++i) {
+    const u8 *frame = raw + (size_t)i * info->block_align;
+    out[i * 2 + 0] = wav_sample_to_i16(info, frame);
+    out[i * 2 + 1] = wav_sample_to_i16(info, frame + right);
+  }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// SAMPLES
+// ═══════════════════════════════════════════════════════════════════════════
+
+De100AudioAssetResult de100_audio_load_wav(De100MemoryArena *arena,
+                                           const char *path,
+                                           i32 samples_per_second,
+                                           De100AudioSample *out_sample) {
+  if (!arena || !path || !out_sample || samples_per_second <= 0) {
+    return audio_asset_result(DE100_AUDIO_ASSET_ERROR_NULL_ARGUMENT);
+  }
+
+  De100FileOpenResult file = de100_file_open(path, DE100_FILE_READ);
+  if (!file.success) {
+    return audio_asset_result(DE100_AUDIO_ASSET_ERROR_OPEN_FAILED);
+  }
+
+  WavInfo info;
+  De100AudioAssetErrorCode code = wav_parse(file.fd, &info);
+  if (code != DE100_AUDIO_ASSET_SUCCESS) {
+    de100_file_close(file.fd);
+    return audio_asset_result(code);
+  }
+
+  De100Resampler resampler;
+  de100_resampler_init(&resampler, info.samples_per_second, samples_per_second);
+
+  u64 input_frames = info.data_bytes / info.block_align;
+  u32 capacity = de100_resampler_capacity(&resampler, (u32)input_frames);
+
+  // Decode straight out of the page cache when the file maps; only the
+  // read() fallback needs a raw chunk buffer
+  De100FileMapping mapping =
+      de100_file_map_readonly(path, DE100_FILE_MAP_ADVICE_SEQUENTIAL);
+  const u8 *mapped_data = NULL;
+  if (mapping.success && mapping.data &&
+      (u64)info.data_offset + info.data_bytes <= mapping.size) {
+    mapped_data = (const u8 *)mapping.data + info.data_offset;
+    de100_file_close(file.fd);
+    file.fd = -1;
+  } else {
+    de100_file_unmap(&mapping);
+  }
+
+  // Scratch for one chunk, outside the arena
+  size_t raw_size =
+      mapped_data ? 0 : (size_t)WAV_CHUNK_FRAMES * info.block_align;
+  size_t decoded_size = (size_t)WAV_CHUNK_FRAMES * 2 * sizeof(i16);
+  De100MemoryBlock scratch = de100_memory_alloc(
+      NULL, raw_size + decoded_size,
+      De100_MEMORY_FLAG_READ | De100_MEMORY_FLAG_WRITE);
+
+  u64 arena_used = arena->used;
+  i16 *frames = de100_memory_is_valid(scratch)
+                    ? de100_arena_push_array(arena, (u64)capacity * 2, i16)
+                    : NULL;
+  if (!frames) {
+    de100_memory_free(&scratch);
+    de100_file_unmap(&mapping);
+    if (file.fd >= 0) {
+      de100_file_close(file.fd);
+    }
+    return audio_asset_result(DE100_AUDIO_ASSET_ERROR_OUT_OF_MEMORY);
+  }
+
+  u8 *raw = (u8 *)scratch.base;
+  i16 *decoded = (i16 *)(raw + raw_size);
+  u32 written = 0;
+  u64 remaining = input_frames;
+
+  while (remaining > 0) {
+    u32 chunk = remaining < WAV_CHUNK_FRAMES ? (u32)remaining
+                                             : WAV_CHUNK_FRAMES;
+    const u8 *source = raw;
+    if (mapped_data) {
+      source = mapped_data + (input_frames - remaining) * info.block_align;
+    } else if (!wav_read(file.fd, raw, (size_t)chunk * info.block_align)) {
+      code = DE100_AUDIO_ASSET_ERROR_READ_FAILED;
+      break;
+    }
+    wav_decode(&info, source, chunk, decoded);
+    written += de100_resample(&resampler, decoded, chunk,
+                            frames + (size_t)written * 2, capacity - written);
+    remaining -= chunk;
+  }
+  if (code == DE100_AUDIO_ASSET_SUCCESS) {
+    written += de100_resample_flush(&resampler, frames + (size_t)written * 2,
+                                    capacity - written);
+  }
+
+  de100_memory_free(&scratch);
+  de100_file_unmap(&mapping);
+  if (file.fd >= 0) {
+    de100_file_close(file.fd);
+  }
+
+  if (code != DE100_AUDIO_ASSET_SUCCESS) {
+    de100_arena_pop_to(arena, arena_used);
+    return audio_asset_result(code);
+  }
+
+  // Give back the worst-case slack (the push is the arena's latest)
+  arena->used -= (u64)(capacity - written) * 2 * sizeof(i16);
+
+  out_sample->frames = frames;
+  out_sample->frame_count = written;
+  out_sample->samples_per_second = samples_per_second;
+  return audio_asset_result(DE100_AUDIO_ASSET_SUCCESS);
+}
+
+de100_file_scoped_fn inline void audio_add_saturate(i16 *dst, f32 value) {
+  *dst = de100_audio_clamp_sample((f32)*dst + value);
+}
+
+void de100_audio_voice_play(De100AudioVoice *voice,
+                            const De100AudioSample *sample, f32 volume,
+                            f32 pan_position, bool loop) {
+  voice->sample = sample;
+  voice->position = 0;
+  voice->volume = volume;
+  voice->pan_position = pan_position;
+  voice->loop = loop;
+  voice->is_playing = sample && sample->frame_count > 0;
+}
+
+void de100_audio_voice_mix(De100AudioVoice *voice,
+                           GameAudioOutputBuffer *buffer) {
+  if (!voice->is_playing || !buffer->samples) {
+    return;
+  }
+
+  const De100AudioSample *sample = voice->sample;
+  f32 left_vol, right_vol;
+  de100_audio_calculate_pan(voice->pan_position, &left_vol, &right_vol);
+  left_vol *= voice->volume;
+  right_vol *= voice->volume;
+
+  i16 *out = (i16 *)buffer->samples;
+  for (i32 i = 0; i < buffer->sample_count; ++i) {
+    if (voice->position >= sample->frame_count) {
+      if (!voice->loop) {
+        voice->is_playing = false;
+        return;
+      }
+      voice->position = 0;
+    }
+    const i16 *frame = sample->frames + (size_t)voice->position * 2;
+    audio_add_saturate(&out[i * 2 + 0], (f32)frame[0] * left_vol);
+    audio_add_saturate(&out[i * 2 + 1], (f32)frame[1] * right_vol);
+    voice->position++;
+  }
+}
+
+void de100_audio_output_clear(GameAudioOutputBuffer *buffer) {
+  if (buffer->samples && buffer->sample_count > 0) {
+    memset(buffer->samples, 0,
+           (size_t)buffer->sample_count * 2 * sizeof(i16));
+  }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// STREAMS
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// One allocation: [De100AudioStream | ring | raw chunk | decoded | resampled]
+//
+// The reader thread is the ring's only producer, de100_audio_stream_mix()
+// its only consumer. The thread sleeps while the ring can't take a full
+// resampled chunk, so it reads ahead at most ~1s of audio.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define AUDIO_STREAM_IDLE_MS 5
+
+struct De100AudioStream {
+  De100MemoryBlock memory; // Owns this struct and its buffers
+
+  WavInfo info;
+  i32 fd;
+  bool loop;
+  u64 data_remaining; // Bytes (reader thread)
+  De100Resampler resampler;
+
+  De100AudioRing ring;
+  u8 *raw;
+  i16 *decoded;
+  i16 *resampled;
+  u32 resampled_capacity;
+
+  pthread_t thread;
+  bool32 running;     // __atomic
+  bool32 source_done; // __atomic: EOF (non-looping) or read error
+  u32 underrun_count;
+};
+
+de100_file_scoped_fn void *audio_stream_thread_proc(void *param) {
+  De100AudioStream *stream = (De100AudioStream *)param;
+  u32 align = stream->info.block_align;
+
+  while (__atomic_load_n(&stream->running, __ATOMIC_ACQUIRE)) {
+    u32 space =
+        stream->ring.capacity_frames - de100_audio_ring_fill(&stream->ring);
+    if (space < stream->resampled_capacity) {
+      de100_sleep_ms(AUDIO_STREAM_IDLE_MS);
+      continue;
+    }
+
+    if (stream->data_remaining < align) {
+      if (!stream->loop) {
+        // Drain the resampler's window (space was checked above)
+        u32 out = de100_resample_flush(&stream->resampler, stream->resampled,
+                                       stream->resampled_capacity);
+        de100_audio_ring_write(&stream->ring, stream->resampled, out);
+        break;
+      }
+      if (!de100_file_seek(stream->fd, stream->info.data_offset,
+                           DE100_SEEK_SET)
+               .success) {
+        break;
+      }
+      stream->data_remaining = stream->info.data_bytes;
+    }
+
+    u64 chunk_bytes = (u64)WAV_CHUNK_FRAMES * align;
+    if (chunk_bytes > stream->data_remaining) {
+      chunk_bytes = stream->data_remaining - stream->data_remaining % align;
+    }
+    if (!wav_read(stream->fd, stream->raw, (size_t)chunk_bytes)) {
+      fprintf(stderr, "⚠️  Audio stream: read failed, stopping\n");
+      break;
+    }
+    stream->data_remaining -= chunk_bytes;
+
+    u32 frames = (u32)(chunk_bytes / align);
+    wav_decode(&stream->info, stream->raw, frames, stream->decoded);
+    u32 out = de100_resample(&stream->resampler, stream->decoded, frames,
+                             stream->resampled, stream->resampled_capacity);
+    de100_audio_ring_write(&stream->ring, stream->resampled, out);
+  }
+
+  __atomic_store_n(&stream->source_done, true, __ATOMIC_RELEASE);
+  return NULL;
+}
+
+De100AudioStream *de100_audio_stream_open(const char *path,
+                                          i32 samples_per_second, bool loop,
+                                          De100AudioAssetResult *result) {
+  De100AudioAssetResult ignored;
+  if (!result) {
+    result = &ignored;
+  }
+  if (!path || samples_per_second <= 0) {
+    *result = audio_asset_result(DE100_AUDIO_ASSET_ERROR_NULL_ARGUMENT);
+    return NULL;
+  }
+
+  De100FileOpenResult file = de100_file_open(path, DE100_FILE_READ);
+  if (!file.success) {
+    *result = audio_asset_result(DE100_AUDIO_ASSET_ERROR_OPEN_FAILED);
+    return NULL;
+  }
+
+  WavInfo info;
+  De100AudioAssetErrorCode code = wav_parse(file.fd, &info);
+  if (code != DE100_AUDIO_ASSET_SUCCESS) {
+    de100_file_close(file.fd);
+    *result = audio_asset_result(code);
+    return NULL;
+  }
+
+  De100Resampler resampler;
+  de100_resampler_init(&resampler, info.samples_per_second, samples_per_second);
+  u32 resampled_capacity =
+      de100_resampler_capacity(&resampler, WAV_CHUNK_FRAMES);
+
+  // ~1s of read-ahead, and always room for a few chunks
+  u32 ring_frames = 1;
+  while (ring_frames < (u32)samples_per_second ||
+         ring_frames < resampled_capacity * 4) {
+    ring_frames <<= 1;
+  }
+
+  size_t frame_bytes = 2 * sizeof(i16);
+  size_t header_size = (sizeof(De100AudioStream) + 15) & ~(size_t)15;
+  size_t ring_size = (size_t)ring_frames * frame_bytes;
+  size_t raw_size = (size_t)WAV_CHUNK_FRAMES * info.block_align;
+  size_t decoded_size = (size_t)WAV_CHUNK_FRAMES * frame_bytes;
+  size_t resampled_size = (size_t)resampled_capacity * frame_bytes;
+
+  De100MemoryBlock memory = de100_memory_alloc(
+      NULL, header_size + ring_size + raw_size + decoded_size + resampled_size,
+      De100_MEMORY_FLAG_READ | De100_MEMORY_FLAG_WRITE |
+          De100_MEMORY_FLAG_ZEROED);
+  if (!de100_memory_is_valid(memory)) {
+    de100_file_close(file.fd);
+    *result = audio_asset_result(DE100_AUDIO_ASSET_ERROR_OUT_OF_MEMORY);
+    return NULL;
+  }
+
+  u8 *cursor = (u8 *)memory.base;
+  De100AudioStream *stream = (De100AudioStream *)cursor;
+  cursor += header_size;
+  stream->memory = memory;
+  stream->info = info;
+  stream->fd = file.fd;
+  stream->loop = loop;
+  stream->data_remaining = info.data_bytes;
+  stream->resampler = resampler;
+  de100_audio_ring_init(&stream->ring, (i16 *)cursor, ring_frames);
+  cursor += ring_size;
+  stream->raw = cursor;
+  cursor += raw_size;
+  stream->decoded = (i16 *)cursor;
+  cursor += decoded_size;
+  stream->resampled = (i16 *)cursor;
+  stream->resampled_capacity = resampled_capacity;
+
+  stream->running = true;
+  if (pthread_create(&stream->thread, NULL, audio_stream_thread_proc,
+                     stream) != 0) {
+    de100_file_close(file.fd);
+    de100_memory_free(&memory);
+    *result = audio_asset_result(DE100_AUDIO_ASSET_ERROR_THREAD_CREATE_FAILED);
+    return NULL;
+  }
+
+  *result = audio_asset_result(DE100_AUDIO_ASSET_SUCCESS);
+  return stream;
+}
+
+u32 de100_audio_stream_mix(De100AudioStream *stream,
+                           GameAudioOutputBuffer *buffer, f32 volume) {
+  if (!stream || !buffer->samples || buffer->sample_count <= 0) {
+    return 0;
+  }
+
+  i16 chunk[256 * 2];
+  i16 *out = (i16 *)buffer->samples;
+  u32 wanted = (u32)buffer->sample_count;
+  u32 mixed = 0;
+
+  while (mixed < wanted) {
+    u32 count = wanted - mixed;
+    if (count > 256) {
+      count = 256;
+    }
+    u32 got = de100_audio_ring_read(&stream->ring, chunk, count);
+    for (u32 i = 0; i < got * 2; ++i) {
+      audio_add_saturate(&out[mixed * 2 + i], (f32)chunk[i] * volume);
+    }
+    mixed += got;
+    if (got < count) {
+      break;
+    }
+  }
+
+  if (mixed < wanted && !de100_audio_stream_is_finished(stream)) {
+    stream->underrun_count++;
+  }
+  return mixed;
+}
+
+bool de100_audio_stream_is_finished(De100AudioStream *stream) {
+  return !stream ||
+         (__atomic_load_n(&stream->source_done, __ATOMIC_ACQUIRE) &&
+          de100_audio_ring_fill(&stream->ring) == 0);
+}
+
+u32 de100_audio_stream_underruns(De100AudioStream *stream) {
+  return stream ? stream->underrun_count : 0;
+}
+
+void de100_audio_stream_close(De100AudioStream *stream) {
+  if (!stream) {
+    return;
+  }
+
+  __atomic_store_n(&stream->running, false, __ATOMIC_RELEASE);
+  pthread_join(stream->thread, NULL);
+  de100_file_close(stream->fd);
+
+  De100MemoryBlock memory = stream->memory;
+  de100_memory_free(&memory);
+}
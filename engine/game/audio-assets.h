@@ -0,0 +1,133 @@
+#ifndef DE100_GAME_AUDIO_ASSETS_H
+#define DE100_GAME_AUDIO_ASSETS_H
+
+#include "../_common/base.h"
+#include "audio.h"
+#include "memory-arena.h"
+#include <stdbool.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// 🎵 AUDIO ASSETS (PCM samples + streamed music)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// Asset-backed counterpart to the procedural SoundSource / De100Oscillator.
+// Everything is converted once to the output format (interleaved i16
+// stereo at the device rate), so mixing is a copy-and-add into the same
+// GameAudioOutputBuffer the game already fills.
+//
+// SAMPLES (short SFX): decoded completely at load into an arena, normally
+// the game's permanent storage (so they survive hot reloads and replays).
+//
+//   de100_audio_load_wav(&state->assets, "data/hit.wav", 48000, &state->hit);
+//   ...
+//   de100_audio_voice_play(&state->voice, &state->hit, 0.8f, 0.0f, false);
+//   de100_audio_voice_mix(&state->voice, buffer);  // in get_audio_samples
+//
+// STREAMS (music): never fully decoded. A background thread reads the file
+// in chunks, converts, and fills a ring (~1s); the game side only drains
+// it:
+//
+//   file ──read/convert/resample (thread)──▶ ring ──▶ de100_audio_stream_mix
+//
+// Stream state is engine heap (not game memory): restoring a replay
+// snapshot must not rewind a ring a live thread is filling. Keep the handle
+// in game state; re-open after a failed load.
+//
+// Supported: RIFF/WAVE, PCM 8/16/24/32-bit and IEEE float 32-bit, mono or
+// stereo (WAVE_FORMAT_EXTENSIBLE included). Other channel counts keep the
+// first two channels. Rate conversion is windowed sinc
+// (audio-resampler.h), done once at load / on the reader thread.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+typedef enum {
+  DE100_AUDIO_ASSET_SUCCESS = 0,
+  DE100_AUDIO_ASSET_ERROR_NULL_ARGUMENT,
+  DE100_AUDIO_ASSET_ERROR_OPEN_FAILED,
+  DE100_AUDIO_ASSET_ERROR_READ_FAILED,
+  DE100_AUDIO_ASSET_ERROR_NOT_WAV,
+  DE100_AUDIO_ASSET_ERROR_UNSUPPORTED_FORMAT,
+  DE100_AUDIO_ASSET_ERROR_NO_DATA,
+  DE100_AUDIO_ASSET_ERROR_OUT_OF_MEMORY,
+  DE100_AUDIO_ASSET_ERROR_THREAD_CREATE_FAILED,
+
+  DE100_AUDIO_ASSET_ERROR_COUNT
+} De100AudioAssetErrorCode;
+
+typedef struct {
+  bool success;
+  De100AudioAssetErrorCode error_code;
+} De100AudioAssetResult;
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Samples
+// ─────────────────────────────────────────────────────────────────────────────
+
+typedef struct {
+  i16 *frames;            // Interleaved stereo, frame_count * 2
+  u32 frame_count;
+  i32 samples_per_second; // Rate it was converted to
+} De100AudioSample;
+
+typedef struct {
+  const De100AudioSample *sample;
+  u32 position; // Next frame
+  f32 volume;
+  f32 pan_position; // -1.0 (left) to 1.0 (right)
+  bool32 loop;
+  bool32 is_playing;
+} De100AudioVoice;
+
+/**
+ * Decode a WAV file into `arena`, converted to stereo i16 at
+ * `samples_per_second`. Nothing is pushed on failure.
+ */
+De100AudioAssetResult de100_audio_load_wav(De100MemoryArena *arena,
+                                           const char *path,
+                                           i32 samples_per_second,
+                                           De100AudioSample *out_sample);
+
+void de100_audio_voice_play(De100AudioVoice *voice,
+                            const De100AudioSample *sample, f32 volume,
+                            f32 pan_position, bool loop);
+
+/**
+ * Add the voice's next buffer->sample_count frames into buffer->samples
+ * (saturating). Clear the buffer first if nothing else writes it.
+ */
+void de100_audio_voice_mix(De100AudioVoice *voice,
+                           GameAudioOutputBuffer *buffer);
+
+/** Zero buffer->sample_count frames (start of a mixed callback). */
+void de100_audio_output_clear(GameAudioOutputBuffer *buffer);
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Streams
+// ─────────────────────────────────────────────────────────────────────────────
+
+typedef struct De100AudioStream De100AudioStream;
+
+/** Open `path` and start its reader thread. NULL on failure. */
+De100AudioStream *de100_audio_stream_open(const char *path,
+                                          i32 samples_per_second, bool loop,
+                                          De100AudioAssetResult *result);
+
+/**
+ * Add up to buffer->sample_count streamed frames into buffer->samples.
+ * Returns frames mixed; fewer than asked (while not finished) is an
+ * underrun, counted in de100_audio_stream_underruns().
+ */
+u32 de100_audio_stream_mix(De100AudioStream *stream,
+                           GameAudioOutputBuffer *buffer, f32 volume);
+
+/** True once a non-looping stream has played everything. */
+bool de100_audio_stream_is_finished(De100AudioStream *stream);
+
+u32 de100_audio_stream_underruns(De100AudioStream *stream);
+
+/** Stop the reader thread, close the file and free the stream. */
+void de100_audio_stream_close(De100AudioStream *stream);
+
+const char *de100_audio_asset_strerror(De100AudioAssetErrorCode code);
+
+#endif // DE100_GAME_AUDIO_ASSETS_H
@@ -0,0 +1,321 @@
+#include "audio-bus.h"
+#include "audio-mix-kernels.h"
+
+#include <math.h>
+#include <string.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// REVERB
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// Freeverb tunings (samples at 44.1kHz, scaled to the output rate). The
+// right channel's lines are a little longer, which decorrelates the two
+// sides into a stereo tail from a mono send.
+//
+
+de100_file_scoped_global_var const i32 g_reverb_comb_lengths[] = {
+    1116, 1188, 1277, 1356};
+de100_file_scoped_global_var const i32 g_reverb_allpass_lengths[] = {556,
+                                                                     441};
+#define REVERB_STEREO_SPREAD 23
+#define REVERB_INPUT_GAIN 0.015f
+#define REVERB_ALLPASS_FEEDBACK 0.5f
+
+de100_file_scoped_fn inline bool
+reverb_line_init(De100AudioDelayLine *line, De100MemoryArena *arena,
+                 i32 tuning, i32 samples_per_second) {
+  line->length = (i32)((i64)tuning * samples_per_second / 44100);
+  if (line->length < 1) {
+    line->length = 1;
+  }
+  line->index = 0;
+  line->filter = 0.0f;
+  line->samples = de100_arena_push_array_zero(arena, line->length, f32);
+  return line->samples != NULL;
+}
+
+de100_file_scoped_fn inline f32 reverb_comb(De100AudioDelayLine *line,
+                                            f32 input, f32 feedback,
+                                            f32 damping) {
+  f32 output = line->samples[line->index];
+  line->filter = output * (1.0f - damping) + line->filter * damping;
+  line->samples[line->index] = input + line->filter * feedback;
+  if (++line->index >= line->length) {
+    line->index = 0;
+  }
+  return output;
+}
+
+de100_file_scoped_fn inline f32 reverb_allpass(De100AudioDelayLine *line,
+                                               f32 input) {
+  f32 delayed = line->samples[line->index];
+  line->samples[line->index] = input + delayed * REVERB_ALLPASS_FEEDBACK;
+  if (++line->index >= line->length) {
+    line->index = 0;
+  }
+  return delayed - input;
+}
+
+de100_file_scoped_fn bool reverb_init(De100AudioReverb *reverb,
+                                      De100MemoryArena *arena,
+                                      i32 samples_per_second) {
+  reverb->is_ready = false;
+  reverb->tail_frames = 0;
+  for (i32 channel = 0; channel < 2; ++channel) {
+    i32 spread = channel * REVERB_STEREO_SPREAD;
+    for (i32 i = 0; i < DE100_AUDIO_REVERB_COMBS; ++i) {
+      if (!reverb_line_init(&reverb->combs[channel][i], arena,
+                            g_reverb_comb_lengths[i] + spread,
+                            samples_per_second)) {
+        return false;
+      }
+    }
+    for (i32 i = 0; i < DE100_AUDIO_REVERB_ALLPASSES; ++i) {
+      if (!reverb_line_init(&reverb->allpasses[channel][i], arena,
+                            g_reverb_allpass_lengths[i] + spread,
+                            samples_per_second)) {
+        return false;
+      }
+    }
+  }
+  reverb->is_ready = true;
+  return true;
+}
+
+// Add the wet signal for `send` (mono) into the master
+de100_file_scoped_fn void reverb_process(De100AudioReverb *reverb,
+                                         const f32 *send, bool has_input,
+                                         f32 *master_left, f32 *master_right,
+                                         i32 count, i32 samples_per_second) {
+  if (!reverb->is_ready || reverb->return_gain <= 0.0f) {
+    return;
+  }
+  if (has_input) {
+    // Long enough for the combs to decay well below audibility
+    reverb->tail_frames = samples_per_second * 4;
+  } else if (reverb->tail_frames <= 0) {
+    return; // Idle: lines hold only silence-level residue
+  }
+  reverb->tail_frames -= count;
+
+  // Freeverb's mapping: room 0..1 onto feedback 0.7..0.98
+  f32 feedback = 0.7f + reverb->room_size * 0.28f;
+  f32 damping = reverb->damping * 0.4f;
+  f32 wet = reverb->return_gain;
+
+  for (i32 i = 0; i < count; ++i) {
+    f32 input = send[i] * REVERB_INPUT_GAIN;
+    f32 out[2];
+    for (i32 channel = 0; channel < 2; ++channel) {
+      f32 sum = 0.0f;
+      for (i32 c = 0; c < DE100_AUDIO_REVERB_COMBS; ++c) {
+        sum += reverb_comb(&reverb->combs[channel][c], input, feedback,
+                           damping);
+      }
+      for (i32 a = 0; a < DE100_AUDIO_REVERB_ALLPASSES; ++a) {
+        sum = reverb_allpass(&reverb->allpasses[channel][a], sum);
+      }
+      out[channel] = sum;
+    }
+    master_left[i] += out[0] * wet;
+    master_right[i] += out[1] * wet;
+  }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// BUS EFFECTS
+// ═══════════════════════════════════════════════════════════════════════════
+
+// One-pole low-pass: y += a * (x - y), a = 1 - e^(-2π fc / fs)
+de100_file_scoped_fn void bus_lowpass(De100AudioBus *bus, i32 count,
+                                      i32 samples_per_second) {
+  if (bus->lowpass_hz <= 0.0f) {
+    return;
+  }
+  if (bus->lowpass_coef_hz != bus->lowpass_hz) {
+    bus->lowpass_coef =
+        1.0f - expf(-2.0f * (f32)M_PI * bus->lowpass_hz /
+                    (f32)samples_per_second);
+    bus->lowpass_coef_hz = bus->lowpass_hz;
+  }
+
+  f32 a = bus->lowpass_coef;
+  f32 left = bus->lowpass_left;
+  f32 right = bus->lowpass_right;
+  for (i32 i = 0; i < count; ++i) {
+    left += a * (bus->left[i] - left);
+    right += a * (bus->right[i] - right);
+    bus->left[i] = left;
+    bus->right[i] = right;
+  }
+  bus->lowpass_left = left;
+  bus->lowpass_right = right;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// MASTER COMPRESSOR
+// ═══════════════════════════════════════════════════════════════════════════
+
+void de100_audio_compressor_set_lookahead(De100AudioCompressor *compressor,
+                                          f32 milliseconds,
+                                          i32 samples_per_second) {
+  i32 frames = (i32)(milliseconds * (f32)samples_per_second / 1000.0f);
+  if (frames < 1) {
+    frames = 1;
+  }
+  if (frames > DE100_AUDIO_MAX_LOOKAHEAD_FRAMES) {
+    frames = DE100_AUDIO_MAX_LOOKAHEAD_FRAMES;
+  }
+  compressor->lookahead_frames = frames;
+  compressor->delay_index = 0;
+  memset(compressor->delay_left, 0, sizeof(compressor->delay_left));
+  memset(compressor->delay_right, 0, sizeof(compressor->delay_right));
+}
+
+de100_file_scoped_fn void compressor_process(De100AudioCompressor *compressor,
+                                             f32 *left, f32 *right,
+                                             i32 count,
+                                             i32 samples_per_second) {
+  i32 lookahead = compressor->lookahead_frames;
+  // Attack reaches ~95% (three time constants) within the look-ahead
+  f32 attack_coef = 1.0f - expf(-3.0f / (f32)lookahead);
+  f32 release_frames = compressor->release_ms * (f32)samples_per_second /
+                       1000.0f;
+  f32 release_coef =
+      release_frames > 1.0f ? 1.0f - expf(-1.0f / release_frames) : 1.0f;
+  f32 threshold = compressor->threshold;
+  // Output level above threshold is (level / threshold)^(1/ratio)
+  f32 slope = compressor->ratio >= 1.0f ? 1.0f - 1.0f / compressor->ratio
+                                        : 1.0f;
+
+  f32 envelope = compressor->envelope;
+  f32 min_gain = 1.0f;
+  i32 index = compressor->delay_index;
+
+  for (i32 i = 0; i < count; ++i) {
+    f32 level = fabsf(left[i]);
+    f32 level_right = fabsf(right[i]);
+    if (level_right > level) {
+      level = level_right;
+    }
+    envelope += (level > envelope ? attack_coef : release_coef) *
+                (level - envelope);
+
+    f32 gain = 1.0f;
+    if (envelope > threshold) {
+      f32 over = threshold / envelope;
+      gain = slope >= 1.0f ? over : powf(over, slope);
+    }
+    if (gain < min_gain) {
+      min_gain = gain;
+    }
+
+    f32 delayed_left = compressor->delay_left[index];
+    f32 delayed_right = compressor->delay_right[index];
+    compressor->delay_left[index] = left[i];
+    compressor->delay_right[index] = right[i];
+    if (++index >= lookahead) {
+      index = 0;
+    }
+    left[i] = delayed_left * gain;
+    right[i] = delayed_right * gain;
+  }
+
+  compressor->envelope = envelope;
+  compressor->delay_index = index;
+  compressor->min_gain = min_gain;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// MIXER
+// ═══════════════════════════════════════════════════════════════════════════
+
+bool de100_audio_mixer_init(De100AudioMixer *mixer, De100MemoryArena *arena,
+                            i32 samples_per_second) {
+  memset(mixer, 0, sizeof(*mixer));
+  mixer->samples_per_second = samples_per_second;
+  mixer->master_volume = 1.0f;
+
+  for (i32 i = 0; i < DE100_AUDIO_BUS_COUNT; ++i) {
+    mixer->buses[i].volume = 1.0f;
+  }
+
+  mixer->reverb.room_size = 0.5f;
+  mixer->reverb.damping = 0.5f;
+  mixer->reverb.return_gain = 1.0f;
+
+  De100AudioCompressor *compressor = &mixer->compressor;
+  compressor->threshold = DE100_AUDIO_FULL_SCALE * 0.89f; // ~-1 dBFS
+  compressor->ratio = 0.0f;                               // Limit
+  compressor->release_ms = 150.0f;
+  de100_audio_compressor_set_lookahead(compressor, 5.0f, samples_per_second);
+
+  return reverb_init(&mixer->reverb, arena, samples_per_second);
+}
+
+i32 de100_audio_mixer_begin_block(De100AudioMixer *mixer,
+                                  GameAudioOutputBuffer *buffer, i32 start) {
+  i32 count = buffer->sample_count - start;
+  if (count > DE100_AUDIO_MIX_BLOCK_FRAMES) {
+    count = DE100_AUDIO_MIX_BLOCK_FRAMES;
+  }
+  if (count <= 0) {
+    return 0;
+  }
+  for (i32 i = 0; i < DE100_AUDIO_BUS_COUNT; ++i) {
+    memset(mixer->buses[i].left, 0, sizeof(f32) * (size_t)count);
+    memset(mixer->buses[i].right, 0, sizeof(f32) * (size_t)count);
+  }
+  return count;
+}
+
+void de100_audio_mixer_end_block(De100AudioMixer *mixer,
+                                 GameAudioOutputBuffer *buffer, i32 start,
+                                 i32 count) {
+  if (count <= 0 || !buffer->samples) {
+    return;
+  }
+  i32 rate = mixer->samples_per_second;
+  f32 *master_left = mixer->master_left;
+  f32 *master_right = mixer->master_right;
+  memset(master_left, 0, sizeof(f32) * (size_t)count);
+  memset(master_right, 0, sizeof(f32) * (size_t)count);
+  memset(mixer->send, 0, sizeof(f32) * (size_t)count);
+
+  // ─── Buses: low-pass, fader, dry to master, send to reverb ───
+  bool has_send = false;
+  for (i32 b = 0; b < DE100_AUDIO_BUS_COUNT; ++b) {
+    De100AudioBus *bus = &mixer->buses[b];
+    bus_lowpass(bus, count, rate);
+
+    f32 volume = bus->volume;
+    f32 send = bus->reverb_send * volume * 0.5f; // L+R to mono
+    for (i32 i = 0; i < count; ++i) {
+      master_left[i] += bus->left[i] * volume;
+      master_right[i] += bus->right[i] * volume;
+    }
+    if (send > 0.0f) {
+      has_send = true;
+      for (i32 i = 0; i < count; ++i) {
+        mixer->send[i] += (bus->left[i] + bus->right[i]) * send;
+      }
+    }
+  }
+
+  // ─── Reverb return ───
+  reverb_process(&mixer->reverb, mixer->send, has_send, master_left,
+                 master_right, count, rate);
+
+  // ─── Master: volume, dynamics, conversion ───
+  f32 master_volume = mixer->master_volume;
+  for (i32 i = 0; i < count; ++i) {
+    master_left[i] *= master_volume;
+    master_right[i] *= master_volume;
+  }
+  compressor_process(&mixer->compressor, master_left, master_right, count,
+                     rate);
+
+  De100AudioMixKernels *kernels = de100_audio_mix_kernels_get();
+  kernels->to_i16(master_left, master_right, count, 16000.0f,
+                  (i16 *)buffer->samples + start * 2);
+}
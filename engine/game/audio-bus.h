@@ -0,0 +1,181 @@
+#ifndef DE100_GAME_AUDIO_BUS_H
+#define DE100_GAME_AUDIO_BUS_H
+
+#include "../_common/base.h"
+#include "audio-helpers.h"
+#include "audio.h"
+#include "memory-arena.h"
+#include <stdbool.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// 🎚️ AUDIO BUSES (submixes, send effects, master dynamics)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// Headroom in DSP instead of in every volume knob. Sources mix into a
+// submix bus; each bus has an optional low-pass, a fader and a reverb
+// send; the master runs a look-ahead compressor before the final i16
+// conversion, so stacked explosions duck instead of hard-clipping:
+//
+//   player/voices ─▶ SFX   ─lowpass─fader─┬─────────────────────▶ master
+//                    MUSIC ─lowpass─fader─┤                        ▲
+//                    UI    ─lowpass─fader─┴─send─▶ reverb ─return──┘
+//
+//   master ─×master_volume─compressor (look-ahead)─to_i16─▶ out LRLR...
+//
+// Everything is planar f32 processed a block (DE100_AUDIO_MIX_BLOCK_FRAMES)
+// at a time, in mix units: 1.0 = one full-volume voice, converted at
+// ×16000 like de100_sound_player_mix(). DE100_AUDIO_FULL_SCALE is the
+// largest value that survives the conversion.
+//
+// Usage (in get_audio_samples):
+//   // once, e.g. when the game state is first set up
+//   de100_audio_mixer_init(&state->mixer, &arena,
+//                          buffer->samples_per_second);
+//   state->mixer.buses[DE100_AUDIO_BUS_SFX].reverb_send = 0.2f;
+//
+//   // per call
+//   for (i32 start = 0; start < buffer->sample_count;) {
+//     i32 count = de100_audio_mixer_begin_block(&state->mixer, buffer,
+//                                               start);
+//     De100AudioBus *sfx = &state->mixer.buses[DE100_AUDIO_BUS_SFX];
+//     de100_sound_player_mix_block(&state->sfx, sfx->left, sfx->right,
+//                                  count, buffer->samples_per_second,
+//                                  state->sfx.volume);
+//     de100_audio_mixer_end_block(&state->mixer, buffer, start, count);
+//     start += count;
+//   }
+//
+// Mixer state belongs in game memory (it's plain data plus arena-backed
+// reverb lines), so it reloads and replays with the rest of the game.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define DE100_AUDIO_FULL_SCALE (32767.0f / 16000.0f)
+
+// Longest compressor look-ahead, in frames (~10ms at 48kHz)
+#ifndef DE100_AUDIO_MAX_LOOKAHEAD_FRAMES
+#define DE100_AUDIO_MAX_LOOKAHEAD_FRAMES 512
+#endif
+
+#define DE100_AUDIO_REVERB_COMBS 4
+#define DE100_AUDIO_REVERB_ALLPASSES 2
+
+typedef enum {
+  DE100_AUDIO_BUS_SFX = 0,
+  DE100_AUDIO_BUS_MUSIC,
+  DE100_AUDIO_BUS_UI,
+
+  DE100_AUDIO_BUS_COUNT
+} De100AudioBusId;
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Bus
+// ─────────────────────────────────────────────────────────────────────────────
+
+typedef struct {
+  // Block input: mix sources in between begin_block and end_block
+  f32 left[DE100_AUDIO_MIX_BLOCK_FRAMES];
+  f32 right[DE100_AUDIO_MIX_BLOCK_FRAMES];
+
+  f32 volume;      // Fader (post low-pass, pre send)
+  f32 reverb_send; // 0.0 = dry only
+  f32 lowpass_hz;  // 0 = bypass
+
+  // One-pole low-pass state
+  f32 lowpass_coef;
+  f32 lowpass_coef_hz; // Cutoff lowpass_coef was computed for
+  f32 lowpass_left;
+  f32 lowpass_right;
+} De100AudioBus;
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Reverb (Schroeder/Freeverb: parallel damped combs, series all-passes)
+// ─────────────────────────────────────────────────────────────────────────────
+
+typedef struct {
+  f32 *samples; // Arena-backed
+  i32 length;
+  i32 index;
+  f32 filter; // Comb damping state
+} De100AudioDelayLine;
+
+typedef struct {
+  De100AudioDelayLine combs[2][DE100_AUDIO_REVERB_COMBS]; // [channel]
+  De100AudioDelayLine allpasses[2][DE100_AUDIO_REVERB_ALLPASSES];
+
+  f32 room_size;   // Comb feedback, 0.0..1.0 (longer tail)
+  f32 damping;     // High-frequency loss per pass, 0.0..1.0
+  f32 return_gain; // Wet level into the master
+
+  i32 tail_frames; // Frames left before an idle reverb is silent
+  bool is_ready;   // Lines allocated
+} De100AudioReverb;
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Master compressor / limiter
+// ─────────────────────────────────────────────────────────────────────────────
+// Peak detector on the incoming signal, gain applied to a delayed copy, so
+// reduction is already in place when the peak comes out. ratio 0 is a
+// limiter (nothing passes threshold except attack overshoot, which the
+// final conversion still clamps).
+
+typedef struct {
+  f32 threshold;  // Mix units (DE100_AUDIO_FULL_SCALE = 0 dBFS)
+  f32 ratio;      // >= 1.0; 0 = limit (infinite ratio)
+  f32 release_ms; // Recovery time after a peak
+
+  i32 lookahead_frames; // <= DE100_AUDIO_MAX_LOOKAHEAD_FRAMES
+  f32 envelope;         // Smoothed peak level
+  f32 min_gain;         // Deepest reduction in the last block (meter)
+
+  f32 delay_left[DE100_AUDIO_MAX_LOOKAHEAD_FRAMES];
+  f32 delay_right[DE100_AUDIO_MAX_LOOKAHEAD_FRAMES];
+  i32 delay_index;
+} De100AudioCompressor;
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Mixer
+// ─────────────────────────────────────────────────────────────────────────────
+
+typedef struct {
+  De100AudioBus buses[DE100_AUDIO_BUS_COUNT];
+  De100AudioReverb reverb;
+  De100AudioCompressor compressor;
+  f32 master_volume;
+  i32 samples_per_second;
+
+  f32 master_left[DE100_AUDIO_MIX_BLOCK_FRAMES];
+  f32 master_right[DE100_AUDIO_MIX_BLOCK_FRAMES];
+  f32 send[DE100_AUDIO_MIX_BLOCK_FRAMES]; // Mono reverb input
+} De100AudioMixer;
+
+/**
+ * Set defaults (unity faders, no sends, no low-pass, limiter at -1 dBFS
+ * with 5ms look-ahead) and allocate the reverb lines from `arena`.
+ * Returns false if they don't fit; everything else still works, the
+ * reverb just stays silent.
+ */
+bool de100_audio_mixer_init(De100AudioMixer *mixer, De100MemoryArena *arena,
+                            i32 samples_per_second);
+
+/** Look-ahead in milliseconds, clamped to the delay line. */
+void de100_audio_compressor_set_lookahead(De100AudioCompressor *compressor,
+                                          f32 milliseconds,
+                                          i32 samples_per_second);
+
+/**
+ * Start the block at frame `start` of `buffer`: zeroes every bus and
+ * returns how many frames it covers (<= DE100_AUDIO_MIX_BLOCK_FRAMES).
+ */
+i32 de100_audio_mixer_begin_block(De100AudioMixer *mixer,
+                                  GameAudioOutputBuffer *buffer, i32 start);
+
+/**
+ * Run bus effects, sends, the master compressor and the conversion for
+ * `count` frames, writing buffer->samples from frame `start`.
+ */
+void de100_audio_mixer_end_block(De100AudioMixer *mixer,
+                                 GameAudioOutputBuffer *buffer, i32 start,
+                                 i32 count);
+
+#endif // DE100_GAME_AUDIO_BUS_H
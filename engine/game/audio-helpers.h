@@ -2,8 +2,11 @@
 #define DE100_GAME_AUDIO_HELPERS_H
 
 #include "../_common/base.h"
+#include "audio-mix-kernels.h"
+#include "audio-wavetable.h"
 #include "audio.h"
 #include <math.h>
+#include <string.h>
 
 // ═══════════════════════════════════════════════════════════════════════════
 // AUDIO HELPER FUNCTIONS
@@ -23,11 +26,27 @@
 // ─────────────────────────────────────────────────────────────────────────────
 // Standard MIDI note to Hz: A4 (note 69) = 440 Hz
 //
+// No powf: octave -1 (notes 0-11) is a constant table, and every octave
+// above it is an exact power-of-two multiply. Notes clamp to 0-127.
+//
 // Usage:
 //   f32 freq = de100_audio_midi_to_freq(60);  // Middle C = 261.63 Hz
 //
+
+// 440 * 2^((n - 69) / 12) for n = 0..11, rounded to f32
+de100_file_scoped_global_var const f32 g_de100_audio_semitone_hz[12] = {
+    8.17579937f, 8.66195679f, 9.17702389f, 9.72271824f,
+    10.3008614f, 10.9133825f, 11.5623255f, 12.2498569f,
+    12.9782715f, 13.75f,      14.5676174f, 15.4338531f,
+};
+
 de100_file_scoped_fn inline f32 de100_audio_midi_to_freq(i32 midi_note) {
-  return 440.0f * powf(2.0f, (f32)(midi_note - 69) / 12.0f);
+  if (midi_note < 0)
+    midi_note = 0;
+  if (midi_note > 127)
+    midi_note = 127;
+  return g_de100_audio_semitone_hz[midi_note % 12] *
+         (f32)(1u << (midi_note / 12));
 }
 
 /* Common MIDI note constants */
@@ -66,7 +85,8 @@ de100_file_scoped_fn inline i16 de100_audio_clamp_sample(f32 sample) {
 // pan: -1.0 (full left) to 1.0 (full right), 0.0 = center
 //
 // Uses linear panning (simple, works well for game audio).
-// For music production, constant-power panning would be better.
+// For music production, constant-power panning would be better: see
+// de100_audio_calculate_pan_equal_power below.
 //
 de100_file_scoped_fn inline void
 de100_audio_calculate_pan(f32 pan, f32 *left_vol, f32 *right_vol) {
@@ -85,6 +105,40 @@ de100_audio_calculate_pan(f32 pan, f32 *left_vol, f32 *right_vol) {
   }
 }
 
+// Equal-power (sin/cos) panning: left² + right² = 1 everywhere, so a sound
+// moving across the field keeps its loudness (center is -3 dB per side
+// instead of linear's 0 dB). Pan is quantized to DE100_AUDIO_PAN_STEPS
+// positions, read from a constant quarter-sine table: no sinf/cosf.
+//
+#define DE100_AUDIO_PAN_STEPS 32
+
+// sin(i / DE100_AUDIO_PAN_STEPS * pi / 2), i = 0..DE100_AUDIO_PAN_STEPS
+de100_file_scoped_global_var const f32
+    g_de100_audio_pan_sine[DE100_AUDIO_PAN_STEPS + 1] = {
+        0.0f,          0.0490676761f, 0.0980171412f, 0.146730468f,
+        0.195090324f,  0.242980182f,  0.290284663f,  0.336889863f,
+        0.382683426f,  0.427555084f,  0.471396744f,  0.514102757f,
+        0.555570245f,  0.59569931f,   0.634393275f,  0.671558976f,
+        0.707106769f,  0.740951121f,  0.773010433f,  0.803207517f,
+        0.831469595f,  0.857728601f,  0.881921291f,  0.903989315f,
+        0.923879504f,  0.941544056f,  0.956940353f,  0.970031261f,
+        0.980785251f,  0.989176512f,  0.99518472f,   0.99879545f,
+        1.0f,
+};
+
+de100_file_scoped_fn inline void
+de100_audio_calculate_pan_equal_power(f32 pan, f32 *left_vol,
+                                      f32 *right_vol) {
+  if (pan < -1.0f)
+    pan = -1.0f;
+  if (pan > 1.0f)
+    pan = 1.0f;
+
+  i32 step = (i32)((pan + 1.0f) * (0.5f * DE100_AUDIO_PAN_STEPS) + 0.5f);
+  *left_vol = g_de100_audio_pan_sine[DE100_AUDIO_PAN_STEPS - step];
+  *right_vol = g_de100_audio_pan_sine[step];
+}
+
 // ─────────────────────────────────────────────────────────────────────────────
 // Volume Ramping
 // ─────────────────────────────────────────────────────────────────────────────
@@ -155,6 +209,23 @@ de100_file_scoped_fn inline f32 de100_audio_wave_pulse(f32 phase, f32 duty) {
   return (phase < duty) ? 1.0f : -1.0f;
 }
 
+// Naive (aliasing, libm) reference for De100AudioWaveform; prefer
+// de100_wavetable_sample() in inner loops (audio-wavetable.h)
+de100_file_scoped_fn inline f32 de100_audio_wave(i32 waveform, f32 phase) {
+  switch (waveform) {
+  case DE100_AUDIO_WAVE_SQUARE:
+    return de100_audio_wave_square(phase);
+  case DE100_AUDIO_WAVE_TRIANGLE:
+    return de100_audio_wave_triangle(phase);
+  case DE100_AUDIO_WAVE_SAWTOOTH:
+    return de100_audio_wave_sawtooth(phase);
+  case DE100_AUDIO_WAVE_PULSE:
+    return de100_audio_wave_pulse(phase, 0.5f);
+  default:
+    return de100_audio_wave_sine(phase);
+  }
+}
+
 /* ─── Sequencer Step Timing ─────────────────────────────────────────────────
  */
 
@@ -188,6 +259,8 @@ typedef struct {
   f32 frequency;      /* Hz */
   f32 volume;         /* Target volume */
   f32 current_volume; /* Smoothed volume (for click-free) */
+  i32 waveform;       /* De100AudioWaveform (0 = sine) */
+  f32 duty;           /* DE100_AUDIO_WAVE_PULSE duty cycle (0.0 to 1.0) */
 } De100Oscillator;
 
 /* Advance oscillator phase, returns current phase before advance */
@@ -200,6 +273,18 @@ de100_file_scoped_fn inline f32 de100_oscillator_advance(De100Oscillator *osc,
   return current_phase;
 }
 
+/* Band-limited sample of the oscillator's waveform, then advance.
+ * Usage (per output sample):
+ *   f32 s = de100_oscillator_sample(&osc, state->wavetables, inv_rate);
+ */
+de100_file_scoped_fn inline f32
+de100_oscillator_sample(De100Oscillator *osc, const De100Wavetables *tables,
+                        f32 inv_sample_rate) {
+  f32 phase = de100_oscillator_advance(osc, inv_sample_rate);
+  return de100_wavetable_sample(tables, osc->waveform, phase, osc->frequency,
+                                osc->duty);
+}
+
 /* Update oscillator volume with ramping */
 de100_file_scoped_fn inline void
 de100_oscillator_update_volume(De100Oscillator *osc, bool is_playing,
@@ -234,8 +319,21 @@ typedef struct {
   i32 total_samples;     // Original duration
   i32 fade_in_samples;   // Samples to fade in (prevents clicks)
   i32 fade_out_samples;  // Samples to fade out (optional)
+  i32 waveform;          // De100AudioWaveform, used by the block mixer
+  i32 priority;          // De100SoundPriority (higher survives stealing)
+  u32 start_serial;      // Start order, for DE100_SOUND_STEAL_OLDEST
 } De100SoundInstance;
 
+// Priority classes: a new sound only steals voices of equal or lower class
+typedef enum {
+  DE100_SOUND_PRIORITY_AMBIENT = 0,
+  DE100_SOUND_PRIORITY_NORMAL,
+  DE100_SOUND_PRIORITY_IMPORTANT,
+  DE100_SOUND_PRIORITY_CRITICAL, // Music stingers, UI feedback
+
+  DE100_SOUND_PRIORITY_COUNT
+} De100SoundPriority;
+
 // Maximum simultaneous sounds (games can define their own limit)
 #ifndef DE100_MAX_SOUND_INSTANCES
 #define DE100_MAX_SOUND_INSTANCES 8
@@ -251,18 +349,20 @@ de100_sound_is_active(De100SoundInstance *inst) {
   return inst->samples_remaining > 0;
 }
 
-// Calculate envelope for current sample (fade in/out)
-de100_file_scoped_fn inline f32 de100_sound_envelope(De100SoundInstance *inst) {
+// Envelope (fade in/out) at the sample where `samples_remaining` are left
+de100_file_scoped_fn inline f32
+de100_sound_envelope_at(const De100SoundInstance *inst,
+                        i32 samples_remaining) {
   f32 env = 1.0f;
 
   // Fade out at end
   if (inst->fade_out_samples > 0 &&
-      inst->samples_remaining <= inst->fade_out_samples) {
-    env = (f32)inst->samples_remaining / (f32)inst->fade_out_samples;
+      samples_remaining <= inst->fade_out_samples) {
+    env = (f32)samples_remaining / (f32)inst->fade_out_samples;
   }
 
   // Fade in at start
-  i32 samples_played = inst->total_samples - inst->samples_remaining;
+  i32 samples_played = inst->total_samples - samples_remaining;
   if (inst->fade_in_samples > 0 && samples_played < inst->fade_in_samples) {
     f32 fade_in = (f32)samples_played / (f32)inst->fade_in_samples;
     env *= fade_in;
@@ -271,6 +371,11 @@ de100_file_scoped_fn inline f32 de100_sound_envelope(De100SoundInstance *inst) {
   return env;
 }
 
+// Calculate envelope for current sample (fade in/out)
+de100_file_scoped_fn inline f32 de100_sound_envelope(De100SoundInstance *inst) {
+  return de100_sound_envelope_at(inst, inst->samples_remaining);
+}
+
 // Advance instance by one sample
 de100_file_scoped_fn inline void de100_sound_advance(De100SoundInstance *inst,
                                                      f32 inv_sample_rate) {
@@ -285,6 +390,43 @@ de100_file_scoped_fn inline void de100_sound_advance(De100SoundInstance *inst,
   inst->samples_remaining--;
 }
 
+// Advance instance by `count` samples without rendering (virtual voice).
+// Closed form for the linear pitch slide; per-sample only if the 20 Hz
+// clamp is reached inside the span.
+de100_file_scoped_fn inline void de100_sound_skip(De100SoundInstance *inst,
+                                                  i32 count,
+                                                  f32 inv_sample_rate) {
+  if (count > inst->samples_remaining) {
+    count = inst->samples_remaining;
+  }
+  if (count <= 0) {
+    return;
+  }
+
+  f32 n = (f32)count;
+  f32 end_frequency = inst->frequency + inst->frequency_slide * n;
+  if (inst->frequency < 20.0f || end_frequency < 20.0f) {
+    for (i32 i = 0; i < count; ++i) {
+      de100_sound_advance(inst, inv_sample_rate);
+    }
+    return;
+  }
+
+  // sum(f0 + k * slide, k = 0..n-1) samples' worth of phase
+  f32 cycles = (inst->frequency * n + inst->frequency_slide * n * (n - 1.0f) *
+                                           0.5f) *
+               inv_sample_rate;
+  inst->phase += cycles;
+  inst->phase -= floorf(inst->phase);
+  inst->frequency = end_frequency;
+  inst->samples_remaining -= count;
+}
+
+// Current audible gain (volume * envelope), used to rank voices
+de100_file_scoped_fn inline f32 de100_sound_gain(De100SoundInstance *inst) {
+  return inst->volume * de100_sound_envelope(inst);
+}
+
 // ═══════════════════════════════════════════════════════════════════════════
 // SOUND PLAYER (Manages multiple instances)
 // ═══════════════════════════════════════════════════════════════════════════
@@ -294,22 +436,301 @@ de100_file_scoped_fn inline void de100_sound_advance(De100SoundInstance *inst,
 //
 // ═══════════════════════════════════════════════════════════════════════════
 
+// Who gets cut off when every slot is busy. Victims always come from the
+// lowest priority class present; the policy picks within that class.
+typedef enum {
+  DE100_SOUND_STEAL_QUIETEST = 0, // Lowest current gain
+  DE100_SOUND_STEAL_OLDEST,       // Earliest start
+  DE100_SOUND_STEAL_NONE,         // Drop the new sound instead
+
+  DE100_SOUND_STEAL_POLICY_COUNT
+} De100SoundStealPolicy;
+
+// Voice manager:
+//   - instances[] bounds how many sounds exist at once (stealing above)
+//   - max_mixed_voices bounds how many are rendered per block; the rest,
+//     and any voice quieter than DE100_SOUND_VIRTUAL_GAIN, are "virtual":
+//     their time keeps advancing (de100_sound_skip) so they resume in
+//     place, but they cost no oscillator or mixing work
+//   - audible voices are chosen by (priority, current gain)
+//
+// All fields zero = old behavior: no virtualization limit, steal quietest.
 typedef struct {
   De100SoundInstance instances[DE100_MAX_SOUND_INSTANCES];
   f32 volume; // Master volume for all SFX
+
+  // Optional band-limited oscillators (NULL = naive de100_audio_wave)
+  const De100Wavetables *wavetables;
+
+  i32 steal_policy;     // De100SoundStealPolicy
+  i32 max_mixed_voices; // 0 = mix every active voice
+  u32 next_serial;
+
+  // Last de100_sound_player_mix() call (last block)
+  i32 mixed_voice_count;
+  i32 virtual_voice_count;
 } De100SoundPlayer;
 
-// Find an empty slot, or steal the oldest sound
+// Gain below which a voice is inaudible at the mixer's i16 scale (half an
+// LSB after player->volume), so it's advanced virtually instead of mixed
+#define DE100_SOUND_VIRTUAL_GAIN (0.5f / 16000.0f)
+
+// Empty slot, or the stealing victim for a sound of `priority`.
+// Returns -1 if no voice of equal or lower priority may be stolen.
 de100_file_scoped_fn inline i32
-de100_sound_player_find_slot(De100SoundPlayer *player) {
-  // First, look for an empty slot
+de100_sound_player_find_slot_for(De100SoundPlayer *player, i32 priority) {
   for (i32 i = 0; i < DE100_MAX_SOUND_INSTANCES; i++) {
     if (!de100_sound_is_active(&player->instances[i])) {
       return i;
     }
   }
-  // All slots full - steal slot 0 (could be smarter: steal quietest)
-  return 0;
+
+  if (player->steal_policy == DE100_SOUND_STEAL_NONE) {
+    return -1;
+  }
+
+  i32 victim = -1;
+  f32 victim_gain = 0.0f;
+  for (i32 i = 0; i < DE100_MAX_SOUND_INSTANCES; i++) {
+    De100SoundInstance *inst = &player->instances[i];
+    if (inst->priority > priority) {
+      continue;
+    }
+    f32 gain = de100_sound_gain(inst);
+    if (victim >= 0) {
+      De100SoundInstance *best = &player->instances[victim];
+      if (inst->priority > best->priority) {
+        continue;
+      }
+      if (inst->priority == best->priority) {
+        // Serials compared by wrapped difference
+        bool better = player->steal_policy == DE100_SOUND_STEAL_OLDEST
+                          ? (i32)(inst->start_serial - best->start_serial) < 0
+                          : gain < victim_gain;
+        if (!better) {
+          continue;
+        }
+      }
+    }
+    victim = i;
+    victim_gain = gain;
+  }
+  return victim;
+}
+
+// Find an empty slot, or steal one (lowest priority first, then by
+// steal_policy). Always returns a valid slot for existing callers.
+de100_file_scoped_fn inline i32
+de100_sound_player_find_slot(De100SoundPlayer *player) {
+  i32 slot = de100_sound_player_find_slot_for(player,
+                                              DE100_SOUND_PRIORITY_COUNT);
+  return slot >= 0 ? slot : 0;
+}
+
+// Claim a slot for a new sound: cleared, with priority and start order
+// stamped. Returns NULL if the sound should be dropped.
+//
+// Usage:
+//   De100SoundInstance *inst =
+//       de100_sound_player_start(&sfx, DE100_SOUND_PRIORITY_NORMAL);
+//   if (inst) { inst->sound_id = SFX_EXPLOSION; inst->frequency = ...; }
+//
+de100_file_scoped_fn inline De100SoundInstance *
+de100_sound_player_start(De100SoundPlayer *player, i32 priority) {
+  i32 slot = de100_sound_player_find_slot_for(player, priority);
+  if (slot < 0) {
+    return NULL;
+  }
+  De100SoundInstance *inst = &player->instances[slot];
+  memset(inst, 0, sizeof(*inst));
+  inst->priority = priority;
+  inst->start_serial = player->next_serial++;
+  return inst;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Block Mixer
+// ─────────────────────────────────────────────────────────────────────────────
+// Mixes every active instance into interleaved i16 stereo, a block at a time:
+//
+//   voice ──render (scalar, serial phase)──▶ f32 block
+//         ──accumulate (SIMD, pan gains)───▶ planar L/R mix
+//   mix   ──to_i16 (SIMD, master, clamp)───▶ out LRLR...
+//
+// Matches the per-sample loop (up to float rounding)
+//
+//   de100_audio_mix_sample_stereo(waveform(phase) * volume * envelope, pan)
+//   de100_sound_advance(...)
+//   de100_audio_finalize_stereo(..., player->volume, out)
+//
+// but the pan and the final conversion are hoisted out of the sample loop
+// and vectorized, and volume * envelope is evaluated at control rate
+// (every DE100_AUDIO_CONTROL_FRAMES) and ramped linearly in between, so
+// the per-voice cost is its oscillator plus one multiply-add. The fades
+// are linear, so the ramp only differs where fade-in and fade-out overlap.
+//
+// Voices over player->max_mixed_voices, or below DE100_SOUND_VIRTUAL_GAIN,
+// are skipped forward instead of rendered (see De100SoundPlayer).
+//
+// Usage (in game_get_audio_samples):
+//   de100_sound_player_mix(&state->sfx, (i16 *)buffer->samples,
+//                          buffer->sample_count,
+//                          buffer->samples_per_second);
+//
+
+#ifndef DE100_AUDIO_MIX_BLOCK_FRAMES
+#define DE100_AUDIO_MIX_BLOCK_FRAMES 256
+#endif
+
+// Gain (volume * envelope) update interval, in frames
+#ifndef DE100_AUDIO_CONTROL_FRAMES
+#define DE100_AUDIO_CONTROL_FRAMES 32
+#endif
+
+// Render up to `count` samples of one voice (mono, volume and envelope
+// applied) and advance it. Returns samples rendered (< count if it ended).
+de100_file_scoped_fn inline i32
+de100_sound_render_block(De100SoundInstance *inst, f32 *out, i32 count,
+                         f32 inv_sample_rate,
+                         const De100Wavetables *wavetables) {
+  if (count > inst->samples_remaining) {
+    count = inst->samples_remaining;
+  }
+  for (i32 i = 0; i < count;) {
+    i32 run = count - i;
+    if (run > DE100_AUDIO_CONTROL_FRAMES) {
+      run = DE100_AUDIO_CONTROL_FRAMES;
+    }
+    f32 gain = inst->volume * de100_sound_envelope(inst);
+    f32 gain_end = inst->volume * de100_sound_envelope_at(
+                                      inst, inst->samples_remaining - run);
+    f32 gain_step = (gain_end - gain) / (f32)run;
+
+    for (i32 end = i + run; i < end; ++i) {
+      f32 sample = wavetables
+                       ? de100_wavetable_sample(wavetables, inst->waveform,
+                                                inst->phase, inst->frequency,
+                                                0.5f)
+                       : de100_audio_wave(inst->waveform, inst->phase);
+      out[i] = sample * gain;
+      gain += gain_step;
+      de100_sound_advance(inst, inv_sample_rate);
+    }
+  }
+  return count > 0 ? count : 0;
+}
+
+// Mark the voices to render this block; updates mixed/virtual counts
+de100_file_scoped_fn inline void
+de100_sound_player_select_audible(De100SoundPlayer *player, bool *audible) {
+  i32 limit = player->max_mixed_voices > 0 ? player->max_mixed_voices
+                                           : DE100_MAX_SOUND_INSTANCES;
+  f32 min_gain = player->volume > 0.0f
+                     ? DE100_SOUND_VIRTUAL_GAIN / player->volume
+                     : 1e30f;
+  i32 mixed = 0;
+  i32 virtual_count = 0;
+
+  for (i32 i = 0; i < DE100_MAX_SOUND_INSTANCES; i++) {
+    De100SoundInstance *inst = &player->instances[i];
+    // Base volume, not the envelope: a voice fading in starts at zero
+    audible[i] = de100_sound_is_active(inst) && inst->volume >= min_gain;
+    if (!de100_sound_is_active(inst)) {
+      continue;
+    }
+    if (audible[i]) {
+      mixed++;
+    } else {
+      virtual_count++;
+    }
+  }
+
+  // Over budget: repeatedly demote the least important audible voice
+  while (mixed > limit) {
+    i32 weakest = -1;
+    f32 weakest_gain = 0.0f;
+    for (i32 i = 0; i < DE100_MAX_SOUND_INSTANCES; i++) {
+      if (!audible[i]) {
+        continue;
+      }
+      De100SoundInstance *inst = &player->instances[i];
+      f32 gain = de100_sound_gain(inst);
+      if (weakest >= 0) {
+        i32 weakest_priority = player->instances[weakest].priority;
+        if (inst->priority > weakest_priority ||
+            (inst->priority == weakest_priority && gain >= weakest_gain)) {
+          continue;
+        }
+      }
+      weakest = i;
+      weakest_gain = gain;
+    }
+    audible[weakest] = false;
+    mixed--;
+    virtual_count++;
+  }
+
+  player->mixed_voice_count = mixed;
+  player->virtual_voice_count = virtual_count;
+}
+
+// Accumulate one block (count <= DE100_AUDIO_MIX_BLOCK_FRAMES) of every
+// voice into planar mix buffers, scaled by `gain`. Lets a bus
+// (audio-bus.h) take the player's output before the final conversion.
+de100_file_scoped_fn inline void
+de100_sound_player_mix_block(De100SoundPlayer *player, f32 *mix_left,
+                             f32 *mix_right, i32 count, i32 samples_per_second,
+                             f32 gain) {
+  De100AudioMixKernels *kernels = de100_audio_mix_kernels_get();
+  f32 inv_sample_rate = 1.0f / (f32)samples_per_second;
+  f32 voice[DE100_AUDIO_MIX_BLOCK_FRAMES];
+
+  bool audible[DE100_MAX_SOUND_INSTANCES];
+  de100_sound_player_select_audible(player, audible);
+
+  for (i32 i = 0; i < DE100_MAX_SOUND_INSTANCES; i++) {
+    De100SoundInstance *inst = &player->instances[i];
+    if (!de100_sound_is_active(inst)) {
+      continue;
+    }
+    if (!audible[i]) {
+      de100_sound_skip(inst, count, inv_sample_rate);
+      continue;
+    }
+    f32 left_vol, right_vol;
+    de100_audio_calculate_pan(inst->pan_position, &left_vol, &right_vol);
+    i32 rendered = de100_sound_render_block(inst, voice, count,
+                                            inv_sample_rate,
+                                            player->wavetables);
+    kernels->accumulate(mix_left, mix_right, voice, rendered,
+                        left_vol * gain, right_vol * gain);
+  }
+}
+
+de100_file_scoped_fn inline void
+de100_sound_player_mix(De100SoundPlayer *player, i16 *out, i32 sample_count,
+                       i32 samples_per_second) {
+  De100AudioMixKernels *kernels = de100_audio_mix_kernels_get();
+
+  f32 mix_left[DE100_AUDIO_MIX_BLOCK_FRAMES];
+  f32 mix_right[DE100_AUDIO_MIX_BLOCK_FRAMES];
+
+  for (i32 start = 0; start < sample_count;
+       start += DE100_AUDIO_MIX_BLOCK_FRAMES) {
+    i32 count = sample_count - start;
+    if (count > DE100_AUDIO_MIX_BLOCK_FRAMES) {
+      count = DE100_AUDIO_MIX_BLOCK_FRAMES;
+    }
+    memset(mix_left, 0, sizeof(f32) * (size_t)count);
+    memset(mix_right, 0, sizeof(f32) * (size_t)count);
+
+    // player->volume goes in the conversion, as the per-sample path does
+    de100_sound_player_mix_block(player, mix_left, mix_right, count,
+                                 samples_per_second, 1.0f);
+
+    kernels->to_i16(mix_left, mix_right, count, player->volume * 16000.0f,
+                    out + start * 2);
+  }
 }
 
 // ═══════════════════════════════════════════════════════════════════════════
@@ -326,6 +747,29 @@ de100_sound_player_find_slot(De100SoundPlayer *player) {
 //   // Copy patterns, set pattern_count
 //   seq.is_playing = true;
 //
+// Two ways to drive it (pick one per sequencer):
+//
+//   Frame time: de100_sequencer_update(&seq, dt) each game frame. Steps
+//   land on frame boundaries, so onsets jitter by up to a frame and move
+//   with adaptive FPS.
+//
+//   Sample time: from the mixer, with the output buffer's
+//   running_sample_index as the clock. Each call fires the steps due at
+//   `at` and says how long the tone can render before the next one, so
+//   notes start on their exact sample:
+//
+//     u64 clock = buffer->running_sample_index;
+//     for (i32 done = 0; done < buffer->sample_count;) {
+//       i32 run = de100_sequencer_advance_samples(
+//           &seq, clock + (u64)done, buffer->sample_count - done,
+//           buffer->samples_per_second);
+//       render_tone(&seq.tone, out + done * 2, run);
+//       done += run;
+//     }
+//
+//   Frame rate never enters, so it holds at low FPS and would work just
+//   the same from an audio thread.
+//
 // ═══════════════════════════════════════════════════════════════════════════
 
 #ifndef DE100_MAX_PATTERN_LENGTH
@@ -348,6 +792,11 @@ typedef struct {
   f32 step_timer;    // Time since last step
   f32 step_duration; // Seconds per step (tempo)
 
+  // Sample-time clock (de100_sequencer_advance_samples). Fractional, so
+  // steps that aren't a whole number of samples don't drift.
+  f64 next_step_sample;
+  bool is_sample_clock_synced; // next_step_sample is valid
+
   // Tone generator
   SoundSource tone;
 
@@ -380,6 +829,7 @@ de100_sequencer_play(De100MusicSequencer *seq) {
   seq->current_pattern = 0;
   seq->current_step = 0;
   seq->step_timer = 0.0f;
+  seq->is_sample_clock_synced = false; // First step at the next mix
   seq->tone.current_volume = 0.0f;
   seq->is_playing = true;
 }
@@ -391,6 +841,35 @@ de100_sequencer_stop(De100MusicSequencer *seq) {
   seq->tone.is_playing = false;
 }
 
+// Play the current step's note and move to the next step
+de100_file_scoped_fn inline void
+de100_sequencer_step(De100MusicSequencer *seq) {
+  // Get current note
+  u8 note = seq->patterns[seq->current_pattern][seq->current_step];
+
+  if (note > 0) {
+    seq->tone.frequency = de100_audio_midi_to_freq(note);
+    seq->tone.is_playing = true;
+  } else {
+    seq->tone.is_playing = false;
+  }
+
+  // Advance step
+  seq->current_step++;
+  if (seq->current_step >= seq->steps_per_pattern) {
+    seq->current_step = 0;
+    seq->current_pattern++;
+
+    if (seq->current_pattern >= seq->pattern_count) {
+      if (seq->loop) {
+        seq->current_pattern = 0;
+      } else {
+        seq->is_playing = false;
+      }
+    }
+  }
+}
+
 // Update sequencer (call each frame with delta_time)
 de100_file_scoped_fn inline void
 de100_sequencer_update(De100MusicSequencer *seq, f32 delta_time) {
@@ -401,32 +880,48 @@ de100_sequencer_update(De100MusicSequencer *seq, f32 delta_time) {
 
   if (seq->step_timer >= seq->step_duration) {
     seq->step_timer -= seq->step_duration;
+    de100_sequencer_step(seq);
+  }
+}
 
-    // Get current note
-    u8 note = seq->patterns[seq->current_pattern][seq->current_step];
+// Sample-time update (call from the mixer; see above). Fires every step
+// due at or before stream position `at`, then returns how many samples
+// (1..max_samples) the tone can render before the next step is due.
+// A tempo change takes effect from the next step.
+de100_file_scoped_fn inline i32
+de100_sequencer_advance_samples(De100MusicSequencer *seq, u64 at,
+                                i32 max_samples, i32 samples_per_second) {
+  if (max_samples <= 0) {
+    return 0;
+  }
+  if (!seq->is_playing) {
+    seq->is_sample_clock_synced = false;
+    return max_samples;
+  }
+  if (!seq->is_sample_clock_synced) {
+    seq->next_step_sample = (f64)at;
+    seq->is_sample_clock_synced = true;
+  }
 
-    if (note > 0) {
-      seq->tone.frequency = de100_audio_midi_to_freq(note);
-      seq->tone.is_playing = true;
-    } else {
-      seq->tone.is_playing = false;
-    }
+  f64 step_samples = (f64)seq->step_duration * (f64)samples_per_second;
+  if (step_samples < 1.0) {
+    step_samples = 1.0;
+  }
+  while (seq->is_playing && (f64)at >= seq->next_step_sample) {
+    de100_sequencer_step(seq);
+    seq->next_step_sample += step_samples;
+  }
+  if (!seq->is_playing) {
+    return max_samples;
+  }
 
-    // Advance step
-    seq->current_step++;
-    if (seq->current_step >= seq->steps_per_pattern) {
-      seq->current_step = 0;
-      seq->current_pattern++;
-
-      if (seq->current_pattern >= seq->pattern_count) {
-        if (seq->loop) {
-          seq->current_pattern = 0;
-        } else {
-          seq->is_playing = false;
-        }
-      }
-    }
+  // First whole sample at or after the next step
+  f64 until = seq->next_step_sample - (f64)at;
+  i32 run = (i32)until;
+  if ((f64)run < until) {
+    run++;
   }
+  return run < max_samples ? run : max_samples;
 }
 
 // ═══════════════════════════════════════════════════════════════════════════
@@ -0,0 +1,292 @@
+#ifndef DE100_GAME_AUDIO_MIX_KERNELS_H
+#define DE100_GAME_AUDIO_MIX_KERNELS_H
+
+#include "../_common/base.h"
+#include "../_common/cpu.h"
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ⚡ AUDIO MIX KERNELS (scalar / SSE2 / AVX2 / NEON)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// Block primitives used by de100_sound_player_mix():
+//
+//   accumulate(l, r, voice, n, gl, gr)   l[i] += voice[i] * gl
+//                                        r[i] += voice[i] * gr
+//   to_i16(l, r, n, gain, out)           out = interleave(clamp(l * gain),
+//                                                         clamp(r * gain))
+//
+// Mix buffers are planar f32 (one array per channel) so both kernels run
+// four frames per instruction; only the final pass interleaves to the
+// platform's i16 LRLR layout.
+//
+// Conversion truncates toward zero after clamping to [-32768, 32767],
+// exactly like de100_audio_clamp_sample(), so every variant converts a
+// given mix to the same samples as the per-sample helpers.
+//
+// Dispatch:
+//   De100AudioMixKernels *kernels = de100_audio_mix_kernels_get();
+//   kernels->accumulate(mix_left, mix_right, voice, count, gl, gr);
+//
+// de100_audio_mix_kernels_get() returns the engine's table once bound
+// with DE100_KERNELS_BIND (see kernels.h); until then each translation
+// unit picks its own from de100_cpu_detect(). The AVX2 path multiplies
+// and adds separately (no FMA), so it rounds exactly like the others.
+// Define DE100_AUDIO_MIX_FORCE_SCALAR to pin the reference path.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) ||            \
+    defined(_M_IX86)
+#define DE100_AUDIO_MIX_X86 1
+#include <immintrin.h>
+#elif defined(__ARM_NEON) || defined(__aarch64__)
+#define DE100_AUDIO_MIX_NEON 1
+#include <arm_neon.h>
+#endif
+
+typedef void de100_audio_mix_accumulate_t(f32 *mix_left, f32 *mix_right,
+                                          const f32 *voice, i32 count,
+                                          f32 left_gain, f32 right_gain);
+typedef void de100_audio_mix_to_i16_t(const f32 *mix_left,
+                                      const f32 *mix_right, i32 count,
+                                      f32 gain, i16 *out);
+
+typedef struct {
+  de100_audio_mix_accumulate_t *accumulate;
+  de100_audio_mix_to_i16_t *to_i16;
+  const char *name;
+  i32 frames_per_iteration;
+} De100AudioMixKernels;
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Scalar reference
+// ─────────────────────────────────────────────────────────────────────────────
+
+de100_file_scoped_fn inline i16 de100_audio_mix_clamp_scalar(f32 sample) {
+  if (sample > 32767.0f)
+    return 32767;
+  if (sample < -32768.0f)
+    return -32768;
+  return (i16)sample;
+}
+
+de100_file_scoped_fn inline void
+de100_audio_mix_accumulate_scalar(f32 *mix_left, f32 *mix_right,
+                                  const f32 *voice, i32 count, f32 left_gain,
+                                  f32 right_gain) {
+  for (i32 i = 0; i < count; ++i) {
+    mix_left[i] += voice[i] * left_gain;
+    mix_right[i] += voice[i] * right_gain;
+  }
+}
+
+de100_file_scoped_fn inline void
+de100_audio_mix_to_i16_scalar(const f32 *mix_left, const f32 *mix_right,
+                              i32 count, f32 gain, i16 *out) {
+  for (i32 i = 0; i < count; ++i) {
+    out[i * 2 + 0] = de100_audio_mix_clamp_scalar(mix_left[i] * gain);
+    out[i * 2 + 1] = de100_audio_mix_clamp_scalar(mix_right[i] * gain);
+  }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// SSE2 (4 frames / iteration) — baseline on every x86-64 CPU
+// ─────────────────────────────────────────────────────────────────────────────
+
+#if DE100_AUDIO_MIX_X86
+
+de100_file_scoped_fn inline void
+de100_audio_mix_accumulate_sse2(f32 *mix_left, f32 *mix_right,
+                                const f32 *voice, i32 count, f32 left_gain,
+                                f32 right_gain) {
+  __m128 gl = _mm_set1_ps(left_gain);
+  __m128 gr = _mm_set1_ps(right_gain);
+  i32 i = 0;
+  for (; i + 4 <= count; i += 4) {
+    __m128 v = _mm_loadu_ps(voice + i);
+    __m128 l = _mm_loadu_ps(mix_left + i);
+    __m128 r = _mm_loadu_ps(mix_right + i);
+    _mm_storeu_ps(mix_left + i, _mm_add_ps(l, _mm_mul_ps(v, gl)));
+    _mm_storeu_ps(mix_right + i, _mm_add_ps(r, _mm_mul_ps(v, gr)));
+  }
+  de100_audio_mix_accumulate_scalar(mix_left + i, mix_right + i, voice + i,
+                                    count - i, left_gain, right_gain);
+}
+
+de100_file_scoped_fn inline void
+de100_audio_mix_to_i16_sse2(const f32 *mix_left, const f32 *mix_right,
+                            i32 count, f32 gain, i16 *out) {
+  __m128 g = _mm_set1_ps(gain);
+  __m128 max = _mm_set1_ps(32767.0f);
+  __m128 min = _mm_set1_ps(-32768.0f);
+  i32 i = 0;
+  for (; i + 4 <= count; i += 4) {
+    __m128 l = _mm_mul_ps(_mm_loadu_ps(mix_left + i), g);
+    __m128 r = _mm_mul_ps(_mm_loadu_ps(mix_right + i), g);
+    // Clamp first: out-of-range floats would convert to INT_MIN
+    __m128i li = _mm_cvttps_epi32(_mm_max_ps(_mm_min_ps(l, max), min));
+    __m128i ri = _mm_cvttps_epi32(_mm_max_ps(_mm_min_ps(r, max), min));
+    __m128i lr_lo = _mm_unpacklo_epi32(li, ri); // l0 r0 l1 r1
+    __m128i lr_hi = _mm_unpackhi_epi32(li, ri); // l2 r2 l3 r3
+    _mm_storeu_si128((__m128i *)(out + i * 2), _mm_packs_epi32(lr_lo, lr_hi));
+  }
+  de100_audio_mix_to_i16_scalar(mix_left + i, mix_right + i, count - i, gain,
+                                out + i * 2);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// AVX2 (8 frames / iteration)
+// ─────────────────────────────────────────────────────────────────────────────
+
+DE100_TARGET_AVX2 de100_file_scoped_fn inline void
+de100_audio_mix_accumulate_avx2(f32 *mix_left, f32 *mix_right,
+                                const f32 *voice, i32 count, f32 left_gain,
+                                f32 right_gain) {
+  __m256 gl = _mm256_set1_ps(left_gain);
+  __m256 gr = _mm256_set1_ps(right_gain);
+  i32 i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m256 v = _mm256_loadu_ps(voice + i);
+    __m256 l = _mm256_loadu_ps(mix_left + i);
+    __m256 r = _mm256_loadu_ps(mix_right + i);
+    _mm256_storeu_ps(mix_left + i, _mm256_add_ps(l, _mm256_mul_ps(v, gl)));
+    _mm256_storeu_ps(mix_right + i, _mm256_add_ps(r, _mm256_mul_ps(v, gr)));
+  }
+  de100_audio_mix_accumulate_scalar(mix_left + i, mix_right + i, voice + i,
+                                    count - i, left_gain, right_gain);
+}
+
+DE100_TARGET_AVX2 de100_file_scoped_fn inline void
+de100_audio_mix_to_i16_avx2(const f32 *mix_left, const f32 *mix_right,
+                            i32 count, f32 gain, i16 *out) {
+  __m256 g = _mm256_set1_ps(gain);
+  __m256 max = _mm256_set1_ps(32767.0f);
+  __m256 min = _mm256_set1_ps(-32768.0f);
+  i32 i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m256 l = _mm256_mul_ps(_mm256_loadu_ps(mix_left + i), g);
+    __m256 r = _mm256_mul_ps(_mm256_loadu_ps(mix_right + i), g);
+    __m256i li = _mm256_cvttps_epi32(_mm256_max_ps(_mm256_min_ps(l, max), min));
+    __m256i ri = _mm256_cvttps_epi32(_mm256_max_ps(_mm256_min_ps(r, max), min));
+    // Unpack and pack stay within 128-bit halves, which lands in order:
+    // l0 r0 l1 r1 l2 r2 l3 r3 | l4 r4 l5 r5 l6 r6 l7 r7
+    __m256i lr_lo = _mm256_unpacklo_epi32(li, ri);
+    __m256i lr_hi = _mm256_unpackhi_epi32(li, ri);
+    _mm256_storeu_si256((__m256i *)(out + i * 2),
+                        _mm256_packs_epi32(lr_lo, lr_hi));
+  }
+  de100_audio_mix_to_i16_scalar(mix_left + i, mix_right + i, count - i, gain,
+                                out + i * 2);
+}
+
+#endif // DE100_AUDIO_MIX_X86
+
+// ─────────────────────────────────────────────────────────────────────────────
+// NEON (4 frames / iteration)
+// ─────────────────────────────────────────────────────────────────────────────
+
+#if DE100_AUDIO_MIX_NEON
+
+de100_file_scoped_fn inline void
+de100_audio_mix_accumulate_neon(f32 *mix_left, f32 *mix_right,
+                                const f32 *voice, i32 count, f32 left_gain,
+                                f32 right_gain) {
+  i32 i = 0;
+  for (; i + 4 <= count; i += 4) {
+    float32x4_t v = vld1q_f32(voice + i);
+    vst1q_f32(mix_left + i,
+              vmlaq_n_f32(vld1q_f32(mix_left + i), v, left_gain));
+    vst1q_f32(mix_right + i,
+              vmlaq_n_f32(vld1q_f32(mix_right + i), v, right_gain));
+  }
+  de100_audio_mix_accumulate_scalar(mix_left + i, mix_right + i, voice + i,
+                                    count - i, left_gain, right_gain);
+}
+
+de100_file_scoped_fn inline void
+de100_audio_mix_to_i16_neon(const f32 *mix_left, const f32 *mix_right,
+                            i32 count, f32 gain, i16 *out) {
+  float32x4_t max = vdupq_n_f32(32767.0f);
+  float32x4_t min = vdupq_n_f32(-32768.0f);
+  i32 i = 0;
+  for (; i + 4 <= count; i += 4) {
+    float32x4_t l = vmulq_n_f32(vld1q_f32(mix_left + i), gain);
+    float32x4_t r = vmulq_n_f32(vld1q_f32(mix_right + i), gain);
+    int16x4x2_t lr;
+    lr.val[0] = vmovn_s32(vcvtq_s32_f32(vmaxq_f32(vminq_f32(l, max), min)));
+    lr.val[1] = vmovn_s32(vcvtq_s32_f32(vmaxq_f32(vminq_f32(r, max), min)));
+    vst2_s16(out + i * 2, lr); // Interleaves l0 r0 l1 r1 ...
+  }
+  de100_audio_mix_to_i16_scalar(mix_left + i, mix_right + i, count - i, gain,
+                                out + i * 2);
+}
+
+#endif // DE100_AUDIO_MIX_NEON
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Dispatch
+// ─────────────────────────────────────────────────────────────────────────────
+
+/**
+ * The best kernels for `cpu_features` (De100CpuFeature bits).
+ */
+de100_file_scoped_fn inline De100AudioMixKernels
+de100_audio_mix_kernels_for(u32 cpu_features) {
+  De100AudioMixKernels kernels = {
+      .accumulate = de100_audio_mix_accumulate_scalar,
+      .to_i16 = de100_audio_mix_to_i16_scalar,
+      .name = "scalar",
+      .frames_per_iteration = 1,
+  };
+
+#if !defined(DE100_AUDIO_MIX_FORCE_SCALAR)
+#if DE100_AUDIO_MIX_X86
+  if (cpu_features & DE100_CPU_FEATURE_AVX2) {
+    kernels = (De100AudioMixKernels){
+        .accumulate = de100_audio_mix_accumulate_avx2,
+        .to_i16 = de100_audio_mix_to_i16_avx2,
+        .name = "avx2",
+        .frames_per_iteration = 8,
+    };
+  } else if (cpu_features & DE100_CPU_FEATURE_SSE2) {
+    kernels = (De100AudioMixKernels){
+        .accumulate = de100_audio_mix_accumulate_sse2,
+        .to_i16 = de100_audio_mix_to_i16_sse2,
+        .name = "sse2",
+        .frames_per_iteration = 4,
+    };
+  }
+#elif DE100_AUDIO_MIX_NEON
+  if (cpu_features & DE100_CPU_FEATURE_NEON) {
+    kernels = (De100AudioMixKernels){
+        .accumulate = de100_audio_mix_accumulate_neon,
+        .to_i16 = de100_audio_mix_to_i16_neon,
+        .name = "neon",
+        .frames_per_iteration = 4,
+    };
+  }
+#endif
+#else
+  (void)cpu_features;
+#endif // !DE100_AUDIO_MIX_FORCE_SCALAR
+
+  return kernels;
+}
+
+// One per module (game library / executable), set by DE100_KERNELS_BIND
+__attribute__((weak)) De100AudioMixKernels *g_de100_audio_mix_kernels = NULL;
+
+de100_file_scoped_fn inline De100AudioMixKernels *
+de100_audio_mix_kernels_get(void) {
+  if (g_de100_audio_mix_kernels) {
+    return g_de100_audio_mix_kernels;
+  }
+
+  local_persist_var De100AudioMixKernels kernels = {0};
+  if (!kernels.accumulate) {
+    kernels = de100_audio_mix_kernels_for(de100_cpu_detect());
+  }
+  return &kernels;
+}
+
+#endif // DE100_GAME_AUDIO_MIX_KERNELS_H
@@ -0,0 +1,228 @@
+#ifndef DE100_GAME_AUDIO_RESAMPLER_H
+#define DE100_GAME_AUDIO_RESAMPLER_H
+
+#include "../_common/base.h"
+#include "audio-helpers.h"
+#include "audio-mix-kernels.h"
+#include <math.h>
+#include <stdbool.h>
+#include <string.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// 🔁 AUDIO RESAMPLER (polyphase windowed sinc, streaming, stereo i16)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// Converts interleaved i16 stereo between rates, so assets can be authored
+// at one rate (e.g. 44.1kHz) and played at whatever the device accepted.
+//
+// Each output frame is a DE100_RESAMPLER_TAPS-point dot product against
+// the most recent input frames. The kernel is a Kaiser-windowed sinc with
+// its cutoff at the lower Nyquist (so downsampling doesn't alias),
+// tabulated at DE100_RESAMPLER_PHASES sub-frame offsets; arbitrary ratios
+// (147:160 for 44.1 → 48k) interpolate between neighbouring phases.
+//
+// Streaming: feed chunks back to back, state carries across. Output lags
+// input by TAPS / 2 frames; call de100_resampler_flush() at the end of a
+// finite sound to drain them.
+//
+//   De100Resampler resampler;   // ~9KB, mostly the kernel table
+//   de100_resampler_init(&resampler, 44100, 48000);
+//   n = de100_resample(&resampler, in, in_frames, out, out_capacity);
+//   n += de100_resample_flush(&resampler, out + n * 2, out_capacity - n);
+//
+// Equal rates are a straight copy.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define DE100_RESAMPLER_TAPS 16 // Even; 8 frames either side
+#define DE100_RESAMPLER_PHASES 128
+#define DE100_RESAMPLER_KAISER_BETA 8.0
+
+typedef struct {
+  f64 step;     // Input frames per output frame
+  f64 position; // Next output, in frames past the window's centre
+  u32 frames_in;
+  i32 write_index;
+
+  // Last TAPS input frames per channel, stored twice so the window is
+  // always contiguous: [write_index + 1, write_index + TAPS]
+  f32 history[2][DE100_RESAMPLER_TAPS * 2];
+
+  // kernel[phase][tap]; one extra row so phase + 1 is always valid
+  f32 kernel[DE100_RESAMPLER_PHASES + 1][DE100_RESAMPLER_TAPS];
+} De100Resampler;
+
+// Zeroth-order modified Bessel function (Kaiser window), series form
+de100_file_scoped_fn inline f64 de100_resampler_bessel_i0(f64 x) {
+  f64 sum = 1.0;
+  f64 term = 1.0;
+  f64 half = x * 0.5;
+  for (i32 k = 1; k < 32; ++k) {
+    term *= (half / (f64)k) * (half / (f64)k);
+    sum += term;
+    if (term < sum * 1e-12) {
+      break;
+    }
+  }
+  return sum;
+}
+
+de100_file_scoped_fn inline void de100_resampler_init(De100Resampler *resampler,
+                                                      i32 source_rate,
+                                                      i32 target_rate) {
+  memset(resampler, 0, sizeof(*resampler));
+  resampler->step = (f64)source_rate / (f64)target_rate;
+  if (resampler->step == 1.0) {
+    return;
+  }
+
+  // Cutoff (fraction of input Nyquist): a little under the lower Nyquist
+  // so the transition band sits below it
+  f64 cutoff = resampler->step > 1.0 ? 1.0 / resampler->step : 1.0;
+  cutoff *= 0.92;
+
+  const i32 half = DE100_RESAMPLER_TAPS / 2;
+  f64 window_norm = de100_resampler_bessel_i0(DE100_RESAMPLER_KAISER_BETA);
+
+  for (i32 phase = 0; phase <= DE100_RESAMPLER_PHASES; ++phase) {
+    f64 offset = (f64)phase / (f64)DE100_RESAMPLER_PHASES;
+    f64 sum = 0.0;
+    f64 row[DE100_RESAMPLER_TAPS];
+    for (i32 tap = 0; tap < DE100_RESAMPLER_TAPS; ++tap) {
+      // Distance from the output instant to this tap's input frame
+      f64 x = (f64)(tap - (half - 1)) - offset;
+      f64 sinc = x == 0.0 ? 1.0 : sin(M_PI * cutoff * x) / (M_PI * cutoff * x);
+      f64 r = x / (f64)half;
+      f64 window = fabs(r) >= 1.0
+                       ? 0.0
+                       : de100_resampler_bessel_i0(
+                             DE100_RESAMPLER_KAISER_BETA * sqrt(1.0 - r * r)) /
+                             window_norm;
+      row[tap] = sinc * window;
+      sum += row[tap];
+    }
+    // Unity DC gain at every phase (no ripple on constant input)
+    for (i32 tap = 0; tap < DE100_RESAMPLER_TAPS; ++tap) {
+      resampler->kernel[phase][tap] = (f32)(row[tap] / sum);
+    }
+  }
+}
+
+// Worst-case output frames for `in_frames` input frames (flush included)
+de100_file_scoped_fn inline u32
+de100_resampler_capacity(const De100Resampler *resampler, u32 in_frames) {
+  return (u32)((f64)(in_frames + DE100_RESAMPLER_TAPS / 2) /
+               resampler->step) +
+         2;
+}
+
+// Dot product of one channel's window with the interpolated kernel row
+de100_file_scoped_fn inline f32 de100_resampler_dot(const f32 *window,
+                                                    const f32 *k0,
+                                                    const f32 *k1, f32 t) {
+#if DE100_AUDIO_MIX_X86
+  __m128 tv = _mm_set1_ps(t);
+  __m128 acc = _mm_setzero_ps();
+  for (i32 i = 0; i < DE100_RESAMPLER_TAPS; i += 4) {
+    __m128 a = _mm_loadu_ps(k0 + i);
+    __m128 b = _mm_loadu_ps(k1 + i);
+    __m128 k = _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), tv));
+    acc = _mm_add_ps(acc, _mm_mul_ps(k, _mm_loadu_ps(window + i)));
+  }
+  acc = _mm_add_ps(acc, _mm_movehl_ps(acc, acc));
+  acc = _mm_add_ss(acc, _mm_shuffle_ps(acc, acc, 1));
+  return _mm_cvtss_f32(acc);
+#elif DE100_AUDIO_MIX_NEON
+  float32x4_t tv = vdupq_n_f32(t);
+  float32x4_t acc = vdupq_n_f32(0.0f);
+  for (i32 i = 0; i < DE100_RESAMPLER_TAPS; i += 4) {
+    float32x4_t a = vld1q_f32(k0 + i);
+    float32x4_t b = vld1q_f32(k1 + i);
+    float32x4_t k = vaddq_f32(a, vmulq_f32(vsubq_f32(b, a), tv));
+    acc = vaddq_f32(acc, vmulq_f32(k, vld1q_f32(window + i)));
+  }
+  float32x2_t pair = vadd_f32(vget_low_f32(acc), vget_high_f32(acc));
+  return vget_lane_f32(vpadd_f32(pair, pair), 0);
+#else
+  f32 acc = 0.0f;
+  for (i32 i = 0; i < DE100_RESAMPLER_TAPS; ++i) {
+    acc += (k0[i] + (k1[i] - k0[i]) * t) * window[i];
+  }
+  return acc;
+#endif
+}
+
+// Push one input frame; emit every output that falls before the next one
+de100_file_scoped_fn inline u32
+de100_resampler_push(De100Resampler *resampler, f32 left, f32 right,
+                     i16 *out, u32 out_capacity) {
+  i32 w = resampler->write_index;
+  resampler->history[0][w] = left;
+  resampler->history[0][w + DE100_RESAMPLER_TAPS] = left;
+  resampler->history[1][w] = right;
+  resampler->history[1][w + DE100_RESAMPLER_TAPS] = right;
+  resampler->write_index = (w + 1) % DE100_RESAMPLER_TAPS;
+  resampler->frames_in++;
+
+  // The window's centre is input frame frames_in - TAPS/2 - 1; nothing to
+  // emit until it reaches frame 0
+  if (resampler->frames_in <= DE100_RESAMPLER_TAPS / 2) {
+    return 0;
+  }
+
+  const f32 *window_left = resampler->history[0] + resampler->write_index;
+  const f32 *window_right = resampler->history[1] + resampler->write_index;
+  u32 written = 0;
+  while (resampler->position < 1.0 && written < out_capacity) {
+    f32 phase = (f32)resampler->position * (f32)DE100_RESAMPLER_PHASES;
+    i32 index = (i32)phase;
+    f32 t = phase - (f32)index;
+    const f32 *k0 = resampler->kernel[index];
+    const f32 *k1 = resampler->kernel[index + 1];
+    out[written * 2 + 0] = de100_audio_clamp_sample(
+        de100_resampler_dot(window_left, k0, k1, t));
+    out[written * 2 + 1] = de100_audio_clamp_sample(
+        de100_resampler_dot(window_right, k0, k1, t));
+    written++;
+    resampler->position += resampler->step;
+  }
+  resampler->position -= 1.0;
+  return written;
+}
+
+de100_file_scoped_fn inline u32 de100_resample(De100Resampler *resampler,
+                                               const i16 *in, u32 in_frames,
+                                               i16 *out, u32 out_capacity) {
+  if (resampler->step == 1.0) {
+    u32 count = in_frames < out_capacity ? in_frames : out_capacity;
+    memcpy(out, in, sizeof(i16) * 2 * count);
+    return count;
+  }
+
+  u32 written = 0;
+  for (u32 i = 0; i < in_frames; ++i) {
+    written += de100_resampler_push(resampler, (f32)in[i * 2 + 0],
+                                    (f32)in[i * 2 + 1],
+                                    out + (size_t)written * 2,
+                                    out_capacity - written);
+  }
+  return written;
+}
+
+// Drain the TAPS / 2 frames still inside the window (end of a sound)
+de100_file_scoped_fn inline u32 de100_resample_flush(De100Resampler *resampler,
+                                                     i16 *out,
+                                                     u32 out_capacity) {
+  if (resampler->step == 1.0) {
+    return 0;
+  }
+  u32 written = 0;
+  for (i32 i = 0; i < DE100_RESAMPLER_TAPS / 2; ++i) {
+    written += de100_resampler_push(resampler, 0.0f, 0.0f,
+                                    out + (size_t)written * 2,
+                                    out_capacity - written);
+  }
+  return written;
+}
+
+#endif // DE100_GAME_AUDIO_RESAMPLER_H
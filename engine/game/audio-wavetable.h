@@ -0,0 +1,191 @@
+#ifndef DE100_GAME_AUDIO_WAVETABLE_H
+#define DE100_GAME_AUDIO_WAVETABLE_H
+
+#include "../_common/base.h"
+#include <math.h>
+#include <string.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// 🎹 BAND-LIMITED WAVETABLES
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// Lookup-table oscillators: one linear-interpolated read per sample, no
+// libm in the inner loop.
+//
+// The naive square / saw / triangle (de100_audio_wave_*) have infinite
+// harmonics; above ~1kHz the ones past Nyquist fold back as inharmonic
+// aliasing. Here each shape is built by additive synthesis once per octave,
+// keeping only the harmonics that fit under Nyquist for the TOP note of
+// that octave:
+//
+//   octave:      0       1       2      ...   10
+//   fundamental: 20-40Hz 40-80Hz 80-160Hz     20-40kHz
+//   harmonics:   600     300     150    ...   1 (pure sine)   (at 48kHz)
+//
+// Pulse (any duty) is the difference of two band-limited saws, so it needs
+// no table of its own.
+//
+// Build once into permanent storage (~270KB), e.g. at game init:
+//   state->wavetables = de100_arena_push_struct(&arena, De100Wavetables);
+//   de100_wavetables_init(state->wavetables, buffer->samples_per_second);
+//
+// The tables are plain data, so they survive hot reloads with the rest of
+// permanent storage.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+// Waveform selector (stored as data, not a function pointer, so it
+// survives game code hot reloads)
+typedef enum {
+  DE100_AUDIO_WAVE_SINE = 0,
+  DE100_AUDIO_WAVE_SQUARE,
+  DE100_AUDIO_WAVE_TRIANGLE,
+  DE100_AUDIO_WAVE_SAWTOOTH,
+  DE100_AUDIO_WAVE_PULSE, // Duty from the oscillator (instances: 50%)
+
+  DE100_AUDIO_WAVE_COUNT
+} De100AudioWaveform;
+
+#define DE100_WAVETABLE_SIZE 2048 // Samples per cycle, power of two
+#define DE100_WAVETABLE_OCTAVES 11
+#define DE100_WAVETABLE_BASE_HZ 20.0f // Bottom of octave 0
+
+// Band-limited shapes with a table per octave (sine has one table)
+typedef enum {
+  DE100_WAVETABLE_SQUARE = 0,
+  DE100_WAVETABLE_TRIANGLE,
+  DE100_WAVETABLE_SAWTOOTH,
+
+  DE100_WAVETABLE_SHAPE_COUNT
+} De100WavetableShape;
+
+typedef struct De100Wavetables {
+  // +1 guard sample (== [0]) so interpolation never wraps
+  f32 sine[DE100_WAVETABLE_SIZE + 1];
+  f32 band[DE100_WAVETABLE_SHAPE_COUNT][DE100_WAVETABLE_OCTAVES]
+          [DE100_WAVETABLE_SIZE + 1];
+  i32 samples_per_second; // Nyquist the tables were built for
+} De100Wavetables;
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Build
+// ─────────────────────────────────────────────────────────────────────────────
+
+// Add harmonic k (integer) with `amplitude`, read from the sine table
+de100_file_scoped_fn inline void
+de100_wavetable_add_harmonic(f32 *table, const f32 *sine, i32 k,
+                             f32 amplitude) {
+  u32 mask = DE100_WAVETABLE_SIZE - 1;
+  for (u32 i = 0; i < DE100_WAVETABLE_SIZE; ++i) {
+    table[i] += sine[(i * (u32)k) & mask] * amplitude;
+  }
+}
+
+de100_file_scoped_fn inline void
+de100_wavetables_init(De100Wavetables *tables, i32 samples_per_second) {
+  const f32 pi = 3.14159265358979f;
+  tables->samples_per_second = samples_per_second;
+
+  for (i32 i = 0; i < DE100_WAVETABLE_SIZE; ++i) {
+    tables->sine[i] = sinf((f32)i / (f32)DE100_WAVETABLE_SIZE * 2.0f * pi);
+  }
+  tables->sine[DE100_WAVETABLE_SIZE] = tables->sine[0];
+
+  f32 nyquist = (f32)samples_per_second * 0.5f;
+
+  for (i32 octave = 0; octave < DE100_WAVETABLE_OCTAVES; ++octave) {
+    f32 top_hz = DE100_WAVETABLE_BASE_HZ * (f32)(2 << octave);
+    i32 harmonics = (i32)(nyquist / top_hz);
+    if (harmonics > DE100_WAVETABLE_SIZE / 2 - 1) {
+      harmonics = DE100_WAVETABLE_SIZE / 2 - 1;
+    }
+    if (harmonics < 1) {
+      harmonics = 1;
+    }
+
+    f32 *square = tables->band[DE100_WAVETABLE_SQUARE][octave];
+    f32 *triangle = tables->band[DE100_WAVETABLE_TRIANGLE][octave];
+    f32 *saw = tables->band[DE100_WAVETABLE_SAWTOOTH][octave];
+    memset(square, 0, sizeof(f32) * DE100_WAVETABLE_SIZE);
+    memset(triangle, 0, sizeof(f32) * DE100_WAVETABLE_SIZE);
+    memset(saw, 0, sizeof(f32) * DE100_WAVETABLE_SIZE);
+
+    // Fourier series matching de100_audio_wave_square / _triangle /
+    // _sawtooth (same phase and polarity)
+    for (i32 k = 1; k <= harmonics; ++k) {
+      if (k & 1) {
+        de100_wavetable_add_harmonic(square, tables->sine, k,
+                                     4.0f / (pi * (f32)k));
+        f32 sign = ((k >> 1) & 1) ? -1.0f : 1.0f;
+        de100_wavetable_add_harmonic(triangle, tables->sine, k,
+                                     sign * 8.0f / (pi * pi * (f32)(k * k)));
+      }
+      de100_wavetable_add_harmonic(saw, tables->sine, k,
+                                   -2.0f / (pi * (f32)k));
+    }
+
+    square[DE100_WAVETABLE_SIZE] = square[0];
+    triangle[DE100_WAVETABLE_SIZE] = triangle[0];
+    saw[DE100_WAVETABLE_SIZE] = saw[0];
+  }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Lookup
+// ─────────────────────────────────────────────────────────────────────────────
+
+// phase in [0, 1)
+de100_file_scoped_fn inline f32 de100_wavetable_read(const f32 *table,
+                                                     f32 phase) {
+  f32 position = phase * (f32)DE100_WAVETABLE_SIZE;
+  i32 index = (i32)position;
+  f32 frac = position - (f32)index;
+  index &= DE100_WAVETABLE_SIZE - 1;
+  return table[index] + (table[index + 1] - table[index]) * frac;
+}
+
+// Octave whose band limit covers `frequency` (float exponent, no log2f)
+de100_file_scoped_fn inline i32 de100_wavetable_octave(f32 frequency) {
+  f32 ratio = frequency * (1.0f / DE100_WAVETABLE_BASE_HZ);
+  if (ratio < 1.0f) {
+    return 0;
+  }
+  u32 bits;
+  memcpy(&bits, &ratio, sizeof(bits));
+  i32 octave = (i32)((bits >> 23) & 0xFF) - 127;
+  return octave < DE100_WAVETABLE_OCTAVES ? octave
+                                          : DE100_WAVETABLE_OCTAVES - 1;
+}
+
+// One sample of `waveform` at `phase` for a note at `frequency` (Hz).
+// duty is only used by DE100_AUDIO_WAVE_PULSE.
+de100_file_scoped_fn inline f32
+de100_wavetable_sample(const De100Wavetables *tables, i32 waveform, f32 phase,
+                       f32 frequency, f32 duty) {
+  i32 octave = de100_wavetable_octave(frequency);
+  switch (waveform) {
+  case DE100_AUDIO_WAVE_SQUARE:
+    return de100_wavetable_read(tables->band[DE100_WAVETABLE_SQUARE][octave],
+                                phase);
+  case DE100_AUDIO_WAVE_TRIANGLE:
+    return de100_wavetable_read(
+        tables->band[DE100_WAVETABLE_TRIANGLE][octave], phase);
+  case DE100_AUDIO_WAVE_SAWTOOTH:
+    return de100_wavetable_read(
+        tables->band[DE100_WAVETABLE_SAWTOOTH][octave], phase);
+  case DE100_AUDIO_WAVE_PULSE: {
+    // pulse(p) = saw(p - duty) - saw(p) + (2 * duty - 1)
+    const f32 *saw = tables->band[DE100_WAVETABLE_SAWTOOTH][octave];
+    f32 shifted = phase - duty;
+    if (shifted < 0.0f) {
+      shifted += 1.0f;
+    }
+    return de100_wavetable_read(saw, shifted) -
+           de100_wavetable_read(saw, phase) + (2.0f * duty - 1.0f);
+  }
+  default:
+    return de100_wavetable_read(tables->sine, phase);
+  }
+}
+
+#endif // DE100_GAME_AUDIO_WAVETABLE_H
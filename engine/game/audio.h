@@ -61,6 +61,10 @@ typedef struct {
   i32 max_sample_count; /* Buffer capacity — never write more than this */
   void *samples;        /* Pointer to sample buffer (i16 interleaved stereo) */
   bool is_initialized;  /* Platform audio subsystem is up; safe to generate */
+  /* Stream position of samples[0]: samples generated before this call.
+   * The sample clock for anything scheduled in audio time (sequencers);
+   * the platform advances it by sample_count after each call. */
+  u64 running_sample_index;
 } GameAudioOutputBuffer;
 
 #endif /* DE100_GAME_AUDIO_H */
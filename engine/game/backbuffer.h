@@ -3,12 +3,236 @@
 
 #include "../_common/memory.h"
 
+// ═══════════════════════════════════════════════════════════════════════════
+// PIXEL FORMAT
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// The byte order the game writes is the byte order the platform uploads:
+// no swizzle anywhere, in our code or the driver's. It is fixed at compile
+// time so color packing folds to constants:
+//
+//   RGBA8  bytes R,G,B,A = 0xAABBGGRR as a u32 (default; GLES, raylib)
+//   BGRA8  bytes B,G,R,A = 0xAARRGGBB as a u32 (-DDE100_PIXEL_FORMAT=1;
+//          desktop GL's native GL_BGRA / UNSIGNED_INT_8_8_8_8_REV)
+//
+// Game, engine and asset packer must be built with the same value. The
+// platform reports the format in GameBackBuffer.pixel_format, uploads in
+// it, and logs when another one would be native for its driver.
+//
+// Alpha is the top byte in both, so blending (pixel-kernels.h) doesn't
+// care which one is active. Pack colors with DE100_PIXEL_PACK (or
+// DE100_RGBA in render-group.h), never with hand-written shifts.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define DE100_PIXEL_FORMAT_RGBA8 0
+#define DE100_PIXEL_FORMAT_BGRA8 1
+#define DE100_PIXEL_FORMAT_COUNT 2
+
+#ifndef DE100_PIXEL_FORMAT
+#define DE100_PIXEL_FORMAT DE100_PIXEL_FORMAT_RGBA8
+#endif
+
+#if DE100_PIXEL_FORMAT == DE100_PIXEL_FORMAT_BGRA8
+#define DE100_PIXEL_SHIFT_RED 16
+#define DE100_PIXEL_SHIFT_BLUE 0
+#elif DE100_PIXEL_FORMAT == DE100_PIXEL_FORMAT_RGBA8
+#define DE100_PIXEL_SHIFT_RED 0
+#define DE100_PIXEL_SHIFT_BLUE 16
+#else
+#error "DE100_PIXEL_FORMAT must be DE100_PIXEL_FORMAT_RGBA8 or _BGRA8"
+#endif
+#define DE100_PIXEL_SHIFT_GREEN 8
+#define DE100_PIXEL_SHIFT_ALPHA 24
+
+#define DE100_PIXEL_PACK(r, g, b, a)                                           \
+  (((u32)(a) << DE100_PIXEL_SHIFT_ALPHA) |                                     \
+   ((u32)(r) << DE100_PIXEL_SHIFT_RED) |                                       \
+   ((u32)(g) << DE100_PIXEL_SHIFT_GREEN) | ((u32)(b) << DE100_PIXEL_SHIFT_BLUE))
+
+#define DE100_PIXEL_RED(color) (((color) >> DE100_PIXEL_SHIFT_RED) & 0xFF)
+#define DE100_PIXEL_GREEN(color) (((color) >> DE100_PIXEL_SHIFT_GREEN) & 0xFF)
+#define DE100_PIXEL_BLUE(color) (((color) >> DE100_PIXEL_SHIFT_BLUE) & 0xFF)
+#define DE100_PIXEL_ALPHA(color) (((color) >> DE100_PIXEL_SHIFT_ALPHA) & 0xFF)
+
+// Byte offsets of each channel within a pixel (for byte-wise writers)
+#define DE100_PIXEL_BYTE_RED (DE100_PIXEL_SHIFT_RED / 8)
+#define DE100_PIXEL_BYTE_GREEN 1
+#define DE100_PIXEL_BYTE_BLUE (DE100_PIXEL_SHIFT_BLUE / 8)
+#define DE100_PIXEL_BYTE_ALPHA 3
+
+de100_file_scoped_fn inline const char *de100_pixel_format_name(int format) {
+  return format == DE100_PIXEL_FORMAT_BGRA8 ? "BGRA8" : "RGBA8";
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// DIRTY RECTANGLES
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// When `is_tracking` is set (GameConfig.prefer_dirty_rect_present), the
+// platform only uploads the regions listed here and then clears the list.
+// A frame that marks nothing uploads nothing.
+//
+// Regions come from:
+//   - the render group (every executed command marks its clipped rect)
+//   - the game, via de100_backbuffer_mark_dirty() when it writes pixels
+//     directly
+//
+// Overlapping rects are merged; when the list overflows or covers most of
+// the frame it collapses to `full_frame` (one plain full upload).
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define DE100_MAX_DIRTY_RECTS 32
+
+typedef struct {
+  int x, y;
+  int width, height;
+} De100DirtyRect;
+
+typedef struct {
+  De100DirtyRect rects[DE100_MAX_DIRTY_RECTS];
+  int count;
+  bool32 full_frame;
+  bool32 is_tracking;
+} GameDirtyRegion;
+
 typedef struct {
   De100MemoryBlock memory; // Raw pixel memory (our canvas!)
   int width;               // Current backbuffer dimensions
   int height;
   int pitch;
   int bytes_per_pixel;
+  int pixel_format; // DE100_PIXEL_FORMAT_*; always == DE100_PIXEL_FORMAT
+  GameDirtyRegion dirty;
+
+  // Set by the platform while fast-forwarding a replay seek: the frame will
+  // never be shown, so the render group skips execution. Games that write
+  // pixels directly should skip drawing too.
+  bool32 is_rendering_disabled;
 } GameBackBuffer;
 
+// Half-open pixel rectangle [min_x, max_x) x [min_y, max_y)
+typedef struct {
+  i32 min_x, min_y;
+  i32 max_x, max_y;
+} De100RenderClipRect;
+
+de100_file_scoped_fn inline void
+de100_backbuffer_mark_all_dirty(GameBackBuffer *buffer) {
+  buffer->dirty.full_frame = true;
+  buffer->dirty.count = 0;
+}
+
+de100_file_scoped_fn inline void
+de100_backbuffer_clear_dirty(GameBackBuffer *buffer) {
+  buffer->dirty.full_frame = false;
+  buffer->dirty.count = 0;
+}
+
+de100_file_scoped_fn inline bool
+de100_dirty_rects_touch(De100DirtyRect *a, De100DirtyRect *b) {
+  return a->x <= b->x + b->width && b->x <= a->x + a->width &&
+         a->y <= b->y + b->height && b->y <= a->y + a->height;
+}
+
+de100_file_scoped_fn inline void de100_dirty_rect_union(De100DirtyRect *into,
+                                                        De100DirtyRect *other) {
+  int x0 = into->x < other->x ? into->x : other->x;
+  int y0 = into->y < other->y ? into->y : other->y;
+  int x1 = into->x + into->width > other->x + other->width
+               ? into->x + into->width
+               : other->x + other->width;
+  int y1 = into->y + into->height > other->y + other->height
+               ? into->y + into->height
+               : other->y + other->height;
+  into->x = x0;
+  into->y = y0;
+  into->width = x1 - x0;
+  into->height = y1 - y0;
+}
+
+/**
+ * Record that pixels inside (x, y, width, height) changed this frame.
+ * The rect is clipped to the buffer. Cheap enough to call per primitive.
+ */
+de100_file_scoped_fn inline void de100_backbuffer_mark_dirty(
+    GameBackBuffer *buffer, int x, int y, int width, int height) {
+  GameDirtyRegion *dirty = &buffer->dirty;
+  if (dirty->full_frame) {
+    return;
+  }
+
+  int x0 = x > 0 ? x : 0;
+  int y0 = y > 0 ? y : 0;
+  int x1 = x + width < buffer->width ? x + width : buffer->width;
+  int y1 = y + height < buffer->height ? y + height : buffer->height;
+  if (x1 <= x0 || y1 <= y0) {
+    return;
+  }
+
+  De100DirtyRect rect = {x0, y0, x1 - x0, y1 - y0};
+
+  // Merge into the first rect it touches; merging may create new overlaps,
+  // so keep absorbing until the list is stable.
+  int merged_index = -1;
+  for (int i = 0; i < dirty->count; ++i) {
+    if (de100_dirty_rects_touch(&dirty->rects[i], &rect)) {
+      de100_dirty_rect_union(&dirty->rects[i], &rect);
+      merged_index = i;
+      break;
+    }
+  }
+
+  if (merged_index >= 0) {
+    for (int i = 0; i < dirty->count; ++i) {
+      if (i != merged_index &&
+          de100_dirty_rects_touch(&dirty->rects[i],
+                                  &dirty->rects[merged_index])) {
+        de100_dirty_rect_union(&dirty->rects[merged_index], &dirty->rects[i]);
+        dirty->rects[i] = dirty->rects[--dirty->count];
+        if (merged_index == dirty->count) {
+          merged_index = i;
+        }
+        i = -1; // restart scan
+      }
+    }
+  } else if (dirty->count < DE100_MAX_DIRTY_RECTS) {
+    dirty->rects[dirty->count++] = rect;
+  } else {
+    de100_backbuffer_mark_all_dirty(buffer);
+    return;
+  }
+
+  // Lots of small uploads cost more than one big one past ~half the frame
+  i64 dirty_area = 0;
+  for (int i = 0; i < dirty->count; ++i) {
+    dirty_area += (i64)dirty->rects[i].width * dirty->rects[i].height;
+  }
+  if (dirty_area * 2 > (i64)buffer->width * buffer->height) {
+    de100_backbuffer_mark_all_dirty(buffer);
+  }
+}
+
+/**
+ * A GameBackBuffer over pixels someone else owns (a standalone game's own
+ * canvas), for the raster and render-group code. 32-bit pixels in
+ * DE100_PIXEL_FORMAT; `pitch` in bytes. Nothing is tracked: the view
+ * starts (and stays) full-frame dirty, so marking costs one branch.
+ */
+de100_file_scoped_fn inline GameBackBuffer
+de100_backbuffer_view(void *pixels, int width, int height, int pitch) {
+  GameBackBuffer view = {0};
+  view.memory.base = pixels;
+  view.memory.size = (size_t)pitch * (size_t)height;
+  view.memory.is_valid = pixels != NULL;
+  view.width = width;
+  view.height = height;
+  view.pitch = pitch;
+  view.bytes_per_pixel = 4;
+  view.pixel_format = DE100_PIXEL_FORMAT;
+  view.dirty.full_frame = true;
+  return view;
+}
+
 #endif // DE100_GAME_BACKBUFFER_H
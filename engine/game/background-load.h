@@ -0,0 +1,106 @@
+#ifndef DE100_GAME_BACKGROUND_LOAD_H
+#define DE100_GAME_BACKGROUND_LOAD_H
+
+#include "../_common/base.h"
+#include "thread.h"
+
+// ═══════════════════════════════════════════════════════════════════════════
+// BACKGROUND LOADS
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// Long-running work (decoding an atlas, building a level) that spans
+// frames. The frame work queue can't take it: complete_all_work() would
+// block the frame on it. The platform runs these on a separate low-priority
+// pool instead; the game submits a task and polls its status:
+//
+//   DE100_BACKGROUND_LOAD_CALLBACK(decode_atlas) {
+//     Atlas *atlas = (Atlas *)task->data;
+//     for (i32 row = 0; row < atlas->rows; ++row) {
+//       if (de100_background_load_should_cancel(task)) {
+//         return false;
+//       }
+//       ...
+//     }
+//     return true;
+//   }
+//
+//   state->atlas_load = (De100BackgroundLoad){
+//       .callback = decode_atlas,
+//       .data = &state->atlas,
+//   };
+//   memory->background_load_submit(memory->background_loader,
+//                                  &state->atlas_load);
+//   ...
+//   if (de100_background_load_is_done(&state->atlas_load)) { ... }
+//
+// Several submitted tasks decode concurrently, one per loader thread.
+// Submit from GAME_INIT to overlap them with the first frames.
+//
+// Hot reload: before the old library is unloaded every task is cancelled
+// and the platform waits until none is running, because `callback` lives
+// in that library. Cancelled tasks end as CANCELLED; resubmit them after
+// the reload (the callback pointer must be refreshed anyway). Long
+// callbacks should check should_cancel() so a reload doesn't stall.
+//
+// The task and `data` must stay valid until the task is done; keep them in
+// game memory.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+typedef struct De100BackgroundLoader De100BackgroundLoader;
+
+typedef enum {
+  DE100_BACKGROUND_LOAD_STATUS_IDLE = 0, // Never submitted
+  DE100_BACKGROUND_LOAD_STATUS_QUEUED,
+  DE100_BACKGROUND_LOAD_STATUS_RUNNING,
+  DE100_BACKGROUND_LOAD_STATUS_COMPLETE,
+  DE100_BACKGROUND_LOAD_STATUS_FAILED, // Callback returned false
+  DE100_BACKGROUND_LOAD_STATUS_CANCELLED,
+
+  DE100_BACKGROUND_LOAD_STATUS_COUNT
+} De100BackgroundLoadStatus;
+
+typedef struct De100BackgroundLoad De100BackgroundLoad;
+
+// Runs on a loader thread; `thread_context->scratch_arena` is released when
+// it returns. Return false on failure.
+#define DE100_BACKGROUND_LOAD_CALLBACK(name)                                   \
+  bool name(ThreadContext *thread_context, De100BackgroundLoad *task)
+typedef DE100_BACKGROUND_LOAD_CALLBACK(de100_background_load_callback_t);
+
+struct De100BackgroundLoad {
+  // Filled by the game
+  de100_background_load_callback_t *callback;
+  void *data;
+
+  // Managed by the platform (atomic)
+  u32 status; // De100BackgroundLoadStatus
+  u32 cancel_requested;
+};
+
+// Queues the task (status becomes QUEUED). Returns false, status FAILED,
+// if the loader is full or the task is still in flight.
+#define DE100_PLATFORM_BACKGROUND_LOAD_SUBMIT(name)                            \
+  bool name(De100BackgroundLoader *loader, De100BackgroundLoad *task)
+typedef DE100_PLATFORM_BACKGROUND_LOAD_SUBMIT(
+    de100_platform_background_load_submit_t);
+
+de100_file_scoped_fn inline bool
+de100_background_load_is_done(const De100BackgroundLoad *task) {
+  u32 status = __atomic_load_n(&task->status, __ATOMIC_ACQUIRE);
+  return status >= DE100_BACKGROUND_LOAD_STATUS_COMPLETE;
+}
+
+// Ask a queued or running task to stop. A queued task never starts; a
+// running one stops at its next should_cancel() check.
+de100_file_scoped_fn inline void
+de100_background_load_cancel(De100BackgroundLoad *task) {
+  __atomic_store_n(&task->cancel_requested, 1, __ATOMIC_RELEASE);
+}
+
+de100_file_scoped_fn inline bool
+de100_background_load_should_cancel(const De100BackgroundLoad *task) {
+  return __atomic_load_n(&task->cancel_requested, __ATOMIC_ACQUIRE) != 0;
+}
+
+#endif // DE100_GAME_BACKGROUND_LOAD_H
@@ -10,6 +10,11 @@ GameConfig get_default_game_config(void) {
 
   config.permanent_storage_size = MEGABYTES(64);
   config.transient_storage_size = GIGABYTES(1);
+  config.prefer_large_pages = false;
+  config.prefault_game_memory = false;
+  config.prefer_numa_local_memory = false;
+  config.frame_arena_size = MEGABYTES(4);
+  config.prefer_lazy_transient_commit = false;
 
   /* =========================
      GAME / BUILD FLAGS
@@ -29,15 +34,48 @@ GameConfig get_default_game_config(void) {
   config.prefer_borderless = false;
   config.prefer_resizable = true;
   config.prefer_adaptive_fps = false;
+  config.prefer_dynamic_resolution = false;
+  config.dynamic_resolution_min_width = 0;
+  config.dynamic_resolution_min_height = 0;
+  config.prefer_vblank_present_timing = false;
+  config.prefer_mapped_backbuffer = false;
+  config.prefer_present_thread = false;
+  config.prefer_shm_present = false;
+  config.prefer_dirty_rect_present = false;
+  config.prefer_present_texture_ring = false;
+  config.prefer_scaled_present = false;
+  config.prefer_integer_scaling = true;
+  config.prefer_core_profile_present = false;
+  config.present_scanline_intensity = 0.0f;
 
   strncpy(config.window_title, "DE100", sizeof(config.window_title) - 1);
   config.window_title[sizeof(config.window_title) - 1] = '\0';
 
+  /* =========================
+     THREADING
+     ========================= */
+
+  config.worker_thread_count = 0;
+
+  /* =========================
+     REPLAY
+     ========================= */
+
+  config.prefer_incremental_replay_snapshots = false;
+  config.prefer_async_replay_snapshots = false;
+  config.transient_storage_is_disposable = false;
+  config.replay_keyframe_interval_seconds = 5.0f;
+  config.replay_state_hash_interval_frames = 60;
+  config.rewind_seconds = 0.0f;
+  config.rewind_log_megabytes = 64;
+
   /* =========================
      INPUT
      ========================= */
 
   config.max_controllers = 5;
+  config.prefer_threaded_joystick = false;
+  config.prefer_raw_mouse_input = false;
 
   /* =========================
      AUDIO
@@ -46,6 +84,10 @@ GameConfig get_default_game_config(void) {
   config.initial_audio_sample_rate = 48000;
   config.audio_buffer_size_frames = 1024;
   config.audio_game_update_hz = 30;
+  config.prefer_threaded_audio = false;
+  config.prefer_adaptive_audio_latency = false;
+  config.prefer_mmap_audio = false;
+  config.prefer_audio_server = false;
 
   /* =========================
      TIMING
@@ -53,6 +95,14 @@ GameConfig get_default_game_config(void) {
 
   config.target_seconds_per_frame =
       1.0f / (f32)config.max_allowed_refresh_rate_hz;
+  config.prefer_high_res_frame_timer = false;
+  config.prefer_event_loop = false;
+  config.prefer_late_input_latch = false;
+  config.prefer_background_throttle = false;
+  config.background_fps = 10;
+  config.fixed_update_hz = 0;
+  config.max_updates_per_frame = 8;
+  config.prefer_pipelined_render = false;
 
   return config;
 }
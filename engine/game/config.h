@@ -3,6 +3,20 @@
 
 #include "../_common/base.h"
 
+#define DE100_GAME_MAX_MODULES 8
+
+/**
+ * An extra game library, reloaded on its own (see GameModuleRegistry in
+ * game-loader.h). The library is lib<name>.so in the game build directory
+ * and exports `<name>_module_get_api` (GAME_MODULE_GET_API).
+ */
+typedef struct {
+  const char *name; // NULL = unused slot
+  // DE100_HOT_RELOAD=0 builds link the module into the executable: point
+  // this at its <name>_module_get_api (ignored when hot reloading)
+  const void *(*linked_get_api)(void);
+} GameModuleConfig;
+
 /**
  * @brief Describes the configuration and preferences for a specific game.
  *
@@ -24,6 +38,33 @@ typedef struct {
    * in bytes */
   u64 transient_storage_size;
 
+  /** Back game memory with 2 MB pages (hugetlbfs/THP, or MEM_LARGE_PAGES
+   * on Windows) to cut TLB misses over the arenas. Ignored while
+   * incremental replay snapshots are on (they protect 4 KB pages).
+   */
+  bool prefer_large_pages;
+
+  /** Touch every page of game memory at startup so no first-touch page
+   * fault lands inside a frame. Costs startup time and resident memory.
+   */
+  bool prefault_game_memory;
+
+  /** Place game memory on the NUMA node of the thread that allocates it */
+  bool prefer_numa_local_memory;
+
+  /** Size of each of the two per-frame arenas (GameMemory.frame_arena),
+   * carved from the start of transient storage. 0 disables them.
+   */
+  u64 frame_arena_size;
+
+  /** Reserve transient storage instead of committing it: arenas made with
+   * de100_arena_init_from_transient commit pages as they grow and return
+   * them on reset, so a large transient budget costs only what is used.
+   * Transient storage must then only be touched through those arenas.
+   * Ignored with large pages.
+   */
+  bool prefer_lazy_transient_commit;
+
   /* =========================
      GAME / BUILD FLAGS
      ========================= */
@@ -64,6 +105,153 @@ typedef struct {
   /** Request adaptive frame pacing if possible */
   bool prefer_adaptive_fps;
 
+  /** Shrink the backbuffer while frames run over budget and grow it back
+   * when there is headroom, stretching it over the same screen rect
+   * (implies prefer_scaled_present; X11 and raylib only). The game must
+   * draw from the backbuffer's current size every frame. See
+   * platforms/_common/dynamic-resolution.h.
+   */
+  bool prefer_dynamic_resolution;
+
+  /** Smallest backbuffer prefer_dynamic_resolution may pick (0 = half the
+   * initial size). The initial size is the largest.
+   */
+  u32 dynamic_resolution_min_width;
+  u32 dynamic_resolution_min_height;
+
+  /** Pace frames on the display instead of sleeping: the swap interval
+   * covers the target frame time and vblank timestamps (when the platform
+   * reports them) become the measured frame time for adaptive FPS.
+   * Falls back to sleep pacing without swap control.
+   */
+  bool prefer_vblank_present_timing;
+
+  /** Let the platform point the backbuffer at GPU-mapped upload memory.
+   * Only safe if the game redraws every pixel each frame and never reads
+   * the backbuffer back (mapped memory is write-combined and rotates).
+   */
+  bool prefer_mapped_backbuffer;
+
+  /** Upload, swap and wait for the flip on a dedicated thread that owns
+   * the GL context, so a blocking swap never delays the game thread. Each
+   * frame is copied into a mailbox (newest frame wins); the game thread
+   * paces itself with sleeps. Overrides prefer_mapped_backbuffer and
+   * prefer_late_input_latch (X11 only; see
+   * platforms/_common/present-thread.h).
+   */
+  bool prefer_present_thread;
+
+  /** Present with MIT-SHM XShmPutImage instead of OpenGL: the server
+   * reads the pixels from shared memory, no GL needed. Used anyway when
+   * GLX is missing or fails. No scaling, no vblank timing, no present
+   * thread; prefer_mapped_backbuffer renders straight into the segment
+   * (X11 only; see platforms/x11/shm-present.h).
+   */
+  bool prefer_shm_present;
+
+  /** Only upload the backbuffer regions marked dirty each frame (see
+   * GameDirtyRegion in backbuffer.h). Ideal for grid/board games that
+   * repaint a few cells per frame.
+   */
+  bool prefer_dirty_rect_present;
+
+  /** Upload each frame into the next texture of a ring of three, so the
+   * upload never waits on the GPU still drawing the previous one, and pace
+   * from measured present times instead of the window library's own sleep
+   * (raylib only). Every ring texture takes full-frame uploads, so this
+   * overrides prefer_dirty_rect_present.
+   */
+  bool prefer_present_texture_ring;
+
+  /** Stretch the backbuffer over the window on the GPU (nearest filtering)
+   * with black bars keeping its aspect ratio, instead of centering it at
+   * native size. The game keeps rendering at backbuffer size, so CPU fill
+   * cost doesn't grow with the window. Mouse positions are reported in
+   * backbuffer pixels while this is on.
+   */
+  bool prefer_scaled_present;
+
+  /** With prefer_scaled_present, only scale by whole multiples so every
+   * game pixel covers the same number of screen pixels (wider bars).
+   * Windows smaller than the backbuffer still shrink it to fit.
+   */
+  bool prefer_integer_scaling;
+
+  /** Present through a core-profile context (GL 3.3, else GLES 3.0): one
+   * full-screen triangle and a small shader that swizzles and scales the
+   * backbuffer texture, instead of fixed-function immediate mode. Falls
+   * back to the legacy context when neither can be created (X11 only).
+   */
+  bool prefer_core_profile_present;
+
+  /** Darken the lower half of every backbuffer row on screen (0 = off,
+   * 1 = black gaps). Done by the core-profile presenter's shader, so it
+   * costs no CPU time; ignored by the legacy presenter.
+   */
+  f32 present_scanline_intensity;
+
+  /* =========================
+     CODE MODULES
+     ========================= */
+
+  /** Libraries besides the main one (AI, rendering, synth, ...), each
+   * rebuilt and hot-reloaded independently of the others. The game reads
+   * each one's function table from GameMemory.modules[i], indexed like
+   * this array.
+   */
+  GameModuleConfig modules[DE100_GAME_MAX_MODULES];
+
+  /* =========================
+     THREADING
+     ========================= */
+
+  /** Worker threads for the work queue (0 = one per core minus main) */
+  u32 worker_thread_count;
+
+  /* =========================
+     REPLAY (LOOPED LIVE EDITING)
+     ========================= */
+
+  /** Snapshot only pages written since the last save/restore, using page
+   * write-protection. Makes looping restores cost O(touched memory).
+   */
+  bool prefer_incremental_replay_snapshots;
+
+  /** Take the first (full) snapshot fork-style on a background thread so
+   * starting a recording doesn't hitch. Implies incremental snapshots.
+   */
+  bool prefer_async_replay_snapshots;
+
+  /** Transient storage holds nothing that must survive a replay loop, so
+   * snapshots cover permanent storage only. The game must rebuild its
+   * transient data after a restore (e.g. on a memory-version mismatch).
+   */
+  bool transient_storage_is_disposable;
+
+  /** Seconds between in-memory keyframes captured while recording, so
+   * playback can seek to any frame by restoring the nearest keyframe and
+   * fast-forwarding (0 disables keyframes; seeks replay from frame 0).
+   */
+  float replay_keyframe_interval_seconds;
+
+  /** Frames between permanent-storage hashes written into input
+   * recordings; playback reports the first frame whose state differs
+   * (1 = every frame, 0 disables). Cheap with incremental snapshots,
+   * which rehash only the pages written since the last save/restore.
+   */
+  u32 replay_state_hash_interval_frames;
+
+  /** Seconds of gameplay kept for rewind: holding the rewind key (F6)
+   * steps back one frame per frame (0 disables). Each frame logs only the
+   * pages it wrote, so this needs incremental replay snapshots.
+   */
+  float rewind_seconds;
+
+  /** Page history the rewind ring may hold; rewind reaches back
+   * rewind_seconds or as far as this allows, whichever is less.
+   */
+  u32 rewind_log_megabytes;
+
   /* =========================
      INPUT REQUIREMENTS
      ========================= */
@@ -71,6 +259,19 @@ typedef struct {
   /** Maximum number of controllers the game intends to support */
   u32 max_controllers;
 
+  /** Read gamepads on a background thread (epoll over evdev, inotify
+   * hotplug) and hand the frame a lock-free snapshot, instead of polling
+   * devices on the frame thread (X11 only; see inputs/evdev.h).
+   */
+  bool prefer_threaded_joystick;
+
+  /** Take mouse motion from unaccelerated device events (XInput2
+   * XI_RawMotion) into GameInput.mouse_dx/dy, at the device's full
+   * report rate instead of coalesced pointer motion (X11 only; other
+   * backends fill mouse_dx/dy from their own deltas).
+   */
+  bool prefer_raw_mouse_input;
+
   /* =========================
      AUDIO REQUIREMENTS
      ========================= */
@@ -84,6 +285,29 @@ typedef struct {
   /** Game update rate for audio calculations (Hz) */
   u32 audio_game_update_hz;
 
+  /** Feed the device from a dedicated audio thread through a lock-free
+   * ring, so a slow frame drains the ring instead of underrunning the
+   * device (X11/ALSA; other backends ignore it).
+   */
+  bool prefer_threaded_audio;
+
+  /** Size the audio write-ahead from measured write jitter and underruns
+   * instead of a fixed 2 frames + safety (X11/ALSA; others ignore it).
+   */
+  bool prefer_adaptive_audio_latency;
+
+  /** Write into the device's mmap'd ring (game renders in place when the
+   * device takes 16-bit; float devices convert on copy), falling back to
+   * snd_pcm_writei if the device can't (X11/ALSA; others ignore it).
+   */
+  bool prefer_mmap_audio;
+
+  /** Play through the desktop sound server (PulseAudio, or PipeWire's
+   * pulse server) when one is running instead of ALSA, falling back to
+   * ALSA when it isn't (X11/DRM/Wayland; others ignore it).
+   */
+  bool prefer_audio_server;
+
   /* =========================
      TIMING INTENT
      ========================= */
@@ -91,6 +315,52 @@ typedef struct {
   /** Desired simulation timestep in seconds per frame */
   float target_seconds_per_frame;
 
+  /** Fixed simulation rate in Hz for games exporting game_update +
+   * game_render (0 = one update_and_render per displayed frame).
+   */
+  u32 fixed_update_hz;
+
+  /** Most game_update ticks per frame before time is dropped */
+  u32 max_updates_per_frame;
+
+  /** Rasterize frame N's render group on the workers while frame N+1's
+   * game_update runs (adds one frame of latency). Needs the fixed-timestep
+   * pair and a game_render that records into memory->render_group.
+   */
+  bool prefer_pipelined_render;
+
+  /** Pace frames with one absolute high-resolution timer sleep and a
+   * learned sub-millisecond spin, instead of 1ms sleeps plus a 3ms spin.
+   * Frees most of a core per instance, at the cost of trusting the OS
+   * timer (clock_nanosleep / high-resolution waitable timers).
+   */
+  bool prefer_high_res_frame_timer;
+
+  /** Wait out sleep-paced frames in one epoll_wait on a deadline timerfd,
+   * the X connection and the gamepad reader, instead of sleeping and
+   * spinning; background-throttled frames also end early on input. Idle
+   * CPU drops to ~0 (X11 only; falls back to sleeping if epoll fails).
+   */
+  bool prefer_event_loop;
+
+  /** When frames are paced by display flips, sleep until just before the
+   * swap is due and only then sample input and simulate, instead of right
+   * after the previous flip. Cuts up to a frame of input-to-photon
+   * latency; a bad work prediction costs a missed flip (X11 only).
+   */
+  bool prefer_late_input_latch;
+
+  /** Throttle to background_fps while the window is unfocused, and also
+   * skip render and present while it is hidden (minimized, fully
+   * obscured, or on another workspace). Fixed-timestep games keep
+   * simulating at their tick rate and audio keeps playing; the
+   * write-ahead stretches to cover the longer frames (X11 only).
+   */
+  bool prefer_background_throttle;
+
+  /** Frame rate while throttled (prefer_background_throttle) */
+  u32 background_fps;
+
   char window_title[64];
 
 } GameConfig;
@@ -17,11 +17,12 @@
 //   - Hot reload file checks
 //
 // This module uses the common APIs:
-//   - file.h: de100_file_exists(), de100_file_get_size(), de100_file_strerror()
+//   - file.h: de100_file_stat(), de100_file_strerror()
 //   - memory.h: de100_memory_alloc(), de100_memory_free(),
 //   de100_memory_error_str()
 //
-// For production file I/O, use the proper asset loading system.
+// For production file I/O, use de100_file_load() (file-load.h): it reads
+// into an arena you own, with 64-bit sizes and read-ahead hints.
 //
 // Casey's Day 15 pattern:
 //   De100DebugDe100FileReadResult file =
@@ -75,7 +76,7 @@ typedef struct {
 /**
  * Read an entire file into memory.
  *
- * Uses de100_file_get_size() to determine size, then allocates via
+ * Uses de100_file_stat() to determine size, then allocates via
  * de100_memory_alloc().
  *
  * @param filename Path to the file to read
@@ -0,0 +1,744 @@
+#ifndef DE100_GAME_ECS_H
+#define DE100_GAME_ECS_H
+
+#include "../_common/base.h"
+#include "memory-arena.h"
+#include "memory.h"
+#include "thread.h"
+
+#include <string.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// 🧱 ECS (archetype chunks, queries, parallel systems)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// For games that outgrow one entity pool per kind (entity-pool.h): an
+// entity is a handle plus any set of components, and every entity with
+// the same set (its ARCHETYPE) lives in the same fixed-size chunks, one
+// dense column per component:
+//
+//   typedef struct { f32 x, y; } Position;
+//   typedef struct { f32 x, y; } Velocity;
+//
+//   de100_ecs_init(&state->world, &state->world_arena, 4096, 32);
+//   state->c_position = DE100_ECS_REGISTER(&state->world, Position);
+//   state->c_velocity = DE100_ECS_REGISTER(&state->world, Velocity);
+//
+//   De100EcsEntity e = de100_ecs_spawn(
+//       &state->world, DE100_ECS_BIT(state->c_position) |
+//                          DE100_ECS_BIT(state->c_velocity));
+//   DE100_ECS_GET(&state->world, e, Position, state->c_position)->x = 10;
+//
+//   De100EcsIter it = de100_ecs_query(&state->world, all_mask, none_mask);
+//   while (de100_ecs_next(&it)) {
+//     Position *p = DE100_ECS_COLUMN(&it.view, Position, state->c_position);
+//     Velocity *v = DE100_ECS_COLUMN(&it.view, Velocity, state->c_velocity);
+//     for (u32 i = 0; i < it.view.count; ++i) {
+//       p[i].x += v[i].x * dt;
+//     }
+//   }
+//
+// Chunks are DE100_ECS_CHUNK_SIZE bytes; rows per chunk depend on the
+// archetype's total component size. Every chunk of an archetype but the
+// last is full: destroy() and archetype moves fill the hole with the
+// archetype's last row, so rows move and only handles are stable. Adding
+// or removing a component moves the entity to the matching archetype,
+// copying what both share; new components start zeroed.
+//
+// Systems declare the query they iterate and the components they read
+// and write. run_systems() groups consecutive systems whose sets don't
+// conflict into phases and queues one work entry per (system, chunk);
+// each phase completes before the next starts, so a system always sees
+// the writes of every earlier conflicting system, on any thread count.
+// A system may only write the rows of the chunk it was handed; anything
+// else (game state, sounds, spawning) belongs in a `main_thread` system,
+// which gets a phase to itself. Structural changes (spawn, destroy,
+// add, remove) are main-thread only and not allowed during a run:
+// collect handles and apply them afterwards.
+//
+// Storage: the world's tables are pushed from the arena at init and
+// chunks on demand, so with a permanent-storage arena every component is
+// in game memory and replay snapshots, rewind and hot reload keep it.
+// Chunks are never returned to the arena; an archetype's emptied chunks
+// are reused by its next spawns.
+//
+// All functions are static inline for zero overhead if unused.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define DE100_ECS_MAX_COMPONENTS 64
+#define DE100_ECS_INDEX_BITS 20
+#define DE100_ECS_MAX_ENTITIES (1u << DE100_ECS_INDEX_BITS)
+#define DE100_ECS_SLOT_MASK (DE100_ECS_MAX_ENTITIES - 1)
+#define DE100_ECS_GENERATION_MASK ((1u << (32 - DE100_ECS_INDEX_BITS)) - 1)
+#define DE100_ECS_ENTITY_NULL 0u
+#define DE100_ECS_CHUNK_SIZE KILOBYTES(16)
+#define DE100_ECS_CHUNK_ALIGNMENT 64
+#define DE100_ECS_NO_COLUMN 0xFFFFFFFFu
+#define DE100_ECS_NO_COMPONENT 0xFFFFFFFFu
+
+#define DE100_ECS_BIT(component) (1ull << (component))
+
+typedef u32 De100EcsEntity; // (generation << DE100_ECS_INDEX_BITS) | slot
+typedef u64 De100EcsMask;   // One bit per registered component
+
+typedef struct De100EcsChunk De100EcsChunk;
+struct De100EcsChunk {
+  De100EcsChunk *prev, *next; // Archetype's chunks, in creation order
+  u32 count;                  // Live rows [0, count)
+  u32 archetype;
+  // Columns at De100EcsArchetype.column_offset
+  _Alignas(DE100_ECS_CHUNK_ALIGNMENT) u8 data[];
+};
+
+typedef struct {
+  De100EcsMask mask;
+  u32 rows_per_chunk;
+  u32 count; // Live entities over all chunks
+  u32 chunk_count;
+  u32 entity_offset; // Column of De100EcsEntity, one per row
+  u32 column_offset[DE100_ECS_MAX_COMPONENTS]; // Or DE100_ECS_NO_COLUMN
+  De100EcsChunk *first;
+  De100EcsChunk *tail; // Last chunk with rows (or `first`)
+} De100EcsArchetype;
+
+// Where a slot's entity lives
+typedef struct {
+  De100EcsChunk *chunk; // NULL while the slot is free
+  u32 row;
+  u16 generation; // Never 0 once used
+  u16 archetype;
+} De100EcsRecord;
+
+typedef struct {
+  De100MemoryArena *arena; // Chunks are pushed on demand
+
+  u32 component_count;
+  u32 component_size[DE100_ECS_MAX_COMPONENTS];
+  u32 component_align[DE100_ECS_MAX_COMPONENTS];
+
+  De100EcsArchetype *archetypes;
+  u32 archetype_count;
+  u32 max_archetypes;
+
+  De100EcsRecord *records; // [slot]
+  u32 *free_slots;         // Stack of retired slots
+  u32 capacity;
+  u32 slot_count; // Slots ever handed out (high water)
+  u32 free_count;
+  u32 count; // Live entities
+  bool32 is_running; // Inside run_systems(): no structural changes
+} De100EcsWorld;
+
+// One chunk's worth of a query: `count` rows
+typedef struct {
+  De100EcsWorld *world;
+  De100EcsArchetype *archetype;
+  De100EcsChunk *chunk;
+  u32 count;
+  const De100EcsEntity *entities; // [row]
+} De100EcsView;
+
+typedef struct {
+  De100EcsView view;
+  De100EcsMask all, none;
+  u32 next_archetype;
+} De100EcsIter;
+
+#define DE100_ECS_SYSTEM(name) void name(De100EcsView *view, void *data)
+typedef DE100_ECS_SYSTEM(de100_ecs_system_fn_t);
+
+typedef struct {
+  const char *name;
+  de100_ecs_system_fn_t *run; // Once per matching chunk
+  void *data;
+  De100EcsMask all, none;     // Query: chunks with all and none of these
+  De100EcsMask reads, writes; // Components touched (writes imply reads)
+  bool32 main_thread;         // Own phase, chunks in order, main thread
+} De100EcsSystem;
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Internals
+// ─────────────────────────────────────────────────────────────────────────────
+
+de100_file_scoped_fn inline u32 de100_ecs_align_up(u32 value, u32 align) {
+  return (value + align - 1) & ~(align - 1);
+}
+
+de100_file_scoped_fn inline u32 de100_ecs_entity_slot(De100EcsEntity e) {
+  return e & DE100_ECS_SLOT_MASK;
+}
+
+de100_file_scoped_fn inline u8 *
+de100_ecs_cell(const De100EcsWorld *world, const De100EcsArchetype *arch,
+               De100EcsChunk *chunk, u32 component, u32 row) {
+  return chunk->data + arch->column_offset[component] +
+         (u64)row * world->component_size[component];
+}
+
+de100_file_scoped_fn inline De100EcsEntity *
+de100_ecs_chunk_entities(const De100EcsArchetype *arch, De100EcsChunk *chunk) {
+  return (De100EcsEntity *)(chunk->data + arch->entity_offset);
+}
+
+// Record of a live entity, or NULL for a stale/null handle
+de100_file_scoped_fn inline De100EcsRecord *
+de100_ecs_record(const De100EcsWorld *world, De100EcsEntity e) {
+  u32 slot = de100_ecs_entity_slot(e);
+  if (e == DE100_ECS_ENTITY_NULL || slot >= world->slot_count) {
+    return NULL;
+  }
+  De100EcsRecord *record = &world->records[slot];
+  if (!record->chunk ||
+      record->generation != (e >> DE100_ECS_INDEX_BITS)) {
+    return NULL;
+  }
+  return record;
+}
+
+// Lay out columns for `rows` rows; false if they don't fit a chunk
+de100_file_scoped_fn inline bool
+de100_ecs_layout(const De100EcsWorld *world, De100EcsArchetype *arch,
+                 u32 rows) {
+  u32 capacity = DE100_ECS_CHUNK_SIZE - (u32)sizeof(De100EcsChunk);
+  u32 offset = 0;
+  arch->entity_offset = 0;
+  offset += rows * (u32)sizeof(De100EcsEntity);
+  for (u32 c = 0; c < world->component_count; ++c) {
+    if (!(arch->mask & DE100_ECS_BIT(c))) {
+      continue;
+    }
+    offset = de100_ecs_align_up(offset, world->component_align[c]);
+    arch->column_offset[c] = offset;
+    offset += rows * world->component_size[c];
+  }
+  return offset <= capacity;
+}
+
+// Archetype index for `mask`, created on first use; -1 when full
+de100_file_scoped_fn inline i32 de100_ecs_archetype(De100EcsWorld *world,
+                                                    De100EcsMask mask) {
+  for (u32 i = 0; i < world->archetype_count; ++i) {
+    if (world->archetypes[i].mask == mask) {
+      return (i32)i;
+    }
+  }
+  DEV_ASSERT_MSG(world->archetype_count < world->max_archetypes,
+                 "ECS out of archetypes (%u)", world->max_archetypes);
+  if (world->archetype_count >= world->max_archetypes) {
+    return -1;
+  }
+
+  De100EcsArchetype *arch = &world->archetypes[world->archetype_count];
+  *arch = (De100EcsArchetype){.mask = mask};
+  for (u32 c = 0; c < DE100_ECS_MAX_COMPONENTS; ++c) {
+    arch->column_offset[c] = DE100_ECS_NO_COLUMN;
+  }
+
+  // Upper bound from the row size, then back off for alignment padding
+  u32 row_size = (u32)sizeof(De100EcsEntity);
+  for (u32 c = 0; c < world->component_count; ++c) {
+    if (mask & DE100_ECS_BIT(c)) {
+      row_size += world->component_size[c];
+    }
+  }
+  u32 rows = (DE100_ECS_CHUNK_SIZE - (u32)sizeof(De100EcsChunk)) / row_size;
+  while (rows > 0 && !de100_ecs_layout(world, arch, rows)) {
+    --rows;
+  }
+  DEV_ASSERT_MSG(rows > 0, "ECS archetype 0x%llx too big for a chunk",
+                 (unsigned long long)mask);
+  if (rows == 0) {
+    return -1;
+  }
+  arch->rows_per_chunk = rows;
+  return (i32)world->archetype_count++;
+}
+
+// Append a row to `arch`; the chunk may be new. NULL when out of memory.
+de100_file_scoped_fn inline De100EcsChunk *
+de100_ecs_push_row(De100EcsWorld *world, u32 archetype, u32 *out_row) {
+  De100EcsArchetype *arch = &world->archetypes[archetype];
+  De100EcsChunk *chunk = arch->tail;
+  if (chunk && chunk->count == arch->rows_per_chunk) {
+    chunk = chunk->next; // Emptied earlier, or NULL
+    if (chunk) {
+      arch->tail = chunk;
+    }
+  }
+  if (!chunk || chunk->count == arch->rows_per_chunk) {
+    chunk = (De100EcsChunk *)de100_arena_push_size_aligned(
+        world->arena, DE100_ECS_CHUNK_SIZE, DE100_ECS_CHUNK_ALIGNMENT);
+    if (!chunk) {
+      return NULL;
+    }
+    *chunk = (De100EcsChunk){.prev = arch->tail, .archetype = archetype};
+    if (arch->tail) {
+      arch->tail->next = chunk;
+    } else {
+      arch->first = chunk;
+    }
+    arch->tail = chunk;
+    arch->chunk_count++;
+  }
+  *out_row = chunk->count++;
+  arch->count++;
+  return chunk;
+}
+
+// Fill (chunk, row) with the archetype's last row and drop the last row
+de100_file_scoped_fn inline void de100_ecs_pop_row(De100EcsWorld *world,
+                                                   u32 archetype,
+                                                   De100EcsChunk *chunk,
+                                                   u32 row) {
+  De100EcsArchetype *arch = &world->archetypes[archetype];
+  De100EcsChunk *tail = arch->tail;
+  u32 last = tail->count - 1;
+  if (tail != chunk || last != row) {
+    for (u32 c = 0; c < world->component_count; ++c) {
+      if (arch->mask & DE100_ECS_BIT(c)) {
+        memcpy(de100_ecs_cell(world, arch, chunk, c, row),
+               de100_ecs_cell(world, arch, tail, c, last),
+               world->component_size[c]);
+      }
+    }
+    De100EcsEntity moved = de100_ecs_chunk_entities(arch, tail)[last];
+    de100_ecs_chunk_entities(arch, chunk)[row] = moved;
+    De100EcsRecord *record = &world->records[de100_ecs_entity_slot(moved)];
+    record->chunk = chunk;
+    record->row = row;
+  }
+  tail->count--;
+  arch->count--;
+  if (tail->count == 0 && tail->prev) {
+    arch->tail = tail->prev;
+  }
+}
+
+// Move an entity to `archetype`, keeping shared components and zeroing
+// new ones. False when out of memory (the entity stays where it was).
+de100_file_scoped_fn inline bool de100_ecs_move(De100EcsWorld *world,
+                                                De100EcsEntity e,
+                                                De100EcsRecord *record,
+                                                u32 archetype) {
+  DEV_ASSERT_MSG(!world->is_running, "%s",
+                 "ECS structural change during run_systems");
+  u32 row;
+  De100EcsChunk *chunk = de100_ecs_push_row(world, archetype, &row);
+  if (!chunk) {
+    return false;
+  }
+  const De100EcsArchetype *from = &world->archetypes[record->archetype];
+  const De100EcsArchetype *to = &world->archetypes[archetype];
+  for (u32 c = 0; c < world->component_count; ++c) {
+    if (!(to->mask & DE100_ECS_BIT(c))) {
+      continue;
+    }
+    u8 *cell = de100_ecs_cell(world, to, chunk, c, row);
+    if (from->mask & DE100_ECS_BIT(c)) {
+      memcpy(cell,
+             de100_ecs_cell(world, from, record->chunk, c, record->row),
+             world->component_size[c]);
+    } else {
+      memset(cell, 0, world->component_size[c]);
+    }
+  }
+  de100_ecs_chunk_entities(to, chunk)[row] = e;
+
+  // Popping may move another entity into the old row; ours has left it
+  De100EcsChunk *old_chunk = record->chunk;
+  u32 old_row = record->row;
+  u32 old_archetype = record->archetype;
+  record->chunk = chunk;
+  record->row = row;
+  record->archetype = (u16)archetype;
+  de100_ecs_pop_row(world, old_archetype, old_chunk, old_row);
+  return true;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// World
+// ─────────────────────────────────────────────────────────────────────────────
+
+/**
+ * Room for `capacity` entities in up to `max_archetypes` distinct
+ * component sets. `arena` must outlive the world (chunks come from it).
+ */
+de100_file_scoped_fn inline bool de100_ecs_init(De100EcsWorld *world,
+                                                De100MemoryArena *arena,
+                                                u32 capacity,
+                                                u32 max_archetypes) {
+  DEV_ASSERT_MSG(capacity > 0 && capacity <= DE100_ECS_MAX_ENTITIES,
+                 "ECS capacity %u out of range", capacity);
+  *world = (De100EcsWorld){0};
+  if (capacity == 0 || capacity > DE100_ECS_MAX_ENTITIES ||
+      max_archetypes == 0 || max_archetypes > 0xFFFF) {
+    return false;
+  }
+  world->records = de100_arena_push_array(arena, capacity, De100EcsRecord);
+  world->free_slots = de100_arena_push_array(arena, capacity, u32);
+  world->archetypes =
+      de100_arena_push_array(arena, max_archetypes, De100EcsArchetype);
+  if (!world->records || !world->free_slots || !world->archetypes) {
+    return false;
+  }
+  memset(world->records, 0, (size_t)capacity * sizeof(De100EcsRecord));
+  world->arena = arena;
+  world->capacity = capacity;
+  world->max_archetypes = max_archetypes;
+  return true;
+}
+
+/**
+ * Register a component type; ids are handed out in call order, so
+ * register in the same order on every run (replays, reloads).
+ *
+ * @return id for DE100_ECS_BIT, or DE100_ECS_NO_COMPONENT when full
+ */
+de100_file_scoped_fn inline u32 de100_ecs_register(De100EcsWorld *world,
+                                                   u32 size, u32 align) {
+  DEV_ASSERT_MSG(world->component_count < DE100_ECS_MAX_COMPONENTS,
+                 "ECS out of component ids (%u)", DE100_ECS_MAX_COMPONENTS);
+  DEV_ASSERT_MSG(world->archetype_count == 0, "%s",
+                 "ECS components must be registered before any spawn");
+  if (world->component_count >= DE100_ECS_MAX_COMPONENTS || size == 0 ||
+      (align & (align - 1)) != 0 || align > DE100_ECS_CHUNK_ALIGNMENT) {
+    return DE100_ECS_NO_COMPONENT;
+  }
+  u32 id = world->component_count++;
+  world->component_size[id] = size;
+  world->component_align[id] = align ? align : 1;
+  return id;
+}
+
+#define DE100_ECS_REGISTER(world, type)                                        \
+  de100_ecs_register((world), (u32)sizeof(type), (u32)_Alignof(type))
+
+/**
+ * New entity with the components in `mask`, all zeroed.
+ *
+ * @return DE100_ECS_ENTITY_NULL when full or out of memory
+ */
+de100_file_scoped_fn inline De100EcsEntity de100_ecs_spawn(De100EcsWorld *world,
+                                                           De100EcsMask mask) {
+  DEV_ASSERT_MSG(!world->is_running, "%s", "ECS spawn during run_systems");
+  if (world->count >= world->capacity) {
+    return DE100_ECS_ENTITY_NULL;
+  }
+  i32 archetype = de100_ecs_archetype(world, mask);
+  if (archetype < 0) {
+    return DE100_ECS_ENTITY_NULL;
+  }
+  u32 row;
+  De100EcsChunk *chunk = de100_ecs_push_row(world, (u32)archetype, &row);
+  if (!chunk) {
+    return DE100_ECS_ENTITY_NULL;
+  }
+
+  u32 slot = world->free_count > 0 ? world->free_slots[--world->free_count]
+                                   : world->slot_count++;
+  De100EcsRecord *record = &world->records[slot];
+  if (record->generation == 0) {
+    record->generation = 1;
+  }
+  record->chunk = chunk;
+  record->row = row;
+  record->archetype = (u16)archetype;
+  world->count++;
+
+  De100EcsEntity e =
+      ((De100EcsEntity)record->generation << DE100_ECS_INDEX_BITS) | slot;
+  De100EcsArchetype *arch = &world->archetypes[archetype];
+  de100_ecs_chunk_entities(arch, chunk)[row] = e;
+  for (u32 c = 0; c < world->component_count; ++c) {
+    if (mask & DE100_ECS_BIT(c)) {
+      memset(de100_ecs_cell(world, arch, chunk, c, row), 0,
+             world->component_size[c]);
+    }
+  }
+  return e;
+}
+
+de100_file_scoped_fn inline bool de100_ecs_is_alive(const De100EcsWorld *world,
+                                                    De100EcsEntity e) {
+  return de100_ecs_record(world, e) != NULL;
+}
+
+/** @return false for a stale handle */
+de100_file_scoped_fn inline bool de100_ecs_destroy(De100EcsWorld *world,
+                                                   De100EcsEntity e) {
+  DEV_ASSERT_MSG(!world->is_running, "%s", "ECS destroy during run_systems");
+  De100EcsRecord *record = de100_ecs_record(world, e);
+  if (!record) {
+    return false;
+  }
+  de100_ecs_pop_row(world, record->archetype, record->chunk, record->row);
+  u16 generation =
+      (u16)((record->generation + 1) & DE100_ECS_GENERATION_MASK);
+  record->generation = generation ? generation : 1;
+  record->chunk = NULL;
+  world->free_slots[world->free_count++] = de100_ecs_entity_slot(e);
+  world->count--;
+  return true;
+}
+
+/** The entity's component set, or 0 for a stale handle. */
+de100_file_scoped_fn inline De100EcsMask
+de100_ecs_mask(const De100EcsWorld *world, De100EcsEntity e) {
+  const De100EcsRecord *record = de100_ecs_record(world, e);
+  return record ? world->archetypes[record->archetype].mask : 0;
+}
+
+/**
+ * The entity's component, or NULL if it has none (or the handle is
+ * stale). Valid until the next structural change.
+ */
+de100_file_scoped_fn inline void *de100_ecs_get(De100EcsWorld *world,
+                                                De100EcsEntity e,
+                                                u32 component) {
+  De100EcsRecord *record = de100_ecs_record(world, e);
+  if (!record) {
+    return NULL;
+  }
+  const De100EcsArchetype *arch = &world->archetypes[record->archetype];
+  if (!(arch->mask & DE100_ECS_BIT(component))) {
+    return NULL;
+  }
+  return de100_ecs_cell(world, arch, record->chunk, component, record->row);
+}
+
+#define DE100_ECS_GET(world, e, type, component)                               \
+  ((type *)de100_ecs_get((world), (e), (component)))
+
+/**
+ * Give the entity `component` (zeroed; kept as is if it had it already).
+ *
+ * @return the component, or NULL for a stale handle or out of memory
+ */
+de100_file_scoped_fn inline void *de100_ecs_add(De100EcsWorld *world,
+                                                De100EcsEntity e,
+                                                u32 component) {
+  De100EcsRecord *record = de100_ecs_record(world, e);
+  if (!record) {
+    return NULL;
+  }
+  De100EcsMask mask = world->archetypes[record->archetype].mask;
+  if (!(mask & DE100_ECS_BIT(component))) {
+    i32 archetype =
+        de100_ecs_archetype(world, mask | DE100_ECS_BIT(component));
+    if (archetype < 0 || !de100_ecs_move(world, e, record, (u32)archetype)) {
+      return NULL;
+    }
+  }
+  return de100_ecs_get(world, e, component);
+}
+
+/** @return false for a stale handle or out of memory */
+de100_file_scoped_fn inline bool de100_ecs_remove(De100EcsWorld *world,
+                                                  De100EcsEntity e,
+                                                  u32 component) {
+  De100EcsRecord *record = de100_ecs_record(world, e);
+  if (!record) {
+    return false;
+  }
+  De100EcsMask mask = world->archetypes[record->archetype].mask;
+  if (!(mask & DE100_ECS_BIT(component))) {
+    return true;
+  }
+  i32 archetype = de100_ecs_archetype(world, mask & ~DE100_ECS_BIT(component));
+  return archetype >= 0 && de100_ecs_move(world, e, record, (u32)archetype);
+}
+
+/** Destroy every entity; chunks and archetypes stay for reuse. */
+de100_file_scoped_fn inline void de100_ecs_clear(De100EcsWorld *world) {
+  for (u32 slot = 0; slot < world->slot_count; ++slot) {
+    De100EcsRecord *record = &world->records[slot];
+    if (record->chunk) {
+      de100_ecs_destroy(world, ((De100EcsEntity)record->generation
+                                << DE100_ECS_INDEX_BITS) |
+                                   slot);
+    }
+  }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Queries
+// ─────────────────────────────────────────────────────────────────────────────
+
+/** Column of `component` in the view's chunk, `view->count` rows. */
+de100_file_scoped_fn inline void *de100_ecs_column(const De100EcsView *view,
+                                                   u32 component) {
+  u32 offset = view->archetype->column_offset[component];
+  DEV_ASSERT_MSG(offset != DE100_ECS_NO_COLUMN,
+                 "ECS component %u not in this chunk", component);
+  return offset == DE100_ECS_NO_COLUMN ? NULL : view->chunk->data + offset;
+}
+
+#define DE100_ECS_COLUMN(view, type, component)                                \
+  ((type *)de100_ecs_column((view), (component)))
+
+de100_file_scoped_fn inline bool de100_ecs_matches(const De100EcsArchetype *a,
+                                                   De100EcsMask all,
+                                                   De100EcsMask none) {
+  return (a->mask & all) == all && (a->mask & none) == 0 && a->count > 0;
+}
+
+/**
+ * Chunks of every entity with all of `all` and none of `none`, in
+ * archetype creation order, then chunk order.
+ */
+de100_file_scoped_fn inline De100EcsIter de100_ecs_query(De100EcsWorld *world,
+                                                         De100EcsMask all,
+                                                         De100EcsMask none) {
+  return (De100EcsIter){.view = {.world = world}, .all = all, .none = none};
+}
+
+/** Advance to the next non-empty chunk; false when done. */
+de100_file_scoped_fn inline bool de100_ecs_next(De100EcsIter *it) {
+  De100EcsWorld *world = it->view.world;
+  De100EcsChunk *chunk = it->view.chunk ? it->view.chunk->next : NULL;
+  if (chunk && chunk->count > 0) {
+    it->view.chunk = chunk;
+  } else {
+    for (;;) {
+      if (it->next_archetype >= world->archetype_count) {
+        it->view.chunk = NULL;
+        it->view.count = 0;
+        return false;
+      }
+      De100EcsArchetype *arch = &world->archetypes[it->next_archetype++];
+      if (de100_ecs_matches(arch, it->all, it->none)) {
+        it->view.archetype = arch;
+        it->view.chunk = arch->first;
+        break;
+      }
+    }
+  }
+  it->view.count = it->view.chunk->count;
+  it->view.entities =
+      de100_ecs_chunk_entities(it->view.archetype, it->view.chunk);
+  return true;
+}
+
+/** Entities matching the query (sum of the archetype counts). */
+de100_file_scoped_fn inline u32 de100_ecs_count(const De100EcsWorld *world,
+                                                De100EcsMask all,
+                                                De100EcsMask none) {
+  u32 count = 0;
+  for (u32 i = 0; i < world->archetype_count; ++i) {
+    if (de100_ecs_matches(&world->archetypes[i], all, none)) {
+      count += world->archetypes[i].count;
+    }
+  }
+  return count;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Systems
+// ─────────────────────────────────────────────────────────────────────────────
+
+typedef struct {
+  const De100EcsSystem *system;
+  De100EcsView view;
+} De100EcsJob;
+
+de100_file_scoped_fn inline
+DE100_WORK_QUEUE_CALLBACK(de100_ecs_job_entry) {
+  (void)thread_context;
+  De100EcsJob *job = (De100EcsJob *)data;
+  job->system->run(&job->view, job->system->data);
+}
+
+de100_file_scoped_fn inline bool de100_ecs_conflicts(const De100EcsSystem *a,
+                                                     const De100EcsSystem *b) {
+  return (a->writes & (b->reads | b->writes)) != 0 ||
+         (b->writes & (a->reads | a->writes)) != 0;
+}
+
+// Systems [first, end) as one phase: a work entry per (system, chunk)
+de100_file_scoped_fn inline void
+de100_ecs_run_phase(De100EcsWorld *world, const De100EcsSystem *systems,
+                    u32 first, u32 end, GameMemory *memory,
+                    ThreadContext *thread_context) {
+  bool parallel = memory && memory->work_queue &&
+                  thread_context && thread_context->scratch_arena &&
+                  !systems[first].main_thread;
+  u32 job_count = 0;
+  if (parallel) {
+    for (u32 s = first; s < end; ++s) {
+      for (u32 a = 0; a < world->archetype_count; ++a) {
+        const De100EcsArchetype *arch = &world->archetypes[a];
+        if (de100_ecs_matches(arch, systems[s].all, systems[s].none)) {
+          job_count += (arch->count + arch->rows_per_chunk - 1) /
+                       arch->rows_per_chunk;
+        }
+      }
+    }
+  }
+
+  De100MemoryArena *scratch = parallel ? thread_context->scratch_arena : NULL;
+  De100TemporaryMemory temp = {0};
+  De100EcsJob *jobs = NULL;
+  if (parallel && job_count > 1) {
+    temp = de100_arena_begin_temp(scratch);
+    jobs = de100_arena_push_array(scratch, job_count, De100EcsJob);
+    if (!jobs) {
+      de100_arena_end_temp(temp);
+    }
+  }
+
+  u32 next = 0;
+  for (u32 s = first; s < end; ++s) {
+    De100EcsIter it = de100_ecs_query(world, systems[s].all, systems[s].none);
+    while (de100_ecs_next(&it)) {
+      if (!jobs) {
+        systems[s].run(&it.view, systems[s].data);
+        continue;
+      }
+      De100EcsJob *job = &jobs[next++];
+      job->system = &systems[s];
+      job->view = it.view;
+      if (!memory->add_work_entry(memory->work_queue, de100_ecs_job_entry,
+                                  job)) {
+        de100_ecs_job_entry(thread_context, job);
+      }
+    }
+  }
+
+  if (jobs) {
+    memory->complete_all_work(memory->work_queue);
+    de100_arena_end_temp(temp);
+  }
+}
+
+/**
+ * Run `systems` in order, as parallel phases (see the header comment).
+ * Without a work queue (memory or thread_context NULL) everything runs
+ * on the calling thread, in the same order per system.
+ */
+de100_file_scoped_fn inline void
+de100_ecs_run_systems(De100EcsWorld *world, const De100EcsSystem *systems,
+                      u32 system_count, GameMemory *memory,
+                      ThreadContext *thread_context) {
+  world->is_running = true;
+  u32 first = 0;
+  while (first < system_count) {
+    u32 end = first + 1;
+    if (!systems[first].main_thread) {
+      for (; end < system_count && !systems[end].main_thread; ++end) {
+        bool conflict = false;
+        for (u32 s = first; s < end && !conflict; ++s) {
+          conflict = de100_ecs_conflicts(&systems[s], &systems[end]);
+        }
+        if (conflict) {
+          break;
+        }
+      }
+    }
+    de100_ecs_run_phase(world, systems, first, end, memory, thread_context);
+    first = end;
+  }
+  world->is_running = false;
+}
+
+#endif // DE100_GAME_ECS_H
@@ -0,0 +1,255 @@
+#ifndef DE100_GAME_ENTITY_POOL_H
+#define DE100_GAME_ENTITY_POOL_H
+
+#include "../_common/base.h"
+#include "memory-arena.h"
+
+// ═══════════════════════════════════════════════════════════════════════════
+// 🧩 ENTITY POOL (macro-generated structure-of-arrays)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// One column array per field, kept DENSE: live entities occupy [0, count)
+// in every column, so update loops stream contiguous floats and vectorize.
+// Entities are named by generational handles, not dense indices, because
+// remove() swap-moves the last entity into the hole:
+//
+//   #define ASTEROID_COLUMNS(X) X(f32, x) X(f32, y) X(f32, vx) X(u8, size)
+//   DE100_POOL_DECLARE(AsteroidPool, asteroid_pool, ASTEROID_COLUMNS)
+//
+//   asteroid_pool_init(&state->asteroids, &state->world_arena, 256);
+//
+//   De100PoolHandle h;
+//   i32 i = asteroid_pool_alloc(&state->asteroids, &h); // -1 when full
+//   state->asteroids.x[i] = ...;
+//
+//   AsteroidPool *pool = &state->asteroids;
+//   for (u32 i = 0; i < pool->index.count; ++i) {
+//     pool->x[i] += pool->vx[i] * dt;
+//   }
+//
+//   for (u32 i = 0; i < pool->index.count;) { // Removal while iterating:
+//     if (dead) asteroid_pool_remove(pool, i); // don't advance, the last
+//     else ++i;                                // entity moved into i
+//   }
+//
+//   i32 target = asteroid_pool_lookup(pool, h); // -1 once removed
+//
+//   ┌ slot (stable) ┐      ┌ dense (moves) ┐
+//   generation[slot]       handles[dense] ──→ slot
+//   slot_to_dense[slot] ──→ x[dense], y[dense], ...
+//
+// A handle is (generation << DE100_POOL_INDEX_BITS) | slot. remove() bumps
+// the slot's generation, so old handles stop resolving instead of aliasing
+// whatever reuses the slot. Generations skip 0, so 0 is never a live
+// handle (DE100_POOL_HANDLE_NULL) and a zeroed field means "no target".
+//
+// Alloc, remove and lookup are O(1): freed slots go on a stack. All
+// storage (columns and bookkeeping) is pushed from an arena at init, each
+// array cache-line aligned. The pool struct only holds pointers into the
+// arena, so keep both in permanent storage for hot reload and replays.
+//
+// All functions are static inline for zero overhead if unused.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define DE100_POOL_INDEX_BITS 20
+#define DE100_POOL_MAX_CAPACITY (1u << DE100_POOL_INDEX_BITS)
+#define DE100_POOL_SLOT_MASK (DE100_POOL_MAX_CAPACITY - 1)
+#define DE100_POOL_GENERATION_MASK ((1u << (32 - DE100_POOL_INDEX_BITS)) - 1)
+#define DE100_POOL_HANDLE_NULL 0u
+#define DE100_POOL_COLUMN_ALIGNMENT 64
+
+typedef u32 De100PoolHandle;
+
+// Bookkeeping shared by every generated pool (no columns of its own)
+typedef struct {
+  u32 count;      // Live entities, dense [0, count)
+  u32 capacity;
+  u32 slot_count; // Slots ever handed out (high water)
+  u32 free_count;
+
+  De100PoolHandle *handles; // [dense] → handle
+  u32 *slot_to_dense;       // [slot]
+  u16 *generations;         // [slot], never 0 once used
+  u32 *free_slots;          // Stack of retired slots
+} De100PoolIndex;
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Index (untyped core)
+// ─────────────────────────────────────────────────────────────────────────────
+
+de100_file_scoped_fn inline void *
+de100_pool_push_column(De100MemoryArena *arena, u32 capacity, u64 size) {
+  return de100_arena_push_size_aligned(arena, (u64)capacity * size,
+                                       DE100_POOL_COLUMN_ALIGNMENT);
+}
+
+de100_file_scoped_fn inline bool de100_pool_index_init(De100PoolIndex *index,
+                                                       De100MemoryArena *arena,
+                                                       u32 capacity) {
+  DEV_ASSERT_MSG(capacity > 0 && capacity <= DE100_POOL_MAX_CAPACITY,
+                 "Pool capacity %u out of range", capacity);
+  *index = (De100PoolIndex){0};
+  if (capacity == 0 || capacity > DE100_POOL_MAX_CAPACITY) {
+    return false;
+  }
+
+  index->handles = (De100PoolHandle *)de100_pool_push_column(
+      arena, capacity, sizeof(De100PoolHandle));
+  index->slot_to_dense =
+      (u32 *)de100_pool_push_column(arena, capacity, sizeof(u32));
+  index->generations =
+      (u16 *)de100_pool_push_column(arena, capacity, sizeof(u16));
+  index->free_slots =
+      (u32 *)de100_pool_push_column(arena, capacity, sizeof(u32));
+  if (!index->handles || !index->slot_to_dense || !index->generations ||
+      !index->free_slots) {
+    return false;
+  }
+
+  // Slots beyond slot_count are untouched until handed out, so only the
+  // generations need a known starting value
+  memset(index->generations, 0, (size_t)capacity * sizeof(u16));
+  index->capacity = capacity;
+  return true;
+}
+
+de100_file_scoped_fn inline u32 de100_pool_handle_slot(De100PoolHandle h) {
+  return h & DE100_POOL_SLOT_MASK;
+}
+
+de100_file_scoped_fn inline u32
+de100_pool_handle_generation(De100PoolHandle h) {
+  return h >> DE100_POOL_INDEX_BITS;
+}
+
+// New dense index (== old count) and its handle, or -1 when full
+de100_file_scoped_fn inline i32
+de100_pool_index_alloc(De100PoolIndex *index, De100PoolHandle *out_handle) {
+  if (index->count >= index->capacity) {
+    return -1;
+  }
+
+  u32 slot = index->free_count > 0 ? index->free_slots[--index->free_count]
+                                   : index->slot_count++;
+  if (index->generations[slot] == 0) {
+    index->generations[slot] = 1;
+  }
+
+  u32 dense = index->count++;
+  De100PoolHandle handle =
+      ((De100PoolHandle)index->generations[slot] << DE100_POOL_INDEX_BITS) |
+      slot;
+  index->handles[dense] = handle;
+  index->slot_to_dense[slot] = dense;
+  if (out_handle) {
+    *out_handle = handle;
+  }
+  return (i32)dense;
+}
+
+// Dense index of a live entity, or -1 for a stale/null handle
+de100_file_scoped_fn inline i32
+de100_pool_index_lookup(const De100PoolIndex *index, De100PoolHandle h) {
+  u32 slot = de100_pool_handle_slot(h);
+  if (h == DE100_POOL_HANDLE_NULL || slot >= index->slot_count ||
+      index->generations[slot] != de100_pool_handle_generation(h)) {
+    return -1;
+  }
+  return (i32)index->slot_to_dense[slot];
+}
+
+/**
+ * Retire the entity at `dense` and move the last entity's bookkeeping
+ * into its place. Returns the index the caller must copy columns from
+ * (the old last), or -1 when `dense` was the last and nothing moves.
+ */
+de100_file_scoped_fn inline i32 de100_pool_index_remove(De100PoolIndex *index,
+                                                        u32 dense) {
+  DEV_ASSERT_MSG(dense < index->count, "Pool remove %u of %u", dense,
+                 index->count);
+
+  u32 slot = de100_pool_handle_slot(index->handles[dense]);
+  u16 generation =
+      (u16)((index->generations[slot] + 1) & DE100_POOL_GENERATION_MASK);
+  index->generations[slot] = generation ? generation : 1;
+  index->free_slots[index->free_count++] = slot;
+
+  u32 last = --index->count;
+  if (dense == last) {
+    return -1;
+  }
+
+  De100PoolHandle moved = index->handles[last];
+  index->handles[dense] = moved;
+  index->slot_to_dense[de100_pool_handle_slot(moved)] = dense;
+  return (i32)last;
+}
+
+// Remove everything; every outstanding handle goes stale
+de100_file_scoped_fn inline void de100_pool_index_clear(De100PoolIndex *index) {
+  while (index->count > 0) {
+    de100_pool_index_remove(index, index->count - 1);
+  }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Generator
+// ─────────────────────────────────────────────────────────────────────────────
+// COLUMNS is an X-macro taking X(type, name). Declares `Type` and the
+// functions prefix_init / _alloc / _lookup / _remove / _remove_handle /
+// _clear. Column contents of a new entity are NOT zeroed.
+//
+
+#define DE100_POOL__FIELD(type, name) type *name;
+#define DE100_POOL__PUSH(type, name)                                           \
+  pool->name = (type *)de100_pool_push_column(arena, capacity, sizeof(type));  \
+  ok = ok && pool->name;
+#define DE100_POOL__MOVE(type, name) pool->name[dst] = pool->name[src];
+
+#define DE100_POOL_DECLARE(Type, prefix, COLUMNS)                              \
+  typedef struct Type {                                                        \
+    De100PoolIndex index;                                                      \
+    COLUMNS(DE100_POOL__FIELD)                                                 \
+  } Type;                                                                      \
+                                                                               \
+  de100_file_scoped_fn inline bool prefix##_init(                              \
+      Type *pool, De100MemoryArena *arena, u32 capacity) {                     \
+    bool ok = de100_pool_index_init(&pool->index, arena, capacity);            \
+    COLUMNS(DE100_POOL__PUSH)                                                  \
+    return ok;                                                                 \
+  }                                                                            \
+                                                                               \
+  de100_file_scoped_fn inline i32 prefix##_alloc(Type *pool,                   \
+                                                 De100PoolHandle *out) {       \
+    return de100_pool_index_alloc(&pool->index, out);                          \
+  }                                                                            \
+                                                                               \
+  de100_file_scoped_fn inline i32 prefix##_lookup(const Type *pool,            \
+                                                  De100PoolHandle h) {         \
+    return de100_pool_index_lookup(&pool->index, h);                           \
+  }                                                                            \
+                                                                               \
+  de100_file_scoped_fn inline void prefix##_remove(Type *pool, u32 dense) {    \
+    i32 moved = de100_pool_index_remove(&pool->index, dense);                  \
+    if (moved >= 0) {                                                          \
+      u32 dst = dense, src = (u32)moved;                                       \
+      COLUMNS(DE100_POOL__MOVE)                                                \
+    }                                                                          \
+  }                                                                            \
+                                                                               \
+  de100_file_scoped_fn inline bool prefix##_remove_handle(Type *pool,          \
+                                                          De100PoolHandle h) { \
+    i32 dense = de100_pool_index_lookup(&pool->index, h);                      \
+    if (dense < 0) {                                                           \
+      return false;                                                            \
+    }                                                                          \
+    prefix##_remove(pool, (u32)dense);                                         \
+    return true;                                                               \
+  }                                                                            \
+                                                                               \
+  de100_file_scoped_fn inline void prefix##_clear(Type *pool) {                \
+    de100_pool_index_clear(&pool->index);                                      \
+  }
+
+#endif // DE100_GAME_ENTITY_POOL_H
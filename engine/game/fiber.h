@@ -0,0 +1,569 @@
+#ifndef DE100_GAME_FIBER_H
+#define DE100_GAME_FIBER_H
+
+#include "../_common/base.h"
+#include "async-io.h"
+#include "background-load.h"
+#include "idle-job.h"
+#include "memory-arena.h"
+#include "memory.h"
+#include "thread.h"
+
+// ═══════════════════════════════════════════════════════════════════════════
+// 🧵 FIBERS (cooperative, main thread)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// For game logic that spans frames: wave scripts, phase transitions,
+// "load this, then fade, then start". Instead of a state machine with a
+// timer per step, a fiber is a function with its own stack that can stop
+// mid-way and carry on from there a later tick:
+//
+//   DE100_FIBER_PROC(run_wave) {
+//     GameState *state = (GameState *)fiber->data;
+//     for (u32 i = 0; i < 20; ++i) {
+//       spawn_creep(state, CREEP_NORMAL);
+//       de100_fiber_sleep(fiber, 30); // Half a second at 60 Hz
+//     }
+//     de100_fiber_await_counter(fiber, &state->creeps_alive);
+//     change_phase(state, PHASE_BUILD);
+//   }
+//
+//   de100_fiber_scheduler_init(&state->fibers, &state->permanent_arena,
+//                              16, KILOBYTES(64));
+//   de100_fiber_start(&state->fibers, run_wave, state);
+//   ...
+//   de100_fiber_scheduler_run(&state->fibers, memory); // Every update tick
+//
+// run() resumes each fiber whose wait is over, in slot order, until it
+// waits again or returns. Everything happens inside that call on the main
+// thread, so fibers touch game state like any update code, no locks.
+//
+// A fiber can wait for:
+//   - ticks (calls to run()):  de100_fiber_sleep, de100_fiber_yield
+//   - a counter to reach 0:    de100_fiber_await_counter, e.g. work entries
+//                              queued with de100_fiber_add_work
+//   - platform requests:       de100_fiber_await_io / _load / _idle_job
+// A parked fiber costs one poll per run(), and blocks no worker: queue
+// jobs and wait on their counter instead of complete_all_work().
+//
+// Stacks and saved registers are pushed from the arena given to init, so
+// with a permanent-storage arena they live in game memory: replay
+// snapshots, rewind and netplay rollback restore suspended fibers with
+// the rest of the state. A stack holds return addresses into the game
+// library, though, so a hot reload cancels every fiber (run() notices
+// GameMemory.code_generation moved). Restart them after the reload, and
+// keep fiber procs in the main library, not in code modules.
+//
+// Ticks are deterministic; completions of I/O, loads and idle jobs depend
+// on the machine, so keep them out of simulated state, as for the
+// requests themselves.
+//
+// Stack overflow is caught late, by a canary checked in DEV builds each
+// time the fiber suspends. Size stacks for the deepest call a fiber makes.
+// The switch is a function call to the compiler: x86-64 and AArch64 only,
+// and not compatible with hardware shadow stacks (CET).
+//
+// All functions are static inline for zero overhead if unused.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define DE100_FIBER_INDEX_BITS 16
+#define DE100_FIBER_MAX_CAPACITY (1u << DE100_FIBER_INDEX_BITS)
+#define DE100_FIBER_SLOT_MASK (DE100_FIBER_MAX_CAPACITY - 1)
+#define DE100_FIBER_HANDLE_NULL 0u
+#define DE100_FIBER_MIN_STACK_SIZE KILOBYTES(4)
+#define DE100_FIBER_STACK_CANARY 0xF1BE55AC0FFEE000ull
+
+typedef u32 De100FiberHandle;
+
+typedef enum {
+  DE100_FIBER_STATUS_FREE = 0,
+  DE100_FIBER_STATUS_STARTING, // Queued, never ran
+  DE100_FIBER_STATUS_SUSPENDED,
+  DE100_FIBER_STATUS_RUNNING,
+  DE100_FIBER_STATUS_DONE, // Returned; the slot is freed by run()
+
+  DE100_FIBER_STATUS_COUNT
+} De100FiberStatus;
+
+typedef enum {
+  DE100_FIBER_WAIT_TICK = 0, // Until scheduler->tick reaches wake_tick
+  DE100_FIBER_WAIT_COUNTER,  // Until *(u32 *)wait_on == 0
+  DE100_FIBER_WAIT_ASYNC_IO,
+  DE100_FIBER_WAIT_BACKGROUND_LOAD,
+  DE100_FIBER_WAIT_IDLE_JOB,
+
+  DE100_FIBER_WAIT_COUNT
+} De100FiberWait;
+
+typedef struct De100Fiber De100Fiber;
+typedef struct De100FiberScheduler De100FiberScheduler;
+
+#define DE100_FIBER_PROC(name) void name(De100Fiber *fiber)
+typedef DE100_FIBER_PROC(de100_fiber_proc_t);
+typedef void de100_fiber_entry_t(De100Fiber *fiber); // Stack's first frame
+
+struct De100Fiber {
+  de100_fiber_proc_t *proc;
+  void *data;
+  De100FiberScheduler *scheduler;
+  void *sp;          // Saved stack pointer while suspended
+  u8 *stack;         // stack_size bytes, canary at the bottom
+  const void *wait_on;
+  u32 wake_tick;
+  u16 status;        // De100FiberStatus
+  u16 wait;          // De100FiberWait
+  u16 generation;    // Never 0 once used
+};
+
+struct De100FiberScheduler {
+  De100Fiber *fibers;
+  u32 capacity;
+  u32 count;           // Live fibers
+  u32 stack_size;
+  u32 tick;            // run() calls so far
+  u32 code_generation; // GameMemory.code_generation the fibers run under
+  void *main_sp;       // run()'s context while a fiber runs
+  De100Fiber *current;
+};
+
+// Work queued by a fiber: `callback(data)` on a worker, then --*pending.
+// Keep it on the fiber's stack; it stays put while the fiber waits.
+typedef struct {
+  de100_work_queue_callback_t *callback;
+  void *data;
+  u32 *pending;
+} De100FiberWork;
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Context switch
+// ─────────────────────────────────────────────────────────────────────────────
+//
+// A suspended context is a stack pointer; the stack below it holds
+// [frame pointer, resume address] above a skipped red zone. Every other
+// register is declared clobbered, so the compiler spills what it needs
+// around the switch as it would around a call.
+
+#if defined(__x86_64__)
+
+#if defined(__AVX512F__)
+#define DE100_FIBER_CLOBBERS_AVX512                                            \
+  , "xmm16", "xmm17", "xmm18", "xmm19", "xmm20", "xmm21", "xmm22", "xmm23",    \
+      "xmm24", "xmm25", "xmm26", "xmm27", "xmm28", "xmm29", "xmm30", "xmm31"
+#else
+#define DE100_FIBER_CLOBBERS_AVX512
+#endif
+
+#define DE100_FIBER_CLOBBERS                                                   \
+  "rax", "rbx", "r8", "r9", "r10", "r11", "r12", "r13", "r14", "r15", "xmm0",  \
+      "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6", "xmm7", "xmm8", "xmm9",  \
+      "xmm10", "xmm11", "xmm12", "xmm13", "xmm14", "xmm15", "memory",          \
+      "cc" DE100_FIBER_CLOBBERS_AVX512
+
+#define DE100_FIBER_SAVE(save)                                                 \
+  "leaq -128(%%rsp), %%rsp\n\t" /* Step over the red zone */                   \
+  "leaq 1f(%%rip), %%rax\n\t"                                                  \
+  "pushq %%rax\n\t"                                                            \
+  "pushq %%rbp\n\t"                                                            \
+  "movq %%rsp, (" save ")\n\t"
+
+/** Save this context to `*from_sp` and resume the one at `to_sp`. */
+de100_file_scoped_fn inline void de100_fiber_switch(void **from_sp,
+                                                    void *to_sp) {
+  __asm__ volatile(DE100_FIBER_SAVE("%0") //
+                   "movq %1, %%rsp\n\t"
+                   "popq %%rbp\n\t"
+                   "popq %%rax\n\t"
+                   "leaq 128(%%rsp), %%rsp\n\t"
+                   "jmpq *%%rax\n\t"
+                   "1:\n\t"
+                   : "+D"(from_sp), "+S"(to_sp)
+                   :
+                   : "rcx", "rdx", DE100_FIBER_CLOBBERS);
+}
+
+/** Save this context to `*from_sp` and call `entry(fiber)` on `top`. */
+de100_file_scoped_fn inline void de100_fiber_enter(void **from_sp, void *top,
+                                                   De100Fiber *fiber,
+                                                   de100_fiber_entry_t *entry) {
+  __asm__ volatile(DE100_FIBER_SAVE("%1") //
+                   "movq %2, %%rsp\n\t"
+                   "xorl %%ebp, %%ebp\n\t" // Backtraces stop here
+                   "callq *%3\n\t"         // Never returns
+                   "ud2\n\t"
+                   "1:\n\t"
+                   : "+D"(fiber), "+S"(from_sp), "+d"(top), "+c"(entry)
+                   :
+                   : DE100_FIBER_CLOBBERS);
+}
+
+#elif defined(__aarch64__)
+
+// x18 is the platform register (left alone); x29 is saved by hand
+#define DE100_FIBER_CLOBBERS                                                   \
+  "x4", "x5", "x6", "x7", "x8", "x9", "x10", "x11", "x12", "x13", "x14",       \
+      "x15", "x16", "x17", "x19", "x20", "x21", "x22", "x23", "x24", "x25",    \
+      "x26", "x27", "x28", "x30", "v0", "v1", "v2", "v3", "v4", "v5", "v6",    \
+      "v7", "v8", "v9", "v10", "v11", "v12", "v13", "v14", "v15", "v16",       \
+      "v17", "v18", "v19", "v20", "v21", "v22", "v23", "v24", "v25", "v26",    \
+      "v27", "v28", "v29", "v30", "v31", "memory", "cc"
+
+#define DE100_FIBER_SAVE(save)                                                 \
+  "sub sp, sp, #144\n\t" /* Red zone (Apple) + the saved pair */               \
+  "adr x9, 1f\n\t"                                                             \
+  "stp x29, x9, [sp]\n\t"                                                      \
+  "mov x9, sp\n\t"                                                             \
+  "str x9, [" save "]\n\t"
+
+de100_file_scoped_fn inline void de100_fiber_switch(void **from_sp,
+                                                    void *to_sp) {
+  register void **save __asm__("x0") = from_sp;
+  register void *load __asm__("x1") = to_sp;
+  __asm__ volatile(DE100_FIBER_SAVE("%0") //
+                   "mov sp, %1\n\t"
+                   "ldp x29, x9, [sp]\n\t"
+                   "add sp, sp, #144\n\t"
+                   "br x9\n\t"
+                   "1:\n\t"
+                   "hint #36\n\t" // bti j: `br` lands here
+                   : "+r"(save), "+r"(load)
+                   :
+                   : "x2", "x3", DE100_FIBER_CLOBBERS);
+}
+
+de100_file_scoped_fn inline void de100_fiber_enter(void **from_sp, void *top,
+                                                   De100Fiber *fiber,
+                                                   de100_fiber_entry_t *entry) {
+  register De100Fiber *arg __asm__("x0") = fiber;
+  register void **save __asm__("x1") = from_sp;
+  register void *stack __asm__("x2") = top;
+  register de100_fiber_entry_t *target __asm__("x3") = entry;
+  __asm__ volatile(DE100_FIBER_SAVE("%1") //
+                   "mov sp, %2\n\t"
+                   "mov x29, xzr\n\t" // Backtraces stop here
+                   "mov x30, xzr\n\t"
+                   "blr %3\n\t" // Never returns
+                   "brk #0\n\t"
+                   "1:\n\t"
+                   "hint #36\n\t"
+                   : "+r"(arg), "+r"(save), "+r"(stack), "+r"(target)
+                   :
+                   : DE100_FIBER_CLOBBERS);
+}
+
+#else
+#error "fiber.h: no context switch for this CPU (x86-64 and AArch64 only)"
+#endif
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Internals
+// ─────────────────────────────────────────────────────────────────────────────
+
+de100_file_scoped_fn inline De100FiberHandle
+de100_fiber_handle(const De100FiberScheduler *scheduler,
+                   const De100Fiber *fiber) {
+  u32 index = (u32)(fiber - scheduler->fibers);
+  return ((De100FiberHandle)fiber->generation << DE100_FIBER_INDEX_BITS) |
+         index;
+}
+
+// Slot of a live fiber, or NULL for a stale handle
+de100_file_scoped_fn inline De100Fiber *
+de100_fiber_lookup(const De100FiberScheduler *scheduler,
+                   De100FiberHandle handle) {
+  u32 index = handle & DE100_FIBER_SLOT_MASK;
+  if (handle == DE100_FIBER_HANDLE_NULL || index >= scheduler->capacity) {
+    return NULL;
+  }
+  De100Fiber *fiber = &scheduler->fibers[index];
+  if (fiber->status == DE100_FIBER_STATUS_FREE ||
+      fiber->generation != (handle >> DE100_FIBER_INDEX_BITS)) {
+    return NULL;
+  }
+  return fiber;
+}
+
+de100_file_scoped_fn inline void
+de100_fiber_release(De100FiberScheduler *scheduler, De100Fiber *fiber) {
+  u16 generation = (u16)(fiber->generation + 1);
+  fiber->generation = generation ? generation : 1;
+  fiber->status = DE100_FIBER_STATUS_FREE;
+  fiber->proc = NULL;
+  fiber->data = NULL;
+  fiber->wait_on = NULL;
+  scheduler->count--;
+}
+
+// First frame of every fiber's stack
+de100_file_scoped_fn inline void de100_fiber_main(De100Fiber *fiber) {
+  fiber->proc(fiber);
+  fiber->status = DE100_FIBER_STATUS_DONE;
+  de100_fiber_switch(&fiber->sp, fiber->scheduler->main_sp);
+  __builtin_unreachable();
+}
+
+de100_file_scoped_fn inline bool
+de100_fiber_is_ready(const De100FiberScheduler *scheduler,
+                     const De100Fiber *fiber) {
+  switch ((De100FiberWait)fiber->wait) {
+  case DE100_FIBER_WAIT_TICK:
+    return (i32)(scheduler->tick - fiber->wake_tick) >= 0;
+  case DE100_FIBER_WAIT_COUNTER:
+    return __atomic_load_n((const u32 *)fiber->wait_on, __ATOMIC_ACQUIRE) ==
+           0;
+  case DE100_FIBER_WAIT_ASYNC_IO:
+    return de100_async_io_is_done(
+        (const De100AsyncIORequest *)fiber->wait_on);
+  case DE100_FIBER_WAIT_BACKGROUND_LOAD:
+    return de100_background_load_is_done(
+        (const De100BackgroundLoad *)fiber->wait_on);
+  case DE100_FIBER_WAIT_IDLE_JOB:
+    return de100_idle_job_is_done((const De100IdleJob *)fiber->wait_on);
+  case DE100_FIBER_WAIT_COUNT:
+    break;
+  }
+  return true;
+}
+
+// Back to run(); returns when run() resumes this fiber
+de100_file_scoped_fn inline void de100_fiber_suspend(De100Fiber *fiber) {
+  DEV_ASSERT_MSG(fiber->scheduler->current == fiber,
+                 "Fiber %u suspended from outside its own stack",
+                 (u32)(fiber - fiber->scheduler->fibers));
+  fiber->status = DE100_FIBER_STATUS_SUSPENDED;
+  de100_fiber_switch(&fiber->sp, fiber->scheduler->main_sp);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// API
+// ─────────────────────────────────────────────────────────────────────────────
+
+/**
+ * `capacity` fibers of `stack_size` bytes each, all pushed from `arena`
+ * (use a permanent one: see the header comment).
+ */
+de100_file_scoped_fn inline bool
+de100_fiber_scheduler_init(De100FiberScheduler *scheduler,
+                           De100MemoryArena *arena, u32 capacity,
+                           u32 stack_size) {
+  DEV_ASSERT_MSG(capacity > 0 && capacity < DE100_FIBER_MAX_CAPACITY,
+                 "Fiber capacity %u out of range", capacity);
+  *scheduler = (De100FiberScheduler){0};
+  stack_size = (stack_size + 15u) & ~15u;
+  if (capacity == 0 || capacity >= DE100_FIBER_MAX_CAPACITY ||
+      stack_size < DE100_FIBER_MIN_STACK_SIZE) {
+    return false;
+  }
+
+  De100Fiber *fibers = de100_arena_push_array(arena, capacity, De100Fiber);
+  u8 *stacks = (u8 *)de100_arena_push_size_aligned(
+      arena, (u64)capacity * stack_size, 16);
+  if (!fibers || !stacks) {
+    return false;
+  }
+  for (u32 i = 0; i < capacity; ++i) {
+    fibers[i] = (De100Fiber){
+        .scheduler = scheduler,
+        .stack = stacks + (u64)i * stack_size,
+        .generation = 1,
+    };
+    *(u64 *)fibers[i].stack = DE100_FIBER_STACK_CANARY;
+  }
+  scheduler->fibers = fibers;
+  scheduler->capacity = capacity;
+  scheduler->stack_size = stack_size;
+  return true;
+}
+
+/**
+ * Queue `proc(fiber)` with fiber->data = `data`. It first runs in the
+ * next run() call (from inside a fiber: the one after this tick's).
+ *
+ * @return DE100_FIBER_HANDLE_NULL when every slot is in use
+ */
+de100_file_scoped_fn inline De100FiberHandle
+de100_fiber_start(De100FiberScheduler *scheduler, de100_fiber_proc_t *proc,
+                  void *data) {
+  for (u32 i = 0; i < scheduler->capacity; ++i) {
+    De100Fiber *fiber = &scheduler->fibers[i];
+    if (fiber->status != DE100_FIBER_STATUS_FREE) {
+      continue;
+    }
+    fiber->proc = proc;
+    fiber->data = data;
+    fiber->status = DE100_FIBER_STATUS_STARTING;
+    fiber->wait = DE100_FIBER_WAIT_TICK;
+    fiber->wake_tick = scheduler->tick + 1;
+    fiber->wait_on = NULL;
+    scheduler->count++;
+    return de100_fiber_handle(scheduler, fiber);
+  }
+  DEV_ASSERT_MSG(false, "Fiber scheduler full (%u fibers)",
+                 scheduler->capacity);
+  return DE100_FIBER_HANDLE_NULL;
+}
+
+/** @return false once the fiber returned or was cancelled */
+de100_file_scoped_fn inline bool
+de100_fiber_is_alive(const De100FiberScheduler *scheduler,
+                     De100FiberHandle handle) {
+  const De100Fiber *fiber = de100_fiber_lookup(scheduler, handle);
+  return fiber && fiber->status != DE100_FIBER_STATUS_DONE;
+}
+
+/**
+ * Drop a fiber that is not running: it never resumes, and its stack is
+ * abandoned as is (nothing on it is unwound).
+ *
+ * @return false for a stale handle or the running fiber itself
+ */
+de100_file_scoped_fn inline bool
+de100_fiber_cancel(De100FiberScheduler *scheduler, De100FiberHandle handle) {
+  De100Fiber *fiber = de100_fiber_lookup(scheduler, handle);
+  if (!fiber || fiber == scheduler->current) {
+    return false;
+  }
+  de100_fiber_release(scheduler, fiber);
+  return true;
+}
+
+/** Drop every fiber; every outstanding handle goes stale. */
+de100_file_scoped_fn inline void
+de100_fiber_scheduler_clear(De100FiberScheduler *scheduler) {
+  DEV_ASSERT_MSG(!scheduler->current, "%s", "Fiber cleared its scheduler");
+  for (u32 i = 0; i < scheduler->capacity && scheduler->count > 0; ++i) {
+    if (scheduler->fibers[i].status != DE100_FIBER_STATUS_FREE) {
+      de100_fiber_release(scheduler, &scheduler->fibers[i]);
+    }
+  }
+}
+
+/**
+ * One tick: resume every fiber whose wait is over, in slot order, each
+ * until it waits again or returns. Call once per game update, from the
+ * main thread and never from a fiber. Cancels everything first if a hot
+ * reload happened since the last call.
+ */
+de100_file_scoped_fn inline void
+de100_fiber_scheduler_run(De100FiberScheduler *scheduler,
+                          const GameMemory *memory) {
+  if (scheduler->code_generation != memory->code_generation) {
+    // Suspended stacks return into the unloaded library
+    de100_fiber_scheduler_clear(scheduler);
+    scheduler->code_generation = memory->code_generation;
+  }
+  scheduler->tick++;
+
+  for (u32 i = 0; i < scheduler->capacity && scheduler->count > 0; ++i) {
+    De100Fiber *fiber = &scheduler->fibers[i];
+    if ((fiber->status != DE100_FIBER_STATUS_STARTING &&
+         fiber->status != DE100_FIBER_STATUS_SUSPENDED) ||
+        !de100_fiber_is_ready(scheduler, fiber)) {
+      continue;
+    }
+
+    u16 status = fiber->status;
+    scheduler->current = fiber;
+    fiber->status = DE100_FIBER_STATUS_RUNNING;
+    if (status == DE100_FIBER_STATUS_STARTING) {
+      de100_fiber_enter(&scheduler->main_sp,
+                        fiber->stack + scheduler->stack_size, fiber,
+                        de100_fiber_main);
+    } else {
+      de100_fiber_switch(&scheduler->main_sp, fiber->sp);
+    }
+    scheduler->current = NULL;
+
+    DEV_ASSERT_MSG(*(const u64 *)fiber->stack == DE100_FIBER_STACK_CANARY,
+                   "Fiber %u overflowed its %u-byte stack", i,
+                   scheduler->stack_size);
+    if (fiber->status == DE100_FIBER_STATUS_DONE) {
+      de100_fiber_release(scheduler, fiber);
+    }
+  }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Inside a fiber
+// ─────────────────────────────────────────────────────────────────────────────
+
+/** Resume `ticks` run() calls from now (0 acts as 1). */
+de100_file_scoped_fn inline void de100_fiber_sleep(De100Fiber *fiber,
+                                                   u32 ticks) {
+  fiber->wait = DE100_FIBER_WAIT_TICK;
+  fiber->wake_tick = fiber->scheduler->tick + (ticks ? ticks : 1);
+  de100_fiber_suspend(fiber);
+}
+
+/** Resume next tick. */
+de100_file_scoped_fn inline void de100_fiber_yield(De100Fiber *fiber) {
+  de100_fiber_sleep(fiber, 1);
+}
+
+// Park until the wait is over; no switch at all if it already is
+de100_file_scoped_fn inline void
+de100_fiber_await(De100Fiber *fiber, De100FiberWait wait, const void *on) {
+  fiber->wait = (u16)wait;
+  fiber->wait_on = on;
+  if (!de100_fiber_is_ready(fiber->scheduler, fiber)) {
+    de100_fiber_suspend(fiber);
+  }
+  fiber->wait_on = NULL;
+}
+
+/** Until `*counter` is 0 (read with acquire: writers decrement with
+ *  release, as de100_fiber_add_work does). */
+de100_file_scoped_fn inline void
+de100_fiber_await_counter(De100Fiber *fiber, const u32 *counter) {
+  de100_fiber_await(fiber, DE100_FIBER_WAIT_COUNTER, counter);
+}
+
+de100_file_scoped_fn inline void
+de100_fiber_await_io(De100Fiber *fiber, const De100AsyncIORequest *request) {
+  de100_fiber_await(fiber, DE100_FIBER_WAIT_ASYNC_IO, request);
+}
+
+de100_file_scoped_fn inline void
+de100_fiber_await_load(De100Fiber *fiber, const De100BackgroundLoad *task) {
+  de100_fiber_await(fiber, DE100_FIBER_WAIT_BACKGROUND_LOAD, task);
+}
+
+de100_file_scoped_fn inline void
+de100_fiber_await_idle_job(De100Fiber *fiber, const De100IdleJob *job) {
+  de100_fiber_await(fiber, DE100_FIBER_WAIT_IDLE_JOB, job);
+}
+
+de100_file_scoped_fn inline
+DE100_WORK_QUEUE_CALLBACK(de100_fiber_work_entry) {
+  De100FiberWork *work = (De100FiberWork *)data;
+  work->callback(thread_context, work->data);
+  __atomic_sub_fetch(work->pending, 1, __ATOMIC_RELEASE);
+}
+
+/**
+ * Queue `work` on the frame work queue and count it in `*work->pending`;
+ * wait with de100_fiber_await_counter. The frame must still complete all
+ * work before it ends (thread.h), so the wait is over by the next tick.
+ *
+ *   u32 pending = 0;
+ *   De100FiberWork jobs[8];
+ *   for (u32 i = 0; i < 8; ++i) {
+ *     jobs[i] = (De100FiberWork){bake_chunk, &chunks[i], &pending};
+ *     de100_fiber_add_work(memory, &jobs[i]);
+ *   }
+ *   de100_fiber_await_counter(fiber, &pending);
+ *
+ * @return false if the queue was full (work not queued, not counted)
+ */
+de100_file_scoped_fn inline bool de100_fiber_add_work(GameMemory *memory,
+                                                      De100FiberWork *work) {
+  __atomic_add_fetch(work->pending, 1, __ATOMIC_RELAXED);
+  if (!memory->add_work_entry(memory->work_queue, de100_fiber_work_entry,
+                              work)) {
+    __atomic_sub_fetch(work->pending, 1, __ATOMIC_RELAXED);
+    return false;
+  }
+  return true;
+}
+
+#endif // DE100_GAME_FIBER_H
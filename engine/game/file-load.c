@@ -0,0 +1,219 @@
+#include "file-load.h"
+
+#include <stdint.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ERRORS
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_global_var const char *g_file_load_error_messages[] = {
+    [DE100_FILE_LOAD_SUCCESS] = "Success",
+    [DE100_FILE_LOAD_ERROR_NULL_ARGUMENT] = "NULL arena or empty path",
+    [DE100_FILE_LOAD_ERROR_OPEN_FAILED] = "Failed to open file",
+    [DE100_FILE_LOAD_ERROR_NOT_A_FILE] = "Not a regular file",
+    [DE100_FILE_LOAD_ERROR_TOO_LARGE] = "File too large for this address space",
+    [DE100_FILE_LOAD_ERROR_ARENA_FULL] = "Not enough room in the arena",
+    [DE100_FILE_LOAD_ERROR_READ_FAILED] = "Failed to read file contents",
+    [DE100_FILE_LOAD_ERROR_MAP_FAILED] = "Failed to map file",
+};
+
+const char *de100_file_load_strerror(De100FileLoadErrorCode code) {
+  if (code >= 0 && code < DE100_FILE_LOAD_ERROR_COUNT) {
+    return g_file_load_error_messages[code];
+  }
+  return "Unknown file load error";
+}
+
+de100_file_scoped_fn inline De100FileLoadResult
+file_load_error(De100FileLoadErrorCode code, De100FileErrorCode file_error) {
+  return (De100FileLoadResult){
+      .success = false,
+      .file_error = file_error,
+      .error_code = code,
+  };
+}
+
+de100_file_scoped_fn inline u64 file_load_round_up(u64 value, u64 alignment) {
+  return (value + alignment - 1) & ~(alignment - 1);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// READ
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// `size` bytes from the start of `fd` into `data`, a chunk per read. A
+// direct read asks for whole aligned blocks, so the last one may ask past
+// the end of the file: the short read it gets back is expected, as long
+// as it brought every byte of the file.
+//
+
+de100_file_scoped_fn De100FileErrorCode file_load_read(i32 fd, u8 *data,
+                                                       u64 size,
+                                                       bool direct) {
+  u64 offset = 0;
+  while (offset < size) {
+    u64 want = size - offset;
+    if (want > DE100_FILE_LOAD_CHUNK_SIZE) {
+      want = DE100_FILE_LOAD_CHUNK_SIZE;
+    }
+    u64 request =
+        direct ? file_load_round_up(want, DE100_FILE_DIRECT_ALIGNMENT) : want;
+
+    De100FileIOResult io = de100_file_read_all(fd, data + offset,
+                                               (size_t)request);
+    if (!io.success && !(io.error_code == DE100_FILE_ERROR_EOF &&
+                         io.bytes_processed >= want)) {
+      return io.error_code;
+    }
+    offset += want;
+  }
+  return DE100_FILE_SUCCESS;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// LOAD
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn De100FileLoadResult file_load_map(const char *path) {
+  De100FileMapping mapping = de100_file_map_readonly(
+      path, DE100_FILE_MAP_ADVICE_SEQUENTIAL | DE100_FILE_MAP_ADVICE_WILLNEED);
+  if (!mapping.success) {
+    return file_load_error(DE100_FILE_LOAD_ERROR_MAP_FAILED,
+                           mapping.error_code);
+  }
+  return (De100FileLoadResult){
+      .data = (void *)mapping.data,
+      .size = mapping.size,
+      .success = true,
+      .is_mapped = mapping.data != NULL,
+      .mapping = mapping,
+  };
+}
+
+De100FileLoadResult de100_file_load(De100MemoryArena *arena, const char *path,
+                                    u32 flags) {
+  if (!arena || !path || path[0] == '\0') {
+    return file_load_error(DE100_FILE_LOAD_ERROR_NULL_ARGUMENT,
+                           DE100_FILE_SUCCESS);
+  }
+
+  De100FileOpenResult file = de100_file_open(path, DE100_FILE_READ);
+  if (!file.success) {
+    return file_load_error(DE100_FILE_LOAD_ERROR_OPEN_FAILED,
+                           file.error_code);
+  }
+
+  De100FileSizeResult size_result = de100_file_get_size_fd(file.fd);
+  if (!size_result.success) {
+    de100_file_close(file.fd);
+    bool not_a_file =
+        size_result.error_code == DE100_FILE_ERROR_IS_DIRECTORY ||
+        size_result.error_code == DE100_FILE_ERROR_NOT_A_FILE;
+    return file_load_error(not_a_file ? DE100_FILE_LOAD_ERROR_NOT_A_FILE
+                                      : DE100_FILE_LOAD_ERROR_READ_FAILED,
+                           size_result.error_code);
+  }
+
+  u64 size = (u64)size_result.value;
+  u64 terminator = (flags & DE100_FILE_LOAD_NUL_TERMINATE) ? 1 : 0;
+  if (size > (u64)SIZE_MAX - DE100_FILE_DIRECT_ALIGNMENT) {
+    de100_file_close(file.fd);
+    return file_load_error(DE100_FILE_LOAD_ERROR_TOO_LARGE,
+                           DE100_FILE_ERROR_TOO_LARGE);
+  }
+
+  // ─────────────────────────────────────────────────────────────────────
+  // Room: direct wants whole aligned blocks; settle for a buffered read
+  // when only the file itself fits, and for a mapping when not even that
+  // ─────────────────────────────────────────────────────────────────────
+  bool direct = !(flags & DE100_FILE_LOAD_NO_DIRECT) &&
+                size >= DE100_FILE_LOAD_DIRECT_MIN_SIZE;
+  u64 reserve = file_load_round_up(size + terminator,
+                                   DE100_FILE_DIRECT_ALIGNMENT);
+  if (direct && reserve > de100_arena_remaining(
+                              arena, DE100_FILE_DIRECT_ALIGNMENT)) {
+    direct = false;
+  }
+  u64 alignment =
+      direct ? DE100_FILE_DIRECT_ALIGNMENT : DE100_FILE_LOAD_ALIGNMENT;
+  if (!direct) {
+    reserve = size + terminator;
+  }
+
+  if (reserve == 0) {
+    de100_file_close(file.fd);
+    return (De100FileLoadResult){.success = true};
+  }
+
+  u64 arena_used = arena->used;
+  u8 *data = NULL;
+  if (reserve <= de100_arena_remaining(arena, alignment)) {
+    data = de100_arena_push_size_aligned(arena, reserve, alignment);
+  }
+  if (!data) {
+    de100_file_close(file.fd);
+    if ((flags & DE100_FILE_LOAD_ALLOW_MAP) && !terminator) {
+      return file_load_map(path);
+    }
+    return file_load_error(DE100_FILE_LOAD_ERROR_ARENA_FULL,
+                           DE100_FILE_SUCCESS);
+  }
+
+  // ─────────────────────────────────────────────────────────────────────
+  // Read
+  // ─────────────────────────────────────────────────────────────────────
+  if (direct) {
+    direct = de100_file_set_direct(file.fd, true);
+  }
+  if (!direct) {
+    de100_file_advise(file.fd, DE100_FILE_MAP_ADVICE_SEQUENTIAL |
+                                   DE100_FILE_MAP_ADVICE_WILLNEED);
+  }
+
+  De100FileErrorCode error = file_load_read(file.fd, data, size, direct);
+  if (error != DE100_FILE_SUCCESS && direct) {
+    // Some filesystems take O_DIRECT at fcntl() and only refuse the read
+    // (EINVAL): read it all again through the cache
+    direct = false;
+    de100_file_set_direct(file.fd, false);
+    De100FileSizeResult rewound = de100_file_seek(file.fd, 0, DE100_SEEK_SET);
+    if (rewound.success) {
+      de100_file_advise(file.fd, DE100_FILE_MAP_ADVICE_SEQUENTIAL);
+      error = file_load_read(file.fd, data, size, false);
+    }
+  }
+  de100_file_close(file.fd);
+
+  if (error != DE100_FILE_SUCCESS) {
+    de100_arena_pop_to(arena, arena_used);
+    return file_load_error(DE100_FILE_LOAD_ERROR_READ_FAILED, error);
+  }
+
+  if (terminator) {
+    data[size] = 0;
+  }
+
+#if !DE100_ARENA_GUARD_PAGES
+  // Give back the direct read's block padding (guard-page pushes end at
+  // their guard and keep it)
+  u64 end = (u64)(data - arena->base) + size + terminator;
+  if (end < arena->used) {
+    de100_arena_pop_to(arena, end);
+  }
+#endif
+
+  return (De100FileLoadResult){
+      .data = data,
+      .size = size,
+      .success = true,
+      .was_direct = direct,
+  };
+}
+
+void de100_file_load_release(De100FileLoadResult *result) {
+  if (!result || !result->is_mapped) {
+    return;
+  }
+  de100_file_unmap(&result->mapping);
+  *result = (De100FileLoadResult){0};
+}
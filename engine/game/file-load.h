@@ -0,0 +1,98 @@
+#ifndef DE100_GAME_FILE_LOAD_H
+#define DE100_GAME_FILE_LOAD_H
+
+#include "../_common/base.h"
+#include "../_common/file.h"
+#include "memory-arena.h"
+#include <stdbool.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// 📂 FILE LOAD (whole files into an arena)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// The production counterpart to de100_debug_read_entire_file: the bytes
+// land in an arena the caller already owns, so loading levels and assets
+// all session long allocates nothing and fragments nothing. Free them the
+// arena way (a temp scope, de100_arena_pop_to, or the arena's reset).
+//
+//   u64 mark = state->level_arena.used;
+//   De100FileLoadResult file = de100_file_load(
+//       &state->level_arena, "data/level3.txt",
+//       DE100_FILE_LOAD_NUL_TERMINATE);
+//   if (file.success) {
+//     parse_level(file.data, file.size);
+//   }
+//   ...
+//   de100_arena_pop_to(&state->level_arena, mark); // next level
+//
+// Sizes are 64-bit. How the bytes are read depends on the size:
+//
+//   - small files: one buffered read, with SEQUENTIAL + WILLNEED read-ahead
+//     hints (de100_file_advise) so the kernel streams ahead of it
+//   - DE100_FILE_LOAD_DIRECT_MIN_SIZE and up: a direct read
+//     (de100_file_set_direct) into a DE100_FILE_DIRECT_ALIGNMENT-aligned
+//     block in DE100_FILE_LOAD_CHUNK_SIZE pieces. A one-shot load of a big
+//     file then skips the copy through the page cache and doesn't evict
+//     what the game is using. Where direct reads aren't supported the same
+//     loop reads buffered; the alignment padding is popped off afterwards.
+//
+// DE100_FILE_LOAD_ALLOW_MAP: when the arena is too small, map the file
+// read-only instead (de100_file_map_readonly) and set is_mapped; release
+// that one with de100_file_load_release. Arena loads never need it
+// (calling it anyway is harmless).
+//
+// Keep the bytes in an arena that matches their lifetime; a mapped result
+// belongs to the process, so like an asset pack it must not be kept in
+// game memory across a hot reload or replay restore.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define DE100_FILE_LOAD_ALIGNMENT 64 // Buffered loads (cache line, SIMD)
+#define DE100_FILE_LOAD_DIRECT_MIN_SIZE (16ull * 1024 * 1024)
+#define DE100_FILE_LOAD_CHUNK_SIZE (8ull * 1024 * 1024) // Per read()
+
+typedef enum {
+  DE100_FILE_LOAD_NUL_TERMINATE = 1 << 0, // data[size] == 0 (text files)
+  DE100_FILE_LOAD_ALLOW_MAP = 1 << 1,     // Map when the arena is too small
+  DE100_FILE_LOAD_NO_DIRECT = 1 << 2,     // Always read through the cache
+} De100FileLoadFlags;
+
+typedef enum {
+  DE100_FILE_LOAD_SUCCESS = 0,
+  DE100_FILE_LOAD_ERROR_NULL_ARGUMENT,
+  DE100_FILE_LOAD_ERROR_OPEN_FAILED,
+  DE100_FILE_LOAD_ERROR_NOT_A_FILE,
+  DE100_FILE_LOAD_ERROR_TOO_LARGE,
+  DE100_FILE_LOAD_ERROR_ARENA_FULL,
+  DE100_FILE_LOAD_ERROR_READ_FAILED,
+  DE100_FILE_LOAD_ERROR_MAP_FAILED,
+
+  DE100_FILE_LOAD_ERROR_COUNT
+} De100FileLoadErrorCode;
+
+typedef struct {
+  // Arena bytes, or the mapping's (read-only) when is_mapped. NULL for an
+  // empty file unless NUL_TERMINATE gave it its terminator.
+  void *data;
+  u64 size;
+  bool success;
+  bool is_mapped;
+  bool was_direct;              // Read around the page cache
+  De100FileMapping mapping;     // When is_mapped
+  De100FileErrorCode file_error; // The file.h error behind a failure
+  De100FileLoadErrorCode error_code;
+} De100FileLoadResult;
+
+/**
+ * Read all of `path` into `arena` (De100FileLoadFlags). On failure the
+ * arena is left exactly as it was.
+ */
+De100FileLoadResult de100_file_load(De100MemoryArena *arena, const char *path,
+                                    u32 flags);
+
+/** Unmap a mapped result and zero it. Arena results are left alone. */
+void de100_file_load_release(De100FileLoadResult *result);
+
+const char *de100_file_load_strerror(De100FileLoadErrorCode code);
+
+#endif // DE100_GAME_FILE_LOAD_H
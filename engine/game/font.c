@@ -0,0 +1,1104 @@
+#include "font.h"
+#include "../_common/file.h"
+#include "pixel-kernels.h"
+
+#include <math.h>
+#include <string.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ERROR MESSAGES
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_global_var const char *g_font_error_messages[] = {
+    [DE100_FONT_SUCCESS] = "Success",
+    [DE100_FONT_ERROR_NULL_ARGUMENT] = "NULL font, face, arena or data",
+    [DE100_FONT_ERROR_OPEN_FAILED] = "Failed to open font file",
+    [DE100_FONT_ERROR_READ_FAILED] = "Failed to read font file",
+    [DE100_FONT_ERROR_NOT_TRUETYPE] =
+        "Not a TrueType font (CFF outlines and collections unsupported)",
+    [DE100_FONT_ERROR_MISSING_TABLE] = "Font is missing a required table",
+    [DE100_FONT_ERROR_NO_UNICODE_CMAP] = "Font has no Unicode character map",
+    [DE100_FONT_ERROR_OUT_OF_MEMORY] = "Not enough arena space for the font",
+};
+
+const char *de100_font_strerror(De100FontErrorCode code) {
+  if (code >= 0 && code < DE100_FONT_ERROR_COUNT) {
+    return g_font_error_messages[code];
+  }
+  return "Unknown font error";
+}
+
+de100_file_scoped_fn inline De100FontResult
+font_result(De100FontErrorCode code) {
+  return (De100FontResult){
+      .success = code == DE100_FONT_SUCCESS,
+      .error_code = code,
+  };
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// TRUETYPE TABLES
+// ═══════════════════════════════════════════════════════════════════════════
+//
+//   offset table: sfnt version, table count, { tag checksum offset length }
+//
+// Every field is big-endian. Reads past the end of the file return 0, so a
+// truncated or hostile font degrades to blank glyphs instead of crashing.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define TTF_TAG(a, b, c, d)                                                    \
+  ((u32)(a) << 24 | (u32)(b) << 16 | (u32)(c) << 8 | (u32)(d))
+
+// Simple glyph point flags
+#define TTF_ON_CURVE 0x01
+#define TTF_X_SHORT 0x02
+#define TTF_Y_SHORT 0x04
+#define TTF_REPEAT 0x08
+#define TTF_X_SAME_OR_POSITIVE 0x10
+#define TTF_Y_SAME_OR_POSITIVE 0x20
+
+// Composite glyph component flags
+#define TTF_ARGS_ARE_WORDS 0x0001
+#define TTF_ARGS_ARE_XY 0x0002
+#define TTF_HAVE_SCALE 0x0008
+#define TTF_MORE_COMPONENTS 0x0020
+#define TTF_HAVE_XY_SCALE 0x0040
+#define TTF_HAVE_2X2 0x0080
+
+#define TTF_MAX_COMPOSITE_DEPTH 8
+
+de100_file_scoped_fn inline u8 ttf_u8(const De100FontFace *face, u64 offset) {
+  return offset < face->size ? face->data[offset] : 0;
+}
+
+de100_file_scoped_fn inline u16 ttf_u16(const De100FontFace *face,
+                                        u64 offset) {
+  if (offset + 2 > face->size) {
+    return 0;
+  }
+  const u8 *p = face->data + offset;
+  return (u16)((u16)p[0] << 8 | p[1]);
+}
+
+de100_file_scoped_fn inline i16 ttf_i16(const De100FontFace *face,
+                                        u64 offset) {
+  return (i16)ttf_u16(face, offset);
+}
+
+de100_file_scoped_fn inline u32 ttf_u32(const De100FontFace *face,
+                                        u64 offset) {
+  if (offset + 4 > face->size) {
+    return 0;
+  }
+  const u8 *p = face->data + offset;
+  return (u32)p[0] << 24 | (u32)p[1] << 16 | (u32)p[2] << 8 | p[3];
+}
+
+// Offset of table `tag`, 0 if absent or not inside the file
+de100_file_scoped_fn u32 ttf_find_table(const De100FontFace *face, u32 tag,
+                                        u32 min_length) {
+  u16 table_count = ttf_u16(face, 4);
+  for (u32 i = 0; i < table_count; ++i) {
+    u32 record = 12 + 16 * i;
+    if (ttf_u32(face, record) != tag) {
+      continue;
+    }
+    u32 offset = ttf_u32(face, record + 8);
+    u32 length = ttf_u32(face, record + 12);
+    if (length < min_length || (u64)offset + length > face->size) {
+      return 0;
+    }
+    return offset;
+  }
+  return 0;
+}
+
+// Best Unicode subtable: full repertoire (format 12) over BMP (format 4)
+de100_file_scoped_fn bool ttf_pick_cmap(De100FontFace *face, u32 cmap) {
+  u32 best = 0;
+  i32 best_rank = 0;
+  u16 table_count = ttf_u16(face, cmap + 2);
+  for (u32 i = 0; i < table_count; ++i) {
+    u32 record = cmap + 4 + 8 * i;
+    u16 platform = ttf_u16(face, record);
+    u16 encoding = ttf_u16(face, record + 2);
+    u32 subtable = cmap + ttf_u32(face, record + 4);
+    u16 format = ttf_u16(face, subtable);
+
+    bool is_unicode = platform == 0 || (platform == 3 && encoding == 1) ||
+                      (platform == 3 && encoding == 10);
+    i32 rank = !is_unicode ? 0 : format == 12 ? 2 : format == 4 ? 1 : 0;
+    if (rank > best_rank) {
+      best = subtable;
+      best_rank = rank;
+    }
+  }
+  face->cmap_subtable = best;
+  face->cmap_is_format12 = best_rank == 2;
+  return best_rank > 0;
+}
+
+de100_file_scoped_fn u16 ttf_glyph_index(const De100FontFace *face,
+                                         u32 codepoint) {
+  u32 table = face->cmap_subtable;
+
+  if (face->cmap_is_format12) {
+    // Sorted groups { start end start_glyph }: binary search
+    u32 lo = 0;
+    u32 hi = ttf_u32(face, table + 12);
+    while (lo < hi) {
+      u32 mid = lo + (hi - lo) / 2;
+      u32 group = table + 16 + 12 * mid;
+      u32 start = ttf_u32(face, group);
+      u32 end = ttf_u32(face, group + 4);
+      if (codepoint < start) {
+        hi = mid;
+      } else if (codepoint > end) {
+        lo = mid + 1;
+      } else {
+        u32 glyph = ttf_u32(face, group + 8) + (codepoint - start);
+        return glyph < face->glyph_count ? (u16)glyph : 0;
+      }
+    }
+    return 0;
+  }
+
+  // Format 4: parallel arrays of segment end/start/delta/range offset
+  if (codepoint > 0xFFFF) {
+    return 0;
+  }
+  u32 segment_count = ttf_u16(face, table + 6) / 2;
+  u32 ends = table + 14;
+  u32 starts = ends + 2 * segment_count + 2;
+  u32 deltas = starts + 2 * segment_count;
+  u32 range_offsets = deltas + 2 * segment_count;
+  for (u32 i = 0; i < segment_count; ++i) {
+    if (ttf_u16(face, ends + 2 * i) < codepoint) {
+      continue;
+    }
+    u16 start = ttf_u16(face, starts + 2 * i);
+    if (start > codepoint) {
+      return 0;
+    }
+    u16 delta = ttf_u16(face, deltas + 2 * i);
+    u16 range_offset = ttf_u16(face, range_offsets + 2 * i);
+    u16 glyph;
+    if (range_offset == 0) {
+      glyph = (u16)(codepoint + delta);
+    } else {
+      glyph = ttf_u16(face, range_offsets + 2 * i + range_offset +
+                                2 * (codepoint - start));
+      if (glyph != 0) {
+        glyph = (u16)(glyph + delta);
+      }
+    }
+    return glyph < face->glyph_count ? glyph : 0;
+  }
+  return 0;
+}
+
+// [start, end) of a glyph's outline in glyf; empty for blank glyphs
+de100_file_scoped_fn inline bool ttf_glyph_range(const De100FontFace *face,
+                                                 u16 glyph, u32 *out_start,
+                                                 u32 *out_end) {
+  if (glyph >= face->glyph_count) {
+    return false;
+  }
+  u32 start, end;
+  if (face->long_loca) {
+    start = ttf_u32(face, face->loca + 4 * (u32)glyph);
+    end = ttf_u32(face, face->loca + 4 * (u32)glyph + 4);
+  } else {
+    start = 2u * ttf_u16(face, face->loca + 2 * (u32)glyph);
+    end = 2u * ttf_u16(face, face->loca + 2 * (u32)glyph + 2);
+  }
+  *out_start = face->glyf + start;
+  *out_end = face->glyf + end;
+  return end > start && (u64)*out_end <= face->size;
+}
+
+de100_file_scoped_fn inline u16 ttf_advance(const De100FontFace *face,
+                                            u16 glyph) {
+  u32 metric = glyph < face->h_metric_count ? glyph : face->h_metric_count - 1;
+  return ttf_u16(face, face->hmtx + 4 * metric);
+}
+
+// Pair adjustment in font units ('kern' format 0: sorted by left << 16 |
+// right, so binary search)
+de100_file_scoped_fn i16 ttf_kerning(const De100FontFace *face, u16 left,
+                                     u16 right) {
+  u32 key = (u32)left << 16 | right;
+  u32 lo = 0;
+  u32 hi = face->kern_pair_count;
+  while (lo < hi) {
+    u32 mid = lo + (hi - lo) / 2;
+    u32 pair = face->kern_pairs + 6 * mid;
+    u32 pair_key = ttf_u32(face, pair);
+    if (key < pair_key) {
+      hi = mid;
+    } else if (key > pair_key) {
+      lo = mid + 1;
+    } else {
+      return ttf_i16(face, pair + 4);
+    }
+  }
+  return 0;
+}
+
+de100_file_scoped_fn De100FontErrorCode ttf_parse(De100FontFace *face) {
+  u32 version = ttf_u32(face, 0);
+  if (version != 0x00010000u && version != TTF_TAG('t', 'r', 'u', 'e')) {
+    return DE100_FONT_ERROR_NOT_TRUETYPE;
+  }
+
+  u32 head = ttf_find_table(face, TTF_TAG('h', 'e', 'a', 'd'), 54);
+  u32 hhea = ttf_find_table(face, TTF_TAG('h', 'h', 'e', 'a'), 36);
+  u32 maxp = ttf_find_table(face, TTF_TAG('m', 'a', 'x', 'p'), 6);
+  u32 cmap = ttf_find_table(face, TTF_TAG('c', 'm', 'a', 'p'), 4);
+  face->hmtx = ttf_find_table(face, TTF_TAG('h', 'm', 't', 'x'), 4);
+  face->loca = ttf_find_table(face, TTF_TAG('l', 'o', 'c', 'a'), 2);
+  face->glyf = ttf_find_table(face, TTF_TAG('g', 'l', 'y', 'f'), 0);
+  if (!face->glyf && ttf_find_table(face, TTF_TAG('C', 'F', 'F', ' '), 0)) {
+    return DE100_FONT_ERROR_NOT_TRUETYPE;
+  }
+  if (!head || !hhea || !maxp || !cmap || !face->hmtx || !face->loca ||
+      !face->glyf) {
+    return DE100_FONT_ERROR_MISSING_TABLE;
+  }
+
+  face->units_per_em = ttf_u16(face, head + 18);
+  face->bbox[0] = ttf_i16(face, head + 36);
+  face->bbox[1] = ttf_i16(face, head + 38);
+  face->bbox[2] = ttf_i16(face, head + 40);
+  face->bbox[3] = ttf_i16(face, head + 42);
+  face->long_loca = ttf_i16(face, head + 50) != 0;
+
+  face->ascent = ttf_i16(face, hhea + 4);
+  face->descent = ttf_i16(face, hhea + 6);
+  face->line_gap = ttf_i16(face, hhea + 8);
+  face->h_metric_count = ttf_u16(face, hhea + 34);
+
+  face->glyph_count = ttf_u16(face, maxp + 4);
+  face->max_points = ttf_u16(face, maxp + 6);
+  if (face->units_per_em == 0 || face->h_metric_count == 0 ||
+      face->glyph_count == 0 || face->ascent <= face->descent) {
+    return DE100_FONT_ERROR_NOT_TRUETYPE;
+  }
+
+  if (!ttf_pick_cmap(face, cmap)) {
+    return DE100_FONT_ERROR_NO_UNICODE_CMAP;
+  }
+
+  // First horizontal format 0 subtable of the (Microsoft) 'kern' table
+  u32 kern = ttf_find_table(face, TTF_TAG('k', 'e', 'r', 'n'), 4);
+  if (kern && ttf_u16(face, kern) == 0) {
+    u32 subtable = kern + 4;
+    u16 subtable_count = ttf_u16(face, kern + 2);
+    for (u32 i = 0; i < subtable_count; ++i) {
+      u16 length = ttf_u16(face, subtable + 2);
+      u16 coverage = ttf_u16(face, subtable + 4);
+      if ((coverage >> 8) == 0 && (coverage & 0x1)) {
+        face->kern_pair_count = ttf_u16(face, subtable + 6);
+        face->kern_pairs = subtable + 14;
+        break;
+      }
+      if (length == 0) {
+        break;
+      }
+      subtable += length;
+    }
+  }
+  return DE100_FONT_SUCCESS;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// FACES
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn De100FontResult font_face_parse_in_arena(
+    De100FontFace *face, De100MemoryArena *arena, u64 arena_used, u8 *bytes,
+    u64 size) {
+  *face = (De100FontFace){.data = bytes, .size = (u32)size};
+  De100FontErrorCode code = ttf_parse(face);
+  if (code != DE100_FONT_SUCCESS) {
+    de100_arena_pop_to(arena, arena_used);
+    *face = (De100FontFace){0};
+  }
+  return font_result(code);
+}
+
+De100FontResult de100_font_face_init(De100FontFace *face,
+                                     De100MemoryArena *arena,
+                                     const void *data, u64 size) {
+  if (!face || !arena || !data || size < 12 || size > 0xFFFFFFFFu) {
+    return font_result(DE100_FONT_ERROR_NULL_ARGUMENT);
+  }
+
+  u64 arena_used = arena->used;
+  u8 *bytes = (u8 *)de100_arena_push_size(arena, size);
+  if (!bytes) {
+    return font_result(DE100_FONT_ERROR_OUT_OF_MEMORY);
+  }
+  memcpy(bytes, data, size);
+  return font_face_parse_in_arena(face, arena, arena_used, bytes, size);
+}
+
+De100FontResult de100_font_face_load(De100FontFace *face,
+                                     De100MemoryArena *arena,
+                                     const char *path) {
+  if (!face || !arena || !path) {
+    return font_result(DE100_FONT_ERROR_NULL_ARGUMENT);
+  }
+
+  De100FileSizeResult size = de100_file_get_size(path);
+  if (!size.success || size.value < 12 || size.value > 0xFFFFFFFF) {
+    return font_result(DE100_FONT_ERROR_OPEN_FAILED);
+  }
+  De100FileOpenResult file = de100_file_open(path, DE100_FILE_READ);
+  if (!file.success) {
+    return font_result(DE100_FONT_ERROR_OPEN_FAILED);
+  }
+
+  u64 arena_used = arena->used;
+  u8 *bytes = (u8 *)de100_arena_push_size(arena, (u64)size.value);
+  if (!bytes) {
+    de100_file_close(file.fd);
+    return font_result(DE100_FONT_ERROR_OUT_OF_MEMORY);
+  }
+  bool read = de100_file_read_all(file.fd, bytes, (size_t)size.value).success;
+  de100_file_close(file.fd);
+  if (!read) {
+    de100_arena_pop_to(arena, arena_used);
+    return font_result(DE100_FONT_ERROR_READ_FAILED);
+  }
+  return font_face_parse_in_arena(face, arena, arena_used, bytes,
+                                  (u64)size.value);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// RASTERIZER
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// Exact-area coverage: every outline edge adds its signed area, cell by
+// cell, into an accumulation buffer; a running sum along each row then
+// turns those into coverage (non-zero fill, anti-aliased, no
+// supersampling). Curves are flattened into lines first.
+//
+//   accumulator row:  +0.3 +0.7  0    0    0   -0.6 -0.4
+//   running sum:       0.3  1.0  1.0  1.0  1.0  0.4  0.0   ← coverage
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+typedef struct {
+  f32 *accumulator; // stride width + 2 (edges may spill two cells right)
+  i32 width;
+  i32 height;
+} FontRaster;
+
+typedef struct {
+  // Font units → glyph pixels: x' = xx*x + xy*y + dx, y' = yx*x + yy*y + dy
+  f32 xx, xy, yx, yy;
+  f32 dx, dy;
+} FontTransform;
+
+de100_file_scoped_fn inline f32 font_clampf(f32 value, f32 max) {
+  return value < 0.0f ? 0.0f : value > max ? max : value;
+}
+
+de100_file_scoped_fn void font_raster_line(FontRaster *raster, f32 x0, f32 y0,
+                                           f32 x1, f32 y1) {
+  x0 = font_clampf(x0, (f32)raster->width);
+  x1 = font_clampf(x1, (f32)raster->width);
+  y0 = font_clampf(y0, (f32)raster->height);
+  y1 = font_clampf(y1, (f32)raster->height);
+  if (y0 == y1) {
+    return;
+  }
+
+  f32 direction = 1.0f;
+  if (y0 > y1) {
+    f32 t = x0;
+    x0 = x1;
+    x1 = t;
+    t = y0;
+    y0 = y1;
+    y1 = t;
+    direction = -1.0f;
+  }
+
+  f32 dxdy = (x1 - x0) / (y1 - y0);
+  f32 x = x0;
+  i32 stride = raster->width + 2;
+  i32 row_end = (i32)ceilf(y1);
+  if (row_end > raster->height) {
+    row_end = raster->height;
+  }
+  for (i32 row = (i32)y0; row < row_end; ++row) {
+    f32 *cells = raster->accumulator + (size_t)row * (size_t)stride;
+    f32 top = (f32)row > y0 ? (f32)row : y0;
+    f32 bottom = (f32)(row + 1) < y1 ? (f32)(row + 1) : y1;
+    f32 dy = bottom - top;
+    f32 x_next = x + dxdy * dy;
+    f32 d = dy * direction;
+
+    f32 left = x < x_next ? x : x_next;
+    f32 right = x < x_next ? x_next : x;
+    f32 left_floor = floorf(left);
+    i32 left_cell = (i32)left_floor;
+    i32 right_cell = (i32)ceilf(right);
+
+    if (right_cell <= left_cell + 1) {
+      // Inside one cell: split by the mean x
+      f32 mid = 0.5f * (x + x_next) - left_floor;
+      cells[left_cell] += d - d * mid;
+      cells[left_cell + 1] += d * mid;
+    } else {
+      // Across cells: trapezoid areas, first and last cells partial
+      f32 inv_width = 1.0f / (right - left);
+      f32 left_frac = left - left_floor;
+      f32 first = 0.5f * inv_width * (1.0f - left_frac) * (1.0f - left_frac);
+      f32 right_frac = right - (f32)right_cell + 1.0f;
+      f32 last = 0.5f * inv_width * right_frac * right_frac;
+      cells[left_cell] += d * first;
+      if (right_cell == left_cell + 2) {
+        cells[left_cell + 1] += d * (1.0f - first - last);
+      } else {
+        f32 second = inv_width * (1.5f - left_frac);
+        cells[left_cell + 1] += d * (second - first);
+        for (i32 cell = left_cell + 2; cell < right_cell - 1; ++cell) {
+          cells[cell] += d * inv_width;
+        }
+        f32 before_last =
+            second + (f32)(right_cell - left_cell - 3) * inv_width;
+        cells[right_cell - 1] += d * (1.0f - before_last - last);
+      }
+      cells[right_cell] += d * last;
+    }
+    x = x_next;
+  }
+}
+
+// Flattened into as few lines as keep the error under ~1/3 pixel
+de100_file_scoped_fn void font_raster_quad(FontRaster *raster, f32 x0, f32 y0,
+                                           f32 cx, f32 cy, f32 x1, f32 y1) {
+  f32 dev_x = x0 - 2.0f * cx + x1;
+  f32 dev_y = y0 - 2.0f * cy + y1;
+  f32 dev_sq = dev_x * dev_x + dev_y * dev_y;
+  if (dev_sq < 0.333f) {
+    font_raster_line(raster, x0, y0, x1, y1);
+    return;
+  }
+
+  i32 steps = 1 + (i32)floorf(sqrtf(sqrtf(3.0f * dev_sq)));
+  f32 step = 1.0f / (f32)steps;
+  f32 px = x0;
+  f32 py = y0;
+  for (i32 i = 1; i <= steps; ++i) {
+    f32 t = (f32)i * step;
+    f32 u = 1.0f - t;
+    f32 nx = u * u * x0 + 2.0f * u * t * cx + t * t * x1;
+    f32 ny = u * u * y0 + 2.0f * u * t * cy + t * t * y1;
+    font_raster_line(raster, px, py, nx, ny);
+    px = nx;
+    py = ny;
+  }
+}
+
+// One contour of `count` points. Consecutive off-curve points have an
+// implied on-curve point halfway between them.
+de100_file_scoped_fn void font_raster_contour(FontRaster *raster,
+                                              const f32 *points,
+                                              const u8 *flags, u32 count) {
+  if (count < 2) {
+    return;
+  }
+
+#define FONT_PX(i) points[2 * (i)]
+#define FONT_PY(i) points[2 * (i) + 1]
+  u32 last = count - 1;
+  f32 begin_x, begin_y;
+  u32 first;
+  if (flags[0] & TTF_ON_CURVE) {
+    begin_x = FONT_PX(0);
+    begin_y = FONT_PY(0);
+    first = 1;
+  } else if (flags[last] & TTF_ON_CURVE) {
+    begin_x = FONT_PX(last);
+    begin_y = FONT_PY(last);
+    first = 0;
+  } else {
+    begin_x = 0.5f * (FONT_PX(0) + FONT_PX(last));
+    begin_y = 0.5f * (FONT_PY(0) + FONT_PY(last));
+    first = 0;
+  }
+
+  f32 x = begin_x, y = begin_y;
+  f32 control_x = 0.0f, control_y = 0.0f;
+  bool has_control = false;
+  for (u32 i = first; i < count; ++i) {
+    f32 px = FONT_PX(i);
+    f32 py = FONT_PY(i);
+    if (flags[i] & TTF_ON_CURVE) {
+      if (has_control) {
+        font_raster_quad(raster, x, y, control_x, control_y, px, py);
+      } else {
+        font_raster_line(raster, x, y, px, py);
+      }
+      has_control = false;
+      x = px;
+      y = py;
+    } else {
+      if (has_control) {
+        f32 mid_x = 0.5f * (control_x + px);
+        f32 mid_y = 0.5f * (control_y + py);
+        font_raster_quad(raster, x, y, control_x, control_y, mid_x, mid_y);
+        x = mid_x;
+        y = mid_y;
+      }
+      control_x = px;
+      control_y = py;
+      has_control = true;
+    }
+  }
+  if (has_control) {
+    font_raster_quad(raster, x, y, control_x, control_y, begin_x, begin_y);
+  } else {
+    font_raster_line(raster, x, y, begin_x, begin_y);
+  }
+#undef FONT_PX
+#undef FONT_PY
+}
+
+de100_file_scoped_fn void font_raster_glyph(De100Font *font,
+                                            FontRaster *raster, u16 glyph,
+                                            FontTransform transform,
+                                            i32 depth) {
+  const De100FontFace *face = font->face;
+  u32 start, end;
+  if (depth > TTF_MAX_COMPOSITE_DEPTH ||
+      !ttf_glyph_range(face, glyph, &start, &end)) {
+    return;
+  }
+
+  i16 contour_count = ttf_i16(face, start);
+  if (contour_count < 0) {
+    // Composite: other glyphs, each placed by its own transform
+    u64 at = start + 10;
+    u16 component_flags;
+    do {
+      component_flags = ttf_u16(face, at);
+      u16 component = ttf_u16(face, at + 2);
+      at += 4;
+      f32 offset_x = 0.0f, offset_y = 0.0f;
+      if (component_flags & TTF_ARGS_ARE_WORDS) {
+        offset_x = (f32)ttf_i16(face, at);
+        offset_y = (f32)ttf_i16(face, at + 2);
+        at += 4;
+      } else {
+        offset_x = (f32)(i8)ttf_u8(face, at);
+        offset_y = (f32)(i8)ttf_u8(face, at + 1);
+        at += 2;
+      }
+      if (!(component_flags & TTF_ARGS_ARE_XY)) {
+        offset_x = offset_y = 0.0f; // Point matching: not supported
+      }
+
+      f32 a = 1.0f, b = 0.0f, c = 0.0f, d = 1.0f; // F2Dot14
+      if (component_flags & TTF_HAVE_SCALE) {
+        a = d = (f32)ttf_i16(face, at) / 16384.0f;
+        at += 2;
+      } else if (component_flags & TTF_HAVE_XY_SCALE) {
+        a = (f32)ttf_i16(face, at) / 16384.0f;
+        d = (f32)ttf_i16(face, at + 2) / 16384.0f;
+        at += 4;
+      } else if (component_flags & TTF_HAVE_2X2) {
+        a = (f32)ttf_i16(face, at) / 16384.0f;
+        b = (f32)ttf_i16(face, at + 2) / 16384.0f;
+        c = (f32)ttf_i16(face, at + 4) / 16384.0f;
+        d = (f32)ttf_i16(face, at + 6) / 16384.0f;
+        at += 8;
+      }
+
+      // parent ∘ (x, y) ↦ (a x + c y + offset_x, b x + d y + offset_y)
+      FontTransform child = {
+          .xx = transform.xx * a + transform.xy * b,
+          .xy = transform.xx * c + transform.xy * d,
+          .yx = transform.yx * a + transform.yy * b,
+          .yy = transform.yx * c + transform.yy * d,
+          .dx = transform.xx * offset_x + transform.xy * offset_y +
+                transform.dx,
+          .dy = transform.yx * offset_x + transform.yy * offset_y +
+                transform.dy,
+      };
+      font_raster_glyph(font, raster, component, child, depth + 1);
+    } while ((component_flags & TTF_MORE_COMPONENTS) && at < end);
+    return;
+  }
+
+  // Simple: end points, instructions (skipped), flags, then x and y deltas
+  u64 end_points = start + 10;
+  u32 point_count =
+      contour_count ? (u32)ttf_u16(face, end_points + 2 * (contour_count - 1)) + 1
+                    : 0;
+  if (point_count == 0 || point_count > face->max_points) {
+    return;
+  }
+  u64 at = end_points + 2 * (u64)contour_count;
+  at += 2 + ttf_u16(face, at);
+
+  u8 *flags = font->outline_flags;
+  for (u32 i = 0; i < point_count;) {
+    u8 flag = ttf_u8(face, at++);
+    u32 repeat = (flag & TTF_REPEAT) ? ttf_u8(face, at++) : 0;
+    for (u32 r = 0; r <= repeat && i < point_count; ++r) {
+      flags[i++] = flag;
+    }
+  }
+
+  f32 *points = font->outline_points;
+  for (u32 axis = 0; axis < 2; ++axis) {
+    u8 short_bit = axis ? TTF_Y_SHORT : TTF_X_SHORT;
+    u8 same_bit = axis ? TTF_Y_SAME_OR_POSITIVE : TTF_X_SAME_OR_POSITIVE;
+    i32 value = 0;
+    for (u32 i = 0; i < point_count; ++i) {
+      if (flags[i] & short_bit) {
+        i32 delta = ttf_u8(face, at++);
+        value += (flags[i] & same_bit) ? delta : -delta;
+      } else if (!(flags[i] & same_bit)) {
+        value += ttf_i16(face, at);
+        at += 2;
+      }
+      points[2 * i + axis] = (f32)value;
+    }
+  }
+  for (u32 i = 0; i < point_count; ++i) {
+    f32 x = points[2 * i];
+    f32 y = points[2 * i + 1];
+    points[2 * i] = transform.xx * x + transform.xy * y + transform.dx;
+    points[2 * i + 1] = transform.yx * x + transform.yy * y + transform.dy;
+  }
+
+  u32 contour_start = 0;
+  for (i32 contour = 0; contour < contour_count; ++contour) {
+    u32 contour_end = (u32)ttf_u16(face, end_points + 2 * (u32)contour) + 1;
+    if (contour_end > point_count || contour_end <= contour_start) {
+      break;
+    }
+    font_raster_contour(raster, points + 2 * contour_start,
+                        flags + contour_start, contour_end - contour_start);
+    contour_start = contour_end;
+  }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// GLYPH CACHE
+// ═══════════════════════════════════════════════════════════════════════════
+
+// Rasterize `glyph` into `out` and copy it into the atlas (shelf packed)
+de100_file_scoped_fn void font_rasterize(De100Font *font, u16 glyph,
+                                         De100FontGlyph *out) {
+  const De100FontFace *face = font->face;
+  f32 scale = font->scale;
+  *out = (De100FontGlyph){
+      .glyph_index = glyph,
+      .advance = (f32)ttf_advance(face, glyph) * scale,
+  };
+
+  u32 start, end;
+  if (!ttf_glyph_range(face, glyph, &start, &end)) {
+    return;
+  }
+  i32 x0 = (i32)floorf((f32)ttf_i16(face, start + 2) * scale);
+  i32 y0 = (i32)floorf(-(f32)ttf_i16(face, start + 8) * scale);
+  i32 x1 = (i32)ceilf((f32)ttf_i16(face, start + 6) * scale);
+  i32 y1 = (i32)ceilf(-(f32)ttf_i16(face, start + 4) * scale);
+  i32 width = x1 - x0;
+  i32 height = y1 - y0;
+  if (width <= 0 || height <= 0) {
+    return;
+  }
+  if (width > font->scratch_width || height > font->scratch_height) {
+    width = width < font->scratch_width ? width : font->scratch_width;
+    height = height < font->scratch_height ? height : font->scratch_height;
+  }
+
+  // Room in the atlas? Next shelf when this one is full
+  i32 pad = DE100_FONT_ATLAS_PADDING;
+  if (font->shelf_x + width > font->atlas_width) {
+    font->shelf_x = 0;
+    font->shelf_y += font->shelf_height + pad;
+    font->shelf_height = 0;
+  }
+  if (width > font->atlas_width ||
+      font->shelf_y + height > font->atlas_height) {
+    font->stats.glyph_atlas_full++;
+    return;
+  }
+
+  i32 stride = width + 2;
+  memset(font->coverage_accumulator, 0,
+         (size_t)stride * (size_t)height * sizeof(f32));
+  FontRaster raster = {font->coverage_accumulator, width, height};
+  FontTransform transform = {
+      .xx = scale,
+      .yy = -scale,
+      .dx = -(f32)x0,
+      .dy = -(f32)y0,
+  };
+  font_raster_glyph(font, &raster, glyph, transform, 0);
+
+  i32 atlas_x = font->shelf_x;
+  i32 atlas_y = font->shelf_y;
+  for (i32 row = 0; row < height; ++row) {
+    const f32 *cells = raster.accumulator + (size_t)row * (size_t)stride;
+    u8 *dst = font->atlas + (size_t)(atlas_y + row) * font->atlas_width +
+              atlas_x;
+    f32 sum = 0.0f;
+    for (i32 col = 0; col < width; ++col) {
+      sum += cells[col];
+      f32 coverage = fabsf(sum);
+      dst[col] = (u8)(coverage >= 1.0f ? 255 : (i32)(coverage * 255.0f + 0.5f));
+    }
+  }
+
+  font->shelf_x += width + pad;
+  if (height > font->shelf_height) {
+    font->shelf_height = height;
+  }
+  font->stats.glyphs_rasterized++;
+
+  out->atlas_x = (u16)atlas_x;
+  out->atlas_y = (u16)atlas_y;
+  out->width = (u16)width;
+  out->height = (u16)height;
+  out->offset_x = (i16)x0;
+  out->offset_y = (i16)y0;
+}
+
+#define FONT_GLYPH_SLOT_BITS 10 // DE100_FONT_MAX_GLYPHS + 1 must fit
+
+de100_file_scoped_fn inline u32 font_codepoint_hash(u32 codepoint) {
+  return (codepoint * 2654435761u) >> 7;
+}
+
+/**
+ * Index into font->glyphs. Codepoints the face lacks share slot 0 (its
+ * .notdef box); so does everything once the cache is full.
+ */
+de100_file_scoped_fn u32 font_glyph_slot(De100Font *font, u32 codepoint) {
+  u32 mask = font->glyph_table_mask;
+  u32 at = font_codepoint_hash(codepoint) & mask;
+  for (;;) {
+    u32 entry = font->glyph_table[at];
+    if (entry == 0) {
+      break;
+    }
+    if (entry >> FONT_GLYPH_SLOT_BITS == codepoint) {
+      return (entry & ((1u << FONT_GLYPH_SLOT_BITS) - 1)) - 1;
+    }
+    at = (at + 1) & mask;
+  }
+
+  u16 glyph = ttf_glyph_index(font->face, codepoint);
+  u32 slot = 0;
+  if (glyph != 0 && font->glyph_count < DE100_FONT_MAX_GLYPHS) {
+    slot = font->glyph_count++;
+    font_rasterize(font, glyph, &font->glyphs[slot]);
+    font->glyphs[slot].codepoint = codepoint;
+  }
+  // Missing codepoints are remembered too, as slot 0, while the table is
+  // under half full; real glyphs always fit (it has 4× their capacity)
+  if (slot != 0 || font->glyph_table_count < (mask + 1) / 2) {
+    font->glyph_table[at] = codepoint << FONT_GLYPH_SLOT_BITS | (slot + 1);
+    font->glyph_table_count++;
+  }
+  return slot;
+}
+
+const De100FontGlyph *de100_font_glyph(De100Font *font, u32 codepoint) {
+  return &font->glyphs[font_glyph_slot(font, codepoint)];
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// LAYOUT
+// ═══════════════════════════════════════════════════════════════════════════
+
+// Next codepoint of UTF-8 `text` at *at; malformed bytes decode as U+FFFD
+de100_file_scoped_fn u32 font_utf8_next(const char *text, u32 *at) {
+  const u8 *p = (const u8 *)text + *at;
+  u32 lead = p[0];
+  u32 length = lead < 0x80 ? 1 : (lead >> 5) == 0x6 ? 2 : (lead >> 4) == 0xE ? 3
+               : (lead >> 3) == 0x1E ? 4 : 0;
+  if (length == 0) {
+    *at += 1;
+    return 0xFFFD;
+  }
+  u32 codepoint = length == 1 ? lead : lead & (0x7Fu >> length);
+  for (u32 i = 1; i < length; ++i) {
+    if ((p[i] & 0xC0) != 0x80) {
+      *at += i;
+      return 0xFFFD;
+    }
+    codepoint = codepoint << 6 | (p[i] & 0x3F);
+  }
+  *at += length;
+  return codepoint;
+}
+
+typedef struct {
+  const char *text;
+  u32 at;
+  f32 pen;
+  u16 previous_glyph; // Face glyph index, 0 = none (no kerning)
+} FontCursor;
+
+// Next glyph of the cursor's string, with its pen position rounded to
+// whole pixels (so the atlas bitmaps blit without resampling)
+de100_file_scoped_fn bool font_cursor_next(De100Font *font,
+                                           FontCursor *cursor,
+                                           De100FontPlacedGlyph *out) {
+  if (cursor->text[cursor->at] == '\0') {
+    return false;
+  }
+  u32 slot = font_glyph_slot(font, font_utf8_next(cursor->text, &cursor->at));
+  const De100FontGlyph *glyph = &font->glyphs[slot];
+  if (cursor->previous_glyph && glyph->glyph_index) {
+    cursor->pen += (f32)ttf_kerning(font->face, cursor->previous_glyph,
+                                    glyph->glyph_index) *
+                   font->scale;
+  }
+  out->glyph = (u16)slot;
+  out->x = (i16)floorf(cursor->pen + 0.5f);
+  cursor->pen += glyph->advance;
+  cursor->previous_glyph = glyph->glyph_index;
+  return true;
+}
+
+de100_file_scoped_fn inline i32 font_cursor_width(const FontCursor *cursor) {
+  return (i32)ceilf(cursor->pen);
+}
+
+de100_file_scoped_fn inline u32 font_text_hash(const char *text,
+                                               u32 *out_length) {
+  u32 hash = 2166136261u; // FNV-1a
+  u32 length = 0;
+  for (; text[length] && length <= DE100_FONT_LAYOUT_MAX_BYTES; ++length) {
+    hash = (hash ^ (u8)text[length]) * 16777619u;
+  }
+  *out_length = length;
+  return hash ? hash : 1;
+}
+
+/**
+ * Cached layout of `text`, laid out now on a miss (evicting the least
+ * recently used way of its set). NULL if it is too long to cache.
+ */
+de100_file_scoped_fn De100FontLayout *font_layout(De100Font *font,
+                                                  const char *text) {
+  u32 length;
+  u32 hash = font_text_hash(text, &length);
+  if (length > DE100_FONT_LAYOUT_MAX_BYTES) {
+    return NULL;
+  }
+
+  De100FontLayout *set =
+      font->layouts + (hash % DE100_FONT_LAYOUT_SETS) * DE100_FONT_LAYOUT_WAYS;
+  De100FontLayout *victim = &set[0];
+  for (u32 way = 0; way < DE100_FONT_LAYOUT_WAYS; ++way) {
+    De100FontLayout *layout = &set[way];
+    if (layout->hash == hash && layout->length == length &&
+        memcmp(layout->text, text, length) == 0) {
+      layout->last_used = ++font->layout_clock;
+      font->stats.layout_hits++;
+      return layout;
+    }
+    if (layout->hash == 0 ||
+        (victim->hash != 0 && layout->last_used < victim->last_used)) {
+      victim = layout;
+    }
+  }
+
+  font->stats.layout_misses++;
+  victim->hash = hash;
+  victim->length = length;
+  victim->glyph_count = 0;
+  victim->last_used = ++font->layout_clock;
+  memcpy(victim->text, text, length);
+
+  // Codepoints ≤ bytes, so glyphs[] always has room
+  FontCursor cursor = {.text = text};
+  while (font_cursor_next(font, &cursor,
+                          &victim->glyphs[victim->glyph_count])) {
+    victim->glyph_count++;
+  }
+  victim->width = font_cursor_width(&cursor);
+  return victim;
+}
+
+void de100_font_prepare(De100Font *font, const char *text) {
+  FontCursor cursor = {.text = text};
+  De100FontPlacedGlyph placed;
+  while (font_cursor_next(font, &cursor, &placed)) {
+  }
+}
+
+i32 de100_font_measure(De100Font *font, const char *text) {
+  De100FontLayout *layout = font_layout(font, text);
+  if (layout) {
+    return layout->width;
+  }
+
+  FontCursor cursor = {.text = text};
+  De100FontPlacedGlyph placed;
+  while (font_cursor_next(font, &cursor, &placed)) {
+  }
+  return font_cursor_width(&cursor);
+}
+
+u32 de100_font_layout_glyphs(De100Font *font, const char *text,
+                             De100FontPlacedGlyph *glyphs, u32 max_count,
+                             i32 *out_width) {
+  u32 count = 0;
+  De100FontLayout *layout = font_layout(font, text);
+  if (layout) {
+    count = layout->glyph_count < max_count ? layout->glyph_count : max_count;
+    memcpy(glyphs, layout->glyphs, count * sizeof(*glyphs));
+    *out_width = layout->width;
+    return count;
+  }
+
+  FontCursor cursor = {.text = text};
+  De100FontPlacedGlyph placed;
+  while (font_cursor_next(font, &cursor, &placed)) {
+    if (count < max_count) {
+      glyphs[count++] = placed;
+    }
+  }
+  *out_width = font_cursor_width(&cursor);
+  return count;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// DRAWING
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn i32 font_draw(GameBackBuffer *buffer,
+                                   De100RenderClipRect clip, De100Font *font,
+                                   i32 x, i32 y, const char *text, u32 color) {
+  De100PixelKernels *kernels = de100_pixel_kernels_get();
+  de100_pixel_coverage_row_t *row_fn = font->is_linear_blend
+                                           ? kernels->coverage_linear_row
+                                           : kernels->coverage_row;
+  i32 baseline = y + font->ascent;
+
+  De100FontLayout *layout = font_layout(font, text);
+  if (layout) {
+    for (u32 i = 0; i < layout->glyph_count; ++i) {
+      De100FontPlacedGlyph placed = layout->glyphs[i];
+      de100_font_blit_glyph_clipped(buffer, clip, font, &font->glyphs[placed.glyph],
+                      x + placed.x, baseline, color, row_fn);
+    }
+    return x + layout->width;
+  }
+
+  FontCursor cursor = {.text = text};
+  De100FontPlacedGlyph placed;
+  while (font_cursor_next(font, &cursor, &placed)) {
+    de100_font_blit_glyph_clipped(buffer, clip, font, &font->glyphs[placed.glyph],
+                    x + placed.x, baseline, color, row_fn);
+  }
+  return x + font_cursor_width(&cursor);
+}
+
+void de100_font_draw_clipped(GameBackBuffer *buffer, De100RenderClipRect clip,
+                             De100Font *font, i32 x, i32 y, const char *text,
+                             u32 color) {
+  if (!buffer || !font || !text || buffer->is_rendering_disabled) {
+    return;
+  }
+  font_draw(buffer, clip, font, x, y, text, color);
+}
+
+i32 de100_font_draw(GameBackBuffer *buffer, De100Font *font, i32 x, i32 y,
+                    const char *text, u32 color) {
+  if (!buffer || !font || !text) {
+    return x;
+  }
+  if (buffer->is_rendering_disabled) {
+    return x + de100_font_measure(font, text);
+  }
+
+  De100RenderClipRect clip = {0, 0, buffer->width, buffer->height};
+  i32 end_x = font_draw(buffer, clip, font, x, y, text, color);
+
+  // Ink may overhang the advance box; the face bbox bounds by how much
+  i32 baseline = y + font->ascent;
+  i32 dirty_x = x + font->ink_left;
+  i32 dirty_y = baseline + font->ink_top;
+  de100_backbuffer_mark_dirty(buffer, dirty_x, dirty_y,
+                              end_x + font->ink_right - dirty_x,
+                              baseline + font->ink_bottom - dirty_y);
+  return end_x;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// INIT
+// ═══════════════════════════════════════════════════════════════════════════
+
+De100FontResult de100_font_init(De100Font *font, const De100FontFace *face,
+                                De100MemoryArena *arena, f32 pixel_height,
+                                i32 atlas_width, i32 atlas_height) {
+  if (!font || !face || !face->data || !arena || pixel_height <= 0.0f ||
+      atlas_width <= 0 || atlas_height <= 0 || atlas_width > 0xFFFF ||
+      atlas_height > 0xFFFF) {
+    return font_result(DE100_FONT_ERROR_NULL_ARGUMENT);
+  }
+
+  f32 scale = pixel_height / (f32)(face->ascent - face->descent);
+  *font = (De100Font){
+      .face = face,
+      .scale = scale,
+      .ascent = (i32)ceilf((f32)face->ascent * scale),
+      .descent = (i32)ceilf(-(f32)face->descent * scale),
+      .ink_left = (i32)floorf((f32)face->bbox[0] * scale),
+      .ink_right = (i32)ceilf((f32)face->bbox[2] * scale),
+      .ink_top = (i32)floorf(-(f32)face->bbox[3] * scale),
+      .ink_bottom = (i32)ceilf(-(f32)face->bbox[1] * scale),
+      .atlas_width = atlas_width,
+      .atlas_height = atlas_height,
+      .glyph_table_mask = 4 * DE100_FONT_MAX_GLYPHS - 1,
+  };
+  font->line_height =
+      font->ascent + font->descent + (i32)ceilf((f32)face->line_gap * scale);
+  font->scratch_width = font->ink_right - font->ink_left + 2;
+  font->scratch_height = font->ink_bottom - font->ink_top + 2;
+  u32 max_points = face->max_points ? face->max_points : 1;
+
+  u64 arena_used = arena->used;
+  font->atlas = de100_arena_push_array_zero(
+      arena, (u64)atlas_width * (u64)atlas_height, u8);
+  font->glyphs =
+      de100_arena_push_array_zero(arena, DE100_FONT_MAX_GLYPHS, De100FontGlyph);
+  font->glyph_table = de100_arena_push_array_zero(
+      arena, font->glyph_table_mask + 1, u32);
+  font->layouts = de100_arena_push_array_zero(
+      arena, DE100_FONT_LAYOUT_SETS * DE100_FONT_LAYOUT_WAYS, De100FontLayout);
+  font->coverage_accumulator = de100_arena_push_array(
+      arena,
+      (u64)(font->scratch_width + 2) * (u64)font->scratch_height, f32);
+  font->outline_points = de100_arena_push_array(arena, 2 * max_points, f32);
+  font->outline_flags = de100_arena_push_array(arena, max_points, u8);
+  if (!font->atlas || !font->glyphs || !font->glyph_table || !font->layouts ||
+      !font->coverage_accumulator || !font->outline_points ||
+      !font->outline_flags) {
+    de100_arena_pop_to(arena, arena_used);
+    *font = (De100Font){0};
+    return font_result(DE100_FONT_ERROR_OUT_OF_MEMORY);
+  }
+
+  // Slot 0 is .notdef, what every missing codepoint draws as
+  font_rasterize(font, 0, &font->glyphs[0]);
+  font->glyph_count = 1;
+  return font_result(DE100_FONT_SUCCESS);
+}
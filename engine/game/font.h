@@ -0,0 +1,275 @@
+#ifndef DE100_GAME_FONT_H
+#define DE100_GAME_FONT_H
+
+#include "../_common/base.h"
+#include "backbuffer.h"
+#include "memory-arena.h"
+#include "pixel-kernels.h"
+#include <stdbool.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// 🔤 FONTS (TrueType → 8-bit coverage atlas)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// A glyph is rasterized ONCE per size, the first time it is asked for,
+// into an 8-bit coverage atlas; drawing text is then one coverage blend
+// per glyph row (pixel-kernels.h coverage_row, SIMD) and never touches an
+// outline again:
+//
+//   .ttf ──parse──▶ De100FontFace (bytes + table offsets, per file)
+//                         │ de100_font_init (per pixel size)
+//                         ▼
+//   De100Font: atlas ████░░  glyph cache (codepoint → atlas rect)
+//                            layout cache (string → placed glyphs)
+//
+//   de100_font_face_load(&state->ui_face, &state->world_arena,
+//                        "data/ui.ttf");
+//   de100_font_init(&state->hud_font, &state->ui_face, &state->world_arena,
+//                   24.0f, 256, 256);
+//   ...
+//   de100_font_draw(buffer, &state->hud_font, 8, 8, "SCORE 1200",
+//                   DE100_RGBA(255, 255, 255, 255));
+//
+// Layout (cmap lookup, advances, kerning pairs) is cached per string too:
+// a HUD label drawn every frame is laid out once. Strings longer than
+// DE100_FONT_LAYOUT_MAX_BYTES are laid out on the fly, still without
+// rasterizing.
+//
+// Everything (the .ttf bytes included) lives in the arena it was given,
+// normally the game's permanent storage, and holds no pointers outside
+// it, so fonts survive hot reloads and are part of replay snapshots.
+// The glyph caches are filled lazily: warm the characters you need with
+// de100_font_prepare() during loading so the first frame that shows them
+// doesn't pay for rasterizing.
+//
+// Supported: TrueType outlines (glyf/loca, simple and composite glyphs),
+// cmap formats 4 and 12, legacy 'kern' format 0 pair kerning. Not
+// supported: CFF/OpenType outlines, GPOS kerning, hinting (the outlines
+// are anti-aliased unhinted, which reads fine from ~10px up).
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define DE100_FONT_MAX_GLYPHS 512   // Cached glyphs per size
+#define DE100_FONT_LAYOUT_WAYS 4    // Layout cache associativity
+#define DE100_FONT_LAYOUT_SETS 16   // × ways = strings kept laid out
+#define DE100_FONT_LAYOUT_MAX_BYTES 64
+#define DE100_FONT_ATLAS_PADDING 1  // Empty pixels between glyphs
+
+typedef enum {
+  DE100_FONT_SUCCESS = 0,
+  DE100_FONT_ERROR_NULL_ARGUMENT,
+  DE100_FONT_ERROR_OPEN_FAILED,
+  DE100_FONT_ERROR_READ_FAILED,
+  DE100_FONT_ERROR_NOT_TRUETYPE, // Bad header, CFF outlines, or collection
+  DE100_FONT_ERROR_MISSING_TABLE,
+  DE100_FONT_ERROR_NO_UNICODE_CMAP,
+  DE100_FONT_ERROR_OUT_OF_MEMORY,
+
+  DE100_FONT_ERROR_COUNT
+} De100FontErrorCode;
+
+typedef struct {
+  bool success;
+  De100FontErrorCode error_code;
+} De100FontResult;
+
+/** A parsed .ttf: the bytes plus where its tables are. */
+typedef struct {
+  const u8 *data;
+  u32 size;
+
+  // Table offsets into `data`
+  u32 cmap_subtable; // Format 4 or 12
+  u32 loca;
+  u32 glyf;
+  u32 hmtx;
+  u32 kern_pairs; // First pair of the format 0 subtable, 0 = none
+  u32 kern_pair_count;
+
+  u16 glyph_count;
+  u16 h_metric_count;
+  u16 max_points; // Per simple glyph (maxp), sizes the outline scratch
+  u16 units_per_em;
+  bool32 long_loca;
+  bool32 cmap_is_format12;
+
+  // Font units
+  i16 ascent;
+  i16 descent; // Negative
+  i16 line_gap;
+  i16 bbox[4]; // x_min, y_min, x_max, y_max over all glyphs
+} De100FontFace;
+
+typedef struct {
+  u32 codepoint;
+  u16 glyph_index; // In the face
+  u16 atlas_x;
+  u16 atlas_y;
+  u16 width; // 0 for blank glyphs (space) or when the atlas was full
+  u16 height;
+  i16 offset_x; // Pen on the baseline → bitmap top-left, pixels
+  i16 offset_y;
+  f32 advance; // Pixels
+} De100FontGlyph;
+
+typedef struct {
+  u16 glyph; // Index into De100Font.glyphs
+  i16 x;     // Pen position from the string's origin, pixels
+} De100FontPlacedGlyph;
+
+typedef struct {
+  u32 hash; // 0 = empty
+  u32 length;
+  u32 glyph_count;
+  u32 last_used;
+  i32 width; // Pixels, pen after the last advance
+  char text[DE100_FONT_LAYOUT_MAX_BYTES];
+  De100FontPlacedGlyph glyphs[DE100_FONT_LAYOUT_MAX_BYTES];
+} De100FontLayout;
+
+typedef struct {
+  u64 glyphs_rasterized;
+  u64 glyph_atlas_full; // Glyphs left blank for lack of atlas space
+  u64 layout_hits;
+  u64 layout_misses;
+} De100FontStats;
+
+/** One face at one pixel size, with its atlas and caches. */
+typedef struct {
+  const De100FontFace *face;
+  f32 scale; // Pixels per font unit
+  i32 ascent; // Pixels above the baseline (rounded up)
+  i32 descent; // Pixels below it (positive)
+  i32 line_height;
+  // Face bbox around the pen (x from the pen, y from the baseline): the
+  // most any glyph can reach past a string's line box
+  i32 ink_left;
+  i32 ink_right;
+  i32 ink_top;
+  i32 ink_bottom;
+
+  u8 *atlas; // atlas_width × atlas_height coverage, 0 = empty
+  i32 atlas_width;
+  i32 atlas_height;
+  i32 shelf_x; // Shelf packer: current shelf's fill, top, height
+  i32 shelf_y;
+  i32 shelf_height;
+
+  De100FontGlyph *glyphs;
+  u32 glyph_count;
+  // Open-addressed codepoint << 10 | (glyphs[] index + 1), 0 = empty
+  u32 *glyph_table;
+  u32 glyph_table_mask;
+  u32 glyph_table_count; // Entries, missing codepoints included
+
+  De100FontLayout *layouts; // SETS × WAYS
+  u32 layout_clock;
+
+  // Rasterizer scratch, sized for the face's biggest glyph
+  f32 *coverage_accumulator;
+  i32 scratch_width;
+  i32 scratch_height;
+  f32 *outline_points; // x, y per point
+  u8 *outline_flags;
+
+  // Blend glyph edges in linear light (coverage_linear_row): anti-aliased
+  // text keeps its weight instead of thinning. Off after de100_font_init.
+  bool32 is_linear_blend;
+
+  De100FontStats stats;
+} De100Font;
+
+/**
+ * Copy `size` bytes of a .ttf into `arena` and parse its tables. Nothing
+ * is pushed on failure.
+ */
+De100FontResult de100_font_face_init(De100FontFace *face,
+                                     De100MemoryArena *arena,
+                                     const void *data, u64 size);
+
+/** de100_font_face_init from a file, read straight into `arena`. */
+De100FontResult de100_font_face_load(De100FontFace *face,
+                                     De100MemoryArena *arena,
+                                     const char *path);
+
+/**
+ * A `pixel_height` (ascent to descent) instance of `face` with an
+ * `atlas_width` × `atlas_height` coverage atlas, caches and scratch all
+ * pushed from `arena`. Nothing is pushed on failure.
+ */
+De100FontResult de100_font_init(De100Font *font, const De100FontFace *face,
+                                De100MemoryArena *arena, f32 pixel_height,
+                                i32 atlas_width, i32 atlas_height);
+
+/** The glyph for `codepoint`, rasterized now if it isn't cached yet. */
+const De100FontGlyph *de100_font_glyph(De100Font *font, u32 codepoint);
+
+/** Rasterize every character of `text` (UTF-8) ahead of time. */
+void de100_font_prepare(De100Font *font, const char *text);
+
+/** Width in pixels `text` (UTF-8) would take. */
+i32 de100_font_measure(De100Font *font, const char *text);
+
+/**
+ * Lay `text` (UTF-8) out into `glyphs` (at most `max_count`; one per
+ * codepoint, so its byte length always suffices), rasterizing what isn't
+ * cached. With the result, drawing needs nothing from the font but its
+ * glyph table and atlas: see De100RenderGlyphRun (render-group.h).
+ *
+ * @return glyphs written; `*out_width` gets the whole string's width
+ */
+u32 de100_font_layout_glyphs(De100Font *font, const char *text,
+                             De100FontPlacedGlyph *glyphs, u32 max_count,
+                             i32 *out_width);
+
+/**
+ * Draw `text` (UTF-8) with the top of its line box at (x, y) in `color`
+ * (DE100_PIXEL_FORMAT; its alpha scales the coverage), restricted to
+ * `clip`. `clip` must already be inside the buffer bounds.
+ */
+void de100_font_draw_clipped(GameBackBuffer *buffer, De100RenderClipRect clip,
+                             De100Font *font, i32 x, i32 y, const char *text,
+                             u32 color);
+
+/**
+ * Immediate-mode draw over the whole buffer (marks the dirty region).
+ *
+ * @return the pen's x after the text
+ */
+i32 de100_font_draw(GameBackBuffer *buffer, De100Font *font, i32 x, i32 y,
+                    const char *text, u32 color);
+
+const char *de100_font_strerror(De100FontErrorCode code);
+
+/**
+ * Blend one cached glyph with its pen at (pen_x, baseline), restricted to
+ * `clip`. Reads only the glyph and the atlas.
+ */
+de100_file_scoped_fn inline void de100_font_blit_glyph_clipped(
+    GameBackBuffer *buffer, De100RenderClipRect clip, const De100Font *font,
+    const De100FontGlyph *glyph, i32 pen_x, i32 baseline, u32 color,
+    de100_pixel_coverage_row_t *row_fn) {
+  i32 x = pen_x + glyph->offset_x;
+  i32 y = baseline + glyph->offset_y;
+  i32 x0 = x > clip.min_x ? x : clip.min_x;
+  i32 y0 = y > clip.min_y ? y : clip.min_y;
+  i32 x1 = x + glyph->width < clip.max_x ? x + glyph->width : clip.max_x;
+  i32 y1 = y + glyph->height < clip.max_y ? y + glyph->height : clip.max_y;
+  if (x1 <= x0 || y1 <= y0) {
+    return;
+  }
+
+  const u8 *coverage = font->atlas +
+                       (size_t)(glyph->atlas_y + (y0 - y)) *
+                           (size_t)font->atlas_width +
+                       glyph->atlas_x + (x0 - x);
+  u8 *row = (u8 *)buffer->memory.base + (size_t)y0 * (size_t)buffer->pitch +
+            (size_t)x0 * sizeof(u32);
+  for (i32 py = y0; py < y1; ++py) {
+    row_fn((u32 *)row, coverage, x1 - x0, color);
+    coverage += font->atlas_width;
+    row += buffer->pitch;
+  }
+}
+
+#endif // DE100_GAME_FONT_H
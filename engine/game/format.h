@@ -0,0 +1,336 @@
+#ifndef DE100_GAME_FORMAT_H
+#define DE100_GAME_FORMAT_H
+
+#include "../_common/base.h"
+#include <string.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// 🔢 NUMBER FORMATTING (HUD text without snprintf)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// snprintf parses its format string and goes through locale-aware libc
+// code for every call; a HUD formats the same few numbers every frame.
+// These write the digits straight into the caller's buffer, two at a time
+// from a "00".."99" table, and return the length, so centering the text
+// needs no strlen:
+//
+//   char score[32];
+//   De100FormatBuffer text = de100_format_buffer(score, sizeof(score));
+//   de100_format_append_str(&text, "SCORE:");
+//   de100_format_append_i32(&text, state->score);
+//   i32 x = (buffer->width - (i32)text.length * GLYPH_WIDTH) / 2;
+//
+// The result is the same text for the same value, so the layout caches
+// (de100_font_draw, de100_ui_label) keep hitting while the score doesn't
+// change: an unchanged HUD costs the formatting and a lookup.
+//
+// Floats are fixed precision (0..DE100_FORMAT_MAX_DECIMALS digits after
+// the point), rounded like printf's %.Nf (exact halves to even); no
+// exponent notation, and never "-0".
+//
+// Every function NUL-terminates. All are static inline.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define DE100_FORMAT_U32_MAX 11 // "4294967295" + NUL
+#define DE100_FORMAT_I32_MAX 12 // "-2147483648" + NUL
+#define DE100_FORMAT_U64_MAX 21
+#define DE100_FORMAT_I64_MAX 21 // "-9223372036854775808" + NUL
+#define DE100_FORMAT_MAX_DECIMALS 9
+#define DE100_FORMAT_F32_MAX 32
+
+de100_file_scoped_global_var const char g_de100_format_digit_pairs[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+de100_file_scoped_global_var const u64 g_de100_format_powers_of_10[20] = {
+    1ull,
+    10ull,
+    100ull,
+    1000ull,
+    10000ull,
+    100000ull,
+    1000000ull,
+    10000000ull,
+    100000000ull,
+    1000000000ull,
+    10000000000ull,
+    100000000000ull,
+    1000000000000ull,
+    10000000000000ull,
+    100000000000000ull,
+    1000000000000000ull,
+    10000000000000000ull,
+    100000000000000000ull,
+    1000000000000000000ull,
+    10000000000000000000ull,
+};
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Integers
+// ─────────────────────────────────────────────────────────────────────────────
+
+/** Decimal digits in `value` (1 for 0). Compares, never branches on them. */
+de100_file_scoped_fn inline u32 de100_format_digit_count_u64(u64 value) {
+  u32 count = 1;
+  for (u32 i = 1; i < 20; ++i) {
+    count += value >= g_de100_format_powers_of_10[i];
+  }
+  return count;
+}
+
+/** Write the `digit_count` digits of `value` ending just before `end`. */
+de100_file_scoped_fn inline void de100_format_digits_u64(char *end, u64 value,
+                                                         u32 digit_count) {
+  // 32-bit divides once the value fits: much cheaper than 64-bit ones
+  while (value > 0xFFFFFFFFull) {
+    u32 pair = (u32)(value % 100);
+    value /= 100;
+    end -= 2;
+    memcpy(end, &g_de100_format_digit_pairs[pair * 2], 2);
+    digit_count -= 2;
+  }
+  u32 small = (u32)value;
+  while (digit_count >= 2) {
+    u32 pair = small % 100;
+    small /= 100;
+    end -= 2;
+    memcpy(end, &g_de100_format_digit_pairs[pair * 2], 2);
+    digit_count -= 2;
+  }
+  if (digit_count) {
+    end[-1] = (char)('0' + small);
+  }
+}
+
+/** `value` in decimal into `out` (>= DE100_FORMAT_U64_MAX bytes). */
+de100_file_scoped_fn inline u32 de100_format_u64(char *out, u64 value) {
+  u32 length = de100_format_digit_count_u64(value);
+  de100_format_digits_u64(out + length, value, length);
+  out[length] = '\0';
+  return length;
+}
+
+de100_file_scoped_fn inline u32 de100_format_i64(char *out, i64 value) {
+  // Negate as unsigned: -INT64_MIN overflows i64
+  u64 magnitude = value < 0 ? 0ull - (u64)value : (u64)value;
+  out[0] = '-';
+  u32 sign = value < 0;
+  return sign + de100_format_u64(out + sign, magnitude);
+}
+
+de100_file_scoped_fn inline u32 de100_format_u32(char *out, u32 value) {
+  return de100_format_u64(out, value);
+}
+
+de100_file_scoped_fn inline u32 de100_format_i32(char *out, i32 value) {
+  return de100_format_i64(out, value);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Floats
+// ─────────────────────────────────────────────────────────────────────────────
+
+/**
+ * `value` with exactly `decimals` digits after the point ("12.50") into
+ * `out` (>= DE100_FORMAT_F32_MAX bytes). NaN prints "nan"; magnitudes
+ * too big to print in full (about 1e19 / 10^decimals) print "inf".
+ */
+de100_file_scoped_fn inline u32 de100_format_f32(char *out, f32 value,
+                                                 u32 decimals) {
+  if (decimals > DE100_FORMAT_MAX_DECIMALS) {
+    decimals = DE100_FORMAT_MAX_DECIMALS;
+  }
+  if (value != value) {
+    memcpy(out, "nan", 4);
+    return 3;
+  }
+
+  u32 sign = value < 0.0f;
+  out[0] = '-';
+  f64 magnitude = sign ? -(f64)value : (f64)value;
+  // An f32 times 10^9 still fits f64's mantissa: exact for any decimals
+  f64 scaled = magnitude * (f64)g_de100_format_powers_of_10[decimals];
+  if (scaled >= 18446744073709549568.0) { // Largest f64 below 2^64
+    memcpy(out + sign, "inf", 4);
+    return sign + 3;
+  }
+
+  u64 fixed = (u64)scaled;
+  f64 remainder = scaled - (f64)fixed;
+  fixed += remainder > 0.5 || (remainder == 0.5 && (fixed & 1));
+  u64 whole = fixed / g_de100_format_powers_of_10[decimals];
+  u64 fraction = fixed % g_de100_format_powers_of_10[decimals];
+  if (whole == 0 && fraction == 0) {
+    sign = 0; // -0.001 at two decimals is "0.00", not "-0.00"
+  }
+
+  u32 length = sign + de100_format_u64(out + sign, whole);
+  if (decimals > 0) {
+    out[length++] = '.';
+    de100_format_digits_u64(out + length + decimals, fraction, decimals);
+    length += decimals;
+    out[length] = '\0';
+  }
+  return length;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Building a line of text
+// ─────────────────────────────────────────────────────────────────────────────
+
+typedef struct {
+  char *data;
+  u32 length;
+  u32 capacity;        // Bytes at `data`, NUL included
+  bool32 is_truncated; // Something didn't fit and was dropped
+} De100FormatBuffer;
+
+/** An empty line in `data` (`capacity` >= 1 bytes). */
+de100_file_scoped_fn inline De100FormatBuffer
+de100_format_buffer(char *data, u32 capacity) {
+  De100FormatBuffer buffer = {data, 0, capacity, false};
+  data[0] = '\0';
+  return buffer;
+}
+
+/** Copy what fits of `length` bytes at `text`. */
+de100_file_scoped_fn inline void
+de100_format_append_bytes(De100FormatBuffer *buffer, const char *text,
+                          u32 length) {
+  if (buffer->capacity == 0) {
+    buffer->is_truncated = true;
+    return;
+  }
+  u32 room = buffer->capacity - 1 - buffer->length;
+  if (length > room) {
+    length = room;
+    buffer->is_truncated = true;
+  }
+  memcpy(buffer->data + buffer->length, text, length);
+  buffer->length += length;
+  buffer->data[buffer->length] = '\0';
+}
+
+de100_file_scoped_fn inline void
+de100_format_append_str(De100FormatBuffer *buffer, const char *text) {
+  de100_format_append_bytes(buffer, text, (u32)strlen(text));
+}
+
+// A number that doesn't fit is dropped whole: a cut-off score would read
+// as a different, wrong one
+
+de100_file_scoped_fn inline void
+de100_format_append_number(De100FormatBuffer *buffer, const char *digits,
+                           u32 length) {
+  if (buffer->capacity == 0 ||
+      length > buffer->capacity - 1 - buffer->length) {
+    buffer->is_truncated = true;
+    return;
+  }
+  de100_format_append_bytes(buffer, digits, length);
+}
+
+de100_file_scoped_fn inline void
+de100_format_append_i64(De100FormatBuffer *buffer, i64 value) {
+  char digits[DE100_FORMAT_I64_MAX];
+  de100_format_append_number(buffer, digits, de100_format_i64(digits, value));
+}
+
+de100_file_scoped_fn inline void
+de100_format_append_u64(De100FormatBuffer *buffer, u64 value) {
+  char digits[DE100_FORMAT_U64_MAX];
+  de100_format_append_number(buffer, digits, de100_format_u64(digits, value));
+}
+
+de100_file_scoped_fn inline void
+de100_format_append_i32(De100FormatBuffer *buffer, i32 value) {
+  de100_format_append_i64(buffer, value);
+}
+
+de100_file_scoped_fn inline void
+de100_format_append_u32(De100FormatBuffer *buffer, u32 value) {
+  de100_format_append_u64(buffer, value);
+}
+
+de100_file_scoped_fn inline void
+de100_format_append_f32(De100FormatBuffer *buffer, f32 value, u32 decimals) {
+  char digits[DE100_FORMAT_F32_MAX];
+  de100_format_append_number(buffer, digits,
+                             de100_format_f32(digits, value, decimals));
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Cached text runs
+// ─────────────────────────────────────────────────────────────────────────────
+//
+// One HUD line keyed by the number in it: formatted on first use and when
+// the value changes, otherwise handed back as-is, length included.
+//
+//   static De100FormatCache score_text;
+//   const char *text = de100_format_cached_i32(&score_text, "SCORE:", score);
+//   i32 width = (i32)score_text.length * GLYPH_WIDTH;
+//
+// The prefix is part of the run, not of the key: one cache per label.
+// A zeroed cache is empty, so caches can live in zero-initialised state.
+
+typedef struct {
+  i64 value;
+  bool32 is_valid;
+  u32 length;
+  char text[32];
+} De100FormatCache;
+
+de100_file_scoped_fn inline const char *
+de100_format_cached_i64(De100FormatCache *cache, const char *prefix,
+                        i64 value) {
+  if (!cache->is_valid || cache->value != value) {
+    De100FormatBuffer text =
+        de100_format_buffer(cache->text, (u32)sizeof(cache->text));
+    de100_format_append_str(&text, prefix);
+    de100_format_append_i64(&text, value);
+    cache->value = value;
+    cache->length = text.length;
+    cache->is_valid = true;
+  }
+  return cache->text;
+}
+
+de100_file_scoped_fn inline const char *
+de100_format_cached_i32(De100FormatCache *cache, const char *prefix,
+                        i32 value) {
+  return de100_format_cached_i64(cache, prefix, value);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Lines in a frame arena
+// ─────────────────────────────────────────────────────────────────────────────
+//
+// Only with memory-arena.h included first: format.h itself needs nothing
+// but base.h, so games with their own GameState can include it.
+
+#ifdef DE100_GAME_MEMORY_ARENA_H
+/**
+ * An empty line of `capacity` bytes pushed from `arena` (a frame arena);
+ * zero capacity, and always truncated, if it is full.
+ */
+de100_file_scoped_fn inline De100FormatBuffer
+de100_format_buffer_from_arena(De100MemoryArena *arena, u32 capacity) {
+  char *data = (char *)de100_arena_push_size(arena, capacity);
+  if (!data || capacity == 0) {
+    De100FormatBuffer empty = {NULL, 0, 0, true};
+    return empty;
+  }
+  return de100_format_buffer(data, capacity);
+}
+#endif
+
+#endif // DE100_GAME_FORMAT_H
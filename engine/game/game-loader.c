@@ -5,6 +5,7 @@
 
 #include "../_common/dll.h"
 #include "../_common/file.h"
+#include "../_common/profiler.h"
 #include "base.h"
 #include "game-loader.h"
 
@@ -41,6 +42,117 @@ create_stub_game_bootstrap_code(void) {
   return result;
 }
 
+// ═══════════════════════════════════════════════════════════════════════════
+// CODE READERS (see game-loader.h)
+// ═══════════════════════════════════════════════════════════════════════════
+// Reader slots hold the last epoch the reader acknowledged. The reader
+// stores its slot then loads the table; the main thread stores the table
+// then loads the slots. Both sequentially consistent, so either the main
+// thread sees the reader's old epoch (and keeps the library) or the
+// reader gets the new table.
+
+#define GAME_CODE_READER_FREE 0u
+#define GAME_CODE_READER_IDLE (~(u64)0)
+
+typedef struct {
+  const GameMainCode *published; // Into tables; atomic
+  GameMainCode tables[2];        // A reader may still hold the other one
+  u32 next_table;
+  u64 epoch; // Bumped per publish; atomic, starts at 1
+  u64 readers[DE100_GAME_CODE_MAX_READERS]; // Seen epoch; atomic
+
+  // Main thread only
+  GameMainCode retired;
+  u64 retired_epoch;
+  bool32 has_retired;
+} GameCodeReaders;
+
+de100_file_scoped_global_var GameCodeReaders g_game_code_readers = {
+    .epoch = 1};
+
+void game_code_publish(const GameMainCode *game_code) {
+  GameCodeReaders *readers = &g_game_code_readers;
+  GameMainCode *table = &readers->tables[readers->next_table];
+  readers->next_table ^= 1;
+  *table = *game_code;
+  __atomic_store_n(&readers->published, table, __ATOMIC_SEQ_CST);
+  __atomic_add_fetch(&readers->epoch, 1, __ATOMIC_SEQ_CST);
+}
+
+i32 game_code_reader_register(void) {
+  for (i32 i = 0; i < DE100_GAME_CODE_MAX_READERS; ++i) {
+    u64 expected = GAME_CODE_READER_FREE;
+    if (__atomic_compare_exchange_n(&g_game_code_readers.readers[i],
+                                    &expected, GAME_CODE_READER_IDLE, false,
+                                    __ATOMIC_SEQ_CST, __ATOMIC_RELAXED)) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+void game_code_reader_unregister(i32 reader) {
+  if (reader >= 0 && reader < DE100_GAME_CODE_MAX_READERS) {
+    __atomic_store_n(&g_game_code_readers.readers[reader],
+                     GAME_CODE_READER_FREE, __ATOMIC_SEQ_CST);
+  }
+}
+
+const GameMainCode *game_code_reader_enter(i32 reader) {
+  GameCodeReaders *readers = &g_game_code_readers;
+  u64 epoch = __atomic_load_n(&readers->epoch, __ATOMIC_SEQ_CST);
+  __atomic_store_n(&readers->readers[reader], epoch, __ATOMIC_SEQ_CST);
+  return __atomic_load_n(&readers->published, __ATOMIC_SEQ_CST);
+}
+
+void game_code_reader_idle(i32 reader) {
+  __atomic_store_n(&g_game_code_readers.readers[reader],
+                   GAME_CODE_READER_IDLE, __ATOMIC_SEQ_CST);
+}
+
+bool32 game_code_has_retired(void) { return g_game_code_readers.has_retired; }
+
+#if DE100_HOT_RELOAD
+
+// No reader still on a table older than `epoch`
+de100_file_scoped_fn bool32 game_code_readers_caught_up(u64 epoch) {
+  for (i32 i = 0; i < DE100_GAME_CODE_MAX_READERS; ++i) {
+    u64 seen =
+        __atomic_load_n(&g_game_code_readers.readers[i], __ATOMIC_SEQ_CST);
+    if (seen != GAME_CODE_READER_FREE && seen < epoch) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/** Close the retired library once it is safe. @return true if none left */
+de100_file_scoped_fn bool32 game_code_collect_retired(void) {
+  GameCodeReaders *readers = &g_game_code_readers;
+  if (!readers->has_retired) {
+    return true;
+  }
+  if (!game_code_readers_caught_up(readers->retired_epoch)) {
+    return false;
+  }
+  unload_game_main_code(&readers->retired);
+  readers->has_retired = false;
+  return true;
+}
+
+// `old_code` was just replaced by a published table: close it now, or
+// keep it mapped until the readers acknowledged the new epoch
+de100_file_scoped_fn void game_code_retire(GameMainCode *old_code) {
+  GameCodeReaders *readers = &g_game_code_readers;
+  readers->retired = *old_code;
+  readers->retired_epoch =
+      __atomic_load_n(&readers->epoch, __ATOMIC_SEQ_CST);
+  readers->has_retired = true;
+  if (!game_code_collect_retired()) {
+    printf("⏳ Previous game code stays loaded until readers move on\n");
+  }
+}
+
 de100_file_scoped_fn inline int
 load_game_assets(GameCodeMeta *game_code_meta,
                  GameCodeMeta *stub_game_code_meta, char *source_lib_name,
@@ -88,16 +200,27 @@ load_game_assets(GameCodeMeta *game_code_meta,
          de100_timespec_to_seconds(&stub_game_code_meta->last_write_time));
 
   // ─────────────────────────────────────────────────────────────────────
-  // Copy library file
+  // Link (or copy) library file
   // ─────────────────────────────────────────────────────────────────────
-
-  printf("📦 Copying library...\n");
+  // The loaded image must not be the file the build writes next. A hard
+  // link gives it a second name without moving any bytes; ld, gold, lld
+  // and MSVC's link all unlink/replace their output rather than truncate
+  // it, so the next build lands on a fresh inode and the linked one stays
+  // intact. Define DE100_HOT_RELOAD_FORCE_COPY for toolchains that
+  // rewrite in place.
+
+  printf("📦 Linking library...\n");
   printf("   %s → %s\n", source_lib_name, temp_lib_name);
 
+#if defined(DE100_HOT_RELOAD_FORCE_COPY)
   De100FileResult copy_result = de100_file_copy(source_lib_name, temp_lib_name);
+#else
+  De100FileResult copy_result =
+      de100_file_link_or_copy(source_lib_name, temp_lib_name);
+#endif
 
   if (!copy_result.success) {
-    fprintf(stderr, "❌ Failed to copy game library\n");
+    fprintf(stderr, "❌ Failed to link/copy game library\n");
     fprintf(stderr, "   Source: %s\n", source_lib_name);
     fprintf(stderr, "   Dest: %s\n", temp_lib_name);
     fprintf(stderr, "   Code: %s\n",
@@ -107,7 +230,7 @@ load_game_assets(GameCodeMeta *game_code_meta,
     return 1;
   }
 
-  printf("✅ Library copied successfully\n");
+  printf("✅ Library linked successfully\n");
 
   // ─────────────────────────────────────────────────────────────────────
   // Load the library with de100_dll_open
@@ -211,6 +334,41 @@ int load_game_main_code(GameMainCode *game_code,
   printf("   ✓ game_get_audio_samples: %p\n",
          (void *)stub_game_code.functions.get_audio_samples);
 
+  // Optional fixed-timestep pair: both or neither
+  stub_game_code.functions.update = (game_update_t *)de100_dll_sym(
+      &stub_game_code.meta.code_lib, "game_update");
+  stub_game_code.functions.render = (game_render_t *)de100_dll_sym(
+      &stub_game_code.meta.code_lib, "game_render");
+  if (!stub_game_code.functions.update || !stub_game_code.functions.render) {
+    if (stub_game_code.functions.update || stub_game_code.functions.render) {
+      printf("⚠️  Only one of game_update/game_render exported, ignoring\n");
+    }
+    stub_game_code.functions.update = NULL;
+    stub_game_code.functions.render = NULL;
+  } else {
+    printf("   ✓ game_update/game_render: %p / %p\n",
+           (void *)stub_game_code.functions.update,
+           (void *)stub_game_code.functions.render);
+  }
+
+  // Optional state layout version + migration
+  stub_game_code.functions.get_state_version =
+      (game_get_state_version_t *)de100_dll_sym(&stub_game_code.meta.code_lib,
+                                                "game_get_state_version");
+  stub_game_code.functions.migrate_state =
+      (game_migrate_state_t *)de100_dll_sym(&stub_game_code.meta.code_lib,
+                                            "game_migrate_state");
+  if (stub_game_code.functions.get_state_version) {
+    printf("   ✓ game_get_state_version: v%u%s\n",
+           stub_game_code.functions.get_state_version(),
+           stub_game_code.functions.migrate_state ? " (+ game_migrate_state)"
+                                                  : "");
+  }
+
+  // A missing optional symbol leaves SYMBOL_NOT_FOUND on the handle, which
+  // would make unload_game_main_code skip the dlclose
+  stub_game_code.meta.code_lib.error_code = DE100_DLL_SUCCESS;
+
   // ─────────────────────────────────────────────────────────────────────
   // Success!
   // ─────────────────────────────────────────────────────────────────────
@@ -318,6 +476,10 @@ void unload_game_main_code(GameMainCode *game_code) {
     game_code->is_valid = false;
     game_code->functions.update_and_render = game_update_and_render_stub;
     game_code->functions.get_audio_samples = game_get_audio_samples_stub;
+    game_code->functions.update = NULL;
+    game_code->functions.render = NULL;
+    game_code->functions.get_state_version = NULL;
+    game_code->functions.migrate_state = NULL;
     game_code->meta.code_lib.handle = NULL;
     return;
   }
@@ -339,6 +501,10 @@ void unload_game_main_code(GameMainCode *game_code) {
   game_code->is_valid = false;
   game_code->functions.update_and_render = game_update_and_render_stub;
   game_code->functions.get_audio_samples = game_get_audio_samples_stub;
+  game_code->functions.update = NULL;
+  game_code->functions.render = NULL;
+  game_code->functions.get_state_version = NULL;
+  game_code->functions.migrate_state = NULL;
   game_code->meta.code_lib.handle = NULL;
 
   printf("✅ Game code reset to stub functions\n");
@@ -387,7 +553,8 @@ void unload_game_bootstrap_code(GameBootstrapCode *game_code) {
 // ═══════════════════════════════════════════════════════════════════════════
 
 bool32 game_main_code_needs_reload(GameMainCode *game_code,
-                                   char *source_lib_name) {
+                                   char *source_lib_name,
+                                   De100FileStatCache *stat_cache) {
   // Validate inputs
   if (!game_code) {
     fprintf(stderr, "⚠️  game_main_code_needs_reload: NULL game_code pointer\n");
@@ -400,27 +567,28 @@ bool32 game_main_code_needs_reload(GameMainCode *game_code,
     return false;
   }
 
-  // Get current modification time
-  De100FileTimeResult current_mod_time =
-      de100_file_get_mod_time(source_lib_name);
+  // Get current modification time (cached: at most one stat per TTL)
+  De100FileStatResult current_stat =
+      de100_file_stat_cached(stat_cache, source_lib_name);
 
-  if (!current_mod_time.success) {
-    // Only log if it's not a "file not found" error
-    // (file might be temporarily missing during compilation)
-    if (current_mod_time.error_code != DE100_FILE_ERROR_NOT_FOUND) {
+  if (!current_stat.success || !current_stat.exists) {
+    // Only log real failures: the file might be temporarily missing
+    // during compilation
+    if (!current_stat.success) {
       fprintf(stderr, "⚠️  Failed to check modification time\n");
       fprintf(stderr, "   File: %s\n", source_lib_name);
     }
     return false;
   }
+  De100TimeSpec current_mod_time = current_stat.mod_time;
 
 #if DE100_INTERNAL
   if (FRAME_LOG_EVERY_FIVE_SECONDS_CHECK) {
     printf("[RELOAD CHECK] Old: %0.2f, New: %0.2f, Changed: %s\n",
            de100_timespec_to_seconds(&game_code->meta.last_write_time),
-           de100_timespec_to_seconds(&current_mod_time.value),
+           de100_timespec_to_seconds(&current_mod_time),
            de100_timespec_diff_seconds(&game_code->meta.last_write_time,
-                                       &current_mod_time.value) > 0.0
+                                       &current_mod_time) > 0.0
                ? "YES"
                : "NO");
   }
@@ -428,18 +596,114 @@ bool32 game_main_code_needs_reload(GameMainCode *game_code,
 
   // Compare modification times
   if (de100_timespec_diff_seconds(&game_code->meta.last_write_time,
-                                  &current_mod_time.value) > 0.0) {
-    printf("🔄 File modification detected\n");
-    printf("   Old time: %0.2f\n",
-           de100_timespec_to_seconds(&game_code->meta.last_write_time));
-    printf("   New time: %0.2f\n",
-           de100_timespec_to_seconds(&current_mod_time.value));
+                                  &current_mod_time) > 0.0) {
     return true;
   }
 
   return false;
 }
 
+// ═══════════════════════════════════════════════════════════════════════════
+// RELOAD HANDSHAKE (see game-loader.h)
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn inline bool32
+game_code_build_locked(const char *lib_path) {
+  char lock_path[DE100_GAME_CODE_PATH_LENGTH + 8];
+  snprintf(lock_path, sizeof(lock_path), "%s" DE100_HOT_RELOAD_LOCK_SUFFIX,
+           lib_path);
+  De100FileStatResult lock = de100_file_stat(lock_path);
+  return lock.success && lock.exists;
+}
+
+/**
+ * Whether the changed library at `lib_path` may be loaded now. When not,
+ * gate->retry_at says when to ask again (0 = only on the next change).
+ * Stats directly: it only runs once a change was seen.
+ */
+de100_file_scoped_fn bool32 game_code_reload_gate_ready(
+    GameCodeReloadGate *gate, const char *lib_path, f64 now) {
+  if (game_code_build_locked(lib_path)) {
+    if (!gate->lock_reported) {
+      printf("⏳ Build in progress (%s" DE100_HOT_RELOAD_LOCK_SUFFIX
+             "), waiting\n",
+             lib_path);
+      gate->lock_reported = true;
+    }
+    gate->retry_at = now + DE100_HOT_RELOAD_SETTLE_SECONDS;
+    return false;
+  }
+  gate->lock_reported = false;
+
+  De100FileStatResult stat = de100_file_stat(lib_path);
+  if (!stat.success || !stat.exists) {
+    gate->retry_at = now + DE100_HOT_RELOAD_SETTLE_SECONDS;
+    return false;
+  }
+
+  if (de100_timespec_diff_seconds(&gate->seen_write_time, &stat.mod_time) !=
+          0.0 ||
+      gate->seen_size != stat.size) {
+    gate->seen_write_time = stat.mod_time;
+    gate->seen_size = stat.size;
+    gate->seen_at = now;
+    gate->retry_at = now + DE100_HOT_RELOAD_SETTLE_SECONDS;
+    return false;
+  }
+  if (now - gate->seen_at < DE100_HOT_RELOAD_SETTLE_SECONDS) {
+    gate->retry_at = gate->seen_at + DE100_HOT_RELOAD_SETTLE_SECONDS;
+    return false;
+  }
+
+  if (gate->failure_count > 0 &&
+      de100_timespec_diff_seconds(&gate->failed_write_time,
+                                  &stat.mod_time) == 0.0) {
+    if (gate->failure_count >= DE100_HOT_RELOAD_MAX_RETRIES) {
+      gate->retry_at = 0.0; // Wait for the next build
+      return false;
+    }
+    if (now < gate->retry_at) {
+      return false;
+    }
+  }
+
+  gate->retry_at = 0.0;
+  return true;
+}
+
+de100_file_scoped_fn inline void
+game_code_reload_gate_failed(GameCodeReloadGate *gate, f64 now) {
+  if (gate->failure_count == 0 ||
+      de100_timespec_diff_seconds(&gate->failed_write_time,
+                                  &gate->seen_write_time) != 0.0) {
+    gate->failed_write_time = gate->seen_write_time;
+    gate->failure_count = 0;
+  }
+  gate->failure_count++;
+
+  if (gate->failure_count >= DE100_HOT_RELOAD_MAX_RETRIES) {
+    gate->retry_at = 0.0;
+    printf("⚠️  Giving up on this build after %u attempts; waiting for "
+           "the next one\n",
+           gate->failure_count);
+    return;
+  }
+  gate->retry_at = now + DE100_HOT_RELOAD_RETRY_SECONDS *
+                             (f64)(1u << (gate->failure_count - 1));
+  printf("⚠️  Retrying in %.2f s\n", gate->retry_at - now);
+}
+
+de100_file_scoped_fn inline void
+game_code_reload_gate_succeeded(GameCodeReloadGate *gate) {
+  gate->failure_count = 0;
+  gate->retry_at = 0.0;
+}
+
+de100_file_scoped_fn inline bool32
+game_code_reload_gate_due(const GameCodeReloadGate *gate, f64 now) {
+  return gate->retry_at > 0.0 && now >= gate->retry_at;
+}
+
 void handle_game_reload_check(GameMainCode *game_code,
                               GameCodePaths *game_code_paths) {
   // ═══════════════════════════════════════════════════════════
@@ -447,10 +711,37 @@ void handle_game_reload_check(GameMainCode *game_code,
   // ═══════════════════════════════════════════════════════════
   // Check periodically if game code has been recompiled
   // This allows changing game logic without restarting!
+  // With a file watch the frame only reads an atomic; the stat runs
+  // once per notification to confirm the mod time really moved.
+  // Without one, the stat cache's TTL bounds the polling rate.
+  // A lock file, an unsettled file or a recent failed load defers the
+  // reload; the gate's retry_at then stands in for the notification.
+  // A library replaced by the last reload and still used by a code reader
+  // holds the next staging path: until it is closed, don't even consume
+  // the notification.
   // ═══════════════════════════════════════════════════════════
-  if (g_reload_requested ||
+  GameCodeReloadGate *gate = &game_code_paths->main_reload_gate;
+  f64 now = de100_get_wall_clock();
+  bool32 can_reload = game_code_collect_retired();
+  bool32 check_needed = can_reload &&
+                        (!game_code_paths->game_main_lib_watch ||
+                         de100_file_watch_consume(
+                             game_code_paths->game_main_lib_watch) ||
+                         game_code_reload_gate_due(gate, now));
+  if (check_needed && game_code_paths->game_main_lib_watch) {
+    de100_file_stat_cache_invalidate(&game_code_paths->stat_cache,
+                                     game_code_paths->game_main_lib_path);
+  }
+  bool32 reload = can_reload && g_reload_requested;
+  if (!reload && check_needed &&
       game_main_code_needs_reload(game_code,
-                                  game_code_paths->game_main_lib_path)) {
+                                  game_code_paths->game_main_lib_path,
+                                  &game_code_paths->stat_cache)) {
+    reload = game_code_reload_gate_ready(
+        gate, game_code_paths->game_main_lib_path, now);
+  }
+
+  if (reload) {
     if (g_reload_requested) {
       g_reload_requested = false;
       printf("🔄 Hot reload requested by user!\n");
@@ -458,32 +749,382 @@ void handle_game_reload_check(GameMainCode *game_code,
 
     printf("🔄 Hot reload triggered! at g_frame_counter: %d\n",
            g_frame_counter);
+    printf("   Old time: %0.2f\n",
+           de100_timespec_to_seconds(&game_code->meta.last_write_time));
     printf("[HOT RELOAD] Before: update_and_render=%p "
            "get_audio_samples=%p\n",
            (void *)game_code->functions.update_and_render,
            (void *)game_code->functions.get_audio_samples);
 
-    unload_game_main_code(game_code);
-
-    printf("[HOT RELOAD] After:  update_and_render=%p "
-           "get_audio_samples=%p\n",
-           (void *)game_code->functions.update_and_render,
-           (void *)game_code->functions.get_audio_samples);
-
-    load_game_main_code(game_code, game_code_paths);
-
-    if (game_code->is_valid) {
+    // Stage the new library next to the running one
+    if (!game_code_paths->game_main_lib_staging_path) {
+      snprintf(game_code_paths->game_main_lib_alt_tmp_path,
+               sizeof(game_code_paths->game_main_lib_alt_tmp_path), "%s.1",
+               game_code_paths->game_main_lib_tmp_path);
+      game_code_paths->game_main_lib_staging_path =
+          game_code_paths->game_main_lib_alt_tmp_path;
+    }
+    GameCodePaths staged_paths = *game_code_paths;
+    staged_paths.game_main_lib_tmp_path =
+        game_code_paths->game_main_lib_staging_path;
+
+    GameMainCode next_code = {0};
+    load_game_main_code(&next_code, &staged_paths);
+
+    if (next_code.is_valid) {
+      if (game_code_paths->before_reload) {
+        game_code_paths->before_reload(
+            game_code_paths->before_reload_user_data);
+      }
+      GameMainCode old_code = *game_code;
+      *game_code = next_code;
+      game_code_publish(game_code);
+      game_code_retire(&old_code);
+
+      char *loaded_tmp_path = game_code_paths->game_main_lib_staging_path;
+      game_code_paths->game_main_lib_staging_path =
+          game_code_paths->game_main_lib_tmp_path;
+      game_code_paths->game_main_lib_tmp_path = loaded_tmp_path;
+      game_code_reload_gate_succeeded(gate);
+
+      printf("[HOT RELOAD] After:  update_and_render=%p "
+             "get_audio_samples=%p\n",
+             (void *)game_code->functions.update_and_render,
+             (void *)game_code->functions.get_audio_samples);
       printf("✅ Hot reload successful!\n");
+      DE100_PROFILE_INSTANT("hot_reload");
+
+      if (game_code_paths->after_reload) {
+        game_code_paths->after_reload(game_code_paths->after_reload_user_data);
+      }
 
       // NOTE: do on a separate thread
       de100_file_delete(
           game_code_paths->game_main_lib_tmp_path); // Clean up temp file
     } else {
-      printf("⚠️  Hot reload failed, using stubs\n");
+      de100_file_delete(game_code_paths->game_main_lib_staging_path);
+      printf("⚠️  Hot reload failed, still running the previous code\n");
+      game_code_reload_gate_failed(gate, now);
+    }
+  }
+
+  if (game_code_paths->modules) {
+    game_modules_reload_check(game_code_paths->modules, game_code_paths);
+  }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// CODE MODULES
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn bool32 game_module_load(GameModuleRegistry *registry,
+                                             u32 index) {
+  GameModule *module = &registry->modules[index];
+  De100GameModule *slot = &registry->memory->modules[index];
+  module->is_valid = false;
+  slot->api = NULL;
+
+  if (load_game_assets(&module->meta, &module->meta, module->lib_path,
+                       module->tmp_path) != 0) {
+    return false;
+  }
+
+  game_module_get_api_t *get_api = (game_module_get_api_t *)de100_dll_sym(
+      &module->meta.code_lib, module->symbol);
+  const void *api = get_api ? get_api() : NULL;
+  if (!api) {
+    fprintf(stderr, "❌ Module '%s': %s\n", module->name,
+            get_api ? "get_api returned NULL" : "symbol not found");
+    fprintf(stderr, "   Symbol: %s\n", module->symbol);
+    de100_dll_close(&module->meta.code_lib);
+    return false;
+  }
+
+  slot->api = api;
+  slot->generation++;
+  module->is_valid = true;
+  printf("   ✓ %s: %p (generation %u)\n", module->symbol, api,
+         slot->generation);
+  return true;
+}
+
+de100_file_scoped_fn void game_module_unload(GameModuleRegistry *registry,
+                                             u32 index) {
+  GameModule *module = &registry->modules[index];
+  registry->memory->modules[index].api = NULL;
+  module->is_valid = false;
+  if (de100_dll_is_valid(module->meta.code_lib)) {
+    de100_dll_close(&module->meta.code_lib);
+  }
+}
+
+void game_modules_reload_check(GameModuleRegistry *registry,
+                               GameCodePaths *game_code_paths) {
+  bool32 barrier_done = false;
+  f64 now = de100_get_wall_clock();
+
+  for (u32 i = 0; i < DE100_GAME_MAX_MODULES; ++i) {
+    GameModule *module = &registry->modules[i];
+    if (!module->name[0]) {
+      continue;
+    }
+
+    // Same scheme as the main library: a notification (or, without a
+    // watch, the stat cache's TTL) gates the stat, the handshake gates
+    // the load
+    bool32 check_needed = !module->watch ||
+                          de100_file_watch_consume(module->watch) ||
+                          game_code_reload_gate_due(&module->reload_gate, now);
+    if (!check_needed) {
+      continue;
+    }
+    if (module->watch) {
+      de100_file_stat_cache_invalidate(&game_code_paths->stat_cache,
+                                       module->lib_path);
+    }
+    De100FileStatResult stat =
+        de100_file_stat_cached(&game_code_paths->stat_cache, module->lib_path);
+    if (!stat.success || !stat.exists ||
+        de100_timespec_diff_seconds(&module->meta.last_write_time,
+                                    &stat.mod_time) <= 0.0 ||
+        !game_code_reload_gate_ready(&module->reload_gate, module->lib_path,
+                                     now)) {
+      continue;
+    }
+
+    printf("🔄 Module '%s' changed, reloading it alone\n", module->name);
+    if (!barrier_done && game_code_paths->before_reload) {
+      game_code_paths->before_reload(game_code_paths->before_reload_user_data);
+    }
+    barrier_done = true;
+
+    game_module_unload(registry, i);
+    if (game_module_load(registry, i)) {
+      printf("✅ Module '%s' reloaded\n", module->name);
+      DE100_PROFILE_INSTANT("module_reload");
+      de100_file_delete(module->tmp_path);
+      game_code_reload_gate_succeeded(&module->reload_gate);
+    } else {
+      printf("⚠️  Module '%s' failed to reload, its table is NULL\n",
+             module->name);
+      game_code_reload_gate_failed(&module->reload_gate, now);
     }
   }
 }
 
+#else // !DE100_HOT_RELOAD
+
+// ═══════════════════════════════════════════════════════════════════════════
+// STATIC LINK (release builds)
+// ═══════════════════════════════════════════════════════════════════════════
+// The game's objects are part of the executable: bind its symbols once and
+// never reload. Callers use DE100_GAME_CALL(), so these pointers only serve
+// the optional-export checks.
+
+int load_game_main_code(GameMainCode *game_code,
+                        GameCodePaths *game_code_paths) {
+  (void)game_code_paths;
+
+  *game_code = create_stub_game_main_code();
+  game_code->functions.update_and_render = game_update_and_render;
+  game_code->functions.get_audio_samples = game_get_audio_samples;
+  // Optional fixed-timestep pair: both or neither
+  if (game_update && game_render) {
+    game_code->functions.update = game_update;
+    game_code->functions.render = game_render;
+  }
+  game_code->functions.get_state_version = game_get_state_version;
+  game_code->functions.migrate_state = game_migrate_state;
+  game_code->is_valid = true;
+
+  printf("✅ Game code statically linked\n");
+  return 0;
+}
+
+int load_game_bootstrap_code(GameBootstrapCode *game_code,
+                             GameCodePaths *game_code_paths) {
+  (void)game_code_paths;
+
+  *game_code = create_stub_game_bootstrap_code();
+  game_code->functions.startup = game_startup;
+  game_code->functions.init = game_init;
+  return 0;
+}
+
+void unload_game_main_code(GameMainCode *game_code) { (void)game_code; }
+
+void unload_game_bootstrap_code(GameBootstrapCode *game_code) {
+  (void)game_code;
+}
+
+bool32 game_main_code_needs_reload(GameMainCode *game_code,
+                                   char *source_lib_name,
+                                   De100FileStatCache *stat_cache) {
+  (void)game_code;
+  (void)source_lib_name;
+  (void)stat_cache;
+  return false;
+}
+
+void handle_game_reload_check(GameMainCode *game_code,
+                              GameCodePaths *game_code_paths) {
+  (void)game_code;
+  (void)game_code_paths;
+}
+
+// Modules are linked in: take the table from linked_get_api, once
+de100_file_scoped_fn bool32 game_module_load(GameModuleRegistry *registry,
+                                             u32 index) {
+  GameModule *module = &registry->modules[index];
+  De100GameModule *slot = &registry->memory->modules[index];
+  const void *api = module->linked_get_api ? module->linked_get_api() : NULL;
+  if (!api) {
+    fprintf(stderr, "❌ Module '%s': no linked_get_api (or it returned "
+                    "NULL)\n",
+            module->name);
+    return false;
+  }
+
+  slot->api = api;
+  slot->generation++;
+  module->is_valid = true;
+  return true;
+}
+
+de100_file_scoped_fn void game_module_unload(GameModuleRegistry *registry,
+                                             u32 index) {
+  registry->memory->modules[index].api = NULL;
+  registry->modules[index].is_valid = false;
+}
+
+void game_modules_reload_check(GameModuleRegistry *registry,
+                               GameCodePaths *game_code_paths) {
+  (void)registry;
+  (void)game_code_paths;
+}
+
+#endif // DE100_HOT_RELOAD
+
+// ═══════════════════════════════════════════════════════════════════════════
+// CODE MODULES (setup and teardown, both build modes)
+// ═══════════════════════════════════════════════════════════════════════════
+
+u32 game_modules_init(GameModuleRegistry *registry,
+                      const GameModuleConfig *config, GameMemory *memory) {
+  *registry = (GameModuleRegistry){0};
+  registry->memory = memory;
+
+  u32 configured = 0;
+  u32 loaded = 0;
+  for (u32 i = 0; i < DE100_GAME_MAX_MODULES; ++i) {
+    const char *name = config[i].name;
+    if (!name || !name[0]) {
+      continue;
+    }
+    configured++;
+
+    GameModule *module = &registry->modules[i];
+    snprintf(module->name, sizeof(module->name), "%s", name);
+    snprintf(module->lib_path, sizeof(module->lib_path),
+             GAME_BUILD_DIR_PATH "/" DE100_SHARED_LIB_PREFIX
+                                 "%s." DE100_SHARED_LIB_EXT,
+             name);
+    snprintf(module->tmp_path, sizeof(module->tmp_path),
+             GAME_BUILD_DIR_PATH "/" DE100_SHARED_LIB_PREFIX
+                                 "%s_tmp." DE100_SHARED_LIB_EXT,
+             name);
+    snprintf(module->symbol, sizeof(module->symbol), "%s_module_get_api",
+             name);
+    module->linked_get_api = config[i].linked_get_api;
+
+#if DE100_HOT_RELOAD
+    De100FileWatchResult watch_result;
+    module->watch = de100_file_watch_start(module->lib_path, &watch_result);
+#endif
+
+    if (game_module_load(registry, i)) {
+      loaded++;
+    }
+  }
+
+  if (configured > 0) {
+    printf("%s Code modules: %u/%u loaded\n",
+           loaded == configured ? "✅" : "⚠️ ", loaded, configured);
+  }
+  return loaded;
+}
+
+void game_modules_shutdown(GameModuleRegistry *registry) {
+  if (!registry->memory) {
+    return;
+  }
+  for (u32 i = 0; i < DE100_GAME_MAX_MODULES; ++i) {
+    GameModule *module = &registry->modules[i];
+    if (!module->name[0]) {
+      continue;
+    }
+    de100_file_watch_stop(module->watch);
+    module->watch = NULL;
+    game_module_unload(registry, i);
+  }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// STATE LAYOUT MIGRATION
+// ═══════════════════════════════════════════════════════════════════════════
+
+u32 game_main_code_state_version(const GameMainCode *game_code) {
+  if (!game_code || !game_code->functions.get_state_version) {
+    return 0;
+  }
+  return game_code->functions.get_state_version();
+}
+
+GameStateMigration migrate_game_state(const GameMainCode *game_code,
+                                      u32 from_version, GameMemory *memory) {
+  u32 to_version = game_main_code_state_version(game_code);
+  if (from_version == to_version || !memory->is_initialized) {
+    return GAME_STATE_MIGRATION_UNCHANGED;
+  }
+
+  printf("🧬 State layout v%u → v%u\n", from_version, to_version);
+
+  u64 size = memory->permanent_storage_size;
+  bool32 migrated = false;
+  if (game_code->functions.migrate_state &&
+      memory->transient_storage_size >= size &&
+      (!memory->transient_commit ||
+       de100_commit_frontier_grow(
+           memory->transient_commit,
+           (u64)((u8 *)memory->transient_storage -
+                 memory->transient_commit->base) +
+               size))) {
+    // Old bytes to scratch; the game rebuilds on a zeroed block so new
+    // fields start at 0
+    de100_mem_copy(memory->transient_storage, memory->permanent_storage,
+                   (size_t)size);
+    de100_mem_set(memory->permanent_storage, 0, (size_t)size);
+    migrated = game_code->functions.migrate_state(
+        memory, from_version, memory->transient_storage, size);
+  } else if (!game_code->functions.migrate_state) {
+    printf("   No game_migrate_state exported\n");
+  } else {
+    printf("   Transient storage too small to hold the old state\n");
+  }
+
+  if (migrated) {
+    printf("✅ State migrated in place\n");
+    DE100_PROFILE_INSTANT("state_migrated");
+    return GAME_STATE_MIGRATION_MIGRATED;
+  }
+
+  // Old layout can't be read by the new code: start over
+  fprintf(stderr, "⚠️  State not migrated, reinitializing game memory\n");
+  de100_mem_set(memory->permanent_storage, 0, (size_t)size);
+  memory->is_initialized = false;
+  return GAME_STATE_MIGRATION_RESET;
+}
+
 // ═══════════════════════════════════════════════════════════════════════════
 // STUB FUNCTIONS (Used when game code fails to load)
 // ═══════════════════════════════════════════════════════════════════════════
@@ -2,6 +2,8 @@
 #define DE100_GAME_LOADER_H
 
 #include "../_common/dll.h"
+#include "../_common/file.h"
+#include "../_common/file-watch.h"
 #include "../_common/path.h"
 #include "../_common/time.h"
 #include "audio.h"
@@ -31,6 +33,25 @@
 #endif
 #endif
 
+// ═══════════════════════════════════════════════════════════════════════════
+// BUILD MODE
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// DE100_HOT_RELOAD=1 (default): game code lives in shared libraries that
+// are linked to a temp name, dlopen'ed and swapped when they change.
+//
+// DE100_HOT_RELOAD=0 (release, see de100_build_release in build-common.sh):
+// the game's objects are linked into the executable. The loader binds the
+// game's symbols directly (no dlopen, no temp copy, no mod-time polling or
+// file watch), and DE100_GAME_CALL() becomes a direct call that LTO can
+// inline across the engine/game boundary.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#ifndef DE100_HOT_RELOAD
+#define DE100_HOT_RELOAD 1
+#endif
+
 #ifndef GAME_BUILD_DIR_PATH
 #define GAME_BUILD_DIR_PATH "./build"
 #endif
@@ -102,11 +123,115 @@ typedef GAME_INIT(game_init_t);
             GameInput *inputs, GameBackBuffer *buffer)
 typedef GAME_UPDATE_AND_RENDER(game_update_and_render_t);
 
+// Optional fixed-timestep pair, used instead of update_and_render when
+// GameConfig.fixed_update_hz > 0 (see platforms/_common/fixed-timestep.h).
+// Update: advance the simulation by exactly dt_seconds, 0..N times per
+// frame. Render: draw once per frame, `alpha` (0..1) of the way from the
+// last tick to the next, for interpolation.
+#define GAME_UPDATE(name)                                                      \
+  void name(ThreadContext *thread_context, GameMemory *memory,                 \
+            GameInput *inputs, f32 dt_seconds)
+typedef GAME_UPDATE(game_update_t);
+
+#define GAME_RENDER(name)                                                      \
+  void name(ThreadContext *thread_context, GameMemory *memory,                 \
+            GameBackBuffer *buffer, f32 alpha)
+typedef GAME_RENDER(game_render_t);
+
 // Called to fill audio buffer - may be called multiple times per frame
 #define GAME_GET_AUDIO_SAMPLES(name)                                           \
   void name(GameMemory *memory, GameAudioOutputBuffer *audio_buffer)
 typedef GAME_GET_AUDIO_SAMPLES(game_get_audio_samples_t);
 
+// Optional: layout version of what the game keeps in permanent storage.
+// Bump it whenever a struct there changes. When a hot reload brings a
+// different version, the engine migrates permanent storage in place
+// instead of running new code on old bytes (see migrate_game_state).
+#define GAME_GET_STATE_VERSION(name) u32 name(void)
+typedef GAME_GET_STATE_VERSION(game_get_state_version_t);
+
+// Optional: rebuild permanent storage (zeroed on entry) in the current
+// layout from `old_state`, a copy of it in layout `from_version`. The copy
+// lives in transient storage, so transient contents are gone afterwards;
+// rebuild anything kept there. Return false for versions it can't handle;
+// the engine then resets memory (is_initialized = false).
+#define GAME_MIGRATE_STATE(name)                                               \
+  bool32 name(GameMemory *memory, u32 from_version, const void *old_state,    \
+              u64 old_size)
+typedef GAME_MIGRATE_STATE(game_migrate_state_t);
+
+// A code module's only export, named `<module>_module_get_api` (see
+// GameConfig.modules): returns the module's function table, usually a
+// static const struct the game casts GameMemory.modules[i].api to.
+// Resolved once per (re)load.
+//
+//   typedef struct { void (*think)(GameMemory *, f32 dt); } AiApi;
+//   static const AiApi g_ai_api = {ai_think};
+//   GAME_MODULE_GET_API(ai_module_get_api) { return &g_ai_api; }
+#define GAME_MODULE_GET_API(name) const void *name(void)
+typedef GAME_MODULE_GET_API(game_module_get_api_t);
+
+// Call a game function: through the loaded code's pointer when hot
+// reloading, straight to the linked symbol otherwise. `fn` is the field in
+// `functions` (update_and_render → game_update_and_render).
+#if DE100_HOT_RELOAD
+#define DE100_GAME_CALL(code, fn) ((code)->functions.fn)
+#else
+GAME_STARTUP(game_startup);
+GAME_INIT(game_init);
+GAME_UPDATE_AND_RENDER(game_update_and_render);
+GAME_GET_AUDIO_SAMPLES(game_get_audio_samples);
+// Optional exports are weak: NULL when the game doesn't define them
+__attribute__((weak)) GAME_UPDATE(game_update);
+__attribute__((weak)) GAME_RENDER(game_render);
+__attribute__((weak)) GAME_GET_STATE_VERSION(game_get_state_version);
+__attribute__((weak)) GAME_MIGRATE_STATE(game_migrate_state);
+
+#define DE100_GAME_CALL(code, fn) ((void)(code), game_##fn)
+#endif
+
+// ═══════════════════════════════════════════════════════════════════════════
+// RELOAD HANDSHAKE
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// A changed mod time alone doesn't mean the library is ready: the linker
+// may still be writing it. So a reload also waits for:
+//
+//   lock    No "<lib>.lock" next to the library. de100_build_game_lib
+//           (build-common.sh) holds it while compiling into a temp file
+//           and renames the result over the library, so the loader only
+//           ever sees a missing lock plus a complete file.
+//   settle  Builds without the handshake: mod time and size unchanged
+//           for DE100_HOT_RELOAD_SETTLE_SECONDS.
+//   backoff A build that fails to load is retried after 0.25 s, then
+//           0.5 s, then left alone until the library changes again.
+//
+// Modules go through the same gate. The new main library is opened
+// (under the temp name the running one isn't using) before the old one
+// is unloaded, so a failed reload keeps running the old code instead of
+// the stubs.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+#define DE100_HOT_RELOAD_LOCK_SUFFIX ".lock"
+#ifndef DE100_HOT_RELOAD_SETTLE_SECONDS
+#define DE100_HOT_RELOAD_SETTLE_SECONDS 0.1
+#endif
+#define DE100_HOT_RELOAD_RETRY_SECONDS 0.25
+#define DE100_HOT_RELOAD_MAX_RETRIES 3
+#define DE100_GAME_CODE_PATH_LENGTH 256
+
+typedef struct {
+  // Last observation of the library, for the settle check
+  De100TimeSpec seen_write_time;
+  i64 seen_size;
+  f64 seen_at;
+  // Failed loads of failed_write_time, and when to look again
+  De100TimeSpec failed_write_time;
+  u32 failure_count;
+  f64 retry_at; // 0 = nothing scheduled
+  bool32 lock_reported;
+} GameCodeReloadGate;
+
 // ═══════════════════════════════════════════════════════════════════════════
 // GAME CODE STRUCTURE
 // ═══════════════════════════════════════════════════════════════════════════
@@ -118,6 +243,28 @@ typedef struct {
 
   De100PathResult exe_full_path; // Full path to executable
   De100PathResult exe_directory; // Directory containing executable
+  // Change notifications for game_main_lib_path. NULL = poll the mod time
+  // every frame instead.
+  De100FileWatch *game_main_lib_watch;
+  // Mod time lookups for the reload check. Without a watch, its TTL is
+  // the polling interval; a watch notification invalidates the entry.
+  De100FileStatCache stat_cache;
+  GameCodeReloadGate main_reload_gate;
+  // Temp name the next main library is staged under; swaps with
+  // game_main_lib_tmp_path on every successful reload (dlopen would hand
+  // back the loaded image for a name it already knows)
+  char *game_main_lib_staging_path;
+  char game_main_lib_alt_tmp_path[DE100_GAME_CODE_PATH_LENGTH];
+  // Runs right before the old library is unloaded on hot reload, to stop
+  // anything that could still call into it. Optional.
+  void (*before_reload)(void *user_data);
+  void *before_reload_user_data;
+  // Runs after a hot reload loaded valid code (e.g. to migrate state to a
+  // new layout). Optional.
+  void (*after_reload)(void *user_data);
+  void *after_reload_user_data;
+  // Code modules checked along with the main library (NULL = none)
+  struct GameModuleRegistry *modules;
 } GameCodePaths;
 
 typedef struct {
@@ -132,9 +279,20 @@ typedef struct {
   struct {
     game_update_and_render_t *update_and_render;
     game_get_audio_samples_t *get_audio_samples;
+    // Optional (NULL if the game doesn't export them)
+    game_update_t *update;
+    game_render_t *render;
+    game_get_state_version_t *get_state_version;
+    game_migrate_state_t *migrate_state;
   } functions;
 } GameMainCode;
 
+typedef enum {
+  GAME_STATE_MIGRATION_UNCHANGED = 0, // Same layout, nothing done
+  GAME_STATE_MIGRATION_MIGRATED,      // Rewritten by game_migrate_state
+  GAME_STATE_MIGRATION_RESET,         // Couldn't migrate; zeroed for init
+} GameStateMigration;
+
 typedef struct {
   GameCodeMeta meta;
   struct {
@@ -143,6 +301,70 @@ typedef struct {
   } functions;
 } GameBootstrapCode;
 
+// ═══════════════════════════════════════════════════════════════════════════
+// CODE MODULES
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// Besides main and bootstrap, a game can split code into modules
+// (GameConfig.modules), each its own shared library:
+//
+//   build/libmain.so   game_update_and_render, ...
+//   build/libai.so     ai_module_get_api      ← rebuilt alone, reloaded alone
+//   build/libsynth.so  synth_module_get_api
+//
+// Every module has its own file watch (or stat-cache polling), temp link
+// and handle. When one changes, only it is unloaded and relinked; its
+// get_api is resolved once and the table published in
+// GameMemory.modules[i], with the generation bumped. So a rebuild
+// relinks one small library instead of all of libmain.so.
+//
+// DE100_HOT_RELOAD=0 builds call GameModuleConfig.linked_get_api instead
+// and never reload.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define GAME_MODULE_NAME_LENGTH 32
+#define GAME_MODULE_PATH_LENGTH DE100_GAME_CODE_PATH_LENGTH
+
+typedef struct {
+  char name[GAME_MODULE_NAME_LENGTH]; // Empty = unused slot
+  char lib_path[GAME_MODULE_PATH_LENGTH];
+  char tmp_path[GAME_MODULE_PATH_LENGTH];
+  char symbol[GAME_MODULE_NAME_LENGTH + 16]; // <name>_module_get_api
+  game_module_get_api_t *linked_get_api;
+
+  GameCodeMeta meta;
+  De100FileWatch *watch; // NULL = poll through the paths' stat cache
+  GameCodeReloadGate reload_gate;
+  bool32 is_valid;
+} GameModule;
+
+typedef struct GameModuleRegistry {
+  GameModule modules[DE100_GAME_MAX_MODULES]; // Indexed like the config
+  GameMemory *memory; // Where tables are published
+} GameModuleRegistry;
+
+/**
+ * Load every module named in `config` and publish their tables in
+ * memory->modules. A module that fails to load stays NULL (the game must
+ * cope) and is retried when its library changes.
+ *
+ * @return Number of modules loaded
+ */
+u32 game_modules_init(GameModuleRegistry *registry,
+                      const GameModuleConfig *config, GameMemory *memory);
+
+/**
+ * Reload the modules whose library changed. handle_game_reload_check
+ * calls this when GameCodePaths.modules is set; runs the paths'
+ * before_reload hook before unloading anything.
+ */
+void game_modules_reload_check(GameModuleRegistry *registry,
+                               GameCodePaths *game_code_paths);
+
+/** Unload every module, stop the watches, clear the published tables. */
+void game_modules_shutdown(GameModuleRegistry *registry);
+
 // ═══════════════════════════════════════════════════════════════════════════
 // API FUNCTIONS
 // ═══════════════════════════════════════════════════════════════════════════
@@ -184,17 +406,97 @@ void unload_game_bootstrap_code(GameBootstrapCode *game_code);
  *
  * @param game_code Current GameCode structure
  * @param source_lib_name Path to the source library file
+ * @param stat_cache Where to look the mod time up (NULL = stat directly)
  * @return true if the source file has been modified, false otherwise
  *
  * Safe to call with NULL pointers (returns false with warning).
  * Returns false if file doesn't exist or can't be accessed.
  */
 bool32 game_main_code_needs_reload(GameMainCode *game_code,
-                                   char *source_lib_name);
+                                   char *source_lib_name,
+                                   De100FileStatCache *stat_cache);
 
 void handle_game_reload_check(GameMainCode *game_code,
                               GameCodePaths *game_code_paths);
 
+/**
+ * Permanent-storage layout version of the loaded code (0 if it doesn't
+ * export game_get_state_version).
+ */
+u32 game_main_code_state_version(const GameMainCode *game_code);
+
+/**
+ * Bring permanent storage from layout `from_version` to the loaded code's.
+ *
+ * Copies permanent storage into transient storage as scratch, zeroes it
+ * and lets game_migrate_state rebuild it. Without a migration function
+ * (or if it fails, or transient storage is too small for the copy) the
+ * memory is zeroed and is_initialized cleared, so the game starts over.
+ */
+GameStateMigration migrate_game_state(const GameMainCode *game_code,
+                                      u32 from_version, GameMemory *memory);
+
+// ═══════════════════════════════════════════════════════════════════════════
+// CODE READERS (game code called off the main thread)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// A thread that calls into the game library by itself (an audio thread
+// running get_audio_samples) must not use the platform's GameMainCode:
+// the main thread overwrites it on reload, and dlclose'ing the old library
+// while that thread is inside it would crash. Instead, epoch-based
+// reclamation, with no lock on either side:
+//
+//   main:   new code loaded ─▶ publish its table ─▶ epoch++
+//                            ─▶ old library RETIRED (still mapped)
+//   reader: at each block boundary, game_code_reader_enter: note the
+//           epoch, get the table, call through it until the next boundary
+//   main:   every reader noted the new epoch, or is idle ─▶ dlclose
+//
+// So a reload stays instant (nobody waits for anybody); the old library
+// just lives one audio block longer. While it is retired the next reload
+// of the main library waits (its temp copy is the next staging path).
+// With no reader registered a reload closes the old library at once.
+//
+// Reader thread:
+//   i32 reader = game_code_reader_register();
+//   while (running) {
+//     const GameMainCode *code = game_code_reader_enter(reader);
+//     if (code) code->functions.get_audio_samples(memory, &buffer);
+//     game_code_reader_idle(reader); // Before blocking on the device
+//     ...
+//   }
+//   game_code_reader_unregister(reader);
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define DE100_GAME_CODE_MAX_READERS 4
+
+/**
+ * Make `game_code`'s functions the table readers get. Main thread; the
+ * engine calls it after the first load, handle_game_reload_check after
+ * each reload.
+ */
+void game_code_publish(const GameMainCode *game_code);
+
+/** Claim a reader slot (starts idle). @return -1 if all are taken */
+i32 game_code_reader_register(void);
+
+void game_code_reader_unregister(i32 reader);
+
+/**
+ * Block boundary: acknowledge the current epoch. The table returned stays
+ * loaded until this reader's next enter or idle. Lock-free; reader only.
+ *
+ * @return NULL before the first publish
+ */
+const GameMainCode *game_code_reader_enter(i32 reader);
+
+/** Out of game code until the next enter; reloads stop waiting for it. */
+void game_code_reader_idle(i32 reader);
+
+/** True while a replaced main library waits for readers to move on. */
+bool32 game_code_has_retired(void);
+
 // ═══════════════════════════════════════════════════════════════════════════
 // STUB FUNCTIONS
 // ═══════════════════════════════════════════════════════════════════════════
@@ -0,0 +1,99 @@
+#ifndef DE100_GAME_IDLE_JOB_H
+#define DE100_GAME_IDLE_JOB_H
+
+#include "../_common/base.h"
+
+// ═══════════════════════════════════════════════════════════════════════════
+// IDLE JOBS (background work in the frame's slack)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// A sleep-paced frame that finishes early waits out the rest of its budget.
+// Low-priority, main-thread work (compressing a save, hashing for a debug
+// check, building a lookup table) can run there instead, for free:
+//
+//   frame_start            work_end                      deadline
+//   |████████ work ████████|▒ job ▒▒ job ▒▒ job ▒|░ sleep ░|
+//                                                ↑ next slice wouldn't fit
+//
+// Jobs can't be interrupted, so they come in SLICES: each callback call
+// does a bounded step and returns whether the job is finished. The
+// platform learns each job's slice time and only starts a slice that is
+// predicted to end a safety margin before the deadline; a slice that
+// overran raises the prediction at once. A job that never fits waits for
+// a frame with more slack.
+//
+//   DE100_IDLE_JOB_CALLBACK(compress_save) {
+//     SaveCompressor *compressor = (SaveCompressor *)job->data;
+//     compress_block(compressor, compressor->next_block++); // ~100us
+//     return compressor->next_block == compressor->block_count;
+//   }
+//
+//   state->compress_job = (De100IdleJob){
+//       .callback = compress_save,
+//       .data = &state->compressor,
+//   };
+//   memory->idle_job_submit(memory->idle_scheduler, &state->compress_job);
+//   ...
+//   if (de100_idle_job_is_done(&state->compress_job)) { ... }
+//
+// Slices run on the main thread between frames (never during update or
+// render), in submission order, round-robin when several jobs are live.
+// Frames with no slack (flip-paced present, over budget) run none: work
+// that must finish by a deadline belongs on the background loader.
+//
+// When a job finishes depends on the machine's slack, so keep its results
+// out of simulated state: replays and netplay re-run the inputs, not the
+// slack.
+//
+// Hot reload cancels every job, since `callback` lives in the old library;
+// resubmit after the reload. The job and `data` must stay valid until the
+// job is done; keep them in game memory.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+typedef struct De100IdleScheduler De100IdleScheduler;
+
+typedef enum {
+  DE100_IDLE_JOB_STATUS_IDLE = 0, // Never submitted
+  DE100_IDLE_JOB_STATUS_QUEUED,   // Waiting for slack, may have run slices
+  DE100_IDLE_JOB_STATUS_COMPLETE,
+  DE100_IDLE_JOB_STATUS_CANCELLED,
+
+  DE100_IDLE_JOB_STATUS_COUNT
+} De100IdleJobStatus;
+
+typedef struct De100IdleJob De100IdleJob;
+
+// One slice; return true when the job is finished
+#define DE100_IDLE_JOB_CALLBACK(name) bool name(De100IdleJob *job)
+typedef DE100_IDLE_JOB_CALLBACK(de100_idle_job_callback_t);
+
+struct De100IdleJob {
+  // Filled by the game
+  de100_idle_job_callback_t *callback;
+  void *data;
+
+  // Managed by the platform
+  u32 status; // De100IdleJobStatus
+  u32 slice_count;
+};
+
+// Queues the job (status becomes QUEUED). Returns false, leaving the
+// status alone, if the scheduler is full or the job is already queued.
+#define DE100_PLATFORM_IDLE_JOB_SUBMIT(name)                                   \
+  bool name(De100IdleScheduler *scheduler, De100IdleJob *job)
+typedef DE100_PLATFORM_IDLE_JOB_SUBMIT(de100_platform_idle_job_submit_t);
+
+de100_file_scoped_fn inline bool
+de100_idle_job_is_done(const De100IdleJob *job) {
+  return job->status >= DE100_IDLE_JOB_STATUS_COMPLETE;
+}
+
+// Drop a queued job before its next slice (status becomes CANCELLED)
+de100_file_scoped_fn inline void de100_idle_job_cancel(De100IdleJob *job) {
+  if (job->status == DE100_IDLE_JOB_STATUS_QUEUED) {
+    job->status = DE100_IDLE_JOB_STATUS_CANCELLED;
+  }
+}
+
+#endif // DE100_GAME_IDLE_JOB_H
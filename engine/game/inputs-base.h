@@ -1,6 +1,11 @@
 #ifndef DE100_GAME_INPUTS_BASE_H
 #define DE100_GAME_INPUTS_BASE_H
 
+#include "../_common/base.h"
+
+// Two bytes per button, transition count first: a run of buttons is a
+// plain byte array, so prepare_input_frame clears every transition count
+// with one AND per 8 bytes (see inputs.c), and recorded frames stay small.
 typedef struct {
   /**
    * Number of state changes this frame
@@ -25,9 +30,12 @@ typedef struct {
    *   }
    * ```
    */
-  int half_transition_count;
+  u8 half_transition_count;
   /** Final state (true = pressed, false = released) */
-  int ended_down;
+  u8 ended_down;
 } GameButtonState;
 
+_Static_assert(sizeof(GameButtonState) == 2,
+               "GameButtonState is cleared as packed byte pairs");
+
 #endif // DE100_GAME_INPUTS_BASE_H
@@ -1,4 +1,7 @@
 #include "inputs.h"
+#include "../_common/time.h"
+
+#include <string.h>
 
 int KEYBOARD_CONTROLLER_INDEX = 0;
 
@@ -11,49 +14,127 @@ inline void process_game_button_state(bool is_down,
 }
 
 // ═══════════════════════════════════════════════════════════
-// Clear new inputs buttons to released state
+// Packed transition clearing
+// ═══════════════════════════════════════════════════════════
+// A GameButtonState is {half_transition_count, ended_down}, one
+// byte each, so a run of buttons is a byte array with every
+// even byte a count. ANDing 8 bytes at a time with
+// {00 FF 00 FF 00 FF 00 FF} keeps ended_down and zeroes the
+// counts - four buttons per operation, and the loop vectorizes.
+// ═══════════════════════════════════════════════════════════
+de100_file_scoped_fn inline void
+input_clear_button_transitions(GameButtonState *buttons, u32 count) {
+  local_persist_var const u8 ended_down_pattern[8] = {0, 0xFF, 0, 0xFF,
+                                                      0, 0xFF, 0, 0xFF};
+  u64 mask;
+  memcpy(&mask, ended_down_pattern, sizeof(mask)); // Endian-neutral
+
+  u8 *bytes = (u8 *)buttons;
+  size_t size = (size_t)count * sizeof(GameButtonState);
+  size_t i = 0;
+  for (; i + sizeof(u64) <= size; i += sizeof(u64)) {
+    u64 word;
+    memcpy(&word, bytes + i, sizeof(word));
+    word &= mask;
+    memcpy(bytes + i, &word, sizeof(word));
+  }
+  for (; i < size; i += sizeof(GameButtonState)) {
+    bytes[i] = 0; // half_transition_count
+  }
+}
+
+void de100_input_clear_transitions(GameInput *input) {
+  // Zero-button games still have a (dummy) union member; ArraySize is 0
+  u32 button_count = (u32)ArraySize(input->controllers[0].buttons);
+  for (u32 c = 0; c < ArraySize(input->controllers); ++c) {
+    input_clear_button_transitions(input->controllers[c].buttons,
+                                   button_count);
+  }
+  input_clear_button_transitions(input->mouse_buttons,
+                                 (u32)ArraySize(input->mouse_buttons));
+
+  // Wheel and motion are deltas
+  input->mouse_z = 0;
+  input->mouse_dx = 0.0f;
+  input->mouse_dy = 0.0f;
+}
+
+// ═══════════════════════════════════════════════════════════
+// Carry state into the new frame
 // ═══════════════════════════════════════════════════════════
 // Backend keyboard only sends events on press/release.
 // If no event, button stays in old state (wrong!).
-// So we must explicitly clear to "not pressed".
+// So held state carries over and only transitions reset.
 // ═══════════════════════════════════════════════════════════
 void prepare_input_frame(GameInput *old_input, GameInput *new_input) {
-  // ═══════════════════════════════════════════════════════════
-  // Clear new inputs buttons to released state
-  // ═══════════════════════════════════════════════════════════
-  for (int i = 0; i < MAX_CONTROLLER_COUNT; i++) {
-    GameControllerInput *old_ctrl = &old_input->controllers[i];
-    GameControllerInput *new_ctrl = &new_input->controllers[i];
-
-    // Copy connection state
-    new_ctrl->is_connected = old_ctrl->is_connected;
-    new_ctrl->is_analog = old_ctrl->is_analog;
-    new_ctrl->controller_index = old_ctrl->controller_index;
+  // Controllers (connection, sticks, buttons) and the mouse carry over
+  // whole, then transitions and deltas are cleared in place
+  memcpy(new_input->controllers, old_input->controllers,
+         sizeof(new_input->controllers));
+  memcpy(new_input->mouse_buttons, old_input->mouse_buttons,
+         sizeof(new_input->mouse_buttons));
+  // Mouse position carries over until a motion event or poll replaces it
+  new_input->mouse_x = old_input->mouse_x;
+  new_input->mouse_y = old_input->mouse_y;
+  de100_input_clear_transitions(new_input);
 
-    // Preserve analog stick state
-    new_ctrl->stick_avg_x = old_ctrl->stick_avg_x;
-    new_ctrl->stick_avg_y = old_ctrl->stick_avg_y;
+  // ─────────────────────────────────────────────────────────────────
+  // Event queue: keep what no update consumed last frame
+  // ─────────────────────────────────────────────────────────────────
+  // Without fixed-timestep ticks tick_event_end == event_count and
+  // nothing carries. With them, events newer than the last tick wait
+  // for the next frame's ticks.
+  u32 carried = 0;
+  if (old_input->tick_event_end < old_input->event_count) {
+    carried = old_input->event_count - old_input->tick_event_end;
+    memmove(new_input->events, old_input->events + old_input->tick_event_end,
+            carried * sizeof(GameInputEvent));
+  }
+  new_input->event_count = carried;
+  new_input->events_dropped = 0;
+  new_input->tick_event_first = 0;
+  new_input->tick_event_end = carried;
 
-    local_persist_var int new_ctrl_btns_size =
-        (int)ArraySize(new_ctrl->buttons);
+  // This frame's updates cover the time since the previous poll
+  f64 now = de100_get_wall_clock();
+  new_input->tick_start_seconds =
+      old_input->tick_end_seconds > 0.0 ? old_input->tick_end_seconds : now;
+  new_input->tick_end_seconds = now;
+}
 
-    // Buttons - preserve state, clear transition count
-    for (int btn = 0; btn < new_ctrl_btns_size; btn++) {
-      new_ctrl->buttons[btn].ended_down = old_ctrl->buttons[btn].ended_down;
-      new_ctrl->buttons[btn].half_transition_count = 0;
-    }
+bool de100_input_push_event(GameInput *input, const GameInputEvent *event) {
+  if (input->event_count >= DE100_INPUT_EVENT_CAPACITY) {
+    ++input->events_dropped;
+    return false;
   }
 
-  // ─────────────────────────────────────────────────────────────────
-  // Preserve mouse button states
-  // ─────────────────────────────────────────────────────────────────
-  for (u32 b = 0; b < ArraySize(new_input->mouse_buttons); b++) {
-    new_input->mouse_buttons[b].ended_down =
-        old_input->mouse_buttons[b].ended_down;
-    new_input->mouse_buttons[b].half_transition_count = 0;
+  // Sources are polled one after another (X11, then joysticks), so an
+  // event can be older than the tail; keep the queue sorted by time
+  u32 index = input->event_count;
+  while (index > input->tick_event_first &&
+         input->events[index - 1].seconds > event->seconds) {
+    input->events[index] = input->events[index - 1];
+    --index;
+  }
+  input->events[index] = *event;
+  if (event->seconds > input->tick_end_seconds) {
+    input->tick_end_seconds = event->seconds; // Arrived while pumping
   }
 
-  // Mouse position doesn't need preservation (polled fresh each frame)
-  // Mouse wheel should reset to 0 each frame (it's a delta)
-  new_input->mouse_z = 0;
+  ++input->event_count;
+  input->tick_event_end = input->event_count;
+  return true;
+}
+
+f64 de100_input_clock_to_seconds(De100InputClock *clock, u32 milliseconds,
+                                 f64 now) {
+  f64 device_seconds = (f64)milliseconds * 0.001;
+  f64 offset = now - device_seconds;
+  if (!clock->is_valid || offset < clock->offset_seconds ||
+      offset > clock->offset_seconds + 1.0) {
+    clock->offset_seconds = offset;
+    clock->is_valid = true;
+  }
+  f64 seconds = device_seconds + clock->offset_seconds;
+  return seconds < now ? seconds : now;
 }
@@ -38,14 +38,74 @@ typedef struct {
 
   f32 stick_avg_x;
   f32 stick_avg_y;
-  int controller_index;
-  bool32 is_analog;
+  i32 controller_index;
+  bool is_analog;
   bool is_connected;
 } GameControllerInput;
 
+// ═══════════════════════════════════════════════════════════════════════════
+// TIMESTAMPED INPUT EVENTS
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// Alongside the per-frame summary (ended_down + half_transition_count), the
+// platform records every input change it sees, in arrival order, stamped
+// with when it happened on the de100_get_wall_clock() timebase:
+//
+//   X11 key/button/motion   → XEvent.time (server ms, mapped to local)
+//   Joystick (js_event)     → js_event.time via de100_input_push_event
+//   Polled sources          → the moment of the poll
+//
+// An update only sees its own slice:
+//
+//   for (u32 i = input->tick_event_first; i < input->tick_event_end; ++i) {
+//     const GameInputEvent *event = &input->events[i];
+//     f64 t = (event->seconds - input->tick_start_seconds) /
+//             (input->tick_end_seconds - input->tick_start_seconds);
+//     // t in ~0..1: where inside this update the event landed
+//   }
+//
+// With fixed-timestep ticks each tick gets the events that fall inside its
+// slice of wall time; events newer than the last tick carry over to the
+// next frame instead of being squashed into the wrong tick.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define DE100_INPUT_EVENT_CAPACITY 64
+
+typedef enum {
+  DE100_INPUT_EVENT_KEY,             // code = platform key (KeySym, raylib key)
+  DE100_INPUT_EVENT_MOUSE_BUTTON,    // code = mouse_buttons index
+  DE100_INPUT_EVENT_MOUSE_MOVE,      // x, y = window-relative position
+  DE100_INPUT_EVENT_MOUSE_WHEEL,     // y = +1 up / -1 down
+  DE100_INPUT_EVENT_JOYSTICK_BUTTON, // code = device button number
+  DE100_INPUT_EVENT_JOYSTICK_AXIS,   // code = device axis, value = -1..1
+  DE100_INPUT_EVENT_MOUSE_DELTA,     // x, y = relative motion (see mouse_dx)
+} De100InputEventKind;
+
+typedef struct {
+  f64 seconds;   // de100_get_wall_clock() timebase
+  u8 kind;       // De100InputEventKind
+  u8 is_down;    // Keys and buttons
+  u8 controller; // controllers[] index (keyboard / joystick events)
+  u8 reserved;
+  u32 code;
+  i16 x;
+  i16 y;
+  f32 value;
+} GameInputEvent; // 24 bytes
+
 typedef struct {
   GameControllerInput controllers[5];
 
+  // Oldest first; see TIMESTAMPED INPUT EVENTS above
+  GameInputEvent events[DE100_INPUT_EVENT_CAPACITY];
+  u32 event_count;
+  u32 events_dropped;   // Arrived with the queue full, this frame
+  u32 tick_event_first; // This update's slice: [first, end)
+  u32 tick_event_end;
+  f64 tick_start_seconds; // Wall-clock span this update covers
+  f64 tick_end_seconds;
+
   /*
   ┌─────────────────────────────────────────────────────────────────────────┐
   │                    X11 MOUSE INPUT FLOW                                 │
@@ -116,6 +176,12 @@ typedef struct {
   i32 mouse_x;
   i32 mouse_y;
   i32 mouse_z; // Mouse wheel (future)
+  // Motion this frame, accumulated from every sample: raw device counts
+  // (unaccelerated, unclamped at screen edges) with
+  // GameConfig.prefer_raw_mouse_input where the backend supports it,
+  // window pixels otherwise
+  f32 mouse_dx;
+  f32 mouse_dy;
 } GameInput;
 
 //
@@ -123,4 +189,29 @@ typedef struct {
 void prepare_input_frame(GameInput *old_input, GameInput *new_input);
 void process_game_button_state(bool is_down, GameButtonState *new_state);
 
+/** Zero every half_transition_count (and the wheel/motion deltas). */
+void de100_input_clear_transitions(GameInput *input);
+
+/**
+ * Append an event to this frame's queue. Fills tick_event_end so a frame
+ * without fixed-timestep ticks sees everything. Returns false (and counts
+ * it in events_dropped) when the queue is full.
+ */
+bool de100_input_push_event(GameInput *input, const GameInputEvent *event);
+
+/**
+ * Maps a device's millisecond clock (X server Time, js_event.time) onto
+ * de100_get_wall_clock(). Neither shares our epoch, so the offset is
+ * estimated: an event can't be stamped later than when we read it, so
+ * the smallest (now - ms) seen is the tightest bound. A jump of over a
+ * second (wrap, server restart) starts the estimate over.
+ */
+typedef struct {
+  f64 offset_seconds;
+  bool is_valid;
+} De100InputClock;
+
+f64 de100_input_clock_to_seconds(De100InputClock *clock, u32 milliseconds,
+                                 f64 now);
+
 #endif
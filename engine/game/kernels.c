@@ -0,0 +1,10 @@
+#include "kernels.h"
+
+void de100_kernels_init(De100Kernels *kernels, u32 cpu_features) {
+  *kernels = (De100Kernels){
+      .cpu_features = cpu_features,
+      .pixel = de100_pixel_kernels_for(cpu_features),
+      .audio_mix = de100_audio_mix_kernels_for(cpu_features),
+  };
+  kernels->hash64 = de100_hash64_select(cpu_features, &kernels->hash64_name);
+}
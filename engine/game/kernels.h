@@ -0,0 +1,59 @@
+#ifndef DE100_GAME_KERNELS_H
+#define DE100_GAME_KERNELS_H
+
+#include "../_common/base.h"
+#include "../_common/cpu.h"
+#include "../_common/hash.h"
+#include "audio-mix-kernels.h"
+#include "pixel-kernels.h"
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ⚡ SHARED KERNEL TABLE
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// The engine detects the CPU once at startup (de100_cpu_features, see
+// cpu.h), picks the widest kernel of every family it supports, and hands
+// the table to the game as GameMemory.kernels:
+//
+//   pixel      fill / blend / premultiplied blit / alpha-test rows
+//   audio_mix  accumulate / to_i16
+//   hash64     de100_hash64 variant (engine code; the game library can't
+//              link against it otherwise)
+//
+// Bind it once per frame, like the profiler:
+//
+//   DE100_KERNELS_BIND(memory);
+//
+// after which de100_pixel_kernels_get() / de100_audio_mix_kernels_get()
+// in the game library return the engine's choices. The table lives in the
+// executable, so a reloaded library rebinds to the same kernels and the
+// same DE100_CPU_DISABLE overrides. Bind before queueing work that draws
+// or mixes: unbound, each translation unit lazily picks its own.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+typedef struct De100Kernels {
+  u32 cpu_features; // De100CpuFeature bits the table was built for
+  De100PixelKernels pixel;
+  De100AudioMixKernels audio_mix;
+  de100_hash64_t *hash64;
+  const char *hash64_name;
+} De100Kernels;
+
+/**
+ * Fill `kernels` for `cpu_features` (engine side).
+ */
+void de100_kernels_init(De100Kernels *kernels, u32 cpu_features);
+
+/**
+ * Route this module's de100_*_kernels_get() to `kernels` (NULL unbinds).
+ */
+de100_file_scoped_fn inline void de100_kernels_bind(De100Kernels *kernels) {
+  g_de100_pixel_kernels = kernels ? &kernels->pixel : NULL;
+  g_de100_audio_mix_kernels = kernels ? &kernels->audio_mix : NULL;
+}
+
+#define DE100_KERNELS_BIND(game_memory)                                        \
+  de100_kernels_bind((game_memory)->kernels)
+
+#endif // DE100_GAME_KERNELS_H
@@ -0,0 +1,458 @@
+#ifndef DE100_GAME_MEMORY_ARENA_H
+#define DE100_GAME_MEMORY_ARENA_H
+
+#include "../_common/base.h"
+#include "../_common/memory.h"
+#include <string.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// 🧱 MEMORY ARENA (Casey's Day 32/34 pattern)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// A bump allocator on top of the raw GameMemory blocks.
+// The platform still allocates ONCE; the game carves it up with arenas
+// instead of casting `permanent_storage` and computing offsets by hand.
+//
+// LAYOUT (typical):
+// ┌─────────────────────────────────────────────────────────────┐
+// │ PermanentStorage                                            │
+// │ [GameState][world_arena ──────────────────────────────────] │
+// └─────────────────────────────────────────────────────────────┘
+// ┌─────────────────────────────────────────────────────────────┐
+// │ TransientStorage                                            │
+// │ [frame_arena────][path_arena──][...free...................] │
+// └─────────────────────────────────────────────────────────────┘
+//
+// Usage:
+//   GameState *state = (GameState *)memory->permanent_storage;
+//   if (!memory->is_initialized) {
+//     de100_arena_init(&state->world_arena,
+//                      memory->permanent_storage_size - sizeof(GameState),
+//                      (u8 *)memory->permanent_storage + sizeof(GameState));
+//     de100_arena_init_from_transient(&state->transient_arena, memory);
+//     de100_arena_sub_arena(&state->frame_arena, &state->transient_arena,
+//                           MEGABYTES(8), 16);
+//   }
+//
+//   De100TemporaryMemory scratch = de100_arena_begin_temp(&state->frame_arena);
+//   i32 *order = de100_arena_push_array(&state->frame_arena, count, i32);
+//   ...
+//   de100_arena_end_temp(scratch);
+//
+// Arenas are plain data (no pointers into platform state), so they live
+// inside GameState, survive hot reload, and are captured by replay
+// snapshots like the rest of permanent storage.
+//
+// LAZY COMMIT (GameConfig.prefer_lazy_transient_commit): transient storage
+// is only reserved, and memory->transient_commit is its commit frontier
+// (memory.h). Arenas made from it (and their sub-arenas) commit pages as
+// pushes reach them, so resident memory follows what the game actually
+// uses. A reset hands pages above this cycle's peak back to the OS, so a
+// one-off spike (a level load) is returned at the following reset while
+// a steady frame arena never makes a syscall. A failed commit is an
+// out-of-space push.
+//
+// All functions are static inline for zero overhead if unused.
+//
+// DEBUG MODES (DE100_INTERNAL builds; pass -D... to both the game library
+// and the platform):
+//
+//   DE100_ARENA_GUARD_PAGES=1   Every push gets its own page(s) and ends
+//                               flush against a PROT_NONE guard (see
+//                               memory.h DEBUG GUARDS): an overrun crashes
+//                               at the faulting write, not frames later.
+//                               Uses >= 2 pages per push, so size transient
+//                               storage up; replay snapshots can't read
+//                               the guards, so don't record loops with it.
+//   DE100_ARENA_POISON=1        end_temp/reset fill the released bytes with
+//                               0xDD. On by default in DE100_SLOW builds.
+//   DE100_ARENA_CAPACITY_PERCENT=N
+//                               Every arena gets N% of its size. Lower it
+//                               until pushes start failing to find the
+//                               real working set (high_water_mark and
+//                               failed_push_count report it).
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define DE100_ARENA_DEFAULT_ALIGNMENT 8
+
+#ifndef DE100_ARENA_GUARD_PAGES
+#define DE100_ARENA_GUARD_PAGES 0
+#endif
+
+#ifndef DE100_ARENA_POISON
+#if DE100_SLOW || DE100_ARENA_GUARD_PAGES
+#define DE100_ARENA_POISON 1
+#else
+#define DE100_ARENA_POISON 0
+#endif
+#endif
+
+// Lazily committed arenas: smallest surplus a reset bothers to release
+#ifndef DE100_ARENA_RELEASE_MIN
+#define DE100_ARENA_RELEASE_MIN MEGABYTES(1)
+#endif
+
+#ifndef DE100_ARENA_CAPACITY_PERCENT
+#define DE100_ARENA_CAPACITY_PERCENT 100
+#endif
+
+#if !DE100_INTERNAL &&                                                         \
+    (DE100_ARENA_GUARD_PAGES || DE100_ARENA_CAPACITY_PERCENT != 100)
+#error "Arena guard pages / reduced capacity are DE100_INTERNAL-only"
+#endif
+
+typedef struct De100MemoryArena {
+  u8 *base;
+  u64 size;
+  u64 used;
+
+  // Number of open temporary scopes (must be 0 at frame end)
+  i32 temp_count;
+
+  // Lazily committed backing (NULL = [base, base + size) is all usable).
+  // Points into game memory like `base`, so it survives reload/replay.
+  struct De100CommitFrontier *commit;
+  u64 cycle_peak; // Highest `used` since the last reset
+  u64 resident;   // Highest `used` since pages were last released
+
+#if DE100_INTERNAL
+  // Largest `used` ever observed; size GameConfig storage from this.
+  u64 high_water_mark;
+  // Number of pushes that failed because the arena was full.
+  u32 failed_push_count;
+#endif
+} De100MemoryArena;
+
+typedef struct {
+  De100MemoryArena *arena;
+  u64 used;
+} De100TemporaryMemory;
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Initialization
+// ─────────────────────────────────────────────────────────────────────────────
+
+de100_file_scoped_fn inline void de100_arena_init(De100MemoryArena *arena,
+                                                  u64 size, void *base) {
+#if DE100_ARENA_CAPACITY_PERCENT != 100
+  size = size / 100 * DE100_ARENA_CAPACITY_PERCENT +
+         size % 100 * DE100_ARENA_CAPACITY_PERCENT / 100;
+#endif
+  arena->base = (u8 *)base;
+  arena->size = size;
+  arena->used = 0;
+  arena->temp_count = 0;
+  arena->commit = NULL;
+  arena->cycle_peak = 0;
+  arena->resident = 0;
+#if DE100_INTERNAL
+  arena->high_water_mark = 0;
+  arena->failed_push_count = 0;
+#endif
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Lazy Commit
+// ─────────────────────────────────────────────────────────────────────────────
+// Make [arena->base, end) usable. One atomic load when it already is.
+//
+
+de100_file_scoped_fn inline bool de100_arena_commit_to(De100MemoryArena *arena,
+                                                       u8 *end) {
+  De100CommitFrontier *frontier = arena->commit;
+  u64 offset = (u64)(end - frontier->base);
+  if (offset <= __atomic_load_n(&frontier->committed, __ATOMIC_ACQUIRE)) {
+    return true;
+  }
+  return de100_commit_frontier_grow(frontier, offset);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Alignment
+// ─────────────────────────────────────────────────────────────────────────────
+// Returns the padding needed so the next push starts on `alignment`.
+// `alignment` must be a power of two.
+//
+
+de100_file_scoped_fn inline u64
+de100_arena_alignment_offset(De100MemoryArena *arena, u64 alignment) {
+  DEV_ASSERT_MSG((alignment & (alignment - 1)) == 0,
+                 "Arena alignment must be a power of two (got %llu)",
+                 (unsigned long long)alignment);
+
+  uintptr_t next = (uintptr_t)(arena->base + arena->used);
+  uintptr_t mask = (uintptr_t)alignment - 1;
+  u64 offset = 0;
+  if (next & mask) {
+    offset = (u64)(alignment - (next & mask));
+  }
+  return offset;
+}
+
+de100_file_scoped_fn inline u64
+de100_arena_remaining(De100MemoryArena *arena, u64 alignment) {
+  u64 offset = de100_arena_alignment_offset(arena, alignment);
+  if (arena->used + offset >= arena->size) {
+    return 0;
+  }
+  return arena->size - (arena->used + offset);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Push
+// ─────────────────────────────────────────────────────────────────────────────
+// Returns NULL when the arena is out of space (and asserts in slow builds).
+// Memory is NOT zeroed; use the `_zero` variants when needed.
+//
+
+de100_file_scoped_fn inline void *
+de100_arena_push_size_aligned(De100MemoryArena *arena, u64 size,
+                              u64 alignment) {
+#if DE100_ARENA_GUARD_PAGES
+  // Carving protects pages; committing afterwards would undo the guard
+  if (arena->commit &&
+      !de100_arena_commit_to(arena, arena->base + arena->size)) {
+    return NULL;
+  }
+  size_t carved = 0;
+  void *guarded = de100_memory_guarded_carve(arena->base + arena->used,
+                                             arena->size - arena->used, size,
+                                             alignment, &carved);
+  u64 offset = 0;
+  u64 effective_size = guarded ? carved : arena->size - arena->used + 1;
+  if (guarded) {
+    offset = (u64)((u8 *)guarded - (arena->base + arena->used));
+  }
+#else
+  u64 offset = de100_arena_alignment_offset(arena, alignment);
+  u64 effective_size = size + offset;
+#endif
+
+  if (arena->used + effective_size > arena->size) {
+#if DE100_INTERNAL
+    arena->failed_push_count++;
+#endif
+    DEV_ASSERT_MSG(false,
+                   "Memory arena out of space (used %llu + %llu > size %llu)",
+                   (unsigned long long)arena->used,
+                   (unsigned long long)effective_size,
+                   (unsigned long long)arena->size);
+    return NULL;
+  }
+
+  void *result = arena->base + arena->used + offset;
+  if (arena->commit) {
+    if (!de100_arena_commit_to(arena, (u8 *)result + size)) {
+#if DE100_INTERNAL
+      arena->failed_push_count++;
+#endif
+      return NULL;
+    }
+    u64 used = arena->used + effective_size;
+    arena->cycle_peak = used > arena->cycle_peak ? used : arena->cycle_peak;
+    arena->resident = used > arena->resident ? used : arena->resident;
+  }
+  arena->used += effective_size; // Guard mode: through the guard page
+
+#if DE100_INTERNAL
+  if (arena->used > arena->high_water_mark) {
+    arena->high_water_mark = arena->used;
+  }
+#endif
+
+  return result;
+}
+
+de100_file_scoped_fn inline void *de100_arena_push_size(De100MemoryArena *arena,
+                                                        u64 size) {
+  return de100_arena_push_size_aligned(arena, size,
+                                       DE100_ARENA_DEFAULT_ALIGNMENT);
+}
+
+de100_file_scoped_fn inline void *
+de100_arena_push_size_aligned_zero(De100MemoryArena *arena, u64 size,
+                                   u64 alignment) {
+  void *result = de100_arena_push_size_aligned(arena, size, alignment);
+  if (result) {
+    memset(result, 0, size);
+  }
+  return result;
+}
+
+de100_file_scoped_fn inline void *
+de100_arena_push_size_zero(De100MemoryArena *arena, u64 size) {
+  return de100_arena_push_size_aligned_zero(arena, size,
+                                            DE100_ARENA_DEFAULT_ALIGNMENT);
+}
+
+#define de100_arena_push_struct(arena, type)                                   \
+  ((type *)de100_arena_push_size_aligned((arena), sizeof(type),                \
+                                         _Alignof(type)))
+#define de100_arena_push_array(arena, count, type)                             \
+  ((type *)de100_arena_push_size_aligned((arena), (u64)(count) * sizeof(type), \
+                                         _Alignof(type)))
+#define de100_arena_push_struct_zero(arena, type)                              \
+  ((type *)de100_arena_push_size_aligned_zero((arena), sizeof(type),           \
+                                              _Alignof(type)))
+#define de100_arena_push_array_zero(arena, count, type)                        \
+  ((type *)de100_arena_push_size_aligned_zero(                                 \
+      (arena), (u64)(count) * sizeof(type), _Alignof(type)))
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Sub-Arenas
+// ─────────────────────────────────────────────────────────────────────────────
+// Carve a child arena out of a parent (usually the transient arena).
+// The child owns its range until the parent is reset/restored past it.
+// A lazily committed child commits its own pages as it goes, not the
+// whole range up front.
+//
+
+de100_file_scoped_fn inline bool de100_arena_sub_arena(De100MemoryArena *child,
+                                                       De100MemoryArena *parent,
+                                                       u64 size,
+                                                       u64 alignment) {
+  // Claim the range without committing it: detach the frontier for the
+  // push (pushing 0 bytes past `base` still bounds-checks `size`)
+  De100CommitFrontier *commit = parent->commit;
+  parent->commit = NULL;
+  void *base = de100_arena_push_size_aligned(parent, size, alignment);
+  parent->commit = commit;
+  if (!base) {
+    de100_arena_init(child, 0, NULL);
+    return false;
+  }
+  de100_arena_init(child, size, base);
+  child->commit = commit;
+  return true;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Temporary Memory (checkpoint / restore)
+// ─────────────────────────────────────────────────────────────────────────────
+// Scopes nest; they must be ended in reverse order.
+//
+
+// Everything past `used` is going away: lift its guards, then poison it
+de100_file_scoped_fn inline void de100_arena_release_to(De100MemoryArena *arena,
+                                                        u64 used) {
+  if (used >= arena->used) {
+    return;
+  }
+#if DE100_ARENA_GUARD_PAGES
+  de100_memory_unguard(arena->base + used, arena->used - used);
+#endif
+#if DE100_ARENA_POISON
+  de100_memory_poison(arena->base + used, arena->used - used);
+#endif
+}
+
+// Undo every push after a saved `used` (e.g. a failed multi-part load)
+de100_file_scoped_fn inline void de100_arena_pop_to(De100MemoryArena *arena,
+                                                    u64 used) {
+  de100_arena_release_to(arena, used);
+  arena->used = used;
+}
+
+de100_file_scoped_fn inline De100TemporaryMemory
+de100_arena_begin_temp(De100MemoryArena *arena) {
+  De100TemporaryMemory result;
+  result.arena = arena;
+  result.used = arena->used;
+  arena->temp_count++;
+  return result;
+}
+
+de100_file_scoped_fn inline void
+de100_arena_end_temp(De100TemporaryMemory temp) {
+  De100MemoryArena *arena = temp.arena;
+  DEV_ASSERT_MSG(arena->used >= temp.used,
+                 "Temporary memory ended out of order (used %llu < %llu)",
+                 (unsigned long long)arena->used,
+                 (unsigned long long)temp.used);
+  DEV_ASSERT_MSG(arena->temp_count > 0, "Unbalanced end_temp (count %d)",
+                 arena->temp_count);
+  de100_arena_release_to(arena, temp.used);
+  arena->used = temp.used;
+  arena->temp_count--;
+}
+
+// Call once per frame on long-lived arenas to catch leaked temp scopes.
+de100_file_scoped_fn inline void
+de100_arena_check_temps(De100MemoryArena *arena) {
+  DEV_ASSERT_MSG(arena->temp_count == 0,
+                 "%d temporary memory scope(s) left open at frame end",
+                 arena->temp_count);
+  (void)arena;
+}
+
+de100_file_scoped_fn inline void de100_arena_reset(De100MemoryArena *arena) {
+  DEV_ASSERT_MSG(arena->temp_count == 0,
+                 "Resetting arena with %d open temporary scope(s)",
+                 arena->temp_count);
+  de100_arena_release_to(arena, 0);
+  arena->used = 0;
+
+  // Keep what this cycle needed; return the rest of an earlier spike
+  if (arena->commit) {
+    if (arena->resident >= arena->cycle_peak + DE100_ARENA_RELEASE_MIN &&
+        de100_commit_frontier_release(arena->commit,
+                                      arena->base + arena->cycle_peak,
+                                      arena->resident - arena->cycle_peak)) {
+      arena->resident = arena->cycle_peak;
+    }
+    arena->cycle_peak = 0;
+  }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Debug: High-Water Mark
+// ─────────────────────────────────────────────────────────────────────────────
+// Read the peak usage to size `permanent_storage_size` and
+// `transient_storage_size` in GameConfig from real numbers.
+//
+
+#if DE100_INTERNAL
+de100_file_scoped_fn inline void
+de100_arena_print_usage(const char *name, De100MemoryArena *arena) {
+  f64 to_mb = 1.0 / (1024.0 * 1024.0);
+  printf("📊 Arena '%s': used %.2f MB, peak %.2f MB / %.2f MB (%.1f%%)",
+         name, (f64)arena->used * to_mb, (f64)arena->high_water_mark * to_mb,
+         (f64)arena->size * to_mb,
+         arena->size ? 100.0 * (f64)arena->high_water_mark / (f64)arena->size
+                     : 0.0);
+  if (arena->failed_push_count) {
+    printf(" ⚠️  %u failed pushes", arena->failed_push_count);
+  }
+  printf("\n");
+}
+#endif
+
+#endif // DE100_GAME_MEMORY_ARENA_H
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Arenas over GameMemory
+// ─────────────────────────────────────────────────────────────────────────────
+// Defined once memory.h is in, whichever of the two comes first (memory.h
+// includes this header at its end). The arena itself needs nothing from
+// GameMemory, so a game with its own platform layer can use arenas, and
+// the headers built on them, without the engine's GameState and inputs.
+
+#if defined(DE100_GAME_De100_MEMORY_H) &&                                      \
+    !defined(DE100_GAME_MEMORY_ARENA_GAME_MEMORY_H)
+#define DE100_GAME_MEMORY_ARENA_GAME_MEMORY_H
+
+de100_file_scoped_fn inline void
+de100_arena_init_from_permanent(De100MemoryArena *arena, GameMemory *memory) {
+  de100_arena_init(arena, memory->permanent_storage_size,
+                   memory->permanent_storage);
+}
+
+de100_file_scoped_fn inline void
+de100_arena_init_from_transient(De100MemoryArena *arena, GameMemory *memory) {
+  de100_arena_init(arena, memory->transient_storage_size,
+                   memory->transient_storage);
+  arena->commit = memory->transient_commit;
+}
+
+#endif
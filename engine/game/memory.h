@@ -2,7 +2,18 @@
 #define DE100_GAME_De100_MEMORY_H
 
 #include "../_common/memory.h"
+#include "../_common/profiler.h"
+#include "../platforms/_common/input-stream.h"
 #include "../platforms/_common/replay-buffer.h"
+#include "../platforms/_common/replay-hash.h"
+#include "../platforms/_common/replay-timeline.h"
+#include "asset-watch.h"
+#include "async-io.h"
+#include "background-load.h"
+#include "config.h"
+#include "idle-job.h"
+#include "platform-command.h"
+#include "thread.h"
 #include <stdint.h>
 
 // ═══════════════════════════════════════════════════════════════
@@ -42,6 +53,44 @@
 
 #define MAX_REPLAY_BUFFERS 4
 
+#define DE100_DEBUG_MAX_ARENAS 8
+#define DE100_DEBUG_MAX_POOLS 8
+#define DE100_DEBUG_NAME_LENGTH 24
+
+/**
+ * A fixed-capacity pool shown in the memory telemetry (entity pools,
+ * particle pools, ...). The name is copied so it outlives a reload of the
+ * game library; the counters point into game storage.
+ */
+typedef struct {
+  char name[DE100_DEBUG_NAME_LENGTH];
+  const u32 *live;
+  const u32 *capacity;
+} De100DebugPool;
+
+/**
+ * A code module's function table as the game sees it (GameConfig.modules).
+ * Read it every frame: it moves on each reload, and is NULL while the
+ * module is unloaded or failed to load.
+ */
+typedef struct {
+  const void *api;
+  u32 generation; // Bumped on every (re)load: drop anything cached from it
+} De100GameModule;
+
+/**
+ * Netplay session as the game sees it (see platforms/_common/netplay.h).
+ * player_count is 0 outside a session. While it runs, player p plays on
+ * controllers[p], and a frame may be simulated more than once: frames with
+ * is_resimulating set are re-runs after a rollback, never rendered, so
+ * skip sounds and other one-shot effects in them.
+ */
+typedef struct {
+  u32 player_count;
+  u32 local_player;
+  bool32 is_resimulating;
+} De100NetplayInfo;
+
 /**
  * 🧠 GAME MEMORY
  * ───────────────────────────────────────────────────────────────
@@ -52,6 +101,9 @@
  *   - IsInitialized flag for first-run detection
  *   - PermanentStorage for save data, settings
  *   - TransientStorage for level data, temp buffers
+ *
+ * Use `memory-arena.h` to carve these blocks into bump-allocated arenas
+ * instead of casting and computing offsets by hand.
  * ───────────────────────────────────────────────────────────────
  */
 typedef struct {
@@ -68,10 +120,134 @@ typedef struct {
   u64 permanent_storage_size;
   // Size of the temporary storage block in bytes
   u64 transient_storage_size;
+  // Per-frame scratch (GameConfig.frame_arena_size; NULL when 0). Two
+  // arenas at the start of transient storage that swap every frame:
+  // frame_arena is empty when game_update_and_render starts, and
+  // previous_frame_arena still holds what was pushed last frame. So data
+  // lives one or two frames with no cleanup, in memory replay snapshots
+  // cover. Main thread only (workers have ThreadContext.scratch_arena);
+  // temporary scopes must be closed by the end of the frame.
+  struct De100MemoryArena *frame_arena;
+  struct De100MemoryArena *previous_frame_arena;
+
+  // Non-NULL with GameConfig.prefer_lazy_transient_commit: transient storage
+  // is reserved, not committed. Use it through arenas (memory-arena.h),
+  // which commit as they grow; raw writes past the frontier fault.
+  De100CommitFrontier *transient_commit;
   // Has this memory been initialized?
   bool32 is_initialized;
+
+  // Platform-owned worker pool (see thread.h). Valid for the whole session;
+  // refreshed by the platform, so never store these in permanent storage.
+  De100WorkQueue *work_queue;
+  de100_platform_add_work_entry_t *add_work_entry;
+  de100_platform_complete_all_work_t *complete_all_work;
+
+  // Platform-owned async file I/O (see async-io.h). Same lifetime rules as
+  // the work queue.
+  De100AsyncIO *async_io;
+  de100_platform_async_io_submit_t *async_io_submit;
+  de100_platform_async_io_wait_t *async_io_wait;
+
+  // Platform-owned multi-frame loader (see background-load.h). NULL if it
+  // failed to start; same lifetime rules as the work queue.
+  De100BackgroundLoader *background_loader;
+  de100_platform_background_load_submit_t *background_load_submit;
+
+  // Platform-owned slack scheduler (see idle-job.h). Always set; main
+  // thread only.
+  De100IdleScheduler *idle_scheduler;
+  de100_platform_idle_job_submit_t *idle_job_submit;
+
+  // Platform-owned asset file watcher (see asset-reload.h). Set only in
+  // DE100_INTERNAL builds; main thread only.
+  De100AssetWatcher *asset_watcher;
+  de100_platform_asset_watch_t *asset_watch;
+  de100_platform_asset_watch_version_t *asset_watch_version;
+
+  // Requests to the platform (see platform-command.h): push from any
+  // thread, applied at the end of the frame. Always set.
+  De100PlatformCommandQueue *platform_commands;
+
+  // Pipelined rendering (GameConfig.prefer_pipelined_render): non-NULL only
+  // inside game_render. Record into it instead of drawing; the platform
+  // rasterizes it on the work queue while the next frame updates.
+  struct De100RenderGroup *render_group;
+
+  // Code modules, indexed like GameConfig.modules. Platform-owned; only
+  // call into them from the main thread or work joined within the frame,
+  // since a reload swaps them between frames.
+  De100GameModule modules[DE100_GAME_MAX_MODULES];
+
+  // Bumped each time a hot reload loads new main-library code. Anything in
+  // game memory holding code addresses (fiber stacks, see fiber.h) went
+  // stale when it changed.
+  u32 code_generation;
+
+  // Platform-owned SIMD kernels picked for this CPU (see kernels.h). Valid
+  // for the whole session. Bind them once per frame with
+  // DE100_KERNELS_BIND(memory).
+  struct De100Kernels *kernels;
+
+  // Platform-owned scoped profiler (see profiler.h); NULL unless
+  // DE100_INTERNAL. Bind it once per frame with DE100_PROFILER_BIND(memory).
+  De100Profiler *profiler;
+
+  // Arenas the game wants shown in the debug overlay's usage bars (optional).
+  // Pointers into game storage; republish after a reload.
+  struct De100MemoryArena *debug_arenas[DE100_DEBUG_MAX_ARENAS];
+  // Pools for the memory telemetry, see de100_debug_publish_pool (optional)
+  De100DebugPool debug_pools[DE100_DEBUG_MAX_POOLS];
+
+  // Fast-forward (fixed-timestep games only, see fixed-timestep.h). The
+  // game sets time_scale: 0 or 1 = normal speed, N = N simulated seconds
+  // per real second, as extra game_update ticks (dt never grows). The
+  // platform writes back the speed it sustained, lower than asked when
+  // the ticks don't fit the frame budget.
+  f32 time_scale;
+  f32 effective_time_scale;
+
+  // Peer-to-peer rollback session (DE100_NETPLAY), platform-written
+  De100NetplayInfo netplay;
 } GameMemory;
 
+/**
+ * Publish (or refresh) a pool in GameMemory.debug_pools, matched by name.
+ * Call once after carving the pool; it stays listed across reloads.
+ *
+ *   de100_debug_publish_pool(memory, "enemies", &pool->index.count,
+ *                            &pool->index.capacity);
+ */
+de100_file_scoped_fn inline void
+de100_debug_publish_pool(GameMemory *memory, const char *name,
+                         const u32 *live, const u32 *capacity) {
+  De100DebugPool *slot = NULL;
+  for (u32 i = 0; i < DE100_DEBUG_MAX_POOLS && !slot; ++i) {
+    De100DebugPool *pool = &memory->debug_pools[i];
+    u32 c = 0;
+    while (c < DE100_DEBUG_NAME_LENGTH - 1 && name[c] &&
+           pool->name[c] == name[c]) {
+      ++c;
+    }
+    bool same_name = pool->name[c] == '\0' &&
+                     (name[c] == '\0' || c == DE100_DEBUG_NAME_LENGTH - 1);
+    if (!pool->live || same_name) {
+      slot = pool;
+    }
+  }
+  if (!slot) {
+    return; // Full: the pool just isn't shown
+  }
+
+  u32 c = 0;
+  for (; c < DE100_DEBUG_NAME_LENGTH - 1 && name[c]; ++c) {
+    slot->name[c] = name[c];
+  }
+  slot->name[c] = '\0';
+  slot->live = live;
+  slot->capacity = capacity;
+}
+
 typedef struct GameState GameState;
 
 // ═══════════════════════════════════════════════════════════════════════════
@@ -99,17 +275,46 @@ typedef struct {
   // ─────────────────────────────────────────────────────────────────────
   ReplayBuffer replay_buffers[MAX_REPLAY_BUFFERS];
 
+  // Which part of game memory a snapshot covers, and (in incremental mode)
+  // which pages changed since the last save/restore
+  ReplaySnapshotTracker snapshot_tracker;
+
+  // Keyframes captured while recording `timeline_slot_index`, for seeking
+  ReplayTimeline timeline;
+  i32 timeline_slot_index; // 0 = no keyframes for any slot
+
+  // Permanent-storage hashes written into recordings and checked on
+  // playback, to find the first frame a replay desyncs
+  ReplayStateHash state_hash;
+
+  // Permanent-storage layout of the loaded game code (see
+  // GAME_GET_STATE_VERSION), and the layout each slot's snapshot holds
+  u32 state_version;
+  u32 slot_state_versions[MAX_REPLAY_BUFFERS];
+
   // ─────────────────────────────────────────────────────────────────────
   // INPUT RECORDING STATE
   // ─────────────────────────────────────────────────────────────────────
+  // Slot files, interned at init (input_recording_init_paths); NULL =
+  // built from exe_directory on each call
+  const char *input_filenames[MAX_REPLAY_BUFFERS];
+  const char *archive_filenames[MAX_REPLAY_BUFFERS];
   i32 recording_fd; // File descriptor for input events (-1 = not recording)
   i32 input_recording_index; // 0 = not recording, N = recording to slot N
+  u64 recorded_frame_count;  // Frames written since recording began
+  InputStreamWriter input_writer; // Delta-encodes frames into recording_fd
+  De100AsyncIO *async_io; // Writes the stream off-thread (NULL = blocking)
 
   // ─────────────────────────────────────────────────────────────────────
   // INPUT PLAYBACK STATE
   // ─────────────────────────────────────────────────────────────────────
-  i32 playback_fd; // File descriptor for input events (-1 = not playing)
+  InputStreamReader input_reader; // Mapped input file being played
   i32 input_playing_index; // 0 = not playing, N = playing from slot N
+  u64 playback_frame_index; // Next frame to be read from the input file
+  u64 playback_frame_count; // Frames in the input file
 } GameMemoryState;
 
+// de100_arena_init_from_permanent/transient, whichever header came first
+#include "memory-arena.h"
+
 #endif // DE100_GAME_De100_MEMORY_H
@@ -0,0 +1,535 @@
+#ifndef DE100_GAME_PARTICLES_H
+#define DE100_GAME_PARTICLES_H
+
+#include "../_common/base.h"
+#include "../_common/math-simd.h"
+#include "backbuffer.h"
+#include "memory-arena.h"
+#include "pixel-kernels.h"
+#include "random.h"
+#include <math.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ✨ PARTICLES (SoA ring pool, emitters, SIMD integrate + batched draw)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// Cosmetic particles (sparks, debris, smoke) for any game, instead of a
+// fixed array + compaction pass per game:
+//
+//   // Transient storage: particles never affect gameplay (see below)
+//   de100_particles_init(&state->sparks, &state->transient_arena, 1 << 17,
+//                        DE100_PARTICLES_ANALYTIC);
+//   state->sparks.fade_out = true;
+//
+//   De100ParticleEmitter burst = {
+//       .x = hit.x, .y = hit.y,
+//       .angle_min = 0.0f, .angle_max = 6.2831853f,
+//       .speed_min = 40.0f, .speed_max = 160.0f,
+//       .lifetime_min = 0.3f, .lifetime_max = 0.8f,
+//       .accel_y = 200.0f,
+//       .color = DE100_RGB(255, 200, 80),
+//   };
+//   de100_particles_emit(&state->sparks, &burst, 64, &state->fx_rng);
+//
+//   de100_particles_update(&state->sparks, dt);      // once per frame
+//   de100_particles_draw(buffer, &state->sparks, 2); // 2x2 quads
+//
+// Storage is one column per field, pushed from an arena at init. Slots
+// form a ring in spawn order: live particles are [head, head + count).
+// Spawn order is death order for equal lifetimes, so culling is an AGE
+// RANGE, not a search: update() advances `head` past every particle whose
+// death time has passed, and nothing is swapped or compacted. A particle
+// that dies before an older, longer-lived neighbour waits in the ring
+// (skipped at draw) until the head passes it. A full pool overwrites its
+// oldest particle, so new effects always show.
+//
+// Two modes, fixed at init:
+//
+//   SIMULATED  x/y/vx/vy integrated every update (semi-implicit Euler,
+//              de100_soa_integrate in math-simd.h). For particles the game
+//              pokes at.
+//   ANALYTIC   x/y/vx/vy stay as spawned; draw evaluates
+//                p(t) = p0 + (v0 + a t / 2) t,  t = now - spawn
+//              so update() only advances the clock and the head: a
+//              particle costs nothing between spawn and draw.
+//
+// draw() evaluates positions and fade 4 at a time into a small batch,
+// culls against the clip in the same pass, then plots the survivors:
+// size 1 writes single pixels, larger sizes fill size x size quads
+// through the row kernels. Opaque colors are stored, translucent ones
+// (or fading ones) blended.
+//
+// Particles live in TRANSIENT memory on purpose: replays don't restore
+// it, so a pool may come back with stale columns after a seek. Positions
+// outside the clip (or NaN) are culled, so the worst case is a frame of
+// odd sparks, never a crash or a gameplay divergence.
+//
+// Define DE100_PARTICLES_FORCE_SCALAR to pin the reference path.
+//
+// All functions are static inline for zero overhead if unused.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#if !defined(DE100_PARTICLES_FORCE_SCALAR) &&                                  \
+    (defined(__x86_64__) || defined(_M_X64) || defined(__i386__) ||          \
+     defined(_M_IX86))
+#define DE100_PARTICLES_X86 1
+#include <emmintrin.h>
+#elif !defined(DE100_PARTICLES_FORCE_SCALAR) && defined(__aarch64__)
+#define DE100_PARTICLES_NEON 1
+#include <arm_neon.h>
+#endif
+
+#define DE100_PARTICLES_MAX_CAPACITY (1u << 22)
+#define DE100_PARTICLES_COLUMN_ALIGNMENT 64
+// Particles evaluated per draw batch (stack arrays, 3 x 4 bytes each)
+#define DE100_PARTICLES_BATCH 256
+// Clock rebase interval: keeps `time` small enough for sub-ms f32 steps
+#define DE100_PARTICLES_REBASE_SECONDS 1024.0f
+
+typedef enum {
+  DE100_PARTICLES_SIMULATED = 0,
+  DE100_PARTICLES_ANALYTIC,
+} De100ParticleMode;
+
+typedef struct {
+  // Columns, `capacity` entries each; slot = (head + i) & mask
+  f32 *x, *y;       // Simulated: current; analytic: spawn point
+  f32 *vx, *vy;     // Simulated: current; analytic: at spawn
+  f32 *ax, *ay;     // Constant acceleration (gravity, wind)
+  f32 *spawn_time;  // Pool clock at spawn
+  f32 *death_time;  // Pool clock at death
+  u32 *color;       // DE100_PIXEL_FORMAT, alpha = starting opacity
+
+  u32 capacity; // Power of two
+  u32 mask;
+  u32 head;
+  u32 count; // Live range length (includes early-dead, see above)
+  f32 time;  // Pool clock, seconds
+  De100ParticleMode mode;
+  bool32 fade_out; // Alpha falls linearly to 0 over each lifetime
+} De100ParticlePool;
+
+/**
+ * What one emit() call sprays. Angles in radians, 0 = +x, growing toward
+ * +y (screen down); speeds in pixels/s; accelerations in pixels/s².
+ * Each particle rolls its angle, speed and lifetime uniformly in range.
+ */
+typedef struct {
+  f32 x, y;
+  f32 angle_min, angle_max;
+  f32 speed_min, speed_max;
+  f32 lifetime_min, lifetime_max; // Seconds, > 0
+  f32 accel_x, accel_y;
+  u32 color;
+} De100ParticleEmitter;
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Pool
+// ─────────────────────────────────────────────────────────────────────────────
+
+/**
+ * Push the columns for `capacity` particles (rounded up to a power of two)
+ * from `arena`. Returns false (and leaves the pool empty, capacity 0) when
+ * the arena is too small.
+ */
+de100_file_scoped_fn inline bool
+de100_particles_init(De100ParticlePool *pool, De100MemoryArena *arena,
+                     u32 capacity, De100ParticleMode mode) {
+  DEV_ASSERT_MSG(capacity > 0 && capacity <= DE100_PARTICLES_MAX_CAPACITY,
+                 "Particle capacity %u out of range", capacity);
+  *pool = (De100ParticlePool){.mode = mode};
+  if (capacity == 0 || capacity > DE100_PARTICLES_MAX_CAPACITY) {
+    return false;
+  }
+  u32 rounded = 1;
+  while (rounded < capacity) {
+    rounded <<= 1;
+  }
+
+  f32 **f32_columns[] = {&pool->x,  &pool->y,  &pool->vx,         &pool->vy,
+                         &pool->ax, &pool->ay, &pool->spawn_time,
+                         &pool->death_time};
+  for (u32 i = 0; i < ArraySize(f32_columns); ++i) {
+    *f32_columns[i] = (f32 *)de100_arena_push_size_aligned(
+        arena, (u64)rounded * sizeof(f32), DE100_PARTICLES_COLUMN_ALIGNMENT);
+    if (!*f32_columns[i]) {
+      return false;
+    }
+  }
+  pool->color = (u32 *)de100_arena_push_size_aligned(
+      arena, (u64)rounded * sizeof(u32), DE100_PARTICLES_COLUMN_ALIGNMENT);
+  if (!pool->color) {
+    return false;
+  }
+
+  pool->capacity = rounded;
+  pool->mask = rounded - 1;
+  return true;
+}
+
+de100_file_scoped_fn inline void
+de100_particles_clear(De100ParticlePool *pool) {
+  pool->head = 0;
+  pool->count = 0;
+}
+
+/**
+ * Append one particle at the pool's current time; overwrites the oldest
+ * when full. Returns its slot (valid until it is culled or overwritten).
+ */
+de100_file_scoped_fn inline u32
+de100_particles_spawn(De100ParticlePool *pool, f32 x, f32 y, f32 vx, f32 vy,
+                      f32 ax, f32 ay, f32 lifetime, u32 color) {
+  DEV_ASSERT_MSG(pool->capacity > 0, "Particle pool not initialized");
+  if (pool->count == pool->capacity) {
+    pool->head = (pool->head + 1) & pool->mask;
+    pool->count--;
+  }
+  u32 slot = (pool->head + pool->count++) & pool->mask;
+  pool->x[slot] = x;
+  pool->y[slot] = y;
+  pool->vx[slot] = vx;
+  pool->vy[slot] = vy;
+  pool->ax[slot] = ax;
+  pool->ay[slot] = ay;
+  pool->spawn_time[slot] = pool->time;
+  pool->death_time[slot] = pool->time + lifetime;
+  pool->color[slot] = color;
+  return slot;
+}
+
+/**
+ * Spawn `count` particles from `emitter`, rolling from `rng` in batches
+ * (random.h bulk stream: keep it separate from gameplay rolls).
+ */
+de100_file_scoped_fn inline void
+de100_particles_emit(De100ParticlePool *pool,
+                     const De100ParticleEmitter *emitter, i32 count,
+                     De100RngBulk *rng) {
+  f32 angles[64], speeds[64], lifetimes[64];
+  for (i32 base = 0; base < count; base += (i32)ArraySize(angles)) {
+    i32 n = count - base;
+    if (n > (i32)ArraySize(angles)) {
+      n = (i32)ArraySize(angles);
+    }
+    de100_rng_bulk_range_f32(rng, angles, n, emitter->angle_min,
+                             emitter->angle_max);
+    de100_rng_bulk_range_f32(rng, speeds, n, emitter->speed_min,
+                             emitter->speed_max);
+    de100_rng_bulk_range_f32(rng, lifetimes, n, emitter->lifetime_min,
+                             emitter->lifetime_max);
+    for (i32 i = 0; i < n; ++i) {
+      de100_particles_spawn(pool, emitter->x, emitter->y,
+                            cosf(angles[i]) * speeds[i],
+                            sinf(angles[i]) * speeds[i], emitter->accel_x,
+                            emitter->accel_y, lifetimes[i], emitter->color);
+    }
+  }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Update
+// ─────────────────────────────────────────────────────────────────────────────
+
+// Semi-implicit Euler over slots [first, first + n) (no wrap)
+de100_file_scoped_fn inline void
+de100_particles_integrate_range(De100ParticlePool *pool, u32 first, u32 n,
+                                f32 dt) {
+  de100_soa_integrate(pool->x + first, pool->vx + first, pool->ax + first, n,
+                      dt);
+  de100_soa_integrate(pool->y + first, pool->vy + first, pool->ay + first, n,
+                      dt);
+}
+
+/**
+ * Advance the pool clock by `dt`, cull the dead prefix and (simulated
+ * pools) integrate the rest. O(culled) for analytic pools.
+ */
+de100_file_scoped_fn inline void de100_particles_update(De100ParticlePool *pool,
+                                                        f32 dt) {
+  pool->time += dt;
+  while (pool->count > 0 && pool->death_time[pool->head] <= pool->time) {
+    pool->head = (pool->head + 1) & pool->mask;
+    pool->count--;
+  }
+  if (pool->count == 0) {
+    pool->head = 0;
+    pool->time = 0.0f; // Nothing refers to the clock: restart it for free
+    return;
+  }
+
+  // Live range as at most two contiguous runs of the ring
+  u32 first_n = pool->capacity - pool->head;
+  first_n = first_n < pool->count ? first_n : pool->count;
+  u32 second_n = pool->count - first_n;
+
+  if (pool->mode == DE100_PARTICLES_SIMULATED) {
+    de100_particles_integrate_range(pool, pool->head, first_n, dt);
+    de100_particles_integrate_range(pool, 0, second_n, dt);
+  }
+
+  if (pool->time >= DE100_PARTICLES_REBASE_SECONDS) {
+    for (u32 i = 0; i < pool->count; ++i) {
+      u32 slot = (pool->head + i) & pool->mask;
+      pool->spawn_time[slot] -= DE100_PARTICLES_REBASE_SECONDS;
+      pool->death_time[slot] -= DE100_PARTICLES_REBASE_SECONDS;
+    }
+    pool->time -= DE100_PARTICLES_REBASE_SECONDS;
+  }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Draw
+// ─────────────────────────────────────────────────────────────────────────────
+
+// Top-left corner and final color per particle; color 0 = not drawn
+typedef struct {
+  i32 x[DE100_PARTICLES_BATCH];
+  i32 y[DE100_PARTICLES_BATCH];
+  u32 color[DE100_PARTICLES_BATCH];
+} De100ParticleBatch;
+
+// Screen-space limit positions are clamped to before the int conversion
+#define DE100_PARTICLES_COORD_LIMIT 65536.0f
+
+/**
+ * Evaluate slots [first, first + n) (no wrap, n <= batch) into `batch`:
+ * position (analytic or stored), floor, quad offset, clip test, fade.
+ */
+de100_file_scoped_fn inline void
+de100_particles_evaluate(const De100ParticlePool *pool, u32 first, u32 n,
+                         De100RenderClipRect clip, i32 size,
+                         De100ParticleBatch *batch) {
+  const f32 *px = pool->x + first, *py = pool->y + first;
+  const f32 *pvx = pool->vx + first, *pvy = pool->vy + first;
+  const f32 *pax = pool->ax + first, *pay = pool->ay + first;
+  const f32 *spawn = pool->spawn_time + first;
+  const f32 *death = pool->death_time + first;
+  const u32 *colors = pool->color + first;
+  bool analytic = pool->mode == DE100_PARTICLES_ANALYTIC;
+  bool fade = pool->fade_out;
+  f32 now = pool->time;
+  i32 half = size / 2;
+  // Quad [x - half, x - half + size) overlaps the clip iff x is in here
+  i32 min_x = clip.min_x + half - size + 1, max_x = clip.max_x + half;
+  i32 min_y = clip.min_y + half - size + 1, max_y = clip.max_y + half;
+
+  u32 i = 0;
+#if DE100_PARTICLES_X86
+  __m128 vnow = _mm_set1_ps(now);
+  __m128 vhalf = _mm_set1_ps(0.5f);
+  __m128 vlo = _mm_set1_ps(-DE100_PARTICLES_COORD_LIMIT);
+  __m128 vhi = _mm_set1_ps(DE100_PARTICLES_COORD_LIMIT);
+  __m128i vone = _mm_set1_epi32(1);
+  __m128i vmin_x = _mm_set1_epi32(min_x - 1), vmax_x = _mm_set1_epi32(max_x);
+  __m128i vmin_y = _mm_set1_epi32(min_y - 1), vmax_y = _mm_set1_epi32(max_y);
+  __m128i vhalf_i = _mm_set1_epi32(half);
+  __m128i vrgb = _mm_set1_epi32(0x00FFFFFF);
+  for (; i + 4 <= n; i += 4) {
+    __m128 x = _mm_loadu_ps(px + i);
+    __m128 y = _mm_loadu_ps(py + i);
+    __m128 t = _mm_sub_ps(vnow, _mm_loadu_ps(spawn + i));
+    if (analytic) {
+      __m128 hx = _mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(pax + i), t), vhalf);
+      __m128 hy = _mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(pay + i), t), vhalf);
+      x = _mm_add_ps(x, _mm_mul_ps(_mm_add_ps(hx, _mm_loadu_ps(pvx + i)), t));
+      y = _mm_add_ps(y, _mm_mul_ps(_mm_add_ps(hy, _mm_loadu_ps(pvy + i)), t));
+    }
+    // max first: maxps returns its second operand for NaN
+    x = _mm_min_ps(_mm_max_ps(x, vlo), vhi);
+    y = _mm_min_ps(_mm_max_ps(y, vlo), vhi);
+    __m128i xi = _mm_cvttps_epi32(x);
+    __m128i yi = _mm_cvttps_epi32(y);
+    // Truncation rounds negatives up: step back where it did
+    xi = _mm_sub_epi32(xi, _mm_and_si128(_mm_castps_si128(_mm_cmpgt_ps(
+                                             _mm_cvtepi32_ps(xi), x)),
+                                         vone));
+    yi = _mm_sub_epi32(yi, _mm_and_si128(_mm_castps_si128(_mm_cmpgt_ps(
+                                             _mm_cvtepi32_ps(yi), y)),
+                                         vone));
+
+    __m128 vdeath = _mm_loadu_ps(death + i);
+    __m128i visible = _mm_castps_si128(_mm_cmplt_ps(vnow, vdeath));
+    visible = _mm_and_si128(visible, _mm_cmpgt_epi32(xi, vmin_x));
+    visible = _mm_and_si128(visible, _mm_cmplt_epi32(xi, vmax_x));
+    visible = _mm_and_si128(visible, _mm_cmpgt_epi32(yi, vmin_y));
+    visible = _mm_and_si128(visible, _mm_cmplt_epi32(yi, vmax_y));
+
+    __m128i color = _mm_loadu_si128((const __m128i *)(colors + i));
+    if (fade) {
+      __m128 life = _mm_sub_ps(vdeath, _mm_loadu_ps(spawn + i));
+      __m128 left = _mm_div_ps(_mm_sub_ps(vdeath, vnow), life);
+      __m128 alpha = _mm_cvtepi32_ps(_mm_srli_epi32(color, 24));
+      __m128i faded = _mm_cvttps_epi32(_mm_mul_ps(alpha, left));
+      color = _mm_or_si128(_mm_and_si128(color, vrgb),
+                           _mm_slli_epi32(faded, 24));
+    }
+    _mm_storeu_si128((__m128i *)(batch->x + i), _mm_sub_epi32(xi, vhalf_i));
+    _mm_storeu_si128((__m128i *)(batch->y + i), _mm_sub_epi32(yi, vhalf_i));
+    _mm_storeu_si128((__m128i *)(batch->color + i),
+                     _mm_and_si128(color, visible));
+  }
+#elif DE100_PARTICLES_NEON
+  float32x4_t vnow = vdupq_n_f32(now);
+  float32x4_t vlo = vdupq_n_f32(-DE100_PARTICLES_COORD_LIMIT);
+  float32x4_t vhi = vdupq_n_f32(DE100_PARTICLES_COORD_LIMIT);
+  int32x4_t vhalf_i = vdupq_n_s32(half);
+  for (; i + 4 <= n; i += 4) {
+    float32x4_t x = vld1q_f32(px + i);
+    float32x4_t y = vld1q_f32(py + i);
+    float32x4_t t = vsubq_f32(vnow, vld1q_f32(spawn + i));
+    if (analytic) {
+      float32x4_t hx = vmulq_n_f32(vmulq_f32(vld1q_f32(pax + i), t), 0.5f);
+      float32x4_t hy = vmulq_n_f32(vmulq_f32(vld1q_f32(pay + i), t), 0.5f);
+      x = vaddq_f32(x, vmulq_f32(vaddq_f32(hx, vld1q_f32(pvx + i)), t));
+      y = vaddq_f32(y, vmulq_f32(vaddq_f32(hy, vld1q_f32(pvy + i)), t));
+    }
+    // NaN fails every compare, so select the low limit for it
+    x = vbslq_f32(vcgeq_f32(x, vlo), x, vlo);
+    y = vbslq_f32(vcgeq_f32(y, vlo), y, vlo);
+    x = vminq_f32(x, vhi);
+    y = vminq_f32(y, vhi);
+    int32x4_t xi = vcvtq_s32_f32(x);
+    int32x4_t yi = vcvtq_s32_f32(y);
+    // vcgt is all-ones (-1) where truncation rounded up: add it
+    xi = vaddq_s32(xi, vreinterpretq_s32_u32(vcgtq_f32(vcvtq_f32_s32(xi), x)));
+    yi = vaddq_s32(yi, vreinterpretq_s32_u32(vcgtq_f32(vcvtq_f32_s32(yi), y)));
+
+    float32x4_t vdeath = vld1q_f32(death + i);
+    uint32x4_t visible = vcltq_f32(vnow, vdeath);
+    visible = vandq_u32(visible, vcgtq_s32(xi, vdupq_n_s32(min_x - 1)));
+    visible = vandq_u32(visible, vcltq_s32(xi, vdupq_n_s32(max_x)));
+    visible = vandq_u32(visible, vcgtq_s32(yi, vdupq_n_s32(min_y - 1)));
+    visible = vandq_u32(visible, vcltq_s32(yi, vdupq_n_s32(max_y)));
+
+    uint32x4_t color = vld1q_u32(colors + i);
+    if (fade) {
+      float32x4_t life = vsubq_f32(vdeath, vld1q_f32(spawn + i));
+      float32x4_t left = vdivq_f32(vsubq_f32(vdeath, vnow), life);
+      float32x4_t alpha = vcvtq_f32_u32(vshrq_n_u32(color, 24));
+      uint32x4_t faded = vcvtq_u32_f32(vmulq_f32(alpha, left));
+      color = vorrq_u32(vandq_u32(color, vdupq_n_u32(0x00FFFFFF)),
+                        vshlq_n_u32(faded, 24));
+    }
+    vst1q_s32(batch->x + i, vsubq_s32(xi, vhalf_i));
+    vst1q_s32(batch->y + i, vsubq_s32(yi, vhalf_i));
+    vst1q_u32(batch->color + i, vandq_u32(color, visible));
+  }
+#endif
+  // Same operation order as the vectors (separate statements: no FMA)
+  for (; i < n; ++i) {
+    f32 x = px[i];
+    f32 y = py[i];
+    f32 t = now - spawn[i];
+    if (analytic) {
+      f32 hx = pax[i] * t;
+      f32 hy = pay[i] * t;
+      hx *= 0.5f;
+      hy *= 0.5f;
+      hx += pvx[i];
+      hy += pvy[i];
+      hx *= t;
+      hy *= t;
+      x += hx;
+      y += hy;
+    }
+    x = x >= -DE100_PARTICLES_COORD_LIMIT ? x : -DE100_PARTICLES_COORD_LIMIT;
+    y = y >= -DE100_PARTICLES_COORD_LIMIT ? y : -DE100_PARTICLES_COORD_LIMIT;
+    x = x < DE100_PARTICLES_COORD_LIMIT ? x : DE100_PARTICLES_COORD_LIMIT;
+    y = y < DE100_PARTICLES_COORD_LIMIT ? y : DE100_PARTICLES_COORD_LIMIT;
+    i32 xi = (i32)x;
+    i32 yi = (i32)y;
+    xi -= (f32)xi > x;
+    yi -= (f32)yi > y;
+
+    bool visible = now < death[i] && xi >= min_x && xi < max_x &&
+                   yi >= min_y && yi < max_y;
+    u32 color = colors[i];
+    if (fade && visible) {
+      f32 left = (death[i] - now) / (death[i] - spawn[i]);
+      u32 faded = (u32)((f32)(color >> 24) * left);
+      color = (color & 0x00FFFFFFu) | (faded << 24);
+    }
+    batch->x[i] = xi - half;
+    batch->y[i] = yi - half;
+    batch->color[i] = visible ? color : 0;
+  }
+}
+
+de100_file_scoped_fn inline void
+de100_particles_plot(GameBackBuffer *buffer, De100RenderClipRect clip,
+                     i32 size, const De100ParticleBatch *batch, u32 n) {
+  u8 *base = (u8 *)buffer->memory.base;
+  size_t pitch = (size_t)buffer->pitch;
+
+  if (size == 1) {
+    // Evaluate already proved every visible point inside the clip
+    for (u32 i = 0; i < n; ++i) {
+      u32 color = batch->color[i];
+      if ((color >> 24) == 0) {
+        continue;
+      }
+      u32 *pixel = (u32 *)(base + (size_t)batch->y[i] * pitch) + batch->x[i];
+      *pixel = (color >> 24) == 255 ? color
+                                    : de100_pixel_blend_scalar(*pixel, color);
+    }
+    return;
+  }
+
+  De100PixelKernels *kernels = de100_pixel_kernels_get();
+  for (u32 i = 0; i < n; ++i) {
+    u32 color = batch->color[i];
+    if ((color >> 24) == 0) {
+      continue;
+    }
+    i32 x0 = batch->x[i] > clip.min_x ? batch->x[i] : clip.min_x;
+    i32 y0 = batch->y[i] > clip.min_y ? batch->y[i] : clip.min_y;
+    i32 x1 = batch->x[i] + size < clip.max_x ? batch->x[i] + size : clip.max_x;
+    i32 y1 = batch->y[i] + size < clip.max_y ? batch->y[i] + size : clip.max_y;
+    de100_pixel_fill_row_t *row_fn =
+        (color >> 24) == 255 ? kernels->fill_row : kernels->blend_row;
+    for (i32 y = y0; y < y1; ++y) {
+      row_fn((u32 *)(base + (size_t)y * pitch) + x0, x1 - x0, color);
+    }
+  }
+}
+
+/**
+ * Draw every live particle as a `size` x `size` quad (1 = single pixel)
+ * centred on its position, restricted to `clip`.
+ */
+de100_file_scoped_fn inline void
+de100_particles_draw_clipped(GameBackBuffer *buffer, De100RenderClipRect clip,
+                             const De100ParticlePool *pool, i32 size) {
+  if (size < 1 || clip.max_x <= clip.min_x || clip.max_y <= clip.min_y) {
+    return;
+  }
+  De100ParticleBatch batch;
+  for (u32 done = 0; done < pool->count;) {
+    u32 first = (pool->head + done) & pool->mask;
+    u32 n = pool->count - done;
+    n = n < DE100_PARTICLES_BATCH ? n : DE100_PARTICLES_BATCH;
+    n = n < pool->capacity - first ? n : pool->capacity - first;
+    de100_particles_evaluate(pool, first, n, clip, size, &batch);
+    de100_particles_plot(buffer, clip, size, &batch, n);
+    done += n;
+  }
+}
+
+/**
+ * Immediate-mode draw over the whole buffer. Particles scatter, so this
+ * marks the full frame dirty whenever anything is live.
+ */
+de100_file_scoped_fn inline void
+de100_particles_draw(GameBackBuffer *buffer, const De100ParticlePool *pool,
+                     i32 size) {
+  if (buffer->is_rendering_disabled || pool->count == 0) {
+    return;
+  }
+  De100RenderClipRect clip = {0, 0, buffer->width, buffer->height};
+  de100_backbuffer_mark_dirty(buffer, 0, 0, buffer->width, buffer->height);
+  de100_particles_draw_clipped(buffer, clip, pool, size);
+}
+
+#endif // DE100_GAME_PARTICLES_H
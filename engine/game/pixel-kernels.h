@@ -0,0 +1,1317 @@
+#ifndef DE100_GAME_PIXEL_KERNELS_H
+#define DE100_GAME_PIXEL_KERNELS_H
+
+#include "../_common/base.h"
+#include "../_common/cpu.h"
+#include <math.h>
+#include <string.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ⚡ PIXEL ROW KERNELS (scalar / SSE2 / AVX2 / NEON)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// Span primitives used by the software rasterizer:
+//
+//   fill_row(dst, count, color)    dst[i] = color
+//   blend_row(dst, count, color)   dst[i] = lerp(dst[i], color, alpha)
+//   blend_premultiplied_row(dst, src, count)
+//                                  dst[i] = src[i] + dst[i] * (255 - a) / 255
+//   alpha_test_row(dst, src, count)
+//                                  dst[i] = src[i] where src alpha >= 128
+//   indexed_row(dst, src, count, palette)
+//                                  dst[i] = palette[src[i]] where src[i] != 0
+//   coverage_row(dst, coverage, count, color)
+//                                  blend_row with alpha * coverage[i] / 255
+//                                  where coverage[i] != 0 (glyph atlases)
+//   sample_nearest_row(dst, src, stride, u, v, du, dv, count)
+//   sample_bilinear_row(dst, src, stride, u, v, du, dv, count)
+//                                  dst[i] = src texel(s) at (u, v) + i (du, dv)
+//                                  (16.16 fixed point; affine sprite blits
+//                                  sample a row, then blit it)
+//
+// blend_linear_row / coverage_linear_row are the same blends in LINEAR
+// LIGHT: channels go through a 256-entry sRGB → 12-bit linear table, are
+// mixed, and come back through a 4096-entry linear → sRGB table. Gamma-
+// space mixing darkens every partial pixel (anti-aliased glyph edges look
+// thin, additive-looking glows look muddy); this doesn't. The tables are
+// built on first use. AVX2 gathers the lookups; SSE2/NEON have no gather
+// and use the scalar rows.
+//
+// Blend uses the EXACT integer formula of the scalar path
+//
+//   out = (src * a + dst * (255 - a)) / 255     (truncating)
+//
+// (and src + dst * (255 - a) / 255 for premultiplied sources, saturating)
+// so every variant is bit-identical. The SIMD divide relies on
+//
+//   x / 255 == (x + 1 + (x >> 8)) >> 8     for 0 <= x <= 65025
+//
+// which keeps everything in 16-bit lanes. Output alpha is forced to 255.
+//
+// Dispatch:
+//   De100PixelKernels *kernels = de100_pixel_kernels_get();
+//   kernels->blend_row(row + x0, x1 - x0, color);
+//
+// de100_pixel_kernels_get() returns the engine's table once bound with
+// DE100_KERNELS_BIND (see kernels.h); until then each translation unit
+// picks its own from de100_cpu_detect(). AVX-512 CPUs get the AVX2 rows:
+// spans are short and memory-bound, so wider vectors only add tail work.
+// Define DE100_PIXEL_KERNELS_FORCE_SCALAR to pin the reference path.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) ||            \
+    defined(_M_IX86)
+#define DE100_PIXEL_KERNELS_X86 1
+#include <immintrin.h>
+#elif defined(__ARM_NEON) || defined(__aarch64__)
+#define DE100_PIXEL_KERNELS_NEON 1
+#include <arm_neon.h>
+#endif
+
+typedef void de100_pixel_fill_row_t(u32 *dst, i32 count, u32 color);
+typedef void de100_pixel_blend_row_t(u32 *dst, i32 count, u32 color);
+typedef void de100_pixel_blit_row_t(u32 *dst, const u32 *src, i32 count);
+typedef void de100_pixel_indexed_row_t(u32 *dst, const u8 *src, i32 count,
+                                       const u32 *palette);
+typedef void de100_pixel_coverage_row_t(u32 *dst, const u8 *coverage,
+                                        i32 count, u32 color);
+// Every (u, v) visited must be inside the source: [0, w) x [0, h) texels
+// for nearest, [0, w - 1) x [0, h - 1) for bilinear (it reads u + 1, v + 1)
+typedef void de100_pixel_sample_row_t(u32 *dst, const u32 *src,
+                                      i32 src_stride, i32 u, i32 v, i32 du,
+                                      i32 dv, i32 count);
+
+typedef struct {
+  de100_pixel_fill_row_t *fill_row;
+  de100_pixel_blend_row_t *blend_row;
+  de100_pixel_blit_row_t *blend_premultiplied_row;
+  de100_pixel_blit_row_t *alpha_test_row;
+  de100_pixel_indexed_row_t *indexed_row;
+  de100_pixel_coverage_row_t *coverage_row;
+  de100_pixel_blend_row_t *blend_linear_row;
+  de100_pixel_coverage_row_t *coverage_linear_row;
+  de100_pixel_sample_row_t *sample_nearest_row;
+  de100_pixel_sample_row_t *sample_bilinear_row;
+  const char *name;
+  i32 pixels_per_iteration;
+} De100PixelKernels;
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Scalar reference
+// ─────────────────────────────────────────────────────────────────────────────
+
+de100_file_scoped_fn inline u32 de100_pixel_blend_scalar(u32 dst, u32 color) {
+  u32 alpha = (color >> 24) & 0xFF;
+  u32 inv_alpha = 255 - alpha;
+  u32 c0 = (((color >> 0) & 0xFF) * alpha + ((dst >> 0) & 0xFF) * inv_alpha) /
+           255;
+  u32 c1 = (((color >> 8) & 0xFF) * alpha + ((dst >> 8) & 0xFF) * inv_alpha) /
+           255;
+  u32 c2 =
+      (((color >> 16) & 0xFF) * alpha + ((dst >> 16) & 0xFF) * inv_alpha) /
+      255;
+  return 0xFF000000u | (c2 << 16) | (c1 << 8) | c0;
+}
+
+de100_file_scoped_fn inline u32
+de100_pixel_blend_premultiplied_scalar(u32 dst, u32 src) {
+  u32 inv_alpha = 255 - ((src >> 24) & 0xFF);
+  u32 result = 0xFF000000u;
+  for (u32 shift = 0; shift < 24; shift += 8) {
+    u32 c = ((src >> shift) & 0xFF) + ((dst >> shift) & 0xFF) * inv_alpha / 255;
+    result |= (c > 255 ? 255 : c) << shift;
+  }
+  return result;
+}
+
+de100_file_scoped_fn inline void
+de100_pixel_fill_row_scalar(u32 *dst, i32 count, u32 color) {
+  for (i32 i = 0; i < count; ++i) {
+    dst[i] = color;
+  }
+}
+
+de100_file_scoped_fn inline void
+de100_pixel_blend_row_scalar(u32 *dst, i32 count, u32 color) {
+  for (i32 i = 0; i < count; ++i) {
+    dst[i] = de100_pixel_blend_scalar(dst[i], color);
+  }
+}
+
+de100_file_scoped_fn inline void
+de100_pixel_blend_premultiplied_row_scalar(u32 *dst, const u32 *src,
+                                           i32 count) {
+  for (i32 i = 0; i < count; ++i) {
+    u32 alpha = src[i] >> 24;
+    if (alpha == 255) {
+      dst[i] = src[i];
+    } else if (alpha != 0) {
+      dst[i] = de100_pixel_blend_premultiplied_scalar(dst[i], src[i]);
+    }
+  }
+}
+
+de100_file_scoped_fn inline void
+de100_pixel_alpha_test_row_scalar(u32 *dst, const u32 *src, i32 count) {
+  for (i32 i = 0; i < count; ++i) {
+    if (src[i] & 0x80000000u) {
+      dst[i] = src[i] | 0xFF000000u;
+    }
+  }
+}
+
+// Index 0 is transparent. Paletted layers are mostly empty, so eight
+// indices are tested at once and all-zero groups skipped
+de100_file_scoped_fn inline void
+de100_pixel_indexed_row_scalar(u32 *dst, const u8 *src, i32 count,
+                               const u32 *palette) {
+  i32 i = 0;
+  for (; i + 8 <= count; i += 8) {
+    u64 group;
+    memcpy(&group, src + i, sizeof(group));
+    if (!group) {
+      continue;
+    }
+    for (i32 j = i; j < i + 8; ++j) {
+      if (src[j]) {
+        dst[j] = palette[src[j]];
+      }
+    }
+  }
+  for (; i < count; ++i) {
+    if (src[i]) {
+      dst[i] = palette[src[i]];
+    }
+  }
+}
+
+// alpha * coverage / 255, by the same exact shift trick the SIMD rows use
+de100_file_scoped_fn inline u32 de100_pixel_coverage_alpha(u32 alpha,
+                                                           u32 coverage) {
+  u32 x = alpha * coverage;
+  return (x + 1 + (x >> 8)) >> 8;
+}
+
+de100_file_scoped_fn inline u32 de100_pixel_coverage_scalar(u32 dst, u32 color,
+                                                       u32 coverage) {
+  u32 a = de100_pixel_coverage_alpha(color >> 24, coverage);
+  return de100_pixel_blend_scalar(dst, (color & 0x00FFFFFFu) | (a << 24));
+}
+
+// Coverage 0 leaves the pixel alone. Glyph rows are mostly empty, so
+// eight are tested at once and all-zero groups skipped
+de100_file_scoped_fn inline void
+de100_pixel_coverage_row_scalar(u32 *dst, const u8 *coverage, i32 count,
+                                u32 color) {
+  i32 i = 0;
+  for (; i + 8 <= count; i += 8) {
+    u64 group;
+    memcpy(&group, coverage + i, sizeof(group));
+    if (!group) {
+      continue;
+    }
+    for (i32 j = i; j < i + 8; ++j) {
+      if (coverage[j]) {
+        dst[j] = de100_pixel_coverage_scalar(dst[j], color, coverage[j]);
+      }
+    }
+  }
+  for (; i < count; ++i) {
+    if (coverage[i]) {
+      dst[i] = de100_pixel_coverage_scalar(dst[i], color, coverage[i]);
+    }
+  }
+}
+
+de100_file_scoped_fn inline void
+de100_pixel_sample_nearest_row_scalar(u32 *dst, const u32 *src,
+                                      i32 src_stride, i32 u, i32 v, i32 du,
+                                      i32 dv, i32 count) {
+  for (i32 i = 0; i < count; ++i) {
+    dst[i] = src[(size_t)(v >> 16) * (size_t)src_stride + (size_t)(u >> 16)];
+    u += du;
+    v += dv;
+  }
+}
+
+// Bilinear weights are 7-bit so every product fits a 16-bit SIMD lane;
+// rows are lerped first, each step rounded, in this exact order:
+//
+//   top = (p00 * (128 - fx) + p01 * fx + 64) >> 7     (bottom: p10, p11)
+//   out = (top * (128 - fy) + bottom * fy + 64) >> 7
+//
+// Premultiplied texels stay premultiplied (channel <= alpha survives).
+de100_file_scoped_fn inline u32 de100_pixel_bilinear_scalar(const u32 *src,
+                                                           i32 src_stride,
+                                                           i32 u, i32 v) {
+  const u32 *row0 =
+      src + (size_t)(v >> 16) * (size_t)src_stride + (size_t)(u >> 16);
+  const u32 *row1 = row0 + src_stride;
+  u32 fx = ((u32)u >> 9) & 127;
+  u32 fy = ((u32)v >> 9) & 127;
+  u32 result = 0;
+  for (u32 shift = 0; shift < 32; shift += 8) {
+    u32 top = (((row0[0] >> shift) & 0xFF) * (128 - fx) +
+               ((row0[1] >> shift) & 0xFF) * fx + 64) >>
+              7;
+    u32 bottom = (((row1[0] >> shift) & 0xFF) * (128 - fx) +
+                  ((row1[1] >> shift) & 0xFF) * fx + 64) >>
+                 7;
+    result |= ((top * (128 - fy) + bottom * fy + 64) >> 7) << shift;
+  }
+  return result;
+}
+
+de100_file_scoped_fn inline void
+de100_pixel_sample_bilinear_row_scalar(u32 *dst, const u32 *src,
+                                       i32 src_stride, i32 u, i32 v, i32 du,
+                                       i32 dv, i32 count) {
+  for (i32 i = 0; i < count; ++i) {
+    dst[i] = de100_pixel_bilinear_scalar(src, src_stride, u, v);
+    u += du;
+    v += dv;
+  }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Linear-light tables
+// ─────────────────────────────────────────────────────────────────────────────
+
+#define DE100_PIXEL_LINEAR_LEVELS 4096 // 12-bit linear light
+
+typedef struct {
+  u32 to_linear[256]; // sRGB byte → [0, 4095]; u32 so AVX2 can gather it
+  // [0, 4095] → sRGB byte; +4 because a 32-bit gather of the last entry
+  // reads three bytes past it
+  u8 to_srgb[DE100_PIXEL_LINEAR_LEVELS + 4];
+  u32 is_ready;
+} De100PixelGammaTables;
+
+/**
+ * The shared tables, built by whichever thread gets here first (racing
+ * builders write identical bytes; readers wait for the release store).
+ */
+de100_file_scoped_fn inline const De100PixelGammaTables *
+de100_pixel_gamma_tables(void) {
+  local_persist_var De100PixelGammaTables tables;
+  if (__atomic_load_n(&tables.is_ready, __ATOMIC_ACQUIRE)) {
+    return &tables;
+  }
+
+  for (u32 i = 0; i < 256; ++i) {
+    f32 c = (f32)i / 255.0f;
+    f32 linear = c <= 0.04045f ? c / 12.92f
+                               : powf((c + 0.055f) / 1.055f, 2.4f);
+    tables.to_linear[i] = (u32)lrintf(linear * 4095.0f);
+  }
+  for (u32 i = 0; i < DE100_PIXEL_LINEAR_LEVELS; ++i) {
+    f32 l = (f32)i / 4095.0f;
+    f32 c = l <= 0.0031308f ? l * 12.92f
+                            : 1.055f * powf(l, 1.0f / 2.4f) - 0.055f;
+    tables.to_srgb[i] = (u8)lrintf(c * 255.0f);
+  }
+  // Round trips exactly, so alpha 0 leaves a pixel as it was
+  for (u32 i = 0; i < 256; ++i) {
+    tables.to_srgb[tables.to_linear[i]] = (u8)i;
+  }
+  __atomic_store_n(&tables.is_ready, 1, __ATOMIC_RELEASE);
+  return &tables;
+}
+
+// x / 255 rounded; the SIMD rows use the same shifts in 32-bit lanes
+de100_file_scoped_fn inline u32 de100_pixel_div255_round(u32 x) {
+  x += 128;
+  return (x + (x >> 8)) >> 8;
+}
+
+de100_file_scoped_fn inline u32
+de100_pixel_blend_linear_scalar(const De100PixelGammaTables *tables, u32 dst,
+                                u32 color, u32 alpha) {
+  u32 inv_alpha = 255 - alpha;
+  u32 result = 0xFF000000u;
+  for (u32 shift = 0; shift < 24; shift += 8) {
+    u32 linear = de100_pixel_div255_round(
+        tables->to_linear[(color >> shift) & 0xFF] * alpha +
+        tables->to_linear[(dst >> shift) & 0xFF] * inv_alpha);
+    result |= (u32)tables->to_srgb[linear] << shift;
+  }
+  return result;
+}
+
+// With one color and alpha per row, each output channel depends only on
+// the destination's byte: blend_linear_row looks the whole pixel up in
+// three 256-entry tables built for that color. They are cached per thread
+// (rect rows, tiles and frames reuse a handful of colors); short rows of
+// a new color are blended directly instead of building tables. Callers
+// blending a tall, narrow shape can build them up front with
+// de100_pixel_linear_blend_table(color, true).
+#define DE100_PIXEL_LINEAR_TABLE_MIN_ROW 64
+
+typedef struct {
+  u32 color;
+  bool32 is_valid;
+  u8 channels[3][256]; // Destination byte → blended byte, per channel
+  u8 gather_slack[4];   // A 32-bit gather of the last entry reads past it
+} De100PixelLinearBlendTable;
+
+de100_file_scoped_fn inline const De100PixelLinearBlendTable *
+de100_pixel_linear_blend_table(u32 color, bool build) {
+  local_persist_var __thread De100PixelLinearBlendTable table;
+  if (table.is_valid && table.color == color) {
+    return &table;
+  }
+  if (!build) {
+    return NULL;
+  }
+
+  const De100PixelGammaTables *tables = de100_pixel_gamma_tables();
+  u32 alpha = color >> 24;
+  for (u32 ch = 0; ch < 3; ++ch) {
+    u32 src_term = tables->to_linear[(color >> (8 * ch)) & 0xFF] * alpha;
+    for (u32 d = 0; d < 256; ++d) {
+      u32 linear = de100_pixel_div255_round(
+          src_term + tables->to_linear[d] * (255 - alpha));
+      table.channels[ch][d] = tables->to_srgb[linear];
+    }
+  }
+  table.color = color;
+  table.is_valid = true;
+  return &table;
+}
+
+de100_file_scoped_fn inline void
+de100_pixel_blend_linear_row_scalar(u32 *dst, i32 count, u32 color) {
+  const De100PixelLinearBlendTable *table = de100_pixel_linear_blend_table(
+      color, count >= DE100_PIXEL_LINEAR_TABLE_MIN_ROW);
+  if (!table) {
+    const De100PixelGammaTables *tables = de100_pixel_gamma_tables();
+    for (i32 i = 0; i < count; ++i) {
+      dst[i] =
+          de100_pixel_blend_linear_scalar(tables, dst[i], color, color >> 24);
+    }
+    return;
+  }
+  for (i32 i = 0; i < count; ++i) {
+    u32 d = dst[i];
+    dst[i] = 0xFF000000u | (u32)table->channels[0][d & 0xFF] |
+             (u32)table->channels[1][(d >> 8) & 0xFF] << 8 |
+             (u32)table->channels[2][(d >> 16) & 0xFF] << 16;
+  }
+}
+
+// Coverage varies per pixel, so only the solid interior (coverage and
+// alpha both 255, which round-trips to `color` exactly) skips the tables
+de100_file_scoped_fn inline void
+de100_pixel_coverage_linear_row_scalar(u32 *dst, const u8 *coverage,
+                                       i32 count, u32 color) {
+  const De100PixelGammaTables *tables = de100_pixel_gamma_tables();
+  u32 alpha = color >> 24;
+  i32 i = 0;
+  for (; i + 8 <= count; i += 8) {
+    u64 group;
+    memcpy(&group, coverage + i, sizeof(group));
+    if (!group) {
+      continue;
+    }
+    for (i32 j = i; j < i + 8; ++j) {
+      if (coverage[j] == 255 && alpha == 255) {
+        dst[j] = color;
+      } else if (coverage[j]) {
+        dst[j] = de100_pixel_blend_linear_scalar(
+            tables, dst[j], color,
+            de100_pixel_coverage_alpha(alpha, coverage[j]));
+      }
+    }
+  }
+  for (; i < count; ++i) {
+    if (coverage[i] == 255 && alpha == 255) {
+      dst[i] = color;
+    } else if (coverage[i]) {
+      dst[i] = de100_pixel_blend_linear_scalar(
+          tables, dst[i], color, de100_pixel_coverage_alpha(alpha, coverage[i]));
+    }
+  }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// SSE2 (4 pixels / iteration) — baseline on every x86-64 CPU
+// ─────────────────────────────────────────────────────────────────────────────
+
+#if DE100_PIXEL_KERNELS_X86
+
+de100_file_scoped_fn inline void
+de100_pixel_fill_row_sse2(u32 *dst, i32 count, u32 color) {
+  __m128i value = _mm_set1_epi32((int)color);
+  i32 i = 0;
+  for (; i + 4 <= count; i += 4) {
+    _mm_storeu_si128((__m128i *)(dst + i), value);
+  }
+  for (; i < count; ++i) {
+    dst[i] = color;
+  }
+}
+
+de100_file_scoped_fn inline __m128i
+de100_pixel_blend_half_sse2(__m128i dst16, __m128i src_term, __m128i inv) {
+  __m128i t = _mm_add_epi16(src_term, _mm_mullo_epi16(dst16, inv));
+  t = _mm_add_epi16(t, _mm_add_epi16(_mm_set1_epi16(1), _mm_srli_epi16(t, 8)));
+  return _mm_srli_epi16(t, 8);
+}
+
+de100_file_scoped_fn inline void
+de100_pixel_blend_row_sse2(u32 *dst, i32 count, u32 color) {
+  u32 alpha = (color >> 24) & 0xFF;
+  __m128i zero = _mm_setzero_si128();
+  __m128i inv = _mm_set1_epi16((short)(255 - alpha));
+  __m128i alpha16 = _mm_set1_epi16((short)alpha);
+  __m128i src16 = _mm_unpacklo_epi8(_mm_set1_epi32((int)color), zero);
+  __m128i src_term = _mm_mullo_epi16(src16, alpha16);
+  __m128i opaque = _mm_set1_epi32((int)0xFF000000u);
+
+  i32 i = 0;
+  for (; i + 4 <= count; i += 4) {
+    __m128i d = _mm_loadu_si128((const __m128i *)(dst + i));
+    __m128i lo = de100_pixel_blend_half_sse2(_mm_unpacklo_epi8(d, zero),
+                                             src_term, inv);
+    __m128i hi = de100_pixel_blend_half_sse2(_mm_unpackhi_epi8(d, zero),
+                                             src_term, inv);
+    __m128i out = _mm_or_si128(_mm_packus_epi16(lo, hi), opaque);
+    _mm_storeu_si128((__m128i *)(dst + i), out);
+  }
+  for (; i < count; ++i) {
+    dst[i] = de100_pixel_blend_scalar(dst[i], color);
+  }
+}
+
+// Per-pixel alpha broadcast to that pixel's four 16-bit lanes
+de100_file_scoped_fn inline __m128i
+de100_pixel_premultiplied_half_sse2(__m128i src16, __m128i dst16) {
+  __m128i alpha = _mm_shufflehi_epi16(
+      _mm_shufflelo_epi16(src16, _MM_SHUFFLE(3, 3, 3, 3)),
+      _MM_SHUFFLE(3, 3, 3, 3));
+  __m128i inv = _mm_sub_epi16(_mm_set1_epi16(255), alpha);
+  __m128i t = _mm_mullo_epi16(dst16, inv);
+  t = _mm_add_epi16(t, _mm_add_epi16(_mm_set1_epi16(1), _mm_srli_epi16(t, 8)));
+  return _mm_add_epi16(src16, _mm_srli_epi16(t, 8));
+}
+
+de100_file_scoped_fn inline void
+de100_pixel_blend_premultiplied_row_sse2(u32 *dst, const u32 *src,
+                                         i32 count) {
+  __m128i zero = _mm_setzero_si128();
+  __m128i alpha_mask = _mm_set1_epi32((int)0xFF000000u);
+
+  i32 i = 0;
+  for (; i + 4 <= count; i += 4) {
+    __m128i s = _mm_loadu_si128((const __m128i *)(src + i));
+    __m128i alpha = _mm_and_si128(s, alpha_mask);
+    i32 transparent = _mm_movemask_epi8(_mm_cmpeq_epi32(alpha, zero));
+    if (transparent == 0xFFFF) {
+      continue; // Early-out: nothing to draw in these 4
+    }
+    if (_mm_movemask_epi8(_mm_cmpeq_epi32(alpha, alpha_mask)) == 0xFFFF) {
+      _mm_storeu_si128((__m128i *)(dst + i), s);
+      continue;
+    }
+    __m128i d = _mm_loadu_si128((const __m128i *)(dst + i));
+    __m128i lo = de100_pixel_premultiplied_half_sse2(
+        _mm_unpacklo_epi8(s, zero), _mm_unpacklo_epi8(d, zero));
+    __m128i hi = de100_pixel_premultiplied_half_sse2(
+        _mm_unpackhi_epi8(s, zero), _mm_unpackhi_epi8(d, zero));
+    __m128i out = _mm_or_si128(_mm_packus_epi16(lo, hi), alpha_mask);
+    // Leave fully transparent pixels untouched, like the scalar path
+    __m128i keep = _mm_cmpeq_epi32(alpha, zero);
+    out = _mm_or_si128(_mm_and_si128(keep, d), _mm_andnot_si128(keep, out));
+    _mm_storeu_si128((__m128i *)(dst + i), out);
+  }
+  de100_pixel_blend_premultiplied_row_scalar(dst + i, src + i, count - i);
+}
+
+// Alpha >= 128 is exactly the sign bit, so the mask is one shift
+de100_file_scoped_fn inline void
+de100_pixel_alpha_test_row_sse2(u32 *dst, const u32 *src, i32 count) {
+  __m128i opaque = _mm_set1_epi32((int)0xFF000000u);
+  i32 i = 0;
+  for (; i + 4 <= count; i += 4) {
+    __m128i s = _mm_loadu_si128((const __m128i *)(src + i));
+    __m128i mask = _mm_srai_epi32(s, 31);
+    __m128i d = _mm_loadu_si128((const __m128i *)(dst + i));
+    __m128i out = _mm_or_si128(_mm_and_si128(mask, _mm_or_si128(s, opaque)),
+                               _mm_andnot_si128(mask, d));
+    _mm_storeu_si128((__m128i *)(dst + i), out);
+  }
+  de100_pixel_alpha_test_row_scalar(dst + i, src + i, count - i);
+}
+
+// No gather before AVX2: 16 indices are tested per compare, empty groups
+// skipped, and only the set ones looked up
+de100_file_scoped_fn inline void
+de100_pixel_indexed_row_sse2(u32 *dst, const u8 *src, i32 count,
+                             const u32 *palette) {
+  __m128i zero = _mm_setzero_si128();
+  i32 i = 0;
+  for (; i + 16 <= count; i += 16) {
+    __m128i s = _mm_loadu_si128((const __m128i *)(src + i));
+    u32 set = ~(u32)_mm_movemask_epi8(_mm_cmpeq_epi8(s, zero)) & 0xFFFF;
+    while (set) {
+      i32 j = i + __builtin_ctz(set);
+      dst[j] = palette[src[j]];
+      set &= set - 1;
+    }
+  }
+  de100_pixel_indexed_row_scalar(dst + i, src + i, count - i, palette);
+}
+
+// x / 255 per 16-bit lane, exact for x <= 65025
+de100_file_scoped_fn inline __m128i de100_pixel_div255_sse2(__m128i x) {
+  x = _mm_add_epi16(x, _mm_add_epi16(_mm_set1_epi16(1), _mm_srli_epi16(x, 8)));
+  return _mm_srli_epi16(x, 8);
+}
+
+// Per-pixel alpha (one per 32-bit lane, < 256) copied into both halves,
+// so 32-bit unpacks spread it over that pixel's four channels
+de100_file_scoped_fn inline void
+de100_pixel_coverage_row_sse2(u32 *dst, const u8 *coverage, i32 count,
+                              u32 color) {
+  u32 alpha = color >> 24;
+  __m128i zero = _mm_setzero_si128();
+  __m128i alpha16 = _mm_set1_epi16((short)alpha);
+  __m128i c255 = _mm_set1_epi16(255);
+  __m128i src16 = _mm_unpacklo_epi8(_mm_set1_epi32((int)color), zero);
+  __m128i opaque = _mm_set1_epi32((int)0xFF000000u);
+  __m128i solid = _mm_set1_epi32((int)(color | 0xFF000000u));
+
+  i32 i = 0;
+  for (; i + 4 <= count; i += 4) {
+    u32 group;
+    memcpy(&group, coverage + i, sizeof(group));
+    if (!group) {
+      continue;
+    }
+    if (group == 0xFFFFFFFFu && alpha == 255) {
+      _mm_storeu_si128((__m128i *)(dst + i), solid);
+      continue;
+    }
+    __m128i c32 = _mm_unpacklo_epi16(
+        _mm_unpacklo_epi8(_mm_cvtsi32_si128((int)group), zero), zero);
+    __m128i a32 = de100_pixel_div255_sse2(_mm_mullo_epi16(c32, alpha16));
+    __m128i a16 = _mm_or_si128(a32, _mm_slli_epi32(a32, 16));
+    __m128i a_lo = _mm_unpacklo_epi32(a16, a16);
+    __m128i a_hi = _mm_unpackhi_epi32(a16, a16);
+
+    __m128i d = _mm_loadu_si128((const __m128i *)(dst + i));
+    __m128i lo = de100_pixel_div255_sse2(_mm_add_epi16(
+        _mm_mullo_epi16(src16, a_lo),
+        _mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), _mm_sub_epi16(c255, a_lo))));
+    __m128i hi = de100_pixel_div255_sse2(_mm_add_epi16(
+        _mm_mullo_epi16(src16, a_hi),
+        _mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), _mm_sub_epi16(c255, a_hi))));
+    __m128i out = _mm_or_si128(_mm_packus_epi16(lo, hi), opaque);
+    __m128i keep = _mm_cmpeq_epi32(c32, zero);
+    out = _mm_or_si128(_mm_and_si128(keep, d), _mm_andnot_si128(keep, out));
+    _mm_storeu_si128((__m128i *)(dst + i), out);
+  }
+  de100_pixel_coverage_row_scalar(dst + i, coverage + i, count - i, color);
+}
+
+// One texel at a time (no gather before AVX2), but a texel's two taps per
+// row are one 64-bit load, and both rows share one multiply per step:
+//   [top p00 | top p01] * [128 - fx | fx]  → sum halves → [top | bottom]
+de100_file_scoped_fn inline void
+de100_pixel_sample_bilinear_row_sse2(u32 *dst, const u32 *src,
+                                     i32 src_stride, i32 u, i32 v, i32 du,
+                                     i32 dv, i32 count) {
+  __m128i zero = _mm_setzero_si128();
+  __m128i round = _mm_set1_epi16(64);
+  for (i32 i = 0; i < count; ++i) {
+    const u32 *row0 =
+        src + (size_t)(v >> 16) * (size_t)src_stride + (size_t)(u >> 16);
+    short fx = (short)((u >> 9) & 127);
+    short fy = (short)((v >> 9) & 127);
+    short ix = (short)(128 - fx);
+    short iy = (short)(128 - fy);
+    __m128i wx = _mm_setr_epi16(ix, ix, ix, ix, fx, fx, fx, fx);
+    __m128i wy = _mm_setr_epi16(iy, iy, iy, iy, fy, fy, fy, fy);
+
+    __m128i top = _mm_mullo_epi16(
+        _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)row0), zero), wx);
+    __m128i bottom = _mm_mullo_epi16(
+        _mm_unpacklo_epi8(
+            _mm_loadl_epi64((const __m128i *)(row0 + src_stride)), zero),
+        wx);
+    __m128i rows = _mm_add_epi16(_mm_unpacklo_epi64(top, bottom),
+                                 _mm_unpackhi_epi64(top, bottom));
+    rows = _mm_srli_epi16(_mm_add_epi16(rows, round), 7);
+    __m128i out = _mm_mullo_epi16(rows, wy);
+    out = _mm_add_epi16(out, _mm_srli_si128(out, 8));
+    out = _mm_srli_epi16(_mm_add_epi16(out, round), 7);
+    dst[i] = (u32)_mm_cvtsi128_si32(_mm_packus_epi16(out, out));
+    u += du;
+    v += dv;
+  }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// AVX2 (8 pixels / iteration)
+// ─────────────────────────────────────────────────────────────────────────────
+
+DE100_TARGET_AVX2 de100_file_scoped_fn inline void
+de100_pixel_fill_row_avx2(u32 *dst, i32 count, u32 color) {
+  __m256i value = _mm256_set1_epi32((int)color);
+  i32 i = 0;
+  for (; i + 8 <= count; i += 8) {
+    _mm256_storeu_si256((__m256i *)(dst + i), value);
+  }
+  for (; i < count; ++i) {
+    dst[i] = color;
+  }
+}
+
+DE100_TARGET_AVX2 de100_file_scoped_fn inline __m256i
+de100_pixel_blend_half_avx2(__m256i dst16, __m256i src_term, __m256i inv) {
+  __m256i t = _mm256_add_epi16(src_term, _mm256_mullo_epi16(dst16, inv));
+  t = _mm256_add_epi16(
+      t, _mm256_add_epi16(_mm256_set1_epi16(1), _mm256_srli_epi16(t, 8)));
+  return _mm256_srli_epi16(t, 8);
+}
+
+DE100_TARGET_AVX2 de100_file_scoped_fn inline void
+de100_pixel_blend_row_avx2(u32 *dst, i32 count, u32 color) {
+  u32 alpha = (color >> 24) & 0xFF;
+  __m256i zero = _mm256_setzero_si256();
+  __m256i inv = _mm256_set1_epi16((short)(255 - alpha));
+  __m256i alpha16 = _mm256_set1_epi16((short)alpha);
+  // unpack works per 128-bit lane, but every pixel is the same color
+  __m256i src16 = _mm256_unpacklo_epi8(_mm256_set1_epi32((int)color), zero);
+  __m256i src_term = _mm256_mullo_epi16(src16, alpha16);
+  __m256i opaque = _mm256_set1_epi32((int)0xFF000000u);
+
+  i32 i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m256i d = _mm256_loadu_si256((const __m256i *)(dst + i));
+    // unpacklo/hi + packus are both lane-local, so pixel order is preserved
+    __m256i lo = de100_pixel_blend_half_avx2(_mm256_unpacklo_epi8(d, zero),
+                                             src_term, inv);
+    __m256i hi = de100_pixel_blend_half_avx2(_mm256_unpackhi_epi8(d, zero),
+                                             src_term, inv);
+    __m256i out = _mm256_or_si256(_mm256_packus_epi16(lo, hi), opaque);
+    _mm256_storeu_si256((__m256i *)(dst + i), out);
+  }
+  for (; i < count; ++i) {
+    dst[i] = de100_pixel_blend_scalar(dst[i], color);
+  }
+}
+
+DE100_TARGET_AVX2 de100_file_scoped_fn inline __m256i
+de100_pixel_premultiplied_half_avx2(__m256i src16, __m256i dst16) {
+  __m256i alpha = _mm256_shufflehi_epi16(
+      _mm256_shufflelo_epi16(src16, _MM_SHUFFLE(3, 3, 3, 3)),
+      _MM_SHUFFLE(3, 3, 3, 3));
+  __m256i inv = _mm256_sub_epi16(_mm256_set1_epi16(255), alpha);
+  __m256i t = _mm256_mullo_epi16(dst16, inv);
+  t = _mm256_add_epi16(
+      t, _mm256_add_epi16(_mm256_set1_epi16(1), _mm256_srli_epi16(t, 8)));
+  return _mm256_add_epi16(src16, _mm256_srli_epi16(t, 8));
+}
+
+DE100_TARGET_AVX2 de100_file_scoped_fn inline void
+de100_pixel_blend_premultiplied_row_avx2(u32 *dst, const u32 *src,
+                                         i32 count) {
+  __m256i zero = _mm256_setzero_si256();
+  __m256i alpha_mask = _mm256_set1_epi32((int)0xFF000000u);
+
+  i32 i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m256i s = _mm256_loadu_si256((const __m256i *)(src + i));
+    __m256i alpha = _mm256_and_si256(s, alpha_mask);
+    if (_mm256_testz_si256(alpha, alpha_mask)) {
+      continue;
+    }
+    if ((u32)_mm256_movemask_epi8(_mm256_cmpeq_epi32(alpha, alpha_mask)) ==
+        0xFFFFFFFFu) {
+      _mm256_storeu_si256((__m256i *)(dst + i), s);
+      continue;
+    }
+    __m256i d = _mm256_loadu_si256((const __m256i *)(dst + i));
+    __m256i lo = de100_pixel_premultiplied_half_avx2(
+        _mm256_unpacklo_epi8(s, zero), _mm256_unpacklo_epi8(d, zero));
+    __m256i hi = de100_pixel_premultiplied_half_avx2(
+        _mm256_unpackhi_epi8(s, zero), _mm256_unpackhi_epi8(d, zero));
+    __m256i out = _mm256_or_si256(_mm256_packus_epi16(lo, hi), alpha_mask);
+    out = _mm256_blendv_epi8(out, d, _mm256_cmpeq_epi32(alpha, zero));
+    _mm256_storeu_si256((__m256i *)(dst + i), out);
+  }
+  de100_pixel_blend_premultiplied_row_scalar(dst + i, src + i, count - i);
+}
+
+DE100_TARGET_AVX2 de100_file_scoped_fn inline void
+de100_pixel_alpha_test_row_avx2(u32 *dst, const u32 *src, i32 count) {
+  __m256i opaque = _mm256_set1_epi32((int)0xFF000000u);
+  i32 i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m256i s = _mm256_loadu_si256((const __m256i *)(src + i));
+    __m256i d = _mm256_loadu_si256((const __m256i *)(dst + i));
+    __m256i out = _mm256_blendv_epi8(d, _mm256_or_si256(s, opaque),
+                                     _mm256_srai_epi32(s, 31));
+    _mm256_storeu_si256((__m256i *)(dst + i), out);
+  }
+  de100_pixel_alpha_test_row_scalar(dst + i, src + i, count - i);
+}
+
+// 16 indices per step: skipped when all zero, else widened to 32-bit and
+// looked up with two 8-lane gathers; index 0 keeps the destination
+DE100_TARGET_AVX2 de100_file_scoped_fn inline void
+de100_pixel_indexed_row_avx2(u32 *dst, const u8 *src, i32 count,
+                             const u32 *palette) {
+  __m128i zero8 = _mm_setzero_si128();
+  __m256i zero = _mm256_setzero_si256();
+  i32 i = 0;
+  for (; i + 16 <= count; i += 16) {
+    __m128i s = _mm_loadu_si128((const __m128i *)(src + i));
+    u32 empty = (u32)_mm_movemask_epi8(_mm_cmpeq_epi8(s, zero8));
+    if (empty == 0xFFFF) {
+      continue;
+    }
+    for (i32 half = 0; half < 2; ++half) {
+      __m256i index = _mm256_cvtepu8_epi32(
+          half ? _mm_unpackhi_epi64(s, s) : s);
+      __m256i color =
+          _mm256_i32gather_epi32((const int *)palette, index, 4);
+      u32 *out = dst + i + half * 8;
+      if (((empty >> (half * 8)) & 0xFF) != 0) {
+        __m256i d = _mm256_loadu_si256((const __m256i *)out);
+        color = _mm256_blendv_epi8(color, d, _mm256_cmpeq_epi32(index, zero));
+      }
+      _mm256_storeu_si256((__m256i *)out, color);
+    }
+  }
+  de100_pixel_indexed_row_scalar(dst + i, src + i, count - i, palette);
+}
+
+DE100_TARGET_AVX2 de100_file_scoped_fn inline __m256i
+de100_pixel_div255_avx2(__m256i x) {
+  x = _mm256_add_epi16(
+      x, _mm256_add_epi16(_mm256_set1_epi16(1), _mm256_srli_epi16(x, 8)));
+  return _mm256_srli_epi16(x, 8);
+}
+
+// As the SSE2 row; the 32-bit unpacks are lane-local exactly like the
+// 8-bit ones, so each pixel's alpha lines up with its channels
+DE100_TARGET_AVX2 de100_file_scoped_fn inline void
+de100_pixel_coverage_row_avx2(u32 *dst, const u8 *coverage, i32 count,
+                              u32 color) {
+  u32 alpha = color >> 24;
+  __m256i zero = _mm256_setzero_si256();
+  __m256i alpha16 = _mm256_set1_epi16((short)alpha);
+  __m256i c255 = _mm256_set1_epi16(255);
+  __m256i src16 = _mm256_unpacklo_epi8(_mm256_set1_epi32((int)color), zero);
+  __m256i opaque = _mm256_set1_epi32((int)0xFF000000u);
+  __m256i solid = _mm256_set1_epi32((int)(color | 0xFF000000u));
+
+  i32 i = 0;
+  for (; i + 8 <= count; i += 8) {
+    u64 group;
+    memcpy(&group, coverage + i, sizeof(group));
+    if (!group) {
+      continue;
+    }
+    if (group == ~0ull && alpha == 255) {
+      _mm256_storeu_si256((__m256i *)(dst + i), solid);
+      continue;
+    }
+    __m256i c32 = _mm256_cvtepu8_epi32(_mm_cvtsi64_si128((long long)group));
+    __m256i a32 = de100_pixel_div255_avx2(_mm256_mullo_epi16(c32, alpha16));
+    __m256i a16 = _mm256_or_si256(a32, _mm256_slli_epi32(a32, 16));
+    __m256i a_lo = _mm256_unpacklo_epi32(a16, a16);
+    __m256i a_hi = _mm256_unpackhi_epi32(a16, a16);
+
+    __m256i d = _mm256_loadu_si256((const __m256i *)(dst + i));
+    __m256i lo = de100_pixel_div255_avx2(_mm256_add_epi16(
+        _mm256_mullo_epi16(src16, a_lo),
+        _mm256_mullo_epi16(_mm256_unpacklo_epi8(d, zero),
+                           _mm256_sub_epi16(c255, a_lo))));
+    __m256i hi = de100_pixel_div255_avx2(_mm256_add_epi16(
+        _mm256_mullo_epi16(src16, a_hi),
+        _mm256_mullo_epi16(_mm256_unpackhi_epi8(d, zero),
+                           _mm256_sub_epi16(c255, a_hi))));
+    __m256i out = _mm256_or_si256(_mm256_packus_epi16(lo, hi), opaque);
+    out = _mm256_blendv_epi8(out, d, _mm256_cmpeq_epi32(c32, zero));
+    _mm256_storeu_si256((__m256i *)(dst + i), out);
+  }
+  de100_pixel_coverage_row_scalar(dst + i, coverage + i, count - i, color);
+}
+
+// One channel of 8 pixels in linear light: gather dst's linear values,
+// mix, gather the sRGB bytes back (byte-addressed, low byte kept)
+DE100_TARGET_AVX2 de100_file_scoped_fn inline __m256i
+de100_pixel_linear_channel_avx2(const De100PixelGammaTables *tables,
+                                __m256i dst8, __m256i src_term,
+                                __m256i inv_alpha) {
+  __m256i d = _mm256_i32gather_epi32((const int *)tables->to_linear, dst8, 4);
+  __m256i x = _mm256_add_epi32(
+      _mm256_add_epi32(src_term, _mm256_mullo_epi32(d, inv_alpha)),
+      _mm256_set1_epi32(128));
+  __m256i linear =
+      _mm256_srli_epi32(_mm256_add_epi32(x, _mm256_srli_epi32(x, 8)), 8);
+  __m256i srgb =
+      _mm256_i32gather_epi32((const int *)tables->to_srgb, linear, 1);
+  return _mm256_and_si256(srgb, _mm256_set1_epi32(0xFF));
+}
+
+DE100_TARGET_AVX2 de100_file_scoped_fn inline __m256i
+de100_pixel_blend_linear_avx2(const De100PixelGammaTables *tables, __m256i d,
+                              const __m256i src_linear[3], __m256i alpha) {
+  __m256i byte = _mm256_set1_epi32(0xFF);
+  __m256i inv = _mm256_sub_epi32(byte, alpha);
+  __m256i out = _mm256_set1_epi32((int)0xFF000000u);
+  for (int ch = 0; ch < 3; ++ch) {
+    __m256i dst8 = _mm256_and_si256(
+        _mm256_srlv_epi32(d, _mm256_set1_epi32(8 * ch)), byte);
+    __m256i c = de100_pixel_linear_channel_avx2(
+        tables, dst8, _mm256_mullo_epi32(src_linear[ch], alpha), inv);
+    out = _mm256_or_si256(out,
+                          _mm256_sllv_epi32(c, _mm256_set1_epi32(8 * ch)));
+  }
+  return out;
+}
+
+// The per-color tables again: three byte gathers per 8 pixels
+DE100_TARGET_AVX2 de100_file_scoped_fn inline void
+de100_pixel_blend_linear_row_avx2(u32 *dst, i32 count, u32 color) {
+  const De100PixelLinearBlendTable *table = de100_pixel_linear_blend_table(
+      color, count >= DE100_PIXEL_LINEAR_TABLE_MIN_ROW);
+  if (!table) {
+    de100_pixel_blend_linear_row_scalar(dst, count, color);
+    return;
+  }
+
+  __m256i byte = _mm256_set1_epi32(0xFF);
+  __m256i opaque = _mm256_set1_epi32((int)0xFF000000u);
+  i32 i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m256i d = _mm256_loadu_si256((const __m256i *)(dst + i));
+    __m256i c0 = _mm256_i32gather_epi32((const int *)table->channels[0],
+                                        _mm256_and_si256(d, byte), 1);
+    __m256i c1 = _mm256_i32gather_epi32(
+        (const int *)table->channels[1],
+        _mm256_and_si256(_mm256_srli_epi32(d, 8), byte), 1);
+    __m256i c2 = _mm256_i32gather_epi32(
+        (const int *)table->channels[2],
+        _mm256_and_si256(_mm256_srli_epi32(d, 16), byte), 1);
+    __m256i out = _mm256_or_si256(
+        _mm256_or_si256(_mm256_and_si256(c0, byte),
+                        _mm256_slli_epi32(_mm256_and_si256(c1, byte), 8)),
+        _mm256_or_si256(_mm256_slli_epi32(_mm256_and_si256(c2, byte), 16),
+                        opaque));
+    _mm256_storeu_si256((__m256i *)(dst + i), out);
+  }
+  de100_pixel_blend_linear_row_scalar(dst + i, count - i, color);
+}
+
+DE100_TARGET_AVX2 de100_file_scoped_fn inline void
+de100_pixel_coverage_linear_row_avx2(u32 *dst, const u8 *coverage, i32 count,
+                                     u32 color) {
+  const De100PixelGammaTables *tables = de100_pixel_gamma_tables();
+  u32 alpha = color >> 24;
+  __m256i alpha32 = _mm256_set1_epi32((int)alpha);
+  __m256i zero = _mm256_setzero_si256();
+  __m256i solid = _mm256_set1_epi32((int)(color | 0xFF000000u));
+  __m256i src_linear[3];
+  for (int ch = 0; ch < 3; ++ch) {
+    src_linear[ch] =
+        _mm256_set1_epi32((int)tables->to_linear[(color >> (8 * ch)) & 0xFF]);
+  }
+
+  i32 i = 0;
+  for (; i + 8 <= count; i += 8) {
+    u64 group;
+    memcpy(&group, coverage + i, sizeof(group));
+    if (!group) {
+      continue;
+    }
+    if (group == ~0ull && alpha == 255) {
+      _mm256_storeu_si256((__m256i *)(dst + i), solid);
+      continue;
+    }
+    __m256i c32 = _mm256_cvtepu8_epi32(_mm_cvtsi64_si128((long long)group));
+    __m256i x = _mm256_mullo_epi32(c32, alpha32);
+    __m256i a = _mm256_srli_epi32(
+        _mm256_add_epi32(_mm256_add_epi32(x, _mm256_set1_epi32(1)),
+                         _mm256_srli_epi32(x, 8)),
+        8);
+    __m256i d = _mm256_loadu_si256((const __m256i *)(dst + i));
+    __m256i out = de100_pixel_blend_linear_avx2(tables, d, src_linear, a);
+    out = _mm256_blendv_epi8(out, d, _mm256_cmpeq_epi32(c32, zero));
+    _mm256_storeu_si256((__m256i *)(dst + i), out);
+  }
+  de100_pixel_coverage_linear_row_scalar(dst + i, coverage + i, count - i,
+                                         color);
+}
+
+// (u, v) for 8 pixels at once: each step adds 8 (du, dv), and the texel
+// offsets become gather indices
+DE100_TARGET_AVX2 de100_file_scoped_fn inline void
+de100_pixel_sample_nearest_row_avx2(u32 *dst, const u32 *src, i32 src_stride,
+                                    i32 u, i32 v, i32 du, i32 dv, i32 count) {
+  __m256i lane = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+  __m256i uu = _mm256_add_epi32(_mm256_set1_epi32(u),
+                                _mm256_mullo_epi32(lane, _mm256_set1_epi32(du)));
+  __m256i vv = _mm256_add_epi32(_mm256_set1_epi32(v),
+                                _mm256_mullo_epi32(lane, _mm256_set1_epi32(dv)));
+  __m256i step_u = _mm256_set1_epi32(8 * du);
+  __m256i step_v = _mm256_set1_epi32(8 * dv);
+  __m256i stride = _mm256_set1_epi32(src_stride);
+
+  i32 i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m256i index =
+        _mm256_add_epi32(_mm256_mullo_epi32(_mm256_srai_epi32(vv, 16), stride),
+                         _mm256_srai_epi32(uu, 16));
+    _mm256_storeu_si256((__m256i *)(dst + i),
+                        _mm256_i32gather_epi32((const int *)src, index, 4));
+    uu = _mm256_add_epi32(uu, step_u);
+    vv = _mm256_add_epi32(vv, step_v);
+  }
+  de100_pixel_sample_nearest_row_scalar(dst + i, src, src_stride, u + i * du,
+                                        v + i * dv, du, dv, count - i);
+}
+
+// Four gathers (the 2x2 taps) per 8 pixels. Weights are per pixel, so
+// they are spread over that pixel's channels like the coverage row's alpha
+DE100_TARGET_AVX2 de100_file_scoped_fn inline __m256i
+de100_pixel_lerp7_avx2(__m256i a16, __m256i b16, __m256i w16) {
+  __m256i t = _mm256_add_epi16(
+      _mm256_mullo_epi16(a16, _mm256_sub_epi16(_mm256_set1_epi16(128), w16)),
+      _mm256_mullo_epi16(b16, w16));
+  return _mm256_srli_epi16(_mm256_add_epi16(t, _mm256_set1_epi16(64)), 7);
+}
+
+DE100_TARGET_AVX2 de100_file_scoped_fn inline void
+de100_pixel_sample_bilinear_row_avx2(u32 *dst, const u32 *src,
+                                     i32 src_stride, i32 u, i32 v, i32 du,
+                                     i32 dv, i32 count) {
+  __m256i lane = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+  __m256i uu = _mm256_add_epi32(_mm256_set1_epi32(u),
+                                _mm256_mullo_epi32(lane, _mm256_set1_epi32(du)));
+  __m256i vv = _mm256_add_epi32(_mm256_set1_epi32(v),
+                                _mm256_mullo_epi32(lane, _mm256_set1_epi32(dv)));
+  __m256i step_u = _mm256_set1_epi32(8 * du);
+  __m256i step_v = _mm256_set1_epi32(8 * dv);
+  __m256i stride = _mm256_set1_epi32(src_stride);
+  __m256i frac_mask = _mm256_set1_epi32(127);
+  __m256i zero = _mm256_setzero_si256();
+  const int *row0 = (const int *)src;
+  const int *row1 = (const int *)(src + src_stride);
+
+  i32 i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m256i index =
+        _mm256_add_epi32(_mm256_mullo_epi32(_mm256_srai_epi32(vv, 16), stride),
+                         _mm256_srai_epi32(uu, 16));
+    __m256i p00 = _mm256_i32gather_epi32(row0, index, 4);
+    __m256i p01 = _mm256_i32gather_epi32(row0 + 1, index, 4);
+    __m256i p10 = _mm256_i32gather_epi32(row1, index, 4);
+    __m256i p11 = _mm256_i32gather_epi32(row1 + 1, index, 4);
+
+    __m256i fx = _mm256_and_si256(_mm256_srli_epi32(uu, 9), frac_mask);
+    __m256i fy = _mm256_and_si256(_mm256_srli_epi32(vv, 9), frac_mask);
+    fx = _mm256_or_si256(fx, _mm256_slli_epi32(fx, 16));
+    fy = _mm256_or_si256(fy, _mm256_slli_epi32(fy, 16));
+    __m256i fx_lo = _mm256_unpacklo_epi32(fx, fx);
+    __m256i fx_hi = _mm256_unpackhi_epi32(fx, fx);
+    __m256i fy_lo = _mm256_unpacklo_epi32(fy, fy);
+    __m256i fy_hi = _mm256_unpackhi_epi32(fy, fy);
+
+    __m256i top_lo = de100_pixel_lerp7_avx2(_mm256_unpacklo_epi8(p00, zero),
+                                            _mm256_unpacklo_epi8(p01, zero),
+                                            fx_lo);
+    __m256i top_hi = de100_pixel_lerp7_avx2(_mm256_unpackhi_epi8(p00, zero),
+                                            _mm256_unpackhi_epi8(p01, zero),
+                                            fx_hi);
+    __m256i bottom_lo = de100_pixel_lerp7_avx2(
+        _mm256_unpacklo_epi8(p10, zero), _mm256_unpacklo_epi8(p11, zero),
+        fx_lo);
+    __m256i bottom_hi = de100_pixel_lerp7_avx2(
+        _mm256_unpackhi_epi8(p10, zero), _mm256_unpackhi_epi8(p11, zero),
+        fx_hi);
+    __m256i lo = de100_pixel_lerp7_avx2(top_lo, bottom_lo, fy_lo);
+    __m256i hi = de100_pixel_lerp7_avx2(top_hi, bottom_hi, fy_hi);
+    _mm256_storeu_si256((__m256i *)(dst + i), _mm256_packus_epi16(lo, hi));
+    uu = _mm256_add_epi32(uu, step_u);
+    vv = _mm256_add_epi32(vv, step_v);
+  }
+  de100_pixel_sample_bilinear_row_scalar(dst + i, src, src_stride, u + i * du,
+                                         v + i * dv, du, dv, count - i);
+}
+
+#endif // DE100_PIXEL_KERNELS_X86
+
+// ─────────────────────────────────────────────────────────────────────────────
+// NEON (4 pixels / iteration)
+// ─────────────────────────────────────────────────────────────────────────────
+
+#if DE100_PIXEL_KERNELS_NEON
+
+de100_file_scoped_fn inline void
+de100_pixel_fill_row_neon(u32 *dst, i32 count, u32 color) {
+  uint32x4_t value = vdupq_n_u32(color);
+  i32 i = 0;
+  for (; i + 4 <= count; i += 4) {
+    vst1q_u32(dst + i, value);
+  }
+  for (; i < count; ++i) {
+    dst[i] = color;
+  }
+}
+
+de100_file_scoped_fn inline uint16x8_t
+de100_pixel_blend_half_neon(uint8x8_t dst8, uint16x8_t src_term,
+                            uint8x8_t inv) {
+  uint16x8_t t = vmlal_u8(src_term, dst8, inv);
+  t = vaddq_u16(t, vaddq_u16(vdupq_n_u16(1), vshrq_n_u16(t, 8)));
+  return vshrq_n_u16(t, 8);
+}
+
+de100_file_scoped_fn inline void
+de100_pixel_blend_row_neon(u32 *dst, i32 count, u32 color) {
+  u32 alpha = (color >> 24) & 0xFF;
+  uint8x8_t inv = vdup_n_u8((u8)(255 - alpha));
+  uint8x8_t src8 = vreinterpret_u8_u32(vdup_n_u32(color));
+  uint16x8_t src_term = vmull_u8(src8, vdup_n_u8((u8)alpha));
+  uint32x4_t opaque = vdupq_n_u32(0xFF000000u);
+
+  i32 i = 0;
+  for (; i + 4 <= count; i += 4) {
+    uint8x16_t d = vreinterpretq_u8_u32(vld1q_u32(dst + i));
+    uint16x8_t lo = de100_pixel_blend_half_neon(vget_low_u8(d), src_term, inv);
+    uint16x8_t hi =
+        de100_pixel_blend_half_neon(vget_high_u8(d), src_term, inv);
+    uint8x16_t packed = vcombine_u8(vmovn_u16(lo), vmovn_u16(hi));
+    vst1q_u32(dst + i, vorrq_u32(vreinterpretq_u32_u8(packed), opaque));
+  }
+  for (; i < count; ++i) {
+    dst[i] = de100_pixel_blend_scalar(dst[i], color);
+  }
+}
+
+// vld4 de-interleaves, so each channel is a plain 8-lane vector
+de100_file_scoped_fn inline void
+de100_pixel_blend_premultiplied_row_neon(u32 *dst, const u32 *src,
+                                         i32 count) {
+  i32 i = 0;
+  for (; i + 8 <= count; i += 8) {
+    uint8x8x4_t s = vld4_u8((const u8 *)(src + i));
+    uint8x8x4_t d = vld4_u8((const u8 *)(dst + i));
+    uint8x8_t inv = vmvn_u8(s.val[3]);
+    uint8x8_t keep = vceq_u8(s.val[3], vdup_n_u8(0)); // Untouched pixels
+    for (int c = 0; c < 3; ++c) {
+      uint16x8_t t = vmull_u8(d.val[c], inv);
+      t = vaddq_u16(t, vaddq_u16(vdupq_n_u16(1), vshrq_n_u16(t, 8)));
+      d.val[c] = vbsl_u8(keep, d.val[c], vqadd_u8(s.val[c], vshrn_n_u16(t, 8)));
+    }
+    d.val[3] = vbsl_u8(keep, d.val[3], vdup_n_u8(255));
+    vst4_u8((u8 *)(dst + i), d);
+  }
+  de100_pixel_blend_premultiplied_row_scalar(dst + i, src + i, count - i);
+}
+
+de100_file_scoped_fn inline void
+de100_pixel_alpha_test_row_neon(u32 *dst, const u32 *src, i32 count) {
+  uint32x4_t opaque = vdupq_n_u32(0xFF000000u);
+  i32 i = 0;
+  for (; i + 4 <= count; i += 4) {
+    uint32x4_t s = vld1q_u32(src + i);
+    uint32x4_t mask =
+        vreinterpretq_u32_s32(vshrq_n_s32(vreinterpretq_s32_u32(s), 31));
+    vst1q_u32(dst + i, vbslq_u32(mask, vorrq_u32(s, opaque),
+                                 vld1q_u32(dst + i)));
+  }
+  de100_pixel_alpha_test_row_scalar(dst + i, src + i, count - i);
+}
+
+// A 256-entry u32 palette is too big for vtbl: skip empty 16-index
+// groups with one compare, look the rest up one by one
+de100_file_scoped_fn inline void
+de100_pixel_indexed_row_neon(u32 *dst, const u8 *src, i32 count,
+                             const u32 *palette) {
+  i32 i = 0;
+  for (; i + 16 <= count; i += 16) {
+    uint64x2_t group = vreinterpretq_u64_u8(vld1q_u8(src + i));
+    if ((vgetq_lane_u64(group, 0) | vgetq_lane_u64(group, 1)) == 0) {
+      continue;
+    }
+    for (i32 j = i; j < i + 16; ++j) {
+      if (src[j]) {
+        dst[j] = palette[src[j]];
+      }
+    }
+  }
+  de100_pixel_indexed_row_scalar(dst + i, src + i, count - i, palette);
+}
+
+// Eight pixels de-interleaved like the premultiplied row; the alpha is
+// one 8-lane vector shared by all three channels
+de100_file_scoped_fn inline void
+de100_pixel_coverage_row_neon(u32 *dst, const u8 *coverage, i32 count,
+                              u32 color) {
+  uint8x8_t alpha = vdup_n_u8((u8)(color >> 24));
+  uint8x8_t src[3] = {vdup_n_u8((u8)color), vdup_n_u8((u8)(color >> 8)),
+                      vdup_n_u8((u8)(color >> 16))};
+  i32 i = 0;
+  for (; i + 8 <= count; i += 8) {
+    uint8x8_t c = vld1_u8(coverage + i);
+    if (vget_lane_u64(vreinterpret_u64_u8(c), 0) == 0) {
+      continue;
+    }
+    uint16x8_t t = vmull_u8(c, alpha);
+    t = vaddq_u16(t, vaddq_u16(vdupq_n_u16(1), vshrq_n_u16(t, 8)));
+    uint8x8_t a = vshrn_n_u16(t, 8);
+    uint8x8_t inv = vmvn_u8(a);
+    uint8x8_t keep = vceq_u8(c, vdup_n_u8(0));
+
+    uint8x8x4_t d = vld4_u8((const u8 *)(dst + i));
+    for (int ch = 0; ch < 3; ++ch) {
+      uint16x8_t v = vmlal_u8(vmull_u8(src[ch], a), d.val[ch], inv);
+      v = vaddq_u16(v, vaddq_u16(vdupq_n_u16(1), vshrq_n_u16(v, 8)));
+      d.val[ch] = vbsl_u8(keep, d.val[ch], vshrn_n_u16(v, 8));
+    }
+    d.val[3] = vbsl_u8(keep, d.val[3], vdup_n_u8(255));
+    vst4_u8((u8 *)(dst + i), d);
+  }
+  de100_pixel_coverage_row_scalar(dst + i, coverage + i, count - i, color);
+}
+
+// As SSE2: one texel per step, its two taps per row one 64-bit load
+de100_file_scoped_fn inline void
+de100_pixel_sample_bilinear_row_neon(u32 *dst, const u32 *src,
+                                     i32 src_stride, i32 u, i32 v, i32 du,
+                                     i32 dv, i32 count) {
+  uint16x4_t round = vdup_n_u16(64);
+  for (i32 i = 0; i < count; ++i) {
+    const u32 *row0 =
+        src + (size_t)(v >> 16) * (size_t)src_stride + (size_t)(u >> 16);
+    u16 fx = (u16)((u >> 9) & 127);
+    u16 fy = (u16)((v >> 9) & 127);
+    uint16x8_t wx = vcombine_u16(vdup_n_u16((u16)(128 - fx)), vdup_n_u16(fx));
+
+    uint16x8_t top = vmulq_u16(vmovl_u8(vld1_u8((const u8 *)row0)), wx);
+    uint16x8_t bottom =
+        vmulq_u16(vmovl_u8(vld1_u8((const u8 *)(row0 + src_stride))), wx);
+    uint16x4_t t = vshr_n_u16(
+        vadd_u16(vadd_u16(vget_low_u16(top), vget_high_u16(top)), round), 7);
+    uint16x4_t b = vshr_n_u16(
+        vadd_u16(vadd_u16(vget_low_u16(bottom), vget_high_u16(bottom)),
+                 round),
+        7);
+    uint16x4_t out = vadd_u16(vmul_n_u16(t, (u16)(128 - fy)),
+                              vmul_n_u16(b, fy));
+    out = vshr_n_u16(vadd_u16(out, round), 7);
+    uint8x8_t packed = vmovn_u16(vcombine_u16(out, out));
+    dst[i] = vget_lane_u32(vreinterpret_u32_u8(packed), 0);
+    u += du;
+    v += dv;
+  }
+}
+
+#endif // DE100_PIXEL_KERNELS_NEON
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Dispatch
+// ─────────────────────────────────────────────────────────────────────────────
+
+/**
+ * The best kernels for `cpu_features` (De100CpuFeature bits).
+ */
+de100_file_scoped_fn inline De100PixelKernels
+de100_pixel_kernels_for(u32 cpu_features) {
+  De100PixelKernels kernels = {
+      .fill_row = de100_pixel_fill_row_scalar,
+      .blend_row = de100_pixel_blend_row_scalar,
+      .blend_premultiplied_row = de100_pixel_blend_premultiplied_row_scalar,
+      .alpha_test_row = de100_pixel_alpha_test_row_scalar,
+      .indexed_row = de100_pixel_indexed_row_scalar,
+      .coverage_row = de100_pixel_coverage_row_scalar,
+      .blend_linear_row = de100_pixel_blend_linear_row_scalar,
+      .coverage_linear_row = de100_pixel_coverage_linear_row_scalar,
+      .sample_nearest_row = de100_pixel_sample_nearest_row_scalar,
+      .sample_bilinear_row = de100_pixel_sample_bilinear_row_scalar,
+      .name = "scalar",
+      .pixels_per_iteration = 1,
+  };
+
+#if !defined(DE100_PIXEL_KERNELS_FORCE_SCALAR)
+#if DE100_PIXEL_KERNELS_X86
+  if (cpu_features & DE100_CPU_FEATURE_AVX2) {
+    kernels = (De100PixelKernels){
+        .fill_row = de100_pixel_fill_row_avx2,
+        .blend_row = de100_pixel_blend_row_avx2,
+        .blend_premultiplied_row = de100_pixel_blend_premultiplied_row_avx2,
+        .alpha_test_row = de100_pixel_alpha_test_row_avx2,
+        .indexed_row = de100_pixel_indexed_row_avx2,
+        .coverage_row = de100_pixel_coverage_row_avx2,
+        .blend_linear_row = de100_pixel_blend_linear_row_avx2,
+        .coverage_linear_row = de100_pixel_coverage_linear_row_avx2,
+        .sample_nearest_row = de100_pixel_sample_nearest_row_avx2,
+        .sample_bilinear_row = de100_pixel_sample_bilinear_row_avx2,
+        .name = "avx2",
+        .pixels_per_iteration = 8,
+    };
+  } else if (cpu_features & DE100_CPU_FEATURE_SSE2) {
+    kernels = (De100PixelKernels){
+        .fill_row = de100_pixel_fill_row_sse2,
+        .blend_row = de100_pixel_blend_row_sse2,
+        .blend_premultiplied_row = de100_pixel_blend_premultiplied_row_sse2,
+        .alpha_test_row = de100_pixel_alpha_test_row_sse2,
+        .indexed_row = de100_pixel_indexed_row_sse2,
+        .coverage_row = de100_pixel_coverage_row_sse2,
+        .blend_linear_row = de100_pixel_blend_linear_row_scalar,
+        .coverage_linear_row = de100_pixel_coverage_linear_row_scalar,
+        // Nearest is a gather; without one the scalar loop is as good
+        .sample_nearest_row = de100_pixel_sample_nearest_row_scalar,
+        .sample_bilinear_row = de100_pixel_sample_bilinear_row_sse2,
+        .name = "sse2",
+        .pixels_per_iteration = 4,
+    };
+  }
+#elif DE100_PIXEL_KERNELS_NEON
+  if (cpu_features & DE100_CPU_FEATURE_NEON) {
+    kernels = (De100PixelKernels){
+        .fill_row = de100_pixel_fill_row_neon,
+        .blend_row = de100_pixel_blend_row_neon,
+        .blend_premultiplied_row = de100_pixel_blend_premultiplied_row_neon,
+        .alpha_test_row = de100_pixel_alpha_test_row_neon,
+        .indexed_row = de100_pixel_indexed_row_neon,
+        .coverage_row = de100_pixel_coverage_row_neon,
+        .blend_linear_row = de100_pixel_blend_linear_row_scalar,
+        .coverage_linear_row = de100_pixel_coverage_linear_row_scalar,
+        .sample_nearest_row = de100_pixel_sample_nearest_row_scalar,
+        .sample_bilinear_row = de100_pixel_sample_bilinear_row_neon,
+        .name = "neon",
+        .pixels_per_iteration = 4,
+    };
+  }
+#endif
+#else
+  (void)cpu_features;
+#endif // !DE100_PIXEL_KERNELS_FORCE_SCALAR
+
+  return kernels;
+}
+
+// One per module (game library / executable), set by DE100_KERNELS_BIND
+__attribute__((weak)) De100PixelKernels *g_de100_pixel_kernels = NULL;
+
+de100_file_scoped_fn inline De100PixelKernels *de100_pixel_kernels_get(void) {
+  if (g_de100_pixel_kernels) {
+    return g_de100_pixel_kernels;
+  }
+
+  local_persist_var De100PixelKernels kernels = {0};
+  if (!kernels.fill_row) {
+    kernels = de100_pixel_kernels_for(de100_cpu_detect());
+  }
+  return &kernels;
+}
+
+#endif // DE100_GAME_PIXEL_KERNELS_H
@@ -0,0 +1,163 @@
+#ifndef DE100_GAME_PLATFORM_COMMAND_H
+#define DE100_GAME_PLATFORM_COMMAND_H
+
+#include "../_common/base.h"
+
+// ═══════════════════════════════════════════════════════════════════════════
+// PLATFORM COMMANDS (game → platform requests, lock-free MPSC)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// GameConfig is read once at startup. Settings the platform can change at
+// runtime are requested through this queue instead, and no new function
+// pointer in GameMemory is needed per request:
+//
+//   de100_platform_command_push(memory->platform_commands,
+//                               DE100_PLATFORM_COMMAND_SET_TARGET_FPS,
+//                               (De100PlatformCommandArg){.u = 30});
+//   de100_platform_command_push(memory->platform_commands,
+//                               DE100_PLATFORM_COMMAND_CAPTURE_SCREENSHOT,
+//                               (De100PlatformCommandArg){0});
+//
+// Any thread may push (update, render, work-queue jobs, the background
+// loader): a push is one CAS on the tail and never blocks. The platform
+// drains the queue on the main thread once per frame, in engine_swap_inputs
+// (after the frame is presented, before the next one's input), in push
+// order. Nothing waits for a command to land: a new frame rate applies
+// from the next frame on.
+//
+// A full queue refuses the push (false) and counts it in `dropped`;
+// DE100_PLATFORM_COMMAND_CAPACITY is far above one frame's worth.
+// Commands carry plain values, never pointers into the game library, so
+// a hot reload leaves nothing stale behind.
+//
+// Loads already have their own non-blocking queues (background_load_submit,
+// async_io_submit); the fast-forward speed is GameMemory.time_scale.
+//
+// Like the rest of GameMemory's platform services, commands change how
+// the machine runs the game, not what it simulates: replays and netplay
+// don't record them.
+//
+// All functions are static inline for zero overhead if unused.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define DE100_PLATFORM_COMMAND_CAPACITY 128 // Power of two
+
+typedef enum {
+  DE100_PLATFORM_COMMAND_NONE = 0,
+
+  // .u: frames per second, clamped to max_allowed_refresh_rate_hz.
+  // Turns adaptive FPS off: the game picked a rate.
+  DE100_PLATFORM_COMMAND_SET_TARGET_FPS,
+  // .b: on re-derives the tier ladder from the current target
+  DE100_PLATFORM_COMMAND_SET_ADAPTIVE_FPS,
+  // .b: GameConfig.prefer_background_throttle
+  DE100_PLATFORM_COMMAND_SET_BACKGROUND_THROTTLE,
+  // .f: GameConfig.present_scanline_intensity, clamped to 0..1
+  DE100_PLATFORM_COMMAND_SET_SCANLINES,
+  // Save the next presented frame (see capture.h)
+  DE100_PLATFORM_COMMAND_CAPTURE_SCREENSHOT,
+  // Re-read the config file now (see config-file.h)
+  DE100_PLATFORM_COMMAND_RELOAD_CONFIG,
+
+  DE100_PLATFORM_COMMAND_COUNT
+} De100PlatformCommandKind;
+
+typedef union {
+  u32 u;
+  f32 f;
+  bool b;
+} De100PlatformCommandArg;
+
+typedef struct {
+  u32 kind; // De100PlatformCommandKind
+  De100PlatformCommandArg arg;
+} De100PlatformCommand;
+
+typedef struct {
+  u32 sequence; // == position + 1 once the command in it is published
+  De100PlatformCommand command;
+} De100PlatformCommandSlot;
+
+// Bounded MPSC ring after Vyukov: each slot's sequence says whose turn it
+// is, so producers only contend on `tail` and never on the slots.
+typedef struct De100PlatformCommandQueue {
+  _Alignas(64) u32 tail; // Next position to claim (producers)
+  u32 dropped;           // Pushes refused while full
+  _Alignas(64) u32 head; // Next position to drain (platform only)
+  De100PlatformCommandSlot slots[DE100_PLATFORM_COMMAND_CAPACITY];
+} De100PlatformCommandQueue;
+
+de100_file_scoped_fn inline void
+de100_platform_command_queue_init(De100PlatformCommandQueue *queue) {
+  queue->tail = 0;
+  queue->dropped = 0;
+  queue->head = 0;
+  for (u32 i = 0; i < DE100_PLATFORM_COMMAND_CAPACITY; ++i) {
+    queue->slots[i].sequence = i;
+  }
+}
+
+/**
+ * Queue a command from any thread. NULL-safe: false when there is no
+ * queue, the kind is unknown or the queue is full.
+ */
+de100_file_scoped_fn inline bool
+de100_platform_command_push(De100PlatformCommandQueue *queue,
+                            De100PlatformCommandKind kind,
+                            De100PlatformCommandArg arg) {
+  if (!queue || kind <= DE100_PLATFORM_COMMAND_NONE ||
+      kind >= DE100_PLATFORM_COMMAND_COUNT) {
+    return false;
+  }
+
+  u32 position = __atomic_load_n(&queue->tail, __ATOMIC_RELAXED);
+  De100PlatformCommandSlot *slot;
+  for (;;) {
+    slot = &queue->slots[position & (DE100_PLATFORM_COMMAND_CAPACITY - 1)];
+    u32 sequence = __atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE);
+    i32 lag = (i32)(sequence - position);
+    if (lag == 0) {
+      // Free for this position: claim it (a failed CAS reloads position)
+      if (__atomic_compare_exchange_n(&queue->tail, &position,
+                                      position + 1, true, __ATOMIC_RELAXED,
+                                      __ATOMIC_RELAXED)) {
+        break;
+      }
+    } else if (lag < 0) {
+      // Still holds the command from a lap ago: full
+      __atomic_fetch_add(&queue->dropped, 1, __ATOMIC_RELAXED);
+      return false;
+    } else {
+      position = __atomic_load_n(&queue->tail, __ATOMIC_RELAXED);
+    }
+  }
+
+  slot->command = (De100PlatformCommand){.kind = (u32)kind, .arg = arg};
+  __atomic_store_n(&slot->sequence, position + 1, __ATOMIC_RELEASE);
+  return true;
+}
+
+/**
+ * Platform side: take the oldest published command. False when empty, or
+ * when the oldest claimed slot is still being written (it is taken next
+ * drain; later ones wait behind it to keep push order).
+ */
+de100_file_scoped_fn inline bool
+de100_platform_command_pop(De100PlatformCommandQueue *queue,
+                           De100PlatformCommand *out) {
+  u32 position = queue->head;
+  De100PlatformCommandSlot *slot =
+      &queue->slots[position & (DE100_PLATFORM_COMMAND_CAPACITY - 1)];
+  if (__atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE) != position + 1) {
+    return false;
+  }
+  *out = slot->command;
+  __atomic_store_n(&slot->sequence,
+                   position + DE100_PLATFORM_COMMAND_CAPACITY,
+                   __ATOMIC_RELEASE);
+  queue->head = position + 1;
+  return true;
+}
+
+#endif // DE100_GAME_PLATFORM_COMMAND_H
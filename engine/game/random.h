@@ -0,0 +1,353 @@
+#ifndef DE100_GAME_RANDOM_H
+#define DE100_GAME_RANDOM_H
+
+#include "../_common/base.h"
+
+// ═══════════════════════════════════════════════════════════════════════════
+// 🎲 RANDOM (xoshiro128**, deterministic, per-system streams)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// Plain-data generators the game keeps in its own state, never in a
+// global. Because they live in permanent storage next to everything else,
+// a replay snapshot restores them and a hot reload keeps them: the same
+// inputs replay the same rolls, bit for bit. rand() gives neither (hidden
+// libc state, different sequence per libc).
+//
+// One stream per system, so spawning extra particles never shifts the
+// gameplay sequence (and a replay with particles disabled still matches):
+//
+//   enum { RNG_STREAM_GAMEPLAY, RNG_STREAM_PARTICLES };
+//
+//   de100_rng_seed(&state->rng, seed, RNG_STREAM_GAMEPLAY);
+//   de100_rng_bulk_seed(&state->fx_rng, seed, RNG_STREAM_PARTICLES);
+//
+//   i32 lane = de100_rng_range_i32(&state->rng, 0, LANE_COUNT);
+//   if (de100_rng_chance(&state->rng, 0.25f)) { ... }
+//
+//   f32 angles[64];                       // spawner pulls a batch at once
+//   de100_rng_bulk_range_f32(&state->fx_rng, angles, n, 0.0f, 6.2831853f);
+//
+// Streams are derived from (seed, stream id) through splitmix64, so any
+// u64 id works and neighbouring ids are unrelated sequences.
+//
+// De100Rng      One xoshiro128** state (16 bytes). Scalar, for the odd
+//               roll in game logic.
+// De100RngBulk  Four independent xoshiro128** lanes stored as columns, so
+//               SSE2 / NEON step all four per instruction. For filling
+//               arrays (particles, noise, jitter). The scalar path steps
+//               the same lanes in the same order, so every variant
+//               produces identical output — replays don't depend on the
+//               CPU that recorded them.
+//
+// Bulk fills always consume whole 4-lane steps; a count that is not a
+// multiple of 4 discards the unused tail. Deterministic, just not
+// interchangeable with the same total split into different calls.
+//
+// Define DE100_RANDOM_FORCE_SCALAR to pin the reference path.
+//
+// All functions are static inline for zero overhead if unused.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#if !defined(DE100_RANDOM_FORCE_SCALAR) &&                                     \
+    (defined(__x86_64__) || defined(_M_X64) || defined(__i386__) ||          \
+     defined(_M_IX86))
+#define DE100_RANDOM_X86 1
+#include <emmintrin.h>
+#elif !defined(DE100_RANDOM_FORCE_SCALAR) &&                                   \
+    (defined(__ARM_NEON) || defined(__aarch64__))
+#define DE100_RANDOM_NEON 1
+#include <arm_neon.h>
+#endif
+
+#define DE100_RNG_BULK_LANES 4
+
+typedef struct {
+  u32 s[4];
+} De100Rng;
+
+// s[k][lane]: each state word is one 16-byte column across the lanes
+typedef struct {
+  u32 s[4][DE100_RNG_BULK_LANES];
+} De100RngBulk;
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Seeding
+// ─────────────────────────────────────────────────────────────────────────────
+
+de100_file_scoped_fn inline u64 de100_rng_splitmix64(u64 *x) {
+  u64 z = (*x += 0x9E3779B97F4A7C15ull);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  return z ^ (z >> 31);
+}
+
+// Tags keep a scalar and a bulk stream with the same id unrelated
+#define DE100_RNG_TAG_SCALAR 0x5CA1A5CA1A5CA1A5ull
+#define DE100_RNG_TAG_BULK 0xB0B0B0B0B0B0B0B0ull
+
+de100_file_scoped_fn inline u64 de100_rng_stream_origin(u64 seed, u64 stream,
+                                                        u64 tag) {
+  u64 x = stream ^ tag;
+  return seed ^ de100_rng_splitmix64(&x);
+}
+
+de100_file_scoped_fn inline void de100_rng_seed(De100Rng *rng, u64 seed,
+                                                u64 stream) {
+  u64 x = de100_rng_stream_origin(seed, stream, DE100_RNG_TAG_SCALAR);
+  u64 a = de100_rng_splitmix64(&x);
+  u64 b = de100_rng_splitmix64(&x);
+  rng->s[0] = (u32)a;
+  rng->s[1] = (u32)(a >> 32);
+  rng->s[2] = (u32)b;
+  rng->s[3] = (u32)(b >> 32);
+  if ((rng->s[0] | rng->s[1] | rng->s[2] | rng->s[3]) == 0) {
+    rng->s[0] = 1; // All-zero is the one state xoshiro never leaves
+  }
+}
+
+de100_file_scoped_fn inline void de100_rng_bulk_seed(De100RngBulk *rng,
+                                                     u64 seed, u64 stream) {
+  u64 x = de100_rng_stream_origin(seed, stream, DE100_RNG_TAG_BULK);
+  for (u32 lane = 0; lane < DE100_RNG_BULK_LANES; ++lane) {
+    u64 a = de100_rng_splitmix64(&x);
+    u64 b = de100_rng_splitmix64(&x);
+    rng->s[0][lane] = (u32)a;
+    rng->s[1][lane] = (u32)(a >> 32);
+    rng->s[2][lane] = (u32)b;
+    rng->s[3][lane] = (u32)(b >> 32);
+    if ((rng->s[0][lane] | rng->s[1][lane] | rng->s[2][lane] |
+         rng->s[3][lane]) == 0) {
+      rng->s[0][lane] = 1;
+    }
+  }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Scalar stream
+// ─────────────────────────────────────────────────────────────────────────────
+
+de100_file_scoped_fn inline u32 de100_rng_rotl(u32 x, u32 k) {
+  return (x << k) | (x >> (32 - k));
+}
+
+de100_file_scoped_fn inline u32 de100_rng_next_u32(De100Rng *rng) {
+  u32 *s = rng->s;
+  u32 result = de100_rng_rotl(s[1] * 5, 7) * 9;
+  u32 t = s[1] << 9;
+  s[2] ^= s[0];
+  s[3] ^= s[1];
+  s[1] ^= s[2];
+  s[0] ^= s[3];
+  s[2] ^= t;
+  s[3] = de100_rng_rotl(s[3], 11);
+  return result;
+}
+
+// Top 24 bits → [0, 1), exact in f32
+de100_file_scoped_fn inline f32 de100_rng_unit_from_u32(u32 x) {
+  return (f32)(x >> 8) * (1.0f / 16777216.0f);
+}
+
+/** [0, 1) */
+de100_file_scoped_fn inline f32 de100_rng_f32(De100Rng *rng) {
+  return de100_rng_unit_from_u32(de100_rng_next_u32(rng));
+}
+
+/** [min, max) */
+de100_file_scoped_fn inline f32 de100_rng_range_f32(De100Rng *rng, f32 min,
+                                                    f32 max) {
+  f32 scaled = de100_rng_f32(rng) * (max - min);
+  return min + scaled;
+}
+
+/** [min, max), unbiased enough for games (Lemire multiply-shift, no %). */
+de100_file_scoped_fn inline i32 de100_rng_range_i32(De100Rng *rng, i32 min,
+                                                    i32 max) {
+  if (max <= min) {
+    return min;
+  }
+  u32 span = (u32)(max - min);
+  u32 r = (u32)(((u64)de100_rng_next_u32(rng) * span) >> 32);
+  return min + (i32)r;
+}
+
+/** true with probability p */
+de100_file_scoped_fn inline bool de100_rng_chance(De100Rng *rng, f32 p) {
+  return de100_rng_f32(rng) < p;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Bulk: scalar reference (steps lanes 0..3 in order, like the SIMD paths)
+// ─────────────────────────────────────────────────────────────────────────────
+
+de100_file_scoped_fn inline void
+de100_rng_bulk_step_scalar(De100RngBulk *rng, u32 out[DE100_RNG_BULK_LANES]) {
+  for (u32 lane = 0; lane < DE100_RNG_BULK_LANES; ++lane) {
+    De100Rng one = {{rng->s[0][lane], rng->s[1][lane], rng->s[2][lane],
+                     rng->s[3][lane]}};
+    out[lane] = de100_rng_next_u32(&one);
+    for (u32 k = 0; k < 4; ++k) {
+      rng->s[k][lane] = one.s[k];
+    }
+  }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Bulk: SSE2 (4 lanes / step) — baseline on every x86-64 CPU
+// ─────────────────────────────────────────────────────────────────────────────
+//
+// SSE2 has no 32-bit lane multiply, but the constants are 5 and 9:
+//   x * 5 == (x << 2) + x,   x * 9 == (x << 3) + x
+
+#if DE100_RANDOM_X86
+
+#define DE100_RNG_SSE2_ROTL(x, k)                                              \
+  _mm_or_si128(_mm_slli_epi32((x), (k)), _mm_srli_epi32((x), 32 - (k)))
+
+de100_file_scoped_fn inline __m128i
+de100_rng_bulk_step_sse2(__m128i *s0, __m128i *s1, __m128i *s2, __m128i *s3) {
+  __m128i x5 = _mm_add_epi32(_mm_slli_epi32(*s1, 2), *s1);
+  __m128i r = DE100_RNG_SSE2_ROTL(x5, 7);
+  __m128i result = _mm_add_epi32(_mm_slli_epi32(r, 3), r);
+
+  __m128i t = _mm_slli_epi32(*s1, 9);
+  *s2 = _mm_xor_si128(*s2, *s0);
+  *s3 = _mm_xor_si128(*s3, *s1);
+  *s1 = _mm_xor_si128(*s1, *s2);
+  *s0 = _mm_xor_si128(*s0, *s3);
+  *s2 = _mm_xor_si128(*s2, t);
+  *s3 = DE100_RNG_SSE2_ROTL(*s3, 11);
+  return result;
+}
+
+#endif // DE100_RANDOM_X86
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Bulk: NEON (4 lanes / step)
+// ─────────────────────────────────────────────────────────────────────────────
+
+#if DE100_RANDOM_NEON
+
+de100_file_scoped_fn inline uint32x4_t de100_rng_bulk_step_neon(uint32x4_t *s0,
+                                                                uint32x4_t *s1,
+                                                                uint32x4_t *s2,
+                                                                uint32x4_t *s3) {
+  uint32x4_t x5 = vmulq_n_u32(*s1, 5);
+  uint32x4_t r = vorrq_u32(vshlq_n_u32(x5, 7), vshrq_n_u32(x5, 25));
+  uint32x4_t result = vmulq_n_u32(r, 9);
+
+  uint32x4_t t = vshlq_n_u32(*s1, 9);
+  *s2 = veorq_u32(*s2, *s0);
+  *s3 = veorq_u32(*s3, *s1);
+  *s1 = veorq_u32(*s1, *s2);
+  *s0 = veorq_u32(*s0, *s3);
+  *s2 = veorq_u32(*s2, t);
+  *s3 = vorrq_u32(vshlq_n_u32(*s3, 11), vshrq_n_u32(*s3, 21));
+  return result;
+}
+
+#endif // DE100_RANDOM_NEON
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Bulk fills
+// ─────────────────────────────────────────────────────────────────────────────
+//
+// Each fill loads the lane columns once, runs whole steps, stores them
+// back. The tail (count % 4) comes from one more step through a scratch
+// block; float fills convert in 64-value chunks from a stack buffer.
+
+/** out[0..count) = raw u32 */
+de100_file_scoped_fn inline void de100_rng_bulk_u32(De100RngBulk *rng,
+                                                    u32 *out, i32 count) {
+  i32 i = 0;
+#if DE100_RANDOM_X86
+  __m128i s0 = _mm_loadu_si128((const __m128i *)rng->s[0]);
+  __m128i s1 = _mm_loadu_si128((const __m128i *)rng->s[1]);
+  __m128i s2 = _mm_loadu_si128((const __m128i *)rng->s[2]);
+  __m128i s3 = _mm_loadu_si128((const __m128i *)rng->s[3]);
+  for (; i + DE100_RNG_BULK_LANES <= count; i += DE100_RNG_BULK_LANES) {
+    _mm_storeu_si128((__m128i *)(out + i),
+                     de100_rng_bulk_step_sse2(&s0, &s1, &s2, &s3));
+  }
+  _mm_storeu_si128((__m128i *)rng->s[0], s0);
+  _mm_storeu_si128((__m128i *)rng->s[1], s1);
+  _mm_storeu_si128((__m128i *)rng->s[2], s2);
+  _mm_storeu_si128((__m128i *)rng->s[3], s3);
+#elif DE100_RANDOM_NEON
+  uint32x4_t s0 = vld1q_u32(rng->s[0]);
+  uint32x4_t s1 = vld1q_u32(rng->s[1]);
+  uint32x4_t s2 = vld1q_u32(rng->s[2]);
+  uint32x4_t s3 = vld1q_u32(rng->s[3]);
+  for (; i + DE100_RNG_BULK_LANES <= count; i += DE100_RNG_BULK_LANES) {
+    vst1q_u32(out + i, de100_rng_bulk_step_neon(&s0, &s1, &s2, &s3));
+  }
+  vst1q_u32(rng->s[0], s0);
+  vst1q_u32(rng->s[1], s1);
+  vst1q_u32(rng->s[2], s2);
+  vst1q_u32(rng->s[3], s3);
+#else
+  for (; i + DE100_RNG_BULK_LANES <= count; i += DE100_RNG_BULK_LANES) {
+    de100_rng_bulk_step_scalar(rng, out + i);
+  }
+#endif
+
+  if (i < count) {
+    u32 tail[DE100_RNG_BULK_LANES];
+    de100_rng_bulk_step_scalar(rng, tail);
+    for (i32 k = 0; i < count; ++i, ++k) {
+      out[i] = tail[k];
+    }
+  }
+}
+
+/** out[0..count) in [min, max). The multiply and add are separate
+ *  statements on purpose: it stops the compiler fusing them into an FMA
+ *  on some targets, which would round differently from the vector path. */
+de100_file_scoped_fn inline void de100_rng_bulk_range_f32(De100RngBulk *rng,
+                                                          f32 *out, i32 count,
+                                                          f32 min, f32 max) {
+  // Whole multiples of 4 per chunk, so chunking doesn't change the output
+  u32 bits[64];
+  f32 span = max - min;
+
+  for (i32 base = 0; base < count; base += (i32)ArraySize(bits)) {
+    i32 n = count - base;
+    if (n > (i32)ArraySize(bits)) {
+      n = (i32)ArraySize(bits);
+    }
+    de100_rng_bulk_u32(rng, bits, n);
+
+    f32 *dst = out + base;
+    i32 i = 0;
+#if DE100_RANDOM_X86
+    __m128 unit = _mm_set1_ps(1.0f / 16777216.0f);
+    __m128 vspan = _mm_set1_ps(span);
+    __m128 vmin = _mm_set1_ps(min);
+    for (; i + 4 <= n; i += 4) {
+      __m128i x =
+          _mm_srli_epi32(_mm_loadu_si128((const __m128i *)(bits + i)), 8);
+      __m128 u = _mm_mul_ps(_mm_cvtepi32_ps(x), unit);
+      _mm_storeu_ps(dst + i, _mm_add_ps(vmin, _mm_mul_ps(u, vspan)));
+    }
+#elif DE100_RANDOM_NEON
+    for (; i + 4 <= n; i += 4) {
+      uint32x4_t x = vshrq_n_u32(vld1q_u32(bits + i), 8);
+      float32x4_t u = vmulq_n_f32(vcvtq_f32_u32(x), 1.0f / 16777216.0f);
+      vst1q_f32(dst + i, vaddq_f32(vdupq_n_f32(min), vmulq_n_f32(u, span)));
+    }
+#endif
+    for (; i < n; ++i) {
+      f32 scaled = de100_rng_unit_from_u32(bits[i]) * span;
+      dst[i] = min + scaled;
+    }
+  }
+}
+
+/** out[0..count) in [0, 1) */
+de100_file_scoped_fn inline void de100_rng_bulk_f32(De100RngBulk *rng,
+                                                    f32 *out, i32 count) {
+  de100_rng_bulk_range_f32(rng, out, count, 0.0f, 1.0f);
+}
+
+#endif // DE100_GAME_RANDOM_H
@@ -0,0 +1,721 @@
+#ifndef DE100_GAME_RASTER_H
+#define DE100_GAME_RASTER_H
+
+#include "../_common/base.h"
+#include "../_common/fixed.h"
+#include "../_common/math.h"
+#include "backbuffer.h"
+#include "pixel-kernels.h"
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ✏️ SHAPE RASTERIZER (rects, lines, circles, convex polygons)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// Wireframes and particles without per-pixel bounds checks:
+//
+//   rect          Clipped once, then one span per row. Alpha 0 draws
+//                 nothing.
+//   line          Clipped ONCE (Liang-Barsky) to the clip rect, then plain
+//                 Bresenham: every plotted pixel is known to be inside.
+//                 Horizontal lines become a single row fill.
+//   line_aa       Xiaolin Wu: two coverage-weighted pixels per step.
+//   circle        One span per row; rows outside the clip never computed.
+//   polygon       Convex, scanline: one span per row from the edge
+//                 crossings at the pixel centre (top-left fill rule, so
+//                 shared edges are drawn exactly once).
+//
+// Every span goes through the SIMD row kernels (pixel-kernels.h):
+// fill_row when the color is opaque, blend_row otherwise.
+//
+//   De100RasterPoint ship[3] = {{x, y - 8}, {x - 5, y + 6}, {x + 5, y + 6}};
+//   de100_raster_polygon(buffer, ship, 3, DE100_RGB(200, 200, 255));
+//   de100_raster_line(buffer, x0, y0, x1, y1, DE100_RGB(255, 255, 255));
+//
+// The `_clipped` variants take a clip rect already inside the buffer
+// (a render tile); the others clip to the buffer and mark it dirty.
+//
+// Games with their own buffer type draw through a view of its pixels
+// (de100_backbuffer_view in backbuffer.h); fills and blends don't depend
+// on channel order, so either pixel format works for rects and shapes.
+//
+// Integer-only boards: the `_fx` variants take Q16.16 points (fixed.h)
+// and never touch the FPU; lines and circles are integer already. With
+// DE100_FIXED_POINT_RENDER the f32 entry points convert their points once
+// and forward to the `_fx` paths, so callers don't change.
+//
+// All functions are static inline for zero overhead if unused.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+// Upper bound for the fixed-point polygon path's edge table
+#ifndef DE100_RASTER_MAX_POLYGON_POINTS
+#define DE100_RASTER_MAX_POLYGON_POINTS 64
+#endif
+
+typedef struct {
+  f32 x, y;
+} De100RasterPoint;
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Spans / pixels
+// ─────────────────────────────────────────────────────────────────────────────
+
+de100_file_scoped_fn inline u32 *de100_raster_row(GameBackBuffer *buffer,
+                                                  i32 y) {
+  return (u32 *)((u8 *)buffer->memory.base + (size_t)y * (size_t)buffer->pitch);
+}
+
+// [x0, x1) on row y, clipped horizontally; `y` must be inside the clip
+de100_file_scoped_fn inline void
+de100_raster_span(GameBackBuffer *buffer, De100RenderClipRect clip, i32 y,
+                  i32 x0, i32 x1, u32 color) {
+  x0 = x0 > clip.min_x ? x0 : clip.min_x;
+  x1 = x1 < clip.max_x ? x1 : clip.max_x;
+  if (x1 <= x0) {
+    return;
+  }
+  De100PixelKernels *kernels = de100_pixel_kernels_get();
+  u32 *row = de100_raster_row(buffer, y) + x0;
+  if ((color >> 24) == 255) {
+    kernels->fill_row(row, x1 - x0, color);
+  } else {
+    kernels->blend_row(row, x1 - x0, color);
+  }
+}
+
+de100_file_scoped_fn inline void de100_raster_blend_pixel(u32 *pixel,
+                                                          u32 color,
+                                                          f32 coverage) {
+  u32 alpha = (u32)((f32)(color >> 24) * coverage + 0.5f);
+  if (alpha > 0) {
+    *pixel = de100_pixel_blend_scalar(*pixel,
+                                      (color & 0x00FFFFFFu) | (alpha << 24));
+  }
+}
+
+// `coverage` in [0, DE100_FX_ONE]
+de100_file_scoped_fn inline void de100_raster_blend_pixel_fx(u32 *pixel,
+                                                             u32 color,
+                                                             fx32 coverage) {
+  u32 alpha = (u32)(((i64)(color >> 24) * coverage + DE100_FX_HALF) >>
+                    DE100_FX_SHIFT);
+  if (alpha > 0) {
+    *pixel = de100_pixel_blend_scalar(*pixel,
+                                      (color & 0x00FFFFFFu) | (alpha << 24));
+  }
+}
+
+// Screen-range Q16.16 point (saturates instead of overflowing)
+de100_file_scoped_fn inline De100FxV2
+de100_raster_point_to_fx(De100RasterPoint point) {
+  f32 limit = 32767.0f;
+  f32 x = point.x < -limit ? -limit : (point.x > limit ? limit : point.x);
+  f32 y = point.y < -limit ? -limit : (point.y > limit ? limit : point.y);
+  return (De100FxV2){de100_fx_from_f32(x), de100_fx_from_f32(y)};
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Rects
+// ─────────────────────────────────────────────────────────────────────────────
+
+de100_file_scoped_fn inline void
+de100_raster_rect_clipped(GameBackBuffer *buffer, De100RenderClipRect clip,
+                          i32 x, i32 y, i32 width, i32 height, u32 color) {
+  if ((color >> 24) == 0) {
+    return;
+  }
+  i32 x0 = x > clip.min_x ? x : clip.min_x;
+  i32 y0 = y > clip.min_y ? y : clip.min_y;
+  i32 x1 = x + width < clip.max_x ? x + width : clip.max_x;
+  i32 y1 = y + height < clip.max_y ? y + height : clip.max_y;
+  if (x1 <= x0) {
+    return;
+  }
+
+  De100PixelKernels *kernels = de100_pixel_kernels_get();
+  de100_pixel_fill_row_t *row_kernel =
+      (color >> 24) == 255 ? kernels->fill_row : kernels->blend_row;
+  for (i32 py = y0; py < y1; ++py) {
+    row_kernel(de100_raster_row(buffer, py) + x0, x1 - x0, color);
+  }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Lines
+// ─────────────────────────────────────────────────────────────────────────────
+
+/**
+ * Integer Liang-Barsky on Q16 coordinates held in i64 (any i32 input
+ * fits). Same contract as the f32 version below.
+ */
+de100_file_scoped_fn inline bool
+de100_raster_clip_segment_q16(i64 *x0, i64 *y0, i64 *x1, i64 *y1, i64 min_x,
+                              i64 min_y, i64 max_x, i64 max_y) {
+  i64 dx = *x1 - *x0;
+  i64 dy = *y1 - *y0;
+  i64 p[4] = {-dx, dx, -dy, dy};
+  i64 q[4] = {*x0 - min_x, max_x - *x0, *y0 - min_y, max_y - *y0};
+  i64 t0 = 0;
+  i64 t1 = DE100_FX_ONE;
+
+  for (i32 i = 0; i < 4; ++i) {
+    if (p[i] == 0) {
+      if (q[i] < 0) {
+        return false; // Parallel and outside
+      }
+      continue;
+    }
+    // q is at most ~2^48 in magnitude: q << 16 fits comfortably
+    i64 t = (q[i] * DE100_FX_ONE) / p[i];
+    if (p[i] < 0) {
+      t0 = t > t0 ? t : t0;
+    } else {
+      t1 = t < t1 ? t : t1;
+    }
+    if (t0 > t1) {
+      return false;
+    }
+  }
+
+  i64 start_x = *x0;
+  i64 start_y = *y0;
+  *x0 = start_x + ((t0 * dx) >> DE100_FX_SHIFT);
+  *y0 = start_y + ((t0 * dy) >> DE100_FX_SHIFT);
+  *x1 = start_x + ((t1 * dx) >> DE100_FX_SHIFT);
+  *y1 = start_y + ((t1 * dy) >> DE100_FX_SHIFT);
+  return true;
+}
+
+/**
+ * Liang-Barsky: trims the segment to [min_x, max_x] x [min_y, max_y]
+ * (inclusive). False if nothing is left.
+ */
+de100_file_scoped_fn inline bool
+de100_raster_clip_segment(f32 *x0, f32 *y0, f32 *x1, f32 *y1, f32 min_x,
+                          f32 min_y, f32 max_x, f32 max_y) {
+  f32 dx = *x1 - *x0;
+  f32 dy = *y1 - *y0;
+  f32 p[4] = {-dx, dx, -dy, dy};
+  f32 q[4] = {*x0 - min_x, max_x - *x0, *y0 - min_y, max_y - *y0};
+  f32 t0 = 0.0f;
+  f32 t1 = 1.0f;
+
+  for (i32 i = 0; i < 4; ++i) {
+    if (p[i] == 0.0f) {
+      if (q[i] < 0.0f) {
+        return false; // Parallel and outside
+      }
+      continue;
+    }
+    f32 t = q[i] / p[i];
+    if (p[i] < 0.0f) {
+      t0 = t > t0 ? t : t0;
+    } else {
+      t1 = t < t1 ? t : t1;
+    }
+    if (t0 > t1) {
+      return false;
+    }
+  }
+
+  f32 start_x = *x0;
+  f32 start_y = *y0;
+  *x0 = start_x + t0 * dx;
+  *y0 = start_y + t0 * dy;
+  *x1 = start_x + t1 * dx;
+  *y1 = start_y + t1 * dy;
+  return true;
+}
+
+de100_file_scoped_fn inline void
+de100_raster_line_clipped(GameBackBuffer *buffer, De100RenderClipRect clip,
+                          i32 x0, i32 y0, i32 x1, i32 y1, u32 color) {
+  if ((color >> 24) == 0) {
+    return;
+  }
+  if (y0 == y1) {
+    if (y0 >= clip.min_y && y0 < clip.max_y) {
+      de100_raster_span(buffer, clip, y0, x0 < x1 ? x0 : x1,
+                        (x0 < x1 ? x1 : x0) + 1, color);
+    }
+    return;
+  }
+
+  // Integer clip: no float ops even on the default path
+  i64 qx0 = (i64)x0 * DE100_FX_ONE, qy0 = (i64)y0 * DE100_FX_ONE;
+  i64 qx1 = (i64)x1 * DE100_FX_ONE, qy1 = (i64)y1 * DE100_FX_ONE;
+  if (!de100_raster_clip_segment_q16(
+          &qx0, &qy0, &qx1, &qy1, (i64)clip.min_x * DE100_FX_ONE,
+          (i64)clip.min_y * DE100_FX_ONE, (i64)(clip.max_x - 1) * DE100_FX_ONE,
+          (i64)(clip.max_y - 1) * DE100_FX_ONE)) {
+    return;
+  }
+  // Round, then clamp away the last-bit error of the truncated t: every
+  // pixel below is inside without further checks
+  x0 = clamp_i32((i32)((qx0 + DE100_FX_HALF) >> DE100_FX_SHIFT), clip.min_x,
+                 clip.max_x - 1);
+  y0 = clamp_i32((i32)((qy0 + DE100_FX_HALF) >> DE100_FX_SHIFT), clip.min_y,
+                 clip.max_y - 1);
+  x1 = clamp_i32((i32)((qx1 + DE100_FX_HALF) >> DE100_FX_SHIFT), clip.min_x,
+                 clip.max_x - 1);
+  y1 = clamp_i32((i32)((qy1 + DE100_FX_HALF) >> DE100_FX_SHIFT), clip.min_y,
+                 clip.max_y - 1);
+
+  i32 dx = abs_i32(x1 - x0);
+  i32 dy = -abs_i32(y1 - y0);
+  i32 step_x = x0 < x1 ? 1 : -1;
+  i32 step_y = y0 < y1 ? buffer->pitch : -buffer->pitch;
+  i32 step_y_sign = y0 < y1 ? 1 : -1;
+  i32 error = dx + dy;
+  bool opaque = (color >> 24) == 255;
+
+  u8 *pixel = (u8 *)de100_raster_row(buffer, y0) + (size_t)x0 * 4;
+  for (;;) {
+    if (opaque) {
+      *(u32 *)pixel = color;
+    } else {
+      *(u32 *)pixel = de100_pixel_blend_scalar(*(u32 *)pixel, color);
+    }
+    if (x0 == x1 && y0 == y1) {
+      break;
+    }
+    i32 error2 = 2 * error;
+    if (error2 >= dy) {
+      error += dy;
+      x0 += step_x;
+      pixel += step_x * 4;
+    }
+    if (error2 <= dx) {
+      error += dx;
+      y0 += step_y_sign;
+      pixel += step_y;
+    }
+  }
+}
+
+/**
+ * Anti-aliased line (Wu), Q16.16 endpoints, integer only.
+ */
+de100_file_scoped_fn inline void
+de100_raster_line_aa_fx_clipped(GameBackBuffer *buffer,
+                                De100RenderClipRect clip, De100FxV2 a,
+                                De100FxV2 b, u32 color) {
+  i64 qx0 = a.x, qy0 = a.y, qx1 = b.x, qy1 = b.y;
+  if ((color >> 24) == 0 ||
+      !de100_raster_clip_segment_q16(
+          &qx0, &qy0, &qx1, &qy1, (i64)(clip.min_x - 1) * DE100_FX_ONE,
+          (i64)(clip.min_y - 1) * DE100_FX_ONE, (i64)clip.max_x * DE100_FX_ONE,
+          (i64)clip.max_y * DE100_FX_ONE)) {
+    return;
+  }
+  fx32 x0 = (fx32)qx0, y0 = (fx32)qy0, x1 = (fx32)qx1, y1 = (fx32)qy1;
+
+  bool steep = de100_fx_abs(y1 - y0) > de100_fx_abs(x1 - x0);
+  if (steep) {
+    fx32 t = x0;
+    x0 = y0;
+    y0 = t;
+    t = x1;
+    x1 = y1;
+    y1 = t;
+  }
+  if (x0 > x1) {
+    fx32 t = x0;
+    x0 = x1;
+    x1 = t;
+    t = y0;
+    y0 = y1;
+    y1 = t;
+  }
+
+  fx32 dx = x1 - x0;
+  fx32 gradient = dx > 0 ? de100_fx_div(y1 - y0, dx) : DE100_FX_ONE;
+  i32 start = de100_fx_round(x0);
+  i32 end = de100_fx_round(x1);
+  fx32 y = y0 + de100_fx_mul(gradient, de100_fx_from_i32(start) - x0);
+
+  for (i32 major = start; major <= end; ++major) {
+    i32 minor = de100_fx_floor(y);
+    fx32 fraction = de100_fx_fraction(y);
+    for (i32 k = 0; k < 2; ++k) {
+      i32 px = steep ? minor + k : major;
+      i32 py = steep ? major : minor + k;
+      if (px >= clip.min_x && px < clip.max_x && py >= clip.min_y &&
+          py < clip.max_y) {
+        de100_raster_blend_pixel_fx(de100_raster_row(buffer, py) + px, color,
+                                    k ? fraction : DE100_FX_ONE - fraction);
+      }
+    }
+    y += gradient;
+  }
+}
+
+/**
+ * Anti-aliased line (Wu). Endpoints are sub-pixel; color alpha scales the
+ * coverage.
+ */
+de100_file_scoped_fn inline void
+de100_raster_line_aa_clipped(GameBackBuffer *buffer, De100RenderClipRect clip,
+                             f32 x0, f32 y0, f32 x1, f32 y1, u32 color) {
+#if DE100_FIXED_POINT_RENDER
+  de100_raster_line_aa_fx_clipped(
+      buffer, clip, de100_raster_point_to_fx((De100RasterPoint){x0, y0}),
+      de100_raster_point_to_fx((De100RasterPoint){x1, y1}), color);
+#else
+  // Trim far-off geometry once; the 1px margin keeps edge coverage
+  if ((color >> 24) == 0 ||
+      !de100_raster_clip_segment(&x0, &y0, &x1, &y1, (f32)clip.min_x - 1.0f,
+                                 (f32)clip.min_y - 1.0f, (f32)clip.max_x,
+                                 (f32)clip.max_y)) {
+    return;
+  }
+
+  bool steep = abs_f32(y1 - y0) > abs_f32(x1 - x0);
+  if (steep) {
+    f32 t = x0;
+    x0 = y0;
+    y0 = t;
+    t = x1;
+    x1 = y1;
+    y1 = t;
+  }
+  if (x0 > x1) {
+    f32 t = x0;
+    x0 = x1;
+    x1 = t;
+    t = y0;
+    y0 = y1;
+    y1 = t;
+  }
+
+  f32 dx = x1 - x0;
+  f32 gradient = dx > 0.0f ? (y1 - y0) / dx : 1.0f;
+  i32 start = floor_f32_to_i32(x0 + 0.5f);
+  i32 end = floor_f32_to_i32(x1 + 0.5f);
+  f32 y = y0 + gradient * ((f32)start - x0);
+
+  for (i32 major = start; major <= end; ++major) {
+    i32 minor = floor_f32_to_i32(y);
+    f32 fraction = y - (f32)minor;
+    for (i32 k = 0; k < 2; ++k) {
+      i32 px = steep ? minor + k : major;
+      i32 py = steep ? major : minor + k;
+      if (px >= clip.min_x && px < clip.max_x && py >= clip.min_y &&
+          py < clip.max_y) {
+        de100_raster_blend_pixel(de100_raster_row(buffer, py) + px, color,
+                                 k ? fraction : 1.0f - fraction);
+      }
+    }
+    y += gradient;
+  }
+#endif
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Filled shapes
+// ─────────────────────────────────────────────────────────────────────────────
+
+de100_file_scoped_fn inline void
+de100_raster_circle_clipped(GameBackBuffer *buffer, De100RenderClipRect clip,
+                            i32 center_x, i32 center_y, i32 radius,
+                            u32 color) {
+  if (radius < 0 || (color >> 24) == 0) {
+    return;
+  }
+
+  // Half-width shrinks monotonically as |dy| grows: walk it down once
+  i32 half_width = radius;
+  i32 radius_squared = radius * radius + radius; // Rounder small circles
+  for (i32 dy = 0; dy <= radius; ++dy) {
+    while (half_width > 0 &&
+           half_width * half_width + dy * dy > radius_squared) {
+      --half_width;
+    }
+    i32 x0 = center_x - half_width;
+    i32 x1 = center_x + half_width + 1;
+    i32 rows[2] = {center_y - dy, center_y + dy};
+    for (i32 i = 0; i < (dy ? 2 : 1); ++i) {
+      if (rows[i] >= clip.min_y && rows[i] < clip.max_y) {
+        de100_raster_span(buffer, clip, rows[i], x0, x1, color);
+      }
+    }
+  }
+}
+
+/**
+ * Convex polygon from Q16.16 points, integer only. Each edge costs one
+ * divide up front; rows then step every edge's x by a multiply-add.
+ * At most DE100_RASTER_MAX_POLYGON_POINTS points are used.
+ */
+de100_file_scoped_fn inline void
+de100_raster_polygon_fx_clipped(GameBackBuffer *buffer,
+                                De100RenderClipRect clip,
+                                const De100FxV2 *points, i32 count,
+                                u32 color) {
+  if (count < 3 || (color >> 24) == 0) {
+    return;
+  }
+  count = count < DE100_RASTER_MAX_POLYGON_POINTS
+              ? count
+              : DE100_RASTER_MAX_POLYGON_POINTS;
+
+  // Per edge: rows [row0, row1) whose centre it crosses, x at row0's
+  // centre and x step per row (all Q16)
+  struct {
+    i32 row0, row1;
+    i64 x, step;
+  } edges[DE100_RASTER_MAX_POLYGON_POINTS];
+  i32 edge_count = 0;
+  i32 y0 = DE100_I32_MAX;
+  i32 y1 = DE100_I32_MIN;
+
+  for (i32 i = 0; i < count; ++i) {
+    De100FxV2 a = points[i];
+    De100FxV2 b = points[i + 1 < count ? i + 1 : 0];
+    if (a.y == b.y) {
+      continue;
+    }
+    if (a.y > b.y) {
+      De100FxV2 t = a;
+      a = b;
+      b = t;
+    }
+    // Row centres (py + 0.5) inside [a.y, b.y)
+    i32 row0 = de100_fx_ceil(a.y - DE100_FX_HALF);
+    i32 row1 = de100_fx_ceil(b.y - DE100_FX_HALF);
+    if (row1 <= row0) {
+      continue;
+    }
+    i64 step = (((i64)b.x - a.x) * DE100_FX_ONE) / ((i64)b.y - a.y);
+    i64 first_center = (i64)row0 * DE100_FX_ONE + DE100_FX_HALF;
+    edges[edge_count].row0 = row0;
+    edges[edge_count].row1 = row1;
+    edges[edge_count].x =
+        a.x + (((first_center - a.y) * step) >> DE100_FX_SHIFT);
+    edges[edge_count].step = step;
+    ++edge_count;
+    y0 = row0 < y0 ? row0 : y0;
+    y1 = row1 > y1 ? row1 : y1;
+  }
+
+  y0 = y0 > clip.min_y ? y0 : clip.min_y;
+  y1 = y1 < clip.max_y ? y1 : clip.max_y;
+
+  for (i32 py = y0; py < y1; ++py) {
+    i64 left = 0;
+    i64 right = 0;
+    bool found = false;
+
+    for (i32 i = 0; i < edge_count; ++i) {
+      if (py < edges[i].row0 || py >= edges[i].row1) {
+        continue;
+      }
+      i64 x = edges[i].x + (i64)(py - edges[i].row0) * edges[i].step;
+      if (!found) {
+        left = right = x;
+        found = true;
+      } else {
+        left = x < left ? x : left;
+        right = x > right ? x : right;
+      }
+    }
+
+    if (found) {
+      // ceil(x - 0.5), as the f32 path
+      i64 span_x0 = (left - DE100_FX_HALF + DE100_FX_FRACTION_MASK) >>
+                    DE100_FX_SHIFT;
+      i64 span_x1 = (right - DE100_FX_HALF + DE100_FX_FRACTION_MASK) >>
+                    DE100_FX_SHIFT;
+      de100_raster_span(buffer, clip, py, (i32)span_x0, (i32)span_x1,
+                        color);
+    }
+  }
+}
+
+/**
+ * Convex polygon, any winding. Non-convex input draws its per-row hull.
+ */
+de100_file_scoped_fn inline void
+de100_raster_polygon_clipped(GameBackBuffer *buffer, De100RenderClipRect clip,
+                             const De100RasterPoint *points, i32 count,
+                             u32 color) {
+  if (count < 3 || (color >> 24) == 0) {
+    return;
+  }
+#if DE100_FIXED_POINT_RENDER
+  De100FxV2 fx_points[DE100_RASTER_MAX_POLYGON_POINTS];
+  count = count < DE100_RASTER_MAX_POLYGON_POINTS
+              ? count
+              : DE100_RASTER_MAX_POLYGON_POINTS;
+  for (i32 i = 0; i < count; ++i) {
+    fx_points[i] = de100_raster_point_to_fx(points[i]);
+  }
+  de100_raster_polygon_fx_clipped(buffer, clip, fx_points, count, color);
+#else
+
+  f32 min_y = points[0].y;
+  f32 max_y = points[0].y;
+  for (i32 i = 1; i < count; ++i) {
+    min_y = points[i].y < min_y ? points[i].y : min_y;
+    max_y = points[i].y > max_y ? points[i].y : max_y;
+  }
+
+  // Rows whose centre (y + 0.5) is inside [min_y, max_y)
+  i32 y0 = ceil_f32_to_i32_safe(min_y - 0.5f);
+  i32 y1 = ceil_f32_to_i32_safe(max_y - 0.5f);
+  y0 = y0 > clip.min_y ? y0 : clip.min_y;
+  y1 = y1 < clip.max_y ? y1 : clip.max_y;
+
+  for (i32 py = y0; py < y1; ++py) {
+    f32 sample_y = (f32)py + 0.5f;
+    f32 left = 0.0f;
+    f32 right = 0.0f;
+    bool found = false;
+
+    for (i32 i = 0; i < count; ++i) {
+      De100RasterPoint a = points[i];
+      De100RasterPoint b = points[i + 1 < count ? i + 1 : 0];
+      if ((sample_y < a.y) == (sample_y < b.y)) {
+        continue; // Edge doesn't cross this row (half-open in y)
+      }
+      f32 x = a.x + (sample_y - a.y) * (b.x - a.x) / (b.y - a.y);
+      if (!found) {
+        left = right = x;
+        found = true;
+      } else {
+        left = x < left ? x : left;
+        right = x > right ? x : right;
+      }
+    }
+
+    if (found) {
+      de100_raster_span(buffer, clip, py, ceil_f32_to_i32_safe(left - 0.5f),
+                        ceil_f32_to_i32_safe(right - 0.5f), color);
+    }
+  }
+#endif
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Immediate mode (whole buffer)
+// ─────────────────────────────────────────────────────────────────────────────
+
+de100_file_scoped_fn inline De100RenderClipRect
+de100_raster_buffer_clip(GameBackBuffer *buffer) {
+  return (De100RenderClipRect){0, 0, buffer->width, buffer->height};
+}
+
+/** Filled when opaque, blended otherwise. */
+de100_file_scoped_fn inline void de100_raster_rect(GameBackBuffer *buffer,
+                                                   i32 x, i32 y, i32 width,
+                                                   i32 height, u32 color) {
+  if (buffer->is_rendering_disabled) {
+    return;
+  }
+  de100_backbuffer_mark_dirty(buffer, x, y, width, height);
+  de100_raster_rect_clipped(buffer, de100_raster_buffer_clip(buffer), x, y,
+                            width, height, color);
+}
+
+de100_file_scoped_fn inline void de100_raster_line(GameBackBuffer *buffer,
+                                                   i32 x0, i32 y0, i32 x1,
+                                                   i32 y1, u32 color) {
+  if (buffer->is_rendering_disabled) {
+    return;
+  }
+  i32 min_x = x0 < x1 ? x0 : x1;
+  i32 min_y = y0 < y1 ? y0 : y1;
+  de100_backbuffer_mark_dirty(buffer, min_x, min_y, abs_i32(x1 - x0) + 1,
+                              abs_i32(y1 - y0) + 1);
+  de100_raster_line_clipped(buffer, de100_raster_buffer_clip(buffer), x0, y0,
+                            x1, y1, color);
+}
+
+de100_file_scoped_fn inline void de100_raster_line_aa(GameBackBuffer *buffer,
+                                                      f32 x0, f32 y0, f32 x1,
+                                                      f32 y1, u32 color) {
+  if (buffer->is_rendering_disabled) {
+    return;
+  }
+  i32 min_x = floor_f32_to_i32(x0 < x1 ? x0 : x1) - 1;
+  i32 min_y = floor_f32_to_i32(y0 < y1 ? y0 : y1) - 1;
+  de100_backbuffer_mark_dirty(buffer, min_x, min_y,
+                              (i32)abs_f32(x1 - x0) + 3,
+                              (i32)abs_f32(y1 - y0) + 3);
+  de100_raster_line_aa_clipped(buffer, de100_raster_buffer_clip(buffer), x0,
+                               y0, x1, y1, color);
+}
+
+de100_file_scoped_fn inline void de100_raster_circle(GameBackBuffer *buffer,
+                                                     i32 center_x,
+                                                     i32 center_y, i32 radius,
+                                                     u32 color) {
+  if (buffer->is_rendering_disabled) {
+    return;
+  }
+  de100_backbuffer_mark_dirty(buffer, center_x - radius, center_y - radius,
+                              2 * radius + 1, 2 * radius + 1);
+  de100_raster_circle_clipped(buffer, de100_raster_buffer_clip(buffer),
+                              center_x, center_y, radius, color);
+}
+
+de100_file_scoped_fn inline void
+de100_raster_polygon(GameBackBuffer *buffer, const De100RasterPoint *points,
+                     i32 count, u32 color) {
+  if (buffer->is_rendering_disabled || count < 3) {
+    return;
+  }
+  f32 min_x = points[0].x, max_x = points[0].x;
+  f32 min_y = points[0].y, max_y = points[0].y;
+  for (i32 i = 1; i < count; ++i) {
+    min_x = points[i].x < min_x ? points[i].x : min_x;
+    max_x = points[i].x > max_x ? points[i].x : max_x;
+    min_y = points[i].y < min_y ? points[i].y : min_y;
+    max_y = points[i].y > max_y ? points[i].y : max_y;
+  }
+  de100_backbuffer_mark_dirty(buffer, floor_f32_to_i32_safe(min_x),
+                              floor_f32_to_i32_safe(min_y),
+                              (i32)(max_x - min_x) + 2,
+                              (i32)(max_y - min_y) + 2);
+  de100_raster_polygon_clipped(buffer, de100_raster_buffer_clip(buffer),
+                               points, count, color);
+}
+
+de100_file_scoped_fn inline void
+de100_raster_line_aa_fx(GameBackBuffer *buffer, De100FxV2 a, De100FxV2 b,
+                        u32 color) {
+  if (buffer->is_rendering_disabled) {
+    return;
+  }
+  i32 min_x = de100_fx_floor(de100_fx_min(a.x, b.x)) - 1;
+  i32 min_y = de100_fx_floor(de100_fx_min(a.y, b.y)) - 1;
+  i32 max_x = de100_fx_ceil(de100_fx_max(a.x, b.x)) + 1;
+  i32 max_y = de100_fx_ceil(de100_fx_max(a.y, b.y)) + 1;
+  de100_backbuffer_mark_dirty(buffer, min_x, min_y, max_x - min_x + 1,
+                              max_y - min_y + 1);
+  de100_raster_line_aa_fx_clipped(buffer, de100_raster_buffer_clip(buffer), a,
+                                  b, color);
+}
+
+de100_file_scoped_fn inline void
+de100_raster_polygon_fx(GameBackBuffer *buffer, const De100FxV2 *points,
+                        i32 count, u32 color) {
+  if (buffer->is_rendering_disabled || count < 3) {
+    return;
+  }
+  fx32 min_x = points[0].x, max_x = points[0].x;
+  fx32 min_y = points[0].y, max_y = points[0].y;
+  for (i32 i = 1; i < count; ++i) {
+    min_x = de100_fx_min(points[i].x, min_x);
+    max_x = de100_fx_max(points[i].x, max_x);
+    min_y = de100_fx_min(points[i].y, min_y);
+    max_y = de100_fx_max(points[i].y, max_y);
+  }
+  i32 x0 = de100_fx_floor(min_x), y0 = de100_fx_floor(min_y);
+  de100_backbuffer_mark_dirty(buffer, x0, y0, de100_fx_ceil(max_x) - x0 + 1,
+                              de100_fx_ceil(max_y) - y0 + 1);
+  de100_raster_polygon_fx_clipped(buffer, de100_raster_buffer_clip(buffer),
+                                  points, count, color);
+}
+
+#endif // DE100_GAME_RASTER_H
@@ -0,0 +1,215 @@
+#ifndef DE100_GAME_RENDER_CULL_H
+#define DE100_GAME_RENDER_CULL_H
+
+#include "../_common/base.h"
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ✂️ RENDER CULLING (offscreen and occluded items, before commands exist)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// Clipping inside each primitive keeps an offscreen sprite from writing
+// pixels. It still costs the push, a slot in the sort, and a bounds test
+// in every tile. This pass rejects it first, from the item's bounds
+// alone:
+//
+//   De100RenderCull cull;
+//   de100_render_cull_begin(&cull, buffer->width, buffer->height,
+//                           camera_x, camera_y, zoom);
+//   // Opaque UI panels, in screen pixels, on the layer they are drawn at
+//   de100_render_cull_add_occluder(&cull, 0, 0, 160, buffer->height,
+//                                  LAYER_UI);
+//
+//   for (each creep) {
+//     if (!de100_render_cull_is_visible(&cull, creep->x - r, creep->y - r,
+//                                       2 * r, 2 * r, LAYER_WORLD)) {
+//       continue;
+//     }
+//     ... // transform and push as before
+//   }
+//
+// Items are tested in WORLD units: the camera maps them to the screen as
+// (world - origin) * scale, so scrolling and zooming need nothing else.
+// A render group can also run the test itself on every rect, sprite and
+// text it is given (screen pixels, the group's current layer):
+//
+//   de100_render_group_set_cull(&group, &cull);
+//
+// An item is OFFSCREEN when its bounds miss the screen, and OCCLUDED
+// when one occluder on a HIGHER layer contains them entirely (an
+// occluder never hides its own layer, so the panel itself still draws).
+// Only single panels are checked, not unions of them: an item straddling
+// two panels is drawn. Keep occluders to the few big opaque rects
+// (sidebars, dialogs); each one costs every test a comparison.
+//
+// Screen-wrapping worlds draw an object once per copy that shows:
+// de100_render_cull_wrap_offsets lists only those copies.
+//
+// Culling only decides what is drawn, never what is simulated: update
+// stays the same for visible and culled items, so replays don't care.
+//
+// All functions are static inline for zero overhead if unused.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define DE100_RENDER_CULL_MAX_OCCLUDERS 16
+
+typedef enum {
+  DE100_RENDER_CULL_VISIBLE = 0,
+  DE100_RENDER_CULL_OFFSCREEN,
+  DE100_RENDER_CULL_OCCLUDED,
+} De100RenderCullResult;
+
+// [min, max) in screen pixels
+typedef struct {
+  f32 min_x, min_y;
+  f32 max_x, max_y;
+  u32 layer; // Hides items on layers below this one
+} De100RenderCullOccluder;
+
+typedef struct {
+  // Camera: screen = (world - origin) * scale
+  f32 origin_x, origin_y;
+  f32 scale;
+  f32 screen_width, screen_height;
+
+  De100RenderCullOccluder occluders[DE100_RENDER_CULL_MAX_OCCLUDERS];
+  u32 occluder_count;
+
+  // This frame, for the debug overlay
+  u32 tested_count;
+  u32 offscreen_count;
+  u32 occluded_count;
+} De100RenderCull;
+
+/**
+ * Start a frame: no occluders, counters zeroed. `scale` is screen pixels
+ * per world unit (1 for an unzoomed, pixel-sized world).
+ */
+de100_file_scoped_fn inline void
+de100_render_cull_begin(De100RenderCull *cull, i32 screen_width,
+                        i32 screen_height, f32 origin_x, f32 origin_y,
+                        f32 scale) {
+  cull->origin_x = origin_x;
+  cull->origin_y = origin_y;
+  cull->scale = scale > 0.0f ? scale : 1.0f;
+  cull->screen_width = (f32)screen_width;
+  cull->screen_height = (f32)screen_height;
+  cull->occluder_count = 0;
+  cull->tested_count = 0;
+  cull->offscreen_count = 0;
+  cull->occluded_count = 0;
+}
+
+/**
+ * An opaque screen rect drawn on `layer`. Returns false (and the rect
+ * hides nothing) once DE100_RENDER_CULL_MAX_OCCLUDERS are in.
+ */
+de100_file_scoped_fn inline bool
+de100_render_cull_add_occluder(De100RenderCull *cull, i32 x, i32 y,
+                               i32 width, i32 height, u32 layer) {
+  if (width <= 0 || height <= 0) {
+    return true;
+  }
+  if (cull->occluder_count >= DE100_RENDER_CULL_MAX_OCCLUDERS) {
+    return false;
+  }
+  cull->occluders[cull->occluder_count++] = (De100RenderCullOccluder){
+      .min_x = (f32)x,
+      .min_y = (f32)y,
+      .max_x = (f32)x + (f32)width,
+      .max_y = (f32)y + (f32)height,
+      .layer = layer,
+  };
+  return true;
+}
+
+/** Test a rect already in screen pixels. Counts toward the stats. */
+de100_file_scoped_fn inline De100RenderCullResult
+de100_render_cull_test_screen(De100RenderCull *cull, f32 x, f32 y,
+                              f32 width, f32 height, u32 layer) {
+  cull->tested_count++;
+  f32 max_x = x + width;
+  f32 max_y = y + height;
+  // Written so NaN bounds fail every comparison and count as offscreen
+  if (!(max_x > 0.0f && max_y > 0.0f && x < cull->screen_width &&
+        y < cull->screen_height)) {
+    cull->offscreen_count++;
+    return DE100_RENDER_CULL_OFFSCREEN;
+  }
+  for (u32 i = 0; i < cull->occluder_count; ++i) {
+    const De100RenderCullOccluder *occluder = &cull->occluders[i];
+    if (occluder->layer > layer && x >= occluder->min_x &&
+        y >= occluder->min_y && max_x <= occluder->max_x &&
+        max_y <= occluder->max_y) {
+      cull->occluded_count++;
+      return DE100_RENDER_CULL_OCCLUDED;
+    }
+  }
+  return DE100_RENDER_CULL_VISIBLE;
+}
+
+/** Test world-space bounds through the camera. */
+de100_file_scoped_fn inline De100RenderCullResult
+de100_render_cull_test(De100RenderCull *cull, f32 x, f32 y, f32 width,
+                       f32 height, u32 layer) {
+  return de100_render_cull_test_screen(
+      cull, (x - cull->origin_x) * cull->scale,
+      (y - cull->origin_y) * cull->scale, width * cull->scale,
+      height * cull->scale, layer);
+}
+
+de100_file_scoped_fn inline bool
+de100_render_cull_is_visible(De100RenderCull *cull, f32 x, f32 y, f32 width,
+                             f32 height, u32 layer) {
+  return de100_render_cull_test(cull, x, y, width, height, layer) ==
+         DE100_RENDER_CULL_VISIBLE;
+}
+
+/**
+ * Cull a whole list at once (entities, projectiles): writes the indexes
+ * of the visible bounds to `visible` (room for `count`), in order, and
+ * returns how many there are. `bounds` is x, y, width, height per item,
+ * world units.
+ */
+de100_file_scoped_fn inline u32
+de100_render_cull_batch(De100RenderCull *cull, const f32 (*bounds)[4],
+                        u32 count, u32 layer, u32 *visible) {
+  u32 visible_count = 0;
+  for (u32 i = 0; i < count; ++i) {
+    if (de100_render_cull_is_visible(cull, bounds[i][0], bounds[i][1],
+                                     bounds[i][2], bounds[i][3], layer)) {
+      visible[visible_count++] = i;
+    }
+  }
+  return visible_count;
+}
+
+/**
+ * A world that wraps every `wrap_width` x `wrap_height` units draws an
+ * object near an edge again one period over. Of the 9 placements (the
+ * object itself and its 8 neighbours), writes the world offsets of the
+ * visible ones to `offsets` and returns how many there are. Most objects
+ * get 1; corners get up to 4.
+ */
+de100_file_scoped_fn inline u32
+de100_render_cull_wrap_offsets(De100RenderCull *cull, f32 x, f32 y,
+                               f32 width, f32 height, f32 wrap_width,
+                               f32 wrap_height, u32 layer,
+                               f32 offsets[9][2]) {
+  u32 count = 0;
+  for (i32 row = -1; row <= 1; ++row) {
+    for (i32 column = -1; column <= 1; ++column) {
+      f32 dx = (f32)column * wrap_width;
+      f32 dy = (f32)row * wrap_height;
+      if (de100_render_cull_is_visible(cull, x + dx, y + dy, width, height,
+                                       layer)) {
+        offsets[count][0] = dx;
+        offsets[count][1] = dy;
+        count++;
+      }
+    }
+  }
+  return count;
+}
+
+#endif // DE100_GAME_RENDER_CULL_H
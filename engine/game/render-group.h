@@ -0,0 +1,786 @@
+#ifndef DE100_GAME_RENDER_GROUP_H
+#define DE100_GAME_RENDER_GROUP_H
+
+#include "../_common/base.h"
+#include "backbuffer.h"
+#include "font.h"
+#include "memory-arena.h"
+#include "memory.h"
+#include "pixel-kernels.h"
+#include "radix-sort.h"
+#include "render-cull.h"
+#include "sprite.h"
+#include "thread.h"
+
+// ═══════════════════════════════════════════════════════════════════════════
+// 🎨 RENDER GROUP (Casey's Day 85/124 pattern)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// Instead of touching GameBackBuffer pixels directly during update, the game
+// RECORDS draw commands into a render group, then the whole list is executed
+// once per screen tile. Tiles are independent, so they run in parallel on
+// the work queue (see thread.h) and each tile clips every command to its own
+// rectangle — no two threads ever write the same pixel.
+//
+//   De100RenderGroup group;
+//   de100_render_group_init(&group, &state->frame_arena, 4096);
+//   de100_push_clear(&group, DE100_RGBA(20, 20, 30, 255));
+//   de100_push_rect(&group, x, y, w, h, DE100_RGBA(255, 0, 0, 128));
+//   de100_render_group_to_output_tiled(&group, buffer, memory,
+//                                      thread_context);
+//
+// ┌────┬────┬────┬────┐
+// │ T0 │ T1 │ T2 │ T3 │   Each tile = one work entry.
+// ├────┼────┼────┼────┤   Every tile walks the FULL command list, but only
+// │ T4 │ T5 │ T6 │ T7 │   touches pixels inside its own clip rect.
+// └────┴────┴────┴────┘
+//
+// Overdraw: each tile starts at the LAST command that paints all of it
+// opaquely (a clear, an opaque rect or sprite) and skips everything
+// before, so a full-screen background rect makes the clear free. A fill
+// followed by an opaque rect is fused: the fill skips the rect's pixels,
+// so a clear under a playfield costs only the border around it.
+//
+// A game that paints every pixel anyway says so and its clears are dropped
+// (in DE100_SLOW builds they paint DE100_RENDER_UNCOVERED_COLOR, so a gap
+// in the promise shows); one that needs only part of the frame cleared
+// pushes clear regions instead of a full clear:
+//
+//   de100_render_group_set_fully_covered(&group);     // tilemap frame
+//   de100_push_clear_rect(&group, 0, 0, w, 32, bg);   // only the HUD strip
+//
+// Layers: commands are drawn in the order they were pushed, unless the
+// game sorts the list once it is recorded. Sorting orders by layer, then
+// by command type, then by sprite (or blend color), so each tile walks
+// runs of the same primitive from the same texels instead of whatever
+// order update happened to push grid, towers, creeps and UI in:
+//
+//   de100_render_group_set_layer(&group, LAYER_WORLD);
+//   ...                                // push in any order
+//   de100_render_group_set_layer(&group, LAYER_UI);
+//   ...
+//   de100_render_group_sort(&group, &state->frame_arena);
+//
+// Within a layer only the push order of identical keys is kept (the sort
+// is stable): a translucent rect meant to go over sprites needs a higher
+// layer than them.
+//
+// Culling: with a De100RenderCull set (see render-cull.h), rects, sprites
+// and text that are offscreen or under an opaque panel on a higher layer
+// are dropped at push, before they take a command slot:
+//
+//   de100_render_group_set_cull(&group, &cull);
+//
+// Pixel format matches the platform upload: DE100_PIXEL_FORMAT, R,G,B,A
+// bytes by default (see backbuffer.h). DE100_RGBA packs in that order.
+//
+// All functions are static inline for zero overhead if unused.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#ifndef DE100_RENDER_TILE_SIZE
+#define DE100_RENDER_TILE_SIZE 64
+#endif
+
+#ifndef DE100_RENDER_UNCOVERED_COLOR
+#define DE100_RENDER_UNCOVERED_COLOR DE100_PIXEL_PACK(255, 0, 255, 255)
+#endif
+
+#define DE100_RENDER_LAYER_COUNT 256
+
+#define DE100_RGBA(r, g, b, a) DE100_PIXEL_PACK(r, g, b, a)
+#define DE100_RGB(r, g, b) DE100_RGBA(r, g, b, 255)
+#define DE100_RGBA_ALPHA(color) (((color) >> 24) & 0xFF)
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Commands
+// ─────────────────────────────────────────────────────────────────────────────
+
+typedef enum {
+  DE100_RENDER_COMMAND_CLEAR = 0,
+  DE100_RENDER_COMMAND_RECT,
+  DE100_RENDER_COMMAND_RECT_BLEND,
+  DE100_RENDER_COMMAND_SPRITE,
+  DE100_RENDER_COMMAND_GLYPHS,
+
+  DE100_RENDER_COMMAND_COUNT
+} De100RenderCommandType;
+
+/**
+ * Text laid out ahead of time (de100_font_layout_glyphs): tiles only read
+ * the font's glyph table and atlas, never its caches, so they can draw it
+ * in parallel.
+ */
+typedef struct {
+  const De100Font *font;
+  const De100FontPlacedGlyph *glyphs;
+  u32 glyph_count;
+} De100RenderGlyphRun;
+
+typedef struct {
+  u16 type;  // De100RenderCommandType
+  u16 layer; // < DE100_RENDER_LAYER_COUNT
+  i32 x, y, width, height; // CLEAR: the region, width 0 for the whole frame
+                           // GLYPHS: the run's ink box
+  u32 color; // SPRITE: De100SpriteBlitMode
+  // Must stay valid until the group is rasterized (the next frame, with
+  // pipelined rendering)
+  union {
+    const De100Sprite *sprite;     // SPRITE
+    const De100RenderGlyphRun *run; // GLYPHS
+  };
+} De100RenderCommand;
+
+typedef struct De100RenderGroup {
+  De100RenderCommand *commands;
+  u32 command_count;
+  u32 max_command_count;
+  // The game paints every pixel this frame: CLEAR commands are dropped.
+  // Reset with the command list.
+  bool32 is_fully_covered;
+  // RECT_BLEND mixes in linear light (blend_linear_row): no dark fringes
+  // where translucent shapes overlap, at ~2x the blend cost. Reset with
+  // the command list.
+  bool32 is_linear_blend;
+  // Stamped on every command pushed from now on. Reset with the command
+  // list.
+  u32 layer;
+  // Tests rects, sprites and text before they are pushed; NULL pushes
+  // everything. Reset with the command list.
+  De100RenderCull *cull;
+} De100RenderGroup;
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Recording
+// ─────────────────────────────────────────────────────────────────────────────
+
+de100_file_scoped_fn inline bool
+de100_render_group_init(De100RenderGroup *group, De100MemoryArena *arena,
+                        u32 max_command_count) {
+  group->commands =
+      de100_arena_push_array(arena, max_command_count, De100RenderCommand);
+  group->command_count = 0;
+  group->max_command_count = group->commands ? max_command_count : 0;
+  group->is_fully_covered = false;
+  group->is_linear_blend = false;
+  group->layer = 0;
+  group->cull = NULL;
+  return group->commands != NULL;
+}
+
+de100_file_scoped_fn inline De100RenderCommand *
+de100_render_group_push(De100RenderGroup *group, De100RenderCommandType type) {
+  if (group->command_count >= group->max_command_count) {
+    DEV_ASSERT_MSG(false, "Render group full (%u commands)",
+                   group->max_command_count);
+    return NULL;
+  }
+  De100RenderCommand *command = &group->commands[group->command_count++];
+  command->type = (u16)type;
+  command->layer = (u16)group->layer;
+  return command;
+}
+
+de100_file_scoped_fn inline void de100_push_clear(De100RenderGroup *group,
+                                                  u32 color) {
+  De100RenderCommand *command =
+      de100_render_group_push(group, DE100_RENDER_COMMAND_CLEAR);
+  if (command) {
+    command->x = 0;
+    command->y = 0;
+    command->width = 0;
+    command->height = 0;
+    command->color = color;
+  }
+}
+
+/**
+ * Clear only this region: the rest of the frame keeps whatever the
+ * commands (or, without any, the previous frame) left there.
+ */
+de100_file_scoped_fn inline void
+de100_push_clear_rect(De100RenderGroup *group, i32 x, i32 y, i32 width,
+                      i32 height, u32 color) {
+  if (width <= 0 || height <= 0) {
+    return;
+  }
+  De100RenderCommand *command =
+      de100_render_group_push(group, DE100_RENDER_COMMAND_CLEAR);
+  if (command) {
+    command->x = x;
+    command->y = y;
+    command->width = width;
+    command->height = height;
+    command->color = color;
+  }
+}
+
+/**
+ * Promise that this frame's commands paint every pixel, so clears are
+ * wasted work. Holds until the command list is reset.
+ */
+de100_file_scoped_fn inline void
+de100_render_group_set_fully_covered(De100RenderGroup *group) {
+  group->is_fully_covered = true;
+}
+
+/**
+ * Blend this frame's translucent rects in linear light (see
+ * pixel-kernels.h). Holds until the command list is reset.
+ */
+de100_file_scoped_fn inline void
+de100_render_group_set_linear_blend(De100RenderGroup *group) {
+  group->is_linear_blend = true;
+}
+
+/**
+ * Cull the rects, sprites and text pushed from now on against `cull`
+ * (screen pixels, the current layer). Holds until the command list is
+ * reset; `cull` must outlive the pushes.
+ */
+de100_file_scoped_fn inline void
+de100_render_group_set_cull(De100RenderGroup *group, De100RenderCull *cull) {
+  group->cull = cull;
+}
+
+/** Would a push of this screen rect survive the group's cull? */
+de100_file_scoped_fn inline bool
+de100_render_group_passes_cull(De100RenderGroup *group, i32 x, i32 y,
+                               i32 width, i32 height) {
+  return !group->cull ||
+         de100_render_cull_test_screen(group->cull, (f32)x, (f32)y,
+                                       (f32)width, (f32)height,
+                                       group->layer) ==
+             DE100_RENDER_CULL_VISIBLE;
+}
+
+/** Layer for the commands pushed next (see Layers above). */
+de100_file_scoped_fn inline void
+de100_render_group_set_layer(De100RenderGroup *group, u32 layer) {
+  DEV_ASSERT_MSG(layer < DE100_RENDER_LAYER_COUNT, "Render layer %u", layer);
+  group->layer = layer < DE100_RENDER_LAYER_COUNT
+                     ? layer
+                     : DE100_RENDER_LAYER_COUNT - 1;
+}
+
+// Picks opaque fill or alpha blend from the color's alpha channel.
+de100_file_scoped_fn inline void de100_push_rect(De100RenderGroup *group,
+                                                 i32 x, i32 y, i32 width,
+                                                 i32 height, u32 color) {
+  u32 alpha = DE100_RGBA_ALPHA(color);
+  if (alpha == 0 || width <= 0 || height <= 0 ||
+      !de100_render_group_passes_cull(group, x, y, width, height)) {
+    return;
+  }
+
+  De100RenderCommand *command = de100_render_group_push(
+      group, alpha == 255 ? DE100_RENDER_COMMAND_RECT
+                          : DE100_RENDER_COMMAND_RECT_BLEND);
+  if (command) {
+    command->x = x;
+    command->y = y;
+    command->width = width;
+    command->height = height;
+    command->color = color;
+  }
+}
+
+de100_file_scoped_fn inline void de100_push_sprite(De100RenderGroup *group,
+                                                   const De100Sprite *sprite,
+                                                   i32 x, i32 y,
+                                                   De100SpriteBlitMode mode) {
+  if (!sprite->pixels || sprite->width <= 0 || sprite->height <= 0 ||
+      !de100_render_group_passes_cull(group, x, y, sprite->width,
+                                      sprite->height)) {
+    return;
+  }
+
+  De100RenderCommand *command =
+      de100_render_group_push(group, DE100_RENDER_COMMAND_SPRITE);
+  if (command) {
+    command->x = x;
+    command->y = y;
+    command->width = sprite->width;
+    command->height = sprite->height;
+    command->color = (u32)mode;
+    command->sprite = sprite;
+  }
+}
+
+/**
+ * Text from `run` with the top of its line box at (x, y), coverage scaled
+ * by `color`'s alpha like de100_font_draw.
+ */
+de100_file_scoped_fn inline void
+de100_push_glyphs(De100RenderGroup *group, const De100RenderGlyphRun *run,
+                  i32 x, i32 y, i32 width, u32 color) {
+  if (run->glyph_count == 0 || DE100_RGBA_ALPHA(color) == 0) {
+    return;
+  }
+
+  // Ink may overhang the advance box; the face bbox bounds by how much
+  const De100Font *font = run->font;
+  i32 ink_x = x + font->ink_left;
+  i32 ink_y = y + font->ascent + font->ink_top;
+  i32 ink_width = width + font->ink_right - font->ink_left;
+  i32 ink_height = font->ink_bottom - font->ink_top;
+  if (!de100_render_group_passes_cull(group, ink_x, ink_y, ink_width,
+                                      ink_height)) {
+    return;
+  }
+
+  De100RenderCommand *command =
+      de100_render_group_push(group, DE100_RENDER_COMMAND_GLYPHS);
+  if (command) {
+    command->x = ink_x;
+    command->y = ink_y;
+    command->width = ink_width;
+    command->height = ink_height;
+    command->color = color;
+    command->run = run;
+  }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Sorting
+// ─────────────────────────────────────────────────────────────────────────────
+
+// Sort key: layer (8 bits) | type (4) | texture (20). The texture bits
+// group sprites and text by address and translucent rects by color
+// (linear blend reuses one color's tables across a run).
+#define DE100_RENDER_SORT_TYPE_SHIFT 20
+#define DE100_RENDER_SORT_LAYER_SHIFT 24
+#define DE100_RENDER_SORT_TEXTURE_MASK 0xFFFFFu
+
+de100_file_scoped_fn inline u32
+de100_render_command_sort_key(const De100RenderCommand *command) {
+  u32 texture = 0;
+  if (command->type == DE100_RENDER_COMMAND_SPRITE) {
+    texture = (u32)((uintptr_t)command->sprite >> 4);
+  } else if (command->type == DE100_RENDER_COMMAND_GLYPHS) {
+    texture = (u32)((uintptr_t)command->run->font >> 4);
+  } else if (command->type == DE100_RENDER_COMMAND_RECT_BLEND) {
+    texture = command->color ^ (command->color >> 20);
+  }
+  return (u32)command->layer << DE100_RENDER_SORT_LAYER_SHIFT |
+         (u32)command->type << DE100_RENDER_SORT_TYPE_SHIFT |
+         (texture & DE100_RENDER_SORT_TEXTURE_MASK);
+}
+
+/**
+ * Reorder the recorded commands by (layer, type, texture), keeping push
+ * order among equal keys. Scratch comes from a temporary scope of `arena`
+ * (the frame arena); a list already in key order is left as is.
+ *
+ * @return false (list unsorted) if the arena can't hold the scratch
+ */
+de100_file_scoped_fn inline bool de100_render_group_sort(
+    De100RenderGroup *group, De100MemoryArena *arena) {
+  DE100_TIMED_FUNCTION();
+  u32 count = group->command_count;
+  if (count < 2) {
+    return true;
+  }
+
+  De100TemporaryMemory temp = de100_arena_begin_temp(arena);
+  // Key above, command index below as the sort's payload
+  u64 *keys = de100_arena_push_array(arena, count, u64);
+  u64 *scratch = de100_arena_push_array(arena, count, u64);
+  De100RenderCommand *sorted =
+      de100_arena_push_array(arena, count, De100RenderCommand);
+  if (!keys || !scratch || !sorted) {
+    de100_arena_end_temp(temp);
+    return false;
+  }
+
+  bool is_ordered = true;
+  u32 previous_key = 0;
+  for (u32 i = 0; i < count; ++i) {
+    u32 key = de100_render_command_sort_key(&group->commands[i]);
+    is_ordered = is_ordered && key >= previous_key;
+    previous_key = key;
+    keys[i] = (u64)key << 32 | i;
+  }
+
+  if (!is_ordered) {
+    de100_radix_sort_u64(keys, scratch, count, 32);
+    for (u32 i = 0; i < count; ++i) {
+      sorted[i] = group->commands[(u32)keys[i]];
+    }
+    memcpy(group->commands, sorted, (size_t)count * sizeof(*sorted));
+  }
+  de100_arena_end_temp(temp);
+  return true;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Rasterization (one clip rect at a time)
+// ─────────────────────────────────────────────────────────────────────────────
+
+de100_file_scoped_fn inline void
+de100_render_fill_clipped(GameBackBuffer *buffer, De100RenderClipRect clip,
+                          i32 x, i32 y, i32 width, i32 height, u32 color) {
+  i32 x0 = x > clip.min_x ? x : clip.min_x;
+  i32 y0 = y > clip.min_y ? y : clip.min_y;
+  i32 x1 = x + width < clip.max_x ? x + width : clip.max_x;
+  i32 y1 = y + height < clip.max_y ? y + height : clip.max_y;
+
+  if (x1 <= x0) {
+    return;
+  }
+
+  de100_pixel_fill_row_t *fill_row = de100_pixel_kernels_get()->fill_row;
+  u8 *row = (u8 *)buffer->memory.base + (size_t)y0 * (size_t)buffer->pitch;
+  for (i32 py = y0; py < y1; ++py) {
+    fill_row((u32 *)row + x0, x1 - x0, color);
+    row += buffer->pitch;
+  }
+}
+
+de100_file_scoped_fn inline void
+de100_render_blend_rows_clipped(GameBackBuffer *buffer,
+                                De100RenderClipRect clip, i32 x, i32 y,
+                                i32 width, i32 height, u32 color,
+                                de100_pixel_blend_row_t *blend_row) {
+  i32 x0 = x > clip.min_x ? x : clip.min_x;
+  i32 y0 = y > clip.min_y ? y : clip.min_y;
+  i32 x1 = x + width < clip.max_x ? x + width : clip.max_x;
+  i32 y1 = y + height < clip.max_y ? y + height : clip.max_y;
+
+  if (x1 <= x0) {
+    return;
+  }
+
+  u8 *row = (u8 *)buffer->memory.base + (size_t)y0 * (size_t)buffer->pitch;
+  for (i32 py = y0; py < y1; ++py) {
+    blend_row((u32 *)row + x0, x1 - x0, color);
+    row += buffer->pitch;
+  }
+}
+
+de100_file_scoped_fn inline void
+de100_render_blend_clipped(GameBackBuffer *buffer, De100RenderClipRect clip,
+                           i32 x, i32 y, i32 width, i32 height, u32 color) {
+  de100_render_blend_rows_clipped(buffer, clip, x, y, width, height, color,
+                                  de100_pixel_kernels_get()->blend_row);
+}
+
+/** de100_render_blend_clipped in linear light. */
+de100_file_scoped_fn inline void
+de100_render_blend_linear_clipped(GameBackBuffer *buffer,
+                                  De100RenderClipRect clip, i32 x, i32 y,
+                                  i32 width, i32 height, u32 color) {
+  // Rows may be too short to build the color's tables on their own
+  if ((i64)width * height >= 4 * DE100_PIXEL_LINEAR_TABLE_MIN_ROW) {
+    de100_pixel_linear_blend_table(color, true);
+  }
+  de100_render_blend_rows_clipped(buffer, clip, x, y, width, height, color,
+                                  de100_pixel_kernels_get()->blend_linear_row);
+}
+
+de100_file_scoped_fn inline void
+de100_render_glyphs_clipped(GameBackBuffer *buffer, De100RenderClipRect clip,
+                            const De100RenderGlyphRun *run, i32 pen_x,
+                            i32 baseline, u32 color) {
+  const De100Font *font = run->font;
+  De100PixelKernels *kernels = de100_pixel_kernels_get();
+  de100_pixel_coverage_row_t *row_fn = font->is_linear_blend
+                                           ? kernels->coverage_linear_row
+                                           : kernels->coverage_row;
+  for (u32 i = 0; i < run->glyph_count; ++i) {
+    De100FontPlacedGlyph placed = run->glyphs[i];
+    de100_font_blit_glyph_clipped(buffer, clip, font,
+                                  &font->glyphs[placed.glyph],
+                                  pen_x + placed.x, baseline, color, row_fn);
+  }
+}
+
+/**
+ * Fill `clip` except where it overlaps the `hole` rect (which the next
+ * command paints anyway).
+ */
+de100_file_scoped_fn inline void
+de100_render_fill_around_clipped(GameBackBuffer *buffer,
+                                 De100RenderClipRect clip, i32 x, i32 y,
+                                 i32 width, i32 height, u32 color) {
+  i32 x0 = x > clip.min_x ? x : clip.min_x;
+  i32 y0 = y > clip.min_y ? y : clip.min_y;
+  i32 x1 = x + width < clip.max_x ? x + width : clip.max_x;
+  i32 y1 = y + height < clip.max_y ? y + height : clip.max_y;
+
+  if (x1 <= x0 || y1 <= y0) {
+    de100_render_fill_clipped(buffer, clip, clip.min_x, clip.min_y,
+                              clip.max_x - clip.min_x,
+                              clip.max_y - clip.min_y, color);
+    return;
+  }
+
+  i32 clip_width = clip.max_x - clip.min_x;
+  de100_render_fill_clipped(buffer, clip, clip.min_x, clip.min_y, clip_width,
+                            y0 - clip.min_y, color);
+  de100_render_fill_clipped(buffer, clip, clip.min_x, y0, x0 - clip.min_x,
+                            y1 - y0, color);
+  de100_render_fill_clipped(buffer, clip, x1, y0, clip.max_x - x1, y1 - y0,
+                            color);
+  de100_render_fill_clipped(buffer, clip, clip.min_x, y1, clip_width,
+                            clip.max_y - y1, color);
+}
+
+/** The command's rect, with a whole-frame CLEAR resolved to `clip`. */
+de100_file_scoped_fn inline De100RenderClipRect
+de100_render_command_bounds(const De100RenderCommand *command,
+                            De100RenderClipRect clip) {
+  if (command->type == DE100_RENDER_COMMAND_CLEAR && command->width == 0) {
+    return clip;
+  }
+  De100RenderClipRect bounds = {command->x, command->y,
+                                command->x + command->width,
+                                command->y + command->height};
+  return bounds;
+}
+
+/** Does `command` paint every pixel of `clip` opaquely? */
+de100_file_scoped_fn inline bool
+de100_render_command_covers(const De100RenderGroup *group,
+                            const De100RenderCommand *command,
+                            De100RenderClipRect clip) {
+  bool is_opaque =
+      (command->type == DE100_RENDER_COMMAND_CLEAR &&
+       !group->is_fully_covered) ||
+      command->type == DE100_RENDER_COMMAND_RECT ||
+      (command->type == DE100_RENDER_COMMAND_SPRITE &&
+       (De100SpriteBlitMode)command->color == DE100_SPRITE_BLIT_OPAQUE);
+  if (!is_opaque) {
+    return false;
+  }
+  De100RenderClipRect bounds = de100_render_command_bounds(command, clip);
+  return bounds.min_x <= clip.min_x && bounds.min_y <= clip.min_y &&
+         bounds.max_x >= clip.max_x && bounds.max_y >= clip.max_y;
+}
+
+de100_file_scoped_fn inline void
+de100_render_command_execute(De100RenderGroup *group,
+                             De100RenderCommand *command,
+                             GameBackBuffer *buffer,
+                             De100RenderClipRect clip) {
+  switch (command->type) {
+  case DE100_RENDER_COMMAND_CLEAR: {
+    u32 color = command->color;
+    if (group->is_fully_covered) {
+#if DE100_SLOW
+      color = DE100_RENDER_UNCOVERED_COLOR;
+#else
+      break;
+#endif
+    }
+    De100RenderClipRect bounds = de100_render_command_bounds(command, clip);
+    de100_render_fill_clipped(buffer, clip, bounds.min_x, bounds.min_y,
+                              bounds.max_x - bounds.min_x,
+                              bounds.max_y - bounds.min_y, color);
+  } break;
+
+  case DE100_RENDER_COMMAND_RECT: {
+    de100_render_fill_clipped(buffer, clip, command->x, command->y,
+                              command->width, command->height,
+                              command->color);
+  } break;
+
+  case DE100_RENDER_COMMAND_RECT_BLEND: {
+    if (group->is_linear_blend) {
+      de100_render_blend_linear_clipped(buffer, clip, command->x, command->y,
+                                        command->width, command->height,
+                                        command->color);
+    } else {
+      de100_render_blend_clipped(buffer, clip, command->x, command->y,
+                                 command->width, command->height,
+                                 command->color);
+    }
+  } break;
+
+  case DE100_RENDER_COMMAND_SPRITE: {
+    de100_sprite_blit_clipped(buffer, clip, command->sprite, command->x,
+                              command->y,
+                              (De100SpriteBlitMode)command->color);
+  } break;
+
+  case DE100_RENDER_COMMAND_GLYPHS: {
+    // Back from the ink box to the pen and baseline (de100_push_glyphs)
+    const De100Font *font = command->run->font;
+    de100_render_glyphs_clipped(buffer, clip, command->run,
+                                command->x - font->ink_left,
+                                command->y - font->ink_top, command->color);
+  } break;
+
+  default: {
+    DEV_ASSERT_MSG(false, "Unknown render command type %d",
+                   (int)command->type);
+  } break;
+  }
+}
+
+/**
+ * Execute the commands, restricted to `clip`, from the last one that
+ * covers it (see Overdraw above).
+ * `clip` must already be inside the buffer bounds.
+ */
+de100_file_scoped_fn inline void
+de100_render_group_to_output_clipped(De100RenderGroup *group,
+                                     GameBackBuffer *buffer,
+                                     De100RenderClipRect clip) {
+  u32 first = group->command_count;
+  while (first > 0 &&
+         !de100_render_command_covers(group, &group->commands[first - 1],
+                                      clip)) {
+    --first;
+  }
+  u32 i = first > 0 ? first - 1 : 0;
+
+  // Fuse a covering fill with the opaque rect or sprite drawn over it
+  if (first > 0 && first < group->command_count) {
+    De100RenderCommand *cover = &group->commands[i];
+    De100RenderCommand *next = &group->commands[first];
+    bool next_is_opaque =
+        next->type == DE100_RENDER_COMMAND_RECT ||
+        (next->type == DE100_RENDER_COMMAND_SPRITE &&
+         (De100SpriteBlitMode)next->color == DE100_SPRITE_BLIT_OPAQUE);
+    if (cover->type != DE100_RENDER_COMMAND_SPRITE && next_is_opaque) {
+      de100_render_fill_around_clipped(buffer, clip, next->x, next->y,
+                                       next->width, next->height,
+                                       cover->color);
+      i = first;
+    }
+  }
+
+  for (; i < group->command_count; ++i) {
+    de100_render_command_execute(group, &group->commands[i], buffer, clip);
+  }
+}
+
+/**
+ * Report every command's footprint to the backbuffer dirty region.
+ * Runs once on the calling thread, never per tile.
+ */
+de100_file_scoped_fn inline void
+de100_render_group_mark_dirty(De100RenderGroup *group,
+                              GameBackBuffer *buffer) {
+  if (!buffer->dirty.is_tracking) {
+    return;
+  }
+  if (group->is_fully_covered) {
+    de100_backbuffer_mark_all_dirty(buffer);
+    return;
+  }
+
+  for (u32 i = 0; i < group->command_count && !buffer->dirty.full_frame;
+       ++i) {
+    De100RenderCommand *command = &group->commands[i];
+    if (command->type == DE100_RENDER_COMMAND_CLEAR && command->width == 0) {
+      de100_backbuffer_mark_all_dirty(buffer);
+    } else {
+      de100_backbuffer_mark_dirty(buffer, command->x, command->y,
+                                  command->width, command->height);
+    }
+  }
+}
+
+/**
+ * Single-threaded execution over the whole buffer.
+ */
+de100_file_scoped_fn inline void
+de100_render_group_to_output(De100RenderGroup *group, GameBackBuffer *buffer) {
+  DE100_TIMED_FUNCTION();
+  if (buffer->is_rendering_disabled) {
+    return; // Replay fast-forward: simulate only
+  }
+  De100RenderClipRect clip = {0, 0, buffer->width, buffer->height};
+  de100_render_group_mark_dirty(group, buffer);
+  de100_render_group_to_output_clipped(group, buffer, clip);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Tiled, multithreaded execution
+// ─────────────────────────────────────────────────────────────────────────────
+
+typedef struct {
+  De100RenderGroup *group;
+  GameBackBuffer *buffer;
+  De100RenderClipRect clip;
+} De100TileRenderWork;
+
+de100_file_scoped_fn inline
+DE100_WORK_QUEUE_CALLBACK(de100_do_tile_render_work) {
+  (void)thread_context;
+  De100TileRenderWork *work = (De100TileRenderWork *)data;
+  DE100_TIMED_BLOCK("render_tile");
+  de100_render_group_to_output_clipped(work->group, work->buffer, work->clip);
+}
+
+/**
+ * Split the buffer into DE100_RENDER_TILE_SIZE tiles and render them on the
+ * work queue. Tile descriptors live in the caller's scratch arena for the
+ * duration of the call. Falls back to running a tile inline when the queue
+ * is missing or full, so the frame is always complete on return.
+ */
+de100_file_scoped_fn inline void de100_render_group_to_output_tiled(
+    De100RenderGroup *group, GameBackBuffer *buffer, GameMemory *memory,
+    ThreadContext *thread_context) {
+  DE100_TIMED_FUNCTION();
+  if (buffer->is_rendering_disabled) {
+    return;
+  }
+  i32 tile_count_x =
+      (buffer->width + DE100_RENDER_TILE_SIZE - 1) / DE100_RENDER_TILE_SIZE;
+  i32 tile_count_y =
+      (buffer->height + DE100_RENDER_TILE_SIZE - 1) / DE100_RENDER_TILE_SIZE;
+  i32 tile_count = tile_count_x * tile_count_y;
+
+  if (!memory->work_queue || !thread_context->scratch_arena ||
+      tile_count <= 1) {
+    de100_render_group_to_output(group, buffer);
+    return;
+  }
+
+  // Pick the SIMD kernels here, before any worker can race on the lazy init
+  de100_pixel_kernels_get();
+  de100_render_group_mark_dirty(group, buffer);
+
+  De100MemoryArena *scratch = thread_context->scratch_arena;
+  De100TemporaryMemory temp = de100_arena_begin_temp(scratch);
+
+  De100TileRenderWork *work_items =
+      de100_arena_push_array(scratch, tile_count, De100TileRenderWork);
+  if (!work_items) {
+    de100_arena_end_temp(temp);
+    de100_render_group_to_output(group, buffer);
+    return;
+  }
+
+  i32 index = 0;
+  for (i32 tile_y = 0; tile_y < tile_count_y; ++tile_y) {
+    for (i32 tile_x = 0; tile_x < tile_count_x; ++tile_x) {
+      De100TileRenderWork *work = &work_items[index++];
+      work->group = group;
+      work->buffer = buffer;
+      work->clip.min_x = tile_x * DE100_RENDER_TILE_SIZE;
+      work->clip.min_y = tile_y * DE100_RENDER_TILE_SIZE;
+      work->clip.max_x = work->clip.min_x + DE100_RENDER_TILE_SIZE;
+      work->clip.max_y = work->clip.min_y + DE100_RENDER_TILE_SIZE;
+      if (work->clip.max_x > buffer->width) {
+        work->clip.max_x = buffer->width;
+      }
+      if (work->clip.max_y > buffer->height) {
+        work->clip.max_y = buffer->height;
+      }
+
+      if (!memory->add_work_entry(memory->work_queue,
+                                  de100_do_tile_render_work, work)) {
+        de100_do_tile_render_work(thread_context, work);
+      }
+    }
+  }
+
+  memory->complete_all_work(memory->work_queue);
+  de100_arena_end_temp(temp);
+}
+
+#endif // DE100_GAME_RENDER_GROUP_H
@@ -0,0 +1,329 @@
+#include "save-game.h"
+#include "kernels.h"
+
+#include <string.h>
+
+_Static_assert(sizeof(De100SaveHeader) == 48,
+               "De100SaveHeader is a file format: no padding");
+_Static_assert(sizeof(De100SaveFieldRecord) == 16,
+               "De100SaveFieldRecord is a file format: no padding");
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ERROR MESSAGES
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_global_var const char *g_save_error_messages[] = {
+    [DE100_SAVE_SUCCESS] = "Success",
+    [DE100_SAVE_ERROR_NULL_ARGUMENT] =
+        "NULL argument (or no hash64 kernel bound)",
+    [DE100_SAVE_ERROR_BUFFER_TOO_SMALL] =
+        "Save buffer smaller than de100_save_size()",
+    [DE100_SAVE_ERROR_PATH_TOO_LONG] = "Save path too long",
+    [DE100_SAVE_ERROR_BUSY] = "Previous save still being written",
+    [DE100_SAVE_ERROR_SUBMIT_FAILED] = "Async I/O queue rejected the save",
+    [DE100_SAVE_ERROR_OPEN_FAILED] = "Failed to map save file",
+    [DE100_SAVE_ERROR_NOT_A_SAVE] = "Not a .de100sav file",
+    [DE100_SAVE_ERROR_VERSION_MISMATCH] = "Save file format version mismatch",
+    [DE100_SAVE_ERROR_CORRUPT] = "Save file table or field out of bounds",
+    [DE100_SAVE_ERROR_CHECKSUM_MISMATCH] =
+        "Save file checksum mismatch (truncated or damaged)",
+};
+
+const char *de100_save_strerror(De100SaveErrorCode code) {
+  if (code >= 0 && code < DE100_SAVE_ERROR_COUNT) {
+    return g_save_error_messages[code];
+  }
+  return "Unknown save error";
+}
+
+de100_file_scoped_fn inline De100SaveResult
+save_result(De100SaveErrorCode code) {
+  return (De100SaveResult){
+      .success = code == DE100_SAVE_SUCCESS,
+      .error_code = code,
+  };
+}
+
+de100_file_scoped_fn inline de100_hash64_t *save_hash(GameMemory *memory) {
+  return memory && memory->kernels ? memory->kernels->hash64 : NULL;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// SCHEMA
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn inline u32 save_name_hash(const char *name) {
+  u32 hash = 2166136261u;
+  for (const u8 *c = (const u8 *)name; *c; ++c) {
+    hash = (hash ^ *c) * 16777619u;
+  }
+  return hash;
+}
+
+de100_file_scoped_fn inline u64 save_fnv64(u64 hash, const void *data,
+                                           u64 size) {
+  const u8 *bytes = (const u8 *)data;
+  for (u64 i = 0; i < size; ++i) {
+    hash = (hash ^ bytes[i]) * 1099511628211ull;
+  }
+  return hash;
+}
+
+u64 de100_save_schema_id(const De100SaveSchema *schema) {
+  u64 id = save_fnv64(14695981039346656037ull, &schema->size,
+                      sizeof(schema->size));
+  for (u32 i = 0; i < schema->field_count; ++i) {
+    const De100SaveField *field = &schema->fields[i];
+    id = save_fnv64(id, field->name, strlen(field->name) + 1);
+    id = save_fnv64(id, &field->type, sizeof(field->type));
+    id = save_fnv64(id, &field->offset, sizeof(field->offset));
+    id = save_fnv64(id, &field->size, sizeof(field->size));
+  }
+  return id;
+}
+
+de100_file_scoped_fn inline u64 save_payload_offset(u32 field_count) {
+  u64 table_end = sizeof(De100SaveHeader) +
+                  (u64)field_count * sizeof(De100SaveFieldRecord);
+  return (table_end + DE100_SAVE_PAYLOAD_ALIGNMENT - 1) &
+         ~(u64)(DE100_SAVE_PAYLOAD_ALIGNMENT - 1);
+}
+
+u64 de100_save_size(const De100SaveSchema *schema) {
+  return save_payload_offset(schema->field_count) + schema->size;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// WRITING
+// ═══════════════════════════════════════════════════════════════════════════
+
+u64 de100_save_serialize(const De100SaveSchema *schema, const void *data,
+                         void *out, u64 capacity, de100_hash64_t *hash) {
+  u64 file_size = de100_save_size(schema);
+  if (!out || !data || !hash || capacity < file_size) {
+    return 0;
+  }
+
+  u8 *base = (u8 *)out;
+  u64 payload_offset = save_payload_offset(schema->field_count);
+  De100SaveFieldRecord *records =
+      (De100SaveFieldRecord *)(base + sizeof(De100SaveHeader));
+  for (u32 i = 0; i < schema->field_count; ++i) {
+    const De100SaveField *field = &schema->fields[i];
+    records[i] = (De100SaveFieldRecord){
+        .name_hash = save_name_hash(field->name),
+        .type = (u16)field->type,
+        .offset = field->offset,
+        .size = field->size,
+    };
+  }
+  u8 *table_end = (u8 *)(records + schema->field_count);
+  memset(table_end, 0, (size_t)(base + payload_offset - table_end));
+  memcpy(base + payload_offset, data, schema->size);
+
+  De100SaveHeader *header = (De100SaveHeader *)base;
+  *header = (De100SaveHeader){
+      .magic = DE100_SAVE_MAGIC,
+      .version = DE100_SAVE_VERSION,
+      .header_size = (u16)sizeof(De100SaveHeader),
+      .schema_id = de100_save_schema_id(schema),
+      .file_size = file_size,
+      .field_count = schema->field_count,
+      .fields_offset = (u32)sizeof(De100SaveHeader),
+      .payload_offset = (u32)payload_offset,
+      .payload_size = schema->size,
+  };
+  header->checksum = hash(base + sizeof(De100SaveHeader),
+                          file_size - sizeof(De100SaveHeader),
+                          DE100_SAVE_HASH_SEED);
+  return file_size;
+}
+
+void de100_save_writer_init(De100SaveWriter *writer, void *buffer,
+                            u64 capacity) {
+  memset(writer, 0, sizeof(*writer));
+  writer->buffer = (u8 *)buffer;
+  writer->capacity = capacity;
+}
+
+De100SaveResult de100_save_write(De100SaveWriter *writer, GameMemory *memory,
+                                 const De100SaveSchema *schema,
+                                 const void *data, const char *path) {
+  de100_hash64_t *hash = save_hash(memory);
+  if (!writer || !schema || !data || !path || !hash || !memory->async_io ||
+      !memory->async_io_submit) {
+    return save_result(DE100_SAVE_ERROR_NULL_ARGUMENT);
+  }
+  // The queue still reads buffer and path: leave both alone
+  if (de100_save_writer_is_busy(writer)) {
+    return save_result(DE100_SAVE_ERROR_BUSY);
+  }
+  size_t path_length = strlen(path);
+  if (path_length >= sizeof(writer->path)) {
+    return save_result(DE100_SAVE_ERROR_PATH_TOO_LONG);
+  }
+
+  u64 size = de100_save_serialize(schema, data, writer->buffer,
+                                  writer->capacity, hash);
+  if (size == 0) {
+    return save_result(DE100_SAVE_ERROR_BUFFER_TOO_SMALL);
+  }
+  memcpy(writer->path, path, path_length + 1);
+
+  writer->request = (De100AsyncIORequest){
+      .op = DE100_ASYNC_IO_OP_SAVE,
+      .path = writer->path,
+      .buffer = writer->buffer,
+      .size = size,
+  };
+  if (!memory->async_io_submit(memory->async_io, &writer->request)) {
+    return save_result(DE100_SAVE_ERROR_SUBMIT_FAILED);
+  }
+  return save_result(DE100_SAVE_SUCCESS);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// LOADING
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn De100SaveErrorCode save_validate(const u8 *base,
+                                                      u64 file_size,
+                                                      de100_hash64_t *hash) {
+  if (file_size < sizeof(De100SaveHeader)) {
+    return DE100_SAVE_ERROR_NOT_A_SAVE;
+  }
+
+  const De100SaveHeader *header = (const De100SaveHeader *)base;
+  if (header->magic != DE100_SAVE_MAGIC) {
+    return DE100_SAVE_ERROR_NOT_A_SAVE;
+  }
+  if (header->version != DE100_SAVE_VERSION ||
+      header->header_size != sizeof(De100SaveHeader)) {
+    return DE100_SAVE_ERROR_VERSION_MISMATCH;
+  }
+
+  u64 fields_end = (u64)header->fields_offset +
+                   (u64)header->field_count * sizeof(De100SaveFieldRecord);
+  u64 payload_end = (u64)header->payload_offset + header->payload_size;
+  if (header->file_size != file_size || fields_end > file_size ||
+      payload_end > file_size || header->fields_offset % 8 != 0 ||
+      header->payload_offset % DE100_SAVE_PAYLOAD_ALIGNMENT != 0) {
+    return DE100_SAVE_ERROR_CORRUPT;
+  }
+
+  const De100SaveFieldRecord *records =
+      (const De100SaveFieldRecord *)(base + header->fields_offset);
+  for (u32 i = 0; i < header->field_count; ++i) {
+    if (records[i].offset > header->payload_size ||
+        records[i].size > header->payload_size - records[i].offset) {
+      return DE100_SAVE_ERROR_CORRUPT;
+    }
+  }
+
+  // Last: one linear pass over the whole file
+  u64 checksum = hash(base + sizeof(De100SaveHeader),
+                      file_size - sizeof(De100SaveHeader),
+                      DE100_SAVE_HASH_SEED);
+  return checksum == header->checksum ? DE100_SAVE_SUCCESS
+                                      : DE100_SAVE_ERROR_CHECKSUM_MISMATCH;
+}
+
+De100SaveResult de100_save_open(De100SaveFile *file, GameMemory *memory,
+                                const char *path) {
+  de100_hash64_t *hash = save_hash(memory);
+  if (!file || !path || !hash) {
+    return save_result(DE100_SAVE_ERROR_NULL_ARGUMENT);
+  }
+  memset(file, 0, sizeof(*file));
+
+  // Sequential: the checksum reads every byte once, front to back
+  De100FileMapping mapping =
+      de100_file_map_readonly(path, DE100_FILE_MAP_ADVICE_SEQUENTIAL);
+  if (!mapping.success) {
+    return save_result(DE100_SAVE_ERROR_OPEN_FAILED);
+  }
+
+  const u8 *base = (const u8 *)mapping.data;
+  De100SaveErrorCode code = base ? save_validate(base, mapping.size, hash)
+                                 : DE100_SAVE_ERROR_NOT_A_SAVE;
+  if (code != DE100_SAVE_SUCCESS) {
+    de100_file_unmap(&mapping);
+    return save_result(code);
+  }
+
+  file->mapping = mapping;
+  file->header = (const De100SaveHeader *)base;
+  file->fields =
+      (const De100SaveFieldRecord *)(base + file->header->fields_offset);
+  file->payload = base + file->header->payload_offset;
+  return save_result(DE100_SAVE_SUCCESS);
+}
+
+void de100_save_close(De100SaveFile *file) {
+  if (!file) {
+    return;
+  }
+  de100_file_unmap(&file->mapping);
+  memset(file, 0, sizeof(*file));
+}
+
+const void *de100_save_view(const De100SaveFile *file,
+                            const De100SaveSchema *schema) {
+  if (!file || !file->header || !schema ||
+      file->header->payload_size != schema->size ||
+      file->header->schema_id != de100_save_schema_id(schema)) {
+    return NULL;
+  }
+  return file->payload;
+}
+
+u32 de100_save_read(const De100SaveFile *file, const De100SaveSchema *schema,
+                    void *out) {
+  if (!file || !file->header || !schema || !out) {
+    return 0;
+  }
+  u8 *destination = (u8 *)out;
+
+  if (de100_save_view(file, schema)) {
+    memcpy(destination, file->payload, schema->size);
+    return schema->field_count;
+  }
+
+  // Layout changed: match by name, copy what both versions agree on
+  u32 restored = 0;
+  for (u32 i = 0; i < schema->field_count; ++i) {
+    const De100SaveField *field = &schema->fields[i];
+    u32 name_hash = save_name_hash(field->name);
+    for (u32 j = 0; j < file->header->field_count; ++j) {
+      const De100SaveFieldRecord *record = &file->fields[j];
+      if (record->name_hash != name_hash || record->type != field->type) {
+        continue;
+      }
+      if (field->type != DE100_SAVE_TYPE_BYTES &&
+          record->size != field->size) {
+        break; // Same scalar type, other size: not ours
+      }
+      u32 size = record->size < field->size ? record->size : field->size;
+      memcpy(destination + field->offset, file->payload + record->offset,
+             size);
+      ++restored;
+      break;
+    }
+  }
+  return restored;
+}
+
+De100SaveResult de100_save_load(GameMemory *memory, const char *path,
+                                const De100SaveSchema *schema, void *out) {
+  if (!schema || !out) {
+    return save_result(DE100_SAVE_ERROR_NULL_ARGUMENT);
+  }
+  De100SaveFile file;
+  De100SaveResult result = de100_save_open(&file, memory, path);
+  if (!result.success) {
+    return result;
+  }
+  de100_save_read(&file, schema, out);
+  de100_save_close(&file);
+  return result;
+}
@@ -0,0 +1,279 @@
+#ifndef DE100_GAME_SAVE_GAME_H
+#define DE100_GAME_SAVE_GAME_H
+
+#include "../_common/base.h"
+#include "../_common/file.h"
+#include "../_common/hash.h"
+#include "async-io.h"
+#include "memory.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// 💾 SAVE GAMES (.de100sav)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// A save is a plain struct declared through a field list. The list
+// generates both the struct and its schema (name, type, offset, size of
+// every field), so the file can describe its own layout:
+//
+//   typedef u32 SnakeTopScores[10];
+//   #define SNAKE_SAVE_FIELDS(FIELD)     (one FIELD per continued line)
+//     FIELD(u32, best_score)
+//     FIELD(u32, games_played)
+//     FIELD(SnakeTopScores, top_scores)
+//   DE100_SAVE_DEFINE(SnakeSave, SNAKE_SAVE_FIELDS)
+//
+//   // Saving: serialize (a memcpy) and queue, never waits
+//   de100_save_write(&state->save_writer, memory,
+//                    de100_save_schema_SnakeSave(), &state->save, path);
+//
+//   // Loading: map, checksum, copy
+//   de100_save_load(memory, path, de100_save_schema_SnakeSave(),
+//                   &state->save);
+//
+// The file is written through the async I/O queue's SAVE op ("<path>.tmp"
+// then rename), so a crash mid-save keeps the previous file and the frame
+// only pays for the copy into the writer's buffer.
+//
+//   ┌────────────────────────┐ 0
+//   │ De100SaveHeader        │ schema id, checksum of the rest
+//   ├────────────────────────┤ fields_offset
+//   │ De100SaveFieldRecord   │ × field_count
+//   ├────────────────────────┤ payload_offset (DE100_SAVE_PAYLOAD_ALIGNMENT)
+//   │ the struct's bytes     │
+//   └────────────────────────┘
+//
+// Loading maps the file and validates it in place: header, bounds, one
+// hash64 pass. If the schema id matches, the payload IS the struct
+// (de100_save_view returns a pointer into the mapping). Otherwise fields
+// are matched by name: a field with the same name and type is copied
+// (arrays and byte blobs: the common prefix), new fields keep whatever the
+// destination held (set defaults first), removed fields are ignored. So
+// adding, removing, reordering or growing fields needs no version bump;
+// changing a field's meaning needs a new name.
+//
+// Little-endian, like the asset pack. Keep a De100SaveFile out of game
+// memory (the mapping belongs to the process); the De100SaveWriter and
+// its buffer belong IN game memory (see async-io.h on request lifetime).
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define DE100_SAVE_MAGIC 0x56533144u // "D1SV"
+#define DE100_SAVE_VERSION 1
+#define DE100_SAVE_PAYLOAD_ALIGNMENT 64
+#define DE100_SAVE_PATH_LENGTH 256
+#define DE100_SAVE_HASH_SEED 0x5641534544313030ull
+
+typedef enum {
+  DE100_SAVE_TYPE_BYTES = 0, // Arrays, structs: compared by size only
+  DE100_SAVE_TYPE_U8,
+  DE100_SAVE_TYPE_I8,
+  DE100_SAVE_TYPE_U16,
+  DE100_SAVE_TYPE_I16,
+  DE100_SAVE_TYPE_U32,
+  DE100_SAVE_TYPE_I32,
+  DE100_SAVE_TYPE_U64,
+  DE100_SAVE_TYPE_I64,
+  DE100_SAVE_TYPE_F32,
+  DE100_SAVE_TYPE_F64,
+
+  DE100_SAVE_TYPE_COUNT
+} De100SaveFieldType;
+
+// ═══════════════════════════════════════════════════════════════════════════
+// SCHEMA
+// ═══════════════════════════════════════════════════════════════════════════
+
+typedef struct {
+  const char *name;
+  u32 type; // De100SaveFieldType
+  u32 offset;
+  u32 size;
+} De100SaveField;
+
+typedef struct {
+  const char *name;
+  const De100SaveField *fields;
+  u32 field_count;
+  u32 size; // sizeof the struct
+} De100SaveSchema;
+
+#define DE100_SAVE_TYPE_OF(expression)                                         \
+  _Generic((expression),                                                       \
+      u8: DE100_SAVE_TYPE_U8,                                                  \
+      i8: DE100_SAVE_TYPE_I8,                                                  \
+      u16: DE100_SAVE_TYPE_U16,                                                \
+      i16: DE100_SAVE_TYPE_I16,                                                \
+      u32: DE100_SAVE_TYPE_U32,                                                \
+      i32: DE100_SAVE_TYPE_I32,                                                \
+      u64: DE100_SAVE_TYPE_U64,                                                \
+      i64: DE100_SAVE_TYPE_I64,                                                \
+      f32: DE100_SAVE_TYPE_F32,                                                \
+      f64: DE100_SAVE_TYPE_F64,                                                \
+      default: DE100_SAVE_TYPE_BYTES)
+
+#define DE100_SAVE_DECLARE_FIELD(type, name) type name;
+#define DE100_SAVE_DESCRIBE_FIELD(type, name)                                  \
+  {#name, DE100_SAVE_TYPE_OF(((De100SaveThis *)0)->name),                      \
+   (u32)offsetof(De100SaveThis, name), (u32)sizeof(type)},
+
+/**
+ * Declare `Type` from a field list, and de100_save_schema_<Type>() returning
+ * its schema. FIELDS(FIELD) expands to FIELD(type, name) entries; arrays
+ * need a typedef (FIELD takes a type name).
+ */
+#define DE100_SAVE_DEFINE(Type, FIELDS)                                        \
+  typedef struct {                                                             \
+    FIELDS(DE100_SAVE_DECLARE_FIELD)                                           \
+  } Type;                                                                      \
+  de100_file_scoped_fn inline const De100SaveSchema                            \
+      *de100_save_schema_##Type(void) {                                        \
+    typedef Type De100SaveThis;                                                \
+    static const De100SaveField fields[] = {                                   \
+        FIELDS(DE100_SAVE_DESCRIBE_FIELD)};                                    \
+    static const De100SaveSchema schema = {                                    \
+        #Type, fields, (u32)(sizeof(fields) / sizeof(fields[0])),              \
+        (u32)sizeof(Type)};                                                    \
+    return &schema;                                                            \
+  }
+
+// ═══════════════════════════════════════════════════════════════════════════
+// FILE FORMAT
+// ═══════════════════════════════════════════════════════════════════════════
+
+typedef struct {
+  u32 magic;
+  u16 version;
+  u16 header_size;
+  u64 schema_id; // de100_save_schema_id of the writer's schema
+  u64 checksum;  // hash64 of bytes [header_size, file_size)
+  u64 file_size;
+  u32 field_count;
+  u32 fields_offset;
+  u32 payload_offset;
+  u32 payload_size;
+} De100SaveHeader;
+
+typedef struct {
+  u32 name_hash; // FNV-1a of the field name
+  u16 type;      // De100SaveFieldType
+  u16 reserved;
+  u32 offset; // Into the payload
+  u32 size;
+} De100SaveFieldRecord;
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ERRORS
+// ═══════════════════════════════════════════════════════════════════════════
+
+typedef enum {
+  DE100_SAVE_SUCCESS = 0,
+  DE100_SAVE_ERROR_NULL_ARGUMENT,
+  DE100_SAVE_ERROR_BUFFER_TOO_SMALL,
+  DE100_SAVE_ERROR_PATH_TOO_LONG,
+  DE100_SAVE_ERROR_BUSY,
+  DE100_SAVE_ERROR_SUBMIT_FAILED,
+  DE100_SAVE_ERROR_OPEN_FAILED,
+  DE100_SAVE_ERROR_NOT_A_SAVE,
+  DE100_SAVE_ERROR_VERSION_MISMATCH,
+  DE100_SAVE_ERROR_CORRUPT,
+  DE100_SAVE_ERROR_CHECKSUM_MISMATCH,
+
+  DE100_SAVE_ERROR_COUNT
+} De100SaveErrorCode;
+
+typedef struct {
+  bool success;
+  De100SaveErrorCode error_code;
+} De100SaveResult;
+
+// ═══════════════════════════════════════════════════════════════════════════
+// WRITING
+// ═══════════════════════════════════════════════════════════════════════════
+
+typedef struct {
+  De100AsyncIORequest request; // status: the last save's outcome
+  char path[DE100_SAVE_PATH_LENGTH];
+  u8 *buffer; // Serialized file, untouched while a save is pending
+  u64 capacity;
+} De100SaveWriter;
+
+/** Stable id of a schema's layout (names, types, offsets, sizes). */
+u64 de100_save_schema_id(const De100SaveSchema *schema);
+
+/** File size for `schema`: the writer buffer's minimum capacity. */
+u64 de100_save_size(const De100SaveSchema *schema);
+
+/**
+ * Write the file for `data` into `out`.
+ *
+ * @param hash  memory->kernels->hash64 (every variant hashes alike)
+ * @return      Bytes written, 0 if `capacity` is too small
+ */
+u64 de100_save_serialize(const De100SaveSchema *schema, const void *data,
+                         void *out, u64 capacity, de100_hash64_t *hash);
+
+/** `buffer` (game memory, de100_save_size bytes) backs every save. */
+void de100_save_writer_init(De100SaveWriter *writer, void *buffer,
+                            u64 capacity);
+
+/**
+ * Serialize `data` and queue it on the async I/O queue. Never blocks:
+ * BUSY while the previous save is still pending (save again later; only
+ * the newest state matters). Completion and errors land in
+ * writer->request (de100_async_io_is_done).
+ */
+De100SaveResult de100_save_write(De100SaveWriter *writer, GameMemory *memory,
+                                 const De100SaveSchema *schema,
+                                 const void *data, const char *path);
+
+de100_file_scoped_fn inline bool
+de100_save_writer_is_busy(const De100SaveWriter *writer) {
+  return __atomic_load_n(&writer->request.status, __ATOMIC_ACQUIRE) ==
+         DE100_ASYNC_IO_STATUS_PENDING;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// LOADING
+// ═══════════════════════════════════════════════════════════════════════════
+
+typedef struct {
+  De100FileMapping mapping;
+  const De100SaveHeader *header;
+  const De100SaveFieldRecord *fields;
+  const u8 *payload;
+} De100SaveFile;
+
+/**
+ * Map `path`, validate header and field bounds and verify the checksum.
+ * Nothing to close on failure.
+ */
+De100SaveResult de100_save_open(De100SaveFile *file, GameMemory *memory,
+                                const char *path);
+
+void de100_save_close(De100SaveFile *file);
+
+/**
+ * The payload as `schema`'s struct, in place (no copy), if the file was
+ * written with exactly this schema; NULL otherwise (use de100_save_read).
+ */
+const void *de100_save_view(const De100SaveFile *file,
+                            const De100SaveSchema *schema);
+
+/**
+ * Copy the file into `out`, field by field when the schemas differ.
+ * Fields the file lacks keep their value in `out`.
+ *
+ * @return Fields of `schema` restored from the file
+ */
+u32 de100_save_read(const De100SaveFile *file, const De100SaveSchema *schema,
+                    void *out);
+
+/** Open, read into `out`, close. */
+De100SaveResult de100_save_load(GameMemory *memory, const char *path,
+                                const De100SaveSchema *schema, void *out);
+
+const char *de100_save_strerror(De100SaveErrorCode code);
+
+#endif // DE100_GAME_SAVE_GAME_H
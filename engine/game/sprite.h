@@ -0,0 +1,600 @@
+#ifndef DE100_GAME_SPRITE_H
+#define DE100_GAME_SPRITE_H
+
+#include "../_common/base.h"
+#include "backbuffer.h"
+#include "memory-arena.h"
+#include "pixel-kernels.h"
+#include <math.h>
+#include <string.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// 🖼️ SPRITE BLITTER
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// Sprites are backbuffer-format pixels (DE100_PIXEL_FORMAT) with
+// PREMULTIPLIED alpha, e.g. straight out of a .de100pak (see asset-pack.h).
+// Clipping happens once per blit; every row then goes to a SIMD row kernel
+// (pixel-kernels.h), never a per-pixel branch:
+//
+//   OPAQUE         memcpy per row (backgrounds, tiles)
+//   ALPHA_TEST     write where alpha >= 128 (pixel art, 1-bit masks)
+//   PREMULTIPLIED  dst = src + dst * (255 - a) / 255 (soft edges, glows)
+//
+// The premultiplied kernel skips 4/8-pixel groups that are fully
+// transparent and copies fully opaque ones. For the big wins on sparse
+// sprites, build a span table once:
+//
+//   de100_sprite_build_spans(&state->hero, &state->asset_arena);
+//
+//   row 3:  ░░░░▓▓▓▓████████████▓▓░░░░░░
+//               └blend┘└─ opaque ──┘└b┘     transparent runs: not stored
+//
+// Blits then visit only the stored runs: transparent pixels cost nothing,
+// opaque runs are memcpy, and only the anti-aliased edges blend. Rows
+// with no runs are skipped outright.
+//
+//   De100Sprite frame = de100_sprite_frame(&state->sheet, 32 * i, 0, 32, 32);
+//   de100_sprite_blit(buffer, &frame, x, y, DE100_SPRITE_BLIT_PREMULTIPLIED);
+//
+// Or record a DE100_RENDER_COMMAND_SPRITE with de100_push_sprite() to
+// rasterize it per tile on the work queue (render-group.h).
+//
+// Rotated/scaled sprites (turrets, spinning pickups) go through
+// de100_sprite_blit_transformed(): the destination pixels are walked, not
+// the source, with the source coordinate stepped incrementally in 16.16
+// fixed point. Each row is clipped analytically to where that coordinate
+// stays inside the sprite, sampled by a SIMD row kernel (nearest or
+// bilinear), then blitted with the same blend rows as above:
+//
+//   De100SpriteTransform turret =
+//       de100_sprite_transform_centered(&state->turret, cx, cy, angle, 1.0f);
+//   de100_sprite_blit_transformed(buffer, &state->turret, &turret,
+//                                 DE100_SPRITE_BLIT_PREMULTIPLIED,
+//                                 DE100_SPRITE_FILTER_BILINEAR);
+//
+// All functions are static inline for zero overhead if unused.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+// Shorter opaque stretches are folded into the surrounding blend run:
+// one kernel call beats three tiny ones.
+#ifndef DE100_SPRITE_MIN_OPAQUE_SPAN
+#define DE100_SPRITE_MIN_OPAQUE_SPAN 8
+#endif
+
+typedef enum {
+  DE100_SPRITE_BLIT_OPAQUE = 0,
+  DE100_SPRITE_BLIT_ALPHA_TEST,
+  DE100_SPRITE_BLIT_PREMULTIPLIED,
+
+  DE100_SPRITE_BLIT_COUNT
+} De100SpriteBlitMode;
+
+typedef enum {
+  DE100_SPRITE_FILTER_NEAREST = 0, // Pixel art; one gather per pixel
+  DE100_SPRITE_FILTER_BILINEAR,    // Smooth rotation/scaling, 2x2 taps
+
+  DE100_SPRITE_FILTER_COUNT
+} De100SpriteFilter;
+
+// Destination pixels sampled per kernel call by transformed blits
+#ifndef DE100_SPRITE_SAMPLE_CHUNK
+#define DE100_SPRITE_SAMPLE_CHUNK 256
+#endif
+
+typedef enum {
+  DE100_SPRITE_SPAN_OPAQUE = 0, // Every alpha == 255
+  DE100_SPRITE_SPAN_BLEND,      // Mixed; no pixel fully transparent at ends
+
+  DE100_SPRITE_SPAN_COUNT
+} De100SpriteSpanKind;
+
+typedef struct {
+  u16 x;
+  u16 count;
+  u16 kind; // De100SpriteSpanKind
+  u16 reserved;
+} De100SpriteSpan;
+
+typedef struct De100Sprite {
+  const u8 *pixels; // DE100_PIXEL_FORMAT; premultiplied alpha
+  i32 width;
+  i32 height;
+  i32 pitch; // Bytes per row
+
+  // Optional (de100_sprite_build_spans): row y's runs are
+  // spans[row_spans[y] .. row_spans[y + 1])
+  const De100SpriteSpan *spans;
+  const u32 *row_spans;
+} De100Sprite;
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Construction
+// ─────────────────────────────────────────────────────────────────────────────
+
+de100_file_scoped_fn inline De100Sprite de100_sprite_make(const void *pixels,
+                                                          i32 width, i32 height,
+                                                          i32 pitch) {
+  return (De100Sprite){
+      .pixels = (const u8 *)pixels,
+      .width = width,
+      .height = height,
+      .pitch = pitch,
+  };
+}
+
+/**
+ * A sub-rectangle (atlas frame) of `sheet`, clamped to it. Shares pixels;
+ * the sheet's span table doesn't apply, so build one per frame if needed.
+ */
+de100_file_scoped_fn inline De100Sprite
+de100_sprite_frame(const De100Sprite *sheet, i32 x, i32 y, i32 width,
+                   i32 height) {
+  i32 x0 = x > 0 ? x : 0;
+  i32 y0 = y > 0 ? y : 0;
+  i32 x1 = x + width < sheet->width ? x + width : sheet->width;
+  i32 y1 = y + height < sheet->height ? y + height : sheet->height;
+  if (x1 <= x0 || y1 <= y0) {
+    return (De100Sprite){0};
+  }
+  return de100_sprite_make(sheet->pixels + (size_t)y0 * (size_t)sheet->pitch +
+                               (size_t)x0 * 4,
+                           x1 - x0, y1 - y0, sheet->pitch);
+}
+
+// Emits row runs into `spans` (or only counts them when NULL)
+de100_file_scoped_fn inline u32
+de100_sprite_row_spans(const u32 *row, i32 width, De100SpriteSpan *spans) {
+  u32 count = 0;
+  i32 x = 0;
+  while (x < width) {
+    while (x < width && (row[x] >> 24) == 0) {
+      ++x;
+    }
+    if (x == width) {
+      break;
+    }
+
+    // [run_start, run_end) has no transparent pixel at either end
+    i32 run_start = x;
+    i32 run_end = x;
+    for (i32 scan = x; scan < width && (row[scan] >> 24) != 0; ++scan) {
+      run_end = scan + 1;
+    }
+    x = run_end;
+
+    i32 cursor = run_start;
+    i32 blend_start = run_start;
+    while (cursor < run_end) {
+      i32 opaque_end = cursor;
+      while (opaque_end < run_end && (row[opaque_end] >> 24) == 255) {
+        ++opaque_end;
+      }
+      if (opaque_end - cursor >= DE100_SPRITE_MIN_OPAQUE_SPAN) {
+        if (cursor > blend_start) {
+          if (spans) {
+            spans[count] = (De100SpriteSpan){(u16)blend_start,
+                                             (u16)(cursor - blend_start),
+                                             DE100_SPRITE_SPAN_BLEND, 0};
+          }
+          ++count;
+        }
+        if (spans) {
+          spans[count] =
+              (De100SpriteSpan){(u16)cursor, (u16)(opaque_end - cursor),
+                                DE100_SPRITE_SPAN_OPAQUE, 0};
+        }
+        ++count;
+        blend_start = opaque_end;
+      }
+      cursor = opaque_end > cursor ? opaque_end : cursor + 1;
+    }
+    if (run_end > blend_start) {
+      if (spans) {
+        spans[count] = (De100SpriteSpan){(u16)blend_start,
+                                         (u16)(run_end - blend_start),
+                                         DE100_SPRITE_SPAN_BLEND, 0};
+      }
+      ++count;
+    }
+  }
+  return count;
+}
+
+/**
+ * Classify every pixel once and store the non-transparent runs in
+ * `arena`. False (sprite unchanged) if the arena is full or the sprite is
+ * wider than 65535.
+ */
+de100_file_scoped_fn inline bool
+de100_sprite_build_spans(De100Sprite *sprite, De100MemoryArena *arena) {
+  if (sprite->width > 0xFFFF || sprite->width <= 0 || sprite->height <= 0) {
+    return false;
+  }
+
+  u32 total = 0;
+  for (i32 y = 0; y < sprite->height; ++y) {
+    const u32 *row = (const u32 *)(sprite->pixels + (size_t)y * sprite->pitch);
+    total += de100_sprite_row_spans(row, sprite->width, NULL);
+  }
+
+  u64 arena_used = arena->used;
+  u32 *row_spans =
+      de100_arena_push_array(arena, (u32)sprite->height + 1, u32);
+  De100SpriteSpan *spans =
+      de100_arena_push_array(arena, total ? total : 1, De100SpriteSpan);
+  if (!row_spans || !spans) {
+    de100_arena_pop_to(arena, arena_used);
+    return false;
+  }
+
+  u32 cursor = 0;
+  for (i32 y = 0; y < sprite->height; ++y) {
+    const u32 *row = (const u32 *)(sprite->pixels + (size_t)y * sprite->pitch);
+    row_spans[y] = cursor;
+    cursor += de100_sprite_row_spans(row, sprite->width, spans + cursor);
+  }
+  row_spans[sprite->height] = cursor;
+
+  sprite->spans = spans;
+  sprite->row_spans = row_spans;
+  return true;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Blitting
+// ─────────────────────────────────────────────────────────────────────────────
+
+/**
+ * Draw `sprite` with its top-left at (x, y), restricted to `clip`.
+ * `clip` must already be inside the buffer bounds.
+ */
+de100_file_scoped_fn inline void
+de100_sprite_blit_clipped(GameBackBuffer *buffer, De100RenderClipRect clip,
+                          const De100Sprite *sprite, i32 x, i32 y,
+                          De100SpriteBlitMode mode) {
+  i32 x0 = x > clip.min_x ? x : clip.min_x;
+  i32 y0 = y > clip.min_y ? y : clip.min_y;
+  i32 x1 = x + sprite->width < clip.max_x ? x + sprite->width : clip.max_x;
+  i32 y1 = y + sprite->height < clip.max_y ? y + sprite->height : clip.max_y;
+  if (x1 <= x0 || y1 <= y0 || !sprite->pixels) {
+    return;
+  }
+
+  De100PixelKernels *kernels = de100_pixel_kernels_get();
+  de100_pixel_blit_row_t *blend_row =
+      mode == DE100_SPRITE_BLIT_ALPHA_TEST ? kernels->alpha_test_row
+                                           : kernels->blend_premultiplied_row;
+
+  // Sprite-space column range that survives the clip
+  i32 src_x0 = x0 - x;
+  i32 src_x1 = x1 - x;
+
+  u8 *dst_row = (u8 *)buffer->memory.base + (size_t)y0 * (size_t)buffer->pitch;
+  const u8 *src_row = sprite->pixels + (size_t)(y0 - y) * sprite->pitch;
+  for (i32 py = y0; py < y1; ++py) {
+    u32 *dst = (u32 *)dst_row;
+    const u32 *src = (const u32 *)src_row;
+
+    if (mode == DE100_SPRITE_BLIT_OPAQUE) {
+      memcpy(dst + x0, src + src_x0, (size_t)(src_x1 - src_x0) * 4);
+    } else if (sprite->row_spans) {
+      i32 sy = py - y;
+      for (u32 i = sprite->row_spans[sy]; i < sprite->row_spans[sy + 1]; ++i) {
+        const De100SpriteSpan *span = &sprite->spans[i];
+        i32 s0 = span->x > src_x0 ? span->x : src_x0;
+        i32 s1 = span->x + span->count < src_x1 ? span->x + span->count
+                                                : src_x1;
+        if (s1 <= s0) {
+          continue;
+        }
+        if (span->kind == DE100_SPRITE_SPAN_OPAQUE) {
+          memcpy(dst + x + s0, src + s0, (size_t)(s1 - s0) * 4);
+        } else {
+          blend_row(dst + x + s0, src + s0, s1 - s0);
+        }
+      }
+    } else {
+      blend_row(dst + x0, src + src_x0, src_x1 - src_x0);
+    }
+
+    dst_row += buffer->pitch;
+    src_row += sprite->pitch;
+  }
+}
+
+/**
+ * Immediate-mode blit over the whole buffer (marks the dirty region).
+ */
+de100_file_scoped_fn inline void de100_sprite_blit(GameBackBuffer *buffer,
+                                                   const De100Sprite *sprite,
+                                                   i32 x, i32 y,
+                                                   De100SpriteBlitMode mode) {
+  if (buffer->is_rendering_disabled) {
+    return;
+  }
+  De100RenderClipRect clip = {0, 0, buffer->width, buffer->height};
+  de100_backbuffer_mark_dirty(buffer, x, y, sprite->width, sprite->height);
+  de100_sprite_blit_clipped(buffer, clip, sprite, x, y, mode);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Transformed blits
+// ─────────────────────────────────────────────────────────────────────────────
+//
+// The inverse mapping is affine, so along a destination row the source
+// coordinate moves by a constant (du, dv) per pixel:
+//
+//   (u, v) = pivot + R(-angle) * ((px, py) - (x, y)) / scale
+//
+// Per row: one float evaluation at the row's first pixel center, then the
+// range of pixels whose (u, v) is inside the sprite is solved exactly in
+// integers, so the kernels never bounds-check. Bilinear needs its 2x2
+// taps inside too, which trims the sprite's outermost half texel (sprites
+// with a transparent border lose nothing). Span tables don't apply.
+//
+
+typedef struct {
+  f32 x; // Where the pivot lands, backbuffer pixels (sub-pixel)
+  f32 y;
+  f32 pivot_x; // Sprite pixels; the center of rotation and scaling
+  f32 pivot_y;
+  f32 angle; // Radians, clockwise on screen (y points down)
+  f32 scale_x;
+  f32 scale_y;
+} De100SpriteTransform;
+
+/** `sprite` rotated by `angle` and scaled by `scale` about its center,
+ *  which lands on (x, y). */
+de100_file_scoped_fn inline De100SpriteTransform
+de100_sprite_transform_centered(const De100Sprite *sprite, f32 x, f32 y,
+                                f32 angle, f32 scale) {
+  return (De100SpriteTransform){
+      .x = x,
+      .y = y,
+      .pivot_x = 0.5f * (f32)sprite->width,
+      .pivot_y = 0.5f * (f32)sprite->height,
+      .angle = angle,
+      .scale_x = scale,
+      .scale_y = scale,
+  };
+}
+
+/** Backbuffer pixels the transformed sprite can touch (unclipped). */
+de100_file_scoped_fn inline De100RenderClipRect
+de100_sprite_transformed_bounds(const De100Sprite *sprite,
+                                const De100SpriteTransform *transform) {
+  f32 c = cosf(transform->angle);
+  f32 s = sinf(transform->angle);
+  f32 min_x = 0.0f, min_y = 0.0f, max_x = 0.0f, max_y = 0.0f;
+  for (i32 corner = 0; corner < 4; ++corner) {
+    f32 sx = ((corner & 1) ? (f32)sprite->width : 0.0f) - transform->pivot_x;
+    f32 sy = ((corner & 2) ? (f32)sprite->height : 0.0f) - transform->pivot_y;
+    sx *= transform->scale_x;
+    sy *= transform->scale_y;
+    f32 dx = c * sx - s * sy;
+    f32 dy = s * sx + c * sy;
+    min_x = corner == 0 || dx < min_x ? dx : min_x;
+    max_x = corner == 0 || dx > max_x ? dx : max_x;
+    min_y = corner == 0 || dy < min_y ? dy : min_y;
+    max_y = corner == 0 || dy > max_y ? dy : max_y;
+  }
+  return (De100RenderClipRect){
+      (i32)floorf(transform->x + min_x), (i32)floorf(transform->y + min_y),
+      (i32)ceilf(transform->x + max_x), (i32)ceilf(transform->y + max_y)};
+}
+
+de100_file_scoped_fn inline i64 de100_sprite_floor_div(i64 a, i64 b) {
+  return a >= 0 ? a / b : -((-a + b - 1) / b);
+}
+
+// Narrow [*first, *last) to the i with 0 <= start + i * step < limit
+de100_file_scoped_fn inline void de100_sprite_span_narrow(i64 start, i64 step,
+                                                          i64 limit,
+                                                          i32 *first,
+                                                          i32 *last) {
+  i64 lo, hi;
+  if (step > 0) {
+    lo = -de100_sprite_floor_div(start, step);
+    hi = -de100_sprite_floor_div(start - limit, step);
+  } else if (step < 0) {
+    lo = de100_sprite_floor_div(start - limit, -step) + 1;
+    hi = de100_sprite_floor_div(start, -step) + 1;
+  } else {
+    lo = 0;
+    hi = (start >= 0 && start < limit) ? *last : 0;
+  }
+  if (lo > *first) {
+    *first = lo < *last ? (i32)lo : *last;
+  }
+  if (hi < *last) {
+    *last = hi > *first ? (i32)hi : *first;
+  }
+}
+
+/**
+ * Draw `sprite` through `transform`, restricted to `clip`. `clip` must
+ * already be inside the buffer bounds; the sprite must be under 32768
+ * pixels a side.
+ */
+de100_file_scoped_fn inline void de100_sprite_blit_transformed_clipped(
+    GameBackBuffer *buffer, De100RenderClipRect clip,
+    const De100Sprite *sprite, const De100SpriteTransform *transform,
+    De100SpriteBlitMode mode, De100SpriteFilter filter) {
+  if (!sprite->pixels || sprite->width <= 0 || sprite->height <= 0 ||
+      sprite->width >= 32768 || sprite->height >= 32768 ||
+      transform->scale_x == 0.0f || transform->scale_y == 0.0f) {
+    return;
+  }
+
+  De100RenderClipRect bounds =
+      de100_sprite_transformed_bounds(sprite, transform);
+  i32 x0 = bounds.min_x > clip.min_x ? bounds.min_x : clip.min_x;
+  i32 y0 = bounds.min_y > clip.min_y ? bounds.min_y : clip.min_y;
+  i32 x1 = bounds.max_x < clip.max_x ? bounds.max_x : clip.max_x;
+  i32 y1 = bounds.max_y < clip.max_y ? bounds.max_y : clip.max_y;
+  if (x1 <= x0 || y1 <= y0) {
+    return;
+  }
+
+  bool bilinear = filter == DE100_SPRITE_FILTER_BILINEAR &&
+                  sprite->width >= 2 && sprite->height >= 2;
+  De100PixelKernels *kernels = de100_pixel_kernels_get();
+  de100_pixel_sample_row_t *sample_row =
+      bilinear ? kernels->sample_bilinear_row : kernels->sample_nearest_row;
+  de100_pixel_blit_row_t *blend_row =
+      mode == DE100_SPRITE_BLIT_ALPHA_TEST ? kernels->alpha_test_row
+                                           : kernels->blend_premultiplied_row;
+
+  // Source texel coordinate per destination step, 16.16
+  f32 c = cosf(transform->angle);
+  f32 s = sinf(transform->angle);
+  f32 inv_sx = 1.0f / transform->scale_x;
+  f32 inv_sy = 1.0f / transform->scale_y;
+  i32 du_dx = (i32)lrintf(c * inv_sx * 65536.0f);
+  i32 dv_dx = (i32)lrintf(-s * inv_sy * 65536.0f);
+  // Bilinear samples between texel centers; nearest floors
+  f32 center = bilinear ? 0.5f : 0.0f;
+  i64 limit_u = (i64)(sprite->width - (bilinear ? 1 : 0)) << 16;
+  i64 limit_v = (i64)(sprite->height - (bilinear ? 1 : 0)) << 16;
+  i32 stride = sprite->pitch / 4;
+  const u32 *src = (const u32 *)sprite->pixels;
+
+  u8 *dst_row = (u8 *)buffer->memory.base + (size_t)y0 * (size_t)buffer->pitch;
+  for (i32 py = y0; py < y1; ++py, dst_row += buffer->pitch) {
+    f32 rx = (f32)x0 + 0.5f - transform->x;
+    f32 ry = (f32)py + 0.5f - transform->y;
+    i64 u = (i64)floorf(
+        ((c * rx + s * ry) * inv_sx + transform->pivot_x - center) * 65536.0f);
+    i64 v = (i64)floorf(
+        ((c * ry - s * rx) * inv_sy + transform->pivot_y - center) * 65536.0f);
+
+    i32 first = 0;
+    i32 last = x1 - x0;
+    de100_sprite_span_narrow(u, du_dx, limit_u, &first, &last);
+    de100_sprite_span_narrow(v, dv_dx, limit_v, &first, &last);
+    if (last <= first) {
+      continue;
+    }
+
+    u32 *dst = (u32 *)dst_row + x0 + first;
+    i32 su = (i32)(u + (i64)first * du_dx);
+    i32 sv = (i32)(v + (i64)first * dv_dx);
+    i32 count = last - first;
+    if (mode == DE100_SPRITE_BLIT_OPAQUE) {
+      sample_row(dst, src, stride, su, sv, du_dx, dv_dx, count);
+      continue;
+    }
+
+    u32 samples[DE100_SPRITE_SAMPLE_CHUNK];
+    for (i32 done = 0; done < count; done += DE100_SPRITE_SAMPLE_CHUNK) {
+      i32 n = count - done < DE100_SPRITE_SAMPLE_CHUNK
+                  ? count - done
+                  : DE100_SPRITE_SAMPLE_CHUNK;
+      sample_row(samples, src, stride, su + done * du_dx, sv + done * dv_dx,
+                 du_dx, dv_dx, n);
+      blend_row(dst + done, samples, n);
+    }
+  }
+}
+
+/**
+ * Immediate-mode transformed blit over the whole buffer (marks the dirty
+ * region).
+ */
+de100_file_scoped_fn inline void
+de100_sprite_blit_transformed(GameBackBuffer *buffer,
+                              const De100Sprite *sprite,
+                              const De100SpriteTransform *transform,
+                              De100SpriteBlitMode mode,
+                              De100SpriteFilter filter) {
+  if (buffer->is_rendering_disabled) {
+    return;
+  }
+  De100RenderClipRect clip = {0, 0, buffer->width, buffer->height};
+  De100RenderClipRect bounds =
+      de100_sprite_transformed_bounds(sprite, transform);
+  de100_backbuffer_mark_dirty(buffer, bounds.min_x, bounds.min_y,
+                              bounds.max_x - bounds.min_x,
+                              bounds.max_y - bounds.min_y);
+  de100_sprite_blit_transformed_clipped(buffer, clip, sprite, transform, mode,
+                                        filter);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Indexed layers
+// ─────────────────────────────────────────────────────────────────────────────
+//
+// One byte per pixel into a 256-entry palette of backbuffer colors, index 0
+// transparent: particle/grain fields, masks, retro art. A quarter of the
+// memory of a u32 layer, and the row kernel skips empty stretches 8-16
+// indices at a time (gathers on AVX2), so a mostly empty layer costs
+// little more than reading it:
+//
+//   De100IndexedImage grains = de100_indexed_image_make(cells, 640, 480, 640);
+//   de100_indexed_blit(buffer, &grains, state->grain_palette, 0, 0);
+//
+
+typedef struct {
+  const u8 *indices; // 0 = transparent
+  i32 width;
+  i32 height;
+  i32 pitch; // Bytes per row
+} De100IndexedImage;
+
+de100_file_scoped_fn inline De100IndexedImage
+de100_indexed_image_make(const u8 *indices, i32 width, i32 height,
+                         i32 pitch) {
+  return (De100IndexedImage){
+      .indices = indices,
+      .width = width,
+      .height = height,
+      .pitch = pitch,
+  };
+}
+
+/**
+ * Draw `image` with its top-left at (x, y), restricted to `clip`.
+ * `palette` has 256 entries (DE100_PIXEL_FORMAT); entry 0 is never read.
+ */
+de100_file_scoped_fn inline void
+de100_indexed_blit_clipped(GameBackBuffer *buffer, De100RenderClipRect clip,
+                           const De100IndexedImage *image, const u32 *palette,
+                           i32 x, i32 y) {
+  i32 x0 = x > clip.min_x ? x : clip.min_x;
+  i32 y0 = y > clip.min_y ? y : clip.min_y;
+  i32 x1 = x + image->width < clip.max_x ? x + image->width : clip.max_x;
+  i32 y1 = y + image->height < clip.max_y ? y + image->height : clip.max_y;
+  if (x1 <= x0 || y1 <= y0 || !image->indices) {
+    return;
+  }
+
+  de100_pixel_indexed_row_t *indexed_row =
+      de100_pixel_kernels_get()->indexed_row;
+  u8 *dst_row = (u8 *)buffer->memory.base + (size_t)y0 * (size_t)buffer->pitch;
+  const u8 *src_row =
+      image->indices + (size_t)(y0 - y) * image->pitch + (x0 - x);
+  for (i32 py = y0; py < y1; ++py) {
+    indexed_row((u32 *)dst_row + x0, src_row, x1 - x0, palette);
+    dst_row += buffer->pitch;
+    src_row += image->pitch;
+  }
+}
+
+/**
+ * Immediate-mode indexed blit over the whole buffer (marks the dirty
+ * region).
+ */
+de100_file_scoped_fn inline void
+de100_indexed_blit(GameBackBuffer *buffer, const De100IndexedImage *image,
+                   const u32 *palette, i32 x, i32 y) {
+  if (buffer->is_rendering_disabled) {
+    return;
+  }
+  De100RenderClipRect clip = {0, 0, buffer->width, buffer->height};
+  de100_backbuffer_mark_dirty(buffer, x, y, image->width, image->height);
+  de100_indexed_blit_clipped(buffer, clip, image, palette, x, y);
+}
+
+#endif // DE100_GAME_SPRITE_H
@@ -3,8 +3,62 @@
 
 #include "../_common/base.h"
 
+// Forward declared to keep memory-arena.h -> memory.h -> thread.h acyclic
+struct De100MemoryArena;
+
+// ═══════════════════════════════════════════════════════════════════════════
+// THREAD CONTEXT
+// ═══════════════════════════════════════════════════════════════════════════
+// Passed to every game entry point and every work-queue callback.
+//
+//   thread_index:  0 = main thread, 1..N = worker threads
+//   scratch_arena: Per-thread scratch memory. Work callbacks get a fresh
+//                  temporary scope per entry, so anything pushed here is
+//                  released once the callback returns.
+// ═══════════════════════════════════════════════════════════════════════════
+
 typedef struct {
-  i32 placeholder;
+  i32 thread_index;
+  struct De100MemoryArena *scratch_arena;
 } ThreadContext;
 
+// ═══════════════════════════════════════════════════════════════════════════
+// WORK QUEUE (Casey's Day 122-126 pattern, with work stealing)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// The platform owns the worker threads; the game only sees an opaque queue
+// and two function pointers on GameMemory:
+//
+//   DE100_WORK_QUEUE_CALLBACK(fill_tile) {
+//     TileJob *job = (TileJob *)data;
+//     ...
+//   }
+//
+//   for (i32 i = 0; i < tile_count; ++i) {
+//     memory->add_work_entry(memory->work_queue, fill_tile, &jobs[i]);
+//   }
+//   memory->complete_all_work(memory->work_queue);
+//
+// The main thread helps drain the queue inside complete_all_work().
+// Always complete all work before returning from game_update_and_render:
+// callbacks live in the game library and must not outlive a hot reload.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+typedef struct De100WorkQueue De100WorkQueue;
+
+#define DE100_WORK_QUEUE_CALLBACK(name)                                        \
+  void name(ThreadContext *thread_context, void *data)
+typedef DE100_WORK_QUEUE_CALLBACK(de100_work_queue_callback_t);
+
+// Returns false if every worker queue is full (entry was NOT queued).
+#define DE100_PLATFORM_ADD_WORK_ENTRY(name)                                    \
+  bool name(De100WorkQueue *queue, de100_work_queue_callback_t *callback,      \
+            void *data)
+typedef DE100_PLATFORM_ADD_WORK_ENTRY(de100_platform_add_work_entry_t);
+
+// Blocks (while helping) until every queued entry has finished.
+#define DE100_PLATFORM_COMPLETE_ALL_WORK(name) void name(De100WorkQueue *queue)
+typedef DE100_PLATFORM_COMPLETE_ALL_WORK(de100_platform_complete_all_work_t);
+
 #endif // DE100_GAME_DE100_THREAD_H
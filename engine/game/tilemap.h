@@ -0,0 +1,344 @@
+#ifndef DE100_GAME_TILEMAP_H
+#define DE100_GAME_TILEMAP_H
+
+#include "../_common/base.h"
+#include "backbuffer.h"
+#include "memory-arena.h"
+#include "pixel-kernels.h"
+#include "sprite.h"
+
+// ═══════════════════════════════════════════════════════════════════════════
+// 🧱 TILEMAP (tile index grid + tileset, drawn from cached chunks)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// Grids of fixed-size tiles (playfields, lanes, boards) drawn as a handful
+// of big opaque blits instead of one rect or sprite per cell:
+//
+//   De100Sprite sheet = ...;                  // tiles left-to-right, rows
+//   De100Tileset tiles = de100_tileset_make(&sheet, 16, 16);
+//   de100_tilemap_init(&state->field, &state->transient_arena, 10, 20,
+//                      &tiles, DE100_RGB(16, 16, 24));
+//
+//   de100_tilemap_set(&state->field, col, row, TILE_LOCKED_RED);
+//   de100_tilemap_draw(buffer, &state->field, board_x - camera_x, board_y);
+//
+// The map is cut into DE100_TILEMAP_CHUNK_TILES² chunks, each with its
+// own cached pixels. A chunk is re-rendered from the tileset only when
+// one of its tiles changed since it was last drawn (set() marks it
+// stale; setting the value a tile already has doesn't), and only once
+// it is actually on screen. A steady frame is then one OPAQUE sprite
+// blit per visible chunk: memcpy rows.
+//
+// Scrolling is just the draw position: chunks are clipped per blit, so a
+// partially visible chunk costs only its visible rows.
+//
+// DE100_TILEMAP_EMPTY tiles show `clear_color`. With a tileset in
+// ALPHA_TEST or PREMULTIPLIED mode, tiles are composited over it inside
+// the chunk; the chunk stays opaque as long as `clear_color` is (a
+// translucent one, premultiplied, makes every chunk blit PREMULTIPLIED).
+// Flat-colored cells need no art: render each cell kind into a small
+// sheet once at init.
+//
+// Cache pixels live in the arena the map is initialized from; transient
+// storage is fine: call de100_tilemap_invalidate() after anything that
+// may have clobbered it (a replay seek) and the chunks redraw.
+//
+// All functions are static inline for zero overhead if unused.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#ifndef DE100_TILEMAP_CHUNK_TILES
+#define DE100_TILEMAP_CHUNK_TILES 16
+#endif
+
+#define DE100_TILEMAP_EMPTY 0xFFFFu
+
+typedef u16 De100Tile;
+
+typedef struct {
+  De100Sprite sheet; // Tile i at column i % columns, row i / columns
+  i32 tile_width;
+  i32 tile_height;
+  i32 columns;
+  i32 tile_count;
+  De100SpriteBlitMode mode; // How tiles land on clear_color in a chunk
+} De100Tileset;
+
+typedef struct {
+  De100Tile *tiles; // [row * width + col]
+  i32 width;        // In tiles
+  i32 height;
+  De100Tileset tileset;
+  u32 clear_color; // DE100_PIXEL_FORMAT, premultiplied
+
+  // Chunk cache: chunk (cx, cy) is pixels + (cy * chunks_x + cx) *
+  // chunk_width * chunk_height, pitch chunk_width * 4
+  u32 *chunk_pixels;
+  u8 *chunk_is_stale;
+  i32 chunks_x;
+  i32 chunks_y;
+  i32 chunk_width; // Pixels (edge chunks only use part of theirs)
+  i32 chunk_height;
+} De100Tilemap;
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Setup
+// ─────────────────────────────────────────────────────────────────────────────
+
+/**
+ * Tileset over `sheet`, cut into tile_width x tile_height frames. Tiles
+ * are copied OPAQUE; set .mode for sheets with transparency.
+ */
+de100_file_scoped_fn inline De100Tileset
+de100_tileset_make(const De100Sprite *sheet, i32 tile_width, i32 tile_height) {
+  De100Tileset tileset = {
+      .sheet = *sheet,
+      .tile_width = tile_width,
+      .tile_height = tile_height,
+      .mode = DE100_SPRITE_BLIT_OPAQUE,
+  };
+  if (tile_width > 0 && tile_height > 0) {
+    tileset.columns = sheet->width / tile_width;
+    tileset.tile_count = tileset.columns * (sheet->height / tile_height);
+  }
+  return tileset;
+}
+
+/**
+ * Push a width x height grid (all DE100_TILEMAP_EMPTY) and its chunk cache
+ * from `arena`. Returns false when the arena is too small.
+ */
+de100_file_scoped_fn inline bool
+de100_tilemap_init(De100Tilemap *map, De100MemoryArena *arena, i32 width,
+                   i32 height, const De100Tileset *tileset, u32 clear_color) {
+  DEV_ASSERT_MSG(width > 0 && height > 0 && tileset->tile_width > 0 &&
+                     tileset->tile_height > 0,
+                 "Tilemap %dx%d of %dx%d tiles", width, height,
+                 tileset->tile_width, tileset->tile_height);
+  *map = (De100Tilemap){0};
+  if (width <= 0 || height <= 0 || tileset->tile_width <= 0 ||
+      tileset->tile_height <= 0) {
+    return false;
+  }
+
+  i32 chunks_x =
+      (width + DE100_TILEMAP_CHUNK_TILES - 1) / DE100_TILEMAP_CHUNK_TILES;
+  i32 chunks_y =
+      (height + DE100_TILEMAP_CHUNK_TILES - 1) / DE100_TILEMAP_CHUNK_TILES;
+  i32 chunk_width = DE100_TILEMAP_CHUNK_TILES * tileset->tile_width;
+  i32 chunk_height = DE100_TILEMAP_CHUNK_TILES * tileset->tile_height;
+
+  map->tiles = de100_arena_push_array(arena, (u64)width * (u64)height,
+                                      De100Tile);
+  map->chunk_is_stale =
+      de100_arena_push_array(arena, (u64)chunks_x * (u64)chunks_y, u8);
+  map->chunk_pixels = (u32 *)de100_arena_push_size_aligned(
+      arena,
+      (u64)chunks_x * (u64)chunks_y * (u64)chunk_width * (u64)chunk_height *
+          sizeof(u32),
+      64);
+  if (!map->tiles || !map->chunk_is_stale || !map->chunk_pixels) {
+    *map = (De100Tilemap){0};
+    return false;
+  }
+
+  for (i64 i = 0; i < (i64)width * height; ++i) {
+    map->tiles[i] = DE100_TILEMAP_EMPTY;
+  }
+  memset(map->chunk_is_stale, 1, (size_t)chunks_x * (size_t)chunks_y);
+  map->width = width;
+  map->height = height;
+  map->tileset = *tileset;
+  map->clear_color = clear_color;
+  map->chunks_x = chunks_x;
+  map->chunks_y = chunks_y;
+  map->chunk_width = chunk_width;
+  map->chunk_height = chunk_height;
+  return true;
+}
+
+/**
+ * Mark every chunk stale (tileset pixels changed, cache memory clobbered).
+ */
+de100_file_scoped_fn inline void de100_tilemap_invalidate(De100Tilemap *map) {
+  if (map->chunk_is_stale) {
+    memset(map->chunk_is_stale, 1,
+           (size_t)map->chunks_x * (size_t)map->chunks_y);
+  }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Tiles
+// ─────────────────────────────────────────────────────────────────────────────
+
+de100_file_scoped_fn inline De100Tile
+de100_tilemap_get(const De100Tilemap *map, i32 col, i32 row) {
+  if (col < 0 || row < 0 || col >= map->width || row >= map->height) {
+    return DE100_TILEMAP_EMPTY;
+  }
+  return map->tiles[(size_t)row * (size_t)map->width + (size_t)col];
+}
+
+// Out-of-range cells are ignored
+de100_file_scoped_fn inline void de100_tilemap_set(De100Tilemap *map, i32 col,
+                                                   i32 row, De100Tile tile) {
+  if (col < 0 || row < 0 || col >= map->width || row >= map->height) {
+    return;
+  }
+  De100Tile *cell = &map->tiles[(size_t)row * (size_t)map->width + col];
+  if (*cell == tile) {
+    return;
+  }
+  *cell = tile;
+  map->chunk_is_stale[(row / DE100_TILEMAP_CHUNK_TILES) * map->chunks_x +
+                      col / DE100_TILEMAP_CHUNK_TILES] = true;
+}
+
+de100_file_scoped_fn inline void de100_tilemap_fill(De100Tilemap *map,
+                                                    De100Tile tile) {
+  for (i32 row = 0; row < map->height; ++row) {
+    for (i32 col = 0; col < map->width; ++col) {
+      de100_tilemap_set(map, col, row, tile);
+    }
+  }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Chunks
+// ─────────────────────────────────────────────────────────────────────────────
+
+de100_file_scoped_fn inline u32 *
+de100_tilemap_chunk_pixels(const De100Tilemap *map, i32 cx, i32 cy) {
+  return map->chunk_pixels + (size_t)(cy * map->chunks_x + cx) *
+                                 (size_t)map->chunk_width *
+                                 (size_t)map->chunk_height;
+}
+
+// Pixel size of chunk (cx, cy); edge chunks are cut to the map
+de100_file_scoped_fn inline De100Sprite
+de100_tilemap_chunk_sprite(const De100Tilemap *map, i32 cx, i32 cy) {
+  i32 first_col = cx * DE100_TILEMAP_CHUNK_TILES;
+  i32 first_row = cy * DE100_TILEMAP_CHUNK_TILES;
+  i32 cols = map->width - first_col < DE100_TILEMAP_CHUNK_TILES
+                 ? map->width - first_col
+                 : DE100_TILEMAP_CHUNK_TILES;
+  i32 rows = map->height - first_row < DE100_TILEMAP_CHUNK_TILES
+                 ? map->height - first_row
+                 : DE100_TILEMAP_CHUNK_TILES;
+  return de100_sprite_make(de100_tilemap_chunk_pixels(map, cx, cy),
+                           cols * map->tileset.tile_width,
+                           rows * map->tileset.tile_height,
+                           map->chunk_width * 4);
+}
+
+/**
+ * Re-render chunk (cx, cy) from the tileset into its cache.
+ */
+de100_file_scoped_fn inline void
+de100_tilemap_render_chunk(De100Tilemap *map, i32 cx, i32 cy) {
+  const De100Tileset *tileset = &map->tileset;
+  De100Sprite chunk = de100_tilemap_chunk_sprite(map, cx, cy);
+  // A GameBackBuffer over the cache, so the sprite blitter can target it
+  GameBackBuffer target = {
+      .width = chunk.width,
+      .height = chunk.height,
+      .pitch = chunk.pitch,
+      .bytes_per_pixel = 4,
+      .pixel_format = DE100_PIXEL_FORMAT,
+  };
+  target.memory.base = (void *)chunk.pixels;
+  De100RenderClipRect clip = {0, 0, chunk.width, chunk.height};
+  de100_pixel_fill_row_t *fill_row = de100_pixel_kernels_get()->fill_row;
+
+  i32 first_col = cx * DE100_TILEMAP_CHUNK_TILES;
+  i32 first_row = cy * DE100_TILEMAP_CHUNK_TILES;
+  i32 cols = chunk.width / tileset->tile_width;
+  i32 rows = chunk.height / tileset->tile_height;
+  for (i32 row = 0; row < rows; ++row) {
+    const De100Tile *tiles =
+        map->tiles + (size_t)(first_row + row) * (size_t)map->width +
+        first_col;
+    i32 y = row * tileset->tile_height;
+    for (i32 col = 0; col < cols; ++col) {
+      i32 x = col * tileset->tile_width;
+      De100Tile tile = tiles[col];
+      bool has_art = tile != DE100_TILEMAP_EMPTY &&
+                     (i32)tile < tileset->tile_count;
+      if (!has_art || tileset->mode != DE100_SPRITE_BLIT_OPAQUE) {
+        for (i32 py = y; py < y + tileset->tile_height; ++py) {
+          fill_row((u32 *)(chunk.pixels + (size_t)py * (size_t)chunk.pitch) +
+                       x,
+                   tileset->tile_width, map->clear_color);
+        }
+      }
+      if (has_art) {
+        De100Sprite frame = de100_sprite_frame(
+            &tileset->sheet, (tile % tileset->columns) * tileset->tile_width,
+            (tile / tileset->columns) * tileset->tile_height,
+            tileset->tile_width, tileset->tile_height);
+        de100_sprite_blit_clipped(&target, clip, &frame, x, y, tileset->mode);
+      }
+    }
+  }
+  map->chunk_is_stale[cy * map->chunks_x + cx] = false;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Draw
+// ─────────────────────────────────────────────────────────────────────────────
+
+/**
+ * Draw the map with its top-left at (x, y), restricted to `clip`.
+ * Re-renders stale chunks that intersect the clip; others stay stale.
+ */
+de100_file_scoped_fn inline void
+de100_tilemap_draw_clipped(GameBackBuffer *buffer, De100RenderClipRect clip,
+                           De100Tilemap *map, i32 x, i32 y) {
+  if (!map->tiles) {
+    return;
+  }
+  // Visible chunk range (floor division: x may be far left of the clip)
+  i32 cx0 = clip.min_x - x;
+  i32 cy0 = clip.min_y - y;
+  i32 cx1 = clip.max_x - x;
+  i32 cy1 = clip.max_y - y;
+  cx0 = cx0 > 0 ? cx0 / map->chunk_width : 0;
+  cy0 = cy0 > 0 ? cy0 / map->chunk_height : 0;
+  cx1 = cx1 > 0 ? (cx1 + map->chunk_width - 1) / map->chunk_width : 0;
+  cy1 = cy1 > 0 ? (cy1 + map->chunk_height - 1) / map->chunk_height : 0;
+  cx1 = cx1 < map->chunks_x ? cx1 : map->chunks_x;
+  cy1 = cy1 < map->chunks_y ? cy1 : map->chunks_y;
+
+  De100SpriteBlitMode mode = (map->clear_color >> 24) == 255
+                                 ? DE100_SPRITE_BLIT_OPAQUE
+                                 : DE100_SPRITE_BLIT_PREMULTIPLIED;
+  for (i32 cy = cy0; cy < cy1; ++cy) {
+    for (i32 cx = cx0; cx < cx1; ++cx) {
+      if (map->chunk_is_stale[cy * map->chunks_x + cx]) {
+        de100_tilemap_render_chunk(map, cx, cy);
+      }
+      De100Sprite chunk = de100_tilemap_chunk_sprite(map, cx, cy);
+      de100_sprite_blit_clipped(buffer, clip, &chunk,
+                                x + cx * map->chunk_width,
+                                y + cy * map->chunk_height, mode);
+    }
+  }
+}
+
+/**
+ * Immediate-mode draw over the whole buffer (marks the map's rect dirty).
+ */
+de100_file_scoped_fn inline void de100_tilemap_draw(GameBackBuffer *buffer,
+                                                    De100Tilemap *map, i32 x,
+                                                    i32 y) {
+  if (buffer->is_rendering_disabled) {
+    return;
+  }
+  De100RenderClipRect clip = {0, 0, buffer->width, buffer->height};
+  de100_backbuffer_mark_dirty(buffer, x, y,
+                              map->width * map->tileset.tile_width,
+                              map->height * map->tileset.tile_height);
+  de100_tilemap_draw_clipped(buffer, clip, map, x, y);
+}
+
+#endif // DE100_GAME_TILEMAP_H
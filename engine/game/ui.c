@@ -0,0 +1,277 @@
+#include "ui.h"
+
+#include <string.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// IDS
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define UI_FNV_OFFSET 2166136261u
+#define UI_FNV_PRIME 16777619u
+
+de100_file_scoped_fn inline u32 ui_hash_bytes(u32 hash, const char *text) {
+  for (; *text; ++text) {
+    hash = (hash ^ (u8)*text) * UI_FNV_PRIME;
+  }
+  return hash;
+}
+
+de100_file_scoped_fn inline u32 ui_hash_u32(u32 hash, u32 value) {
+  for (u32 byte = 0; byte < 4; ++byte) {
+    hash = (hash ^ ((value >> (8 * byte)) & 0xFF)) * UI_FNV_PRIME;
+  }
+  return hash;
+}
+
+de100_file_scoped_fn inline u32 ui_id_seed(const De100Ui *ui) {
+  return ui->id_depth > 0 ? ui->id_stack[ui->id_depth - 1] : UI_FNV_OFFSET;
+}
+
+De100UiId de100_ui_id(const De100Ui *ui, const char *label) {
+  De100UiId id = ui_hash_bytes(ui_id_seed(ui), label);
+  return id ? id : 1;
+}
+
+void de100_ui_push_id(De100Ui *ui, u32 value) {
+  DEV_ASSERT_MSG(ui->id_depth < DE100_UI_ID_STACK_DEPTH,
+                 "UI ID stack deeper than %d", DE100_UI_ID_STACK_DEPTH);
+  if (ui->id_depth < DE100_UI_ID_STACK_DEPTH) {
+    ui->id_stack[ui->id_depth] = ui_hash_u32(ui_id_seed(ui), value);
+    ui->id_depth++;
+  }
+}
+
+void de100_ui_pop_id(De100Ui *ui) {
+  DEV_ASSERT_MSG(ui->id_depth > 0, "UI ID stack popped %s", "empty");
+  if (ui->id_depth > 0) {
+    ui->id_depth--;
+  }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// LAYOUT CACHE
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// Open addressing on the widget ID, at most DE100_UI_LAYOUT_PROBES slots
+// from its home. A widget whose content changed is laid out again in its
+// own slot; a new widget takes an empty slot or the probed slot that went
+// unused the longest.
+
+/**
+ * The widget's layout, redone if `label` or the requested size changed.
+ * NULL only when every probed slot is already in use this frame.
+ */
+de100_file_scoped_fn De100UiLayout *ui_layout(De100Ui *ui, De100UiId id,
+                                              const char *label, i32 width,
+                                              i32 height) {
+  u32 content_hash = ui_hash_bytes(UI_FNV_OFFSET, label);
+  content_hash = ui_hash_u32(content_hash, (u32)width);
+  content_hash = ui_hash_u32(content_hash, (u32)height);
+  content_hash = ui_hash_u32(content_hash, (u32)(uintptr_t)ui->font);
+  content_hash = content_hash ? content_hash : 1;
+
+  De100UiLayout *victim = NULL;
+  for (u32 probe = 0; probe < DE100_UI_LAYOUT_PROBES; ++probe) {
+    De100UiLayout *layout = &ui->layouts[(id + probe) & ui->layout_mask];
+    if (layout->content_hash != 0 && layout->id == id) {
+      victim = layout;
+      break;
+    }
+    if (layout->content_hash == 0) {
+      if (!victim || victim->content_hash != 0) {
+        victim = layout;
+      }
+    } else if (!victim || (victim->content_hash != 0 &&
+                           layout->last_used_frame < victim->last_used_frame)) {
+      victim = layout;
+    }
+  }
+
+  if (victim->id == id && victim->content_hash == content_hash) {
+    victim->last_used_frame = ui->frame;
+    ui->stats.layout_hits++;
+    return victim;
+  }
+  if (victim->id != id && victim->content_hash != 0 &&
+      victim->last_used_frame == ui->frame) {
+    // Its glyphs are still referenced by this frame's commands
+    DEV_ASSERT_MSG(false, "UI layout cache full (%u entries)",
+                   ui->layout_mask + 1);
+    return NULL;
+  }
+
+  ui->stats.layout_misses++;
+  victim->id = id;
+  victim->content_hash = content_hash;
+  victim->last_used_frame = ui->frame;
+  i32 text_width = 0;
+  u32 glyph_count = de100_font_layout_glyphs(
+      ui->font, label, victim->glyphs, DE100_UI_MAX_TEXT_BYTES, &text_width);
+  victim->text_width = text_width;
+  victim->width = width > 0 ? width : text_width + 2 * ui->style.padding_x;
+  victim->height = height > 0
+                       ? height
+                       : ui->font->line_height + 2 * ui->style.padding_y;
+  victim->run.font = ui->font;
+  victim->run.glyphs = victim->glyphs;
+  victim->run.glyph_count = glyph_count;
+  return victim;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// HIT-TESTING
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn inline bool ui_rect_contains(De100RenderClipRect rect,
+                                                  i32 x, i32 y) {
+  return x >= rect.min_x && x < rect.max_x && y >= rect.min_y &&
+         y < rect.max_y;
+}
+
+/**
+ * Queue the widget's rect for de100_ui_end and answer from the last
+ * frame's hit-test (and the mouse still being over it).
+ */
+de100_file_scoped_fn De100UiInteraction ui_interact(De100Ui *ui, De100UiId id,
+                                                    i32 x, i32 y, i32 width,
+                                                    i32 height) {
+  De100RenderClipRect rect = {x, y, x + width, y + height};
+  if (ui->hit_rect_count < DE100_UI_MAX_WIDGETS) {
+    ui->hit_rects[ui->hit_rect_count].id = id;
+    ui->hit_rects[ui->hit_rect_count].rect = rect;
+    ui->hit_rect_count++;
+  } else {
+    ui->stats.hit_rects_dropped++;
+  }
+
+  De100UiInteraction result = {0};
+  bool is_over = ui_rect_contains(rect, ui->mouse_x, ui->mouse_y);
+  result.is_hot = ui->hot_id == id && is_over;
+  if (result.is_hot && ui->mouse_went_down) {
+    ui->active_id = id;
+  }
+  if (ui->active_id == id) {
+    result.is_pressed = ui->mouse_down;
+    result.is_clicked = ui->mouse_went_up && is_over;
+  }
+  return result;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// FRAME
+// ═══════════════════════════════════════════════════════════════════════════
+
+De100UiStyle de100_ui_default_style(void) {
+  De100UiStyle style = {
+      .button_color = DE100_RGBA(48, 52, 64, 230),
+      .button_hot_color = DE100_RGBA(72, 80, 100, 240),
+      .button_pressed_color = DE100_RGBA(32, 36, 44, 255),
+      .text_color = DE100_RGB(235, 235, 240),
+      .padding_x = 8,
+      .padding_y = 4,
+  };
+  return style;
+}
+
+bool de100_ui_init(De100Ui *ui, De100MemoryArena *arena, De100Font *font,
+                   u32 max_layouts) {
+  u32 capacity = 1;
+  while (capacity < max_layouts) {
+    capacity <<= 1;
+  }
+  De100UiLayout *layouts =
+      de100_arena_push_array_zero(arena, capacity, De100UiLayout);
+  if (!layouts) {
+    return false;
+  }
+
+  memset(ui, 0, sizeof(*ui));
+  ui->font = font;
+  ui->style = de100_ui_default_style();
+  ui->layouts = layouts;
+  ui->layout_mask = capacity - 1;
+  return true;
+}
+
+void de100_ui_begin(De100Ui *ui, De100RenderGroup *group, i32 mouse_x,
+                    i32 mouse_y, const GameButtonState *button) {
+  ui->group = group;
+  ui->mouse_x = mouse_x;
+  ui->mouse_y = mouse_y;
+  ui->mouse_down = button->ended_down;
+  // Two transitions in one frame are a whole click
+  ui->mouse_went_down =
+      (button->ended_down && button->half_transition_count > 0) ||
+      button->half_transition_count > 1;
+  ui->mouse_went_up =
+      (!button->ended_down && button->half_transition_count > 0) ||
+      button->half_transition_count > 1;
+  ui->hit_rect_count = 0;
+  ui->id_depth = 0;
+  ui->frame++;
+}
+
+void de100_ui_end(De100Ui *ui) {
+  DEV_ASSERT_MSG(ui->id_depth == 0, "UI ID stack left %u deep",
+                 ui->id_depth);
+  ui->hot_id = 0;
+  for (u32 i = ui->hit_rect_count; i > 0; --i) {
+    if (ui_rect_contains(ui->hit_rects[i - 1].rect, ui->mouse_x,
+                         ui->mouse_y)) {
+      ui->hot_id = ui->hit_rects[i - 1].id;
+      break;
+    }
+  }
+  if (!ui->mouse_down || ui->mouse_went_up) {
+    ui->active_id = 0;
+  }
+  ui->group = NULL;
+}
+
+bool de100_ui_is_mouse_captured(const De100Ui *ui) {
+  return ui->hot_id != 0 || ui->active_id != 0;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// WIDGETS
+// ═══════════════════════════════════════════════════════════════════════════
+
+De100UiInteraction de100_ui_region(De100Ui *ui, const char *label, i32 x,
+                                   i32 y, i32 width, i32 height) {
+  return ui_interact(ui, de100_ui_id(ui, label), x, y, width, height);
+}
+
+De100UiInteraction de100_ui_button_ex(De100Ui *ui, const char *label, i32 x,
+                                      i32 y, i32 width, i32 height) {
+  De100UiInteraction result = {0};
+  De100UiId id = de100_ui_id(ui, label);
+  De100UiLayout *layout = ui_layout(ui, id, label, width, height);
+  if (!layout) {
+    return result;
+  }
+
+  result = ui_interact(ui, id, x, y, layout->width, layout->height);
+  u32 color = result.is_pressed ? ui->style.button_pressed_color
+              : result.is_hot   ? ui->style.button_hot_color
+                                : ui->style.button_color;
+  de100_push_rect(ui->group, x, y, layout->width, layout->height, color);
+  de100_push_glyphs(ui->group, &layout->run,
+                    x + (layout->width - layout->text_width) / 2,
+                    y + (layout->height - ui->font->line_height) / 2,
+                    layout->text_width, ui->style.text_color);
+  return result;
+}
+
+bool de100_ui_button(De100Ui *ui, const char *label, i32 x, i32 y, i32 width,
+                     i32 height) {
+  return de100_ui_button_ex(ui, label, x, y, width, height).is_clicked;
+}
+
+i32 de100_ui_label(De100Ui *ui, const char *text, i32 x, i32 y, u32 color) {
+  De100UiLayout *layout = ui_layout(ui, de100_ui_id(ui, text), text, 0, 0);
+  if (!layout) {
+    return 0;
+  }
+  de100_push_glyphs(ui->group, &layout->run, x, y, layout->text_width, color);
+  return layout->text_width;
+}
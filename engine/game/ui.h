@@ -0,0 +1,190 @@
+#ifndef DE100_GAME_UI_H
+#define DE100_GAME_UI_H
+
+#include "../_common/base.h"
+#include "font.h"
+#include "inputs-base.h"
+#include "memory-arena.h"
+#include "render-group.h"
+#include <stdbool.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// 🖱️ IMMEDIATE-MODE UI (buttons, labels, hover regions)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// Widgets are function calls made while recording the frame; there is no
+// retained widget tree to keep in sync with game state. A call both draws
+// the widget (rect + text commands into the render group) and answers
+// whether it was hovered or clicked:
+//
+//   de100_ui_begin(&state->ui, group, input->mouse_x, input->mouse_y,
+//                  &input->mouse_buttons[0]);
+//   for (u32 i = 0; i < TOWER_TYPE_COUNT; ++i) {
+//     de100_ui_push_id(&state->ui, i);
+//     if (de100_ui_button(&state->ui, tower_names[i], x, y + 30 * i, 120,
+//                         0)) {
+//       select_tower(state, i);
+//     }
+//     de100_ui_pop_id(&state->ui);
+//   }
+//   de100_ui_label(&state->ui, target_mode_name(t), x, y2, text_color);
+//   de100_ui_end(&state->ui);
+//
+// What makes it cheap:
+//
+//   IDs         A widget is identified by its label hashed with the ID
+//               stack (push an index for widgets built in a loop), so the
+//               same button is recognised frame to frame.
+//   Layout      Text layout and widget size are cached per ID and only
+//               redone when the label, font or requested size changes: a
+//               menu that doesn't change costs a table lookup per widget.
+//               The cached glyphs are what the text commands point at.
+//   Hit-tests   Widgets only append their rect to a per-frame list;
+//               de100_ui_end() tests the mouse against the whole list in
+//               one pass, topmost (last drawn) first. Widgets answer from
+//               the previous frame's result, the usual one-frame latency
+//               of immediate-mode UIs.
+//
+// A click is press and release on the same widget. The widget that took
+// the press holds it until release (de100_ui_is_mouse_captured lets the
+// game ignore that click in the world).
+//
+// Layout entries point into the font's glyph table and hold the glyphs
+// the render group draws from, so a De100Ui must outlive the frames it
+// recorded (keep it in permanent storage next to its font).
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define DE100_UI_MAX_WIDGETS 256     // Hit rects per frame
+#define DE100_UI_ID_STACK_DEPTH 16
+#define DE100_UI_MAX_TEXT_BYTES 48   // Longer labels are cut off
+#define DE100_UI_LAYOUT_PROBES 8     // Open addressing probe limit
+
+typedef u32 De100UiId; // 0 = none
+
+typedef struct {
+  u32 button_color;
+  u32 button_hot_color;
+  u32 button_pressed_color;
+  u32 text_color;
+  i32 padding_x; // Text inset in auto-sized buttons
+  i32 padding_y;
+} De100UiStyle;
+
+typedef struct {
+  bool32 is_hot;     // Under the mouse
+  bool32 is_pressed; // Took the press, mouse button still down
+  bool32 is_clicked; // Released over it this frame
+} De100UiInteraction;
+
+/** Cached size and laid-out text of one widget. */
+typedef struct {
+  De100UiId id;
+  u32 content_hash; // Label, font and requested size; 0 = empty
+  u32 last_used_frame;
+  i32 width;
+  i32 height;
+  i32 text_width;
+  De100RenderGlyphRun run;
+  De100FontPlacedGlyph glyphs[DE100_UI_MAX_TEXT_BYTES];
+} De100UiLayout;
+
+typedef struct {
+  De100UiId id;
+  De100RenderClipRect rect;
+} De100UiHitRect;
+
+typedef struct {
+  u64 layout_hits;
+  u64 layout_misses;
+  u64 hit_rects_dropped; // Widgets past DE100_UI_MAX_WIDGETS in a frame
+} De100UiStats;
+
+typedef struct {
+  De100Font *font;
+  De100UiStyle style;
+
+  // Current frame (de100_ui_begin)
+  De100RenderGroup *group;
+  i32 mouse_x;
+  i32 mouse_y;
+  bool32 mouse_down;
+  bool32 mouse_went_down;
+  bool32 mouse_went_up;
+  u32 frame;
+
+  De100UiId hot_id;    // Resolved by the last de100_ui_end
+  De100UiId active_id; // Holds the press until release
+
+  De100UiHitRect hit_rects[DE100_UI_MAX_WIDGETS];
+  u32 hit_rect_count;
+
+  De100UiId id_stack[DE100_UI_ID_STACK_DEPTH];
+  u32 id_depth;
+
+  De100UiLayout *layouts;
+  u32 layout_mask; // Capacity - 1 (power of two)
+
+  De100UiStats stats;
+} De100Ui;
+
+/**
+ * Set up `ui` drawing with `font`, caching the layout of up to
+ * `max_layouts` widgets (rounded up to a power of two) pushed from
+ * `arena`.
+ *
+ * @return false (nothing pushed) if the arena is full
+ */
+bool de100_ui_init(De100Ui *ui, De100MemoryArena *arena, De100Font *font,
+                   u32 max_layouts);
+
+De100UiStyle de100_ui_default_style(void);
+
+/**
+ * Start a frame: widgets record into `group`. The mouse is in backbuffer
+ * pixels; `button` is the one that clicks (usually mouse_buttons[0]).
+ */
+void de100_ui_begin(De100Ui *ui, De100RenderGroup *group, i32 mouse_x,
+                    i32 mouse_y, const GameButtonState *button);
+
+/** Hit-test this frame's widgets against the mouse, for the next frame. */
+void de100_ui_end(De100Ui *ui);
+
+/** Scope the IDs of widgets built in a loop (or sharing a label). */
+void de100_ui_push_id(De100Ui *ui, u32 value);
+void de100_ui_pop_id(De100Ui *ui);
+
+/** ID of the widget labelled `label` at the current ID stack. */
+De100UiId de100_ui_id(const De100Ui *ui, const char *label);
+
+/**
+ * An invisible widget: hover and click state of the (x, y, width, height)
+ * rect, for hotspots the game draws itself.
+ */
+De100UiInteraction de100_ui_region(De100Ui *ui, const char *label, i32 x,
+                                   i32 y, i32 width, i32 height);
+
+/**
+ * A button with `label` centered on it. `width` / `height` of 0 fit the
+ * text plus the style's padding.
+ *
+ * @return true when clicked this frame
+ */
+bool de100_ui_button(De100Ui *ui, const char *label, i32 x, i32 y, i32 width,
+                     i32 height);
+
+/** de100_ui_button, with the full interaction state. */
+De100UiInteraction de100_ui_button_ex(De100Ui *ui, const char *label, i32 x,
+                                      i32 y, i32 width, i32 height);
+
+/**
+ * Text with the top of its line box at (x, y).
+ *
+ * @return its width in pixels
+ */
+i32 de100_ui_label(De100Ui *ui, const char *text, i32 x, i32 y, u32 color);
+
+/** The mouse belongs to a widget (hovered or pressed): not the world's. */
+bool de100_ui_is_mouse_captured(const De100Ui *ui);
+
+#endif // DE100_GAME_UI_H
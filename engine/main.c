@@ -1,5 +1,9 @@
 #include "./platforms/_common/backend.h"
+#include "./platforms/_common/benchmark.h"
+#include "./platforms/_common/fixed-timestep.h"
 #include "_common/path.h"
+#include <stdlib.h>
+#include <string.h>
 
 #if DE100_INTERNAL
 #include "./_common/base.h"
@@ -10,8 +14,19 @@
 int main(int argc, char **argv) {
   de100_path_on_init(argc, argv);
 
-  (void)argc;
-  (void)argv;
+  // --time-scale <N>: fast-forward from the start (fixed-timestep.h)
+  for (int i = 1; i + 1 < argc; ++i) {
+    if (strcmp(argv[i], "--time-scale") == 0) {
+      g_fixed_timestep.forced_time_scale = (f32)atof(argv[i + 1]);
+    }
+  }
+
+  // --benchmark <recording.hmr>: same binary, no window (benchmark.h)
+  for (int i = 1; i + 1 < argc; ++i) {
+    if (strcmp(argv[i], "--benchmark") == 0) {
+      return benchmark_main(argv[i + 1]);
+    }
+  }
 
 #if DE100_INTERNAL
   f64 main_start = de100_get_wall_clock();
@@ -1,240 +1,195 @@
 #include "adaptive-fps.h"
+#include "dynamic-resolution.h"
 #include "./hooks/utils.h"
 
 #include <stdio.h>
 
 AdaptiveFPS g_adaptive_fps = {0};
 
-void adaptive_fps_init(void) {
-  g_adaptive_fps.frames_sampled = 0;
-  g_adaptive_fps.frames_missed = 0;
-  g_adaptive_fps.sample_window_seconds =
-      1.5f; // Changed: 1.5 seconds of sampling
-  g_adaptive_fps.miss_threshold = 0.10f;
-  g_adaptive_fps.recover_threshold = 0.02f;
-  g_adaptive_fps.frames_since_last_change = 0;
-  g_adaptive_fps.cooldown_frames = 180;
-  g_adaptive_fps.consecutive_good_frames = 0;
-  g_adaptive_fps.recent_frame_index = 0;
-  g_adaptive_fps.recent_frame_count = 0; // Added
-
-  for (int i = 0; i < 10; i++) {
-    g_adaptive_fps.recent_frame_times[i] = 0.0f;
-  }
-}
-
-de100_file_scoped_fn inline void
-adaptive_fps_record_frame(f32 frame_time_ms, f32 target_frame_time_ms) {
-  g_adaptive_fps.frames_sampled++;
-  g_adaptive_fps.frames_since_last_change++;
-
-  // Track recent frame times
-  g_adaptive_fps.recent_frame_times[g_adaptive_fps.recent_frame_index] =
-      frame_time_ms;
-  g_adaptive_fps.recent_frame_index =
-      (g_adaptive_fps.recent_frame_index + 1) % 10;
-
-  // Track valid sample count
-  if (g_adaptive_fps.recent_frame_count < 10) {
-    g_adaptive_fps.recent_frame_count++;
-  }
-
-  // Check if frame missed (with tolerance)
-  bool frame_missed = (frame_time_ms > (target_frame_time_ms + 3.0f));
-
-  if (frame_missed) {
-    g_adaptive_fps.frames_missed++;
-    g_adaptive_fps.consecutive_good_frames = 0;
+de100_file_scoped_global_var const f32 g_adaptive_fps_fallback_tiers[] = {
+    FPS_120, FPS_90, FPS_60, FPS_45, FPS_30,
+};
+
+de100_file_scoped_fn inline void adaptive_fps_build_tiers(f32 monitor_hz,
+                                                          f32 max_hz) {
+  g_adaptive_fps.tier_count = 0;
+
+  if (monitor_hz > 0.0f) {
+    for (u32 divisor = 1;
+         g_adaptive_fps.tier_count < ADAPTIVE_FPS_MAX_TIERS; ++divisor) {
+      f32 hz = monitor_hz / (f32)divisor;
+      if (hz < ADAPTIVE_FPS_MIN_HZ && g_adaptive_fps.tier_count > 0) {
+        break;
+      }
+      if (max_hz <= 0.0f || hz <= max_hz + 0.5f) {
+        g_adaptive_fps.tier_hz[g_adaptive_fps.tier_count++] = hz;
+      }
+      if (hz < ADAPTIVE_FPS_MIN_HZ) {
+        break; // Slow monitor: its rate is the only tier
+      }
+    }
   } else {
-    g_adaptive_fps.consecutive_good_frames++;
-  }
-}
-
-de100_file_scoped_fn inline f32 adaptive_fps_get_recent_median(void) {
-  if (g_adaptive_fps.recent_frame_count == 0) {
-    return 0.0f;
-  }
-
-  // Copy to temporary array for sorting
-  f32 sorted[10];
-  for (int i = 0; i < g_adaptive_fps.recent_frame_count; i++) {
-    sorted[i] = g_adaptive_fps.recent_frame_times[i];
-  }
-
-  // Insertion sort (fast for small arrays)
-  for (int i = 1; i < g_adaptive_fps.recent_frame_count; i++) {
-    f32 key = sorted[i];
-    int j = i - 1;
-    while (j >= 0 && sorted[j] > key) {
-      sorted[j + 1] = sorted[j];
-      j--;
+    for (u32 i = 0; i < ArraySize(g_adaptive_fps_fallback_tiers); ++i) {
+      f32 hz = g_adaptive_fps_fallback_tiers[i];
+      if (max_hz <= 0.0f || hz <= max_hz) {
+        g_adaptive_fps.tier_hz[g_adaptive_fps.tier_count++] = hz;
+      }
     }
-    sorted[j + 1] = key;
   }
 
-  // Return median
-  if (g_adaptive_fps.recent_frame_count % 2 == 0) {
-    int mid = g_adaptive_fps.recent_frame_count / 2;
-    return (sorted[mid - 1] + sorted[mid]) / 2.0f;
-  } else {
-    return sorted[g_adaptive_fps.recent_frame_count / 2];
+  // max_hz below every tier: run at max_hz alone
+  if (g_adaptive_fps.tier_count == 0) {
+    g_adaptive_fps.tier_hz[0] = max_hz > 0.0f ? max_hz : FPS_60;
+    g_adaptive_fps.tier_count = 1;
   }
 }
 
-de100_file_scoped_fn inline bool
-adaptive_fps_should_increase(GameConfig *game_config,
-                             f32 target_frame_time_ms) {
-  // Quick recovery check
-  if (g_adaptive_fps.consecutive_good_frames >= 30 &&
-      game_config->target_refresh_rate_hz <
-          game_config->max_allowed_refresh_rate_hz &&
-      g_adaptive_fps.frames_since_last_change >= 90) {
-
-    f32 median_recent = adaptive_fps_get_recent_median(); // Changed
-    f32 headroom_threshold = target_frame_time_ms * 0.80f;
-
-    if (median_recent < headroom_threshold) {
-      return true;
-    }
-  }
-
-  // Calculate required samples based on time window
-  u32 required_samples = (u32)(g_adaptive_fps.sample_window_seconds *
-                               (f32)game_config->target_refresh_rate_hz);
-
-  // Regular evaluation
-  if (g_adaptive_fps.frames_sampled >= required_samples &&
-      g_adaptive_fps.frames_since_last_change >=
-          g_adaptive_fps.cooldown_frames) {
-
-    f32 miss_rate =
-        (f32)g_adaptive_fps.frames_missed / (f32)g_adaptive_fps.frames_sampled;
+de100_file_scoped_fn inline void adaptive_fps_reset_signals(void) {
+  g_adaptive_fps.has_samples = false;
+  g_adaptive_fps.miss_rate = 0.0f;
+  g_adaptive_fps.down_seconds = 0.0f;
+  g_adaptive_fps.up_seconds = 0.0f;
+  g_adaptive_fps.seconds_since_change = 0.0f;
+}
 
-    if (miss_rate < g_adaptive_fps.recover_threshold &&
-        game_config->target_refresh_rate_hz <
-            game_config->max_allowed_refresh_rate_hz) {
-      return true;
-    }
-  }
+de100_file_scoped_fn inline void
+adaptive_fps_apply_tier(GameConfig *game_config, u32 tier_index) {
+  f32 hz = g_adaptive_fps.tier_hz[tier_index];
+  g_adaptive_fps.tier_index = tier_index;
 
-  return false;
+  game_config->target_refresh_rate_hz = (u32)(hz + 0.5f);
+  game_config->target_seconds_per_frame = 1.0f / hz;
+  de100_set_target_fps(game_config->target_refresh_rate_hz);
 }
 
-de100_file_scoped_fn inline bool
-adaptive_fps_should_decrease(GameConfig *game_config) {
-  // Calculate required samples based on time window
-  u32 required_samples = (u32)(g_adaptive_fps.sample_window_seconds *
-                               (f32)game_config->target_refresh_rate_hz);
-
-  if (g_adaptive_fps.frames_sampled >= required_samples &&
-      g_adaptive_fps.frames_since_last_change >=
-          g_adaptive_fps.cooldown_frames) {
+void adaptive_fps_init(GameConfig *game_config, u32 monitor_hz) {
+  g_adaptive_fps = (AdaptiveFPS){0};
+  g_adaptive_fps.monitor_hz = (f32)monitor_hz;
+  g_adaptive_fps.up_hold_seconds = ADAPTIVE_FPS_UP_HOLD_SECONDS;
 
-    f32 miss_rate =
-        (f32)g_adaptive_fps.frames_missed / (f32)g_adaptive_fps.frames_sampled;
+  adaptive_fps_build_tiers((f32)monitor_hz,
+                           (f32)game_config->max_allowed_refresh_rate_hz);
 
-    if (miss_rate > g_adaptive_fps.miss_threshold) {
-      return true;
-    }
+  // Start on the fastest tier not above the current target
+  u32 start = 0;
+  while (start + 1 < g_adaptive_fps.tier_count &&
+         g_adaptive_fps.tier_hz[start] >
+             (f32)game_config->target_refresh_rate_hz + 0.5f) {
+    ++start;
   }
-
-  return false;
-}
-
-de100_file_scoped_fn inline u32 adaptive_fps_get_next_higher(u32 current_fps,
-                                                             u32 monitor_hz) {
-  u32 next_fps;
-
-  switch (current_fps) {
-  case FPS_30:
-    next_fps = FPS_45;
-    break;
-  case FPS_45:
-    next_fps = FPS_60;
-    break;
-  case FPS_60:
-    next_fps = FPS_90;
-    break;
-  case FPS_90:
-    next_fps = FPS_120;
-    break;
-  default:
-    next_fps = monitor_hz;
-    break;
+  g_adaptive_fps.tier_index = start;
+  if (game_config->prefer_adaptive_fps) {
+    adaptive_fps_apply_tier(game_config, start);
   }
 
-  return (next_fps > monitor_hz) ? monitor_hz : next_fps;
-}
-
-de100_file_scoped_fn inline u32 adaptive_fps_get_next_lower(u32 current_fps) {
-  switch (current_fps) {
-  case FPS_120:
-    return FPS_90;
-  case FPS_90:
-    return FPS_60;
-  case FPS_60:
-    return FPS_45;
-  case FPS_45:
-    return FPS_30;
-  default:
-    return FPS_30;
+#if DE100_INTERNAL
+  printf("🎚️  Adaptive FPS tiers (monitor %uHz):", monitor_hz);
+  for (u32 i = 0; i < g_adaptive_fps.tier_count; ++i) {
+    printf(" %.1f", g_adaptive_fps.tier_hz[i]);
   }
+  printf("\n");
+#endif
 }
 
-de100_file_scoped_fn inline void
-adaptive_fps_apply_change(GameConfig *game_config, u32 new_fps) {
-  game_config->target_refresh_rate_hz = new_fps;
-  game_config->target_seconds_per_frame = 1.0f / (f32)new_fps;
-
-  g_adaptive_fps.frames_since_last_change = 0;
-  g_adaptive_fps.frames_sampled = 0;
-  g_adaptive_fps.frames_missed = 0;
-  g_adaptive_fps.consecutive_good_frames = 0;
-  g_adaptive_fps.recent_frame_count = 0; // Added: reset valid sample count
-
-  de100_set_target_fps(new_fps);
+de100_file_scoped_fn inline f32 adaptive_fps_ewma(f32 average, f32 sample,
+                                                  f32 alpha) {
+  return average + (sample - average) * alpha;
 }
 
-de100_file_scoped_fn inline void adaptive_fps_reset_window(void) {
-  g_adaptive_fps.frames_sampled = 0;
-  g_adaptive_fps.frames_missed = 0;
+de100_file_scoped_fn inline void adaptive_fps_record(f32 frame_time_ms,
+                                                     f32 work_time_ms,
+                                                     f32 budget_ms) {
+  f32 sleep_ms = frame_time_ms - work_time_ms;
+  f32 missed =
+      frame_time_ms > budget_ms + ADAPTIVE_FPS_MISS_TOLERANCE_MS ? 1.0f : 0.0f;
+
+  if (!g_adaptive_fps.has_samples) {
+    g_adaptive_fps.work_ms = work_time_ms;
+    g_adaptive_fps.sleep_ms = sleep_ms;
+    g_adaptive_fps.frame_ms = frame_time_ms;
+    g_adaptive_fps.has_samples = true;
+  } else {
+    g_adaptive_fps.work_ms = adaptive_fps_ewma(
+        g_adaptive_fps.work_ms, work_time_ms, ADAPTIVE_FPS_EWMA_ALPHA);
+    g_adaptive_fps.sleep_ms = adaptive_fps_ewma(g_adaptive_fps.sleep_ms,
+                                                sleep_ms, ADAPTIVE_FPS_EWMA_ALPHA);
+    g_adaptive_fps.frame_ms = adaptive_fps_ewma(
+        g_adaptive_fps.frame_ms, frame_time_ms, ADAPTIVE_FPS_EWMA_ALPHA);
+  }
+  g_adaptive_fps.miss_rate = adaptive_fps_ewma(g_adaptive_fps.miss_rate,
+                                               missed, ADAPTIVE_FPS_MISS_ALPHA);
 }
 
-void adaptive_fps_update(GameConfig *game_config, f32 frame_time_ms) {
-  if (!game_config->prefer_adaptive_fps) {
+void adaptive_fps_update(GameConfig *game_config, f32 frame_time_ms,
+                         f32 work_time_ms) {
+  if (!game_config->prefer_adaptive_fps || g_adaptive_fps.tier_count == 0) {
     return;
   }
 
-  f32 target_frame_time_ms = game_config->target_seconds_per_frame * 1000.0f;
-
-  adaptive_fps_record_frame(frame_time_ms, target_frame_time_ms);
-
-  // Calculate required samples for window reset check
-  u32 required_samples = (u32)(g_adaptive_fps.sample_window_seconds *
-                               (f32)game_config->target_refresh_rate_hz);
-
-  if (adaptive_fps_should_increase(game_config, target_frame_time_ms)) {
-    u32 old_fps = game_config->target_refresh_rate_hz;
-    u32 new_fps = adaptive_fps_get_next_higher(
-        old_fps, game_config->max_allowed_refresh_rate_hz);
-
-    if (new_fps != old_fps) {
-      adaptive_fps_apply_change(game_config, new_fps);
+  u32 tier = g_adaptive_fps.tier_index;
+  f32 budget_ms = 1000.0f / g_adaptive_fps.tier_hz[tier];
+  f32 frame_seconds = frame_time_ms / 1000.0f;
+
+  adaptive_fps_record(frame_time_ms, work_time_ms, budget_ms);
+  g_adaptive_fps.seconds_since_change += frame_seconds;
+
+  // ─────────────────────────────────────────────────────────────────────
+  // Down band: current budget
+  // ─────────────────────────────────────────────────────────────────────
+  // Dynamic resolution sheds pixels before frames
+  bool over = (g_adaptive_fps.work_ms >
+                   budget_ms * ADAPTIVE_FPS_DOWN_WORK_FRACTION ||
+               g_adaptive_fps.miss_rate > ADAPTIVE_FPS_DOWN_MISS_RATE) &&
+              !dynamic_resolution_can_shrink();
+  g_adaptive_fps.down_seconds = over ? g_adaptive_fps.down_seconds +
+                                           frame_seconds
+                                     : 0.0f;
+
+  // ─────────────────────────────────────────────────────────────────────
+  // Up band: the faster tier's budget
+  // ─────────────────────────────────────────────────────────────────────
+  bool fits_faster = false;
+  if (tier > 0 && dynamic_resolution_is_full()) {
+    f32 faster_budget_ms = 1000.0f / g_adaptive_fps.tier_hz[tier - 1];
+    fits_faster = g_adaptive_fps.work_ms <
+                      faster_budget_ms * ADAPTIVE_FPS_UP_WORK_FRACTION &&
+                  g_adaptive_fps.miss_rate < ADAPTIVE_FPS_UP_MISS_RATE;
+  }
+  g_adaptive_fps.up_seconds = fits_faster ? g_adaptive_fps.up_seconds +
+                                                frame_seconds
+                                          : 0.0f;
+
+  u32 old_hz = game_config->target_refresh_rate_hz;
+
+  if (g_adaptive_fps.down_seconds >= ADAPTIVE_FPS_DOWN_HOLD_SECONDS &&
+      tier + 1 < g_adaptive_fps.tier_count) {
+    // Failed up-shift: wait longer before trying that tier again
+    if (g_adaptive_fps.last_change_was_up &&
+        g_adaptive_fps.seconds_since_change < ADAPTIVE_FPS_UPSHIFT_PROBATION) {
+      g_adaptive_fps.up_hold_seconds *= 2.0f;
+      if (g_adaptive_fps.up_hold_seconds > ADAPTIVE_FPS_UP_HOLD_MAX_SECONDS) {
+        g_adaptive_fps.up_hold_seconds = ADAPTIVE_FPS_UP_HOLD_MAX_SECONDS;
+      }
+    }
+    adaptive_fps_apply_tier(game_config, tier + 1);
+    adaptive_fps_reset_signals();
+    g_adaptive_fps.last_change_was_up = false;
+    printf("⚠️  ADAPTIVE: %u → %u Hz (work %.2fms, miss %.0f%%)\n", old_hz,
+           game_config->target_refresh_rate_hz, g_adaptive_fps.work_ms,
+           g_adaptive_fps.miss_rate * 100.0f);
+  } else if (g_adaptive_fps.up_seconds >= g_adaptive_fps.up_hold_seconds) {
+    adaptive_fps_apply_tier(game_config, tier - 1);
+    adaptive_fps_reset_signals();
+    g_adaptive_fps.last_change_was_up = true;
 #if DE100_INTERNAL
-      printf("✅ ADAPTIVE: %d → %d Hz\n", old_fps, new_fps);
+    printf("✅ ADAPTIVE: %u → %u Hz (work %.2fms)\n", old_hz,
+           game_config->target_refresh_rate_hz, g_adaptive_fps.work_ms);
 #endif
-    }
-  } else if (adaptive_fps_should_decrease(
-                 game_config)) { // Changed: added game_config
-    u32 old_fps = game_config->target_refresh_rate_hz;
-    u32 new_fps = adaptive_fps_get_next_lower(old_fps);
-
-    if (new_fps != old_fps) {
-      adaptive_fps_apply_change(game_config, new_fps);
-      printf("⚠️  ADAPTIVE: %d → %d Hz\n", old_fps, new_fps);
-    }
-  } else if (g_adaptive_fps.frames_sampled >=
-             required_samples) { // Changed: use calculated samples
-    adaptive_fps_reset_window();
+  } else if (g_adaptive_fps.last_change_was_up &&
+             g_adaptive_fps.seconds_since_change >=
+                 ADAPTIVE_FPS_UPSHIFT_PROBATION) {
+    // Up-shift held: relax the hold back toward the default
+    g_adaptive_fps.up_hold_seconds = ADAPTIVE_FPS_UP_HOLD_SECONDS;
+    g_adaptive_fps.last_change_was_up = false;
   }
 }
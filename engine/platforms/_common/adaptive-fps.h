@@ -4,26 +4,87 @@
 #include "../../_common/base.h"
 #include "../../game/config.h"
 
+// ═══════════════════════════════════════════════════════════════════════════
+// 🎚️ ADAPTIVE FPS GOVERNOR
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// TIERS: integer divisors of the monitor rate, so every tier is a whole
+// number of vblanks per frame (no judder):
+//
+//   144Hz monitor → 144, 72, 48, 36     60Hz → 60, 30
+//
+// capped at max_allowed_refresh_rate_hz, floored at ADAPTIVE_FPS_MIN_HZ.
+// With no monitor rate (0) it falls back to 120/90/60/45/30.
+//
+// SIGNALS (EWMA per frame):
+//   work   time the frame actually needed (update + audio + present)
+//   sleep  slack left before the deadline (frame - work)
+//   miss   fraction of frames over budget + tolerance
+//
+// HYSTERESIS: the down and up thresholds are on different budgets, so a game
+// sitting on a boundary can't bounce:
+//
+//   down  work > 95% of the CURRENT budget, or miss > 10%   (held 0.5s)
+//   up    work < 75% of the FASTER tier's budget, miss < 2% (held 2s)
+//
+// With dynamic resolution (dynamic-resolution.h) the backbuffer shrinks
+// to its minimum before a down-shift, and is back to full size before an
+// up-shift.
+//
+// An up-shift that falls back down within ADAPTIVE_FPS_UPSHIFT_PROBATION
+// seconds doubles the hold before that tier is tried again (capped).
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define ADAPTIVE_FPS_MAX_TIERS 8
+#define ADAPTIVE_FPS_MIN_HZ 30.0f
+
+#define ADAPTIVE_FPS_EWMA_ALPHA 0.1f
+#define ADAPTIVE_FPS_MISS_ALPHA 0.05f
+#define ADAPTIVE_FPS_MISS_TOLERANCE_MS 1.0f
+
+#define ADAPTIVE_FPS_DOWN_WORK_FRACTION 0.95f
+#define ADAPTIVE_FPS_DOWN_MISS_RATE 0.10f
+#define ADAPTIVE_FPS_DOWN_HOLD_SECONDS 0.5f
+
+#define ADAPTIVE_FPS_UP_WORK_FRACTION 0.75f
+#define ADAPTIVE_FPS_UP_MISS_RATE 0.02f
+#define ADAPTIVE_FPS_UP_HOLD_SECONDS 2.0f
+#define ADAPTIVE_FPS_UP_HOLD_MAX_SECONDS 30.0f
+#define ADAPTIVE_FPS_UPSHIFT_PROBATION 3.0f
+
 typedef struct {
-  u32 frames_sampled;
-  u32 frames_missed;
-  // Time-based instead of frame-based
-  f32 sample_window_seconds;
-  f32 miss_threshold;
-  f32 recover_threshold;
-  u32 frames_since_last_change;
-  u32 cooldown_frames;
-
-  // Quick recovery tracking
-  u32 consecutive_good_frames;
-  f32 recent_frame_times[10];
-  int recent_frame_index;
-  // Track valid samples
-  int recent_frame_count;
+  // Fastest first
+  f32 tier_hz[ADAPTIVE_FPS_MAX_TIERS];
+  u32 tier_count;
+  u32 tier_index;
+  f32 monitor_hz; // 0 = unknown (fixed fallback tiers)
+
+  // EWMA signals (ms / fraction)
+  f32 work_ms;
+  f32 sleep_ms;
+  f32 frame_ms;
+  f32 miss_rate;
+  bool32 has_samples;
+
+  // Hysteresis timers (seconds of consecutive agreement)
+  f32 down_seconds;
+  f32 up_seconds;
+  f32 up_hold_seconds; // Grows after failed up-shifts
+  f32 seconds_since_change;
+  bool32 last_change_was_up;
 } AdaptiveFPS;
 extern AdaptiveFPS g_adaptive_fps;
 
-void adaptive_fps_init(void);
-void adaptive_fps_update(GameConfig *game_config, f32 frame_time_ms);
+/** Build the tier ladder. monitor_hz 0 = unknown. */
+void adaptive_fps_init(GameConfig *game_config, u32 monitor_hz);
+
+/**
+ * Feed one finished frame. work_time_ms is the part of the frame spent
+ * working (not sleeping / waiting for vblank); pass frame_time_ms if the
+ * backend can't separate them.
+ */
+void adaptive_fps_update(GameConfig *game_config, f32 frame_time_ms,
+                         f32 work_time_ms);
 
 #endif // DE100_PLATFORMS__COMMON_ADAPTIVE_FPS_H
@@ -0,0 +1,60 @@
+#include "./asset-watcher.h"
+#include "../../_common/log.h"
+
+#include <string.h>
+
+De100AssetWatcher g_asset_watcher = {0};
+
+DE100_PLATFORM_ASSET_WATCH(asset_watcher_watch) {
+  if (!watcher || !path) {
+    return 0;
+  }
+  size_t length = strlen(path);
+  if (length == 0 || length >= ASSET_WATCHER_PATH_MAX) {
+    return 0;
+  }
+
+  for (u32 i = 0; i < watcher->count; ++i) {
+    if (strcmp(watcher->entries[i].path, path) == 0) {
+      return i + 1;
+    }
+  }
+  if (watcher->count >= ASSET_WATCHER_MAX_FILES) {
+    DE100_LOG_WARN(DE100_LOG_ASSETS, "Asset '%s' not watched: %u files max",
+                   path, ASSET_WATCHER_MAX_FILES);
+    return 0;
+  }
+
+  De100FileWatchResult watch_result;
+  De100FileWatch *watch = de100_file_watch_start(path, &watch_result);
+  if (!watch) {
+    DE100_LOG_WARN(DE100_LOG_ASSETS, "Asset '%s' not watched: %s", path,
+                   de100_file_watch_strerror(watch_result.error_code));
+    return 0;
+  }
+
+  AssetWatcherEntry *entry = &watcher->entries[watcher->count++];
+  memcpy(entry->path, path, length + 1);
+  entry->watch = watch;
+  entry->version = 0;
+  return watcher->count;
+}
+
+DE100_PLATFORM_ASSET_WATCH_VERSION(asset_watcher_version) {
+  if (!watcher || watch == 0 || watch > watcher->count) {
+    return 0;
+  }
+  AssetWatcherEntry *entry = &watcher->entries[watch - 1];
+  if (de100_file_watch_consume(entry->watch)) {
+    entry->version++;
+    DE100_LOG_INFO(DE100_LOG_ASSETS, "Asset '%s' changed", entry->path);
+  }
+  return entry->version;
+}
+
+void asset_watcher_shutdown(De100AssetWatcher *watcher) {
+  for (u32 i = 0; i < watcher->count; ++i) {
+    de100_file_watch_stop(watcher->entries[i].watch);
+  }
+  *watcher = (De100AssetWatcher){0};
+}
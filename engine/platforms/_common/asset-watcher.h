@@ -0,0 +1,46 @@
+#ifndef DE100_PLATFORMS__COMMON_ASSET_WATCHER_H
+#define DE100_PLATFORMS__COMMON_ASSET_WATCHER_H
+
+#include "../../_common/base.h"
+#include "../../_common/file-watch.h"
+#include "../../game/asset-watch.h"
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ASSET WATCHER (settled-change counters per asset file, DE100_INTERNAL)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// Backs GameMemory.asset_watcher. Each distinct path gets one file watch
+// (file-watch.h, a thread each), so keep the watched set to what is being
+// edited. Watch ids are index + 1; a path is never unwatched before
+// shutdown, so ids stay valid across game hot reloads.
+//
+// Main thread only, no locks. One watcher per process (g_asset_watcher).
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define ASSET_WATCHER_MAX_FILES 32
+#define ASSET_WATCHER_PATH_MAX 256
+
+typedef struct {
+  char path[ASSET_WATCHER_PATH_MAX];
+  De100FileWatch *watch;
+  u32 version; // Settled changes since the watch started
+} AssetWatcherEntry;
+
+struct De100AssetWatcher {
+  AssetWatcherEntry entries[ASSET_WATCHER_MAX_FILES];
+  u32 count;
+};
+
+extern De100AssetWatcher g_asset_watcher;
+
+/** DE100_PLATFORM_ASSET_WATCH, handed to the game. */
+DE100_PLATFORM_ASSET_WATCH(asset_watcher_watch);
+
+/** DE100_PLATFORM_ASSET_WATCH_VERSION, handed to the game. */
+DE100_PLATFORM_ASSET_WATCH_VERSION(asset_watcher_version);
+
+/** Stop every watch (engine shutdown). */
+void asset_watcher_shutdown(De100AssetWatcher *watcher);
+
+#endif // DE100_PLATFORMS__COMMON_ASSET_WATCHER_H
@@ -0,0 +1,561 @@
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE // syscall (io_uring), MAP_POPULATE
+#endif
+
+#include "./async-io.h"
+#include "../../_common/file.h"
+#include "../../_common/path.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#elif defined(__linux__)
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ERROR MESSAGES
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_global_var const char *g_async_io_error_messages[] = {
+    [ASYNC_IO_SUCCESS] = "Success",
+    [ASYNC_IO_ERROR_NULL_QUEUE] = "NULL async I/O queue pointer",
+    [ASYNC_IO_ERROR_SYNC_INIT_FAILED] =
+        "Failed to initialize mutex or condition variable",
+    [ASYNC_IO_ERROR_THREAD_CREATE_FAILED] = "Failed to create I/O thread",
+};
+
+const char *async_io_strerror(AsyncIOErrorCode code) {
+  if (code >= 0 && code < ASYNC_IO_ERROR_COUNT) {
+    return g_async_io_error_messages[code];
+  }
+  return "Unknown async I/O error";
+}
+
+const char *async_io_backend_name(AsyncIOBackend backend) {
+  switch (backend) {
+  case ASYNC_IO_BACKEND_IO_URING:
+    return "io_uring";
+  case ASYNC_IO_BACKEND_THREADS:
+  default:
+    return "threads";
+  }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// INTERNAL HELPERS
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define PENDING_MASK (DE100_ASYNC_IO_QUEUE_CAPACITY - 1)
+
+de100_file_scoped_fn void async_io_finish(De100AsyncIO *io,
+                                          De100AsyncIORequest *request,
+                                          u64 bytes, i32 error_code) {
+  request->bytes_transferred = bytes;
+  request->error_code = error_code;
+  __atomic_store_n(&request->status,
+                   error_code == DE100_FILE_SUCCESS
+                       ? DE100_ASYNC_IO_STATUS_COMPLETE
+                       : DE100_ASYNC_IO_STATUS_FAILED,
+                   __ATOMIC_RELEASE);
+
+  pthread_mutex_lock(&io->lock);
+  pthread_cond_broadcast(&io->done_condition);
+  pthread_mutex_unlock(&io->lock);
+}
+
+de100_file_scoped_fn bool async_io_save_tmp_path(const char *path,
+                                                 char *out, size_t size) {
+  i32 written = snprintf(out, size, "%s.tmp", path);
+  return written > 0 && (size_t)written < size;
+}
+
+de100_file_scoped_fn bool async_io_replace_file(const char *from,
+                                                const char *to) {
+#if defined(_WIN32)
+  return MoveFileExA(from, to, MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+  return rename(from, to) == 0;
+#endif
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// BLOCKING BACKEND (thread pool)
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn void async_io_execute_blocking(De100AsyncIO *io,
+                                                    De100AsyncIORequest *req) {
+  char tmp_path[DE100_MAX_PATH_LENGTH];
+  const char *open_path = req->path;
+  u32 flags = DE100_FILE_READ;
+  u64 offset = req->offset;
+
+  if (req->op == DE100_ASYNC_IO_OP_WRITE) {
+    flags = DE100_FILE_WRITE | DE100_FILE_CREATE;
+  } else if (req->op == DE100_ASYNC_IO_OP_SAVE) {
+    if (!async_io_save_tmp_path(req->path, tmp_path, sizeof(tmp_path))) {
+      async_io_finish(io, req, 0, DE100_FILE_ERROR_INVALID_PATH);
+      return;
+    }
+    open_path = tmp_path;
+    flags = DE100_FILE_WRITE | DE100_FILE_CREATE | DE100_FILE_TRUNCATE;
+    offset = 0;
+  }
+
+  De100FileOpenResult file = de100_file_open(open_path, flags);
+  if (!file.success) {
+    async_io_finish(io, req, 0, file.error_code);
+    return;
+  }
+
+  if (offset > 0) {
+    De100FileSizeResult seek =
+        de100_file_seek(file.fd, (i64)offset, DE100_SEEK_SET);
+    if (!seek.success) {
+      de100_file_close(file.fd);
+      async_io_finish(io, req, 0, seek.error_code);
+      return;
+    }
+  }
+
+  De100FileIOResult transfer =
+      req->op == DE100_ASYNC_IO_OP_READ
+          ? de100_file_read_all(file.fd, req->buffer, (size_t)req->size)
+          : de100_file_write_all(file.fd, req->buffer, (size_t)req->size);
+  de100_file_close(file.fd);
+
+  // A read that runs into end of file is a short success, not an error
+  i32 error_code = transfer.success || transfer.error_code ==
+                                           DE100_FILE_ERROR_EOF
+                       ? DE100_FILE_SUCCESS
+                       : transfer.error_code;
+
+  if (error_code == DE100_FILE_SUCCESS && req->op == DE100_ASYNC_IO_OP_SAVE &&
+      !async_io_replace_file(tmp_path, req->path)) {
+    error_code = DE100_FILE_ERROR_WRITE_FAILED;
+  }
+
+  async_io_finish(io, req, transfer.bytes_processed, error_code);
+}
+
+de100_file_scoped_fn void *async_io_blocking_thread_proc(void *arg) {
+  De100AsyncIO *io = (De100AsyncIO *)arg;
+
+  for (;;) {
+    pthread_mutex_lock(&io->lock);
+    while (io->is_running && io->pending_head == io->pending_tail) {
+      pthread_cond_wait(&io->work_condition, &io->lock);
+    }
+    if (io->pending_head == io->pending_tail) {
+      pthread_mutex_unlock(&io->lock);
+      break; // Shut down and drained
+    }
+    De100AsyncIORequest *request =
+        io->pending[io->pending_head++ & PENDING_MASK];
+    bool cancelled = !io->is_running;
+    pthread_mutex_unlock(&io->lock);
+
+    if (cancelled) {
+      async_io_finish(io, request, 0, DE100_FILE_ERROR_UNKNOWN);
+    } else {
+      async_io_execute_blocking(io, request);
+    }
+  }
+  return NULL;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// IO_URING BACKEND (Linux)
+// ═══════════════════════════════════════════════════════════════════════════
+
+#if defined(__linux__)
+
+de100_file_scoped_fn bool uring_setup(AsyncIOUring *ring) {
+  struct io_uring_params params;
+  memset(&params, 0, sizeof(params));
+  ring->fd = (i32)syscall(__NR_io_uring_setup, DE100_ASYNC_IO_MAX_IN_FLIGHT,
+                          &params);
+  if (ring->fd < 0) {
+    return false;
+  }
+
+  ring->sq_map_size = params.sq_off.array + params.sq_entries * sizeof(u32);
+  ring->cq_map_size =
+      params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+  ring->sqes_map_size = params.sq_entries * sizeof(struct io_uring_sqe);
+
+  ring->sq_map = mmap(NULL, ring->sq_map_size, PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQ_RING);
+  ring->cq_map = mmap(NULL, ring->cq_map_size, PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_CQ_RING);
+  ring->sqes = mmap(NULL, ring->sqes_map_size, PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQES);
+  if (ring->sq_map == MAP_FAILED || ring->cq_map == MAP_FAILED ||
+      ring->sqes == MAP_FAILED) {
+    if (ring->sq_map != MAP_FAILED) {
+      munmap(ring->sq_map, ring->sq_map_size);
+    }
+    if (ring->cq_map != MAP_FAILED) {
+      munmap(ring->cq_map, ring->cq_map_size);
+    }
+    if (ring->sqes != MAP_FAILED) {
+      munmap(ring->sqes, ring->sqes_map_size);
+    }
+    close(ring->fd);
+    return false;
+  }
+
+  u8 *sq = (u8 *)ring->sq_map;
+  u8 *cq = (u8 *)ring->cq_map;
+  ring->sq_head = (u32 *)(sq + params.sq_off.head);
+  ring->sq_tail = (u32 *)(sq + params.sq_off.tail);
+  ring->sq_mask = (u32 *)(sq + params.sq_off.ring_mask);
+  ring->sq_array = (u32 *)(sq + params.sq_off.array);
+  ring->cq_head = (u32 *)(cq + params.cq_off.head);
+  ring->cq_tail = (u32 *)(cq + params.cq_off.tail);
+  ring->cq_mask = (u32 *)(cq + params.cq_off.ring_mask);
+  ring->cqes = cq + params.cq_off.cqes;
+  return true;
+}
+
+de100_file_scoped_fn void uring_teardown(AsyncIOUring *ring) {
+  munmap(ring->sqes, ring->sqes_map_size);
+  munmap(ring->cq_map, ring->cq_map_size);
+  munmap(ring->sq_map, ring->sq_map_size);
+  close(ring->fd);
+}
+
+// Queue the (rest of the) transfer for one in-flight slot
+de100_file_scoped_fn bool uring_submit_slot(AsyncIOUring *ring, u32 index) {
+  AsyncIOInFlight *slot = &ring->in_flight[index];
+  De100AsyncIORequest *req = slot->request;
+  u64 offset = req->op == DE100_ASYNC_IO_OP_SAVE ? 0 : req->offset;
+
+  slot->iov.iov_base = (u8 *)req->buffer + slot->done;
+  slot->iov.iov_len = (size_t)(req->size - slot->done);
+
+  u32 tail = *ring->sq_tail; // Only this thread writes it
+  u32 sq_index = tail & *ring->sq_mask;
+  struct io_uring_sqe *sqe = (struct io_uring_sqe *)ring->sqes + sq_index;
+  memset(sqe, 0, sizeof(*sqe));
+  sqe->opcode = req->op == DE100_ASYNC_IO_OP_READ ? IORING_OP_READV
+                                                  : IORING_OP_WRITEV;
+  sqe->fd = slot->fd;
+  sqe->addr = (u64)(uintptr_t)&slot->iov;
+  sqe->len = 1;
+  sqe->off = offset + slot->done;
+  sqe->user_data = index;
+  ring->sq_array[sq_index] = sq_index;
+  __atomic_store_n(ring->sq_tail, tail + 1, __ATOMIC_RELEASE);
+
+  if (syscall(__NR_io_uring_enter, ring->fd, 1, 0, 0, NULL, 0) >= 0) {
+    return true;
+  }
+  // Not consumed: take it back so a later enter can't submit it for a
+  // slot that is about to be freed
+  if (__atomic_load_n(ring->sq_head, __ATOMIC_ACQUIRE) == tail) {
+    __atomic_store_n(ring->sq_tail, tail, __ATOMIC_RELEASE);
+  }
+  return false;
+}
+
+de100_file_scoped_fn void uring_complete_slot(De100AsyncIO *io, u32 index,
+                                              i32 error_code) {
+  AsyncIOUring *ring = &io->uring;
+  AsyncIOInFlight *slot = &ring->in_flight[index];
+  De100AsyncIORequest *req = slot->request;
+  close(slot->fd);
+
+  if (error_code == DE100_FILE_SUCCESS && req->op == DE100_ASYNC_IO_OP_SAVE) {
+    char tmp_path[DE100_MAX_PATH_LENGTH];
+    async_io_save_tmp_path(req->path, tmp_path, sizeof(tmp_path));
+    if (!async_io_replace_file(tmp_path, req->path)) {
+      error_code = DE100_FILE_ERROR_WRITE_FAILED;
+    }
+  }
+
+  u64 done = slot->done;
+  slot->request = NULL;
+  ring->in_flight_count--;
+  async_io_finish(io, req, done, error_code);
+}
+
+// Open the file and start the transfer in a free slot
+de100_file_scoped_fn void uring_start(De100AsyncIO *io,
+                                      De100AsyncIORequest *req) {
+  AsyncIOUring *ring = &io->uring;
+  char tmp_path[DE100_MAX_PATH_LENGTH];
+  const char *open_path = req->path;
+  i32 flags = O_RDONLY;
+
+  if (req->op == DE100_ASYNC_IO_OP_WRITE) {
+    flags = O_WRONLY | O_CREAT;
+  } else if (req->op == DE100_ASYNC_IO_OP_SAVE) {
+    if (!async_io_save_tmp_path(req->path, tmp_path, sizeof(tmp_path))) {
+      async_io_finish(io, req, 0, DE100_FILE_ERROR_INVALID_PATH);
+      return;
+    }
+    open_path = tmp_path;
+    flags = O_WRONLY | O_CREAT | O_TRUNC;
+  }
+
+  i32 fd = open(open_path, flags | O_CLOEXEC, 0644);
+  if (fd < 0) {
+    i32 error_code = req->op == DE100_ASYNC_IO_OP_READ
+                         ? DE100_FILE_ERROR_READ_FAILED
+                         : DE100_FILE_ERROR_WRITE_FAILED;
+    if (errno == ENOENT) {
+      error_code = DE100_FILE_ERROR_NOT_FOUND;
+    } else if (errno == EACCES || errno == EPERM) {
+      error_code = DE100_FILE_ERROR_ACCESS_DENIED;
+    }
+    async_io_finish(io, req, 0, error_code);
+    return;
+  }
+
+  u32 index = 0;
+  while (ring->in_flight[index].request) {
+    index++; // Caller guarantees a free slot
+  }
+  AsyncIOInFlight *slot = &ring->in_flight[index];
+  slot->request = req;
+  slot->fd = fd;
+  slot->done = 0;
+  ring->in_flight_count++;
+
+  if (req->size == 0) {
+    uring_complete_slot(io, index, DE100_FILE_SUCCESS);
+  } else if (!uring_submit_slot(ring, index)) {
+    uring_complete_slot(io, index, DE100_FILE_ERROR_UNKNOWN);
+  }
+}
+
+de100_file_scoped_fn void uring_reap(De100AsyncIO *io) {
+  AsyncIOUring *ring = &io->uring;
+  u32 head = *ring->cq_head;
+
+  while (head != __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE)) {
+    struct io_uring_cqe *cqe =
+        (struct io_uring_cqe *)ring->cqes + (head & *ring->cq_mask);
+    u32 index = (u32)cqe->user_data;
+    i32 res = cqe->res;
+    head++;
+    __atomic_store_n(ring->cq_head, head, __ATOMIC_RELEASE);
+
+    AsyncIOInFlight *slot = &ring->in_flight[index];
+    bool is_read = slot->request->op == DE100_ASYNC_IO_OP_READ;
+
+    if (res < 0) {
+      uring_complete_slot(io, index,
+                          is_read ? DE100_FILE_ERROR_READ_FAILED
+                                  : DE100_FILE_ERROR_WRITE_FAILED);
+    } else if (res == 0) {
+      // End of file on a read (short success); a write that makes no
+      // progress would loop forever
+      uring_complete_slot(io, index,
+                          is_read ? DE100_FILE_SUCCESS
+                                  : DE100_FILE_ERROR_WRITE_FAILED);
+    } else {
+      slot->done += (u64)res;
+      if (slot->done >= slot->request->size) {
+        uring_complete_slot(io, index, DE100_FILE_SUCCESS);
+      } else if (!uring_submit_slot(ring, index)) {
+        uring_complete_slot(io, index, DE100_FILE_ERROR_UNKNOWN);
+      }
+    }
+  }
+}
+
+de100_file_scoped_fn void *async_io_uring_thread_proc(void *arg) {
+  De100AsyncIO *io = (De100AsyncIO *)arg;
+  AsyncIOUring *ring = &io->uring;
+
+  for (;;) {
+    De100AsyncIORequest *batch[DE100_ASYNC_IO_MAX_IN_FLIGHT];
+    u32 batch_count = 0;
+
+    pthread_mutex_lock(&io->lock);
+    while (io->is_running && io->pending_head == io->pending_tail &&
+           ring->in_flight_count == 0) {
+      pthread_cond_wait(&io->work_condition, &io->lock);
+    }
+    bool running = io->is_running;
+    if (!running && io->pending_head == io->pending_tail &&
+        ring->in_flight_count == 0) {
+      pthread_mutex_unlock(&io->lock);
+      break; // Shut down and drained
+    }
+    while (io->pending_head != io->pending_tail &&
+           batch_count < DE100_ASYNC_IO_MAX_IN_FLIGHT - ring->in_flight_count) {
+      batch[batch_count++] = io->pending[io->pending_head++ & PENDING_MASK];
+    }
+    pthread_mutex_unlock(&io->lock);
+
+    for (u32 i = 0; i < batch_count; ++i) {
+      if (running) {
+        uring_start(io, batch[i]);
+      } else {
+        async_io_finish(io, batch[i], 0, DE100_FILE_ERROR_UNKNOWN);
+      }
+    }
+
+    if (ring->in_flight_count > 0) {
+      // New submissions wait for the next completion; disk I/O is short
+      syscall(__NR_io_uring_enter, ring->fd, 0, 1, IORING_ENTER_GETEVENTS,
+              NULL, 0);
+      uring_reap(io);
+    }
+  }
+  return NULL;
+}
+
+#endif // __linux__
+
+// ═══════════════════════════════════════════════════════════════════════════
+// INIT / SHUTDOWN
+// ═══════════════════════════════════════════════════════════════════════════
+
+AsyncIOInitResult async_io_init(De100AsyncIO *io) {
+  AsyncIOInitResult result = {0};
+  if (!io) {
+    result.error_code = ASYNC_IO_ERROR_NULL_QUEUE;
+    return result;
+  }
+
+  if (pthread_mutex_init(&io->lock, NULL) != 0 ||
+      pthread_cond_init(&io->work_condition, NULL) != 0 ||
+      pthread_cond_init(&io->done_condition, NULL) != 0) {
+    result.error_code = ASYNC_IO_ERROR_SYNC_INIT_FAILED;
+    return result;
+  }
+
+  io->is_running = true;
+  io->backend = ASYNC_IO_BACKEND_THREADS;
+  void *(*thread_proc)(void *) = async_io_blocking_thread_proc;
+  u32 wanted_threads = DE100_ASYNC_IO_FALLBACK_THREADS;
+
+#if defined(__linux__)
+  if (uring_setup(&io->uring)) {
+    io->backend = ASYNC_IO_BACKEND_IO_URING;
+    thread_proc = async_io_uring_thread_proc;
+    wanted_threads = 1;
+  }
+#endif
+
+  for (u32 i = 0; i < wanted_threads; ++i) {
+    if (pthread_create(&io->threads[i], NULL, thread_proc, io) != 0) {
+      break;
+    }
+    io->thread_count++;
+  }
+
+  if (io->thread_count == 0) {
+#if defined(__linux__)
+    if (io->backend == ASYNC_IO_BACKEND_IO_URING) {
+      uring_teardown(&io->uring);
+    }
+#endif
+    pthread_cond_destroy(&io->done_condition);
+    pthread_cond_destroy(&io->work_condition);
+    pthread_mutex_destroy(&io->lock);
+    io->is_running = false;
+    result.error_code = ASYNC_IO_ERROR_THREAD_CREATE_FAILED;
+    return result;
+  }
+
+  io->is_initialized = true;
+  result.success = true;
+  result.backend = io->backend;
+  result.error_code = io->thread_count == wanted_threads
+                          ? ASYNC_IO_SUCCESS
+                          : ASYNC_IO_ERROR_THREAD_CREATE_FAILED;
+  return result;
+}
+
+void async_io_shutdown(De100AsyncIO *io) {
+  if (!io || !io->is_initialized) {
+    return;
+  }
+
+  pthread_mutex_lock(&io->lock);
+  io->is_running = false;
+  pthread_cond_broadcast(&io->work_condition);
+  pthread_mutex_unlock(&io->lock);
+
+  for (u32 i = 0; i < io->thread_count; ++i) {
+    pthread_join(io->threads[i], NULL);
+  }
+
+#if defined(__linux__)
+  if (io->backend == ASYNC_IO_BACKEND_IO_URING) {
+    uring_teardown(&io->uring);
+  }
+#endif
+
+  pthread_cond_destroy(&io->done_condition);
+  pthread_cond_destroy(&io->work_condition);
+  pthread_mutex_destroy(&io->lock);
+  io->thread_count = 0;
+  io->is_initialized = false;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// GAME-FACING API
+// ═══════════════════════════════════════════════════════════════════════════
+
+DE100_PLATFORM_ASYNC_IO_SUBMIT(async_io_submit) {
+  if (!request) {
+    return false;
+  }
+
+  request->bytes_transferred = 0;
+  request->error_code = DE100_FILE_SUCCESS;
+
+  bool valid = io && io->is_initialized && request->path &&
+               (request->buffer || request->size == 0) &&
+               request->op >= 0 && request->op < DE100_ASYNC_IO_OP_COUNT;
+  if (!valid) {
+    request->error_code = DE100_FILE_ERROR_INVALID_PATH;
+    __atomic_store_n(&request->status, DE100_ASYNC_IO_STATUS_FAILED,
+                     __ATOMIC_RELEASE);
+    return false;
+  }
+
+  pthread_mutex_lock(&io->lock);
+  if (io->pending_tail - io->pending_head >= DE100_ASYNC_IO_QUEUE_CAPACITY) {
+    pthread_mutex_unlock(&io->lock);
+    request->error_code = DE100_FILE_ERROR_UNKNOWN;
+    __atomic_store_n(&request->status, DE100_ASYNC_IO_STATUS_FAILED,
+                     __ATOMIC_RELEASE);
+    return false;
+  }
+
+  __atomic_store_n(&request->status, DE100_ASYNC_IO_STATUS_PENDING,
+                   __ATOMIC_RELAXED);
+  io->pending[io->pending_tail++ & PENDING_MASK] = request;
+  pthread_cond_signal(&io->work_condition);
+  pthread_mutex_unlock(&io->lock);
+  return true;
+}
+
+DE100_PLATFORM_ASYNC_IO_WAIT(async_io_wait) {
+  if (!io || !request || !io->is_initialized) {
+    return;
+  }
+
+  pthread_mutex_lock(&io->lock);
+  while (__atomic_load_n(&request->status, __ATOMIC_ACQUIRE) ==
+         DE100_ASYNC_IO_STATUS_PENDING) {
+    pthread_cond_wait(&io->done_condition, &io->lock);
+  }
+  pthread_mutex_unlock(&io->lock);
+}
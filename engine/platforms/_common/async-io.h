@@ -0,0 +1,143 @@
+#ifndef DE100_PLATFORMS__COMMON_ASYNC_IO_H
+#define DE100_PLATFORMS__COMMON_ASYNC_IO_H
+
+#include "../../_common/base.h"
+#include "../../game/async-io.h"
+
+#include <pthread.h>
+#if defined(__linux__)
+#include <sys/uio.h>
+#endif
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ASYNC I/O QUEUE (shared by X11 and Raylib backends)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+//   main thread ──submit──▶ [ pending ring ] ──▶ I/O thread(s)
+//                                                  │
+//              request->status ◀── release store ──┘
+//
+// Linux (io_uring): ONE I/O thread opens files and keeps up to
+// DE100_ASYNC_IO_MAX_IN_FLIGHT reads/writes in the kernel at once, so a
+// level's worth of asset reads overlap instead of queueing behind each
+// other. The ring is driven with raw syscalls (no liburing dependency).
+//
+// Everywhere else, or when io_uring_setup is refused (old kernel,
+// seccomp'd container): DE100_ASYNC_IO_FALLBACK_THREADS threads doing
+// blocking de100_file_* calls, one request each.
+//
+// submit() is single-producer: call it from the main thread only.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+// Must be a power of two
+#ifndef DE100_ASYNC_IO_QUEUE_CAPACITY
+#define DE100_ASYNC_IO_QUEUE_CAPACITY 256
+#endif
+
+#ifndef DE100_ASYNC_IO_MAX_IN_FLIGHT
+#define DE100_ASYNC_IO_MAX_IN_FLIGHT 32
+#endif
+
+#ifndef DE100_ASYNC_IO_FALLBACK_THREADS
+#define DE100_ASYNC_IO_FALLBACK_THREADS 2
+#endif
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ERROR CODES
+// ═══════════════════════════════════════════════════════════════════════════
+
+typedef enum {
+  ASYNC_IO_SUCCESS = 0,
+  ASYNC_IO_ERROR_NULL_QUEUE,
+  ASYNC_IO_ERROR_SYNC_INIT_FAILED,
+  ASYNC_IO_ERROR_THREAD_CREATE_FAILED,
+
+  ASYNC_IO_ERROR_COUNT
+} AsyncIOErrorCode;
+
+typedef enum {
+  ASYNC_IO_BACKEND_THREADS = 0,
+  ASYNC_IO_BACKEND_IO_URING,
+
+  ASYNC_IO_BACKEND_COUNT
+} AsyncIOBackend;
+
+// ═══════════════════════════════════════════════════════════════════════════
+// QUEUE STRUCTURES
+// ═══════════════════════════════════════════════════════════════════════════
+
+#if defined(__linux__)
+typedef struct {
+  De100AsyncIORequest *request; // NULL = free slot
+  i32 fd;
+  u64 done; // Bytes finished so far (short reads/writes resubmit)
+  struct iovec iov;
+} AsyncIOInFlight;
+
+typedef struct {
+  i32 fd;
+  u32 *sq_head, *sq_tail, *sq_mask, *sq_array;
+  u32 *cq_head, *cq_tail, *cq_mask;
+  void *sqes; // struct io_uring_sqe[]
+  void *cqes; // struct io_uring_cqe[]
+  void *sq_map, *cq_map;
+  size_t sq_map_size, cq_map_size, sqes_map_size;
+  u32 in_flight_count;
+  AsyncIOInFlight in_flight[DE100_ASYNC_IO_MAX_IN_FLIGHT];
+} AsyncIOUring;
+#endif
+
+struct De100AsyncIO {
+  De100AsyncIORequest *pending[DE100_ASYNC_IO_QUEUE_CAPACITY];
+  u32 pending_head; // Next to start (guarded by lock)
+  u32 pending_tail; // Next free (guarded by lock)
+
+  pthread_mutex_t lock;
+  pthread_cond_t work_condition; // Pending requests (or shutdown)
+  pthread_cond_t done_condition; // Any request completed
+
+  pthread_t threads[DE100_ASYNC_IO_FALLBACK_THREADS];
+  u32 thread_count;
+  AsyncIOBackend backend;
+  bool32 is_running;
+  bool32 is_initialized;
+
+#if defined(__linux__)
+  AsyncIOUring uring;
+#endif
+};
+
+typedef struct {
+  bool success;
+  AsyncIOErrorCode error_code;
+  AsyncIOBackend backend;
+} AsyncIOInitResult;
+
+// ═══════════════════════════════════════════════════════════════════════════
+// API FUNCTIONS
+// ═══════════════════════════════════════════════════════════════════════════
+
+/**
+ * Start the I/O thread(s).
+ *
+ * @param io  Queue storage (zeroed; usually engine-allocated)
+ */
+AsyncIOInitResult async_io_init(De100AsyncIO *io);
+
+/**
+ * Finish in-flight requests, fail the ones never started, join threads.
+ * Safe to call multiple times.
+ */
+void async_io_shutdown(De100AsyncIO *io);
+
+/**
+ * Implementations of the GameMemory function pointers.
+ */
+DE100_PLATFORM_ASYNC_IO_SUBMIT(async_io_submit);
+DE100_PLATFORM_ASYNC_IO_WAIT(async_io_wait);
+
+const char *async_io_strerror(AsyncIOErrorCode code);
+const char *async_io_backend_name(AsyncIOBackend backend);
+
+#endif // DE100_PLATFORMS__COMMON_ASYNC_IO_H
@@ -0,0 +1,113 @@
+#ifndef DE100_PLATFORMS__COMMON_AUDIO_RING_H
+#define DE100_PLATFORMS__COMMON_AUDIO_RING_H
+
+#include "../../_common/base.h"
+#include <string.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// 🔊 AUDIO RING (lock-free SPSC)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// Interleaved 16-bit stereo frames between exactly one producer (the game
+// loop, via get_audio_samples) and one consumer (the audio device thread).
+//
+//   producer ──write──▶ [ ░░░▓▓▓▓▓▓▓▓▓▓░░░░ ] ──read──▶ consumer
+//                           read ↑        ↑ write
+//
+// Indexes count frames forever (u64, never wrap in practice); the slot is
+// index & (capacity - 1). The producer publishes with a release store of
+// write_index, the consumer with a release store of read_index, so each
+// side only ever sees fully written frames / fully freed space.
+//
+// Storage is caller-owned: capacity_frames must be a power of two.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define DE100_AUDIO_RING_CHANNELS 2
+
+typedef struct {
+  i16 *samples;        // capacity_frames * DE100_AUDIO_RING_CHANNELS
+  u32 capacity_frames; // Power of two
+  u64 write_index;     // Producer-owned
+  u64 read_index;      // Consumer-owned
+} De100AudioRing;
+
+de100_file_scoped_fn inline void de100_audio_ring_init(De100AudioRing *ring,
+                                                       i16 *samples,
+                                                       u32 capacity_frames) {
+  ring->samples = samples;
+  ring->capacity_frames = capacity_frames;
+  ring->write_index = 0;
+  ring->read_index = 0;
+}
+
+/** Frames queued (safe from either side; a lower bound for the consumer). */
+de100_file_scoped_fn inline u32
+de100_audio_ring_fill(const De100AudioRing *ring) {
+  u64 write = __atomic_load_n(&ring->write_index, __ATOMIC_ACQUIRE);
+  u64 read = __atomic_load_n(&ring->read_index, __ATOMIC_ACQUIRE);
+  return (u32)(write - read);
+}
+
+/** Copy between linear frames and the ring, splitting at the wrap. */
+de100_file_scoped_fn inline void de100_audio_ring_copy(De100AudioRing *ring,
+                                                       u64 index, i16 *linear,
+                                                       u32 count,
+                                                       bool to_ring) {
+  u32 mask = ring->capacity_frames - 1;
+  u32 start = (u32)(index & mask);
+  u32 first = ring->capacity_frames - start;
+  if (first > count) {
+    first = count;
+  }
+  size_t frame_bytes = sizeof(i16) * DE100_AUDIO_RING_CHANNELS;
+  i16 *slot = ring->samples + (size_t)start * DE100_AUDIO_RING_CHANNELS;
+  i16 *linear_rest = linear + (size_t)first * DE100_AUDIO_RING_CHANNELS;
+
+  if (to_ring) {
+    memcpy(slot, linear, first * frame_bytes);
+    memcpy(ring->samples, linear_rest, (count - first) * frame_bytes);
+  } else {
+    memcpy(linear, slot, first * frame_bytes);
+    memcpy(linear_rest, ring->samples, (count - first) * frame_bytes);
+  }
+}
+
+/** Producer: append up to `count` frames. Returns frames accepted. */
+de100_file_scoped_fn inline u32 de100_audio_ring_write(De100AudioRing *ring,
+                                                       const i16 *frames,
+                                                       u32 count) {
+  u64 write = ring->write_index;
+  u64 read = __atomic_load_n(&ring->read_index, __ATOMIC_ACQUIRE);
+  u32 space = ring->capacity_frames - (u32)(write - read);
+  if (count > space) {
+    count = space;
+  }
+  if (count == 0) {
+    return 0;
+  }
+
+  de100_audio_ring_copy(ring, write, (i16 *)frames, count, true);
+  __atomic_store_n(&ring->write_index, write + count, __ATOMIC_RELEASE);
+  return count;
+}
+
+/** Consumer: take up to `count` frames. Returns frames read. */
+de100_file_scoped_fn inline u32 de100_audio_ring_read(De100AudioRing *ring,
+                                                      i16 *frames, u32 count) {
+  u64 read = ring->read_index;
+  u64 write = __atomic_load_n(&ring->write_index, __ATOMIC_ACQUIRE);
+  u32 available = (u32)(write - read);
+  if (count > available) {
+    count = available;
+  }
+  if (count == 0) {
+    return 0;
+  }
+
+  de100_audio_ring_copy(ring, read, frames, count, false);
+  __atomic_store_n(&ring->read_index, read + count, __ATOMIC_RELEASE);
+  return count;
+}
+
+#endif // DE100_PLATFORMS__COMMON_AUDIO_RING_H
@@ -0,0 +1,182 @@
+#include "./background-loader.h"
+
+#include <stdio.h>
+#include <string.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ERROR MESSAGES
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_global_var const char *g_background_loader_error_messages[] =
+    {
+        [BACKGROUND_LOADER_SUCCESS] = "Success",
+        [BACKGROUND_LOADER_ERROR_NULL_LOADER] = "NULL background loader pointer",
+        [BACKGROUND_LOADER_ERROR_SYNC_INIT_FAILED] = "Failed to initialize mutex",
+        [BACKGROUND_LOADER_ERROR_QUEUE_INIT_FAILED] =
+            "Failed to start the loader work queue",
+        [BACKGROUND_LOADER_ERROR_NO_WORKERS] =
+            "No loader threads started (tasks would never run)",
+};
+
+const char *background_loader_strerror(BackgroundLoaderErrorCode code) {
+  if (code >= 0 && code < BACKGROUND_LOADER_ERROR_COUNT) {
+    return g_background_loader_error_messages[code];
+  }
+  return "Unknown background loader error";
+}
+
+de100_file_scoped_fn inline BackgroundLoaderInitResult
+background_loader_result(BackgroundLoaderErrorCode code, u32 worker_count) {
+  return (BackgroundLoaderInitResult){
+      .success = code == BACKGROUND_LOADER_SUCCESS,
+      .error_code = code,
+      .worker_count = worker_count,
+  };
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// WORK ENTRY
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn DE100_WORK_QUEUE_CALLBACK(background_loader_run) {
+  BackgroundLoaderSlot *slot = (BackgroundLoaderSlot *)data;
+  De100BackgroundLoad *task = slot->task;
+
+  u32 status = DE100_BACKGROUND_LOAD_STATUS_CANCELLED;
+  if (!de100_background_load_should_cancel(task)) {
+    __atomic_store_n(&task->status, DE100_BACKGROUND_LOAD_STATUS_RUNNING,
+                     __ATOMIC_RELEASE);
+    bool ok = task->callback(thread_context, task);
+    if (de100_background_load_should_cancel(task)) {
+      status = DE100_BACKGROUND_LOAD_STATUS_CANCELLED;
+    } else {
+      status = ok ? DE100_BACKGROUND_LOAD_STATUS_COMPLETE
+                  : DE100_BACKGROUND_LOAD_STATUS_FAILED;
+    }
+  }
+
+  // Free the slot BEFORE publishing: once the game sees a final status it
+  // may resubmit the same task.
+  De100BackgroundLoader *loader = slot->loader;
+  pthread_mutex_lock(&loader->lock);
+  slot->task = NULL;
+  pthread_mutex_unlock(&loader->lock);
+
+  __atomic_store_n(&task->status, status, __ATOMIC_RELEASE);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// PUBLIC API
+// ═══════════════════════════════════════════════════════════════════════════
+
+BackgroundLoaderInitResult background_loader_init(De100BackgroundLoader *loader,
+                                                  u32 worker_count) {
+  if (!loader) {
+    return background_loader_result(BACKGROUND_LOADER_ERROR_NULL_LOADER, 0);
+  }
+  if (pthread_mutex_init(&loader->lock, NULL) != 0) {
+    return background_loader_result(BACKGROUND_LOADER_ERROR_SYNC_INIT_FAILED,
+                                    0);
+  }
+
+  WorkQueueInitResult queue_result = work_queue_init(
+      &loader->queue,
+      worker_count ? worker_count : DE100_BACKGROUND_LOADER_WORKERS);
+  if (!queue_result.success || queue_result.worker_count == 0) {
+    // Without workers, entries would wait for the next cancel_all()
+    work_queue_shutdown(&loader->queue);
+    pthread_mutex_destroy(&loader->lock);
+    return background_loader_result(
+        queue_result.success ? BACKGROUND_LOADER_ERROR_NO_WORKERS
+                             : BACKGROUND_LOADER_ERROR_QUEUE_INIT_FAILED,
+        0);
+  }
+
+  for (u32 i = 0; i < DE100_BACKGROUND_LOADER_MAX_TASKS; ++i) {
+    loader->slots[i].loader = loader;
+    loader->slots[i].task = NULL;
+  }
+  loader->is_initialized = true;
+  return background_loader_result(BACKGROUND_LOADER_SUCCESS,
+                                  queue_result.worker_count);
+}
+
+DE100_PLATFORM_BACKGROUND_LOAD_SUBMIT(background_loader_submit) {
+  if (!task) {
+    return false;
+  }
+  u32 status = __atomic_load_n(&task->status, __ATOMIC_ACQUIRE);
+  if (status == DE100_BACKGROUND_LOAD_STATUS_QUEUED ||
+      status == DE100_BACKGROUND_LOAD_STATUS_RUNNING) {
+    return false; // Still in flight: don't touch it
+  }
+  if (!loader || !loader->is_initialized || !task->callback) {
+    __atomic_store_n(&task->status, DE100_BACKGROUND_LOAD_STATUS_FAILED,
+                     __ATOMIC_RELEASE);
+    return false;
+  }
+
+  BackgroundLoaderSlot *slot = NULL;
+  pthread_mutex_lock(&loader->lock);
+  for (u32 i = 0; i < DE100_BACKGROUND_LOADER_MAX_TASKS; ++i) {
+    if (!loader->slots[i].task) {
+      slot = &loader->slots[i];
+      slot->task = task;
+      break;
+    }
+  }
+  pthread_mutex_unlock(&loader->lock);
+
+  if (!slot) {
+    __atomic_store_n(&task->status, DE100_BACKGROUND_LOAD_STATUS_FAILED,
+                     __ATOMIC_RELEASE);
+    return false;
+  }
+
+  __atomic_store_n(&task->cancel_requested, 0, __ATOMIC_RELAXED);
+  __atomic_store_n(&task->status, DE100_BACKGROUND_LOAD_STATUS_QUEUED,
+                   __ATOMIC_RELEASE);
+  if (!work_queue_add_entry(&loader->queue, background_loader_run, slot)) {
+    pthread_mutex_lock(&loader->lock);
+    slot->task = NULL;
+    pthread_mutex_unlock(&loader->lock);
+    __atomic_store_n(&task->status, DE100_BACKGROUND_LOAD_STATUS_FAILED,
+                     __ATOMIC_RELEASE);
+    return false;
+  }
+  return true;
+}
+
+void background_loader_cancel_all(De100BackgroundLoader *loader) {
+  if (!loader || !loader->is_initialized) {
+    return;
+  }
+
+  u32 cancelled = 0;
+  pthread_mutex_lock(&loader->lock);
+  for (u32 i = 0; i < DE100_BACKGROUND_LOADER_MAX_TASKS; ++i) {
+    if (loader->slots[i].task) {
+      de100_background_load_cancel(loader->slots[i].task);
+      cancelled++;
+    }
+  }
+  pthread_mutex_unlock(&loader->lock);
+
+  // Never-started entries finish instantly as CANCELLED; the main thread
+  // helps drain them
+  work_queue_complete_all_work(&loader->queue);
+
+  if (cancelled) {
+    printf("🛑 Background loader: cancelled %u task(s)\n", cancelled);
+  }
+}
+
+void background_loader_shutdown(De100BackgroundLoader *loader) {
+  if (!loader || !loader->is_initialized) {
+    return;
+  }
+  background_loader_cancel_all(loader);
+  work_queue_shutdown(&loader->queue);
+  pthread_mutex_destroy(&loader->lock);
+  loader->is_initialized = false;
+}
@@ -0,0 +1,101 @@
+#ifndef DE100_PLATFORMS__COMMON_BACKGROUND_LOADER_H
+#define DE100_PLATFORMS__COMMON_BACKGROUND_LOADER_H
+
+#include "../../_common/base.h"
+#include "../../game/background-load.h"
+#include "./work-queue.h"
+
+#include <pthread.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// BACKGROUND LOADER (shared by X11 and Raylib backends)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// A second, low-priority De100WorkQueue with its own few threads, so a
+// multi-frame decode never sits in the frame queue that
+// complete_all_work() drains every frame. Each submitted task takes a
+// slot; its work entry runs the game callback unless it was cancelled
+// first, then frees the slot and publishes the final status.
+//
+// background_loader_cancel_all() is the hot-reload barrier: it flags
+// every task in flight, then drains the queue (skipping the ones that
+// never started), so no game callback is running when it returns.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#ifndef DE100_BACKGROUND_LOADER_WORKERS
+#define DE100_BACKGROUND_LOADER_WORKERS 2
+#endif
+
+#ifndef DE100_BACKGROUND_LOADER_MAX_TASKS
+#define DE100_BACKGROUND_LOADER_MAX_TASKS 64
+#endif
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ERROR CODES
+// ═══════════════════════════════════════════════════════════════════════════
+
+typedef enum {
+  BACKGROUND_LOADER_SUCCESS = 0,
+  BACKGROUND_LOADER_ERROR_NULL_LOADER,
+  BACKGROUND_LOADER_ERROR_SYNC_INIT_FAILED,
+  BACKGROUND_LOADER_ERROR_QUEUE_INIT_FAILED,
+  BACKGROUND_LOADER_ERROR_NO_WORKERS,
+
+  BACKGROUND_LOADER_ERROR_COUNT
+} BackgroundLoaderErrorCode;
+
+// ═══════════════════════════════════════════════════════════════════════════
+// LOADER STRUCTURES
+// ═══════════════════════════════════════════════════════════════════════════
+
+typedef struct {
+  De100BackgroundLoader *loader;
+  De100BackgroundLoad *task; // NULL = free (guarded by loader->lock)
+} BackgroundLoaderSlot;
+
+struct De100BackgroundLoader {
+  De100WorkQueue queue;
+  BackgroundLoaderSlot slots[DE100_BACKGROUND_LOADER_MAX_TASKS];
+  pthread_mutex_t lock;
+  bool32 is_initialized;
+};
+
+typedef struct {
+  bool success;
+  BackgroundLoaderErrorCode error_code;
+  u32 worker_count;
+} BackgroundLoaderInitResult;
+
+// ═══════════════════════════════════════════════════════════════════════════
+// API FUNCTIONS
+// ═══════════════════════════════════════════════════════════════════════════
+
+/**
+ * Start the loader threads.
+ *
+ * @param loader        Loader storage (zeroed; usually engine-allocated)
+ * @param worker_count  Threads to start; 0 = DE100_BACKGROUND_LOADER_WORKERS
+ */
+BackgroundLoaderInitResult background_loader_init(De100BackgroundLoader *loader,
+                                                  u32 worker_count);
+
+/**
+ * Cancel every task in flight and wait until none is running.
+ * Call before unloading the game library.
+ */
+void background_loader_cancel_all(De100BackgroundLoader *loader);
+
+/**
+ * Cancel all, then join the threads. Safe to call multiple times.
+ */
+void background_loader_shutdown(De100BackgroundLoader *loader);
+
+/**
+ * Implementation of the GameMemory function pointer (main thread only).
+ */
+DE100_PLATFORM_BACKGROUND_LOAD_SUBMIT(background_loader_submit);
+
+const char *background_loader_strerror(BackgroundLoaderErrorCode code);
+
+#endif // DE100_PLATFORMS__COMMON_BACKGROUND_LOADER_H
@@ -0,0 +1,299 @@
+#include "benchmark.h"
+
+#include "../../_common/memory.h"
+#include "../../_common/time.h"
+#include "../../engine.h"
+#include "../../game/base.h"
+#include "../../game/game-loader.h"
+#include "../../game/inputs.h"
+#include "fixed-timestep.h"
+#include "replay-archive.h"
+#include "replay-buffer.h"
+#include "replay-hash.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+typedef enum {
+  BENCHMARK_PHASE_INPUT = 0,
+  BENCHMARK_PHASE_UPDATE,
+  BENCHMARK_PHASE_RENDER,
+  BENCHMARK_PHASE_AUDIO,
+  BENCHMARK_PHASE_FRAME,
+
+  BENCHMARK_PHASE_COUNT
+} BenchmarkPhase;
+
+de100_file_scoped_global_var const char
+    *g_benchmark_phase_names[BENCHMARK_PHASE_COUNT] = {
+        "input", "update", "render", "audio", "frame",
+};
+
+typedef struct {
+  ReplayArchive replay;
+  bool has_replay;
+
+  // f32 ms per phase per frame, frame_capacity frames each
+  De100MemoryBlock timings;
+  u64 frame_capacity;
+  u64 phase_counts[BENCHMARK_PHASE_COUNT];
+} BenchmarkState;
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Helpers
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn inline f32 *benchmark_phase_times(BenchmarkState *bench,
+                                                      BenchmarkPhase phase) {
+  return (f32 *)bench->timings.base + (u64)phase * bench->frame_capacity;
+}
+
+de100_file_scoped_fn inline void benchmark_record(BenchmarkState *bench,
+                                                 BenchmarkPhase phase,
+                                                 f64 start, f64 end) {
+  u64 *count = &bench->phase_counts[phase];
+  if (*count < bench->frame_capacity) {
+    benchmark_phase_times(bench, phase)[(*count)++] =
+        (f32)(de100_get_seconds_elapsed(start, end) * 1000.0);
+  }
+}
+
+de100_file_scoped_fn int benchmark_compare_f32(const void *a, const void *b) {
+  f32 x = *(const f32 *)a;
+  f32 y = *(const f32 *)b;
+  return (x > y) - (x < y);
+}
+
+FramePhaseSummary benchmark_summarize_ms(f32 *milliseconds, u64 count) {
+  FramePhaseSummary summary = {0};
+  if (count == 0) {
+    return summary;
+  }
+
+  f64 total = 0.0;
+  for (u64 i = 0; i < count; ++i) {
+    total += milliseconds[i];
+  }
+  qsort(milliseconds, count, sizeof(f32), benchmark_compare_f32);
+
+#define BENCHMARK_PERCENTILE(p)                                                \
+  milliseconds[(u64)((p) / 100.0 * (f64)(count - 1) + 0.5)]
+  summary.count = count;
+  summary.mean_ms = (f32)(total / (f64)count);
+  summary.p50_ms = BENCHMARK_PERCENTILE(50.0);
+  summary.p95_ms = BENCHMARK_PERCENTILE(95.0);
+  summary.p99_ms = BENCHMARK_PERCENTILE(99.0);
+  summary.p999_ms = BENCHMARK_PERCENTILE(99.9);
+  summary.max_ms = milliseconds[count - 1];
+#undef BENCHMARK_PERCENTILE
+  return summary;
+}
+
+/**
+ * Put the archive's snapshot into game memory.
+ */
+de100_file_scoped_fn bool benchmark_restore(EngineState *engine,
+                                            BenchmarkState *bench,
+                                            const char *replay_path) {
+  ReplaySnapshotTracker *tracker =
+      &engine->platform.memory_state.snapshot_tracker;
+  u64 snapshot_size = bench->replay.header.snapshot_size;
+  if (snapshot_size > tracker->capacity ||
+      bench->replay.header.input_frame_size != sizeof(GameInput)) {
+    fprintf(stderr, "❌ '%s': %s\n", replay_path,
+            replay_archive_strerror(REPLAY_ARCHIVE_ERROR_SIZE_MISMATCH));
+    return false;
+  }
+
+  // Game memory is about to change behind the tracker's back
+  replay_snapshot_tracker_invalidate(tracker);
+  if (!replay_snapshot_tracker_commit(tracker, snapshot_size)) {
+    fprintf(stderr, "❌ Failed to commit memory for the snapshot\n");
+    return false;
+  }
+  ReplayArchiveResult result = replay_archive_read_snapshot(
+      &bench->replay, tracker->base, snapshot_size);
+  if (!result.success) {
+    fprintf(stderr, "❌ Failed to unpack snapshot: %s\n",
+            replay_archive_strerror(result.error_code));
+    return false;
+  }
+  return true;
+}
+
+/**
+ * One frame's worth of audio, as the headless backend generates it.
+ */
+de100_file_scoped_fn void benchmark_generate_audio(EngineState *engine) {
+  EngineGameState *game = &engine->game;
+  i32 sample_count = (i32)((f32)game->audio.samples_per_second *
+                           game->config.target_seconds_per_frame);
+  if (sample_count <= 0) {
+    return;
+  }
+  if (sample_count > game->audio.max_sample_count) {
+    sample_count = game->audio.max_sample_count;
+  }
+
+  game->audio.sample_count = sample_count;
+  DE100_GAME_CALL(&engine->platform.game_main_code, get_audio_samples)(
+      &game->memory, &game->audio);
+  game->audio.running_sample_index += (u64)sample_count;
+}
+
+de100_file_scoped_fn void benchmark_shutdown(BenchmarkState *bench) {
+  if (bench->has_replay) {
+    replay_archive_close(&bench->replay);
+    bench->has_replay = false;
+  }
+  if (de100_memory_is_valid(bench->timings)) {
+    de100_memory_free(&bench->timings);
+  }
+}
+
+de100_file_scoped_fn void benchmark_report(BenchmarkState *bench, u64 frames,
+                                           f64 elapsed, u64 state_hash) {
+  printf("[BENCHMARK] ✅ %lu frames in %.3fs (%.0f f/s)\n",
+         (unsigned long)frames, elapsed,
+         elapsed > 0.0 ? (f64)frames / elapsed : 0.0);
+  printf("[BENCHMARK] phase      frames     mean      p50      p95      p99"
+         "      max\n");
+  for (i32 phase = 0; phase < BENCHMARK_PHASE_COUNT; ++phase) {
+    u64 count = bench->phase_counts[phase];
+    if (count == 0) {
+      // render: the game runs update_and_render, timed as update
+      printf("[BENCHMARK] %-8s %8s\n", g_benchmark_phase_names[phase], "-");
+      continue;
+    }
+    FramePhaseSummary summary = benchmark_summarize_ms(
+        benchmark_phase_times(bench, (BenchmarkPhase)phase), count);
+    printf("[BENCHMARK] %-8s %8lu %8.3f %8.3f %8.3f %8.3f %8.3f\n",
+           g_benchmark_phase_names[phase], (unsigned long)summary.count,
+           (f64)summary.mean_ms, (f64)summary.p50_ms, (f64)summary.p95_ms,
+           (f64)summary.p99_ms, (f64)summary.max_ms);
+  }
+  printf("[BENCHMARK] 🔑 Permanent storage hash: %016llx\n",
+         (unsigned long long)state_hash);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Entry Point
+// ═══════════════════════════════════════════════════════════════════════════
+
+int benchmark_main(const char *replay_path) {
+  EngineState engine = {0};
+  BenchmarkState bench = {0};
+
+  ReplayArchiveResult open_result =
+      replay_archive_open(replay_path, &bench.replay);
+  if (!open_result.success) {
+    fprintf(stderr, "❌ Failed to open replay '%s': %s\n", replay_path,
+            replay_archive_strerror(open_result.error_code));
+    return 1;
+  }
+  bench.has_replay = true;
+
+  bench.frame_capacity = bench.replay.header.frame_count;
+  if (bench.frame_capacity > 0) {
+    bench.timings = de100_memory_alloc(
+        NULL, bench.frame_capacity * BENCHMARK_PHASE_COUNT * sizeof(f32),
+        De100_MEMORY_FLAG_RW);
+    if (!de100_memory_is_valid(bench.timings)) {
+      fprintf(stderr, "❌ Out of memory for %lu frames of timings\n",
+              (unsigned long)bench.frame_capacity);
+      benchmark_shutdown(&bench);
+      return 1;
+    }
+  }
+
+  if (engine_init(&engine)) {
+    benchmark_shutdown(&bench);
+    return 1;
+  }
+
+  // Bootstrap first: the snapshot then overwrites its state
+  DE100_GAME_CALL(&engine.platform.game_bootstrap_code, init)(
+      &engine.game.thread_context, &engine.game.memory, engine.game.inputs,
+      &engine.game.backbuffer);
+  if (!benchmark_restore(&engine, &bench, replay_path)) {
+    benchmark_shutdown(&bench);
+    engine_shutdown(&engine);
+    return 1;
+  }
+
+  // Rendering on, presentation off: nothing uploads, so nothing to track
+  engine.game.backbuffer.is_rendering_disabled = false;
+  engine.game.backbuffer.dirty.is_tracking = false;
+
+  // Same ticks per frame on every machine (fixed-timestep.h)
+  g_fixed_timestep.ignore_tick_budget = true;
+
+  GameMainCode *code = &engine.platform.game_main_code;
+  bool is_fixed_timestep = fixed_timestep_is_active(&engine.game.config, code);
+  f32 frame_seconds = engine.game.config.target_seconds_per_frame;
+
+  printf("[BENCHMARK] 🏁 '%s': %lu frames, %s\n", replay_path,
+         (unsigned long)bench.frame_capacity,
+         is_fixed_timestep ? "game_update + game_render"
+                           : "game_update_and_render");
+
+  f64 start = de100_get_wall_clock();
+  u64 frame = 0;
+  int exit_code = 0;
+
+  // Same loop shape as the headless backend, with a clock between phases
+  while (is_game_running && frame < bench.frame_capacity) {
+    f64 frame_start = de100_get_wall_clock();
+    prepare_input_frame(engine.platform.old_inputs, engine.game.inputs);
+    ReplayArchiveResult result =
+        replay_archive_read_frame(&bench.replay, frame, engine.game.inputs);
+    if (!result.success) {
+      fprintf(stderr, "❌ Failed to read frame %lu: %s\n",
+              (unsigned long)frame,
+              replay_archive_strerror(result.error_code));
+      exit_code = 1;
+      break;
+    }
+    f64 input_end = de100_get_wall_clock();
+    benchmark_record(&bench, BENCHMARK_PHASE_INPUT, frame_start, input_end);
+
+    // Nominal frame time, not wall time: ticks per frame stay reproducible
+    f64 update_end;
+    if (is_fixed_timestep) {
+      fixed_timestep_update(&engine.game, code, frame_seconds);
+      f64 tick_end = de100_get_wall_clock();
+      benchmark_record(&bench, BENCHMARK_PHASE_UPDATE, input_end, tick_end);
+      fixed_timestep_render(&engine.game, code);
+      update_end = de100_get_wall_clock();
+      benchmark_record(&bench, BENCHMARK_PHASE_RENDER, tick_end, update_end);
+    } else {
+      fixed_timestep_run_frame(&engine.game, code, frame_seconds);
+      update_end = de100_get_wall_clock();
+      benchmark_record(&bench, BENCHMARK_PHASE_UPDATE, input_end, update_end);
+    }
+
+    benchmark_generate_audio(&engine);
+    f64 frame_end = de100_get_wall_clock();
+    benchmark_record(&bench, BENCHMARK_PHASE_AUDIO, update_end, frame_end);
+    benchmark_record(&bench, BENCHMARK_PHASE_FRAME, frame_start, frame_end);
+
+#if DE100_INTERNAL
+    // Keep the profiler's rings drained, outside the timed phases
+    de100_profiler_end_frame(engine.game.memory.profiler);
+#endif
+
+    g_frame_counter++;
+    frame++;
+    engine_swap_inputs(&engine);
+  }
+
+  f64 elapsed = de100_get_seconds_elapsed(start, de100_get_wall_clock());
+  u64 state_hash =
+      replay_state_hash_memory(engine.game.memory.permanent_storage,
+                               engine.game.memory.permanent_storage_size);
+  benchmark_report(&bench, frame, elapsed, state_hash);
+
+  benchmark_shutdown(&bench);
+  engine_shutdown(&engine);
+  return exit_code;
+}
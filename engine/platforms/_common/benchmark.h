@@ -0,0 +1,48 @@
+#ifndef DE100_PLATFORMS__COMMON_BENCHMARK_H
+#define DE100_PLATFORMS__COMMON_BENCHMARK_H
+
+#include "../../_common/base.h"
+#include "frame-stats.h"
+
+// ═══════════════════════════════════════════════════════════════════════════
+// 🏁 WHOLE-GAME BENCHMARK (--benchmark <recording.hmr>)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// Any backend's executable, same game library, real content:
+//
+//   ./game --benchmark loop_edit_1.hmr
+//
+// Restores the archive's snapshot (replay-archive.h) and plays every
+// recorded GameInput back to back: no window, no audio device, no frame
+// pacing, no presentation. The game still renders every frame into the
+// backbuffer and generates one frame of audio, so the work measured is
+// the work a live frame does minus the platform's share.
+//
+// Each frame is split into phases, timed individually:
+//
+//   input   decode the recorded frame
+//   update  game_update ticks (or the whole update_and_render when the
+//           game doesn't export the fixed-timestep pair)
+//   render  game_render (fixed-timestep games only)
+//   audio   get_audio_samples
+//   frame   all of the above
+//
+// On exit: mean / p50 / p95 / p99 / max per phase (exact, every frame
+// kept), frames per second and the permanent storage hash. Run it on the
+// game library before and after a change: the hashes must match, the
+// percentiles are the measurement.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+/**
+ * Run the benchmark and print its report.
+ * @return 0 on success, non-zero if the recording couldn't be played
+ */
+int benchmark_main(const char *replay_path);
+
+/**
+ * Exact summary of `count` per-frame times (sorts them in place).
+ */
+FramePhaseSummary benchmark_summarize_ms(f32 *milliseconds, u64 count);
+
+#endif // DE100_PLATFORMS__COMMON_BENCHMARK_H
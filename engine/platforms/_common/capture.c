@@ -0,0 +1,823 @@
+#include "./capture.h"
+#include "../../_common/memory.h"
+#include "../../_common/time.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ERROR MESSAGES
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_global_var const char *g_capture_error_messages[] = {
+    [CAPTURE_SUCCESS] = "Success",
+    [CAPTURE_ERROR_BAD_SPEC] =
+        "Bad capture spec (expected DIR, FILE.y4m[,EVERY] or "
+        "FILE.raw[,EVERY])",
+    [CAPTURE_ERROR_ALREADY_ACTIVE] = "Capture is already running",
+    [CAPTURE_ERROR_OPEN_FAILED] = "Failed to open the video file",
+    [CAPTURE_ERROR_THREAD_CREATE_FAILED] =
+        "Failed to create the capture encoder thread",
+};
+
+const char *capture_strerror(CaptureErrorCode code) {
+  if (code >= 0 && code < CAPTURE_ERROR_COUNT) {
+    return g_capture_error_messages[code];
+  }
+  return "Unknown capture error";
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// STATE
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define CAPTURE_ENCODER_IDLE_NS (2 * 1000 * 1000)
+#define CAPTURE_BYTES_PER_PIXEL 4
+#define CAPTURE_HASH_BITS 15
+#define CAPTURE_DEFLATE_WINDOW 32768
+#define CAPTURE_DEFLATE_MAX_MATCH 258
+
+typedef enum {
+  CAPTURE_VIDEO_NONE = 0,
+  CAPTURE_VIDEO_Y4M,
+  CAPTURE_VIDEO_RAW,
+} CaptureVideoFormat;
+
+typedef enum {
+  CAPTURE_SLOT_SCREENSHOT = 1 << 0,
+  CAPTURE_SLOT_VIDEO = 1 << 1,
+} CaptureSlotFlags;
+
+typedef struct {
+  De100MemoryBlock block; // width * height * 4, rows packed
+  u32 width;
+  u32 height;
+  u32 pixel_format;
+  u32 flags; // CaptureSlotFlags
+  f32 seconds_per_frame;
+} CaptureSlot;
+
+typedef struct {
+  char directory[CAPTURE_PATH_LENGTH]; // Screenshots
+  char video_path[CAPTURE_PATH_LENGTH];
+  CaptureVideoFormat video_format;
+  u32 video_every;
+
+  // main thread → encoder
+  CaptureSlot slots[CAPTURE_RING_SIZE];
+  u32 slot_count; // 1 for screenshots only
+  u64 slot_bytes; // Capacity of each; changed by main with the ring empty
+  u64 write_index;
+  u64 read_index;
+
+  pthread_t encoder;
+  bool encoder_started;
+  bool is_running; // __atomic
+  bool is_disabled; // Slot allocation failed
+
+  // Main-only
+  bool screenshot_pending;
+  u64 frames_offered;
+  u64 video_frames_dropped; // Ring full
+
+  // Encoder-only
+  FILE *video;
+  u32 video_width;
+  u32 video_height;
+  u64 video_frames_written;
+  u64 video_frames_mismatched; // Not the first frame's size
+  u32 screenshots_written;
+  u32 write_failures;
+  De100MemoryBlock rows;     // PNG filtered rows, or one I420 frame
+  De100MemoryBlock deflated; // zlib stream
+  u32 hash_heads[1u << CAPTURE_HASH_BITS]; // Position + 1, 0 = none
+  u32 crc_table[256];
+} Capture;
+
+de100_file_scoped_global_var Capture g_capture = {.video_every = 1};
+
+/** Grow `block` to hold `size` bytes; contents are not kept. */
+de100_file_scoped_fn bool capture_reserve(De100MemoryBlock *block,
+                                          u64 size) {
+  if (de100_memory_is_valid(*block) && block->size >= size) {
+    return true;
+  }
+  if (de100_memory_is_valid(*block)) {
+    de100_memory_free(block);
+  }
+  *block = de100_memory_alloc(NULL, size, De100_MEMORY_FLAG_RW);
+  return de100_memory_is_valid(*block);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// CHECKSUMS
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn void capture_crc_init(Capture *capture) {
+  for (u32 n = 0; n < 256; ++n) {
+    u32 c = n;
+    for (int k = 0; k < 8; ++k) {
+      c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+    }
+    capture->crc_table[n] = c;
+  }
+}
+
+/** Running CRC-32 (PNG chunks); start and finish with ~0. */
+de100_file_scoped_fn u32 capture_crc_update(const Capture *capture, u32 crc,
+                                            const u8 *data, u64 size) {
+  for (u64 i = 0; i < size; ++i) {
+    crc = capture->crc_table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+  }
+  return crc;
+}
+
+de100_file_scoped_fn u32 capture_adler32(const u8 *data, u64 size) {
+  u32 a = 1;
+  u32 b = 0;
+  while (size > 0) {
+    u64 chunk = size < 5552 ? size : 5552; // Largest n without u32 overflow
+    size -= chunk;
+    while (chunk--) {
+      a += *data++;
+      b += a;
+    }
+    a %= 65521;
+    b %= 65521;
+  }
+  return (b << 16) | a;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// DEFLATE (fixed Huffman, greedy LZ77)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// One final block with the fixed code (RFC 1951 §3.2.6), so no tables are
+// sent or built. One hash probe per position, like zlib level 1: flat game
+// art (runs, repeated tiles) shrinks 20-100x, noisy art stays ~raw size.
+// Output never exceeds 9/8 of the input plus a few bytes: a literal is at
+// most 9 bits, and a match costs at most 25 bits for 3+ bytes.
+
+typedef struct {
+  u8 *out;
+  u64 size;
+  u64 bits;
+  u32 bit_count;
+} CaptureBitWriter;
+
+de100_file_scoped_global_var const u16 g_capture_length_base[29] = {
+    3,  4,  5,  6,  7,  8,  9,  10, 11,  13,  15,  17,  19,  23, 27,
+    31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+de100_file_scoped_global_var const u8 g_capture_length_extra[29] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2,
+    2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+de100_file_scoped_global_var const u16 g_capture_distance_base[30] = {
+    1,    2,    3,    4,    5,    7,     9,     13,    17,  25,
+    33,   49,   65,   97,   129,  193,   257,   385,   513, 769,
+    1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+de100_file_scoped_global_var const u8 g_capture_distance_extra[30] = {
+    0, 0, 0, 0, 1, 1, 2, 2,  3,  3,  4,  4,  5,  5,  6,
+    6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+de100_file_scoped_fn inline void capture_put_bits(CaptureBitWriter *writer,
+                                                  u32 value, u32 count) {
+  writer->bits |= (u64)value << writer->bit_count;
+  writer->bit_count += count;
+  while (writer->bit_count >= 8) {
+    writer->out[writer->size++] = (u8)writer->bits;
+    writer->bits >>= 8;
+    writer->bit_count -= 8;
+  }
+}
+
+/** Huffman codes go out most significant bit first. */
+de100_file_scoped_fn inline void capture_put_code(CaptureBitWriter *writer,
+                                                  u32 code, u32 length) {
+  u32 reversed = 0;
+  for (u32 i = 0; i < length; ++i) {
+    reversed = (reversed << 1) | (code & 1);
+    code >>= 1;
+  }
+  capture_put_bits(writer, reversed, length);
+}
+
+de100_file_scoped_fn inline void capture_put_symbol(CaptureBitWriter *writer,
+                                                    u32 symbol) {
+  if (symbol <= 143) {
+    capture_put_code(writer, 0x30 + symbol, 8);
+  } else if (symbol <= 255) {
+    capture_put_code(writer, 0x190 + (symbol - 144), 9);
+  } else if (symbol <= 279) {
+    capture_put_code(writer, symbol - 256, 7);
+  } else {
+    capture_put_code(writer, 0xC0 + (symbol - 280), 8);
+  }
+}
+
+de100_file_scoped_fn void capture_put_match(CaptureBitWriter *writer,
+                                            u32 length, u32 distance) {
+  u32 code = 28;
+  while (g_capture_length_base[code] > length) {
+    --code;
+  }
+  capture_put_symbol(writer, 257 + code);
+  capture_put_bits(writer, length - g_capture_length_base[code],
+                   g_capture_length_extra[code]);
+
+  code = 29;
+  while (g_capture_distance_base[code] > distance) {
+    --code;
+  }
+  capture_put_code(writer, code, 5);
+  capture_put_bits(writer, distance - g_capture_distance_base[code],
+                   g_capture_distance_extra[code]);
+}
+
+/**
+ * zlib stream of `data` into `out` (room for size * 9 / 8 + 64).
+ * @return Bytes written
+ */
+de100_file_scoped_fn u64 capture_zlib_compress(Capture *capture, u8 *out,
+                                               const u8 *data, u64 size) {
+  CaptureBitWriter writer = {.out = out};
+  out[writer.size++] = 0x78; // Deflate, 32 KB window
+  out[writer.size++] = 0x01; // No dictionary, check bits
+  capture_put_bits(&writer, 1, 1); // BFINAL
+  capture_put_bits(&writer, 1, 2); // BTYPE = fixed Huffman
+
+  u32 *heads = capture->hash_heads;
+  memset(heads, 0, sizeof(capture->hash_heads));
+
+  u64 i = 0;
+  while (i < size) {
+    if (i + 3 <= size) {
+      u32 key = (u32)data[i] | (u32)data[i + 1] << 8 | (u32)data[i + 2] << 16;
+      u32 hash = (key * 2654435761u) >> (32 - CAPTURE_HASH_BITS);
+      u32 candidate = heads[hash];
+      heads[hash] = (u32)i + 1;
+
+      if (candidate && i - (candidate - 1) <= CAPTURE_DEFLATE_WINDOW) {
+        u64 from = candidate - 1;
+        u64 max_length = size - i < CAPTURE_DEFLATE_MAX_MATCH
+                             ? size - i
+                             : CAPTURE_DEFLATE_MAX_MATCH;
+        u64 length = 0;
+        // Overlapping matches (from + length >= i) are valid deflate
+        while (length < max_length && data[from + length] == data[i + length]) {
+          ++length;
+        }
+        if (length >= 3) {
+          capture_put_match(&writer, (u32)length, (u32)(i - from));
+          i += length;
+          continue;
+        }
+      }
+    }
+    capture_put_symbol(&writer, data[i]);
+    ++i;
+  }
+
+  capture_put_symbol(&writer, 256); // End of block
+  if (writer.bit_count > 0) {
+    capture_put_bits(&writer, 0, 8 - writer.bit_count);
+  }
+
+  u32 adler = capture_adler32(data, size);
+  out[writer.size++] = (u8)(adler >> 24);
+  out[writer.size++] = (u8)(adler >> 16);
+  out[writer.size++] = (u8)(adler >> 8);
+  out[writer.size++] = (u8)adler;
+  return writer.size;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ENCODERS
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn inline void capture_channel_bytes(const CaptureSlot *slot,
+                                                       u32 *red, u32 *blue) {
+  *red = slot->pixel_format == DE100_PIXEL_FORMAT_BGRA8 ? 2 : 0;
+  *blue = 2 - *red;
+}
+
+de100_file_scoped_fn inline void capture_put_u32_be(u8 *out, u32 value) {
+  out[0] = (u8)(value >> 24);
+  out[1] = (u8)(value >> 16);
+  out[2] = (u8)(value >> 8);
+  out[3] = (u8)value;
+}
+
+de100_file_scoped_fn bool capture_write_chunk(const Capture *capture,
+                                              FILE *file, const char *type,
+                                              const u8 *data, u32 size) {
+  u8 header[8];
+  capture_put_u32_be(header, size);
+  memcpy(header + 4, type, 4);
+  u32 crc = capture_crc_update(capture, ~0u, header + 4, 4);
+  crc = ~capture_crc_update(capture, crc, data, size);
+  u8 footer[4];
+  capture_put_u32_be(footer, crc);
+
+  return fwrite(header, 1, sizeof(header), file) == sizeof(header) &&
+         (size == 0 || fwrite(data, 1, size, file) == size) &&
+         fwrite(footer, 1, sizeof(footer), file) == sizeof(footer);
+}
+
+/** 8-bit RGB PNG, Sub filter on every row (alpha is not meaningful). */
+de100_file_scoped_fn void capture_write_png(Capture *capture,
+                                            const CaptureSlot *slot) {
+  f64 start = de100_get_wall_clock();
+  u64 row_bytes = 1 + (u64)slot->width * 3;
+  u64 raw_size = row_bytes * slot->height;
+  if (!capture_reserve(&capture->rows, raw_size) ||
+      !capture_reserve(&capture->deflated, raw_size + raw_size / 8 + 64)) {
+    capture->write_failures++;
+    return;
+  }
+
+  u32 red, blue;
+  capture_channel_bytes(slot, &red, &blue);
+  const u8 *pixels = (const u8 *)slot->block.base;
+  u8 *rows = (u8 *)capture->rows.base;
+  for (u32 y = 0; y < slot->height; ++y) {
+    const u8 *src = pixels + (u64)y * slot->width * CAPTURE_BYTES_PER_PIXEL;
+    u8 *dst = rows + (u64)y * row_bytes;
+    *dst++ = 1; // Sub: each byte minus the one a pixel to the left
+    u8 left_r = 0, left_g = 0, left_b = 0;
+    for (u32 x = 0; x < slot->width; ++x, src += CAPTURE_BYTES_PER_PIXEL) {
+      u8 r = src[red], g = src[1], b = src[blue];
+      *dst++ = (u8)(r - left_r);
+      *dst++ = (u8)(g - left_g);
+      *dst++ = (u8)(b - left_b);
+      left_r = r;
+      left_g = g;
+      left_b = b;
+    }
+  }
+  u64 deflated_size = capture_zlib_compress(
+      capture, (u8 *)capture->deflated.base, rows, raw_size);
+
+  struct tm local = {0};
+  time_t now = time(NULL);
+#if defined(_WIN32)
+  localtime_s(&local, &now);
+#else
+  localtime_r(&now, &local);
+#endif
+  char path[CAPTURE_PATH_LENGTH + 64];
+  snprintf(path, sizeof(path),
+           "%s/screenshot-%04d%02d%02d-%02d%02d%02d-%u.png",
+           capture->directory, local.tm_year + 1900, local.tm_mon + 1,
+           local.tm_mday, local.tm_hour, local.tm_min, local.tm_sec,
+           capture->screenshots_written);
+
+  FILE *file = fopen(path, "wb");
+  if (!file) {
+    fprintf(stderr, "[CAPTURE] ❌ Can't write %s\n", path);
+    capture->write_failures++;
+    return;
+  }
+  static const u8 signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+  u8 header[13];
+  capture_put_u32_be(header, slot->width);
+  capture_put_u32_be(header + 4, slot->height);
+  header[8] = 8;  // Bit depth
+  header[9] = 2;  // Color type: RGB
+  header[10] = 0; // Deflate
+  header[11] = 0; // Adaptive filtering
+  header[12] = 0; // Not interlaced
+
+  bool ok = fwrite(signature, 1, sizeof(signature), file) ==
+                sizeof(signature) &&
+            capture_write_chunk(capture, file, "IHDR", header,
+                                sizeof(header)) &&
+            capture_write_chunk(capture, file, "IDAT",
+                                (const u8 *)capture->deflated.base,
+                                (u32)deflated_size) &&
+            capture_write_chunk(capture, file, "IEND", NULL, 0);
+  ok = fclose(file) == 0 && ok;
+  if (!ok) {
+    fprintf(stderr, "[CAPTURE] ❌ Failed writing %s\n", path);
+    capture->write_failures++;
+    return;
+  }
+
+  capture->screenshots_written++;
+  printf("[CAPTURE] 📸 %s (%ux%u, %lu KB, %.1f ms)\n", path, slot->width,
+         slot->height, (unsigned long)((deflated_size + 1023) / 1024),
+         (de100_get_wall_clock() - start) * 1000.0);
+}
+
+/** BT.601 limited range, chroma averaged over 2x2 (edges repeat). */
+de100_file_scoped_fn void capture_to_i420(const CaptureSlot *slot, u8 *out) {
+  u32 width = slot->width;
+  u32 height = slot->height;
+  u32 chroma_width = (width + 1) / 2;
+  u32 chroma_height = (height + 1) / 2;
+  u8 *plane_y = out;
+  u8 *plane_u = plane_y + (u64)width * height;
+  u8 *plane_v = plane_u + (u64)chroma_width * chroma_height;
+
+  u32 red, blue;
+  capture_channel_bytes(slot, &red, &blue);
+  const u8 *pixels = (const u8 *)slot->block.base;
+  u64 stride = (u64)width * CAPTURE_BYTES_PER_PIXEL;
+
+  for (u32 y = 0; y < height; ++y) {
+    const u8 *src = pixels + y * stride;
+    u8 *dst = plane_y + (u64)y * width;
+    for (u32 x = 0; x < width; ++x, src += CAPTURE_BYTES_PER_PIXEL) {
+      i32 r = src[red], g = src[1], b = src[blue];
+      dst[x] = (u8)(((66 * r + 129 * g + 25 * b + 128) >> 8) + 16);
+    }
+  }
+
+  for (u32 cy = 0; cy < chroma_height; ++cy) {
+    const u8 *row0 = pixels + (u64)(2 * cy) * stride;
+    const u8 *row1 =
+        2 * cy + 1 < height ? row0 + stride : row0;
+    for (u32 cx = 0; cx < chroma_width; ++cx) {
+      u64 x0 = (u64)(2 * cx) * CAPTURE_BYTES_PER_PIXEL;
+      u64 x1 = 2 * cx + 1 < width ? x0 + CAPTURE_BYTES_PER_PIXEL : x0;
+      i32 r = row0[x0 + red] + row0[x1 + red] + row1[x0 + red] +
+              row1[x1 + red];
+      i32 g = row0[x0 + 1] + row0[x1 + 1] + row1[x0 + 1] + row1[x1 + 1];
+      i32 b = row0[x0 + blue] + row0[x1 + blue] + row1[x0 + blue] +
+              row1[x1 + blue];
+      // Sums of 4: the >> 10 folds in the average
+      u64 at = (u64)cy * chroma_width + cx;
+      plane_u[at] =
+          (u8)(((-38 * r - 74 * g + 112 * b + 512) >> 10) + 128);
+      plane_v[at] =
+          (u8)(((112 * r - 94 * g - 18 * b + 512) >> 10) + 128);
+    }
+  }
+}
+
+de100_file_scoped_fn void capture_write_video(Capture *capture,
+                                              const CaptureSlot *slot) {
+  if (!capture->video) {
+    return;
+  }
+  if (capture->video_frames_written + capture->video_frames_mismatched ==
+      0) {
+    capture->video_width = slot->width;
+    capture->video_height = slot->height;
+    if (capture->video_format == CAPTURE_VIDEO_Y4M) {
+      // Frame rate as a ratio in thousandths: 59.94 stays 59940:1000
+      f32 seconds = slot->seconds_per_frame * (f32)capture->video_every;
+      u32 millihertz = seconds > 0.0f ? (u32)(1000.0f / seconds + 0.5f)
+                                      : 60000;
+      fprintf(capture->video,
+              "YUV4MPEG2 W%u H%u F%u:1000 Ip A1:1 C420jpeg "
+              "XYSCSS=420JPEG\n",
+              slot->width, slot->height, millihertz);
+    }
+  }
+  if (slot->width != capture->video_width ||
+      slot->height != capture->video_height) {
+    capture->video_frames_mismatched++;
+    return;
+  }
+
+  bool ok;
+  if (capture->video_format == CAPTURE_VIDEO_Y4M) {
+    u64 luma = (u64)slot->width * slot->height;
+    u64 chroma = (u64)((slot->width + 1) / 2) * ((slot->height + 1) / 2);
+    u64 frame_size = luma + 2 * chroma;
+    if (!capture_reserve(&capture->rows, frame_size)) {
+      capture->write_failures++;
+      return;
+    }
+    capture_to_i420(slot, (u8 *)capture->rows.base);
+    ok = fputs("FRAME\n", capture->video) >= 0 &&
+         fwrite(capture->rows.base, 1, frame_size, capture->video) ==
+             frame_size;
+  } else {
+    u64 frame_size =
+        (u64)slot->width * slot->height * CAPTURE_BYTES_PER_PIXEL;
+    ok = fwrite(slot->block.base, 1, frame_size, capture->video) ==
+         frame_size;
+  }
+
+  if (ok) {
+    capture->video_frames_written++;
+  } else {
+    capture->write_failures++;
+  }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ENCODER THREAD
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn void *capture_encoder_proc(void *arg) {
+  Capture *capture = (Capture *)arg;
+
+  for (;;) {
+    bool running = __atomic_load_n(&capture->is_running, __ATOMIC_ACQUIRE);
+    u64 read = capture->read_index;
+    u64 write = __atomic_load_n(&capture->write_index, __ATOMIC_ACQUIRE);
+
+    for (; read < write; ++read) {
+      const CaptureSlot *slot = &capture->slots[read % capture->slot_count];
+      if (slot->flags & CAPTURE_SLOT_SCREENSHOT) {
+        capture_write_png(capture, slot);
+      }
+      if (slot->flags & CAPTURE_SLOT_VIDEO) {
+        capture_write_video(capture, slot);
+      }
+      // Hand the slot back as soon as it's done
+      __atomic_store_n(&capture->read_index, read + 1, __ATOMIC_RELEASE);
+    }
+
+    if (!running) {
+      break;
+    }
+    struct timespec idle = {0, CAPTURE_ENCODER_IDLE_NS};
+    nanosleep(&idle, NULL);
+  }
+
+  return NULL;
+}
+
+de100_file_scoped_fn CaptureErrorCode capture_start(Capture *capture) {
+  capture_crc_init(capture);
+  __atomic_store_n(&capture->is_running, true, __ATOMIC_RELEASE);
+  if (pthread_create(&capture->encoder, NULL, capture_encoder_proc,
+                     capture) != 0) {
+    __atomic_store_n(&capture->is_running, false, __ATOMIC_RELEASE);
+    return CAPTURE_ERROR_THREAD_CREATE_FAILED;
+  }
+  capture->encoder_started = true;
+  return CAPTURE_SUCCESS;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// SPEC
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn bool capture_has_suffix(const char *text, size_t length,
+                                             const char *suffix) {
+  size_t suffix_length = strlen(suffix);
+  return length > suffix_length &&
+         strncmp(text + length - suffix_length, suffix, suffix_length) == 0;
+}
+
+/** "DIR", "FILE.y4m[,EVERY]" or "FILE.raw[,EVERY]" → capture settings. */
+de100_file_scoped_fn bool capture_parse(Capture *capture, const char *spec) {
+  const char *comma = strchr(spec, ',');
+  size_t length = comma ? (size_t)(comma - spec) : strlen(spec);
+  if (length == 0 || length >= CAPTURE_PATH_LENGTH) {
+    return false;
+  }
+
+  if (capture_has_suffix(spec, length, ".y4m")) {
+    capture->video_format = CAPTURE_VIDEO_Y4M;
+  } else if (capture_has_suffix(spec, length, ".raw")) {
+    capture->video_format = CAPTURE_VIDEO_RAW;
+  } else {
+    if (comma) {
+      return false; // A screenshot directory takes no frame interval
+    }
+    memcpy(capture->directory, spec, length);
+    capture->directory[length] = '\0';
+    return true;
+  }
+
+  memcpy(capture->video_path, spec, length);
+  capture->video_path[length] = '\0';
+  if (comma) {
+    char *end = NULL;
+    unsigned long every = strtoul(comma + 1, &end, 10);
+    if (end == comma + 1 || *end != '\0' || every == 0 ||
+        every > 1000000) {
+      return false;
+    }
+    capture->video_every = (u32)every;
+  }
+
+  // Screenshots go next to the video
+  const char *slash = strrchr(capture->video_path, '/');
+  if (slash) {
+    size_t directory_length = (size_t)(slash - capture->video_path);
+    memcpy(capture->directory, capture->video_path,
+           directory_length ? directory_length : 1);
+    capture->directory[directory_length ? directory_length : 1] = '\0';
+  }
+  return true;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// PUBLIC API
+// ═══════════════════════════════════════════════════════════════════════════
+
+CaptureResult capture_begin(const char *spec) {
+  CaptureResult result = {0};
+  Capture *capture = &g_capture;
+
+  if (capture->encoder_started) {
+    result.error_code = CAPTURE_ERROR_ALREADY_ACTIVE;
+    return result;
+  }
+
+  *capture = (Capture){.video_every = 1, .slot_count = 1};
+  snprintf(capture->directory, sizeof(capture->directory), ".");
+  if (!spec || !spec[0]) {
+    result.success = true; // Screenshots start the encoder on demand
+    result.error_code = CAPTURE_SUCCESS;
+    return result;
+  }
+  if (!capture_parse(capture, spec)) {
+    result.error_code = CAPTURE_ERROR_BAD_SPEC;
+    return result;
+  }
+
+  if (capture->video_format != CAPTURE_VIDEO_NONE) {
+    capture->video = fopen(capture->video_path, "wb");
+    if (!capture->video) {
+      result.error_code = CAPTURE_ERROR_OPEN_FAILED;
+      return result;
+    }
+    // Few large writes: the encoder is I/O-bound at 1080p (~190 MB/s Y4M)
+    setvbuf(capture->video, NULL, _IOFBF, 1 << 20);
+    capture->slot_count = CAPTURE_RING_SIZE;
+
+    CaptureErrorCode start_error = capture_start(capture);
+    if (start_error != CAPTURE_SUCCESS) {
+      fclose(capture->video);
+      capture->video = NULL;
+      result.error_code = start_error;
+      return result;
+    }
+    printf("[CAPTURE] 🎥 Recording every %u frame(s) to %s\n",
+           capture->video_every, capture->video_path);
+  }
+
+  result.success = true;
+  result.error_code = CAPTURE_SUCCESS;
+  return result;
+}
+
+void capture_request_screenshot(void) {
+  Capture *capture = &g_capture;
+  if (capture->is_disabled) {
+    return;
+  }
+  if (capture->slot_count == 0) {
+    capture_begin(NULL); // Never configured (no engine_init)
+  }
+  if (!capture->encoder_started) {
+    CaptureErrorCode start_error = capture_start(capture);
+    if (start_error != CAPTURE_SUCCESS) {
+      fprintf(stderr, "[CAPTURE] ❌ %s\n", capture_strerror(start_error));
+      return;
+    }
+  }
+  capture->screenshot_pending = true;
+}
+
+/** (Re)allocate every slot for `bytes`. Only with the ring empty. */
+de100_file_scoped_fn bool capture_resize_slots(Capture *capture, u64 bytes) {
+  for (u32 i = 0; i < capture->slot_count; ++i) {
+    CaptureSlot *slot = &capture->slots[i];
+    if (de100_memory_is_valid(slot->block)) {
+      de100_memory_free(&slot->block);
+    }
+    slot->block = de100_memory_alloc(
+        NULL, bytes, De100_MEMORY_FLAG_RW | De100_MEMORY_FLAG_PREFAULT);
+    if (!de100_memory_is_valid(slot->block)) {
+      capture->slot_bytes = 0;
+      return false;
+    }
+  }
+  capture->slot_bytes = bytes;
+  return true;
+}
+
+void capture_frame(const GameBackBuffer *backbuffer,
+                   f32 target_seconds_per_frame) {
+  Capture *capture = &g_capture;
+  if (!capture->encoder_started || capture->is_disabled) {
+    return;
+  }
+
+  u32 flags = 0;
+  if (capture->screenshot_pending) {
+    flags |= CAPTURE_SLOT_SCREENSHOT;
+  }
+  if (capture->video && capture->frames_offered++ % capture->video_every == 0) {
+    flags |= CAPTURE_SLOT_VIDEO;
+  }
+  if (!flags || backbuffer->is_rendering_disabled ||
+      !backbuffer->memory.base || backbuffer->width <= 0 ||
+      backbuffer->height <= 0 ||
+      backbuffer->bytes_per_pixel != CAPTURE_BYTES_PER_PIXEL) {
+    return;
+  }
+
+  u64 write = capture->write_index;
+  u64 read = __atomic_load_n(&capture->read_index, __ATOMIC_ACQUIRE);
+  u64 row_bytes = (u64)backbuffer->width * CAPTURE_BYTES_PER_PIXEL;
+  u64 frame_bytes = row_bytes * (u64)backbuffer->height;
+
+  bool is_full = write - read >= capture->slot_count;
+  if (!is_full && frame_bytes > capture->slot_bytes) {
+    // The encoder holds no slot when the ring is empty
+    if (read != write) {
+      is_full = true;
+    } else if (!capture_resize_slots(capture, frame_bytes)) {
+      fprintf(stderr, "[CAPTURE] ❌ Out of memory for %dx%d frames, "
+                      "capture off\n",
+              backbuffer->width, backbuffer->height);
+      capture->is_disabled = true;
+      return;
+    }
+  }
+  if (is_full) {
+    if (flags & CAPTURE_SLOT_VIDEO) {
+      capture->video_frames_dropped++;
+    }
+    return; // A screenshot stays pending for the next frame
+  }
+
+  CaptureSlot *slot = &capture->slots[write % capture->slot_count];
+  const u8 *src = (const u8 *)backbuffer->memory.base;
+  u8 *dst = (u8 *)slot->block.base;
+  if ((u64)backbuffer->pitch == row_bytes) {
+    memcpy(dst, src, frame_bytes);
+  } else {
+    for (int y = 0; y < backbuffer->height; ++y) {
+      memcpy(dst + (u64)y * row_bytes, src + (u64)y * backbuffer->pitch,
+             row_bytes);
+    }
+  }
+  slot->width = (u32)backbuffer->width;
+  slot->height = (u32)backbuffer->height;
+  slot->pixel_format = (u32)backbuffer->pixel_format;
+  slot->flags = flags;
+  slot->seconds_per_frame = target_seconds_per_frame;
+  __atomic_store_n(&capture->write_index, write + 1, __ATOMIC_RELEASE);
+
+  capture->screenshot_pending = false;
+}
+
+void capture_end(void) {
+  Capture *capture = &g_capture;
+  if (!capture->encoder_started) {
+    return;
+  }
+
+  __atomic_store_n(&capture->is_running, false, __ATOMIC_RELEASE);
+  pthread_join(capture->encoder, NULL);
+  capture->encoder_started = false;
+
+  if (capture->video) {
+    fclose(capture->video);
+    capture->video = NULL;
+    printf("[CAPTURE] ✅ %s: %lu frames (%lu dropped, ring full; %lu "
+           "dropped, wrong size)\n",
+           capture->video_path,
+           (unsigned long)capture->video_frames_written,
+           (unsigned long)capture->video_frames_dropped,
+           (unsigned long)capture->video_frames_mismatched);
+    if (capture->video_format == CAPTURE_VIDEO_RAW &&
+        capture->video_frames_written > 0) {
+      const CaptureSlot *slot = &capture->slots[0];
+      printf("[CAPTURE]    ffmpeg -f rawvideo -pixel_format %s "
+             "-video_size %ux%u -framerate %.3f -i %s out.mkv\n",
+             slot->pixel_format == DE100_PIXEL_FORMAT_BGRA8 ? "bgra"
+                                                            : "rgba",
+             capture->video_width, capture->video_height,
+             slot->seconds_per_frame > 0.0f
+                 ? 1.0f / (slot->seconds_per_frame *
+                           (f32)capture->video_every)
+                 : 60.0f,
+             capture->video_path);
+    }
+  }
+  if (capture->write_failures > 0) {
+    fprintf(stderr, "[CAPTURE] ⚠️  %u writes failed\n",
+            capture->write_failures);
+  }
+
+  for (u32 i = 0; i < CAPTURE_RING_SIZE; ++i) {
+    if (de100_memory_is_valid(capture->slots[i].block)) {
+      de100_memory_free(&capture->slots[i].block);
+    }
+  }
+  capture->slot_bytes = 0;
+  capture->write_index = 0;
+  capture->read_index = 0;
+  if (de100_memory_is_valid(capture->rows)) {
+    de100_memory_free(&capture->rows);
+  }
+  if (de100_memory_is_valid(capture->deflated)) {
+    de100_memory_free(&capture->deflated);
+  }
+}
+
+bool capture_is_active(void) { return g_capture.encoder_started; }
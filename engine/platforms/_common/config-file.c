@@ -0,0 +1,510 @@
+#include "./config-file.h"
+#include "../../_common/file.h"
+#include "../../_common/log.h"
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ERROR MESSAGES
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_global_var const char *g_config_file_error_messages[] = {
+    [CONFIG_FILE_SUCCESS] = "Success",
+    [CONFIG_FILE_ERROR_OPEN_FAILED] = "Failed to open the config file",
+    [CONFIG_FILE_ERROR_READ_FAILED] = "Failed to read the config file",
+    [CONFIG_FILE_ERROR_TOO_LARGE] =
+        "Config file larger than CONFIG_FILE_MAX_BYTES",
+    [CONFIG_FILE_ERROR_SYNTAX] = "Expected \"key = value\"",
+    [CONFIG_FILE_ERROR_UNKNOWN_KEY] = "Not a GameConfig field",
+    [CONFIG_FILE_ERROR_BAD_VALUE] = "Value of the wrong type or out of range",
+};
+
+const char *config_file_strerror(ConfigFileErrorCode code) {
+  if (code >= 0 && code < CONFIG_FILE_ERROR_COUNT) {
+    return g_config_file_error_messages[code];
+  }
+  return "Unknown config file error";
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// FIELDS
+// ═══════════════════════════════════════════════════════════════════════════
+
+typedef enum {
+  CONFIG_FIELD_BOOL = 0, // bool
+  CONFIG_FIELD_U32,      // u32
+  CONFIG_FIELD_SIZE,     // u64, K/M/G suffixes
+  CONFIG_FIELD_F32,      // f32
+} ConfigFieldType;
+
+typedef struct {
+  const char *name;
+  u16 offset; // Into GameConfig
+  u8 type;    // ConfigFieldType
+  u8 is_live; // Read every frame: safe to change on reload
+} ConfigFileField;
+
+#define CONFIG_FIELD(name, type, is_live)                                      \
+  {#name, (u16)offsetof(GameConfig, name), (type), (is_live)}
+
+de100_file_scoped_global_var const ConfigFileField g_config_file_fields[] = {
+    // Memory
+    CONFIG_FIELD(permanent_storage_size, CONFIG_FIELD_SIZE, false),
+    CONFIG_FIELD(transient_storage_size, CONFIG_FIELD_SIZE, false),
+    CONFIG_FIELD(frame_arena_size, CONFIG_FIELD_SIZE, false),
+    CONFIG_FIELD(prefer_large_pages, CONFIG_FIELD_BOOL, false),
+    CONFIG_FIELD(prefault_game_memory, CONFIG_FIELD_BOOL, false),
+    CONFIG_FIELD(prefer_numa_local_memory, CONFIG_FIELD_BOOL, false),
+    CONFIG_FIELD(prefer_lazy_transient_commit, CONFIG_FIELD_BOOL, false),
+
+    // Window / display
+    CONFIG_FIELD(window_width, CONFIG_FIELD_U32, false),
+    CONFIG_FIELD(window_height, CONFIG_FIELD_U32, false),
+    CONFIG_FIELD(target_refresh_rate_hz, CONFIG_FIELD_U32, true),
+    CONFIG_FIELD(max_allowed_refresh_rate_hz, CONFIG_FIELD_U32, true),
+    CONFIG_FIELD(prefer_adaptive_fps, CONFIG_FIELD_BOOL, true),
+    CONFIG_FIELD(prefer_vsync, CONFIG_FIELD_BOOL, false),
+    CONFIG_FIELD(prefer_dynamic_resolution, CONFIG_FIELD_BOOL, false),
+    CONFIG_FIELD(prefer_vblank_present_timing, CONFIG_FIELD_BOOL, false),
+    CONFIG_FIELD(prefer_present_thread, CONFIG_FIELD_BOOL, false),
+    CONFIG_FIELD(prefer_shm_present, CONFIG_FIELD_BOOL, false),
+    CONFIG_FIELD(prefer_dirty_rect_present, CONFIG_FIELD_BOOL, false),
+    CONFIG_FIELD(prefer_present_texture_ring, CONFIG_FIELD_BOOL, false),
+    CONFIG_FIELD(prefer_scaled_present, CONFIG_FIELD_BOOL, false),
+    CONFIG_FIELD(prefer_integer_scaling, CONFIG_FIELD_BOOL, false),
+    CONFIG_FIELD(prefer_core_profile_present, CONFIG_FIELD_BOOL, false),
+    CONFIG_FIELD(present_scanline_intensity, CONFIG_FIELD_F32, true),
+
+    // Threading
+    CONFIG_FIELD(worker_thread_count, CONFIG_FIELD_U32, false),
+
+    // Replay
+    CONFIG_FIELD(replay_keyframe_interval_seconds, CONFIG_FIELD_F32, false),
+    CONFIG_FIELD(replay_state_hash_interval_frames, CONFIG_FIELD_U32, false),
+    CONFIG_FIELD(rewind_seconds, CONFIG_FIELD_F32, false),
+    CONFIG_FIELD(rewind_log_megabytes, CONFIG_FIELD_U32, false),
+
+    // Input
+    CONFIG_FIELD(prefer_threaded_joystick, CONFIG_FIELD_BOOL, false),
+    CONFIG_FIELD(prefer_raw_mouse_input, CONFIG_FIELD_BOOL, false),
+
+    // Audio
+    CONFIG_FIELD(initial_audio_sample_rate, CONFIG_FIELD_U32, false),
+    CONFIG_FIELD(audio_buffer_size_frames, CONFIG_FIELD_U32, false),
+    CONFIG_FIELD(prefer_threaded_audio, CONFIG_FIELD_BOOL, false),
+    CONFIG_FIELD(prefer_adaptive_audio_latency, CONFIG_FIELD_BOOL, false),
+    CONFIG_FIELD(prefer_mmap_audio, CONFIG_FIELD_BOOL, false),
+    CONFIG_FIELD(prefer_audio_server, CONFIG_FIELD_BOOL, false),
+
+    // Timing
+    CONFIG_FIELD(max_updates_per_frame, CONFIG_FIELD_U32, true),
+    CONFIG_FIELD(prefer_high_res_frame_timer, CONFIG_FIELD_BOOL, false),
+    CONFIG_FIELD(prefer_event_loop, CONFIG_FIELD_BOOL, false),
+    CONFIG_FIELD(prefer_late_input_latch, CONFIG_FIELD_BOOL, false),
+    CONFIG_FIELD(prefer_background_throttle, CONFIG_FIELD_BOOL, true),
+    CONFIG_FIELD(background_fps, CONFIG_FIELD_U32, true),
+};
+
+// Sim rate, pipelining and modules change what the game itself sees, so
+// they stay the game's call (startup()), not the machine's
+
+// ═══════════════════════════════════════════════════════════════════════════
+// PARSING
+// ═══════════════════════════════════════════════════════════════════════════
+
+typedef struct {
+  i32 field; // Into g_config_file_fields; -1 = blank or comment line
+  union {
+    bool boolean;
+    u32 u32_value;
+    u64 size;
+    f32 f32_value;
+  } value;
+} ConfigFileAssignment;
+
+de100_file_scoped_fn inline bool config_file_is_space(char c) {
+  return c == ' ' || c == '\t' || c == '\r';
+}
+
+/** True if [text, text + length) is `word`, ignoring ASCII case. */
+de100_file_scoped_fn bool config_file_token_is(const char *text, u32 length,
+                                               const char *word) {
+  u32 i = 0;
+  for (; i < length && word[i]; ++i) {
+    char c = text[i];
+    if (c >= 'A' && c <= 'Z') {
+      c = (char)(c - 'A' + 'a');
+    }
+    if (c != word[i]) {
+      return false;
+    }
+  }
+  return i == length && word[i] == '\0';
+}
+
+de100_file_scoped_fn bool config_file_parse_bool(const char *text, u32 length,
+                                                 bool *out) {
+  if (config_file_token_is(text, length, "true") ||
+      config_file_token_is(text, length, "on") ||
+      config_file_token_is(text, length, "yes") ||
+      config_file_token_is(text, length, "1")) {
+    *out = true;
+    return true;
+  }
+  if (config_file_token_is(text, length, "false") ||
+      config_file_token_is(text, length, "off") ||
+      config_file_token_is(text, length, "no") ||
+      config_file_token_is(text, length, "0")) {
+    *out = false;
+    return true;
+  }
+  return false;
+}
+
+/** Decimal digits, then (when `allow_suffix`) K, M or G and an optional B. */
+de100_file_scoped_fn bool config_file_parse_u64(const char *text, u32 length,
+                                                bool allow_suffix, u64 *out) {
+  u64 value = 0;
+  u32 i = 0;
+  for (; i < length && text[i] >= '0' && text[i] <= '9'; ++i) {
+    u64 digit = (u64)(text[i] - '0');
+    if (value > (~0ull - digit) / 10) {
+      return false;
+    }
+    value = value * 10 + digit;
+  }
+  if (i == 0) {
+    return false;
+  }
+
+  if (allow_suffix && i < length) {
+    u32 shift = 0;
+    switch (text[i]) {
+    case 'K':
+    case 'k':
+      shift = 10;
+      break;
+    case 'M':
+    case 'm':
+      shift = 20;
+      break;
+    case 'G':
+    case 'g':
+      shift = 30;
+      break;
+    default:
+      return false;
+    }
+    i++;
+    if (i < length && (text[i] == 'B' || text[i] == 'b')) {
+      i++;
+    }
+    if (value > (~0ull >> shift)) {
+      return false;
+    }
+    value <<= shift;
+  }
+
+  *out = value;
+  return i == length;
+}
+
+/** [-]digits[.digits], without strtof: no locale, no NUL needed. */
+de100_file_scoped_fn bool config_file_parse_f32(const char *text, u32 length,
+                                                f32 *out) {
+  u32 i = 0;
+  bool is_negative = i < length && text[i] == '-';
+  i += is_negative;
+
+  u64 mantissa = 0;
+  f64 scale = 1.0;
+  u32 digit_count = 0;
+  bool seen_point = false;
+  for (; i < length; ++i) {
+    char c = text[i];
+    if (c == '.' && !seen_point) {
+      seen_point = true;
+      continue;
+    }
+    if (c < '0' || c > '9') {
+      return false;
+    }
+    // Digits past 18 can't change an f32
+    if (digit_count < 18) {
+      mantissa = mantissa * 10 + (u64)(c - '0');
+      if (seen_point) {
+        scale *= 10.0;
+      }
+    } else if (!seen_point) {
+      scale /= 10.0;
+    }
+    digit_count++;
+  }
+  if (digit_count == 0) {
+    return false;
+  }
+
+  f64 value = (f64)mantissa / scale;
+  *out = (f32)(is_negative ? -value : value);
+  return true;
+}
+
+/**
+ * One line (no newline) into `out`. Blank and comment lines parse as
+ * field -1.
+ */
+de100_file_scoped_fn ConfigFileErrorCode
+config_file_parse_line(const char *line, u32 length,
+                       ConfigFileAssignment *out) {
+  out->field = -1;
+
+  // Comment to end of line
+  for (u32 i = 0; i < length; ++i) {
+    if (line[i] == '#') {
+      length = i;
+      break;
+    }
+  }
+  while (length > 0 && config_file_is_space(line[length - 1])) {
+    length--;
+  }
+  u32 start = 0;
+  while (start < length && config_file_is_space(line[start])) {
+    start++;
+  }
+  if (start == length) {
+    return CONFIG_FILE_SUCCESS;
+  }
+
+  u32 equals = start;
+  while (equals < length && line[equals] != '=') {
+    equals++;
+  }
+  if (equals == length) {
+    return CONFIG_FILE_ERROR_SYNTAX;
+  }
+  u32 key_end = equals;
+  while (key_end > start && config_file_is_space(line[key_end - 1])) {
+    key_end--;
+  }
+  u32 value_start = equals + 1;
+  while (value_start < length && config_file_is_space(line[value_start])) {
+    value_start++;
+  }
+  if (key_end == start || value_start == length) {
+    return CONFIG_FILE_ERROR_SYNTAX;
+  }
+
+  const char *key = line + start;
+  u32 key_length = key_end - start;
+  i32 field = -1;
+  for (u32 i = 0; i < ArraySize(g_config_file_fields); ++i) {
+    const char *name = g_config_file_fields[i].name;
+    if (strlen(name) == key_length && memcmp(name, key, key_length) == 0) {
+      field = (i32)i;
+      break;
+    }
+  }
+  if (field < 0) {
+    return CONFIG_FILE_ERROR_UNKNOWN_KEY;
+  }
+
+  const char *value = line + value_start;
+  u32 value_length = length - value_start;
+  bool is_valid = false;
+  u64 integer = 0;
+  switch ((ConfigFieldType)g_config_file_fields[field].type) {
+  case CONFIG_FIELD_BOOL:
+    is_valid = config_file_parse_bool(value, value_length,
+                                      &out->value.boolean);
+    break;
+  case CONFIG_FIELD_U32:
+    is_valid = config_file_parse_u64(value, value_length, false, &integer) &&
+               integer <= 0xFFFFFFFFull;
+    out->value.u32_value = (u32)integer;
+    break;
+  case CONFIG_FIELD_SIZE:
+    is_valid =
+        config_file_parse_u64(value, value_length, true, &out->value.size);
+    break;
+  case CONFIG_FIELD_F32:
+    is_valid = config_file_parse_f32(value, value_length,
+                                     &out->value.f32_value);
+    break;
+  }
+  if (!is_valid) {
+    return CONFIG_FILE_ERROR_BAD_VALUE;
+  }
+
+  out->field = field;
+  return CONFIG_FILE_SUCCESS;
+}
+
+/**
+ * Write the assignment into `config`.
+ *
+ * @return true if the field's value changed
+ */
+de100_file_scoped_fn bool
+config_file_store(const ConfigFileAssignment *assignment, GameConfig *config,
+                  bool is_dry_run) {
+  const ConfigFileField *field = &g_config_file_fields[assignment->field];
+  u8 *target = (u8 *)config + field->offset;
+  size_t size = 0;
+  switch ((ConfigFieldType)field->type) {
+  case CONFIG_FIELD_BOOL:
+    size = sizeof(bool);
+    break;
+  case CONFIG_FIELD_U32:
+    size = sizeof(u32);
+    break;
+  case CONFIG_FIELD_SIZE:
+    size = sizeof(u64);
+    break;
+  case CONFIG_FIELD_F32:
+    size = sizeof(f32);
+    break;
+  }
+  // Every union member starts at its first byte
+  if (memcmp(target, &assignment->value, size) == 0) {
+    return false;
+  }
+  if (!is_dry_run) {
+    memcpy(target, &assignment->value, size);
+  }
+  return true;
+}
+
+ConfigFileResult config_file_apply_text(const char *text, u32 length,
+                                        GameConfig *config, bool is_reload) {
+  ConfigFileResult result = {0};
+
+  // Pass 0 validates every line, pass 1 applies: all or nothing
+  for (u32 pass = 0; pass < 2; ++pass) {
+    u32 line_number = 0;
+    for (u32 line_start = 0; line_start < length;) {
+      u32 line_end = line_start;
+      while (line_end < length && text[line_end] != '\n') {
+        line_end++;
+      }
+      line_number++;
+
+      ConfigFileAssignment assignment;
+      ConfigFileErrorCode error = config_file_parse_line(
+          text + line_start, line_end - line_start, &assignment);
+      line_start = line_end + 1;
+
+      if (error != CONFIG_FILE_SUCCESS) {
+        result.error_code = error;
+        result.line = line_number;
+        return result;
+      }
+      if (pass == 0 || assignment.field < 0) {
+        continue;
+      }
+
+      const ConfigFileField *field = &g_config_file_fields[assignment.field];
+      if (is_reload && !field->is_live) {
+        if (config_file_store(&assignment, config, true)) {
+          DE100_LOG_WARN(DE100_LOG_ENGINE,
+                         "Config: %s takes effect on restart", field->name);
+          result.restart_count++;
+        }
+        continue;
+      }
+      result.applied_count += config_file_store(&assignment, config, false);
+    }
+  }
+
+  result.success = true;
+  result.error_code = CONFIG_FILE_SUCCESS;
+  return result;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// FILE
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn ConfigFileResult config_file_load(ConfigFile *file,
+                                                       GameConfig *config,
+                                                       bool is_reload) {
+  ConfigFileResult result = {0};
+  // Off the stack; only the main thread loads
+  local_persist_var char text[CONFIG_FILE_MAX_BYTES];
+
+  De100FileOpenResult open_result = de100_file_open(file->path,
+                                                    DE100_FILE_READ);
+  if (!open_result.success) {
+    result.error_code = CONFIG_FILE_ERROR_OPEN_FAILED;
+    return result;
+  }
+  // One byte over the limit tells "exactly full" from "too large"
+  De100FileIOResult read_result =
+      de100_file_read_all(open_result.fd, text, sizeof(text));
+  de100_file_close(open_result.fd);
+  if (read_result.success) {
+    result.error_code = CONFIG_FILE_ERROR_TOO_LARGE;
+    return result;
+  }
+  if (read_result.error_code != DE100_FILE_ERROR_EOF) {
+    result.error_code = CONFIG_FILE_ERROR_READ_FAILED;
+    return result;
+  }
+
+  result = config_file_apply_text(text, (u32)read_result.bytes_processed,
+                                  config, is_reload);
+  if (result.success) {
+    file->load_count++;
+  }
+  return result;
+}
+
+ConfigFileResult config_file_open(ConfigFile *file, const char *exe_directory,
+                                  GameConfig *config) {
+  ConfigFileResult result = {.success = true};
+  *file = (ConfigFile){0};
+
+  const char *path = getenv("DE100_CONFIG");
+  if (path && path[0]) {
+    snprintf(file->path, sizeof(file->path), "%s", path);
+  } else if (exe_directory) {
+    snprintf(file->path, sizeof(file->path), "%s/%s", exe_directory,
+             CONFIG_FILE_DEFAULT_NAME);
+    De100FileExistsResult exists = de100_file_exists(file->path);
+    if (!exists.success || !exists.exists) {
+      file->path[0] = '\0';
+      return result;
+    }
+  } else {
+    return result;
+  }
+
+  result = config_file_load(file, config, false);
+
+  // Watched even after a bad first load: fixing the file still applies
+  // its live fields
+  De100FileWatchResult watch_result;
+  file->watch = de100_file_watch_start(file->path, &watch_result);
+  if (!file->watch) {
+    DE100_LOG_WARN(DE100_LOG_ENGINE, "Config '%s' not watched: %s",
+                   file->path,
+                   de100_file_watch_strerror(watch_result.error_code));
+  }
+  return result;
+}
+
+bool config_file_poll(ConfigFile *file) {
+  return file->watch && de100_file_watch_consume(file->watch);
+}
+
+ConfigFileResult config_file_reload(ConfigFile *file, GameConfig *config) {
+  return config_file_load(file, config, true);
+}
+
+void config_file_close(ConfigFile *file) {
+  de100_file_watch_stop(file->watch);
+  file->watch = NULL;
+}
@@ -0,0 +1,105 @@
+#ifndef DE100_PLATFORMS__COMMON_CONFIG_FILE_H
+#define DE100_PLATFORMS__COMMON_CONFIG_FILE_H
+
+#include "../../_common/base.h"
+#include "../../_common/file-watch.h"
+#include "../../game/config.h"
+
+#include <stdbool.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ⚙️ RUNTIME CONFIG FILE (GameConfig overrides, reloaded live)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// Per-machine tuning without a rebuild: a text file of GameConfig fields,
+// applied over the game's startup() values at engine_init and watched
+// like the game library afterwards.
+//
+//   # Steam Deck
+//   transient_storage_size = 256M
+//   worker_thread_count = 3
+//   max_allowed_refresh_rate_hz = 60
+//   prefer_adaptive_fps = true
+//   present_scanline_intensity = 0.25
+//
+// One `key = value` per line; `#` starts a comment. Values are true /
+// false (also on/off, yes/no, 1/0), unsigned integers, sizes with an
+// optional K/M/G suffix (powers of 1024) and plain decimals ("0.25").
+// Keys are GameConfig field names (the table in config-file.c).
+//
+// The path is DE100_CONFIG, else de100.cfg next to the executable when
+// there is one.
+//
+// LIVE vs RESTART: a reload applies only the fields the engine reads
+// every frame (frame-rate targets and tiers, tick cap, background
+// throttle, scanlines). Fields sized or started at init (storage, window,
+// workers, audio device, presenter) keep their value until the next run;
+// changing one in the file logs a warning instead.
+//
+// A file with any bad line is rejected whole, on reload too: half of a
+// config is worse than the last good one. The file is read into one
+// static CONFIG_FILE_MAX_BYTES buffer and parsed in place; nothing is
+// allocated.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define CONFIG_FILE_MAX_BYTES (16 * 1024)
+#define CONFIG_FILE_DEFAULT_NAME "de100.cfg"
+#define CONFIG_FILE_MAX_PATH 512
+
+typedef enum {
+  CONFIG_FILE_SUCCESS = 0,
+  CONFIG_FILE_ERROR_OPEN_FAILED,
+  CONFIG_FILE_ERROR_READ_FAILED,
+  CONFIG_FILE_ERROR_TOO_LARGE,
+  CONFIG_FILE_ERROR_SYNTAX,      // Not "key = value"
+  CONFIG_FILE_ERROR_UNKNOWN_KEY,
+  CONFIG_FILE_ERROR_BAD_VALUE,   // Wrong type or out of range
+  CONFIG_FILE_ERROR_COUNT
+} ConfigFileErrorCode;
+
+typedef struct {
+  bool success;
+  ConfigFileErrorCode error_code;
+  u32 line;          // First bad line (1-based), 0 when not a line's fault
+  u32 applied_count; // Fields whose value changed
+  u32 restart_count; // Changed in the file, held until restart (reloads)
+} ConfigFileResult;
+
+typedef struct {
+  char path[CONFIG_FILE_MAX_PATH]; // Empty = no config file
+  De100FileWatch *watch;
+  u32 load_count; // Successful loads, the first included
+} ConfigFile;
+
+/**
+ * Parse `length` bytes of config text and apply it to `config`: every
+ * field on the first load, only live fields when `is_reload`. Nothing is
+ * applied unless the whole text parses.
+ */
+ConfigFileResult config_file_apply_text(const char *text, u32 length,
+                                        GameConfig *config, bool is_reload);
+
+/**
+ * Find the config file (DE100_CONFIG, else CONFIG_FILE_DEFAULT_NAME in
+ * `exe_directory` if present), load it over `config` and start watching
+ * it. No file is success with an empty file->path.
+ */
+ConfigFileResult config_file_open(ConfigFile *file, const char *exe_directory,
+                                  GameConfig *config);
+
+/**
+ * Once per frame: true when the file changed and settled since the last
+ * call (one atomic load otherwise). Then call config_file_reload().
+ */
+bool config_file_poll(ConfigFile *file);
+
+/** Re-read the file and apply its live fields to `config`. */
+ConfigFileResult config_file_reload(ConfigFile *file, GameConfig *config);
+
+/** Stop watching. */
+void config_file_close(ConfigFile *file);
+
+const char *config_file_strerror(ConfigFileErrorCode code);
+
+#endif // DE100_PLATFORMS__COMMON_CONFIG_FILE_H
@@ -18,6 +18,29 @@
 //
 // ═══════════════════════════════════════════════════════════════════════════
 
+// ─────────────────────────────────────────────────────────────────────
+// THREAD PLACEMENT (see thread-placement.h)
+// ─────────────────────────────────────────────────────────────────────
+//
+// Filled by engine_init() (de100_thread_placement_defaults, overridable
+// with DE100_THREAD_PLACEMENT); backends read it when they start threads.
+// ─────────────────────────────────────────────────────────────────────
+
+typedef struct {
+  // Audio thread: SCHED_FIFO on Linux, MMCSS "Pro Audio" on Windows,
+  // USER_INTERACTIVE QoS on macOS. Falls back to a raised nice level,
+  // then to normal priority, when the OS refuses.
+  bool audio_realtime;
+  i32 audio_realtime_priority; // SCHED_FIFO 1..99 (Linux only)
+
+  // Workers one per physical core except the first, which (with its
+  // SMT siblings) is left to the main (frame) thread. Pinning the main
+  // thread itself is opt-in: threads it starts afterwards inherit the
+  // pin unless they re-place themselves.
+  bool pin_main_thread;
+  bool pin_workers;
+} PlatformThreadPlacement;
+
 typedef struct {
   // Display
   u32 window_width;
@@ -36,6 +59,8 @@ typedef struct {
 
   // Timing
   f32 seconds_per_frame;
+
+  PlatformThreadPlacement threads;
 } PlatformConfig;
 
 #endif /* DE100_GAME__COMMON_CONFIG_H */
@@ -0,0 +1,497 @@
+#include "./debug-overlay.h"
+#include "../../game/memory-arena.h"
+#include "../../game/render-group.h"
+#include "./frame-stats.h"
+#include "./input-latency.h"
+#include "./work-queue.h"
+
+#include <stdio.h>
+
+// Only built with DE100_INTERNAL (see build-common.sh); arena statistics and
+// the profiler exist only there
+#if DE100_INTERNAL
+
+// ═══════════════════════════════════════════════════════════════════════════
+// LAYOUT
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define OVERLAY_MAX_COMMANDS 8192
+#define OVERLAY_PAD 8
+#define OVERLAY_GAP 4
+#define OVERLAY_GRAPH_HEIGHT 48
+#define OVERLAY_ROW_HEIGHT 5 // Per nesting level in a timeline lane
+#define OVERLAY_MAX_LANE_DEPTH 8
+#define OVERLAY_ARENA_BAR_HEIGHT 4
+#define OVERLAY_AUDIO_BAR_HEIGHT 4
+#define OVERLAY_LATENCY_BAR_HEIGHT 4
+
+#define OVERLAY_MAX_ARENAS                                                     \
+  (DE100_WORK_QUEUE_MAX_THREADS + DE100_DEBUG_MAX_ARENAS + 1)
+
+DebugOverlayMode g_debug_overlay_mode = DEBUG_OVERLAY_HIDDEN;
+DebugOverlayAudio g_debug_overlay_audio = {0};
+const MemoryStats *g_debug_overlay_memory = NULL;
+
+// Platform-owned command storage: the overlay must not touch game arenas
+de100_file_scoped_global_var De100RenderCommand
+    g_overlay_commands[OVERLAY_MAX_COMMANDS];
+
+typedef struct {
+  u8 r, g, b;
+  const char *name;
+} OverlayPaletteEntry;
+
+// Indexed by block id, so colors stay put across frames and reloads
+de100_file_scoped_global_var const OverlayPaletteEntry g_overlay_palette[] = {
+    {230, 80, 70, "red"},     {90, 190, 90, "green"},
+    {80, 140, 230, "blue"},   {230, 190, 60, "yellow"},
+    {180, 100, 220, "purple"}, {70, 200, 200, "cyan"},
+    {235, 140, 50, "orange"}, {220, 110, 170, "pink"},
+};
+#define OVERLAY_PALETTE_COUNT                                                  \
+  (sizeof(g_overlay_palette) / sizeof(g_overlay_palette[0]))
+
+de100_file_scoped_global_var const char
+    *g_overlay_mode_names[DEBUG_OVERLAY_MODE_COUNT] = {
+        [DEBUG_OVERLAY_HIDDEN] = "hidden",
+        [DEBUG_OVERLAY_SEMI_TRANSPARENT] = "semi-transparent",
+        [DEBUG_OVERLAY_OPAQUE] = "opaque",
+};
+
+// ═══════════════════════════════════════════════════════════════════════════
+// HELPERS
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn inline const OverlayPaletteEntry *
+overlay_block_palette(u32 block_id) {
+  return &g_overlay_palette[(block_id - 1) % OVERLAY_PALETTE_COUNT];
+}
+
+de100_file_scoped_fn inline u32 overlay_block_color(u32 block_id,
+                                                    u32 alpha) {
+  const OverlayPaletteEntry *entry = overlay_block_palette(block_id);
+  return DE100_RGBA(entry->r, entry->g, entry->b, alpha);
+}
+
+de100_file_scoped_fn inline i32 overlay_scale(f64 fraction, i32 width) {
+  if (fraction <= 0.0) {
+    return 0;
+  }
+  if (fraction >= 1.0) {
+    return width;
+  }
+  return (i32)(fraction * (f64)width);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// SECTIONS
+// ═══════════════════════════════════════════════════════════════════════════
+
+/**
+ * Last FRAME_STATS_HISTORY_COUNT frame times, oldest on the left. The
+ * target frame time sits at half height, so misses stand out.
+ */
+de100_file_scoped_fn void overlay_frame_graph(De100RenderGroup *group,
+                                              i32 left, i32 top, i32 width,
+                                              f32 target_ms, u32 alpha) {
+  i32 bar_width = width / FRAME_STATS_HISTORY_COUNT;
+  if (bar_width < 1) {
+    bar_width = 1;
+  }
+  u32 bar_count = (u32)(width / bar_width);
+  if (bar_count > FRAME_STATS_HISTORY_COUNT) {
+    bar_count = FRAME_STATS_HISTORY_COUNT;
+  }
+
+  de100_push_rect(group, left, top, width, OVERLAY_GRAPH_HEIGHT,
+                  DE100_RGBA(40, 40, 40, alpha));
+
+  u32 oldest = (g_frame_stats.history_index + FRAME_STATS_HISTORY_COUNT -
+                bar_count) %
+               FRAME_STATS_HISTORY_COUNT;
+  for (u32 i = 0; i < bar_count; ++i) {
+    f32 ms = g_frame_stats.history_ms[(oldest + i) %
+                                      FRAME_STATS_HISTORY_COUNT];
+    if (ms <= 0.0f) {
+      continue; // Not recorded yet
+    }
+
+    i32 height = overlay_scale(ms / (2.0f * target_ms), OVERLAY_GRAPH_HEIGHT);
+    if (height < 1) {
+      height = 1;
+    }
+
+    u32 color = ms <= target_ms          ? DE100_RGBA(90, 190, 90, alpha)
+                : ms <= target_ms * 1.5f ? DE100_RGBA(230, 190, 60, alpha)
+                                         : DE100_RGBA(230, 80, 70, alpha);
+    de100_push_rect(group, left + (i32)i * bar_width,
+                    top + OVERLAY_GRAPH_HEIGHT - height, bar_width, height,
+                    color);
+  }
+
+  de100_push_rect(group, left, top + OVERLAY_GRAPH_HEIGHT / 2, width, 1,
+                  DE100_RGBA(255, 255, 255, alpha));
+}
+
+/**
+ * Used (bright) and high-water (dim) fraction of each arena; red when a
+ * push has failed.
+ */
+de100_file_scoped_fn void overlay_arena_bars(De100RenderGroup *group,
+                                             De100MemoryArena **arenas,
+                                             u32 arena_count, i32 left,
+                                             i32 top, i32 width, u32 alpha) {
+  i32 y = top;
+  for (u32 i = 0; i < arena_count; ++i) {
+    De100MemoryArena *arena = arenas[i];
+    f64 size = (f64)arena->size;
+
+    de100_push_rect(group, left, y, width, OVERLAY_ARENA_BAR_HEIGHT,
+                    DE100_RGBA(64, 64, 64, alpha));
+    de100_push_rect(group, left, y,
+                    overlay_scale((f64)arena->high_water_mark / size, width),
+                    OVERLAY_ARENA_BAR_HEIGHT, DE100_RGBA(110, 110, 150, alpha));
+    de100_push_rect(group, left, y,
+                    overlay_scale((f64)arena->used / size, width),
+                    OVERLAY_ARENA_BAR_HEIGHT,
+                    arena->failed_push_count
+                        ? DE100_RGBA(230, 80, 70, alpha)
+                        : DE100_RGBA(190, 200, 255, alpha));
+
+    y += OVERLAY_ARENA_BAR_HEIGHT + 1;
+  }
+}
+
+/**
+ * Memory regions, committed (bright) within reserved (dim), all on the
+ * scale of the largest reservation; then pools, live over capacity.
+ */
+de100_file_scoped_fn void overlay_memory_bars(De100RenderGroup *group,
+                                              const MemoryStats *stats,
+                                              i32 left, i32 top, i32 width,
+                                              u32 alpha) {
+  u64 largest = 1;
+  for (u32 i = 0; i < stats->region_count; ++i) {
+    if (stats->regions[i].reserved > largest) {
+      largest = stats->regions[i].reserved;
+    }
+  }
+
+  i32 y = top;
+  for (u32 i = 0; i < stats->region_count; ++i) {
+    const MemoryStatsRegion *region = &stats->regions[i];
+    de100_push_rect(group, left, y, width, OVERLAY_ARENA_BAR_HEIGHT,
+                    DE100_RGBA(64, 64, 64, alpha));
+    de100_push_rect(group, left, y,
+                    overlay_scale((f64)region->reserved / (f64)largest, width),
+                    OVERLAY_ARENA_BAR_HEIGHT, DE100_RGBA(90, 110, 90, alpha));
+    de100_push_rect(
+        group, left, y,
+        overlay_scale((f64)region->committed / (f64)largest, width),
+        OVERLAY_ARENA_BAR_HEIGHT, DE100_RGBA(150, 220, 150, alpha));
+    y += OVERLAY_ARENA_BAR_HEIGHT + 1;
+  }
+
+  for (u32 i = 0; i < stats->pool_count; ++i) {
+    const MemoryStatsPool *pool = &stats->pools[i];
+    f64 capacity = pool->capacity ? (f64)pool->capacity : 1.0;
+    de100_push_rect(group, left, y, width, OVERLAY_ARENA_BAR_HEIGHT,
+                    DE100_RGBA(64, 64, 64, alpha));
+    de100_push_rect(group, left, y,
+                    overlay_scale((f64)pool->live / capacity, width),
+                    OVERLAY_ARENA_BAR_HEIGHT,
+                    pool->live >= pool->capacity
+                        ? DE100_RGBA(230, 80, 70, alpha)
+                        : DE100_RGBA(230, 190, 60, alpha));
+    y += OVERLAY_ARENA_BAR_HEIGHT + 1;
+  }
+}
+
+/**
+ * Write-ahead (green, red after an underrun) over the write interval (dim),
+ * with the jitter band centred on the interval's end.
+ */
+de100_file_scoped_fn void overlay_audio_bar(De100RenderGroup *group,
+                                            const DebugOverlayAudio *audio,
+                                            i32 left, i32 top, i32 width,
+                                            u32 alpha) {
+  f64 scale = 1.0 / DEBUG_OVERLAY_AUDIO_SCALE_MS;
+  i32 h = OVERLAY_AUDIO_BAR_HEIGHT;
+
+  de100_push_rect(group, left, top, width, h, DE100_RGBA(64, 64, 64, alpha));
+  de100_push_rect(group, left, top,
+                  overlay_scale(audio->latency_ms * scale, width), h,
+                  audio->recent_underrun ? DE100_RGBA(230, 80, 70, alpha)
+                                         : DE100_RGBA(90, 190, 90, alpha));
+  de100_push_rect(group, left, top + 1,
+                  overlay_scale(audio->interval_ms * scale, width), h - 2,
+                  DE100_RGBA(40, 90, 40, alpha));
+
+  i32 jitter_x0 = overlay_scale(
+      (audio->interval_ms - audio->jitter_ms) * scale, width);
+  i32 jitter_x1 = overlay_scale(
+      (audio->interval_ms + audio->jitter_ms) * scale, width);
+  de100_push_rect(group, left + jitter_x0, top,
+                  jitter_x1 > jitter_x0 ? jitter_x1 - jitter_x0 : 1, h,
+                  DE100_RGBA(230, 190, 60, alpha));
+}
+
+/** The stage the latency bar shows: photons if measured, else upload. */
+de100_file_scoped_fn InputLatencyStage overlay_latency_stage(void) {
+  if (g_input_latency.stages[INPUT_LATENCY_PRESENT].count > 0) {
+    return INPUT_LATENCY_PRESENT;
+  }
+  return INPUT_LATENCY_UPLOAD;
+}
+
+/**
+ * Input-to-screen p95 (dim) under p50 (blue), the newest frame's sample
+ * (white tick) and input-to-audio p50 (green tick).
+ */
+de100_file_scoped_fn void overlay_latency_bar(De100RenderGroup *group,
+                                              i32 left, i32 top, i32 width,
+                                              u32 alpha) {
+  InputLatencyStage stage = overlay_latency_stage();
+  f64 scale = 1.0 / DEBUG_OVERLAY_LATENCY_SCALE_MS;
+  i32 h = OVERLAY_LATENCY_BAR_HEIGHT;
+
+  de100_push_rect(group, left, top, width, h, DE100_RGBA(64, 64, 64, alpha));
+  de100_push_rect(
+      group, left, top,
+      overlay_scale(input_latency_percentile_ms(stage, 95.0f) * scale, width),
+      h, DE100_RGBA(50, 80, 130, alpha));
+  de100_push_rect(
+      group, left, top,
+      overlay_scale(input_latency_percentile_ms(stage, 50.0f) * scale, width),
+      h, DE100_RGBA(80, 140, 230, alpha));
+
+  i32 newest_x =
+      overlay_scale(g_input_latency.last_ms[stage] * scale, width - 1);
+  de100_push_rect(group, left + newest_x, top, 1, h,
+                  DE100_RGBA(255, 255, 255, alpha));
+  if (g_input_latency.stages[INPUT_LATENCY_AUDIO].count > 0) {
+    i32 audio_x = overlay_scale(
+        input_latency_percentile_ms(INPUT_LATENCY_AUDIO, 50.0f) * scale,
+        width - 1);
+    de100_push_rect(group, left + audio_x, top, 1, h,
+                    DE100_RGBA(90, 190, 90, alpha));
+  }
+}
+
+/**
+ * The profiler's spans for the last frame: one lane per thread, one row per
+ * nesting level, x = time within the frame.
+ */
+de100_file_scoped_fn void
+overlay_timeline(De100RenderGroup *group, const De100Profiler *profiler,
+                 const u32 *lane_depth, i32 left, i32 top, i32 width,
+                 u32 alpha) {
+  i32 lane_top[DE100_PROFILER_MAX_THREADS];
+  i32 y = top;
+  for (u32 t = 0; t < DE100_PROFILER_MAX_THREADS; ++t) {
+    lane_top[t] = y;
+    if (lane_depth[t] == 0) {
+      continue;
+    }
+    i32 height = (i32)lane_depth[t] * OVERLAY_ROW_HEIGHT;
+    de100_push_rect(group, left, y, width, height,
+                    DE100_RGBA(30, 30, 40, alpha));
+    y += height + 1;
+  }
+
+  f64 frame_cycles = (f64)profiler->frame_cycles;
+  u64 frame_start = profiler->frame_start_cycles;
+
+  // Newest first: a scope lands after everything it encloses, including
+  // frame phases (recorded after the fact), so enclosed blocks paint on top
+  for (u32 i = profiler->span_count; i-- > 0;) {
+    // Group full: a very busy frame shows its last spans only
+    if (group->command_count >= group->max_command_count) {
+      break;
+    }
+
+    const De100ProfileSpan *span = &profiler->spans[i];
+    if (span->depth >= OVERLAY_MAX_LANE_DEPTH) {
+      continue;
+    }
+
+    // Scopes opened in an earlier frame start at the left edge
+    f64 start = span->start_cycles > frame_start
+                    ? (f64)(span->start_cycles - frame_start)
+                    : 0.0;
+    f64 end = span->end_cycles > frame_start
+                  ? (f64)(span->end_cycles - frame_start)
+                  : 0.0;
+    i32 x0 = overlay_scale(start / frame_cycles, width);
+    i32 x1 = overlay_scale(end / frame_cycles, width);
+    if (x1 <= x0) {
+      x1 = x0 + 1; // Too short to see otherwise
+    }
+
+    de100_push_rect(group, left + x0,
+                    lane_top[span->thread_index] +
+                        span->depth * OVERLAY_ROW_HEIGHT,
+                    x1 - x0, OVERLAY_ROW_HEIGHT - 1,
+                    overlay_block_color(span->block_id, alpha));
+  }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// PUBLIC API
+// ═══════════════════════════════════════════════════════════════════════════
+
+void debug_overlay_cycle_mode(const De100Profiler *profiler) {
+  g_debug_overlay_mode =
+      (DebugOverlayMode)((g_debug_overlay_mode + 1) % DEBUG_OVERLAY_MODE_COUNT);
+  printf("[OVERLAY] 📊 %s\n", g_overlay_mode_names[g_debug_overlay_mode]);
+
+  if (g_debug_overlay_mode != DEBUG_OVERLAY_SEMI_TRANSPARENT) {
+    return;
+  }
+
+  if (g_debug_overlay_memory) {
+    memory_stats_print(g_debug_overlay_memory);
+  }
+  if (!profiler) {
+    return;
+  }
+
+  // Just became visible: print what the colors mean
+  for (u32 id = 1; id <= profiler->block_count; ++id) {
+    if (profiler->totals[id - 1].hit_count == 0) {
+      continue;
+    }
+    const De100ProfileBlockInfo *info = &profiler->blocks[id - 1];
+    printf("[OVERLAY]   %-7s %s (%s:%u)\n", overlay_block_palette(id)->name,
+           info->name, info->file, info->line);
+  }
+}
+
+void debug_overlay_render(GameBackBuffer *buffer, GameMemory *memory,
+                          f32 target_seconds_per_frame) {
+  if (g_debug_overlay_mode == DEBUG_OVERLAY_HIDDEN ||
+      buffer->is_rendering_disabled || !buffer->memory.base) {
+    return;
+  }
+
+  u32 alpha =
+      g_debug_overlay_mode == DEBUG_OVERLAY_SEMI_TRANSPARENT ? 160 : 255;
+  i32 width = buffer->width - 2 * OVERLAY_PAD;
+  if (width <= 0) {
+    return;
+  }
+
+  f32 target_ms = target_seconds_per_frame * 1000.0f;
+  if (target_ms <= 0.0f) {
+    target_ms = 1000.0f / 30.0f;
+  }
+
+  // ─────────────────────────────────────────────────────────────────────
+  // Gather sections (sizes first, so the panel hugs the bottom edge)
+  // ─────────────────────────────────────────────────────────────────────
+
+  De100MemoryArena *arenas[OVERLAY_MAX_ARENAS];
+  u32 arena_count = 0;
+  if (memory->work_queue) {
+    De100WorkQueue *queue = memory->work_queue;
+    for (u32 i = 0; i < queue->thread_count; ++i) {
+      if (queue->threads[i].scratch_arena.size > 0) {
+        arenas[arena_count++] = &queue->threads[i].scratch_arena;
+      }
+    }
+  }
+  if (memory->previous_frame_arena) {
+    arenas[arena_count++] = memory->previous_frame_arena; // Last full frame
+  }
+  for (u32 i = 0; i < DE100_DEBUG_MAX_ARENAS; ++i) {
+    De100MemoryArena *arena = memory->debug_arenas[i];
+    if (arena && arena->size > 0) {
+      arenas[arena_count++] = arena;
+    }
+  }
+
+  const De100Profiler *profiler = memory->profiler;
+  u32 lane_depth[DE100_PROFILER_MAX_THREADS] = {0};
+  i32 lanes_height = 0;
+  if (profiler && profiler->frame_cycles > 0) {
+    for (u32 i = 0; i < profiler->span_count; ++i) {
+      const De100ProfileSpan *span = &profiler->spans[i];
+      u32 depth = span->depth + 1u;
+      if (depth > OVERLAY_MAX_LANE_DEPTH) {
+        depth = OVERLAY_MAX_LANE_DEPTH;
+      }
+      if (depth > lane_depth[span->thread_index]) {
+        lane_depth[span->thread_index] = depth;
+      }
+    }
+    for (u32 t = 0; t < DE100_PROFILER_MAX_THREADS; ++t) {
+      if (lane_depth[t] > 0) {
+        lanes_height += (i32)lane_depth[t] * OVERLAY_ROW_HEIGHT + 1;
+      }
+    }
+  }
+
+  i32 arenas_height = (i32)arena_count * (OVERLAY_ARENA_BAR_HEIGHT + 1);
+  i32 audio_height =
+      g_debug_overlay_audio.is_valid ? OVERLAY_AUDIO_BAR_HEIGHT + 1 : 0;
+  const MemoryStats *memory_stats = g_debug_overlay_memory;
+  i32 memory_height =
+      memory_stats ? (i32)(memory_stats->region_count +
+                           memory_stats->pool_count) *
+                         (OVERLAY_ARENA_BAR_HEIGHT + 1)
+                   : 0;
+  i32 latency_height =
+      g_input_latency.stages[overlay_latency_stage()].count > 0
+          ? OVERLAY_LATENCY_BAR_HEIGHT + 1
+          : 0;
+  i32 total_height = OVERLAY_GRAPH_HEIGHT + OVERLAY_GAP + lanes_height +
+                     arenas_height + audio_height + memory_height +
+                     latency_height;
+  i32 top = buffer->height - OVERLAY_PAD - total_height;
+  if (top < OVERLAY_PAD) {
+    top = OVERLAY_PAD; // Tiny window: clip at the bottom instead
+  }
+
+  // ─────────────────────────────────────────────────────────────────────
+  // Record and execute
+  // ─────────────────────────────────────────────────────────────────────
+
+  De100RenderGroup group = {
+      .commands = g_overlay_commands,
+      .command_count = 0,
+      .max_command_count = OVERLAY_MAX_COMMANDS,
+  };
+
+  de100_push_rect(&group, OVERLAY_PAD - 2, top - 2, width + 4,
+                  total_height + 4, DE100_RGBA(0, 0, 0, alpha * 3 / 4));
+  overlay_frame_graph(&group, OVERLAY_PAD, top, width, target_ms, alpha);
+
+  // Arenas are recorded before the timeline so spans can use up the rest
+  // of the command buffer
+  i32 y = top + OVERLAY_GRAPH_HEIGHT + OVERLAY_GAP;
+  overlay_arena_bars(&group, arenas, arena_count, OVERLAY_PAD,
+                     y + lanes_height, width, alpha);
+  if (audio_height > 0) {
+    overlay_audio_bar(&group, &g_debug_overlay_audio, OVERLAY_PAD,
+                      y + lanes_height + arenas_height, width, alpha);
+  }
+  if (memory_height > 0) {
+    overlay_memory_bars(&group, memory_stats, OVERLAY_PAD,
+                        y + lanes_height + arenas_height + audio_height,
+                        width, alpha);
+  }
+  if (latency_height > 0) {
+    overlay_latency_bar(&group, OVERLAY_PAD,
+                        y + lanes_height + arenas_height + audio_height +
+                            memory_height,
+                        width, alpha);
+  }
+  if (lanes_height > 0) {
+    overlay_timeline(&group, profiler, lane_depth, OVERLAY_PAD, y, width,
+                     alpha);
+  }
+
+  de100_render_group_to_output(&group, buffer);
+}
+
+#endif // DE100_INTERNAL
@@ -0,0 +1,90 @@
+#ifndef DE100_PLATFORMS__COMMON_DEBUG_OVERLAY_H
+#define DE100_PLATFORMS__COMMON_DEBUG_OVERLAY_H
+
+#include "../../_common/base.h"
+#include "../../game/backbuffer.h"
+#include "../../game/memory.h"
+#include "./memory-stats.h"
+
+// ═══════════════════════════════════════════════════════════════════════════
+// DEBUG OVERLAY (internal builds)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// Drawn by the platform into the backbuffer after update_and_render, through
+// a render group, so it works on every backend that presents a backbuffer:
+//
+//   ┌──────────────────────────────────────────────────────────┐
+//   │ ▂▂▃▂▂▂█▂▂▂▂▂▃▂▂ ─ ─ ─ target   frame time graph (history) │
+//   │ ████████████ ██████  ███       profiler timeline, one     │
+//   │   ████  ███   ██                lane per thread, nested   │
+//   │ ██████░░░░░░░░░░░░░░░░░░░░░░░   arena usage (used / peak) │
+//   │ ███▒▒▒▒▒▒▒▒▒░░░░░░░░░░░░░░░░░   memory regions, pools      │
+//   │ ██████▒▒▒|░░░░░░░░░│░░░░░░░░░   input latency              │
+//   └──────────────────────────────────────────────────────────┘
+//
+// The timeline spans the previous frame (the profiler aggregates at frame
+// end). Blocks keep a stable color; the legend is printed to stdout each
+// time the overlay is shown, since the engine has no font.
+//
+// Arenas: the work queue's per-thread scratch arenas, plus whatever the game
+// publishes in GameMemory.debug_arenas.
+//
+// Audio: backends with an adaptive latency controller publish it in
+// g_debug_overlay_audio; drawn as one bar on a 0-100ms scale (write-ahead,
+// write interval, jitter band; red after an underrun).
+//
+// Memory: the engine publishes its telemetry snapshot in
+// g_debug_overlay_memory (see memory-stats.h). One bar per OS region
+// (committed over reserved, scaled to the largest reservation) and per
+// published pool (live / capacity, red when full); the full table is
+// printed to stdout when the overlay is shown.
+//
+// Input latency: input-latency.h's input-to-present distribution (to
+// upload when the presenter can't report flips), 0-100ms: p50 solid, p95
+// dim, newest frame as a white tick, input-to-audio p50 as a green tick.
+//
+// Toggle: DEBUG_OVERLAY_KEY cycles hidden → semi-transparent → opaque.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define DEBUG_OVERLAY_KEY_NAME "F3"
+
+typedef enum {
+  DEBUG_OVERLAY_HIDDEN = 0,
+  DEBUG_OVERLAY_SEMI_TRANSPARENT,
+  DEBUG_OVERLAY_OPAQUE,
+
+  DEBUG_OVERLAY_MODE_COUNT
+} DebugOverlayMode;
+
+extern DebugOverlayMode g_debug_overlay_mode;
+
+#define DEBUG_OVERLAY_AUDIO_SCALE_MS 100.0f
+#define DEBUG_OVERLAY_LATENCY_SCALE_MS 100.0f
+
+typedef struct {
+  bool32 is_valid;
+  f32 latency_ms;  // Current write-ahead target
+  f32 interval_ms; // Mean time between audio writes
+  f32 jitter_ms;
+  bool32 recent_underrun;
+} DebugOverlayAudio;
+
+extern DebugOverlayAudio g_debug_overlay_audio;
+
+extern const MemoryStats *g_debug_overlay_memory;
+
+/**
+ * Next mode; prints the block color legend and the memory table when it
+ * becomes visible.
+ */
+void debug_overlay_cycle_mode(const De100Profiler *profiler);
+
+/**
+ * Draw the overlay (no-op when hidden or while rendering is disabled).
+ * Call after update_and_render, before presenting.
+ */
+void debug_overlay_render(GameBackBuffer *buffer, GameMemory *memory,
+                          f32 target_seconds_per_frame);
+
+#endif // DE100_PLATFORMS__COMMON_DEBUG_OVERLAY_H
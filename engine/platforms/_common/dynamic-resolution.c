@@ -0,0 +1,167 @@
+#include "dynamic-resolution.h"
+
+#include <math.h>
+#include <stdio.h>
+
+DynamicResolution g_dynamic_resolution = {0};
+
+de100_file_scoped_fn inline void dynamic_resolution_pick_size(f32 scale) {
+  DynamicResolution *dynamic = &g_dynamic_resolution;
+  if (scale < dynamic->min_scale) {
+    scale = dynamic->min_scale;
+  }
+  if (scale >= 1.0f) {
+    dynamic->scale = 1.0f;
+    dynamic->width = dynamic->max_width;
+    dynamic->height = dynamic->max_height;
+    return;
+  }
+
+  i32 width = (i32)((f32)dynamic->max_width * scale /
+                        DYNAMIC_RESOLUTION_WIDTH_ALIGN +
+                    0.5f) *
+              DYNAMIC_RESOLUTION_WIDTH_ALIGN;
+  if (width < dynamic->min_width) {
+    width = dynamic->min_width;
+  }
+  if (width > dynamic->max_width) {
+    width = dynamic->max_width;
+  }
+  i32 height = (i32)((f32)dynamic->max_height * (f32)width /
+                         (f32)dynamic->max_width +
+                     0.5f);
+
+  dynamic->scale = scale;
+  dynamic->width = width;
+  dynamic->height = height > 0 ? height : 1;
+}
+
+void dynamic_resolution_init(GameConfig *game_config,
+                             const GameBackBuffer *backbuffer) {
+  g_dynamic_resolution = (DynamicResolution){0};
+  if (!game_config->prefer_dynamic_resolution || backbuffer->width <= 0 ||
+      backbuffer->height <= 0) {
+    return;
+  }
+
+  DynamicResolution *dynamic = &g_dynamic_resolution;
+  dynamic->max_width = backbuffer->width;
+  dynamic->max_height = backbuffer->height;
+
+  i32 min_width = (i32)game_config->dynamic_resolution_min_width;
+  i32 min_height = (i32)game_config->dynamic_resolution_min_height;
+  if (min_width <= 0 || min_width > dynamic->max_width) {
+    min_width = dynamic->max_width / 2;
+  }
+  if (min_height <= 0 || min_height > dynamic->max_height) {
+    min_height = dynamic->max_height / 2;
+  }
+  dynamic->min_scale =
+      fmaxf((f32)min_width / (f32)dynamic->max_width,
+            (f32)min_height / (f32)dynamic->max_height);
+  dynamic->min_width =
+      (i32)((f32)dynamic->max_width * dynamic->min_scale + 0.5f);
+  if (dynamic->min_width < 1) {
+    dynamic->min_width = 1;
+  }
+
+  dynamic_resolution_pick_size(1.0f);
+  dynamic->is_active = true;
+
+  // A shrunk frame has to be stretched back over the full-size rect
+  game_config->prefer_scaled_present = true;
+
+  printf("📐 Dynamic resolution: %dx%d down to %dx%d\n", dynamic->max_width,
+         dynamic->max_height, dynamic->min_width,
+         (i32)((f32)dynamic->max_height * dynamic->min_scale + 0.5f));
+}
+
+void dynamic_resolution_update(const GameConfig *game_config,
+                               f32 frame_time_ms, f32 work_time_ms) {
+  DynamicResolution *dynamic = &g_dynamic_resolution;
+  if (!dynamic->is_active || game_config->target_seconds_per_frame <= 0.0f) {
+    return;
+  }
+
+  if (!dynamic->has_samples) {
+    dynamic->work_ms = work_time_ms;
+    dynamic->has_samples = true;
+  } else {
+    dynamic->work_ms += (work_time_ms - dynamic->work_ms) *
+                        DYNAMIC_RESOLUTION_EWMA_ALPHA;
+  }
+
+  f32 budget_ms = game_config->target_seconds_per_frame * 1000.0f;
+  f32 frame_seconds = frame_time_ms / 1000.0f;
+  f32 load = dynamic->work_ms / budget_ms;
+
+  bool over = load > DYNAMIC_RESOLUTION_DOWN_FRACTION &&
+              dynamic->scale > dynamic->min_scale;
+  bool under = load < DYNAMIC_RESOLUTION_UP_FRACTION && dynamic->scale < 1.0f;
+  dynamic->down_seconds = over ? dynamic->down_seconds + frame_seconds : 0.0f;
+  dynamic->up_seconds = under ? dynamic->up_seconds + frame_seconds : 0.0f;
+
+  // Work ~ pixels ~ scale²: the scale that would put it at the target
+  f32 predicted = dynamic->scale * sqrtf(DYNAMIC_RESOLUTION_TARGET_FRACTION /
+                                         fmaxf(load, 0.01f));
+
+  f32 scale = dynamic->scale;
+  if (dynamic->down_seconds >= DYNAMIC_RESOLUTION_DOWN_HOLD_SECONDS) {
+    scale = fmaxf(predicted, dynamic->scale * DYNAMIC_RESOLUTION_MAX_STEP_DOWN);
+  } else if (dynamic->up_seconds >= DYNAMIC_RESOLUTION_UP_HOLD_SECONDS) {
+    scale = fminf(predicted, dynamic->scale * DYNAMIC_RESOLUTION_STEP_UP);
+  } else {
+    return;
+  }
+
+  i32 old_width = dynamic->width;
+  i32 old_height = dynamic->height;
+  dynamic_resolution_pick_size(scale);
+
+  // The new size's frames are the only useful samples
+  dynamic->has_samples = false;
+  dynamic->down_seconds = 0.0f;
+  dynamic->up_seconds = 0.0f;
+
+#if DE100_INTERNAL
+  if (dynamic->width != old_width) {
+    printf("📐 DYNAMIC RES: %dx%d → %dx%d (work %.2fms of %.2fms)\n",
+           old_width, old_height, dynamic->width, dynamic->height,
+           dynamic->work_ms, budget_ms);
+  }
+#else
+  (void)old_width;
+  (void)old_height;
+#endif
+}
+
+bool dynamic_resolution_apply(GameBackBuffer *backbuffer) {
+  DynamicResolution *dynamic = &g_dynamic_resolution;
+  if (!dynamic->is_active || (backbuffer->width == dynamic->width &&
+                              backbuffer->height == dynamic->height)) {
+    return false;
+  }
+
+  // Never past the initial size, which the backbuffer reservation covers
+  backbuffer->width = dynamic->width;
+  backbuffer->height = dynamic->height;
+  backbuffer->pitch = dynamic->width * backbuffer->bytes_per_pixel;
+  de100_backbuffer_mark_all_dirty(backbuffer);
+  return true;
+}
+
+void dynamic_resolution_layout_size(i32 *width, i32 *height) {
+  if (g_dynamic_resolution.is_active) {
+    *width = g_dynamic_resolution.max_width;
+    *height = g_dynamic_resolution.max_height;
+  }
+}
+
+bool dynamic_resolution_can_shrink(void) {
+  return g_dynamic_resolution.is_active &&
+         g_dynamic_resolution.scale > g_dynamic_resolution.min_scale;
+}
+
+bool dynamic_resolution_is_full(void) {
+  return !g_dynamic_resolution.is_active || g_dynamic_resolution.scale >= 1.0f;
+}
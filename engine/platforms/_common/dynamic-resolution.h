@@ -0,0 +1,112 @@
+#ifndef DE100_PLATFORMS__COMMON_DYNAMIC_RESOLUTION_H
+#define DE100_PLATFORMS__COMMON_DYNAMIC_RESOLUTION_H
+
+#include "../../_common/base.h"
+#include "../../game/backbuffer.h"
+#include "../../game/config.h"
+
+// ═══════════════════════════════════════════════════════════════════════════
+// 📐 DYNAMIC RESOLUTION GOVERNOR (GameConfig.prefer_dynamic_resolution)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// Software rendering is fill-bound: a frame that misses its budget usually
+// misses it by pixels. Instead of dropping a frame rate tier (see
+// adaptive-fps.h), shrink the backbuffer the game renders into and let the
+// scaled presenter stretch it over the same screen rect:
+//
+//   full 1280×720 ──over budget──▶ 1088×612 ──▶ 928×522 ... min bounds
+//                ◀──headroom────── (one step at a time, slower)
+//
+// SIGNAL: EWMA of the frame's work time against the target frame time.
+//
+//   down  work > 90% of the budget (held 0.25s): scale so the predicted
+//         work lands at 80%, assuming work follows the pixel count
+//         (at most DYNAMIC_RESOLUTION_MAX_STEP_DOWN per axis at once)
+//   up    work < 65% of the budget (held 1s): one
+//         DYNAMIC_RESOLUTION_STEP_UP per axis, never past the predicted 80%
+//
+// Bounds: the initial backbuffer size is the maximum, and the game
+// declares the minimum (dynamic_resolution_min_width/height, default
+// half). Widths are multiples of 8 and the aspect ratio is kept. The game
+// must draw from backbuffer->width/height every frame; mouse positions
+// come in the current backbuffer's pixels.
+//
+// With prefer_adaptive_fps too, resolution goes first: the frame rate only
+// drops once the backbuffer is at its minimum, and only climbs back once
+// it is full size again.
+//
+// Changes are applied (dynamic_resolution_apply) right after the present,
+// when no tile is being rasterized and the frame on screen is done with,
+// so the next frame is the first one at the new size.
+//
+// X11 and raylib only: Wayland and DRM present without scaling.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define DYNAMIC_RESOLUTION_EWMA_ALPHA 0.1f
+#define DYNAMIC_RESOLUTION_TARGET_FRACTION 0.80f
+#define DYNAMIC_RESOLUTION_DOWN_FRACTION 0.90f
+#define DYNAMIC_RESOLUTION_DOWN_HOLD_SECONDS 0.25f
+#define DYNAMIC_RESOLUTION_UP_FRACTION 0.65f
+#define DYNAMIC_RESOLUTION_UP_HOLD_SECONDS 1.0f
+#define DYNAMIC_RESOLUTION_MAX_STEP_DOWN 0.75f // Per axis
+#define DYNAMIC_RESOLUTION_STEP_UP 1.10f       // Per axis
+#define DYNAMIC_RESOLUTION_WIDTH_ALIGN 8
+
+typedef struct {
+  bool32 is_active;
+
+  // Bounds (backbuffer pixels)
+  i32 max_width;
+  i32 max_height;
+  i32 min_width;
+
+  // Per axis, 1 = full size
+  f32 scale;
+  f32 min_scale;
+  i32 width; // What `scale` rounds to; applied after the next present
+  i32 height;
+
+  // EWMA work time (ms) and hysteresis timers
+  f32 work_ms;
+  bool32 has_samples;
+  f32 down_seconds;
+  f32 up_seconds;
+} DynamicResolution;
+extern DynamicResolution g_dynamic_resolution;
+
+/**
+ * Take `backbuffer`'s current size as the maximum. No-op unless
+ * config->prefer_dynamic_resolution; turns on prefer_scaled_present.
+ */
+void dynamic_resolution_init(GameConfig *game_config,
+                             const GameBackBuffer *backbuffer);
+
+/**
+ * Feed one finished frame (same arguments as adaptive_fps_update). Picks
+ * the next size; dynamic_resolution_apply resizes.
+ */
+void dynamic_resolution_update(const GameConfig *game_config,
+                               f32 frame_time_ms, f32 work_time_ms);
+
+/**
+ * Resize `backbuffer` to the picked size (width, height, pitch; the whole
+ * frame is dirty). Call after the present.
+ *
+ * @return true if the size changed (backends recreate textures)
+ */
+bool dynamic_resolution_apply(GameBackBuffer *backbuffer);
+
+/**
+ * The size the present lays out: the full-size backbuffer's, so a shrunk
+ * frame covers the same screen rect. Unchanged when inactive.
+ */
+void dynamic_resolution_layout_size(i32 *width, i32 *height);
+
+/** There is still room to shrink (inactive: false). */
+bool dynamic_resolution_can_shrink(void);
+
+/** Rendering at full size (inactive: true). */
+bool dynamic_resolution_is_full(void);
+
+#endif // DE100_PLATFORMS__COMMON_DYNAMIC_RESOLUTION_H
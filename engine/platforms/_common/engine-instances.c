@@ -0,0 +1,313 @@
+#include "./engine-instances.h"
+
+#include "../../game/game-loader.h"
+
+#include <string.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ERROR MESSAGES
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_global_var const char *g_engine_instances_error_messages[] = {
+    [ENGINE_INSTANCES_SUCCESS] = "Success",
+    [ENGINE_INSTANCES_ERROR_BAD_COUNT] = "Instance count out of range",
+    [ENGINE_INSTANCES_ERROR_HOST_NOT_READY] =
+        "Host engine has no game code or game memory",
+    [ENGINE_INSTANCES_ERROR_ALLOC_FAILED] = "Failed to allocate instance memory",
+};
+
+const char *engine_instances_strerror(EngineInstancesErrorCode code) {
+  if (code >= 0 && code < ENGINE_INSTANCES_ERROR_COUNT) {
+    return g_engine_instances_error_messages[code];
+  }
+  return "Unknown engine instances error";
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// LIFECYCLE
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn void engine_instance_free(EngineInstance *instance) {
+  if (de100_memory_is_valid(instance->game.backbuffer.memory)) {
+    de100_memory_free(&instance->game.backbuffer.memory);
+  }
+  if (de100_memory_is_valid(instance->audio_samples)) {
+    de100_memory_free(&instance->audio_samples);
+  }
+  if (de100_memory_is_valid(instance->game_state)) {
+    de100_memory_free(&instance->game_state);
+  }
+}
+
+/**
+ * Own memory, backbuffer and audio buffer, sized like the host's; the
+ * services in GameMemory are the host's.
+ */
+de100_file_scoped_fn bool engine_instance_alloc(EngineInstance *instance,
+                                                const EngineState *host,
+                                                u32 index) {
+  const EngineGameState *host_game = &host->game;
+  EngineGameState *game = &instance->game;
+
+  game->config = host_game->config;
+  game->kernels = host_game->kernels;
+  game->thread_context = host_game->thread_context;
+  game->inputs = &instance->inputs[0];
+  instance->old_inputs = &instance->inputs[1];
+  instance->index = index;
+
+  // Same split as the host: permanent storage already page-rounded there
+  u64 permanent_size = host_game->config.permanent_storage_size;
+  u64 total_size = permanent_size + host_game->config.transient_storage_size;
+  De100MemoryFlags flags = De100_MEMORY_FLAG_RW_ZEROED;
+  if (host_game->config.prefault_game_memory) {
+    flags |= De100_MEMORY_FLAG_PREFAULT;
+  }
+  instance->game_state = de100_memory_alloc(NULL, total_size, flags);
+  if (!de100_memory_is_valid(instance->game_state)) {
+    return false;
+  }
+
+  // Services (work queue, async I/O, modules, kernels...) from the host;
+  // storage, frame arenas and per-game bookkeeping are this instance's
+  game->memory = host_game->memory;
+  game->memory.kernels = &game->kernels;
+  game->memory.permanent_storage = instance->game_state.base;
+  game->memory.transient_storage =
+      (u8 *)instance->game_state.base + permanent_size;
+  game->memory.permanent_storage_size = permanent_size;
+  game->memory.transient_storage_size =
+      host_game->config.transient_storage_size;
+  game->memory.transient_commit = NULL;
+  game->memory.is_initialized = false;
+  game->memory.render_group = NULL;
+  memset(game->memory.debug_arenas, 0, sizeof(game->memory.debug_arenas));
+  memset(game->memory.debug_pools, 0, sizeof(game->memory.debug_pools));
+  game->memory.time_scale = 0.0f;
+  game->memory.effective_time_scale = 1.0f;
+  engine_carve_frame_arenas(game);
+
+  int width = host_game->config.window_width;
+  int height = host_game->config.window_height;
+  game->backbuffer.memory = de100_memory_alloc(
+      NULL, (size_t)width * (size_t)height * 4, De100_MEMORY_FLAG_RW_ZEROED);
+  if (!de100_memory_is_valid(game->backbuffer.memory)) {
+    return false;
+  }
+  game->backbuffer.width = width;
+  game->backbuffer.height = height;
+  game->backbuffer.pitch = width * 4;
+  game->backbuffer.bytes_per_pixel = 4;
+  game->backbuffer.pixel_format = DE100_PIXEL_FORMAT;
+  // Composited whole; nothing reads its dirty rects
+  game->backbuffer.dirty.is_tracking = false;
+
+  i32 max_sample_count = host_game->audio.max_sample_count;
+  instance->audio_samples =
+      de100_memory_alloc(NULL, (size_t)max_sample_count * sizeof(i16) * 2,
+                         De100_MEMORY_FLAG_RW_ZEROED);
+  if (!de100_memory_is_valid(instance->audio_samples)) {
+    return false;
+  }
+  game->audio.samples_per_second = host_game->audio.samples_per_second;
+  game->audio.max_sample_count = max_sample_count;
+  game->audio.samples = instance->audio_samples.base;
+  game->audio.is_initialized = true; // Mixed into the host's device
+
+  instance->timestep = (FixedTimestep){0};
+  return true;
+}
+
+EngineInstancesResult engine_instances_init(EngineInstanceSet *set,
+                                            EngineState *host, u32 count) {
+  EngineInstancesResult result = {0};
+  *set = (EngineInstanceSet){0};
+
+  if (count == 0 || count > ENGINE_MAX_INSTANCES) {
+    result.error_code = ENGINE_INSTANCES_ERROR_BAD_COUNT;
+    return result;
+  }
+  if (!engine_is_valid(host)) {
+    result.error_code = ENGINE_INSTANCES_ERROR_HOST_NOT_READY;
+    return result;
+  }
+
+  set->storage = de100_memory_alloc(NULL, count * sizeof(EngineInstance),
+                                    De100_MEMORY_FLAG_RW_ZEROED);
+  if (!de100_memory_is_valid(set->storage)) {
+    result.error_code = ENGINE_INSTANCES_ERROR_ALLOC_FAILED;
+    return result;
+  }
+  set->host = host;
+  set->instances = (EngineInstance *)set->storage.base;
+
+  for (u32 i = 0; i < count; ++i) {
+    EngineInstance *instance = &set->instances[i];
+    if (!engine_instance_alloc(instance, host, i)) {
+      engine_instance_free(instance);
+      engine_instances_shutdown(set);
+      result.error_code = ENGINE_INSTANCES_ERROR_ALLOC_FAILED;
+      return result;
+    }
+    set->count = i + 1;
+
+    DE100_GAME_CALL(&host->platform.game_bootstrap_code, init)(
+        &instance->game.thread_context, &instance->game.memory,
+        instance->game.inputs, &instance->game.backbuffer);
+  }
+
+  result.success = true;
+  result.error_code = ENGINE_INSTANCES_SUCCESS;
+  return result;
+}
+
+void engine_instances_shutdown(EngineInstanceSet *set) {
+  for (u32 i = 0; i < set->count; ++i) {
+    engine_instance_free(&set->instances[i]);
+  }
+  if (de100_memory_is_valid(set->storage)) {
+    de100_memory_free(&set->storage);
+  }
+  *set = (EngineInstanceSet){0};
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// FRAME
+// ═══════════════════════════════════════════════════════════════════════════
+
+void engine_instances_run_frame(EngineInstanceSet *set, f32 frame_seconds) {
+  if (set->count == 0) {
+    return;
+  }
+  GameMainCode *code = &set->host->platform.game_main_code;
+  FixedTimestep host_timestep = g_fixed_timestep;
+
+  for (u32 i = 0; i < set->count; ++i) {
+    EngineInstance *instance = &set->instances[i];
+    // The clock is the instance's; how the backend runs clocks is the
+    // host's
+    instance->timestep.forced_time_scale = host_timestep.forced_time_scale;
+    instance->timestep.ignore_tick_budget = host_timestep.ignore_tick_budget;
+    instance->timestep.throttled_seconds_per_frame =
+        host_timestep.throttled_seconds_per_frame;
+
+    // Modules can be reloaded between frames: refresh the host's table
+    memcpy(instance->game.memory.modules, set->host->game.memory.modules,
+           sizeof(instance->game.memory.modules));
+
+    g_fixed_timestep = instance->timestep;
+    fixed_timestep_run_frame(&instance->game, code, frame_seconds);
+    instance->timestep = g_fixed_timestep;
+  }
+
+  g_fixed_timestep = host_timestep;
+}
+
+void engine_instances_mix_audio(EngineInstanceSet *set,
+                                GameAudioOutputBuffer *output) {
+  i32 sample_count = output->sample_count;
+  if (sample_count <= 0) {
+    return;
+  }
+  GameMainCode *code = &set->host->platform.game_main_code;
+  i16 *mix = (i16 *)output->samples;
+
+  for (u32 i = 0; i < set->count; ++i) {
+    GameAudioOutputBuffer *audio = &set->instances[i].game.audio;
+    i32 count = sample_count < audio->max_sample_count
+                    ? sample_count
+                    : audio->max_sample_count;
+    audio->sample_count = count;
+    DE100_GAME_CALL(code, get_audio_samples)(&set->instances[i].game.memory,
+                                             audio);
+    audio->running_sample_index += (u64)count;
+
+    // Both channels, interleaved: one flat loop the compiler vectorizes
+    // into saturating adds
+    const i16 *source = (const i16 *)audio->samples;
+    for (i32 s = 0; s < count * 2; ++s) {
+      i32 sum = (i32)mix[s] + (i32)source[s];
+      sum = sum > 32767 ? 32767 : sum;
+      sum = sum < -32768 ? -32768 : sum;
+      mix[s] = (i16)sum;
+    }
+  }
+}
+
+void engine_instances_swap_inputs(EngineInstanceSet *set) {
+  for (u32 i = 0; i < set->count; ++i) {
+    EngineInstance *instance = &set->instances[i];
+    GameInput *temp = instance->game.inputs;
+    instance->game.inputs = instance->old_inputs;
+    instance->old_inputs = temp;
+    engine_rotate_frame_arenas(&instance->game.memory);
+  }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// VIEWPORTS
+// ═══════════════════════════════════════════════════════════════════════════
+
+void engine_instances_tile(EngineInstanceSet *set, i32 x, i32 y, i32 width,
+                           i32 height) {
+  if (set->count == 0) {
+    return;
+  }
+  u32 columns = 1;
+  while (columns * columns < set->count) {
+    columns++;
+  }
+  u32 rows = (set->count + columns - 1) / columns;
+
+  for (u32 i = 0; i < set->count; ++i) {
+    i32 column = (i32)(i % columns);
+    i32 row = (i32)(i / columns);
+    // Edges from the running fraction: the tiles cover the rect exactly
+    set->instances[i].viewport = (De100RenderClipRect){
+        x + column * width / (i32)columns,
+        y + row * height / (i32)rows,
+        x + (column + 1) * width / (i32)columns,
+        y + (row + 1) * height / (i32)rows,
+    };
+  }
+}
+
+void engine_instances_composite(EngineInstanceSet *set,
+                                GameBackBuffer *target) {
+  for (u32 i = 0; i < set->count; ++i) {
+    const GameBackBuffer *source = &set->instances[i].game.backbuffer;
+    De100RenderClipRect view = set->instances[i].viewport;
+    i32 view_width = view.max_x - view.min_x;
+    i32 view_height = view.max_y - view.min_y;
+    if (view_width <= 0 || view_height <= 0) {
+      continue;
+    }
+
+    // 16.16 steps through the source; clipping moves the start, not the
+    // step
+    u32 step_x = (u32)(((u64)source->width << 16) / (u64)view_width);
+    u32 step_y = (u32)(((u64)source->height << 16) / (u64)view_height);
+    i32 min_x = view.min_x > 0 ? view.min_x : 0;
+    i32 min_y = view.min_y > 0 ? view.min_y : 0;
+    i32 max_x = view.max_x < target->width ? view.max_x : target->width;
+    i32 max_y = view.max_y < target->height ? view.max_y : target->height;
+    if (min_x >= max_x || min_y >= max_y) {
+      continue;
+    }
+
+    u32 source_y = (u32)(min_y - view.min_y) * step_y;
+    for (i32 y = min_y; y < max_y; ++y, source_y += step_y) {
+      const u32 *source_row =
+          (const u32 *)((const u8 *)source->memory.base +
+                        (size_t)(source_y >> 16) * (size_t)source->pitch);
+      u32 *row = (u32 *)((u8 *)target->memory.base +
+                         (size_t)y * (size_t)target->pitch);
+      u32 source_x = (u32)(min_x - view.min_x) * step_x;
+      for (i32 x = min_x; x < max_x; ++x, source_x += step_x) {
+        row[x] = source_row[source_x >> 16];
+      }
+    }
+    de100_backbuffer_mark_dirty(target, min_x, min_y, max_x - min_x,
+                                max_y - min_y);
+  }
+}
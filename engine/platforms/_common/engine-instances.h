@@ -0,0 +1,143 @@
+#ifndef DE100_PLATFORMS__COMMON_ENGINE_INSTANCES_H
+#define DE100_PLATFORMS__COMMON_ENGINE_INSTANCES_H
+
+#include "../../_common/base.h"
+#include "../../_common/memory.h"
+#include "../../engine.h"
+#include "./fixed-timestep.h"
+
+#include <stdbool.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// 🧩 ENGINE INSTANCES (several games in one process)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// N more sessions of the host's game, run by the host engine next to its
+// own. Everything that costs startup time or threads is the host's and
+// shared:
+//
+//   shared (host)                      per instance
+//   ───────────────────────────────    ────────────────────────────────
+//   game library + code modules        permanent + transient storage
+//   worker pool, thread context        frame arenas
+//   async I/O, background loader       backbuffer
+//   kernels, profiler                  audio buffer (mixed into host's)
+//   replay / netplay / capture         inputs, fixed-timestep clock
+//
+// Sixteen bots for training, or a split-screen of independent matches,
+// then cost sixteen game memories instead of sixteen engines: no extra
+// threads, one dlopen, one audio device.
+//
+//   EngineInstanceSet set;
+//   engine_instances_init(&set, &engine, 3);   // after the host's game init
+//   engine_instances_tile(&set, 0, 0, width, height);
+//   // each frame, after the host's update:
+//   for (u32 i = 0; i < set.count; ++i) {
+//     *set.instances[i].game.inputs = bot_input(i);
+//   }
+//   engine_instances_run_frame(&set, seconds_per_frame);
+//   engine_instances_mix_audio(&set, &engine.game.audio); // after host's
+//   engine_instances_composite(&set, &engine.game.backbuffer);
+//   engine_instances_swap_inputs(&set);
+//
+// The game must keep its state in GameMemory: globals in the game library
+// (and local_persist_var) are one copy shared by every instance. Each
+// instance gets its own copy of FixedTimestep, swapped into
+// g_fixed_timestep around its frame; the backend-level globals (render
+// pipeline, frame timing, replay) stay the host's, so instances run
+// update_and_render (or update + render) directly, never pipelined, and
+// are never recorded. Transient storage is committed up front (no lazy
+// commit) and on 4 KB pages.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define ENGINE_MAX_INSTANCES 64
+
+typedef enum {
+  ENGINE_INSTANCES_SUCCESS = 0,
+  ENGINE_INSTANCES_ERROR_BAD_COUNT,
+  ENGINE_INSTANCES_ERROR_HOST_NOT_READY,
+  ENGINE_INSTANCES_ERROR_ALLOC_FAILED,
+  ENGINE_INSTANCES_ERROR_COUNT
+} EngineInstancesErrorCode;
+
+typedef struct {
+  bool success;
+  EngineInstancesErrorCode error_code;
+} EngineInstancesResult;
+
+typedef struct {
+  // Passed to the game like the host's EngineGameState; memory points at
+  // the host's services
+  EngineGameState game;
+  GameInput inputs[2];
+  GameInput *old_inputs;
+  FixedTimestep timestep; // In g_fixed_timestep only during its frame
+
+  // Where engine_instances_composite() draws this instance's backbuffer
+  De100RenderClipRect viewport;
+  u32 index;
+
+  De100MemoryBlock game_state; // Permanent + transient
+  De100MemoryBlock audio_samples;
+} EngineInstance;
+
+typedef struct {
+  EngineState *host;
+  EngineInstance *instances;
+  u32 count;
+  De100MemoryBlock storage; // The EngineInstance array
+} EngineInstanceSet;
+
+/**
+ * Allocate `count` instances of the host's game (its GameConfig sizes)
+ * and call the game's init on each. The host must be initialized
+ * (engine_init) and outlive the set.
+ *
+ * @return ENGINE_INSTANCES_ERROR_BAD_COUNT for 0 or more than
+ *         ENGINE_MAX_INSTANCES; nothing stays allocated on failure
+ */
+EngineInstancesResult engine_instances_init(EngineInstanceSet *set,
+                                            EngineState *host, u32 count);
+
+/** Free every instance's memory. The host is untouched. */
+void engine_instances_shutdown(EngineInstanceSet *set);
+
+/**
+ * Run one frame of game code in every instance, in order, for
+ * `frame_seconds` of elapsed time (fixed-timestep ticks + render, or one
+ * update_and_render). Fill each instance's game.inputs first.
+ */
+void engine_instances_run_frame(EngineInstanceSet *set, f32 frame_seconds);
+
+/**
+ * Have every instance produce output->sample_count samples and add them,
+ * saturating, onto output's (the host's own, already written). Instances
+ * advance their own running_sample_index.
+ */
+void engine_instances_mix_audio(EngineInstanceSet *set,
+                                GameAudioOutputBuffer *output);
+
+/**
+ * Lay the instances' viewports out as a near-square grid over the
+ * (x, y, width, height) rect of the host's backbuffer, in index order.
+ */
+void engine_instances_tile(EngineInstanceSet *set, i32 x, i32 y, i32 width,
+                           i32 height);
+
+/**
+ * Copy each instance's backbuffer, scaled (nearest) to its viewport, into
+ * `target`, and mark those rects dirty. Empty viewports are skipped.
+ */
+void engine_instances_composite(EngineInstanceSet *set,
+                                GameBackBuffer *target);
+
+/**
+ * End of frame for every instance, like engine_swap_inputs(): swap the
+ * input buffers and rotate the frame arenas.
+ */
+void engine_instances_swap_inputs(EngineInstanceSet *set);
+
+const char *engine_instances_strerror(EngineInstancesErrorCode code);
+
+#endif // DE100_PLATFORMS__COMMON_ENGINE_INSTANCES_H
@@ -0,0 +1,161 @@
+#ifndef DE100_PLATFORMS__COMMON_FIXED_STEP_H
+#define DE100_PLATFORMS__COMMON_FIXED_STEP_H
+
+#include "../../_common/base.h"
+
+#include <math.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ⏱️ FIXED-STEP ARITHMETIC (the tick cap, the drop and the smoothing)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// The rules fixed-timestep.h describes — fast-forward scales the tick cap,
+// the tick budget holds it to what the CPU sustains (never below 1x), time
+// past the cap is dropped, and the achieved speed is smoothed 1/8 per
+// frame — without the engine's game state. fixed_timestep_update builds
+// the engine tick (input slices, game calls) on these helpers.
+//
+// A host that runs its own main loop uses de100_fixed_step_run:
+//
+//   De100FixedStep step;
+//   de100_fixed_step_init(&step, 60, 4, 0.5 / 60.0);
+//   ...
+//   de100_fixed_step_run(&step, frame_seconds, time_scale, tick, &state,
+//                        get_time);                 // every frame
+//   state.effective_time_scale = step.effective_time_scale;
+//   render(&state);                                 // once
+//
+// A NULL clock skips the tick budget, so ticks per frame stay
+// reproducible (the engine's ignore_tick_budget).
+//
+// All functions are static inline for zero overhead if unused.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+// One simulation tick of `dt` seconds
+typedef void De100FixedStepTickFn(void *user, f32 dt);
+
+// Monotonic wall clock in seconds
+typedef f64 De100FixedStepClockFn(void);
+
+typedef struct {
+  f64 dt;                  // Seconds per tick
+  u32 max_ticks;           // Per frame at 1x
+  f64 tick_budget_seconds; // Wall seconds per frame fast-forward may use
+
+  f64 accumulator_seconds;   // Simulated seconds not yet ticked
+  f64 tick_cost_seconds;     // Smoothed wall time of one tick (0 = none yet)
+  f64 smoothed_sim_seconds;  // Per frame, for effective_time_scale
+  f64 smoothed_wall_seconds;
+  f32 effective_time_scale;  // Achieved speed, 1 = real time
+  u32 ticks_last_frame;
+} De100FixedStep;
+
+/**
+ * Tick cap for this frame: `base` (the 1x cap) times `scale`, then, with
+ * a budget and a measured cost, no more than the budget pays for, but
+ * never below what 1x would run this frame.
+ */
+de100_file_scoped_fn inline u32
+de100_fixed_step_max_ticks(u32 base, f32 scale, f64 dt,
+                           f64 accumulator_seconds, f32 frame_seconds,
+                           f64 tick_cost_seconds, f64 tick_budget_seconds) {
+  if (scale <= 1.0f) {
+    return base;
+  }
+
+  u32 max_ticks = (u32)ceilf((f32)base * scale);
+  if (tick_budget_seconds <= 0.0 || tick_cost_seconds <= 0.0) {
+    return max_ticks;
+  }
+
+  f64 affordable = floor(tick_budget_seconds / tick_cost_seconds);
+  // What 1x would run this frame, under 1x's cap
+  f64 normal = floor((accumulator_seconds + (f64)frame_seconds) / dt);
+  normal = normal < (f64)base ? normal : (f64)base;
+  f64 cap = affordable > normal ? affordable : normal;
+  cap = cap > 1.0 ? cap : 1.0;
+  return cap < (f64)max_ticks ? (u32)cap : max_ticks;
+}
+
+/** Over the cap: drop whole ticks, keep the fraction. Returns the drop. */
+de100_file_scoped_fn inline u64
+de100_fixed_step_drop_excess(f64 *accumulator_seconds, f64 dt) {
+  if (*accumulator_seconds < dt) {
+    return 0;
+  }
+  u64 dropped = (u64)(*accumulator_seconds / dt);
+  *accumulator_seconds -= (f64)dropped * dt;
+  return dropped;
+}
+
+/**
+ * 1/8 smoothing after a frame's `ticks`: the cost of one tick (seeded by
+ * the first measurement; skipped when `ticks_wall_seconds` < 0 or no tick
+ * ran) and the simulated vs wall seconds. Returns the achieved speed.
+ */
+de100_file_scoped_fn inline f32
+de100_fixed_step_smooth(f64 *tick_cost_seconds, f64 *smoothed_sim_seconds,
+                        f64 *smoothed_wall_seconds, u32 ticks, f64 dt,
+                        f32 frame_seconds, f64 ticks_wall_seconds) {
+  if (ticks > 0 && ticks_wall_seconds >= 0.0) {
+    f64 cost = ticks_wall_seconds / (f64)ticks;
+    *tick_cost_seconds = *tick_cost_seconds > 0.0
+                             ? *tick_cost_seconds +
+                                   (cost - *tick_cost_seconds) * 0.125
+                             : cost;
+  }
+  *smoothed_sim_seconds +=
+      ((f64)ticks * dt - *smoothed_sim_seconds) * 0.125;
+  *smoothed_wall_seconds +=
+      ((f64)frame_seconds - *smoothed_wall_seconds) * 0.125;
+  return *smoothed_wall_seconds > 0.0
+             ? (f32)(*smoothed_sim_seconds / *smoothed_wall_seconds)
+             : 1.0f;
+}
+
+de100_file_scoped_fn inline void
+de100_fixed_step_init(De100FixedStep *step, u32 hz, u32 max_ticks,
+                      f64 tick_budget_seconds) {
+  *step = (De100FixedStep){
+      .dt = 1.0 / (f64)hz,
+      .max_ticks = max_ticks > 0 ? max_ticks : 1,
+      .tick_budget_seconds = tick_budget_seconds,
+      .effective_time_scale = 1.0f,
+  };
+}
+
+/**
+ * Run this frame's ticks; returns how many ran. `scale` <= 1 is 1x.
+ * `clock` may be NULL (no tick budget).
+ */
+de100_file_scoped_fn inline u32
+de100_fixed_step_run(De100FixedStep *step, f32 frame_seconds, f32 scale,
+                     De100FixedStepTickFn *tick, void *user,
+                     De100FixedStepClockFn *clock) {
+  scale = scale > 1.0f ? scale : 1.0f;
+  f64 dt = step->dt;
+  u32 max_ticks = de100_fixed_step_max_ticks(
+      step->max_ticks, scale, dt, step->accumulator_seconds, frame_seconds,
+      step->tick_cost_seconds, clock ? step->tick_budget_seconds : 0.0);
+
+  step->accumulator_seconds += (f64)frame_seconds * (f64)scale;
+
+  f64 start = clock ? clock() : 0.0;
+  u32 ticks = 0;
+  while (step->accumulator_seconds >= dt && ticks < max_ticks) {
+    tick(user, (f32)dt);
+    step->accumulator_seconds -= dt;
+    ++ticks;
+  }
+  de100_fixed_step_drop_excess(&step->accumulator_seconds, dt);
+
+  step->effective_time_scale = de100_fixed_step_smooth(
+      &step->tick_cost_seconds, &step->smoothed_sim_seconds,
+      &step->smoothed_wall_seconds, ticks, dt, frame_seconds,
+      clock ? clock() - start : -1.0);
+  step->ticks_last_frame = ticks;
+  return ticks;
+}
+
+#endif // DE100_PLATFORMS__COMMON_FIXED_STEP_H
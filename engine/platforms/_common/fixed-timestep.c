@@ -0,0 +1,141 @@
+#include "fixed-timestep.h"
+
+#include "../../_common/time.h"
+
+#include <math.h>
+
+FixedTimestep g_fixed_timestep = {0};
+
+bool fixed_timestep_is_active(const GameConfig *config,
+                              const GameMainCode *code) {
+  return config->fixed_update_hz > 0 && code->functions.update &&
+         code->functions.render;
+}
+
+// Requested speed, >= 1
+de100_file_scoped_fn inline f32
+fixed_timestep_requested_scale(const EngineGameState *game) {
+  f32 scale = g_fixed_timestep.forced_time_scale > 0.0f
+                  ? g_fixed_timestep.forced_time_scale
+                  : game->memory.time_scale;
+  return scale > 1.0f ? scale : 1.0f;
+}
+
+/**
+ * Tick cap for this frame: the configured cap (raised to cover throttled
+ * frames), scaled and budgeted by de100_fixed_step_max_ticks.
+ */
+de100_file_scoped_fn u32 fixed_timestep_max_ticks(const EngineGameState *game,
+                                                  f32 scale, f64 dt,
+                                                  f32 frame_seconds) {
+  u32 base = game->config.max_updates_per_frame
+                 ? game->config.max_updates_per_frame
+                 : 1;
+  if (g_fixed_timestep.throttled_seconds_per_frame > 0.0f) {
+    // One spare tick for the frame that runs late
+    u32 throttled =
+        (u32)ceil((f64)g_fixed_timestep.throttled_seconds_per_frame / dt) + 1;
+    base = throttled > base ? throttled : base;
+  }
+
+  f64 budget = g_fixed_timestep.ignore_tick_budget
+                   ? 0.0
+                   : (f64)game->config.target_seconds_per_frame *
+                         FIXED_TIMESTEP_TICK_BUDGET;
+  return de100_fixed_step_max_ticks(base, scale, dt,
+                                    g_fixed_timestep.accumulator_seconds,
+                                    frame_seconds,
+                                    g_fixed_timestep.tick_cost_seconds,
+                                    budget);
+}
+
+void fixed_timestep_update(EngineGameState *game, GameMainCode *code,
+                           f32 frame_seconds) {
+  f64 dt = 1.0 / (f64)game->config.fixed_update_hz;
+  f32 scale = fixed_timestep_requested_scale(game);
+  u32 max_ticks = fixed_timestep_max_ticks(game, scale, dt, frame_seconds);
+
+  g_fixed_timestep.accumulator_seconds += (f64)frame_seconds * (f64)scale;
+
+  // The ticks simulate the wall time that ends `accumulator` before the
+  // input poll; each gets the queued events that fall inside its slice
+  // (dt / scale of wall time per tick when fast-forwarding)
+  GameInput *input = game->inputs;
+  f64 wall_dt = dt / (f64)scale;
+  f64 poll_seconds = input->tick_end_seconds;
+  f64 tick_start =
+      poll_seconds - g_fixed_timestep.accumulator_seconds / (f64)scale;
+  u32 next_event = 0;
+  f64 ticks_start = de100_get_wall_clock();
+
+  u32 ticks = 0;
+  GameInput held_input;
+  while (g_fixed_timestep.accumulator_seconds >= dt && ticks < max_ticks) {
+    GameInput *tick_input = input;
+    if (ticks == 1) {
+      held_input = *input;
+      de100_input_clear_transitions(&held_input);
+    }
+    if (ticks > 0) {
+      tick_input = &held_input;
+    }
+
+    f64 tick_end = tick_start + wall_dt;
+    tick_input->tick_event_first = next_event;
+    while (next_event < input->event_count &&
+           input->events[next_event].seconds <= tick_end) {
+      ++next_event;
+    }
+    tick_input->tick_event_end = next_event;
+    tick_input->tick_start_seconds = tick_start;
+    tick_input->tick_end_seconds = tick_end;
+
+    DE100_GAME_CALL(code, update)(&game->thread_context, &game->memory,
+                                  tick_input, (f32)dt);
+    g_fixed_timestep.accumulator_seconds -= dt;
+    tick_start = tick_end;
+    ++ticks;
+  }
+
+  // What no tick took carries over to next frame (prepare_input_frame)
+  input->tick_event_first = 0;
+  input->tick_event_end = next_event;
+  input->tick_end_seconds = poll_seconds;
+
+  // Over the cap: drop whole ticks, keep the fraction for alpha. Fast-
+  // forward past the budget is the cap working, not a stall: not counted.
+  u64 dropped =
+      de100_fixed_step_drop_excess(&g_fixed_timestep.accumulator_seconds, dt);
+  if (scale <= 1.0f) {
+    g_fixed_timestep.dropped_ticks += dropped;
+  }
+
+  // Tick cost for the next cap, achieved speed for the game
+  g_fixed_timestep.effective_time_scale = de100_fixed_step_smooth(
+      &g_fixed_timestep.tick_cost_seconds,
+      &g_fixed_timestep.smoothed_sim_seconds,
+      &g_fixed_timestep.smoothed_wall_seconds, ticks, dt, frame_seconds,
+      de100_get_seconds_elapsed(ticks_start, de100_get_wall_clock()));
+  game->memory.effective_time_scale = g_fixed_timestep.effective_time_scale;
+
+  g_fixed_timestep.tick_count += ticks;
+  g_fixed_timestep.ticks_last_frame = ticks;
+  g_fixed_timestep.alpha = (f32)(g_fixed_timestep.accumulator_seconds / dt);
+}
+
+void fixed_timestep_render(EngineGameState *game, GameMainCode *code) {
+  DE100_GAME_CALL(code, render)(&game->thread_context, &game->memory,
+                                &game->backbuffer, g_fixed_timestep.alpha);
+}
+
+void fixed_timestep_run_frame(EngineGameState *game, GameMainCode *code,
+                              f32 frame_seconds) {
+  if (!fixed_timestep_is_active(&game->config, code)) {
+    DE100_GAME_CALL(code, update_and_render)(
+        &game->thread_context, &game->memory, game->inputs, &game->backbuffer);
+    return;
+  }
+
+  fixed_timestep_update(game, code, frame_seconds);
+  fixed_timestep_render(game, code);
+}
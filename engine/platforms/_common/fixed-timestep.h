@@ -0,0 +1,101 @@
+#ifndef DE100_PLATFORMS__COMMON_FIXED_TIMESTEP_H
+#define DE100_PLATFORMS__COMMON_FIXED_TIMESTEP_H
+
+#include "../../_common/base.h"
+#include "../../engine.h"
+#include "fixed-step.h"
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ⏱️ FIXED-TIMESTEP GAME TICK
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// With GameConfig.fixed_update_hz > 0 and a game exporting game_update +
+// game_render, simulation runs at a fixed rate no matter what adaptive FPS
+// does to the display rate:
+//
+//   accumulator += frame_seconds
+//   while (accumulator >= dt) { game_update(dt); accumulator -= dt; }
+//   game_render(alpha = accumulator / dt)     // 0..1 into the next tick
+//
+//   120Hz display, 60Hz sim:  update 0-1x per frame, alpha 0 / 0.5
+//    30Hz display, 60Hz sim:  update 2x per frame
+//
+// Ticks per frame are capped (GameConfig.max_updates_per_frame); time past
+// the cap is dropped, so a long stall slows the game down instead of
+// spiralling. Deliberately long frames (throttled_seconds_per_frame, set
+// by a backgrounded backend) raise the cap to cover them.
+//
+// Button transitions and the wheel/motion deltas go to the first tick of a
+// frame; later ticks in the same frame see held state only, so one press
+// is one press.
+//
+// Timestamped events (GameInput.events) are split by time instead: a tick
+// sees the ones inside its slice of wall time, and events newer than the
+// last tick wait for the next frame.
+//
+// FAST-FORWARD: GameMemory.time_scale (or --time-scale N, for QA) feeds
+// the accumulator N times the frame time, so one rendered frame runs N
+// times the ticks, each the same fixed dt: nothing tunnels that wouldn't
+// at 1x, and the frames in between are simply never rendered. The tick
+// cap scales with it. Live, ticks are also held to what fits in
+// FIXED_TIMESTEP_TICK_BUDGET of the frame at the measured cost per tick
+// (never below what 1x needs), so an 8x request on a slow machine
+// settles at the speed the CPU sustains instead of dropping frames; the
+// achieved speed is written to GameMemory.effective_time_scale. Headless
+// runs and --benchmark skip the budget (ignore_tick_budget) so ticks per
+// frame stay reproducible.
+//
+// The cap, drop and smoothing arithmetic lives in fixed-step.h, which a
+// host with its own main loop can run without the engine.
+//
+// Otherwise (fixed_update_hz == 0, or the game lacks the pair) the frame
+// calls game_update_and_render once, as before, and time_scale is
+// ignored.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+// Share of the frame budget fast-forward ticks may use (the rest is for
+// render, audio and present)
+#ifndef FIXED_TIMESTEP_TICK_BUDGET
+#define FIXED_TIMESTEP_TICK_BUDGET 0.5
+#endif
+
+typedef struct {
+  f64 accumulator_seconds;
+  u64 tick_count;
+  u32 ticks_last_frame;
+  u64 dropped_ticks; // Skipped by the per-frame cap (at 1x only)
+  f32 alpha;         // Last value passed to game_render
+
+  // Fast-forward
+  f32 forced_time_scale;     // --time-scale; > 0 overrides the game's
+  f32 effective_time_scale;  // Smoothed simulated / real seconds
+  f64 tick_cost_seconds;     // Smoothed wall time of one game_update
+  f64 smoothed_sim_seconds;  // Per frame, for effective_time_scale
+  f64 smoothed_wall_seconds;
+  bool ignore_tick_budget;   // Reproducible runs: cap by count only
+
+  // > 0 while the backend runs frames this long on purpose (background
+  // throttling): the tick cap covers them instead of dropping time
+  f32 throttled_seconds_per_frame;
+} FixedTimestep;
+extern FixedTimestep g_fixed_timestep;
+
+/** True if this frame will use game_update/game_render. */
+bool fixed_timestep_is_active(const GameConfig *config,
+                              const GameMainCode *code);
+
+/**
+ * Run one frame of game code: update ticks for `frame_seconds` of elapsed
+ * time plus one render, or a single update_and_render.
+ */
+void fixed_timestep_run_frame(EngineGameState *game, GameMainCode *code,
+                              f32 frame_seconds);
+
+// The two halves of run_frame when active, for callers that schedule the
+// render separately (see render-pipeline.h)
+void fixed_timestep_update(EngineGameState *game, GameMainCode *code,
+                           f32 frame_seconds);
+void fixed_timestep_render(EngineGameState *game, GameMainCode *code);
+
+#endif // DE100_PLATFORMS__COMMON_FIXED_TIMESTEP_H
@@ -0,0 +1,609 @@
+#include "./flight-recorder.h"
+#include "../../_common/memory.h"
+#include "../../_common/time.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Only built with DE100_INTERNAL (see build-common.sh)
+#if DE100_INTERNAL
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ERROR MESSAGES
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_global_var const char *g_flight_recorder_error_messages[] = {
+    [FLIGHT_RECORDER_SUCCESS] = "Success",
+    [FLIGHT_RECORDER_ERROR_DISABLED] = "Disabled",
+    [FLIGHT_RECORDER_ERROR_BAD_SPEC] =
+        "Bad spec (expected DIR[,THRESHOLD_MS[,SECONDS]] or off)",
+    [FLIGHT_RECORDER_ERROR_ALREADY_ACTIVE] =
+        "The flight recorder is already running",
+    [FLIGHT_RECORDER_ERROR_ALLOC_FAILED] = "Failed to allocate recorder rings",
+    [FLIGHT_RECORDER_ERROR_THREAD_CREATE_FAILED] =
+        "Failed to create flight recorder writer thread",
+};
+
+const char *flight_recorder_strerror(FlightRecorderErrorCode code) {
+  if (code >= 0 && code < FLIGHT_RECORDER_ERROR_COUNT) {
+    return g_flight_recorder_error_messages[code];
+  }
+  return "Unknown flight recorder error";
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// STATE
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define FLIGHT_FRAME_MASK (FLIGHT_RECORDER_FRAME_CAPACITY - 1)
+#define FLIGHT_SPAN_MASK (FLIGHT_RECORDER_SPAN_CAPACITY - 1)
+#define FLIGHT_EVENT_MASK (FLIGHT_RECORDER_EVENT_CAPACITY - 1)
+#define FLIGHT_WRITER_IDLE_NS (10 * 1000 * 1000)
+
+// Trace rows besides the profiler's threads
+#define FLIGHT_TID_FRAMES 1000
+#define FLIGHT_TID_INPUT 1001
+
+typedef struct {
+  u64 frame_index; // Profiler's
+  u64 start_cycles;
+  u64 end_cycles;
+  f64 end_seconds; // Wall clock, pairs with end_cycles for calibration
+  u64 span_first;  // Ring positions (not wrapped)
+  u64 event_first;
+  u32 span_count;
+  u32 event_count;
+  f32 frame_ms;
+  f32 target_ms;
+  FlightRecorderAudio audio;
+  bool has_audio;
+  bool is_hitch;
+} FlightFrame;
+
+typedef struct {
+  const De100Profiler *profiler;
+  char directory[FLIGHT_RECORDER_PATH_LENGTH];
+  f32 threshold_ms;
+  f32 window_seconds;
+  f64 begin_seconds;
+
+  // Rings and dump buffers, one allocation
+  De100MemoryBlock block;
+  FlightFrame *frames;
+  De100ProfileSpan *spans;
+  GameInputEvent *events;
+  u64 frame_write;
+  u64 span_write;
+  u64 event_write;
+
+  FlightRecorderAudio audio; // Staged for the next frame
+  bool has_audio;
+
+  // Armed capture (main thread)
+  bool is_armed;
+  f64 trigger_seconds;
+  f64 close_seconds;
+  u64 trigger_frame_index;
+  f32 trigger_ms;
+  u32 dump_count;
+  u32 skipped_hitches; // Writer busy or out of dumps
+
+  // main thread → writer: owned by the writer while dump_ready
+  FlightFrame *dump_frames;
+  De100ProfileSpan *dump_spans;
+  GameInputEvent *dump_events;
+  u32 dump_frame_count;
+  u32 dump_span_count;
+  u32 dump_event_count;
+  u64 dump_trigger_frame_index;
+  f32 dump_trigger_ms;
+  bool dump_ready; // __atomic
+
+  pthread_t writer;
+  bool writer_started;
+  bool is_running; // __atomic
+} FlightRecorder;
+
+de100_file_scoped_global_var FlightRecorder g_flight_recorder = {0};
+
+// ═══════════════════════════════════════════════════════════════════════════
+// OUTPUT (writer thread)
+// ═══════════════════════════════════════════════════════════════════════════
+
+/** Block names are identifiers/paths; escape just enough for JSON. */
+de100_file_scoped_fn void flight_escape(char *dest, size_t capacity,
+                                        const char *src) {
+  size_t out = 0;
+  for (; *src && out + 2 < capacity; ++src) {
+    char c = *src;
+    if (c == '"' || c == '\\') {
+      dest[out++] = '\\';
+    } else if ((u8)c < 0x20) {
+      c = ' ';
+    }
+    dest[out++] = c;
+  }
+  dest[out] = '\0';
+}
+
+de100_file_scoped_global_var const char *g_flight_input_names[] = {
+    [DE100_INPUT_EVENT_KEY] = "key",
+    [DE100_INPUT_EVENT_MOUSE_BUTTON] = "mouse button",
+    [DE100_INPUT_EVENT_MOUSE_MOVE] = "mouse move",
+    [DE100_INPUT_EVENT_MOUSE_WHEEL] = "mouse wheel",
+    [DE100_INPUT_EVENT_JOYSTICK_BUTTON] = "joystick button",
+    [DE100_INPUT_EVENT_JOYSTICK_AXIS] = "joystick axis",
+    [DE100_INPUT_EVENT_MOUSE_DELTA] = "mouse delta",
+};
+
+typedef struct {
+  u64 base_cycles;
+  f64 base_seconds;
+  f64 cycles_per_us;
+} FlightTimebase;
+
+de100_file_scoped_fn inline f64 flight_cycles_to_us(const FlightTimebase *tb,
+                                                   u64 cycles) {
+  f64 delta = cycles >= tb->base_cycles ? (f64)(cycles - tb->base_cycles)
+                                        : -(f64)(tb->base_cycles - cycles);
+  return delta / tb->cycles_per_us;
+}
+
+de100_file_scoped_fn void flight_write_dump(FlightRecorder *recorder,
+                                            const char *path) {
+  FILE *file = fopen(path, "w");
+  if (!file) {
+    fprintf(stderr, "[FLIGHT] ❌ Can't write %s\n", path);
+    return;
+  }
+
+  // Both clocks were read at each frame end: the window's first and last
+  // frames give the cycle rate, and put input timestamps on the same axis
+  const FlightFrame *first = &recorder->dump_frames[0];
+  const FlightFrame *last =
+      &recorder->dump_frames[recorder->dump_frame_count - 1];
+  FlightTimebase tb = {first->end_cycles, first->end_seconds, 0.0};
+  f64 elapsed_us = (last->end_seconds - first->end_seconds) * 1e6;
+  if (elapsed_us > 0.0 && last->end_cycles > first->end_cycles) {
+    tb.cycles_per_us = (f64)(last->end_cycles - first->end_cycles) / elapsed_us;
+  } else if (first->end_cycles > first->start_cycles && first->frame_ms > 0) {
+    tb.cycles_per_us = (f64)(first->end_cycles - first->start_cycles) /
+                       ((f64)first->frame_ms * 1000.0);
+  } else {
+    tb.cycles_per_us = 1.0;
+  }
+
+  fprintf(file,
+          "[\n{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,"
+          "\"args\":{\"name\":\"hitch at frame %lu (%.2fms)\"}},\n"
+          "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,"
+          "\"args\":{\"name\":\"frames\"}},\n"
+          "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,"
+          "\"args\":{\"name\":\"input\"}}",
+          (unsigned long)recorder->dump_trigger_frame_index,
+          (f64)recorder->dump_trigger_ms, FLIGHT_TID_FRAMES, FLIGHT_TID_INPUT);
+
+  for (u32 i = 0; i < recorder->dump_frame_count; ++i) {
+    const FlightFrame *frame = &recorder->dump_frames[i];
+    f64 ts = flight_cycles_to_us(&tb, frame->start_cycles);
+    f64 dur = flight_cycles_to_us(&tb, frame->end_cycles) - ts;
+    fprintf(file,
+            ",\n{\"name\":\"%sframe %lu\",\"cat\":\"frame\",\"ph\":\"X\","
+            "\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u,"
+            "\"args\":{\"ms\":%.3f,\"target_ms\":%.3f}}"
+            ",\n{\"name\":\"frame ms\",\"ph\":\"C\",\"ts\":%.3f,\"pid\":1,"
+            "\"args\":{\"value\":%.3f}}",
+            frame->is_hitch ? "HITCH " : "", (unsigned long)frame->frame_index,
+            ts, dur, FLIGHT_TID_FRAMES, (f64)frame->frame_ms,
+            (f64)frame->target_ms, ts, (f64)frame->frame_ms);
+    if (frame->is_hitch) {
+      fprintf(file,
+              ",\n{\"name\":\"hitch\",\"cat\":\"frame\",\"ph\":\"i\","
+              "\"s\":\"g\",\"ts\":%.3f,\"pid\":1,\"tid\":%u}",
+              ts, FLIGHT_TID_FRAMES);
+    }
+    if (frame->has_audio) {
+      f64 flip = flight_cycles_to_us(&tb, frame->end_cycles);
+      fprintf(file,
+              ",\n{\"name\":\"audio frames\",\"ph\":\"C\",\"ts\":%.3f,"
+              "\"pid\":1,\"args\":{\"delay\":%ld,\"avail\":%ld}}"
+              ",\n{\"name\":\"audio cursors\",\"ph\":\"C\",\"ts\":%.3f,"
+              "\"pid\":1,\"args\":{\"play\":%ld,\"write\":%ld}}",
+              flip, (long)frame->audio.delay_frames,
+              (long)frame->audio.avail_frames, flip,
+              (long)frame->audio.play_cursor, (long)frame->audio.write_cursor);
+    }
+  }
+
+  const De100Profiler *profiler = recorder->profiler;
+  u32 block_count = __atomic_load_n(&profiler->block_count, __ATOMIC_ACQUIRE);
+  bool named_threads[DE100_PROFILER_MAX_THREADS] = {0};
+  for (u32 i = 0; i < recorder->dump_span_count; ++i) {
+    const De100ProfileSpan *span = &recorder->dump_spans[i];
+    if (span->block_id == 0 || span->block_id > block_count) {
+      continue;
+    }
+    const De100ProfileBlockInfo *info = &profiler->blocks[span->block_id - 1];
+    u32 tid = span->thread_index;
+    if (tid < DE100_PROFILER_MAX_THREADS && !named_threads[tid]) {
+      named_threads[tid] = true;
+      fprintf(file,
+              ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,"
+              "\"tid\":%u,\"args\":{\"name\":\"thread %u\"}}",
+              tid, tid);
+    }
+
+    char name[DE100_PROFILER_NAME_LENGTH * 2];
+    char site[DE100_PROFILER_FILE_LENGTH * 2];
+    flight_escape(name, sizeof(name), info->name);
+    flight_escape(site, sizeof(site), info->file);
+    f64 ts = flight_cycles_to_us(&tb, span->start_cycles);
+    if (span->type == DE100_PROFILE_EVENT_INSTANT) {
+      fprintf(file,
+              ",\n{\"name\":\"%s\",\"cat\":\"de100\",\"ph\":\"i\","
+              "\"s\":\"t\",\"ts\":%.3f,\"pid\":1,\"tid\":%u,"
+              "\"args\":{\"site\":\"%s:%u\"}}",
+              name, ts, tid, site, info->line);
+    } else {
+      f64 dur = (f64)(span->end_cycles - span->start_cycles) /
+                tb.cycles_per_us;
+      fprintf(file,
+              ",\n{\"name\":\"%s\",\"cat\":\"de100\",\"ph\":\"X\","
+              "\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u,"
+              "\"args\":{\"site\":\"%s:%u\"}}",
+              name, ts, dur, tid, site, info->line);
+    }
+  }
+
+  for (u32 i = 0; i < recorder->dump_event_count; ++i) {
+    const GameInputEvent *event = &recorder->dump_events[i];
+    const char *kind =
+        event->kind < sizeof(g_flight_input_names) / sizeof(char *)
+            ? g_flight_input_names[event->kind]
+            : "input";
+    fprintf(file,
+            ",\n{\"name\":\"%s%s\",\"cat\":\"input\",\"ph\":\"i\","
+            "\"s\":\"t\",\"ts\":%.3f,\"pid\":1,\"tid\":%u,"
+            "\"args\":{\"code\":%u,\"down\":%u,\"controller\":%u,"
+            "\"x\":%d,\"y\":%d,\"value\":%.3f}}",
+            kind, event->is_down ? " down" : "",
+            (event->seconds - tb.base_seconds) * 1e6, FLIGHT_TID_INPUT,
+            event->code, event->is_down, event->controller, event->x,
+            event->y, (f64)event->value);
+  }
+
+  fputs("\n]\n", file);
+  bool failed = ferror(file) != 0;
+  if (fclose(file) != 0 || failed) {
+    fprintf(stderr, "[FLIGHT] ❌ Write failed: %s\n", path);
+    return;
+  }
+  printf("[FLIGHT] 🛬 Hitch at frame %lu (%.2fms) → %s (%u frames, %u "
+         "spans, %u inputs)\n",
+         (unsigned long)recorder->dump_trigger_frame_index,
+         (f64)recorder->dump_trigger_ms, path, recorder->dump_frame_count,
+         recorder->dump_span_count, recorder->dump_event_count);
+}
+
+de100_file_scoped_fn void *flight_writer_proc(void *arg) {
+  FlightRecorder *recorder = (FlightRecorder *)arg;
+  u32 written = 0;
+
+  for (;;) {
+    bool running = __atomic_load_n(&recorder->is_running, __ATOMIC_ACQUIRE);
+    if (!__atomic_load_n(&recorder->dump_ready, __ATOMIC_ACQUIRE)) {
+      if (!running) {
+        break; // Stopped, nothing pending
+      }
+      struct timespec idle = {0, FLIGHT_WRITER_IDLE_NS};
+      nanosleep(&idle, NULL);
+      continue;
+    }
+
+    struct tm local = {0};
+    time_t now = time(NULL);
+#if defined(_WIN32)
+    localtime_s(&local, &now);
+#else
+    localtime_r(&now, &local);
+#endif
+    char path[FLIGHT_RECORDER_PATH_LENGTH + 64];
+    snprintf(path, sizeof(path),
+             "%s/hitch-%04d%02d%02d-%02d%02d%02d-%u.json",
+             recorder->directory, local.tm_year + 1900, local.tm_mon + 1,
+             local.tm_mday, local.tm_hour, local.tm_min, local.tm_sec,
+             written++);
+    flight_write_dump(recorder, path);
+
+    __atomic_store_n(&recorder->dump_ready, false, __ATOMIC_RELEASE);
+  }
+
+  return NULL;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// CAPTURE (main thread)
+// ═══════════════════════════════════════════════════════════════════════════
+
+/** Copy [first, end) of a ring into `dest`, unwrapping. */
+de100_file_scoped_fn void flight_copy_ring(void *dest, const void *ring,
+                                           u64 capacity, size_t element,
+                                           u64 first, u64 end) {
+  u64 count = end - first;
+  u64 start = first & (capacity - 1);
+  u64 head = count < capacity - start ? count : capacity - start;
+  memcpy(dest, (const u8 *)ring + start * element, head * element);
+  memcpy((u8 *)dest + head * element, ring, (count - head) * element);
+}
+
+/**
+ * Hand the frames from `window_seconds` before the trigger up to now to
+ * the writer. Stops early at frames whose spans or events the rings have
+ * already overwritten.
+ */
+de100_file_scoped_fn void flight_publish(FlightRecorder *recorder) {
+  f64 oldest_seconds = recorder->trigger_seconds - recorder->window_seconds;
+  u64 span_floor = recorder->span_write > FLIGHT_RECORDER_SPAN_CAPACITY
+                       ? recorder->span_write - FLIGHT_RECORDER_SPAN_CAPACITY
+                       : 0;
+  u64 event_floor =
+      recorder->event_write > FLIGHT_RECORDER_EVENT_CAPACITY
+          ? recorder->event_write - FLIGHT_RECORDER_EVENT_CAPACITY
+          : 0;
+
+  u64 first = recorder->frame_write;
+  u64 frame_floor =
+      recorder->frame_write > FLIGHT_RECORDER_FRAME_CAPACITY
+          ? recorder->frame_write - FLIGHT_RECORDER_FRAME_CAPACITY
+          : 0;
+  while (first > frame_floor) {
+    const FlightFrame *frame =
+        &recorder->frames[(first - 1) & FLIGHT_FRAME_MASK];
+    if (frame->end_seconds < oldest_seconds ||
+        frame->span_first < span_floor || frame->event_first < event_floor) {
+      break;
+    }
+    --first;
+  }
+  if (first == recorder->frame_write) {
+    return;
+  }
+
+  const FlightFrame *oldest = &recorder->frames[first & FLIGHT_FRAME_MASK];
+  recorder->dump_frame_count = (u32)(recorder->frame_write - first);
+  recorder->dump_span_count = (u32)(recorder->span_write - oldest->span_first);
+  recorder->dump_event_count =
+      (u32)(recorder->event_write - oldest->event_first);
+  flight_copy_ring(recorder->dump_frames, recorder->frames,
+                   FLIGHT_RECORDER_FRAME_CAPACITY, sizeof(FlightFrame), first,
+                   recorder->frame_write);
+  flight_copy_ring(recorder->dump_spans, recorder->spans,
+                   FLIGHT_RECORDER_SPAN_CAPACITY, sizeof(De100ProfileSpan),
+                   oldest->span_first, recorder->span_write);
+  flight_copy_ring(recorder->dump_events, recorder->events,
+                   FLIGHT_RECORDER_EVENT_CAPACITY, sizeof(GameInputEvent),
+                   oldest->event_first, recorder->event_write);
+  recorder->dump_trigger_frame_index = recorder->trigger_frame_index;
+  recorder->dump_trigger_ms = recorder->trigger_ms;
+
+  __atomic_store_n(&recorder->dump_ready, true, __ATOMIC_RELEASE);
+  recorder->dump_count++;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// PUBLIC API
+// ═══════════════════════════════════════════════════════════════════════════
+
+/** "DIR[,THRESHOLD_MS[,SECONDS]]"; NULL or "" keeps the defaults. */
+de100_file_scoped_fn bool flight_parse(FlightRecorder *recorder,
+                                       const char *spec) {
+  recorder->directory[0] = '.';
+  recorder->directory[1] = '\0';
+  recorder->threshold_ms = FLIGHT_RECORDER_DEFAULT_THRESHOLD_MS;
+  recorder->window_seconds = FLIGHT_RECORDER_DEFAULT_SECONDS;
+  if (!spec || !spec[0]) {
+    return true;
+  }
+
+  const char *comma = strchr(spec, ',');
+  size_t length = comma ? (size_t)(comma - spec) : strlen(spec);
+  if (length >= FLIGHT_RECORDER_PATH_LENGTH) {
+    return false;
+  }
+  if (length > 0) {
+    memcpy(recorder->directory, spec, length);
+    recorder->directory[length] = '\0';
+  }
+  if (!comma) {
+    return true;
+  }
+
+  char *end = NULL;
+  f32 threshold = strtof(comma + 1, &end);
+  if (end == comma + 1 || threshold < 0.0f ||
+      (*end != '\0' && *end != ',')) {
+    return false;
+  }
+  recorder->threshold_ms = threshold;
+  if (*end == ',') {
+    const char *seconds_text = end + 1;
+    f32 seconds = strtof(seconds_text, &end);
+    if (end == seconds_text || *end != '\0' || seconds <= 0.0f ||
+        seconds > 60.0f) {
+      return false;
+    }
+    recorder->window_seconds = seconds;
+  }
+  return true;
+}
+
+FlightRecorderResult flight_recorder_begin(const De100Profiler *profiler,
+                                           const char *spec) {
+  FlightRecorderResult result = {0};
+  FlightRecorder *recorder = &g_flight_recorder;
+
+  if (spec && strcmp(spec, "off") == 0) {
+    result.error_code = FLIGHT_RECORDER_ERROR_DISABLED;
+    return result;
+  }
+  if (recorder->writer_started) {
+    result.error_code = FLIGHT_RECORDER_ERROR_ALREADY_ACTIVE;
+    return result;
+  }
+
+  *recorder = (FlightRecorder){0};
+  if (!profiler || !flight_parse(recorder, spec)) {
+    result.error_code = FLIGHT_RECORDER_ERROR_BAD_SPEC;
+    return result;
+  }
+  recorder->profiler = profiler;
+
+  // Rings, then the dump buffers, same sizes. Prefaulted: the rings are
+  // written every frame, and a dump shouldn't fault in megabytes
+  size_t frames_size = sizeof(FlightFrame) * FLIGHT_RECORDER_FRAME_CAPACITY;
+  size_t spans_size =
+      sizeof(De100ProfileSpan) * FLIGHT_RECORDER_SPAN_CAPACITY;
+  size_t events_size =
+      sizeof(GameInputEvent) * FLIGHT_RECORDER_EVENT_CAPACITY;
+  size_t half = frames_size + spans_size + events_size;
+  recorder->block = de100_memory_alloc(
+      NULL, half * 2, De100_MEMORY_FLAG_RW | De100_MEMORY_FLAG_PREFAULT);
+  if (!de100_memory_is_valid(recorder->block)) {
+    result.error_code = FLIGHT_RECORDER_ERROR_ALLOC_FAILED;
+    return result;
+  }
+  u8 *base = (u8 *)recorder->block.base;
+  recorder->frames = (FlightFrame *)base;
+  recorder->spans = (De100ProfileSpan *)(base + frames_size);
+  recorder->events = (GameInputEvent *)(base + frames_size + spans_size);
+  recorder->dump_frames = (FlightFrame *)(base + half);
+  recorder->dump_spans = (De100ProfileSpan *)(base + half + frames_size);
+  recorder->dump_events =
+      (GameInputEvent *)(base + half + frames_size + spans_size);
+
+  recorder->begin_seconds = de100_get_wall_clock();
+
+  __atomic_store_n(&recorder->is_running, true, __ATOMIC_RELEASE);
+  if (pthread_create(&recorder->writer, NULL, flight_writer_proc, recorder) !=
+      0) {
+    __atomic_store_n(&recorder->is_running, false, __ATOMIC_RELEASE);
+    de100_memory_free(&recorder->block);
+    result.error_code = FLIGHT_RECORDER_ERROR_THREAD_CREATE_FAILED;
+    return result;
+  }
+  recorder->writer_started = true;
+
+  printf("[FLIGHT] ✈️  Recording %.1fs of frames, dumping hitches over "
+         "target + %.1fms to %s/ (%lu KB)\n",
+         (f64)recorder->window_seconds, (f64)recorder->threshold_ms,
+         recorder->directory, (unsigned long)(half * 2 / 1024));
+  result.success = true;
+  result.error_code = FLIGHT_RECORDER_SUCCESS;
+  return result;
+}
+
+void flight_recorder_audio(const FlightRecorderAudio *audio) {
+  FlightRecorder *recorder = &g_flight_recorder;
+  if (!recorder->writer_started || !audio) {
+    return;
+  }
+  recorder->audio = *audio;
+  recorder->has_audio = true;
+}
+
+void flight_recorder_frame(const De100Profiler *profiler,
+                           const GameInput *inputs, f32 frame_time_ms,
+                           f32 target_seconds_per_frame) {
+  FlightRecorder *recorder = &g_flight_recorder;
+  if (!recorder->writer_started || profiler != recorder->profiler) {
+    return;
+  }
+  f64 now = de100_get_wall_clock();
+
+  FlightFrame *frame =
+      &recorder->frames[recorder->frame_write & FLIGHT_FRAME_MASK];
+  frame->frame_index = profiler->frame_index;
+  frame->start_cycles = profiler->frame_start_cycles;
+  frame->end_cycles = profiler->last_frame_end_cycles;
+  frame->end_seconds = now;
+  frame->frame_ms = frame_time_ms;
+  frame->target_ms = target_seconds_per_frame * 1000.0f;
+  frame->audio = recorder->audio;
+  frame->has_audio = recorder->has_audio;
+  recorder->has_audio = false;
+
+  u32 span_count = profiler->span_count < DE100_PROFILER_MAX_SPANS
+                       ? profiler->span_count
+                       : DE100_PROFILER_MAX_SPANS;
+  frame->span_first = recorder->span_write;
+  frame->span_count = span_count;
+  for (u32 i = 0; i < span_count; ++i) {
+    recorder->spans[(recorder->span_write + i) & FLIGHT_SPAN_MASK] =
+        profiler->spans[i];
+  }
+  recorder->span_write += span_count;
+
+  u32 event_count = inputs ? inputs->event_count : 0;
+  frame->event_first = recorder->event_write;
+  frame->event_count = event_count;
+  for (u32 i = 0; i < event_count; ++i) {
+    recorder->events[(recorder->event_write + i) & FLIGHT_EVENT_MASK] =
+        inputs->events[i];
+  }
+  recorder->event_write += event_count;
+
+  frame->is_hitch =
+      frame_time_ms > frame->target_ms + recorder->threshold_ms &&
+      now - recorder->begin_seconds >= FLIGHT_RECORDER_WARMUP_SECONDS;
+  recorder->frame_write++;
+
+  bool writer_busy =
+      __atomic_load_n(&recorder->dump_ready, __ATOMIC_ACQUIRE);
+  if (frame->is_hitch && !recorder->is_armed) {
+    if (writer_busy || recorder->dump_count >= FLIGHT_RECORDER_MAX_DUMPS) {
+      recorder->skipped_hitches++;
+    } else {
+      recorder->is_armed = true;
+      recorder->trigger_seconds = now;
+      recorder->close_seconds = now + FLIGHT_RECORDER_AFTER_SECONDS;
+      recorder->trigger_frame_index = frame->frame_index;
+      recorder->trigger_ms = frame_time_ms;
+    }
+  }
+
+  if (recorder->is_armed && now >= recorder->close_seconds && !writer_busy) {
+    recorder->is_armed = false;
+    flight_publish(recorder);
+  }
+}
+
+void flight_recorder_end(void) {
+  FlightRecorder *recorder = &g_flight_recorder;
+  if (!recorder->writer_started) {
+    return;
+  }
+
+  // A capture still collecting its tail goes out with what it has
+  if (recorder->is_armed &&
+      !__atomic_load_n(&recorder->dump_ready, __ATOMIC_ACQUIRE)) {
+    recorder->is_armed = false;
+    flight_publish(recorder);
+  }
+
+  __atomic_store_n(&recorder->is_running, false, __ATOMIC_RELEASE);
+  pthread_join(recorder->writer, NULL);
+  recorder->writer_started = false;
+  de100_memory_free(&recorder->block);
+
+  printf("[FLIGHT] ✅ Stopped (%u hitch dump(s), %u hitch(es) not dumped)\n",
+         recorder->dump_count, recorder->skipped_hitches);
+}
+
+bool flight_recorder_is_active(void) {
+  return g_flight_recorder.writer_started;
+}
+
+#endif // DE100_INTERNAL
@@ -0,0 +1,101 @@
+#ifndef DE100_PLATFORMS__COMMON_FLIGHT_RECORDER_H
+#define DE100_PLATFORMS__COMMON_FLIGHT_RECORDER_H
+
+#include "../../_common/base.h"
+#include "../../_common/profiler.h"
+#include "../../game/inputs.h"
+#include <stdbool.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// FLIGHT RECORDER (internal builds)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// Always on: keeps the last few seconds of every frame in rings (the
+// profiler's spans, so frame phases, timed blocks and the hot_reload /
+// underrun instants; the frame's input events; the audio cursors
+// linux_debug_capture_flip_state reads). When a frame goes over its
+// budget by more than the threshold, the window around it is written as
+// Chrome trace-event JSON (Perfetto, chrome://tracing, like
+// trace-export.h), so a hitch that happens once an hour comes with the
+// frames that led up to it instead of a "missed frame" line.
+//
+//   end_frame ──copy──▶ rings ──hitch──▶ dump buffer ──▶ writer thread ──▶
+//                                                        hitch-*.json
+//
+// Per frame the main thread copies the frame's spans and events into the
+// rings (a few KB). A hitch arms a capture that closes
+// FLIGHT_RECORDER_AFTER_SECONDS later (the recovery is part of the
+// story); the window is then copied into the dump buffer and the writer
+// thread formats and writes it. Hitches while a dump is pending or being
+// written are marked in it, not dumped again.
+//
+// DE100_FLIGHT_RECORDER environment variable at engine_init:
+//   off                              Disabled
+//   DIR[,THRESHOLD_MS[,SECONDS]]     Dumps go to DIR (default "."); a hitch
+//                                    is THRESHOLD_MS over the target
+//                                    (default 8); SECONDS of history
+//                                    (default 3)
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define FLIGHT_RECORDER_FRAME_CAPACITY 1024    // Frames, power of two
+#define FLIGHT_RECORDER_SPAN_CAPACITY (1u << 17) // Spans, power of two
+#define FLIGHT_RECORDER_EVENT_CAPACITY 8192    // Input events, power of two
+#define FLIGHT_RECORDER_DEFAULT_THRESHOLD_MS 8.0f
+#define FLIGHT_RECORDER_DEFAULT_SECONDS 3.0f
+#define FLIGHT_RECORDER_AFTER_SECONDS 0.25f
+#define FLIGHT_RECORDER_WARMUP_SECONDS 2.0f // Startup frames never trigger
+#define FLIGHT_RECORDER_MAX_DUMPS 16        // Per session
+#define FLIGHT_RECORDER_PATH_LENGTH 512
+
+typedef enum {
+  FLIGHT_RECORDER_SUCCESS = 0,
+  FLIGHT_RECORDER_ERROR_DISABLED,
+  FLIGHT_RECORDER_ERROR_BAD_SPEC,
+  FLIGHT_RECORDER_ERROR_ALREADY_ACTIVE,
+  FLIGHT_RECORDER_ERROR_ALLOC_FAILED,
+  FLIGHT_RECORDER_ERROR_THREAD_CREATE_FAILED,
+
+  FLIGHT_RECORDER_ERROR_COUNT
+} FlightRecorderErrorCode;
+
+typedef struct {
+  bool success;
+  FlightRecorderErrorCode error_code;
+} FlightRecorderResult;
+
+/** One frame's audio device state, at the flip. */
+typedef struct {
+  i64 play_cursor;  // Bytes into the device buffer
+  i64 write_cursor; // Bytes into the device buffer
+  i64 delay_frames; // Queued in the device
+  i64 avail_frames; // Free in the device
+} FlightRecorderAudio;
+
+/**
+ * Parse the spec (see above), allocate the rings and start the writer
+ * thread. "off" returns FLIGHT_RECORDER_ERROR_DISABLED.
+ */
+FlightRecorderResult flight_recorder_begin(const De100Profiler *profiler,
+                                           const char *spec);
+
+/** This frame's audio state. Main thread, before flight_recorder_frame. */
+void flight_recorder_audio(const FlightRecorderAudio *audio);
+
+/**
+ * Record the profiler's last frame and `inputs`' events; trigger or
+ * finish a dump. Main thread, right after de100_profiler_end_frame().
+ * No-op when not recording.
+ */
+void flight_recorder_frame(const De100Profiler *profiler,
+                           const GameInput *inputs, f32 frame_time_ms,
+                           f32 target_seconds_per_frame);
+
+/** Finish a dump being written, stop and join the writer. */
+void flight_recorder_end(void);
+
+bool flight_recorder_is_active(void);
+
+const char *flight_recorder_strerror(FlightRecorderErrorCode code);
+
+#endif // DE100_PLATFORMS__COMMON_FLIGHT_RECORDER_H
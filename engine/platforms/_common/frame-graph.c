@@ -0,0 +1,203 @@
+#include "./frame-graph.h"
+#include "../../_common/log.h"
+#include "../../_common/profiler.h"
+#include "../../_common/time.h"
+#include "./work-queue.h"
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ERROR MESSAGES
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_global_var const char *g_frame_graph_error_messages[] = {
+    [FRAME_GRAPH_SUCCESS] = "Success",
+    [FRAME_GRAPH_ERROR_TOO_MANY_PHASES] =
+        "More than FRAME_GRAPH_MAX_PHASES phases",
+    [FRAME_GRAPH_ERROR_UNKNOWN_DEPENDENCY] =
+        "A phase runs after a phase that was never added",
+    [FRAME_GRAPH_ERROR_CYCLE] = "Phase dependencies form a cycle",
+};
+
+const char *frame_graph_strerror(FrameGraphErrorCode code) {
+  if (code >= 0 && code < FRAME_GRAPH_ERROR_COUNT) {
+    return g_frame_graph_error_messages[code];
+  }
+  return "Unknown frame graph error";
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// BUILD
+// ═══════════════════════════════════════════════════════════════════════════
+
+u32 frame_graph_add(FrameGraph *graph, FrameGraphPhase phase) {
+  if (graph->count >= FRAME_GRAPH_MAX_PHASES) {
+    return FRAME_GRAPH_INVALID_PHASE;
+  }
+  u32 index = graph->count++;
+  phase.wave = 0;
+  phase.profile_block_id = 0;
+  phase.graph = graph;
+  phase.last_ms = 0.0f;
+  phase.keep_running = true;
+  graph->phases[index] = phase;
+  graph->is_compiled = false;
+  return index;
+}
+
+FrameGraphResult frame_graph_compile(FrameGraph *graph,
+                                     De100WorkQueue *work_queue) {
+  FrameGraphResult result = {0};
+  graph->is_compiled = false;
+  graph->work_queue = work_queue;
+
+  u32 added = graph->count >= 32 ? ~0u : FRAME_GRAPH_BIT(graph->count) - 1;
+  for (u32 i = 0; i < graph->count; ++i) {
+    if (graph->phases[i].after & ~added) {
+      result.error_code = FRAME_GRAPH_ERROR_UNKNOWN_DEPENDENCY;
+      return result;
+    }
+  }
+
+  // Kahn's algorithm, a wave at a time: everything whose dependencies
+  // are all placed joins the next wave. Add order is kept within a wave.
+  u32 placed = 0;
+  u32 order_count = 0;
+  graph->wave_count = 0;
+  while (order_count < graph->count) {
+    u32 wave = graph->wave_count;
+    u32 wave_mask = 0;
+    graph->wave_start[wave] = order_count;
+    for (u32 i = 0; i < graph->count; ++i) {
+      FrameGraphPhase *phase = &graph->phases[i];
+      if (!(placed & FRAME_GRAPH_BIT(i)) && (phase->after & ~placed) == 0) {
+        phase->wave = wave;
+        graph->order[order_count++] = i;
+        wave_mask |= FRAME_GRAPH_BIT(i);
+      }
+    }
+    if (wave_mask == 0) {
+      result.error_code = FRAME_GRAPH_ERROR_CYCLE;
+      return result;
+    }
+    placed |= wave_mask;
+    graph->wave_count++;
+  }
+  graph->wave_start[graph->wave_count] = order_count;
+
+  graph->is_compiled = true;
+  result.success = true;
+  return result;
+}
+
+void frame_graph_set_enabled(FrameGraph *graph, u32 phase, bool enabled) {
+  if (phase >= graph->count) {
+    return;
+  }
+  if (enabled) {
+    graph->phases[phase].flags &= ~(u32)FRAME_GRAPH_DISABLED;
+  } else {
+    graph->phases[phase].flags |= FRAME_GRAPH_DISABLED;
+  }
+}
+
+void frame_graph_log(const FrameGraph *graph) {
+  for (u32 wave = 0; wave < graph->wave_count; ++wave) {
+    for (u32 o = graph->wave_start[wave]; o < graph->wave_start[wave + 1];
+         ++o) {
+      const FrameGraphPhase *phase = &graph->phases[graph->order[o]];
+      DE100_LOG_DEBUG(DE100_LOG_ENGINE, "Frame wave %u: %s%s", wave,
+                      phase->name,
+                      (phase->flags & FRAME_GRAPH_MAIN_THREAD) ? " (main)"
+                                                               : "");
+      (void)phase;
+    }
+  }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// RUN
+// ═══════════════════════════════════════════════════════════════════════════
+
+// Run and time one phase, on whichever thread
+de100_file_scoped_fn void frame_graph_run_phase(FrameGraphPhase *phase) {
+  f64 start = de100_get_wall_clock();
+#if DE100_INTERNAL
+  u64 start_cycles = de100_profiler_cycles();
+#endif
+
+  phase->keep_running = phase->run(phase->graph, phase->data);
+
+#if DE100_INTERNAL
+  de100_profiler_record_scope(&phase->profile_block_id, phase->name,
+                              __FILE__, __LINE__, start_cycles,
+                              de100_profiler_cycles());
+#endif
+  phase->last_ms =
+      (f32)(de100_get_seconds_elapsed(start, de100_get_wall_clock()) *
+            1000.0);
+}
+
+de100_file_scoped_fn
+DE100_WORK_QUEUE_CALLBACK(frame_graph_phase_work) {
+  (void)thread_context;
+  frame_graph_run_phase((FrameGraphPhase *)data);
+}
+
+bool frame_graph_run(FrameGraph *graph) {
+  if (!graph->is_compiled) {
+    return false;
+  }
+
+  bool keep_running = true;
+  for (u32 wave = 0; wave < graph->wave_count && keep_running; ++wave) {
+    u32 first = graph->wave_start[wave];
+    u32 end = graph->wave_start[wave + 1];
+    u32 live = 0;
+    for (u32 o = first; o < end; ++o) {
+      live += !(graph->phases[graph->order[o]].flags & FRAME_GRAPH_DISABLED);
+    }
+
+    // Workers only pay off with something to overlap
+    bool queued = false;
+    if (graph->work_queue && live > 1) {
+      for (u32 o = first; o < end; ++o) {
+        FrameGraphPhase *phase = &graph->phases[graph->order[o]];
+        u32 stay = FRAME_GRAPH_MAIN_THREAD | FRAME_GRAPH_DISABLED;
+        if (!(phase->flags & stay) &&
+            work_queue_add_entry(graph->work_queue, frame_graph_phase_work,
+                                 phase)) {
+          phase->flags |= FRAME_GRAPH_QUEUED;
+          queued = true;
+          graph->parallel_phase_count++;
+        }
+      }
+    }
+
+    for (u32 o = first; o < end; ++o) {
+      FrameGraphPhase *phase = &graph->phases[graph->order[o]];
+      if (!(phase->flags & (FRAME_GRAPH_DISABLED | FRAME_GRAPH_QUEUED))) {
+        frame_graph_run_phase(phase);
+      }
+    }
+    if (queued) {
+      work_queue_complete_all_work(graph->work_queue);
+    }
+
+    // Stats and the stop flag on the main thread, once the wave is done
+    for (u32 o = first; o < end; ++o) {
+      FrameGraphPhase *phase = &graph->phases[graph->order[o]];
+      if (phase->flags & FRAME_GRAPH_DISABLED) {
+        continue;
+      }
+      phase->flags &= ~(u32)FRAME_GRAPH_QUEUED;
+#if DE100_INTERNAL
+      if (phase->stats_phase != FRAME_GRAPH_NO_STATS) {
+        frame_stats_phase_add((FramePhase)phase->stats_phase, phase->last_ms);
+      }
+#endif
+      keep_running = keep_running && phase->keep_running;
+    }
+  }
+
+  graph->frame_count++;
+  return keep_running;
+}
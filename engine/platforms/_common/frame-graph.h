@@ -0,0 +1,136 @@
+#ifndef DE100_PLATFORMS__COMMON_FRAME_GRAPH_H
+#define DE100_PLATFORMS__COMMON_FRAME_GRAPH_H
+
+#include "../../_common/base.h"
+#include "../../game/thread.h"
+#include "./frame-stats.h"
+
+#include <stdbool.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// FRAME GRAPH (the main loop as phases with declared dependencies)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// A backend describes its frame once, at init, instead of hand-ordering
+// calls in its loop:
+//
+//   u32 input  = frame_graph_add(&graph, (FrameGraphPhase){
+//       .name = "input", .run = headless_phase_input, .data = &ctx,
+//       .flags = FRAME_GRAPH_MAIN_THREAD, .stats_phase = FRAME_PHASE_INPUT});
+//   u32 update = frame_graph_add(&graph, (FrameGraphPhase){
+//       .name = "update", .run = headless_phase_update, .data = &ctx,
+//       .after = FRAME_GRAPH_BIT(input), .flags = FRAME_GRAPH_MAIN_THREAD,
+//       .stats_phase = FRAME_PHASE_UPDATE});
+//   ...
+//   frame_graph_compile(&graph, work_queue);
+//   while (frame_graph_run(&graph)) {}
+//
+// compile() sorts the phases into WAVES: a phase goes in the first wave
+// after every phase in its `after` mask. run() executes the waves in
+// order. Within a wave, nothing depends on anything else, so the phases
+// without FRAME_GRAPH_MAIN_THREAD go to the work queue while the main
+// thread runs the rest. The wave ends once all of them are done:
+//
+//   wave 0   input
+//   wave 1   update
+//   wave 2   audio ║ present      ← audio on a worker, present on main
+//   wave 3   stats
+//
+// Keep FRAME_GRAPH_MAIN_THREAD on anything touching the window, GL
+// context, input devices or game code that isn't thread-safe. Only
+// phases that read shared state (the finished backbuffer, the game's
+// sound output) may share a wave, and only if they write nothing the
+// other reads.
+//
+// Every phase is timed. The time goes to its `stats_phase` histogram
+// (frame-stats.h) and, in DE100_INTERNAL builds, a profiler scope under
+// its name, so traces show which phases overlapped. A phase that returns
+// false ends the loop after the current wave (run() returns false).
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define FRAME_GRAPH_MAX_PHASES 32
+#define FRAME_GRAPH_INVALID_PHASE 0xFFFFFFFFu
+#define FRAME_GRAPH_BIT(phase) (1u << (phase))
+#define FRAME_GRAPH_NO_STATS (-1)
+
+typedef struct FrameGraph FrameGraph;
+
+// Returns false to stop the main loop
+#define FRAME_GRAPH_PHASE_FN(name) bool name(FrameGraph *graph, void *data)
+typedef FRAME_GRAPH_PHASE_FN(frame_graph_phase_fn);
+
+typedef enum {
+  FRAME_GRAPH_MAIN_THREAD = 1u << 0, // Never on a worker
+  FRAME_GRAPH_DISABLED = 1u << 1,    // Skipped (dependents still run)
+  FRAME_GRAPH_QUEUED = 1u << 2,      // Internal: on a worker this wave
+} FrameGraphPhaseFlags;
+
+typedef struct {
+  // Filled by the backend
+  const char *name;
+  frame_graph_phase_fn *run;
+  void *data;
+  u32 after;       // FRAME_GRAPH_BIT()s of earlier phases
+  u32 flags;       // FrameGraphPhaseFlags
+  i32 stats_phase; // FramePhase to charge, or FRAME_GRAPH_NO_STATS
+
+  // Managed by the graph
+  u32 wave;
+  u32 profile_block_id;
+  FrameGraph *graph;
+  f32 last_ms;
+  bool keep_running; // This frame's result
+} FrameGraphPhase;
+
+typedef enum {
+  FRAME_GRAPH_SUCCESS = 0,
+  FRAME_GRAPH_ERROR_TOO_MANY_PHASES,
+  FRAME_GRAPH_ERROR_UNKNOWN_DEPENDENCY, // `after` names no added phase
+  FRAME_GRAPH_ERROR_CYCLE,
+
+  FRAME_GRAPH_ERROR_COUNT
+} FrameGraphErrorCode;
+
+typedef struct {
+  bool success;
+  FrameGraphErrorCode error_code;
+} FrameGraphResult;
+
+struct FrameGraph {
+  FrameGraphPhase phases[FRAME_GRAPH_MAX_PHASES];
+  u32 count;
+
+  // From compile(): phase indexes wave by wave
+  u32 order[FRAME_GRAPH_MAX_PHASES];
+  u32 wave_start[FRAME_GRAPH_MAX_PHASES + 1];
+  u32 wave_count;
+  bool is_compiled;
+
+  De100WorkQueue *work_queue; // NULL: every phase on the main thread
+  u64 frame_count;
+  u32 parallel_phase_count; // Phases run on workers, total
+};
+
+/** Append a phase. Returns its index, or FRAME_GRAPH_INVALID_PHASE. */
+u32 frame_graph_add(FrameGraph *graph, FrameGraphPhase phase);
+
+/**
+ * Sort the phases into waves. Call after the last add() and before the
+ * first run(); add() after compile() needs another compile().
+ */
+FrameGraphResult frame_graph_compile(FrameGraph *graph,
+                                     De100WorkQueue *work_queue);
+
+/** One frame. False once a phase asked to stop the loop. */
+bool frame_graph_run(FrameGraph *graph);
+
+/** Turn a phase on or off between frames (e.g. audio only when wanted). */
+void frame_graph_set_enabled(FrameGraph *graph, u32 phase, bool enabled);
+
+/** Log the waves (DE100_LOG_ENGINE, debug). */
+void frame_graph_log(const FrameGraph *graph);
+
+const char *frame_graph_strerror(FrameGraphErrorCode code);
+
+#endif // DE100_PLATFORMS__COMMON_FRAME_GRAPH_H
@@ -0,0 +1,98 @@
+#ifndef DE100_PLATFORMS__COMMON_FRAME_HISTOGRAM_H
+#define DE100_PLATFORMS__COMMON_FRAME_HISTOGRAM_H
+
+#include "../../_common/base.h"
+
+// ═══════════════════════════════════════════════════════════════════════════
+// FRAME HISTOGRAM
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// HDR-histogram style duration histogram: values are microseconds in
+// log-linear buckets (32 exact buckets, then 16 per power of two, ≤ ~6%
+// error), so p99.9 over hours of frames costs a fixed 2KB and O(1) per
+// record. Shared by frame stats (frame-stats.h) and telemetry
+// (telemetry.h); header-only so release builds get it without the
+// internal frame stats.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define FRAME_HISTOGRAM_EXACT_BUCKETS 32
+#define FRAME_HISTOGRAM_SUB_BUCKETS 16
+#define FRAME_HISTOGRAM_BUCKET_COUNT                                           \
+  (FRAME_HISTOGRAM_EXACT_BUCKETS + 27 * FRAME_HISTOGRAM_SUB_BUCKETS)
+
+typedef struct {
+  u64 count;
+  u64 total_us;
+  u32 min_us;
+  u32 max_us;
+  u32 buckets[FRAME_HISTOGRAM_BUCKET_COUNT];
+} FrameHistogram;
+
+de100_file_scoped_fn inline u32 frame_histogram_bucket_index(u32 value_us) {
+  if (value_us < FRAME_HISTOGRAM_EXACT_BUCKETS) {
+    return value_us;
+  }
+  u32 msb = 31 - (u32)__builtin_clz(value_us); // ≥ 5
+  u32 shift = msb - 4;
+  u32 top = value_us >> shift; // 16..31
+  return FRAME_HISTOGRAM_EXACT_BUCKETS +
+         (shift - 1) * FRAME_HISTOGRAM_SUB_BUCKETS +
+         (top - FRAME_HISTOGRAM_SUB_BUCKETS);
+}
+
+/** Largest value that lands in `index` (reported value, like HDR). */
+de100_file_scoped_fn inline u64 frame_histogram_bucket_upper(u32 index) {
+  if (index < FRAME_HISTOGRAM_EXACT_BUCKETS) {
+    return index;
+  }
+  u32 k = index - FRAME_HISTOGRAM_EXACT_BUCKETS;
+  u32 shift = k / FRAME_HISTOGRAM_SUB_BUCKETS + 1;
+  u64 top = k % FRAME_HISTOGRAM_SUB_BUCKETS + FRAME_HISTOGRAM_SUB_BUCKETS;
+  return ((top + 1) << shift) - 1;
+}
+
+de100_file_scoped_fn inline void
+frame_histogram_record(FrameHistogram *histogram, f32 ms) {
+  f32 us = ms * 1000.0f;
+  u32 value_us = us <= 0.0f ? 0 : us >= 4.0e9f ? 0xFFFFFFFFu : (u32)us;
+
+  if (histogram->count == 0 || value_us < histogram->min_us) {
+    histogram->min_us = value_us;
+  }
+  if (value_us > histogram->max_us) {
+    histogram->max_us = value_us;
+  }
+  histogram->count++;
+  histogram->total_us += value_us;
+  histogram->buckets[frame_histogram_bucket_index(value_us)]++;
+}
+
+/** Percentile (0..100) in ms; 0 when empty. */
+de100_file_scoped_fn inline f32
+frame_histogram_percentile_ms(const FrameHistogram *histogram,
+                              f32 percentile) {
+  if (histogram->count == 0) {
+    return 0.0f;
+  }
+
+  u64 rank = (u64)((f64)percentile / 100.0 * (f64)histogram->count + 0.5);
+  if (rank < 1) {
+    rank = 1;
+  }
+
+  u64 seen = 0;
+  for (u32 i = 0; i < FRAME_HISTOGRAM_BUCKET_COUNT; ++i) {
+    seen += histogram->buckets[i];
+    if (seen >= rank) {
+      u64 value = frame_histogram_bucket_upper(i);
+      if (value > histogram->max_us) {
+        value = histogram->max_us; // Never report beyond what was seen
+      }
+      return (f32)value / 1000.0f;
+    }
+  }
+  return (f32)histogram->max_us / 1000.0f;
+}
+
+#endif // DE100_PLATFORMS__COMMON_FRAME_HISTOGRAM_H
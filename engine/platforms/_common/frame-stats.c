@@ -1,14 +1,62 @@
 #include "./frame-stats.h"
+#include "../../_common/log.h"
+#include "../../_common/profiler.h"
+#include "../../_common/time.h"
 #include <stdio.h>
+#include <string.h>
 
 FrameStats g_frame_stats = {0};
 
-void frame_stats_init(void) {
-  g_frame_stats.frame_count = 0;
-  g_frame_stats.missed_frames = 0;
-  g_frame_stats.min_frame_time_ms = 0.0f;
-  g_frame_stats.max_frame_time_ms = 0.0f;
-  g_frame_stats.total_frame_time_ms = 0.0f;
+de100_file_scoped_global_var const char *g_frame_phase_names[] = {
+    [FRAME_PHASE_INPUT] = "input",     [FRAME_PHASE_UPDATE] = "update",
+    [FRAME_PHASE_AUDIO] = "audio",     [FRAME_PHASE_PRESENT] = "present",
+    [FRAME_PHASE_SLEEP] = "sleep",     [FRAME_PHASE_TOTAL] = "total",
+};
+
+const char *frame_stats_phase_name(FramePhase phase) {
+  if (phase >= 0 && phase < FRAME_PHASE_COUNT) {
+    return g_frame_phase_names[phase];
+  }
+  return "unknown";
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// RECORDING
+// ═══════════════════════════════════════════════════════════════════════════
+
+void frame_stats_init(void) { g_frame_stats = (FrameStats){0}; }
+
+void frame_stats_phase_begin(void) {
+  g_frame_stats.phase_mark_seconds = de100_get_wall_clock();
+#if DE100_INTERNAL
+  g_frame_stats.phase_mark_cycles = de100_profiler_cycles();
+#endif
+}
+
+void frame_stats_phase_mark(FramePhase phase) {
+  f64 now = de100_get_wall_clock();
+  frame_stats_phase_add(
+      phase, (f32)((now - g_frame_stats.phase_mark_seconds) * 1000.0));
+  g_frame_stats.phase_mark_seconds = now;
+
+#if DE100_INTERNAL
+  // Also a profiler scope, so phases show up on traces and the overlay.
+  // Recorded after the fact, so they don't parent the game's blocks.
+  local_persist_var u32 phase_block_ids[FRAME_PHASE_COUNT];
+  u64 now_cycles = de100_profiler_cycles();
+  if (phase >= 0 && phase < FRAME_PHASE_TOTAL) {
+    de100_profiler_record_scope(&phase_block_ids[phase],
+                                g_frame_phase_names[phase], __FILE__, 0,
+                                g_frame_stats.phase_mark_cycles, now_cycles);
+  }
+  g_frame_stats.phase_mark_cycles = now_cycles;
+#endif
+}
+
+void frame_stats_phase_add(FramePhase phase, f32 ms) {
+  if (phase >= 0 && phase < FRAME_PHASE_TOTAL) {
+    g_frame_stats.phase_ms[phase] += ms;
+  }
 }
 
 void frame_stats_record(f32 frame_time_ms, f32 target_seconds_per_frame) {
@@ -23,12 +71,79 @@ void frame_stats_record(f32 frame_time_ms, f32 target_seconds_per_frame) {
   }
 
   g_frame_stats.total_frame_time_ms += frame_time_ms;
+  g_frame_stats.history_ms[g_frame_stats.history_index] = frame_time_ms;
+  g_frame_stats.history_index =
+      (g_frame_stats.history_index + 1) % FRAME_STATS_HISTORY_COUNT;
 
   if ((frame_time_ms / 1000.0f) > (target_seconds_per_frame + 0.002f)) {
     g_frame_stats.missed_frames++;
+    g_frame_stats.missed_since_report++;
+    if (frame_time_ms > g_frame_stats.worst_since_report_ms) {
+      g_frame_stats.worst_since_report_ms = frame_time_ms;
+    }
+  }
+
+  // Commit this frame's phases
+  for (u32 phase = 0; phase < FRAME_PHASE_TOTAL; ++phase) {
+    frame_histogram_record(&g_frame_stats.phases[phase],
+                           g_frame_stats.phase_ms[phase]);
+    g_frame_stats.phase_ms[phase] = 0.0f;
+  }
+  frame_histogram_record(&g_frame_stats.phases[FRAME_PHASE_TOTAL],
+                         frame_time_ms);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// QUERIES
+// ═══════════════════════════════════════════════════════════════════════════
+
+f32 frame_stats_percentile_ms(FramePhase phase, f32 percentile) {
+  if (phase < 0 || phase >= FRAME_PHASE_COUNT) {
+    return 0.0f;
+  }
+  return frame_histogram_percentile_ms(&g_frame_stats.phases[phase],
+                                       percentile);
+}
+
+FramePhaseSummary frame_stats_summarize(FramePhase phase) {
+  FramePhaseSummary summary = {0};
+  if (phase < 0 || phase >= FRAME_PHASE_COUNT) {
+    return summary;
+  }
+
+  const FrameHistogram *histogram = &g_frame_stats.phases[phase];
+  summary.count = histogram->count;
+  if (histogram->count == 0) {
+    return summary;
+  }
+
+  summary.mean_ms =
+      (f32)((f64)histogram->total_us / (f64)histogram->count / 1000.0);
+  summary.p50_ms = frame_histogram_percentile_ms(histogram, 50.0f);
+  summary.p95_ms = frame_histogram_percentile_ms(histogram, 95.0f);
+  summary.p99_ms = frame_histogram_percentile_ms(histogram, 99.0f);
+  summary.p999_ms = frame_histogram_percentile_ms(histogram, 99.9f);
+  summary.max_ms = (f32)histogram->max_us / 1000.0f;
+  return summary;
+}
+
+void frame_stats_report_missed(void) {
+  if (g_frame_stats.missed_since_report == 0) {
+    return;
   }
+
+  DE100_LOG_WARN(DE100_LOG_TIMING,
+                 "%u missed frame(s) since last report (worst: %.2fms)",
+                 g_frame_stats.missed_since_report,
+                 g_frame_stats.worst_since_report_ms);
+  g_frame_stats.missed_since_report = 0;
+  g_frame_stats.worst_since_report_ms = 0.0f;
 }
 
+// ═══════════════════════════════════════════════════════════════════════════
+// OUTPUT
+// ═══════════════════════════════════════════════════════════════════════════
+
 void frame_stats_print(void) {
   printf("\n═══════════════════════════════════════════════════════════\n");
   printf("📊 FRAME TIME STATISTICS\n");
@@ -40,5 +155,95 @@ void frame_stats_print(void) {
   printf("Max frame time: %.2fms\n", g_frame_stats.max_frame_time_ms);
   printf("Avg frame time: %.2fms\n",
          g_frame_stats.total_frame_time_ms / g_frame_stats.frame_count);
+  printf("───────────────────────────────────────────────────────────\n");
+  printf("%-8s %8s %8s %8s %8s %8s %8s\n", "phase", "mean", "p50", "p95",
+         "p99", "p99.9", "max");
+  for (u32 phase = 0; phase < FRAME_PHASE_COUNT; ++phase) {
+    FramePhaseSummary s = frame_stats_summarize((FramePhase)phase);
+    if (s.count == 0 || s.max_ms == 0.0f) {
+      continue; // Phase not instrumented by this backend
+    }
+    printf("%-8s %8.2f %8.2f %8.2f %8.2f %8.2f %8.2f\n",
+           frame_stats_phase_name((FramePhase)phase), s.mean_ms, s.p50_ms,
+           s.p95_ms, s.p99_ms, s.p999_ms, s.max_ms);
+  }
   printf("═══════════════════════════════════════════════════════════\n");
 }
+
+de100_file_scoped_fn void dump_csv(FILE *file) {
+  fprintf(file, "phase,count,mean_ms,p50_ms,p95_ms,p99_ms,p999_ms,max_ms\n");
+  for (u32 phase = 0; phase < FRAME_PHASE_COUNT; ++phase) {
+    FramePhaseSummary s = frame_stats_summarize((FramePhase)phase);
+    fprintf(file, "%s,%llu,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f\n",
+            frame_stats_phase_name((FramePhase)phase),
+            (unsigned long long)s.count, s.mean_ms, s.p50_ms, s.p95_ms,
+            s.p99_ms, s.p999_ms, s.max_ms);
+  }
+}
+
+de100_file_scoped_fn void dump_json(FILE *file) {
+  fprintf(file, "{\n  \"frame_count\": %u,\n  \"missed_frames\": %u,\n",
+          g_frame_stats.frame_count, g_frame_stats.missed_frames);
+  fprintf(file, "  \"phases\": {\n");
+  for (u32 phase = 0; phase < FRAME_PHASE_COUNT; ++phase) {
+    const FrameHistogram *histogram = &g_frame_stats.phases[phase];
+    FramePhaseSummary s = frame_stats_summarize((FramePhase)phase);
+
+    fprintf(file,
+            "    \"%s\": {\"count\": %llu, \"mean_ms\": %.3f, "
+            "\"p50_ms\": %.3f, \"p95_ms\": %.3f, \"p99_ms\": %.3f, "
+            "\"p999_ms\": %.3f, \"max_ms\": %.3f,\n",
+            frame_stats_phase_name((FramePhase)phase),
+            (unsigned long long)s.count, s.mean_ms, s.p50_ms, s.p95_ms,
+            s.p99_ms, s.p999_ms, s.max_ms);
+
+    // [upper bound in us, count] for every non-empty bucket
+    fprintf(file, "      \"buckets_us\": [");
+    bool first = true;
+    for (u32 i = 0; i < FRAME_HISTOGRAM_BUCKET_COUNT; ++i) {
+      if (histogram->buckets[i] == 0) {
+        continue;
+      }
+      fprintf(file, "%s[%llu, %u]", first ? "" : ", ",
+              (unsigned long long)frame_histogram_bucket_upper(i),
+              histogram->buckets[i]);
+      first = false;
+    }
+    fprintf(file, "]}%s\n", phase + 1 < FRAME_PHASE_COUNT ? "," : "");
+  }
+  fprintf(file, "  }\n}\n");
+}
+
+bool frame_stats_dump(const char *path) {
+  if (!path) {
+    return false;
+  }
+
+  FILE *file = fopen(path, "w");
+  if (!file) {
+    fprintf(stderr, "[FRAME STATS] Failed to open '%s' for writing\n", path);
+    return false;
+  }
+
+  size_t length = strlen(path);
+  if (length >= 4 && strcmp(path + length - 4, ".csv") == 0) {
+    dump_csv(file);
+  } else {
+    dump_json(file);
+  }
+
+  bool ok = ferror(file) == 0;
+  ok = (fclose(file) == 0) && ok;
+  if (ok) {
+    printf("[FRAME STATS] 💾 Wrote %s\n", path);
+  }
+  return ok;
+}
+
+void frame_stats_dump_to_directory(const char *directory) {
+  char path[512];
+  snprintf(path, sizeof(path), "%sframe-stats.json", directory);
+  frame_stats_dump(path);
+  snprintf(path, sizeof(path), "%sframe-stats.csv", directory);
+  frame_stats_dump(path);
+}
@@ -2,6 +2,51 @@
 #define DE100_PLATFORMS__COMMON_FRAME_STATS_H
 
 #include "../../_common/base.h"
+#include "./frame-histogram.h"
+#include <stdbool.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// FRAME STATS (internal builds)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// Per-phase frame time histograms (frame-histogram.h): p99.9 over hours
+// of frames costs a fixed 2KB per phase and O(1) per record.
+//
+// Per frame:
+//   frame_stats_phase_begin()            at frame start
+//   frame_stats_phase_mark(PHASE)        after each phase's work
+//   frame_stats_record(total_ms, target) at frame end (commits phases)
+//
+// Marks are cumulative within a frame, so a phase split over several
+// places in the loop (e.g. event pumping) adds up.
+//
+// frame-stats.c is only built with DE100_INTERNAL; backends use the
+// FRAME_STATS_* macros, which compile away otherwise.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+typedef enum {
+  FRAME_PHASE_INPUT = 0,
+  FRAME_PHASE_UPDATE, // update_and_render
+  FRAME_PHASE_AUDIO,
+  FRAME_PHASE_PRESENT,
+  FRAME_PHASE_SLEEP,
+  FRAME_PHASE_TOTAL, // Whole frame (from frame_stats_record)
+
+  FRAME_PHASE_COUNT
+} FramePhase;
+
+#define FRAME_STATS_HISTORY_COUNT 256 // Recent frames, for graphs
+
+typedef struct {
+  u64 count;
+  f32 mean_ms;
+  f32 p50_ms;
+  f32 p95_ms;
+  f32 p99_ms;
+  f32 p999_ms;
+  f32 max_ms;
+} FramePhaseSummary;
 
 typedef struct {
   u32 frame_count;
@@ -9,6 +54,22 @@ typedef struct {
   f32 min_frame_time_ms;
   f32 max_frame_time_ms;
   f32 total_frame_time_ms;
+
+  FrameHistogram phases[FRAME_PHASE_COUNT];
+
+  // Current frame
+  f64 phase_mark_seconds;
+  u64 phase_mark_cycles; // Same instant, for profiler scopes
+  f32 phase_ms[FRAME_PHASE_COUNT];
+
+  // Ring of the last FRAME_STATS_HISTORY_COUNT frame times;
+  // history_index is the next slot to write
+  f32 history_ms[FRAME_STATS_HISTORY_COUNT];
+  u32 history_index;
+
+  // Rate-limited missed-frame reporting
+  u32 missed_since_report;
+  f32 worst_since_report_ms;
 } FrameStats;
 extern FrameStats g_frame_stats;
 
@@ -16,4 +77,43 @@ void frame_stats_init(void);
 void frame_stats_record(f32 frame_time_ms, f32 target_seconds_per_frame);
 void frame_stats_print(void);
 
+/** Start timing a frame's phases. */
+void frame_stats_phase_begin(void);
+
+/** Attribute the time since the previous mark (or begin) to `phase`. */
+void frame_stats_phase_mark(FramePhase phase);
+
+/** Add a value to a phase directly (e.g. a duration measured elsewhere). */
+void frame_stats_phase_add(FramePhase phase, f32 ms);
+
+/** Percentile (0..100) of a phase so far, in ms. */
+f32 frame_stats_percentile_ms(FramePhase phase, f32 percentile);
+
+FramePhaseSummary frame_stats_summarize(FramePhase phase);
+
+const char *frame_stats_phase_name(FramePhase phase);
+
+/**
+ * Print (once) how many frames missed their target since the last call, if
+ * any. Call at most about once a second.
+ */
+void frame_stats_report_missed(void);
+
+/**
+ * Write the summaries (and JSON: the non-empty buckets) to `path`.
+ * Format follows the extension: ".csv", anything else is JSON.
+ */
+bool frame_stats_dump(const char *path);
+
+/** Write "<directory>frame-stats.json" and ".csv" (backends, on exit). */
+void frame_stats_dump_to_directory(const char *directory);
+
+#if DE100_INTERNAL
+#define FRAME_STATS_PHASE_BEGIN() frame_stats_phase_begin()
+#define FRAME_STATS_PHASE_MARK(phase) frame_stats_phase_mark(phase)
+#else
+#define FRAME_STATS_PHASE_BEGIN()
+#define FRAME_STATS_PHASE_MARK(phase)
+#endif
+
 #endif // DE100_PLATFORMS__COMMON_FRAME_STATS_H
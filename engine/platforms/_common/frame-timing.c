@@ -1,5 +1,6 @@
 
 #include "./frame-timing.h"
+#include "./idle-scheduler.h"
 
 #if DE100_INTERNAL
 #include <x86intrin.h> // For __rdtsc() CPU cycle counter
@@ -9,6 +10,8 @@ FrameTiming g_frame_timing = {0};
 
 void frame_timing_begin(void) {
   de100_get_timespec(&g_frame_timing.frame_start);
+  g_frame_timing.work_start = g_frame_timing.frame_start;
+  g_frame_timing.is_latched = false;
 #if DE100_INTERNAL
   g_frame_timing.start_cycles = __rdtsc();
 #endif
@@ -17,11 +20,36 @@ void frame_timing_begin(void) {
 void frame_timing_mark_work_done(void) {
   de100_get_timespec(&g_frame_timing.work_end);
   g_frame_timing.work_seconds = (f32)de100_timespec_diff_seconds(
-      &g_frame_timing.frame_start, &g_frame_timing.work_end);
+      &g_frame_timing.work_start, &g_frame_timing.work_end);
+
+  if (g_frame_timing.is_latched) {
+    // Longer than predicted: widen fast. Shorter: narrow slowly
+    f32 predicted = g_frame_timing.latch_work_seconds;
+    f32 rate = g_frame_timing.work_seconds > predicted ? 0.5f : 0.02f;
+    g_frame_timing.latch_work_seconds +=
+        (g_frame_timing.work_seconds - predicted) * rate;
+  }
+}
+
+// work_seconds when there was nothing to run
+f32 frame_timing_run_idle_jobs(f32 target_seconds) {
+  g_frame_timing.idle_job_seconds = 0.0f;
+  if (!idle_scheduler_has_jobs(&g_idle_scheduler) ||
+      g_frame_timing.work_seconds >= target_seconds) {
+    return g_frame_timing.work_seconds;
+  }
+
+  De100TimeSpec now;
+  de100_get_timespec(&now);
+  f32 elapsed = (f32)de100_timespec_diff_seconds(&g_frame_timing.frame_start,
+                                                 &now);
+  g_frame_timing.idle_job_seconds =
+      idle_scheduler_run(&g_idle_scheduler, target_seconds - elapsed);
+  return elapsed + g_frame_timing.idle_job_seconds;
 }
 
 void frame_timing_sleep_until_target(f32 target_seconds) {
-  f32 seconds_elapsed = g_frame_timing.work_seconds;
+  f32 seconds_elapsed = frame_timing_run_idle_jobs(target_seconds);
 
   if (seconds_elapsed < target_seconds) {
     f32 sleep_threshold = target_seconds - 0.003f;
@@ -36,16 +64,107 @@ void frame_timing_sleep_until_target(f32 target_seconds) {
           &g_frame_timing.frame_start, &current);
     }
 
-    // Phase 2: Spin-wait
-    while (seconds_elapsed < target_seconds) {
-      De100TimeSpec current;
-      de100_get_timespec(&current);
-      seconds_elapsed = (f32)de100_timespec_diff_seconds(
-          &g_frame_timing.frame_start, &current);
+    // Phase 2: Spin-wait on the CPU counter (one OS clock read to set
+    // the deadline, then a few ns per poll instead of a clock_gettime)
+    if (seconds_elapsed < target_seconds) {
+      u64 deadline = de100_timestamp() + de100_timestamp_from_seconds(
+                                             target_seconds - seconds_elapsed);
+      while (de100_timestamp() < deadline) {
+      }
     }
   }
 }
 
+de100_file_scoped_fn void
+frame_timing_spin_until(const De100TimeSpec *target) {
+  De100TimeSpec current;
+  de100_get_timespec(&current);
+  f64 remaining = de100_timespec_diff_seconds(&current, target);
+  if (remaining <= 0.0) {
+    return;
+  }
+  u64 deadline = de100_timestamp() + de100_timestamp_from_seconds(remaining);
+  while (de100_timestamp() < deadline) {
+  }
+}
+
+de100_file_scoped_fn void frame_timing_learn_overshoot(f32 overshoot) {
+  if (g_frame_timing.wake_overshoot_seconds <= 0.0f) {
+    g_frame_timing.wake_overshoot_seconds =
+        FRAME_TIMING_INITIAL_OVERSHOOT_SECONDS;
+  }
+  if (overshoot < 0.0f) {
+    overshoot = 0.0f;
+  }
+
+  // A late wake means a missed deadline: widen fast, narrow slowly
+  f32 rate = overshoot > g_frame_timing.wake_overshoot_seconds ? 0.5f : 0.02f;
+  g_frame_timing.wake_overshoot_seconds +=
+      (overshoot - g_frame_timing.wake_overshoot_seconds) * rate;
+
+  f32 window = g_frame_timing.wake_overshoot_seconds * 1.25f +
+               FRAME_TIMING_SPIN_MARGIN_SECONDS;
+  if (window < FRAME_TIMING_SPIN_WINDOW_MIN_SECONDS) {
+    window = FRAME_TIMING_SPIN_WINDOW_MIN_SECONDS;
+  }
+  if (window > FRAME_TIMING_SPIN_WINDOW_MAX_SECONDS) {
+    window = FRAME_TIMING_SPIN_WINDOW_MAX_SECONDS;
+  }
+  g_frame_timing.spin_window_seconds = window;
+}
+
+void frame_timing_wait_until_target(f32 target_seconds) {
+  f32 seconds_elapsed = frame_timing_run_idle_jobs(target_seconds);
+  if (seconds_elapsed >= target_seconds) {
+    return;
+  }
+  if (g_frame_timing.spin_window_seconds <= 0.0f) {
+    frame_timing_learn_overshoot(FRAME_TIMING_INITIAL_OVERSHOOT_SECONDS);
+  }
+
+  De100TimeSpec target = de100_timespec_add_seconds(
+      &g_frame_timing.frame_start, (f64)target_seconds);
+  f32 remaining = target_seconds - seconds_elapsed;
+
+  if (remaining > g_frame_timing.spin_window_seconds) {
+    De100TimeSpec wake_at = de100_timespec_add_seconds(
+        &target, -(f64)g_frame_timing.spin_window_seconds);
+    de100_sleep_until_timespec(&wake_at);
+
+    De100TimeSpec woke;
+    de100_get_timespec(&woke);
+    frame_timing_learn_overshoot(
+        (f32)de100_timespec_diff_seconds(&wake_at, &woke));
+  }
+
+  frame_timing_spin_until(&target);
+}
+
+void frame_timing_latch_wait(f32 target_seconds) {
+  if (g_frame_timing.latch_work_seconds <= 0.0f) {
+    // No history: assume half the frame, then learn
+    g_frame_timing.latch_work_seconds = target_seconds * 0.5f;
+  }
+
+  f32 lead =
+      g_frame_timing.latch_work_seconds + FRAME_TIMING_LATCH_MARGIN_SECONDS;
+  if (lead < target_seconds) {
+    De100TimeSpec wake_at = de100_timespec_add_seconds(
+        &g_frame_timing.frame_start, (f64)(target_seconds - lead));
+    de100_sleep_until_timespec(&wake_at);
+  }
+
+  de100_get_timespec(&g_frame_timing.work_start);
+  g_frame_timing.is_latched = true;
+}
+
+void frame_timing_latch_missed(f32 target_seconds) {
+  f32 widened = g_frame_timing.latch_work_seconds * 1.5f +
+                FRAME_TIMING_LATCH_MARGIN_SECONDS;
+  g_frame_timing.latch_work_seconds =
+      widened < target_seconds ? widened : target_seconds;
+}
+
 void frame_timing_end(void) {
   de100_get_timespec(&g_frame_timing.frame_end);
 #if DE100_INTERNAL
@@ -61,6 +180,11 @@ void frame_timing_end(void) {
   //     &g_frame_timing.frame_start, &g_frame_timing.frame_end);
 }
 
+void frame_timing_use_present_interval(f32 present_seconds) {
+  g_frame_timing.total_seconds = present_seconds;
+  g_frame_timing.sleep_seconds = present_seconds - g_frame_timing.work_seconds;
+}
+
 f32 frame_timing_get_ms(void) { return g_frame_timing.total_seconds * 1000.0f; }
 
 f32 frame_timing_get_fps(void) { return 1.0f / g_frame_timing.total_seconds; }
@@ -6,12 +6,20 @@
 
 typedef struct {
   De100TimeSpec frame_start;
+  De100TimeSpec work_start; // frame_start, or the end of the latch wait
   De100TimeSpec work_end;
   De100TimeSpec frame_end;
   f32 work_seconds;
   f32 total_seconds;
   // f32 total_ms;
   f32 sleep_seconds;
+  f32 idle_job_seconds; // Slack spent on idle jobs (idle-scheduler.h)
+  // High-resolution pacing calibration (frame_timing_wait_until_target)
+  f32 wake_overshoot_seconds; // Learned OS timer lateness
+  f32 spin_window_seconds;    // Tail spun instead of slept
+  // Late input latch (frame_timing_latch_wait)
+  f32 latch_work_seconds; // Predicted input→swap time
+  bool is_latched;        // This frame waited before sampling input
 #if DE100_INTERNAL
   u64 start_cycles;
   u64 end_cycles;
@@ -23,10 +31,72 @@ void frame_timing_begin(void);
 
 void frame_timing_mark_work_done(void);
 
+// Sleep 1ms at a time, then spin the last 3ms (burns most of a core).
+// Both waits run queued idle jobs in the slack first (idle-scheduler.h).
 void frame_timing_sleep_until_target(f32 target_seconds);
 
+// Hand the slack to idle jobs; returns the seconds elapsed since
+// frame_start afterwards. For waits of a backend's own.
+f32 frame_timing_run_idle_jobs(f32 target_seconds);
+
+// ─────────────────────────────────────────────────────────────────────────────
+// High-resolution pacing
+// ─────────────────────────────────────────────────────────────────────────────
+//
+// One absolute high-resolution sleep (de100_sleep_until_timespec) to
+// `target - spin_window`, then spin only what's left:
+//
+//   frame_start        work_end          wake       target
+//   |██████ work ██████|░░░░░ sleep ░░░░░|~ spin ~|
+//                                        ↑ target - spin_window
+//
+// Each wake measures how late the OS timer fired; the spin window tracks
+// that overshoot (fast attack, slow decay) plus a margin, capped below 1ms.
+// On a quiet machine this settles at ~100-200us of spin per frame.
+//
+// ─────────────────────────────────────────────────────────────────────────────
+
+#define FRAME_TIMING_SPIN_WINDOW_MIN_SECONDS 0.00005f // 50us
+#define FRAME_TIMING_SPIN_WINDOW_MAX_SECONDS 0.0009f  // 0.9ms
+#define FRAME_TIMING_SPIN_MARGIN_SECONDS 0.00005f
+#define FRAME_TIMING_INITIAL_OVERSHOOT_SECONDS 0.0002f
+
+void frame_timing_wait_until_target(f32 target_seconds);
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Late input latch
+// ─────────────────────────────────────────────────────────────────────────────
+//
+// Flip-paced, the loop wakes at a vblank, samples input, simulates and
+// swaps - but the swap only reaches the screen at the NEXT vblank, so the
+// input is up to a whole frame old by then. Latching late sleeps first:
+//
+//   vblank                                          vblank
+//   |░░░░░░░░░░░ sleep ░░░░░░░░░░░|input|work|swap|  |
+//                                 ↑ target - predicted work - margin
+//
+// The prediction follows the measured input→swap time (fast attack, slow
+// decay); a missed flip widens it. work_seconds starts after the wait, so
+// frame stats and adaptive FPS still see the real load.
+//
+// Sleep-paced frames don't need it: their sleep already ends right before
+// input is sampled.
+//
+// ─────────────────────────────────────────────────────────────────────────────
+
+#define FRAME_TIMING_LATCH_MARGIN_SECONDS 0.001f // 1ms
+
+// Call after frame_timing_begin(), before sampling input
+void frame_timing_latch_wait(f32 target_seconds);
+// The frame missed its flip: predict more work next time
+void frame_timing_latch_missed(f32 target_seconds);
+
 void frame_timing_end(void);
 
+// Replace the measured frame time with the display's flip-to-flip interval
+// (vblank timestamps), after frame_timing_end(). Keeps work_seconds.
+void frame_timing_use_present_interval(f32 present_seconds);
+
 f32 frame_timing_get_ms(void);
 
 f32 frame_timing_get_fps(void);
@@ -0,0 +1,120 @@
+#include "./idle-scheduler.h"
+
+#include "../../_common/time.h"
+
+De100IdleScheduler g_idle_scheduler = {0};
+
+// ═══════════════════════════════════════════════════════════════════════════
+// QUEUE
+// ═══════════════════════════════════════════════════════════════════════════
+
+DE100_PLATFORM_IDLE_JOB_SUBMIT(idle_scheduler_submit) {
+  if (!scheduler || !job || !job->callback ||
+      job->status == DE100_IDLE_JOB_STATUS_QUEUED ||
+      scheduler->count >= IDLE_SCHEDULER_MAX_JOBS) {
+    return false;
+  }
+
+  job->status = DE100_IDLE_JOB_STATUS_QUEUED;
+  job->slice_count = 0;
+  scheduler->entries[scheduler->count++] = (IdleSchedulerEntry){
+      .job = job,
+      .slice_seconds = IDLE_SCHEDULER_INITIAL_SLICE_SECONDS,
+  };
+  return true;
+}
+
+// Drop finished and cancelled jobs, keeping submission order
+de100_file_scoped_fn void
+idle_scheduler_compact(De100IdleScheduler *scheduler) {
+  u32 kept = 0;
+  for (u32 i = 0; i < scheduler->count; ++i) {
+    if (scheduler->entries[i].job->status == DE100_IDLE_JOB_STATUS_QUEUED) {
+      scheduler->entries[kept++] = scheduler->entries[i];
+    } else if (i < scheduler->next) {
+      --scheduler->next;
+    }
+  }
+  scheduler->count = kept;
+}
+
+void idle_scheduler_cancel_all(De100IdleScheduler *scheduler) {
+  for (u32 i = 0; i < scheduler->count; ++i) {
+    scheduler->entries[i].job->status = DE100_IDLE_JOB_STATUS_CANCELLED;
+  }
+  scheduler->count = 0;
+  scheduler->next = 0;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// RUN
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn void idle_scheduler_learn(IdleSchedulerEntry *entry,
+                                               f32 seconds) {
+  // Overran its prediction: trust the new time. Faster: drift down
+  if (seconds > entry->slice_seconds) {
+    entry->slice_seconds = seconds;
+  } else {
+    entry->slice_seconds += (seconds - entry->slice_seconds) * 0.1f;
+  }
+}
+
+f32 idle_scheduler_run(De100IdleScheduler *scheduler, f32 budget_seconds) {
+  scheduler->last_busy_seconds = 0.0f;
+  scheduler->last_slice_count = 0;
+  if (budget_seconds <= IDLE_SCHEDULER_MARGIN_SECONDS) {
+    return 0.0f;
+  }
+
+  u64 start = de100_timestamp();
+  u64 deadline = start + de100_timestamp_from_seconds(
+                             budget_seconds - IDLE_SCHEDULER_MARGIN_SECONDS);
+  u64 now = start;
+
+  for (;;) {
+    idle_scheduler_compact(scheduler);
+    if (scheduler->count == 0) {
+      scheduler->next = 0;
+      break;
+    }
+
+    // Next job in turn whose predicted slice still fits
+    IdleSchedulerEntry *entry = NULL;
+    for (u32 tried = 0; tried < scheduler->count; ++tried) {
+      u32 index = (scheduler->next + tried) % scheduler->count;
+      IdleSchedulerEntry *candidate = &scheduler->entries[index];
+      if (now + de100_timestamp_from_seconds(candidate->slice_seconds) <=
+          deadline) {
+        entry = candidate;
+        scheduler->next = index + 1;
+        break;
+      }
+    }
+    if (!entry) {
+      break;
+    }
+
+    De100IdleJob *job = entry->job;
+    bool is_done = job->callback(job);
+    u64 end = de100_timestamp();
+
+    idle_scheduler_learn(entry,
+                         (f32)de100_timestamp_seconds_between(now, end));
+    ++job->slice_count;
+    ++scheduler->last_slice_count;
+    if (end > deadline) {
+      ++scheduler->overrun_count;
+    }
+    // The callback may have cancelled itself
+    if (is_done && job->status == DE100_IDLE_JOB_STATUS_QUEUED) {
+      job->status = DE100_IDLE_JOB_STATUS_COMPLETE;
+    }
+    now = end;
+  }
+
+  scheduler->total_slice_count += scheduler->last_slice_count;
+  scheduler->last_busy_seconds =
+      (f32)de100_timestamp_seconds_between(start, now);
+  return scheduler->last_busy_seconds;
+}
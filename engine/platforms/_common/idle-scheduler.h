@@ -0,0 +1,73 @@
+#ifndef DE100_PLATFORMS__COMMON_IDLE_SCHEDULER_H
+#define DE100_PLATFORMS__COMMON_IDLE_SCHEDULER_H
+
+#include "../../_common/base.h"
+#include "../../game/idle-job.h"
+
+#include <stdbool.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// IDLE SCHEDULER (idle jobs in the frame's slack, shared by all backends)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// frame_timing_sleep_until_target / frame_timing_wait_until_target hand
+// the slack to idle_scheduler_run() before they sleep, so every
+// sleep-paced backend runs idle jobs without a change of its own.
+//
+// Per job, the scheduler keeps a predicted slice time: a slice that took
+// longer replaces it at once, shorter ones pull it down slowly (the
+// learned-overshoot rule of frame-timing.h). A slice starts only if
+// `now + predicted + IDLE_SCHEDULER_MARGIN_SECONDS` is before the
+// deadline; jobs that don't fit are skipped for the ones that do. The
+// margin covers the sleep's own wake-up lateness and a mispredicted slice.
+// A job's first slice runs on IDLE_SCHEDULER_INITIAL_SLICE_SECONDS, a
+// guess: keep slices short and even.
+//
+// Main thread only, no locks: submit from game update, run from the
+// frame loop. One scheduler per process (g_idle_scheduler).
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define IDLE_SCHEDULER_MAX_JOBS 32
+#define IDLE_SCHEDULER_MARGIN_SECONDS 0.0005f        // 0.5ms
+#define IDLE_SCHEDULER_INITIAL_SLICE_SECONDS 0.0005f // Until measured
+
+typedef struct {
+  De100IdleJob *job;
+  f32 slice_seconds; // Predicted
+} IdleSchedulerEntry;
+
+struct De100IdleScheduler {
+  IdleSchedulerEntry entries[IDLE_SCHEDULER_MAX_JOBS]; // Submission order
+  u32 count;
+  u32 next; // Round-robin cursor
+
+  // Last idle_scheduler_run(), and totals since startup
+  f32 last_busy_seconds;
+  u32 last_slice_count;
+  u64 total_slice_count;
+  u64 overrun_count; // Slices that ended past the deadline
+};
+
+extern De100IdleScheduler g_idle_scheduler;
+
+/** Queue `job` (DE100_PLATFORM_IDLE_JOB_SUBMIT, handed to the game). */
+DE100_PLATFORM_IDLE_JOB_SUBMIT(idle_scheduler_submit);
+
+/**
+ * Run slices until the next predicted one would end within the margin of
+ * `budget_seconds` from now, or no job is left.
+ *
+ * @return seconds spent in slices
+ */
+f32 idle_scheduler_run(De100IdleScheduler *scheduler, f32 budget_seconds);
+
+/** Cancel every queued job (hot reload barrier). */
+void idle_scheduler_cancel_all(De100IdleScheduler *scheduler);
+
+de100_file_scoped_fn inline bool
+idle_scheduler_has_jobs(const De100IdleScheduler *scheduler) {
+  return scheduler->count > 0;
+}
+
+#endif // DE100_PLATFORMS__COMMON_IDLE_SCHEDULER_H
@@ -0,0 +1,109 @@
+#include "./input-latency.h"
+#include "../../_common/time.h"
+#include "./trace-export.h"
+
+#include <stdio.h>
+
+InputLatency g_input_latency = {0};
+
+de100_file_scoped_global_var const char
+    *g_input_latency_stage_names[INPUT_LATENCY_STAGE_COUNT] = {
+        [INPUT_LATENCY_UPDATE] = "update",
+        [INPUT_LATENCY_RENDER] = "render",
+        [INPUT_LATENCY_UPLOAD] = "upload",
+        [INPUT_LATENCY_PRESENT] = "present",
+        [INPUT_LATENCY_AUDIO] = "audio",
+};
+
+// Trace counter names; the exporter matches them by pointer
+de100_file_scoped_global_var const char
+    *g_input_latency_trace_names[INPUT_LATENCY_STAGE_COUNT] = {
+        [INPUT_LATENCY_UPDATE] = "input to update ms",
+        [INPUT_LATENCY_RENDER] = "input to render ms",
+        [INPUT_LATENCY_UPLOAD] = "input to upload ms",
+        [INPUT_LATENCY_PRESENT] = "input to present ms",
+        [INPUT_LATENCY_AUDIO] = "input to audio ms",
+};
+
+const char *input_latency_stage_name(InputLatencyStage stage) {
+  if (stage < INPUT_LATENCY_STAGE_COUNT) {
+    return g_input_latency_stage_names[stage];
+  }
+  return "unknown";
+}
+
+void input_latency_begin_frame(const GameInput *input, bool is_pipelined) {
+  InputLatency *latency = &g_input_latency;
+
+  // Events are oldest first
+  f64 oldest = input->event_count > 0 ? input->events[0].seconds : 0.0;
+  latency->simulated_input_seconds = oldest;
+  if (is_pipelined) {
+    latency->shown_input_seconds = latency->pending_input_seconds;
+    latency->pending_input_seconds = oldest;
+  } else {
+    latency->shown_input_seconds = oldest;
+    latency->pending_input_seconds = 0.0;
+  }
+  latency->recorded_stages = 0;
+}
+
+void input_latency_mark_at(InputLatencyStage stage, f64 seconds) {
+  InputLatency *latency = &g_input_latency;
+  u32 bit = 1u << stage;
+  if (stage >= INPUT_LATENCY_STAGE_COUNT || (latency->recorded_stages & bit)) {
+    return;
+  }
+
+  bool is_simulated = stage == INPUT_LATENCY_UPDATE ||
+                      stage == INPUT_LATENCY_AUDIO;
+  f64 input_seconds = is_simulated ? latency->simulated_input_seconds
+                                   : latency->shown_input_seconds;
+  // No input, or a timestamp from another clock (a driver's UST that
+  // isn't CLOCK_MONOTONIC): nothing meaningful to record
+  if (input_seconds <= 0.0 || seconds < input_seconds ||
+      seconds - input_seconds > 10.0) {
+    return;
+  }
+
+  f32 ms = (f32)((seconds - input_seconds) * 1000.0);
+  latency->recorded_stages |= bit;
+  latency->last_ms[stage] = ms;
+  frame_histogram_record(&latency->stages[stage], ms);
+  trace_export_counter(g_input_latency_trace_names[stage], (f64)ms);
+}
+
+void input_latency_mark(InputLatencyStage stage) {
+  input_latency_mark_at(stage, de100_get_wall_clock());
+}
+
+f32 input_latency_percentile_ms(InputLatencyStage stage, f32 percentile) {
+  if (stage >= INPUT_LATENCY_STAGE_COUNT) {
+    return 0.0f;
+  }
+  return frame_histogram_percentile_ms(&g_input_latency.stages[stage],
+                                       percentile);
+}
+
+void input_latency_print(void) {
+  printf("\n═══════════════════════════════════════════════════════════\n");
+  printf("🎯 INPUT LATENCY (oldest event of the frame → stage)\n");
+  printf("═══════════════════════════════════════════════════════════\n");
+  printf("%-8s %8s %8s %8s %8s %8s %8s\n", "stage", "frames", "mean",
+         "p50", "p95", "p99", "max");
+  for (u32 stage = 0; stage < INPUT_LATENCY_STAGE_COUNT; ++stage) {
+    const FrameHistogram *histogram = &g_input_latency.stages[stage];
+    if (histogram->count == 0) {
+      continue; // Not reached by this backend / presenter
+    }
+    printf("%-8s %8llu %8.2f %8.2f %8.2f %8.2f %8.2f\n",
+           input_latency_stage_name((InputLatencyStage)stage),
+           (unsigned long long)histogram->count,
+           (f32)histogram->total_us / (f32)histogram->count / 1000.0f,
+           frame_histogram_percentile_ms(histogram, 50.0f),
+           frame_histogram_percentile_ms(histogram, 95.0f),
+           frame_histogram_percentile_ms(histogram, 99.0f),
+           (f32)histogram->max_us / 1000.0f);
+  }
+  printf("═══════════════════════════════════════════════════════════\n");
+}
@@ -0,0 +1,92 @@
+#ifndef DE100_PLATFORMS__COMMON_INPUT_LATENCY_H
+#define DE100_PLATFORMS__COMMON_INPUT_LATENCY_H
+
+#include "../../_common/base.h"
+#include "../../game/inputs.h"
+#include "./frame-histogram.h"
+#include <stdbool.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// INPUT LATENCY (internal builds)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// Input-to-photon and input-to-audio distributions, to put numbers on
+// late latching, the present thread and the audio ring. Each frame is
+// tagged with the timestamp of the OLDEST input event it consumed
+// (GameInput.events[0], wall-clock timebase), and every stage it passes
+// records "stage time - input time" in a histogram (frame-histogram.h):
+//
+//   event ─┬─ UPDATE    simulation that consumed it finished
+//          ├─ RENDER    backbuffer holding its result finished
+//          ├─ UPLOAD    handed to the presenter (swap issued, thread
+//          │            submit, XShmPutImage)
+//          ├─ PRESENT   on screen: the flip's UST (GLX_OML_sync_control),
+//          │            else glFinish after the swap; flip-paced only
+//          └─ AUDIO     first sample written after it audible (write time
+//                       + audio queued ahead of it)
+//
+// Frames without input record nothing. With pipelined render the frame
+// shown is the previous one's simulation, so RENDER / UPLOAD / PRESENT
+// use the previous frame's tag.
+//
+// The debug overlay draws PRESENT (or UPLOAD) and AUDIO as a bar; the
+// newest samples go to the trace export as counters; the summary table
+// is printed on exit.
+//
+// input-latency.c is only built with DE100_INTERNAL; backends use the
+// INPUT_LATENCY_* macros, which compile away otherwise.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+typedef enum {
+  INPUT_LATENCY_UPDATE = 0,
+  INPUT_LATENCY_RENDER,
+  INPUT_LATENCY_UPLOAD,
+  INPUT_LATENCY_PRESENT,
+  INPUT_LATENCY_AUDIO,
+
+  INPUT_LATENCY_STAGE_COUNT
+} InputLatencyStage;
+
+typedef struct {
+  FrameHistogram stages[INPUT_LATENCY_STAGE_COUNT];
+  f32 last_ms[INPUT_LATENCY_STAGE_COUNT]; // Newest sample per stage
+
+  // Oldest consumed input (0 = none): of the frame being simulated, the
+  // one simulated but not rasterized yet (pipelined), and the one shown
+  f64 simulated_input_seconds;
+  f64 pending_input_seconds;
+  f64 shown_input_seconds;
+  u32 recorded_stages; // Bit per stage, this frame
+} InputLatency;
+extern InputLatency g_input_latency;
+
+/** After the input pump: tag this frame with its oldest event. */
+void input_latency_begin_frame(const GameInput *input, bool is_pipelined);
+
+/** The frame reached `stage` now. Once per stage per frame. */
+void input_latency_mark(InputLatencyStage stage);
+
+/** The frame reached `stage` at `seconds` (wall-clock timebase). */
+void input_latency_mark_at(InputLatencyStage stage, f64 seconds);
+
+/** Percentile (0..100) of a stage so far, in ms; 0 when empty. */
+f32 input_latency_percentile_ms(InputLatencyStage stage, f32 percentile);
+
+const char *input_latency_stage_name(InputLatencyStage stage);
+
+void input_latency_print(void);
+
+#if DE100_INTERNAL
+#define INPUT_LATENCY_BEGIN_FRAME(input, is_pipelined)                         \
+  input_latency_begin_frame(input, is_pipelined)
+#define INPUT_LATENCY_MARK(stage) input_latency_mark(stage)
+#define INPUT_LATENCY_MARK_AT(stage, seconds)                                  \
+  input_latency_mark_at(stage, seconds)
+#else
+#define INPUT_LATENCY_BEGIN_FRAME(input, is_pipelined)
+#define INPUT_LATENCY_MARK(stage)
+#define INPUT_LATENCY_MARK_AT(stage, seconds)
+#endif
+
+#endif // DE100_PLATFORMS__COMMON_INPUT_LATENCY_H
@@ -0,0 +1,506 @@
+#include "./input-stream.h"
+#include "./async-io.h"
+
+#include <stdio.h>
+#include <string.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ERROR MESSAGES
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_global_var const char *g_input_stream_error_messages[] = {
+    [INPUT_STREAM_SUCCESS] = "Success",
+    [INPUT_STREAM_ERROR_NULL_POINTER] = "NULL stream, path or frame",
+    [INPUT_STREAM_ERROR_OUT_OF_MEMORY] = "Failed to allocate write chunks",
+    [INPUT_STREAM_ERROR_WRITE_FAILED] = "Failed to write input stream",
+    [INPUT_STREAM_ERROR_READ_FAILED] = "Failed to map input stream",
+    [INPUT_STREAM_ERROR_BAD_HEADER] = "Not an input stream",
+    [INPUT_STREAM_ERROR_VERSION_MISMATCH] = "Unsupported input stream version",
+    [INPUT_STREAM_ERROR_SIZE_MISMATCH] =
+        "Input stream does not match this game's input layout",
+    [INPUT_STREAM_ERROR_CORRUPT] = "Input stream is truncated or corrupt",
+};
+
+const char *input_stream_strerror(InputStreamErrorCode code) {
+  if (code >= 0 && code < INPUT_STREAM_ERROR_COUNT) {
+    return g_input_stream_error_messages[code];
+  }
+  return "Unknown input stream error";
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// INTERNAL HELPERS
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define INPUT_STREAM_WORD_COUNT (sizeof(GameInput) / sizeof(u32))
+#define INPUT_STREAM_BLOCK_WORDS 32
+#define INPUT_STREAM_BLOCK_COUNT                                               \
+  ((INPUT_STREAM_WORD_COUNT + INPUT_STREAM_BLOCK_WORDS - 1) /                  \
+   INPUT_STREAM_BLOCK_WORDS)
+
+// tag + block mask + a word mask per block + every word + state hash
+#define INPUT_STREAM_MAX_RECORD_SIZE                                           \
+  (10 + 10 + INPUT_STREAM_BLOCK_COUNT * 5 + sizeof(GameInput) + sizeof(u64))
+
+_Static_assert(sizeof(GameInput) % sizeof(u32) == 0,
+               "GameInput must be whole u32 words");
+_Static_assert(INPUT_STREAM_BLOCK_COUNT <= 64,
+               "GameInput too big for a 64-bit block mask");
+_Static_assert(sizeof(InputStreamHeader) + INPUT_STREAM_MAX_RECORD_SIZE <=
+                   INPUT_STREAM_CHUNK_SIZE,
+               "A record must fit in one chunk");
+
+de100_file_scoped_fn inline InputStreamResult
+make_result(bool success, InputStreamErrorCode code) {
+  return (InputStreamResult){.success = success, .error_code = code};
+}
+
+de100_file_scoped_fn inline u32 put_varint(u8 *out, u64 value) {
+  u32 size = 0;
+  while (value >= 0x80) {
+    out[size++] = (u8)(value | 0x80);
+    value >>= 7;
+  }
+  out[size++] = (u8)value;
+  return size;
+}
+
+de100_file_scoped_fn inline bool get_varint(const u8 *data, u64 size,
+                                            u64 *cursor, u64 *out) {
+  u64 value = 0;
+  for (u32 shift = 0; shift < 64 && *cursor < size; shift += 7) {
+    u8 byte = data[(*cursor)++];
+    value |= (u64)(byte & 0x7F) << shift;
+    if (!(byte & 0x80)) {
+      *out = value;
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * Bit patterns of the tick window predicted from the frame before:
+ * start = last end, end = start + last span.
+ */
+de100_file_scoped_fn inline void predict_ticks(const GameInput *previous,
+                                               u64 predicted[2]) {
+  f64 start = previous->tick_end_seconds;
+  f64 end =
+      start + (previous->tick_end_seconds - previous->tick_start_seconds);
+  memcpy(predicted, &start, sizeof(u64));
+  memcpy(predicted + 1, &end, sizeof(u64));
+}
+
+/**
+ * Real times ↔ residuals. Bitwise, so the round trip is exact.
+ */
+de100_file_scoped_fn inline void xor_ticks(GameInput *frame,
+                                           const u64 predicted[2]) {
+  u64 bits[2];
+  memcpy(bits, &frame->tick_start_seconds, sizeof(u64));
+  memcpy(bits + 1, &frame->tick_end_seconds, sizeof(u64));
+  bits[0] ^= predicted[0];
+  bits[1] ^= predicted[1];
+  memcpy(&frame->tick_start_seconds, bits, sizeof(u64));
+  memcpy(&frame->tick_end_seconds, bits + 1, sizeof(u64));
+}
+
+/**
+ * Walk one record's changes, writing them into `words` (NULL = skip).
+ */
+de100_file_scoped_fn bool decode_changes(const u8 *data, u64 size,
+                                         u64 *cursor, u32 *words) {
+  u64 block_mask;
+  if (!get_varint(data, size, cursor, &block_mask)) {
+    return false;
+  }
+
+  while (block_mask) {
+    u32 block = (u32)__builtin_ctzll(block_mask);
+    block_mask &= block_mask - 1;
+
+    u64 word_mask;
+    if (block >= INPUT_STREAM_BLOCK_COUNT ||
+        !get_varint(data, size, cursor, &word_mask) ||
+        word_mask >> INPUT_STREAM_BLOCK_WORDS) {
+      return false;
+    }
+
+    while (word_mask) {
+      u32 word = block * INPUT_STREAM_BLOCK_WORDS +
+                 (u32)__builtin_ctzll(word_mask);
+      word_mask &= word_mask - 1;
+      if (word >= INPUT_STREAM_WORD_COUNT || size - *cursor < sizeof(u32)) {
+        return false;
+      }
+      if (words) {
+        memcpy(words + word, data + *cursor, sizeof(u32));
+      }
+      *cursor += sizeof(u32);
+    }
+  }
+  return true;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// WRITER
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn inline u8 *writer_chunk(InputStreamWriter *writer,
+                                             u32 index) {
+  return (u8 *)writer->chunks.base + (u64)index * INPUT_STREAM_CHUNK_SIZE;
+}
+
+de100_file_scoped_fn inline bool write_sync(InputStreamWriter *writer,
+                                            const void *data, u64 size,
+                                            u64 offset) {
+  return de100_file_seek(writer->fd, (i64)offset, DE100_SEEK_SET).success &&
+         de100_file_write_all(writer->fd, data, (size_t)size).success;
+}
+
+/**
+ * Wait for a chunk's previous write (if any) so it can be refilled.
+ */
+de100_file_scoped_fn void reclaim_chunk(InputStreamWriter *writer,
+                                        u32 index) {
+  De100AsyncIORequest *request = &writer->requests[index];
+  if (__atomic_load_n(&request->status, __ATOMIC_ACQUIRE) ==
+      DE100_ASYNC_IO_STATUS_PENDING) {
+    async_io_wait(writer->io, request);
+  }
+  if (request->status == DE100_ASYNC_IO_STATUS_FAILED) {
+    writer->failed = true;
+  }
+  request->status = DE100_ASYNC_IO_STATUS_IDLE;
+}
+
+/**
+ * Hand the chunk being filled to the I/O queue and move to the next one.
+ */
+de100_file_scoped_fn void submit_chunk(InputStreamWriter *writer) {
+  if (writer->chunk_used == 0) {
+    return;
+  }
+
+  u8 *chunk = writer_chunk(writer, writer->chunk_index);
+  De100AsyncIORequest *request = &writer->requests[writer->chunk_index];
+  bool submitted = false;
+  if (writer->io) {
+    *request = (De100AsyncIORequest){
+        .op = DE100_ASYNC_IO_OP_WRITE,
+        .path = writer->path,
+        .buffer = chunk,
+        .offset = writer->file_offset,
+        .size = writer->chunk_used,
+    };
+    submitted = async_io_submit(writer->io, request);
+  }
+  if (!submitted) {
+    // No queue, or it's full: this frame pays for one write
+    request->status = DE100_ASYNC_IO_STATUS_IDLE;
+    if (!write_sync(writer, chunk, writer->chunk_used, writer->file_offset)) {
+      writer->failed = true;
+    }
+  }
+
+  writer->file_offset += writer->chunk_used;
+  writer->chunk_used = 0;
+  writer->chunk_index = (writer->chunk_index + 1) % INPUT_STREAM_CHUNK_COUNT;
+  reclaim_chunk(writer, writer->chunk_index);
+}
+
+/**
+ * Append `repeats` + the changes from previous_coded to `coded`
+ * (+ the state hash, if any).
+ */
+de100_file_scoped_fn void write_record(InputStreamWriter *writer,
+                                       u64 repeats, const GameInput *coded,
+                                       const u64 *state_hash) {
+  if (writer->chunk_used + INPUT_STREAM_MAX_RECORD_SIZE >
+      INPUT_STREAM_CHUNK_SIZE) {
+    submit_chunk(writer);
+  }
+
+  const u32 *words = (const u32 *)coded;
+  const u32 *previous_words = (const u32 *)&writer->previous_coded;
+
+  u32 word_masks[INPUT_STREAM_BLOCK_COUNT];
+  u64 block_mask = 0;
+  for (u32 block = 0; block < INPUT_STREAM_BLOCK_COUNT; ++block) {
+    u32 first = block * INPUT_STREAM_BLOCK_WORDS;
+    u32 count = INPUT_STREAM_WORD_COUNT - first < INPUT_STREAM_BLOCK_WORDS
+                    ? (u32)(INPUT_STREAM_WORD_COUNT - first)
+                    : INPUT_STREAM_BLOCK_WORDS;
+    u32 mask = 0;
+    for (u32 i = 0; i < count; ++i) {
+      mask |= (u32)(words[first + i] != previous_words[first + i]) << i;
+    }
+    word_masks[block] = mask;
+    block_mask |= (u64)(mask != 0) << block;
+  }
+
+  u8 *out = writer_chunk(writer, writer->chunk_index) + writer->chunk_used;
+  u8 *start = out;
+  out += put_varint(out, repeats << 1 | (state_hash != NULL));
+  out += put_varint(out, block_mask);
+  for (u64 blocks = block_mask; blocks; blocks &= blocks - 1) {
+    u32 block = (u32)__builtin_ctzll(blocks);
+    out += put_varint(out, word_masks[block]);
+    for (u32 mask = word_masks[block]; mask; mask &= mask - 1) {
+      u32 word = block * INPUT_STREAM_BLOCK_WORDS + (u32)__builtin_ctz(mask);
+      memcpy(out, words + word, sizeof(u32));
+      out += sizeof(u32);
+    }
+  }
+  if (state_hash) {
+    memcpy(out, state_hash, sizeof(u64));
+    out += sizeof(u64);
+  }
+  writer->chunk_used += (u32)(out - start);
+}
+
+InputStreamResult input_stream_writer_begin(InputStreamWriter *writer,
+                                            const char *path, i32 fd,
+                                            De100AsyncIO *io) {
+  if (!writer || !path) {
+    return make_result(false, INPUT_STREAM_ERROR_NULL_POINTER);
+  }
+
+  *writer = (InputStreamWriter){0};
+  writer->chunks =
+      de100_memory_alloc(NULL, INPUT_STREAM_CHUNK_SIZE * INPUT_STREAM_CHUNK_COUNT,
+                         De100_MEMORY_FLAG_RW);
+  if (!de100_memory_is_valid(writer->chunks)) {
+    return make_result(false, INPUT_STREAM_ERROR_OUT_OF_MEMORY);
+  }
+
+  writer->io = io;
+  writer->fd = fd;
+  snprintf(writer->path, sizeof(writer->path), "%s", path);
+
+  InputStreamHeader header = {
+      .magic = INPUT_STREAM_MAGIC,
+      .version = INPUT_STREAM_VERSION,
+      .frame_size = sizeof(GameInput),
+  };
+  memcpy(writer_chunk(writer, 0), &header, sizeof(header));
+  writer->chunk_used = sizeof(header);
+  writer->is_open = true;
+  return make_result(true, INPUT_STREAM_SUCCESS);
+}
+
+InputStreamResult input_stream_writer_push(InputStreamWriter *writer,
+                                           const GameInput *input,
+                                           const u64 *state_hash) {
+  if (!writer || !input || !writer->is_open) {
+    return make_result(false, INPUT_STREAM_ERROR_NULL_POINTER);
+  }
+  if (writer->failed) {
+    return make_result(false, INPUT_STREAM_ERROR_WRITE_FAILED);
+  }
+
+  // Event slots past event_count hold stale events from older frames
+  GameInput frame = *input;
+  u32 used = frame.event_count < DE100_INPUT_EVENT_CAPACITY
+                 ? frame.event_count
+                 : DE100_INPUT_EVENT_CAPACITY;
+  memset(frame.events + used, 0,
+         (DE100_INPUT_EVENT_CAPACITY - used) * sizeof(GameInputEvent));
+
+  // Nothing to place in the window: snap it to the prediction, so the
+  // residual is zero and an idle frame repeats the last one
+  u64 predicted[2];
+  predict_ticks(&writer->previous, predicted);
+  if (used == 0) {
+    memcpy(&frame.tick_start_seconds, predicted, sizeof(u64));
+    memcpy(&frame.tick_end_seconds, predicted + 1, sizeof(u64));
+  }
+
+  GameInput coded = frame;
+  xor_ticks(&coded, predicted);
+
+  // A hash needs a record of its own, even for an unchanged frame
+  if (!state_hash &&
+      memcmp(&coded, &writer->previous_coded, sizeof(GameInput)) == 0) {
+    ++writer->pending_repeats;
+  } else {
+    write_record(writer, writer->pending_repeats, &coded, state_hash);
+    writer->pending_repeats = 0;
+    writer->previous_coded = coded;
+  }
+  writer->previous = frame;
+
+  ++writer->frame_count;
+  return writer->failed ? make_result(false, INPUT_STREAM_ERROR_WRITE_FAILED)
+                        : make_result(true, INPUT_STREAM_SUCCESS);
+}
+
+InputStreamResult input_stream_writer_end(InputStreamWriter *writer) {
+  if (!writer || !writer->is_open) {
+    return make_result(true, INPUT_STREAM_SUCCESS);
+  }
+
+  // A record with no changes is one more repeat
+  if (writer->pending_repeats > 0) {
+    write_record(writer, writer->pending_repeats - 1,
+                 &writer->previous_coded, NULL);
+    writer->pending_repeats = 0;
+  }
+  submit_chunk(writer);
+  for (u32 i = 0; i < INPUT_STREAM_CHUNK_COUNT; ++i) {
+    reclaim_chunk(writer, i);
+  }
+
+  de100_memory_free(&writer->chunks);
+  writer->is_open = false;
+  return writer->failed ? make_result(false, INPUT_STREAM_ERROR_WRITE_FAILED)
+                        : make_result(true, INPUT_STREAM_SUCCESS);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// READER
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn inline void reader_rewind(InputStreamReader *reader) {
+  reader->cursor = 0;
+  reader->repeats_left = 0;
+  reader->has_frame = false;
+  reader->has_hash = false;
+  reader->frame_has_hash = false;
+  memset(&reader->previous, 0, sizeof(GameInput));
+  memset(&reader->previous_coded, 0, sizeof(GameInput));
+}
+
+InputStreamResult input_stream_reader_open(InputStreamReader *reader,
+                                           const char *path) {
+  if (!reader || !path) {
+    return make_result(false, INPUT_STREAM_ERROR_NULL_POINTER);
+  }
+
+  *reader = (InputStreamReader){0};
+  reader->mapping =
+      de100_file_map_readonly(path, DE100_FILE_MAP_ADVICE_SEQUENTIAL);
+  if (!reader->mapping.success) {
+    return make_result(false, INPUT_STREAM_ERROR_READ_FAILED);
+  }
+
+  InputStreamHeader header;
+  InputStreamErrorCode error = INPUT_STREAM_SUCCESS;
+  if (reader->mapping.size < sizeof(header)) {
+    error = INPUT_STREAM_ERROR_BAD_HEADER;
+  } else {
+    memcpy(&header, reader->mapping.data, sizeof(header));
+    if (header.magic != INPUT_STREAM_MAGIC) {
+      error = INPUT_STREAM_ERROR_BAD_HEADER;
+    } else if (header.version < 1 || header.version > INPUT_STREAM_VERSION) {
+      error = INPUT_STREAM_ERROR_VERSION_MISMATCH;
+    } else if (header.frame_size != sizeof(GameInput)) {
+      error = INPUT_STREAM_ERROR_SIZE_MISMATCH;
+    }
+  }
+
+  // Validate every record once so playback never has to
+  if (error == INPUT_STREAM_SUCCESS) {
+    reader->data = (const u8 *)reader->mapping.data + sizeof(header);
+    reader->size = reader->mapping.size - sizeof(header);
+    reader->version = header.version;
+    u64 cursor = 0;
+    while (cursor < reader->size) {
+      u64 tag;
+      if (!get_varint(reader->data, reader->size, &cursor, &tag) ||
+          !decode_changes(reader->data, reader->size, &cursor, NULL)) {
+        error = INPUT_STREAM_ERROR_CORRUPT;
+        break;
+      }
+      u64 repeats = tag;
+      if (reader->version >= 2) {
+        repeats = tag >> 1;
+        if (tag & 1) {
+          if (reader->size - cursor < sizeof(u64)) {
+            error = INPUT_STREAM_ERROR_CORRUPT;
+            break;
+          }
+          cursor += sizeof(u64);
+        }
+      }
+      reader->frame_count += repeats + 1;
+    }
+  }
+
+  if (error != INPUT_STREAM_SUCCESS) {
+    de100_file_unmap(&reader->mapping);
+    *reader = (InputStreamReader){0};
+    return make_result(false, error);
+  }
+
+  reader_rewind(reader);
+  reader->is_open = true;
+  return make_result(true, INPUT_STREAM_SUCCESS);
+}
+
+bool input_stream_reader_next(InputStreamReader *reader, GameInput *out) {
+  if (!reader->is_open) {
+    return false;
+  }
+
+  while (reader->repeats_left == 0 && !reader->has_frame) {
+    u64 tag;
+    if (reader->cursor >= reader->size ||
+        !get_varint(reader->data, reader->size, &reader->cursor, &tag)) {
+      return false;
+    }
+    reader->repeats_left = tag;
+    reader->has_hash = false;
+    if (reader->version >= 2) {
+      reader->repeats_left = tag >> 1;
+      reader->has_hash = (tag & 1) != 0;
+    }
+    reader->has_frame = true;
+  }
+
+  // Predict from the old window before any changes land
+  u64 predicted[2];
+  predict_ticks(&reader->previous, predicted);
+
+  reader->frame_has_hash = false;
+  if (reader->repeats_left > 0) {
+    --reader->repeats_left;
+  } else {
+    reader->has_frame = false;
+    decode_changes(reader->data, reader->size, &reader->cursor,
+                   (u32 *)&reader->previous_coded);
+    memcpy(&reader->previous, &reader->previous_coded, sizeof(GameInput));
+    if (reader->has_hash) {
+      // Validated on open
+      memcpy(&reader->frame_hash, reader->data + reader->cursor, sizeof(u64));
+      reader->cursor += sizeof(u64);
+      reader->frame_has_hash = true;
+    }
+  }
+
+  reader->previous.tick_start_seconds =
+      reader->previous_coded.tick_start_seconds;
+  reader->previous.tick_end_seconds = reader->previous_coded.tick_end_seconds;
+  xor_ticks(&reader->previous, predicted);
+
+  if (out) {
+    memcpy(out, &reader->previous, sizeof(GameInput));
+  }
+  return true;
+}
+
+void input_stream_reader_seek(InputStreamReader *reader, u64 frame_index) {
+  reader_rewind(reader);
+  for (u64 i = 0; i < frame_index && input_stream_reader_next(reader, NULL);
+       ++i) {
+  }
+}
+
+void input_stream_reader_close(InputStreamReader *reader) {
+  if (!reader) {
+    return;
+  }
+  de100_file_unmap(&reader->mapping);
+  *reader = (InputStreamReader){0};
+}
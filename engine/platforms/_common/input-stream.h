@@ -0,0 +1,189 @@
+#ifndef DE100_INPUT_STREAM_H
+#define DE100_INPUT_STREAM_H
+
+#include "../../_common/base.h"
+#include "../../_common/file.h"
+#include "../../_common/memory.h"
+#include "../../game/async-io.h"
+#include "../../game/inputs.h"
+#include <stdbool.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// INPUT STREAM (.hmi) - delta-encoded GameInput frames
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// A recording used to be one raw GameInput per frame (~2KB × 60/s). Most
+// frames repeat the last one, so the stream stores only what changed:
+//
+//   ┌──────────────────┐
+//   │ Header           │  magic, version, sizeof(GameInput)
+//   ├──────────────────┤
+//   │ Record           │  varint tag         repeats << 1 | has_hash
+//   │                  │  varint block_mask  which 32-word blocks changed
+//   │                  │  per set block:
+//   │                  │    varint word_mask which u32 words changed
+//   │                  │    u32 × popcount   their new values
+//   │                  │  u64 state hash     if has_hash (see replay-hash.h)
+//   ├──────────────────┤
+//   │ Record ...       │  each record = `repeats` copies + one new frame
+//   └──────────────────┘
+//
+// tick_start/end_seconds move every frame, so they are stored XORed with
+// their prediction (start = last end, end = start + last span). A frame
+// with no queued events has nothing to place inside its tick window, so
+// the recorder snaps it to the prediction: idle frames then cost zero
+// bytes and an idle hour is a single record.
+//
+// A frame pushed with a state hash always ends a record (the hash belongs
+// to the record's new frame), so hashing every N frames costs at most one
+// record per N frames. Version 1 streams have no tag bit and no hashes.
+//
+// The writer never touches the disk itself: records fill
+// INPUT_STREAM_CHUNK_SIZE chunks that go out as async I/O writes (see
+// async-io.h), so the frame thread makes no syscall per frame. Without an
+// async I/O queue, full chunks are written synchronously instead.
+//
+// The reader maps the file and decodes forward; seeking replays records
+// from the start (a repeated frame only advances its tick times).
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define INPUT_STREAM_MAGIC 0x53494544u // "DEIS" little-endian
+#define INPUT_STREAM_VERSION 2
+#define INPUT_STREAM_CHUNK_SIZE KILOBYTES(16)
+#define INPUT_STREAM_CHUNK_COUNT 4
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ERROR CODES
+// ═══════════════════════════════════════════════════════════════════════════
+
+typedef enum {
+  INPUT_STREAM_SUCCESS = 0,
+  INPUT_STREAM_ERROR_NULL_POINTER,
+  INPUT_STREAM_ERROR_OUT_OF_MEMORY,
+  INPUT_STREAM_ERROR_WRITE_FAILED,
+  INPUT_STREAM_ERROR_READ_FAILED,
+  INPUT_STREAM_ERROR_BAD_HEADER,
+  INPUT_STREAM_ERROR_VERSION_MISMATCH,
+  INPUT_STREAM_ERROR_SIZE_MISMATCH,
+  INPUT_STREAM_ERROR_CORRUPT,
+
+  INPUT_STREAM_ERROR_COUNT
+} InputStreamErrorCode;
+
+// ═══════════════════════════════════════════════════════════════════════════
+// STRUCTURES
+// ═══════════════════════════════════════════════════════════════════════════
+
+typedef struct {
+  u32 magic;      // INPUT_STREAM_MAGIC
+  u32 version;    // INPUT_STREAM_VERSION
+  u32 frame_size; // sizeof(GameInput) when recorded
+  u32 reserved;
+} InputStreamHeader;
+
+typedef struct {
+  // Destination: async writes by path, or synchronous writes through fd
+  De100AsyncIO *io;
+  char path[256];
+  i32 fd;
+
+  De100MemoryBlock chunks; // INPUT_STREAM_CHUNK_COUNT × CHUNK_SIZE
+  De100AsyncIORequest requests[INPUT_STREAM_CHUNK_COUNT];
+  u32 chunk_index; // Chunk being filled
+  u32 chunk_used;
+  u64 file_offset; // Where the chunk being filled lands
+
+  GameInput previous;       // Last frame as the reader will rebuild it
+  GameInput previous_coded; // Same, with times as prediction residuals
+  u64 pending_repeats;      // Frames equal to `previous`, not yet written
+  u64 frame_count;
+  bool is_open;
+  bool failed;
+} InputStreamWriter;
+
+typedef struct {
+  De100FileMapping mapping;
+  const u8 *data; // Records (past the header)
+  u64 size;
+  u64 cursor;
+
+  GameInput previous;
+  GameInput previous_coded;
+  u64 repeats_left;   // Copies of `previous` still to hand out
+  bool has_frame;     // A record's new frame follows the repeats
+  bool has_hash;      // ...and carries a state hash
+  u64 frame_count;    // Counted when opened
+  u32 version;
+  bool is_open;
+
+  // State hash recorded with the frame last returned by next()
+  bool frame_has_hash;
+  u64 frame_hash;
+} InputStreamReader;
+
+typedef struct {
+  bool success;
+  InputStreamErrorCode error_code;
+} InputStreamResult;
+
+// ═══════════════════════════════════════════════════════════════════════════
+// API FUNCTIONS
+// ═══════════════════════════════════════════════════════════════════════════
+
+/**
+ * Start a stream in an open, empty file.
+ *
+ * @param path  The same file, for async writes (copied)
+ * @param fd    Open for writing; used when `io` is NULL or the queue is
+ *              full. The caller still owns (and closes) it.
+ * @param io    Async I/O queue, or NULL for synchronous writes
+ */
+InputStreamResult input_stream_writer_begin(InputStreamWriter *writer,
+                                            const char *path, i32 fd,
+                                            De100AsyncIO *io);
+
+/**
+ * Append one frame. Only encodes into memory; a chunk that fills up is
+ * handed to the I/O queue. Fails once any earlier write has failed.
+ *
+ * @param state_hash  Hash of game state before this frame's update, or
+ *                    NULL (playback verifies it; see replay-hash.h)
+ */
+InputStreamResult input_stream_writer_push(InputStreamWriter *writer,
+                                           const GameInput *input,
+                                           const u64 *state_hash);
+
+/**
+ * Write out pending repeats and the last chunk, wait for every write and
+ * free the chunks. Safe to call on a writer that never began.
+ */
+InputStreamResult input_stream_writer_end(InputStreamWriter *writer);
+
+/**
+ * Map a stream and count its frames. BAD_HEADER means the file is not a
+ * stream at all (e.g. raw GameInput frames).
+ */
+InputStreamResult input_stream_reader_open(InputStreamReader *reader,
+                                           const char *path);
+
+/**
+ * Decode the next frame into `out`. False at the end of the stream.
+ * Sets frame_has_hash / frame_hash for the frame returned.
+ */
+bool input_stream_reader_next(InputStreamReader *reader, GameInput *out);
+
+/**
+ * Position the reader so the next frame returned is `frame_index`
+ * (decodes from the start; repeated frames are not copied out).
+ */
+void input_stream_reader_seek(InputStreamReader *reader, u64 frame_index);
+
+/**
+ * Unmap. Safe to call multiple times.
+ */
+void input_stream_reader_close(InputStreamReader *reader);
+
+const char *input_stream_strerror(InputStreamErrorCode code);
+
+#endif // DE100_INPUT_STREAM_H
@@ -106,6 +106,7 @@
 
 #include "inputs-recording.h"
 #include "../../_common/file.h"
+#include "./replay-archive.h"
 #include "./replay-buffer.h"
 #include <stdio.h>
 #include <string.h>
@@ -114,16 +115,80 @@
 // INTERNAL HELPERS
 // ═══════════════════════════════════════════════════════════════════════════
 
+// Day 25 naming: loop_edit_N_input.hmi (input events; the state lives in
+// the replay buffer), loop_edit_N.hmr (exported archive)
+#define INPUT_FILE_SUFFIX "_input.hmi"
+#define ARCHIVE_FILE_SUFFIX ".hmr"
+
+de100_file_scoped_fn inline void format_slot_name(char *name, size_t name_size,
+                                                  i32 slot_index,
+                                                  const char *suffix) {
+  snprintf(name, name_size, "loop_edit_%d%s", slot_index, suffix);
+}
+
+de100_file_scoped_fn inline const char *
+build_slot_filename(const char *exe_directory, i32 slot_index,
+                    const char *suffix, char *buffer, size_t buffer_size) {
+  char name[64];
+  format_slot_name(name, sizeof(name), slot_index, suffix);
+  de100_path_join_into(buffer, buffer_size, exe_directory, name);
+  return buffer;
+}
+
 /**
- * Generate filename for input events (not state - that's in replay buffer).
+ * Input event file for a slot: interned at init when
+ * input_recording_init_paths ran, built into `buffer` otherwise.
  */
-de100_file_scoped_fn inline void get_input_filename(const char *exe_directory,
-                                                    i32 slot_index,
-                                                    char *buffer,
-                                                    size_t buffer_size) {
-  // Day 25 naming: loop_edit_N_input.hmi
-  snprintf(buffer, buffer_size, "%sloop_edit_%d_input.hmi", exe_directory,
-           slot_index);
+de100_file_scoped_fn inline const char *
+get_input_filename(const GameMemoryState *state, const char *exe_directory,
+                   i32 slot_index, char *buffer, size_t buffer_size) {
+  if (slot_index >= 0 && slot_index < MAX_REPLAY_BUFFERS &&
+      state->input_filenames[slot_index]) {
+    return state->input_filenames[slot_index];
+  }
+  return build_slot_filename(exe_directory, slot_index, INPUT_FILE_SUFFIX,
+                             buffer, buffer_size);
+}
+
+/**
+ * Compare the state hash recorded with the frame just read (if any) to
+ * game memory now, which is the same pre-update point it was taken at.
+ */
+de100_file_scoped_fn void check_state_hash(GameMemoryState *state,
+                                           u64 frame_index) {
+  const InputStreamReader *reader = &state->input_reader;
+  if (!reader->frame_has_hash || !state->state_hash.memory) {
+    return;
+  }
+
+  u64 actual =
+      replay_state_hash_compute(&state->state_hash, &state->snapshot_tracker);
+  if (replay_state_hash_check(&state->state_hash, frame_index,
+                              reader->frame_hash, actual)) {
+    fprintf(stderr,
+            "[INPUT PLAYBACK] ⚠️ Desync at frame %lu: state hash %016llx, "
+            "recorded %016llx\n",
+            (unsigned long)frame_index, (unsigned long long)actual,
+            (unsigned long long)reader->frame_hash);
+  }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// SLOT PATHS
+// ═══════════════════════════════════════════════════════════════════════════
+
+void input_recording_init_paths(GameMemoryState *state, De100PathTable *table,
+                                const char *exe_directory) {
+  for (i32 slot = VALID_REPLAY_BUFFERS_START_INDEX; slot < MAX_REPLAY_BUFFERS;
+       ++slot) {
+    char name[64];
+    format_slot_name(name, sizeof(name), slot, INPUT_FILE_SUFFIX);
+    state->input_filenames[slot] =
+        de100_path_table_add(table, exe_directory, name);
+    format_slot_name(name, sizeof(name), slot, ARCHIVE_FILE_SUFFIX);
+    state->archive_filenames[slot] =
+        de100_path_table_add(table, exe_directory, name);
+  }
 }
 
 // ═══════════════════════════════════════════════════════════════════════════
@@ -162,9 +227,10 @@ bool input_recording_begin(const char *exe_directory, GameMemoryState *state,
   }
 
   // Open file for input events only (state goes to replay buffer)
-  char input_filename[256];
-  get_input_filename(exe_directory, slot_index, input_filename,
-                     sizeof(input_filename));
+  char input_filename_buffer[256];
+  const char *input_filename =
+      get_input_filename(state, exe_directory, slot_index,
+                         input_filename_buffer, sizeof(input_filename_buffer));
 
   De100FileOpenResult open_result =
       de100_file_open(input_filename, DE100_FILE_WRITE | DE100_FILE_CREATE |
@@ -180,11 +246,13 @@ bool input_recording_begin(const char *exe_directory, GameMemoryState *state,
 
   // ─────────────────────────────────────────────────────────────────────
   // FAST: Save state to memory-mapped replay buffer (memcpy, not file I/O!)
+  // In ASYNC snapshot mode this only write-protects memory and returns;
+  // record_frame() reports when the background copy lands.
   // ─────────────────────────────────────────────────────────────────────
   printf("[INPUT RECORDING] 📼 Starting recording to slot %d\n", slot_index);
 
-  ReplayBufferResult save_result = replay_buffer_save_state(
-      replay_buffer, state->game_memory, state->total_size);
+  ReplayBufferResult save_result =
+      replay_buffer_save_tracked(replay_buffer, &state->snapshot_tracker);
   if (!save_result.success) {
     fprintf(stderr, "[INPUT RECORDING] Failed to save state: %s\n",
             replay_buffer_strerror(save_result.error_code));
@@ -192,8 +260,23 @@ bool input_recording_begin(const char *exe_directory, GameMemoryState *state,
     return false;
   }
 
+  InputStreamResult stream_result = input_stream_writer_begin(
+      &state->input_writer, input_filename, open_result.fd, state->async_io);
+  if (!stream_result.success) {
+    fprintf(stderr, "[INPUT RECORDING] Failed to start input stream: %s\n",
+            input_stream_strerror(stream_result.error_code));
+    de100_file_close(open_result.fd);
+    return false;
+  }
+
   state->recording_fd = open_result.fd;
   state->input_recording_index = slot_index;
+  state->recorded_frame_count = 0;
+  state->slot_state_versions[slot_index] = state->state_version;
+
+  // Old keyframes belong to the previous take
+  replay_timeline_clear(&state->timeline);
+  state->timeline_slot_index = slot_index;
 
   printf("[INPUT RECORDING] ✅ Recording started (slot %d)\n", slot_index);
   return true;
@@ -205,15 +288,47 @@ void input_recording_record_frame(GameMemoryState *state,
     return;
   }
 
-  // Write input frame to file (this is small, file I/O is fine)
-  De100FileIOResult result =
-      de100_file_write_all(state->recording_fd, input, sizeof(GameInput));
+  // The snapshot may still be copying in the background; inputs recorded
+  // meanwhile are fine since the capture reflects the first frame
+  if (replay_snapshot_tracker_update(&state->snapshot_tracker)) {
+    printf("[INPUT RECORDING] ✅ Snapshot for slot %d is complete\n",
+           state->input_recording_index);
+  }
+
+  // Memory is the state BEFORE this frame's update - exactly what a seek
+  // to this frame needs. Reading doesn't disturb the snapshot tracker.
+  if (replay_timeline_should_capture(&state->timeline,
+                                     state->recorded_frame_count)) {
+    ReplayTimelineResult keyframe_result =
+        replay_timeline_capture(&state->timeline, state->recorded_frame_count);
+    if (!keyframe_result.success) {
+      fprintf(stderr, "[INPUT RECORDING] Keyframe skipped: %s\n",
+              replay_timeline_strerror(keyframe_result.error_code));
+    }
+  }
+
+  // Same pre-update state, hashed so playback can spot the first desync
+  u64 state_hash = 0;
+  bool has_hash = replay_state_hash_should_hash(&state->state_hash,
+                                                state->recorded_frame_count);
+  if (has_hash) {
+    state_hash = replay_state_hash_compute(&state->state_hash,
+                                           &state->snapshot_tracker);
+  }
+
+  // Only encodes the changes into memory; full chunks reach the file
+  // through async I/O (see input-stream.h)
+  InputStreamResult result = input_stream_writer_push(
+      &state->input_writer, input, has_hash ? &state_hash : NULL);
 
   if (!result.success) {
     fprintf(stderr, "[INPUT RECORDING] Failed to write input frame: %s\n",
-            de100_file_strerror(result.error_code));
+            input_stream_strerror(result.error_code));
     input_recording_end(state);
+    return;
   }
+
+  state->recorded_frame_count++;
 }
 
 void input_recording_end(GameMemoryState *state) {
@@ -224,6 +339,16 @@ void input_recording_end(GameMemoryState *state) {
   printf("[INPUT RECORDING] ⏹️ Stopping recording (slot %d)\n",
          state->input_recording_index);
 
+  InputStreamResult result = input_stream_writer_end(&state->input_writer);
+  if (result.success) {
+    printf("[INPUT RECORDING] 📼 %lu frames in %.1f KB\n",
+           (unsigned long)state->input_writer.frame_count,
+           (double)state->input_writer.file_offset / 1024.0);
+  } else {
+    fprintf(stderr, "[INPUT RECORDING] Failed to flush input stream: %s\n",
+            input_stream_strerror(result.error_code));
+  }
+
   de100_file_close(state->recording_fd);
   state->recording_fd = -1;
   state->input_recording_index = 0;
@@ -262,17 +387,28 @@ bool input_recording_playback_begin(const char *exe_directory,
     return false;
   }
 
-  // Open file for input events
-  char input_filename[256];
-  get_input_filename(exe_directory, slot_index, input_filename,
-                     sizeof(input_filename));
+  // Restoring another layout would hand the game bytes it can't read
+  if (state->slot_state_versions[slot_index] != state->state_version) {
+    fprintf(stderr,
+            "[INPUT PLAYBACK] Slot %d holds state layout v%u, game is at "
+            "v%u; record it again\n",
+            slot_index, state->slot_state_versions[slot_index],
+            state->state_version);
+    return false;
+  }
 
-  De100FileOpenResult open_result =
-      de100_file_open(input_filename, DE100_FILE_READ);
+  // Map the input stream (validates it and counts its frames)
+  char input_filename_buffer[256];
+  const char *input_filename =
+      get_input_filename(state, exe_directory, slot_index,
+                         input_filename_buffer, sizeof(input_filename_buffer));
+
+  InputStreamResult open_result =
+      input_stream_reader_open(&state->input_reader, input_filename);
 
   if (!open_result.success) {
     fprintf(stderr, "[INPUT PLAYBACK] Failed to open input file: %s\n",
-            de100_file_strerror(open_result.error_code));
+            input_stream_strerror(open_result.error_code));
     return false;
   }
 
@@ -281,17 +417,20 @@ bool input_recording_playback_begin(const char *exe_directory,
   // ─────────────────────────────────────────────────────────────────────
   // FAST: Restore state from memory-mapped replay buffer (memcpy!)
   // ─────────────────────────────────────────────────────────────────────
-  ReplayBufferResult restore_result = replay_buffer_restore_state(
-      replay_buffer, state->game_memory, state->total_size);
+  ReplayBufferResult restore_result =
+      replay_buffer_restore_tracked(replay_buffer, &state->snapshot_tracker);
 
   if (!restore_result.success) {
     fprintf(stderr, "[INPUT PLAYBACK] Failed to restore state: %s\n",
             replay_buffer_strerror(restore_result.error_code));
-    de100_file_close(open_result.fd);
+    input_stream_reader_close(&state->input_reader);
     return false;
   }
-  state->playback_fd = open_result.fd;
+
   state->input_playing_index = slot_index;
+  state->playback_frame_index = 0;
+  state->playback_frame_count = state->input_reader.frame_count;
+  replay_state_hash_reset_check(&state->state_hash);
 
   printf("[INPUT PLAYBACK] ✅ Playback started (slot %d)\n", slot_index);
   return true;
@@ -302,35 +441,22 @@ void input_recording_playback_frame(GameMemoryState *state, GameInput *input) {
     return;
   }
 
-  De100FileIOResult read_result =
-      de100_file_read_all(state->playback_fd, input, sizeof(GameInput));
-
-  if (read_result.success) {
-    return;
-  }
-
-  if (!read_result.success && read_result.error_code != DE100_FILE_ERROR_EOF) {
-    fprintf(stderr, "[INPUT PLAYBACK] Failed to read input: %s\n",
-            de100_file_strerror(read_result.error_code));
-    input_recording_playback_end(state);
+  if (input_stream_reader_next(&state->input_reader, input)) {
+    check_state_hash(state, state->playback_frame_index);
+    state->playback_frame_index++;
     return;
   }
 
   // End of input stream - loop back!
   i32 slot = state->input_playing_index;
   printf("[INPUT PLAYBACK] 🔄 Looping back to start (slot %d)\n", slot);
-
-  // Seek back to beginning of input file
-  De100FileSizeResult seek_result =
-      de100_file_seek(state->playback_fd, 0, DE100_SEEK_SET);
-
-  if (!seek_result.success) {
-    fprintf(stderr, "[INPUT PLAYBACK] Failed to seek: %s\n",
-            de100_file_strerror(seek_result.error_code));
-    input_recording_playback_end(state);
-    return;
+  if (state->state_hash.checked_count > 0 && !state->state_hash.has_diverged) {
+    printf("[INPUT PLAYBACK] ✅ %lu state hashes matched the recording\n",
+           (unsigned long)state->state_hash.checked_count);
   }
 
+  input_stream_reader_seek(&state->input_reader, 0);
+
   // ─────────────────────────────────────────────────────────────────
   // FAST: Restore state from replay buffer (memcpy, not file read!)
   // ─────────────────────────────────────────────────────────────────
@@ -342,8 +468,8 @@ void input_recording_playback_frame(GameMemoryState *state, GameInput *input) {
     return;
   }
 
-  ReplayBufferResult restore_result = replay_buffer_restore_state(
-      replay_buffer, state->game_memory, state->total_size);
+  ReplayBufferResult restore_result =
+      replay_buffer_restore_tracked(replay_buffer, &state->snapshot_tracker);
 
   if (!restore_result.success) {
     fprintf(stderr, "[INPUT PLAYBACK] Failed to restore state on loop: %s\n",
@@ -353,15 +479,68 @@ void input_recording_playback_frame(GameMemoryState *state, GameInput *input) {
   }
 
   // Read first input frame
-  read_result =
-      de100_file_read_all(state->playback_fd, input, sizeof(GameInput));
-
-  if (!read_result.success) {
-    fprintf(stderr, "[INPUT PLAYBACK] Failed to read first input on loop: %s\n",
-            de100_file_strerror(read_result.error_code));
+  if (!input_stream_reader_next(&state->input_reader, input)) {
+    fprintf(stderr, "[INPUT PLAYBACK] Input stream is empty (slot %d)\n",
+            slot);
     input_recording_playback_end(state);
     return;
   }
+  replay_state_hash_reset_check(&state->state_hash);
+  check_state_hash(state, 0);
+  state->playback_frame_index = 1;
+}
+
+bool input_recording_playback_rewind_to(GameMemoryState *state,
+                                        u64 frame_index, u64 *out_frame) {
+  if (state->input_playing_index == 0) {
+    return false;
+  }
+
+  i32 slot = state->input_playing_index;
+  ReplayBuffer *replay_buffer = replay_buffer_get(state->replay_buffers, slot);
+  if (!replay_buffer_is_valid(replay_buffer)) {
+    fprintf(stderr, "[INPUT PLAYBACK] Replay buffer became invalid\n");
+    input_recording_playback_end(state);
+    return false;
+  }
+
+  const ReplayKeyframe *keyframe =
+      state->timeline_slot_index == slot
+          ? replay_timeline_find(&state->timeline, frame_index)
+          : NULL;
+
+  u64 landed_frame = 0;
+  if (keyframe) {
+    // Game memory is about to change behind the tracker's back
+    replay_snapshot_tracker_invalidate(&state->snapshot_tracker);
+    ReplayTimelineResult keyframe_result =
+        replay_timeline_restore(&state->timeline, keyframe);
+    if (keyframe_result.success) {
+      landed_frame = keyframe->frame_index;
+    } else {
+      fprintf(stderr, "[INPUT PLAYBACK] Keyframe restore failed: %s\n",
+              replay_timeline_strerror(keyframe_result.error_code));
+      keyframe = NULL; // Memory is garbage now; fall back to frame 0
+    }
+  }
+
+  if (!keyframe) {
+    ReplayBufferResult restore_result =
+        replay_buffer_restore_tracked(replay_buffer, &state->snapshot_tracker);
+    if (!restore_result.success) {
+      fprintf(stderr, "[INPUT PLAYBACK] Failed to restore state: %s\n",
+              replay_buffer_strerror(restore_result.error_code));
+      input_recording_playback_end(state);
+      return false;
+    }
+  }
+
+  input_stream_reader_seek(&state->input_reader, landed_frame);
+  replay_state_hash_reset_check(&state->state_hash);
+
+  state->playback_frame_index = landed_frame;
+  *out_frame = landed_frame;
+  return true;
 }
 
 void input_recording_playback_end(GameMemoryState *state) {
@@ -372,11 +551,201 @@ void input_recording_playback_end(GameMemoryState *state) {
   printf("[INPUT PLAYBACK] ⏹️ Stopping playback (slot %d)\n",
          state->input_playing_index);
 
-  de100_file_close(state->playback_fd);
-  state->playback_fd = -1;
+  input_stream_reader_close(&state->input_reader);
   state->input_playing_index = 0;
 }
 
+// ═══════════════════════════════════════════════════════════════════════════
+// ARCHIVE EXPORT / IMPORT
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn inline const char *
+get_archive_filename(const GameMemoryState *state, const char *exe_directory,
+                     i32 slot_index, char *buffer, size_t buffer_size) {
+  if (slot_index >= 0 && slot_index < MAX_REPLAY_BUFFERS &&
+      state->archive_filenames[slot_index]) {
+    return state->archive_filenames[slot_index];
+  }
+  return build_slot_filename(exe_directory, slot_index, ARCHIVE_FILE_SUFFIX,
+                             buffer, buffer_size);
+}
+
+/**
+ * ReplayArchiveReadFrames over an input stream.
+ */
+de100_file_scoped_fn bool read_stream_frames(void *user_data, void *frames,
+                                             u32 count) {
+  InputStreamReader *reader = (InputStreamReader *)user_data;
+  GameInput *out = (GameInput *)frames;
+  for (u32 i = 0; i < count; ++i) {
+    if (!input_stream_reader_next(reader, out + i)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool input_recording_export(const char *exe_directory, GameMemoryState *state,
+                            i32 slot_index, const char *archive_path) {
+  if (!state) {
+    fprintf(stderr, "[INPUT ARCHIVE] ERROR: NULL state\n");
+    return false;
+  }
+
+  if (state->input_recording_index == slot_index) {
+    fprintf(stderr, "[INPUT ARCHIVE] ERROR: Slot %d is still recording\n",
+            slot_index);
+    return false;
+  }
+
+  ReplayBuffer *replay_buffer =
+      replay_buffer_get(state->replay_buffers, slot_index);
+  if (!replay_buffer_is_valid(replay_buffer)) {
+    fprintf(stderr, "[INPUT ARCHIVE] ERROR: Replay buffer slot %d not valid\n",
+            slot_index);
+    return false;
+  }
+
+  // The snapshot may still be landing in the background
+  replay_snapshot_tracker_wait(&state->snapshot_tracker);
+
+  char input_filename_buffer[256];
+  const char *input_filename =
+      get_input_filename(state, exe_directory, slot_index,
+                         input_filename_buffer, sizeof(input_filename_buffer));
+  char default_archive[256];
+  if (!archive_path) {
+    archive_path = get_archive_filename(state, exe_directory, slot_index,
+                                        default_archive,
+                                        sizeof(default_archive));
+  }
+
+  // Its own reader: the slot may be playing at the same time
+  InputStreamReader reader;
+  InputStreamResult open_result =
+      input_stream_reader_open(&reader, input_filename);
+  if (!open_result.success) {
+    fprintf(stderr, "[INPUT ARCHIVE] Failed to open input file: %s\n",
+            input_stream_strerror(open_result.error_code));
+    return false;
+  }
+
+  ReplayArchiveResult result = replay_archive_write(
+      archive_path, replay_buffer->memory_block, replay_buffer->snapshot_size,
+      reader.frame_count, sizeof(GameInput), read_stream_frames, &reader);
+  input_stream_reader_close(&reader);
+
+  if (!result.success) {
+    fprintf(stderr, "[INPUT ARCHIVE] Export failed: %s\n",
+            replay_archive_strerror(result.error_code));
+    return false;
+  }
+
+  printf("[INPUT ARCHIVE] 📦 Exported slot %d → %s (%.2f MB)\n", slot_index,
+         archive_path, (double)result.bytes_written / (1024.0 * 1024.0));
+  return true;
+}
+
+bool input_recording_import(const char *exe_directory, GameMemoryState *state,
+                            i32 slot_index, const char *archive_path) {
+  if (!state || !archive_path) {
+    fprintf(stderr, "[INPUT ARCHIVE] ERROR: NULL state or path\n");
+    return false;
+  }
+
+  if (state->input_recording_index == slot_index ||
+      state->input_playing_index == slot_index) {
+    fprintf(stderr, "[INPUT ARCHIVE] ERROR: Slot %d is in use\n", slot_index);
+    return false;
+  }
+
+  ReplayBuffer *replay_buffer =
+      replay_buffer_get(state->replay_buffers, slot_index);
+  if (!replay_buffer_is_valid(replay_buffer)) {
+    fprintf(stderr, "[INPUT ARCHIVE] ERROR: Replay buffer slot %d not valid\n",
+            slot_index);
+    return false;
+  }
+
+  ReplayArchive archive;
+  ReplayArchiveResult result = replay_archive_open(archive_path, &archive);
+  if (!result.success) {
+    fprintf(stderr, "[INPUT ARCHIVE] Failed to open '%s': %s\n", archive_path,
+            replay_archive_strerror(result.error_code));
+    return false;
+  }
+
+  // Smaller is fine: a snapshot of lazily committed memory
+  if (archive.header.snapshot_size > state->snapshot_tracker.capacity ||
+      archive.header.input_frame_size != sizeof(GameInput)) {
+    fprintf(stderr, "[INPUT ARCHIVE] '%s': %s\n", archive_path,
+            replay_archive_strerror(REPLAY_ARCHIVE_ERROR_SIZE_MISMATCH));
+    replay_archive_close(&archive);
+    return false;
+  }
+
+  // We're about to overwrite the buffer behind the tracker's back
+  replay_snapshot_tracker_wait(&state->snapshot_tracker);
+  if (state->snapshot_tracker.synced_buffer == replay_buffer) {
+    state->snapshot_tracker.synced_buffer = NULL;
+  }
+  if (state->timeline_slot_index == slot_index) {
+    replay_timeline_clear(&state->timeline);
+    state->timeline_slot_index = 0;
+  }
+
+  result = replay_archive_read_snapshot(&archive, replay_buffer->memory_block,
+                                        replay_buffer->mapped_size);
+  replay_buffer->snapshot_size = archive.header.snapshot_size;
+  if (!result.success) {
+    fprintf(stderr, "[INPUT ARCHIVE] Failed to unpack snapshot: %s\n",
+            replay_archive_strerror(result.error_code));
+    replay_archive_close(&archive);
+    return false;
+  }
+
+  char input_filename_buffer[256];
+  const char *input_filename =
+      get_input_filename(state, exe_directory, slot_index,
+                         input_filename_buffer, sizeof(input_filename_buffer));
+  De100FileOpenResult open_result =
+      de100_file_open(input_filename, DE100_FILE_WRITE | DE100_FILE_CREATE |
+                                          DE100_FILE_TRUNCATE);
+  if (!open_result.success) {
+    fprintf(stderr, "[INPUT ARCHIVE] Failed to create input file: %s\n",
+            de100_file_strerror(open_result.error_code));
+    replay_archive_close(&archive);
+    return false;
+  }
+
+  // Blocking writes: importing already stalls the frame
+  InputStreamWriter writer;
+  bool ok =
+      input_stream_writer_begin(&writer, input_filename, open_result.fd, NULL)
+          .success;
+  GameInput frame;
+  for (u64 i = 0; i < archive.header.frame_count && ok; ++i) {
+    ok = replay_archive_read_frame(&archive, i, &frame).success &&
+         input_stream_writer_push(&writer, &frame, NULL).success;
+  }
+  ok = input_stream_writer_end(&writer).success && ok;
+
+  de100_file_close(open_result.fd);
+  replay_archive_close(&archive);
+
+  if (!ok) {
+    fprintf(stderr, "[INPUT ARCHIVE] Failed to unpack input stream\n");
+    return false;
+  }
+
+  // Archives don't record a layout; assume the one running now
+  state->slot_state_versions[slot_index] = state->state_version;
+
+  printf("[INPUT ARCHIVE] 📂 Imported %s → slot %d (%lu frames)\n",
+         archive_path, slot_index, (unsigned long)archive.header.frame_count);
+  return true;
+}
+
 // ═══════════════════════════════════════════════════════════════════════════
 // TOGGLE FUNCTION (Updated for Day 25 - Can Exit Playback!)
 // ═══════════════════════════════════════════════════════════════════════════
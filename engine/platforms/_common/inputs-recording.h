@@ -1,6 +1,7 @@
 #ifndef DE100_INPUT_RECORDING_H
 #define DE100_INPUT_RECORDING_H
 
+#include "../../_common/path.h"
 #include "../../game/inputs.h"
 #include "../../game/memory.h"
 #include <stdbool.h>
@@ -9,6 +10,13 @@
 // INPUT RECORDING API
 // ═══════════════════════════════════════════════════════════════════════════
 
+/**
+ * Intern every slot's input and archive file path into `table`, once at
+ * init. Without it each begin/toggle builds the path from exe_directory.
+ */
+void input_recording_init_paths(GameMemoryState *state, De100PathTable *table,
+                                const char *exe_directory);
+
 /**
  * Begin recording input to a slot.
  * Saves game state to replay buffer, opens input file for writing.
@@ -46,12 +54,40 @@ bool input_recording_playback_begin(const char *exe_directory,
  */
 void input_recording_playback_frame(GameMemoryState *state, GameInput *input);
 
+/**
+ * Jump playback back to the nearest point at or before `frame_index`: the
+ * latest keyframe recorded for this slot, else the slot's start state.
+ * Game memory and the input file position are both moved there; the
+ * caller re-simulates the remaining frames (see engine_replay_seek).
+ *
+ * @param out_frame  Receives the frame playback landed on
+ * @return false on failure (playback is stopped)
+ */
+bool input_recording_playback_rewind_to(GameMemoryState *state,
+                                        u64 frame_index, u64 *out_frame);
+
 /**
  * End playback.
  * Closes input file.
  */
 void input_recording_playback_end(GameMemoryState *state);
 
+/**
+ * Pack a recorded slot (snapshot + inputs) into a compressed .hmr archive
+ * (see replay-archive.h). Must not be recording into that slot.
+ *
+ * @param archive_path  Output path; NULL = "<exe_dir>loop_edit_N.hmr"
+ */
+bool input_recording_export(const char *exe_directory, GameMemoryState *state,
+                            i32 slot_index, const char *archive_path);
+
+/**
+ * Unpack an archive into a slot so the normal playback path can loop it.
+ * Overwrites that slot's replay buffer and input file.
+ */
+bool input_recording_import(const char *exe_directory, GameMemoryState *state,
+                            i32 slot_index, const char *archive_path);
+
 typedef enum {
   INPUT_RECORDING_TOGGLE_STARTTED_RECORDING,
   INPUT_RECORDING_TOGGLE_SWITCHED_TO_PLAYBACK,
@@ -0,0 +1,214 @@
+#include "./memory-stats.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#if defined(_MSC_VER)
+#pragma comment(lib, "psapi.lib")
+#endif
+#else
+#include <sys/resource.h>
+#include <unistd.h>
+#if defined(__APPLE__)
+#include <mach/mach.h>
+#endif
+#endif
+
+// ═══════════════════════════════════════════════════════════════════════════
+// HELPERS
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn inline void memory_stats_copy_name(char *dest,
+                                                        const char *name) {
+  snprintf(dest, MEMORY_STATS_NAME_LENGTH, "%s", name ? name : "?");
+}
+
+de100_file_scoped_fn inline f64 memory_stats_mb(u64 bytes) {
+  return (f64)bytes / (1024.0 * 1024.0);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// COLLECTION
+// ═══════════════════════════════════════════════════════════════════════════
+
+void memory_stats_begin(MemoryStats *stats) {
+  u64 sample_count = stats->sample_count;
+  memset(stats, 0, sizeof(*stats));
+  stats->sample_count = sample_count;
+}
+
+void memory_stats_add_region(MemoryStats *stats, const char *name,
+                             u64 reserved, u64 committed) {
+  if (stats->region_count >= MEMORY_STATS_MAX_REGIONS) {
+    return;
+  }
+
+  MemoryStatsRegion *region = &stats->regions[stats->region_count++];
+  memory_stats_copy_name(region->name, name);
+  region->reserved = reserved > committed ? reserved : committed;
+  region->committed = committed;
+}
+
+void memory_stats_add_block(MemoryStats *stats, const char *name,
+                            const De100MemoryBlock *block, u64 committed) {
+  if (!block->is_valid) {
+    return;
+  }
+  memory_stats_add_region(stats, name, block->reserved_size,
+                          committed ? committed : block->size);
+}
+
+void memory_stats_add_arena(MemoryStats *stats, const char *name,
+                            const De100MemoryArena *arena) {
+  if (!arena || arena->size == 0 ||
+      stats->arena_count >= MEMORY_STATS_MAX_ARENAS) {
+    return;
+  }
+
+  MemoryStatsArena *entry = &stats->arenas[stats->arena_count++];
+  memory_stats_copy_name(entry->name, name);
+  entry->size = arena->size;
+  entry->used = arena->used;
+#if DE100_INTERNAL
+  entry->high_water = arena->high_water_mark;
+  entry->failed_pushes = arena->failed_push_count;
+#endif
+}
+
+void memory_stats_add_pools(MemoryStats *stats, const GameMemory *memory) {
+  for (u32 i = 0; i < DE100_DEBUG_MAX_POOLS; ++i) {
+    const De100DebugPool *pool = &memory->debug_pools[i];
+    if (!pool->live || !pool->capacity) {
+      continue;
+    }
+    MemoryStatsPool *entry = &stats->pools[stats->pool_count++];
+    memory_stats_copy_name(entry->name, pool->name);
+    entry->live = *pool->live;
+    entry->capacity = *pool->capacity;
+  }
+}
+
+void memory_stats_add_replay_buffers(MemoryStats *stats,
+                                     const ReplayBuffer *buffers, u32 count) {
+  for (u32 i = 0; i < count; ++i) {
+    if (!buffers[i].is_valid) {
+      continue;
+    }
+    stats->replay_buffer_count++;
+    stats->replay_mapped_bytes += buffers[i].mapped_size;
+    stats->replay_snapshot_bytes += buffers[i].snapshot_size;
+  }
+}
+
+void memory_stats_read_process(MemoryStats *stats) {
+#if defined(_WIN32)
+  PROCESS_MEMORY_COUNTERS counters = {0};
+  counters.cb = sizeof(counters);
+  if (GetProcessMemoryInfo(GetCurrentProcess(), &counters,
+                           sizeof(counters))) {
+    stats->resident_bytes = counters.WorkingSetSize;
+    stats->peak_resident_bytes = counters.PeakWorkingSetSize;
+    // Windows counts soft and hard faults together
+    stats->minor_faults = counters.PageFaultCount;
+  }
+#else
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) == 0) {
+    stats->major_faults = (u64)usage.ru_majflt;
+    stats->minor_faults = (u64)usage.ru_minflt;
+#if defined(__APPLE__)
+    stats->peak_resident_bytes = (u64)usage.ru_maxrss; // Bytes
+#else
+    stats->peak_resident_bytes = (u64)usage.ru_maxrss * 1024; // KB
+#endif
+  }
+
+#if defined(__APPLE__)
+  mach_task_basic_info_data_t info;
+  mach_msg_type_number_t info_count = MACH_TASK_BASIC_INFO_COUNT;
+  if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, (task_info_t)&info,
+                &info_count) == KERN_SUCCESS) {
+    stats->resident_bytes = info.resident_size;
+  }
+#elif defined(__linux__)
+  // "size resident shared text lib data dt", in pages
+  FILE *statm = fopen("/proc/self/statm", "r");
+  if (statm) {
+    unsigned long total_pages = 0, resident_pages = 0;
+    if (fscanf(statm, "%lu %lu", &total_pages, &resident_pages) == 2) {
+      stats->resident_bytes =
+          (u64)resident_pages * (u64)de100_memory_page_size();
+    }
+    fclose(statm);
+  }
+#endif
+#endif
+}
+
+void memory_stats_end(MemoryStats *stats) {
+  stats->reserved_bytes = 0;
+  stats->committed_bytes = 0;
+  for (u32 i = 0; i < stats->region_count; ++i) {
+    stats->reserved_bytes += stats->regions[i].reserved;
+    stats->committed_bytes += stats->regions[i].committed;
+  }
+  stats->sample_count++;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// REPORT
+// ═══════════════════════════════════════════════════════════════════════════
+
+void memory_stats_print(const MemoryStats *stats) {
+  if (stats->sample_count == 0) {
+    printf("[MEMORY] No snapshot yet\n");
+    return;
+  }
+
+  printf("[MEMORY] Process: %.1f MB resident (peak %.1f MB), %lu major / "
+         "%lu minor faults\n",
+         memory_stats_mb(stats->resident_bytes),
+         memory_stats_mb(stats->peak_resident_bytes),
+         (unsigned long)stats->major_faults,
+         (unsigned long)stats->minor_faults);
+
+  printf("[MEMORY] Regions: %.1f MB committed of %.1f MB reserved\n",
+         memory_stats_mb(stats->committed_bytes),
+         memory_stats_mb(stats->reserved_bytes));
+  for (u32 i = 0; i < stats->region_count; ++i) {
+    const MemoryStatsRegion *region = &stats->regions[i];
+    printf("[MEMORY]   %-20s %9.2f / %9.2f MB\n", region->name,
+           memory_stats_mb(region->committed),
+           memory_stats_mb(region->reserved));
+  }
+
+  for (u32 i = 0; i < stats->arena_count; ++i) {
+    const MemoryStatsArena *arena = &stats->arenas[i];
+    printf("[MEMORY]   arena %-14s %9.2f / %9.2f MB (peak %.2f MB)",
+           arena->name, memory_stats_mb(arena->used),
+           memory_stats_mb(arena->size), memory_stats_mb(arena->high_water));
+    if (arena->failed_pushes) {
+      printf(" ⚠️  %u failed pushes", arena->failed_pushes);
+    }
+    printf("\n");
+  }
+
+  for (u32 i = 0; i < stats->pool_count; ++i) {
+    const MemoryStatsPool *pool = &stats->pools[i];
+    printf("[MEMORY]   pool  %-14s %9u / %9u%s\n", pool->name, pool->live,
+           pool->capacity, pool->live >= pool->capacity ? " (full)" : "");
+  }
+
+  if (stats->replay_buffer_count > 0) {
+    printf("[MEMORY]   replay: %u slots, %.1f MB mapped, %.1f MB in "
+           "snapshots\n",
+           stats->replay_buffer_count,
+           memory_stats_mb(stats->replay_mapped_bytes),
+           memory_stats_mb(stats->replay_snapshot_bytes));
+  }
+}
@@ -0,0 +1,119 @@
+#ifndef DE100_PLATFORMS__COMMON_MEMORY_STATS_H
+#define DE100_PLATFORMS__COMMON_MEMORY_STATS_H
+
+#include "../../_common/base.h"
+#include "../../_common/memory.h"
+#include "../../game/memory-arena.h"
+#include "../../game/memory.h"
+#include "./replay-buffer.h"
+
+// ═══════════════════════════════════════════════════════════════════════════
+// MEMORY STATS (live memory telemetry)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// One snapshot of where the process's memory is, refreshed by the engine
+// every ENGINE_MEMORY_STATS_INTERVAL frames (see engine.h):
+//
+//   regions   Engine-owned OS allocations: reserved vs committed bytes.
+//             With prefer_lazy_transient_commit, game memory's committed
+//             size follows the transient frontier.
+//   arenas    Size, used, high-water mark and failed pushes (high water
+//             and failures are DE100_INTERNAL-only, 0 otherwise)
+//   pools     What the game publishes in GameMemory.debug_pools
+//   replay    Mapped replay slot bytes, and the bytes the snapshots hold
+//   process   Resident set (current and peak) and page faults. Major
+//             faults mean something hit the disk: a swapped-out page, or a
+//             replay file page dropped from the page cache.
+//
+// Collection is a few loads per region plus two small syscalls
+// (getrusage, /proc/self/statm), cheap enough for every second but not
+// meant for every frame.
+//
+// Internal builds also draw the snapshot in the debug overlay and stream
+// the totals as trace counters (trace-export.h).
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define MEMORY_STATS_MAX_REGIONS 16
+#define MEMORY_STATS_MAX_ARENAS 32
+#define MEMORY_STATS_NAME_LENGTH DE100_DEBUG_NAME_LENGTH
+
+typedef struct {
+  char name[MEMORY_STATS_NAME_LENGTH];
+  u64 reserved;
+  u64 committed;
+} MemoryStatsRegion;
+
+typedef struct {
+  char name[MEMORY_STATS_NAME_LENGTH];
+  u64 size;
+  u64 used;
+  u64 high_water;
+  u32 failed_pushes;
+} MemoryStatsArena;
+
+typedef struct {
+  char name[MEMORY_STATS_NAME_LENGTH];
+  u32 live;
+  u32 capacity;
+} MemoryStatsPool;
+
+typedef struct {
+  u64 sample_count; // Snapshots taken so far (0 = never collected)
+
+  MemoryStatsRegion regions[MEMORY_STATS_MAX_REGIONS];
+  u32 region_count;
+  MemoryStatsArena arenas[MEMORY_STATS_MAX_ARENAS];
+  u32 arena_count;
+  MemoryStatsPool pools[DE100_DEBUG_MAX_POOLS];
+  u32 pool_count;
+
+  // Sums over regions[]
+  u64 reserved_bytes;
+  u64 committed_bytes;
+
+  u32 replay_buffer_count; // Valid slots
+  u64 replay_mapped_bytes;
+  u64 replay_snapshot_bytes;
+
+  // 0 where the platform doesn't report it
+  u64 resident_bytes;
+  u64 peak_resident_bytes;
+  u64 major_faults;
+  u64 minor_faults;
+} MemoryStats;
+
+/** Clear `stats` for a new snapshot (keeps sample_count). */
+void memory_stats_begin(MemoryStats *stats);
+
+/** Add an OS allocation (or several, summed under one name). */
+void memory_stats_add_region(MemoryStats *stats, const char *name,
+                             u64 reserved, u64 committed);
+
+/**
+ * Add an OS allocation. Blocks made by de100_memory_reserve report their
+ * reservation; `committed` overrides the block's committed size when
+ * non-zero (e.g. a commit frontier inside it).
+ */
+void memory_stats_add_block(MemoryStats *stats, const char *name,
+                            const De100MemoryBlock *block, u64 committed);
+
+void memory_stats_add_arena(MemoryStats *stats, const char *name,
+                            const De100MemoryArena *arena);
+
+/** Every published slot of GameMemory.debug_pools. */
+void memory_stats_add_pools(MemoryStats *stats, const GameMemory *memory);
+
+void memory_stats_add_replay_buffers(MemoryStats *stats,
+                                     const ReplayBuffer *buffers, u32 count);
+
+/** Resident set and fault counters of the calling process. */
+void memory_stats_read_process(MemoryStats *stats);
+
+/** Finish the snapshot (totals, sample_count). */
+void memory_stats_end(MemoryStats *stats);
+
+/** Human-readable table on stdout. */
+void memory_stats_print(const MemoryStats *stats);
+
+#endif // DE100_PLATFORMS__COMMON_MEMORY_STATS_H
@@ -0,0 +1,604 @@
+#include "./netplay.h"
+#include "../../_common/log.h"
+#include "../../_common/time.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#if defined(_MSC_VER)
+#pragma comment(lib, "ws2_32.lib")
+#endif
+#else
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ERROR MESSAGES
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_global_var const char *g_netplay_error_messages[] = {
+    [NETPLAY_SUCCESS] = "Success",
+    [NETPLAY_ERROR_NULL_POINTER] = "NULL session, config or tracker",
+    [NETPLAY_ERROR_BAD_CONFIG] =
+        "Bad config (player must be 0 or 1, input delay >= 1, prediction "
+        "window within the input history)",
+    [NETPLAY_ERROR_SOCKET_FAILED] = "Failed to create the UDP socket",
+    [NETPLAY_ERROR_BIND_FAILED] = "Failed to bind the local port",
+    [NETPLAY_ERROR_ADDRESS_INVALID] = "Failed to resolve the peer's address",
+    [NETPLAY_ERROR_OUT_OF_MEMORY] = "Failed to allocate rollback snapshots",
+    [NETPLAY_ERROR_SNAPSHOT_FAILED] = "Failed to sync the rollback snapshot",
+    [NETPLAY_ERROR_ROLLBACK_TOO_FAR] =
+        "Rollback target no longer in the undo log (raise undo_log_size)",
+    [NETPLAY_ERROR_PEER_TIMEOUT] = "Peer stopped sending",
+};
+
+const char *netplay_strerror(NetplayErrorCode code) {
+  if (code >= 0 && code < NETPLAY_ERROR_COUNT) {
+    return g_netplay_error_messages[code];
+  }
+  return "Unknown netplay error";
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// INTERNAL HELPERS
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define NETPLAY_NO_FRAME 0xFFFFFFFFu
+
+typedef struct {
+  u32 magic;
+  u16 version;
+  u8 player;      // Sender's player index
+  u8 input_count; // NetplayInputs following the header
+  u32 frame;      // Sender's next frame to simulate
+  u32 ack_end;    // Sender has every receiver input below this frame
+  u32 first_frame; // Frame of the first input
+  i32 advantage;  // Sender's frame minus the last receiver frame it saw
+} NetplayPacketHeader;
+
+de100_file_scoped_fn inline NetplayResult make_result(bool success,
+                                                      NetplayErrorCode code) {
+  return (NetplayResult){.success = success, .error_code = code};
+}
+
+de100_file_scoped_fn inline u32 history_index(u32 frame) {
+  return frame & (NETPLAY_INPUT_HISTORY - 1);
+}
+
+de100_file_scoped_fn inline u32 remote_player(const NetplaySession *session) {
+  return 1u - session->config.local_player;
+}
+
+de100_file_scoped_fn inline bool input_equal(NetplayInput a, NetplayInput b) {
+  return a.buttons == b.buttons && a.stick_x == b.stick_x &&
+         a.stick_y == b.stick_y;
+}
+
+de100_file_scoped_fn inline i8 quantize_stick(f32 value) {
+  f32 scaled = value * 127.0f;
+  if (scaled > 127.0f) {
+    scaled = 127.0f;
+  } else if (scaled < -127.0f) {
+    scaled = -127.0f;
+  }
+  return (i8)(scaled < 0.0f ? scaled - 0.5f : scaled + 0.5f);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// SOCKET
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn void socket_close(i64 socket_handle) {
+  if (socket_handle < 0) {
+    return;
+  }
+#if defined(_WIN32)
+  closesocket((SOCKET)socket_handle);
+  WSACleanup();
+#else
+  close((int)socket_handle);
+#endif
+}
+
+de100_file_scoped_fn NetplayErrorCode socket_open(NetplaySession *session) {
+#if defined(_WIN32)
+  WSADATA wsa_data;
+  if (WSAStartup(MAKEWORD(2, 2), &wsa_data) != 0) {
+    return NETPLAY_ERROR_SOCKET_FAILED;
+  }
+  SOCKET handle = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+  if (handle == INVALID_SOCKET) {
+    WSACleanup();
+    return NETPLAY_ERROR_SOCKET_FAILED;
+  }
+  u_long non_blocking = 1;
+  ioctlsocket(handle, FIONBIO, &non_blocking);
+  session->socket = (i64)handle;
+#else
+  int handle = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+  if (handle < 0) {
+    return NETPLAY_ERROR_SOCKET_FAILED;
+  }
+  fcntl(handle, F_SETFL, fcntl(handle, F_GETFL, 0) | O_NONBLOCK);
+  session->socket = (i64)handle;
+#endif
+
+  struct sockaddr_in local = {0};
+  local.sin_family = AF_INET;
+  local.sin_addr.s_addr = htonl(INADDR_ANY);
+  local.sin_port = htons(session->config.local_port);
+  if (bind((int)session->socket, (struct sockaddr *)&local, sizeof(local)) !=
+      0) {
+    socket_close(session->socket);
+    session->socket = -1;
+    return NETPLAY_ERROR_BIND_FAILED;
+  }
+
+  char port[8];
+  snprintf(port, sizeof(port), "%u", (unsigned)session->config.remote_port);
+  struct addrinfo hints = {0};
+  hints.ai_family = AF_INET;
+  hints.ai_socktype = SOCK_DGRAM;
+  struct addrinfo *found = NULL;
+  if (getaddrinfo(session->config.remote_host, port, &hints, &found) != 0 ||
+      !found || found->ai_addrlen > sizeof(session->remote_address)) {
+    if (found) {
+      freeaddrinfo(found);
+    }
+    socket_close(session->socket);
+    session->socket = -1;
+    return NETPLAY_ERROR_ADDRESS_INVALID;
+  }
+  memcpy(session->remote_address, found->ai_addr, found->ai_addrlen);
+  session->remote_address_size = (u32)found->ai_addrlen;
+  freeaddrinfo(found);
+
+  return NETPLAY_SUCCESS;
+}
+
+de100_file_scoped_fn void socket_send(NetplaySession *session,
+                                      const void *data, u32 size) {
+  sendto((int)session->socket, (const char *)data, size, 0,
+         (const struct sockaddr *)session->remote_address,
+         session->remote_address_size);
+  session->packets_sent++;
+}
+
+/** Bytes received, or -1 when nothing is pending. */
+de100_file_scoped_fn i32 socket_receive(NetplaySession *session, void *data,
+                                        u32 capacity) {
+  return (i32)recvfrom((int)session->socket, (char *)data, capacity, 0, NULL,
+                       NULL);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// INPUTS
+// ═══════════════════════════════════════════════════════════════════════════
+
+NetplayInput netplay_pack_input(const GameInput *input) {
+  NetplayInput packed = {0};
+  u32 button_count =
+      DE100_GAME_BUTTON_COUNT < 32 ? DE100_GAME_BUTTON_COUNT : 32;
+  bool has_stick = false;
+
+  for (i32 c = 0; c < MAX_CONTROLLER_COUNT; ++c) {
+    const GameControllerInput *controller = &input->controllers[c];
+    if (c != KEYBOARD_CONTROLLER_INDEX && !controller->is_connected) {
+      continue;
+    }
+    for (u32 b = 0; b < button_count; ++b) {
+      if (controller->buttons[b].ended_down) {
+        packed.buttons |= 1u << b;
+      }
+    }
+    if (!has_stick && controller->is_analog) {
+      packed.stick_x = quantize_stick(controller->stick_avg_x);
+      packed.stick_y = quantize_stick(controller->stick_avg_y);
+      has_stick = true;
+    }
+  }
+  return packed;
+}
+
+de100_file_scoped_fn inline void store_input(NetplaySession *session,
+                                             u32 player, u32 frame,
+                                             NetplayInput input) {
+  NetplayInputSlot *slot = &session->received[player][history_index(frame)];
+  slot->input = input;
+  slot->frame = frame;
+  slot->has_frame = true;
+}
+
+/** Received input for `frame`, or the newest one before it. */
+de100_file_scoped_fn NetplayInput input_for_frame(NetplaySession *session,
+                                                  u32 player, u32 frame) {
+  const NetplayInputSlot *slot =
+      &session->received[player][history_index(frame)];
+  if (slot->has_frame && slot->frame == frame) {
+    return slot->input;
+  }
+  // Prediction: the last input of the contiguous run repeats
+  u32 end = player == session->config.local_player
+                ? session->local_input_end
+                : session->remote_received_end;
+  if (end == 0) {
+    return (NetplayInput){0};
+  }
+  slot = &session->received[player][history_index(end - 1)];
+  return slot->has_frame && slot->frame == end - 1 ? slot->input
+                                                   : (NetplayInput){0};
+}
+
+/** Fill session->input for `frame` and remember what was used. */
+de100_file_scoped_fn void compose_input(NetplaySession *session, u32 frame) {
+  GameInput *input = &session->input;
+  memset(input, 0, sizeof(*input));
+  u32 button_count =
+      DE100_GAME_BUTTON_COUNT < 32 ? DE100_GAME_BUTTON_COUNT : 32;
+
+  for (u32 player = 0; player < NETPLAY_MAX_PLAYERS; ++player) {
+    NetplayInput current = input_for_frame(session, player, frame);
+    NetplayInputSlot *used = &session->used[player][history_index(frame)];
+    used->input = current;
+    used->frame = frame;
+    used->has_frame = true;
+
+    NetplayInput previous = {0};
+    const NetplayInputSlot *before =
+        &session->used[player][history_index(frame - 1)];
+    if (frame > 0 && before->has_frame && before->frame == frame - 1) {
+      previous = before->input;
+    }
+
+    GameControllerInput *controller = &input->controllers[player];
+    controller->is_connected = true;
+    controller->controller_index = (i32)player;
+    controller->is_analog = current.stick_x != 0 || current.stick_y != 0;
+    controller->stick_avg_x = (f32)current.stick_x / 127.0f;
+    controller->stick_avg_y = (f32)current.stick_y / 127.0f;
+    for (u32 b = 0; b < button_count; ++b) {
+      bool is_down = (current.buttons >> b) & 1u;
+      bool was_down = (previous.buttons >> b) & 1u;
+      controller->buttons[b].ended_down = is_down;
+      controller->buttons[b].half_transition_count = is_down != was_down;
+    }
+  }
+
+  f64 seconds_per_frame = (f64)session->config.seconds_per_frame;
+  input->tick_start_seconds = (f64)frame * seconds_per_frame;
+  input->tick_end_seconds = input->tick_start_seconds + seconds_per_frame;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// PACKETS
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn void send_inputs(NetplaySession *session) {
+  u8 packet[sizeof(NetplayPacketHeader) +
+            NETPLAY_MAX_PACKET_INPUTS * sizeof(NetplayInput)];
+  NetplayPacketHeader header = {0};
+  header.magic = NETPLAY_MAGIC;
+  header.version = NETPLAY_VERSION;
+  header.player = (u8)session->config.local_player;
+  header.frame = session->frame;
+  header.ack_end = session->remote_received_end;
+  header.advantage = (i32)session->frame - (i32)session->remote_frame;
+
+  // Everything the peer hasn't acked, oldest first
+  u32 first = session->remote_acked_end;
+  u32 count = session->local_input_end > first
+                  ? session->local_input_end - first
+                  : 0;
+  if (count > NETPLAY_MAX_PACKET_INPUTS) {
+    count = NETPLAY_MAX_PACKET_INPUTS;
+  }
+  header.first_frame = first;
+  header.input_count = (u8)count;
+
+  u32 local = session->config.local_player;
+  NetplayInput *inputs = (NetplayInput *)(packet + sizeof(header));
+  for (u32 i = 0; i < count; ++i) {
+    inputs[i] = session->received[local][history_index(first + i)].input;
+  }
+  memcpy(packet, &header, sizeof(header));
+  socket_send(session, packet,
+              (u32)(sizeof(header) + count * sizeof(NetplayInput)));
+}
+
+de100_file_scoped_fn void receive_packet(NetplaySession *session,
+                                         const u8 *packet, i32 size) {
+  NetplayPacketHeader header;
+  if (size < (i32)sizeof(header)) {
+    return;
+  }
+  memcpy(&header, packet, sizeof(header));
+  u32 remote = remote_player(session);
+  if (header.magic != NETPLAY_MAGIC || header.version != NETPLAY_VERSION ||
+      header.player != remote ||
+      header.input_count > NETPLAY_MAX_PACKET_INPUTS ||
+      (u32)size <
+          sizeof(header) + header.input_count * sizeof(NetplayInput)) {
+    return;
+  }
+
+  session->packets_received++;
+  session->last_receive_seconds = de100_get_wall_clock();
+  if (header.frame > session->remote_frame ||
+      session->packets_received == 1) {
+    session->remote_frame = header.frame;
+    session->remote_advantage = header.advantage;
+  }
+  if (header.ack_end > session->remote_acked_end) {
+    session->remote_acked_end = header.ack_end;
+  }
+
+  const NetplayInput *inputs =
+      (const NetplayInput *)(packet + sizeof(header));
+  for (u32 i = 0; i < header.input_count; ++i) {
+    u32 frame = header.first_frame + i;
+    if (frame < session->remote_received_end ||
+        frame >= session->frame + NETPLAY_INPUT_HISTORY / 2) {
+      continue; // Already have it, or too far ahead to keep
+    }
+
+    NetplayInput input;
+    memcpy(&input, &inputs[i], sizeof(input));
+    store_input(session, remote, frame, input);
+
+    // Simulated with a prediction that turned out wrong?
+    const NetplayInputSlot *used =
+        &session->used[remote][history_index(frame)];
+    if (frame < session->frame && used->has_frame && used->frame == frame &&
+        !input_equal(used->input, input) && frame < session->rollback_frame) {
+      session->rollback_frame = frame;
+    }
+  }
+
+  while (true) {
+    const NetplayInputSlot *next =
+        &session->received[remote][history_index(session->remote_received_end)];
+    if (!next->has_frame || next->frame != session->remote_received_end) {
+      break;
+    }
+    session->remote_received_end++;
+  }
+}
+
+de100_file_scoped_fn void receive_all(NetplaySession *session) {
+  u8 packet[sizeof(NetplayPacketHeader) +
+            NETPLAY_MAX_PACKET_INPUTS * sizeof(NetplayInput)];
+  i32 size;
+  while ((size = socket_receive(session, packet, sizeof(packet))) >= 0) {
+    receive_packet(session, packet, size);
+  }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// SESSION
+// ═══════════════════════════════════════════════════════════════════════════
+
+void netplay_config_defaults(NetplayConfig *config, f32 seconds_per_frame) {
+  config->input_delay_frames = NETPLAY_DEFAULT_INPUT_DELAY_FRAMES;
+  config->max_prediction_frames = NETPLAY_DEFAULT_MAX_PREDICTION_FRAMES;
+  config->undo_log_size = NETPLAY_DEFAULT_UNDO_LOG_SIZE;
+  config->seconds_per_frame = seconds_per_frame;
+}
+
+bool netplay_config_parse(const char *spec, NetplayConfig *config) {
+  if (!spec || !config) {
+    return false;
+  }
+  unsigned player = 0, local_port = 0, remote_port = 0, delay = 0;
+  char host[sizeof(config->remote_host)] = {0};
+  i32 fields = sscanf(spec, "%u,%u,%63[^:]:%u,%u", &player, &local_port,
+                      host, &remote_port, &delay);
+  if (fields < 4 || local_port > 65535 || remote_port > 65535) {
+    return false;
+  }
+  config->local_player = player;
+  config->local_port = (u16)local_port;
+  config->remote_port = (u16)remote_port;
+  memcpy(config->remote_host, host, sizeof(config->remote_host));
+  if (fields == 5) {
+    config->input_delay_frames = delay;
+  }
+  return true;
+}
+
+de100_file_scoped_fn void session_fail(NetplaySession *session,
+                                       NetplayErrorCode code) {
+  session->status = NETPLAY_STATUS_FAILED;
+  session->error_code = code;
+  DE100_LOG_ERROR(DE100_LOG_NET, "Session ended at frame %u: %s",
+                  session->frame, netplay_strerror(code));
+}
+
+NetplayResult netplay_begin(NetplaySession *session,
+                            const NetplayConfig *config,
+                            ReplaySnapshotTracker *tracker) {
+  if (!session || !config || !tracker) {
+    return make_result(false, NETPLAY_ERROR_NULL_POINTER);
+  }
+  if (config->local_player >= NETPLAY_MAX_PLAYERS ||
+      config->input_delay_frames < 1 || config->max_prediction_frames < 1 ||
+      config->input_delay_frames + config->max_prediction_frames +
+              NETPLAY_MAX_PACKET_INPUTS >=
+          NETPLAY_INPUT_HISTORY / 2 ||
+      config->undo_log_size < undo_log_min_size(tracker)) {
+    return make_result(false, NETPLAY_ERROR_BAD_CONFIG);
+  }
+
+  memset(session, 0, sizeof(*session));
+  session->config = *config;
+  session->socket = -1;
+  session->rollback_frame = NETPLAY_NO_FRAME;
+
+  NetplayErrorCode error = socket_open(session);
+  if (error != NETPLAY_SUCCESS) {
+    return make_result(false, error);
+  }
+
+  if (undo_log_init(&session->snapshots, tracker, config->undo_log_size,
+                    NETPLAY_INPUT_HISTORY) != UNDO_LOG_SUCCESS) {
+    socket_close(session->socket);
+    session->socket = -1;
+    return make_result(false, NETPLAY_ERROR_OUT_OF_MEMORY);
+  }
+
+  // Frames before the input delay are neutral for both players
+  u32 delay = config->input_delay_frames;
+  for (u32 frame = 0; frame < delay; ++frame) {
+    store_input(session, 0, frame, (NetplayInput){0});
+    store_input(session, 1, frame, (NetplayInput){0});
+  }
+  session->local_input_end = delay;
+  session->remote_received_end = delay;
+  session->remote_acked_end = delay;
+
+  session->status = NETPLAY_STATUS_CONNECTING;
+  session->last_receive_seconds = de100_get_wall_clock();
+  DE100_LOG_INFO(DE100_LOG_NET,
+                 "Player %u on port %u, waiting for %s:%u (delay %u frames)",
+                 config->local_player, (unsigned)config->local_port,
+                 config->remote_host, (unsigned)config->remote_port, delay);
+  return make_result(true, NETPLAY_SUCCESS);
+}
+
+/** Simulate `frame` (snapshot boundary first). */
+de100_file_scoped_fn bool simulate_frame(NetplaySession *session, u32 frame,
+                                         netplay_simulate_fn *simulate,
+                                         void *user_data,
+                                         bool is_resimulating) {
+  if (undo_log_save(&session->snapshots, frame) != UNDO_LOG_SUCCESS) {
+    session_fail(session, NETPLAY_ERROR_SNAPSHOT_FAILED);
+    return false;
+  }
+  compose_input(session, frame);
+  simulate(user_data, &session->input, is_resimulating);
+  return true;
+}
+
+NetplayAdvanceResult netplay_advance(NetplaySession *session,
+                                     const GameInput *local_input,
+                                     netplay_simulate_fn *simulate,
+                                     void (*on_start)(void *user_data),
+                                     void *user_data) {
+  if (!netplay_is_active(session)) {
+    return NETPLAY_ADVANCE_IDLE;
+  }
+
+  receive_all(session);
+
+  if (session->status == NETPLAY_STATUS_CONNECTING) {
+    if (session->packets_received == 0) {
+      send_inputs(session);
+      return NETPLAY_ADVANCE_WAITING;
+    }
+    DE100_LOG_INFO(DE100_LOG_NET, "Peer connected, starting at frame 0");
+    if (on_start) {
+      on_start(user_data);
+    }
+    if (undo_log_begin(&session->snapshots, 0) != UNDO_LOG_SUCCESS) {
+      session_fail(session, NETPLAY_ERROR_SNAPSHOT_FAILED);
+      return NETPLAY_ADVANCE_FAILED;
+    }
+    session->status = NETPLAY_STATUS_RUNNING;
+  }
+
+  if (de100_get_wall_clock() - session->last_receive_seconds >
+      NETPLAY_DISCONNECT_SECONDS) {
+    session_fail(session, NETPLAY_ERROR_PEER_TIMEOUT);
+    return NETPLAY_ADVANCE_FAILED;
+  }
+
+  // Too far ahead of the last remote input: a rollback would get too long
+  u32 frame = session->frame;
+  bool is_stalled = frame >= session->remote_received_end &&
+                    frame - session->remote_received_end >=
+                        session->config.max_prediction_frames;
+
+  // Ahead of the peer by a frame or more (latency cancels out): wait one
+  i32 local_advantage = (i32)frame - (i32)session->remote_frame;
+  if (!is_stalled && session->packets_received > 1 &&
+      (local_advantage - session->remote_advantage) / 2 >= 1 &&
+      frame - session->last_skip_frame >= NETPLAY_TIME_SYNC_INTERVAL_FRAMES) {
+    session->last_skip_frame = frame;
+    is_stalled = true;
+  }
+
+  if (is_stalled) {
+    session->frames_stalled++;
+    send_inputs(session);
+    return NETPLAY_ADVANCE_WAITING;
+  }
+
+  // This frame's local input is for frame + delay
+  store_input(session, session->config.local_player,
+              frame + session->config.input_delay_frames,
+              netplay_pack_input(local_input));
+  session->local_input_end = frame + session->config.input_delay_frames + 1;
+  send_inputs(session);
+
+  // ─────────────────────────────────────────────────────────────────────
+  // Rollback: back to the first mispredicted frame, then forward again
+  // ─────────────────────────────────────────────────────────────────────
+  session->last_rollback_frames = 0;
+  if (session->rollback_frame < frame) {
+    u32 target = session->rollback_frame;
+    if (undo_log_save(&session->snapshots, frame) != UNDO_LOG_SUCCESS) {
+      session_fail(session, NETPLAY_ERROR_SNAPSHOT_FAILED);
+      return NETPLAY_ADVANCE_FAILED;
+    }
+    UndoLogErrorCode error = undo_log_rollback(&session->snapshots, target);
+    if (error != UNDO_LOG_SUCCESS) {
+      session_fail(session, error == UNDO_LOG_ERROR_TOO_FAR
+                                ? NETPLAY_ERROR_ROLLBACK_TOO_FAR
+                                : NETPLAY_ERROR_SNAPSHOT_FAILED);
+      return NETPLAY_ADVANCE_FAILED;
+    }
+    for (u32 f = target; f < frame; ++f) {
+      if (!simulate_frame(session, f, simulate, user_data, true)) {
+        return NETPLAY_ADVANCE_FAILED;
+      }
+    }
+    session->rollbacks++;
+    session->frames_resimulated += frame - target;
+    session->last_rollback_frames = frame - target;
+  }
+  session->rollback_frame = NETPLAY_NO_FRAME;
+
+  if (!simulate_frame(session, frame, simulate, user_data, false)) {
+    return NETPLAY_ADVANCE_FAILED;
+  }
+  session->frame = frame + 1;
+  return NETPLAY_ADVANCE_SIMULATED;
+}
+
+void netplay_end(NetplaySession *session) {
+  if (!session || session->status == NETPLAY_STATUS_IDLE) {
+    return;
+  }
+  DE100_LOG_INFO(DE100_LOG_NET,
+                 "Session over at frame %u: %lu rollbacks (%lu frames "
+                 "re-simulated), %lu stalls, %lu/%lu packets sent/received",
+                 session->frame, (unsigned long)session->rollbacks,
+                 (unsigned long)session->frames_resimulated,
+                 (unsigned long)session->frames_stalled,
+                 (unsigned long)session->packets_sent,
+                 (unsigned long)session->packets_received);
+  socket_close(session->socket);
+  session->socket = -1;
+  undo_log_free(&session->snapshots);
+  session->status = NETPLAY_STATUS_IDLE;
+}
@@ -0,0 +1,230 @@
+#ifndef DE100_PLATFORMS__COMMON_NETPLAY_H
+#define DE100_PLATFORMS__COMMON_NETPLAY_H
+
+#include "../../_common/base.h"
+#include "../../_common/memory.h"
+#include "../../game/inputs.h"
+#include "./replay-buffer.h"
+#include "./undo-log.h"
+#include <stdbool.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// NETPLAY (peer-to-peer rollback)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// Two peers run the same deterministic simulation from the same start
+// state and exchange nothing but inputs. Every rendered frame:
+//
+//   1. The local controller is packed into a NetplayInput (8 bytes) and
+//      queued for frame + input_delay_frames.
+//   2. Packets from the peer are read. Each carries every input of the
+//      sender the receiver hasn't acked (up to NETPLAY_MAX_PACKET_INPUTS),
+//      so a lost packet costs nothing once the next one arrives.
+//   3. If a remote input differs from the one predicted when its frame was
+//      simulated, game memory rolls back to the state before that frame
+//      and the frames since are re-simulated with the real inputs
+//      (rendering disabled, GameMemory.netplay.is_resimulating set).
+//   4. This frame is simulated, the remote input predicted as a repeat of
+//      the last one received.
+//
+// Local input therefore never waits for the network. Remote input shows
+// up late by the one-way latency minus the input delay, and is corrected
+// by rollback. Past max_prediction_frames ahead of the last remote input,
+// the simulation stalls instead (so a rollback stays bounded).
+//
+// SNAPSHOTS: no full copy per frame; game memory history is an undo log
+// of the pages each frame dirtied (undo-log.h), sized by
+// NetplayConfig.undo_log_size. A frame whose pages were overwritten can't
+// be rolled back to, which ends the session.
+//
+// TIME SYNC: each packet carries the sender's frame advantage (its frame
+// minus the last remote frame it saw). Latency cancels out of half the
+// difference between the two peers' advantages; the peer that is ahead
+// skips a frame now and then until they match.
+//
+// GAME SIDE: while a session runs, the game sees player p's controller in
+// controllers[p] (is_connected set, the others cleared), no events, no
+// mouse, and tick times derived from the frame number. Everything the
+// simulation depends on must come from game memory and these inputs
+// (seed RNGs from game state, not the clock). Each session starts from
+// zeroed permanent storage with is_initialized cleared, like a reset
+// state migration. Frames before input_delay_frames (at least 1) get
+// neutral input on both peers, so the first frame never rolls back.
+//
+// Packets are in host byte order (both peers little-endian).
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define NETPLAY_MAX_PLAYERS 2
+#define NETPLAY_INPUT_HISTORY 128 // Frames of inputs kept (power of two)
+#define NETPLAY_MAX_PACKET_INPUTS 32
+#define NETPLAY_MAGIC 0x504E4544u // "DENP" little-endian
+#define NETPLAY_VERSION 1
+
+#define NETPLAY_DEFAULT_INPUT_DELAY_FRAMES 2
+#define NETPLAY_DEFAULT_MAX_PREDICTION_FRAMES 8
+#define NETPLAY_DEFAULT_UNDO_LOG_SIZE MEGABYTES(64)
+#define NETPLAY_DISCONNECT_SECONDS 5.0
+#define NETPLAY_TIME_SYNC_INTERVAL_FRAMES 10 // At most one skip per this
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ERROR CODES
+// ═══════════════════════════════════════════════════════════════════════════
+
+typedef enum {
+  NETPLAY_SUCCESS = 0,
+  NETPLAY_ERROR_NULL_POINTER,
+  NETPLAY_ERROR_BAD_CONFIG,
+  NETPLAY_ERROR_SOCKET_FAILED,
+  NETPLAY_ERROR_BIND_FAILED,
+  NETPLAY_ERROR_ADDRESS_INVALID,
+  NETPLAY_ERROR_OUT_OF_MEMORY,
+  NETPLAY_ERROR_SNAPSHOT_FAILED,
+  NETPLAY_ERROR_ROLLBACK_TOO_FAR,
+  NETPLAY_ERROR_PEER_TIMEOUT,
+
+  NETPLAY_ERROR_COUNT
+} NetplayErrorCode;
+
+// ═══════════════════════════════════════════════════════════════════════════
+// STRUCTURES
+// ═══════════════════════════════════════════════════════════════════════════
+
+/** One player's controller for one frame, as sent over the wire. */
+typedef struct {
+  u32 buttons; // Bit i = buttons[i].ended_down (first 32 buttons)
+  i8 stick_x;  // stick_avg_x * 127
+  i8 stick_y;
+  u16 reserved;
+} NetplayInput;
+
+typedef struct {
+  u32 local_player; // 0 or 1
+  u16 local_port;
+  char remote_host[64]; // IPv4 address or host name
+  u16 remote_port;
+  u32 input_delay_frames; // >= 1
+  u32 max_prediction_frames;
+  u64 undo_log_size;
+  f32 seconds_per_frame; // Simulated per frame (tick times)
+} NetplayConfig;
+
+typedef enum {
+  NETPLAY_STATUS_IDLE = 0,
+  NETPLAY_STATUS_CONNECTING, // Waiting for the peer's first packet
+  NETPLAY_STATUS_RUNNING,
+  NETPLAY_STATUS_FAILED, // See NetplaySession.error_code
+} NetplayStatus;
+
+typedef struct {
+  NetplayInput input;
+  u32 frame; // Frame this slot holds (valid if has_frame)
+  bool has_frame;
+} NetplayInputSlot;
+
+typedef struct {
+  NetplayConfig config;
+  NetplayStatus status;
+  NetplayErrorCode error_code;
+  i64 socket; // -1 = closed
+  u8 remote_address[32]; // sockaddr_storage prefix
+  u32 remote_address_size;
+
+  u32 frame; // Next frame to simulate
+
+  // Per player: inputs received (or entered locally), and the ones the
+  // simulation actually used for each frame (actual or predicted)
+  NetplayInputSlot received[NETPLAY_MAX_PLAYERS][NETPLAY_INPUT_HISTORY];
+  NetplayInputSlot used[NETPLAY_MAX_PLAYERS][NETPLAY_INPUT_HISTORY];
+  u32 remote_received_end; // Every remote frame below this is here
+  u32 local_input_end;     // Local inputs exist below this frame
+  u32 remote_acked_end;    // The peer has our inputs below this frame
+  u32 rollback_frame;      // Earliest mispredicted frame (UINT32_MAX none)
+  GameInput input;         // What the simulation is handed
+
+  // Time sync
+  u32 remote_frame;    // Peer's frame in its newest packet
+  i32 remote_advantage;
+  u32 last_skip_frame;
+
+  f64 last_receive_seconds;
+  UndoLog snapshots; // Rollback history (see SNAPSHOTS above)
+
+  // Stats
+  u64 packets_sent;
+  u64 packets_received;
+  u64 rollbacks;
+  u64 frames_resimulated;
+  u64 frames_stalled;
+  u32 last_rollback_frames;
+} NetplaySession;
+
+/**
+ * Run one frame of game code with `input` (the composed netplay input).
+ * `is_resimulating` is set for the frames re-run after a rollback.
+ */
+typedef void netplay_simulate_fn(void *user_data, GameInput *input,
+                                 bool is_resimulating);
+
+typedef enum {
+  NETPLAY_ADVANCE_IDLE = 0,    // No session
+  NETPLAY_ADVANCE_WAITING,     // Connecting, or stalled on the peer
+  NETPLAY_ADVANCE_SIMULATED,   // The frame ran (maybe after a rollback)
+  NETPLAY_ADVANCE_FAILED,      // The session just ended with an error
+} NetplayAdvanceResult;
+
+typedef struct {
+  bool success;
+  NetplayErrorCode error_code;
+} NetplayResult;
+
+// ═══════════════════════════════════════════════════════════════════════════
+// API FUNCTIONS
+// ═══════════════════════════════════════════════════════════════════════════
+
+/**
+ * Parse "player,local_port,host:port[,delay]" (the DE100_NETPLAY
+ * environment variable) into `config`, keeping its other fields.
+ */
+bool netplay_config_parse(const char *spec, NetplayConfig *config);
+
+/** Defaults for everything but the addresses and the player. */
+void netplay_config_defaults(NetplayConfig *config, f32 seconds_per_frame);
+
+/**
+ * Open the socket and start connecting. Snapshots go through `tracker`
+ * (the replay snapshot tracker); game memory is taken over when the
+ * peer answers, see netplay_advance.
+ */
+NetplayResult netplay_begin(NetplaySession *session,
+                            const NetplayConfig *config,
+                            ReplaySnapshotTracker *tracker);
+
+/**
+ * Once per rendered frame, with this frame's local input: exchange
+ * packets, roll back and re-simulate if needed, then simulate the frame
+ * through `simulate` (unless stalled).
+ *
+ * @param on_start  Called once when the peer answers, before frame 0, to
+ *                  reset game state (may be NULL)
+ */
+NetplayAdvanceResult netplay_advance(NetplaySession *session,
+                                     const GameInput *local_input,
+                                     netplay_simulate_fn *simulate,
+                                     void (*on_start)(void *user_data),
+                                     void *user_data);
+
+/** Close the socket and free the snapshots. Safe to call twice. */
+void netplay_end(NetplaySession *session);
+
+static inline bool netplay_is_active(const NetplaySession *session) {
+  return session && (session->status == NETPLAY_STATUS_CONNECTING ||
+                     session->status == NETPLAY_STATUS_RUNNING);
+}
+
+/** Controllers of a GameInput merged into one NetplayInput. */
+NetplayInput netplay_pack_input(const GameInput *input);
+
+const char *netplay_strerror(NetplayErrorCode code);
+
+#endif // DE100_PLATFORMS__COMMON_NETPLAY_H
@@ -0,0 +1,323 @@
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE // syscall (perf_event_open)
+#endif
+
+#include "./perf-counters.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Only built with DE100_INTERNAL (see build-common.sh)
+#if DE100_INTERNAL
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ERROR MESSAGES
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_global_var const char *g_perf_counters_error_messages[] = {
+    [PERF_COUNTERS_SUCCESS] = "Success",
+    [PERF_COUNTERS_ERROR_NULL_ARGUMENT] = "NULL profiler or empty spec",
+    [PERF_COUNTERS_ERROR_ALREADY_ACTIVE] = "Counters are already running",
+    [PERF_COUNTERS_ERROR_UNSUPPORTED] =
+        "Hardware counters need Linux perf_event_open",
+    [PERF_COUNTERS_ERROR_NO_COUNTERS] =
+        "perf_event_open refused every counter (perf_event_paranoid, VM?)",
+};
+
+const char *perf_counters_strerror(PerfCountersErrorCode code) {
+  if (code >= 0 && code < PERF_COUNTERS_ERROR_COUNT) {
+    return g_perf_counters_error_messages[code];
+  }
+  return "Unknown performance counter error";
+}
+
+#if defined(__linux__)
+
+// ═══════════════════════════════════════════════════════════════════════════
+// STATE
+// ═══════════════════════════════════════════════════════════════════════════
+
+typedef struct {
+  u32 type;
+  u64 config;
+  const char *name;
+} PerfCounterEvent;
+
+de100_file_scoped_global_var const PerfCounterEvent
+    g_perf_counter_events[DE100_PROFILE_COUNTER_COUNT] = {
+        [DE100_PROFILE_COUNTER_CYCLES] = {PERF_TYPE_HARDWARE,
+                                          PERF_COUNT_HW_CPU_CYCLES, "cycles"},
+        [DE100_PROFILE_COUNTER_INSTRUCTIONS] = {PERF_TYPE_HARDWARE,
+                                                PERF_COUNT_HW_INSTRUCTIONS,
+                                                "instructions"},
+        [DE100_PROFILE_COUNTER_CACHE_MISSES] = {PERF_TYPE_HARDWARE,
+                                                PERF_COUNT_HW_CACHE_MISSES,
+                                                "cache-misses"},
+        [DE100_PROFILE_COUNTER_BRANCH_MISSES] = {PERF_TYPE_HARDWARE,
+                                                 PERF_COUNT_HW_BRANCH_MISSES,
+                                                 "branch-misses"},
+        [DE100_PROFILE_COUNTER_STALLED_CYCLES] = {
+            PERF_TYPE_HARDWARE, PERF_COUNT_HW_STALLED_CYCLES_BACKEND,
+            "stalled-cycles-backend"},
+};
+
+typedef struct {
+  i32 fds[DE100_PROFILE_COUNTER_COUNT]; // Group members in counter order
+  i32 leader;                           // -1 once closed
+} PerfCounterGroup;
+
+typedef struct {
+  De100Profiler *profiler;
+  u32 mask; // Counters every group opens
+  u32 member_count;
+
+  u32 lock;
+  u32 group_count;
+  PerfCounterGroup groups[PERF_COUNTERS_MAX_THREADS];
+  bool is_active;
+} PerfCounters;
+
+de100_file_scoped_global_var PerfCounters g_perf_counters = {0};
+
+// The calling thread's group, opened on its first read
+de100_file_scoped_global_var __thread PerfCounterGroup *t_perf_group;
+de100_file_scoped_global_var __thread bool t_perf_group_failed;
+
+// PERF_FORMAT_GROUP | TOTAL_TIME_ENABLED | TOTAL_TIME_RUNNING
+typedef struct {
+  u64 count;
+  u64 time_enabled;
+  u64 time_running;
+  u64 values[DE100_PROFILE_COUNTER_COUNT];
+} PerfGroupRead;
+
+// ═══════════════════════════════════════════════════════════════════════════
+// GROUPS
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn i32 perf_open(u32 counter, i32 group_fd) {
+  struct perf_event_attr attr;
+  memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = g_perf_counter_events[counter].type;
+  attr.config = g_perf_counter_events[counter].config;
+  attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED |
+                     PERF_FORMAT_TOTAL_TIME_RUNNING;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  // This thread only, any CPU
+  return (i32)syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0);
+}
+
+de100_file_scoped_fn void perf_close_group(PerfCounterGroup *group) {
+  for (u32 i = 0; i < DE100_PROFILE_COUNTER_COUNT; ++i) {
+    if (group->fds[i] >= 0) {
+      close(group->fds[i]);
+      group->fds[i] = -1;
+    }
+  }
+  __atomic_store_n(&group->leader, -1, __ATOMIC_RELEASE);
+}
+
+/** Open `mask`'s counters as one group on the calling thread. */
+de100_file_scoped_fn bool perf_open_group(PerfCounterGroup *group, u32 mask) {
+  group->leader = -1;
+  for (u32 i = 0; i < DE100_PROFILE_COUNTER_COUNT; ++i) {
+    group->fds[i] = -1;
+  }
+  for (u32 i = 0; i < DE100_PROFILE_COUNTER_COUNT; ++i) {
+    if (!(mask & (1u << i))) {
+      continue;
+    }
+    group->fds[i] = perf_open(i, group->leader);
+    if (group->fds[i] < 0) {
+      perf_close_group(group);
+      return false;
+    }
+    if (group->leader < 0) {
+      group->leader = group->fds[i];
+    }
+  }
+  return group->leader >= 0;
+}
+
+/**
+ * Read the group into `values` (by counter), scaled up if the kernel had
+ * to multiplex it with other users of the PMU.
+ */
+de100_file_scoped_fn bool perf_read_group(const PerfCounterGroup *group,
+                                          u32 mask, u64 *values) {
+  i32 leader = __atomic_load_n(&group->leader, __ATOMIC_ACQUIRE);
+  if (leader < 0) {
+    return false;
+  }
+  PerfGroupRead data;
+  ssize_t size = read(leader, &data, sizeof(data));
+  if (size < (ssize_t)(3 * sizeof(u64)) || data.time_running == 0) {
+    return false;
+  }
+  f64 scale = data.time_running < data.time_enabled
+                  ? (f64)data.time_enabled / (f64)data.time_running
+                  : 1.0;
+  u32 member = 0;
+  for (u32 i = 0; i < DE100_PROFILE_COUNTER_COUNT; ++i) {
+    if (!(mask & (1u << i))) {
+      continue;
+    }
+    if (member >= data.count) {
+      return false;
+    }
+    u64 value = data.values[member++];
+    values[i] = scale == 1.0 ? value : (u64)((f64)value * scale);
+  }
+  return true;
+}
+
+de100_file_scoped_fn DE100_PROFILER_READ_COUNTERS(perf_read_counters) {
+  (void)profiler;
+  PerfCounters *perf = &g_perf_counters;
+  if (t_perf_group_failed) {
+    return false;
+  }
+
+  if (!t_perf_group) {
+    while (__atomic_exchange_n(&perf->lock, 1, __ATOMIC_ACQUIRE)) {
+      // First read per thread; just spin
+    }
+    PerfCounterGroup *group = NULL;
+    if (perf->group_count < PERF_COUNTERS_MAX_THREADS) {
+      group = &perf->groups[perf->group_count];
+      if (perf_open_group(group, perf->mask)) {
+        perf->group_count++;
+      } else {
+        group = NULL;
+      }
+    }
+    __atomic_store_n(&perf->lock, 0, __ATOMIC_RELEASE);
+
+    if (!group) {
+      t_perf_group_failed = true;
+      return false;
+    }
+    t_perf_group = group;
+  }
+
+  return perf_read_group(t_perf_group, perf->mask, values);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// PUBLIC API
+// ═══════════════════════════════════════════════════════════════════════════
+
+PerfCountersResult perf_counters_begin(De100Profiler *profiler,
+                                       const char *spec) {
+  PerfCountersResult result = {0};
+  PerfCounters *perf = &g_perf_counters;
+
+  if (!profiler || !spec || !spec[0]) {
+    result.error_code = PERF_COUNTERS_ERROR_NULL_ARGUMENT;
+    return result;
+  }
+  if (perf->is_active) {
+    result.error_code = PERF_COUNTERS_ERROR_ALREADY_ACTIVE;
+    return result;
+  }
+
+  // Whatever this CPU (or hypervisor) offers, one at a time
+  u32 mask = 0;
+  for (u32 i = 0; i < DE100_PROFILE_COUNTER_COUNT; ++i) {
+    i32 fd = perf_open(i, -1);
+    if (fd >= 0) {
+      mask |= 1u << i;
+      close(fd);
+    }
+  }
+
+  // Then as a group that actually gets scheduled: a group the PMU can't
+  // hold never runs, so drop counters from the end until it does
+  *perf = (PerfCounters){0};
+  perf->profiler = profiler;
+  PerfCounterGroup *group = &perf->groups[0];
+  while (mask) {
+    if (perf_open_group(group, mask)) {
+      volatile u64 spin = 0;
+      for (u32 i = 0; i < 100000; ++i) {
+        spin += i;
+      }
+      u64 values[DE100_PROFILE_COUNTER_COUNT];
+      if (perf_read_group(group, mask, values)) {
+        break;
+      }
+      perf_close_group(group);
+    }
+    mask &= ~(1u << (31 - __builtin_clz(mask)));
+  }
+  if (!mask) {
+    result.error_code = PERF_COUNTERS_ERROR_NO_COUNTERS;
+    return result;
+  }
+
+  perf->mask = mask;
+  perf->group_count = 1;
+  t_perf_group = group;
+  t_perf_group_failed = false;
+  perf->is_active = true;
+
+  const char *filter = strcmp(spec, "frame") == 0 ? "" : spec;
+  de100_profiler_enable_counters(profiler, perf_read_counters, mask, filter);
+
+  printf("[PERF] 🔬 Counters:");
+  for (u32 i = 0; i < DE100_PROFILE_COUNTER_COUNT; ++i) {
+    if (mask & (1u << i)) {
+      printf(" %s", g_perf_counter_events[i].name);
+    }
+  }
+  printf(" (blocks: %s)\n", filter[0] ? filter : "none, frames only");
+
+  result.success = true;
+  result.error_code = PERF_COUNTERS_SUCCESS;
+  return result;
+}
+
+void perf_counters_end(void) {
+  PerfCounters *perf = &g_perf_counters;
+  if (!perf->is_active) {
+    return;
+  }
+
+  de100_profiler_enable_counters(perf->profiler, NULL, 0, NULL);
+  while (__atomic_exchange_n(&perf->lock, 1, __ATOMIC_ACQUIRE)) {
+  }
+  for (u32 i = 0; i < perf->group_count; ++i) {
+    perf_close_group(&perf->groups[i]);
+  }
+  __atomic_store_n(&perf->lock, 0, __ATOMIC_RELEASE);
+  perf->is_active = false;
+}
+
+bool perf_counters_is_active(void) { return g_perf_counters.is_active; }
+
+#else // !__linux__
+
+PerfCountersResult perf_counters_begin(De100Profiler *profiler,
+                                       const char *spec) {
+  (void)profiler;
+  (void)spec;
+  PerfCountersResult result = {0};
+  result.error_code = PERF_COUNTERS_ERROR_UNSUPPORTED;
+  return result;
+}
+
+void perf_counters_end(void) {}
+
+bool perf_counters_is_active(void) { return false; }
+
+#endif // __linux__
+
+#endif // DE100_INTERNAL
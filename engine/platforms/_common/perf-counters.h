@@ -0,0 +1,74 @@
+#ifndef DE100_PLATFORMS__COMMON_PERF_COUNTERS_H
+#define DE100_PLATFORMS__COMMON_PERF_COUNTERS_H
+
+#include "../../_common/base.h"
+#include "../../_common/profiler.h"
+#include <stdbool.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// HARDWARE PERFORMANCE COUNTERS (internal builds, Linux)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// Feeds the profiler's counter sampling (see profiler.h) from
+// perf_event_open: one counter group per thread (cycles, instructions,
+// last-level cache misses, branch misses, backend stall cycles), opened
+// the first time the thread reads it and read with a single read().
+// User space only, so perf_event_paranoid up to 2 allows it.
+//
+// The report then says whether a block is memory-bound (low IPC, many
+// misses per item) or branch-bound (branch misses per item), e.g.
+//
+//   counters                        IPC  LLC miss/it   br miss/it  stall%
+//   update_grains                  0.61        0.412        0.011    58.0
+//   find_best_target               1.05        0.002        2.310     n/a
+//
+// Each sample is a syscall (~1µs) at both ends of the block, so select
+// blocks that run a handful of times per frame and do real work inside;
+// their own numbers include that cost, the frame's only the sampling of
+// the blocks inside it.
+//
+// DE100_PERF_COUNTERS environment variable at engine_init:
+//   BLOCK[,BLOCK...]   Names of the timed blocks to sample
+//   *                  Every block
+//   frame              Frame counters only
+//
+// Counters the CPU or the VM doesn't provide are left out (n/a in the
+// report); none at all is an error.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define PERF_COUNTERS_MAX_THREADS DE100_PROFILER_MAX_THREADS
+
+typedef enum {
+  PERF_COUNTERS_SUCCESS = 0,
+  PERF_COUNTERS_ERROR_NULL_ARGUMENT,
+  PERF_COUNTERS_ERROR_ALREADY_ACTIVE,
+  PERF_COUNTERS_ERROR_UNSUPPORTED, // Not Linux
+  PERF_COUNTERS_ERROR_NO_COUNTERS, // perf_event_open refused all of them
+
+  PERF_COUNTERS_ERROR_COUNT
+} PerfCountersErrorCode;
+
+typedef struct {
+  bool success;
+  PerfCountersErrorCode error_code;
+} PerfCountersResult;
+
+/**
+ * Probe the counters on the calling (main) thread and turn on the
+ * profiler's sampling for the blocks in `spec` (see above).
+ */
+PerfCountersResult perf_counters_begin(De100Profiler *profiler,
+                                       const char *spec);
+
+/**
+ * Stop sampling and close every thread's counters. Stats stay. Call once
+ * the threads that sample them have stopped.
+ */
+void perf_counters_end(void);
+
+bool perf_counters_is_active(void);
+
+const char *perf_counters_strerror(PerfCountersErrorCode code);
+
+#endif // DE100_PLATFORMS__COMMON_PERF_COUNTERS_H
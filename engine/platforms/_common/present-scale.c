@@ -0,0 +1,59 @@
+#include "present-scale.h"
+#include "dynamic-resolution.h"
+
+#include <math.h>
+
+de100_file_scoped_global_var PresentScaleRect g_present_scale_current = {
+    .scale = 1.0f,
+};
+
+PresentScaleRect present_scale_compute(const GameConfig *config,
+                                       i32 source_width, i32 source_height,
+                                       i32 window_width, i32 window_height) {
+  PresentScaleRect rect = {
+      .width = source_width,
+      .height = source_height,
+      .source_width = source_width,
+      .source_height = source_height,
+      .scale = 1.0f,
+  };
+
+  if (config->prefer_scaled_present && source_width > 0 &&
+      source_height > 0 && window_width > 0 && window_height > 0) {
+    // A dynamically shrunk frame takes the full-size frame's rect
+    i32 layout_width = source_width;
+    i32 layout_height = source_height;
+    dynamic_resolution_layout_size(&layout_width, &layout_height);
+
+    f32 fit = fminf((f32)window_width / (f32)layout_width,
+                    (f32)window_height / (f32)layout_height);
+    f32 layout_scale = fit;
+    if (config->prefer_integer_scaling && fit >= 1.0f) {
+      layout_scale = floorf(fit);
+    }
+    rect.width = (i32)((f32)layout_width * layout_scale);
+    rect.height = (i32)((f32)layout_height * layout_scale);
+    rect.scale = (f32)rect.width / (f32)source_width;
+    rect.is_scaled = true;
+  }
+
+  rect.x = (window_width - rect.width) / 2;
+  rect.y = (window_height - rect.height) / 2;
+  return rect;
+}
+
+void present_scale_set_current(PresentScaleRect rect) {
+  g_present_scale_current = rect;
+}
+
+void present_scale_window_to_backbuffer(i32 *x, i32 *y) {
+  const PresentScaleRect *rect = &g_present_scale_current;
+  if (!rect->is_scaled || rect->scale <= 0.0f) {
+    return;
+  }
+
+  i32 bx = (i32)floorf((f32)(*x - rect->x) / rect->scale);
+  i32 by = (i32)floorf((f32)(*y - rect->y) / rect->scale);
+  *x = bx < 0 ? 0 : bx >= rect->source_width ? rect->source_width - 1 : bx;
+  *y = by < 0 ? 0 : by >= rect->source_height ? rect->source_height - 1 : by;
+}
@@ -0,0 +1,65 @@
+#ifndef DE100_PLATFORMS__COMMON_PRESENT_SCALE_H
+#define DE100_PLATFORMS__COMMON_PRESENT_SCALE_H
+
+#include "../../_common/base.h"
+#include "../../game/config.h"
+
+// ═══════════════════════════════════════════════════════════════════════════
+// 🖼️ PRESENT SCALING (GameConfig.prefer_scaled_present)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// Where the backbuffer lands in the window. The game renders at its fixed
+// backbuffer size; the GPU stretches the texture (nearest filtering) into
+// this rect and the rest of the window stays black:
+//
+//   ┌───────────────── window ─────────────────┐
+//   │▓▓▓▓│                                │▓▓▓▓│
+//   │▓▓▓▓│   backbuffer × scale           │▓▓▓▓│
+//   │▓▓▓▓│   (centered, aspect kept)      │▓▓▓▓│
+//   │▓▓▓▓│                                │▓▓▓▓│
+//   └──────────────────────────────────────────┘
+//
+//   off        scale 1, centered (the window only adds borders)
+//   integer    largest whole scale that fits: every game pixel is the same
+//              size on screen. Smaller windows fall back to fit.
+//   fit        largest scale that fits, fractional
+//
+// Backends record the rect they drew with (present_scale_set_current) so
+// mouse input can be mapped back to backbuffer pixels. Unscaled, the
+// mapping is the identity: positions stay window-relative as before.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+typedef struct {
+  // Destination in window pixels, top-left origin
+  i32 x;
+  i32 y;
+  i32 width;
+  i32 height;
+  // Backbuffer size
+  i32 source_width;
+  i32 source_height;
+  f32 scale;      // Window pixels per backbuffer pixel
+  bool is_scaled; // Mouse positions are mapped to backbuffer pixels
+} PresentScaleRect;
+
+/**
+ * Destination rect for a `source_width` × `source_height` backbuffer in a
+ * `window_width` × `window_height` window, per the config's preferences.
+ */
+PresentScaleRect present_scale_compute(const GameConfig *config,
+                                       i32 source_width, i32 source_height,
+                                       i32 window_width, i32 window_height);
+
+/**
+ * Remember the rect the backend presents with, for input mapping.
+ */
+void present_scale_set_current(PresentScaleRect rect);
+
+/**
+ * Map a window position to backbuffer pixels with the current rect
+ * (unchanged when unscaled). Positions in the bars clamp to the edge.
+ */
+void present_scale_window_to_backbuffer(i32 *x, i32 *y);
+
+#endif // DE100_PLATFORMS__COMMON_PRESENT_SCALE_H
@@ -0,0 +1,314 @@
+#include "present-thread.h"
+#include "../../_common/time.h"
+
+#include <pthread.h>
+#include <stdio.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ERROR MESSAGES
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_global_var const char *g_present_thread_error_messages[] = {
+    [PRESENT_THREAD_SUCCESS] = "Success",
+    [PRESENT_THREAD_ERROR_NULL_ARGUMENT] = "NULL callbacks or empty size",
+    [PRESENT_THREAD_ERROR_ALREADY_ACTIVE] = "Present thread already running",
+    [PRESENT_THREAD_ERROR_ALLOC_FAILED] = "Failed to allocate frame slots",
+    [PRESENT_THREAD_ERROR_SYNC_INIT_FAILED] =
+        "Failed to initialize mutex/condition",
+    [PRESENT_THREAD_ERROR_THREAD_CREATE_FAILED] =
+        "Failed to create present thread",
+};
+
+const char *present_thread_strerror(PresentThreadErrorCode code) {
+  if (code >= 0 && code < PRESENT_THREAD_ERROR_COUNT) {
+    return g_present_thread_error_messages[code];
+  }
+  return "Unknown present thread error";
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// STATE
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define PRESENT_THREAD_SLOT_MASK 0x3u
+#define PRESENT_THREAD_SLOT_FRESH 0x4u // Mailbox holds an unshown frame
+
+typedef struct {
+  PresentThreadCallbacks callbacks;
+  De100MemoryBlock block;
+  u64 slot_capacity;
+  PresentThreadFrame slots[PRESENT_THREAD_SLOT_COUNT];
+
+  u32 write_slot; // Game thread's
+  u32 mailbox;    // Slot index | PRESENT_THREAD_SLOT_FRESH, atomic
+  u32 read_slot;  // Present thread's
+  bool has_presented;
+
+  // Under `lock`
+  pthread_t thread;
+  pthread_mutex_t lock;
+  pthread_cond_t wake;
+  bool stop_requested;
+  bool repaint_requested;
+  i32 repaint_width;
+  i32 repaint_height;
+  PresentThreadStats stats;
+
+  bool is_active;
+} PresentThread;
+
+de100_file_scoped_global_var PresentThread g_present_thread = {0};
+de100_file_scoped_global_var __thread bool t_is_present_thread;
+
+de100_file_scoped_fn inline f32 present_thread_ewma(f32 average, f32 sample,
+                                                    u64 count) {
+  return count <= 1 ? sample
+                    : average + (sample - average) * PRESENT_THREAD_STATS_ALPHA;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// THREAD
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn void *present_thread_proc(void *data) {
+  PresentThread *present = (PresentThread *)data;
+  PresentThreadCallbacks *callbacks = &present->callbacks;
+  t_is_present_thread = true;
+
+  if (callbacks->begin) {
+    callbacks->begin(callbacks->user);
+  }
+
+  pthread_mutex_lock(&present->lock);
+  for (;;) {
+    while (!(__atomic_load_n(&present->mailbox, __ATOMIC_ACQUIRE) &
+             PRESENT_THREAD_SLOT_FRESH) &&
+           !present->stop_requested && !present->repaint_requested) {
+      pthread_cond_wait(&present->wake, &present->lock);
+    }
+    bool is_fresh = __atomic_load_n(&present->mailbox, __ATOMIC_ACQUIRE) &
+                    PRESENT_THREAD_SLOT_FRESH;
+    bool is_repaint = present->repaint_requested && present->has_presented;
+    i32 repaint_width = present->repaint_width;
+    i32 repaint_height = present->repaint_height;
+    bool should_stop = present->stop_requested;
+    present->repaint_requested = false;
+    pthread_mutex_unlock(&present->lock);
+
+    f32 flip_seconds = 0.0f;
+    f64 start = de100_get_wall_clock();
+    const PresentThreadFrame *frame = NULL;
+    if (is_fresh) {
+      // Hand back the shown slot, take the newest frame
+      u32 taken = __atomic_exchange_n(&present->mailbox, present->read_slot,
+                                      __ATOMIC_ACQ_REL);
+      present->read_slot = taken & PRESENT_THREAD_SLOT_MASK;
+      frame = &present->slots[present->read_slot];
+      flip_seconds = callbacks->present(frame, callbacks->user);
+      present->has_presented = true;
+    } else if (is_repaint) {
+      PresentThreadFrame again = present->slots[present->read_slot];
+      again.window_width = repaint_width;
+      again.window_height = repaint_height;
+      again.is_repaint = true;
+      callbacks->present(&again, callbacks->user);
+    }
+    f64 end = de100_get_wall_clock();
+
+    pthread_mutex_lock(&present->lock);
+    PresentThreadStats *stats = &present->stats;
+    if (frame) {
+      stats->presented++;
+      stats->present_ms = present_thread_ewma(
+          stats->present_ms, (f32)((end - start) * 1000.0), stats->presented);
+      stats->latency_ms = present_thread_ewma(
+          stats->latency_ms, (f32)((end - frame->submit_seconds) * 1000.0),
+          stats->presented);
+      if (flip_seconds > 0.0f) {
+        stats->flip_interval_ms = present_thread_ewma(
+            stats->flip_interval_ms, flip_seconds * 1000.0f,
+            stats->presented);
+      }
+    } else if (is_repaint) {
+      stats->repaints++;
+    }
+    if (should_stop && !is_fresh) {
+      break;
+    }
+  }
+  pthread_mutex_unlock(&present->lock);
+
+  if (callbacks->end) {
+    callbacks->end(callbacks->user);
+  }
+  return NULL;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// PUBLIC API
+// ═══════════════════════════════════════════════════════════════════════════
+
+PresentThreadResult
+present_thread_start(const PresentThreadCallbacks *callbacks, i32 max_width,
+                     i32 max_height) {
+  PresentThreadResult result = {0};
+  PresentThread *present = &g_present_thread;
+
+  if (!callbacks || !callbacks->present || max_width <= 0 ||
+      max_height <= 0) {
+    result.error_code = PRESENT_THREAD_ERROR_NULL_ARGUMENT;
+    return result;
+  }
+  if (present->is_active) {
+    result.error_code = PRESENT_THREAD_ERROR_ALREADY_ACTIVE;
+    return result;
+  }
+
+  *present = (PresentThread){0};
+  present->callbacks = *callbacks;
+  present->slot_capacity = (u64)max_width * (u64)max_height * 4;
+  present->block = de100_memory_alloc(
+      NULL, present->slot_capacity * PRESENT_THREAD_SLOT_COUNT,
+      De100_MEMORY_FLAG_RW_ZEROED);
+  if (!de100_memory_is_valid(present->block)) {
+    result.error_code = PRESENT_THREAD_ERROR_ALLOC_FAILED;
+    return result;
+  }
+  for (u32 i = 0; i < PRESENT_THREAD_SLOT_COUNT; ++i) {
+    present->slots[i].backbuffer.memory.base =
+        (u8 *)present->block.base + present->slot_capacity * i;
+    present->slots[i].backbuffer.memory.size = present->slot_capacity;
+  }
+  present->write_slot = 0;
+  present->mailbox = 1;
+  present->read_slot = 2;
+
+  if (pthread_mutex_init(&present->lock, NULL) != 0) {
+    de100_memory_free(&present->block);
+    result.error_code = PRESENT_THREAD_ERROR_SYNC_INIT_FAILED;
+    return result;
+  }
+  if (pthread_cond_init(&present->wake, NULL) != 0) {
+    pthread_mutex_destroy(&present->lock);
+    de100_memory_free(&present->block);
+    result.error_code = PRESENT_THREAD_ERROR_SYNC_INIT_FAILED;
+    return result;
+  }
+  if (pthread_create(&present->thread, NULL, present_thread_proc, present) !=
+      0) {
+    pthread_cond_destroy(&present->wake);
+    pthread_mutex_destroy(&present->lock);
+    de100_memory_free(&present->block);
+    result.error_code = PRESENT_THREAD_ERROR_THREAD_CREATE_FAILED;
+    return result;
+  }
+
+  present->is_active = true;
+  printf("✅ Present thread: %u slots of %dx%d\n", PRESENT_THREAD_SLOT_COUNT,
+         max_width, max_height);
+
+  result.success = true;
+  result.error_code = PRESENT_THREAD_SUCCESS;
+  return result;
+}
+
+void present_thread_submit(const GameBackBuffer *backbuffer,
+                           i32 window_width, i32 window_height,
+                           f32 target_seconds_per_frame) {
+  PresentThread *present = &g_present_thread;
+  if (!present->is_active) {
+    return;
+  }
+
+  u64 row_bytes = (u64)backbuffer->width * (u64)backbuffer->bytes_per_pixel;
+  if (row_bytes * (u64)backbuffer->height > present->slot_capacity) {
+    DEV_ASSERT_MSG(false, "Backbuffer %dx%d outgrew the present slots",
+                   backbuffer->width, backbuffer->height);
+    return;
+  }
+
+  PresentThreadFrame *frame = &present->slots[present->write_slot];
+  u8 *slot_pixels = (u8 *)frame->backbuffer.memory.base;
+  if ((u64)backbuffer->pitch == row_bytes) {
+    de100_mem_copy_large(slot_pixels, backbuffer->memory.base,
+                         row_bytes * (u64)backbuffer->height);
+  } else {
+    const u8 *row = (const u8 *)backbuffer->memory.base;
+    for (i32 y = 0; y < backbuffer->height; ++y) {
+      de100_mem_copy(slot_pixels + row_bytes * (u64)y, row, row_bytes);
+      row += backbuffer->pitch;
+    }
+  }
+
+  De100MemoryBlock slot_memory = frame->backbuffer.memory;
+  frame->backbuffer = *backbuffer;
+  frame->backbuffer.memory = slot_memory;
+  frame->backbuffer.pitch = (int)row_bytes;
+  frame->backbuffer.dirty = (GameDirtyRegion){0}; // Full uploads only
+  frame->window_width = window_width;
+  frame->window_height = window_height;
+  frame->target_seconds_per_frame = target_seconds_per_frame;
+  frame->submit_seconds = de100_get_wall_clock();
+  frame->is_repaint = false;
+
+  u32 previous =
+      __atomic_exchange_n(&present->mailbox,
+                          present->write_slot | PRESENT_THREAD_SLOT_FRESH,
+                          __ATOMIC_ACQ_REL);
+  present->write_slot = previous & PRESENT_THREAD_SLOT_MASK;
+
+  pthread_mutex_lock(&present->lock);
+  present->stats.submitted++;
+  if (previous & PRESENT_THREAD_SLOT_FRESH) {
+    present->stats.dropped++;
+  }
+  pthread_cond_signal(&present->wake);
+  pthread_mutex_unlock(&present->lock);
+}
+
+void present_thread_repaint(i32 window_width, i32 window_height) {
+  PresentThread *present = &g_present_thread;
+  if (!present->is_active) {
+    return;
+  }
+  pthread_mutex_lock(&present->lock);
+  present->repaint_requested = true;
+  present->repaint_width = window_width;
+  present->repaint_height = window_height;
+  pthread_cond_signal(&present->wake);
+  pthread_mutex_unlock(&present->lock);
+}
+
+void present_thread_stop(void) {
+  PresentThread *present = &g_present_thread;
+  if (!present->is_active) {
+    return;
+  }
+
+  pthread_mutex_lock(&present->lock);
+  present->stop_requested = true;
+  pthread_cond_signal(&present->wake);
+  pthread_mutex_unlock(&present->lock);
+  pthread_join(present->thread, NULL);
+
+  pthread_cond_destroy(&present->wake);
+  pthread_mutex_destroy(&present->lock);
+  de100_memory_free(&present->block);
+  present->is_active = false;
+}
+
+bool present_thread_is_active(void) { return g_present_thread.is_active; }
+
+bool present_thread_is_current(void) { return t_is_present_thread; }
+
+PresentThreadStats present_thread_stats(void) {
+  PresentThread *present = &g_present_thread;
+  PresentThreadStats stats = {0};
+  if (!present->is_active) {
+    return stats;
+  }
+  pthread_mutex_lock(&present->lock);
+  stats = present->stats;
+  pthread_mutex_unlock(&present->lock);
+  return stats;
+}
@@ -0,0 +1,131 @@
+#ifndef DE100_PLATFORMS__COMMON_PRESENT_THREAD_H
+#define DE100_PLATFORMS__COMMON_PRESENT_THREAD_H
+
+#include "../../_common/base.h"
+#include "../../_common/memory.h"
+#include "../../game/backbuffer.h"
+
+#include <stdbool.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// 🖥️ PRESENT THREAD (GameConfig.prefer_present_thread)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// Upload, swap and the wait for the flip run on a thread that owns the GL
+// context, so a blocking swap (vsync, a busy driver, a compositor) never
+// eats into the game thread's frame:
+//
+//   game thread ──copy──▶ [ write ]    ┌─────────┐    [ read ] ──▶ upload
+//                            └─swap──▶ │ mailbox │ ──swap─┘        swap
+//                                      └─────────┘                 flip
+//
+// Three frame slots: the game thread fills one, the mailbox holds the
+// newest finished frame, the present thread shows one. Both sides only
+// ever exchange their slot with the mailbox (one atomic swap each), so
+// neither waits for the other: a frame the present thread didn't get to
+// in time is replaced by the next one (counted as dropped), and a slow
+// present never stalls a submit.
+//
+// The frame is COPIED into its slot (a few MB, row by row), so the game
+// keeps its own backbuffer and its contents; dirty rects are not carried
+// over (every present is a full upload).
+//
+// The game thread keeps its own pacing (sleep to the frame target); the
+// present thread is paced by the swap. The backend's callbacks do the
+// actual GL work; present times come back through present_thread_stats.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define PRESENT_THREAD_SLOT_COUNT 3
+#define PRESENT_THREAD_STATS_ALPHA 0.1f
+
+typedef enum {
+  PRESENT_THREAD_SUCCESS = 0,
+  PRESENT_THREAD_ERROR_NULL_ARGUMENT,
+  PRESENT_THREAD_ERROR_ALREADY_ACTIVE,
+  PRESENT_THREAD_ERROR_ALLOC_FAILED,
+  PRESENT_THREAD_ERROR_SYNC_INIT_FAILED,
+  PRESENT_THREAD_ERROR_THREAD_CREATE_FAILED,
+
+  PRESENT_THREAD_ERROR_COUNT
+} PresentThreadErrorCode;
+
+typedef struct {
+  bool success;
+  PresentThreadErrorCode error_code;
+} PresentThreadResult;
+
+/** One finished frame, as the present thread sees it. */
+typedef struct {
+  GameBackBuffer backbuffer; // Points into the slot; rows packed
+  i32 window_width;
+  i32 window_height;
+  f32 target_seconds_per_frame;
+  f64 submit_seconds; // Wall clock at present_thread_submit
+  bool is_repaint;    // Same frame again (Expose): skip the upload
+} PresentThreadFrame;
+
+/**
+ * Show `frame` (upload unless it is a repaint, draw, swap). Returns the
+ * flip-to-flip interval in seconds if the backend waited for the flip,
+ * else 0.
+ */
+#define PRESENT_THREAD_PRESENT(name)                                           \
+  f32 name(const PresentThreadFrame *frame, void *user)
+typedef PRESENT_THREAD_PRESENT(present_thread_present_t);
+
+/** On the present thread: take (begin) or release (end) the context. */
+#define PRESENT_THREAD_CONTEXT(name) void name(void *user)
+typedef PRESENT_THREAD_CONTEXT(present_thread_context_t);
+
+typedef struct {
+  present_thread_context_t *begin;
+  present_thread_present_t *present;
+  present_thread_context_t *end;
+  void *user;
+} PresentThreadCallbacks;
+
+typedef struct {
+  u64 submitted;
+  u64 presented;
+  u64 dropped; // Replaced in the mailbox before the thread took them
+  u64 repaints;
+  // EWMA, ms
+  f32 present_ms; // Upload + draw + swap (+ flip wait)
+  f32 latency_ms; // Submit to present done
+  f32 flip_interval_ms;
+} PresentThreadStats;
+
+/**
+ * Allocate the slots for frames up to `max_width` × `max_height` and start
+ * the thread. The calling thread must release the GL context first: the
+ * thread's begin callback takes it.
+ */
+PresentThreadResult
+present_thread_start(const PresentThreadCallbacks *callbacks, i32 max_width,
+                     i32 max_height);
+
+/**
+ * Copy `backbuffer` into the mailbox and wake the thread. Never waits for
+ * a present. Game thread only.
+ */
+void present_thread_submit(const GameBackBuffer *backbuffer,
+                           i32 window_width, i32 window_height,
+                           f32 target_seconds_per_frame);
+
+/** Show the last presented frame again at the given window size. */
+void present_thread_repaint(i32 window_width, i32 window_height);
+
+/** Show the queued frame, if any, then stop; end runs on the thread. */
+void present_thread_stop(void);
+
+bool present_thread_is_active(void);
+
+/** True on the present thread itself. */
+bool present_thread_is_current(void);
+
+PresentThreadStats present_thread_stats(void);
+
+const char *present_thread_strerror(PresentThreadErrorCode code);
+
+#endif // DE100_PLATFORMS__COMMON_PRESENT_THREAD_H
@@ -0,0 +1,151 @@
+#include "render-pipeline.h"
+#include "fixed-timestep.h"
+
+#include <stdio.h>
+
+RenderPipeline g_render_pipeline = {0};
+
+bool render_pipeline_init(void) {
+  if (g_render_pipeline.is_initialized) {
+    return true;
+  }
+
+  size_t group_bytes =
+      sizeof(De100RenderCommand) * RENDER_PIPELINE_MAX_COMMANDS;
+  g_render_pipeline.command_block =
+      de100_memory_alloc(NULL, group_bytes * RENDER_PIPELINE_SLOT_COUNT,
+                         De100_MEMORY_FLAG_RW_ZEROED);
+  if (!de100_memory_is_valid(g_render_pipeline.command_block)) {
+    fprintf(stderr, "❌ Render pipeline: failed to allocate command lists\n");
+    return false;
+  }
+
+  u8 *base = (u8 *)g_render_pipeline.command_block.base;
+  for (u32 i = 0; i < RENDER_PIPELINE_SLOT_COUNT; ++i) {
+    De100RenderGroup *group = &g_render_pipeline.groups[i];
+    group->commands = (De100RenderCommand *)(base + group_bytes * i);
+    group->command_count = 0;
+    group->is_fully_covered = false;
+    group->is_linear_blend = false;
+    group->layer = 0;
+    group->cull = NULL;
+    group->max_command_count = RENDER_PIPELINE_MAX_COMMANDS;
+  }
+
+  g_render_pipeline.is_initialized = true;
+  printf("✅ Pipelined render: %u x %u commands\n", RENDER_PIPELINE_SLOT_COUNT,
+         RENDER_PIPELINE_MAX_COMMANDS);
+  return true;
+}
+
+void render_pipeline_shutdown(void) {
+  if (de100_memory_is_valid(g_render_pipeline.tile_block)) {
+    de100_memory_free(&g_render_pipeline.tile_block);
+  }
+  if (de100_memory_is_valid(g_render_pipeline.command_block)) {
+    de100_memory_free(&g_render_pipeline.command_block);
+  }
+  g_render_pipeline = (RenderPipeline){0};
+}
+
+bool render_pipeline_is_active(const EngineGameState *game,
+                               const GameMainCode *code) {
+  return g_render_pipeline.is_initialized &&
+         game->config.prefer_pipelined_render && game->memory.work_queue &&
+         fixed_timestep_is_active(&game->config, code);
+}
+
+void render_pipeline_finish(GameMemory *memory) {
+  if (!g_render_pipeline.raster_in_flight) {
+    return;
+  }
+  DE100_TIMED_BLOCK("render_pipeline_finish");
+  memory->complete_all_work(memory->work_queue);
+  g_render_pipeline.raster_in_flight = false;
+}
+
+de100_file_scoped_fn inline bool render_pipeline_reserve_tiles(u32 count) {
+  if (count <= g_render_pipeline.tile_capacity) {
+    return true;
+  }
+  if (de100_memory_is_valid(g_render_pipeline.tile_block)) {
+    de100_memory_free(&g_render_pipeline.tile_block);
+  }
+  g_render_pipeline.tile_block = de100_memory_alloc(
+      NULL, sizeof(De100TileRenderWork) * count, De100_MEMORY_FLAG_RW_ZEROED);
+  if (!de100_memory_is_valid(g_render_pipeline.tile_block)) {
+    g_render_pipeline.tiles = NULL;
+    g_render_pipeline.tile_capacity = 0;
+    return false;
+  }
+  g_render_pipeline.tiles =
+      (De100TileRenderWork *)g_render_pipeline.tile_block.base;
+  g_render_pipeline.tile_capacity = count;
+  return true;
+}
+
+void render_pipeline_record_and_kick(EngineGameState *game,
+                                     GameMainCode *code) {
+  // Never record over (or re-tile) a list the workers are still reading
+  render_pipeline_finish(&game->memory);
+
+  De100RenderGroup *group = &g_render_pipeline.groups[g_render_pipeline.slot];
+  g_render_pipeline.slot =
+      (g_render_pipeline.slot + 1) % RENDER_PIPELINE_SLOT_COUNT;
+  group->command_count = 0;
+  group->is_fully_covered = false;
+  group->is_linear_blend = false;
+  group->layer = 0;
+  group->cull = NULL;
+
+  game->memory.render_group = group;
+  fixed_timestep_render(game, code);
+  game->memory.render_group = NULL;
+
+  GameBackBuffer *buffer = &game->backbuffer;
+  if (buffer->is_rendering_disabled || group->command_count == 0) {
+    return;
+  }
+
+  i32 tile_count_x =
+      (buffer->width + DE100_RENDER_TILE_SIZE - 1) / DE100_RENDER_TILE_SIZE;
+  i32 tile_count_y =
+      (buffer->height + DE100_RENDER_TILE_SIZE - 1) / DE100_RENDER_TILE_SIZE;
+  u32 tile_count = (u32)(tile_count_x * tile_count_y);
+
+  de100_pixel_kernels_get(); // Resolve before workers race on the lazy init
+  de100_render_group_mark_dirty(group, buffer);
+
+  if (!render_pipeline_reserve_tiles(tile_count)) {
+    de100_render_group_to_output(group, buffer);
+    return;
+  }
+
+  u32 index = 0;
+  for (i32 tile_y = 0; tile_y < tile_count_y; ++tile_y) {
+    for (i32 tile_x = 0; tile_x < tile_count_x; ++tile_x) {
+      De100TileRenderWork *work = &g_render_pipeline.tiles[index++];
+      work->group = group;
+      work->buffer = buffer;
+      work->clip.min_x = tile_x * DE100_RENDER_TILE_SIZE;
+      work->clip.min_y = tile_y * DE100_RENDER_TILE_SIZE;
+      work->clip.max_x = work->clip.min_x + DE100_RENDER_TILE_SIZE;
+      work->clip.max_y = work->clip.min_y + DE100_RENDER_TILE_SIZE;
+      if (work->clip.max_x > buffer->width) {
+        work->clip.max_x = buffer->width;
+      }
+      if (work->clip.max_y > buffer->height) {
+        work->clip.max_y = buffer->height;
+      }
+
+      // Queue full: this tile runs now, the rest still overlap
+      if (!game->memory.add_work_entry(game->memory.work_queue,
+                                       de100_do_tile_render_work, work)) {
+        de100_render_group_to_output_clipped(group, buffer, work->clip);
+      }
+    }
+  }
+
+  g_render_pipeline.raster_in_flight = true;
+  ++g_render_pipeline.frames_pipelined;
+}
@@ -0,0 +1,70 @@
+#ifndef DE100_PLATFORMS__COMMON_RENDER_PIPELINE_H
+#define DE100_PLATFORMS__COMMON_RENDER_PIPELINE_H
+
+#include "../../_common/base.h"
+#include "../../_common/memory.h"
+#include "../../engine.h"
+#include "../../game/render-group.h"
+
+// ═══════════════════════════════════════════════════════════════════════════
+// 🏭 PIPELINED RENDER (GameConfig.prefer_pipelined_render)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// Overlaps simulation with rasterization across two frames:
+//
+//   main:     | update N+1 | audio | finish | present N | render N+1 → kick
+//   workers:  |░░ raster N (tiles) ░░|                  |░░ raster N+1 ░░…
+//
+// game_render only RECORDS into memory->render_group (cheap); the tiles
+// are rasterized on the work queue by engine code while the main thread
+// sleeps and runs the next frame's game_update. The command lists are
+// double-buffered engine memory, so no game-visible state is shared with
+// the workers and a hot reload mid-raster is safe.
+//
+// Costs one frame of latency. If the game calls complete_all_work during
+// game_update it also waits for the raster in flight (correct, less
+// overlap). Requires the fixed-timestep pair and a work queue; otherwise
+// the frame runs serially as before.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define RENDER_PIPELINE_SLOT_COUNT 2
+
+#ifndef RENDER_PIPELINE_MAX_COMMANDS
+#define RENDER_PIPELINE_MAX_COMMANDS 16384
+#endif
+
+typedef struct {
+  De100RenderGroup groups[RENDER_PIPELINE_SLOT_COUNT];
+  De100MemoryBlock command_block;
+  u32 slot; // Next group to record into
+
+  // Tile descriptors for the raster in flight (grown on resize)
+  De100TileRenderWork *tiles;
+  u32 tile_capacity;
+  De100MemoryBlock tile_block;
+
+  bool32 is_initialized;
+  bool32 raster_in_flight;
+  u64 frames_pipelined;
+} RenderPipeline;
+extern RenderPipeline g_render_pipeline;
+
+bool render_pipeline_init(void);
+void render_pipeline_shutdown(void);
+
+/** Pipelining applies this frame (config, game exports, work queue). */
+bool render_pipeline_is_active(const EngineGameState *game,
+                               const GameMainCode *code);
+
+/** Wait for the raster in flight; the backbuffer is then complete. */
+void render_pipeline_finish(GameMemory *memory);
+
+/**
+ * Record this frame's game_render into the next command list and queue its
+ * tiles on the workers. Call after presenting; returns without waiting.
+ */
+void render_pipeline_record_and_kick(EngineGameState *game,
+                                     GameMainCode *code);
+
+#endif // DE100_PLATFORMS__COMMON_RENDER_PIPELINE_H
@@ -0,0 +1,468 @@
+#include "./replay-archive.h"
+#include "../../_common/compression.h"
+#include "../../_common/file.h"
+
+#include <stdio.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ERROR MESSAGES
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_global_var const char *g_replay_archive_error_messages[] = {
+    [REPLAY_ARCHIVE_SUCCESS] = "Success",
+    [REPLAY_ARCHIVE_ERROR_NULL_POINTER] = "NULL path, archive or buffer",
+    [REPLAY_ARCHIVE_ERROR_FILE_OPEN_FAILED] = "Failed to open archive file",
+    [REPLAY_ARCHIVE_ERROR_WRITE_FAILED] = "Failed to write archive",
+    [REPLAY_ARCHIVE_ERROR_READ_FAILED] = "Failed to read archive",
+    [REPLAY_ARCHIVE_ERROR_BAD_HEADER] = "Not a replay archive",
+    [REPLAY_ARCHIVE_ERROR_VERSION_MISMATCH] = "Unsupported archive version",
+    [REPLAY_ARCHIVE_ERROR_SIZE_MISMATCH] =
+        "Archive does not match this game's memory or input layout",
+    [REPLAY_ARCHIVE_ERROR_OUT_OF_MEMORY] = "Failed to allocate scratch memory",
+    [REPLAY_ARCHIVE_ERROR_COMPRESSION_FAILED] =
+        "Failed to compress or decompress a block",
+    [REPLAY_ARCHIVE_ERROR_FRAME_OUT_OF_RANGE] = "Frame index past the end",
+};
+
+const char *replay_archive_strerror(ReplayArchiveErrorCode code) {
+  if (code >= 0 && code < REPLAY_ARCHIVE_ERROR_COUNT) {
+    return g_replay_archive_error_messages[code];
+  }
+  return "Unknown replay archive error";
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// INTERNAL HELPERS
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn inline ReplayArchiveResult
+make_result(bool success, ReplayArchiveErrorCode code, u64 bytes) {
+  return (ReplayArchiveResult){
+      .success = success, .error_code = code, .bytes_written = bytes};
+}
+
+de100_file_scoped_fn inline bool is_zero_block(const u8 *data, u64 size) {
+  const u64 *words = (const u64 *)data;
+  u64 word_count = size / sizeof(u64);
+  for (u64 i = 0; i < word_count; ++i) {
+    if (words[i]) {
+      return false;
+    }
+  }
+  for (u64 i = word_count * sizeof(u64); i < size; ++i) {
+    if (data[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+de100_file_scoped_fn inline void xor_bytes(u8 *dest, const u8 *src,
+                                           u32 size) {
+  for (u32 i = 0; i < size; ++i) {
+    dest[i] ^= src[i];
+  }
+}
+
+de100_file_scoped_fn inline bool write_at(i32 fd, u64 *offset,
+                                          const void *data, u64 size) {
+  De100FileIOResult result = de100_file_write_all(fd, data, (size_t)size);
+  *offset += result.bytes_processed;
+  return result.success;
+}
+
+de100_file_scoped_fn inline bool read_at(i32 fd, u64 offset, void *data,
+                                         u64 size) {
+  if (!de100_file_seek(fd, (i64)offset, DE100_SEEK_SET).success) {
+    return false;
+  }
+  return de100_file_read_all(fd, data, (size_t)size).success;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// WRITE
+// ═══════════════════════════════════════════════════════════════════════════
+
+/**
+ * Everything after the file is open. Early-returns an error code; the
+ * caller owns cleanup of the file and scratch memory.
+ */
+de100_file_scoped_fn ReplayArchiveErrorCode
+write_archive_contents(i32 fd, ReplayArchiveHeader *header,
+                       const u8 *snapshot_bytes,
+                       ReplayArchiveReadFrames *read_frames, void *user_data,
+                       ReplayArchiveBlockEntry *blocks,
+                       ReplayArchiveChunkEntry *chunks, u8 *compressed,
+                       u64 compressed_capacity, u8 *chunk_raw, u64 *offset) {
+  u64 snapshot_size = header->snapshot_size;
+  u32 input_frame_size = header->input_frame_size;
+
+  // Placeholder; rewritten once the table offsets are known
+  if (!write_at(fd, offset, header, sizeof(*header))) {
+    return REPLAY_ARCHIVE_ERROR_WRITE_FAILED;
+  }
+
+  // ─────────────────────────────────────────────────────────────────────
+  // Snapshot blocks
+  // ─────────────────────────────────────────────────────────────────────
+
+  for (u32 i = 0; i < header->block_count; ++i) {
+    u64 block_offset = (u64)i * header->block_size;
+    u64 raw_size = snapshot_size - block_offset < header->block_size
+                       ? snapshot_size - block_offset
+                       : header->block_size;
+    const u8 *raw = snapshot_bytes + block_offset;
+
+    blocks[i].raw_size = (u32)raw_size;
+    if (is_zero_block(raw, raw_size)) {
+      continue; // offset/compressed_size stay 0
+    }
+
+    De100CompressResult packed = de100_lz_compress(
+        raw, (size_t)raw_size, compressed, (size_t)compressed_capacity);
+    if (!packed.success) {
+      return REPLAY_ARCHIVE_ERROR_COMPRESSION_FAILED;
+    }
+
+    blocks[i].offset = *offset;
+    blocks[i].compressed_size = (u32)packed.size;
+    if (!write_at(fd, offset, compressed, packed.size)) {
+      return REPLAY_ARCHIVE_ERROR_WRITE_FAILED;
+    }
+  }
+
+  // ─────────────────────────────────────────────────────────────────────
+  // Input chunks (XOR delta → compress)
+  // ─────────────────────────────────────────────────────────────────────
+
+  u64 frames_left = header->frame_count;
+  for (u32 i = 0; i < header->chunk_count; ++i) {
+    u32 frame_count = frames_left < header->frames_per_chunk
+                          ? (u32)frames_left
+                          : header->frames_per_chunk;
+    u64 raw_size = (u64)frame_count * input_frame_size;
+    frames_left -= frame_count;
+
+    if (!read_frames(user_data, chunk_raw, frame_count)) {
+      return REPLAY_ARCHIVE_ERROR_READ_FAILED;
+    }
+
+    // Walk backwards so each frame is XORed with its untouched
+    // predecessor. Frame 0 stays raw: every chunk decodes on its own.
+    for (u32 f = frame_count; f-- > 1;) {
+      xor_bytes(chunk_raw + (u64)f * input_frame_size,
+                chunk_raw + (u64)(f - 1) * input_frame_size, input_frame_size);
+    }
+
+    De100CompressResult packed = de100_lz_compress(
+        chunk_raw, (size_t)raw_size, compressed, (size_t)compressed_capacity);
+    if (!packed.success) {
+      return REPLAY_ARCHIVE_ERROR_COMPRESSION_FAILED;
+    }
+
+    chunks[i].offset = *offset;
+    chunks[i].compressed_size = (u32)packed.size;
+    chunks[i].frame_count = frame_count;
+    if (!write_at(fd, offset, compressed, packed.size)) {
+      return REPLAY_ARCHIVE_ERROR_WRITE_FAILED;
+    }
+  }
+
+  // ─────────────────────────────────────────────────────────────────────
+  // Tables + final header
+  // ─────────────────────────────────────────────────────────────────────
+
+  u64 block_table_size =
+      (u64)header->block_count * sizeof(ReplayArchiveBlockEntry);
+  u64 chunk_table_size =
+      (u64)header->chunk_count * sizeof(ReplayArchiveChunkEntry);
+
+  header->block_table_offset = *offset;
+  header->chunk_table_offset = *offset + block_table_size;
+  if (!write_at(fd, offset, blocks, block_table_size) ||
+      !write_at(fd, offset, chunks, chunk_table_size)) {
+    return REPLAY_ARCHIVE_ERROR_WRITE_FAILED;
+  }
+
+  u64 header_offset = 0;
+  if (!de100_file_seek(fd, 0, DE100_SEEK_SET).success ||
+      !write_at(fd, &header_offset, header, sizeof(*header))) {
+    return REPLAY_ARCHIVE_ERROR_WRITE_FAILED;
+  }
+
+  return REPLAY_ARCHIVE_SUCCESS;
+}
+
+ReplayArchiveResult replay_archive_write(const char *path,
+                                         const void *snapshot,
+                                         u64 snapshot_size, u64 frame_count,
+                                         u32 input_frame_size,
+                                         ReplayArchiveReadFrames *read_frames,
+                                         void *user_data) {
+  if (!path || !snapshot || input_frame_size == 0 ||
+      (frame_count && !read_frames)) {
+    return make_result(false, REPLAY_ARCHIVE_ERROR_NULL_POINTER, 0);
+  }
+
+  ReplayArchiveHeader header = {0};
+  header.magic = REPLAY_ARCHIVE_MAGIC;
+  header.version = REPLAY_ARCHIVE_VERSION;
+  header.snapshot_size = snapshot_size;
+  header.block_size = REPLAY_ARCHIVE_BLOCK_SIZE;
+  header.block_count =
+      (u32)((snapshot_size + header.block_size - 1) / header.block_size);
+  header.input_frame_size = input_frame_size;
+  header.frames_per_chunk = REPLAY_ARCHIVE_FRAMES_PER_CHUNK;
+  header.frame_count = frame_count;
+  header.chunk_count =
+      (u32)((header.frame_count + header.frames_per_chunk - 1) /
+            header.frames_per_chunk);
+
+  // ─────────────────────────────────────────────────────────────────────
+  // Scratch: tables | compressed bytes | raw chunk
+  // ─────────────────────────────────────────────────────────────────────
+
+  u64 chunk_raw_size = (u64)header.frames_per_chunk * input_frame_size;
+  u64 block_table_size =
+      (u64)header.block_count * sizeof(ReplayArchiveBlockEntry);
+  u64 chunk_table_size =
+      (u64)header.chunk_count * sizeof(ReplayArchiveChunkEntry);
+  u64 compressed_capacity = de100_lz_compress_bound(
+      header.block_size > chunk_raw_size ? header.block_size : chunk_raw_size);
+
+  De100MemoryBlock scratch = de100_memory_alloc(
+      NULL,
+      (size_t)(block_table_size + chunk_table_size + compressed_capacity +
+               chunk_raw_size),
+      De100_MEMORY_FLAG_RW_ZEROED);
+  if (!de100_memory_is_valid(scratch)) {
+    return make_result(false, REPLAY_ARCHIVE_ERROR_OUT_OF_MEMORY, 0);
+  }
+
+  ReplayArchiveBlockEntry *blocks = (ReplayArchiveBlockEntry *)scratch.base;
+  ReplayArchiveChunkEntry *chunks =
+      (ReplayArchiveChunkEntry *)((u8 *)blocks + block_table_size);
+  u8 *compressed = (u8 *)chunks + chunk_table_size;
+  u8 *chunk_raw = compressed + compressed_capacity;
+
+  De100FileOpenResult open_result =
+      de100_file_open(path, DE100_FILE_WRITE | DE100_FILE_CREATE |
+                                DE100_FILE_TRUNCATE);
+  if (!open_result.success) {
+    de100_memory_free(&scratch);
+    return make_result(false, REPLAY_ARCHIVE_ERROR_FILE_OPEN_FAILED, 0);
+  }
+  u64 offset = 0;
+  ReplayArchiveErrorCode error = write_archive_contents(
+      open_result.fd, &header, (const u8 *)snapshot, read_frames, user_data,
+      blocks, chunks, compressed, compressed_capacity, chunk_raw, &offset);
+
+  de100_file_close(open_result.fd);
+  de100_memory_free(&scratch);
+
+  if (error != REPLAY_ARCHIVE_SUCCESS) {
+    de100_file_delete(path);
+    return make_result(false, error, 0);
+  }
+
+#if DE100_INTERNAL
+  printf("[REPLAY ARCHIVE] 📦 %s: %.2f MB snapshot + %lu frames → %.2f MB\n",
+         path, (double)snapshot_size / (1024.0 * 1024.0),
+         (unsigned long)header.frame_count, (double)offset / (1024.0 * 1024.0));
+#endif
+
+  return make_result(true, REPLAY_ARCHIVE_SUCCESS, offset);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// READ
+// ═══════════════════════════════════════════════════════════════════════════
+
+ReplayArchiveResult replay_archive_open(const char *path,
+                                        ReplayArchive *archive) {
+  if (!path || !archive) {
+    return make_result(false, REPLAY_ARCHIVE_ERROR_NULL_POINTER, 0);
+  }
+
+  *archive = (ReplayArchive){0};
+  archive->fd = -1;
+  archive->cached_chunk = -1;
+
+  De100FileOpenResult open_result = de100_file_open(path, DE100_FILE_READ);
+  if (!open_result.success) {
+    return make_result(false, REPLAY_ARCHIVE_ERROR_FILE_OPEN_FAILED, 0);
+  }
+  archive->fd = open_result.fd;
+
+  ReplayArchiveHeader *header = &archive->header;
+  ReplayArchiveErrorCode error = REPLAY_ARCHIVE_SUCCESS;
+
+  if (!read_at(archive->fd, 0, header, sizeof(*header))) {
+    error = REPLAY_ARCHIVE_ERROR_READ_FAILED;
+  } else if (header->magic != REPLAY_ARCHIVE_MAGIC) {
+    error = REPLAY_ARCHIVE_ERROR_BAD_HEADER;
+  } else if (header->version != REPLAY_ARCHIVE_VERSION) {
+    error = REPLAY_ARCHIVE_ERROR_VERSION_MISMATCH;
+  } else if (header->block_size == 0 || header->input_frame_size == 0 ||
+             header->frames_per_chunk == 0) {
+    error = REPLAY_ARCHIVE_ERROR_BAD_HEADER;
+  }
+
+  if (error != REPLAY_ARCHIVE_SUCCESS) {
+    replay_archive_close(archive);
+    return make_result(false, error, 0);
+  }
+
+  // ─────────────────────────────────────────────────────────────────────
+  // Tables
+  // ─────────────────────────────────────────────────────────────────────
+
+  u64 block_table_size =
+      (u64)header->block_count * sizeof(ReplayArchiveBlockEntry);
+  u64 chunk_table_size =
+      (u64)header->chunk_count * sizeof(ReplayArchiveChunkEntry);
+
+  archive->tables =
+      de100_memory_alloc(NULL, (size_t)(block_table_size + chunk_table_size),
+                         De100_MEMORY_FLAG_RW_ZEROED);
+  if (!de100_memory_is_valid(archive->tables)) {
+    replay_archive_close(archive);
+    return make_result(false, REPLAY_ARCHIVE_ERROR_OUT_OF_MEMORY, 0);
+  }
+
+  archive->blocks = (ReplayArchiveBlockEntry *)archive->tables.base;
+  archive->chunks =
+      (ReplayArchiveChunkEntry *)((u8 *)archive->blocks + block_table_size);
+
+  if (!read_at(archive->fd, header->block_table_offset, archive->blocks,
+               block_table_size) ||
+      !read_at(archive->fd, header->chunk_table_offset, archive->chunks,
+               chunk_table_size)) {
+    replay_archive_close(archive);
+    return make_result(false, REPLAY_ARCHIVE_ERROR_READ_FAILED, 0);
+  }
+
+  // ─────────────────────────────────────────────────────────────────────
+  // Decode scratch
+  // ─────────────────────────────────────────────────────────────────────
+
+  u64 chunk_raw_size = (u64)header->frames_per_chunk * header->input_frame_size;
+  u64 compressed_capacity = de100_lz_compress_bound(
+      header->block_size > chunk_raw_size ? header->block_size
+                                          : chunk_raw_size);
+
+  archive->scratch =
+      de100_memory_alloc(NULL, (size_t)(compressed_capacity + chunk_raw_size),
+                         De100_MEMORY_FLAG_RW);
+  if (!de100_memory_is_valid(archive->scratch)) {
+    replay_archive_close(archive);
+    return make_result(false, REPLAY_ARCHIVE_ERROR_OUT_OF_MEMORY, 0);
+  }
+  archive->compressed = (u8 *)archive->scratch.base;
+  archive->chunk_frames = archive->compressed + compressed_capacity;
+
+  return make_result(true, REPLAY_ARCHIVE_SUCCESS, 0);
+}
+
+ReplayArchiveResult replay_archive_read_snapshot(ReplayArchive *archive,
+                                                 void *dest, u64 dest_size) {
+  if (!archive || !dest || archive->fd < 0) {
+    return make_result(false, REPLAY_ARCHIVE_ERROR_NULL_POINTER, 0);
+  }
+
+  if (dest_size < archive->header.snapshot_size) {
+    return make_result(false, REPLAY_ARCHIVE_ERROR_SIZE_MISMATCH, 0);
+  }
+
+  u8 *dest_bytes = (u8 *)dest;
+  for (u32 i = 0; i < archive->header.block_count; ++i) {
+    ReplayArchiveBlockEntry *block = &archive->blocks[i];
+    u8 *raw = dest_bytes + (u64)i * archive->header.block_size;
+
+    if (block->compressed_size == 0) {
+      de100_mem_set(raw, 0, block->raw_size);
+      continue;
+    }
+
+    if (!read_at(archive->fd, block->offset, archive->compressed,
+                 block->compressed_size)) {
+      return make_result(false, REPLAY_ARCHIVE_ERROR_READ_FAILED, 0);
+    }
+
+    De100CompressResult unpacked =
+        de100_lz_decompress(archive->compressed, block->compressed_size, raw,
+                            block->raw_size);
+    if (!unpacked.success || unpacked.size != block->raw_size) {
+      return make_result(false, REPLAY_ARCHIVE_ERROR_COMPRESSION_FAILED, 0);
+    }
+  }
+
+  return make_result(true, REPLAY_ARCHIVE_SUCCESS,
+                     archive->header.snapshot_size);
+}
+
+ReplayArchiveResult replay_archive_read_frame(ReplayArchive *archive,
+                                              u64 frame_index, void *out) {
+  if (!archive || !out || archive->fd < 0) {
+    return make_result(false, REPLAY_ARCHIVE_ERROR_NULL_POINTER, 0);
+  }
+
+  ReplayArchiveHeader *header = &archive->header;
+  if (frame_index >= header->frame_count) {
+    return make_result(false, REPLAY_ARCHIVE_ERROR_FRAME_OUT_OF_RANGE, 0);
+  }
+
+  i64 chunk_index = (i64)(frame_index / header->frames_per_chunk);
+  if (chunk_index != archive->cached_chunk) {
+    ReplayArchiveChunkEntry *chunk = &archive->chunks[chunk_index];
+    u64 raw_size = (u64)chunk->frame_count * header->input_frame_size;
+
+    archive->cached_chunk = -1;
+    if (!read_at(archive->fd, chunk->offset, archive->compressed,
+                 chunk->compressed_size)) {
+      return make_result(false, REPLAY_ARCHIVE_ERROR_READ_FAILED, 0);
+    }
+
+    De100CompressResult unpacked =
+        de100_lz_decompress(archive->compressed, chunk->compressed_size,
+                            archive->chunk_frames, (size_t)raw_size);
+    if (!unpacked.success || unpacked.size != raw_size) {
+      return make_result(false, REPLAY_ARCHIVE_ERROR_COMPRESSION_FAILED, 0);
+    }
+
+    // Undo the delta front to back
+    for (u32 f = 1; f < chunk->frame_count; ++f) {
+      xor_bytes(archive->chunk_frames + (u64)f * header->input_frame_size,
+                archive->chunk_frames + (u64)(f - 1) * header->input_frame_size,
+                header->input_frame_size);
+    }
+    archive->cached_chunk = chunk_index;
+  }
+
+  u64 frame_in_chunk = frame_index % header->frames_per_chunk;
+  de100_mem_copy(out,
+                 archive->chunk_frames +
+                     frame_in_chunk * header->input_frame_size,
+                 header->input_frame_size);
+  return make_result(true, REPLAY_ARCHIVE_SUCCESS, header->input_frame_size);
+}
+
+void replay_archive_close(ReplayArchive *archive) {
+  if (!archive) {
+    return;
+  }
+
+  if (archive->fd >= 0) {
+    de100_file_close(archive->fd);
+    archive->fd = -1;
+  }
+  if (de100_memory_is_valid(archive->tables)) {
+    de100_memory_free(&archive->tables);
+  }
+  if (de100_memory_is_valid(archive->scratch)) {
+    de100_memory_free(&archive->scratch);
+  }
+  archive->blocks = NULL;
+  archive->chunks = NULL;
+  archive->cached_chunk = -1;
+}
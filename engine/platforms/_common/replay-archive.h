@@ -0,0 +1,169 @@
+#ifndef DE100_REPLAY_ARCHIVE_H
+#define DE100_REPLAY_ARCHIVE_H
+
+#include "../../_common/base.h"
+#include "../../_common/memory.h"
+#include <stdbool.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// REPLAY ARCHIVE (.hmr) - compressed, seekable, shippable replays
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// The live replay slots are raw mmap'd files as big as game memory. An
+// archive packs one slot (snapshot + input stream) into a single small file
+// for QA / bug reports:
+//
+//   ┌──────────────────┐
+//   │ Header           │  sizes, counts, table offsets
+//   ├──────────────────┤
+//   │ Snapshot blocks  │  1MB blocks, LZ-compressed; all-zero blocks are
+//   │                  │  not stored at all (most of game memory)
+//   ├──────────────────┤
+//   │ Input chunks     │  256 frames each, XOR-delta against the previous
+//   │                  │  frame (first frame of a chunk against zero), then
+//   │                  │  LZ-compressed. Unchanged input → zero bytes.
+//   ├──────────────────┤
+//   │ Block table      │  offset/size per snapshot block
+//   │ Chunk table      │  offset/size per input chunk (the frame index)
+//   └──────────────────┘
+//
+// Seeking to frame N decodes only chunk N / frames_per_chunk.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define REPLAY_ARCHIVE_MAGIC 0x41524544u // "DERA" little-endian
+#define REPLAY_ARCHIVE_VERSION 1
+#define REPLAY_ARCHIVE_BLOCK_SIZE MEGABYTES(1)
+#define REPLAY_ARCHIVE_FRAMES_PER_CHUNK 256
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ERROR CODES
+// ═══════════════════════════════════════════════════════════════════════════
+
+typedef enum {
+  REPLAY_ARCHIVE_SUCCESS = 0,
+  REPLAY_ARCHIVE_ERROR_NULL_POINTER,
+  REPLAY_ARCHIVE_ERROR_FILE_OPEN_FAILED,
+  REPLAY_ARCHIVE_ERROR_WRITE_FAILED,
+  REPLAY_ARCHIVE_ERROR_READ_FAILED,
+  REPLAY_ARCHIVE_ERROR_BAD_HEADER,
+  REPLAY_ARCHIVE_ERROR_VERSION_MISMATCH,
+  REPLAY_ARCHIVE_ERROR_SIZE_MISMATCH,
+  REPLAY_ARCHIVE_ERROR_OUT_OF_MEMORY,
+  REPLAY_ARCHIVE_ERROR_COMPRESSION_FAILED,
+  REPLAY_ARCHIVE_ERROR_FRAME_OUT_OF_RANGE,
+
+  REPLAY_ARCHIVE_ERROR_COUNT
+} ReplayArchiveErrorCode;
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ON-DISK STRUCTURES
+// ═══════════════════════════════════════════════════════════════════════════
+
+typedef struct {
+  u32 magic;
+  u32 version;
+  u64 snapshot_size;
+  u32 block_size;
+  u32 block_count;
+  u32 input_frame_size; // sizeof(GameInput) when recorded
+  u32 frames_per_chunk;
+  u64 frame_count;
+  u32 chunk_count;
+  u32 reserved;
+  u64 block_table_offset;
+  u64 chunk_table_offset;
+} ReplayArchiveHeader;
+
+typedef struct {
+  u64 offset;
+  u32 compressed_size; // 0 = all-zero block, nothing stored
+  u32 raw_size;
+} ReplayArchiveBlockEntry;
+
+typedef struct {
+  u64 offset;
+  u32 compressed_size;
+  u32 frame_count;
+} ReplayArchiveChunkEntry;
+
+// ═══════════════════════════════════════════════════════════════════════════
+// READER STATE
+// ═══════════════════════════════════════════════════════════════════════════
+
+typedef struct {
+  i32 fd;
+  ReplayArchiveHeader header;
+  De100MemoryBlock tables; // Block table followed by chunk table
+  ReplayArchiveBlockEntry *blocks;
+  ReplayArchiveChunkEntry *chunks;
+
+  // Decode scratch: compressed bytes + one decoded chunk
+  De100MemoryBlock scratch;
+  u8 *compressed;
+  u8 *chunk_frames;
+  i64 cached_chunk; // -1 = none
+} ReplayArchive;
+
+// ═══════════════════════════════════════════════════════════════════════════
+// RESULT STRUCTURES
+// ═══════════════════════════════════════════════════════════════════════════
+
+typedef struct {
+  bool success;
+  ReplayArchiveErrorCode error_code;
+  u64 bytes_written; // Archive size (write) / bytes restored (read)
+} ReplayArchiveResult;
+
+// ═══════════════════════════════════════════════════════════════════════════
+// API FUNCTIONS
+// ═══════════════════════════════════════════════════════════════════════════
+
+/**
+ * Fill `frames` with the next `count` raw input frames, in order.
+ */
+typedef bool ReplayArchiveReadFrames(void *user_data, void *frames,
+                                     u32 count);
+
+/**
+ * Write an archive from a snapshot and a sequence of input frames.
+ *
+ * @param path              Output file
+ * @param snapshot          Game memory snapshot (e.g. a replay buffer)
+ * @param snapshot_size     Bytes of snapshot
+ * @param frame_count       Input frames read_frames will supply
+ * @param input_frame_size  sizeof(GameInput)
+ * @param read_frames       Called once per chunk (see input-stream.h for
+ *                          the recorded .hmi stream)
+ */
+ReplayArchiveResult replay_archive_write(const char *path,
+                                         const void *snapshot,
+                                         u64 snapshot_size, u64 frame_count,
+                                         u32 input_frame_size,
+                                         ReplayArchiveReadFrames *read_frames,
+                                         void *user_data);
+
+/**
+ * Open an archive and load its tables. Close with replay_archive_close().
+ */
+ReplayArchiveResult replay_archive_open(const char *path,
+                                        ReplayArchive *archive);
+
+/**
+ * Decompress the snapshot into `dest` (must hold header.snapshot_size).
+ */
+ReplayArchiveResult replay_archive_read_snapshot(ReplayArchive *archive,
+                                                 void *dest, u64 dest_size);
+
+/**
+ * Decode one input frame (random access; consecutive frames in the same
+ * chunk are served from the cached chunk).
+ */
+ReplayArchiveResult replay_archive_read_frame(ReplayArchive *archive,
+                                              u64 frame_index, void *out);
+
+void replay_archive_close(ReplayArchive *archive);
+
+const char *replay_archive_strerror(ReplayArchiveErrorCode code);
+
+#endif // DE100_REPLAY_ARCHIVE_H
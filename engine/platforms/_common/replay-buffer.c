@@ -1,5 +1,6 @@
 #include "./replay-buffer.h"
 #include "../../_common/file.h"
+#include "../../_common/log.h"
 #include "../../_common/memory.h"
 
 #include <stdio.h>
@@ -17,6 +18,8 @@
 #elif defined(__linux__) || defined(__APPLE__) || defined(__FreeBSD__) ||      \
     defined(__unix__) || defined(__MACH__)
 #include <errno.h>
+#include <pthread.h>
+#include <signal.h>
 #include <sys/mman.h>
 #include <unistd.h>
 #else
@@ -43,6 +46,10 @@ de100_file_scoped_global_var const char *g_replay_buffer_error_messages[] = {
     [REPLAY_BUFFER_ERROR_SAVE_FAILED] = "Failed to save state to replay buffer",
     [REPLAY_BUFFER_ERROR_RESTORE_FAILED] =
         "Failed to restore state from replay buffer",
+    [REPLAY_BUFFER_ERROR_TRACKING_UNSUPPORTED] =
+        "Write tracking not supported on this platform",
+    [REPLAY_BUFFER_ERROR_PROTECT_FAILED] =
+        "Failed to change page protection on game memory",
 };
 
 const char *replay_buffer_strerror(ReplayBufferErrorCode code) {
@@ -162,9 +169,7 @@ de100_file_scoped_fn void *de100_mmap_file(i32 fd, u64 size,
   );
 
   if (ptr == MAP_FAILED) {
-#if DE100_INTERNAL && DE100_SLOW
-    fprintf(stderr, "[REPLAY BUFFER] mmap failed: %s\n", strerror(errno));
-#endif
+    DE100_LOG_ERROR(DE100_LOG_REPLAY, "mmap failed: %s", strerror(errno));
     *out_error = REPLAY_BUFFER_ERROR_MMAP_FAILED;
     return NULL;
   }
@@ -180,9 +185,7 @@ de100_file_scoped_fn void de100_munmap_file(void *ptr, u64 size) {
 
 de100_file_scoped_fn bool de100_file_resize(i32 fd, u64 size) {
   if (ftruncate(fd, (off_t)size) != 0) {
-#if DE100_INTERNAL && DE100_SLOW
-    fprintf(stderr, "[REPLAY BUFFER] ftruncate failed: %s\n", strerror(errno));
-#endif
+    DE100_LOG_ERROR(DE100_LOG_REPLAY, "ftruncate failed: %s", strerror(errno));
     return false;
   }
   return true;
@@ -217,10 +220,8 @@ ReplayBufferInitResult replay_buffers_init(const char *exe_directory,
     exe_directory = "./"; // Default to current directory
   }
 
-#if DE100_INTERNAL
-  printf("[REPLAY BUFFER] Initializing %d buffers (%.2f MB each)\n",
-         MAX_REPLAY_BUFFERS, (double)total_size / (1024.0 * 1024.0));
-#endif
+  DE100_LOG_DEBUG(DE100_LOG_REPLAY, "Initializing %d buffers (%.2f MB each)",
+                  MAX_REPLAY_BUFFERS, (double)total_size / (1024.0 * 1024.0));
 
   // ─────────────────────────────────────────────────────────────────────
   // Initialize each buffer
@@ -251,10 +252,9 @@ ReplayBufferInitResult replay_buffers_init(const char *exe_directory,
                               DE100_FILE_CREATE | DE100_FILE_TRUNCATE);
 
     if (!open_result.success) {
-#if DE100_INTERNAL && DE100_SLOW
-      fprintf(stderr, "[REPLAY BUFFER] Failed to create '%s': %s\n",
-              buffer->filename, de100_file_strerror(open_result.error_code));
-#endif
+      DE100_LOG_ERROR(DE100_LOG_REPLAY, "Failed to create '%s': %s",
+                      buffer->filename,
+                      de100_file_strerror(open_result.error_code));
       buffer->last_error = REPLAY_BUFFER_ERROR_FILE_CREATE_FAILED;
       continue;
     }
@@ -294,13 +294,13 @@ ReplayBufferInitResult replay_buffers_init(const char *exe_directory,
     // ─────────────────────────────────────────────────────────────────
 
     buffer->mapped_size = (size_t)total_size;
+    buffer->snapshot_size = total_size; // Whatever the file held before
     buffer->is_valid = true;
     buffer->last_error = REPLAY_BUFFER_SUCCESS;
     result.buffers_initialized++;
 
-#if DE100_INTERNAL
-    printf("[REPLAY BUFFER] ✅ Slot %d ready: %s\n", slot, buffer->filename);
-#endif
+    DE100_LOG_DEBUG(DE100_LOG_REPLAY, "Slot %d ready: %s", slot,
+                    buffer->filename);
   }
 
   // ─────────────────────────────────────────────────────────────────────
@@ -314,14 +314,12 @@ ReplayBufferInitResult replay_buffers_init(const char *exe_directory,
     result.error_code = REPLAY_BUFFER_ERROR_MMAP_FAILED;
   }
 
-#if DE100_INTERNAL
   if (result.success) {
-    printf("[REPLAY BUFFER] ✅ %d/%d buffers initialized\n",
-           result.buffers_initialized, MAX_REPLAY_BUFFERS);
+    DE100_LOG_DEBUG(DE100_LOG_REPLAY, "%d/%d buffers initialized",
+                    result.buffers_initialized, MAX_REPLAY_BUFFERS);
   } else {
-    printf("[REPLAY BUFFER] ❌ All buffers failed to initialize\n");
+    DE100_LOG_ERROR(DE100_LOG_REPLAY, "All buffers failed to initialize");
   }
-#endif
 
   return result;
 }
@@ -335,9 +333,7 @@ void replay_buffers_shutdown(ReplayBuffer *buffers, u64 total_size) {
     return;
   }
 
-#if DE100_INTERNAL
-  printf("[REPLAY BUFFER] Shutting down...\n");
-#endif
+  DE100_LOG_DEBUG(DE100_LOG_REPLAY, "Shutting down...");
 
   for (i32 slot = VALID_REPLAY_BUFFERS_START_INDEX; slot < MAX_REPLAY_BUFFERS;
        ++slot) {
@@ -359,9 +355,7 @@ void replay_buffers_shutdown(ReplayBuffer *buffers, u64 total_size) {
     buffer->is_valid = false;
   }
 
-#if DE100_INTERNAL
-  printf("[REPLAY BUFFER] ✅ Shutdown complete\n");
-#endif
+  DE100_LOG_DEBUG(DE100_LOG_REPLAY, "Shutdown complete");
 }
 
 // ═══════════════════════════════════════════════════════════════════════════
@@ -375,10 +369,8 @@ ReplayBuffer *replay_buffer_get(ReplayBuffer *buffers, i32 slot_index) {
 
   if (slot_index < VALID_REPLAY_BUFFERS_START_INDEX ||
       slot_index >= MAX_REPLAY_BUFFERS) {
-#if DE100_INTERNAL && DE100_SLOW
-    fprintf(stderr, "[REPLAY BUFFER] Invalid slot index: %d (max %d)\n",
-            slot_index, MAX_REPLAY_BUFFERS - 1);
-#endif
+    DE100_LOG_ERROR(DE100_LOG_REPLAY, "Invalid slot index: %d (max %d)",
+                    slot_index, MAX_REPLAY_BUFFERS - 1);
     return NULL;
   }
 
@@ -410,15 +402,16 @@ ReplayBufferResult replay_buffer_save_state(ReplayBuffer *buffer,
   // THE MAGIC: Just a memcpy!
   // ─────────────────────────────────────────────────────────────────────
   // This copies from game memory to the memory-mapped region.
-  // ~50-100ms for 1GB vs 2-5 seconds with file I/O.
+  // ~50-100ms for 1GB vs 2-5 seconds with file I/O; streaming stores
+  // split across the work queue (de100_mem_copy_large) bring it down to
+  // what memory bandwidth allows.
   // ─────────────────────────────────────────────────────────────────────
 
-  de100_mem_copy(buffer->memory_block, game_memory, (size_t)total_size);
+  de100_mem_copy_large(buffer->memory_block, game_memory, (size_t)total_size);
+  buffer->snapshot_size = total_size;
 
-#if DE100_INTERNAL
-  printf("[REPLAY BUFFER] 📸 Saved state (%.2f MB)\n",
-         (double)total_size / (1024.0 * 1024.0));
-#endif
+  DE100_LOG_DEBUG(DE100_LOG_REPLAY, "Saved state (%.2f MB)",
+                  (double)total_size / (1024.0 * 1024.0));
 
   buffer->last_error = REPLAY_BUFFER_SUCCESS;
   return make_result(true, REPLAY_BUFFER_SUCCESS);
@@ -447,12 +440,569 @@ ReplayBufferResult replay_buffer_restore_state(const ReplayBuffer *buffer,
   // THE MAGIC: Just a memcpy!
   // ─────────────────────────────────────────────────────────────────────
 
-  de100_mem_copy(game_memory, buffer->memory_block, (size_t)total_size);
+  de100_mem_copy_large(game_memory, buffer->memory_block, (size_t)total_size);
+
+  DE100_LOG_DEBUG(DE100_LOG_REPLAY, "Restored state (%.2f MB)",
+                  (double)total_size / (1024.0 * 1024.0));
+
+  return make_result(true, REPLAY_BUFFER_SUCCESS);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// SNAPSHOT TRACKER
+// ═══════════════════════════════════════════════════════════════════════════
+
+// Only one tracker can own the fault handler at a time
+de100_file_scoped_global_var ReplaySnapshotTracker *g_armed_tracker = NULL;
+
+// page_copy_state values during an async capture
+#define PAGE_NOT_COPIED 0
+#define PAGE_COPYING 1
+#define PAGE_COPIED 2
+
+/**
+ * Copy one page into the capture destination unless someone else already
+ * did. Called by both the copier thread and the fault handler; whoever
+ * wins the CAS copies, everyone else waits for PAGE_COPIED.
+ */
+de100_file_scoped_fn inline void capture_page(ReplaySnapshotTracker *tracker,
+                                              u64 page) {
+  u8 *state = (u8 *)tracker->page_copy_state.base + page;
+  u8 expected = PAGE_NOT_COPIED;
+  if (__atomic_compare_exchange_n(state, &expected, PAGE_COPYING, false,
+                                  __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+    u64 offset = page * tracker->page_size;
+    u64 length = tracker->page_size;
+    if (offset + length > tracker->size) {
+      length = tracker->size - offset;
+    }
+    de100_mem_copy(tracker->capture_destination + offset,
+                   tracker->base + offset, (size_t)length);
+    __atomic_store_n(state, PAGE_COPIED, __ATOMIC_RELEASE);
+    return;
+  }
+
+  while (__atomic_load_n(state, __ATOMIC_ACQUIRE) != PAGE_COPIED) {
+    // Copier is mid-page; a 4KB memcpy finishes quickly
+  }
+}
+
+#if defined(_WIN32)
+
+de100_file_scoped_fn inline bool install_fault_handler(void) { return false; }
+de100_file_scoped_fn inline void remove_fault_handler(void) {}
+de100_file_scoped_fn inline bool start_capture_thread(void) { return false; }
+de100_file_scoped_fn inline void join_capture_thread(void) {}
+
+#else // POSIX
+
+de100_file_scoped_global_var pthread_t g_capture_thread;
+
+de100_file_scoped_fn void *capture_thread_proc(void *arg) {
+  ReplaySnapshotTracker *tracker = (ReplaySnapshotTracker *)arg;
+  for (u64 page = 0; page < tracker->page_count; ++page) {
+    capture_page(tracker, page);
+  }
+  __atomic_store_n(&tracker->capture_done, true, __ATOMIC_RELEASE);
+  return NULL;
+}
+
+de100_file_scoped_fn inline bool start_capture_thread(void) {
+  return pthread_create(&g_capture_thread, NULL, capture_thread_proc,
+                        g_armed_tracker) == 0;
+}
+
+de100_file_scoped_fn inline void join_capture_thread(void) {
+  pthread_join(g_capture_thread, NULL);
+}
+
+de100_file_scoped_global_var struct sigaction g_previous_segv_action;
+de100_file_scoped_global_var bool g_fault_handler_installed = false;
+
+de100_file_scoped_fn void replay_fault_handler(int sig, siginfo_t *info,
+                                               void *ucontext) {
+  ReplaySnapshotTracker *tracker = g_armed_tracker;
+  u8 *address = (u8 *)info->si_addr;
+
+  if (tracker && address >= tracker->base &&
+      address < tracker->base + tracker->size) {
+    u64 page = (u64)(address - tracker->base) / tracker->page_size;
+    if (__atomic_load_n(&tracker->is_capturing, __ATOMIC_ACQUIRE)) {
+      // Snapshot must see the pre-write contents
+      capture_page(tracker, page);
+    }
+
+    u8 *dirty = (u8 *)tracker->dirty_pages.base;
+    if (!dirty[page]) {
+      dirty[page] = 1;
+      // mprotect is a plain syscall; fine to call from the handler
+      if (mprotect(tracker->base + page * tracker->page_size,
+                   (size_t)tracker->page_size, PROT_READ | PROT_WRITE) == 0) {
+        return;
+      }
+    } else {
+      // Another thread already unprotected this page; just retry
+      return;
+    }
+  }
+
+  // Not ours: hand over to whoever was installed before us
+  if (g_previous_segv_action.sa_flags & SA_SIGINFO) {
+    g_previous_segv_action.sa_sigaction(sig, info, ucontext);
+  } else if (g_previous_segv_action.sa_handler != SIG_IGN &&
+             g_previous_segv_action.sa_handler != SIG_DFL) {
+    g_previous_segv_action.sa_handler(sig);
+  } else {
+    // Re-raise with the default action so crashes still crash
+    sigaction(SIGSEGV, &g_previous_segv_action, NULL);
+  }
+}
+
+de100_file_scoped_fn inline bool install_fault_handler(void) {
+  if (g_fault_handler_installed) {
+    return true;
+  }
+
+  struct sigaction action = {0};
+  action.sa_sigaction = replay_fault_handler;
+  action.sa_flags = SA_SIGINFO | SA_NODEFER;
+  sigemptyset(&action.sa_mask);
+
+  if (sigaction(SIGSEGV, &action, &g_previous_segv_action) != 0) {
+    return false;
+  }
+  g_fault_handler_installed = true;
+  return true;
+}
+
+de100_file_scoped_fn inline void remove_fault_handler(void) {
+  if (g_fault_handler_installed) {
+    sigaction(SIGSEGV, &g_previous_segv_action, NULL);
+    g_fault_handler_installed = false;
+  }
+}
+
+#endif // Platform selection
+
+de100_file_scoped_fn inline void
+tracker_set_size(ReplaySnapshotTracker *tracker, u64 size) {
+  tracker->size = size;
+  tracker->page_count = (size + tracker->page_size - 1) / tracker->page_size;
+}
+
+de100_file_scoped_fn inline void
+tracker_hold_releases(ReplaySnapshotTracker *tracker, bool hold) {
+  if (tracker->frontier) {
+    __atomic_store_n(&tracker->frontier->releases_held, hold,
+                     __ATOMIC_RELEASE);
+  }
+}
 
+/**
+ * Write-protect the first `size` bytes (the snapshot `buffer` now holds)
+ * and forget previous dirty pages.
+ */
+de100_file_scoped_fn bool tracker_arm(ReplaySnapshotTracker *tracker,
+                                      const ReplayBuffer *buffer, u64 size) {
+  tracker_set_size(tracker, size);
+  de100_mem_set(tracker->dirty_pages.base, 0, (size_t)tracker->page_count);
+  ++tracker->sync_generation;
+  tracker_hold_releases(tracker, true);
+  if (de100_memory_protect(tracker->base, (size_t)tracker->size,
+                           De100_MEMORY_FLAG_READ) != De100_MEMORY_OK) {
+    tracker->is_armed = false;
+    tracker->synced_buffer = NULL;
+    tracker_hold_releases(tracker, false);
+    return false;
+  }
+  tracker->is_armed = true;
+  tracker->synced_buffer = buffer;
+  return true;
+}
+
+de100_file_scoped_fn void tracker_disarm(ReplaySnapshotTracker *tracker) {
+  if (tracker->is_armed) {
+    de100_memory_protect(tracker->base, (size_t)tracker->size,
+                         De100_MEMORY_FLAG_RW);
+    tracker->is_armed = false;
+    tracker_hold_releases(tracker, false);
+  }
+  tracker->synced_buffer = NULL;
+}
+
+/**
+ * The frontier moved since the last sync: copy the new pages whole and
+ * start tracking them.
+ */
+de100_file_scoped_fn bool tracker_grow(ReplaySnapshotTracker *tracker,
+                                       u8 *buffer_memory, u64 size) {
+  u64 old_size = tracker->size;
+  if (size <= old_size) {
+    return true;
+  }
+  de100_mem_copy_large(buffer_memory + old_size, tracker->base + old_size,
+                       (size_t)(size - old_size));
+  tracker_set_size(tracker, size);
 #if DE100_INTERNAL
-  printf("[REPLAY BUFFER] 🔄 Restored state (%.2f MB)\n",
-         (double)total_size / (1024.0 * 1024.0));
+  tracker->last_bytes_copied += size - old_size;
 #endif
+  return de100_memory_protect(tracker->base + old_size,
+                              (size_t)(size - old_size),
+                              De100_MEMORY_FLAG_READ) == De100_MEMORY_OK;
+}
+
+/**
+ * Copy each run of consecutive dirty pages in one go, then re-protect it.
+ * `to_buffer` selects the direction (save vs restore).
+ */
+de100_file_scoped_fn bool tracker_copy_dirty(ReplaySnapshotTracker *tracker,
+                                             u8 *buffer_memory,
+                                             bool to_buffer) {
+  u8 *dirty = (u8 *)tracker->dirty_pages.base;
+  u64 bytes_copied = 0;
+  bool ok = true;
+  ++tracker->sync_generation;
+
+  u64 page = 0;
+  while (page < tracker->page_count) {
+    if (!dirty[page]) {
+      ++page;
+      continue;
+    }
+
+    u64 run_start = page;
+    while (page < tracker->page_count && dirty[page]) {
+      dirty[page] = 0;
+      ++page;
+    }
+
+    u64 offset = run_start * tracker->page_size;
+    u64 length = (page - run_start) * tracker->page_size;
+    if (offset + length > tracker->size) {
+      length = tracker->size - offset;
+    }
+
+    if (to_buffer) {
+      de100_mem_copy(buffer_memory + offset, tracker->base + offset,
+                     (size_t)length);
+    } else {
+      de100_mem_copy(tracker->base + offset, buffer_memory + offset,
+                     (size_t)length);
+    }
+    bytes_copied += length;
+
+    if (de100_memory_protect(tracker->base + offset, (size_t)length,
+                             De100_MEMORY_FLAG_READ) != De100_MEMORY_OK) {
+      ok = false;
+    }
+  }
+
+#if DE100_INTERNAL
+  tracker->last_bytes_copied = bytes_copied;
+#else
+  (void)bytes_copied;
+#endif
+  return ok;
+}
+
+ReplayBufferResult replay_snapshot_tracker_init(ReplaySnapshotTracker *tracker,
+                                                void *game_memory, u64 size,
+                                                ReplaySnapshotMode mode) {
+  if (!tracker) {
+    return make_result(false, REPLAY_BUFFER_ERROR_NULL_STATE);
+  }
+
+  if (!game_memory || size == 0) {
+    return make_result(false, REPLAY_BUFFER_ERROR_NO_GAME_MEMORY);
+  }
+
+  *tracker = (ReplaySnapshotTracker){0};
+  tracker->mode = REPLAY_SNAPSHOT_MODE_FULL;
+  tracker->base = (u8 *)game_memory;
+  tracker->capacity = size;
+  tracker->page_size = de100_memory_page_size();
+  tracker_set_size(tracker, size);
+
+  if (mode == REPLAY_SNAPSHOT_MODE_FULL) {
+    return make_result(true, REPLAY_BUFFER_SUCCESS);
+  }
+
+  if (g_armed_tracker || !install_fault_handler()) {
+    return make_result(false, REPLAY_BUFFER_ERROR_TRACKING_UNSUPPORTED);
+  }
+
+  // Sized for the whole range; page_count follows `size`
+  tracker->dirty_pages = de100_memory_alloc(NULL, (size_t)tracker->page_count,
+                                            De100_MEMORY_FLAG_RW_ZEROED);
+  if (!de100_memory_is_valid(tracker->dirty_pages)) {
+    remove_fault_handler();
+    return make_result(false, REPLAY_BUFFER_ERROR_NO_GAME_MEMORY);
+  }
+
+  tracker->mode = REPLAY_SNAPSHOT_MODE_INCREMENTAL;
+  g_armed_tracker = tracker;
+
+  if (mode == REPLAY_SNAPSHOT_MODE_ASYNC) {
+    tracker->page_copy_state = de100_memory_alloc(
+        NULL, (size_t)tracker->page_count, De100_MEMORY_FLAG_RW_ZEROED);
+    if (!de100_memory_is_valid(tracker->page_copy_state)) {
+      // Still incremental, just with synchronous full copies
+      return make_result(false, REPLAY_BUFFER_ERROR_NO_GAME_MEMORY);
+    }
+    tracker->mode = REPLAY_SNAPSHOT_MODE_ASYNC;
+  }
+
+  DE100_LOG_DEBUG(DE100_LOG_REPLAY,
+                  "Incremental snapshots: %lu pages of %lu bytes",
+                  (unsigned long)tracker->page_count,
+                  (unsigned long)tracker->page_size);
+
+  return make_result(true, REPLAY_BUFFER_SUCCESS);
+}
+
+void replay_snapshot_tracker_shutdown(ReplaySnapshotTracker *tracker) {
+  if (!tracker || tracker->mode == REPLAY_SNAPSHOT_MODE_FULL) {
+    return;
+  }
+
+  replay_snapshot_tracker_wait(tracker);
+  tracker_disarm(tracker);
+  if (g_armed_tracker == tracker) {
+    g_armed_tracker = NULL;
+    remove_fault_handler();
+  }
+  de100_memory_free(&tracker->dirty_pages);
+  if (de100_memory_is_valid(tracker->page_copy_state)) {
+    de100_memory_free(&tracker->page_copy_state);
+  }
+  tracker->mode = REPLAY_SNAPSHOT_MODE_FULL;
+}
+
+void replay_snapshot_tracker_set_frontier(ReplaySnapshotTracker *tracker,
+                                          De100CommitFrontier *frontier) {
+  if (!tracker) {
+    return;
+  }
+  tracker->frontier = frontier;
+  tracker_set_size(tracker, replay_snapshot_tracker_extent(tracker));
+}
+
+u64 replay_snapshot_tracker_extent(const ReplaySnapshotTracker *tracker) {
+  if (!tracker->frontier) {
+    return tracker->capacity;
+  }
+  u64 extent = (u64)(tracker->frontier->base - tracker->base) +
+               de100_commit_frontier_committed(tracker->frontier);
+  return extent < tracker->capacity ? extent : tracker->capacity;
+}
+
+bool replay_snapshot_tracker_commit(ReplaySnapshotTracker *tracker, u64 size) {
+  if (size > tracker->capacity) {
+    return false;
+  }
+  if (!tracker->frontier) {
+    return true;
+  }
+  u64 offset = (u64)(tracker->frontier->base - tracker->base);
+  return size <= offset ||
+         de100_commit_frontier_grow(tracker->frontier, size - offset);
+}
+
+/**
+ * Fork-style full save: protect everything now, copy in the background.
+ * Falls back to a synchronous copy if the thread can't start.
+ */
+de100_file_scoped_fn bool begin_async_capture(ReplaySnapshotTracker *tracker,
+                                              ReplayBuffer *buffer, u64 size) {
+  tracker_set_size(tracker, size);
+  de100_mem_set(tracker->page_copy_state.base, PAGE_NOT_COPIED,
+                (size_t)tracker->page_count);
+  tracker->capture_destination = (u8 *)buffer->memory_block;
+  tracker->capture_done = false;
+  __atomic_store_n(&tracker->is_capturing, true, __ATOMIC_RELEASE);
+
+  // Protect AFTER is_capturing is visible, so the first write already
+  // goes through capture_page()
+  if (!tracker_arm(tracker, buffer, size)) {
+    __atomic_store_n(&tracker->is_capturing, false, __ATOMIC_RELEASE);
+    return false;
+  }
+
+  if (!start_capture_thread()) {
+    for (u64 page = 0; page < tracker->page_count; ++page) {
+      capture_page(tracker, page);
+    }
+    __atomic_store_n(&tracker->is_capturing, false, __ATOMIC_RELEASE);
+  }
+  return true;
+}
+
+de100_file_scoped_fn void
+finish_async_capture(ReplaySnapshotTracker *tracker) {
+  join_capture_thread();
+  __atomic_store_n(&tracker->is_capturing, false, __ATOMIC_RELEASE);
+
+  DE100_LOG_DEBUG(DE100_LOG_REPLAY, "Background capture finished (%.2f MB)",
+                  (double)tracker->size / (1024.0 * 1024.0));
+
+  // Playback will read all of it soon; start paging it in now
+  if (tracker->synced_buffer) {
+    replay_buffer_prefetch(tracker->synced_buffer, tracker->size);
+  }
+}
+
+bool replay_snapshot_tracker_update(ReplaySnapshotTracker *tracker) {
+  if (!tracker || !tracker->is_capturing ||
+      !__atomic_load_n(&tracker->capture_done, __ATOMIC_ACQUIRE)) {
+    return false;
+  }
+
+  finish_async_capture(tracker);
+  return true;
+}
+
+void replay_snapshot_tracker_wait(ReplaySnapshotTracker *tracker) {
+  if (!tracker || !tracker->is_capturing) {
+    return;
+  }
+
+  if (!__atomic_load_n(&tracker->capture_done, __ATOMIC_ACQUIRE)) {
+    DE100_LOG_DEBUG(DE100_LOG_REPLAY, "Waiting for background capture...");
+  }
+  finish_async_capture(tracker);
+}
+
+void replay_snapshot_tracker_invalidate(ReplaySnapshotTracker *tracker) {
+  if (!tracker || tracker->mode == REPLAY_SNAPSHOT_MODE_FULL) {
+    return;
+  }
+
+  replay_snapshot_tracker_wait(tracker);
+  tracker_disarm(tracker); // Also forgets synced_buffer
+}
+
+void replay_buffer_prefetch(const ReplayBuffer *buffer, u64 size) {
+  if (!replay_buffer_is_valid(buffer)) {
+    return;
+  }
+  if (size > buffer->mapped_size) {
+    size = buffer->mapped_size;
+  }
+#if defined(_WIN32)
+  WIN32_MEMORY_RANGE_ENTRY range = {buffer->memory_block, (SIZE_T)size};
+  PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+#else
+  posix_madvise(buffer->memory_block, (size_t)size, POSIX_MADV_WILLNEED);
+#endif
+}
+
+ReplayBufferResult replay_buffer_save_tracked(ReplayBuffer *buffer,
+                                              ReplaySnapshotTracker *tracker) {
+  if (!buffer || !tracker) {
+    return make_result(false, REPLAY_BUFFER_ERROR_NULL_STATE);
+  }
+
+  u64 size = replay_snapshot_tracker_extent(tracker);
+  if (!buffer->is_valid || !buffer->memory_block ||
+      buffer->mapped_size < size) {
+    buffer->last_error = REPLAY_BUFFER_ERROR_BUFFER_NOT_VALID;
+    return make_result(false, REPLAY_BUFFER_ERROR_BUFFER_NOT_VALID);
+  }
+
+  if (tracker->mode == REPLAY_SNAPSHOT_MODE_FULL) {
+    tracker_set_size(tracker, size);
+    return replay_buffer_save_state(buffer, tracker->base, size);
+  }
+
+  replay_snapshot_tracker_wait(tracker);
+
+  if (tracker->is_armed && tracker->synced_buffer == buffer) {
+    if (!tracker_copy_dirty(tracker, (u8 *)buffer->memory_block, true) ||
+        !tracker_grow(tracker, (u8 *)buffer->memory_block, size)) {
+      tracker_disarm(tracker);
+      buffer->last_error = REPLAY_BUFFER_ERROR_PROTECT_FAILED;
+      return make_result(false, REPLAY_BUFFER_ERROR_PROTECT_FAILED);
+    }
+  } else if (tracker->mode == REPLAY_SNAPSHOT_MODE_ASYNC) {
+    tracker_disarm(tracker);
+    if (!begin_async_capture(tracker, buffer, size)) {
+      buffer->last_error = REPLAY_BUFFER_ERROR_PROTECT_FAILED;
+      return make_result(false, REPLAY_BUFFER_ERROR_PROTECT_FAILED);
+    }
+    buffer->snapshot_size = size;
+#if DE100_INTERNAL
+    tracker->last_bytes_copied = 0;
+    DE100_LOG_DEBUG(DE100_LOG_REPLAY, "Captured state, copying in background");
+#endif
+    buffer->last_error = REPLAY_BUFFER_SUCCESS;
+    return make_result(true, REPLAY_BUFFER_SUCCESS);
+  } else {
+    // Reading protected pages is fine, no need to disarm first
+    de100_mem_copy_large(buffer->memory_block, tracker->base, (size_t)size);
+#if DE100_INTERNAL
+    tracker->last_bytes_copied = size;
+#endif
+    if (!tracker_arm(tracker, buffer, size)) {
+      buffer->last_error = REPLAY_BUFFER_ERROR_PROTECT_FAILED;
+      return make_result(false, REPLAY_BUFFER_ERROR_PROTECT_FAILED);
+    }
+  }
+  buffer->snapshot_size = size;
+
+  DE100_LOG_DEBUG(DE100_LOG_REPLAY,
+                  "Saved state incrementally (%.2f MB copied)",
+                  (double)tracker->last_bytes_copied / (1024.0 * 1024.0));
+
+  buffer->last_error = REPLAY_BUFFER_SUCCESS;
+  return make_result(true, REPLAY_BUFFER_SUCCESS);
+}
+
+ReplayBufferResult
+replay_buffer_restore_tracked(const ReplayBuffer *buffer,
+                              ReplaySnapshotTracker *tracker) {
+  if (!buffer || !tracker) {
+    return make_result(false, REPLAY_BUFFER_ERROR_NULL_STATE);
+  }
+
+  u64 size = buffer->snapshot_size;
+  if (!buffer->is_valid || !buffer->memory_block || size == 0 ||
+      buffer->mapped_size < size || size > tracker->capacity) {
+    return make_result(false, REPLAY_BUFFER_ERROR_BUFFER_NOT_VALID);
+  }
+
+  // Pages the snapshot had committed must be writable again
+  if (!replay_snapshot_tracker_commit(tracker, size)) {
+    return make_result(false, REPLAY_BUFFER_ERROR_RESTORE_FAILED);
+  }
+
+  if (tracker->mode == REPLAY_SNAPSHOT_MODE_FULL) {
+    tracker_set_size(tracker, size);
+    return replay_buffer_restore_state(buffer, tracker->base, size);
+  }
+
+  replay_snapshot_tracker_wait(tracker);
+
+  if (tracker->is_armed && tracker->synced_buffer == buffer) {
+    // Dirty pages are already writable; clean ones already match. Pages
+    // committed since are past the snapshot: nothing to restore there.
+    if (!tracker_copy_dirty(tracker, (u8 *)buffer->memory_block, false)) {
+      tracker_disarm(tracker);
+      return make_result(false, REPLAY_BUFFER_ERROR_PROTECT_FAILED);
+    }
+  } else {
+    tracker_disarm(tracker);
+    de100_mem_copy_large(tracker->base, buffer->memory_block, (size_t)size);
+#if DE100_INTERNAL
+    tracker->last_bytes_copied = size;
+#endif
+    if (!tracker_arm(tracker, buffer, size)) {
+      return make_result(false, REPLAY_BUFFER_ERROR_PROTECT_FAILED);
+    }
+  }
+
+  DE100_LOG_DEBUG(DE100_LOG_REPLAY,
+                  "Restored state incrementally (%.2f MB copied)",
+                  (double)tracker->last_bytes_copied / (1024.0 * 1024.0));
 
   return make_result(true, REPLAY_BUFFER_SUCCESS);
 }
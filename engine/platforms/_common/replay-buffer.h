@@ -2,6 +2,7 @@
 #define DE100_REPLAY_BUFFER_H
 
 #include "../../_common/base.h"
+#include "../../_common/memory.h"
 #include "./memory.h"
 #include <stdbool.h>
 
@@ -20,6 +21,9 @@
 #define VALID_REPLAY_BUFFERS_START_INDEX 1
 #define REPLAY_BUFFER_FILENAME_MAX 256
 
+// Full copies go through de100_mem_copy_large: streaming stores that
+// leave the cache alone, split across the work queue when large
+
 // ═══════════════════════════════════════════════════════════════════════════
 // ERROR CODES
 // ═══════════════════════════════════════════════════════════════════════════
@@ -35,6 +39,8 @@ typedef enum {
   REPLAY_BUFFER_ERROR_BUFFER_NOT_VALID,
   REPLAY_BUFFER_ERROR_SAVE_FAILED,
   REPLAY_BUFFER_ERROR_RESTORE_FAILED,
+  REPLAY_BUFFER_ERROR_TRACKING_UNSUPPORTED,
+  REPLAY_BUFFER_ERROR_PROTECT_FAILED,
 
   REPLAY_BUFFER_ERROR_COUNT
 } ReplayBufferErrorCode;
@@ -47,11 +53,95 @@ typedef struct {
   i32 file_fd;        // File descriptor
   void *memory_block; // mmap'd region (or allocated block on Windows)
   size_t mapped_size; // Size of the mapped region
+  u64 snapshot_size;  // Bytes the last save wrote (<= mapped_size)
   char filename[REPLAY_BUFFER_FILENAME_MAX]; // Path to backing file
   bool is_valid;                             // Ready for use?
   ReplayBufferErrorCode last_error;          // Last error for this buffer
 } ReplayBuffer;
 
+// ═══════════════════════════════════════════════════════════════════════════
+// SNAPSHOT TRACKER (Incremental snapshots)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// INCREMENTAL mode write-protects the snapshotted range after every
+// save/restore. The first write to each page faults once; the handler marks
+// the page dirty and unprotects it. The next save/restore against the SAME
+// buffer copies only the dirty pages:
+//
+//   save(slot 1)      full copy, arm          (first time only)
+//   ...game runs...   N pages dirtied
+//   restore(slot 1)   copy N pages back, re-arm
+//
+// Switching to another buffer falls back to one full copy and re-arms.
+//
+// ASYNC mode makes that full copy fork-style: the range is write-protected
+// (instant) and a background thread copies it out. If the game writes a
+// page the thread hasn't reached yet, the fault handler copies that page
+// first, so the snapshot is exactly the state at capture time:
+//
+//   main:    protect all ──► keep running frames ──► update() reaps thread
+//   copier:        └─► copy page 0..N (skipping pages already copied)
+//   fault:   copy page (if not yet copied) ──► mark dirty ──► unprotect
+//
+// Any save/restore while a capture is in flight waits for it first.
+//
+// CAVEAT: while armed, syscalls that WRITE into game memory (read() into a
+// game-owned buffer, etc.) fail with EFAULT instead of faulting. Read files
+// into engine memory first.
+//
+// LAZY TRANSIENT COMMIT: with a commit frontier attached, a snapshot only
+// covers the committed part of the range (permanent storage + the
+// transient prefix in use), and each buffer remembers how much it holds.
+// Restoring commits up to that size first. Pages committed after a sync
+// are beyond the synced snapshot, so the next save to the same buffer
+// copies them whole and starts tracking them. While armed, the tracker
+// holds the frontier's page releases (a released page would silently
+// stop matching the buffer).
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+typedef enum {
+  REPLAY_SNAPSHOT_MODE_FULL = 0,    // Plain memcpy of the whole range
+  REPLAY_SNAPSHOT_MODE_INCREMENTAL, // Copy pages dirtied since last sync
+  REPLAY_SNAPSHOT_MODE_ASYNC,       // INCREMENTAL + full copies off-thread
+} ReplaySnapshotMode;
+
+typedef struct {
+  ReplaySnapshotMode mode;
+  u8 *base;       // Start of game memory
+  u64 capacity;   // Whole range (permanent only if transient is
+                  // disposable)
+  u64 size;       // Bytes snapshotted now (= capacity unless lazy)
+  u64 page_size;
+  u64 page_count; // Pages of `size`
+
+  // Commit frontier of the range's tail (NULL = all of it is committed)
+  De100CommitFrontier *frontier;
+
+  // One byte per page (bytes, not bits: the fault handler can set them
+  // from any thread without read-modify-write races)
+  De100MemoryBlock dirty_pages;
+
+  // Buffer whose contents equal game memory except for the dirty pages
+  const ReplayBuffer *synced_buffer;
+  bool is_armed;
+
+  // Bumped whenever dirty bytes are cleared (arm, save, restore), so
+  // readers of dirty_pages can tell their view is stale
+  u64 sync_generation;
+
+  // ASYNC capture in flight (page_copy_state and capture_done are shared
+  // with the copier thread and the fault handler; __atomic only)
+  De100MemoryBlock page_copy_state;
+  u8 *capture_destination;
+  bool is_capturing;
+  bool32 capture_done;
+
+#if DE100_INTERNAL
+  u64 last_bytes_copied;
+#endif
+} ReplaySnapshotTracker;
+
 // ═══════════════════════════════════════════════════════════════════════════
 // RESULT STRUCTURES
 // ═══════════════════════════════════════════════════════════════════════════
@@ -138,6 +228,84 @@ ReplayBufferResult replay_buffer_restore_state(const ReplayBuffer *buffer,
                                                void *game_memory,
                                                u64 total_size);
 
+/**
+ * Set up the snapshot tracker.
+ *
+ * @param tracker      Tracker to initialize (zeroed)
+ * @param game_memory  Start of game memory (page-aligned)
+ * @param size         Bytes to snapshot, starting at game_memory
+ * @param mode         FULL or INCREMENTAL
+ * @return             Result; on failure the tracker is still usable in
+ *                     FULL mode (e.g. TRACKING_UNSUPPORTED on Windows)
+ */
+ReplayBufferResult replay_snapshot_tracker_init(ReplaySnapshotTracker *tracker,
+                                                void *game_memory, u64 size,
+                                                ReplaySnapshotMode mode);
+
+/**
+ * Unprotect game memory, remove the fault handler, free the dirty map.
+ * Safe to call multiple times.
+ */
+void replay_snapshot_tracker_shutdown(ReplaySnapshotTracker *tracker);
+
+/**
+ * Snapshot only what `frontier` (a part of the range) has committed.
+ * Call right after init, before the first save.
+ */
+void replay_snapshot_tracker_set_frontier(ReplaySnapshotTracker *tracker,
+                                          De100CommitFrontier *frontier);
+
+/**
+ * Bytes a save would cover now: capacity, or up to the frontier.
+ */
+u64 replay_snapshot_tracker_extent(const ReplaySnapshotTracker *tracker);
+
+/**
+ * Commit enough of the range that `size` bytes from base are writable
+ * (before restoring a snapshot of that size from anywhere).
+ */
+bool replay_snapshot_tracker_commit(ReplaySnapshotTracker *tracker, u64 size);
+
+/**
+ * Save game state into a replay buffer through the tracker.
+ * Copies only dirty pages when the buffer is already in sync.
+ */
+ReplayBufferResult replay_buffer_save_tracked(ReplayBuffer *buffer,
+                                              ReplaySnapshotTracker *tracker);
+
+/**
+ * Restore game state from a replay buffer through the tracker.
+ * Copies back only dirty pages when the buffer is already in sync.
+ */
+ReplayBufferResult
+replay_buffer_restore_tracked(const ReplayBuffer *buffer,
+                              ReplaySnapshotTracker *tracker);
+
+/**
+ * Reap a finished async capture. Call once per frame while recording.
+ *
+ * @return true exactly once, on the call that observes the capture finish
+ */
+bool replay_snapshot_tracker_update(ReplaySnapshotTracker *tracker);
+
+/**
+ * Block until any in-flight async capture completes.
+ */
+void replay_snapshot_tracker_wait(ReplaySnapshotTracker *tracker);
+
+/**
+ * Forget which buffer game memory is in sync with and make it writable.
+ * Call before overwriting game memory from somewhere else (e.g. a replay
+ * keyframe); the next save/restore then does one full copy.
+ */
+void replay_snapshot_tracker_invalidate(ReplaySnapshotTracker *tracker);
+
+/**
+ * Ask the OS to fault the buffer's pages in ahead of a restore, so the
+ * first loop doesn't page through the backing file. Non-blocking.
+ */
+void replay_buffer_prefetch(const ReplayBuffer *buffer, u64 size);
+
 /**
  * Check if a replay buffer is valid and ready for use.
  *
@@ -0,0 +1,168 @@
+#include "./replay-hash.h"
+#include "../../_common/hash.h"
+
+// ═══════════════════════════════════════════════════════════════════════════
+// INTERNAL HELPERS
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn inline u64 page_hash(const u8 *memory, u64 size,
+                                          u64 page) {
+  u64 offset = page * REPLAY_STATE_HASH_PAGE_SIZE;
+  u64 length = size - offset < REPLAY_STATE_HASH_PAGE_SIZE
+                   ? size - offset
+                   : REPLAY_STATE_HASH_PAGE_SIZE;
+  return de100_hash64(memory + offset, length, page);
+}
+
+de100_file_scoped_fn inline u64 finish(u64 combined, u64 size) {
+  return de100_hash_mix64(combined ^ size);
+}
+
+/**
+ * Whether the tracker's dirty marks describe every write to our range.
+ */
+de100_file_scoped_fn inline bool
+tracker_is_usable(const ReplayStateHash *hash,
+                  const ReplaySnapshotTracker *tracker) {
+  return tracker && tracker->mode != REPLAY_SNAPSHOT_MODE_FULL &&
+         tracker->is_armed && tracker->base == hash->memory &&
+         tracker->size >= hash->size &&
+         tracker->page_size % REPLAY_STATE_HASH_PAGE_SIZE == 0;
+}
+
+/**
+ * Hash every page, filling the cache when `cache` is non-NULL.
+ */
+de100_file_scoped_fn u64 hash_all_pages(ReplayStateHash *hash, u64 *cache) {
+  u64 combined = 0;
+  for (u64 page = 0; page < hash->page_count; ++page) {
+    u64 value = page_hash(hash->memory, hash->size, page);
+    if (cache) {
+      cache[page] = value;
+    }
+    combined ^= value;
+  }
+#if DE100_INTERNAL
+  hash->last_pages_hashed = hash->page_count;
+#endif
+  return combined;
+}
+
+/**
+ * Swap the hashes of every page inside a dirty tracker page.
+ */
+de100_file_scoped_fn void rehash_dirty_pages(ReplayStateHash *hash,
+                                             const ReplaySnapshotTracker
+                                                 *tracker) {
+  u64 *cache = (u64 *)hash->page_hashes.base;
+  const u8 *dirty = (const u8 *)tracker->dirty_pages.base;
+  u64 pages_per_dirty = tracker->page_size / REPLAY_STATE_HASH_PAGE_SIZE;
+  u64 dirty_count =
+      (hash->page_count + pages_per_dirty - 1) / pages_per_dirty;
+  u64 pages_hashed = 0;
+
+  for (u64 dirty_page = 0; dirty_page < dirty_count; ++dirty_page) {
+    if (!__atomic_load_n(&dirty[dirty_page], __ATOMIC_RELAXED)) {
+      continue;
+    }
+    u64 first = dirty_page * pages_per_dirty;
+    u64 end = first + pages_per_dirty < hash->page_count
+                  ? first + pages_per_dirty
+                  : hash->page_count;
+    for (u64 page = first; page < end; ++page) {
+      u64 value = page_hash(hash->memory, hash->size, page);
+      hash->combined ^= cache[page] ^ value;
+      cache[page] = value;
+    }
+    pages_hashed += end - first;
+  }
+
+#if DE100_INTERNAL
+  hash->last_pages_hashed = pages_hashed;
+#else
+  (void)pages_hashed;
+#endif
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// API
+// ═══════════════════════════════════════════════════════════════════════════
+
+void replay_state_hash_init(ReplayStateHash *hash, const void *memory,
+                            u64 size, u32 interval_frames) {
+  *hash = (ReplayStateHash){0};
+  hash->memory = (const u8 *)memory;
+  hash->size = size;
+  hash->page_count =
+      (size + REPLAY_STATE_HASH_PAGE_SIZE - 1) / REPLAY_STATE_HASH_PAGE_SIZE;
+  hash->interval_frames = memory && size ? interval_frames : 0;
+}
+
+void replay_state_hash_shutdown(ReplayStateHash *hash) {
+  if (!hash) {
+    return;
+  }
+  if (de100_memory_is_valid(hash->page_hashes)) {
+    de100_memory_free(&hash->page_hashes);
+  }
+  hash->is_cached = false;
+  hash->interval_frames = 0;
+}
+
+bool replay_state_hash_should_hash(const ReplayStateHash *hash,
+                                   u64 frame_index) {
+  return hash->interval_frames > 0 &&
+         frame_index % hash->interval_frames == 0;
+}
+
+u64 replay_state_hash_compute(ReplayStateHash *hash,
+                              const ReplaySnapshotTracker *tracker) {
+  if (!tracker_is_usable(hash, tracker)) {
+    hash->is_cached = false;
+    return finish(hash_all_pages(hash, NULL), hash->size);
+  }
+
+  if (hash->is_cached && hash->cached_generation == tracker->sync_generation) {
+    rehash_dirty_pages(hash, tracker);
+    return finish(hash->combined, hash->size);
+  }
+
+  // Dirty marks were cleared since the cache was built (or there is no
+  // cache yet): start over from a full pass
+  if (!de100_memory_is_valid(hash->page_hashes)) {
+    hash->page_hashes =
+        de100_memory_alloc(NULL, (size_t)(hash->page_count * sizeof(u64)),
+                           De100_MEMORY_FLAG_RW);
+  }
+  u64 *cache = de100_memory_is_valid(hash->page_hashes)
+                   ? (u64 *)hash->page_hashes.base
+                   : NULL;
+
+  hash->combined = hash_all_pages(hash, cache);
+  hash->is_cached = cache != NULL;
+  hash->cached_generation = tracker->sync_generation;
+  return finish(hash->combined, hash->size);
+}
+
+u64 replay_state_hash_memory(const void *memory, u64 size) {
+  ReplayStateHash hash;
+  replay_state_hash_init(&hash, memory, size, 0);
+  return finish(hash_all_pages(&hash, NULL), size);
+}
+
+bool replay_state_hash_check(ReplayStateHash *hash, u64 frame_index,
+                             u64 recorded, u64 actual) {
+  ++hash->checked_count;
+  if (recorded == actual || hash->has_diverged) {
+    return false;
+  }
+  hash->has_diverged = true;
+  hash->diverged_frame = frame_index;
+  return true;
+}
+
+void replay_state_hash_reset_check(ReplayStateHash *hash) {
+  hash->checked_count = 0;
+  hash->has_diverged = false;
+  hash->diverged_frame = 0;
+}
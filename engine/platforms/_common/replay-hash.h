@@ -0,0 +1,112 @@
+#ifndef DE100_REPLAY_HASH_H
+#define DE100_REPLAY_HASH_H
+
+#include "../../_common/base.h"
+#include "../../_common/memory.h"
+#include "./replay-buffer.h"
+#include <stdbool.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// REPLAY STATE HASH (desync / determinism checks)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// While recording, permanent storage is hashed every `interval_frames`
+// and the hash goes into the input stream next to that frame's input.
+// Playback hashes the same frame again and reports the first frame whose
+// state differs: the point where the replay stopped being deterministic.
+//
+// The hash is per 4KB page (de100_hash64 seeded with the page index),
+// XORed together and mixed with the size:
+//
+//   hash = mix(size ^ H(page 0, 0) ^ H(page 1, 1) ^ ...)
+//
+// so one page can be swapped out of the total without touching the rest.
+// With incremental snapshots armed, only pages the tracker marked dirty
+// are rehashed; the others reuse the hash cached the last time around.
+// Dirty marks accumulate until the next save/restore, so the cost is the
+// memory written since then, not the whole range. Any other case (FULL
+// snapshots, tracker disarmed, dirty marks cleared since the cache was
+// built) rehashes everything. Both paths give the same value.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define REPLAY_STATE_HASH_PAGE_SIZE KILOBYTES(4)
+
+// ═══════════════════════════════════════════════════════════════════════════
+// STRUCTURES
+// ═══════════════════════════════════════════════════════════════════════════
+
+typedef struct {
+  const u8 *memory; // Permanent storage
+  u64 size;
+  u64 page_count;
+  u32 interval_frames; // 0 = hashing disabled
+
+  // Incremental cache: one u64 per page, valid for one tracker generation
+  De100MemoryBlock page_hashes;
+  u64 combined; // XOR of every entry in page_hashes
+  u64 cached_generation;
+  bool is_cached;
+
+  // Playback verification
+  u64 checked_count;
+  bool has_diverged;
+  u64 diverged_frame;
+
+#if DE100_INTERNAL
+  u64 last_pages_hashed;
+#endif
+} ReplayStateHash;
+
+// ═══════════════════════════════════════════════════════════════════════════
+// API FUNCTIONS
+// ═══════════════════════════════════════════════════════════════════════════
+
+/**
+ * Configure hashing. The page cache is allocated on first incremental use.
+ *
+ * @param interval_frames  Frames between hashes (1 = every frame,
+ *                         0 disables hashing)
+ */
+void replay_state_hash_init(ReplayStateHash *hash, const void *memory,
+                            u64 size, u32 interval_frames);
+
+/**
+ * Free the page cache. Safe to call multiple times.
+ */
+void replay_state_hash_shutdown(ReplayStateHash *hash);
+
+/**
+ * True when `frame_index` is due for a hash.
+ */
+bool replay_state_hash_should_hash(const ReplayStateHash *hash,
+                                   u64 frame_index);
+
+/**
+ * Hash the memory range now.
+ *
+ * @param tracker  Snapshot tracker over the same memory, or NULL. When its
+ *                 dirty pages are usable only those pages are rehashed.
+ */
+u64 replay_state_hash_compute(ReplayStateHash *hash,
+                              const ReplaySnapshotTracker *tracker);
+
+/**
+ * One-off hash of a memory range, same value as replay_state_hash_compute
+ * over it (e.g. end-of-run hashes for headless determinism checks).
+ */
+u64 replay_state_hash_memory(const void *memory, u64 size);
+
+/**
+ * Compare against a recorded hash. Remembers (and returns true for) only
+ * the first mismatch until replay_state_hash_reset_check().
+ */
+bool replay_state_hash_check(ReplayStateHash *hash, u64 frame_index,
+                             u64 recorded, u64 actual);
+
+/**
+ * Forget any divergence (new playback pass).
+ */
+void replay_state_hash_reset_check(ReplayStateHash *hash);
+
+#endif // DE100_REPLAY_HASH_H
@@ -0,0 +1,315 @@
+#include "./replay-timeline.h"
+#include "../../_common/compression.h"
+
+#include <stdio.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ERROR MESSAGES
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_global_var const char *g_replay_timeline_error_messages[] = {
+    [REPLAY_TIMELINE_SUCCESS] = "Success",
+    [REPLAY_TIMELINE_ERROR_NULL_POINTER] = "NULL timeline or keyframe",
+    [REPLAY_TIMELINE_ERROR_NOT_INITIALIZED] =
+        "Timeline has no memory range (keyframes disabled?)",
+    [REPLAY_TIMELINE_ERROR_OUT_OF_MEMORY] = "Failed to grow keyframe storage",
+    [REPLAY_TIMELINE_ERROR_COMPRESSION_FAILED] =
+        "Failed to compress or decompress a keyframe block",
+};
+
+const char *replay_timeline_strerror(ReplayTimelineErrorCode code) {
+  if (code >= 0 && code < REPLAY_TIMELINE_ERROR_COUNT) {
+    return g_replay_timeline_error_messages[code];
+  }
+  return "Unknown replay timeline error";
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// INTERNAL HELPERS
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn inline ReplayTimelineResult
+make_result(bool success, ReplayTimelineErrorCode code) {
+  return (ReplayTimelineResult){.success = success, .error_code = code};
+}
+
+de100_file_scoped_fn inline u32 block_count(u64 size) {
+  return (u32)((size + REPLAY_TIMELINE_BLOCK_SIZE - 1) /
+               REPLAY_TIMELINE_BLOCK_SIZE);
+}
+
+de100_file_scoped_fn inline u64 block_raw_size(u64 size, u32 block) {
+  u64 offset = (u64)block * REPLAY_TIMELINE_BLOCK_SIZE;
+  u64 remaining = size - offset;
+  return remaining < REPLAY_TIMELINE_BLOCK_SIZE ? remaining
+                                                : REPLAY_TIMELINE_BLOCK_SIZE;
+}
+
+/** Bytes a capture covers now: all of it, or up to the frontier. */
+de100_file_scoped_fn inline u64 capture_size(const ReplayTimeline *timeline) {
+  if (!timeline->frontier) {
+    return timeline->size;
+  }
+  u64 size = (u64)(timeline->frontier->base - timeline->memory) +
+             de100_commit_frontier_committed(timeline->frontier);
+  return size < timeline->size ? size : timeline->size;
+}
+
+de100_file_scoped_fn inline bool is_zero_block(const u8 *data, u64 size) {
+  const u64 *words = (const u64 *)data;
+  for (u64 i = 0; i < size / sizeof(u64); ++i) {
+    if (words[i]) {
+      return false;
+    }
+  }
+  for (u64 i = size & ~(u64)(sizeof(u64) - 1); i < size; ++i) {
+    if (data[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Grow a keyframe's storage (doubling) so `needed` more bytes fit.
+ */
+de100_file_scoped_fn bool reserve(ReplayKeyframe *keyframe, u64 needed) {
+  u64 required = keyframe->data_size + needed;
+  if (de100_memory_is_valid(keyframe->data) &&
+      keyframe->data.size >= required) {
+    return true;
+  }
+
+  u64 capacity = de100_memory_is_valid(keyframe->data)
+                     ? (u64)keyframe->data.size * 2
+                     : REPLAY_TIMELINE_BLOCK_SIZE;
+  while (capacity < required) {
+    capacity *= 2;
+  }
+
+  if (!de100_memory_is_valid(keyframe->data)) {
+    keyframe->data =
+        de100_memory_alloc(NULL, (size_t)capacity, De100_MEMORY_FLAG_RW);
+    return de100_memory_is_valid(keyframe->data);
+  }
+
+  return de100_memory_realloc(&keyframe->data, (size_t)capacity, true) ==
+         De100_MEMORY_OK;
+}
+
+de100_file_scoped_fn inline void free_keyframe(ReplayKeyframe *keyframe) {
+  if (de100_memory_is_valid(keyframe->data)) {
+    de100_memory_free(&keyframe->data);
+  }
+  *keyframe = (ReplayKeyframe){0};
+}
+
+/**
+ * Table full: keep keyframes 1, 3, 5... (multiples of the doubled
+ * interval) and free the rest.
+ */
+de100_file_scoped_fn void thin_keyframes(ReplayTimeline *timeline) {
+  u32 kept = 0;
+  for (u32 i = 0; i < timeline->keyframe_count; ++i) {
+    if (i % 2 == 1) {
+      timeline->keyframes[kept++] = timeline->keyframes[i];
+    } else {
+      free_keyframe(&timeline->keyframes[i]);
+    }
+  }
+  for (u32 i = kept; i < timeline->keyframe_count; ++i) {
+    timeline->keyframes[i] = (ReplayKeyframe){0};
+  }
+  timeline->keyframe_count = kept;
+  timeline->interval_frames *= 2;
+
+#if DE100_INTERNAL
+  printf("[REPLAY TIMELINE] Keyframe table full, interval now %u frames\n",
+         timeline->interval_frames);
+#endif
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// LIFECYCLE
+// ═══════════════════════════════════════════════════════════════════════════
+
+void replay_timeline_init(ReplayTimeline *timeline, void *memory, u64 size,
+                          u32 interval_frames) {
+  if (!timeline) {
+    return;
+  }
+
+  *timeline = (ReplayTimeline){0};
+  timeline->memory = (u8 *)memory;
+  timeline->size = size;
+  timeline->interval_frames = interval_frames;
+  timeline->base_interval_frames = interval_frames;
+}
+
+void replay_timeline_set_frontier(ReplayTimeline *timeline,
+                                  De100CommitFrontier *frontier) {
+  if (timeline) {
+    timeline->frontier = frontier;
+  }
+}
+
+void replay_timeline_clear(ReplayTimeline *timeline) {
+  if (!timeline) {
+    return;
+  }
+
+  for (u32 i = 0; i < timeline->keyframe_count; ++i) {
+    free_keyframe(&timeline->keyframes[i]);
+  }
+  timeline->keyframe_count = 0;
+  timeline->interval_frames = timeline->base_interval_frames;
+}
+
+void replay_timeline_shutdown(ReplayTimeline *timeline) {
+  replay_timeline_clear(timeline);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// CAPTURE
+// ═══════════════════════════════════════════════════════════════════════════
+
+bool replay_timeline_should_capture(const ReplayTimeline *timeline,
+                                    u64 frame_index) {
+  return timeline && timeline->memory && timeline->interval_frames > 0 &&
+         frame_index > 0 && frame_index % timeline->interval_frames == 0;
+}
+
+ReplayTimelineResult replay_timeline_capture(ReplayTimeline *timeline,
+                                             u64 frame_index) {
+  if (!timeline) {
+    return make_result(false, REPLAY_TIMELINE_ERROR_NULL_POINTER);
+  }
+
+  if (!timeline->memory || timeline->size == 0) {
+    return make_result(false, REPLAY_TIMELINE_ERROR_NOT_INITIALIZED);
+  }
+
+  if (timeline->keyframe_count == REPLAY_TIMELINE_MAX_KEYFRAMES) {
+    thin_keyframes(timeline);
+    if (frame_index % timeline->interval_frames != 0) {
+      return make_result(true, REPLAY_TIMELINE_SUCCESS); // Not due anymore
+    }
+  }
+
+  ReplayKeyframe *keyframe = &timeline->keyframes[timeline->keyframe_count];
+  *keyframe = (ReplayKeyframe){0};
+  keyframe->frame_index = frame_index;
+  keyframe->size = capture_size(timeline);
+  u32 blocks = block_count(keyframe->size);
+
+  u64 table_size = (u64)blocks * sizeof(u32);
+  if (!reserve(keyframe, table_size)) {
+    free_keyframe(keyframe);
+    return make_result(false, REPLAY_TIMELINE_ERROR_OUT_OF_MEMORY);
+  }
+  keyframe->data_size = table_size;
+
+  for (u32 block = 0; block < blocks; ++block) {
+    const u8 *raw =
+        timeline->memory + (u64)block * REPLAY_TIMELINE_BLOCK_SIZE;
+    u64 raw_size = block_raw_size(keyframe->size, block);
+    u32 *sizes = (u32 *)keyframe->data.base; // May move on reserve()
+
+    if (is_zero_block(raw, raw_size)) {
+      sizes[block] = 0;
+      continue;
+    }
+
+    u64 bound = de100_lz_compress_bound((size_t)raw_size);
+    if (!reserve(keyframe, bound)) {
+      free_keyframe(keyframe);
+      return make_result(false, REPLAY_TIMELINE_ERROR_OUT_OF_MEMORY);
+    }
+    sizes = (u32 *)keyframe->data.base;
+
+    De100CompressResult packed = de100_lz_compress(
+        raw, (size_t)raw_size, (u8 *)keyframe->data.base + keyframe->data_size,
+        (size_t)bound);
+    if (!packed.success) {
+      free_keyframe(keyframe);
+      return make_result(false, REPLAY_TIMELINE_ERROR_COMPRESSION_FAILED);
+    }
+
+    sizes[block] = (u32)packed.size;
+    keyframe->data_size += packed.size;
+  }
+
+  timeline->keyframe_count++;
+
+#if DE100_INTERNAL
+  printf("[REPLAY TIMELINE] 🔑 Keyframe @ frame %lu (%.2f MB)\n",
+         (unsigned long)frame_index,
+         (double)keyframe->data_size / (1024.0 * 1024.0));
+#endif
+
+  return make_result(true, REPLAY_TIMELINE_SUCCESS);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// SEEK
+// ═══════════════════════════════════════════════════════════════════════════
+
+const ReplayKeyframe *replay_timeline_find(const ReplayTimeline *timeline,
+                                           u64 frame_index) {
+  if (!timeline) {
+    return NULL;
+  }
+
+  // Keyframes are sorted by frame; the table is small, scan from the end
+  for (u32 i = timeline->keyframe_count; i-- > 0;) {
+    if (timeline->keyframes[i].frame_index <= frame_index) {
+      return &timeline->keyframes[i];
+    }
+  }
+  return NULL;
+}
+
+ReplayTimelineResult replay_timeline_restore(const ReplayTimeline *timeline,
+                                             const ReplayKeyframe *keyframe) {
+  if (!timeline || !keyframe) {
+    return make_result(false, REPLAY_TIMELINE_ERROR_NULL_POINTER);
+  }
+
+  if (!timeline->memory || !de100_memory_is_valid(keyframe->data)) {
+    return make_result(false, REPLAY_TIMELINE_ERROR_NOT_INITIALIZED);
+  }
+
+  // Pages committed when the keyframe was taken must be writable again
+  if (timeline->frontier) {
+    u64 offset = (u64)(timeline->frontier->base - timeline->memory);
+    if (keyframe->size > offset &&
+        !de100_commit_frontier_grow(timeline->frontier,
+                                    keyframe->size - offset)) {
+      return make_result(false, REPLAY_TIMELINE_ERROR_OUT_OF_MEMORY);
+    }
+  }
+
+  u32 blocks = block_count(keyframe->size);
+  const u32 *sizes = (const u32 *)keyframe->data.base;
+  const u8 *packed =
+      (const u8 *)keyframe->data.base + (u64)blocks * sizeof(u32);
+
+  for (u32 block = 0; block < blocks; ++block) {
+    u8 *raw = timeline->memory + (u64)block * REPLAY_TIMELINE_BLOCK_SIZE;
+    u64 raw_size = block_raw_size(keyframe->size, block);
+
+    if (sizes[block] == 0) {
+      de100_mem_set(raw, 0, (size_t)raw_size);
+      continue;
+    }
+
+    De100CompressResult unpacked =
+        de100_lz_decompress(packed, sizes[block], raw, (size_t)raw_size);
+    if (!unpacked.success || unpacked.size != raw_size) {
+      return make_result(false, REPLAY_TIMELINE_ERROR_COMPRESSION_FAILED);
+    }
+    packed += sizes[block];
+  }
+
+  return make_result(true, REPLAY_TIMELINE_SUCCESS);
+}
@@ -0,0 +1,127 @@
+#ifndef DE100_REPLAY_TIMELINE_H
+#define DE100_REPLAY_TIMELINE_H
+
+#include "../../_common/base.h"
+#include "../../_common/memory.h"
+#include <stdbool.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// REPLAY TIMELINE (periodic keyframes for seeking)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// While recording, a compressed keyframe of game memory is captured every
+// `interval_frames`. Seeking to frame X then costs:
+//
+//   restore nearest keyframe ≤ X  +  re-simulate (X - keyframe) frames
+//
+// instead of re-simulating from the start of the recording. Frame 0 is the
+// replay buffer itself, so the first keyframe is at `interval_frames`.
+//
+// Keyframes are in-memory only (LZ-compressed 1MB blocks, all-zero blocks
+// not stored). When the table fills up, every other keyframe is dropped
+// and the interval doubles, so long recordings stay seekable with bounded
+// memory.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define REPLAY_TIMELINE_MAX_KEYFRAMES 64
+#define REPLAY_TIMELINE_BLOCK_SIZE MEGABYTES(1)
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ERROR CODES
+// ═══════════════════════════════════════════════════════════════════════════
+
+typedef enum {
+  REPLAY_TIMELINE_SUCCESS = 0,
+  REPLAY_TIMELINE_ERROR_NULL_POINTER,
+  REPLAY_TIMELINE_ERROR_NOT_INITIALIZED,
+  REPLAY_TIMELINE_ERROR_OUT_OF_MEMORY,
+  REPLAY_TIMELINE_ERROR_COMPRESSION_FAILED,
+
+  REPLAY_TIMELINE_ERROR_COUNT
+} ReplayTimelineErrorCode;
+
+// ═══════════════════════════════════════════════════════════════════════════
+// STRUCTURES
+// ═══════════════════════════════════════════════════════════════════════════
+
+typedef struct {
+  u64 frame_index;       // State BEFORE this frame's update ran
+  De100MemoryBlock data; // [u32 size per block][compressed blocks...]
+  u64 data_size;         // Bytes of `data` in use
+  u64 size;              // Bytes of game memory captured
+} ReplayKeyframe;
+
+typedef struct {
+  u8 *memory; // Range to capture (the snapshot tracker's range)
+  u64 size;
+  De100CommitFrontier *frontier; // Capture only up to it (NULL = all)
+  u32 interval_frames; // 0 = keyframes disabled
+  u32 base_interval_frames;
+
+  ReplayKeyframe keyframes[REPLAY_TIMELINE_MAX_KEYFRAMES];
+  u32 keyframe_count;
+} ReplayTimeline;
+
+typedef struct {
+  bool success;
+  ReplayTimelineErrorCode error_code;
+} ReplayTimelineResult;
+
+// ═══════════════════════════════════════════════════════════════════════════
+// API FUNCTIONS
+// ═══════════════════════════════════════════════════════════════════════════
+
+/**
+ * Configure the timeline. No memory is allocated until the first capture.
+ *
+ * @param interval_frames  Frames between keyframes (0 disables them)
+ */
+void replay_timeline_init(ReplayTimeline *timeline, void *memory, u64 size,
+                          u32 interval_frames);
+
+/**
+ * Capture only what `frontier` (the tail of the range) has committed,
+ * like the snapshot tracker.
+ */
+void replay_timeline_set_frontier(ReplayTimeline *timeline,
+                                  De100CommitFrontier *frontier);
+
+/**
+ * Drop all keyframes (new recording). Keeps the configuration.
+ */
+void replay_timeline_clear(ReplayTimeline *timeline);
+
+/**
+ * Free everything. Safe to call multiple times.
+ */
+void replay_timeline_shutdown(ReplayTimeline *timeline);
+
+/**
+ * True when `frame_index` is due for a keyframe.
+ */
+bool replay_timeline_should_capture(const ReplayTimeline *timeline,
+                                    u64 frame_index);
+
+/**
+ * Capture game memory as the keyframe for `frame_index`.
+ */
+ReplayTimelineResult replay_timeline_capture(ReplayTimeline *timeline,
+                                             u64 frame_index);
+
+/**
+ * Latest keyframe at or before `frame_index`, or NULL (use frame 0).
+ */
+const ReplayKeyframe *replay_timeline_find(const ReplayTimeline *timeline,
+                                           u64 frame_index);
+
+/**
+ * Decompress a keyframe back into game memory. Memory must be writable
+ * (invalidate the snapshot tracker first).
+ */
+ReplayTimelineResult replay_timeline_restore(const ReplayTimeline *timeline,
+                                             const ReplayKeyframe *keyframe);
+
+const char *replay_timeline_strerror(ReplayTimelineErrorCode code);
+
+#endif // DE100_REPLAY_TIMELINE_H
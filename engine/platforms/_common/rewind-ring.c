@@ -0,0 +1,172 @@
+#include "./rewind-ring.h"
+#include "../../_common/log.h"
+
+#include <string.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ERROR MESSAGES
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_global_var const char *g_rewind_ring_error_messages[] = {
+    [REWIND_RING_SUCCESS] = "Success",
+    [REWIND_RING_ERROR_NULL_POINTER] = "NULL ring or tracker",
+    [REWIND_RING_ERROR_DISABLED] = "rewind_seconds is 0",
+    [REWIND_RING_ERROR_TRACKING_UNSUPPORTED] =
+        "Needs incremental replay snapshots (page tracking)",
+    [REWIND_RING_ERROR_LOG_TOO_SMALL] =
+        "rewind_log_megabytes can't hold a single frame",
+    [REWIND_RING_ERROR_OUT_OF_MEMORY] = "Failed to allocate the rewind ring",
+    [REWIND_RING_ERROR_SNAPSHOT_FAILED] = "Failed to sync the rewind snapshot",
+    [REWIND_RING_ERROR_TOO_FAR] = "Frame no longer in the rewind ring",
+};
+
+const char *rewind_ring_strerror(RewindRingErrorCode code) {
+  if (code >= 0 && code < REWIND_RING_ERROR_COUNT) {
+    return g_rewind_ring_error_messages[code];
+  }
+  return "Unknown rewind error";
+}
+
+de100_file_scoped_fn inline RewindRingResult
+make_result(bool success, RewindRingErrorCode code) {
+  return (RewindRingResult){.success = success, .error_code = code};
+}
+
+de100_file_scoped_fn inline GameInput *ring_input(const RewindRing *ring,
+                                                  u32 frame) {
+  return &ring->inputs[frame & (ring->log.record_count - 1)];
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// PUBLIC API
+// ═══════════════════════════════════════════════════════════════════════════
+
+RewindRingResult rewind_ring_init(RewindRing *ring,
+                                  ReplaySnapshotTracker *tracker,
+                                  f32 seconds, f32 seconds_per_frame,
+                                  u64 log_size) {
+  if (!ring || !tracker) {
+    return make_result(false, REWIND_RING_ERROR_NULL_POINTER);
+  }
+  *ring = (RewindRing){0};
+  if (seconds <= 0.0f || seconds_per_frame <= 0.0f) {
+    return make_result(false, REWIND_RING_ERROR_DISABLED);
+  }
+  if (tracker->mode == REPLAY_SNAPSHOT_MODE_FULL) {
+    return make_result(false, REWIND_RING_ERROR_TRACKING_UNSUPPORTED);
+  }
+  if (log_size < undo_log_min_size(tracker)) {
+    return make_result(false, REWIND_RING_ERROR_LOG_TOO_SMALL);
+  }
+
+  // One record per frame, plus the one being built
+  ring->max_frames = (u32)(seconds / seconds_per_frame + 0.5f);
+  if (ring->max_frames < 1) {
+    ring->max_frames = 1;
+  }
+  u32 record_count = 2;
+  while (record_count < ring->max_frames + 1) {
+    record_count <<= 1;
+  }
+
+  if (undo_log_init(&ring->log, tracker, log_size, record_count) !=
+      UNDO_LOG_SUCCESS) {
+    return make_result(false, REWIND_RING_ERROR_OUT_OF_MEMORY);
+  }
+  ring->input_memory =
+      de100_memory_alloc(NULL, (size_t)record_count * sizeof(GameInput),
+                         De100_MEMORY_FLAG_RW_ZEROED);
+  if (!de100_memory_is_valid(ring->input_memory)) {
+    undo_log_free(&ring->log);
+    return make_result(false, REWIND_RING_ERROR_OUT_OF_MEMORY);
+  }
+  ring->inputs = (GameInput *)ring->input_memory.base;
+  ring->is_enabled = true;
+  ring->needs_begin = true;
+
+  DE100_LOG_INFO(DE100_LOG_REPLAY,
+                 "Rewind: %u frames, %.1f MB of page history (%s)",
+                 ring->max_frames, (double)log_size / (1024.0 * 1024.0),
+                 REWIND_KEY_NAME);
+  return make_result(true, REWIND_RING_SUCCESS);
+}
+
+void rewind_ring_shutdown(RewindRing *ring) {
+  if (!ring || !ring->is_enabled) {
+    return;
+  }
+  undo_log_free(&ring->log);
+  de100_memory_free(&ring->input_memory);
+  ring->inputs = NULL;
+  ring->is_enabled = false;
+}
+
+void rewind_ring_reset(RewindRing *ring) {
+  if (ring && ring->is_enabled) {
+    ring->needs_begin = true;
+  }
+}
+
+RewindRingResult rewind_ring_capture(RewindRing *ring,
+                                     const GameInput *input) {
+  UndoLogErrorCode error;
+  if (ring->needs_begin) {
+    error = undo_log_begin(&ring->log, ring->frame);
+    ring->oldest_frame = ring->frame;
+    ring->needs_begin = false;
+  } else {
+    error = undo_log_save(&ring->log, ring->frame);
+  }
+  if (error != UNDO_LOG_SUCCESS) {
+    ring->needs_begin = true;
+    return make_result(false, REWIND_RING_ERROR_SNAPSHOT_FAILED);
+  }
+
+  GameInput *slot = ring_input(ring, ring->frame);
+  if (slot != input) {
+    memcpy(slot, input, sizeof(*slot));
+  }
+  ++ring->frame;
+  if (ring->frame - ring->oldest_frame > ring->max_frames) {
+    ring->oldest_frame = ring->frame - ring->max_frames;
+  }
+  return make_result(true, REWIND_RING_SUCCESS);
+}
+
+bool rewind_ring_can_step_back(const RewindRing *ring, u32 frames) {
+  if (!ring->is_enabled || ring->needs_begin ||
+      ring->frame - ring->oldest_frame < frames) {
+    return false;
+  }
+  // Also false once the frame's pages were overwritten in the log
+  return undo_log_can_rollback(&ring->log, ring->frame - frames);
+}
+
+RewindRingResult rewind_ring_step_back(RewindRing *ring, u32 frames) {
+  if (!rewind_ring_can_step_back(ring, frames)) {
+    return make_result(false, REWIND_RING_ERROR_TOO_FAR);
+  }
+
+  // The pages the last frame wrote go in the log first; they may push the
+  // target out of it, which leaves the history usable up to here
+  u32 target = ring->frame - frames;
+  if (undo_log_save(&ring->log, ring->frame) != UNDO_LOG_SUCCESS) {
+    ring->needs_begin = true;
+    return make_result(false, REWIND_RING_ERROR_SNAPSHOT_FAILED);
+  }
+  if (!undo_log_can_rollback(&ring->log, target)) {
+    ring->oldest_frame = ring->frame;
+    return make_result(false, REWIND_RING_ERROR_TOO_FAR);
+  }
+  if (undo_log_rollback(&ring->log, target) != UNDO_LOG_SUCCESS) {
+    ring->needs_begin = true;
+    return make_result(false, REWIND_RING_ERROR_SNAPSHOT_FAILED);
+  }
+  ring->frame = target;
+  ring->frames_rewound += frames;
+  return make_result(true, REWIND_RING_SUCCESS);
+}
+
+const GameInput *rewind_ring_input(const RewindRing *ring, u32 frame) {
+  return ring_input(ring, frame);
+}
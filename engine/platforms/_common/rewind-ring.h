@@ -0,0 +1,105 @@
+#ifndef DE100_PLATFORMS__COMMON_REWIND_RING_H
+#define DE100_PLATFORMS__COMMON_REWIND_RING_H
+
+#include "../../_common/base.h"
+#include "../../_common/memory.h"
+#include "../../game/inputs.h"
+#include "./undo-log.h"
+#include <stdbool.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// REWIND RING (GameConfig.rewind_seconds)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// The last rewind_seconds of gameplay, frame by frame, in a bounded ring
+// of per-frame page deltas (undo-log.h). Every rendered frame logs only
+// the pages its update wrote, so history costs O(touched memory) per
+// frame instead of a full copy:
+//
+//   frame boundary:  undo log += old contents of last frame's dirty pages
+//                    inputs[frame] = the input this frame runs with
+//   REWIND_KEY held: roll back one frame instead of updating
+//
+// Reach is whichever runs out first: rewind_seconds of frames, or
+// GameConfig.rewind_log_megabytes of logged pages. Holding the key past
+// it freezes on the oldest frame; releasing it resumes from the frame on
+// screen and drops the frames after it.
+//
+// Needs incremental replay snapshots (page write-protection): without
+// them every frame would compare all of game memory. Recording, playback
+// and netplay own game memory's history, so the ring pauses while they
+// run and restarts afterwards (as it does after a hot reload).
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define REWIND_KEY_NAME "F6"
+
+typedef enum {
+  REWIND_RING_SUCCESS = 0,
+  REWIND_RING_ERROR_NULL_POINTER,
+  REWIND_RING_ERROR_DISABLED,             // rewind_seconds is 0
+  REWIND_RING_ERROR_TRACKING_UNSUPPORTED, // FULL snapshot mode
+  REWIND_RING_ERROR_LOG_TOO_SMALL,
+  REWIND_RING_ERROR_OUT_OF_MEMORY,
+  REWIND_RING_ERROR_SNAPSHOT_FAILED,
+  REWIND_RING_ERROR_TOO_FAR, // Nothing that old left in the ring
+
+  REWIND_RING_ERROR_COUNT
+} RewindRingErrorCode;
+
+typedef struct {
+  bool success;
+  RewindRingErrorCode error_code;
+} RewindRingResult;
+
+typedef struct {
+  UndoLog log;
+  De100MemoryBlock input_memory;
+  GameInput *inputs; // Input frame f ran with, at f & (record_count - 1)
+  u32 max_frames;    // rewind_seconds worth of frames
+
+  u32 frame; // Next frame to simulate
+  u32 oldest_frame;
+  bool is_enabled;
+  bool needs_begin; // History dropped: restart at the next boundary
+  bool is_held;     // REWIND_KEY is down (set by the backend)
+
+  u64 frames_rewound; // Stats
+} RewindRing;
+
+/**
+ * Allocate the ring: `log_size` bytes of page history over `tracker`'s
+ * range, and `seconds` / `seconds_per_frame` frames of inputs.
+ */
+RewindRingResult rewind_ring_init(RewindRing *ring,
+                                  ReplaySnapshotTracker *tracker,
+                                  f32 seconds, f32 seconds_per_frame,
+                                  u64 log_size);
+
+/** Free the ring. Safe to call twice. */
+void rewind_ring_shutdown(RewindRing *ring);
+
+/** Game memory changed under the ring: drop the history. */
+void rewind_ring_reset(RewindRing *ring);
+
+/**
+ * Frame boundary before an update that runs with `input`: log the last
+ * frame's pages and remember the input.
+ */
+RewindRingResult rewind_ring_capture(RewindRing *ring, const GameInput *input);
+
+/** True if `frames` frames back are still in the ring. */
+bool rewind_ring_can_step_back(const RewindRing *ring, u32 frames);
+
+/**
+ * Game memory back to the state before frame - `frames` (the frame then
+ * becomes the next one to simulate).
+ */
+RewindRingResult rewind_ring_step_back(RewindRing *ring, u32 frames);
+
+/** The input `frame` ran with (valid while it's in the ring). */
+const GameInput *rewind_ring_input(const RewindRing *ring, u32 frame);
+
+const char *rewind_ring_strerror(RewindRingErrorCode code);
+
+#endif // DE100_PLATFORMS__COMMON_REWIND_RING_H
@@ -0,0 +1,715 @@
+#include "./spectate.h"
+#include "../../_common/compression.h"
+#include "../../_common/memory.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if !defined(_WIN32)
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#endif
+
+#if !defined(_WIN32) && !defined(MSG_NOSIGNAL)
+#define MSG_NOSIGNAL 0 // No SIGPIPE flag here; the peer just reads EPIPE
+#endif
+
+_Static_assert(sizeof(SpectateFrameHeader) == 28,
+               "SpectateFrameHeader is a wire format: no padding");
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ERROR MESSAGES
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_global_var const char *g_spectate_error_messages[] = {
+    [SPECTATE_SUCCESS] = "Success",
+    [SPECTATE_ERROR_BAD_SPEC] = "Bad spectate spec (expected PORT[,EVERY])",
+    [SPECTATE_ERROR_ALREADY_ACTIVE] = "Spectating is already running",
+    [SPECTATE_ERROR_SOCKET_FAILED] = "Failed to open the TCP socket",
+    [SPECTATE_ERROR_LISTEN_FAILED] = "Failed to listen on the port",
+    [SPECTATE_ERROR_THREAD_CREATE_FAILED] =
+        "Failed to create the spectate sender thread",
+    [SPECTATE_ERROR_CORRUPT_FRAME] = "Corrupt or mismatched spectate frame",
+};
+
+const char *spectate_strerror(SpectateErrorCode code) {
+  if (code >= 0 && code < SPECTATE_ERROR_COUNT) {
+    return g_spectate_error_messages[code];
+  }
+  return "Unknown spectate error";
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// STATE
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define SPECTATE_SENDER_IDLE_NS (2 * 1000 * 1000)
+#define SPECTATE_BYTES_PER_PIXEL 4
+#define SPECTATE_MAX_DIMENSION 0xFFFF // Header fields are u16
+
+typedef struct {
+  De100MemoryBlock block; // Tile pixels, then the tile indexes
+  u32 *tile_indexes;
+  u32 tile_count;
+  u32 pixel_bytes; // Of the packed tiles
+  u32 frame;
+  u16 width;
+  u16 height;
+  u16 pixel_format;
+  u16 flags; // SpectateFrameFlags
+} SpectateSlot;
+
+typedef struct {
+  i32 fd; // -1 = free
+  bool is_synced; // Has had a keyframe
+} Spectator;
+
+typedef struct {
+  i32 listen_fd;
+  u16 port;
+  u32 every;
+
+  // main thread → sender
+  SpectateSlot slots[SPECTATE_RING_SIZE];
+  u64 slot_bytes; // Capacity of each; changed by main with the ring empty
+  u64 write_index;
+  u64 read_index;
+  u32 spectator_count;     // __atomic (written by sender)
+  bool keyframe_requested; // __atomic (set by sender, taken by main)
+
+  pthread_t sender;
+  bool sender_started;
+  bool is_running; // __atomic
+  bool is_disabled; // Allocation failed
+
+  // Main-only: the frame as last queued, and tiles to compare next
+  De100MemoryBlock previous; // width * height * 4, rows packed
+  De100MemoryBlock tile_marks; // u8 per tile
+  u32 width;
+  u32 height;
+  u32 tiles_x;
+  u32 tiles_y;
+  bool needs_keyframe;
+  u64 frames_offered;
+  u64 frames_dropped; // Ring full
+  u64 frames_queued;
+  u64 tiles_queued;
+
+  // Sender-only
+  Spectator spectators[SPECTATE_MAX_SPECTATORS];
+  De100MemoryBlock compressed;
+  u64 bytes_sent;
+  u32 spectators_served;
+  u32 spectators_dropped;
+} Spectate;
+
+de100_file_scoped_global_var Spectate g_spectate = {.listen_fd = -1};
+
+/** Grow `block` to hold `size` bytes; contents are not kept. */
+de100_file_scoped_fn bool spectate_reserve(De100MemoryBlock *block,
+                                           u64 size) {
+  if (de100_memory_is_valid(*block) && block->size >= size) {
+    return true;
+  }
+  if (de100_memory_is_valid(*block)) {
+    de100_memory_free(block);
+  }
+  *block = de100_memory_alloc(NULL, size, De100_MEMORY_FLAG_RW);
+  return de100_memory_is_valid(*block);
+}
+
+de100_file_scoped_fn void spectate_release(De100MemoryBlock *block) {
+  if (de100_memory_is_valid(*block)) {
+    de100_memory_free(block);
+  }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// TILES
+// ═══════════════════════════════════════════════════════════════════════════
+
+typedef struct {
+  u32 x, y;
+  u32 width, height; // Clipped to the frame
+} SpectateTileRect;
+
+de100_file_scoped_fn inline SpectateTileRect
+spectate_tile_rect(u32 index, u32 tiles_x, u32 frame_width,
+                   u32 frame_height) {
+  SpectateTileRect rect;
+  rect.x = (index % tiles_x) * SPECTATE_TILE_SIZE;
+  rect.y = (index / tiles_x) * SPECTATE_TILE_SIZE;
+  rect.width = frame_width - rect.x < SPECTATE_TILE_SIZE
+                   ? frame_width - rect.x
+                   : SPECTATE_TILE_SIZE;
+  rect.height = frame_height - rect.y < SPECTATE_TILE_SIZE
+                    ? frame_height - rect.y
+                    : SPECTATE_TILE_SIZE;
+  return rect;
+}
+
+/** Mark the tiles this frame may have changed. */
+de100_file_scoped_fn void spectate_mark_tiles(Spectate *spectate,
+                                              const GameBackBuffer *buffer) {
+  u8 *marks = (u8 *)spectate->tile_marks.base;
+  const GameDirtyRegion *dirty = &buffer->dirty;
+  if (!dirty->is_tracking || dirty->full_frame) {
+    memset(marks, 1, (size_t)spectate->tiles_x * spectate->tiles_y);
+    return;
+  }
+
+  for (int i = 0; i < dirty->count; ++i) {
+    const De100DirtyRect *rect = &dirty->rects[i];
+    i32 x0 = rect->x < 0 ? 0 : rect->x;
+    i32 y0 = rect->y < 0 ? 0 : rect->y;
+    i32 x1 = rect->x + rect->width;
+    i32 y1 = rect->y + rect->height;
+    x1 = x1 > (i32)spectate->width ? (i32)spectate->width : x1;
+    y1 = y1 > (i32)spectate->height ? (i32)spectate->height : y1;
+    if (x1 <= x0 || y1 <= y0) {
+      continue;
+    }
+    u32 first_x = (u32)x0 / SPECTATE_TILE_SIZE;
+    u32 last_x = (u32)(x1 - 1) / SPECTATE_TILE_SIZE;
+    u32 last_y = (u32)(y1 - 1) / SPECTATE_TILE_SIZE;
+    for (u32 ty = (u32)y0 / SPECTATE_TILE_SIZE; ty <= last_y; ++ty) {
+      memset(marks + ty * spectate->tiles_x + first_x, 1,
+             last_x - first_x + 1);
+    }
+  }
+}
+
+/**
+ * Copy tile `index` into the slot (and `previous`) if it differs from
+ * `previous`, or always when `force`. Returns the bytes added.
+ */
+de100_file_scoped_fn u32 spectate_take_tile(Spectate *spectate,
+                                            const GameBackBuffer *buffer,
+                                            u32 index, u8 *out, bool force) {
+  SpectateTileRect rect = spectate_tile_rect(index, spectate->tiles_x,
+                                             spectate->width,
+                                             spectate->height);
+  u64 row_bytes = (u64)rect.width * SPECTATE_BYTES_PER_PIXEL;
+  u64 previous_pitch = (u64)spectate->width * SPECTATE_BYTES_PER_PIXEL;
+  const u8 *src = (const u8 *)buffer->memory.base +
+                  (u64)rect.y * (u64)buffer->pitch +
+                  (u64)rect.x * SPECTATE_BYTES_PER_PIXEL;
+  u8 *previous = (u8 *)spectate->previous.base +
+                 (u64)rect.y * previous_pitch +
+                 (u64)rect.x * SPECTATE_BYTES_PER_PIXEL;
+
+  // Rows before the first difference are already in `previous`
+  u32 first_changed = 0;
+  if (!force) {
+    while (first_changed < rect.height &&
+           memcmp(src + (u64)first_changed * (u64)buffer->pitch,
+                  previous + (u64)first_changed * previous_pitch,
+                  row_bytes) == 0) {
+      ++first_changed;
+    }
+    if (first_changed == rect.height) {
+      return 0;
+    }
+  }
+
+  for (u32 row = 0; row < rect.height; ++row) {
+    const u8 *src_row = src + (u64)row * (u64)buffer->pitch;
+    if (row >= first_changed) {
+      memcpy(previous + (u64)row * previous_pitch, src_row, row_bytes);
+    }
+    memcpy(out + (u64)row * row_bytes, src_row, row_bytes);
+  }
+  return (u32)(row_bytes * rect.height);
+}
+
+/**
+ * Size the previous frame, marks and slots for this backbuffer. Only
+ * with the ring empty; a new size starts with a keyframe.
+ */
+de100_file_scoped_fn bool spectate_resize(Spectate *spectate,
+                                          const GameBackBuffer *buffer) {
+  u32 width = (u32)buffer->width;
+  u32 height = (u32)buffer->height;
+  u32 tiles_x = (width + SPECTATE_TILE_SIZE - 1) / SPECTATE_TILE_SIZE;
+  u32 tiles_y = (height + SPECTATE_TILE_SIZE - 1) / SPECTATE_TILE_SIZE;
+  u64 frame_bytes = (u64)width * height * SPECTATE_BYTES_PER_PIXEL;
+  u64 slot_bytes = frame_bytes + (u64)tiles_x * tiles_y * sizeof(u32);
+
+  if (!spectate_reserve(&spectate->previous, frame_bytes) ||
+      !spectate_reserve(&spectate->tile_marks, (u64)tiles_x * tiles_y)) {
+    return false;
+  }
+  if (slot_bytes > spectate->slot_bytes) {
+    for (u32 i = 0; i < SPECTATE_RING_SIZE; ++i) {
+      SpectateSlot *slot = &spectate->slots[i];
+      spectate_release(&slot->block);
+      slot->block = de100_memory_alloc(
+          NULL, slot_bytes, De100_MEMORY_FLAG_RW | De100_MEMORY_FLAG_PREFAULT);
+      if (!de100_memory_is_valid(slot->block)) {
+        spectate->slot_bytes = 0;
+        return false;
+      }
+    }
+    spectate->slot_bytes = slot_bytes;
+  }
+  for (u32 i = 0; i < SPECTATE_RING_SIZE; ++i) {
+    SpectateSlot *slot = &spectate->slots[i];
+    slot->tile_indexes = (u32 *)((u8 *)slot->block.base + frame_bytes);
+  }
+
+  spectate->width = width;
+  spectate->height = height;
+  spectate->tiles_x = tiles_x;
+  spectate->tiles_y = tiles_y;
+  spectate->needs_keyframe = true;
+  return true;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// SENDER THREAD
+// ═══════════════════════════════════════════════════════════════════════════
+
+#if !defined(_WIN32)
+
+de100_file_scoped_fn void spectate_drop(Spectate *spectate,
+                                        Spectator *spectator) {
+  close(spectator->fd);
+  spectator->fd = -1;
+  spectator->is_synced = false;
+  __atomic_store_n(&spectate->spectator_count,
+                   spectate->spectator_count - 1, __ATOMIC_RELEASE);
+}
+
+/** All of `size`, or false (peer gone, or full for the send timeout). */
+de100_file_scoped_fn bool spectate_send_all(i32 fd, const void *data,
+                                            u64 size) {
+  const u8 *bytes = (const u8 *)data;
+  while (size > 0) {
+    ssize_t sent = send(fd, bytes, size, MSG_NOSIGNAL);
+    if (sent < 0 && errno == EINTR) {
+      continue;
+    }
+    if (sent <= 0) {
+      return false;
+    }
+    bytes += sent;
+    size -= (u64)sent;
+  }
+  return true;
+}
+
+de100_file_scoped_fn void spectate_accept(Spectate *spectate) {
+  for (;;) {
+    i32 fd = accept(spectate->listen_fd, NULL, NULL);
+    if (fd < 0) {
+      return; // EAGAIN: nobody else waiting
+    }
+
+    Spectator *free_spectator = NULL;
+    for (u32 i = 0; i < SPECTATE_MAX_SPECTATORS && !free_spectator; ++i) {
+      if (spectate->spectators[i].fd < 0) {
+        free_spectator = &spectate->spectators[i];
+      }
+    }
+    if (!free_spectator) {
+      close(fd);
+      continue;
+    }
+
+    // Blocking with a timeout, so one stuck screen can't hold the rest
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) & ~O_NONBLOCK);
+    struct timeval timeout = {
+        .tv_sec = SPECTATE_SEND_TIMEOUT_MS / 1000,
+        .tv_usec = (SPECTATE_SEND_TIMEOUT_MS % 1000) * 1000,
+    };
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+    free_spectator->fd = fd;
+    free_spectator->is_synced = false;
+    spectate->spectators_served++;
+    __atomic_store_n(&spectate->spectator_count,
+                     spectate->spectator_count + 1, __ATOMIC_RELEASE);
+    __atomic_store_n(&spectate->keyframe_requested, true, __ATOMIC_RELEASE);
+  }
+}
+
+de100_file_scoped_fn void spectate_send(Spectate *spectate,
+                                        const SpectateSlot *slot) {
+  bool is_keyframe = slot->flags & SPECTATE_FRAME_KEYFRAME;
+  bool has_receiver = false;
+  for (u32 i = 0; i < SPECTATE_MAX_SPECTATORS; ++i) {
+    const Spectator *spectator = &spectate->spectators[i];
+    has_receiver = has_receiver || (spectator->fd >= 0 &&
+                                    (spectator->is_synced || is_keyframe));
+  }
+  if (!has_receiver) {
+    return;
+  }
+
+  u64 bound = de100_lz_compress_bound(slot->pixel_bytes);
+  if (!spectate_reserve(&spectate->compressed, bound)) {
+    return;
+  }
+  De100CompressResult compressed =
+      de100_lz_compress(slot->block.base, slot->pixel_bytes,
+                        spectate->compressed.base, bound);
+  if (!compressed.success) {
+    return;
+  }
+
+  SpectateFrameHeader header = {
+      .magic = SPECTATE_MAGIC,
+      .version = SPECTATE_VERSION,
+      .flags = slot->flags,
+      .frame = slot->frame,
+      .width = slot->width,
+      .height = slot->height,
+      .tile_size = SPECTATE_TILE_SIZE,
+      .pixel_format = slot->pixel_format,
+      .tile_count = slot->tile_count,
+      .compressed_size = (u32)compressed.size,
+  };
+  u64 index_bytes = (u64)slot->tile_count * sizeof(u32);
+
+  for (u32 i = 0; i < SPECTATE_MAX_SPECTATORS; ++i) {
+    Spectator *spectator = &spectate->spectators[i];
+    if (spectator->fd < 0) {
+      continue;
+    }
+    if (!spectator->is_synced && !is_keyframe) {
+      continue; // Deltas mean nothing before the first keyframe
+    }
+    if (!spectate_send_all(spectator->fd, &header, sizeof(header)) ||
+        !spectate_send_all(spectator->fd, slot->tile_indexes, index_bytes) ||
+        !spectate_send_all(spectator->fd, spectate->compressed.base,
+                           compressed.size)) {
+      spectate->spectators_dropped++;
+      spectate_drop(spectate, spectator);
+      continue;
+    }
+    spectator->is_synced = true;
+    spectate->bytes_sent += sizeof(header) + index_bytes + compressed.size;
+  }
+}
+
+de100_file_scoped_fn void *spectate_sender_proc(void *arg) {
+  Spectate *spectate = (Spectate *)arg;
+
+  for (;;) {
+    bool running = __atomic_load_n(&spectate->is_running, __ATOMIC_ACQUIRE);
+    spectate_accept(spectate);
+
+    u64 read = spectate->read_index;
+    u64 write = __atomic_load_n(&spectate->write_index, __ATOMIC_ACQUIRE);
+    for (; read < write; ++read) {
+      spectate_send(spectate,
+                    &spectate->slots[read & (SPECTATE_RING_SIZE - 1)]);
+      // Hand the slot back as soon as it's sent
+      __atomic_store_n(&spectate->read_index, read + 1, __ATOMIC_RELEASE);
+    }
+
+    if (!running) {
+      break;
+    }
+    struct timespec idle = {0, SPECTATE_SENDER_IDLE_NS};
+    nanosleep(&idle, NULL);
+  }
+
+  return NULL;
+}
+
+#endif // !_WIN32
+
+// ═══════════════════════════════════════════════════════════════════════════
+// SPEC
+// ═══════════════════════════════════════════════════════════════════════════
+
+/** "PORT[,EVERY]" → listening socket. */
+de100_file_scoped_fn SpectateErrorCode spectate_open(Spectate *spectate,
+                                                    const char *spec) {
+  char *end = NULL;
+  unsigned long port = strtoul(spec, &end, 10);
+  if (end == spec || port == 0 || port > 65535 ||
+      (*end != '\0' && *end != ',')) {
+    return SPECTATE_ERROR_BAD_SPEC;
+  }
+  spectate->port = (u16)port;
+  spectate->every = 1;
+  if (*end == ',') {
+    const char *every_text = end + 1;
+    unsigned long every = strtoul(every_text, &end, 10);
+    if (end == every_text || *end != '\0' || every == 0 ||
+        every > 1000000) {
+      return SPECTATE_ERROR_BAD_SPEC;
+    }
+    spectate->every = (u32)every;
+  }
+
+#if defined(_WIN32)
+  return SPECTATE_ERROR_SOCKET_FAILED;
+#else
+  spectate->listen_fd = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+  if (spectate->listen_fd < 0) {
+    return SPECTATE_ERROR_SOCKET_FAILED;
+  }
+  int reuse = 1;
+  setsockopt(spectate->listen_fd, SOL_SOCKET, SO_REUSEADDR, &reuse,
+             sizeof(reuse));
+  fcntl(spectate->listen_fd, F_SETFL,
+        fcntl(spectate->listen_fd, F_GETFL, 0) | O_NONBLOCK);
+
+  struct sockaddr_in local = {0};
+  local.sin_family = AF_INET;
+  local.sin_addr.s_addr = htonl(INADDR_ANY);
+  local.sin_port = htons(spectate->port);
+  if (bind(spectate->listen_fd, (struct sockaddr *)&local, sizeof(local)) !=
+          0 ||
+      listen(spectate->listen_fd, SPECTATE_MAX_SPECTATORS) != 0) {
+    return SPECTATE_ERROR_LISTEN_FAILED;
+  }
+  return SPECTATE_SUCCESS;
+#endif
+}
+
+de100_file_scoped_fn void spectate_close(Spectate *spectate) {
+#if !defined(_WIN32)
+  if (spectate->listen_fd >= 0) {
+    close(spectate->listen_fd);
+  }
+  for (u32 i = 0; i < SPECTATE_MAX_SPECTATORS; ++i) {
+    if (spectate->spectators[i].fd >= 0) {
+      close(spectate->spectators[i].fd);
+    }
+    spectate->spectators[i].fd = -1;
+  }
+#endif
+  spectate->listen_fd = -1;
+  spectate->spectator_count = 0;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// PUBLIC API
+// ═══════════════════════════════════════════════════════════════════════════
+
+SpectateResult spectate_begin(const char *spec) {
+  SpectateResult result = {0};
+  Spectate *spectate = &g_spectate;
+
+  if (!spec || !spec[0]) {
+    result.error_code = SPECTATE_ERROR_BAD_SPEC;
+    return result;
+  }
+  if (spectate->sender_started) {
+    result.error_code = SPECTATE_ERROR_ALREADY_ACTIVE;
+    return result;
+  }
+
+  *spectate = (Spectate){.listen_fd = -1};
+  for (u32 i = 0; i < SPECTATE_MAX_SPECTATORS; ++i) {
+    spectate->spectators[i].fd = -1;
+  }
+  SpectateErrorCode open_error = spectate_open(spectate, spec);
+  if (open_error != SPECTATE_SUCCESS) {
+    spectate_close(spectate);
+    result.error_code = open_error;
+    return result;
+  }
+
+#if !defined(_WIN32)
+  __atomic_store_n(&spectate->is_running, true, __ATOMIC_RELEASE);
+  if (pthread_create(&spectate->sender, NULL, spectate_sender_proc,
+                     spectate) != 0) {
+    __atomic_store_n(&spectate->is_running, false, __ATOMIC_RELEASE);
+    spectate_close(spectate);
+    result.error_code = SPECTATE_ERROR_THREAD_CREATE_FAILED;
+    return result;
+  }
+  spectate->sender_started = true;
+#endif
+
+  printf("[SPECTATE] 📺 Serving every %u frame(s) on port %u\n",
+         spectate->every, spectate->port);
+  result.success = true;
+  result.error_code = SPECTATE_SUCCESS;
+  return result;
+}
+
+void spectate_frame(const GameBackBuffer *backbuffer) {
+  Spectate *spectate = &g_spectate;
+  if (!spectate->sender_started || spectate->is_disabled) {
+    return;
+  }
+  u64 frame = spectate->frames_offered++;
+
+  // Nobody watching: a new spectator asks for a keyframe anyway
+  if (__atomic_load_n(&spectate->spectator_count, __ATOMIC_ACQUIRE) == 0 ||
+      backbuffer->is_rendering_disabled || !backbuffer->memory.base ||
+      backbuffer->width <= 0 || backbuffer->height <= 0 ||
+      backbuffer->width > SPECTATE_MAX_DIMENSION ||
+      backbuffer->height > SPECTATE_MAX_DIMENSION ||
+      backbuffer->bytes_per_pixel != SPECTATE_BYTES_PER_PIXEL) {
+    return;
+  }
+  if (__atomic_exchange_n(&spectate->keyframe_requested, false,
+                          __ATOMIC_ACQ_REL)) {
+    spectate->needs_keyframe = true;
+  }
+
+  u64 write = spectate->write_index;
+  u64 read = __atomic_load_n(&spectate->read_index, __ATOMIC_ACQUIRE);
+  if ((u32)backbuffer->width != spectate->width ||
+      (u32)backbuffer->height != spectate->height) {
+    if (read != write) {
+      return; // The sender holds slots sized for the old frame
+    }
+    if (!spectate_resize(spectate, backbuffer)) {
+      fprintf(stderr, "[SPECTATE] ❌ Out of memory for %dx%d frames, "
+                      "spectating off\n",
+              backbuffer->width, backbuffer->height);
+      spectate->is_disabled = true;
+      return;
+    }
+  }
+
+  spectate_mark_tiles(spectate, backbuffer);
+  if (frame % spectate->every != 0) {
+    return;
+  }
+  if (write - read >= SPECTATE_RING_SIZE) {
+    spectate->frames_dropped++;
+    return; // Marks stay for the next queued frame
+  }
+
+  SpectateSlot *slot = &spectate->slots[write & (SPECTATE_RING_SIZE - 1)];
+  u8 *marks = (u8 *)spectate->tile_marks.base;
+  u8 *out = (u8 *)slot->block.base;
+  u32 tile_total = spectate->tiles_x * spectate->tiles_y;
+  bool is_keyframe = spectate->needs_keyframe;
+  u32 tile_count = 0;
+  u32 pixel_bytes = 0;
+
+  for (u32 index = 0; index < tile_total; ++index) {
+    if (!is_keyframe && !marks[index]) {
+      continue;
+    }
+    marks[index] = 0;
+    u32 bytes = spectate_take_tile(spectate, backbuffer, index,
+                                   out + pixel_bytes, is_keyframe);
+    if (bytes > 0) {
+      slot->tile_indexes[tile_count++] = index;
+      pixel_bytes += bytes;
+    }
+  }
+  if (tile_count == 0) {
+    return; // Nothing changed: nothing to send
+  }
+
+  slot->tile_count = tile_count;
+  slot->pixel_bytes = pixel_bytes;
+  slot->frame = (u32)frame;
+  slot->width = (u16)spectate->width;
+  slot->height = (u16)spectate->height;
+  slot->pixel_format = (u16)backbuffer->pixel_format;
+  slot->flags = is_keyframe ? SPECTATE_FRAME_KEYFRAME : 0;
+  __atomic_store_n(&spectate->write_index, write + 1, __ATOMIC_RELEASE);
+
+  spectate->needs_keyframe = false;
+  spectate->frames_queued++;
+  spectate->tiles_queued += tile_count;
+}
+
+void spectate_end(void) {
+  Spectate *spectate = &g_spectate;
+  if (!spectate->sender_started) {
+    return;
+  }
+
+  __atomic_store_n(&spectate->is_running, false, __ATOMIC_RELEASE);
+  pthread_join(spectate->sender, NULL);
+  spectate->sender_started = false;
+  spectate_close(spectate);
+
+  printf("[SPECTATE] ✅ Stopped: %lu frames, %lu tiles, %lu KB sent to %u "
+         "spectator(s) (%lu frames dropped, ring full; %u spectators "
+         "dropped)\n",
+         (unsigned long)spectate->frames_queued,
+         (unsigned long)spectate->tiles_queued,
+         (unsigned long)(spectate->bytes_sent / 1024),
+         spectate->spectators_served,
+         (unsigned long)spectate->frames_dropped,
+         spectate->spectators_dropped);
+
+  for (u32 i = 0; i < SPECTATE_RING_SIZE; ++i) {
+    spectate_release(&spectate->slots[i].block);
+  }
+  spectate->slot_bytes = 0;
+  spectate->write_index = 0;
+  spectate->read_index = 0;
+  spectate_release(&spectate->previous);
+  spectate_release(&spectate->tile_marks);
+  spectate_release(&spectate->compressed);
+  spectate->width = 0;
+  spectate->height = 0;
+}
+
+bool spectate_is_active(void) { return g_spectate.sender_started; }
+
+// ═══════════════════════════════════════════════════════════════════════════
+// VIEWER
+// ═══════════════════════════════════════════════════════════════════════════
+
+SpectateResult spectate_apply(const SpectateFrameHeader *header,
+                              const u32 *tile_indexes, const void *block,
+                              void *scratch, size_t scratch_size, u8 *pixels,
+                              u32 pitch) {
+  SpectateResult result = {0};
+  result.error_code = SPECTATE_ERROR_CORRUPT_FRAME;
+  if (header->magic != SPECTATE_MAGIC ||
+      header->version != SPECTATE_VERSION ||
+      header->tile_size != SPECTATE_TILE_SIZE || header->width == 0 ||
+      header->height == 0) {
+    return result;
+  }
+
+  De100CompressResult decompressed = de100_lz_decompress(
+      block, header->compressed_size, scratch, scratch_size);
+  if (!decompressed.success) {
+    return result;
+  }
+
+  u32 tiles_x = (header->width + SPECTATE_TILE_SIZE - 1) / SPECTATE_TILE_SIZE;
+  u32 tiles_y = (header->height + SPECTATE_TILE_SIZE - 1) / SPECTATE_TILE_SIZE;
+  const u8 *in = (const u8 *)scratch;
+  size_t offset = 0;
+  for (u32 i = 0; i < header->tile_count; ++i) {
+    if (tile_indexes[i] >= tiles_x * tiles_y) {
+      return result;
+    }
+    SpectateTileRect rect = spectate_tile_rect(tile_indexes[i], tiles_x,
+                                               header->width, header->height);
+    size_t row_bytes = (size_t)rect.width * SPECTATE_BYTES_PER_PIXEL;
+    if (offset + row_bytes * rect.height > decompressed.size) {
+      return result;
+    }
+    for (u32 row = 0; row < rect.height; ++row) {
+      memcpy(pixels + (size_t)(rect.y + row) * pitch +
+                 (size_t)rect.x * SPECTATE_BYTES_PER_PIXEL,
+             in + offset, row_bytes);
+      offset += row_bytes;
+    }
+  }
+  if (offset != decompressed.size) {
+    return result;
+  }
+
+  result.success = true;
+  result.error_code = SPECTATE_SUCCESS;
+  return result;
+}
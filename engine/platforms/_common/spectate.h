@@ -0,0 +1,129 @@
+#ifndef DE100_PLATFORMS__COMMON_SPECTATE_H
+#define DE100_PLATFORMS__COMMON_SPECTATE_H
+
+#include "../../_common/base.h"
+#include "../../game/backbuffer.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// SPECTATE (live backbuffer stream to spectator screens over TCP)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// For tournaments: a kiosk serves its frames to spectator screens on the
+// LAN. Built in every configuration.
+//
+//   main thread ──slot ring──▶ sender thread ──TCP──▶ spectators
+//
+// The frame is cut into SPECTATE_TILE_SIZE² tiles. The main thread keeps
+// a copy of the last frame it queued, compares only the tiles this frame
+// may have changed, and queues the ones that differ:
+//
+//   - with dirty rect tracking (GameDirtyRegion.is_tracking), the tiles
+//     under the frame's dirty rects: an idle frame compares nothing
+//   - otherwise, or on a full_frame region, every tile (a memcmp per row,
+//     stopping at the first row that differs)
+//
+// so its cost follows what changed, not the resolution. A frame with no
+// changed tile sends nothing. Tiles marked on a frame that isn't queued
+// (EVERY > 1, ring full) stay marked until one is. With nobody watching,
+// spectate_frame returns at once.
+//
+// The sender thread accepts spectators, compresses each queued frame's
+// tiles as one LZ block (compression.h) and writes it to every spectator.
+// A new spectator gets nothing until the next KEYFRAME (every tile),
+// which its connection requests. TCP keeps the deltas whole and in order;
+// a spectator whose socket stays full for SPECTATE_SEND_TIMEOUT_MS is
+// dropped rather than stall the others.
+//
+// DE100_SPECTATE environment variable at engine_init:
+//   PORT[,EVERY]   Listen on PORT (all interfaces) and stream every
+//                  EVERYth frame (default 1)
+//
+// Messages are in host byte order (little-endian on every supported
+// target):
+//
+//   SpectateFrameHeader
+//   u32 tile_indexes[tile_count]     ty * tiles_x + tx, ascending
+//   u8  block[compressed_size]       de100_lz_compress() of the tiles'
+//                                    pixels, in tile_indexes order, each
+//                                    tile's rows packed (edge tiles are
+//                                    clipped to the frame)
+//
+// spectate_apply() decodes one into a viewer's pixels.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define SPECTATE_RING_SIZE 4 // Slots, power of two
+#define SPECTATE_TILE_SIZE 32
+#define SPECTATE_MAX_SPECTATORS 8
+#define SPECTATE_SEND_TIMEOUT_MS 1000
+#define SPECTATE_MAGIC 0x53534544u // "DESS" little-endian
+#define SPECTATE_VERSION 1
+
+typedef enum {
+  SPECTATE_SUCCESS = 0,
+  SPECTATE_ERROR_BAD_SPEC,
+  SPECTATE_ERROR_ALREADY_ACTIVE,
+  SPECTATE_ERROR_SOCKET_FAILED,
+  SPECTATE_ERROR_LISTEN_FAILED,
+  SPECTATE_ERROR_THREAD_CREATE_FAILED,
+  SPECTATE_ERROR_CORRUPT_FRAME,
+
+  SPECTATE_ERROR_COUNT
+} SpectateErrorCode;
+
+typedef struct {
+  bool success;
+  SpectateErrorCode error_code;
+} SpectateResult;
+
+typedef enum {
+  SPECTATE_FRAME_KEYFRAME = 1 << 0, // Every tile; a viewer may start here
+} SpectateFrameFlags;
+
+/** Wire format, first in every message. */
+typedef struct {
+  u32 magic;
+  u16 version;
+  u16 flags;  // SpectateFrameFlags
+  u32 frame;  // Frames offered since spectate_begin
+  u16 width;  // Backbuffer pixels
+  u16 height;
+  u16 tile_size;
+  u16 pixel_format; // DE100_PIXEL_FORMAT_*
+  u32 tile_count;
+  u32 compressed_size;
+} SpectateFrameHeader;
+
+/**
+ * Parse "PORT[,EVERY]", listen, and start the sender thread.
+ */
+SpectateResult spectate_begin(const char *spec);
+
+/**
+ * Offer this frame's finished backbuffer. Main thread, once per frame,
+ * next to capture_frame() (before the debug overlay draws and before
+ * present clears the dirty rects).
+ */
+void spectate_frame(const GameBackBuffer *backbuffer);
+
+/** Stop the sender, close every connection, free the ring. */
+void spectate_end(void);
+
+bool spectate_is_active(void);
+
+/**
+ * Viewer side: apply one message to `pixels` (header->width ×
+ * header->height, `pitch` bytes per row). `scratch` needs room for the
+ * decompressed tiles: tile_count × SPECTATE_TILE_SIZE² × 4 bytes is
+ * always enough.
+ */
+SpectateResult spectate_apply(const SpectateFrameHeader *header,
+                              const u32 *tile_indexes, const void *block,
+                              void *scratch, size_t scratch_size, u8 *pixels,
+                              u32 pitch);
+
+const char *spectate_strerror(SpectateErrorCode code);
+
+#endif // DE100_PLATFORMS__COMMON_SPECTATE_H
@@ -0,0 +1,375 @@
+#include "./telemetry.h"
+#include "../../_common/memory.h"
+#include "../../_common/time.h"
+#include "./frame-histogram.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if !defined(_WIN32)
+#include <netdb.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+_Static_assert(sizeof(TelemetryPacket) ==
+                   96 + 8 * TELEMETRY_COUNTER_COUNT,
+               "TelemetryPacket is a wire format: no padding");
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ERROR MESSAGES
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_global_var const char *g_telemetry_error_messages[] = {
+    [TELEMETRY_SUCCESS] = "Success",
+    [TELEMETRY_ERROR_BAD_DESTINATION] =
+        "Bad destination (expected HOST:PORT[,SECONDS])",
+    [TELEMETRY_ERROR_ALREADY_ACTIVE] = "Telemetry is already running",
+    [TELEMETRY_ERROR_SOCKET_FAILED] = "Failed to open the UDP socket",
+    [TELEMETRY_ERROR_ALLOC_FAILED] = "Failed to allocate the record ring",
+    [TELEMETRY_ERROR_THREAD_CREATE_FAILED] =
+        "Failed to create the telemetry sender thread",
+};
+
+const char *telemetry_strerror(TelemetryErrorCode code) {
+  if (code >= 0 && code < TELEMETRY_ERROR_COUNT) {
+    return g_telemetry_error_messages[code];
+  }
+  return "Unknown telemetry error";
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// STATE
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define TELEMETRY_RING_MASK (TELEMETRY_RING_SIZE - 1)
+#define TELEMETRY_SENDER_IDLE_NS (10 * 1000 * 1000)
+
+typedef enum {
+  TELEMETRY_RECORD_FRAME = 0,
+  TELEMETRY_RECORD_COUNTER,
+} TelemetryRecordType;
+
+typedef struct {
+  u8 type;    // TelemetryRecordType
+  u8 counter; // TelemetryCounter, or 1 = missed (FRAME)
+  u16 reserved;
+  f32 frame_ms;
+  u64 value;
+} TelemetryRecord;
+
+typedef struct {
+  i32 fd;
+  u8 address[128]; // sockaddr_storage
+  u32 address_size;
+  f32 interval_seconds;
+
+  // main thread → sender
+  De100MemoryBlock ring_block;
+  TelemetryRecord *ring;
+  u64 write_index;
+  u64 read_index;
+  u64 dropped_records; // __atomic (written by main, read by sender)
+
+  pthread_t sender;
+  bool sender_started;
+  bool is_running; // __atomic
+
+  // Sender-only
+  FrameHistogram interval;
+  u32 missed_frames;
+  u64 counters[TELEMETRY_COUNTER_COUNT];
+  TelemetryPacket packet; // Header fields fixed at begin
+  f64 start_seconds;
+  f64 interval_start_seconds;
+  u64 send_failures;
+} Telemetry;
+
+de100_file_scoped_global_var Telemetry g_telemetry = {.fd = -1};
+
+// ═══════════════════════════════════════════════════════════════════════════
+// SENDER THREAD
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn void telemetry_send(Telemetry *telemetry, f64 now) {
+  TelemetryPacket *packet = &telemetry->packet;
+  const FrameHistogram *histogram = &telemetry->interval;
+
+  packet->uptime_seconds = now - telemetry->start_seconds;
+  packet->interval_seconds = (f32)(now - telemetry->interval_start_seconds);
+  packet->frame_count = (u32)histogram->count;
+  packet->missed_frames = telemetry->missed_frames;
+  packet->dropped_records =
+      (u32)__atomic_load_n(&telemetry->dropped_records, __ATOMIC_RELAXED);
+  packet->mean_ms =
+      histogram->count
+          ? (f32)((f64)histogram->total_us / (f64)histogram->count / 1000.0)
+          : 0.0f;
+  packet->p50_ms = frame_histogram_percentile_ms(histogram, 50.0f);
+  packet->p95_ms = frame_histogram_percentile_ms(histogram, 95.0f);
+  packet->p99_ms = frame_histogram_percentile_ms(histogram, 99.0f);
+  packet->p999_ms = frame_histogram_percentile_ms(histogram, 99.9f);
+  packet->max_ms = (f32)histogram->max_us / 1000.0f;
+  memcpy(packet->counters, telemetry->counters, sizeof(packet->counters));
+
+#if !defined(_WIN32)
+  if (sendto(telemetry->fd, packet, sizeof(*packet), 0,
+             (const struct sockaddr *)telemetry->address,
+             telemetry->address_size) != (ssize_t)sizeof(*packet)) {
+    telemetry->send_failures++; // Collector down: keep trying next interval
+  }
+#endif
+
+  packet->sequence++;
+  memset(&telemetry->interval, 0, sizeof(telemetry->interval));
+  telemetry->missed_frames = 0;
+  telemetry->interval_start_seconds = now;
+}
+
+de100_file_scoped_fn void telemetry_consume(Telemetry *telemetry,
+                                            const TelemetryRecord *record) {
+  if (record->type == TELEMETRY_RECORD_FRAME) {
+    frame_histogram_record(&telemetry->interval, record->frame_ms);
+    telemetry->missed_frames += record->counter;
+  } else if (record->counter < TELEMETRY_COUNTER_COUNT) {
+    telemetry->counters[record->counter] = record->value;
+  }
+}
+
+de100_file_scoped_fn void *telemetry_sender_proc(void *arg) {
+  Telemetry *telemetry = (Telemetry *)arg;
+
+  for (;;) {
+    bool running = __atomic_load_n(&telemetry->is_running, __ATOMIC_ACQUIRE);
+    u64 read = telemetry->read_index;
+    u64 write = __atomic_load_n(&telemetry->write_index, __ATOMIC_ACQUIRE);
+
+    for (; read < write; ++read) {
+      telemetry_consume(telemetry,
+                        &telemetry->ring[read & TELEMETRY_RING_MASK]);
+    }
+    __atomic_store_n(&telemetry->read_index, read, __ATOMIC_RELEASE);
+
+    f64 now = de100_get_wall_clock();
+    if (!running) {
+      if (telemetry->interval.count > 0) {
+        telemetry_send(telemetry, now); // Partial last interval
+      }
+      break;
+    }
+    if (now - telemetry->interval_start_seconds >=
+        (f64)telemetry->interval_seconds) {
+      telemetry_send(telemetry, now);
+    }
+
+    struct timespec idle = {0, TELEMETRY_SENDER_IDLE_NS};
+    nanosleep(&idle, NULL);
+  }
+
+  return NULL;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// DESTINATION
+// ═══════════════════════════════════════════════════════════════════════════
+
+/** "HOST:PORT[,SECONDS]" → socket and address. */
+de100_file_scoped_fn TelemetryErrorCode
+telemetry_open(Telemetry *telemetry, const char *destination) {
+  char host[256];
+  char port[16];
+  const char *comma = strchr(destination, ',');
+  size_t spec_length = comma ? (size_t)(comma - destination)
+                             : strlen(destination);
+  const char *colon = memchr(destination, ':', spec_length);
+  if (!colon || colon == destination ||
+      (size_t)(colon - destination) >= sizeof(host) ||
+      spec_length - (size_t)(colon - destination) - 1 >= sizeof(port) ||
+      (size_t)(colon - destination) + 1 == spec_length) {
+    return TELEMETRY_ERROR_BAD_DESTINATION;
+  }
+  memcpy(host, destination, (size_t)(colon - destination));
+  host[colon - destination] = '\0';
+  size_t port_length = spec_length - (size_t)(colon - destination) - 1;
+  memcpy(port, colon + 1, port_length);
+  port[port_length] = '\0';
+
+  telemetry->interval_seconds = TELEMETRY_DEFAULT_INTERVAL_SECONDS;
+  if (comma) {
+    f32 seconds = strtof(comma + 1, NULL);
+    if (seconds <= 0.0f) {
+      return TELEMETRY_ERROR_BAD_DESTINATION;
+    }
+    telemetry->interval_seconds = seconds;
+  }
+
+#if defined(_WIN32)
+  return TELEMETRY_ERROR_SOCKET_FAILED;
+#else
+  struct addrinfo hints = {0};
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_DGRAM;
+  struct addrinfo *addresses = NULL;
+  if (getaddrinfo(host, port, &hints, &addresses) != 0) {
+    return TELEMETRY_ERROR_BAD_DESTINATION;
+  }
+
+  for (struct addrinfo *it = addresses; it && telemetry->fd < 0;
+       it = it->ai_next) {
+    if (it->ai_addrlen > sizeof(telemetry->address)) {
+      continue;
+    }
+    telemetry->fd = socket(it->ai_family, it->ai_socktype, it->ai_protocol);
+    if (telemetry->fd >= 0) {
+      memcpy(telemetry->address, it->ai_addr, it->ai_addrlen);
+      telemetry->address_size = (u32)it->ai_addrlen;
+    }
+  }
+  freeaddrinfo(addresses);
+  return telemetry->fd >= 0 ? TELEMETRY_SUCCESS
+                            : TELEMETRY_ERROR_SOCKET_FAILED;
+#endif
+}
+
+de100_file_scoped_fn void telemetry_close(Telemetry *telemetry) {
+#if !defined(_WIN32)
+  if (telemetry->fd >= 0) {
+    close(telemetry->fd);
+  }
+#endif
+  telemetry->fd = -1;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// PUBLIC API
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn void telemetry_push(Telemetry *telemetry,
+                                         const TelemetryRecord *record) {
+  u64 write = telemetry->write_index;
+  u64 read = __atomic_load_n(&telemetry->read_index, __ATOMIC_ACQUIRE);
+  if (write - read >= TELEMETRY_RING_SIZE) {
+    __atomic_store_n(&telemetry->dropped_records,
+                     telemetry->dropped_records + 1, __ATOMIC_RELAXED);
+    return;
+  }
+  telemetry->ring[write & TELEMETRY_RING_MASK] = *record;
+  __atomic_store_n(&telemetry->write_index, write + 1, __ATOMIC_RELEASE);
+}
+
+TelemetryResult telemetry_begin(const char *destination) {
+  TelemetryResult result = {0};
+  Telemetry *telemetry = &g_telemetry;
+
+  if (!destination || !destination[0]) {
+    result.error_code = TELEMETRY_ERROR_BAD_DESTINATION;
+    return result;
+  }
+  if (telemetry->sender_started) {
+    result.error_code = TELEMETRY_ERROR_ALREADY_ACTIVE;
+    return result;
+  }
+
+  *telemetry = (Telemetry){.fd = -1};
+  TelemetryErrorCode open_error = telemetry_open(telemetry, destination);
+  if (open_error != TELEMETRY_SUCCESS) {
+    telemetry_close(telemetry);
+    result.error_code = open_error;
+    return result;
+  }
+
+  telemetry->ring_block = de100_memory_alloc(
+      NULL, sizeof(TelemetryRecord) * TELEMETRY_RING_SIZE,
+      De100_MEMORY_FLAG_RW_ZEROED);
+  if (!de100_memory_is_valid(telemetry->ring_block)) {
+    telemetry_close(telemetry);
+    result.error_code = TELEMETRY_ERROR_ALLOC_FAILED;
+    return result;
+  }
+  telemetry->ring = (TelemetryRecord *)telemetry->ring_block.base;
+
+  TelemetryPacket *packet = &telemetry->packet;
+  packet->magic = TELEMETRY_MAGIC;
+  packet->version = TELEMETRY_VERSION;
+  packet->size = (u16)sizeof(*packet);
+  telemetry->start_seconds = de100_get_wall_clock();
+  telemetry->interval_start_seconds = telemetry->start_seconds;
+#if !defined(_WIN32)
+  if (gethostname(packet->host, sizeof(packet->host)) != 0) {
+    snprintf(packet->host, sizeof(packet->host), "unknown");
+  }
+  packet->host[sizeof(packet->host) - 1] = '\0';
+  packet->session_id =
+      (u32)getpid() * 2654435761u ^ (u32)(telemetry->start_seconds * 1e6);
+#endif
+
+  __atomic_store_n(&telemetry->is_running, true, __ATOMIC_RELEASE);
+  if (pthread_create(&telemetry->sender, NULL, telemetry_sender_proc,
+                     telemetry) != 0) {
+    __atomic_store_n(&telemetry->is_running, false, __ATOMIC_RELEASE);
+    de100_memory_free(&telemetry->ring_block);
+    telemetry_close(telemetry);
+    result.error_code = TELEMETRY_ERROR_THREAD_CREATE_FAILED;
+    return result;
+  }
+  telemetry->sender_started = true;
+
+  printf("[TELEMETRY] 📡 Sending to %s every %.1fs (session %08x)\n",
+         destination, telemetry->interval_seconds, packet->session_id);
+  result.success = true;
+  result.error_code = TELEMETRY_SUCCESS;
+  return result;
+}
+
+void telemetry_frame(f32 frame_time_ms, f32 target_seconds_per_frame) {
+  Telemetry *telemetry = &g_telemetry;
+  if (!telemetry->sender_started) {
+    return;
+  }
+
+  TelemetryRecord record = {0};
+  record.type = TELEMETRY_RECORD_FRAME;
+  record.counter =
+      (frame_time_ms / 1000.0f) > (target_seconds_per_frame + 0.002f);
+  record.frame_ms = frame_time_ms;
+  telemetry_push(telemetry, &record);
+}
+
+void telemetry_counter(TelemetryCounter counter, u64 value) {
+  Telemetry *telemetry = &g_telemetry;
+  if (!telemetry->sender_started || counter < 0 ||
+      counter >= TELEMETRY_COUNTER_COUNT) {
+    return;
+  }
+
+  TelemetryRecord record = {0};
+  record.type = TELEMETRY_RECORD_COUNTER;
+  record.counter = (u8)counter;
+  record.value = value;
+  telemetry_push(telemetry, &record);
+}
+
+void telemetry_end(void) {
+  Telemetry *telemetry = &g_telemetry;
+  if (!telemetry->sender_started) {
+    return;
+  }
+
+  __atomic_store_n(&telemetry->is_running, false, __ATOMIC_RELEASE);
+  pthread_join(telemetry->sender, NULL);
+  telemetry->sender_started = false;
+
+  telemetry_close(telemetry);
+  de100_memory_free(&telemetry->ring_block);
+
+  printf("[TELEMETRY] ✅ Stopped after %u packets (%lu records dropped, "
+         "%lu sends failed)\n",
+         telemetry->packet.sequence,
+         (unsigned long)telemetry->dropped_records,
+         (unsigned long)telemetry->send_failures);
+}
+
+bool telemetry_is_active(void) { return g_telemetry.sender_started; }
@@ -0,0 +1,115 @@
+#ifndef DE100_PLATFORMS__COMMON_TELEMETRY_H
+#define DE100_PLATFORMS__COMMON_TELEMETRY_H
+
+#include "../../_common/base.h"
+#include <stdbool.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// TELEMETRY (remote frame stats over UDP)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// Every interval, one TelemetryPacket goes to a collector: frame time
+// percentiles and missed frames over the interval, plus the latest value
+// of each TelemetryCounter (audio underruns, reloads, memory high-water).
+// Built in every configuration, for fleets of release builds.
+//
+//   main thread ──ring──▶ sender thread ──UDP──▶ collector
+//
+// The main thread only pushes 16-byte records into a lock-free
+// single-producer/single-consumer ring. The sender thread owns the
+// histogram (frame-histogram.h), builds the packets and does the
+// sendto(). A full ring drops records (counted in the packet) rather than
+// stall the frame. UDP: a lost packet loses one interval, sequence
+// numbers show the gap.
+//
+// Destination (DE100_TELEMETRY environment variable at engine_init):
+//   HOST:PORT[,SECONDS]   Collector, and the interval (default 10)
+//
+// Packets are in host byte order (little-endian on every supported
+// target); collectors check magic and version, and use `size` to skip
+// fields a newer version appended.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define TELEMETRY_RING_SIZE 4096 // Records, power of two
+#define TELEMETRY_MAGIC 0x4D4C4544u // "DELM" little-endian
+#define TELEMETRY_VERSION 1
+#define TELEMETRY_DEFAULT_INTERVAL_SECONDS 10.0f
+#define TELEMETRY_HOST_LENGTH 32
+
+typedef enum {
+  TELEMETRY_COUNTER_AUDIO_UNDERRUNS = 0, // Cumulative
+  TELEMETRY_COUNTER_RELOADS,             // Game code hot reloads
+  TELEMETRY_COUNTER_PEAK_RESIDENT_BYTES,
+  TELEMETRY_COUNTER_COMMITTED_BYTES,     // Engine-owned regions, now
+  // Largest arena peak (DE100_INTERNAL), or largest arena use so far
+  TELEMETRY_COUNTER_ARENA_HIGH_WATER_BYTES,
+
+  TELEMETRY_COUNTER_COUNT
+} TelemetryCounter;
+
+typedef enum {
+  TELEMETRY_SUCCESS = 0,
+  TELEMETRY_ERROR_BAD_DESTINATION,
+  TELEMETRY_ERROR_ALREADY_ACTIVE,
+  TELEMETRY_ERROR_SOCKET_FAILED,
+  TELEMETRY_ERROR_ALLOC_FAILED,
+  TELEMETRY_ERROR_THREAD_CREATE_FAILED,
+
+  TELEMETRY_ERROR_COUNT
+} TelemetryErrorCode;
+
+typedef struct {
+  bool success;
+  TelemetryErrorCode error_code;
+} TelemetryResult;
+
+/** Wire format, one per interval. */
+typedef struct {
+  u32 magic;
+  u16 version;
+  u16 size;       // Bytes of this packet
+  u32 sequence;   // Per session; gaps are lost packets
+  u32 session_id; // Random per process, tells restarts apart
+  char host[TELEMETRY_HOST_LENGTH]; // gethostname(), NUL-terminated
+  f64 uptime_seconds;
+  f32 interval_seconds; // Wall time this packet covers
+
+  // Frames in the interval
+  u32 frame_count;
+  u32 missed_frames;    // Over target by more than 2ms, like frame stats
+  u32 dropped_records;  // Cumulative, ring was full
+  f32 mean_ms;
+  f32 p50_ms;
+  f32 p95_ms;
+  f32 p99_ms;
+  f32 p999_ms;
+  f32 max_ms;
+
+  u64 counters[TELEMETRY_COUNTER_COUNT]; // Latest values
+} TelemetryPacket;
+
+/**
+ * Parse the destination and start the sender thread.
+ *
+ * @param destination  "HOST:PORT[,SECONDS]"
+ */
+TelemetryResult telemetry_begin(const char *destination);
+
+/**
+ * Queue one frame's time. Main thread, once per frame (after frame stats).
+ * No-op when not running.
+ */
+void telemetry_frame(f32 frame_time_ms, f32 target_seconds_per_frame);
+
+/** Queue a counter's current value. Main thread. No-op when not running. */
+void telemetry_counter(TelemetryCounter counter, u64 value);
+
+/** Send the partial interval, stop and join the sender. */
+void telemetry_end(void);
+
+bool telemetry_is_active(void);
+
+const char *telemetry_strerror(TelemetryErrorCode code);
+
+#endif // DE100_PLATFORMS__COMMON_TELEMETRY_H
@@ -0,0 +1,397 @@
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE // sched_getaffinity, pthread_setaffinity_np
+#endif
+
+#include "./thread-placement.h"
+#include "../../_common/memory.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <avrt.h>
+#if defined(_MSC_VER)
+#pragma comment(lib, "avrt.lib")
+#endif
+#elif defined(__APPLE__)
+#include <pthread.h>
+#include <pthread/qos.h>
+#include <unistd.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// nice level for a thread SCHED_FIFO was refused to: the same boost the
+// desktop gives its own audio threads
+#define THREAD_PLACEMENT_AUDIO_NICE -11
+
+// ═══════════════════════════════════════════════════════════════════════════
+// TOPOLOGY
+// ═══════════════════════════════════════════════════════════════════════════
+
+/**
+ * Sort cpus[] by (core key, cpu) and number the cores. keys[i] belongs
+ * to cpus[i]; CPUs sharing a key are hardware threads of one core.
+ */
+de100_file_scoped_fn void topology_group(De100CpuTopology *topology,
+                                         u64 *keys) {
+  // Insertion sort: at most a few hundred entries, once at startup
+  for (u32 i = 1; i < topology->cpu_count; ++i) {
+    u16 cpu = topology->cpus[i];
+    u64 key = keys[i];
+    u32 j = i;
+    while (j > 0 && (keys[j - 1] > key ||
+                     (keys[j - 1] == key && topology->cpus[j - 1] > cpu))) {
+      topology->cpus[j] = topology->cpus[j - 1];
+      keys[j] = keys[j - 1];
+      --j;
+    }
+    topology->cpus[j] = cpu;
+    keys[j] = key;
+  }
+
+  topology->core_count = 0;
+  for (u32 i = 0; i < topology->cpu_count; ++i) {
+    if (i == 0 || keys[i] != keys[i - 1]) {
+      ++topology->core_count;
+    }
+    topology->cpu_core[i] = (u16)(topology->core_count - 1);
+  }
+}
+
+#if defined(__linux__)
+
+de100_file_scoped_fn i64 topology_read_sysfs(u32 cpu, const char *name) {
+  char path[128];
+  snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/topology/%s",
+           cpu, name);
+  FILE *file = fopen(path, "r");
+  if (!file) {
+    return -1;
+  }
+  long long value = -1;
+  if (fscanf(file, "%lld", &value) != 1) {
+    value = -1;
+  }
+  fclose(file);
+  return (i64)value;
+}
+
+void de100_cpu_topology_query(De100CpuTopology *topology) {
+  de100_mem_set(topology, 0, sizeof(*topology));
+  u64 keys[DE100_THREAD_PLACEMENT_MAX_CPUS];
+
+  cpu_set_t allowed;
+  CPU_ZERO(&allowed);
+  if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+    topology->cpus[0] = 0;
+    topology->cpu_count = topology->core_count = 1;
+    return;
+  }
+
+  for (u32 cpu = 0; cpu < CPU_SETSIZE &&
+                    topology->cpu_count < DE100_THREAD_PLACEMENT_MAX_CPUS;
+       ++cpu) {
+    if (!CPU_ISSET(cpu, &allowed)) {
+      continue;
+    }
+    i64 package = topology_read_sysfs(cpu, "physical_package_id");
+    i64 core = topology_read_sysfs(cpu, "core_id");
+    // No sysfs topology (some containers, old ARM kernels): own core
+    u64 key = (package < 0 || core < 0)
+                  ? (1ull << 63) | cpu
+                  : ((u64)package << 32) | (u64)(u32)core;
+    keys[topology->cpu_count] = key;
+    topology->cpus[topology->cpu_count++] = (u16)cpu;
+  }
+
+  topology_group(topology, keys);
+}
+
+#elif defined(_WIN32)
+
+// First processor group only (64 logical CPUs)
+void de100_cpu_topology_query(De100CpuTopology *topology) {
+  de100_mem_set(topology, 0, sizeof(*topology));
+  u64 keys[DE100_THREAD_PLACEMENT_MAX_CPUS];
+
+  DWORD_PTR process_mask = 0, system_mask = 0;
+  if (!GetProcessAffinityMask(GetCurrentProcess(), &process_mask,
+                              &system_mask)) {
+    process_mask = 1;
+  }
+
+  SYSTEM_LOGICAL_PROCESSOR_INFORMATION info[256];
+  DWORD length = sizeof(info);
+  u32 entry_count = 0;
+  if (GetLogicalProcessorInformation(info, &length)) {
+    entry_count = (u32)(length / sizeof(info[0]));
+  }
+
+  for (u32 cpu = 0; cpu < 64 && topology->cpu_count <
+                                    DE100_THREAD_PLACEMENT_MAX_CPUS;
+       ++cpu) {
+    DWORD_PTR bit = (DWORD_PTR)1 << cpu;
+    if (!(process_mask & bit)) {
+      continue;
+    }
+    u64 key = (1ull << 63) | cpu;
+    for (u32 i = 0; i < entry_count; ++i) {
+      if (info[i].Relationship == RelationProcessorCore &&
+          (info[i].ProcessorMask & bit)) {
+        key = i;
+        break;
+      }
+    }
+    keys[topology->cpu_count] = key;
+    topology->cpus[topology->cpu_count++] = (u16)cpu;
+  }
+
+  if (topology->cpu_count == 0) {
+    topology->cpus[0] = 0;
+    keys[0] = 0;
+    topology->cpu_count = 1;
+  }
+  topology_group(topology, keys);
+}
+
+#else
+
+// No usable topology (macOS hides it): every CPU is its own core
+void de100_cpu_topology_query(De100CpuTopology *topology) {
+  de100_mem_set(topology, 0, sizeof(*topology));
+  u64 keys[DE100_THREAD_PLACEMENT_MAX_CPUS];
+
+  long count = sysconf(_SC_NPROCESSORS_ONLN);
+  if (count < 1) {
+    count = 1;
+  }
+  if (count > DE100_THREAD_PLACEMENT_MAX_CPUS) {
+    count = DE100_THREAD_PLACEMENT_MAX_CPUS;
+  }
+  for (u32 cpu = 0; cpu < (u32)count; ++cpu) {
+    keys[cpu] = cpu;
+    topology->cpus[cpu] = (u16)cpu;
+  }
+  topology->cpu_count = (u32)count;
+  topology_group(topology, keys);
+}
+
+#endif
+
+// ═══════════════════════════════════════════════════════════════════════════
+// PLAN
+// ═══════════════════════════════════════════════════════════════════════════
+
+void de100_thread_plan_make(De100ThreadPlan *plan,
+                            const De100CpuTopology *topology,
+                            const PlatformThreadPlacement *placement) {
+  plan->main_cpu = -1;
+  plan->worker_cpu_count = 0;
+
+  // One core can't separate anything; pinning would only add stalls
+  if (topology->core_count < 2) {
+    return;
+  }
+
+  if (placement->pin_main_thread) {
+    plan->main_cpu = topology->cpus[0];
+  }
+  if (!placement->pin_workers) {
+    return;
+  }
+
+  // Core 0 stays the frame thread's even when it isn't pinned: pass 0
+  // takes each other core's first hardware thread, pass 1 the second...
+  for (u32 pass = 0; plan->worker_cpu_count < topology->cpu_count; ++pass) {
+    bool found = false;
+    u32 thread_in_core = 0;
+    for (u32 i = 0; i < topology->cpu_count; ++i) {
+      thread_in_core = (i > 0 && topology->cpu_core[i] ==
+                                     topology->cpu_core[i - 1])
+                           ? thread_in_core + 1
+                           : 0;
+      if (topology->cpu_core[i] == 0 || thread_in_core != pass) {
+        continue;
+      }
+      plan->worker_cpus[plan->worker_cpu_count++] = topology->cpus[i];
+      found = true;
+    }
+    if (!found) {
+      break;
+    }
+  }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// AFFINITY + PRIORITY
+// ═══════════════════════════════════════════════════════════════════════════
+
+#if defined(__linux__)
+
+bool de100_thread_pin_self(u32 cpu) {
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+}
+
+De100ThreadPriorityLevel de100_thread_promote_audio(i32 priority) {
+  if (priority <= 0) {
+    priority = DE100_THREAD_AUDIO_DEFAULT_PRIORITY;
+  }
+  i32 policy = SCHED_FIFO;
+#ifdef SCHED_RESET_ON_FORK
+  // Children (the shell-outs of debug tools) must not inherit RT
+  policy |= SCHED_RESET_ON_FORK;
+#endif
+
+  // Unprivileged processes may still go RT up to RLIMIT_RTPRIO
+  struct rlimit limit;
+  if (getrlimit(RLIMIT_RTPRIO, &limit) == 0 &&
+      limit.rlim_cur != RLIM_INFINITY && limit.rlim_cur > 0 &&
+      (rlim_t)priority > limit.rlim_cur) {
+    priority = (i32)limit.rlim_cur;
+  }
+
+  struct sched_param param = {.sched_priority = priority};
+  if (pthread_setschedparam(pthread_self(), policy, &param) == 0) {
+    return DE100_THREAD_PRIORITY_REALTIME;
+  }
+
+  // nice is per-thread on Linux when addressed by tid
+  pid_t tid = (pid_t)syscall(SYS_gettid);
+  if (setpriority(PRIO_PROCESS, (id_t)tid, THREAD_PLACEMENT_AUDIO_NICE) ==
+      0) {
+    return DE100_THREAD_PRIORITY_ELEVATED;
+  }
+  return DE100_THREAD_PRIORITY_NORMAL;
+}
+
+void de100_thread_demote_audio(void) {}
+
+#elif defined(_WIN32)
+
+#if defined(_MSC_VER)
+de100_file_scoped_global_var __declspec(thread) HANDLE g_mmcss_task = NULL;
+#else
+de100_file_scoped_global_var _Thread_local HANDLE g_mmcss_task = NULL;
+#endif
+
+bool de100_thread_pin_self(u32 cpu) {
+  if (cpu >= 64) {
+    return false;
+  }
+  return SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)1 << cpu) != 0;
+}
+
+De100ThreadPriorityLevel de100_thread_promote_audio(i32 priority) {
+  (void)priority;
+  DWORD task_index = 0;
+  g_mmcss_task = AvSetMmThreadCharacteristicsW(L"Pro Audio", &task_index);
+  if (g_mmcss_task) {
+    AvSetMmThreadPriority(g_mmcss_task, AVRT_PRIORITY_HIGH);
+    return DE100_THREAD_PRIORITY_REALTIME;
+  }
+  if (SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_TIME_CRITICAL)) {
+    return DE100_THREAD_PRIORITY_ELEVATED;
+  }
+  return DE100_THREAD_PRIORITY_NORMAL;
+}
+
+void de100_thread_demote_audio(void) {
+  if (g_mmcss_task) {
+    AvRevertMmThreadCharacteristics(g_mmcss_task);
+    g_mmcss_task = NULL;
+  }
+}
+
+#elif defined(__APPLE__)
+
+// No thread affinity on macOS (thread_policy_set affinity tags are hints
+// between threads, not CPUs, and ignored on Apple silicon)
+bool de100_thread_pin_self(u32 cpu) {
+  (void)cpu;
+  return false;
+}
+
+De100ThreadPriorityLevel de100_thread_promote_audio(i32 priority) {
+  (void)priority;
+  if (pthread_set_qos_class_self_np(QOS_CLASS_USER_INTERACTIVE, 0) == 0) {
+    return DE100_THREAD_PRIORITY_ELEVATED;
+  }
+  return DE100_THREAD_PRIORITY_NORMAL;
+}
+
+void de100_thread_demote_audio(void) {}
+
+#else
+
+bool de100_thread_pin_self(u32 cpu) {
+  (void)cpu;
+  return false;
+}
+
+De100ThreadPriorityLevel de100_thread_promote_audio(i32 priority) {
+  (void)priority;
+  return DE100_THREAD_PRIORITY_NORMAL;
+}
+
+void de100_thread_demote_audio(void) {}
+
+#endif
+
+const char *de100_thread_priority_name(De100ThreadPriorityLevel level) {
+  switch (level) {
+  case DE100_THREAD_PRIORITY_REALTIME:
+    return "real-time";
+  case DE100_THREAD_PRIORITY_ELEVATED:
+    return "elevated";
+  default:
+    return "normal";
+  }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// CONFIG
+// ═══════════════════════════════════════════════════════════════════════════
+
+void de100_thread_placement_defaults(PlatformThreadPlacement *placement) {
+  placement->audio_realtime = true;
+  placement->audio_realtime_priority = DE100_THREAD_AUDIO_DEFAULT_PRIORITY;
+  placement->pin_main_thread = false;
+  placement->pin_workers = true;
+
+  const char *list = getenv("DE100_THREAD_PLACEMENT");
+  while (list && *list) {
+    const char *end = strchr(list, ',');
+    u64 length = end ? (u64)(end - list) : strlen(list);
+
+    if (length == 3 && strncmp(list, "off", 3) == 0) {
+      placement->audio_realtime = false;
+      placement->pin_main_thread = false;
+      placement->pin_workers = false;
+    } else if (length == 5 && strncmp(list, "audio", 5) == 0) {
+      placement->audio_realtime = true;
+    } else if (length == 7 && strncmp(list, "workers", 7) == 0) {
+      placement->pin_workers = true;
+    } else if (length == 4 && strncmp(list, "main", 4) == 0) {
+      placement->pin_main_thread = true;
+    } else if (length > 7 && strncmp(list, "rtprio=", 7) == 0) {
+      i32 priority = atoi(list + 7);
+      if (priority >= 1 && priority <= 99) {
+        placement->audio_realtime_priority = priority;
+      }
+    }
+
+    list = end ? end + 1 : NULL;
+  }
+}
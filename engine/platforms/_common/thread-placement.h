@@ -0,0 +1,123 @@
+#ifndef DE100_PLATFORMS__COMMON_THREAD_PLACEMENT_H
+#define DE100_PLATFORMS__COMMON_THREAD_PLACEMENT_H
+
+#include "../../_common/base.h"
+#include "./config.h"
+
+// ═══════════════════════════════════════════════════════════════════════════
+// THREAD PLACEMENT (priorities + CPU affinity)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// Two problems on a loaded machine:
+//
+//   Audio    A background service at the same priority preempts the
+//            audio thread for a few ms and the device underruns. The
+//            audio thread asks for real-time scheduling instead:
+//
+//              Linux    SCHED_FIFO (needs CAP_SYS_NICE or RLIMIT_RTPRIO,
+//                       e.g. @audio - rtprio 95 in limits.conf), else
+//                       nice -11 on the thread, else unchanged
+//              Windows  MMCSS "Pro Audio" task (avrt), else
+//                       THREAD_PRIORITY_TIME_CRITICAL
+//              macOS    QOS_CLASS_USER_INTERACTIVE
+//
+//   Workers  The scheduler is free to put a worker on the SMT sibling of
+//            the frame thread, where both run at roughly half speed.
+//            The plan keeps the first allowed physical core for the
+//            frame thread and puts each worker on its own remaining core
+//            (first hardware thread of each, then the second ones when
+//            there are more workers than cores).
+//
+// Only CPUs in the process's current affinity mask are used, so
+// `taskset` and the headless multi-instance runner keep working: with a
+// single allowed core nothing is pinned.
+//
+// Placement is advisory everywhere: every call reports what it got and
+// never fails the caller. macOS has no affinity API, so pinning is a
+// no-op there.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#ifndef DE100_THREAD_PLACEMENT_MAX_CPUS
+#define DE100_THREAD_PLACEMENT_MAX_CPUS 256
+#endif
+
+// Default SCHED_FIFO priority: above the usual desktop RT threads
+// (pipewire asks for 20 or more by default), below the kernel's
+// watchdog/migration threads at 99
+#define DE100_THREAD_AUDIO_DEFAULT_PRIORITY 70
+
+typedef enum {
+  DE100_THREAD_PRIORITY_NORMAL = 0, // Nothing changed
+  DE100_THREAD_PRIORITY_ELEVATED,   // Raised nice / time-critical / QoS
+  DE100_THREAD_PRIORITY_REALTIME,   // SCHED_FIFO / MMCSS
+} De100ThreadPriorityLevel;
+
+/**
+ * CPU topology restricted to the process's allowed CPUs.
+ *
+ * cpus[] lists every allowed logical CPU, grouped by physical core with
+ * each core's first hardware thread first.
+ */
+typedef struct {
+  u32 cpu_count;  // Allowed logical CPUs
+  u32 core_count; // Physical cores they belong to
+  u16 cpus[DE100_THREAD_PLACEMENT_MAX_CPUS];
+  u16 cpu_core[DE100_THREAD_PLACEMENT_MAX_CPUS]; // Core index of cpus[i]
+} De100CpuTopology;
+
+/**
+ * Where each thread goes. cpu -1 = leave it to the scheduler.
+ */
+typedef struct {
+  i32 main_cpu;
+  u32 worker_cpu_count; // 0 = workers unpinned
+  u16 worker_cpus[DE100_THREAD_PLACEMENT_MAX_CPUS];
+} De100ThreadPlan;
+
+/**
+ * Read the topology (sysfs on Linux, GetLogicalProcessorInformation on
+ * Windows). Without one every allowed CPU counts as its own core.
+ */
+void de100_cpu_topology_query(De100CpuTopology *topology);
+
+/**
+ * Build a plan from `placement`: main thread on the first core (if
+ * asked), workers on every other core's first hardware thread, then on
+ * their second ones. Needs at least two cores to pin anything.
+ */
+void de100_thread_plan_make(De100ThreadPlan *plan,
+                            const De100CpuTopology *topology,
+                            const PlatformThreadPlacement *placement);
+
+/**
+ * Pin the calling thread to one logical CPU.
+ */
+bool de100_thread_pin_self(u32 cpu);
+
+/**
+ * Raise the calling thread for audio. priority is the SCHED_FIFO level
+ * (0 = DE100_THREAD_AUDIO_DEFAULT_PRIORITY); other systems ignore it.
+ */
+De100ThreadPriorityLevel de100_thread_promote_audio(i32 priority);
+
+/** Undo platform state taken by de100_thread_promote_audio (MMCSS). */
+void de100_thread_demote_audio(void);
+
+const char *de100_thread_priority_name(De100ThreadPriorityLevel level);
+
+/**
+ * Defaults (real-time audio, pinned workers, unpinned main thread), then
+ * DE100_THREAD_PLACEMENT, a comma-separated list applied in order:
+ *
+ *   off          nothing
+ *   audio        real-time audio thread
+ *   workers      pin workers
+ *   main         pin the main thread too
+ *   rtprio=N     SCHED_FIFO priority for audio
+ *
+ *   DE100_THREAD_PLACEMENT=off,audio ./game   # RT audio, no pinning
+ */
+void de100_thread_placement_defaults(PlatformThreadPlacement *placement);
+
+#endif // DE100_PLATFORMS__COMMON_THREAD_PLACEMENT_H
@@ -0,0 +1,504 @@
+#include "./trace-export.h"
+#include "../../_common/file.h"
+#include "../../_common/memory.h"
+#include "../../_common/time.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if !defined(_WIN32)
+#include <netdb.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+// Only built with DE100_INTERNAL (see build-common.sh)
+#if DE100_INTERNAL
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ERROR MESSAGES
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_global_var const char *g_trace_export_error_messages[] = {
+    [TRACE_EXPORT_SUCCESS] = "Success",
+    [TRACE_EXPORT_ERROR_NULL_DESTINATION] = "NULL or empty destination",
+    [TRACE_EXPORT_ERROR_ALREADY_ACTIVE] = "A trace export is already running",
+    [TRACE_EXPORT_ERROR_OPEN_FAILED] = "Failed to open trace file",
+    [TRACE_EXPORT_ERROR_CONNECT_FAILED] = "Failed to connect trace socket",
+    [TRACE_EXPORT_ERROR_ALLOC_FAILED] = "Failed to allocate trace ring",
+    [TRACE_EXPORT_ERROR_THREAD_CREATE_FAILED] =
+        "Failed to create trace writer thread",
+};
+
+const char *trace_export_strerror(TraceExportErrorCode code) {
+  if (code >= 0 && code < TRACE_EXPORT_ERROR_COUNT) {
+    return g_trace_export_error_messages[code];
+  }
+  return "Unknown trace export error";
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// STATE
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define TRACE_RING_MASK (TRACE_EXPORT_RING_SIZE - 1)
+#define TRACE_WRITE_BUFFER_SIZE (64 * 1024)
+#define TRACE_WRITER_IDLE_NS (2 * 1000 * 1000)
+
+typedef enum {
+  TRACE_RECORD_SCOPE = 0,
+  TRACE_RECORD_INSTANT,
+  TRACE_RECORD_CALIBRATE, // start = cycles, end = wall clock (f64 bits)
+  TRACE_RECORD_COUNTER,   // block_id = counter, end = value (f64 bits)
+} TraceRecordType;
+
+typedef struct {
+  u64 start;
+  u64 end;
+  u32 block_id;
+  u16 thread_index;
+  u16 type; // TraceRecordType
+} TraceRecord;
+
+typedef struct {
+  const De100Profiler *profiler;
+  i32 fd;
+  bool is_socket;
+
+  // main thread → writer
+  De100MemoryBlock ring_block;
+  TraceRecord *ring;
+  u64 write_index;
+  u64 read_index;
+  u64 dropped_records;
+
+  // Registered on the main thread; count published with release so the
+  // writer sees each name before a record that uses it
+  const char *counter_names[TRACE_EXPORT_MAX_COUNTERS];
+  u32 counter_count;
+
+  pthread_t writer;
+  bool writer_started;
+  bool is_running; // __atomic
+
+  // Writer-only: cycles → microseconds since the first calibration
+  u64 base_cycles;
+  f64 base_seconds;
+  f64 cycles_per_us;
+  bool named_threads[DE100_PROFILER_MAX_THREADS];
+  bool wrote_event;
+
+  char buffer[TRACE_WRITE_BUFFER_SIZE];
+  u32 buffer_used;
+  bool write_failed;
+} TraceExport;
+
+de100_file_scoped_global_var TraceExport g_trace_export = {.fd = -1};
+
+// ═══════════════════════════════════════════════════════════════════════════
+// OUTPUT (writer thread)
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn void trace_flush(TraceExport *trace) {
+  if (trace->buffer_used == 0 || trace->write_failed) {
+    trace->buffer_used = 0;
+    return;
+  }
+  De100FileIOResult result =
+      de100_file_write_all(trace->fd, trace->buffer, trace->buffer_used);
+  if (!result.success) {
+    fprintf(stderr, "[TRACE] ⚠️  Write failed, stopping output: %s\n",
+            de100_file_strerror(result.error_code));
+    trace->write_failed = true;
+  }
+  trace->buffer_used = 0;
+}
+
+de100_file_scoped_fn void trace_append(TraceExport *trace, const char *text,
+                                       u32 length) {
+  if (trace->buffer_used + length > TRACE_WRITE_BUFFER_SIZE) {
+    trace_flush(trace);
+  }
+  if (length > TRACE_WRITE_BUFFER_SIZE) {
+    return;
+  }
+  memcpy(trace->buffer + trace->buffer_used, text, length);
+  trace->buffer_used += length;
+}
+
+/** Block names are identifiers/paths; escape just enough for JSON. */
+de100_file_scoped_fn void trace_escape(char *dest, size_t capacity,
+                                       const char *src) {
+  size_t out = 0;
+  for (; *src && out + 2 < capacity; ++src) {
+    char c = *src;
+    if (c == '"' || c == '\\') {
+      dest[out++] = '\\';
+    } else if ((u8)c < 0x20) {
+      c = ' ';
+    }
+    dest[out++] = c;
+  }
+  dest[out] = '\0';
+}
+
+de100_file_scoped_fn inline f64 trace_cycles_to_us(TraceExport *trace,
+                                                  u64 cycles) {
+  f64 delta = cycles >= trace->base_cycles
+                  ? (f64)(cycles - trace->base_cycles)
+                  : -(f64)(trace->base_cycles - cycles);
+  return delta / trace->cycles_per_us;
+}
+
+de100_file_scoped_fn void trace_write_record(TraceExport *trace,
+                                             const TraceRecord *record) {
+  char line[512];
+  i32 length = 0;
+  const char *separator = trace->wrote_event ? ",\n" : "";
+
+  if (record->type == TRACE_RECORD_CALIBRATE) {
+    f64 seconds;
+    memcpy(&seconds, &record->end, sizeof(seconds));
+    if (trace->base_cycles == 0) {
+      trace->base_cycles = record->start;
+      trace->base_seconds = seconds;
+    } else if (seconds > trace->base_seconds + 0.1 &&
+               record->start > trace->base_cycles) {
+      // Longer baseline, better estimate
+      trace->cycles_per_us = (f64)(record->start - trace->base_cycles) /
+                             ((seconds - trace->base_seconds) * 1e6);
+    }
+    return;
+  }
+
+  if (record->type == TRACE_RECORD_COUNTER) {
+    u32 counter_count =
+        __atomic_load_n(&trace->counter_count, __ATOMIC_ACQUIRE);
+    if (record->block_id >= counter_count) {
+      return;
+    }
+    f64 value;
+    memcpy(&value, &record->end, sizeof(value));
+    char name[128];
+    trace_escape(name, sizeof(name), trace->counter_names[record->block_id]);
+    length = snprintf(line, sizeof(line),
+                      "%s{\"name\":\"%s\",\"ph\":\"C\",\"ts\":%.3f,"
+                      "\"pid\":1,\"args\":{\"value\":%.3f}}",
+                      separator, name,
+                      trace_cycles_to_us(trace, record->start), value);
+    if (length > 0 && length < (i32)sizeof(line)) {
+      trace_append(trace, line, (u32)length);
+      trace->wrote_event = true;
+    }
+    return;
+  }
+
+  const De100Profiler *profiler = trace->profiler;
+  u32 block_count =
+      __atomic_load_n(&profiler->block_count, __ATOMIC_ACQUIRE);
+  if (record->block_id == 0 || record->block_id > block_count) {
+    return;
+  }
+  const De100ProfileBlockInfo *info = &profiler->blocks[record->block_id - 1];
+
+  u32 tid = record->thread_index;
+  if (tid < DE100_PROFILER_MAX_THREADS && !trace->named_threads[tid]) {
+    trace->named_threads[tid] = true;
+    length = snprintf(line, sizeof(line),
+                      "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,"
+                      "\"tid\":%u,\"args\":{\"name\":\"thread %u\"}}",
+                      separator, tid, tid);
+    trace_append(trace, line, (u32)length);
+    trace->wrote_event = true;
+    separator = ",\n";
+  }
+
+  char name[DE100_PROFILER_NAME_LENGTH * 2];
+  char file[DE100_PROFILER_FILE_LENGTH * 2];
+  trace_escape(name, sizeof(name), info->name);
+  trace_escape(file, sizeof(file), info->file);
+
+  f64 ts = trace_cycles_to_us(trace, record->start);
+  if (record->type == TRACE_RECORD_INSTANT) {
+    length = snprintf(line, sizeof(line),
+                      "%s{\"name\":\"%s\",\"cat\":\"de100\",\"ph\":\"i\","
+                      "\"s\":\"t\",\"ts\":%.3f,\"pid\":1,\"tid\":%u,"
+                      "\"args\":{\"site\":\"%s:%u\"}}",
+                      separator, name, ts, tid, file, info->line);
+  } else {
+    f64 dur = (f64)(record->end - record->start) / trace->cycles_per_us;
+    length = snprintf(line, sizeof(line),
+                      "%s{\"name\":\"%s\",\"cat\":\"de100\",\"ph\":\"X\","
+                      "\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u,"
+                      "\"args\":{\"site\":\"%s:%u\"}}",
+                      separator, name, ts, dur, tid, file, info->line);
+  }
+
+  if (length > 0) {
+    if (length >= (i32)sizeof(line)) {
+      length = (i32)sizeof(line) - 1; // Truncated (can't happen with limits)
+    }
+    trace_append(trace, line, (u32)length);
+    trace->wrote_event = true;
+  }
+}
+
+de100_file_scoped_fn void *trace_writer_proc(void *arg) {
+  TraceExport *trace = (TraceExport *)arg;
+
+  for (;;) {
+    bool running = __atomic_load_n(&trace->is_running, __ATOMIC_ACQUIRE);
+    u64 read = trace->read_index;
+    u64 write = __atomic_load_n(&trace->write_index, __ATOMIC_ACQUIRE);
+
+    if (read == write) {
+      trace_flush(trace);
+      if (!running) {
+        break; // Stopped and drained
+      }
+      struct timespec idle = {0, TRACE_WRITER_IDLE_NS};
+      nanosleep(&idle, NULL);
+      continue;
+    }
+
+    for (; read < write; ++read) {
+      trace_write_record(trace, &trace->ring[read & TRACE_RING_MASK]);
+    }
+    __atomic_store_n(&trace->read_index, read, __ATOMIC_RELEASE);
+  }
+
+  return NULL;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// DESTINATIONS
+// ═══════════════════════════════════════════════════════════════════════════
+
+/** "tcp:HOST:PORT" → connected socket, or -1. */
+de100_file_scoped_fn i32 trace_connect(const char *spec) {
+#if defined(_WIN32)
+  (void)spec;
+  return -1;
+#else
+  char host[256];
+  const char *colon = strrchr(spec, ':');
+  if (!colon || colon == spec || (size_t)(colon - spec) >= sizeof(host)) {
+    return -1;
+  }
+  memcpy(host, spec, (size_t)(colon - spec));
+  host[colon - spec] = '\0';
+
+  struct addrinfo hints = {0};
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+  struct addrinfo *addresses = NULL;
+  if (getaddrinfo(host, colon + 1, &hints, &addresses) != 0) {
+    return -1;
+  }
+
+  i32 fd = -1;
+  for (struct addrinfo *it = addresses; it && fd < 0; it = it->ai_next) {
+    fd = socket(it->ai_family, it->ai_socktype, it->ai_protocol);
+    if (fd >= 0 && connect(fd, it->ai_addr, it->ai_addrlen) != 0) {
+      close(fd);
+      fd = -1;
+    }
+  }
+  freeaddrinfo(addresses);
+  return fd;
+#endif
+}
+
+de100_file_scoped_fn void trace_close_fd(TraceExport *trace) {
+  if (trace->fd < 0) {
+    return;
+  }
+#if !defined(_WIN32)
+  if (trace->is_socket) {
+    close(trace->fd);
+    trace->fd = -1;
+    return;
+  }
+#endif
+  de100_file_close(trace->fd);
+  trace->fd = -1;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// PUBLIC API
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn void trace_push(TraceExport *trace,
+                                     const TraceRecord *record) {
+  u64 write = trace->write_index;
+  u64 read = __atomic_load_n(&trace->read_index, __ATOMIC_ACQUIRE);
+  if (write - read >= TRACE_EXPORT_RING_SIZE) {
+    trace->dropped_records++;
+    return;
+  }
+  trace->ring[write & TRACE_RING_MASK] = *record;
+  __atomic_store_n(&trace->write_index, write + 1, __ATOMIC_RELEASE);
+}
+
+de100_file_scoped_fn void trace_push_calibration(TraceExport *trace) {
+  f64 seconds = de100_get_wall_clock();
+  TraceRecord record = {0};
+  record.start = de100_profiler_cycles();
+  memcpy(&record.end, &seconds, sizeof(seconds));
+  record.type = TRACE_RECORD_CALIBRATE;
+  trace_push(trace, &record);
+}
+
+TraceExportResult trace_export_begin(const De100Profiler *profiler,
+                                     const char *destination) {
+  TraceExportResult result = {0};
+  TraceExport *trace = &g_trace_export;
+
+  if (!profiler || !destination || !destination[0]) {
+    result.error_code = TRACE_EXPORT_ERROR_NULL_DESTINATION;
+    return result;
+  }
+  if (trace->writer_started) {
+    result.error_code = TRACE_EXPORT_ERROR_ALREADY_ACTIVE;
+    return result;
+  }
+
+  *trace = (TraceExport){.fd = -1};
+  trace->profiler = profiler;
+
+  if (strncmp(destination, "tcp:", 4) == 0) {
+    trace->fd = trace_connect(destination + 4);
+    trace->is_socket = true;
+    if (trace->fd < 0) {
+      result.error_code = TRACE_EXPORT_ERROR_CONNECT_FAILED;
+      return result;
+    }
+  } else {
+    De100FileOpenResult open_result = de100_file_open(
+        destination, DE100_FILE_WRITE | DE100_FILE_CREATE | DE100_FILE_TRUNCATE);
+    if (!open_result.success) {
+      result.error_code = TRACE_EXPORT_ERROR_OPEN_FAILED;
+      return result;
+    }
+    trace->fd = open_result.fd;
+  }
+
+  trace->ring_block = de100_memory_alloc(
+      NULL, sizeof(TraceRecord) * TRACE_EXPORT_RING_SIZE,
+      De100_MEMORY_FLAG_RW_ZEROED);
+  if (!de100_memory_is_valid(trace->ring_block)) {
+    trace_close_fd(trace);
+    result.error_code = TRACE_EXPORT_ERROR_ALLOC_FAILED;
+    return result;
+  }
+  trace->ring = (TraceRecord *)trace->ring_block.base;
+
+  // Initial cycle rate; per-frame calibration records refine it
+  u64 cycles_start = de100_profiler_cycles();
+  f64 seconds_start = de100_get_wall_clock();
+  struct timespec wait = {0, 20 * 1000 * 1000};
+  nanosleep(&wait, NULL);
+  f64 seconds = de100_get_seconds_elapsed(seconds_start, de100_get_wall_clock());
+  u64 cycles = de100_profiler_cycles() - cycles_start;
+  trace->cycles_per_us = seconds > 0.0 ? (f64)cycles / (seconds * 1e6) : 1.0;
+  if (trace->cycles_per_us <= 0.0) {
+    trace->cycles_per_us = 1.0;
+  }
+
+  trace_append(trace, "[\n", 2);
+  trace_push_calibration(trace);
+
+  __atomic_store_n(&trace->is_running, true, __ATOMIC_RELEASE);
+  if (pthread_create(&trace->writer, NULL, trace_writer_proc, trace) != 0) {
+    __atomic_store_n(&trace->is_running, false, __ATOMIC_RELEASE);
+    de100_memory_free(&trace->ring_block);
+    trace_close_fd(trace);
+    result.error_code = TRACE_EXPORT_ERROR_THREAD_CREATE_FAILED;
+    return result;
+  }
+  trace->writer_started = true;
+
+  printf("[TRACE] 📡 Exporting to %s (%.0f cycles/us)\n", destination,
+         trace->cycles_per_us);
+  result.success = true;
+  result.error_code = TRACE_EXPORT_SUCCESS;
+  return result;
+}
+
+void trace_export_frame(const De100Profiler *profiler) {
+  TraceExport *trace = &g_trace_export;
+  if (!trace->writer_started || profiler != trace->profiler) {
+    return;
+  }
+
+  for (u32 i = 0; i < profiler->span_count; ++i) {
+    const De100ProfileSpan *span = &profiler->spans[i];
+    TraceRecord record;
+    record.start = span->start_cycles;
+    record.end = span->end_cycles;
+    record.block_id = span->block_id;
+    record.thread_index = span->thread_index;
+    record.type = span->type == DE100_PROFILE_EVENT_INSTANT
+                      ? TRACE_RECORD_INSTANT
+                      : TRACE_RECORD_SCOPE;
+    trace_push(trace, &record);
+  }
+
+  trace_push_calibration(trace);
+}
+
+void trace_export_counter(const char *name, f64 value) {
+  TraceExport *trace = &g_trace_export;
+  if (!trace->writer_started || !name) {
+    return;
+  }
+
+  u32 index = 0;
+  while (index < trace->counter_count &&
+         trace->counter_names[index] != name) {
+    ++index;
+  }
+  if (index == trace->counter_count) {
+    if (index >= TRACE_EXPORT_MAX_COUNTERS) {
+      return;
+    }
+    trace->counter_names[index] = name;
+    __atomic_store_n(&trace->counter_count, index + 1, __ATOMIC_RELEASE);
+  }
+
+  TraceRecord record = {0};
+  record.start = de100_profiler_cycles();
+  memcpy(&record.end, &value, sizeof(value));
+  record.block_id = index;
+  record.type = TRACE_RECORD_COUNTER;
+  trace_push(trace, &record);
+}
+
+void trace_export_end(void) {
+  TraceExport *trace = &g_trace_export;
+  if (!trace->writer_started) {
+    return;
+  }
+
+  __atomic_store_n(&trace->is_running, false, __ATOMIC_RELEASE);
+  pthread_join(trace->writer, NULL);
+  trace->writer_started = false;
+
+  // Writer is gone; finish the array on this thread
+  trace_append(trace, "\n]\n", 3);
+  trace_flush(trace);
+  trace_close_fd(trace);
+  de100_memory_free(&trace->ring_block);
+
+  printf("[TRACE] ✅ Export closed (%lu records dropped, %lu spans over "
+         "the per-frame limit)\n",
+         (unsigned long)trace->dropped_records,
+         (unsigned long)trace->profiler->dropped_span_count);
+}
+
+bool trace_export_is_active(void) { return g_trace_export.writer_started; }
+
+#endif // DE100_INTERNAL
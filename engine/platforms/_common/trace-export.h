@@ -0,0 +1,81 @@
+#ifndef DE100_PLATFORMS__COMMON_TRACE_EXPORT_H
+#define DE100_PLATFORMS__COMMON_TRACE_EXPORT_H
+
+#include "../../_common/base.h"
+#include "../../_common/profiler.h"
+#include <stdbool.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// TRACE EXPORT (internal builds)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// Streams the profiler's spans as Chrome trace-event JSON (opens in
+// Perfetto / chrome://tracing): frame phases, game DE100_TIMED_BLOCKs,
+// DE100_PROFILE_INSTANT markers (hot reloads, audio underruns), and
+// counter tracks (memory telemetry, see memory-stats.h).
+//
+//   game threads ──ring──▶ profiler end_frame ──ring──▶ writer thread ──▶ fd
+//
+// Both hops are lock-free single-producer/single-consumer rings; the writer
+// formats and writes in the background so capture costs the frame a copy
+// of its spans. If the writer falls behind, records are dropped (counted)
+// rather than stalling the game.
+//
+// The file is streamed in the JSON array format ("[ {...}, {...}"), which
+// trace viewers accept even when a crash cuts it short; a clean stop adds
+// the closing "]".
+//
+// Destination (DE100_TRACE environment variable at engine_init):
+//   path/to/trace.json   File (truncated)
+//   tcp:HOST:PORT        Stream to a socket, e.g. a collector
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define TRACE_EXPORT_RING_SIZE (1u << 16) // Records, power of two
+#define TRACE_EXPORT_MAX_COUNTERS 32      // Distinct counter names
+
+typedef enum {
+  TRACE_EXPORT_SUCCESS = 0,
+  TRACE_EXPORT_ERROR_NULL_DESTINATION,
+  TRACE_EXPORT_ERROR_ALREADY_ACTIVE,
+  TRACE_EXPORT_ERROR_OPEN_FAILED,
+  TRACE_EXPORT_ERROR_CONNECT_FAILED,
+  TRACE_EXPORT_ERROR_ALLOC_FAILED,
+  TRACE_EXPORT_ERROR_THREAD_CREATE_FAILED,
+
+  TRACE_EXPORT_ERROR_COUNT
+} TraceExportErrorCode;
+
+typedef struct {
+  bool success;
+  TraceExportErrorCode error_code;
+} TraceExportResult;
+
+/**
+ * Open `destination` and start the writer thread. Calibrates the cycle
+ * counter against the wall clock (~20ms).
+ */
+TraceExportResult trace_export_begin(const De100Profiler *profiler,
+                                     const char *destination);
+
+/**
+ * Queue the profiler's last frame. Call on the main thread right after
+ * de100_profiler_end_frame(). No-op when not exporting.
+ */
+void trace_export_frame(const De100Profiler *profiler);
+
+/**
+ * Queue a counter sample, drawn as a graph track named `name`. Main
+ * thread. `name` must outlive the export (a string literal); names past
+ * TRACE_EXPORT_MAX_COUNTERS are ignored. No-op when not exporting.
+ */
+void trace_export_counter(const char *name, f64 value);
+
+/** Drain what's queued, close the stream and join the writer. */
+void trace_export_end(void);
+
+bool trace_export_is_active(void);
+
+const char *trace_export_strerror(TraceExportErrorCode code);
+
+#endif // DE100_PLATFORMS__COMMON_TRACE_EXPORT_H
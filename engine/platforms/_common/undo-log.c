@@ -0,0 +1,279 @@
+#include "./undo-log.h"
+
+#include <string.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// INTERNAL HELPERS
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define UNDO_LOG_ZERO_PAGE 1u // Entry has no bytes: the page was zero
+
+typedef struct {
+  u32 page;
+  u32 flags;
+} UndoLogEntry;
+
+de100_file_scoped_fn inline UndoLogRecord *undo_log_record(const UndoLog *log,
+                                                           u32 frame) {
+  return &log->records[frame & (log->record_count - 1)];
+}
+
+de100_file_scoped_fn inline u64 log_entry_capacity(const UndoLog *log) {
+  return sizeof(UndoLogEntry) + log->tracker->page_size;
+}
+
+/** Where an entry starting at `head` goes: entries never wrap. */
+de100_file_scoped_fn inline u64 log_align(const UndoLog *log, u64 head) {
+  u64 position = head % log->log.size;
+  if (log->log.size - position < log_entry_capacity(log)) {
+    head += log->log.size - position;
+  }
+  return head;
+}
+
+de100_file_scoped_fn void log_append(UndoLog *log, u32 page, const u8 *bytes,
+                                     u64 length) {
+  u64 head = log_align(log, log->log_head);
+  u8 *at = (u8 *)log->log.base + head % log->log.size;
+  UndoLogEntry entry = {.page = page, .flags = bytes ? 0 : UNDO_LOG_ZERO_PAGE};
+  memcpy(at, &entry, sizeof(entry));
+  head += sizeof(entry);
+  if (bytes) {
+    u64 page_size = log->tracker->page_size;
+    memcpy(at + sizeof(entry), bytes, (size_t)length);
+    memset(at + sizeof(entry) + length, 0, (size_t)(page_size - length));
+    head += page_size;
+  }
+  log->log_head = head;
+  // A rollback moves the head back, but what this wrote stays overwritten
+  if (head > log->log.size && head - log->log.size > log->log_floor) {
+    log->log_floor = head - log->log.size;
+  }
+}
+
+de100_file_scoped_fn inline u64 page_length(const UndoLog *log, u64 page,
+                                            u64 extent) {
+  u64 offset = page * log->tracker->page_size;
+  u64 remaining = extent - offset;
+  return remaining < log->tracker->page_size ? remaining
+                                             : log->tracker->page_size;
+}
+
+de100_file_scoped_fn inline bool is_tracked(const UndoLog *log) {
+  const ReplaySnapshotTracker *tracker = log->tracker;
+  return tracker->mode != REPLAY_SNAPSHOT_MODE_FULL && tracker->is_armed &&
+         tracker->synced_buffer == &log->base;
+}
+
+/**
+ * Bring the base buffer to game memory. With page tracking the tracker
+ * copies what was dirtied (the first time, everything) and re-arms.
+ */
+de100_file_scoped_fn bool sync_base(UndoLog *log, u64 extent) {
+  ReplaySnapshotTracker *tracker = log->tracker;
+  if (tracker->mode == REPLAY_SNAPSHOT_MODE_FULL) {
+    log->base.snapshot_size = extent; // Copied page by page already
+    return true;
+  }
+  ReplayBufferResult result = replay_buffer_save_tracked(&log->base, tracker);
+  replay_snapshot_tracker_wait(tracker);
+  return result.success;
+}
+
+de100_file_scoped_fn inline bool record_intact(const UndoLog *log,
+                                               u32 frame) {
+  const UndoLogRecord *record = undo_log_record(log, frame);
+  return record->frame == frame && record->start >= log->log_floor;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// PUBLIC API
+// ═══════════════════════════════════════════════════════════════════════════
+
+u64 undo_log_min_size(const ReplaySnapshotTracker *tracker) {
+  return 2 * (sizeof(UndoLogEntry) + tracker->page_size);
+}
+
+UndoLogErrorCode undo_log_init(UndoLog *log, ReplaySnapshotTracker *tracker,
+                               u64 log_size, u32 record_count) {
+  *log = (UndoLog){0};
+  log->tracker = tracker;
+  log->base_memory = de100_memory_alloc(NULL, (size_t)tracker->capacity,
+                                        De100_MEMORY_FLAG_RW_ZEROED);
+  log->log =
+      de100_memory_alloc(NULL, (size_t)log_size, De100_MEMORY_FLAG_RW_ZEROED);
+  log->record_memory =
+      de100_memory_alloc(NULL, (size_t)record_count * sizeof(UndoLogRecord),
+                         De100_MEMORY_FLAG_RW_ZEROED);
+  if (!de100_memory_is_valid(log->base_memory) ||
+      !de100_memory_is_valid(log->log) ||
+      !de100_memory_is_valid(log->record_memory)) {
+    undo_log_free(log);
+    return UNDO_LOG_ERROR_OUT_OF_MEMORY;
+  }
+  log->base.file_fd = -1;
+  log->base.memory_block = log->base_memory.base;
+  log->base.mapped_size = log->base_memory.size;
+  log->base.is_valid = true;
+  log->records = (UndoLogRecord *)log->record_memory.base;
+  log->record_count = record_count;
+  return UNDO_LOG_SUCCESS;
+}
+
+void undo_log_free(UndoLog *log) {
+  ReplaySnapshotTracker *tracker = log->tracker;
+  if (tracker && tracker->synced_buffer == &log->base) {
+    // Nothing may point at the base buffer once it's gone
+    replay_snapshot_tracker_invalidate(tracker);
+  }
+  if (de100_memory_is_valid(log->base_memory)) {
+    de100_memory_free(&log->base_memory);
+  }
+  if (de100_memory_is_valid(log->log)) {
+    de100_memory_free(&log->log);
+  }
+  if (de100_memory_is_valid(log->record_memory)) {
+    de100_memory_free(&log->record_memory);
+  }
+  log->base = (ReplayBuffer){0};
+  log->records = NULL;
+}
+
+UndoLogErrorCode undo_log_begin(UndoLog *log, u32 frame) {
+  ReplaySnapshotTracker *tracker = log->tracker;
+  u64 extent = replay_snapshot_tracker_extent(tracker);
+  if (tracker->mode == REPLAY_SNAPSHOT_MODE_FULL) {
+    memcpy(log->base.memory_block, tracker->base, (size_t)extent);
+  }
+  log->base_frame = frame;
+  log->log_head = 0;
+  log->log_floor = 0;
+  for (u32 i = 0; i < log->record_count; ++i) {
+    log->records[i].frame = UNDO_LOG_NO_FRAME;
+  }
+  return sync_base(log, extent) ? UNDO_LOG_SUCCESS
+                                : UNDO_LOG_ERROR_SYNC_FAILED;
+}
+
+UndoLogErrorCode undo_log_save(UndoLog *log, u32 frame) {
+  if (frame == log->base_frame) {
+    return UNDO_LOG_SUCCESS;
+  }
+
+  ReplaySnapshotTracker *tracker = log->tracker;
+  u64 extent = replay_snapshot_tracker_extent(tracker);
+  u64 old_size = log->base.snapshot_size;
+  u64 page_size = tracker->page_size;
+  u64 page_count = (extent + page_size - 1) / page_size;
+  u8 *base = (u8 *)log->base.memory_block;
+  const u8 *live = tracker->base;
+  bool tracked = is_tracked(log);
+  const u8 *dirty = tracked ? (const u8 *)tracker->dirty_pages.base : NULL;
+
+  UndoLogRecord *record = undo_log_record(log, log->base_frame);
+  record->frame = log->base_frame;
+  record->start = log->log_head;
+  u64 pages_logged = 0;
+
+  for (u64 page = 0; page < page_count; ++page) {
+    u64 offset = page * page_size;
+    u64 length = page_length(log, page, extent);
+
+    if (offset >= old_size) {
+      // Committed since the last boundary: it was zero before
+      log_append(log, (u32)page, NULL, 0);
+      if (!tracked) {
+        memcpy(base + offset, live + offset, (size_t)length);
+      }
+      ++pages_logged;
+      continue;
+    }
+
+    if (dirty) {
+      if (!__atomic_load_n(&dirty[page], __ATOMIC_RELAXED)) {
+        continue;
+      }
+    } else if (memcmp(live + offset, base + offset, (size_t)length) == 0) {
+      continue;
+    }
+
+    u64 old_length = old_size - offset < length ? old_size - offset : length;
+    log_append(log, (u32)page, base + offset, old_length);
+    if (!tracked) {
+      memcpy(base + offset, live + offset, (size_t)length);
+    }
+    ++pages_logged;
+  }
+
+  record->end = log->log_head;
+  log->pages_logged_last = pages_logged;
+  log->base_frame = frame;
+  return sync_base(log, extent) ? UNDO_LOG_SUCCESS
+                                : UNDO_LOG_ERROR_SYNC_FAILED;
+}
+
+bool undo_log_can_rollback(const UndoLog *log, u32 frame) {
+  if (log->base_frame - frame > log->record_count) {
+    return false; // Also catches frame > base_frame
+  }
+  for (u32 f = frame; f < log->base_frame; ++f) {
+    if (!record_intact(log, f)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+UndoLogErrorCode undo_log_rollback(UndoLog *log, u32 frame) {
+  if (frame >= log->base_frame) {
+    return UNDO_LOG_SUCCESS;
+  }
+  if (!undo_log_can_rollback(log, frame)) {
+    return UNDO_LOG_ERROR_TOO_FAR;
+  }
+
+  ReplaySnapshotTracker *tracker = log->tracker;
+  u64 extent = replay_snapshot_tracker_extent(tracker);
+  u64 page_size = tracker->page_size;
+  u8 *live = tracker->base;
+  u8 *base = (u8 *)log->base.memory_block;
+  bool tracked = is_tracked(log);
+
+  // Newest first, so each page ends up with its oldest logged contents
+  for (u32 f = log->base_frame; f-- > frame;) {
+    UndoLogRecord *record = undo_log_record(log, f);
+    u64 head = record->start;
+    while (head < record->end) {
+      head = log_align(log, head);
+      const u8 *at = (const u8 *)log->log.base + head % log->log.size;
+      UndoLogEntry entry;
+      memcpy(&entry, at, sizeof(entry));
+      head += sizeof(entry);
+      bool is_zero = (entry.flags & UNDO_LOG_ZERO_PAGE) != 0;
+      if (!is_zero) {
+        head += page_size;
+      }
+
+      u64 offset = (u64)entry.page * page_size;
+      if (offset >= extent) {
+        continue; // Released since
+      }
+      u64 length = page_length(log, entry.page, extent);
+      if (is_zero) {
+        memset(live + offset, 0, (size_t)length);
+      } else {
+        memcpy(live + offset, at + sizeof(entry), (size_t)length);
+      }
+      if (!tracked) {
+        memcpy(base + offset, live + offset, (size_t)length);
+      }
+    }
+    record->frame = UNDO_LOG_NO_FRAME;
+  }
+
+  // Everything logged from `frame` on is gone: reuse its space
+  log->log_head = undo_log_record(log, frame)->start;
+  log->base_frame = frame;
+  return sync_base(log, extent) ? UNDO_LOG_SUCCESS
+                                : UNDO_LOG_ERROR_SYNC_FAILED;
+}
@@ -0,0 +1,104 @@
+#ifndef DE100_PLATFORMS__COMMON_UNDO_LOG_H
+#define DE100_PLATFORMS__COMMON_UNDO_LOG_H
+
+#include "../../_common/base.h"
+#include "../../_common/memory.h"
+#include "./replay-buffer.h"
+#include <stdbool.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// UNDO LOG (per-frame game memory history, shared by netplay and rewind)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// No full copy per frame. Game memory stays in sync with one base buffer
+// through the replay snapshot tracker (replay-buffer.h). At each frame
+// boundary the pages dirtied during the frame are logged with their old
+// contents (read from the base buffer), then the base buffer takes the
+// new ones. Rolling back applies the logged pages newest first:
+//
+//   boundary f+1:  for each dirty page p: log[f] += (p, base[p])
+//                  save_tracked(base)          copies the dirty pages
+//   rollback to m: apply log[n-1] .. log[m] to game memory
+//                  save_tracked(base)          base = state before m
+//
+// The log is a byte ring; a frame whose pages were overwritten (or whose
+// record slot was reused, record_count frames later) can't be rolled back
+// to. With FULL snapshots (no page tracking) changed pages are found by
+// comparing against the base buffer instead, which reads the whole range
+// per frame.
+//
+// One log per tracker at a time: another user syncing the tracker to its
+// own buffer (a replay slot save, a second log) costs this one a compare
+// of the whole range at its next boundary, and vice versa.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define UNDO_LOG_NO_FRAME 0xFFFFFFFFu
+
+typedef enum {
+  UNDO_LOG_SUCCESS = 0,
+  UNDO_LOG_ERROR_OUT_OF_MEMORY,
+  UNDO_LOG_ERROR_SYNC_FAILED, // Base buffer save through the tracker
+  UNDO_LOG_ERROR_TOO_FAR,     // Target frame no longer in the log
+} UndoLogErrorCode;
+
+typedef struct {
+  u64 start; // log_head when the record began
+  u64 end;
+  u32 frame;
+} UndoLogRecord;
+
+typedef struct {
+  ReplaySnapshotTracker *tracker; // Range, dirty pages
+  De100MemoryBlock base_memory;
+  ReplayBuffer base; // State before base_frame (base_memory, no file)
+  u32 base_frame;
+
+  De100MemoryBlock log; // Ring of [u32 page][u32 flags][page bytes]
+  u64 log_head;         // Bytes ever written (position = head % size)
+  u64 log_floor;        // Below it was overwritten (rollback keeps it)
+
+  De100MemoryBlock record_memory;
+  UndoLogRecord *records; // Undo of frame f at f & (record_count - 1)
+  u32 record_count;       // Power of two
+
+  u64 pages_logged_last; // By the last boundary
+} UndoLog;
+
+/** Smallest log_size undo_log_init accepts for `tracker`: two pages. */
+u64 undo_log_min_size(const ReplaySnapshotTracker *tracker);
+
+/**
+ * Allocate the base buffer (the tracker's capacity), the `log_size` byte
+ * ring and `record_count` (a power of two) frame records.
+ */
+UndoLogErrorCode undo_log_init(UndoLog *log, ReplaySnapshotTracker *tracker,
+                               u64 log_size, u32 record_count);
+
+/** Free everything; forgets the tracker's sync if it's ours. Idempotent. */
+void undo_log_free(UndoLog *log);
+
+/** Game memory now holds the state before `frame`: start the history. */
+UndoLogErrorCode undo_log_begin(UndoLog *log, u32 frame);
+
+/**
+ * Frame boundary: game memory now holds the state before `frame`. Logs
+ * the old contents of every page changed since the last boundary.
+ */
+UndoLogErrorCode undo_log_save(UndoLog *log, u32 frame);
+
+/** True if undo_log_rollback(log, frame) would succeed. */
+bool undo_log_can_rollback(const UndoLog *log, u32 frame);
+
+/**
+ * Game memory (and the base buffer) back to the state before `frame`.
+ * Everything logged from `frame` on is dropped. Call undo_log_save for
+ * the current frame first.
+ */
+UndoLogErrorCode undo_log_rollback(UndoLog *log, u32 frame);
+
+static inline bool undo_log_is_valid(const UndoLog *log) {
+  return log && log->records != NULL;
+}
+
+#endif // DE100_PLATFORMS__COMMON_UNDO_LOG_H
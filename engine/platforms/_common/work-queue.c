@@ -0,0 +1,391 @@
+#include "./work-queue.h"
+#include "./thread-placement.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ERROR MESSAGES
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_global_var const char *g_work_queue_error_messages[] = {
+    [WORK_QUEUE_SUCCESS] = "Success",
+    [WORK_QUEUE_ERROR_NULL_QUEUE] = "NULL work queue pointer",
+    [WORK_QUEUE_ERROR_SYNC_INIT_FAILED] =
+        "Failed to initialize mutex or condition variable",
+    [WORK_QUEUE_ERROR_SCRATCH_ALLOC_FAILED] =
+        "Failed to allocate per-thread scratch arena",
+    [WORK_QUEUE_ERROR_THREAD_CREATE_FAILED] = "Failed to create worker thread",
+};
+
+const char *work_queue_strerror(WorkQueueErrorCode code) {
+  if (code >= 0 && code < WORK_QUEUE_ERROR_COUNT) {
+    return g_work_queue_error_messages[code];
+  }
+  return "Unknown work queue error";
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// INTERNAL HELPERS
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define DEQUE_MASK (DE100_WORK_QUEUE_DEQUE_CAPACITY - 1)
+
+u32 work_queue_get_core_count(void) {
+#if defined(_WIN32)
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  return info.dwNumberOfProcessors > 0 ? (u32)info.dwNumberOfProcessors : 1;
+#else
+  long count = sysconf(_SC_NPROCESSORS_ONLN);
+  return count > 0 ? (u32)count : 1;
+#endif
+}
+
+de100_file_scoped_fn bool deque_push(De100WorkDeque *deque,
+                                     De100WorkQueueEntry entry) {
+  bool pushed = false;
+  pthread_mutex_lock(&deque->lock);
+  if (deque->tail - deque->head < DE100_WORK_QUEUE_DEQUE_CAPACITY) {
+    deque->entries[deque->tail & DEQUE_MASK] = entry;
+    __atomic_store_n(&deque->tail, deque->tail + 1, __ATOMIC_RELAXED);
+    pushed = true;
+  }
+  pthread_mutex_unlock(&deque->lock);
+  return pushed;
+}
+
+// Owner end: newest entry first (still warm in cache)
+de100_file_scoped_fn bool deque_pop(De100WorkDeque *deque,
+                                    De100WorkQueueEntry *out_entry) {
+  bool popped = false;
+  pthread_mutex_lock(&deque->lock);
+  if (deque->tail != deque->head) {
+    __atomic_store_n(&deque->tail, deque->tail - 1, __ATOMIC_RELAXED);
+    *out_entry = deque->entries[deque->tail & DEQUE_MASK];
+    popped = true;
+  }
+  pthread_mutex_unlock(&deque->lock);
+  return popped;
+}
+
+// Thief end: oldest entry first
+de100_file_scoped_fn bool deque_steal(De100WorkDeque *deque,
+                                      De100WorkQueueEntry *out_entry) {
+  // Cheap unlocked peek so idle thieves don't hammer empty deques' mutexes
+  if (__atomic_load_n(&deque->tail, __ATOMIC_RELAXED) ==
+      __atomic_load_n(&deque->head, __ATOMIC_RELAXED)) {
+    return false;
+  }
+
+  bool stolen = false;
+  pthread_mutex_lock(&deque->lock);
+  if (deque->tail != deque->head) {
+    *out_entry = deque->entries[deque->head & DEQUE_MASK];
+    __atomic_store_n(&deque->head, deque->head + 1, __ATOMIC_RELAXED);
+    stolen = true;
+  }
+  pthread_mutex_unlock(&deque->lock);
+  return stolen;
+}
+
+/**
+ * Run one entry if any is available: own deque first, then steal.
+ * Returns true if an entry was executed.
+ */
+de100_file_scoped_fn bool work_queue_do_next_entry(De100WorkQueue *queue,
+                                                   u32 self_index) {
+  De100WorkQueueEntry entry;
+  bool found = deque_pop(&queue->deques[self_index], &entry);
+
+  // Workers may start while later slots are still being published by init
+  u32 thread_count = __atomic_load_n(&queue->thread_count, __ATOMIC_ACQUIRE);
+  for (u32 offset = 1; !found && offset < thread_count; ++offset) {
+    u32 victim = (self_index + offset) % thread_count;
+    found = deque_steal(&queue->deques[victim], &entry);
+  }
+
+  if (!found) {
+    return false;
+  }
+
+  __atomic_sub_fetch(&queue->pending_count, 1, __ATOMIC_ACQ_REL);
+
+  De100WorkQueueThread *self = &queue->threads[self_index];
+  De100TemporaryMemory scratch = de100_arena_begin_temp(&self->scratch_arena);
+  entry.callback(&self->context, entry.data);
+  de100_arena_end_temp(scratch);
+
+  __atomic_add_fetch(&queue->completion_count, 1, __ATOMIC_RELEASE);
+  return true;
+}
+
+de100_file_scoped_fn void *work_queue_thread_proc(void *param) {
+  De100WorkQueueThread *self = (De100WorkQueueThread *)param;
+  De100WorkQueue *queue = self->queue;
+  u32 self_index = (u32)self->context.thread_index;
+
+  if (self->pinned_cpu >= 0) {
+    de100_thread_pin_self((u32)self->pinned_cpu);
+  }
+
+  while (__atomic_load_n(&queue->is_running, __ATOMIC_ACQUIRE)) {
+    if (!work_queue_do_next_entry(queue, self_index)) {
+      pthread_mutex_lock(&queue->sleep_lock);
+      while (__atomic_load_n(&queue->is_running, __ATOMIC_ACQUIRE) &&
+             __atomic_load_n(&queue->pending_count, __ATOMIC_ACQUIRE) == 0) {
+        pthread_cond_wait(&queue->wake_condition, &queue->sleep_lock);
+      }
+      pthread_mutex_unlock(&queue->sleep_lock);
+    }
+  }
+
+  return NULL;
+}
+
+de100_file_scoped_fn bool work_queue_init_thread_slot(De100WorkQueue *queue,
+                                                      u32 index) {
+  De100WorkQueueThread *slot = &queue->threads[index];
+  slot->queue = queue;
+  slot->context.thread_index = (i32)index;
+  slot->context.scratch_arena = &slot->scratch_arena;
+  slot->pinned_cpu =
+      (index > 0 && queue->worker_cpu_count > 0)
+          ? (i32)queue->worker_cpus[(index - 1) % queue->worker_cpu_count]
+          : -1;
+
+  slot->scratch_block = de100_memory_alloc(NULL, DE100_WORK_QUEUE_SCRATCH_SIZE,
+                                           De100_MEMORY_FLAG_RW);
+  if (!de100_memory_is_valid(slot->scratch_block)) {
+    return false;
+  }
+  de100_arena_init(&slot->scratch_arena, slot->scratch_block.size,
+                   slot->scratch_block.base);
+
+  if (pthread_mutex_init(&queue->deques[index].lock, NULL) != 0) {
+    de100_memory_free(&slot->scratch_block);
+    return false;
+  }
+  queue->deques[index].head = 0;
+  queue->deques[index].tail = 0;
+  return true;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// PUBLIC API
+// ═══════════════════════════════════════════════════════════════════════════
+
+WorkQueueInitResult work_queue_init(De100WorkQueue *queue, u32 worker_count) {
+  WorkQueueInitResult result = {0};
+
+  if (!queue) {
+    result.error_code = WORK_QUEUE_ERROR_NULL_QUEUE;
+    return result;
+  }
+
+  if (worker_count == 0) {
+    u32 cores = work_queue_get_core_count();
+    worker_count = cores > 1 ? cores - 1 : 0;
+  }
+  if (worker_count > DE100_WORK_QUEUE_MAX_WORKERS) {
+    worker_count = DE100_WORK_QUEUE_MAX_WORKERS;
+  }
+
+  if (pthread_mutex_init(&queue->sleep_lock, NULL) != 0 ||
+      pthread_cond_init(&queue->wake_condition, NULL) != 0) {
+    result.error_code = WORK_QUEUE_ERROR_SYNC_INIT_FAILED;
+    return result;
+  }
+
+  // ─────────────────────────────────────────────────────────────────────
+  // Slot 0 = main thread (it participates in complete_all_work)
+  // ─────────────────────────────────────────────────────────────────────
+
+  if (!work_queue_init_thread_slot(queue, 0)) {
+    pthread_cond_destroy(&queue->wake_condition);
+    pthread_mutex_destroy(&queue->sleep_lock);
+    result.error_code = WORK_QUEUE_ERROR_SCRATCH_ALLOC_FAILED;
+    return result;
+  }
+
+  queue->thread_count = 1;
+  queue->next_submit_index = 0;
+  queue->completion_goal = 0;
+  queue->completion_count = 0;
+  queue->pending_count = 0;
+  queue->is_running = true;
+  queue->is_initialized = true;
+  result.success = true;
+
+  // ─────────────────────────────────────────────────────────────────────
+  // Workers
+  // ─────────────────────────────────────────────────────────────────────
+
+  for (u32 i = 1; i <= worker_count; ++i) {
+    if (!work_queue_init_thread_slot(queue, i)) {
+      result.error_code = WORK_QUEUE_ERROR_SCRATCH_ALLOC_FAILED;
+      break;
+    }
+
+    // Publish the slot before the thread can steal from it
+    __atomic_store_n(&queue->thread_count, i + 1, __ATOMIC_RELEASE);
+
+    De100WorkQueueThread *slot = &queue->threads[i];
+    if (pthread_create(&slot->thread, NULL, work_queue_thread_proc, slot) !=
+        0) {
+      __atomic_store_n(&queue->thread_count, i, __ATOMIC_RELEASE);
+      pthread_mutex_destroy(&queue->deques[i].lock);
+      de100_memory_free(&slot->scratch_block);
+      result.error_code = WORK_QUEUE_ERROR_THREAD_CREATE_FAILED;
+      break;
+    }
+    slot->thread_started = true;
+  }
+
+  result.worker_count = queue->thread_count - 1;
+  return result;
+}
+
+void work_queue_set_worker_cpus(De100WorkQueue *queue, const u16 *cpus,
+                                u32 count) {
+  if (count > DE100_WORK_QUEUE_MAX_WORKERS) {
+    count = DE100_WORK_QUEUE_MAX_WORKERS;
+  }
+  for (u32 i = 0; i < count; ++i) {
+    queue->worker_cpus[i] = cpus[i];
+  }
+  queue->worker_cpu_count = count;
+}
+
+void work_queue_shutdown(De100WorkQueue *queue) {
+  if (!queue || !queue->is_initialized) {
+    return;
+  }
+
+  work_queue_complete_all_work(queue);
+
+  pthread_mutex_lock(&queue->sleep_lock);
+  __atomic_store_n(&queue->is_running, false, __ATOMIC_RELEASE);
+  pthread_cond_broadcast(&queue->wake_condition);
+  pthread_mutex_unlock(&queue->sleep_lock);
+
+  for (u32 i = 0; i < queue->thread_count; ++i) {
+    De100WorkQueueThread *slot = &queue->threads[i];
+    if (slot->thread_started) {
+      pthread_join(slot->thread, NULL);
+      slot->thread_started = false;
+    }
+    pthread_mutex_destroy(&queue->deques[i].lock);
+    if (de100_memory_is_valid(slot->scratch_block)) {
+      de100_memory_free(&slot->scratch_block);
+    }
+  }
+
+  pthread_cond_destroy(&queue->wake_condition);
+  pthread_mutex_destroy(&queue->sleep_lock);
+
+  queue->thread_count = 0;
+  queue->is_initialized = false;
+}
+
+ThreadContext *work_queue_main_thread_context(De100WorkQueue *queue) {
+  if (!queue || !queue->is_initialized) {
+    return NULL;
+  }
+  return &queue->threads[0].context;
+}
+
+DE100_PLATFORM_ADD_WORK_ENTRY(work_queue_add_entry) {
+  if (!queue || !queue->is_initialized || !callback) {
+    return false;
+  }
+
+  De100WorkQueueEntry entry = {.callback = callback, .data = data};
+
+  // Count the entry as outstanding BEFORE it becomes stealable, so
+  // complete_all_work can never observe count == goal mid-push.
+  __atomic_add_fetch(&queue->completion_goal, 1, __ATOMIC_ACQ_REL);
+  __atomic_add_fetch(&queue->pending_count, 1, __ATOMIC_ACQ_REL);
+
+  // Round-robin across all deques; fall through to the next if one is full
+  bool pushed = false;
+  for (u32 attempt = 0; !pushed && attempt < queue->thread_count; ++attempt) {
+    // Workers submit too (nested jobs), so the cursor is shared
+    u32 index = __atomic_fetch_add(&queue->next_submit_index, 1,
+                                   __ATOMIC_RELAXED) %
+                queue->thread_count;
+    pushed = deque_push(&queue->deques[index], entry);
+  }
+
+  if (!pushed) {
+    __atomic_sub_fetch(&queue->pending_count, 1, __ATOMIC_ACQ_REL);
+    __atomic_sub_fetch(&queue->completion_goal, 1, __ATOMIC_ACQ_REL);
+#if DE100_INTERNAL
+    fprintf(stderr, "⚠️  Work queue full, entry dropped\n");
+#endif
+    return false;
+  }
+
+  // Signal under the lock so a worker about to sleep can't miss it
+  pthread_mutex_lock(&queue->sleep_lock);
+  pthread_cond_signal(&queue->wake_condition);
+  pthread_mutex_unlock(&queue->sleep_lock);
+
+  return true;
+}
+
+typedef struct {
+  de100_mem_task_t *task;
+  void *data;
+  u32 index;
+} WorkQueueParallelTask;
+
+de100_file_scoped_fn DE100_WORK_QUEUE_CALLBACK(work_queue_parallel_task) {
+  (void)thread_context;
+  WorkQueueParallelTask *entry = (WorkQueueParallelTask *)data;
+  entry->task(entry->data, entry->index);
+}
+
+DE100_MEM_PARALLEL_FOR(work_queue_parallel_for) {
+  De100WorkQueue *queue = (De100WorkQueue *)context;
+  WorkQueueParallelTask entries[DE100_WORK_QUEUE_MAX_THREADS];
+  u32 queued = 0;
+
+  for (u32 i = 0; i < task_count; ++i) {
+    if (queued < DE100_WORK_QUEUE_MAX_THREADS) {
+      WorkQueueParallelTask *entry = &entries[queued];
+      *entry = (WorkQueueParallelTask){task, data, i};
+      if (work_queue_add_entry(queue, work_queue_parallel_task, entry)) {
+        queued++;
+        continue;
+      }
+    }
+    task(data, i);
+  }
+
+  if (queued > 0) {
+    work_queue_complete_all_work(queue);
+  }
+}
+
+DE100_PLATFORM_COMPLETE_ALL_WORK(work_queue_complete_all_work) {
+  if (!queue || !queue->is_initialized) {
+    return;
+  }
+
+  while (__atomic_load_n(&queue->completion_count, __ATOMIC_ACQUIRE) !=
+         __atomic_load_n(&queue->completion_goal, __ATOMIC_ACQUIRE)) {
+    work_queue_do_next_entry(queue, 0);
+  }
+
+  __atomic_store_n(&queue->completion_goal, 0, __ATOMIC_RELEASE);
+  __atomic_store_n(&queue->completion_count, 0, __ATOMIC_RELEASE);
+}
@@ -0,0 +1,182 @@
+#ifndef DE100_PLATFORMS__COMMON_WORK_QUEUE_H
+#define DE100_PLATFORMS__COMMON_WORK_QUEUE_H
+
+#include "../../_common/base.h"
+#include "../../_common/memory.h"
+#include "../../game/memory-arena.h"
+#include "../../game/thread.h"
+
+#include <pthread.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// WORK QUEUE (pthreads, shared by X11 and Raylib backends)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// One deque per thread (slot 0 = main thread, 1..N = workers).
+//
+//   add_work_entry()      Round-robin push onto the workers' deques.
+//   owner                 Pops from the TAIL of its own deque (LIFO, hot).
+//   thief                 Steals from the HEAD of another deque (FIFO, cold).
+//   complete_all_work()   Main thread steals until every entry is done.
+//
+// Each deque has its own mutex, so contention only happens when two threads
+// touch the SAME deque (owner vs thief), which is rare when work is balanced.
+// A lock-free (Chase-Lev) deque would save the uncontended lock, but
+// entries here are whole jobs, not fine-grained tasks, so that cost is
+// noise next to the job itself.
+//
+// Idle workers sleep on a condition variable instead of spinning.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#ifndef DE100_WORK_QUEUE_MAX_WORKERS
+#define DE100_WORK_QUEUE_MAX_WORKERS 16
+#endif
+
+// Must be a power of two
+#ifndef DE100_WORK_QUEUE_DEQUE_CAPACITY
+#define DE100_WORK_QUEUE_DEQUE_CAPACITY 512
+#endif
+
+#ifndef DE100_WORK_QUEUE_SCRATCH_SIZE
+#define DE100_WORK_QUEUE_SCRATCH_SIZE MEGABYTES(4)
+#endif
+
+// Main thread + workers
+#define DE100_WORK_QUEUE_MAX_THREADS (DE100_WORK_QUEUE_MAX_WORKERS + 1)
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ERROR CODES
+// ═══════════════════════════════════════════════════════════════════════════
+
+typedef enum {
+  WORK_QUEUE_SUCCESS = 0,
+  WORK_QUEUE_ERROR_NULL_QUEUE,
+  WORK_QUEUE_ERROR_SYNC_INIT_FAILED,
+  WORK_QUEUE_ERROR_SCRATCH_ALLOC_FAILED,
+  WORK_QUEUE_ERROR_THREAD_CREATE_FAILED,
+
+  WORK_QUEUE_ERROR_COUNT
+} WorkQueueErrorCode;
+
+// ═══════════════════════════════════════════════════════════════════════════
+// QUEUE STRUCTURES
+// ═══════════════════════════════════════════════════════════════════════════
+
+typedef struct {
+  de100_work_queue_callback_t *callback;
+  void *data;
+} De100WorkQueueEntry;
+
+typedef struct {
+  pthread_mutex_t lock;
+  u32 head; // Steal end (oldest)
+  u32 tail; // Owner end (newest)
+  De100WorkQueueEntry entries[DE100_WORK_QUEUE_DEQUE_CAPACITY];
+} De100WorkDeque;
+
+typedef struct {
+  De100WorkQueue *queue;
+  pthread_t thread;
+  bool32 thread_started;
+
+  ThreadContext context;
+  De100MemoryArena scratch_arena;
+  De100MemoryBlock scratch_block;
+  i32 pinned_cpu; // -1 = scheduler's choice (see work_queue_set_worker_cpus)
+} De100WorkQueueThread;
+
+struct De100WorkQueue {
+  De100WorkDeque deques[DE100_WORK_QUEUE_MAX_THREADS];
+  De100WorkQueueThread threads[DE100_WORK_QUEUE_MAX_THREADS];
+  u32 thread_count; // Including main thread (slot 0)
+  u32 next_submit_index; // __atomic: any thread may submit
+
+  // Set before work_queue_init; worker i runs on worker_cpus[(i - 1) %
+  // worker_cpu_count], or anywhere when the count is 0
+  u32 worker_cpu_count;
+  u16 worker_cpus[DE100_WORK_QUEUE_MAX_WORKERS];
+
+  // Accessed with __atomic builtins
+  u32 completion_goal;
+  u32 completion_count;
+  u32 pending_count;
+
+  // Sleeping workers wait here when every deque is empty
+  pthread_mutex_t sleep_lock;
+  pthread_cond_t wake_condition;
+  bool32 is_running;
+  bool32 is_initialized;
+};
+
+// ═══════════════════════════════════════════════════════════════════════════
+// RESULT STRUCTURES
+// ═══════════════════════════════════════════════════════════════════════════
+
+typedef struct {
+  bool success;
+  WorkQueueErrorCode error_code;
+  u32 worker_count; // Worker threads started (excludes main thread)
+} WorkQueueInitResult;
+
+// ═══════════════════════════════════════════════════════════════════════════
+// API FUNCTIONS
+// ═══════════════════════════════════════════════════════════════════════════
+
+/**
+ * Start the worker pool.
+ *
+ * @param queue         Queue storage (zeroed; usually engine-allocated)
+ * @param worker_count  Worker threads to start; 0 = one per core minus the
+ *                      main thread. Clamped to DE100_WORK_QUEUE_MAX_WORKERS.
+ * @return              Result with the number of workers started
+ *
+ * On thread-creation failure the queue still works with the workers that
+ * did start (or main-thread only), and the error code is reported.
+ */
+WorkQueueInitResult work_queue_init(De100WorkQueue *queue, u32 worker_count);
+
+/**
+ * Pin workers as they start: worker i to cpus[(i - 1) % count].
+ * Call before work_queue_init (count 0 = unpinned, the default); a
+ * worker that can't be pinned runs unpinned.
+ */
+void work_queue_set_worker_cpus(De100WorkQueue *queue, const u16 *cpus,
+                                u32 count);
+
+/**
+ * Stop and join all workers, free their scratch arenas.
+ * Pending entries are drained first. Safe to call multiple times.
+ */
+void work_queue_shutdown(De100WorkQueue *queue);
+
+/**
+ * Context for the main thread (slot 0), with its own scratch arena.
+ */
+ThreadContext *work_queue_main_thread_context(De100WorkQueue *queue);
+
+/**
+ * Implementations of the GameMemory function pointers.
+ *
+ * add_work_entry() is single-producer: call it from the main thread only
+ * (callbacks must not enqueue more work).
+ */
+DE100_PLATFORM_ADD_WORK_ENTRY(work_queue_add_entry);
+DE100_PLATFORM_COMPLETE_ALL_WORK(work_queue_complete_all_work);
+
+/**
+ * de100_mem_set_parallel_for() hook (`context` = the queue): one entry per
+ * task, then complete_all_work. Main thread, outside the game's own
+ * add/complete pairs. Tasks past DE100_WORK_QUEUE_MAX_THREADS, or that
+ * don't fit the deques, run inline.
+ */
+DE100_MEM_PARALLEL_FOR(work_queue_parallel_for);
+
+/**
+ * Number of online CPU cores (at least 1).
+ */
+u32 work_queue_get_core_count(void);
+
+const char *work_queue_strerror(WorkQueueErrorCode code);
+
+#endif // DE100_PLATFORMS__COMMON_WORK_QUEUE_H
@@ -0,0 +1,858 @@
+#include "../_common/backend.h"
+#include "../../engine.h"
+
+#include "../../_common/base.h"
+#include "../../_common/log.h"
+#include "../../game/backbuffer.h"
+#include "../../game/base.h"
+#include "../../game/config.h"
+#include "../../game/game-loader.h"
+#include "../../game/inputs.h"
+#include "../_common/adaptive-fps.h"
+#include "../_common/capture.h"
+#include "../_common/config.h"
+#include "../_common/debug-overlay.h"
+#include "../_common/fixed-timestep.h"
+#include "../_common/flight-recorder.h"
+#include "../_common/frame-stats.h"
+#include "../_common/frame-timing.h"
+#include "../_common/inputs-recording.h"
+#include "../_common/spectate.h"
+#include "../_common/telemetry.h"
+#include "../_common/trace-export.h"
+#include "../x11/audio.h"
+#include "../x11/hooks/inputs/joystick.h"
+#include "../x11/inputs/evdev.h"
+#include "./hooks/inputs/keyboard.h"
+
+#include <drm/drm.h>
+#include <drm/drm_fourcc.h>
+#include <drm/drm_mode.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <glob.h>
+#include <linux/input.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <unistd.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// DRM/KMS BACKEND (kiosk: no X server, no compositor)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// Drives a display directly through the kernel's mode-setting API with
+// two CPU-mapped "dumb" scanout buffers; no GL, no libdrm (plain ioctls):
+//
+//   connector (first connected) → preferred mode → CRTC
+//   2 × CREATE_DUMB + MAP_DUMB + ADDFB2   → front/back framebuffers
+//   present = PAGE_FLIP(back) → wait for the flip event → swap roles
+//
+// With GameConfig.prefer_mapped_backbuffer the GameBackBuffer points
+// straight into the back framebuffer (centered, pitch = scanout pitch), so
+// presenting is a page flip and nothing is copied. The same contract as
+// X11's mapped PBOs applies: the game redraws every pixel each frame
+// (the pointer alternates between the two buffers) and avoids reading
+// pixels back (dumb buffers are often write-combined). Without it the
+// engine's backbuffer is copied into the back framebuffer each frame.
+//
+// The backbuffer is shown 1:1, centered on black; one larger than the
+// mode is an error (no scaling without a GPU pass). Flip events carry
+// the vblank timestamp, which feeds frame_timing like GLX_OML does.
+//
+// Audio is the X11 backend's ALSA code (platforms/x11/audio.c), gamepads
+// its evdev reader. Keyboards are read from /dev/input/event* (grabbed,
+// so keys don't also reach the console) and handed to the game adapter's
+// drm_handle_key(). Needs DRM master: run from a VT, not under X/Wayland.
+//
+//   DE100_DRM_DEVICE  Card node (default /dev/dri/card0)
+//
+// SIGINT/SIGTERM end the loop normally, so the previous CRTC setup (the
+// console) is restored on exit.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define DRM_BUFFER_COUNT 2
+#define DRM_MAX_RESOURCES 32 // CRTCs, connectors, encoders per card
+#define DRM_MAX_MODES 256 // GETCONNECTOR copies all modes or none
+#define DRM_MAX_KEYBOARDS 8
+#define DRM_FLIP_TIMEOUT_MS 1000
+
+#if DE100_PIXEL_FORMAT == DE100_PIXEL_FORMAT_BGRA8
+#define DRM_SCANOUT_FORMAT DRM_FORMAT_XRGB8888 // Bytes B,G,R,X
+#else
+#define DRM_SCANOUT_FORMAT DRM_FORMAT_XBGR8888 // Bytes R,G,B,X
+#endif
+
+typedef struct {
+  u32 handle;
+  u32 fb_id;
+  u32 pitch;
+  u64 size;
+  u8 *map;
+} DrmBuffer;
+
+typedef struct {
+  int fd;
+  u32 connector_id;
+  u32 crtc_id;
+  struct drm_mode_modeinfo mode;
+  f64 refresh_hz;
+
+  // CRTC state before we took over (the console), restored at exit
+  struct drm_mode_crtc saved_crtc;
+  bool has_saved_crtc;
+
+  DrmBuffer buffers[DRM_BUFFER_COUNT];
+  u32 back_index; // Buffer being drawn; the other one is on screen
+  bool flip_pending;
+
+  // Backbuffer placement inside a framebuffer (centered)
+  u64 backbuffer_offset;
+  bool is_zero_copy;
+  void *backbuffer_original_base;
+  int backbuffer_original_pitch;
+
+  // Last flip (vblank timestamp from the flip event, CLOCK_MONOTONIC)
+  bool has_last_flip;
+  f64 last_flip_seconds;
+  f32 flip_interval_seconds;
+
+  int keyboard_fds[DRM_MAX_KEYBOARDS];
+  u32 keyboard_count;
+
+  LinuxAudioConfig audio_config;
+} DrmPlatformState;
+
+de100_file_scoped_global_var DrmPlatformState g_drm = {.fd = -1};
+de100_file_scoped_global_var volatile sig_atomic_t g_drm_quit_requested = 0;
+
+#define DRM_EVDEV_BIT_WORDS(bits)                                              \
+  (((bits) + 8 * sizeof(unsigned long) - 1) / (8 * sizeof(unsigned long)))
+#define DRM_EVDEV_TEST_BIT(array, bit)                                         \
+  (((array)[(bit) / (8 * sizeof(unsigned long))] >>                           \
+    ((bit) % (8 * sizeof(unsigned long)))) &                                   \
+   1)
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Mode setting
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn inline u32 drm_min_u32(u32 a, u32 b) {
+  return a < b ? a : b;
+}
+
+de100_file_scoped_fn inline int drm_ioctl(int fd, unsigned long request,
+                                          void *arg) {
+  int result;
+  do {
+    result = ioctl(fd, request, arg);
+  } while (result == -1 && (errno == EINTR || errno == EAGAIN));
+  return result;
+}
+
+/**
+ * First connected connector with at least one mode; picks its preferred
+ * mode (else the first, which the kernel sorts highest) and a CRTC that
+ * can drive it.
+ */
+de100_file_scoped_fn bool drm_find_display(DrmPlatformState *drm) {
+  u32 crtc_ids[DRM_MAX_RESOURCES] = {0};
+  u32 connector_ids[DRM_MAX_RESOURCES] = {0};
+  u32 encoder_ids[DRM_MAX_RESOURCES] = {0};
+
+  struct drm_mode_card_res resources = {0};
+  if (drm_ioctl(drm->fd, DRM_IOCTL_MODE_GETRESOURCES, &resources) != 0) {
+    fprintf(stderr, "❌ DRM: not a KMS device (%s)\n", strerror(errno));
+    return false;
+  }
+  resources.count_fbs = 0;
+  resources.count_crtcs =
+      drm_min_u32(resources.count_crtcs, DRM_MAX_RESOURCES);
+  resources.count_connectors =
+      drm_min_u32(resources.count_connectors, DRM_MAX_RESOURCES);
+  resources.count_encoders =
+      drm_min_u32(resources.count_encoders, DRM_MAX_RESOURCES);
+  resources.crtc_id_ptr = (u64)(uintptr_t)crtc_ids;
+  resources.connector_id_ptr = (u64)(uintptr_t)connector_ids;
+  resources.encoder_id_ptr = (u64)(uintptr_t)encoder_ids;
+  if (drm_ioctl(drm->fd, DRM_IOCTL_MODE_GETRESOURCES, &resources) != 0) {
+    fprintf(stderr, "❌ DRM: GETRESOURCES failed (%s)\n", strerror(errno));
+    return false;
+  }
+
+  local_persist_var struct drm_mode_modeinfo modes[DRM_MAX_MODES];
+  for (u32 c = 0; c < resources.count_connectors; ++c) {
+    u32 connector_encoders[DRM_MAX_RESOURCES] = {0};
+    // First pass (no arrays) also makes the kernel probe the connector
+    struct drm_mode_get_connector connector = {.connector_id =
+                                                   connector_ids[c]};
+    if (drm_ioctl(drm->fd, DRM_IOCTL_MODE_GETCONNECTOR, &connector) != 0 ||
+        connector.connection != 1 || connector.count_modes == 0) {
+      continue;
+    }
+    connector.count_props = 0;
+    if (connector.count_modes > DRM_MAX_MODES) {
+      connector.count_modes = DRM_MAX_MODES; // Kernel then copies none
+    }
+    connector.count_encoders =
+        drm_min_u32(connector.count_encoders, DRM_MAX_RESOURCES);
+    connector.modes_ptr = (u64)(uintptr_t)modes;
+    connector.encoders_ptr = (u64)(uintptr_t)connector_encoders;
+    // Counts come back as the kernel's totals; more than we passed
+    // (hotplug in between) means that array wasn't copied
+    if (drm_ioctl(drm->fd, DRM_IOCTL_MODE_GETCONNECTOR, &connector) != 0 ||
+        connector.count_modes == 0 || connector.count_modes > DRM_MAX_MODES ||
+        connector.count_encoders > DRM_MAX_RESOURCES) {
+      continue;
+    }
+
+    drm->mode = modes[0];
+    for (u32 m = 0; m < connector.count_modes; ++m) {
+      if (modes[m].type & DRM_MODE_TYPE_PREFERRED) {
+        drm->mode = modes[m];
+        break;
+      }
+    }
+
+    // The CRTC the connector's encoder already uses, else any it can reach
+    u32 crtc_id = 0;
+    for (u32 e = 0; e < connector.count_encoders && !crtc_id; ++e) {
+      struct drm_mode_get_encoder encoder = {.encoder_id =
+                                                 connector_encoders[e]};
+      if (drm_ioctl(drm->fd, DRM_IOCTL_MODE_GETENCODER, &encoder) != 0) {
+        continue;
+      }
+      if (encoder.encoder_id == connector.encoder_id && encoder.crtc_id) {
+        crtc_id = encoder.crtc_id;
+        break;
+      }
+      for (u32 i = 0; i < resources.count_crtcs; ++i) {
+        if (encoder.possible_crtcs & (1u << i)) {
+          crtc_id = crtc_ids[i];
+          break;
+        }
+      }
+    }
+    if (!crtc_id) {
+      continue;
+    }
+
+    drm->connector_id = connector.connector_id;
+    drm->crtc_id = crtc_id;
+    drm->refresh_hz =
+        drm->mode.htotal && drm->mode.vtotal
+            ? (f64)drm->mode.clock * 1000.0 /
+                  ((f64)drm->mode.htotal * (f64)drm->mode.vtotal)
+            : (f64)drm->mode.vrefresh;
+    return true;
+  }
+
+  fprintf(stderr, "❌ DRM: no connected display\n");
+  return false;
+}
+
+de100_file_scoped_fn void drm_destroy_buffer(DrmPlatformState *drm,
+                                             DrmBuffer *buffer) {
+  if (buffer->map) {
+    munmap(buffer->map, (size_t)buffer->size);
+  }
+  if (buffer->fb_id) {
+    drm_ioctl(drm->fd, DRM_IOCTL_MODE_RMFB, &buffer->fb_id);
+  }
+  if (buffer->handle) {
+    struct drm_mode_destroy_dumb destroy = {.handle = buffer->handle};
+    drm_ioctl(drm->fd, DRM_IOCTL_MODE_DESTROY_DUMB, &destroy);
+  }
+  *buffer = (DrmBuffer){0};
+}
+
+/** One mode-sized, CPU-mapped, scanout-capable framebuffer (black). */
+de100_file_scoped_fn bool drm_create_buffer(DrmPlatformState *drm,
+                                            DrmBuffer *buffer) {
+  struct drm_mode_create_dumb create = {
+      .width = drm->mode.hdisplay,
+      .height = drm->mode.vdisplay,
+      .bpp = 32,
+  };
+  if (drm_ioctl(drm->fd, DRM_IOCTL_MODE_CREATE_DUMB, &create) != 0) {
+    fprintf(stderr, "❌ DRM: CREATE_DUMB failed (%s)\n", strerror(errno));
+    return false;
+  }
+  buffer->handle = create.handle;
+  buffer->pitch = create.pitch;
+  buffer->size = create.size;
+
+  struct drm_mode_fb_cmd2 framebuffer = {
+      .width = create.width,
+      .height = create.height,
+      .pixel_format = DRM_SCANOUT_FORMAT,
+      .handles = {create.handle},
+      .pitches = {create.pitch},
+  };
+  if (drm_ioctl(drm->fd, DRM_IOCTL_MODE_ADDFB2, &framebuffer) != 0) {
+    fprintf(stderr, "❌ DRM: ADDFB2 %s failed (%s)%s\n",
+            de100_pixel_format_name(DE100_PIXEL_FORMAT), strerror(errno),
+            DE100_PIXEL_FORMAT == DE100_PIXEL_FORMAT_BGRA8
+                ? ""
+                : "; XRGB8888 (-DDE100_PIXEL_FORMAT=1) is universal");
+    drm_destroy_buffer(drm, buffer);
+    return false;
+  }
+  buffer->fb_id = framebuffer.fb_id;
+
+  struct drm_mode_map_dumb map = {.handle = create.handle};
+  if (drm_ioctl(drm->fd, DRM_IOCTL_MODE_MAP_DUMB, &map) != 0) {
+    drm_destroy_buffer(drm, buffer);
+    return false;
+  }
+  void *memory = mmap(NULL, (size_t)buffer->size, PROT_READ | PROT_WRITE,
+                      MAP_SHARED, drm->fd, (off_t)map.offset);
+  if (memory == MAP_FAILED) {
+    fprintf(stderr, "❌ DRM: mmap of dumb buffer failed (%s)\n",
+            strerror(errno));
+    drm_destroy_buffer(drm, buffer);
+    return false;
+  }
+  buffer->map = (u8 *)memory;
+  memset(buffer->map, 0, (size_t)buffer->size);
+  return true;
+}
+
+de100_file_scoped_fn bool drm_init_display(DrmPlatformState *drm) {
+  const char *device = getenv("DE100_DRM_DEVICE");
+  if (!device || !device[0]) {
+    device = "/dev/dri/card0";
+  }
+
+  drm->fd = open(device, O_RDWR | O_CLOEXEC);
+  if (drm->fd < 0) {
+    fprintf(stderr, "❌ DRM: cannot open %s (%s)\n", device, strerror(errno));
+    return false;
+  }
+  if (!drm_find_display(drm)) {
+    return false;
+  }
+
+  for (u32 i = 0; i < DRM_BUFFER_COUNT; ++i) {
+    if (!drm_create_buffer(drm, &drm->buffers[i])) {
+      return false;
+    }
+  }
+
+  drm->saved_crtc = (struct drm_mode_crtc){.crtc_id = drm->crtc_id};
+  drm->has_saved_crtc =
+      drm_ioctl(drm->fd, DRM_IOCTL_MODE_GETCRTC, &drm->saved_crtc) == 0;
+
+  // Buffer 0 goes on screen; the game draws into buffer 1 first
+  struct drm_mode_crtc set = {
+      .set_connectors_ptr = (u64)(uintptr_t)&drm->connector_id,
+      .count_connectors = 1,
+      .crtc_id = drm->crtc_id,
+      .fb_id = drm->buffers[0].fb_id,
+      .mode_valid = 1,
+      .mode = drm->mode,
+  };
+  if (drm_ioctl(drm->fd, DRM_IOCTL_MODE_SETCRTC, &set) != 0) {
+    fprintf(stderr, "❌ DRM: SETCRTC failed (%s; is another display server "
+                    "running?)\n",
+            strerror(errno));
+    drm->has_saved_crtc = false; // Never changed it
+    return false;
+  }
+  drm->back_index = 1;
+
+  printf("✅ DRM display %s: %ux%u @ %.2fHz (%s)\n", device,
+         drm->mode.hdisplay, drm->mode.vdisplay, drm->refresh_hz,
+         drm->mode.name);
+  return true;
+}
+
+de100_file_scoped_fn void drm_shutdown_display(DrmPlatformState *drm) {
+  if (drm->fd < 0) {
+    return;
+  }
+  if (drm->has_saved_crtc) {
+    struct drm_mode_crtc *saved = &drm->saved_crtc;
+    saved->set_connectors_ptr = (u64)(uintptr_t)&drm->connector_id;
+    saved->count_connectors = 1;
+    drm_ioctl(drm->fd, DRM_IOCTL_MODE_SETCRTC, saved);
+  }
+  for (u32 i = 0; i < DRM_BUFFER_COUNT; ++i) {
+    drm_destroy_buffer(drm, &drm->buffers[i]);
+  }
+  close(drm->fd);
+  drm->fd = -1;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Backbuffer & present
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn bool drm_attach_backbuffer(DrmPlatformState *drm,
+                                                GameBackBuffer *backbuffer,
+                                                bool prefer_zero_copy) {
+  if ((u32)backbuffer->width > drm->mode.hdisplay ||
+      (u32)backbuffer->height > drm->mode.vdisplay) {
+    fprintf(stderr, "❌ DRM: backbuffer %dx%d is larger than the %ux%u mode\n",
+            backbuffer->width, backbuffer->height, drm->mode.hdisplay,
+            drm->mode.vdisplay);
+    return false;
+  }
+
+  u64 offset_x = (drm->mode.hdisplay - (u32)backbuffer->width) / 2;
+  u64 offset_y = (drm->mode.vdisplay - (u32)backbuffer->height) / 2;
+  drm->backbuffer_offset =
+      offset_y * drm->buffers[0].pitch + offset_x * sizeof(u32);
+
+  // Every frame goes out whole (two buffers alternate, so a partial
+  // update would show the frame before last around the dirty rects)
+  backbuffer->dirty.is_tracking = false;
+
+  if (prefer_zero_copy) {
+    drm->is_zero_copy = true;
+    drm->backbuffer_original_base = backbuffer->memory.base;
+    drm->backbuffer_original_pitch = backbuffer->pitch;
+    backbuffer->memory.base =
+        drm->buffers[drm->back_index].map + drm->backbuffer_offset;
+    backbuffer->pitch = (int)drm->buffers[drm->back_index].pitch;
+  }
+  return true;
+}
+
+de100_file_scoped_fn void drm_detach_backbuffer(DrmPlatformState *drm,
+                                                GameBackBuffer *backbuffer) {
+  if (drm->is_zero_copy) {
+    backbuffer->memory.base = drm->backbuffer_original_base;
+    backbuffer->pitch = drm->backbuffer_original_pitch;
+    drm->is_zero_copy = false;
+  }
+}
+
+/** Block until the queued flip has happened and record its vblank time. */
+de100_file_scoped_fn void drm_wait_for_flip(DrmPlatformState *drm) {
+  while (drm->flip_pending) {
+    struct pollfd pfd = {.fd = drm->fd, .events = POLLIN};
+    int ready = poll(&pfd, 1, DRM_FLIP_TIMEOUT_MS);
+    if (ready < 0 && errno == EINTR) {
+      continue;
+    }
+    if (ready <= 0) {
+      fprintf(stderr, "⚠️  DRM: page flip timed out\n");
+      drm->flip_pending = false;
+      return;
+    }
+
+    u8 events[1024];
+    ssize_t bytes = read(drm->fd, events, sizeof(events));
+    for (ssize_t at = 0; at + (ssize_t)sizeof(struct drm_event) <= bytes;) {
+      const struct drm_event *event = (const struct drm_event *)(events + at);
+      if (event->length == 0) {
+        break;
+      }
+      if (event->type == DRM_EVENT_FLIP_COMPLETE) {
+        const struct drm_event_vblank *vblank =
+            (const struct drm_event_vblank *)event;
+        f64 seconds =
+            (f64)vblank->tv_sec + (f64)vblank->tv_usec * 0.000001;
+        drm->flip_interval_seconds =
+            drm->has_last_flip ? (f32)(seconds - drm->last_flip_seconds)
+                               : 0.0f;
+        drm->last_flip_seconds = seconds;
+        drm->has_last_flip = true;
+        drm->flip_pending = false;
+      }
+      at += event->length;
+    }
+  }
+}
+
+/**
+ * Put the finished back buffer on screen at the next vblank and hand the
+ * game the other one. Returns false if the flip could not be queued.
+ */
+de100_file_scoped_fn bool drm_present(DrmPlatformState *drm,
+                                      GameBackBuffer *backbuffer) {
+  DrmBuffer *back = &drm->buffers[drm->back_index];
+
+  if (!drm->is_zero_copy && de100_memory_is_valid(backbuffer->memory)) {
+    const u8 *source = (const u8 *)backbuffer->memory.base;
+    u8 *dest = back->map + drm->backbuffer_offset;
+    u64 row_bytes = (u64)backbuffer->width * sizeof(u32);
+    for (int y = 0; y < backbuffer->height; ++y) {
+      de100_mem_copy(dest, source, row_bytes);
+      source += backbuffer->pitch;
+      dest += back->pitch;
+    }
+  }
+
+  struct drm_mode_crtc_page_flip flip = {
+      .crtc_id = drm->crtc_id,
+      .fb_id = back->fb_id,
+      .flags = DRM_MODE_PAGE_FLIP_EVENT,
+  };
+  if (drm_ioctl(drm->fd, DRM_IOCTL_MODE_PAGE_FLIP, &flip) != 0) {
+    return false;
+  }
+  drm->flip_pending = true;
+
+  drm->back_index = (drm->back_index + 1) % DRM_BUFFER_COUNT;
+  if (drm->is_zero_copy) {
+    // Still on screen until the flip lands: drm_wait_for_flip() runs
+    // before the game draws into it
+    backbuffer->memory.base =
+        drm->buffers[drm->back_index].map + drm->backbuffer_offset;
+  }
+  return true;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Keyboards (evdev)
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn bool drm_is_keyboard(int fd) {
+  unsigned long keys[DRM_EVDEV_BIT_WORDS(KEY_CNT)] = {0};
+  if (ioctl(fd, EVIOCGBIT(EV_KEY, sizeof(keys)), keys) < 0) {
+    return false;
+  }
+  return DRM_EVDEV_TEST_BIT(keys, KEY_A) && DRM_EVDEV_TEST_BIT(keys, KEY_ESC);
+}
+
+de100_file_scoped_fn void drm_open_keyboards(DrmPlatformState *drm) {
+  glob_t paths = {0};
+  if (glob("/dev/input/event*", 0, NULL, &paths) != 0) {
+    printf("⚠️  DRM: no input devices, keyboard disabled\n");
+    return;
+  }
+
+  for (size_t i = 0;
+       i < paths.gl_pathc && drm->keyboard_count < DRM_MAX_KEYBOARDS; ++i) {
+    int fd = open(paths.gl_pathv[i], O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+    if (fd < 0) {
+      continue;
+    }
+    if (!drm_is_keyboard(fd)) {
+      close(fd);
+      continue;
+    }
+    int clock_id = CLOCK_MONOTONIC; // Same clock as de100_get_wall_clock()
+    ioctl(fd, EVIOCSCLOCKID, &clock_id);
+    ioctl(fd, EVIOCGRAB, (void *)1); // Keep keys off the console
+    drm->keyboard_fds[drm->keyboard_count++] = fd;
+  }
+  globfree(&paths);
+
+  printf("✅ DRM: %u keyboard%s\n", drm->keyboard_count,
+         drm->keyboard_count == 1 ? "" : "s");
+}
+
+de100_file_scoped_fn void drm_close_keyboards(DrmPlatformState *drm) {
+  for (u32 i = 0; i < drm->keyboard_count; ++i) {
+    ioctl(drm->keyboard_fds[i], EVIOCGRAB, (void *)0);
+    close(drm->keyboard_fds[i]);
+  }
+  drm->keyboard_count = 0;
+}
+
+de100_file_scoped_fn void drm_poll_keyboards(DrmPlatformState *drm,
+                                             EnginePlatformState *platform,
+                                             EngineGameState *game) {
+  struct input_event events[64];
+  for (u32 k = 0; k < drm->keyboard_count; ++k) {
+    ssize_t bytes;
+    while ((bytes = read(drm->keyboard_fds[k], events, sizeof(events))) > 0) {
+      u32 count = (u32)((size_t)bytes / sizeof(struct input_event));
+      for (u32 i = 0; i < count; ++i) {
+        const struct input_event *event = &events[i];
+        if (event->type != EV_KEY || event->value == 2) { // 2 = autorepeat
+          continue;
+        }
+        bool is_down = event->value != 0;
+        GameInputEvent input_event = {
+            .seconds = (f64)event->input_event_sec +
+                       (f64)event->input_event_usec * 0.000001,
+            .kind = DE100_INPUT_EVENT_KEY,
+            .is_down = is_down,
+            .controller = (u8)KEYBOARD_CONTROLLER_INDEX,
+            .code = event->code,
+        };
+        de100_input_push_event(game->inputs, &input_event);
+        if (event->code == KEY_F12 && is_down) {
+          capture_request_screenshot();
+        }
+        drm_handle_key(event->code, is_down, game, platform);
+      }
+    }
+  }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Audio
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn inline void
+audio_generate_and_send(LinuxAudioConfig *audio_config, EngineGameState *game,
+                        GameMainCode *game_main_code) {
+  u32 samples_to_generate =
+      linux_get_samples_to_write(audio_config, &game->audio);
+  if (samples_to_generate == 0) {
+    return;
+  }
+  if (samples_to_generate > (u32)game->audio.max_sample_count) {
+    samples_to_generate = (u32)game->audio.max_sample_count;
+  }
+  samples_to_generate =
+      linux_begin_audio_write(audio_config, &game->audio, samples_to_generate);
+
+  game->audio.sample_count = (i32)samples_to_generate;
+  DE100_GAME_CALL(game_main_code, get_audio_samples)(&game->memory,
+                                                     &game->audio);
+  linux_send_samples_to_alsa(audio_config, &game->audio);
+  game->audio.running_sample_index += (u64)game->audio.sample_count;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// DRM Platform Initialization
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn void drm_request_quit(int signal_number) {
+  (void)signal_number;
+  g_drm_quit_requested = 1;
+}
+
+de100_file_scoped_fn int drm_init(EngineState *engine) {
+  DrmPlatformState *drm = &g_drm;
+  engine_set_backend(engine, drm);
+
+  if (!drm_init_display(drm) ||
+      !drm_attach_backbuffer(drm, &engine->game.backbuffer,
+                             engine->game.config.prefer_mapped_backbuffer)) {
+    return 1;
+  }
+  printf("%s\n", drm->is_zero_copy
+                     ? "✅ Game renders directly into scanout memory"
+                     : "ℹ️  Backbuffer copied to scanout each frame "
+                       "(prefer_mapped_backbuffer for zero-copy)");
+
+  struct sigaction action = {.sa_handler = drm_request_quit};
+  sigaction(SIGINT, &action, NULL);
+  sigaction(SIGTERM, &action, NULL);
+
+  drm_open_keyboards(drm);
+
+  linux_load_alsa();
+  drm->audio_config.game_update_hz =
+      (i32)engine->game.config.audio_game_update_hz;
+  drm->audio_config.bytes_per_sample = (i32)(sizeof(i16) * 2);
+  drm->audio_config.use_audio_thread =
+      engine->game.config.prefer_threaded_audio;
+  drm->audio_config.adaptive_latency =
+      engine->game.config.prefer_adaptive_audio_latency;
+  drm->audio_config.use_mmap = engine->game.config.prefer_mmap_audio;
+  drm->audio_config.use_audio_server =
+      engine->game.config.prefer_audio_server;
+  linux_init_audio(&drm->audio_config, &engine->game.audio,
+                   (i32)engine->game.config.initial_audio_sample_rate,
+                   (i32)engine->game.config.audio_game_update_hz);
+
+  if (engine->game.config.prefer_threaded_joystick && !x11_evdev_start()) {
+    printf("⚠️  Gamepad thread unavailable, polling on the frame thread\n");
+  }
+  linux_init_joystick(engine->platform.old_inputs->controllers,
+                      engine->game.inputs->controllers);
+
+  adaptive_fps_init(&engine->game.config, (u32)(drm->refresh_hz + 0.5));
+
+#if DE100_INTERNAL
+  frame_stats_init();
+#endif
+
+  printf("✅ DRM platform initialized\n");
+  return 0;
+}
+
+de100_file_scoped_fn void drm_shutdown(EngineState *engine) {
+  DrmPlatformState *drm = &g_drm;
+
+  linux_close_joysticks();
+  x11_evdev_stop();
+  linux_unload_alsa(&drm->audio_config);
+  drm_close_keyboards(drm);
+
+  drm_wait_for_flip(drm);
+  // Give the engine its own backbuffer block back before it frees it
+  drm_detach_backbuffer(drm, &engine->game.backbuffer);
+  drm_shutdown_display(drm);
+  engine->platform.backend = NULL;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Main Platform Entry Point
+// ═══════════════════════════════════════════════════════════════════════════
+
+int platform_main(void) {
+  EngineState engine = {0};
+  engine.platform.game_main_code = (GameMainCode){0};
+
+  if (engine_init(&engine)) {
+    return 1;
+  }
+
+  EngineStartupStamp backend_start = engine_startup_now();
+  if (drm_init(&engine) != 0) {
+    drm_detach_backbuffer(&g_drm, &engine.game.backbuffer);
+    drm_shutdown_display(&g_drm);
+    engine_shutdown(&engine);
+    return 1;
+  }
+  engine_startup_phase(&engine, "display + input", backend_start,
+                       engine_startup_now());
+
+  DrmPlatformState *drm = engine_get_backend(&engine, DrmPlatformState);
+
+  EngineStartupStamp game_init_start = engine_startup_now();
+  DE100_GAME_CALL(&engine.platform.game_bootstrap_code, init)(
+      &engine.game.thread_context, &engine.game.memory, engine.game.inputs,
+      &engine.game.backbuffer);
+  engine_startup_phase(&engine, "game init", game_init_start,
+                       engine_startup_now());
+  engine_startup_report(&engine);
+
+  while (is_game_running) {
+    if (g_drm_quit_requested) {
+      break;
+    }
+
+#if DE100_INTERNAL
+    if (FRAME_LOG_EVERY_TEN_SECONDS_CHECK) {
+      printf("[HEALTH CHECK] frame=%u, RSI=%lld, marker_idx=%d\n",
+             g_frame_counter, (long long)drm->audio_config.running_sample_index,
+             g_debug_marker_index);
+    }
+#endif
+
+    frame_timing_begin();
+    FRAME_STATS_PHASE_BEGIN();
+
+    handle_game_reload_check(&engine.platform.game_main_code,
+                             &engine.platform.paths);
+
+    prepare_input_frame(engine.platform.old_inputs, engine.game.inputs);
+    drm_poll_keyboards(drm, &engine.platform, &engine.game);
+    if (x11_evdev_is_running()) {
+      x11_evdev_drain_events(engine.game.inputs);
+    }
+    linux_poll_joystick(engine.game.inputs);
+
+    if (input_recording_is_recording(&engine.platform.memory_state)) {
+      input_recording_record_frame(&engine.platform.memory_state,
+                                   engine.game.inputs);
+    }
+    if (input_recording_is_playing(&engine.platform.memory_state)) {
+      input_recording_playback_frame(&engine.platform.memory_state,
+                                     engine.game.inputs);
+    }
+    FRAME_STATS_PHASE_MARK(FRAME_PHASE_INPUT);
+
+    if (!engine_netplay_frame(&engine)) {
+      fixed_timestep_run_frame(&engine.game, &engine.platform.game_main_code,
+                               g_frame_timing.total_seconds);
+    }
+    FRAME_STATS_PHASE_MARK(FRAME_PHASE_UPDATE);
+
+    audio_generate_and_send(&drm->audio_config, &engine.game,
+                            &engine.platform.game_main_code);
+    FRAME_STATS_PHASE_MARK(FRAME_PHASE_AUDIO);
+
+    capture_frame(&engine.game.backbuffer,
+                  engine.game.config.target_seconds_per_frame);
+    spectate_frame(&engine.game.backbuffer);
+
+#if DE100_INTERNAL
+    int display_marker_index =
+        (g_debug_marker_index - 1 + MAX_DEBUG_AUDIO_MARKERS) %
+        MAX_DEBUG_AUDIO_MARKERS;
+    linux_debug_sync_display(&engine.game.backbuffer, &engine.game.audio,
+                             &drm->audio_config, g_debug_audio_markers,
+                             MAX_DEBUG_AUDIO_MARKERS, display_marker_index);
+    debug_overlay_render(&engine.game.backbuffer, &engine.game.memory,
+                         engine.game.config.target_seconds_per_frame);
+#endif
+
+    if (!drm_present(drm, &engine.game.backbuffer)) {
+      fprintf(stderr, "⚠️  DRM: page flip failed (%s)\n", strerror(errno));
+    }
+#if DE100_INTERNAL
+    linux_debug_capture_flip_state(&drm->audio_config);
+#endif
+    FRAME_STATS_PHASE_MARK(FRAME_PHASE_PRESENT);
+
+    // The flip paces the loop at the refresh rate; a lower target (e.g.
+    // 30Hz on 60Hz) sleeps off the remainder after it
+    frame_timing_mark_work_done();
+    drm_wait_for_flip(drm);
+    f64 refresh_seconds = drm->refresh_hz > 0.0 ? 1.0 / drm->refresh_hz : 0.0;
+    if (engine.game.config.target_seconds_per_frame > refresh_seconds * 1.5) {
+      frame_timing_sleep_until_target(
+          engine.game.config.target_seconds_per_frame);
+    }
+    frame_timing_end();
+    if (drm->flip_interval_seconds > 0.0f) {
+      frame_timing_use_present_interval(drm->flip_interval_seconds);
+    }
+    FRAME_STATS_PHASE_MARK(FRAME_PHASE_SLEEP);
+
+    f32 frame_time_ms = frame_timing_get_ms();
+    telemetry_frame(frame_time_ms, engine.game.config.target_seconds_per_frame);
+    if (FRAME_LOG_EVERY_ONE_SECONDS_CHECK) {
+      telemetry_counter(TELEMETRY_COUNTER_AUDIO_UNDERRUNS,
+                        linux_audio_underrun_count());
+    }
+
+#if DE100_INTERNAL
+    frame_stats_record(frame_time_ms,
+                       engine.game.config.target_seconds_per_frame);
+    de100_profiler_end_frame(engine.game.memory.profiler);
+    trace_export_frame(engine.game.memory.profiler);
+    flight_recorder_frame(engine.game.memory.profiler, engine.game.inputs,
+                          frame_time_ms,
+                          engine.game.config.target_seconds_per_frame);
+    if (FRAME_LOG_EVERY_ONE_SECONDS_CHECK) {
+      frame_stats_report_missed();
+    }
+#endif
+
+    g_frame_counter++;
+
+    if (engine.game.config.prefer_adaptive_fps) {
+      adaptive_fps_update(&engine.game.config, frame_time_ms,
+                          g_frame_timing.work_seconds * 1000.0f);
+    }
+
+    engine_swap_inputs(&engine);
+  }
+
+#if DE100_INTERNAL
+  de100_profiler_print(engine.game.memory.profiler, 15, true);
+#endif
+
+  linux_audio_thread_stop(&drm->audio_config);
+  // Always: restoring the console's CRTC is what makes the VT usable again
+  drm_shutdown(&engine);
+  engine_shutdown(&engine);
+
+#if DE100_INTERNAL
+  frame_stats_print();
+  frame_stats_dump_to_directory(engine.platform.paths.exe_directory.path);
+#endif
+
+  printf("Goodbye!\n");
+  return 0;
+}
@@ -0,0 +1,12 @@
+#ifndef DE100_PLATFORMS_DRM_INPUTS_KEYBOARD_H
+#define DE100_PLATFORMS_DRM_INPUTS_KEYBOARD_H
+
+#include "../../../../engine.h"
+
+#include <linux/input-event-codes.h>
+
+// `code` is an evdev KEY_* code; autorepeat is filtered out before this
+void drm_handle_key(u16 code, bool is_down, EngineGameState *game_state,
+                    EnginePlatformState *platform_state);
+
+#endif // DE100_PLATFORMS_DRM_INPUTS_KEYBOARD_H
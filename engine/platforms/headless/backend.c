@@ -0,0 +1,768 @@
+#if defined(__linux__)
+#define _GNU_SOURCE // sched_setaffinity (DE100_HEADLESS_INSTANCES)
+#endif
+
+#include "../_common/backend.h"
+#include "../../_common/base.h"
+#include "../../_common/file.h"
+#include "../../_common/log.h"
+#include "../../_common/time.h"
+#include "../../engine.h"
+#include "../../game/base.h"
+#include "../../game/game-loader.h"
+#include "../../game/inputs.h"
+#include "../_common/benchmark.h"
+#include "../_common/engine-instances.h"
+#include "../_common/fixed-timestep.h"
+#include "../_common/frame-graph.h"
+#include "../_common/frame-stats.h"
+#include "../_common/inputs-recording.h"
+#include "../_common/replay-archive.h"
+#include "../_common/replay-hash.h"
+#include "../_common/trace-export.h"
+#include "../_common/work-queue.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if !defined(_WIN32)
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+// ═══════════════════════════════════════════════════════════════════════════
+// HEADLESS BACKEND
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// Same game library, same engine_init(), but no window, no audio device and
+// no frame pacing: frames run back to back. For soak tests, determinism
+// checks and AI training on machines without a display.
+//
+// Configured through the environment (platform_main() takes no args):
+//
+//   DE100_HEADLESS_FRAMES  Frames to run (0 = until the input runs out or
+//                          the game clears is_game_running)
+//   DE100_HEADLESS_REPLAY  .hmr archive (see replay-archive.h): restores
+//                          its snapshot and plays its inputs. Without
+//                          DE100_HEADLESS_FRAMES it stops after one pass;
+//                          with it, playback loops like the live backends.
+//   DE100_HEADLESS_INPUT   A recorded loop_edit_N_input.hmi (see
+//                          input-stream.h) or raw GameInput frames (e.g.
+//                          written by a script); stops at the end
+//   DE100_HEADLESS_AUDIO   0 = skip get_audio_samples (default 1; the
+//                          game's audio state then matches a live run)
+//   DE100_HEADLESS_INSTANCES
+//                          Run N copies of the same session in parallel,
+//                          one process per core (0 = one per online
+//                          core). Default 1.
+//   DE100_HEADLESS_SHARED  Run N more sessions inside this process, next
+//                          to the main one (see engine-instances.h): one
+//                          game library, worker pool and audio mix, own
+//                          game memory. Each gets the main session's
+//                          input; their state hashes must match its.
+//   DE100_HEADLESS_TIMINGS Write per-frame update_and_render times
+//                          ("frame,update_ms" CSV) to this path; with
+//                          instances, to "<path>.<instance>"
+//
+// With no input source the game sees idle controllers every frame.
+//
+// On exit a hash of permanent storage is printed (the same state hash
+// recordings carry, see replay-hash.h), so two runs of the same input can
+// be compared for determinism.
+//
+// Benchmarking a game build from real gameplay:
+//
+//   DE100_HEADLESS_REPLAY=loop_edit_1.hmr DE100_HEADLESS_INSTANCES=0 ./game
+//
+// Each instance is a forked process (own engine, own game memory, pinned
+// to its own core, which its worker threads share) that plays the archive straight from the file, so
+// instances share no replay slots. The parent prints one row per
+// instance (update_and_render mean/p50/p95/p99/max and the state hash)
+// and exits non-zero if any instance failed or the hashes disagree; run
+// it once per game library build and compare the rows.
+//
+// For a per-phase breakdown (input / update / render / audio) of one
+// run, any backend's executable takes --benchmark (see benchmark.h).
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+typedef struct {
+  u64 frame_limit;
+  const char *replay_path;
+  const char *input_path;
+  bool generate_audio;
+
+  InputStreamReader input_stream; // DE100_HEADLESS_INPUT if it's a stream
+  i32 input_fd;                    // Raw frames otherwise (-1 = none)
+
+  ReplayArchive replay; // DE100_HEADLESS_REPLAY
+  bool has_replay;
+  u64 replay_frame; // Next frame to play
+
+  u32 instance_index;
+  u32 instance_count;
+  EngineInstanceSet shared; // DE100_HEADLESS_SHARED
+  const char *timings_path;
+  De100MemoryBlock update_ms; // f32 per frame
+  u64 update_ms_count;
+} HeadlessState;
+
+#define HEADLESS_MAX_INSTANCES 256
+
+// What one instance reports back to the parent (over a pipe)
+typedef struct {
+  i32 exit_code;
+  u64 frame_count;
+  f64 seconds;
+  u64 state_hash;
+  FramePhaseSummary update; // update_and_render, exact percentiles
+} HeadlessReport;
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Helpers
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn inline const char *headless_env(const char *name) {
+  const char *value = getenv(name);
+  return (value && value[0]) ? value : NULL;
+}
+
+/**
+ * Audio at exactly one frame's worth of samples: keeps the game's audio
+ * state advancing at the live rate without a device to drain it.
+ */
+de100_file_scoped_fn inline void headless_generate_audio(EngineState *engine) {
+  EngineGameState *game = &engine->game;
+  i32 sample_count = (i32)((f32)game->audio.samples_per_second *
+                           game->config.target_seconds_per_frame);
+  if (sample_count <= 0) {
+    return;
+  }
+  if (sample_count > game->audio.max_sample_count) {
+    sample_count = game->audio.max_sample_count;
+  }
+
+  game->audio.sample_count = sample_count;
+  DE100_GAME_CALL(&engine->platform.game_main_code, get_audio_samples)(
+      &game->memory, &game->audio);
+  game->audio.running_sample_index += (u64)sample_count;
+}
+
+/**
+ * Put the archive's snapshot into game memory (start of a pass).
+ */
+de100_file_scoped_fn bool headless_restore_replay(EngineState *engine,
+                                                  HeadlessState *headless) {
+  ReplaySnapshotTracker *tracker =
+      &engine->platform.memory_state.snapshot_tracker;
+  u64 snapshot_size = headless->replay.header.snapshot_size;
+  if (snapshot_size > tracker->capacity ||
+      headless->replay.header.input_frame_size != sizeof(GameInput)) {
+    fprintf(stderr, "❌ '%s': %s\n", headless->replay_path,
+            replay_archive_strerror(REPLAY_ARCHIVE_ERROR_SIZE_MISMATCH));
+    return false;
+  }
+
+  // Game memory is about to change behind the tracker's back
+  replay_snapshot_tracker_invalidate(tracker);
+  if (!replay_snapshot_tracker_commit(tracker, snapshot_size)) {
+    fprintf(stderr, "❌ Failed to commit memory for the snapshot\n");
+    return false;
+  }
+  ReplayArchiveResult result = replay_archive_read_snapshot(
+      &headless->replay, tracker->base, snapshot_size);
+  if (!result.success) {
+    fprintf(stderr, "❌ Failed to unpack snapshot: %s\n",
+            replay_archive_strerror(result.error_code));
+    return false;
+  }
+  return true;
+}
+
+/**
+ * Fill this frame's input. Returns false when the input source is done.
+ */
+de100_file_scoped_fn bool headless_read_input(EngineState *engine,
+                                              HeadlessState *headless) {
+  if (headless->input_stream.is_open) {
+    return input_stream_reader_next(&headless->input_stream,
+                                    engine->game.inputs);
+  }
+
+  if (headless->input_fd >= 0) {
+    De100FileIOResult read_result = de100_file_read_all(
+        headless->input_fd, engine->game.inputs, sizeof(GameInput));
+    if (!read_result.success &&
+        read_result.error_code != DE100_FILE_ERROR_EOF) {
+      DE100_LOG_ERROR(DE100_LOG_INPUT, "Failed to read input: %s",
+                      de100_file_strerror(read_result.error_code));
+    }
+    return read_result.success;
+  }
+
+  if (headless->has_replay) {
+    u64 frame_count = headless->replay.header.frame_count;
+    if (headless->replay_frame >= frame_count) {
+      // One pass unless a frame count asks for more (then loop)
+      if (headless->frame_limit == 0 || frame_count == 0 ||
+          !headless_restore_replay(engine, headless)) {
+        return false;
+      }
+      headless->replay_frame = 0;
+    }
+    ReplayArchiveResult result = replay_archive_read_frame(
+        &headless->replay, headless->replay_frame++, engine->game.inputs);
+    if (!result.success) {
+      DE100_LOG_ERROR(DE100_LOG_INPUT, "Failed to read replay frame: %s",
+                      replay_archive_strerror(result.error_code));
+    }
+    return result.success;
+  }
+
+  return true; // Idle input from prepare_input_frame()
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Update Timings
+// ═══════════════════════════════════════════════════════════════════════════
+
+/**
+ * Append one frame's update_and_render time (storage doubles as needed;
+ * if it can't grow, later frames just aren't timed).
+ */
+de100_file_scoped_fn void headless_record_update(HeadlessState *headless,
+                                                 f32 milliseconds) {
+  u64 needed = (headless->update_ms_count + 1) * sizeof(f32);
+  if (!de100_memory_is_valid(headless->update_ms)) {
+    // Address space for ~16M frames; pages are committed as it grows
+    headless->update_ms = de100_memory_reserve(
+        NULL, KILOBYTES(64), MEGABYTES(64), De100_MEMORY_FLAG_RW);
+    if (!de100_memory_is_valid(headless->update_ms)) {
+      return;
+    }
+  } else if (headless->update_ms.size < needed &&
+             de100_memory_realloc(&headless->update_ms,
+                                  headless->update_ms.size * 2,
+                                  true) != De100_MEMORY_OK) {
+    return;
+  }
+
+  ((f32 *)headless->update_ms.base)[headless->update_ms_count++] =
+      milliseconds;
+}
+
+de100_file_scoped_fn void headless_write_timings(const HeadlessState *headless) {
+  if (!headless->timings_path || headless->update_ms_count == 0) {
+    return;
+  }
+
+  char path[512];
+  if (headless->instance_count > 1) {
+    snprintf(path, sizeof(path), "%s.%u", headless->timings_path,
+             headless->instance_index);
+  } else {
+    snprintf(path, sizeof(path), "%s", headless->timings_path);
+  }
+
+  FILE *file = fopen(path, "w");
+  if (!file) {
+    fprintf(stderr, "⚠️  Failed to write timings to '%s'\n", path);
+    return;
+  }
+  const f32 *milliseconds = (const f32 *)headless->update_ms.base;
+  fprintf(file, "frame,update_ms\n");
+  for (u64 i = 0; i < headless->update_ms_count; ++i) {
+    fprintf(file, "%lu,%.4f\n", (unsigned long)i, (f64)milliseconds[i]);
+  }
+  fclose(file);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Headless Platform Initialization
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn int headless_init(EngineState *engine,
+                                       HeadlessState *headless) {
+  const char *frames = headless_env("DE100_HEADLESS_FRAMES");
+  const char *audio = headless_env("DE100_HEADLESS_AUDIO");
+  headless->timings_path = headless_env("DE100_HEADLESS_TIMINGS");
+
+  headless->frame_limit = frames ? strtoull(frames, NULL, 10) : 0;
+  headless->replay_path = headless_env("DE100_HEADLESS_REPLAY");
+  headless->input_path = headless_env("DE100_HEADLESS_INPUT");
+  headless->generate_audio = !audio || audio[0] != '0';
+  headless->input_fd = -1;
+
+  if (headless->replay_path && headless->input_path) {
+    fprintf(stderr, "❌ Set DE100_HEADLESS_REPLAY or DE100_HEADLESS_INPUT, "
+                    "not both\n");
+    return 1;
+  }
+
+  if (headless->input_path) {
+    InputStreamResult stream_result = input_stream_reader_open(
+        &headless->input_stream, headless->input_path);
+    if (stream_result.error_code != INPUT_STREAM_ERROR_BAD_HEADER &&
+        !stream_result.success) {
+      fprintf(stderr, "❌ Failed to open input '%s': %s\n",
+              headless->input_path,
+              input_stream_strerror(stream_result.error_code));
+      return 1;
+    }
+  }
+
+  if (headless->input_path && !headless->input_stream.is_open) {
+    De100FileOpenResult open_result =
+        de100_file_open(headless->input_path, DE100_FILE_READ);
+    if (!open_result.success) {
+      fprintf(stderr, "❌ Failed to open input '%s': %s\n",
+              headless->input_path,
+              de100_file_strerror(open_result.error_code));
+      return 1;
+    }
+    headless->input_fd = open_result.fd;
+  }
+
+  // Played straight from the archive rather than imported into a replay
+  // slot: parallel instances would otherwise share the slot's files
+  if (headless->replay_path) {
+    ReplayArchiveResult open_result =
+        replay_archive_open(headless->replay_path, &headless->replay);
+    if (!open_result.success) {
+      fprintf(stderr, "❌ Failed to open replay '%s': %s\n",
+              headless->replay_path,
+              replay_archive_strerror(open_result.error_code));
+      return 1;
+    }
+    headless->has_replay = true;
+    if (!headless_restore_replay(engine, headless)) {
+      return 1;
+    }
+  }
+
+  // Nothing presents, so there is nothing to track
+  engine->game.backbuffer.dirty.is_tracking = false;
+
+  // After the replay restore: its snapshot is the main session's only
+  const char *shared = headless_env("DE100_HEADLESS_SHARED");
+  u32 shared_count = shared ? (u32)strtoul(shared, NULL, 10) : 0;
+  if (shared_count > 0) {
+    EngineInstancesResult shared_result =
+        engine_instances_init(&headless->shared, engine, shared_count);
+    if (!shared_result.success) {
+      fprintf(stderr, "❌ Failed to start %u shared instances: %s\n",
+              shared_count,
+              engine_instances_strerror(shared_result.error_code));
+      return 1;
+    }
+    printf("✅ Shared instances: %u (%lu MB game memory each)\n",
+           shared_count,
+           (unsigned long)(headless->shared.instances[0].game_state.size /
+                           (1024 * 1024)));
+  }
+
+  printf("✅ Headless platform initialized (frames: %lu, input: %s)\n",
+         (unsigned long)headless->frame_limit,
+         headless->replay_path  ? headless->replay_path
+         : headless->input_path ? headless->input_path
+                                : "idle");
+  return 0;
+}
+
+de100_file_scoped_fn void headless_shutdown(HeadlessState *headless) {
+  engine_instances_shutdown(&headless->shared);
+  if (headless->has_replay) {
+    replay_archive_close(&headless->replay);
+    headless->has_replay = false;
+  }
+  if (de100_memory_is_valid(headless->update_ms)) {
+    de100_memory_free(&headless->update_ms);
+  }
+  input_stream_reader_close(&headless->input_stream);
+  if (headless->input_fd >= 0) {
+    de100_file_close(headless->input_fd);
+    headless->input_fd = -1;
+  }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Frame Phases (see frame-graph.h)
+// ═══════════════════════════════════════════════════════════════════════════
+
+typedef struct {
+  EngineState *engine;
+  HeadlessState *headless;
+  u64 frame;
+  f64 start;
+  f64 frame_start;
+} HeadlessFrame;
+
+de100_file_scoped_fn FRAME_GRAPH_PHASE_FN(headless_phase_input) {
+  (void)graph;
+  HeadlessFrame *ctx = (HeadlessFrame *)data;
+  ctx->frame_start = de100_get_wall_clock();
+  prepare_input_frame(ctx->engine->platform.old_inputs,
+                      ctx->engine->game.inputs);
+  return headless_read_input(ctx->engine, ctx->headless);
+}
+
+de100_file_scoped_fn FRAME_GRAPH_PHASE_FN(headless_phase_update) {
+  (void)graph;
+  HeadlessFrame *ctx = (HeadlessFrame *)data;
+  EngineState *engine = ctx->engine;
+  HeadlessState *headless = ctx->headless;
+
+  // Nominal frame time, not wall time: ticks per frame stay reproducible
+  f64 update_start = de100_get_wall_clock();
+  if (!engine_netplay_frame(engine)) {
+    fixed_timestep_run_frame(&engine->game, &engine->platform.game_main_code,
+                             engine->game.config.target_seconds_per_frame);
+  }
+  for (u32 i = 0; i < headless->shared.count; ++i) {
+    *headless->shared.instances[i].game.inputs = *engine->game.inputs;
+  }
+  engine_instances_run_frame(&headless->shared,
+                             engine->game.config.target_seconds_per_frame);
+  headless_record_update(
+      headless, (f32)(de100_get_seconds_elapsed(update_start,
+                                                de100_get_wall_clock()) *
+                      1000.0));
+  return true;
+}
+
+de100_file_scoped_fn FRAME_GRAPH_PHASE_FN(headless_phase_audio) {
+  (void)graph;
+  HeadlessFrame *ctx = (HeadlessFrame *)data;
+  headless_generate_audio(ctx->engine);
+  engine_instances_mix_audio(&ctx->headless->shared, &ctx->engine->game.audio);
+  return true;
+}
+
+// Frame bookkeeping, then the inputs flip for the next frame
+de100_file_scoped_fn FRAME_GRAPH_PHASE_FN(headless_phase_end) {
+  HeadlessFrame *ctx = (HeadlessFrame *)data;
+  EngineState *engine = ctx->engine;
+
+  (void)graph;
+#if DE100_INTERNAL
+  frame_stats_record((f32)(de100_get_seconds_elapsed(ctx->frame_start,
+                                                     de100_get_wall_clock()) *
+                           1000.0),
+                     engine->game.config.target_seconds_per_frame);
+  de100_profiler_end_frame(engine->game.memory.profiler);
+  trace_export_frame(engine->game.memory.profiler);
+#endif
+
+  g_frame_counter++;
+  ctx->frame++;
+
+#if DE100_INTERNAL
+  if (FRAME_LOG_EVERY_TEN_SECONDS_CHECK) {
+    DE100_LOG_DEBUG(DE100_LOG_TIMING, "frame=%lu (%.0f f/s)",
+                    (unsigned long)ctx->frame,
+                    (f64)ctx->frame / de100_get_seconds_elapsed(
+                                          ctx->start, de100_get_wall_clock()));
+  }
+#endif
+
+  engine_swap_inputs(engine);
+  engine_instances_swap_inputs(&ctx->headless->shared);
+  return true;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Headless Session
+// ═══════════════════════════════════════════════════════════════════════════
+
+/**
+ * One headless session, start to finish. Fills `report` (also on failure).
+ */
+de100_file_scoped_fn int headless_run(u32 instance_index, u32 instance_count,
+                                      HeadlessReport *report) {
+  EngineState engine = {0};
+  engine.platform.game_main_code = (GameMainCode){0};
+  HeadlessState headless = {0};
+  headless.instance_index = instance_index;
+  headless.instance_count = instance_count;
+  *report = (HeadlessReport){.exit_code = 1};
+
+  if (engine_init(&engine)) {
+    return 1;
+  }
+
+  EngineStartupStamp game_init_start = engine_startup_now();
+  // Bootstrap first: a replay then overwrites its state with the archive's
+  DE100_GAME_CALL(&engine.platform.game_bootstrap_code, init)(
+      &engine.game.thread_context, &engine.game.memory, engine.game.inputs,
+      &engine.game.backbuffer);
+  engine_startup_phase(&engine, "game init", game_init_start,
+                       engine_startup_now());
+  engine_startup_report(&engine);
+
+  if (headless_init(&engine, &headless) != 0) {
+    headless_shutdown(&headless);
+    engine_shutdown(&engine);
+    return 1;
+  }
+  // Fast-forward by tick count only: the budget cap would tie ticks to
+  // this machine's speed
+  g_fixed_timestep.ignore_tick_budget = true;
+
+  HeadlessFrame ctx = {.engine = &engine, .headless = &headless};
+  FrameGraph graph = {0};
+  u32 input_phase = frame_graph_add(
+      &graph, (FrameGraphPhase){.name = "input",
+                                .run = headless_phase_input,
+                                .data = &ctx,
+                                .flags = FRAME_GRAPH_MAIN_THREAD,
+                                .stats_phase = FRAME_PHASE_INPUT});
+  u32 update_phase = frame_graph_add(
+      &graph, (FrameGraphPhase){.name = "update",
+                                .run = headless_phase_update,
+                                .data = &ctx,
+                                .after = FRAME_GRAPH_BIT(input_phase),
+                                .flags = FRAME_GRAPH_MAIN_THREAD,
+                                .stats_phase = FRAME_PHASE_UPDATE});
+  u32 audio_phase = frame_graph_add(
+      &graph, (FrameGraphPhase){.name = "audio",
+                                .run = headless_phase_audio,
+                                .data = &ctx,
+                                .after = FRAME_GRAPH_BIT(update_phase),
+                                .flags = FRAME_GRAPH_MAIN_THREAD,
+                                .stats_phase = FRAME_PHASE_AUDIO});
+  frame_graph_add(&graph, (FrameGraphPhase){
+                              .name = "end",
+                              .run = headless_phase_end,
+                              .data = &ctx,
+                              .after = FRAME_GRAPH_BIT(audio_phase),
+                              .flags = FRAME_GRAPH_MAIN_THREAD,
+                              .stats_phase = FRAME_GRAPH_NO_STATS});
+  frame_graph_set_enabled(&graph, audio_phase, headless.generate_audio);
+  // No work queue: every phase runs in order on this thread, so the run
+  // stays as reproducible as before
+  FrameGraphResult compiled = frame_graph_compile(&graph, NULL);
+  if (!compiled.success) {
+    DE100_LOG_ERROR(DE100_LOG_ENGINE, "Frame graph: %s",
+                    frame_graph_strerror(compiled.error_code));
+    headless_shutdown(&headless);
+    engine_shutdown(&engine);
+    return 1;
+  }
+  frame_graph_log(&graph);
+
+  f64 start = de100_get_wall_clock();
+  ctx.start = start;
+
+  // No hot reload, frame pacing or presentation: the run must depend on
+  // nothing but the game library and its inputs
+  while (is_game_running &&
+         (headless.frame_limit == 0 || ctx.frame < headless.frame_limit)) {
+    if (!frame_graph_run(&graph)) {
+      break;
+    }
+  }
+  u64 frame = ctx.frame;
+
+  f64 elapsed = de100_get_seconds_elapsed(start, de100_get_wall_clock());
+  u64 state_hash =
+      replay_state_hash_memory(engine.game.memory.permanent_storage,
+                               engine.game.memory.permanent_storage_size);
+  headless_write_timings(&headless);
+  FramePhaseSummary update = benchmark_summarize_ms(
+      (f32 *)headless.update_ms.base, headless.update_ms_count);
+
+  printf("[HEADLESS] ✅ %lu frames in %.3fs (%.0f f/s)\n",
+         (unsigned long)frame, elapsed,
+         elapsed > 0.0 ? (f64)frame / elapsed : 0.0);
+  printf("[HEADLESS] ⏱️ update_and_render ms: mean %.3f, p50 %.3f, "
+         "p95 %.3f, p99 %.3f, max %.3f\n",
+         (f64)update.mean_ms, (f64)update.p50_ms, (f64)update.p95_ms,
+         (f64)update.p99_ms, (f64)update.max_ms);
+  printf("[HEADLESS] 🔑 Permanent storage hash: %016llx\n",
+         (unsigned long long)state_hash);
+
+  // Same game, same inputs, own memory: anything else is state leaking
+  // between instances (game library globals)
+  i32 exit_code = 0;
+  for (u32 i = 0; i < headless.shared.count; ++i) {
+    GameMemory *memory = &headless.shared.instances[i].game.memory;
+    u64 shared_hash = replay_state_hash_memory(memory->permanent_storage,
+                                               memory->permanent_storage_size);
+    if (shared_hash != state_hash) {
+      printf("[HEADLESS] ❌ Shared instance %u hash %016llx differs\n", i,
+             (unsigned long long)shared_hash);
+      exit_code = 1;
+    }
+  }
+  if (headless.shared.count > 0 && exit_code == 0) {
+    printf("[HEADLESS] ✅ All %u shared instances agree\n",
+           headless.shared.count);
+  }
+
+  *report = (HeadlessReport){
+      .exit_code = exit_code,
+      .frame_count = frame,
+      .seconds = elapsed,
+      .state_hash = state_hash,
+      .update = update,
+  };
+
+#if DE100_INTERNAL
+  de100_profiler_print(engine.game.memory.profiler, 15, true);
+#endif
+
+  headless_shutdown(&headless);
+  engine_shutdown(&engine);
+
+#if DE100_INTERNAL
+  frame_stats_print();
+  if (instance_count == 1) { // Instances would overwrite each other's dump
+    frame_stats_dump_to_directory(engine.platform.paths.exe_directory.path);
+  }
+#endif
+
+  printf("Goodbye!\n");
+  return exit_code;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Parallel Instances (DE100_HEADLESS_INSTANCES)
+// ═══════════════════════════════════════════════════════════════════════════
+
+#if !defined(_WIN32)
+/**
+ * Child side: pin to a core, run, send the report up the pipe.
+ */
+de100_file_scoped_fn void headless_run_child(u32 instance_index,
+                                             u32 instance_count, int fd) {
+#if defined(__linux__)
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+  CPU_SET(instance_index % work_queue_get_core_count(), &cpus);
+  sched_setaffinity(0, sizeof(cpus), &cpus);
+#endif
+
+  // N engines' init logs would bury the summary; errors still show
+  if (!freopen("/dev/null", "w", stdout)) {
+    fprintf(stderr, "⚠️  Instance %u keeps its stdout\n", instance_index);
+  }
+
+  HeadlessReport report;
+  headless_run(instance_index, instance_count, &report);
+  ssize_t written = write(fd, &report, sizeof(report));
+  close(fd);
+  _exit(written == (ssize_t)sizeof(report) ? report.exit_code : 1);
+}
+
+de100_file_scoped_fn int headless_run_instances(u32 instance_count) {
+  pid_t pids[HEADLESS_MAX_INSTANCES];
+  int fds[HEADLESS_MAX_INSTANCES];
+  if (instance_count > HEADLESS_MAX_INSTANCES) {
+    instance_count = HEADLESS_MAX_INSTANCES;
+  }
+
+  printf("[HEADLESS] 🧪 Running %u instances\n", instance_count);
+  fflush(stdout); // Or every child flushes a copy of it
+
+  u32 started = 0;
+  for (; started < instance_count; ++started) {
+    int pipe_fds[2];
+    if (pipe(pipe_fds) != 0) {
+      break;
+    }
+    pid_t pid = fork();
+    if (pid < 0) {
+      close(pipe_fds[0]);
+      close(pipe_fds[1]);
+      break;
+    }
+    if (pid == 0) {
+      close(pipe_fds[0]);
+      for (u32 i = 0; i < started; ++i) {
+        close(fds[i]);
+      }
+      headless_run_child(started, instance_count, pipe_fds[1]);
+    }
+    close(pipe_fds[1]);
+    pids[started] = pid;
+    fds[started] = pipe_fds[0];
+  }
+  if (started < instance_count) {
+    fprintf(stderr, "⚠️  Started only %u of %u instances\n", started,
+            instance_count);
+  }
+
+  printf("[HEADLESS] instance   frames     mean      p50      p95      p99"
+         "      max  hash\n");
+  bool ok = started > 0;
+  bool hashes_match = true;
+  u64 first_hash = 0;
+  for (u32 i = 0; i < started; ++i) {
+    HeadlessReport report = {.exit_code = 1};
+    bool received = read(fds[i], &report, sizeof(report)) ==
+                    (ssize_t)sizeof(report);
+    close(fds[i]);
+    int status = 0;
+    waitpid(pids[i], &status, 0);
+
+    if (!received || report.exit_code != 0 || !WIFEXITED(status) ||
+        WEXITSTATUS(status) != 0) {
+      printf("[HEADLESS] %8u   failed\n", i);
+      ok = false;
+      continue;
+    }
+
+    if (i == 0) {
+      first_hash = report.state_hash;
+    }
+    hashes_match = hashes_match && report.state_hash == first_hash;
+    printf("[HEADLESS] %8u %8lu %8.3f %8.3f %8.3f %8.3f %8.3f  %016llx\n", i,
+           (unsigned long)report.frame_count, (f64)report.update.mean_ms,
+           (f64)report.update.p50_ms, (f64)report.update.p95_ms,
+           (f64)report.update.p99_ms, (f64)report.update.max_ms,
+           (unsigned long long)report.state_hash);
+  }
+
+  if (!ok) {
+    printf("[HEADLESS] ❌ Some instances failed\n");
+    return 1;
+  }
+  if (!hashes_match) {
+    printf("[HEADLESS] ❌ State hashes differ: the run is not deterministic\n");
+    return 1;
+  }
+  printf("[HEADLESS] ✅ All %u instances agree\n", started);
+  return 0;
+}
+#endif
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Main Platform Entry Point
+// ═══════════════════════════════════════════════════════════════════════════
+
+int platform_main(void) {
+  const char *instances = headless_env("DE100_HEADLESS_INSTANCES");
+  u32 instance_count = instances ? (u32)strtoul(instances, NULL, 10) : 1;
+  if (instance_count == 0) {
+    instance_count = work_queue_get_core_count();
+  }
+
+#if !defined(_WIN32)
+  if (instance_count > 1) {
+    return headless_run_instances(instance_count);
+  }
+#else
+  if (instance_count > 1) {
+    fprintf(stderr, "⚠️  DE100_HEADLESS_INSTANCES needs fork(); running one\n");
+  }
+#endif
+
+  HeadlessReport report;
+  return headless_run(0, 1, &report);
+}
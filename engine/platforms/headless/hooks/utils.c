@@ -0,0 +1,17 @@
+#include "../../_common/hooks/utils.h"
+#include "../../../game/base.h"
+
+// ═══════════════════════════════════════════════════════════════════════
+// Simulated clock: headless runs as fast as it can, but the game must see
+// the same time step it would live, or runs stop being reproducible.
+// ═══════════════════════════════════════════════════════════════════════
+
+void de100_set_target_fps(u32 fps) { g_fps = fps; }
+
+f32 de100_get_frame_time(void) { return g_fps ? 1.0f / (f32)g_fps : 0.0f; }
+
+f64 de100_get_time(void) {
+  return g_fps ? (f64)g_frame_counter / (f64)g_fps : 0.0;
+}
+
+u32 de100_get_fps(void) { return g_fps; }
@@ -10,6 +10,31 @@
 
 RaylibSoundOutput g_raylib_audio_output = {0};
 
+// ═══════════════════════════════════════════════════════════════════════════
+// 🔊 STREAM CALLBACK (miniaudio's device thread)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// Sole consumer of the ring. Must fill every frame asked for, so a short
+// ring becomes a gap of silence (counted) rather than a stall. No locks,
+// no allocation, no printing: this runs on the real-time thread.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn void raylib_audio_callback(void *buffer_data,
+                                                unsigned int frames) {
+  RaylibSoundOutput *output = &g_raylib_audio_output;
+  i16 *out = (i16 *)buffer_data;
+
+  u32 read = de100_audio_ring_read(&output->ring, out, frames);
+  if (read < frames) {
+    de100_mem_set(out + (size_t)read * DE100_AUDIO_RING_CHANNELS, 0,
+                  (size_t)(frames - read) * sizeof(i16) *
+                      DE100_AUDIO_RING_CHANNELS);
+    __atomic_add_fetch(&output->ring_underrun_count, 1, __ATOMIC_RELAXED);
+  }
+  __atomic_add_fetch(&output->frames_played, (u64)frames, __ATOMIC_RELAXED);
+}
+
 // ═══════════════════════════════════════════════════════════════════════════
 // 🔊 INITIALIZE AUDIO SYSTEM
 // ═══════════════════════════════════════════════════════════════════════════
@@ -21,11 +46,13 @@ RaylibSoundOutput g_raylib_audio_output = {0};
 //   - You calculate how much to write based on cursor positions
 //   - Write whenever you want, as long as you don't overrun
 //
-// Raylib Model:
-//   - Double-buffered internally
-//   - IsAudioStreamProcessed() returns true when a buffer is consumed
-//   - You write EXACTLY buffer_size_frames samples when called
-//   - If you try to write when buffer is full, it's rejected
+// Raylib Model (callback):
+//   - miniaudio's device thread calls raylib_audio_callback() whenever
+//     the device wants a period; it drains our ring
+//   - The game loop only tops the ring up to latency + safety frames,
+//     the same target and the same ring as the X11 audio thread
+//   - UpdateAudioStream()/IsAudioStreamProcessed() are no longer used:
+//     they refill in whole-buffer steps, locked to the frame rate
 //
 // ═══════════════════════════════════════════════════════════════════════════
 bool raylib_init_audio(GameAudioOutputBuffer *audio_output,
@@ -47,18 +74,22 @@ bool raylib_init_audio(GameAudioOutputBuffer *audio_output,
   printf("✅ Audio: Device initialized\n");
 
   i32 samples_per_frame = samples_per_second / game_update_hz;
-  i32 buffer_size = samples_per_frame * 2; // ~2 frames
+  i32 latency_sample_count = samples_per_frame * FRAMES_OF_AUDIO_LATENCY;
+  i32 safety_sample_count = samples_per_frame / 3;
 
-  if (buffer_size < 512)
-    buffer_size = 512;
-  if (buffer_size > 4096)
-    buffer_size = 4096;
+  // Stream buffer = device period (~10ms); the ring holds the latency
+  i32 buffer_size = samples_per_second / 100;
+  if (buffer_size < 256)
+    buffer_size = 256;
 
   printf("[AUDIO] Samples per frame: %d (at %d Hz game logic)\n",
          samples_per_frame, game_update_hz);
-  printf("[AUDIO] Buffer size: %d samples (%.1f ms, ~%.1f frames)\n",
-         buffer_size, (float)buffer_size / samples_per_second * 1000.0f,
-         (float)buffer_size / samples_per_frame);
+  printf("[AUDIO] Latency: %d samples (%.1f ms) + safety %d\n",
+         latency_sample_count,
+         (float)latency_sample_count / samples_per_second * 1000.0f,
+         safety_sample_count);
+  printf("[AUDIO] Stream period: %d samples (%.1f ms)\n", buffer_size,
+         (float)buffer_size / samples_per_second * 1000.0f);
 
   // ───────
   // Store sample rate so game can read it back if needed
@@ -109,11 +140,56 @@ bool raylib_init_audio(GameAudioOutputBuffer *audio_output,
     return false;
   }
 
+  g_raylib_audio_output.sample_buffer_size = buffer_bytes;
+
   printf("✅ Audio: Sample buffer allocated (%d bytes)\n",
          g_raylib_audio_output.sample_buffer_size);
 
-  g_raylib_audio_output.sample_buffer_size = buffer_bytes;
+  // Ring: the deepest target plus a full max-size submission, sized like
+  // the X11 audio thread's
+  u32 max_submit = (audio_output && audio_output->max_sample_count > 0)
+                       ? (u32)audio_output->max_sample_count
+                       : (u32)(samples_per_frame * 3);
+  u32 wanted = (u32)(samples_per_second / 4) + max_submit;
+  u32 capacity = 1;
+  while (capacity < wanted) {
+    capacity <<= 1;
+  }
+  g_raylib_audio_output.ring_memory =
+      de100_memory_alloc(NULL, (size_t)capacity * (u32)bytes_per_sample,
+                         De100_MEMORY_FLAG_READ | De100_MEMORY_FLAG_WRITE |
+                             De100_MEMORY_FLAG_ZEROED);
+  if (!de100_memory_is_valid(g_raylib_audio_output.ring_memory)) {
+    fprintf(stderr, "❌ Audio: Failed to allocate ring\n");
+    de100_memory_free(&g_raylib_audio_output.sample_buffer);
+    UnloadAudioStream(g_raylib_audio_output.stream);
+    CloseAudioDevice();
+    if (audio_output)
+      audio_output->is_initialized = false;
+    return false;
+  }
 
+  de100_audio_ring_init(&g_raylib_audio_output.ring,
+                        (i16 *)g_raylib_audio_output.ring_memory.base,
+                        capacity);
+  g_raylib_audio_output.latency_sample_count = latency_sample_count;
+  g_raylib_audio_output.safety_sample_count = safety_sample_count;
+  g_raylib_audio_output.ring_underrun_count = 0;
+  g_raylib_audio_output.frames_played = 0;
+
+  // Head start of silence, as the ALSA path primes its device
+  for (u32 lead = (u32)latency_sample_count; lead > 0;) {
+    u32 chunk = lead < (u32)buffer_size ? lead : (u32)buffer_size;
+    de100_audio_ring_write(&g_raylib_audio_output.ring,
+                           (i16 *)g_raylib_audio_output.sample_buffer.base,
+                           chunk);
+    lead -= chunk;
+  }
+
+  printf("✅ Audio: Ring allocated (%u frames)\n", capacity);
+
+  // Before playing: the callback replaces UpdateAudioStream entirely
+  SetAudioStreamCallback(g_raylib_audio_output.stream, raylib_audio_callback);
   PlayAudioStream(g_raylib_audio_output.stream);
   if (audio_output)
     audio_output->is_initialized = true;
@@ -126,20 +202,26 @@ bool raylib_init_audio(GameAudioOutputBuffer *audio_output,
 // ═══════════════════════════════════════════════════════════════════════════
 // 🔊 QUERY SAMPLES TO WRITE
 // ═══════════════════════════════════════════════════════════════════════════
-// FIXED: Write audio EVERY frame to keep buffer full, not just when empty.
-// Raylib's internal buffer needs continuous feeding.
+// Top the ring up to latency + safety, every frame, whatever the callback
+// has consumed since (so sample_count varies frame to frame, as on ALSA).
 // ═══════════════════════════════════════════════════════════════════════════
 u32 raylib_get_samples_to_write(GameAudioOutputBuffer *audio_output) {
   if (!audio_output->is_initialized || !g_raylib_audio_output.stream_valid) {
     return 0;
   }
 
-  // Check if ANY buffer is ready
-  if (!IsAudioStreamProcessed(g_raylib_audio_output.stream)) {
-    return 0;
+  i32 target = g_raylib_audio_output.latency_sample_count +
+               g_raylib_audio_output.safety_sample_count;
+  i32 queued = (i32)de100_audio_ring_fill(&g_raylib_audio_output.ring);
+  i32 to_write = target - queued;
+  if (to_write < 0) {
+    to_write = 0;
   }
-
-  return g_raylib_audio_output.buffer_size_frames;
+  if (audio_output->max_sample_count > 0 &&
+      to_write > audio_output->max_sample_count) {
+    to_write = audio_output->max_sample_count;
+  }
+  return (u32)to_write;
 }
 
 // ═══════════════════════════════════════════════════════════════════════════
@@ -160,12 +242,14 @@ void raylib_send_samples(GameAudioOutputBuffer *audio_output) {
     PlayAudioStream(g_raylib_audio_output.stream);
   }
 
-  // Send samples to Raylib
-  UpdateAudioStream(g_raylib_audio_output.stream, audio_output->samples,
-                    audio_output->sample_count);
+  // The callback picks these up on its next period
+  u32 written = de100_audio_ring_write(&g_raylib_audio_output.ring,
+                                       audio_output->samples,
+                                       (u32)audio_output->sample_count);
 
   // Track total written for debug overlay
-  g_raylib_audio_output.total_samples_written += audio_output->sample_count;
+  g_raylib_audio_output.total_samples_written += written;
+  g_raylib_audio_output.writes_this_period++;
 }
 
 // ═══════════════════════════════════════════════════════════════════════════
@@ -177,17 +261,15 @@ void raylib_clear_audio_buffer(GameAudioOutputBuffer *audio_output) {
     return;
   }
 
-  // Only send silence if buffer is ready
-  if (IsAudioStreamProcessed(g_raylib_audio_output.stream)) {
-    const i32 bytes_per_sample = (i32)(sizeof(i16) * 2);
-    de100_mem_set(g_raylib_audio_output.sample_buffer.base, 0,
-                  (u32)g_raylib_audio_output.buffer_size_frames *
-                      (u32)bytes_per_sample);
+  // One period of silence into the ring
+  const i32 bytes_per_sample = (i32)(sizeof(i16) * 2);
+  de100_mem_set(g_raylib_audio_output.sample_buffer.base, 0,
+                (u32)g_raylib_audio_output.buffer_size_frames *
+                    (u32)bytes_per_sample);
 
-    UpdateAudioStream(g_raylib_audio_output.stream,
-                      g_raylib_audio_output.sample_buffer.base,
-                      g_raylib_audio_output.buffer_size_frames);
-  }
+  de100_audio_ring_write(&g_raylib_audio_output.ring,
+                         (i16 *)g_raylib_audio_output.sample_buffer.base,
+                         g_raylib_audio_output.buffer_size_frames);
 }
 
 // ═══════════════════════════════════════════════════════════════════════════
@@ -220,7 +302,7 @@ void raylib_debug_audio_latency(GameAudioOutputBuffer *audio_output) {
          "\u2500\u2500\u2500\u2500\u2500\u2500\u2500\u2500\u2500\u2500\u2500"
          "\u2500\u2500\u2500\u2500\u2500\u2500\u2500\u2500\u2500\u2500\u2500"
          "\u2500\u2500\u2500\u2500\u2500\u2500\u2500\u2500\u2500\u2524\n");
-  printf("\u2502 Mode: Double-buffered (Raylib internal)                     "
+  printf("\u2502 Mode: Stream callback pulling from a lock-free ring         "
          "\u2502\n");
   printf("\u2502                                                             "
          "\u2502\n");
@@ -246,9 +328,13 @@ void raylib_debug_audio_latency(GameAudioOutputBuffer *audio_output) {
   printf("\u2502 Stream ready:       %-3s                                    "
          "\u2502\n",
          IsAudioStreamValid(g_raylib_audio_output.stream) ? "Yes" : "No");
-  printf("\u2502 Stream processed:   %-3s (buffer needs fill)                "
+  printf("\u2502 Ring queued:        %6u frames                           "
+         "\u2502\n",
+         de100_audio_ring_fill(&g_raylib_audio_output.ring));
+  printf("\u2502 Ring underruns:     %6llu                                  "
          "\u2502\n",
-         IsAudioStreamProcessed(g_raylib_audio_output.stream) ? "Yes" : "No");
+         (unsigned long long)__atomic_load_n(
+             &g_raylib_audio_output.ring_underrun_count, __ATOMIC_RELAXED));
   printf("\u2502 Stream playing:     %-3s                                    "
          "\u2502\n",
          IsAudioStreamPlaying(g_raylib_audio_output.stream) ? "Yes" : "No");
@@ -279,11 +365,13 @@ void raylib_shutdown_audio(GameAudioOutputBuffer *audio_output) {
     g_raylib_audio_output.stream_valid = false;
   }
 
+  // Device closed before the ring goes: no callback can still be reading
+  CloseAudioDevice();
+
   if (de100_memory_is_valid(g_raylib_audio_output.sample_buffer)) {
     de100_memory_free(&g_raylib_audio_output.sample_buffer);
   }
-
-  CloseAudioDevice();
+  de100_memory_free(&g_raylib_audio_output.ring_memory);
 
   audio_output->is_initialized = false;
   audio_output->sample_count = 0;
@@ -297,8 +385,8 @@ void raylib_shutdown_audio(GameAudioOutputBuffer *audio_output) {
 
 void raylib_audio_fps_change_handling(GameAudioOutputBuffer *audio_output) {
   (void)audio_output;
-  // For Raylib, buffer size is fixed at init time
-  // Would need to recreate stream to change it
+  // The stream period is fixed at init time and the ring target was sized
+  // from the audio update rate, which this doesn't change
   printf("[AUDIO] Note: FPS change doesn't affect Raylib audio buffer size\n");
 }
 
@@ -317,9 +405,9 @@ void raylib_audio_fps_change_handling(GameAudioOutputBuffer *audio_output) {
 │  │           ▲ Write Cursor│          │  │  ??? (hidden)          │         │
 │  └────────────────────────┘          │  └────────────────────────┘         │
 │                                      │                                      │
-│  You can query:                      │  You can only ask:                  │
-│  - snd_pcm_delay()                   │  - IsAudioStreamProcessed()         │
-│  - snd_pcm_avail()                   │    (true/false, no position info)   │
+│  You can query:                      │  You can ask (callback mode):       │
+│  - snd_pcm_delay()                   │  - ring fill (what we queued)       │
+│  - snd_pcm_avail()                   │  - frames_played (callback count)   │
 │  - Calculate exact positions         │                                      │
 │                                      │                                      │
 │  Debug markers SHOW:                 │  Debug markers would show:           │
@@ -336,13 +424,21 @@ void raylib_debug_audio_overlay(void) {
     return;
 
   char stats[256];
+  // Queued in the ring plus the period the device is playing
+  u32 queued = de100_audio_ring_fill(&g_raylib_audio_output.ring) +
+               g_raylib_audio_output.buffer_size_frames;
   snprintf(stats, sizeof(stats),
            "Audio: %lld samples written | %d writes/period | %.1f ms latency "
            "estimate",
            (long long)g_raylib_audio_output.total_samples_written,
            g_raylib_audio_output.writes_this_period,
-           (float)g_raylib_audio_output.buffer_size_frames / 48000.0f *
+           (float)queued / (float)g_raylib_audio_output.stream.sampleRate *
                1000.0f);
 
   DrawText(stats, 10, 10, 16, GREEN);
 }
+
+u64 raylib_audio_underrun_count(void) {
+  return __atomic_load_n(&g_raylib_audio_output.ring_underrun_count,
+                         __ATOMIC_RELAXED);
+}
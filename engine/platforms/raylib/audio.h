@@ -4,6 +4,7 @@
 #include "../../_common/base.h"
 #include "../../_common/memory.h"
 #include "../../game/audio.h"
+#include "../_common/audio-ring.h"
 #include <raylib.h>
 #include <stdbool.h>
 #include <stdint.h>
@@ -11,6 +12,17 @@
 // ═══════════════════════════════════════════════════════════════════════════
 // 🔊 RAYLIB SOUND OUTPUT STATE
 // ═══════════════════════════════════════════════════════════════════════════
+//
+// Pull model, same shape as the X11 audio thread:
+//
+//   main thread                          miniaudio's device thread
+//   get_audio_samples ─▶ ring (SPSC) ─▶ raylib_audio_callback, which fills
+//   (tops the ring up to                 each device period, padding with
+//    latency + safety frames)            silence if the ring runs dry
+//
+// The stream's own buffer (buffer_size_frames) only covers the device
+// period, so latency is the ring target, not how often the loop polls.
+// ═══════════════════════════════════════════════════════════════════════════
 
 typedef struct {
   AudioStream stream;
@@ -18,7 +30,16 @@ typedef struct {
   bool stream_playing;
 
   // Buffer configuration
-  u32 buffer_size_frames;
+  u32 buffer_size_frames; // Stream buffer (device period)
+
+  // Write-ahead kept in the ring (Casey's Day 20 latency + safety)
+  i32 latency_sample_count;
+  i32 safety_sample_count;
+
+  De100AudioRing ring;
+  De100MemoryBlock ring_memory;
+  u64 ring_underrun_count; // __atomic: callbacks padded with silence
+  u64 frames_played;       // __atomic: frames handed to the device
 
   // Sample buffer for game to fill
   De100MemoryBlock sample_buffer;
@@ -60,4 +81,7 @@ void raylib_debug_audio_latency(GameAudioOutputBuffer *audio_output);
 void raylib_audio_fps_change_handling(GameAudioOutputBuffer *audio_output);
 void raylib_debug_audio_overlay(void);
 
+/** Callbacks padded with silence so far. */
+u64 raylib_audio_underrun_count(void);
+
 #endif // DE100_PLATFORMS_RAYLIB_AUDIO_H
@@ -1,12 +1,25 @@
 #include "../_common/backend.h"
 #include "../../_common/base.h"
+#include "../../_common/log.h"
 #include "../../engine.h"
 #include "../../game/backbuffer.h"
 #include "../../game/base.h"
 #include "../../game/game-loader.h"
 #include "../../game/inputs.h"
 #include "../_common/adaptive-fps.h"
+#include "../_common/capture.h"
+#include "../_common/debug-overlay.h"
+#include "../_common/dynamic-resolution.h"
+#include "../_common/fixed-timestep.h"
+#include "../_common/flight-recorder.h"
+#include "../_common/frame-graph.h"
+#include "../_common/frame-stats.h"
+#include "../_common/frame-timing.h"
 #include "../_common/inputs-recording.h"
+#include "../_common/present-scale.h"
+#include "../_common/spectate.h"
+#include "../_common/telemetry.h"
+#include "../_common/trace-export.h"
 #include "./audio.h"
 #include "./hooks/inputs/joystick.h"
 #include "./hooks/inputs/keyboard.h"
@@ -17,20 +30,73 @@
 #include <stdint.h>
 #include <stdio.h>
 
-#if DE100_INTERNAL
-#include "../_common/frame-stats.h"
+// raylib textures have no BGRA layout: R8G8B8A8 is the only zero-conversion
+// upload, so that is the only backbuffer format this backend accepts
+#if DE100_PIXEL_FORMAT != DE100_PIXEL_FORMAT_RGBA8
+#error "raylib backend needs DE100_PIXEL_FORMAT_RGBA8"
 #endif
 
+
 // ═══════════════════════════════════════════════════════════════════════════
 // State
 // ═══════════════════════════════════════════════════════════════════════════
 
+// ─────────────────────────────────────────────────────────────────────────────
+// Texture ring (GameConfig.prefer_present_texture_ring)
+// ─────────────────────────────────────────────────────────────────────────────
+//
+// With one texture, UpdateTexture() overwrites pixels the GPU may still be
+// sampling for the previous frame: the driver either stalls the upload or
+// copies behind our back. A ring gives every frame in flight its own:
+//
+//   frame N    upload → textures[0], draw 0
+//   frame N+1  upload → textures[1], draw 1   (0 may still be on the GPU)
+//   frame N+2  upload → textures[2], draw 2
+//
+// raylib has no fence API, so the ring depth is the frame-latency limit:
+// three covers the driver's usual two queued swaps plus the one being
+// built. Pacing then comes from the presents themselves instead of
+// SetTargetFPS(): the swap is issued `target - predicted swap block` after
+// the previous one returned, and the measured swap-to-swap interval is the
+// frame time adaptive FPS sees. When the GPU falls behind, EndDrawing()
+// blocks longer, the prediction grows and the CPU sleeps that much less
+// instead of waiting twice.
+//
+// ─────────────────────────────────────────────────────────────────────────────
+
+#define RAYLIB_PRESENT_RING_SIZE 3
+
 typedef struct {
-  Texture2D texture;
+  Texture2D textures[RAYLIB_PRESENT_RING_SIZE];
+  u32 texture_count; // 1 without the ring
+  u32 write_index;   // Texture the next frame uploads into
   bool has_texture;
+  // UpdateTextureRec() wants tightly packed pixels, so dirty rects are
+  // gathered here first
+  De100MemoryBlock dirty_staging;
 } BackBufferMeta;
 
+typedef struct {
+  bool enabled;
+  f64 last_present_seconds;  // When EndDrawing() last returned (0 = never)
+  f32 swap_predict_seconds;  // Expected EndDrawing() block (back-pressure)
+  f32 last_interval_seconds; // Measured present-to-present
+} PresentPacing;
+
+#define PRESENT_SWAP_LEAD_MAX_FRACTION 0.5f // Of the target frame time
+
 de100_file_scoped_global_var BackBufferMeta g_game_buffer_meta = {0};
+de100_file_scoped_global_var PresentPacing g_present_pacing = {0};
+
+de100_file_scoped_fn inline void unload_textures(void) {
+  if (!g_game_buffer_meta.has_texture) {
+    return;
+  }
+  for (u32 i = 0; i < g_game_buffer_meta.texture_count; ++i) {
+    UnloadTexture(g_game_buffer_meta.textures[i]);
+  }
+  g_game_buffer_meta.has_texture = false;
+}
 
 // ═══════════════════════════════════════════════════════════════════════════
 // Backbuffer Management
@@ -38,10 +104,11 @@ de100_file_scoped_global_var BackBufferMeta g_game_buffer_meta = {0};
 
 de100_file_scoped_fn inline void resize_back_buffer(GameBackBuffer *backbuffer,
                                                     int width, int height) {
-  printf("Resizing backbuffer → %dx%d\n", width, height);
+  DE100_LOG_DEBUG(DE100_LOG_RENDER, "Resizing backbuffer → %dx%d", width,
+                  height);
 
   if (width <= 0 || height <= 0) {
-    printf("⚠️  Rejected resize: invalid size\n");
+    DE100_LOG_WARN(DE100_LOG_RENDER, "Rejected resize: invalid size");
     return;
   }
 
@@ -58,10 +125,7 @@ de100_file_scoped_fn inline void resize_back_buffer(GameBackBuffer *backbuffer,
     de100_memory_realloc(&backbuffer->memory, buffer_size, 1);
   }
 
-  if (g_game_buffer_meta.has_texture) {
-    UnloadTexture(g_game_buffer_meta.texture);
-    g_game_buffer_meta.has_texture = false;
-  }
+  unload_textures();
 
   Image img = {.data = backbuffer->memory.base,
                .width = backbuffer->width,
@@ -69,35 +133,128 @@ de100_file_scoped_fn inline void resize_back_buffer(GameBackBuffer *backbuffer,
                .format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8,
                .mipmaps = 1};
 
-  g_game_buffer_meta.texture = LoadTextureFromImage(img);
+  g_game_buffer_meta.texture_count =
+      g_present_pacing.enabled ? RAYLIB_PRESENT_RING_SIZE : 1;
+  g_game_buffer_meta.write_index = 0;
+  for (u32 i = 0; i < g_game_buffer_meta.texture_count; ++i) {
+    g_game_buffer_meta.textures[i] = LoadTextureFromImage(img);
+  }
   g_game_buffer_meta.has_texture = true;
 
-  printf("✅ Raylib texture created successfully\n");
+  if (de100_memory_is_valid(g_game_buffer_meta.dirty_staging)) {
+    de100_memory_free(&g_game_buffer_meta.dirty_staging);
+  }
+  if (backbuffer->dirty.is_tracking && !g_present_pacing.enabled) {
+    g_game_buffer_meta.dirty_staging = de100_memory_alloc(
+        NULL, (size_t)width * height * backbuffer->bytes_per_pixel,
+        De100_MEMORY_FLAG_READ | De100_MEMORY_FLAG_WRITE);
+  }
+  de100_backbuffer_mark_all_dirty(backbuffer);
+
+  printf("✅ Raylib texture%s created successfully (%u)\n",
+         g_game_buffer_meta.texture_count > 1 ? " ring" : "",
+         g_game_buffer_meta.texture_count);
 }
 
 de100_file_scoped_fn inline void
-update_window_from_backbuffer(GameBackBuffer *backbuffer) {
+update_window_from_backbuffer(GameBackBuffer *backbuffer,
+                              const GameConfig *config) {
   if (!g_game_buffer_meta.has_texture ||
       !de100_memory_is_valid(backbuffer->memory)) {
     return;
   }
 
-  int window_width = GetScreenWidth();
-  int window_height = GetScreenHeight();
+  // Centered at native size, or stretched and letterboxed (raylib
+  // textures default to point filtering, so scaling stays blocky)
+  PresentScaleRect rect =
+      present_scale_compute(config, backbuffer->width, backbuffer->height,
+                            GetScreenWidth(), GetScreenHeight());
+  present_scale_set_current(rect);
+
+  // Ring textures are a frame or more behind, so only the single texture
+  // can take just this frame's dirty rects
+  Texture2D texture =
+      g_game_buffer_meta.textures[g_game_buffer_meta.write_index];
+  g_game_buffer_meta.write_index =
+      (g_game_buffer_meta.write_index + 1) % g_game_buffer_meta.texture_count;
+
+  GameDirtyRegion *dirty = &backbuffer->dirty;
+  if (dirty->is_tracking && !dirty->full_frame &&
+      g_game_buffer_meta.texture_count == 1 &&
+      de100_memory_is_valid(g_game_buffer_meta.dirty_staging)) {
+    u8 *staging = (u8 *)g_game_buffer_meta.dirty_staging.base;
+    for (int i = 0; i < dirty->count; ++i) {
+      De100DirtyRect *rect = &dirty->rects[i];
+      int row_bytes = rect->width * backbuffer->bytes_per_pixel;
+      u8 *src = (u8 *)backbuffer->memory.base + rect->y * backbuffer->pitch +
+                rect->x * backbuffer->bytes_per_pixel;
+      for (int y = 0; y < rect->height; ++y) {
+        de100_mem_copy(staging + y * row_bytes, src, row_bytes);
+        src += backbuffer->pitch;
+      }
+
+      Rectangle rec = {(float)rect->x, (float)rect->y, (float)rect->width,
+                       (float)rect->height};
+      UpdateTextureRec(texture, rec, staging);
+    }
+  } else {
+    UpdateTexture(texture, backbuffer->memory.base);
+  }
+  de100_backbuffer_clear_dirty(backbuffer);
+
+  // ClearBackground(BLACK) already clears the whole window (and the bars)
+  Rectangle source = {0.0f, 0.0f, (float)backbuffer->width,
+                      (float)backbuffer->height};
+  Rectangle destination = {(float)rect.x, (float)rect.y, (float)rect.width,
+                           (float)rect.height};
+  DrawTexturePro(texture, source, destination, (Vector2){0.0f, 0.0f}, 0.0f,
+                 WHITE);
+}
 
-  // Center the backbuffer in the window
-  int offset_x = (window_width - backbuffer->width) / 2;
-  int offset_y = (window_height - backbuffer->height) / 2;
+// ═══════════════════════════════════════════════════════════════════════════
+// Present Pacing
+// ═══════════════════════════════════════════════════════════════════════════
 
-  // Or fixed offset like Casey:
-  // int offset_x = 10;
-  // int offset_y = 10;
+/**
+ * Sleep until the swap is due, swap, and measure it. Call after the frame's
+ * draw calls; replaces EndDrawing().
+ */
+de100_file_scoped_fn void present_paced(GameConfig *config) {
+  PresentPacing *pacing = &g_present_pacing;
+  f32 target = config->target_seconds_per_frame;
+
+  frame_timing_mark_work_done();
+  f32 swap_lead = pacing->swap_predict_seconds;
+  if (swap_lead > target * PRESENT_SWAP_LEAD_MAX_FRACTION) {
+    swap_lead = target * PRESENT_SWAP_LEAD_MAX_FRACTION;
+  }
+  if (config->prefer_high_res_frame_timer) {
+    frame_timing_wait_until_target(target - swap_lead);
+  } else {
+    frame_timing_sleep_until_target(target - swap_lead);
+  }
 
-  UpdateTexture(g_game_buffer_meta.texture, backbuffer->memory.base);
+  f64 swap_start = GetTime();
+  EndDrawing();
+  f64 present = GetTime();
+
+  // Fast attack, slow decay: one slow swap shouldn't cost a missed frame
+  // twice, and a quiet GPU lets the sleep grow back gradually
+  f32 swap_seconds = (f32)(present - swap_start);
+  if (swap_seconds > pacing->swap_predict_seconds) {
+    pacing->swap_predict_seconds = swap_seconds;
+  } else {
+    pacing->swap_predict_seconds +=
+        (swap_seconds - pacing->swap_predict_seconds) * 0.05f;
+  }
 
-  // ClearBackground(BLACK) already clears the whole window
-  // Just draw the texture at an offset instead of (0, 0)
-  DrawTexture(g_game_buffer_meta.texture, offset_x, offset_y, WHITE);
+  frame_timing_end();
+  if (pacing->last_present_seconds > 0.0) {
+    pacing->last_interval_seconds =
+        (f32)(present - pacing->last_present_seconds);
+    frame_timing_use_present_interval(pacing->last_interval_seconds);
+  }
+  pacing->last_present_seconds = present;
 }
 
 // ═══════════════════════════════════════════════════════════════════════════
@@ -107,26 +264,27 @@ update_window_from_backbuffer(GameBackBuffer *backbuffer) {
 de100_file_scoped_fn inline void
 audio_generate_and_send(EngineGameState *game, GameMainCode *game_main_code) {
 
-  // Fill ALL available buffers (Raylib double-buffers internally)
-  for (int i = 0; i < 4; i++) {
-    u32 samples_to_generate = raylib_get_samples_to_write(&game->audio);
+  // Top the ring up once per frame; the stream callback drains it
+  u32 samples_to_generate = raylib_get_samples_to_write(&game->audio);
 #if DE100_INTERNAL
-    if (FRAME_LOG_EVERY_THREE_SECONDS_CHECK) {
-      printf("[AUDIO] samples_to_generate=%d\n", samples_to_generate);
-    }
+  if (FRAME_LOG_EVERY_THREE_SECONDS_CHECK) {
+    DE100_LOG_DEBUG(DE100_LOG_AUDIO, "samples_to_generate=%d",
+                    samples_to_generate);
+  }
 #endif
 
-    if (samples_to_generate == 0)
-      break;
-
-    if (samples_to_generate > (u32)game->audio.max_sample_count) {
-      samples_to_generate = (u32)game->audio.max_sample_count;
-    }
+  if (samples_to_generate == 0)
+    return;
 
-    game->audio.sample_count = (i32)samples_to_generate;
-    game_main_code->functions.get_audio_samples(&game->memory, &game->audio);
-    raylib_send_samples(&game->audio);
+  if (samples_to_generate > (u32)game->audio.max_sample_count) {
+    samples_to_generate = (u32)game->audio.max_sample_count;
   }
+
+  game->audio.sample_count = (i32)samples_to_generate;
+  DE100_GAME_CALL(game_main_code, get_audio_samples)(&game->memory,
+                                                     &game->audio);
+  raylib_send_samples(&game->audio);
+  game->audio.running_sample_index += (u64)game->audio.sample_count;
 }
 
 // ═══════════════════════════════════════════════════════════════════════════
@@ -139,10 +297,22 @@ de100_file_scoped_fn inline int raylib_init(EngineState *engine) {
              engine->game.config.window_title);
   SetWindowState(FLAG_WINDOW_RESIZABLE);
   SetExitKey(KEY_NULL);
-  SetTargetFPS(engine->game.config.target_refresh_rate_hz);
+
+  g_present_pacing = (PresentPacing){
+      .enabled = engine->game.config.prefer_present_texture_ring,
+  };
+  if (g_present_pacing.enabled) {
+    // We sleep before the swap ourselves; raylib's wait would come after it
+    SetTargetFPS(0);
+  } else {
+    SetTargetFPS(engine->game.config.target_refresh_rate_hz);
+  }
 
   printf("✅ Window created\n");
 
+  adaptive_fps_init(&engine->game.config,
+                    (u32)GetMonitorRefreshRate(GetCurrentMonitor()));
+
   raylib_game_initpad(engine->platform.old_inputs->controllers,
                       engine->game.inputs->controllers);
 
@@ -158,97 +328,253 @@ de100_file_scoped_fn inline int raylib_init(EngineState *engine) {
 
   resize_back_buffer(&engine->game.backbuffer, engine->game.backbuffer.width,
                      engine->game.backbuffer.height);
+  dynamic_resolution_init(&engine->game.config, &engine->game.backbuffer);
 
   return 0;
 }
 
 // ═══════════════════════════════════════════════════════════════════════════
-// Main Loop
+// Frame Phases (see frame-graph.h)
 // ═══════════════════════════════════════════════════════════════════════════
+//
+// raylib is single-threaded (window, GL context, input polling), so every
+// phase runs on the main thread, one wave each, in the order the loop
+// always ran them.
+//
 
-int platform_main(void) {
-  EngineState engine = {0};
-  engine.platform.game_main_code = (GameMainCode){0};
-
-  if (engine_init(&engine)) {
-    return 1;
+typedef struct {
+  EngineState *engine;
+
+  // This frame's timing, from input (start) and present (the rest)
+  f64 frame_start_seconds;
+  f32 work_time_ms;
+  f32 frame_time_ms;
+} RaylibFrame;
+
+de100_file_scoped_fn FRAME_GRAPH_PHASE_FN(raylib_phase_input) {
+  (void)graph;
+  RaylibFrame *ctx = (RaylibFrame *)data;
+  EngineState *engine = ctx->engine;
+
+  ctx->frame_start_seconds = GetTime();
+  if (g_present_pacing.enabled) {
+    frame_timing_begin();
   }
-
-  if (raylib_init(&engine) != 0) {
-    engine_shutdown(&engine);
-    return 1;
+  handle_game_reload_check(&engine->platform.game_main_code,
+                           &engine->platform.paths);
+  prepare_input_frame(engine->platform.old_inputs, engine->game.inputs);
+
+  // if (IsWindowResized()) {
+  //   resize_back_buffer(&engine->game.backbuffer, GetScreenWidth(),
+  //                      GetScreenHeight());
+  // }
+
+  handle_keyboard_inputs(&engine->platform, &engine->game);
+  raylib_poll_gamepad(engine->game.inputs);
+  raylib_poll_mouse(engine->game.inputs);
+
+  if (input_recording_is_recording(&engine->platform.memory_state)) {
+    input_recording_record_frame(&engine->platform.memory_state,
+                                 engine->game.inputs);
   }
 
-  engine.platform.game_bootstrap_code.functions.init(
-      &engine.game.thread_context, &engine.game.memory, engine.game.inputs,
-      &engine.game.backbuffer);
+  if (input_recording_is_playing(&engine->platform.memory_state)) {
+    input_recording_playback_frame(&engine->platform.memory_state,
+                                   engine->game.inputs);
+  }
+  return true;
+}
 
-  printf("✅ Entering main loop...\n");
+de100_file_scoped_fn FRAME_GRAPH_PHASE_FN(raylib_phase_update) {
+  (void)graph;
+  EngineState *engine = ((RaylibFrame *)data)->engine;
+  if (!engine_netplay_frame(engine)) {
+    fixed_timestep_run_frame(&engine->game, &engine->platform.game_main_code,
+                             GetFrameTime());
+  }
+  return true;
+}
 
-  while (!WindowShouldClose() && is_game_running) {
-    handle_game_reload_check(&engine.platform.game_main_code,
-                             &engine.platform.paths);
-    prepare_input_frame(engine.platform.old_inputs, engine.game.inputs);
-
-    // if (IsWindowResized()) {
-    //   resize_back_buffer(&engine.game.backbuffer, GetScreenWidth(),
-    //                      GetScreenHeight());
-    // }
-
-    handle_keyboard_inputs(&engine.platform, &engine.game);
-    raylib_poll_gamepad(engine.game.inputs);
-    raylib_poll_mouse(engine.game.inputs);
-
-    if (input_recording_is_recording(&engine.platform.memory_state)) {
-      input_recording_record_frame(&engine.platform.memory_state,
-                                   engine.game.inputs);
-    }
+de100_file_scoped_fn FRAME_GRAPH_PHASE_FN(raylib_phase_audio) {
+  (void)graph;
+  EngineState *engine = ((RaylibFrame *)data)->engine;
+  audio_generate_and_send(&engine->game, &engine->platform.game_main_code);
+  return true;
+}
 
-    if (input_recording_is_playing(&engine.platform.memory_state)) {
-      input_recording_playback_frame(&engine.platform.memory_state,
-                                     engine.game.inputs);
-    }
+de100_file_scoped_fn FRAME_GRAPH_PHASE_FN(raylib_phase_present) {
+  (void)graph;
+  RaylibFrame *ctx = (RaylibFrame *)data;
+  EngineState *engine = ctx->engine;
 
-    engine.platform.game_main_code.functions.update_and_render(
-        &engine.game.thread_context, &engine.game.memory, engine.game.inputs,
-        &engine.game.backbuffer);
+  if (IsKeyPressed(KEY_F12)) {
+    capture_request_screenshot();
+  }
+  capture_frame(&engine->game.backbuffer,
+                engine->game.config.target_seconds_per_frame);
+  spectate_frame(&engine->game.backbuffer);
 
-    audio_generate_and_send(&engine.game, &engine.platform.game_main_code);
+#if DE100_INTERNAL
+  if (IsKeyPressed(KEY_F3)) {
+    debug_overlay_cycle_mode(engine->game.memory.profiler);
+  }
+  debug_overlay_render(&engine->game.backbuffer, &engine->game.memory,
+                       engine->game.config.target_seconds_per_frame);
+#endif
 
-    BeginDrawing();
-    ClearBackground(BLACK);
-    update_window_from_backbuffer(&engine.game.backbuffer);
+  // EndDrawing() both presents and waits for SetTargetFPS(), so sleep
+  // is folded into present here (and work stops before it). Paced, the
+  // sleep comes first and the swap is measured on its own.
+  ctx->work_time_ms =
+      (f32)((GetTime() - ctx->frame_start_seconds) * 1000.0);
+  BeginDrawing();
+  ClearBackground(BLACK);
+  update_window_from_backbuffer(&engine->game.backbuffer,
+                                &engine->game.config);
+  if (g_present_pacing.enabled) {
+    present_paced(&engine->game.config);
+    ctx->work_time_ms = g_frame_timing.work_seconds * 1000.0f;
+    ctx->frame_time_ms = frame_timing_get_ms();
+  } else {
     EndDrawing();
+    ctx->frame_time_ms = GetFrameTime() * 1000.0f;
+  }
+  return true;
+}
 
-    f32 frame_time_ms = GetFrameTime() * 1000.0f;
-    f32 target_frame_time_ms =
-        engine.game.config.target_seconds_per_frame * 1000.0f;
-
-    if (frame_time_ms > (target_frame_time_ms + 5.0f)) {
-      printf("⚠️  MISSED FRAME! %.2fms (target: %.2fms, over by: %.2fms)\n",
-             frame_time_ms, target_frame_time_ms,
-             frame_time_ms - target_frame_time_ms);
-    }
+// Frame bookkeeping and adaptation, then the inputs flip for the next frame
+de100_file_scoped_fn FRAME_GRAPH_PHASE_FN(raylib_phase_end) {
+  (void)graph;
+  RaylibFrame *ctx = (RaylibFrame *)data;
+  EngineState *engine = ctx->engine;
+  f32 frame_time_ms = ctx->frame_time_ms;
+  f32 work_time_ms = ctx->work_time_ms;
+
+  // Presented: the next frame renders at the new size, into new textures
+  if (dynamic_resolution_apply(&engine->game.backbuffer)) {
+    resize_back_buffer(&engine->game.backbuffer, engine->game.backbuffer.width,
+                       engine->game.backbuffer.height);
+  }
+  telemetry_frame(frame_time_ms, engine->game.config.target_seconds_per_frame);
+  if (FRAME_LOG_EVERY_ONE_SECONDS_CHECK) {
+    telemetry_counter(TELEMETRY_COUNTER_AUDIO_UNDERRUNS,
+                      raylib_audio_underrun_count());
+  }
 
 #if DE100_INTERNAL
-    frame_stats_record(frame_time_ms,
-                       engine.game.config.target_seconds_per_frame);
+  frame_stats_record(frame_time_ms,
+                     engine->game.config.target_seconds_per_frame);
+  de100_profiler_end_frame(engine->game.memory.profiler);
+  trace_export_frame(engine->game.memory.profiler);
+  flight_recorder_frame(engine->game.memory.profiler, engine->game.inputs,
+                        frame_time_ms,
+                        engine->game.config.target_seconds_per_frame);
+  if (FRAME_LOG_EVERY_ONE_SECONDS_CHECK) {
+    frame_stats_report_missed();
+  }
 #endif
 
-    g_frame_counter++;
+  g_frame_counter++;
 
 #if DE100_INTERNAL
-    if (FRAME_LOG_EVERY_FIVE_SECONDS_CHECK) {
-      printf("[Raylib] %.2fms/f, %.2df/s (GetFrameTime: %.2fms)\n",
-             frame_time_ms, GetFPS(), GetFrameTime() * 1000.0f);
+  if (FRAME_LOG_EVERY_FIVE_SECONDS_CHECK) {
+    DE100_LOG_DEBUG(DE100_LOG_TIMING,
+                    "%.2fms/f, %.2df/s (GetFrameTime: %.2fms)",
+                    frame_time_ms, GetFPS(), GetFrameTime() * 1000.0f);
+    if (g_present_pacing.enabled) {
+      DE100_LOG_DEBUG(DE100_LOG_TIMING,
+                      "present: %.2fms interval, %.2fms swap predicted",
+                      g_present_pacing.last_interval_seconds * 1000.0f,
+                      g_present_pacing.swap_predict_seconds * 1000.0f);
     }
+  }
 #endif
 
-    if (engine.game.config.prefer_adaptive_fps) {
-      adaptive_fps_update(&engine.game.config, frame_time_ms);
-    }
+  dynamic_resolution_update(&engine->game.config, frame_time_ms,
+                            work_time_ms);
+  if (engine->game.config.prefer_adaptive_fps) {
+    adaptive_fps_update(&engine->game.config, frame_time_ms, work_time_ms);
+  }
+
+  engine_swap_inputs(engine);
+  return true;
+}
 
-    engine_swap_inputs(&engine);
+// One wave per phase, in this order
+de100_file_scoped_fn FrameGraphResult
+raylib_build_frame_graph(FrameGraph *graph, RaylibFrame *ctx) {
+  struct {
+    const char *name;
+    frame_graph_phase_fn *run;
+    i32 stats_phase;
+  } phases[] = {
+      {"input", raylib_phase_input, FRAME_PHASE_INPUT},
+      {"update", raylib_phase_update, FRAME_PHASE_UPDATE},
+      {"audio", raylib_phase_audio, FRAME_PHASE_AUDIO},
+      {"present", raylib_phase_present, FRAME_PHASE_PRESENT},
+      {"end", raylib_phase_end, FRAME_GRAPH_NO_STATS},
+  };
+
+  u32 previous = FRAME_GRAPH_INVALID_PHASE;
+  for (u32 i = 0; i < ArraySize(phases); ++i) {
+    previous = frame_graph_add(
+        graph, (FrameGraphPhase){
+                   .name = phases[i].name,
+                   .run = phases[i].run,
+                   .data = ctx,
+                   .after = previous == FRAME_GRAPH_INVALID_PHASE
+                                ? 0
+                                : FRAME_GRAPH_BIT(previous),
+                   .flags = FRAME_GRAPH_MAIN_THREAD,
+                   .stats_phase = phases[i].stats_phase});
+  }
+  return frame_graph_compile(graph, NULL);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Main Loop
+// ═══════════════════════════════════════════════════════════════════════════
+
+int platform_main(void) {
+  EngineState engine = {0};
+  engine.platform.game_main_code = (GameMainCode){0};
+
+  if (engine_init(&engine)) {
+    return 1;
+  }
+
+  EngineStartupStamp backend_start = engine_startup_now();
+  if (raylib_init(&engine) != 0) {
+    engine_shutdown(&engine);
+    return 1;
+  }
+  engine_startup_phase(&engine, "window + audio", backend_start,
+                       engine_startup_now());
+
+  EngineStartupStamp game_init_start = engine_startup_now();
+  DE100_GAME_CALL(&engine.platform.game_bootstrap_code, init)(
+      &engine.game.thread_context, &engine.game.memory, engine.game.inputs,
+      &engine.game.backbuffer);
+  engine_startup_phase(&engine, "game init", game_init_start,
+                       engine_startup_now());
+  engine_startup_report(&engine);
+
+  printf("✅ Entering main loop...\n");
+
+  RaylibFrame frame = {.engine = &engine};
+  FrameGraph graph = {0};
+  FrameGraphResult compiled = raylib_build_frame_graph(&graph, &frame);
+  if (!compiled.success) {
+    DE100_LOG_ERROR(DE100_LOG_ENGINE, "Frame graph: %s",
+                    frame_graph_strerror(compiled.error_code));
+    is_game_running = false;
+  }
+  frame_graph_log(&graph);
+
+  while (!WindowShouldClose() && is_game_running) {
+    if (!frame_graph_run(&graph)) {
+      break;
+    }
   }
 
 #if DE100_INTERNAL
@@ -261,13 +587,16 @@ int platform_main(void) {
   // Cleanup
   // ═══════════════════════════════════════════════════════════════════
 
+#if DE100_INTERNAL
+  // Before shutdown: the profiler lives in engine allocations
+  de100_profiler_print(engine.game.memory.profiler, 15, true);
+#endif
+
   printf("[%.3fs] Exiting, freeing memory...\n",
          de100_get_wall_clock() - g_initial_game_time_ms);
 #if DE100_SANITIZE_WAVE_1_MEMORY
 
-  if (g_game_buffer_meta.has_texture) {
-    UnloadTexture(g_game_buffer_meta.texture);
-  }
+  unload_textures();
   raylib_shutdown_audio(&engine.game.audio);
   CloseWindow();
 
@@ -280,6 +609,7 @@ int platform_main(void) {
 
 #if DE100_INTERNAL
   frame_stats_print();
+  frame_stats_dump_to_directory(engine.platform.paths.exe_directory.path);
 #endif
 
   printf("Goodbye!\n");
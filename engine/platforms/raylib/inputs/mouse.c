@@ -1,18 +1,65 @@
 #include "./mouse.h"
+#include "../../../_common/time.h"
 #include "../../../game/inputs.h"
+#include "../../_common/present-scale.h"
 
 #include <raylib.h>
 
+// Raylib only exposes polled state, so events are stamped with the poll
+// time: ordered correctly, but without sub-frame precision.
+de100_file_scoped_fn inline void raylib_push_mouse_event(GameInput *input,
+                                                         f64 seconds, u8 kind,
+                                                         u32 code, bool is_down,
+                                                         i32 y) {
+  GameInputEvent event = {
+      .seconds = seconds,
+      .kind = kind,
+      .is_down = is_down,
+      .code = code,
+      .x = (i16)(kind == DE100_INPUT_EVENT_MOUSE_WHEEL ? 0 : input->mouse_x),
+      .y = (i16)y,
+  };
+  de100_input_push_event(input, &event);
+}
+
 void raylib_poll_mouse(GameInput *input) {
+  f64 now = de100_get_wall_clock();
+
   // ─────────────────────────────────────────────────────────────────
   // MOUSE POSITION
   // ─────────────────────────────────────────────────────────────────
   Vector2 mouse_pos = GetMousePosition();
-  input->mouse_x = (i32)mouse_pos.x;
-  input->mouse_y = (i32)mouse_pos.y;
+  i32 mouse_x = (i32)mouse_pos.x;
+  i32 mouse_y = (i32)mouse_pos.y;
+  present_scale_window_to_backbuffer(&mouse_x, &mouse_y);
+  if (mouse_x != input->mouse_x || mouse_y != input->mouse_y) {
+    input->mouse_x = mouse_x;
+    input->mouse_y = mouse_y;
+    raylib_push_mouse_event(input, now, DE100_INPUT_EVENT_MOUSE_MOVE, 0,
+                            false, input->mouse_y);
+  }
+
+  // Motion since last frame. Raylib reports it per frame only; with the
+  // cursor disabled (DisableCursor) GLFW feeds it raw motion
+  Vector2 mouse_delta = GetMouseDelta();
+  input->mouse_dx = mouse_delta.x;
+  input->mouse_dy = mouse_delta.y;
+  if (mouse_delta.x != 0.0f || mouse_delta.y != 0.0f) {
+    GameInputEvent event = {
+        .seconds = now,
+        .kind = DE100_INPUT_EVENT_MOUSE_DELTA,
+        .x = (i16)mouse_delta.x,
+        .y = (i16)mouse_delta.y,
+    };
+    de100_input_push_event(input, &event);
+  }
 
   // Mouse wheel (Raylib returns float, we store as int)
   input->mouse_z = (i32)GetMouseWheelMove();
+  if (input->mouse_z != 0) {
+    raylib_push_mouse_event(input, now, DE100_INPUT_EVENT_MOUSE_WHEEL, 0,
+                            false, input->mouse_z);
+  }
 
   // ─────────────────────────────────────────────────────────────────
   // MOUSE BUTTONS
@@ -51,4 +98,12 @@ void raylib_poll_mouse(GameInput *input) {
   // Extra button (forward/XButton2)
   process_game_button_state(IsMouseButtonDown(MOUSE_BUTTON_EXTRA),
                             &input->mouse_buttons[4]);
+
+  for (u32 b = 0; b < ArraySize(input->mouse_buttons); ++b) {
+    if (input->mouse_buttons[b].half_transition_count > 0) {
+      raylib_push_mouse_event(input, now, DE100_INPUT_EVENT_MOUSE_BUTTON, b,
+                              input->mouse_buttons[b].ended_down,
+                              input->mouse_y);
+    }
+  }
 }
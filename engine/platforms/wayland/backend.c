@@ -0,0 +1,1101 @@
+#define _GNU_SOURCE // memfd_create
+
+#include "../_common/backend.h"
+#include "../../engine.h"
+
+#include "../../_common/base.h"
+#include "../../_common/log.h"
+#include "../../game/backbuffer.h"
+#include "../../game/base.h"
+#include "../../game/config.h"
+#include "../../game/game-loader.h"
+#include "../../game/inputs.h"
+#include "../_common/adaptive-fps.h"
+#include "../_common/capture.h"
+#include "../_common/config.h"
+#include "../_common/debug-overlay.h"
+#include "../_common/fixed-timestep.h"
+#include "../_common/flight-recorder.h"
+#include "../_common/frame-stats.h"
+#include "../_common/frame-timing.h"
+#include "../_common/inputs-recording.h"
+#include "../_common/spectate.h"
+#include "../_common/telemetry.h"
+#include "../_common/trace-export.h"
+#include "../drm/hooks/inputs/keyboard.h"
+#include "../x11/audio.h"
+#include "../x11/hooks/inputs/joystick.h"
+#include "../x11/inputs/evdev.h"
+#include "./protocol/xdg-shell-client-protocol.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/input-event-codes.h>
+#include <poll.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <wayland-client.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// WAYLAND BACKEND (native; no Xwayland copy)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// One memfd-backed wl_shm pool holds WAYLAND_BUFFER_COUNT backbuffer-sized
+// wl_buffers. Each frame uses a buffer the compositor has released:
+//
+//   pick free buffer → game draws → attach + damage_buffer(dirty rects)
+//   → frame callback → commit → wait for the callback (pacing)
+//
+// With GameConfig.prefer_mapped_backbuffer the GameBackBuffer points
+// straight at that buffer, so the compositor reads the pixels the game
+// wrote: no copy on our side. Otherwise the engine's backbuffer is
+// copied in at present.
+//
+// Buffers rotate, so a buffer is several frames behind when it comes
+// back. With dirty-rect tracking (prefer_dirty_rect_present) it is
+// repaired first: the rects damaged since it was last shown are copied
+// from the newest buffer (a per-frame damage history covers that), and
+// only this frame's rects go to wl_surface_damage_buffer. Without
+// tracking, every frame is damaged whole and, when zero-copy, the game
+// must redraw every pixel (the mapped-backbuffer contract).
+//
+// Pacing follows wl_surface.frame callbacks, which the compositor sends
+// when it's a good time to draw. They live on their own event queue
+// (with the buffer release events), so waiting for one never dispatches
+// input between frames; input is dispatched at the top of the frame.
+// A hidden surface gets no callbacks: after a frame's worth of waiting
+// the loop falls back to sleep pacing.
+//
+// Key codes are evdev KEY_* as on DRM, so the game's DRM keyboard adapter
+// (drm_handle_key) serves both. Audio and gamepads are the X11 backend's
+// ALSA and evdev code.
+//
+// xdg-shell glue is generated by wayland-scanner at build time (see
+// build-common.sh) into platforms/wayland/protocol/.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define WAYLAND_BUFFER_COUNT 3
+#define WAYLAND_DAMAGE_HISTORY 4 // > WAYLAND_BUFFER_COUNT
+
+#if DE100_PIXEL_FORMAT == DE100_PIXEL_FORMAT_BGRA8
+#define WAYLAND_SHM_FORMAT WL_SHM_FORMAT_XRGB8888 // Bytes B,G,R,X
+#else
+#define WAYLAND_SHM_FORMAT WL_SHM_FORMAT_XBGR8888 // Bytes R,G,B,X
+#endif
+
+typedef struct {
+  struct wl_buffer *buffer;
+  u8 *pixels;
+  bool is_busy; // Attached; the compositor may still read it
+  u64 frame;    // Present count of the frame it holds (0 = never used)
+} WaylandBuffer;
+
+typedef struct {
+  struct wl_display *display;
+  struct wl_registry *registry;
+  struct wl_compositor *compositor;
+  struct wl_shm *shm;
+  struct xdg_wm_base *wm_base;
+  struct wl_seat *seat;
+  struct wl_keyboard *keyboard;
+  struct wl_pointer *pointer;
+
+  struct wl_surface *surface;
+  struct xdg_surface *xdg_surface;
+  struct xdg_toplevel *toplevel;
+  bool is_configured;
+  bool has_shm_format;
+
+  // Frame callbacks + buffer releases (never input)
+  struct wl_event_queue *frame_queue;
+  struct wl_callback *frame_callback;
+  bool has_last_frame_time;
+  u32 last_frame_time_ms;
+  f32 frame_interval_seconds;
+
+  // Backbuffer pool
+  struct wl_shm_pool *pool;
+  int pool_fd;
+  u8 *pool_memory;
+  u64 pool_size;
+  u64 buffer_size;
+  WaylandBuffer buffers[WAYLAND_BUFFER_COUNT];
+  i32 current;    // Buffer this frame draws into (-1 = none picked)
+  i32 last_shown; // Newest attached buffer (-1 = none yet)
+  u64 present_count;
+  GameDirtyRegion damage_history[WAYLAND_DAMAGE_HISTORY];
+
+  bool is_zero_copy;
+  void *backbuffer_original_base;
+
+  EngineState *engine; // For input listeners
+  De100InputClock input_clock;
+
+  LinuxAudioConfig audio_config;
+} WaylandPlatformState;
+
+de100_file_scoped_global_var WaylandPlatformState g_wl = {
+    .pool_fd = -1, .current = -1, .last_shown = -1};
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Event pumping
+// ═══════════════════════════════════════════════════════════════════════════
+
+/**
+ * Read whatever the socket has and dispatch `queue` (NULL = the default
+ * queue, i.e. input and shell events). Waits up to `timeout_ms` for data
+ * (0 = don't wait). Returns false on timeout or a dead connection.
+ */
+de100_file_scoped_fn bool wayland_pump(WaylandPlatformState *wl,
+                                       struct wl_event_queue *queue,
+                                       int timeout_ms) {
+  while ((queue ? wl_display_prepare_read_queue(wl->display, queue)
+                : wl_display_prepare_read(wl->display)) != 0) {
+    if ((queue ? wl_display_dispatch_queue_pending(wl->display, queue)
+               : wl_display_dispatch_pending(wl->display)) < 0) {
+      return false;
+    }
+  }
+  wl_display_flush(wl->display);
+
+  struct pollfd pfd = {.fd = wl_display_get_fd(wl->display),
+                       .events = POLLIN};
+  int ready;
+  do {
+    ready = poll(&pfd, 1, timeout_ms);
+  } while (ready < 0 && errno == EINTR);
+
+  if (ready > 0) {
+    wl_display_read_events(wl->display);
+  } else {
+    wl_display_cancel_read(wl->display);
+  }
+  int dispatched = queue
+                       ? wl_display_dispatch_queue_pending(wl->display, queue)
+                       : wl_display_dispatch_pending(wl->display);
+  return ready > 0 && dispatched >= 0;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Listeners
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn void wm_base_ping(void *data, struct xdg_wm_base *wm_base,
+                                       u32 serial) {
+  (void)data;
+  xdg_wm_base_pong(wm_base, serial);
+}
+
+de100_file_scoped_global_var const struct xdg_wm_base_listener
+    g_wm_base_listener = {.ping = wm_base_ping};
+
+de100_file_scoped_fn void xdg_surface_configure(void *data,
+                                                struct xdg_surface *surface,
+                                                u32 serial) {
+  WaylandPlatformState *wl = (WaylandPlatformState *)data;
+  xdg_surface_ack_configure(surface, serial);
+  wl->is_configured = true;
+}
+
+de100_file_scoped_global_var const struct xdg_surface_listener
+    g_xdg_surface_listener = {.configure = xdg_surface_configure};
+
+// The backbuffer keeps its size; a compositor asking for another one
+// (tiling, maximize) gets ours, drawn 1:1
+de100_file_scoped_fn void toplevel_configure(void *data,
+                                             struct xdg_toplevel *toplevel,
+                                             i32 width, i32 height,
+                                             struct wl_array *states) {
+  (void)data;
+  (void)toplevel;
+  (void)width;
+  (void)height;
+  (void)states;
+}
+
+de100_file_scoped_fn void toplevel_close(void *data,
+                                         struct xdg_toplevel *toplevel) {
+  (void)data;
+  (void)toplevel;
+  is_game_running = false;
+}
+
+de100_file_scoped_global_var const struct xdg_toplevel_listener
+    g_toplevel_listener = {.configure = toplevel_configure,
+                           .close = toplevel_close};
+
+de100_file_scoped_fn void shm_format(void *data, struct wl_shm *shm,
+                                     u32 format) {
+  WaylandPlatformState *wl = (WaylandPlatformState *)data;
+  (void)shm;
+  if (format == WAYLAND_SHM_FORMAT) {
+    wl->has_shm_format = true;
+  }
+}
+
+de100_file_scoped_global_var const struct wl_shm_listener g_shm_listener = {
+    .format = shm_format};
+
+de100_file_scoped_fn void buffer_release(void *data, struct wl_buffer *buffer) {
+  (void)buffer;
+  ((WaylandBuffer *)data)->is_busy = false;
+}
+
+de100_file_scoped_global_var const struct wl_buffer_listener
+    g_buffer_listener = {.release = buffer_release};
+
+de100_file_scoped_fn void frame_done(void *data, struct wl_callback *callback,
+                                     u32 time_ms) {
+  WaylandPlatformState *wl = (WaylandPlatformState *)data;
+  wl_callback_destroy(callback);
+  wl->frame_callback = NULL;
+
+  wl->frame_interval_seconds =
+      wl->has_last_frame_time
+          ? (f32)(u32)(time_ms - wl->last_frame_time_ms) / 1000.0f
+          : 0.0f;
+  wl->last_frame_time_ms = time_ms;
+  wl->has_last_frame_time = true;
+}
+
+de100_file_scoped_global_var const struct wl_callback_listener
+    g_frame_listener = {.done = frame_done};
+
+// ─────────────────────────────────────────────────────────────────────
+// Keyboard (evdev codes; the keymap is the game adapter's business)
+// ─────────────────────────────────────────────────────────────────────
+
+de100_file_scoped_fn void keyboard_keymap(void *data,
+                                          struct wl_keyboard *keyboard,
+                                          u32 format, i32 fd, u32 size) {
+  (void)data;
+  (void)keyboard;
+  (void)format;
+  (void)size;
+  close(fd);
+}
+
+de100_file_scoped_fn void keyboard_enter(void *data,
+                                         struct wl_keyboard *keyboard,
+                                         u32 serial, struct wl_surface *surface,
+                                         struct wl_array *keys) {
+  (void)data;
+  (void)keyboard;
+  (void)serial;
+  (void)surface;
+  (void)keys;
+}
+
+de100_file_scoped_fn void keyboard_leave(void *data,
+                                         struct wl_keyboard *keyboard,
+                                         u32 serial,
+                                         struct wl_surface *surface) {
+  (void)data;
+  (void)keyboard;
+  (void)serial;
+  (void)surface;
+}
+
+de100_file_scoped_fn void keyboard_key(void *data, struct wl_keyboard *keyboard,
+                                       u32 serial, u32 time_ms, u32 key,
+                                       u32 state) {
+  WaylandPlatformState *wl = (WaylandPlatformState *)data;
+  (void)keyboard;
+  (void)serial;
+  EngineState *engine = wl->engine;
+  bool is_down = state == WL_KEYBOARD_KEY_STATE_PRESSED;
+
+  GameInputEvent input_event = {
+      .seconds = de100_input_clock_to_seconds(&wl->input_clock, time_ms,
+                                              de100_get_wall_clock()),
+      .kind = DE100_INPUT_EVENT_KEY,
+      .is_down = is_down,
+      .controller = (u8)KEYBOARD_CONTROLLER_INDEX,
+      .code = key,
+  };
+  de100_input_push_event(engine->game.inputs, &input_event);
+  if (key == KEY_F12 && is_down) {
+    capture_request_screenshot();
+  }
+  drm_handle_key((u16)key, is_down, &engine->game, &engine->platform);
+}
+
+de100_file_scoped_fn void keyboard_modifiers(void *data,
+                                             struct wl_keyboard *keyboard,
+                                             u32 serial, u32 depressed,
+                                             u32 latched, u32 locked,
+                                             u32 group) {
+  (void)data;
+  (void)keyboard;
+  (void)serial;
+  (void)depressed;
+  (void)latched;
+  (void)locked;
+  (void)group;
+}
+
+de100_file_scoped_fn void keyboard_repeat_info(void *data,
+                                               struct wl_keyboard *keyboard,
+                                               i32 rate, i32 delay) {
+  (void)data;
+  (void)keyboard;
+  (void)rate;
+  (void)delay;
+}
+
+de100_file_scoped_global_var const struct wl_keyboard_listener
+    g_keyboard_listener = {
+        .keymap = keyboard_keymap,
+        .enter = keyboard_enter,
+        .leave = keyboard_leave,
+        .key = keyboard_key,
+        .modifiers = keyboard_modifiers,
+        .repeat_info = keyboard_repeat_info,
+};
+
+// ─────────────────────────────────────────────────────────────────────
+// Pointer (surface coordinates = backbuffer pixels, drawn 1:1)
+// ─────────────────────────────────────────────────────────────────────
+
+de100_file_scoped_fn void pointer_set_position(WaylandPlatformState *wl,
+                                               wl_fixed_t fixed_x,
+                                               wl_fixed_t fixed_y,
+                                               f64 seconds) {
+  GameInput *input = wl->engine->game.inputs;
+  i32 x = wl_fixed_to_int(fixed_x);
+  i32 y = wl_fixed_to_int(fixed_y);
+  input->mouse_dx += (f32)(x - input->mouse_x);
+  input->mouse_dy += (f32)(y - input->mouse_y);
+  input->mouse_x = x;
+  input->mouse_y = y;
+
+  GameInputEvent input_event = {
+      .seconds = seconds,
+      .kind = DE100_INPUT_EVENT_MOUSE_MOVE,
+      .x = (i16)x,
+      .y = (i16)y,
+  };
+  de100_input_push_event(input, &input_event);
+}
+
+de100_file_scoped_fn void pointer_enter(void *data, struct wl_pointer *pointer,
+                                        u32 serial, struct wl_surface *surface,
+                                        wl_fixed_t x, wl_fixed_t y) {
+  (void)pointer;
+  (void)serial;
+  (void)surface;
+  pointer_set_position((WaylandPlatformState *)data, x, y,
+                       de100_get_wall_clock());
+}
+
+de100_file_scoped_fn void pointer_leave(void *data, struct wl_pointer *pointer,
+                                        u32 serial,
+                                        struct wl_surface *surface) {
+  (void)data;
+  (void)pointer;
+  (void)serial;
+  (void)surface;
+}
+
+de100_file_scoped_fn void pointer_motion(void *data, struct wl_pointer *pointer,
+                                         u32 time_ms, wl_fixed_t x,
+                                         wl_fixed_t y) {
+  WaylandPlatformState *wl = (WaylandPlatformState *)data;
+  (void)pointer;
+  pointer_set_position(wl, x, y,
+                       de100_input_clock_to_seconds(&wl->input_clock, time_ms,
+                                                    de100_get_wall_clock()));
+}
+
+// evdev buttons → mouse_buttons[] (same layout as X11's)
+de100_file_scoped_fn inline int wayland_mouse_button_index(u32 button) {
+  switch (button) {
+  case BTN_LEFT:
+    return 0;
+  case BTN_MIDDLE:
+    return 1;
+  case BTN_RIGHT:
+    return 2;
+  case BTN_SIDE:
+    return 3;
+  case BTN_EXTRA:
+    return 4;
+  default:
+    return -1;
+  }
+}
+
+de100_file_scoped_fn void pointer_button(void *data, struct wl_pointer *pointer,
+                                         u32 serial, u32 time_ms, u32 button,
+                                         u32 state) {
+  WaylandPlatformState *wl = (WaylandPlatformState *)data;
+  (void)pointer;
+  (void)serial;
+  int index = wayland_mouse_button_index(button);
+  if (index < 0) {
+    return;
+  }
+  GameInput *input = wl->engine->game.inputs;
+  bool is_down = state == WL_POINTER_BUTTON_STATE_PRESSED;
+  process_game_button_state(is_down, &input->mouse_buttons[index]);
+
+  GameInputEvent input_event = {
+      .seconds = de100_input_clock_to_seconds(&wl->input_clock, time_ms,
+                                              de100_get_wall_clock()),
+      .kind = DE100_INPUT_EVENT_MOUSE_BUTTON,
+      .is_down = is_down,
+      .code = (u32)index,
+      .x = (i16)input->mouse_x,
+      .y = (i16)input->mouse_y,
+  };
+  de100_input_push_event(input, &input_event);
+}
+
+de100_file_scoped_fn void pointer_axis(void *data, struct wl_pointer *pointer,
+                                       u32 time_ms, u32 axis,
+                                       wl_fixed_t value) {
+  WaylandPlatformState *wl = (WaylandPlatformState *)data;
+  (void)pointer;
+  if (axis != WL_POINTER_AXIS_VERTICAL_SCROLL || value == 0) {
+    return;
+  }
+  // Positive is down; X11 wheel "up" is +1
+  i32 delta = value < 0 ? 1 : -1;
+  GameInput *input = wl->engine->game.inputs;
+  input->mouse_z += delta;
+
+  GameInputEvent input_event = {
+      .seconds = de100_input_clock_to_seconds(&wl->input_clock, time_ms,
+                                              de100_get_wall_clock()),
+      .kind = DE100_INPUT_EVENT_MOUSE_WHEEL,
+      .y = (i16)delta,
+  };
+  de100_input_push_event(input, &input_event);
+}
+
+de100_file_scoped_global_var const struct wl_pointer_listener
+    g_pointer_listener = {
+        .enter = pointer_enter,
+        .leave = pointer_leave,
+        .motion = pointer_motion,
+        .button = pointer_button,
+        .axis = pointer_axis,
+};
+
+de100_file_scoped_fn void seat_capabilities(void *data, struct wl_seat *seat,
+                                            u32 capabilities) {
+  WaylandPlatformState *wl = (WaylandPlatformState *)data;
+  if ((capabilities & WL_SEAT_CAPABILITY_KEYBOARD) && !wl->keyboard) {
+    wl->keyboard = wl_seat_get_keyboard(seat);
+    wl_keyboard_add_listener(wl->keyboard, &g_keyboard_listener, wl);
+  }
+  if ((capabilities & WL_SEAT_CAPABILITY_POINTER) && !wl->pointer) {
+    wl->pointer = wl_seat_get_pointer(seat);
+    wl_pointer_add_listener(wl->pointer, &g_pointer_listener, wl);
+  }
+}
+
+de100_file_scoped_fn void seat_name(void *data, struct wl_seat *seat,
+                                    const char *name) {
+  (void)data;
+  (void)seat;
+  (void)name;
+}
+
+de100_file_scoped_global_var const struct wl_seat_listener g_seat_listener = {
+    .capabilities = seat_capabilities, .name = seat_name};
+
+de100_file_scoped_fn void registry_global(void *data,
+                                          struct wl_registry *registry,
+                                          u32 name, const char *interface,
+                                          u32 version) {
+  WaylandPlatformState *wl = (WaylandPlatformState *)data;
+  if (strcmp(interface, wl_compositor_interface.name) == 0 && version >= 4) {
+    // v4: wl_surface_damage_buffer
+    wl->compositor = (struct wl_compositor *)wl_registry_bind(
+        registry, name, &wl_compositor_interface, 4);
+  } else if (strcmp(interface, wl_shm_interface.name) == 0) {
+    wl->shm = (struct wl_shm *)wl_registry_bind(registry, name,
+                                                &wl_shm_interface, 1);
+    wl_shm_add_listener(wl->shm, &g_shm_listener, wl);
+  } else if (strcmp(interface, xdg_wm_base_interface.name) == 0) {
+    wl->wm_base = (struct xdg_wm_base *)wl_registry_bind(
+        registry, name, &xdg_wm_base_interface, 1);
+    xdg_wm_base_add_listener(wl->wm_base, &g_wm_base_listener, wl);
+  } else if (strcmp(interface, wl_seat_interface.name) == 0 && !wl->seat) {
+    wl->seat = (struct wl_seat *)wl_registry_bind(
+        registry, name, &wl_seat_interface, version < 4 ? version : 4);
+    wl_seat_add_listener(wl->seat, &g_seat_listener, wl);
+  }
+}
+
+de100_file_scoped_fn void registry_global_remove(void *data,
+                                                 struct wl_registry *registry,
+                                                 u32 name) {
+  (void)data;
+  (void)registry;
+  (void)name;
+}
+
+de100_file_scoped_global_var const struct wl_registry_listener
+    g_registry_listener = {.global = registry_global,
+                           .global_remove = registry_global_remove};
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Buffer pool
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn bool wayland_create_pool(WaylandPlatformState *wl,
+                                              GameBackBuffer *backbuffer) {
+  wl->buffer_size = (u64)backbuffer->pitch * (u64)backbuffer->height;
+  wl->pool_size = wl->buffer_size * WAYLAND_BUFFER_COUNT;
+
+  wl->pool_fd = memfd_create("de100-wl-shm", MFD_CLOEXEC);
+  if (wl->pool_fd < 0 || ftruncate(wl->pool_fd, (off_t)wl->pool_size) != 0) {
+    fprintf(stderr, "❌ Wayland: shm pool allocation failed (%s)\n",
+            strerror(errno));
+    return false;
+  }
+  void *memory = mmap(NULL, (size_t)wl->pool_size, PROT_READ | PROT_WRITE,
+                      MAP_SHARED, wl->pool_fd, 0);
+  if (memory == MAP_FAILED) {
+    fprintf(stderr, "❌ Wayland: shm pool mmap failed (%s)\n",
+            strerror(errno));
+    return false;
+  }
+  wl->pool_memory = (u8 *)memory;
+
+  wl->pool = wl_shm_create_pool(wl->shm, wl->pool_fd, (i32)wl->pool_size);
+  for (u32 i = 0; i < WAYLAND_BUFFER_COUNT; ++i) {
+    WaylandBuffer *buffer = &wl->buffers[i];
+    buffer->pixels = wl->pool_memory + i * wl->buffer_size;
+    buffer->buffer = wl_shm_pool_create_buffer(
+        wl->pool, (i32)(i * wl->buffer_size), backbuffer->width,
+        backbuffer->height, backbuffer->pitch, WAYLAND_SHM_FORMAT);
+    // Releases arrive on the frame queue, with the frame callbacks
+    wl_proxy_set_queue((struct wl_proxy *)buffer->buffer, wl->frame_queue);
+    wl_buffer_add_listener(buffer->buffer, &g_buffer_listener, buffer);
+  }
+  return true;
+}
+
+de100_file_scoped_fn void wayland_destroy_pool(WaylandPlatformState *wl) {
+  for (u32 i = 0; i < WAYLAND_BUFFER_COUNT; ++i) {
+    if (wl->buffers[i].buffer) {
+      wl_buffer_destroy(wl->buffers[i].buffer);
+    }
+    wl->buffers[i] = (WaylandBuffer){0};
+  }
+  if (wl->pool) {
+    wl_shm_pool_destroy(wl->pool);
+    wl->pool = NULL;
+  }
+  if (wl->pool_memory) {
+    munmap(wl->pool_memory, (size_t)wl->pool_size);
+    wl->pool_memory = NULL;
+  }
+  if (wl->pool_fd >= 0) {
+    close(wl->pool_fd);
+    wl->pool_fd = -1;
+  }
+}
+
+/** Copy `rect` (or everything) between two same-layout buffers. */
+de100_file_scoped_fn void wayland_copy_rect(u8 *dest, const u8 *source,
+                                            const GameBackBuffer *backbuffer,
+                                            const De100DirtyRect *rect) {
+  De100DirtyRect all = {0, 0, backbuffer->width, backbuffer->height};
+  if (!rect) {
+    rect = &all;
+  }
+  u64 offset = (u64)rect->y * (u64)backbuffer->pitch +
+               (u64)rect->x * (u64)backbuffer->bytes_per_pixel;
+  u64 row_bytes = (u64)rect->width * (u64)backbuffer->bytes_per_pixel;
+  for (int y = 0; y < rect->height; ++y) {
+    de100_mem_copy(dest + offset, source + offset, row_bytes);
+    offset += (u64)backbuffer->pitch;
+  }
+}
+
+/**
+ * Bring `buffer` up to date with `source` for every frame after the one
+ * it holds, up to and including frame `through`.
+ */
+de100_file_scoped_fn void wayland_repair(WaylandPlatformState *wl,
+                                         WaylandBuffer *buffer,
+                                         const u8 *source, u64 through,
+                                         const GameBackBuffer *backbuffer) {
+  if (buffer->frame == 0 ||
+      through - buffer->frame >= WAYLAND_DAMAGE_HISTORY) {
+    wayland_copy_rect(buffer->pixels, source, backbuffer, NULL);
+    return;
+  }
+  for (u64 frame = buffer->frame + 1; frame <= through; ++frame) {
+    const GameDirtyRegion *damage =
+        &wl->damage_history[frame % WAYLAND_DAMAGE_HISTORY];
+    if (damage->full_frame) {
+      wayland_copy_rect(buffer->pixels, source, backbuffer, NULL);
+      return;
+    }
+    for (int i = 0; i < damage->count; ++i) {
+      wayland_copy_rect(buffer->pixels, source, backbuffer,
+                        &damage->rects[i]);
+    }
+  }
+}
+
+/**
+ * Pick the buffer this frame draws into (the released one holding the
+ * newest frame, so it needs the least repair). Zero-copy: point the
+ * backbuffer at it, repaired up to the last frame shown.
+ */
+de100_file_scoped_fn bool wayland_begin_frame(WaylandPlatformState *wl,
+                                              GameBackBuffer *backbuffer,
+                                              f32 timeout_seconds) {
+  if (wl->current >= 0) {
+    return true;
+  }
+
+  f64 deadline = de100_get_wall_clock() + (f64)timeout_seconds;
+  for (;;) {
+    i32 best = -1;
+    for (i32 i = 0; i < WAYLAND_BUFFER_COUNT; ++i) {
+      if (!wl->buffers[i].is_busy &&
+          (best < 0 || wl->buffers[i].frame > wl->buffers[best].frame)) {
+        best = i;
+      }
+    }
+    if (best >= 0) {
+      wl->current = best;
+      break;
+    }
+    int remaining_ms =
+        (int)((deadline - de100_get_wall_clock()) * 1000.0);
+    if (remaining_ms <= 0 ||
+        !wayland_pump(wl, wl->frame_queue, remaining_ms)) {
+      return false; // Compositor holds every buffer; skip this frame
+    }
+  }
+
+  if (wl->is_zero_copy) {
+    WaylandBuffer *buffer = &wl->buffers[wl->current];
+    if (backbuffer->dirty.is_tracking && wl->last_shown >= 0 &&
+        wl->last_shown != wl->current) {
+      wayland_repair(wl, buffer, wl->buffers[wl->last_shown].pixels,
+                     wl->present_count, backbuffer);
+    }
+    backbuffer->memory.base = buffer->pixels;
+  }
+  return true;
+}
+
+/**
+ * Attach this frame's buffer with its damage and commit. Returns false
+ * if nothing was committed (no buffer, or nothing changed).
+ */
+de100_file_scoped_fn bool wayland_present(WaylandPlatformState *wl,
+                                          GameBackBuffer *backbuffer) {
+  if (wl->current < 0) {
+    return false;
+  }
+  GameDirtyRegion *dirty = &backbuffer->dirty;
+  bool is_full = !dirty->is_tracking || dirty->full_frame;
+  if (!is_full && dirty->count == 0) {
+    return false; // Keep the buffer for next frame
+  }
+
+  WaylandBuffer *buffer = &wl->buffers[wl->current];
+  u64 frame = ++wl->present_count;
+  GameDirtyRegion *history =
+      &wl->damage_history[frame % WAYLAND_DAMAGE_HISTORY];
+  *history = *dirty;
+  history->full_frame = is_full;
+
+  if (!wl->is_zero_copy) {
+    wayland_repair(wl, buffer, (const u8 *)backbuffer->memory.base, frame,
+                   backbuffer);
+  }
+
+  wl_surface_attach(wl->surface, buffer->buffer, 0, 0);
+  if (is_full) {
+    wl_surface_damage_buffer(wl->surface, 0, 0, INT32_MAX, INT32_MAX);
+  } else {
+    for (int i = 0; i < dirty->count; ++i) {
+      De100DirtyRect *rect = &dirty->rects[i];
+      wl_surface_damage_buffer(wl->surface, rect->x, rect->y, rect->width,
+                               rect->height);
+    }
+  }
+  if (!wl->frame_callback) {
+    wl->frame_callback = wl_surface_frame(wl->surface);
+    wl_proxy_set_queue((struct wl_proxy *)wl->frame_callback,
+                       wl->frame_queue);
+    wl_callback_add_listener(wl->frame_callback, &g_frame_listener, wl);
+  }
+  wl_surface_commit(wl->surface);
+  wl_display_flush(wl->display);
+
+  buffer->is_busy = true;
+  buffer->frame = frame;
+  wl->last_shown = wl->current;
+  wl->current = -1;
+  de100_backbuffer_clear_dirty(backbuffer);
+  return true;
+}
+
+/**
+ * Wait for the compositor's frame callback. Returns false after
+ * `timeout_seconds` without one (hidden surface): sleep-pace instead.
+ */
+de100_file_scoped_fn bool wayland_wait_for_frame(WaylandPlatformState *wl,
+                                                 f32 timeout_seconds) {
+  f64 deadline = de100_get_wall_clock() + (f64)timeout_seconds;
+  while (wl->frame_callback) {
+    int remaining_ms = (int)((deadline - de100_get_wall_clock()) * 1000.0);
+    if (remaining_ms <= 0 ||
+        !wayland_pump(wl, wl->frame_queue, remaining_ms)) {
+      return !wl->frame_callback;
+    }
+  }
+  return true;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Audio
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn inline void
+audio_generate_and_send(LinuxAudioConfig *audio_config, EngineGameState *game,
+                        GameMainCode *game_main_code) {
+  u32 samples_to_generate =
+      linux_get_samples_to_write(audio_config, &game->audio);
+  if (samples_to_generate == 0) {
+    return;
+  }
+  if (samples_to_generate > (u32)game->audio.max_sample_count) {
+    samples_to_generate = (u32)game->audio.max_sample_count;
+  }
+  samples_to_generate =
+      linux_begin_audio_write(audio_config, &game->audio, samples_to_generate);
+
+  game->audio.sample_count = (i32)samples_to_generate;
+  DE100_GAME_CALL(game_main_code, get_audio_samples)(&game->memory,
+                                                     &game->audio);
+  linux_send_samples_to_alsa(audio_config, &game->audio);
+  game->audio.running_sample_index += (u64)game->audio.sample_count;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Wayland Platform Initialization
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn int wayland_init(EngineState *engine) {
+  WaylandPlatformState *wl = &g_wl;
+  engine_set_backend(engine, wl);
+  wl->engine = engine;
+  GameConfig *config = &engine->game.config;
+
+  wl->display = wl_display_connect(NULL);
+  if (!wl->display) {
+    fprintf(stderr, "❌ Cannot connect to a Wayland compositor\n");
+    return 1;
+  }
+  wl->frame_queue = wl_display_create_queue(wl->display);
+
+  wl->registry = wl_display_get_registry(wl->display);
+  wl_registry_add_listener(wl->registry, &g_registry_listener, wl);
+  wl_display_roundtrip(wl->display); // Globals
+  wl_display_roundtrip(wl->display); // Their first events (shm formats)
+  if (!wl->compositor || !wl->shm || !wl->wm_base) {
+    fprintf(stderr, "❌ Wayland: compositor lacks wl_compositor v4, wl_shm "
+                    "or xdg_wm_base\n");
+    return 1;
+  }
+  if (!wl->has_shm_format) {
+    fprintf(stderr, "❌ Wayland: wl_shm has no %s format%s\n",
+            de100_pixel_format_name(DE100_PIXEL_FORMAT),
+            DE100_PIXEL_FORMAT == DE100_PIXEL_FORMAT_BGRA8
+                ? ""
+                : "; XRGB8888 (-DDE100_PIXEL_FORMAT=1) is universal");
+    return 1;
+  }
+
+  wl->surface = wl_compositor_create_surface(wl->compositor);
+  wl->xdg_surface = xdg_wm_base_get_xdg_surface(wl->wm_base, wl->surface);
+  xdg_surface_add_listener(wl->xdg_surface, &g_xdg_surface_listener, wl);
+  wl->toplevel = xdg_surface_get_toplevel(wl->xdg_surface);
+  xdg_toplevel_add_listener(wl->toplevel, &g_toplevel_listener, wl);
+  xdg_toplevel_set_title(wl->toplevel, config->window_title);
+  xdg_toplevel_set_app_id(wl->toplevel, config->window_title);
+  wl_surface_commit(wl->surface);
+  while (!wl->is_configured) {
+    if (wl_display_dispatch(wl->display) < 0) {
+      fprintf(stderr, "❌ Wayland: lost the compositor before configure\n");
+      return 1;
+    }
+  }
+
+  GameBackBuffer *backbuffer = &engine->game.backbuffer;
+  if (!wayland_create_pool(wl, backbuffer)) {
+    return 1;
+  }
+  if (config->prefer_mapped_backbuffer) {
+    wl->is_zero_copy = true;
+    wl->backbuffer_original_base = backbuffer->memory.base;
+  }
+  wayland_begin_frame(wl, backbuffer, config->target_seconds_per_frame);
+
+  printf("✅ Wayland surface %dx%d (%s, %s)\n", backbuffer->width,
+         backbuffer->height, de100_pixel_format_name(DE100_PIXEL_FORMAT),
+         wl->is_zero_copy ? "game renders into wl_shm"
+                          : "copied into wl_shm at present");
+
+  linux_load_alsa();
+  wl->audio_config.game_update_hz = (i32)config->audio_game_update_hz;
+  wl->audio_config.bytes_per_sample = (i32)(sizeof(i16) * 2);
+  wl->audio_config.use_audio_thread = config->prefer_threaded_audio;
+  wl->audio_config.adaptive_latency = config->prefer_adaptive_audio_latency;
+  wl->audio_config.use_mmap = config->prefer_mmap_audio;
+  wl->audio_config.use_audio_server = config->prefer_audio_server;
+  linux_init_audio(&wl->audio_config, &engine->game.audio,
+                   (i32)config->initial_audio_sample_rate,
+                   (i32)config->audio_game_update_hz);
+
+  if (config->prefer_threaded_joystick && !x11_evdev_start()) {
+    printf("⚠️  Gamepad thread unavailable, polling on the frame thread\n");
+  }
+  linux_init_joystick(engine->platform.old_inputs->controllers,
+                      engine->game.inputs->controllers);
+
+  // No refresh rate query without wl_output bookkeeping; frame callbacks
+  // report the real interval once running
+  adaptive_fps_init(config, config->max_allowed_refresh_rate_hz);
+
+#if DE100_INTERNAL
+  frame_stats_init();
+#endif
+
+  printf("✅ Wayland platform initialized\n");
+  return 0;
+}
+
+de100_file_scoped_fn void wayland_shutdown(EngineState *engine) {
+  WaylandPlatformState *wl = &g_wl;
+
+  if (wl->is_zero_copy) {
+    // Give the engine its own backbuffer block back before it frees it
+    engine->game.backbuffer.memory.base = wl->backbuffer_original_base;
+    wl->is_zero_copy = false;
+  }
+  if (!wl->display) {
+    return;
+  }
+  if (wl->frame_callback) {
+    wl_callback_destroy(wl->frame_callback);
+    wl->frame_callback = NULL;
+  }
+  wayland_destroy_pool(wl);
+  if (wl->toplevel) {
+    xdg_toplevel_destroy(wl->toplevel);
+  }
+  if (wl->xdg_surface) {
+    xdg_surface_destroy(wl->xdg_surface);
+  }
+  if (wl->surface) {
+    wl_surface_destroy(wl->surface);
+  }
+  if (wl->keyboard) {
+    wl_keyboard_destroy(wl->keyboard);
+  }
+  if (wl->pointer) {
+    wl_pointer_destroy(wl->pointer);
+  }
+  if (wl->frame_queue) {
+    wl_event_queue_destroy(wl->frame_queue);
+  }
+  wl_display_disconnect(wl->display);
+  *wl = (WaylandPlatformState){.pool_fd = -1, .current = -1, .last_shown = -1};
+  engine->platform.backend = NULL;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Main Platform Entry Point
+// ═══════════════════════════════════════════════════════════════════════════
+
+int platform_main(void) {
+  EngineState engine = {0};
+  engine.platform.game_main_code = (GameMainCode){0};
+
+  if (engine_init(&engine)) {
+    return 1;
+  }
+
+  EngineStartupStamp backend_start = engine_startup_now();
+  if (wayland_init(&engine) != 0) {
+    wayland_shutdown(&engine);
+    engine_shutdown(&engine);
+    return 1;
+  }
+  engine_startup_phase(&engine, "surface + input", backend_start,
+                       engine_startup_now());
+
+  WaylandPlatformState *wl = engine_get_backend(&engine, WaylandPlatformState);
+
+  EngineStartupStamp game_init_start = engine_startup_now();
+  DE100_GAME_CALL(&engine.platform.game_bootstrap_code, init)(
+      &engine.game.thread_context, &engine.game.memory, engine.game.inputs,
+      &engine.game.backbuffer);
+  engine_startup_phase(&engine, "game init", game_init_start,
+                       engine_startup_now());
+  engine_startup_report(&engine);
+
+  while (is_game_running) {
+#if DE100_INTERNAL
+    if (FRAME_LOG_EVERY_TEN_SECONDS_CHECK) {
+      printf("[HEALTH CHECK] frame=%u, RSI=%lld, marker_idx=%d\n",
+             g_frame_counter, (long long)wl->audio_config.running_sample_index,
+             g_debug_marker_index);
+    }
+#endif
+
+    frame_timing_begin();
+    FRAME_STATS_PHASE_BEGIN();
+
+    handle_game_reload_check(&engine.platform.game_main_code,
+                             &engine.platform.paths);
+
+    // Input (and shell) events queued since last frame land in this one
+    prepare_input_frame(engine.platform.old_inputs, engine.game.inputs);
+    if (!wayland_pump(wl, NULL, 0) &&
+        wl_display_get_error(wl->display) != 0) {
+      fprintf(stderr, "❌ Wayland: connection lost\n");
+      break;
+    }
+    if (x11_evdev_is_running()) {
+      x11_evdev_drain_events(engine.game.inputs);
+    }
+    linux_poll_joystick(engine.game.inputs);
+
+    if (input_recording_is_recording(&engine.platform.memory_state)) {
+      input_recording_record_frame(&engine.platform.memory_state,
+                                   engine.game.inputs);
+    }
+    if (input_recording_is_playing(&engine.platform.memory_state)) {
+      input_recording_playback_frame(&engine.platform.memory_state,
+                                     engine.game.inputs);
+    }
+    FRAME_STATS_PHASE_MARK(FRAME_PHASE_INPUT);
+
+    // Zero-copy: the game needs a released buffer to draw into
+    bool has_buffer =
+        wayland_begin_frame(wl, &engine.game.backbuffer,
+                            engine.game.config.target_seconds_per_frame);
+    engine.game.backbuffer.is_rendering_disabled =
+        wl->is_zero_copy && !has_buffer;
+
+    if (!engine_netplay_frame(&engine)) {
+      fixed_timestep_run_frame(&engine.game, &engine.platform.game_main_code,
+                               g_frame_timing.total_seconds);
+    }
+    engine.game.backbuffer.is_rendering_disabled = false;
+    FRAME_STATS_PHASE_MARK(FRAME_PHASE_UPDATE);
+
+    audio_generate_and_send(&wl->audio_config, &engine.game,
+                            &engine.platform.game_main_code);
+    FRAME_STATS_PHASE_MARK(FRAME_PHASE_AUDIO);
+
+    capture_frame(&engine.game.backbuffer,
+                  engine.game.config.target_seconds_per_frame);
+    spectate_frame(&engine.game.backbuffer);
+
+#if DE100_INTERNAL
+    if (has_buffer) {
+      int display_marker_index =
+          (g_debug_marker_index - 1 + MAX_DEBUG_AUDIO_MARKERS) %
+          MAX_DEBUG_AUDIO_MARKERS;
+      linux_debug_sync_display(&engine.game.backbuffer, &engine.game.audio,
+                               &wl->audio_config, g_debug_audio_markers,
+                               MAX_DEBUG_AUDIO_MARKERS, display_marker_index);
+      debug_overlay_render(&engine.game.backbuffer, &engine.game.memory,
+                           engine.game.config.target_seconds_per_frame);
+    }
+#endif
+
+    bool presented = wayland_present(wl, &engine.game.backbuffer);
+#if DE100_INTERNAL
+    linux_debug_capture_flip_state(&wl->audio_config);
+#endif
+    FRAME_STATS_PHASE_MARK(FRAME_PHASE_PRESENT);
+
+    frame_timing_mark_work_done();
+    bool paced = presented &&
+                 wayland_wait_for_frame(
+                     wl, engine.game.config.target_seconds_per_frame);
+    if (!paced || wl->frame_interval_seconds <
+                      engine.game.config.target_seconds_per_frame * 0.75f) {
+      // Hidden surface, nothing to show, or a target slower than the
+      // compositor's cadence (30Hz on 60Hz)
+      frame_timing_sleep_until_target(
+          engine.game.config.target_seconds_per_frame);
+    }
+    frame_timing_end();
+    if (paced && wl->frame_interval_seconds > 0.0f) {
+      frame_timing_use_present_interval(wl->frame_interval_seconds);
+    }
+    FRAME_STATS_PHASE_MARK(FRAME_PHASE_SLEEP);
+
+    f32 frame_time_ms = frame_timing_get_ms();
+    telemetry_frame(frame_time_ms, engine.game.config.target_seconds_per_frame);
+    if (FRAME_LOG_EVERY_ONE_SECONDS_CHECK) {
+      telemetry_counter(TELEMETRY_COUNTER_AUDIO_UNDERRUNS,
+                        linux_audio_underrun_count());
+    }
+
+#if DE100_INTERNAL
+    frame_stats_record(frame_time_ms,
+                       engine.game.config.target_seconds_per_frame);
+    de100_profiler_end_frame(engine.game.memory.profiler);
+    trace_export_frame(engine.game.memory.profiler);
+    flight_recorder_frame(engine.game.memory.profiler, engine.game.inputs,
+                          frame_time_ms,
+                          engine.game.config.target_seconds_per_frame);
+    if (FRAME_LOG_EVERY_ONE_SECONDS_CHECK) {
+      frame_stats_report_missed();
+    }
+#endif
+
+    g_frame_counter++;
+
+    if (engine.game.config.prefer_adaptive_fps) {
+      adaptive_fps_update(&engine.game.config, frame_time_ms,
+                          g_frame_timing.work_seconds * 1000.0f);
+    }
+
+    engine_swap_inputs(&engine);
+  }
+
+#if DE100_INTERNAL
+  de100_profiler_print(engine.game.memory.profiler, 15, true);
+#endif
+
+  linux_audio_thread_stop(&wl->audio_config);
+  linux_close_joysticks();
+  x11_evdev_stop();
+  linux_unload_alsa(&wl->audio_config);
+  wayland_shutdown(&engine);
+  engine_shutdown(&engine);
+
+#if DE100_INTERNAL
+  frame_stats_print();
+  frame_stats_dump_to_directory(engine.platform.paths.exe_directory.path);
+#endif
+
+  printf("Goodbye!\n");
+  return 0;
+}
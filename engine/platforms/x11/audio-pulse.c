@@ -0,0 +1,406 @@
+#include "audio-pulse.h"
+
+#include "../../_common/base.h"
+#include "../../_common/memory.h"
+#include "../../_common/profiler.h"
+
+#include <dlfcn.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// 🔊 LIBPULSE DECLARATIONS (subset, ABI-stable since 0.9)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// Declared here rather than including <pulse/pulseaudio.h>, so building
+// doesn't need the -dev package, same as the ALSA declarations in audio.h.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+typedef struct pa_threaded_mainloop pa_threaded_mainloop;
+typedef struct pa_mainloop_api pa_mainloop_api;
+typedef struct pa_context pa_context;
+typedef struct pa_stream pa_stream;
+typedef uint64_t pa_usec_t;
+
+typedef struct {
+  int format; // pa_sample_format_t
+  uint32_t rate;
+  uint8_t channels;
+} pa_sample_spec;
+
+typedef struct {
+  uint32_t maxlength;
+  uint32_t tlength;
+  uint32_t prebuf;
+  uint32_t minreq;
+  uint32_t fragsize;
+} pa_buffer_attr;
+
+#define LINUX_PA_SAMPLE_S16LE 3
+
+#define LINUX_PA_CONTEXT_READY 4
+#define LINUX_PA_CONTEXT_FAILED 5
+#define LINUX_PA_CONTEXT_TERMINATED 6
+
+#define LINUX_PA_STREAM_READY 2
+#define LINUX_PA_STREAM_FAILED 3
+#define LINUX_PA_STREAM_TERMINATED 4
+
+#define LINUX_PA_STREAM_INTERPOLATE_TIMING 0x0002u
+#define LINUX_PA_STREAM_AUTO_TIMING_UPDATE 0x0008u
+#define LINUX_PA_STREAM_ADJUST_LATENCY 0x2000u
+
+#define LINUX_PA_SEEK_RELATIVE 0
+
+typedef void (*pa_context_notify_cb_t)(pa_context *c, void *userdata);
+typedef void (*pa_stream_notify_cb_t)(pa_stream *s, void *userdata);
+typedef void (*pa_stream_request_cb_t)(pa_stream *s, size_t nbytes,
+                                       void *userdata);
+
+typedef struct {
+  pa_threaded_mainloop *(*threaded_mainloop_new)(void);
+  void (*threaded_mainloop_free)(pa_threaded_mainloop *m);
+  int (*threaded_mainloop_start)(pa_threaded_mainloop *m);
+  void (*threaded_mainloop_stop)(pa_threaded_mainloop *m);
+  void (*threaded_mainloop_lock)(pa_threaded_mainloop *m);
+  void (*threaded_mainloop_unlock)(pa_threaded_mainloop *m);
+  void (*threaded_mainloop_wait)(pa_threaded_mainloop *m);
+  void (*threaded_mainloop_signal)(pa_threaded_mainloop *m, int wait_accept);
+  pa_mainloop_api *(*threaded_mainloop_get_api)(pa_threaded_mainloop *m);
+
+  pa_context *(*context_new)(pa_mainloop_api *api, const char *name);
+  void (*context_unref)(pa_context *c);
+  int (*context_connect)(pa_context *c, const char *server, int flags,
+                         const void *spawn_api);
+  void (*context_disconnect)(pa_context *c);
+  int (*context_get_state)(pa_context *c);
+  int (*context_errno)(pa_context *c);
+  void (*context_set_state_callback)(pa_context *c, pa_context_notify_cb_t cb,
+                                     void *userdata);
+
+  pa_stream *(*stream_new)(pa_context *c, const char *name,
+                           const pa_sample_spec *ss, const void *map);
+  void (*stream_unref)(pa_stream *s);
+  int (*stream_connect_playback)(pa_stream *s, const char *dev,
+                                 const pa_buffer_attr *attr, unsigned flags,
+                                 const void *volume, pa_stream *sync_stream);
+  int (*stream_disconnect)(pa_stream *s);
+  int (*stream_get_state)(pa_stream *s);
+  int (*stream_begin_write)(pa_stream *s, void **data, size_t *nbytes);
+  int (*stream_write)(pa_stream *s, const void *data, size_t nbytes,
+                      void (*free_cb)(void *), int64_t offset, int seek);
+  int (*stream_get_latency)(pa_stream *s, pa_usec_t *usec, int *negative);
+  void (*stream_set_state_callback)(pa_stream *s, pa_stream_notify_cb_t cb,
+                                    void *userdata);
+  void (*stream_set_write_callback)(pa_stream *s, pa_stream_request_cb_t cb,
+                                    void *userdata);
+  void (*stream_set_underflow_callback)(pa_stream *s, pa_stream_notify_cb_t cb,
+                                        void *userdata);
+
+  const char *(*strerror)(int error);
+} LinuxPulseApi;
+
+de100_file_scoped_global_var void *g_linux_pulse_library = NULL;
+de100_file_scoped_global_var LinuxPulseApi g_pa;
+
+// ═══════════════════════════════════════════════════════════════════════════
+// 🔊 LOAD / UNLOAD
+// ═══════════════════════════════════════════════════════════════════════════
+
+bool linux_pulse_load(void) {
+  if (g_linux_pulse_library) {
+    return true;
+  }
+
+  void *library = dlopen("libpulse.so.0", RTLD_LAZY);
+  if (!library) {
+    printf("[AUDIO] libpulse not available (%s)\n", dlerror());
+    return false;
+  }
+
+  const struct {
+    const char *name;
+    void **slot;
+  } symbols[] = {
+#define LINUX_PA_SYMBOL(field) {"pa_" #field, (void **)&g_pa.field}
+      LINUX_PA_SYMBOL(threaded_mainloop_new),
+      LINUX_PA_SYMBOL(threaded_mainloop_free),
+      LINUX_PA_SYMBOL(threaded_mainloop_start),
+      LINUX_PA_SYMBOL(threaded_mainloop_stop),
+      LINUX_PA_SYMBOL(threaded_mainloop_lock),
+      LINUX_PA_SYMBOL(threaded_mainloop_unlock),
+      LINUX_PA_SYMBOL(threaded_mainloop_wait),
+      LINUX_PA_SYMBOL(threaded_mainloop_signal),
+      LINUX_PA_SYMBOL(threaded_mainloop_get_api),
+      LINUX_PA_SYMBOL(context_new),
+      LINUX_PA_SYMBOL(context_unref),
+      LINUX_PA_SYMBOL(context_connect),
+      LINUX_PA_SYMBOL(context_disconnect),
+      LINUX_PA_SYMBOL(context_get_state),
+      LINUX_PA_SYMBOL(context_errno),
+      LINUX_PA_SYMBOL(context_set_state_callback),
+      LINUX_PA_SYMBOL(stream_new),
+      LINUX_PA_SYMBOL(stream_unref),
+      LINUX_PA_SYMBOL(stream_connect_playback),
+      LINUX_PA_SYMBOL(stream_disconnect),
+      LINUX_PA_SYMBOL(stream_get_state),
+      LINUX_PA_SYMBOL(stream_begin_write),
+      LINUX_PA_SYMBOL(stream_write),
+      LINUX_PA_SYMBOL(stream_get_latency),
+      LINUX_PA_SYMBOL(stream_set_state_callback),
+      LINUX_PA_SYMBOL(stream_set_write_callback),
+      LINUX_PA_SYMBOL(stream_set_underflow_callback),
+      LINUX_PA_SYMBOL(strerror),
+#undef LINUX_PA_SYMBOL
+  };
+
+  for (size_t i = 0; i < sizeof(symbols) / sizeof(symbols[0]); ++i) {
+    *symbols[i].slot = dlsym(library, symbols[i].name);
+    if (!*symbols[i].slot) {
+      printf("⚠️  Audio: libpulse lacks %s, not using it\n", symbols[i].name);
+      dlclose(library);
+      return false;
+    }
+  }
+
+  g_linux_pulse_library = library;
+  printf("✅ Audio: libpulse loaded\n");
+  return true;
+}
+
+void linux_pulse_unload(void) {
+  if (g_linux_pulse_library) {
+    dlclose(g_linux_pulse_library);
+    g_linux_pulse_library = NULL;
+  }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// 🔊 CALLBACKS (server mainloop thread, mainloop lock held)
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn void linux_pulse_context_state(pa_context *c,
+                                                    void *userdata) {
+  (void)c;
+  LinuxPulseOutput *pulse = (LinuxPulseOutput *)userdata;
+  g_pa.threaded_mainloop_signal((pa_threaded_mainloop *)pulse->mainloop, 0);
+}
+
+de100_file_scoped_fn void linux_pulse_stream_state(pa_stream *s,
+                                                   void *userdata) {
+  (void)s;
+  LinuxPulseOutput *pulse = (LinuxPulseOutput *)userdata;
+  g_pa.threaded_mainloop_signal((pa_threaded_mainloop *)pulse->mainloop, 0);
+}
+
+de100_file_scoped_fn void linux_pulse_underflow(pa_stream *s, void *userdata) {
+  (void)s;
+  LinuxPulseOutput *pulse = (LinuxPulseOutput *)userdata;
+  __atomic_add_fetch(pulse->xrun_count, 1, __ATOMIC_RELAXED);
+  DE100_PROFILE_INSTANT("audio_underrun");
+}
+
+// Server wants `nbytes` more. Hand it what the ring has, straight into the
+// server's own buffer; silence only if the ring is empty, since writing
+// short just brings the next request sooner
+de100_file_scoped_fn void linux_pulse_write(pa_stream *s, size_t nbytes,
+                                            void *userdata) {
+  LinuxPulseOutput *pulse = (LinuxPulseOutput *)userdata;
+  const size_t frame_bytes = sizeof(i16) * DE100_AUDIO_RING_CHANNELS;
+
+  while (nbytes >= frame_bytes) {
+    void *data = NULL;
+    size_t size = nbytes;
+    if (g_pa.stream_begin_write(s, &data, &size) < 0 || !data) {
+      return;
+    }
+
+    u32 frames = (u32)(size / frame_bytes);
+    u32 read = de100_audio_ring_read(pulse->ring, (i16 *)data, frames);
+    if (read == 0) {
+      de100_mem_set(data, 0, (size_t)frames * frame_bytes);
+      read = frames;
+      __atomic_add_fetch(pulse->ring_underrun_count, 1, __ATOMIC_RELAXED);
+      DE100_PROFILE_INSTANT("audio_ring_underrun");
+    }
+
+    g_pa.stream_write(s, data, (size_t)read * frame_bytes, NULL, 0,
+                      LINUX_PA_SEEK_RELATIVE);
+    __atomic_add_fetch(pulse->running_sample_index, (i64)read,
+                       __ATOMIC_RELAXED);
+
+    if (read < frames) {
+      return;
+    }
+    nbytes -= (size_t)read * frame_bytes;
+  }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// 🔊 OPEN / CLOSE
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// tlength is the server-side buffer (what the device may still play after
+// we stop writing), minreq how much must free up before we're asked again.
+// ADJUST_LATENCY makes the server size the sink to tlength rather than
+// queueing tlength on top of its own default (~2s on PulseAudio).
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+bool linux_pulse_open(LinuxPulseOutput *pulse, i32 samples_per_second,
+                      u32 target_frames, u32 request_frames) {
+  if (!g_linux_pulse_library) {
+    return false;
+  }
+
+  const u32 frame_bytes = sizeof(i16) * DE100_AUDIO_RING_CHANNELS;
+  pulse->samples_per_second = samples_per_second;
+  pulse->target_frames = target_frames;
+  pulse->request_frames = request_frames;
+
+  pa_threaded_mainloop *mainloop = g_pa.threaded_mainloop_new();
+  if (!mainloop) {
+    return false;
+  }
+  pulse->mainloop = mainloop;
+
+  pa_context *context = g_pa.context_new(
+      g_pa.threaded_mainloop_get_api(mainloop), "Handmade Engine");
+  if (!context) {
+    linux_pulse_close(pulse);
+    return false;
+  }
+  pulse->context = context;
+  g_pa.context_set_state_callback(context, linux_pulse_context_state, pulse);
+
+  // No autospawn: if nothing is running, ALSA is the better fallback
+  const int no_autospawn = 0x0001;
+  if (g_pa.context_connect(context, NULL, no_autospawn, NULL) < 0) {
+    printf("[AUDIO] No sound server (%s)\n",
+           g_pa.strerror(g_pa.context_errno(context)));
+    linux_pulse_close(pulse);
+    return false;
+  }
+
+  g_pa.threaded_mainloop_lock(mainloop);
+  if (g_pa.threaded_mainloop_start(mainloop) < 0) {
+    g_pa.threaded_mainloop_unlock(mainloop);
+    linux_pulse_close(pulse);
+    return false;
+  }
+
+  bool ok = false;
+  for (;;) {
+    int state = g_pa.context_get_state(context);
+    if (state == LINUX_PA_CONTEXT_READY) {
+      ok = true;
+      break;
+    }
+    if (state == LINUX_PA_CONTEXT_FAILED ||
+        state == LINUX_PA_CONTEXT_TERMINATED) {
+      break;
+    }
+    g_pa.threaded_mainloop_wait(mainloop);
+  }
+
+  if (ok) {
+    pa_sample_spec spec = {.format = LINUX_PA_SAMPLE_S16LE,
+                           .rate = (uint32_t)samples_per_second,
+                           .channels = DE100_AUDIO_RING_CHANNELS};
+    pa_stream *stream = g_pa.stream_new(context, "Game", &spec, NULL);
+    pulse->stream = stream;
+    ok = stream != NULL;
+  }
+
+  if (ok) {
+    pa_stream *stream = (pa_stream *)pulse->stream;
+    pa_buffer_attr attr = {.maxlength = UINT32_MAX,
+                           .tlength = target_frames * frame_bytes,
+                           .prebuf = UINT32_MAX,
+                           .minreq = request_frames * frame_bytes,
+                           .fragsize = UINT32_MAX};
+    g_pa.stream_set_state_callback(stream, linux_pulse_stream_state, pulse);
+    g_pa.stream_set_write_callback(stream, linux_pulse_write, pulse);
+    g_pa.stream_set_underflow_callback(stream, linux_pulse_underflow, pulse);
+
+    unsigned flags = LINUX_PA_STREAM_ADJUST_LATENCY |
+                     LINUX_PA_STREAM_INTERPOLATE_TIMING |
+                     LINUX_PA_STREAM_AUTO_TIMING_UPDATE;
+    ok = g_pa.stream_connect_playback(stream, NULL, &attr, flags, NULL,
+                                      NULL) >= 0;
+    while (ok) {
+      int state = g_pa.stream_get_state(stream);
+      if (state == LINUX_PA_STREAM_READY) {
+        break;
+      }
+      if (state == LINUX_PA_STREAM_FAILED ||
+          state == LINUX_PA_STREAM_TERMINATED) {
+        ok = false;
+        break;
+      }
+      g_pa.threaded_mainloop_wait(mainloop);
+    }
+  }
+
+  if (!ok) {
+    printf("⚠️  Audio: Sound server stream failed (%s)\n",
+           g_pa.strerror(g_pa.context_errno(context)));
+    g_pa.threaded_mainloop_unlock(mainloop);
+    linux_pulse_close(pulse);
+    return false;
+  }
+
+  pulse->is_open = true;
+  g_pa.threaded_mainloop_unlock(mainloop);
+
+  printf("✅ Audio: Sound server stream (%d Hz stereo, buffer %u frames, "
+         "refill %u)\n",
+         samples_per_second, target_frames, request_frames);
+  return true;
+}
+
+u32 linux_pulse_queued_frames(LinuxPulseOutput *pulse) {
+  if (!pulse->is_open) {
+    return 0;
+  }
+
+  pa_threaded_mainloop *mainloop = (pa_threaded_mainloop *)pulse->mainloop;
+  pa_usec_t usec = 0;
+  int negative = 0;
+  g_pa.threaded_mainloop_lock(mainloop);
+  int err = g_pa.stream_get_latency((pa_stream *)pulse->stream, &usec,
+                                    &negative);
+  g_pa.threaded_mainloop_unlock(mainloop);
+  if (err < 0 || negative) {
+    return 0;
+  }
+
+  return (u32)(usec * (u64)pulse->samples_per_second / 1000000ull);
+}
+
+void linux_pulse_close(LinuxPulseOutput *pulse) {
+  pa_threaded_mainloop *mainloop = (pa_threaded_mainloop *)pulse->mainloop;
+
+  // Stop the mainloop thread first: after this no callback touches the ring
+  if (mainloop) {
+    g_pa.threaded_mainloop_stop(mainloop);
+  }
+  if (pulse->stream) {
+    g_pa.stream_disconnect((pa_stream *)pulse->stream);
+    g_pa.stream_unref((pa_stream *)pulse->stream);
+  }
+  if (pulse->context) {
+    g_pa.context_disconnect((pa_context *)pulse->context);
+    g_pa.context_unref((pa_context *)pulse->context);
+  }
+  if (mainloop) {
+    g_pa.threaded_mainloop_free(mainloop);
+  }
+
+  pulse->mainloop = NULL;
+  pulse->context = NULL;
+  pulse->stream = NULL;
+  pulse->is_open = false;
+}
@@ -0,0 +1,64 @@
+#ifndef DE100_PLATFORMS_X11_AUDIO_PULSE_H
+#define DE100_PLATFORMS_X11_AUDIO_PULSE_H
+
+#include "../../_common/base.h"
+#include "../_common/audio-ring.h"
+#include <stdbool.h>
+
+// ═══════════════════════════════════════════════════════════════
+// 🔊 SOUND SERVER OUTPUT (libpulse, loaded at runtime)
+// ═══════════════════════════════════════════════════════════════
+//
+// Talks to the desktop sound server directly instead of through ALSA's
+// compatibility plugin: PulseAudio itself, or PipeWire's pulse server
+// (what PipeWire desktops run), which skips the pipewire-alsa layer and
+// the extra buffering it forces on linux_init_audio.
+//
+// Pull model: the server's mainloop thread calls us whenever it wants
+// audio, and the callback drains the same lock-free ring the ALSA audio
+// thread uses, so the game side (get/send samples) is unchanged:
+//
+//   get_audio_samples ─▶ ring (SPSC) ─▶ write callback ─▶ server
+//                                       (pa_threaded_mainloop)
+//
+// Loaded like ALSA (dlopen libpulse.so.0), but all-or-nothing: a missing
+// symbol means no server output and linux_init_audio uses ALSA.
+// ═══════════════════════════════════════════════════════════════
+
+typedef struct {
+  // Opaque libpulse handles (pa_threaded_mainloop / pa_context / pa_stream)
+  void *mainloop;
+  void *context;
+  void *stream;
+
+  // Where the callback reads from and what it reports (owned by the
+  // caller; updated with __atomic from the server thread)
+  De100AudioRing *ring;
+  i64 *running_sample_index;
+  u64 *ring_underrun_count;
+  u64 *xrun_count;
+
+  i32 samples_per_second;
+  u32 target_frames;  // Server-side buffer we asked for
+  u32 request_frames; // Refill granularity we asked for
+  bool32 is_open;
+} LinuxPulseOutput;
+
+/** dlopen libpulse and resolve every entry point. False if unavailable. */
+bool linux_pulse_load(void);
+
+/**
+ * Connect to the server and start a 16-bit stereo playback stream fed
+ * from pulse->ring (set ring and the counters first). Blocks until the
+ * stream is ready or has failed; on failure everything is torn down.
+ */
+bool linux_pulse_open(LinuxPulseOutput *pulse, i32 samples_per_second,
+                      u32 target_frames, u32 request_frames);
+
+/** Frames queued in the server (0 if unknown). */
+u32 linux_pulse_queued_frames(LinuxPulseOutput *pulse);
+
+void linux_pulse_close(LinuxPulseOutput *pulse);
+void linux_pulse_unload(void);
+
+#endif // DE100_PLATFORMS_X11_AUDIO_PULSE_H
@@ -38,9 +38,14 @@
 
 #include "../../_common/base.h"
 #include "../../_common/memory.h"
+#include "../../_common/profiler.h"
+#include "../../_common/time.h"
 #include "../../game/audio.h"
+#include "../_common/flight-recorder.h"
+#include "../_common/thread-placement.h"
 
 #include <dlfcn.h>
+#include <math.h>
 #include <stdio.h>
 #include <string.h>
 
@@ -50,6 +55,17 @@
 
 LinuxSoundOutput g_linux_audio_output = {0};
 
+// ALSA PCM or sound server stream
+de100_file_scoped_fn inline bool linux_audio_output_is_open(void) {
+  return g_linux_audio_output.pcm_handle != NULL ||
+         g_linux_audio_output.pulse.is_open;
+}
+
+// Seen by the adaptive latency controller (any thread may recover an xrun)
+de100_file_scoped_fn inline void linux_audio_note_xrun(void) {
+  __atomic_add_fetch(&g_linux_audio_output.xrun_count, 1, __ATOMIC_RELAXED);
+}
+
 #if DE100_INTERNAL
 LinuxDebugAudioMarker g_debug_audio_markers[MAX_DEBUG_AUDIO_MARKERS] = {0};
 int g_debug_marker_index = 0;
@@ -89,6 +105,10 @@ alsa_snd_pcm_delay *SndPcmDelay_ = AlsaSndPcmDelayStub;
 alsa_snd_pcm_get_params *SndPcmGetParams_ = AlsaSndPcmGetParamsStub;
 alsa_snd_pcm_start *SndPcmStart_ = AlsaSndPcmStartStub;
 alsa_snd_pcm_drop *SndPcmDrop_ = AlsaSndPcmDropStub;
+alsa_snd_pcm_avail_update *SndPcmAvailUpdate_ = AlsaSndPcmAvailUpdateStub;
+alsa_snd_pcm_mmap_begin *SndPcmMmapBegin_ = AlsaSndPcmMmapBeginStub;
+alsa_snd_pcm_mmap_commit *SndPcmMmapCommit_ = AlsaSndPcmMmapCommitStub;
+alsa_snd_pcm_wait *SndPcmWait_ = AlsaSndPcmWaitStub;
 
 // ═══════════════════════════════════════════════════════════════════════════
 // 🔊 STUB FUNCTIONS (Used when ALSA is unavailable)
@@ -175,6 +195,32 @@ ALSA_SND_PCM_DROP(AlsaSndPcmDropStub) {
   return 0; // Success (nothing to drop)
 }
 
+ALSA_SND_PCM_AVAIL_UPDATE(AlsaSndPcmAvailUpdateStub) {
+  (void)pcm;
+  return 0; // No space
+}
+
+ALSA_SND_PCM_MMAP_BEGIN(AlsaSndPcmMmapBeginStub) {
+  (void)pcm;
+  (void)areas;
+  (void)offset;
+  (void)frames;
+  return -1; // Failure
+}
+
+ALSA_SND_PCM_MMAP_COMMIT(AlsaSndPcmMmapCommitStub) {
+  (void)pcm;
+  (void)offset;
+  (void)frames;
+  return -1; // Failure
+}
+
+ALSA_SND_PCM_WAIT(AlsaSndPcmWaitStub) {
+  (void)pcm;
+  (void)timeout;
+  return -1; // Failure
+}
+
 // ═══════════════════════════════════════════════════════════════════════════
 // 🔊 DYNAMIC LOADING OF ALSA LIBRARY
 // ═══════════════════════════════════════════════════════════════════════════
@@ -315,10 +361,497 @@ void linux_load_alsa(void) {
     SndPcmDrop_ = AlsaSndPcmDropStub;
   }
 
+  // mmap output (LinuxAudioConfig.use_mmap); init falls back to writei
+  // if these are stubs
+  SndPcmAvailUpdate_ =
+      (alsa_snd_pcm_avail_update *)dlsym(alsa_lib, "snd_pcm_avail_update");
+  if (!SndPcmAvailUpdate_) {
+    fprintf(stderr, "⚠️  Audio: Symbol 'snd_pcm_avail_update' not found\n");
+    SndPcmAvailUpdate_ = AlsaSndPcmAvailUpdateStub;
+  }
+
+  SndPcmMmapBegin_ =
+      (alsa_snd_pcm_mmap_begin *)dlsym(alsa_lib, "snd_pcm_mmap_begin");
+  if (!SndPcmMmapBegin_) {
+    fprintf(stderr, "⚠️  Audio: Symbol 'snd_pcm_mmap_begin' not found\n");
+    SndPcmMmapBegin_ = AlsaSndPcmMmapBeginStub;
+  }
+
+  SndPcmMmapCommit_ =
+      (alsa_snd_pcm_mmap_commit *)dlsym(alsa_lib, "snd_pcm_mmap_commit");
+  if (!SndPcmMmapCommit_) {
+    fprintf(stderr, "⚠️  Audio: Symbol 'snd_pcm_mmap_commit' not found\n");
+    SndPcmMmapCommit_ = AlsaSndPcmMmapCommitStub;
+  }
+
+  SndPcmWait_ = (alsa_snd_pcm_wait *)dlsym(alsa_lib, "snd_pcm_wait");
+  if (!SndPcmWait_) {
+    fprintf(stderr, "⚠️  Audio: Symbol 'snd_pcm_wait' not found\n");
+    SndPcmWait_ = AlsaSndPcmWaitStub;
+  }
+
   printf("✅ Audio: All ALSA functions loaded\n");
   printf("═══════════════════════════════════════════════════════════\n\n");
 }
 
+// ═══════════════════════════════════════════════════════════════════════════
+// 🗺️ DEVICE WRITES (writei or mmap, see audio.h)
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn inline bool linux_audio_mode_is_mmap(void) {
+  return g_linux_audio_output.device_mode != LINUX_AUDIO_DEVICE_RW_S16;
+}
+
+// Start of frame `offset` in an interleaved mmap area
+de100_file_scoped_fn inline void *
+linux_alsa_area_frame(const snd_pcm_channel_area_t *areas,
+                      snd_pcm_uframes_t offset) {
+  return (u8 *)areas[0].addr + (areas[0].first + offset * areas[0].step) / 8;
+}
+
+// Copy (S16) or convert (FLOAT) `count` i16 stereo frames into the ring
+de100_file_scoped_fn void
+linux_alsa_copy_to_area(const snd_pcm_channel_area_t *areas,
+                        snd_pcm_uframes_t offset, const i16 *frames,
+                        snd_pcm_uframes_t count) {
+  void *dest = linux_alsa_area_frame(areas, offset);
+  if (g_linux_audio_output.device_mode == LINUX_AUDIO_DEVICE_MMAP_S16) {
+    de100_mem_copy(dest, frames, (size_t)count * 2 * sizeof(i16));
+    return;
+  }
+  f32 *out = (f32 *)dest;
+  for (size_t i = 0; i < (size_t)count * 2; ++i) {
+    out[i] = (f32)frames[i] * (1.0f / 32768.0f);
+  }
+}
+
+// Write `count` frames in the negotiated mode. Blocks until the device
+// has room, like snd_pcm_writei(), and returns the same thing: frames
+// written, or a negative ALSA error for SndPcmRecover().
+de100_file_scoped_fn snd_pcm_sframes_t linux_alsa_write(const i16 *frames,
+                                                        u32 count) {
+  snd_pcm_t *pcm = g_linux_audio_output.pcm_handle;
+  if (!linux_audio_mode_is_mmap()) {
+    return SndPcmWritei(pcm, frames, (snd_pcm_uframes_t)count);
+  }
+
+  u32 written = 0;
+  while (written < count) {
+    snd_pcm_sframes_t avail = SndPcmAvailUpdate(pcm);
+    if (avail < 0) {
+      return written > 0 ? (snd_pcm_sframes_t)written : avail;
+    }
+    if (avail == 0) {
+      // 0 = timed out (device not running yet): report what fit
+      int err = SndPcmWait(pcm, 100);
+      if (err <= 0) {
+        return written > 0 || err == 0 ? (snd_pcm_sframes_t)written : err;
+      }
+      continue;
+    }
+
+    const snd_pcm_channel_area_t *areas = NULL;
+    snd_pcm_uframes_t offset = 0;
+    snd_pcm_uframes_t chunk = (snd_pcm_uframes_t)(count - written);
+    int err = SndPcmMmapBegin(pcm, &areas, &offset, &chunk);
+    if (err < 0) {
+      return written > 0 ? (snd_pcm_sframes_t)written : err;
+    }
+    linux_alsa_copy_to_area(areas, offset,
+                            frames + (size_t)written * 2, chunk);
+    snd_pcm_sframes_t committed = SndPcmMmapCommit(pcm, offset, chunk);
+    if (committed < 0) {
+      return written > 0 ? (snd_pcm_sframes_t)written : committed;
+    }
+    written += (u32)committed;
+  }
+  return (snd_pcm_sframes_t)written;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// 🎚️ ADAPTIVE LATENCY CONTROLLER (see audio.h)
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn inline f32 linux_audio_samples_to_ms(LinuxAudioConfig *c,
+                                                          i32 samples) {
+  return (f32)samples * 1000.0f / (f32)c->samples_per_second;
+}
+
+// (Re)start from the fixed Day-20 target; called at init and FPS changes
+de100_file_scoped_fn void linux_audio_latency_reset(LinuxAudioConfig *config) {
+  LinuxAudioLatencyController *ctl = &g_linux_audio_output.latency_controller;
+  LinuxSoundOutput *output = &g_linux_audio_output;
+
+  f32 fixed_ms = linux_audio_samples_to_ms(
+      config, output->latency_sample_count + output->safety_sample_count);
+  ctl->min_ms = LINUX_AUDIO_LATENCY_MIN_MS;
+  ctl->max_ms = fixed_ms * 2.0f;
+  if (!config->use_audio_thread) {
+    // Can't queue more than the device holds (minus a period to write in)
+    f32 device_ms = linux_audio_samples_to_ms(
+        config, (i32)output->buffer_size - (i32)output->period_size);
+    if (ctl->max_ms > device_ms) {
+      ctl->max_ms = device_ms;
+    }
+  }
+  if (ctl->min_ms > ctl->max_ms) {
+    ctl->min_ms = ctl->max_ms;
+  }
+
+  ctl->target_ms = fixed_ms < ctl->max_ms ? fixed_ms : ctl->max_ms;
+  ctl->interval_ms = 1000.0f / (f32)config->game_update_hz;
+  ctl->jitter_ms = 0.0f;
+  ctl->last_call_seconds = 0.0;
+  ctl->last_adjust_seconds = 0.0;
+  ctl->last_underrun_seconds = 0.0;
+  ctl->seen_underruns =
+      __atomic_load_n(&output->xrun_count, __ATOMIC_RELAXED) +
+      __atomic_load_n(&output->ring_underrun_count, __ATOMIC_RELAXED);
+}
+
+// One observation per write call; returns the write-ahead in samples
+de100_file_scoped_fn i32 linux_audio_latency_update(LinuxAudioConfig *config) {
+  LinuxAudioLatencyController *ctl = &g_linux_audio_output.latency_controller;
+  LinuxSoundOutput *output = &g_linux_audio_output;
+  f64 now = de100_get_wall_clock();
+
+  if (ctl->last_call_seconds > 0.0) {
+    f32 interval = (f32)((now - ctl->last_call_seconds) * 1000.0);
+    // Ignore debugger pauses / window drags; underruns still count below
+    if (interval < 250.0f) {
+      ctl->interval_ms += (interval - ctl->interval_ms) / 16.0f;
+      ctl->jitter_ms +=
+          (fabsf(interval - ctl->interval_ms) - ctl->jitter_ms) / 16.0f;
+    }
+  }
+  ctl->last_call_seconds = now;
+
+  u64 underruns = __atomic_load_n(&output->xrun_count, __ATOMIC_RELAXED) +
+                  __atomic_load_n(&output->ring_underrun_count,
+                                  __ATOMIC_RELAXED);
+  f32 desired = ctl->interval_ms +
+                LINUX_AUDIO_LATENCY_JITTER_SCALE * ctl->jitter_ms +
+                LINUX_AUDIO_LATENCY_MARGIN_MS;
+
+  if (underruns != ctl->seen_underruns) {
+    ctl->seen_underruns = underruns;
+    ctl->target_ms = ctl->target_ms * 1.5f;
+    ctl->last_underrun_seconds = now;
+    ctl->last_adjust_seconds = now;
+#if DE100_INTERNAL
+    printf("[AUDIO] 🎚️ Underrun: write-ahead → %.1f ms\n",
+           ctl->target_ms < ctl->max_ms ? ctl->target_ms : ctl->max_ms);
+#endif
+  } else if (now - ctl->last_adjust_seconds >=
+             LINUX_AUDIO_LATENCY_ADJUST_SECONDS) {
+    if (desired > ctl->target_ms) {
+      ctl->target_ms = desired;
+    } else if (now - ctl->last_underrun_seconds >=
+               LINUX_AUDIO_LATENCY_HOLD_SECONDS) {
+      ctl->target_ms -= (ctl->target_ms - desired) * 0.25f;
+    }
+    ctl->last_adjust_seconds = now;
+  }
+
+  if (ctl->target_ms < ctl->min_ms) {
+    ctl->target_ms = ctl->min_ms;
+  }
+  if (ctl->target_ms > ctl->max_ms) {
+    ctl->target_ms = ctl->max_ms;
+  }
+
+  return (i32)(ctl->target_ms * (f32)config->samples_per_second / 1000.0f);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// 🔊 AUDIO THREAD (LinuxAudioConfig.use_audio_thread)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// Sole consumer of the ring and sole writer to the PCM once started. Each
+// pass hands ALSA one period; snd_pcm_writei() blocks until the device has
+// room, which paces the loop.
+//
+// Ring empty (the game loop is late): sleep while ALSA still holds more
+// than a period, otherwise pad a period of silence so the device never
+// starves — a gap instead of an xrun, counted in ring_underrun_count.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn void linux_audio_thread_write(LinuxAudioConfig *config,
+                                                   i16 *frames, u32 count) {
+  while (count > 0) {
+    snd_pcm_sframes_t written = linux_alsa_write(frames, count);
+    if (written < 0) {
+      DE100_PROFILE_INSTANT("audio_underrun");
+      linux_audio_note_xrun();
+      if (SndPcmRecover(g_linux_audio_output.pcm_handle, (int)written, 1) <
+          0) {
+        return;
+      }
+      continue;
+    }
+
+    frames += (size_t)written * DE100_AUDIO_RING_CHANNELS;
+    count -= (u32)written;
+    __atomic_add_fetch(&config->running_sample_index, (i64)written,
+                       __ATOMIC_RELAXED);
+  }
+}
+
+de100_file_scoped_fn void *linux_audio_thread_proc(void *param) {
+  LinuxAudioConfig *config = (LinuxAudioConfig *)param;
+  LinuxSoundOutput *output = &g_linux_audio_output;
+  i16 *period = (i16 *)output->period_buffer.base;
+
+  // Before the first write: a preempted audio thread is an underrun
+  if (config->realtime_thread) {
+    De100ThreadPriorityLevel level =
+        de100_thread_promote_audio(config->realtime_priority);
+    printf("[AUDIO] Audio thread priority: %s\n",
+           de100_thread_priority_name(level));
+  }
+
+  while (__atomic_load_n(&output->audio_thread_running, __ATOMIC_ACQUIRE)) {
+    u32 frames = de100_audio_ring_read(&output->ring, period,
+                                       output->period_size);
+    if (frames == 0) {
+      snd_pcm_sframes_t avail = SndPcmAvail(output->pcm_handle);
+      snd_pcm_sframes_t queued = (snd_pcm_sframes_t)output->buffer_size - avail;
+      if (avail >= 0 && queued > (snd_pcm_sframes_t)output->period_size) {
+        de100_sleep_ms(1);
+        continue;
+      }
+
+      de100_mem_set(period, 0, output->period_buffer.size);
+      frames = output->period_size;
+      __atomic_add_fetch(&output->ring_underrun_count, 1, __ATOMIC_RELAXED);
+      DE100_PROFILE_INSTANT("audio_ring_underrun");
+    }
+
+    linux_audio_thread_write(config, period, frames);
+  }
+
+  if (config->realtime_thread) {
+    de100_thread_demote_audio();
+  }
+  return NULL;
+}
+
+// Ring for whichever consumer drains it (audio thread or sound server),
+// pre-filled with the latency lead
+de100_file_scoped_fn bool
+linux_audio_ring_create(LinuxAudioConfig *audio_config) {
+  LinuxSoundOutput *output = &g_linux_audio_output;
+
+  // Room for the deepest target the game loop may ask for (latency +
+  // safety at the lowest update rate) plus a full max-size submission
+  u32 max_submit =
+      output->sample_buffer_size / (u32)audio_config->bytes_per_sample;
+  u32 wanted = (u32)(audio_config->samples_per_second / 4) + max_submit;
+  u32 capacity = 1;
+  while (capacity < wanted) {
+    capacity <<= 1;
+  }
+
+  u32 flags = De100_MEMORY_FLAG_READ | De100_MEMORY_FLAG_WRITE |
+              De100_MEMORY_FLAG_ZEROED;
+  output->ring_memory = de100_memory_alloc(
+      NULL, (size_t)capacity * (u32)audio_config->bytes_per_sample, flags);
+  if (!de100_memory_is_valid(output->ring_memory)) {
+    return false;
+  }
+
+  de100_audio_ring_init(&output->ring, (i16 *)output->ring_memory.base,
+                        capacity);
+  output->ring_underrun_count = 0;
+
+  // Same head start the device gets in main-thread mode
+  u32 lead = (u32)output->latency_sample_count;
+  while (lead > 0) {
+    u32 chunk = lead < max_submit ? lead : max_submit;
+    de100_audio_ring_write(&output->ring,
+                           (i16 *)output->sample_buffer.base, chunk);
+    lead -= chunk;
+  }
+  return true;
+}
+
+de100_file_scoped_fn bool
+linux_audio_thread_start(LinuxAudioConfig *audio_config) {
+  LinuxSoundOutput *output = &g_linux_audio_output;
+  if (output->period_size == 0) {
+    output->period_size = (u32)(audio_config->samples_per_second / 100);
+  }
+
+  output->period_buffer = de100_memory_alloc(
+      NULL, (size_t)output->period_size * (u32)audio_config->bytes_per_sample,
+      De100_MEMORY_FLAG_READ | De100_MEMORY_FLAG_WRITE |
+          De100_MEMORY_FLAG_ZEROED);
+  if (!de100_memory_is_valid(output->period_buffer) ||
+      !linux_audio_ring_create(audio_config)) {
+    de100_memory_free(&output->period_buffer);
+    return false;
+  }
+
+  output->audio_thread_running = true;
+  if (pthread_create(&output->audio_thread, NULL, linux_audio_thread_proc,
+                     audio_config) != 0) {
+    output->audio_thread_running = false;
+    de100_memory_free(&output->ring_memory);
+    de100_memory_free(&output->period_buffer);
+    return false;
+  }
+  output->audio_thread_started = true;
+
+  printf("✅ Audio: Audio thread started (ring %u frames, period %u)\n",
+         output->ring.capacity_frames, output->period_size);
+  return true;
+}
+
+void linux_audio_thread_stop(LinuxAudioConfig *audio_config) {
+  LinuxSoundOutput *output = &g_linux_audio_output;
+
+  // Server mode: the server's thread is the ring consumer
+  if (output->pulse.is_open) {
+    linux_pulse_close(&output->pulse);
+    audio_config->use_audio_thread = false;
+    printf("[AUDIO] Sound server stream closed (%llu ring underruns)\n",
+           (unsigned long long)output->ring_underrun_count);
+    de100_memory_free(&output->ring_memory);
+    return;
+  }
+
+  if (!output->audio_thread_started) {
+    return;
+  }
+
+  __atomic_store_n(&output->audio_thread_running, false, __ATOMIC_RELEASE);
+  pthread_join(output->audio_thread, NULL);
+  output->audio_thread_started = false;
+  audio_config->use_audio_thread = false;
+
+  printf("[AUDIO] Audio thread stopped (%llu ring underruns)\n",
+         (unsigned long long)output->ring_underrun_count);
+
+  de100_memory_free(&output->ring_memory);
+  de100_memory_free(&output->period_buffer);
+}
+
+u64 linux_audio_underrun_count(void) {
+  return __atomic_load_n(&g_linux_audio_output.xrun_count, __ATOMIC_RELAXED) +
+         __atomic_load_n(&g_linux_audio_output.ring_underrun_count,
+                         __ATOMIC_RELAXED);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// 🔊 SAMPLE BUFFER (what the game fills each frame)
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn bool
+linux_audio_alloc_sample_buffer(GameAudioOutputBuffer *audio_output,
+                                i32 samples_per_second, i32 game_update_hz) {
+  // Allocate enough for max samples per call
+  u32 sample_buffer_size =
+      (audio_output && audio_output->max_sample_count > 0)
+          ? (u32)audio_output->max_sample_count * (u32)(sizeof(i16) * 2)
+          : (u32)(samples_per_second / game_update_hz * 3) *
+                (u32)(sizeof(i16) * 2);
+
+  g_linux_audio_output.sample_buffer =
+      de100_memory_alloc(NULL, sample_buffer_size,
+                         De100_MEMORY_FLAG_READ | De100_MEMORY_FLAG_WRITE |
+                             De100_MEMORY_FLAG_ZEROED);
+
+  if (!de100_memory_is_valid(g_linux_audio_output.sample_buffer)) {
+    fprintf(stderr,
+            "\u274c Audio: Failed to allocate sample buffer (%d bytes)\n",
+            sample_buffer_size);
+    fprintf(
+        stderr, "   Error: %s\n",
+        de100_memory_error_str(g_linux_audio_output.sample_buffer.error_code));
+    return false;
+  }
+
+  g_linux_audio_output.sample_buffer_size = sample_buffer_size;
+
+  printf("✅ Audio: Sample buffer allocated (%d bytes)\n", sample_buffer_size);
+  return true;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// 🔊 SOUND SERVER INITIALIZATION (LinuxAudioConfig.use_audio_server)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// Same latency model as ALSA below, but the write-ahead lives in the ring
+// and the server only keeps LINUX_AUDIO_THREAD_ALSA_LATENCY_US queued.
+// Returns false with nothing left allocated, so ALSA init can follow.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn bool
+linux_init_audio_server(LinuxAudioConfig *audio_config,
+                        GameAudioOutputBuffer *audio_output,
+                        i32 samples_per_second, i32 game_update_hz) {
+  LinuxSoundOutput *output = &g_linux_audio_output;
+  if (!linux_pulse_load()) {
+    return false;
+  }
+
+  i32 samples_per_frame = samples_per_second / game_update_hz;
+  i32 latency_sample_count = samples_per_frame * FRAMES_OF_AUDIO_LATENCY;
+  i32 safety_sample_count = samples_per_frame / 3;
+  u32 server_frames = (u32)((i64)samples_per_second *
+                            LINUX_AUDIO_THREAD_ALSA_LATENCY_US / 1000000);
+  u32 request_frames = server_frames / 4;
+
+  audio_config->samples_per_second = samples_per_second;
+  audio_config->bytes_per_sample = sizeof(i16) * 2; // 16-bit stereo
+  audio_config->running_sample_index = 0;
+  audio_config->game_update_hz = game_update_hz;
+  audio_config->latency_samples = latency_sample_count;
+  audio_config->safety_samples = safety_sample_count;
+
+  output->buffer_size = server_frames;
+  output->period_size = request_frames;
+  output->latency_sample_count = latency_sample_count;
+  output->latency_microseconds = (i32)((f64)latency_sample_count /
+                                       (f64)samples_per_second * 1000000.0);
+  output->safety_sample_count = safety_sample_count;
+  output->ring_underrun_count = 0;
+
+  if (!linux_audio_alloc_sample_buffer(audio_output, samples_per_second,
+                                       game_update_hz)) {
+    return false;
+  }
+  if (!linux_audio_ring_create(audio_config)) {
+    de100_memory_free(&output->sample_buffer);
+    return false;
+  }
+
+  output->pulse.ring = &output->ring;
+  output->pulse.running_sample_index = &audio_config->running_sample_index;
+  output->pulse.ring_underrun_count = &output->ring_underrun_count;
+  output->pulse.xrun_count = &output->xrun_count;
+  if (!linux_pulse_open(&output->pulse, samples_per_second, server_frames,
+                        request_frames)) {
+    de100_memory_free(&output->ring_memory);
+    de100_memory_free(&output->sample_buffer);
+    return false;
+  }
+
+  output->device_mode = LINUX_AUDIO_DEVICE_SERVER;
+  audio_config->use_audio_thread = true; // Ring mode for get/send
+  audio_config->is_initialized = true;
+  if (audio_config->adaptive_latency) {
+    linux_audio_latency_reset(audio_config);
+  }
+  if (audio_output)
+    audio_output->is_initialized = true;
+
+  printf("🔊 AUDIO SYSTEM INITIALIZED (sound server)\n\n");
+  return true;
+}
+
 // ═══════════════════════════════════════════════════════════════════════════
 // 🔊 INITIALIZE AUDIO SYSTEM
 // ═══════════════════════════════════════════════════════════════════════════
@@ -355,6 +888,12 @@ bool linux_init_audio(LinuxAudioConfig *audio_config,
   printf("🔊 ALSA AUDIO INITIALIZATION\n");
   printf("═══════════════════════════════════════════════════════════\n");
 
+  if (audio_config->use_audio_server &&
+      linux_init_audio_server(audio_config, audio_output, samples_per_second,
+                              game_update_hz)) {
+    return true;
+  }
+
   // ─────────────────────────────────────────────────────────────────────
   // STEP 1: Check if ALSA was loaded
   // ─────────────────────────────────────────────────────────────────────
@@ -441,15 +980,53 @@ bool linux_init_audio(LinuxAudioConfig *audio_config,
   //
   // ─────────────────────────────────────────────────────────────────────
 
-  err = SndPcmSetParams(
-      g_linux_audio_output.pcm_handle,
-      LINUX_SND_PCM_FORMAT_S16_LE,         // 16-bit signed little-endian
-      LINUX_SND_PCM_ACCESS_RW_INTERLEAVED, // Interleaved stereo (LRLRLR)
-      2,                                   // Stereo
-      (unsigned int)samples_per_second,    // Sample rate
-      1,                                   // Allow soft resampling
-      (unsigned int)latency_microseconds   // Target latency
-  );
+  // Threaded: the ring carries the frame-to-frame latency, so the device
+  // only needs to cover the audio thread's wake-up jitter
+  i32 alsa_latency_microseconds = audio_config->use_audio_thread
+                                      ? LINUX_AUDIO_THREAD_ALSA_LATENCY_US
+                                      : latency_microseconds;
+
+  // mmap modes first when asked for; plain writei is always the fallback
+  const struct {
+    LinuxAudioDeviceMode mode;
+    int access;
+    int format;
+    const char *name;
+  } device_modes[] = {
+      {LINUX_AUDIO_DEVICE_MMAP_S16, LINUX_SND_PCM_ACCESS_MMAP_INTERLEAVED,
+       LINUX_SND_PCM_FORMAT_S16_LE, "mmap, 16-bit"},
+      {LINUX_AUDIO_DEVICE_MMAP_FLOAT, LINUX_SND_PCM_ACCESS_MMAP_INTERLEAVED,
+       LINUX_SND_PCM_FORMAT_FLOAT_LE, "mmap, float"},
+      {LINUX_AUDIO_DEVICE_RW_S16, LINUX_SND_PCM_ACCESS_RW_INTERLEAVED,
+       LINUX_SND_PCM_FORMAT_S16_LE, "writei, 16-bit"},
+  };
+  i32 mode_count = (i32)(sizeof(device_modes) / sizeof(device_modes[0]));
+  bool has_mmap = SndPcmMmapBegin_ != AlsaSndPcmMmapBeginStub &&
+                  SndPcmMmapCommit_ != AlsaSndPcmMmapCommitStub &&
+                  SndPcmAvailUpdate_ != AlsaSndPcmAvailUpdateStub &&
+                  SndPcmWait_ != AlsaSndPcmWaitStub;
+  i32 first_mode = audio_config->use_mmap && has_mmap ? 0 : mode_count - 1;
+  const char *mode_name = "";
+
+  err = -1;
+  for (i32 m = first_mode; m < mode_count && err < 0; ++m) {
+    err = SndPcmSetParams(
+        g_linux_audio_output.pcm_handle,
+        device_modes[m].format,                 // Sample encoding
+        device_modes[m].access,                 // Interleaved (LRLRLR)
+        2,                                      // Stereo
+        (unsigned int)samples_per_second,       // Sample rate
+        1,                                      // Allow soft resampling
+        (unsigned int)alsa_latency_microseconds // Target latency
+    );
+    if (err >= 0) {
+      g_linux_audio_output.device_mode = device_modes[m].mode;
+      mode_name = device_modes[m].name;
+    } else if (m + 1 < mode_count) {
+      printf("[AUDIO] %s not available (%s), trying next\n",
+             device_modes[m].name, SndStrerror(err));
+    }
+  }
 
   if (err < 0) {
     fprintf(stderr, "❌ Audio: Cannot set PCM parameters: %s\n",
@@ -460,8 +1037,8 @@ bool linux_init_audio(LinuxAudioConfig *audio_config,
     return false;
   }
 
-  printf("✅ Audio: PCM configured (%d Hz, 16-bit stereo)\n",
-         samples_per_second);
+  printf("✅ Audio: PCM configured (%d Hz stereo, %s)\n", samples_per_second,
+         mode_name);
 
   // ─────────────────────────────────────────────────────────────────────
   // STEP 5: Query actual buffer/period sizes from ALSA
@@ -506,6 +1083,7 @@ bool linux_init_audio(LinuxAudioConfig *audio_config,
 
   // Linux-specific state
   g_linux_audio_output.buffer_size = (u32)actual_buffer_size;
+  g_linux_audio_output.period_size = (u32)actual_period_size;
   g_linux_audio_output.latency_sample_count = latency_sample_count;
   g_linux_audio_output.latency_microseconds = latency_microseconds;
   g_linux_audio_output.safety_sample_count = safety_sample_count;
@@ -519,25 +1097,8 @@ bool linux_init_audio(LinuxAudioConfig *audio_config,
   //
   // ─────────────────────────────────────────────────────────────────────
 
-  // Allocate enough for max samples per call
-  u32 sample_buffer_size =
-      (audio_output && audio_output->max_sample_count > 0)
-          ? (u32)audio_output->max_sample_count * (u32)(sizeof(i16) * 2)
-          : (u32)(samples_per_second / game_update_hz * 3) *
-                (u32)(sizeof(i16) * 2);
-
-  g_linux_audio_output.sample_buffer =
-      de100_memory_alloc(NULL, sample_buffer_size,
-                         De100_MEMORY_FLAG_READ | De100_MEMORY_FLAG_WRITE |
-                             De100_MEMORY_FLAG_ZEROED);
-
-  if (!de100_memory_is_valid(g_linux_audio_output.sample_buffer)) {
-    fprintf(stderr,
-            "\u274c Audio: Failed to allocate sample buffer (%d bytes)\n",
-            sample_buffer_size);
-    fprintf(
-        stderr, "   Error: %s\n",
-        de100_memory_error_str(g_linux_audio_output.sample_buffer.error_code));
+  if (!linux_audio_alloc_sample_buffer(audio_output, samples_per_second,
+                                       game_update_hz)) {
     SndPcmClose(g_linux_audio_output.pcm_handle);
     g_linux_audio_output.pcm_handle = NULL;
     audio_config->is_initialized = false;
@@ -546,10 +1107,6 @@ bool linux_init_audio(LinuxAudioConfig *audio_config,
     return false;
   }
 
-  g_linux_audio_output.sample_buffer_size = sample_buffer_size;
-
-  printf("✅ Audio: Sample buffer allocated (%d bytes)\n", sample_buffer_size);
-
   // ─────────────────────────────────────────────────────────────────────
   // STEP 9: Pre-fill buffer with silence and start playback
   // ─────────────────────────────────────────────────────────────────────
@@ -563,10 +1120,14 @@ bool linux_init_audio(LinuxAudioConfig *audio_config,
   de100_mem_set(g_linux_audio_output.sample_buffer.base, 0,
                 g_linux_audio_output.sample_buffer_size);
 
-  // Write silence to prime the buffer
-  snd_pcm_sframes_t frames_written = SndPcmWritei(
-      g_linux_audio_output.pcm_handle, g_linux_audio_output.sample_buffer.base,
-      (snd_pcm_uframes_t)latency_sample_count);
+  // Write silence to prime the buffer (threaded: the small device buffer;
+  // the ring gets the latency worth below)
+  snd_pcm_uframes_t prime_frames = (snd_pcm_uframes_t)latency_sample_count;
+  if (audio_config->use_audio_thread && prime_frames > actual_buffer_size) {
+    prime_frames = actual_buffer_size;
+  }
+  snd_pcm_sframes_t frames_written = linux_alsa_write(
+      (i16 *)g_linux_audio_output.sample_buffer.base, (u32)prime_frames);
 
   if (frames_written < 0) {
     fprintf(stderr, "⚠️  Audio: Initial write failed: %s\n",
@@ -586,6 +1147,23 @@ bool linux_init_audio(LinuxAudioConfig *audio_config,
   }
 
   audio_config->is_initialized = true;
+
+  // ─────────────────────────────────────────────────────────────────────
+  // STEP 10: Start the audio thread (threaded mode)
+  // ─────────────────────────────────────────────────────────────────────
+
+  if (audio_config->use_audio_thread &&
+      !linux_audio_thread_start(audio_config)) {
+    fprintf(stderr, "⚠️  Audio: Audio thread unavailable, writing to ALSA "
+                    "from the game loop\n");
+    audio_config->use_audio_thread = false;
+  }
+
+  // After the thread decision: the controller's ceiling depends on it
+  if (audio_config->adaptive_latency) {
+    linux_audio_latency_reset(audio_config);
+  }
+
   if (audio_output)
     audio_output->is_initialized = true;
 
@@ -642,14 +1220,66 @@ bool linux_init_audio(LinuxAudioConfig *audio_config,
 //
 // ═══════════════════════════════════════════════════════════════════════════
 
+f32 linux_audio_set_frame_gap(LinuxAudioConfig *audio_config,
+                              f32 frame_seconds) {
+  audio_config->frame_gap_samples = 0;
+  if (frame_seconds <= 0.0f || !audio_config->is_initialized ||
+      !linux_audio_output_is_open()) {
+    return frame_seconds;
+  }
+
+  LinuxSoundOutput *output = &g_linux_audio_output;
+  i32 rate = audio_config->samples_per_second;
+  i32 normal = output->latency_sample_count + output->safety_sample_count;
+  i32 capacity = audio_config->use_audio_thread
+                     ? (i32)output->ring.capacity_frames
+                     : (i32)output->buffer_size;
+  i32 per_write =
+      (i32)(output->sample_buffer_size / (u32)audio_config->bytes_per_sample);
+
+  // Each frame tops the buffer up by one gap: it has to fit beside the
+  // normal target (with a safety margin to spare) and in one write
+  i32 gap = (i32)(frame_seconds * (f32)rate);
+  i32 room = capacity - normal - output->safety_sample_count;
+  gap = gap < room ? gap : room;
+  gap = gap < per_write ? gap : per_write;
+  gap = gap > 0 ? gap : 0;
+
+  audio_config->frame_gap_samples = gap;
+  return (f32)gap / (f32)rate;
+}
+
 u32 linux_get_samples_to_write(LinuxAudioConfig *audio_config,
                                GameAudioOutputBuffer *audio_output) {
   (void)audio_output;
 
-  if (!audio_config->is_initialized || !g_linux_audio_output.pcm_handle) {
+  if (!audio_config->is_initialized || !linux_audio_output_is_open()) {
     return 0;
   }
 
+  // Write-ahead: fixed Day-20 latency + safety, or the controller's,
+  // plus one throttled frame while backgrounded
+  i32 target_buffered = audio_config->adaptive_latency
+                            ? linux_audio_latency_update(audio_config)
+                            : g_linux_audio_output.latency_sample_count +
+                                  g_linux_audio_output.safety_sample_count;
+  target_buffered += audio_config->frame_gap_samples;
+
+  // Threaded: same target, kept in the ring instead of the device buffer
+  if (audio_config->use_audio_thread) {
+    i32 ring_target = target_buffered;
+    i32 ring_queued = (i32)de100_audio_ring_fill(&g_linux_audio_output.ring);
+    // A lower bound: the device buffer behind the ring isn't queried here
+    audio_config->queued_samples = ring_queued;
+    i32 ring_to_write = ring_target - ring_queued;
+    i32 ring_max = (i32)(g_linux_audio_output.sample_buffer_size /
+                         audio_config->bytes_per_sample);
+    if (ring_to_write < 0) {
+      ring_to_write = 0;
+    }
+    return (u32)(ring_to_write > ring_max ? ring_max : ring_to_write);
+  }
+
   // ─────────────────────────────────────────────────────────────────────
   // STEP 1: Query ALSA for delay and available space
   // ─────────────────────────────────────────────────────────────────────
@@ -668,6 +1298,8 @@ u32 linux_get_samples_to_write(LinuxAudioConfig *audio_config,
 
   if (err < 0) {
     // Underrun or error - try to recover
+    DE100_PROFILE_INSTANT("audio_underrun");
+    linux_audio_note_xrun();
     err = SndPcmRecover(g_linux_audio_output.pcm_handle, err, 1);
     if (err < 0) {
       fprintf(stderr, "⚠️  Audio: Recovery failed: %s\n", SndStrerror(err));
@@ -675,11 +1307,14 @@ u32 linux_get_samples_to_write(LinuxAudioConfig *audio_config,
     }
     delay_frames = 0;
   }
+  audio_config->queued_samples = (i32)delay_frames;
 
   snd_pcm_sframes_t avail_frames = SndPcmAvail(g_linux_audio_output.pcm_handle);
 
   if (avail_frames < 0) {
     // Error - try to recover
+    DE100_PROFILE_INSTANT("audio_underrun");
+    linux_audio_note_xrun();
     err = SndPcmRecover(g_linux_audio_output.pcm_handle, (int)avail_frames, 1);
     if (err < 0) {
       return 0;
@@ -702,10 +1337,6 @@ u32 linux_get_samples_to_write(LinuxAudioConfig *audio_config,
   //
   // ─────────────────────────────────────────────────────────────────────
 
-  // Target: keep (latency + safety) samples in the buffer
-  i32 target_buffered = g_linux_audio_output.latency_sample_count +
-                        g_linux_audio_output.safety_sample_count;
-
   // Current buffered amount is approximately: buffer_size - avail
   i32 current_buffered =
       (i32)g_linux_audio_output.buffer_size - (i32)avail_frames;
@@ -804,6 +1435,38 @@ u32 linux_get_samples_to_write(LinuxAudioConfig *audio_config,
   return samples_to_write;
 }
 
+// ═══════════════════════════════════════════════════════════════════════════
+// 🗺️ BEGIN WRITE (zero-copy mmap, see audio.h)
+// ═══════════════════════════════════════════════════════════════════════════
+
+u32 linux_begin_audio_write(LinuxAudioConfig *audio_config,
+                            GameAudioOutputBuffer *audio_output, u32 frames) {
+  LinuxSoundOutput *output = &g_linux_audio_output;
+  if (frames == 0 || !audio_config->is_initialized ||
+      audio_config->use_audio_thread ||
+      output->device_mode != LINUX_AUDIO_DEVICE_MMAP_S16) {
+    return frames;
+  }
+
+  // Errors fall through to the copy path, which recovers them
+  if (SndPcmAvailUpdate(output->pcm_handle) <= 0) {
+    return frames;
+  }
+  const snd_pcm_channel_area_t *areas = NULL;
+  snd_pcm_uframes_t offset = 0;
+  snd_pcm_uframes_t contiguous = (snd_pcm_uframes_t)frames;
+  if (SndPcmMmapBegin(output->pcm_handle, &areas, &offset, &contiguous) < 0 ||
+      contiguous == 0) {
+    return frames;
+  }
+
+  output->staging_samples = audio_output->samples;
+  output->mapped_samples = linux_alsa_area_frame(areas, offset);
+  output->mapped_offset = offset;
+  audio_output->samples = output->mapped_samples;
+  return (u32)contiguous;
+}
+
 // ═══════════════════════════════════════════════════════════════════════════
 // 🔊 SEND SAMPLES TO ALSA
 // ═══════════════════════════════════════════════════════════════════════════
@@ -815,7 +1478,7 @@ u32 linux_get_samples_to_write(LinuxAudioConfig *audio_config,
 
 void linux_send_samples_to_alsa(LinuxAudioConfig *audio_config,
                                 GameAudioOutputBuffer *source) {
-  if (!audio_config->is_initialized || !g_linux_audio_output.pcm_handle) {
+  if (!audio_config->is_initialized || !linux_audio_output_is_open()) {
     return;
   }
 
@@ -823,6 +1486,32 @@ void linux_send_samples_to_alsa(LinuxAudioConfig *audio_config,
     return;
   }
 
+  // Zero copy: the game wrote into the device ring; just commit it
+  if (g_linux_audio_output.mapped_samples &&
+      source->samples == g_linux_audio_output.mapped_samples) {
+    snd_pcm_sframes_t committed = SndPcmMmapCommit(
+        g_linux_audio_output.pcm_handle, g_linux_audio_output.mapped_offset,
+        (snd_pcm_uframes_t)source->sample_count);
+    source->samples = g_linux_audio_output.staging_samples;
+    g_linux_audio_output.mapped_samples = NULL;
+    if (committed < 0) {
+      DE100_PROFILE_INSTANT("audio_underrun");
+      linux_audio_note_xrun();
+      SndPcmRecover(g_linux_audio_output.pcm_handle, (int)committed, 0);
+      return;
+    }
+    audio_config->running_sample_index += committed;
+    return;
+  }
+
+  // Threaded: the audio thread writes to ALSA and advances
+  // running_sample_index
+  if (audio_config->use_audio_thread) {
+    de100_audio_ring_write(&g_linux_audio_output.ring, source->samples,
+                           (u32)source->sample_count);
+    return;
+  }
+
   // ─────────────────────────────────────────────────────────────────────
   // Write samples to ALSA
   // ─────────────────────────────────────────────────────────────────────
@@ -837,11 +1526,12 @@ void linux_send_samples_to_alsa(LinuxAudioConfig *audio_config,
   // ─────────────────────────────────────────────────────────────────────
 
   snd_pcm_sframes_t frames_written =
-      SndPcmWritei(g_linux_audio_output.pcm_handle, source->samples,
-                   (snd_pcm_uframes_t)source->sample_count);
+      linux_alsa_write(source->samples, (u32)source->sample_count);
 
   if (frames_written < 0) {
     // Error occurred - try to recover
+    DE100_PROFILE_INSTANT("audio_underrun");
+    linux_audio_note_xrun();
     int err =
         SndPcmRecover(g_linux_audio_output.pcm_handle, (int)frames_written, 0);
 
@@ -853,8 +1543,7 @@ void linux_send_samples_to_alsa(LinuxAudioConfig *audio_config,
 
     // Retry the write after recovery
     frames_written =
-        SndPcmWritei(g_linux_audio_output.pcm_handle, source->samples,
-                     (snd_pcm_uframes_t)source->sample_count);
+        linux_alsa_write(source->samples, (u32)source->sample_count);
 
     if (frames_written < 0) {
       fprintf(stderr, "⚠️  Audio: Write still failing after recovery\n");
@@ -871,7 +1560,7 @@ void linux_send_samples_to_alsa(LinuxAudioConfig *audio_config,
 // ═══════════════════════════════════════════════════════════════════════════
 
 void linux_clear_audio_buffer(LinuxAudioConfig *audio_config) {
-  if (!audio_config->is_initialized || !g_linux_audio_output.pcm_handle) {
+  if (!audio_config->is_initialized || !linux_audio_output_is_open()) {
     return;
   }
 
@@ -883,10 +1572,16 @@ void linux_clear_audio_buffer(LinuxAudioConfig *audio_config) {
   i32 samples_to_clear = (i32)(g_linux_audio_output.sample_buffer_size /
                                audio_config->bytes_per_sample);
 
+  if (audio_config->use_audio_thread) {
+    de100_audio_ring_write(&g_linux_audio_output.ring,
+                           (i16 *)g_linux_audio_output.sample_buffer.base,
+                           (u32)samples_to_clear);
+    return;
+  }
+
   // Write silence
-  SndPcmWritei(g_linux_audio_output.pcm_handle,
-               g_linux_audio_output.sample_buffer.base,
-               (snd_pcm_uframes_t)samples_to_clear);
+  linux_alsa_write((i16 *)g_linux_audio_output.sample_buffer.base,
+                   (u32)samples_to_clear);
 }
 
 // ═══════════════════════════════════════════════════════════════════════════
@@ -899,11 +1594,16 @@ void linux_debug_audio_latency(LinuxAudioConfig *audio_config) {
     return;
   }
 
-  // Query current ALSA state
+  // Query current ALSA state (server: what it reports queued)
   snd_pcm_sframes_t delay_frames = 0;
-  SndPcmDelay(g_linux_audio_output.pcm_handle, &delay_frames);
-
-  snd_pcm_sframes_t avail_frames = SndPcmAvail(g_linux_audio_output.pcm_handle);
+  snd_pcm_sframes_t avail_frames = 0;
+  if (g_linux_audio_output.pulse.is_open) {
+    delay_frames = (snd_pcm_sframes_t)linux_pulse_queued_frames(
+        &g_linux_audio_output.pulse);
+  } else if (g_linux_audio_output.pcm_handle) {
+    SndPcmDelay(g_linux_audio_output.pcm_handle, &delay_frames);
+    avail_frames = SndPcmAvail(g_linux_audio_output.pcm_handle);
+  }
 
   float runtime_seconds = (float)audio_config->running_sample_index /
                           (float)audio_config->samples_per_second;
@@ -914,7 +1614,14 @@ void linux_debug_audio_latency(LinuxAudioConfig *audio_config) {
   printf("┌─────────────────────────────────────────────────────────────┐\n");
   printf("│ 🔊 ALSA AUDIO DEBUG INFO                                    │\n");
   printf("├─────────────────────────────────────────────────────────────┤\n");
-  printf("│ Mode: Ring buffer with snd_pcm_writei()                     │\n");
+  printf("│ Mode: %-53s │\n",
+         g_linux_audio_output.device_mode == LINUX_AUDIO_DEVICE_MMAP_S16
+             ? "mmap, 16-bit (game writes the device ring)"
+         : g_linux_audio_output.device_mode == LINUX_AUDIO_DEVICE_MMAP_FLOAT
+             ? "mmap, float (converted on copy)"
+         : g_linux_audio_output.device_mode == LINUX_AUDIO_DEVICE_SERVER
+             ? "Sound server stream (libpulse, no ALSA)"
+             : "Ring buffer with snd_pcm_writei()");
   printf("│                                                             │\n");
   printf("│ Sample rate:        %6d Hz                               │\n",
          audio_config->samples_per_second);
@@ -954,6 +1661,8 @@ void linux_debug_audio_latency(LinuxAudioConfig *audio_config) {
 void linux_unload_alsa(LinuxAudioConfig *audio_config) {
   printf("🔊 Shutting down ALSA audio...\n");
 
+  linux_audio_thread_stop(audio_config);
+
   // Close PCM device
   if (g_linux_audio_output.pcm_handle) {
     SndPcmDrop(g_linux_audio_output.pcm_handle);
@@ -966,6 +1675,8 @@ void linux_unload_alsa(LinuxAudioConfig *audio_config) {
     de100_memory_free(&g_linux_audio_output.sample_buffer);
   }
 
+  linux_pulse_unload();
+
   // Unload ALSA library
   if (g_linux_audio_output.alsa_library) {
     dlclose(g_linux_audio_output.alsa_library);
@@ -984,6 +1695,10 @@ void linux_unload_alsa(LinuxAudioConfig *audio_config) {
     SndPcmGetParams_ = AlsaSndPcmGetParamsStub;
     SndPcmStart_ = AlsaSndPcmStartStub;
     SndPcmDrop_ = AlsaSndPcmDropStub;
+    SndPcmAvailUpdate_ = AlsaSndPcmAvailUpdateStub;
+    SndPcmMmapBegin_ = AlsaSndPcmMmapBeginStub;
+    SndPcmMmapCommit_ = AlsaSndPcmMmapCommitStub;
+    SndPcmWait_ = AlsaSndPcmWaitStub;
   }
 
   audio_config->is_initialized = false;
@@ -1021,6 +1736,10 @@ void linux_audio_fps_change_handling(GameAudioOutputBuffer *audio_output,
   audio_config->latency_samples = g_linux_audio_output.latency_sample_count;
   audio_config->safety_samples = g_linux_audio_output.safety_sample_count;
 
+  if (audio_config->adaptive_latency) {
+    linux_audio_latency_reset(audio_config);
+  }
+
   printf("[AUDIO] FPS changed: new latency=%d samples, safety=%d samples\n",
          g_linux_audio_output.latency_sample_count,
          g_linux_audio_output.safety_sample_count);
@@ -1085,6 +1804,10 @@ void linux_debug_capture_flip_state(LinuxAudioConfig *audio_config) {
   marker->flip_delay_frames = delay_frames;
   marker->flip_avail_frames = avail_frames;
 
+  FlightRecorderAudio flight = {play_cursor_bytes, write_cursor_bytes,
+                                delay_frames, avail_frames};
+  flight_recorder_audio(&flight);
+
   // Move to next marker slot
   g_debug_marker_index = (g_debug_marker_index + 1) % MAX_DEBUG_AUDIO_MARKERS;
 }
@@ -1158,6 +1881,8 @@ de100_file_scoped_fn void linux_debug_draw_bar(GameBackBuffer *buffer, i32 x1,
   if (bottom > buffer->height)
     bottom = buffer->height;
 
+  de100_backbuffer_mark_dirty(buffer, x1, top, x2 - x1, bottom - top);
+
   for (i32 y = top; y < bottom; y++) {
     u32 *row_start = (u32 *)((u8 *)buffer->memory.base + y * buffer->pitch);
     for (i32 x = x1; x < x2; x++) {
@@ -1208,11 +1933,11 @@ void linux_debug_sync_display(GameBackBuffer *buffer,
   f32 scale = (f32)drawable_width / (f32)buffer_size_frames;
 
   // Colors
-  u32 delay_color = 0xFFFFFFFF;   // White: queued/playing audio
-  u32 avail_color = 0xFF404040;   // Dark gray: available space (background)
-  u32 written_color = 0xFF00FF00; // Green: samples we just wrote
-  u32 target_color = 0xFFFFFF00;  // Yellow: target latency marker
-  u32 safety_color = 0xFFFF00FF;  // Magenta: safety margin
+  u32 delay_color = DE100_PIXEL_PACK(255, 255, 255, 255); // Queued/playing
+  u32 avail_color = DE100_PIXEL_PACK(64, 64, 64, 255);    // Available space
+  u32 written_color = DE100_PIXEL_PACK(0, 255, 0, 255);   // Just written
+  u32 target_color = DE100_PIXEL_PACK(255, 255, 0, 255);  // Target latency
+  u32 safety_color = DE100_PIXEL_PACK(255, 0, 255, 255);  // Safety margin
 
   // Target latency in frames (for reference line)
   i32 target_latency_frames = g_linux_audio_output.latency_sample_count;
@@ -4,6 +4,9 @@
 #include "../../_common/base.h"
 #include "../../_common/memory.h"
 #include "../../game/audio.h"
+#include "../_common/audio-ring.h"
+#include "audio-pulse.h"
+#include <pthread.h>
 #include <stdbool.h>
 #include <stdint.h>
 
@@ -17,9 +20,23 @@ typedef struct _snd_pcm_hw_params snd_pcm_hw_params_t;
 typedef long snd_pcm_sframes_t;
 typedef unsigned long snd_pcm_uframes_t;
 
-typedef enum { LINUX_SND_PCM_FORMAT_S16_LE = 2 } linux_snd_pcm_format_t;
+typedef enum {
+  LINUX_SND_PCM_FORMAT_S16_LE = 2,
+  LINUX_SND_PCM_FORMAT_FLOAT_LE = 14
+} linux_snd_pcm_format_t;
+
+typedef enum {
+  LINUX_SND_PCM_ACCESS_MMAP_INTERLEAVED = 0,
+  LINUX_SND_PCM_ACCESS_RW_INTERLEAVED = 3
+} linux_snd_pcm_access_t;
 
-typedef enum { LINUX_SND_PCM_ACCESS_RW_INTERLEAVED = 3 } linux_snd_pcm_access_t;
+// One channel's view of the mmap'd ring (interleaved: same addr, first
+// bit offset per channel, step = frame size in bits)
+typedef struct {
+  void *addr;
+  unsigned int first;
+  unsigned int step;
+} snd_pcm_channel_area_t;
 
 typedef enum { LINUX_SND_PCM_STREAM_PLAYBACK = 0 } linux_snd_pcm_stream_t;
 
@@ -71,6 +88,22 @@ typedef ALSA_SND_PCM_START(alsa_snd_pcm_start);
 #define ALSA_SND_PCM_DROP(name) int name(snd_pcm_t *pcm)
 typedef ALSA_SND_PCM_DROP(alsa_snd_pcm_drop);
 
+#define ALSA_SND_PCM_AVAIL_UPDATE(name) long name(snd_pcm_t *pcm)
+typedef ALSA_SND_PCM_AVAIL_UPDATE(alsa_snd_pcm_avail_update);
+
+#define ALSA_SND_PCM_MMAP_BEGIN(name)                                          \
+  int name(snd_pcm_t *pcm, const snd_pcm_channel_area_t **areas,              \
+           snd_pcm_uframes_t *offset, snd_pcm_uframes_t *frames)
+typedef ALSA_SND_PCM_MMAP_BEGIN(alsa_snd_pcm_mmap_begin);
+
+#define ALSA_SND_PCM_MMAP_COMMIT(name)                                         \
+  snd_pcm_sframes_t name(snd_pcm_t *pcm, snd_pcm_uframes_t offset,            \
+                         snd_pcm_uframes_t frames)
+typedef ALSA_SND_PCM_MMAP_COMMIT(alsa_snd_pcm_mmap_commit);
+
+#define ALSA_SND_PCM_WAIT(name) int name(snd_pcm_t *pcm, int timeout)
+typedef ALSA_SND_PCM_WAIT(alsa_snd_pcm_wait);
+
 // Stub declarations
 ALSA_SND_PCM_OPEN(AlsaSndPcmOpenStub);
 ALSA_SND_PCM_SET_PARAMS(AlsaSndPcmSetParamsStub);
@@ -84,6 +117,10 @@ ALSA_SND_PCM_DELAY(AlsaSndPcmDelayStub);
 ALSA_SND_PCM_GET_PARAMS(AlsaSndPcmGetParamsStub);
 ALSA_SND_PCM_START(AlsaSndPcmStartStub);
 ALSA_SND_PCM_DROP(AlsaSndPcmDropStub);
+ALSA_SND_PCM_AVAIL_UPDATE(AlsaSndPcmAvailUpdateStub);
+ALSA_SND_PCM_MMAP_BEGIN(AlsaSndPcmMmapBeginStub);
+ALSA_SND_PCM_MMAP_COMMIT(AlsaSndPcmMmapCommitStub);
+ALSA_SND_PCM_WAIT(AlsaSndPcmWaitStub);
 
 // Global function pointers
 extern alsa_snd_pcm_open *SndPcmOpen_;
@@ -98,6 +135,10 @@ extern alsa_snd_pcm_delay *SndPcmDelay_;
 extern alsa_snd_pcm_get_params *SndPcmGetParams_;
 extern alsa_snd_pcm_start *SndPcmStart_;
 extern alsa_snd_pcm_drop *SndPcmDrop_;
+extern alsa_snd_pcm_avail_update *SndPcmAvailUpdate_;
+extern alsa_snd_pcm_mmap_begin *SndPcmMmapBegin_;
+extern alsa_snd_pcm_mmap_commit *SndPcmMmapCommit_;
+extern alsa_snd_pcm_wait *SndPcmWait_;
 
 // Clean API names
 #define SndPcmOpen SndPcmOpen_
@@ -112,6 +153,10 @@ extern alsa_snd_pcm_drop *SndPcmDrop_;
 #define SndPcmGetParams SndPcmGetParams_
 #define SndPcmStart SndPcmStart_
 #define SndPcmDrop SndPcmDrop_
+#define SndPcmAvailUpdate SndPcmAvailUpdate_
+#define SndPcmMmapBegin SndPcmMmapBegin_
+#define SndPcmMmapCommit SndPcmMmapCommit_
+#define SndPcmWait SndPcmWait_
 
 // ═══════════════════════════════════════════════════════════════// 🔊 LINUX /
 // ALSA PRIVATE AUDIO CONFIG
@@ -130,8 +175,113 @@ typedef struct {
   i32 safety_samples;       /* Guard margin: ~1/3 frame */
   i64 running_sample_index; /* Total samples written to ALSA — write cursor */
   bool is_initialized;      /* True after successful ALSA init */
+  bool use_audio_thread;    /* Set before init: feed ALSA from its own thread */
+  bool adaptive_latency;    /* Set before init: closed-loop write-ahead */
+  bool use_mmap;            /* Set before init: write into the mmap'd ring */
+  bool use_audio_server;    /* Set before init: try libpulse before ALSA */
+  bool realtime_thread;     /* Set before init: RT-schedule the audio thread */
+  i32 realtime_priority;    /* SCHED_FIFO level for it (0 = default) */
+  i32 frame_gap_samples;    /* Extra write-ahead (linux_audio_set_frame_gap) */
+  i32 queued_samples;       /* Queued ahead of the next write, last query */
 } LinuxAudioConfig;
 
+// ══════════════════════════════════════════════════════════════
+// 🎚️ ADAPTIVE LATENCY (LinuxAudioConfig.adaptive_latency)
+// ══════════════════════════════════════════════════════════════
+//
+// Replaces the fixed "latency + safety" write-ahead with a target that
+// follows what this machine actually does:
+//
+//   interval  EWMA of the time between linux_get_samples_to_write() calls
+//   jitter    EWMA of |interval sample - interval|
+//
+//   desired = interval + 4 * jitter + margin      (clamped to min..max)
+//
+//   underrun          → target *= 1.5 at once, hold off shrinking for 3s
+//   desired > target  → grow to desired at once
+//   desired < target  → shrink a quarter of the gap every 0.5s
+//
+// So a quiet machine settles near one frame + a few ms, and load backs it
+// off before it crackles instead of after every crackle.
+// ══════════════════════════════════════════════════════════════
+
+#define LINUX_AUDIO_LATENCY_MIN_MS 10.0f
+#define LINUX_AUDIO_LATENCY_MARGIN_MS 2.0f
+#define LINUX_AUDIO_LATENCY_JITTER_SCALE 4.0f
+#define LINUX_AUDIO_LATENCY_HOLD_SECONDS 3.0
+#define LINUX_AUDIO_LATENCY_ADJUST_SECONDS 0.5
+
+typedef struct {
+  f64 last_call_seconds;
+  f64 last_underrun_seconds;
+  f64 last_adjust_seconds;
+  f32 interval_ms;
+  f32 jitter_ms;
+  f32 target_ms; // Current write-ahead
+  f32 min_ms;
+  f32 max_ms;   // Bounded by the device buffer (or ring)
+  u64 seen_underruns;
+} LinuxAudioLatencyController;
+
+// ══════════════════════════════════════════════════════════════
+// 🔊 THREADED OUTPUT (LinuxAudioConfig.use_audio_thread)
+// ══════════════════════════════════════════════════════════════
+//
+//   main thread                         audio thread
+//   get_audio_samples ─▶ ring (SPSC) ─▶ snd_pcm_writei, one period at a
+//   (tops the ring up to                time, blocking on the device
+//    latency + safety samples)
+//
+// The device deadline no longer depends on frame pacing: a long frame
+// drains the ring instead of the ALSA buffer, so ALSA itself can run with
+// a small buffer. If the ring runs dry the thread pads with silence only
+// when ALSA is about to starve.
+//
+// In this mode linux_get_samples_to_write() / linux_send_samples_to_alsa()
+// size against and push into the ring; debug cursor markers aren't updated.
+// ══════════════════════════════════════════════════════════════
+
+#define LINUX_AUDIO_THREAD_ALSA_LATENCY_US 10000 // ALSA buffer when threaded
+
+// ══════════════════════════════════════════════════════════════
+// 🗺️ MMAP OUTPUT (LinuxAudioConfig.use_mmap)
+// ══════════════════════════════════════════════════════════════
+//
+// Negotiated at init, first match wins:
+//
+//   MMAP_INTERLEAVED + S16_LE    game renders straight into the ring
+//   MMAP_INTERLEAVED + FLOAT_LE  i16 → f32 while copying into the ring
+//   RW_INTERLEAVED   + S16_LE    snd_pcm_writei (the only mode without
+//                                use_mmap)
+//
+// Zero copy (main-thread S16 only): linux_begin_audio_write() maps the
+// next contiguous region of the device ring and points
+// GameAudioOutputBuffer.samples at it; linux_send_samples_to_alsa()
+// commits it and restores the staging pointer. The region stops at the
+// ring's wrap, so a call may be granted fewer frames than asked; the next
+// call makes up the difference. Everything else (audio thread, silence,
+// float devices) goes through linux_alsa_write(), which copies or
+// converts into the mapped areas.
+// ══════════════════════════════════════════════════════════════
+
+// ══════════════════════════════════════════════════════════════
+// 🔊 SOUND SERVER OUTPUT (LinuxAudioConfig.use_audio_server)
+// ══════════════════════════════════════════════════════════════
+//
+// Tried first when asked for (see audio-pulse.h); ALSA isn't opened at
+// all if the server accepts the stream. The server's write callback is
+// the ring consumer, so this runs in threaded mode (use_audio_thread is
+// forced on) with LINUX_AUDIO_THREAD_ALSA_LATENCY_US as the server-side
+// buffer. No server, or a stream it refuses, falls through to ALSA.
+// ══════════════════════════════════════════════════════════════
+
+typedef enum {
+  LINUX_AUDIO_DEVICE_RW_S16 = 0,
+  LINUX_AUDIO_DEVICE_MMAP_S16,
+  LINUX_AUDIO_DEVICE_MMAP_FLOAT,
+  LINUX_AUDIO_DEVICE_SERVER, // libpulse stream, no ALSA PCM
+} LinuxAudioDeviceMode;
+
 // ══════════════════════════════════════════════════════════════// 🔊 LINUX
 // SOUND OUTPUT STATE
 // ═══════════════════════════════════════════════════════════════
@@ -158,6 +308,28 @@ typedef struct {
   // - Same calculation (but in samples, not bytes)
   // - Formula: (samples_per_second / game_update_hz) / 3
   i32 safety_sample_count; // Safety margin (1/3 frame worth of samples)
+
+  // Threaded output (see above)
+  De100AudioRing ring;
+  De100MemoryBlock ring_memory;
+  De100MemoryBlock period_buffer; // Audio thread's staging for one period
+  u32 period_size;                // ALSA period in frames
+  pthread_t audio_thread;
+  bool32 audio_thread_started;
+  bool32 audio_thread_running;  // __atomic
+  u64 ring_underrun_count;      // Silence padded because the ring ran dry
+
+  u64 xrun_count; // __atomic: ALSA underruns recovered (either thread)
+  LinuxAudioLatencyController latency_controller;
+
+  // mmap output (see above)
+  LinuxAudioDeviceMode device_mode;
+  void *staging_samples;           // GameAudioOutputBuffer.samples to restore
+  void *mapped_samples;            // Region handed to the game, or NULL
+  snd_pcm_uframes_t mapped_offset; // ...and its ring offset for commit
+
+  // Sound server output (see above)
+  LinuxPulseOutput pulse;
 } LinuxSoundOutput;
 
 extern LinuxSoundOutput g_linux_audio_output;
@@ -260,13 +432,36 @@ bool linux_init_audio(LinuxAudioConfig *audio_config,
 
 u32 linux_get_samples_to_write(LinuxAudioConfig *audio_config,
                                GameAudioOutputBuffer *audio_output);
+
+/**
+ * Stretch the write-ahead so playback survives frames `frame_seconds`
+ * apart (background throttling); 0 restores the normal target. The
+ * device buffer or ring and one submission's worth of samples bound the
+ * stretch, so the return value is the longest frame interval actually
+ * covered (`frame_seconds` itself when there is no audio output).
+ */
+f32 linux_audio_set_frame_gap(LinuxAudioConfig *audio_config,
+                              f32 frame_seconds);
 void linux_debug_audio_latency(LinuxAudioConfig *audio_config);
 void linux_unload_alsa(LinuxAudioConfig *audio_config);
 void linux_audio_fps_change_handling(GameAudioOutputBuffer *audio_output,
                                      LinuxAudioConfig *audio_config);
 
+/**
+ * Zero-copy mmap mode: point audio_output->samples into the device ring
+ * for up to `frames` frames and return how many the game may write (may
+ * be fewer at the ring's wrap). Other modes return `frames` unchanged.
+ */
+u32 linux_begin_audio_write(LinuxAudioConfig *audio_config,
+                            GameAudioOutputBuffer *audio_output, u32 frames);
 void linux_send_samples_to_alsa(LinuxAudioConfig *audio_config,
                                 GameAudioOutputBuffer *source);
 void linux_clear_audio_buffer(LinuxAudioConfig *audio_config);
 
+/** Stop and join the audio thread (no-op when not threaded). */
+void linux_audio_thread_stop(LinuxAudioConfig *audio_config);
+
+/** ALSA xruns plus ring underruns so far (any thread may add to them). */
+u64 linux_audio_underrun_count(void);
+
 #endif // DE100_PLATFORMS_X11_AUDIO_H
@@ -2,27 +2,49 @@
 #include "../../engine.h"
 
 #include "../../_common/base.h"
+#include "../../_common/log.h"
+#include "../../_internal/utils.h"
 #include "../../game/backbuffer.h"
 #include "../../game/base.h"
 #include "../../game/config.h"
 #include "../../game/game-loader.h"
 #include "../../game/inputs.h"
 #include "../_common/adaptive-fps.h"
+#include "../_common/capture.h"
 #include "../_common/config.h"
+#include "../_common/debug-overlay.h"
+#include "../_common/dynamic-resolution.h"
+#include "../_common/fixed-timestep.h"
+#include "../_common/flight-recorder.h"
+#include "../_common/frame-graph.h"
+#include "../_common/frame-stats.h"
 #include "../_common/frame-timing.h"
+#include "../_common/input-latency.h"
+#include "../_common/present-scale.h"
+#include "../_common/present-thread.h"
+#include "../_common/render-pipeline.h"
 #include "../_common/inputs-recording.h"
+#include "../_common/spectate.h"
+#include "../_common/telemetry.h"
+#include "../_common/trace-export.h"
 #include "./audio.h"
 #include "./hooks/inputs/joystick.h"
 #include "./hooks/inputs/keyboard.h"
+#include "./inputs/evdev.h"
+#include "./inputs/keymap.h"
 #include "./inputs/mouse.h"
+#include "./event-wait.h"
+#include "./shm-present.h"
 
 #include <GL/gl.h>
 #include <GL/glx.h>
 #include <X11/X.h>
+#include <X11/Xatom.h>
 #include <X11/Xlib.h>
 #include <X11/Xutil.h>
 #include <X11/extensions/Xrandr.h>
 #include <linux/joystick.h>
+#include <pthread.h>
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdio.h>
@@ -30,9 +52,119 @@
 #include <string.h>
 #include <unistd.h>
 
-#if DE100_INTERNAL
-#include "../_common/frame-stats.h"
-#endif
+
+// ─────────────────────────────────────────────────────────────────────
+// TEXTURE UPLOAD PATHS (best available is picked in opengl_init)
+// ─────────────────────────────────────────────────────────────────────
+//   PERSISTENT_PBO: GL 4.4 / ARB_buffer_storage + ARB_sync. A ring of
+//                   persistently mapped PBOs; glTexSubImage2D reads from
+//                   the PBO on the GPU timeline, fences guard reuse.
+//   PBO:            GL 2.1 / ARB_pixel_buffer_object. Orphan + map the
+//                   next ring PBO each frame, memcpy, async TexSubImage.
+//   TEX_SUB_IMAGE:  No PBOs. Synchronous glTexSubImage2D from client
+//                   memory (still avoids reallocating the texture).
+// ─────────────────────────────────────────────────────────────────────
+
+typedef enum {
+  OPENGL_UPLOAD_TEX_SUB_IMAGE = 0,
+  OPENGL_UPLOAD_PBO,
+  OPENGL_UPLOAD_PERSISTENT_PBO,
+
+  OPENGL_UPLOAD_COUNT
+} OpenGLUploadMode;
+
+#define OPENGL_PBO_RING_SIZE 3
+
+typedef struct {
+  PFNGLGENBUFFERSPROC gen_buffers;
+  PFNGLDELETEBUFFERSPROC delete_buffers;
+  PFNGLBINDBUFFERPROC bind_buffer;
+  PFNGLBUFFERDATAPROC buffer_data;
+  PFNGLBUFFERSTORAGEPROC buffer_storage;
+  PFNGLMAPBUFFERRANGEPROC map_buffer_range;
+  PFNGLUNMAPBUFFERPROC unmap_buffer;
+  PFNGLTEXSTORAGE2DPROC tex_storage_2d;
+  PFNGLFENCESYNCPROC fence_sync;
+  PFNGLCLIENTWAITSYNCPROC client_wait_sync;
+  PFNGLDELETESYNCPROC delete_sync;
+
+  // Core-profile presenter (and glGetStringi for core extension queries)
+  PFNGLGETSTRINGIPROC get_stringi;
+  PFNGLCREATESHADERPROC create_shader;
+  PFNGLSHADERSOURCEPROC shader_source;
+  PFNGLCOMPILESHADERPROC compile_shader;
+  PFNGLGETSHADERIVPROC get_shaderiv;
+  PFNGLGETSHADERINFOLOGPROC get_shader_info_log;
+  PFNGLDELETESHADERPROC delete_shader;
+  PFNGLCREATEPROGRAMPROC create_program;
+  PFNGLATTACHSHADERPROC attach_shader;
+  PFNGLLINKPROGRAMPROC link_program;
+  PFNGLGETPROGRAMIVPROC get_programiv;
+  PFNGLGETPROGRAMINFOLOGPROC get_program_info_log;
+  PFNGLUSEPROGRAMPROC use_program;
+  PFNGLGETUNIFORMLOCATIONPROC get_uniform_location;
+  PFNGLUNIFORM1IPROC uniform1i;
+  PFNGLUNIFORM1FPROC uniform1f;
+  PFNGLGENVERTEXARRAYSPROC gen_vertex_arrays;
+  PFNGLBINDVERTEXARRAYPROC bind_vertex_array;
+} OpenGLExtensions;
+
+// ─────────────────────────────────────────────────────────────────────
+// PRESENTERS (GameConfig.prefer_core_profile_present)
+// ─────────────────────────────────────────────────────────────────────
+//   LEGACY  glXCreateContext, fixed-function glOrtho + GL_QUADS.
+//   CORE    GL 3.3 core via glXCreateContextAttribsARB.
+//   GLES    GLES 3.0 (GLX_EXT_create_context_es2_profile) when there is
+//           no desktop core profile.
+//
+// CORE/GLES draw one full-screen triangle from gl_VertexID (empty VAO,
+// no vertex buffer) with glViewport set to the PresentScaleRect; the
+// fragment shader samples the backbuffer texture, swaps red/blue when
+// the upload could not (GLES has no GL_BGRA), and applies the optional
+// scanline darkening. Further GPU post effects belong in that shader.
+// Upload paths (PBO rings) are shared by every presenter.
+// ─────────────────────────────────────────────────────────────────────
+
+typedef enum {
+  OPENGL_PRESENTER_LEGACY = 0,
+  OPENGL_PRESENTER_CORE,
+  OPENGL_PRESENTER_GLES,
+
+  OPENGL_PRESENTER_COUNT
+} OpenGLPresenter;
+
+// ─────────────────────────────────────────────────────────────────────
+// PRESENT TIMING (GameConfig.prefer_vblank_present_timing)
+// ─────────────────────────────────────────────────────────────────────
+//   Swap control  GLX_EXT_swap_control (or GLX_MESA_swap_control) sets
+//                 the swap interval to the target frame time in vblanks,
+//                 so glXSwapBuffers paces the loop (no frame_timing sleep).
+//   Feedback      GLX_OML_sync_control: glXWaitForSbcOML blocks until the
+//                 swap has hit the screen and returns its vblank UST/MSC.
+//                 Without OML, glFinish + the wall clock approximates it.
+//
+//   flip interval = ust - last_ust      (fed to frame_timing/adaptive FPS)
+//   missed vblanks = (msc - last_msc) - swap_interval
+// ─────────────────────────────────────────────────────────────────────
+
+typedef struct {
+  PFNGLXSWAPINTERVALEXTPROC swap_interval_ext;
+  PFNGLXSWAPINTERVALMESAPROC swap_interval_mesa;
+  PFNGLXGETMSCRATEOMLPROC get_msc_rate;
+  PFNGLXWAITFORSBCOMLPROC wait_for_sbc;
+
+  bool enabled;
+  f64 refresh_hz;
+  i32 swap_interval; // Vblanks per frame (0 = not set yet)
+
+  // Last flip
+  bool has_last;
+  i64 last_ust; // Microseconds (Mesa/NVIDIA: CLOCK_MONOTONIC)
+  i64 last_msc;
+  f64 last_flip_seconds; // Wall clock, no-OML fallback
+  f32 flip_interval_seconds;
+  u32 missed_vblanks;
+} OpenGLPresentTiming;
 
 typedef struct {
   Display *display;
@@ -41,6 +173,38 @@ typedef struct {
   GLuint texture_id;
   int width;
   int height;
+
+  OpenGLExtensions ext;
+  OpenGLUploadMode upload_mode;
+
+  // CORE/GLES presenter objects (0 with the legacy presenter)
+  OpenGLPresenter presenter;
+  GLuint program;
+  GLuint vertex_array;
+  GLint uniform_swap_red_blue;
+  GLint uniform_scanline_intensity;
+  bool swap_red_blue; // Upload is BGRA bytes labelled GL_RGBA
+
+  // Client pixel layout for every upload, from DE100_PIXEL_FORMAT
+  GLenum upload_format;
+  GLenum upload_type;
+
+  // Texture storage currently allocated (0 = none yet)
+  int texture_width;
+  int texture_height;
+
+  // PBO ring
+  GLuint pbos[OPENGL_PBO_RING_SIZE];
+  void *pbo_mapped[OPENGL_PBO_RING_SIZE]; // PERSISTENT_PBO only
+  GLsync pbo_fences[OPENGL_PBO_RING_SIZE];
+  size_t pbo_size;
+  u32 pbo_index;
+
+  // Game renders straight into the mapped PBO (GameConfig opt-in)
+  bool mapped_backbuffer;
+  void *backbuffer_original_base;
+
+  OpenGLPresentTiming present;
 } OpenGLState;
 
 typedef struct {
@@ -66,6 +230,54 @@ de100_file_scoped_global_var OpenGLState g_gl = {0};
 de100_file_scoped_global_var bool g_window_is_active = true;
 de100_file_scoped_global_var int g_last_window_width = 0;
 de100_file_scoped_global_var int g_last_window_height = 0;
+// X server Time (ms) → de100_get_wall_clock() for input events
+de100_file_scoped_global_var De100InputClock g_x11_input_clock = {0};
+
+// XInputExtension opcode when raw mouse motion is on, else -1
+de100_file_scoped_global_var int g_x11_xi_opcode = -1;
+
+// Interned once at init (one round-trip for all); never per event
+typedef struct {
+  Atom wm_protocols;
+  Atom wm_delete_window;
+  Atom net_wm_state;
+  Atom net_wm_state_hidden;
+} X11Atoms;
+de100_file_scoped_global_var X11Atoms g_x11_atoms = {0};
+
+// ─────────────────────────────────────────────────────────────────────
+// Background throttling (GameConfig.prefer_background_throttle)
+// ─────────────────────────────────────────────────────────────────────
+//
+//   unfocused          background_fps, still rendered and presented
+//   hidden             background_fps, no render, no present
+//
+// "Hidden" is any of: unmapped (minimized on most WMs), fully obscured
+// (VisibilityNotify, only without a compositor) or _NET_WM_STATE_HIDDEN
+// (minimized / other workspace, what compositing WMs report instead).
+// Fixed-timestep ticks and the audio write-ahead stretch to the longer
+// frames, so the game's clock and sound don't notice.
+
+typedef struct {
+  bool is_unmapped;
+  bool is_obscured;
+  bool is_wm_hidden;
+
+  bool is_throttled;
+  bool is_skipping_present;
+  bool needs_fresh_frame; // Presenting again: render before the present
+  f32 seconds_per_frame;  // While throttled
+} X11BackgroundState;
+de100_file_scoped_global_var X11BackgroundState g_x11_background = {0};
+
+#if DE100_INTERNAL
+// X requests issued per frame (NextRequest deltas), for the health check.
+// Calls that block on a reply also mark a "x11_round_trip" profiler
+// instant, so the profiler's hit count is round-trips per frame.
+de100_file_scoped_global_var unsigned long g_x11_last_request = 0;
+de100_file_scoped_global_var u64 g_x11_requests_since_report = 0;
+de100_file_scoped_global_var u32 g_x11_frames_since_report = 0;
+#endif
 
 // ═══════════════════════════════════════════════════════════════════════════
 // OpenGL Functions
@@ -73,6 +285,9 @@ de100_file_scoped_global_var int g_last_window_height = 0;
 
 de100_file_scoped_fn inline void opengl_update_projection(int window_width,
                                                           int window_height) {
+  if (g_gl.presenter != OPENGL_PRESENTER_LEGACY) {
+    return; // Viewport is set per draw from the PresentScaleRect
+  }
   // TODO: Make this call configurable
   glViewport(0, 0, window_width, window_height); // Add this!
   glMatrixMode(GL_PROJECTION);
@@ -82,88 +297,950 @@ de100_file_scoped_fn inline void opengl_update_projection(int window_width,
   glLoadIdentity();
 }
 
-de100_file_scoped_fn inline bool opengl_init(Display *display, Window window,
-                                             int width, int height) {
-  int visual_attribs[] = {GLX_RGBA, GLX_DEPTH_SIZE, 24, GLX_DOUBLEBUFFER, None};
+de100_file_scoped_global_var const char
+    *g_opengl_upload_mode_names[OPENGL_UPLOAD_COUNT] = {
+        [OPENGL_UPLOAD_TEX_SUB_IMAGE] = "glTexSubImage2D",
+        [OPENGL_UPLOAD_PBO] = "PBO ring",
+        [OPENGL_UPLOAD_PERSISTENT_PBO] = "persistent-mapped PBO ring",
+};
+
+de100_file_scoped_global_var const char
+    *g_opengl_presenter_names[OPENGL_PRESENTER_COUNT] = {
+        [OPENGL_PRESENTER_LEGACY] = "legacy",
+        [OPENGL_PRESENTER_CORE] = "core 3.3",
+        [OPENGL_PRESENTER_GLES] = "GLES 3.0",
+};
+
+de100_file_scoped_fn inline bool
+opengl_extension_list_has(const char *extensions, const char *name) {
+  if (!extensions) {
+    return false;
+  }
 
-  XVisualInfo *visual =
-      glXChooseVisual(display, DefaultScreen(display), visual_attribs);
-  if (!visual) {
-    fprintf(stderr, "❌ No suitable OpenGL visual found\n");
+  size_t name_length = strlen(name);
+  const char *cursor = extensions;
+  while ((cursor = strstr(cursor, name)) != NULL) {
+    bool starts = cursor == extensions || cursor[-1] == ' ';
+    bool ends = cursor[name_length] == ' ' || cursor[name_length] == '\0';
+    if (starts && ends) {
+      return true;
+    }
+    cursor += name_length;
+  }
+  return false;
+}
+
+de100_file_scoped_fn inline bool opengl_has_extension(const char *name) {
+  // Core profiles removed glGetString(GL_EXTENSIONS): one name per index
+  if (g_gl.presenter == OPENGL_PRESENTER_CORE && g_gl.ext.get_stringi) {
+    GLint count = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+    for (GLint i = 0; i < count; ++i) {
+      const char *extension =
+          (const char *)g_gl.ext.get_stringi(GL_EXTENSIONS, (GLuint)i);
+      if (extension && strcmp(extension, name) == 0) {
+        return true;
+      }
+    }
+    return false;
+  }
+  return opengl_extension_list_has((const char *)glGetString(GL_EXTENSIONS),
+                                   name);
+}
+
+de100_file_scoped_fn inline bool glx_has_extension(const char *name) {
+  return opengl_extension_list_has(
+      glXQueryExtensionsString(g_gl.display, DefaultScreen(g_gl.display)),
+      name);
+}
+
+de100_file_scoped_fn inline bool opengl_version_at_least(int major,
+                                                         int minor) {
+  const char *version = (const char *)glGetString(GL_VERSION);
+  int have_major = 0, have_minor = 0;
+  // GLES reports "OpenGL ES 3.2 ..."; its PBO/map/sync features line up
+  // with desktop 3.x, storage extensions are checked by name anyway
+  if (version && strncmp(version, "OpenGL ES ", 10) == 0) {
+    version += 10;
+  }
+  if (!version || sscanf(version, "%d.%d", &have_major, &have_minor) != 2) {
+    return false;
+  }
+  return have_major > major || (have_major == major && have_minor >= minor);
+}
+
+#define OPENGL_LOAD_PROC(type, name)                                           \
+  ((type)glXGetProcAddressARB((const GLubyte *)(name)))
+
+de100_file_scoped_fn inline void opengl_load_extensions(void) {
+  OpenGLExtensions *ext = &g_gl.ext;
+
+  ext->get_stringi = OPENGL_LOAD_PROC(PFNGLGETSTRINGIPROC, "glGetStringi");
+  ext->gen_buffers = OPENGL_LOAD_PROC(PFNGLGENBUFFERSPROC, "glGenBuffers");
+  ext->delete_buffers =
+      OPENGL_LOAD_PROC(PFNGLDELETEBUFFERSPROC, "glDeleteBuffers");
+  ext->bind_buffer = OPENGL_LOAD_PROC(PFNGLBINDBUFFERPROC, "glBindBuffer");
+  ext->buffer_data = OPENGL_LOAD_PROC(PFNGLBUFFERDATAPROC, "glBufferData");
+  ext->buffer_storage =
+      OPENGL_LOAD_PROC(PFNGLBUFFERSTORAGEPROC, "glBufferStorage");
+  ext->map_buffer_range =
+      OPENGL_LOAD_PROC(PFNGLMAPBUFFERRANGEPROC, "glMapBufferRange");
+  ext->unmap_buffer = OPENGL_LOAD_PROC(PFNGLUNMAPBUFFERPROC, "glUnmapBuffer");
+  ext->tex_storage_2d =
+      OPENGL_LOAD_PROC(PFNGLTEXSTORAGE2DPROC, "glTexStorage2D");
+  ext->fence_sync = OPENGL_LOAD_PROC(PFNGLFENCESYNCPROC, "glFenceSync");
+  ext->client_wait_sync =
+      OPENGL_LOAD_PROC(PFNGLCLIENTWAITSYNCPROC, "glClientWaitSync");
+  ext->delete_sync = OPENGL_LOAD_PROC(PFNGLDELETESYNCPROC, "glDeleteSync");
+
+  // glXGetProcAddress may return non-NULL for unsupported entry points, so
+  // the version/extension string is the source of truth.
+  bool has_pbo = (opengl_version_at_least(2, 1) ||
+                  opengl_has_extension("GL_ARB_pixel_buffer_object")) &&
+                 (opengl_version_at_least(3, 0) ||
+                  opengl_has_extension("GL_ARB_map_buffer_range")) &&
+                 ext->gen_buffers && ext->bind_buffer && ext->buffer_data &&
+                 ext->map_buffer_range && ext->unmap_buffer;
+  bool has_persistent = has_pbo &&
+                        (opengl_version_at_least(4, 4) ||
+                         opengl_has_extension("GL_ARB_buffer_storage")) &&
+                        (opengl_version_at_least(3, 2) ||
+                         opengl_has_extension("GL_ARB_sync")) &&
+                        ext->buffer_storage && ext->fence_sync &&
+                        ext->client_wait_sync && ext->delete_sync;
+
+  if (!(opengl_version_at_least(4, 2) ||
+        opengl_has_extension("GL_ARB_texture_storage"))) {
+    ext->tex_storage_2d = NULL;
+  }
+
+  g_gl.upload_mode = has_persistent ? OPENGL_UPLOAD_PERSISTENT_PBO
+                     : has_pbo      ? OPENGL_UPLOAD_PBO
+                                    : OPENGL_UPLOAD_TEX_SUB_IMAGE;
+}
+
+/**
+ * Upload in the backbuffer's own layout, so the driver never converts.
+ * Desktop GL stores textures as BGRA internally: an RGBA8 build is
+ * still correct but may pay a driver-side swizzle, so say so once.
+ */
+de100_file_scoped_fn inline bool opengl_select_pixel_format(void) {
+  g_gl.swap_red_blue = false;
+#if DE100_PIXEL_FORMAT == DE100_PIXEL_FORMAT_BGRA8
+  if (g_gl.presenter == OPENGL_PRESENTER_GLES) {
+    // No GL_BGRA in GLES 3.0: upload the bytes as-is, swap in the shader
+    g_gl.upload_format = GL_RGBA;
+    g_gl.upload_type = GL_UNSIGNED_BYTE;
+    g_gl.swap_red_blue = true;
+    return true;
+  }
+  if (!opengl_version_at_least(1, 2) &&
+      !opengl_has_extension("GL_EXT_bgra")) {
+    fprintf(stderr, "❌ BGRA8 backbuffer needs GL 1.2 or GL_EXT_bgra\n");
     return false;
   }
+  g_gl.upload_format = GL_BGRA;
+  g_gl.upload_type = GL_UNSIGNED_INT_8_8_8_8_REV;
+#else
+  g_gl.upload_format = GL_RGBA;
+  g_gl.upload_type = GL_UNSIGNED_BYTE;
+  printf("ℹ️  Backbuffer is RGBA8; desktop GL's native upload is BGRA8 "
+         "(-DDE100_PIXEL_FORMAT=1)\n");
+#endif
+  return true;
+}
 
-  g_gl.gl_context = glXCreateContext(display, visual, NULL, GL_TRUE);
+de100_file_scoped_fn inline void opengl_create_texture(void) {
+  glGenTextures(1, &g_gl.texture_id);
+  glBindTexture(GL_TEXTURE_2D, g_gl.texture_id);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+  g_gl.texture_width = 0;
+  g_gl.texture_height = 0;
+}
+
+de100_file_scoped_fn inline void opengl_wait_pbo_fence(u32 slot) {
+  if (g_gl.pbo_fences[slot]) {
+    g_gl.ext.client_wait_sync(g_gl.pbo_fences[slot],
+                              GL_SYNC_FLUSH_COMMANDS_BIT,
+                              1000000000ull); // 1s safety timeout
+    g_gl.ext.delete_sync(g_gl.pbo_fences[slot]);
+    g_gl.pbo_fences[slot] = NULL;
+  }
+}
+
+de100_file_scoped_fn inline void opengl_release_pbos(void) {
+  if (g_gl.upload_mode == OPENGL_UPLOAD_TEX_SUB_IMAGE || !g_gl.pbos[0]) {
+    return;
+  }
+
+  for (u32 i = 0; i < OPENGL_PBO_RING_SIZE; ++i) {
+    if (g_gl.upload_mode == OPENGL_UPLOAD_PERSISTENT_PBO) {
+      opengl_wait_pbo_fence(i);
+      if (g_gl.pbo_mapped[i]) {
+        g_gl.ext.bind_buffer(GL_PIXEL_UNPACK_BUFFER, g_gl.pbos[i]);
+        g_gl.ext.unmap_buffer(GL_PIXEL_UNPACK_BUFFER);
+        g_gl.pbo_mapped[i] = NULL;
+      }
+    }
+  }
+  g_gl.ext.bind_buffer(GL_PIXEL_UNPACK_BUFFER, 0);
+  g_gl.ext.delete_buffers(OPENGL_PBO_RING_SIZE, g_gl.pbos);
+  memset(g_gl.pbos, 0, sizeof(g_gl.pbos));
+  g_gl.pbo_size = 0;
+  g_gl.pbo_index = 0;
+}
+
+de100_file_scoped_fn inline bool
+opengl_create_pbo_ring(GameBackBuffer *backbuffer) {
+  g_gl.pbo_size = (size_t)backbuffer->pitch * (size_t)backbuffer->height;
+  g_gl.pbo_index = 0;
+  g_gl.ext.gen_buffers(OPENGL_PBO_RING_SIZE, g_gl.pbos);
+
+  for (u32 i = 0; i < OPENGL_PBO_RING_SIZE; ++i) {
+    g_gl.ext.bind_buffer(GL_PIXEL_UNPACK_BUFFER, g_gl.pbos[i]);
+    if (g_gl.upload_mode == OPENGL_UPLOAD_PERSISTENT_PBO) {
+      GLbitfield flags =
+          GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+      g_gl.ext.buffer_storage(GL_PIXEL_UNPACK_BUFFER,
+                              (GLsizeiptr)g_gl.pbo_size, NULL, flags);
+      g_gl.pbo_mapped[i] = g_gl.ext.map_buffer_range(
+          GL_PIXEL_UNPACK_BUFFER, 0, (GLsizeiptr)g_gl.pbo_size, flags);
+      if (!g_gl.pbo_mapped[i]) {
+        opengl_release_pbos();
+        return false;
+      }
+    } else {
+      g_gl.ext.buffer_data(GL_PIXEL_UNPACK_BUFFER, (GLsizeiptr)g_gl.pbo_size,
+                           NULL, GL_STREAM_DRAW);
+    }
+  }
+
+  g_gl.ext.bind_buffer(GL_PIXEL_UNPACK_BUFFER, 0);
+  return true;
+}
+
+/**
+ * (Re)allocate texture storage + PBO ring when the backbuffer size changes.
+ * Immutable storage (glTexStorage2D) can't be resized, so the texture is
+ * recreated in that case.
+ */
+de100_file_scoped_fn inline void
+opengl_ensure_stream_storage(GameBackBuffer *backbuffer) {
+  if (g_gl.texture_width == backbuffer->width &&
+      g_gl.texture_height == backbuffer->height) {
+    return;
+  }
+
+  if (g_gl.texture_width != 0 && g_gl.ext.tex_storage_2d) {
+    glDeleteTextures(1, &g_gl.texture_id);
+    opengl_create_texture();
+  }
+
+  glBindTexture(GL_TEXTURE_2D, g_gl.texture_id);
+  if (g_gl.ext.tex_storage_2d) {
+    g_gl.ext.tex_storage_2d(GL_TEXTURE_2D, 1, GL_RGBA8, backbuffer->width,
+                            backbuffer->height);
+  } else {
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, backbuffer->width,
+                 backbuffer->height, 0, g_gl.upload_format, g_gl.upload_type,
+                 NULL);
+  }
+  g_gl.texture_width = backbuffer->width;
+  g_gl.texture_height = backbuffer->height;
+
+  if (g_gl.upload_mode == OPENGL_UPLOAD_TEX_SUB_IMAGE) {
+    return;
+  }
+
+  opengl_release_pbos();
+  if (!opengl_create_pbo_ring(backbuffer)) {
+    fprintf(stderr, "⚠️  Persistent PBO map failed, using PBO ring\n");
+    g_gl.upload_mode = OPENGL_UPLOAD_PBO;
+    g_gl.mapped_backbuffer = false;
+    opengl_create_pbo_ring(backbuffer);
+  }
+
+  if (g_gl.mapped_backbuffer) {
+    backbuffer->memory.base = g_gl.pbo_mapped[0];
+  }
+}
+
+/**
+ * Let the game render straight into persistently mapped PBO memory,
+ * removing the per-frame memcpy. Only valid when the game redraws every
+ * pixel each frame and never reads the backbuffer back: mapped memory is
+ * usually write-combined (reads are very slow) and rotates through the
+ * ring, so it does NOT hold last frame's pixels.
+ */
+de100_file_scoped_fn inline bool
+opengl_attach_mapped_backbuffer(GameBackBuffer *backbuffer) {
+  if (g_gl.upload_mode != OPENGL_UPLOAD_PERSISTENT_PBO) {
+    return false;
+  }
+  g_gl.backbuffer_original_base = backbuffer->memory.base;
+  g_gl.mapped_backbuffer = true;
+  g_gl.texture_width = 0;
+  g_gl.texture_height = 0;
+  opengl_ensure_stream_storage(backbuffer);
+  return g_gl.mapped_backbuffer;
+}
+
+de100_file_scoped_fn inline void
+opengl_detach_mapped_backbuffer(GameBackBuffer *backbuffer) {
+  if (g_gl.mapped_backbuffer) {
+    backbuffer->memory.base = g_gl.backbuffer_original_base;
+    g_gl.mapped_backbuffer = false;
+  }
+}
+
+/**
+ * Upload only the listed rects straight from client memory.
+ * The texture keeps last frame's pixels everywhere else.
+ */
+de100_file_scoped_fn inline void
+opengl_upload_dirty_rects(GameBackBuffer *backbuffer) {
+  GameDirtyRegion *dirty = &backbuffer->dirty;
+
+  glBindTexture(GL_TEXTURE_2D, g_gl.texture_id);
+  glPixelStorei(GL_UNPACK_ROW_LENGTH,
+                backbuffer->pitch / backbuffer->bytes_per_pixel);
+
+  for (int i = 0; i < dirty->count; ++i) {
+    De100DirtyRect *rect = &dirty->rects[i];
+    glPixelStorei(GL_UNPACK_SKIP_PIXELS, rect->x);
+    glPixelStorei(GL_UNPACK_SKIP_ROWS, rect->y);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, rect->x, rect->y, rect->width,
+                    rect->height, g_gl.upload_format, g_gl.upload_type,
+                    backbuffer->memory.base);
+  }
+
+  glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0);
+  glPixelStorei(GL_UNPACK_SKIP_ROWS, 0);
+  glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+}
+
+de100_file_scoped_fn inline void
+opengl_upload_backbuffer(GameBackBuffer *backbuffer) {
+  // Partial present needs the texture to still hold last frame, and a
+  // stable client pointer (the mapped PBO ring rotates it every frame)
+  bool32 storage_is_current = g_gl.texture_width == backbuffer->width &&
+                              g_gl.texture_height == backbuffer->height;
+  GameDirtyRegion *dirty = &backbuffer->dirty;
+  if (dirty->is_tracking && !dirty->full_frame && !g_gl.mapped_backbuffer &&
+      storage_is_current) {
+    opengl_upload_dirty_rects(backbuffer);
+    de100_backbuffer_clear_dirty(backbuffer);
+    return;
+  }
+
+  opengl_ensure_stream_storage(backbuffer);
+
+  glBindTexture(GL_TEXTURE_2D, g_gl.texture_id);
+  glPixelStorei(GL_UNPACK_ROW_LENGTH,
+                backbuffer->pitch / backbuffer->bytes_per_pixel);
+
+  switch (g_gl.upload_mode) {
+  case OPENGL_UPLOAD_PERSISTENT_PBO: {
+    u32 slot = g_gl.pbo_index;
+    if (backbuffer->memory.base != g_gl.pbo_mapped[slot]) {
+      opengl_wait_pbo_fence(slot);
+      de100_mem_copy(g_gl.pbo_mapped[slot], backbuffer->memory.base,
+                     g_gl.pbo_size);
+    }
+
+    g_gl.ext.bind_buffer(GL_PIXEL_UNPACK_BUFFER, g_gl.pbos[slot]);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, backbuffer->width,
+                    backbuffer->height, g_gl.upload_format, g_gl.upload_type,
+                    (void *)0);
+    g_gl.ext.bind_buffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    g_gl.pbo_fences[slot] =
+        g_gl.ext.fence_sync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    g_gl.pbo_index = (slot + 1) % OPENGL_PBO_RING_SIZE;
+    if (g_gl.mapped_backbuffer) {
+      // Hand the game a slot the GPU is done reading
+      opengl_wait_pbo_fence(g_gl.pbo_index);
+      backbuffer->memory.base = g_gl.pbo_mapped[g_gl.pbo_index];
+    }
+  } break;
+
+  case OPENGL_UPLOAD_PBO: {
+    u32 slot = g_gl.pbo_index;
+    g_gl.ext.bind_buffer(GL_PIXEL_UNPACK_BUFFER, g_gl.pbos[slot]);
+    // Orphan: the driver hands back fresh storage instead of stalling
+    g_gl.ext.buffer_data(GL_PIXEL_UNPACK_BUFFER, (GLsizeiptr)g_gl.pbo_size,
+                         NULL, GL_STREAM_DRAW);
+    void *dest = g_gl.ext.map_buffer_range(
+        GL_PIXEL_UNPACK_BUFFER, 0, (GLsizeiptr)g_gl.pbo_size,
+        GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+    if (dest) {
+      de100_mem_copy(dest, backbuffer->memory.base, g_gl.pbo_size);
+      g_gl.ext.unmap_buffer(GL_PIXEL_UNPACK_BUFFER);
+      glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, backbuffer->width,
+                      backbuffer->height, g_gl.upload_format, g_gl.upload_type,
+                      (void *)0);
+      g_gl.ext.bind_buffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    } else {
+      g_gl.ext.bind_buffer(GL_PIXEL_UNPACK_BUFFER, 0);
+      glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, backbuffer->width,
+                      backbuffer->height, g_gl.upload_format, g_gl.upload_type,
+                      backbuffer->memory.base);
+    }
+    g_gl.pbo_index = (slot + 1) % OPENGL_PBO_RING_SIZE;
+  } break;
+
+  case OPENGL_UPLOAD_TEX_SUB_IMAGE:
+  default: {
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, backbuffer->width,
+                    backbuffer->height, g_gl.upload_format, g_gl.upload_type,
+                    backbuffer->memory.base);
+  } break;
+  }
+
+  glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+  de100_backbuffer_clear_dirty(backbuffer);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Core-profile presenter
+// ═══════════════════════════════════════════════════════════════════════════
+
+// Full-screen triangle: ids 0,1,2 → (-1,-1) (3,-1) (-1,3). uv.y is flipped
+// so backbuffer row 0 (top) lands at the top of the viewport.
+de100_file_scoped_global_var const char *g_opengl_present_vertex_shader =
+    "out vec2 v_uv;\n"
+    "void main() {\n"
+    "  vec2 corner = vec2(float((gl_VertexID << 1) & 2),\n"
+    "                     float(gl_VertexID & 2));\n"
+    "  v_uv = vec2(corner.x, 1.0 - corner.y);\n"
+    "  gl_Position = vec4(corner * 2.0 - 1.0, 0.0, 1.0);\n"
+    "}\n";
+
+de100_file_scoped_global_var const char *g_opengl_present_fragment_shader =
+    "in vec2 v_uv;\n"
+    "out vec4 o_color;\n"
+    "uniform sampler2D u_backbuffer;\n"
+    "uniform bool u_swap_red_blue;\n"
+    "uniform float u_scanline_intensity;\n"
+    "void main() {\n"
+    "  vec3 color = texture(u_backbuffer, v_uv).rgb;\n"
+    "  if (u_swap_red_blue) {\n"
+    "    color = color.bgr;\n"
+    "  }\n"
+    "  float row = v_uv.y * float(textureSize(u_backbuffer, 0).y);\n"
+    "  color *= 1.0 - u_scanline_intensity * step(0.5, fract(row));\n"
+    "  o_color = vec4(color, 1.0);\n"
+    "}\n";
+
+de100_file_scoped_global_var bool g_opengl_context_error = false;
+
+de100_file_scoped_fn int opengl_context_error_handler(Display *display,
+                                                      XErrorEvent *event) {
+  (void)display;
+  (void)event;
+  g_opengl_context_error = true;
+  return 0;
+}
+
+/**
+ * The GLXFBConfig behind `visual` (glXCreateContextAttribsARB wants an
+ * FBConfig; the window was created from a plain XVisualInfo).
+ */
+de100_file_scoped_fn inline bool
+opengl_find_fbconfig(Display *display, VisualID visual_id,
+                     GLXFBConfig *out_config) {
+  int fbconfig_attribs[] = {GLX_X_RENDERABLE, True,
+                            GLX_DRAWABLE_TYPE, GLX_WINDOW_BIT,
+                            GLX_RENDER_TYPE, GLX_RGBA_BIT,
+                            GLX_DOUBLEBUFFER, True,
+                            None};
+  int count = 0;
+  GLXFBConfig *configs = glXChooseFBConfig(display, DefaultScreen(display),
+                                           fbconfig_attribs, &count);
+  bool found = false;
+  for (int i = 0; configs && i < count && !found; ++i) {
+    XVisualInfo *info = glXGetVisualFromFBConfig(display, configs[i]);
+    if (info && info->visualid == visual_id) {
+      *out_config = configs[i];
+      found = true;
+    }
+    if (info) {
+      XFree(info);
+    }
+  }
+  if (configs) {
+    XFree(configs);
+  }
+  return found;
+}
+
+/**
+ * Core 3.3, else GLES 3.0. NULL (legacy context next) when the driver
+ * has neither; a refused request raises an X error, which is swallowed.
+ */
+de100_file_scoped_fn GLXContext opengl_create_core_context(
+    Display *display, VisualID visual_id, OpenGLPresenter *out_presenter) {
+  GLXFBConfig fbconfig;
+  if (!glx_has_extension("GLX_ARB_create_context_profile") ||
+      !opengl_find_fbconfig(display, visual_id, &fbconfig)) {
+    return NULL;
+  }
+  PFNGLXCREATECONTEXTATTRIBSARBPROC create_context = OPENGL_LOAD_PROC(
+      PFNGLXCREATECONTEXTATTRIBSARBPROC, "glXCreateContextAttribsARB");
+  if (!create_context) {
+    return NULL;
+  }
+
+  int core_attribs[] = {GLX_CONTEXT_MAJOR_VERSION_ARB,
+                        3,
+                        GLX_CONTEXT_MINOR_VERSION_ARB,
+                        3,
+                        GLX_CONTEXT_PROFILE_MASK_ARB,
+                        GLX_CONTEXT_CORE_PROFILE_BIT_ARB,
+                        None};
+  int gles_attribs[] = {GLX_CONTEXT_MAJOR_VERSION_ARB,
+                        3,
+                        GLX_CONTEXT_MINOR_VERSION_ARB,
+                        0,
+                        GLX_CONTEXT_PROFILE_MASK_ARB,
+                        GLX_CONTEXT_ES2_PROFILE_BIT_EXT,
+                        None};
+  struct {
+    const int *attribs;
+    OpenGLPresenter presenter;
+    bool supported;
+  } attempts[] = {
+      {core_attribs, OPENGL_PRESENTER_CORE, true},
+      {gles_attribs, OPENGL_PRESENTER_GLES,
+       glx_has_extension("GLX_EXT_create_context_es2_profile")},
+  };
+
+  GLXContext context = NULL;
+  for (u32 i = 0; i < ArraySize(attempts) && !context; ++i) {
+    if (!attempts[i].supported) {
+      continue;
+    }
+    g_opengl_context_error = false;
+    XSync(display, False);
+    int (*previous)(Display *, XErrorEvent *) =
+        XSetErrorHandler(opengl_context_error_handler);
+    context = create_context(display, fbconfig, NULL, True,
+                             attempts[i].attribs);
+    XSync(display, False);
+    XSetErrorHandler(previous);
+
+    if (g_opengl_context_error && context) {
+      glXDestroyContext(display, context);
+      context = NULL;
+    }
+    if (context) {
+      *out_presenter = attempts[i].presenter;
+    }
+  }
+  return context;
+}
+
+de100_file_scoped_fn inline void opengl_load_presenter_procs(void) {
+  OpenGLExtensions *ext = &g_gl.ext;
+  ext->create_shader =
+      OPENGL_LOAD_PROC(PFNGLCREATESHADERPROC, "glCreateShader");
+  ext->shader_source =
+      OPENGL_LOAD_PROC(PFNGLSHADERSOURCEPROC, "glShaderSource");
+  ext->compile_shader =
+      OPENGL_LOAD_PROC(PFNGLCOMPILESHADERPROC, "glCompileShader");
+  ext->get_shaderiv = OPENGL_LOAD_PROC(PFNGLGETSHADERIVPROC, "glGetShaderiv");
+  ext->get_shader_info_log =
+      OPENGL_LOAD_PROC(PFNGLGETSHADERINFOLOGPROC, "glGetShaderInfoLog");
+  ext->delete_shader =
+      OPENGL_LOAD_PROC(PFNGLDELETESHADERPROC, "glDeleteShader");
+  ext->create_program =
+      OPENGL_LOAD_PROC(PFNGLCREATEPROGRAMPROC, "glCreateProgram");
+  ext->attach_shader =
+      OPENGL_LOAD_PROC(PFNGLATTACHSHADERPROC, "glAttachShader");
+  ext->link_program = OPENGL_LOAD_PROC(PFNGLLINKPROGRAMPROC, "glLinkProgram");
+  ext->get_programiv =
+      OPENGL_LOAD_PROC(PFNGLGETPROGRAMIVPROC, "glGetProgramiv");
+  ext->get_program_info_log =
+      OPENGL_LOAD_PROC(PFNGLGETPROGRAMINFOLOGPROC, "glGetProgramInfoLog");
+  ext->use_program = OPENGL_LOAD_PROC(PFNGLUSEPROGRAMPROC, "glUseProgram");
+  ext->get_uniform_location =
+      OPENGL_LOAD_PROC(PFNGLGETUNIFORMLOCATIONPROC, "glGetUniformLocation");
+  ext->uniform1i = OPENGL_LOAD_PROC(PFNGLUNIFORM1IPROC, "glUniform1i");
+  ext->uniform1f = OPENGL_LOAD_PROC(PFNGLUNIFORM1FPROC, "glUniform1f");
+  ext->gen_vertex_arrays =
+      OPENGL_LOAD_PROC(PFNGLGENVERTEXARRAYSPROC, "glGenVertexArrays");
+  ext->bind_vertex_array =
+      OPENGL_LOAD_PROC(PFNGLBINDVERTEXARRAYPROC, "glBindVertexArray");
+}
+
+/** Compile one stage behind the profile's #version line; 0 on failure. */
+de100_file_scoped_fn GLuint opengl_compile_shader(GLenum stage,
+                                                  const char *body) {
+  const char *header = g_gl.presenter == OPENGL_PRESENTER_GLES
+                           ? "#version 300 es\nprecision mediump float;\n"
+                           : "#version 330 core\n";
+  const char *sources[] = {header, body};
+
+  GLuint shader = g_gl.ext.create_shader(stage);
+  g_gl.ext.shader_source(shader, 2, sources, NULL);
+  g_gl.ext.compile_shader(shader);
+
+  GLint compiled = GL_FALSE;
+  g_gl.ext.get_shaderiv(shader, GL_COMPILE_STATUS, &compiled);
+  if (!compiled) {
+    char log[512] = {0};
+    g_gl.ext.get_shader_info_log(shader, sizeof(log), NULL, log);
+    fprintf(stderr, "❌ Present shader failed to compile:\n%s\n", log);
+    g_gl.ext.delete_shader(shader);
+    return 0;
+  }
+  return shader;
+}
+
+de100_file_scoped_fn bool opengl_create_presenter(void) {
+  opengl_load_presenter_procs();
+  OpenGLExtensions *ext = &g_gl.ext;
+  if (!ext->create_shader || !ext->link_program || !ext->gen_vertex_arrays ||
+      !ext->bind_vertex_array || !ext->uniform1f) {
+    return false;
+  }
+
+  GLuint vertex =
+      opengl_compile_shader(GL_VERTEX_SHADER, g_opengl_present_vertex_shader);
+  GLuint fragment = opengl_compile_shader(GL_FRAGMENT_SHADER,
+                                          g_opengl_present_fragment_shader);
+  if (!vertex || !fragment) {
+    return false;
+  }
+
+  g_gl.program = ext->create_program();
+  ext->attach_shader(g_gl.program, vertex);
+  ext->attach_shader(g_gl.program, fragment);
+  ext->link_program(g_gl.program);
+  ext->delete_shader(vertex); // Freed with the program
+  ext->delete_shader(fragment);
+
+  GLint linked = GL_FALSE;
+  ext->get_programiv(g_gl.program, GL_LINK_STATUS, &linked);
+  if (!linked) {
+    char log[512] = {0};
+    ext->get_program_info_log(g_gl.program, sizeof(log), NULL, log);
+    fprintf(stderr, "❌ Present shader failed to link:\n%s\n", log);
+    g_gl.program = 0;
+    return false;
+  }
+
+  g_gl.uniform_swap_red_blue =
+      ext->get_uniform_location(g_gl.program, "u_swap_red_blue");
+  g_gl.uniform_scanline_intensity =
+      ext->get_uniform_location(g_gl.program, "u_scanline_intensity");
+
+  ext->use_program(g_gl.program);
+  ext->uniform1i(ext->get_uniform_location(g_gl.program, "u_backbuffer"), 0);
+  ext->uniform1i(g_gl.uniform_swap_red_blue, g_gl.swap_red_blue ? 1 : 0);
+
+  // Core profiles refuse draws without a bound VAO, even attribute-less
+  ext->gen_vertex_arrays(1, &g_gl.vertex_array);
+  ext->bind_vertex_array(g_gl.vertex_array);
+  return true;
+}
+
+/**
+ * Create the context (core/GLES when preferred, else legacy) and
+ * everything that depends on it: upload path, pixel format, texture,
+ * shader. A presenter that fails to build retries as legacy.
+ */
+de100_file_scoped_fn bool opengl_init_context(Display *display, Window window,
+                                              XVisualInfo *visual,
+                                              bool prefer_core) {
+  g_gl.presenter = OPENGL_PRESENTER_LEGACY;
+  g_gl.gl_context = NULL;
+  if (prefer_core) {
+    g_gl.gl_context =
+        opengl_create_core_context(display, visual->visualid, &g_gl.presenter);
+  }
+  if (!g_gl.gl_context) {
+    g_gl.presenter = OPENGL_PRESENTER_LEGACY;
+    g_gl.gl_context = glXCreateContext(display, visual, NULL, GL_TRUE);
+  }
   if (!g_gl.gl_context) {
     fprintf(stderr, "❌ Failed to create OpenGL context\n");
-    XFree(visual);
     return false;
   }
 
   glXMakeCurrent(display, window, g_gl.gl_context);
 
+  opengl_load_extensions();
+  if (!opengl_select_pixel_format()) {
+    return false;
+  }
+  opengl_create_texture();
+
+  if (g_gl.presenter != OPENGL_PRESENTER_LEGACY && !opengl_create_presenter()) {
+    fprintf(stderr, "⚠️  %s presenter unavailable, using legacy GL\n",
+            g_opengl_presenter_names[g_gl.presenter]);
+    glXMakeCurrent(display, None, NULL);
+    glXDestroyContext(display, g_gl.gl_context);
+    g_gl.gl_context = NULL;
+    g_gl.ext = (OpenGLExtensions){0};
+    g_gl.program = 0;
+    g_gl.vertex_array = 0;
+    return opengl_init_context(display, window, visual, false);
+  }
+  return true;
+}
+
+de100_file_scoped_fn inline bool opengl_init(Display *display, Window window,
+                                             int width, int height,
+                                             const GameConfig *config) {
+  int visual_attribs[] = {GLX_RGBA, GLX_DEPTH_SIZE, 24, GLX_DOUBLEBUFFER, None};
+
+  XVisualInfo *visual =
+      glXChooseVisual(display, DefaultScreen(display), visual_attribs);
+  if (!visual) {
+    fprintf(stderr, "❌ No suitable OpenGL visual found\n");
+    return false;
+  }
+
   g_gl.display = display;
   g_gl.window = window;
   g_gl.width = width;
   g_gl.height = height;
 
-  glGenTextures(1, &g_gl.texture_id);
-  glBindTexture(GL_TEXTURE_2D, g_gl.texture_id);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+  if (!opengl_init_context(display, window, visual,
+                           config->prefer_core_profile_present)) {
+    XFree(visual);
+    return false;
+  }
 
-  glMatrixMode(GL_PROJECTION);
-  glLoadIdentity();
-  glOrtho(0, width, height, 0, -1, 1);
-  glMatrixMode(GL_MODELVIEW);
-  glLoadIdentity();
+  if (g_gl.presenter == OPENGL_PRESENTER_LEGACY) {
+    glMatrixMode(GL_PROJECTION);
+    glLoadIdentity();
+    glOrtho(0, width, height, 0, -1, 1);
+    glMatrixMode(GL_MODELVIEW);
+    glLoadIdentity();
 
-  opengl_update_projection(width, height);
+    opengl_update_projection(width, height);
 
-  glEnable(GL_TEXTURE_2D);
+    glEnable(GL_TEXTURE_2D);
+  }
 
-  printf("✅ OpenGL initialized (version: %s)\n", glGetString(GL_VERSION));
+  printf("✅ OpenGL initialized (version: %s, presenter: %s, upload: %s, "
+         "%s)\n",
+         glGetString(GL_VERSION), g_opengl_presenter_names[g_gl.presenter],
+         g_opengl_upload_mode_names[g_gl.upload_mode],
+         de100_pixel_format_name(DE100_PIXEL_FORMAT));
   XFree(visual);
   return true;
 }
 
+// ═══════════════════════════════════════════════════════════════════════════
+// Present timing
+// ═══════════════════════════════════════════════════════════════════════════
+
+/** Returns false (sleep pacing stays in charge) without swap control. */
+de100_file_scoped_fn inline bool
+opengl_init_present_timing(u32 fallback_refresh_hz) {
+  OpenGLPresentTiming *present = &g_gl.present;
+  *present = (OpenGLPresentTiming){0};
+
+  if (glx_has_extension("GLX_EXT_swap_control")) {
+    present->swap_interval_ext = OPENGL_LOAD_PROC(PFNGLXSWAPINTERVALEXTPROC,
+                                                  "glXSwapIntervalEXT");
+  } else if (glx_has_extension("GLX_MESA_swap_control")) {
+    present->swap_interval_mesa = OPENGL_LOAD_PROC(
+        PFNGLXSWAPINTERVALMESAPROC, "glXSwapIntervalMESA");
+  }
+  if (!present->swap_interval_ext && !present->swap_interval_mesa) {
+    return false;
+  }
+
+  if (glx_has_extension("GLX_OML_sync_control")) {
+    present->get_msc_rate =
+        OPENGL_LOAD_PROC(PFNGLXGETMSCRATEOMLPROC, "glXGetMscRateOML");
+    present->wait_for_sbc =
+        OPENGL_LOAD_PROC(PFNGLXWAITFORSBCOMLPROC, "glXWaitForSbcOML");
+  }
+
+  i32 numerator = 0, denominator = 0;
+  if (present->get_msc_rate &&
+      present->get_msc_rate(g_gl.display, g_gl.window, &numerator,
+                            &denominator) &&
+      numerator > 0 && denominator > 0) {
+    present->refresh_hz = (f64)numerator / (f64)denominator;
+  } else {
+    present->refresh_hz = (f64)fallback_refresh_hz;
+  }
+
+  present->enabled = true;
+  printf("✅ Vblank present timing (%.2fHz, feedback: %s)\n",
+         present->refresh_hz,
+         present->wait_for_sbc ? "GLX_OML_sync_control" : "glFinish");
+  return true;
+}
+
+/** Swap every N vblanks, N = target frame time in refresh periods. */
 de100_file_scoped_fn inline void
-opengl_display_buffer(GameBackBuffer *backbuffer, int window_width,
-                      int window_height) {
-  (void)window_width;
-  (void)window_height;
-  if (!de100_memory_is_valid(backbuffer->memory))
+opengl_present_set_target(f32 target_seconds_per_frame) {
+  OpenGLPresentTiming *present = &g_gl.present;
+  i32 interval =
+      (i32)((f64)target_seconds_per_frame * present->refresh_hz + 0.5);
+  if (interval < 1) {
+    interval = 1;
+  }
+  if (interval == present->swap_interval) {
     return;
+  }
+
+  if (present->swap_interval_ext) {
+    present->swap_interval_ext(g_gl.display, g_gl.window, interval);
+  } else {
+    present->swap_interval_mesa((unsigned int)interval);
+  }
+  present->swap_interval = interval;
+  present->has_last = false; // Interval change isn't a missed vblank
+}
+
+/**
+ * Block until the last swap is on screen and record when it got there.
+ * Returns the flip-to-flip interval in seconds (0 for the first flip).
+ */
+de100_file_scoped_fn inline f32 opengl_present_wait_for_flip(void) {
+  OpenGLPresentTiming *present = &g_gl.present;
+  f32 interval = 0.0f;
+
+  int64_t ust = 0, msc = 0, sbc = 0;
+  DE100_PROFILE_INSTANT("x11_round_trip");
+  if (present->wait_for_sbc &&
+      present->wait_for_sbc(g_gl.display, g_gl.window, 0, &ust, &msc,
+                            &sbc)) {
+    if (present->has_last) {
+      interval = (f32)((f64)(ust - present->last_ust) / 1000000.0);
+      i64 vblanks = msc - present->last_msc;
+      if (vblanks > present->swap_interval) {
+        present->missed_vblanks += (u32)(vblanks - present->swap_interval);
+      }
+    }
+    present->last_ust = ust;
+    present->last_msc = msc;
+  } else {
+    glFinish();
+    f64 now = de100_get_wall_clock();
+    if (present->has_last) {
+      interval = (f32)(now - present->last_flip_seconds);
+    }
+    present->last_flip_seconds = now;
+  }
+
+  present->has_last = true;
+  present->flip_interval_seconds = interval;
+  return interval;
+}
 
-  // Center the backbuffer in the window
-  int offset_x = (window_width - backbuffer->width) / 2;
-  int offset_y = (window_height - backbuffer->height) / 2;
+/**
+ * Draw the already-uploaded texture and swap. Used directly by Expose
+ * repaints so they never re-upload (or rotate the PBO ring) mid-frame.
+ */
+de100_file_scoped_fn inline void
+opengl_draw_backbuffer_texture(GameBackBuffer *backbuffer,
+                               const GameConfig *config, int window_width,
+                               int window_height) {
+  if (g_gl.texture_width == 0) {
+    return;
+  }
 
-  // Or fixed offset like Casey:
-  // int offset_x = 10;
-  // int offset_y = 10;
+  // Centered at native size, or stretched and letterboxed (the texture
+  // samples GL_NEAREST, so scaling stays blocky)
+  PresentScaleRect rect =
+      present_scale_compute(config, backbuffer->width, backbuffer->height,
+                            window_width, window_height);
+  if (!present_thread_is_current()) {
+    present_scale_set_current(rect); // Else the game thread set it
+  }
 
   glClear(GL_COLOR_BUFFER_BIT);
 
   glBindTexture(GL_TEXTURE_2D, g_gl.texture_id);
-  glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, backbuffer->width, backbuffer->height,
-               0, GL_RGBA, GL_UNSIGNED_BYTE, backbuffer->memory.base);
 
-  // Draw at offset with BACKBUFFER size, not window size
+  if (g_gl.presenter != OPENGL_PRESENTER_LEGACY) {
+    // The triangle covers the viewport; GL's origin is bottom-left
+    glViewport(rect.x, window_height - rect.y - rect.height, rect.width,
+               rect.height);
+    g_gl.ext.uniform1f(g_gl.uniform_scanline_intensity,
+                       config->present_scanline_intensity);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    glXSwapBuffers(g_gl.display, g_gl.window);
+    return;
+  }
+
+  // Draw the BACKBUFFER (or its scaled rect), not the window size
   glBegin(GL_QUADS);
   glTexCoord2f(0.0f, 0.0f);
-  glVertex2f(offset_x, offset_y);
+  glVertex2f(rect.x, rect.y);
   glTexCoord2f(1.0f, 0.0f);
-  glVertex2f(offset_x + backbuffer->width, offset_y);
+  glVertex2f(rect.x + rect.width, rect.y);
   glTexCoord2f(1.0f, 1.0f);
-  glVertex2f(offset_x + backbuffer->width, offset_y + backbuffer->height);
+  glVertex2f(rect.x + rect.width, rect.y + rect.height);
   glTexCoord2f(0.0f, 1.0f);
-  glVertex2f(offset_x, offset_y + backbuffer->height);
+  glVertex2f(rect.x, rect.y + rect.height);
   glEnd();
 
   glXSwapBuffers(g_gl.display, g_gl.window);
 }
 
+de100_file_scoped_fn inline void
+opengl_display_buffer(GameBackBuffer *backbuffer, const GameConfig *config,
+                      int window_width, int window_height) {
+  if (!de100_memory_is_valid(backbuffer->memory))
+    return;
+
+  opengl_upload_backbuffer(backbuffer);
+  opengl_draw_backbuffer_texture(backbuffer, config, window_width,
+                                 window_height);
+}
+
+// ─────────────────────────────────────────────────────────────────────
+// Present thread (GameConfig.prefer_present_thread)
+// ─────────────────────────────────────────────────────────────────────
+//
+// Every GL call after init happens in these, on the present thread,
+// until present_thread_stop hands the context back for teardown.
+
+de100_file_scoped_fn PRESENT_THREAD_CONTEXT(x11_present_thread_begin) {
+  (void)user;
+  glXMakeCurrent(g_gl.display, g_gl.window, g_gl.gl_context);
+}
+
+de100_file_scoped_fn PRESENT_THREAD_CONTEXT(x11_present_thread_end) {
+  (void)user;
+  glXMakeCurrent(g_gl.display, None, NULL);
+}
+
+de100_file_scoped_fn PRESENT_THREAD_PRESENT(x11_present_thread_present) {
+  const GameConfig *config = (const GameConfig *)user;
+  GameBackBuffer backbuffer = frame->backbuffer;
+
+  if (frame->window_width != g_gl.width ||
+      frame->window_height != g_gl.height) {
+    g_gl.width = frame->window_width;
+    g_gl.height = frame->window_height;
+    opengl_update_projection(g_gl.width, g_gl.height);
+  }
+
+  if (frame->is_repaint) {
+    opengl_draw_backbuffer_texture(&backbuffer, config, g_gl.width,
+                                   g_gl.height);
+    return 0.0f;
+  }
+
+  if (g_gl.present.enabled) {
+    opengl_present_set_target(frame->target_seconds_per_frame);
+  }
+  opengl_display_buffer(&backbuffer, config, g_gl.width, g_gl.height);
+  return g_gl.present.enabled ? opengl_present_wait_for_flip() : 0.0f;
+}
+
 #if DE100_SANITIZE_WAVE_1_MEMORY
 de100_file_scoped_fn inline void opengl_cleanup(void) {
   if (g_gl.gl_context) {
@@ -178,10 +1255,62 @@ de100_file_scoped_fn inline void opengl_cleanup(void) {
 // X11 Functions
 // ═══════════════════════════════════════════════════════════════════════════
 
+de100_file_scoped_fn inline f64 x11_event_seconds(Time time) {
+  return de100_input_clock_to_seconds(&g_x11_input_clock, (u32)time,
+                                      de100_get_wall_clock());
+}
+
+/** Queue a KEY event; the game's keyboard hook still does the mapping. */
+de100_file_scoped_fn inline void x11_push_key_event(XEvent *event,
+                                                    GameInput *input,
+                                                    bool is_down) {
+  GameInputEvent input_event = {
+      .seconds = x11_event_seconds(event->xkey.time),
+      .kind = DE100_INPUT_EVENT_KEY,
+      .is_down = is_down,
+      .controller = (u8)KEYBOARD_CONTROLLER_INDEX,
+      .code = (u32)x11_keymap_keysym(&event->xkey),
+  };
+  de100_input_push_event(input, &input_event);
+}
+
+/**
+ * True if the window's _NET_WM_STATE lists `state`. One round-trip, only
+ * when the WM changes the property.
+ */
+de100_file_scoped_fn bool x11_window_has_wm_state(Display *display,
+                                                  Window window, Atom state) {
+  Atom type = None;
+  int format = 0;
+  unsigned long count = 0, bytes_after = 0;
+  unsigned char *data = NULL;
+  DE100_PROFILE_INSTANT("x11_round_trip");
+  if (XGetWindowProperty(display, window, g_x11_atoms.net_wm_state, 0, 64,
+                         False, XA_ATOM, &type, &format, &count,
+                         &bytes_after, &data) != Success ||
+      !data) {
+    return false;
+  }
+
+  bool found = false;
+  if (type == XA_ATOM && format == 32) {
+    Atom *atoms = (Atom *)data;
+    for (unsigned long i = 0; i < count && !found; ++i) {
+      found = atoms[i] == state;
+    }
+  }
+  XFree(data);
+  return found;
+}
+
 de100_file_scoped_fn inline void x11_handle_event(Display *display,
                                                   XEvent *event,
                                                   EnginePlatformState *platform,
                                                   EngineGameState *game) {
+  if (x11_shm_present_handle_event(event)) {
+    return;
+  }
+
   switch (event->type) {
   case ConfigureNotify: {
     int new_width = event->xconfigure.width;
@@ -189,21 +1318,26 @@ de100_file_scoped_fn inline void x11_handle_event(Display *display,
 
     if (new_width != g_last_window_width ||
         new_height != g_last_window_height) {
-      printf("Window resized: %dx%d → %dx%d\n", g_last_window_width,
-             g_last_window_height, new_width, new_height);
+      DE100_LOG_DEBUG(DE100_LOG_PLATFORM, "Window resized: %dx%d → %dx%d",
+                      g_last_window_width, g_last_window_height, new_width,
+                      new_height);
       g_last_window_width = new_width;
       g_last_window_height = new_height;
 
-      // Update OpenGL projection to match new window size
-      opengl_update_projection(new_width, new_height);
+      // Update OpenGL projection to match new window size (the present
+      // thread does it when its next frame brings the new size; SHM
+      // re-centers at its next present)
+      if (!present_thread_is_active() && !x11_shm_present_is_active()) {
+        opengl_update_projection(new_width, new_height);
+      }
     }
     break;
   }
 
   case ClientMessage: {
-    Atom wmDelete = XInternAtom(display, "WM_DELETE_WINDOW", False);
-    if ((Atom)event->xclient.data.l[0] == wmDelete) {
-      printf("Window close requested\n");
+    if (event->xclient.message_type == g_x11_atoms.wm_protocols &&
+        (Atom)event->xclient.data.l[0] == g_x11_atoms.wm_delete_window) {
+      DE100_LOG_DEBUG(DE100_LOG_PLATFORM, "Window close requested");
       is_game_running = false;
     }
     break;
@@ -213,48 +1347,127 @@ de100_file_scoped_fn inline void x11_handle_event(Display *display,
   case Expose: {
     if (event->xexpose.count != 0)
       break;
-    printf("Repainting window\n");
-    opengl_display_buffer(&game->backbuffer, g_last_window_width,
-                          g_last_window_height);
+    DE100_LOG_TRACE(DE100_LOG_PLATFORM, "Repainting window");
+    if (present_thread_is_active()) {
+      present_thread_repaint(g_last_window_width, g_last_window_height);
+      break;
+    }
+    if (x11_shm_present_is_active()) {
+      x11_shm_present_repaint(g_last_window_width, g_last_window_height);
+      XFlush(display);
+      break;
+    }
+    opengl_draw_backbuffer_texture(&game->backbuffer, &game->config,
+                                   g_last_window_width, g_last_window_height);
     XFlush(display);
     break;
   }
 
   case FocusIn: {
-    printf("Window gained focus\n");
+    DE100_LOG_DEBUG(DE100_LOG_PLATFORM, "Window gained focus");
     g_window_is_active = true;
+    // Buttons may have changed while another window had the pointer
+    x11_poll_mouse(display, event->xfocus.window, game->inputs);
     break;
   }
 
   case FocusOut: {
-    printf("Window lost focus\n");
+    DE100_LOG_DEBUG(DE100_LOG_PLATFORM, "Window lost focus");
     g_window_is_active = false;
+    platform->rewind.is_held = false; // Its release goes elsewhere
+    break;
+  }
+
+  case MapNotify: {
+    g_x11_background.is_unmapped = false;
+    break;
+  }
+
+  case UnmapNotify: {
+    g_x11_background.is_unmapped = true;
+    break;
+  }
+
+  case VisibilityNotify: {
+    g_x11_background.is_obscured =
+        event->xvisibility.state == VisibilityFullyObscured;
+    break;
+  }
+
+  case PropertyNotify: {
+    if (event->xproperty.atom == g_x11_atoms.net_wm_state) {
+      g_x11_background.is_wm_hidden =
+          x11_window_has_wm_state(display, event->xproperty.window,
+                                  g_x11_atoms.net_wm_state_hidden);
+    }
     break;
   }
 
   case DestroyNotify: {
-    printf("Window destroyed\n");
+    DE100_LOG_DEBUG(DE100_LOG_PLATFORM, "Window destroyed");
     is_game_running = false;
     break;
   }
 
   case KeyPress: {
+    KeySym keysym = x11_keymap_keysym(&event->xkey);
+    if (keysym == XK_F12) {
+      capture_request_screenshot();
+      break;
+    }
+    if (keysym == XK_F6 && platform->rewind.is_enabled) {
+      platform->rewind.is_held = true;
+      break;
+    }
+#if DE100_INTERNAL
+    if (keysym == XK_F3) {
+      debug_overlay_cycle_mode(game->memory.profiler);
+      break;
+    }
+#endif
+    x11_push_key_event(event, game->inputs, true);
     handleEventKeyPress(event, game, platform);
     break;
   }
 
   case KeyRelease: {
+    if (x11_keymap_keysym(&event->xkey) == XK_F6 &&
+        platform->rewind.is_enabled) {
+      platform->rewind.is_held = false;
+      break;
+    }
+    x11_push_key_event(event, game->inputs, false);
     handleEventKeyRelease(event, game, platform);
     break;
   }
 
+  case MappingNotify: {
+    x11_keymap_handle_mapping(event);
+    break;
+  }
+
+  case GenericEvent: {
+    handle_mouse_raw_event(display, event, g_x11_xi_opcode,
+                           g_window_is_active ? game->inputs : NULL,
+                           x11_event_seconds);
+    break;
+  }
+
+  case MotionNotify: {
+    handle_mouse_motion(event, game->inputs,
+                        x11_event_seconds(event->xmotion.time));
+    break;
+  }
+
   case ButtonPress: {
-    handle_mouse_button_press(event, game->inputs);
+    handle_mouse_button_press(event, game->inputs,
+                              x11_event_seconds(event->xbutton.time));
     break;
   }
 
   case ButtonRelease: {
-    handle_mouse_button_release(event, game->inputs);
+    handle_mouse_button_release(event, game->inputs,
+                                x11_event_seconds(event->xbutton.time));
     break;
   }
 
@@ -285,8 +1498,9 @@ audio_generate_and_send(LinuxAudioConfig *audio_config, EngineGameState *game,
 
 #if DE100_INTERNAL
   if (FRAME_LOG_EVERY_THREE_SECONDS_CHECK) {
-    printf("[AUDIO] samples_to_generate=%d, RSI=%ld\n", samples_to_generate,
-           (long)audio_config->running_sample_index);
+    DE100_LOG_DEBUG(DE100_LOG_AUDIO, "samples_to_generate=%d, RSI=%ld",
+                    samples_to_generate,
+                    (long)audio_config->running_sample_index);
   }
 #endif
 
@@ -294,44 +1508,189 @@ audio_generate_and_send(LinuxAudioConfig *audio_config, EngineGameState *game,
     if (samples_to_generate > (u32)game->audio.max_sample_count) {
       samples_to_generate = (u32)game->audio.max_sample_count;
     }
+    samples_to_generate = linux_begin_audio_write(audio_config, &game->audio,
+                                                  samples_to_generate);
 
     game->audio.sample_count = (i32)samples_to_generate;
-    game_main_code->functions.get_audio_samples(&game->memory, &game->audio);
+    DE100_GAME_CALL(game_main_code, get_audio_samples)(&game->memory,
+                                                       &game->audio);
     linux_send_samples_to_alsa(audio_config, &game->audio);
+    game->audio.running_sample_index += (u64)game->audio.sample_count;
+    // This frame's first sample plays once what was queued has
+    INPUT_LATENCY_MARK_AT(INPUT_LATENCY_AUDIO,
+                          de100_get_wall_clock() +
+                              (f64)audio_config->queued_samples /
+                                  (f64)audio_config->samples_per_second);
   }
 }
 
+/**
+ * Enter or leave background throttling after focus/visibility events.
+ * Returns this frame's target seconds.
+ */
+de100_file_scoped_fn f32 x11_update_background_throttle(EngineGameState *game,
+                                                        X11PlatformState *x11) {
+  const GameConfig *config = &game->config;
+  X11BackgroundState *background = &g_x11_background;
+
+  bool is_hidden = background->is_unmapped || background->is_obscured ||
+                   background->is_wm_hidden;
+  bool throttle = config->prefer_background_throttle &&
+                  config->background_fps > 0 &&
+                  (!g_window_is_active || is_hidden);
+  bool skip_present = throttle && is_hidden;
+
+  if (throttle != background->is_throttled) {
+    if (throttle) {
+      // The audio output may not stretch as far as asked; never run
+      // faster than the foreground target either
+      f32 wanted = 1.0f / (f32)config->background_fps;
+      f32 covered = linux_audio_set_frame_gap(&x11->audio_config, wanted);
+      background->seconds_per_frame =
+          covered > config->target_seconds_per_frame
+              ? covered
+              : config->target_seconds_per_frame;
+      g_fixed_timestep.throttled_seconds_per_frame =
+          background->seconds_per_frame;
+      DE100_LOG_DEBUG(DE100_LOG_PLATFORM, "Background: throttled to %.1f fps",
+                      1.0f / background->seconds_per_frame);
+    } else {
+      linux_audio_set_frame_gap(&x11->audio_config, 0.0f);
+      g_fixed_timestep.throttled_seconds_per_frame = 0.0f;
+      DE100_LOG_DEBUG(DE100_LOG_PLATFORM, "Background: full rate");
+    }
+    background->is_throttled = throttle;
+  }
+
+  if (skip_present != background->is_skipping_present) {
+    // The flips we skip aren't missed vblanks
+    g_gl.present.has_last = false;
+    background->needs_fresh_frame = !skip_present;
+    background->is_skipping_present = skip_present;
+  }
+
+  return throttle ? background->seconds_per_frame
+                  : config->target_seconds_per_frame;
+}
+
 // ═══════════════════════════════════════════════════════════════════════════
 // X11 Platform Initialization
 // ═══════════════════════════════════════════════════════════════════════════
 
-de100_file_scoped_fn inline int x11_init(EngineState *engine) {
-  g_last_window_width = engine->game.config.window_width;
-  g_last_window_height = engine->game.config.window_height;
+// ─────────────────────────────────────────────────────────────────────
+// Audio device open, overlapped with window + GL context creation
+// ─────────────────────────────────────────────────────────────────────
+//
+// Opening ALSA (dlopen, device probe, hw params) and creating the window
+// and GL context both wait on other processes; neither touches the
+// other's state, so the device opens on a helper thread meanwhile.
 
-  // TODO: remove the use of `callloc`
-  X11PlatformState *x11 = calloc(1, sizeof(X11PlatformState));
-  if (!x11) {
-    fprintf(stderr, "❌ Failed to allocate X11 state\n");
-    return 1;
+typedef struct {
+  X11PlatformState *x11;
+  EngineGameState *game;
+  EngineStartupStamp start;
+  EngineStartupStamp end;
+  pthread_t thread;
+  bool is_threaded;
+} X11AudioOpen;
+
+de100_file_scoped_fn void *x11_audio_open_proc(void *data) {
+  X11AudioOpen *audio_open = (X11AudioOpen *)data;
+  GameConfig *config = &audio_open->game->config;
+  audio_open->start = engine_startup_now();
+  linux_load_alsa();
+  linux_init_audio(&audio_open->x11->audio_config, &audio_open->game->audio,
+                   (i32)config->initial_audio_sample_rate,
+                   (i32)config->audio_game_update_hz);
+  audio_open->end = engine_startup_now();
+  return NULL;
+}
+
+/**
+ * Present through MIT-SHM instead of GL. The GL-only preferences are
+ * turned off, so the rest of init and the loop take their plain paths.
+ */
+de100_file_scoped_fn bool x11_init_shm_present(EngineState *engine,
+                                               X11PlatformState *x11,
+                                               XVisualInfo *visual) {
+  GameConfig *config = &engine->game.config;
+  if (config->prefer_scaled_present || config->prefer_dynamic_resolution) {
+    printf("⚠️  SHM present doesn't scale: native size, centered\n");
+  }
+  config->prefer_scaled_present = false;
+  config->prefer_dynamic_resolution = false;
+  config->prefer_vblank_present_timing = false;
+  config->prefer_present_thread = false;
+
+  X11ShmPresentResult present = x11_shm_present_init(
+      x11->display, x11->window, visual->visual, visual->depth,
+      &engine->game.backbuffer, config->prefer_mapped_backbuffer);
+  if (!present.success) {
+    fprintf(stderr, "❌ X11 present: %s\n",
+            x11_shm_present_strerror(present.error_code));
+    return false;
+  }
+  return true;
+}
+
+/**
+ * Create the window and its GL context (and present timing / mapped
+ * backbuffer when configured), or the SHM presenter without GL.
+ */
+de100_file_scoped_fn bool x11_init_window(EngineState *engine,
+                                          X11PlatformState *x11) {
+  // The present thread swaps on this display while the game thread pumps
+  // its events: Xlib must lock, which has to be set up before any call
+  if (engine->game.config.prefer_present_thread && !XInitThreads()) {
+    printf("⚠️  XInitThreads failed, presenting on the game thread\n");
+    engine->game.config.prefer_present_thread = false;
   }
-  engine->platform.backend = x11;
 
   x11->display = XOpenDisplay(NULL);
   if (!x11->display) {
     fprintf(stderr, "❌ Cannot connect to X server\n");
-    return 1;
+    return false;
   }
 
   x11->screen = DefaultScreen(x11->display);
+
+  // Every atom in one request/reply instead of a round-trip each
+  char *atom_names[] = {"WM_PROTOCOLS", "WM_DELETE_WINDOW", "_NET_WM_STATE",
+                        "_NET_WM_STATE_HIDDEN"};
+  Atom atoms[ArraySize(atom_names)];
+  XInternAtoms(x11->display, atom_names, (int)ArraySize(atom_names), False,
+               atoms);
+  g_x11_atoms.wm_protocols = atoms[0];
+  g_x11_atoms.wm_delete_window = atoms[1];
+  g_x11_atoms.net_wm_state = atoms[2];
+  g_x11_atoms.net_wm_state_hidden = atoms[3];
+  x11->wm_delete_window = g_x11_atoms.wm_delete_window;
+
+  // Key events read keysyms (and the adapter's buttons) from this table
+  x11_keymap_build(x11->display);
+
   Window root = RootWindow(x11->display, x11->screen);
 
-  int visual_attribs[] = {GLX_RGBA, GLX_DEPTH_SIZE, 24, GLX_DOUBLEBUFFER, None};
-  XVisualInfo *visual =
-      glXChooseVisual(x11->display, x11->screen, visual_attribs);
+  // A GLX visual, or the plain TrueColor one for the SHM presenter
+  bool use_shm = engine->game.config.prefer_shm_present;
+  XVisualInfo *visual = NULL;
+  if (!use_shm) {
+    int visual_attribs[] = {GLX_RGBA, GLX_DEPTH_SIZE, 24, GLX_DOUBLEBUFFER,
+                            None};
+    visual = glXChooseVisual(x11->display, x11->screen, visual_attribs);
+    if (!visual) {
+      printf("⚠️  No OpenGL visual available, presenting with MIT-SHM\n");
+      use_shm = true;
+    }
+  }
+  XVisualInfo shm_visual = {0};
   if (!visual) {
-    fprintf(stderr, "❌ No OpenGL visual available\n");
-    return 1;
+    if (!XMatchVisualInfo(x11->display, x11->screen, 24, TrueColor,
+                          &shm_visual)) {
+      fprintf(stderr, "❌ No 24-bit TrueColor visual available\n");
+      return false;
+    }
+    visual = &shm_visual;
   }
 
   Colormap colormap =
@@ -344,8 +1703,10 @@ de100_file_scoped_fn inline int x11_init(EngineState *engine) {
           KeyReleaseMask |    // Keyboard events
           ButtonPressMask |   // Mouse button press
           ButtonReleaseMask | // Mouse button release
-          // NOTE: PointerMotionMask is NOT needed - we poll with XQueryPointer!
-          FocusChangeMask, // Window focus
+          PointerMotionMask | // Mouse position (replaces XQueryPointer)
+          FocusChangeMask |   // Window focus
+          VisibilityChangeMask | // Fully obscured (background throttling)
+          PropertyChangeMask,    // _NET_WM_STATE (background throttling)
   };
 
   x11->window = XCreateWindow(
@@ -355,36 +1716,151 @@ de100_file_scoped_fn inline int x11_init(EngineState *engine) {
 
   if (!x11->window) {
     fprintf(stderr, "❌ Failed to create X11 window\n");
-    return 1;
+    return false;
   }
 
   printf("✅ Created window\n");
 
-  Atom wmDelete = XInternAtom(x11->display, "WM_DELETE_WINDOW", False);
-  XSetWMProtocols(x11->display, x11->window, &wmDelete, 1);
+  XSetWMProtocols(x11->display, x11->window, &x11->wm_delete_window, 1);
+  if (engine->game.config.prefer_raw_mouse_input) {
+    g_x11_xi_opcode = x11_raw_mouse_enable(x11->display);
+    if (g_x11_xi_opcode < 0) {
+      printf("⚠️  XInput 2 unavailable, mouse deltas from pointer motion\n");
+    }
+  }
   XStoreName(x11->display, x11->window, engine->game.config.window_title);
   XMapWindow(x11->display, x11->window);
 
-  if (!opengl_init(x11->display, x11->window, engine->game.config.window_width,
-                   engine->game.config.window_height)) {
+  if (!use_shm &&
+      !opengl_init(x11->display, x11->window,
+                   engine->game.config.window_width,
+                   engine->game.config.window_height, &engine->game.config)) {
+    printf("⚠️  OpenGL unavailable, presenting with MIT-SHM\n");
+    if (g_gl.gl_context) {
+      glXMakeCurrent(x11->display, None, NULL);
+      glXDestroyContext(x11->display, g_gl.gl_context);
+      g_gl.gl_context = NULL;
+    }
+    use_shm = true;
+  }
+  if (use_shm) {
+    return x11_init_shm_present(engine, x11, visual);
+  }
+
+  if (engine->game.config.prefer_vblank_present_timing) {
+    if (opengl_init_present_timing(
+            engine->game.config.max_allowed_refresh_rate_hz)) {
+      opengl_present_set_target(engine->game.config.target_seconds_per_frame);
+    } else {
+      printf("⚠️  No GLX swap control, pacing frames with sleeps\n");
+    }
+  }
+
+  if (engine->game.config.prefer_mapped_backbuffer &&
+      engine->game.config.prefer_present_thread) {
+    printf("⚠️  Mapped backbuffer is off with the present thread (the "
+           "frame is copied to it)\n");
+  } else if (engine->game.config.prefer_mapped_backbuffer) {
+    if (opengl_attach_mapped_backbuffer(&engine->game.backbuffer)) {
+      printf("✅ Game renders directly into mapped PBO memory\n");
+    } else {
+      printf("⚠️  Mapped backbuffer unavailable, using copy upload\n");
+    }
+  }
+  return true;
+}
+
+de100_file_scoped_fn inline int x11_init(EngineState *engine) {
+  g_last_window_width = engine->game.config.window_width;
+  g_last_window_height = engine->game.config.window_height;
+
+  // TODO: remove the use of `callloc`
+  X11PlatformState *x11 = calloc(1, sizeof(X11PlatformState));
+  if (!x11) {
+    fprintf(stderr, "❌ Failed to allocate X11 state\n");
     return 1;
   }
+  engine->platform.backend = x11;
 
-  linux_load_alsa();
   // init hz + latency before calling audio init
   x11->audio_config.game_update_hz =
       (i32)engine->game.config.audio_game_update_hz;
   x11->audio_config.bytes_per_sample = (i32)(sizeof(i16) * 2);
-  linux_init_audio(&x11->audio_config, &engine->game.audio,
-                   (i32)engine->game.config.initial_audio_sample_rate,
-                   (i32)engine->game.config.audio_game_update_hz);
+  x11->audio_config.use_audio_thread =
+      engine->game.config.prefer_threaded_audio;
+  x11->audio_config.adaptive_latency =
+      engine->game.config.prefer_adaptive_audio_latency;
+  x11->audio_config.use_mmap = engine->game.config.prefer_mmap_audio;
+  x11->audio_config.use_audio_server =
+      engine->game.config.prefer_audio_server;
+  x11->audio_config.realtime_thread =
+      engine->platform.config.threads.audio_realtime;
+  x11->audio_config.realtime_priority =
+      engine->platform.config.threads.audio_realtime_priority;
+
+  X11AudioOpen audio_open = {.x11 = x11, .game = &engine->game};
+  audio_open.is_threaded = pthread_create(&audio_open.thread, NULL,
+                                          x11_audio_open_proc,
+                                          &audio_open) == 0;
+
+  EngineStartupStamp window_start = engine_startup_now();
+  bool has_window = x11_init_window(engine, x11);
+  engine_startup_phase(engine, "window + GL", window_start,
+                       engine_startup_now());
+
+  if (audio_open.is_threaded) {
+    pthread_join(audio_open.thread, NULL);
+  } else {
+    x11_audio_open_proc(&audio_open);
+  }
+  engine_startup_record(engine, "audio device", audio_open.start,
+                        audio_open.end, audio_open.is_threaded);
+  if (!has_window) {
+    return 1;
+  }
 
+  if (engine->game.config.prefer_threaded_joystick && !x11_evdev_start()) {
+    printf("⚠️  Gamepad thread unavailable, polling on the frame thread\n");
+  }
   linux_init_joystick(engine->platform.old_inputs->controllers,
                       engine->game.inputs->controllers);
 
+  if (engine->game.config.prefer_event_loop &&
+      x11_event_wait_init(x11->display)) {
+    printf("✅ Event loop: epoll + timerfd frame waits\n");
+  }
+
   printf("✅ X11 platform initialized\n");
 
-  adaptive_fps_init();
+  if (engine->game.config.prefer_pipelined_render &&
+      !render_pipeline_init()) {
+    printf("⚠️  Pipelined render unavailable, rendering serially\n");
+  }
+
+  u32 monitor_hz = g_gl.present.enabled
+                       ? (u32)(g_gl.present.refresh_hz + 0.5)
+                       : get_monitor_refresh_hz();
+  adaptive_fps_init(&engine->game.config, monitor_hz);
+  dynamic_resolution_init(&engine->game.config, &engine->game.backbuffer);
+
+  if (engine->game.config.prefer_present_thread) {
+    // The thread takes the context; it can only be current on one thread
+    glXMakeCurrent(x11->display, None, NULL);
+    PresentThreadCallbacks callbacks = {
+        .begin = x11_present_thread_begin,
+        .present = x11_present_thread_present,
+        .end = x11_present_thread_end,
+        .user = &engine->game.config,
+    };
+    PresentThreadResult present = present_thread_start(
+        &callbacks, engine->game.backbuffer.width,
+        engine->game.backbuffer.height);
+    if (!present.success) {
+      printf("⚠️  Present thread: %s, presenting on the game thread\n",
+             present_thread_strerror(present.error_code));
+      glXMakeCurrent(x11->display, x11->window, g_gl.gl_context);
+    }
+  }
 
 #if DE100_INTERNAL
   frame_stats_init();
@@ -407,8 +1883,14 @@ de100_file_scoped_fn inline void x11_shutdown(EngineState *engine) {
     return;
 
   linux_close_joysticks();
+  x11_evdev_stop();
   linux_unload_alsa(&x11->audio_config);
 
+  // Give the engine its own backbuffer block back before it frees it
+  opengl_detach_mapped_backbuffer(&engine->game.backbuffer);
+  opengl_release_pbos();
+  render_pipeline_shutdown();
+
   if (x11->gl_context) {
     glXMakeCurrent(x11->display, None, NULL);
     glXDestroyContext(x11->display, x11->gl_context);
@@ -426,126 +1908,447 @@ de100_file_scoped_fn inline void x11_shutdown(EngineState *engine) {
 #endif
 
 // ═══════════════════════════════════════════════════════════════════════════
-// Main Platform Entry Point
+// Frame Phases (see frame-graph.h)
 // ═══════════════════════════════════════════════════════════════════════════
+//
+// Every phase touches the display, the GL context or game code, so they
+// all run on the main thread, one wave each, in the order the loop always
+// ran them. The graph times each one into its frame-stats phase.
+//
 
-int platform_main(void) {
-  EngineState engine = {0};
-  engine.platform.game_main_code = (GameMainCode){0};
-
-  if (engine_init(&engine)) {
-    return 1;
-  }
-
-  if (x11_init(&engine) != 0) {
-    engine_shutdown(&engine);
-    return 1;
-  }
-
-  X11PlatformState *x11 = engine_get_backend(&engine, X11PlatformState);
-
-  engine.platform.game_bootstrap_code.functions.init(
-      &engine.game.thread_context, &engine.game.memory, engine.game.inputs,
-      &engine.game.backbuffer);
+typedef struct {
+  EngineState *engine;
+  X11PlatformState *x11;
+
+  // This frame's decisions, made by begin and update
+  f32 target_seconds;
+  bool skip_present;
+  bool is_flip_paced;
+  bool pipelined;
+} X11Frame;
+
+// Throttle and pacing decisions, then the late-latch sleep
+de100_file_scoped_fn FRAME_GRAPH_PHASE_FN(x11_phase_begin) {
+  (void)graph;
+  X11Frame *ctx = (X11Frame *)data;
+  EngineState *engine = ctx->engine;
 
-  while (is_game_running) {
 #if DE100_INTERNAL
-    if (FRAME_LOG_EVERY_TEN_SECONDS_CHECK) {
-      printf("[HEALTH CHECK] frame=%u, RSI=%lld, marker_idx=%d\n",
-             g_frame_counter, (long long)x11->audio_config.running_sample_index,
-             g_debug_marker_index);
+  if (FRAME_LOG_EVERY_TEN_SECONDS_CHECK) {
+    printf("[HEALTH CHECK] frame=%u, RSI=%lld, marker_idx=%d\n",
+           g_frame_counter,
+           (long long)ctx->x11->audio_config.running_sample_index,
+           g_debug_marker_index);
+    if (g_x11_frames_since_report > 0) {
+      printf("[HEALTH CHECK] X requests/frame=%.1f\n",
+             (f64)g_x11_requests_since_report /
+                 (f64)g_x11_frames_since_report);
     }
+    g_x11_requests_since_report = 0;
+    g_x11_frames_since_report = 0;
+  }
 #endif
 
-    frame_timing_begin();
+  frame_timing_begin();
 
-    handle_game_reload_check(&engine.platform.game_main_code,
-                             &engine.platform.paths);
+  // Reacts to last frame's focus/visibility events
+  ctx->target_seconds = x11_update_background_throttle(&engine->game, ctx->x11);
+  ctx->skip_present = g_x11_background.is_skipping_present;
 
-    prepare_input_frame(engine.platform.old_inputs, engine.game.inputs);
-    x11_poll_mouse(x11->display, x11->window, engine.game.inputs);
-    ;
-    linux_poll_joystick(engine.game.inputs);
+  ctx->is_flip_paced = g_gl.present.enabled && !present_thread_is_active();
+  if (ctx->is_flip_paced && engine->game.config.prefer_late_input_latch &&
+      !g_x11_background.is_throttled) {
+    // Sleep first, then sample and simulate just before the swap
+    frame_timing_latch_wait(ctx->target_seconds);
+  }
+  return true;
+}
 
-    // Input recording/playback: record after getting real inputs, playback
-    // overwrites it
-    if (input_recording_is_recording(&engine.platform.memory_state)) {
-      input_recording_record_frame(&engine.platform.memory_state,
-                                   engine.game.inputs);
-    }
+de100_file_scoped_fn FRAME_GRAPH_PHASE_FN(x11_phase_input) {
+  (void)graph;
+  X11Frame *ctx = (X11Frame *)data;
+  EngineState *engine = ctx->engine;
+
+  handle_game_reload_check(&engine->platform.game_main_code,
+                           &engine->platform.paths);
+
+  // Pump before the update so this frame's presses reach this frame's
+  // game code (and a press + release within one frame isn't lost)
+  prepare_input_frame(engine->platform.old_inputs, engine->game.inputs);
+  x11_process_pending_events(ctx->x11->display, &engine->platform,
+                             &engine->game);
+  if (x11_evdev_is_running()) {
+    x11_evdev_drain_events(engine->game.inputs);
+  }
+  linux_poll_joystick(engine->game.inputs);
 
-    if (input_recording_is_playing(&engine.platform.memory_state)) {
-      input_recording_playback_frame(&engine.platform.memory_state,
-                                     engine.game.inputs);
-    }
+  // Input recording/playback: record after getting real inputs, playback
+  // overwrites it
+  if (input_recording_is_recording(&engine->platform.memory_state)) {
+    input_recording_record_frame(&engine->platform.memory_state,
+                                 engine->game.inputs);
+  }
 
-    engine.platform.game_main_code.functions.update_and_render(
-        &engine.game.thread_context, &engine.game.memory, engine.game.inputs,
-        &engine.game.backbuffer);
+  if (input_recording_is_playing(&engine->platform.memory_state)) {
+    input_recording_playback_frame(&engine->platform.memory_state,
+                                   engine->game.inputs);
+  }
+  return true;
+}
 
-    audio_generate_and_send(&x11->audio_config, &engine.game,
-                            &engine.platform.game_main_code);
+de100_file_scoped_fn FRAME_GRAPH_PHASE_FN(x11_phase_update) {
+  (void)graph;
+  X11Frame *ctx = (X11Frame *)data;
+  EngineState *engine = ctx->engine;
+
+  // Last frame's measured time drives the fixed-timestep accumulator.
+  // Pipelined: only simulate here, overlapping last frame's raster.
+  // Hidden: only simulate (update_and_render games can't split).
+  // Netplay and rewind run their own frames, unpipelined.
+  bool is_own_frame =
+      engine_netplay_frame(engine) || engine_rewind_frame(engine);
+  ctx->pipelined = !is_own_frame &&
+                   render_pipeline_is_active(&engine->game,
+                                             &engine->platform.game_main_code);
+  bool simulate_only =
+      !is_own_frame && ctx->skip_present &&
+      fixed_timestep_is_active(&engine->game.config,
+                               &engine->platform.game_main_code);
+  INPUT_LATENCY_BEGIN_FRAME(engine->game.inputs, ctx->pipelined);
+  if (is_own_frame) {
+    // Simulated (and rendered) above, held for the peer, or rewound
+  } else if (ctx->pipelined || simulate_only) {
+    fixed_timestep_update(&engine->game, &engine->platform.game_main_code,
+                          g_frame_timing.total_seconds);
+    if (ctx->pipelined && !ctx->skip_present &&
+        g_x11_background.needs_fresh_frame) {
+      // Nothing was rasterized while hidden: this frame's, now
+      render_pipeline_record_and_kick(&engine->game,
+                                      &engine->platform.game_main_code);
+    }
+  } else {
+    fixed_timestep_run_frame(&engine->game, &engine->platform.game_main_code,
+                             g_frame_timing.total_seconds);
+  }
+  INPUT_LATENCY_MARK(INPUT_LATENCY_UPDATE);
+  return true;
+}
 
-    x11_process_pending_events(x11->display, &engine.platform, &engine.game);
+de100_file_scoped_fn FRAME_GRAPH_PHASE_FN(x11_phase_audio) {
+  (void)graph;
+  X11Frame *ctx = (X11Frame *)data;
+  audio_generate_and_send(&ctx->x11->audio_config, &ctx->engine->game,
+                          &ctx->engine->platform.game_main_code);
+  return true;
+}
+
+// The backbuffer must hold a finished frame before overlay/present
+de100_file_scoped_fn FRAME_GRAPH_PHASE_FN(x11_phase_finish_raster) {
+  (void)graph;
+  X11Frame *ctx = (X11Frame *)data;
+  render_pipeline_finish(&ctx->engine->game.memory);
+  INPUT_LATENCY_MARK(INPUT_LATENCY_RENDER);
+  return true;
+}
 
+de100_file_scoped_fn FRAME_GRAPH_PHASE_FN(x11_phase_present) {
+  (void)graph;
+  X11Frame *ctx = (X11Frame *)data;
+  EngineState *engine = ctx->engine;
+  X11PlatformState *x11 = ctx->x11;
+  f32 target_seconds = ctx->target_seconds;
+
+  // Hidden: no overlay, upload or swap (Expose repaints on return)
+  if (!ctx->skip_present) {
+    capture_frame(&engine->game.backbuffer, target_seconds);
+    spectate_frame(&engine->game.backbuffer);
 #if DE100_INTERNAL
     int display_marker_index =
         (g_debug_marker_index - 1 + MAX_DEBUG_AUDIO_MARKERS) %
         MAX_DEBUG_AUDIO_MARKERS;
-    linux_debug_sync_display(&engine.game.backbuffer, &engine.game.audio,
+    linux_debug_sync_display(&engine->game.backbuffer, &engine->game.audio,
                              &x11->audio_config, g_debug_audio_markers,
                              MAX_DEBUG_AUDIO_MARKERS, display_marker_index);
+    if (x11->audio_config.adaptive_latency) {
+      const LinuxAudioLatencyController *latency =
+          &g_linux_audio_output.latency_controller;
+      g_debug_overlay_audio = (DebugOverlayAudio){
+          .is_valid = true,
+          .latency_ms = latency->target_ms,
+          .interval_ms = latency->interval_ms,
+          .jitter_ms = latency->jitter_ms,
+          .recent_underrun =
+              de100_get_wall_clock() - latency->last_underrun_seconds < 1.0,
+      };
+    }
+    debug_overlay_render(&engine->game.backbuffer, &engine->game.memory,
+                         target_seconds);
 #endif
 
-    opengl_display_buffer(&engine.game.backbuffer, g_last_window_width,
-                          g_last_window_height);
-    XSync(x11->display, False);
-
+    if (x11_shm_present_is_active()) {
+      present_scale_set_current(present_scale_compute(
+          &engine->game.config, engine->game.backbuffer.width,
+          engine->game.backbuffer.height, g_last_window_width,
+          g_last_window_height));
+      // Waits for a ShmCompletion when the server is a frame behind
+      x11_shm_present_frame(&engine->game.backbuffer, g_last_window_width,
+                            g_last_window_height, target_seconds);
+    } else if (present_thread_is_active()) {
+      // Mouse mapping is the game thread's; the thread only draws
+      present_scale_set_current(present_scale_compute(
+          &engine->game.config, engine->game.backbuffer.width,
+          engine->game.backbuffer.height, g_last_window_width,
+          g_last_window_height));
+      present_thread_submit(&engine->game.backbuffer, g_last_window_width,
+                            g_last_window_height, target_seconds);
+      de100_backbuffer_clear_dirty(&engine->game.backbuffer);
+    } else {
+      if (g_gl.present.enabled) {
+        // Picks up adaptive FPS and background throttle target changes
+        opengl_present_set_target(target_seconds);
+      }
+      opengl_display_buffer(&engine->game.backbuffer, &engine->game.config,
+                            g_last_window_width, g_last_window_height);
+    }
+    g_x11_background.needs_fresh_frame = false;
+    INPUT_LATENCY_MARK(INPUT_LATENCY_UPLOAD);
+
+    // Presented and not rasterizing: the next frame takes the new size
+    if (dynamic_resolution_apply(&engine->game.backbuffer) &&
+        !present_thread_is_active()) {
+      // Now, so a mapped backbuffer points into the resized PBO ring
+      opengl_ensure_stream_storage(&engine->game.backbuffer);
+    }
+  }
+  // Nothing this frame needs a reply, so don't wait for one (XSync is a
+  // full round-trip: milliseconds on remote X). Swap throttling is the
+  // driver's job, or wait_for_flip's with present timing.
+  XFlush(x11->display);
 #if DE100_INTERNAL
-    linux_debug_capture_flip_state(&x11->audio_config);
-#endif
+  unsigned long next_request = NextRequest(x11->display);
+  g_x11_requests_since_report += next_request - g_x11_last_request;
+  g_x11_last_request = next_request;
+  ++g_x11_frames_since_report;
 
-    frame_timing_mark_work_done();
-    frame_timing_sleep_until_target(
-        engine.game.config.target_seconds_per_frame);
-    frame_timing_end();
+  linux_debug_capture_flip_state(&x11->audio_config);
+#endif
+  return true;
+}
 
-    f32 frame_time_ms = frame_timing_get_ms();
-    f32 target_frame_time_ms =
-        engine.game.config.target_seconds_per_frame * 1000.0f;
+// Rasterizes during the sleep and the next frame's update
+de100_file_scoped_fn FRAME_GRAPH_PHASE_FN(x11_phase_kick_raster) {
+  (void)graph;
+  X11Frame *ctx = (X11Frame *)data;
+  if (ctx->pipelined && !ctx->skip_present) {
+    render_pipeline_record_and_kick(&ctx->engine->game,
+                                    &ctx->engine->platform.game_main_code);
+  }
+  return true;
+}
 
-    if (frame_time_ms > (target_frame_time_ms + 5.0f)) {
-      printf("⚠️  MISSED FRAME! %.2fms (target: %.2fms, over by: %.2fms)\n",
-             frame_time_ms, target_frame_time_ms,
-             frame_time_ms - target_frame_time_ms);
+de100_file_scoped_fn FRAME_GRAPH_PHASE_FN(x11_phase_pace) {
+  (void)graph;
+  X11Frame *ctx = (X11Frame *)data;
+  EngineState *engine = ctx->engine;
+  f32 target_seconds = ctx->target_seconds;
+
+  frame_timing_mark_work_done();
+  f32 flip_interval = 0.0f;
+  if (ctx->is_flip_paced && !ctx->skip_present) {
+    // The swap interval paces the loop; sleeping too would double-wait
+    flip_interval = opengl_present_wait_for_flip();
+    // UST is CLOCK_MONOTONIC microseconds on Mesa and NVIDIA
+    INPUT_LATENCY_MARK_AT(INPUT_LATENCY_PRESENT,
+                          g_gl.present.wait_for_sbc
+                              ? (f64)g_gl.present.last_ust / 1000000.0
+                              : g_gl.present.last_flip_seconds);
+  } else if (x11_event_wait_is_active() &&
+             x11_event_wait_until_target(target_seconds,
+                                         g_x11_background.is_throttled) !=
+                 X11_EVENT_WAIT_WAKE_ERROR) {
+    // Slept in epoll until the deadline (or, throttled, until input)
+  } else if (engine->game.config.prefer_high_res_frame_timer) {
+    frame_timing_wait_until_target(target_seconds);
+  } else {
+    frame_timing_sleep_until_target(target_seconds);
+  }
+  frame_timing_end();
+  if (flip_interval > 0.0f) {
+    frame_timing_use_present_interval(flip_interval);
+    if (g_frame_timing.is_latched && flip_interval > target_seconds * 1.5f) {
+      frame_timing_latch_missed(target_seconds);
     }
+  }
+  return true;
+}
+
+// Frame bookkeeping and adaptation, then the inputs flip for the next frame
+de100_file_scoped_fn FRAME_GRAPH_PHASE_FN(x11_phase_end) {
+  (void)graph;
+  X11Frame *ctx = (X11Frame *)data;
+  EngineState *engine = ctx->engine;
+  f32 target_seconds = ctx->target_seconds;
+
+  f32 frame_time_ms = frame_timing_get_ms();
+  telemetry_frame(frame_time_ms, target_seconds);
+  if (FRAME_LOG_EVERY_ONE_SECONDS_CHECK) {
+    telemetry_counter(TELEMETRY_COUNTER_AUDIO_UNDERRUNS,
+                      linux_audio_underrun_count());
+  }
 
 #if DE100_INTERNAL
-    frame_stats_record(frame_time_ms,
-                       engine.game.config.target_seconds_per_frame);
+  frame_stats_record(frame_time_ms, target_seconds);
+  de100_profiler_end_frame(engine->game.memory.profiler);
+  trace_export_frame(engine->game.memory.profiler);
+  flight_recorder_frame(engine->game.memory.profiler, engine->game.inputs,
+                        frame_time_ms, target_seconds);
+  if (FRAME_LOG_EVERY_ONE_SECONDS_CHECK) {
+    frame_stats_report_missed();
+  }
 #endif
 
-    g_frame_counter++;
+  g_frame_counter++;
 
 #if DE100_INTERNAL
-    if (FRAME_LOG_EVERY_FIVE_SECONDS_CHECK) {
-      printf(
-          "[X11] %.2fms/f, %.2ff/s, %.2fmc/f (work: %.2fms, sleep: %.2fms)\n",
-          frame_time_ms, frame_timing_get_fps(), frame_timing_get_mcpf(),
-          g_frame_timing.work_seconds * 1000.0f,
-          g_frame_timing.sleep_seconds * 1000.0f);
+  if (FRAME_LOG_EVERY_FIVE_SECONDS_CHECK) {
+    DE100_LOG_DEBUG(
+        DE100_LOG_TIMING,
+        "%.2fms/f, %.2ff/s, %.2fmc/f (work: %.2fms, sleep: %.2fms)",
+        frame_time_ms, frame_timing_get_fps(), frame_timing_get_mcpf(),
+        g_frame_timing.work_seconds * 1000.0f,
+        g_frame_timing.sleep_seconds * 1000.0f);
+    if (present_thread_is_active()) {
+      PresentThreadStats present = present_thread_stats();
+      DE100_LOG_DEBUG(DE100_LOG_TIMING,
+                      "present thread: %.2fms present, %.2fms latency, "
+                      "%llu shown, %llu dropped",
+                      present.present_ms, present.latency_ms,
+                      (unsigned long long)present.presented,
+                      (unsigned long long)present.dropped);
+    }
+    if (x11_shm_present_is_shared()) {
+      X11ShmPresentStats shm = x11_shm_present_stats();
+      DE100_LOG_DEBUG(DE100_LOG_TIMING,
+                      "shm present: %.2fms to completion, %llu waits "
+                      "(%.2fms), %llu skipped",
+                      shm.completion_ms, (unsigned long long)shm.waits,
+                      shm.wait_ms, (unsigned long long)shm.skipped);
     }
+  }
 #endif
 
-    if (engine.game.config.prefer_adaptive_fps) {
-      adaptive_fps_update(&engine.game.config, frame_time_ms);
-    }
+  // Throttled frames are slow on purpose, not a reason to adapt
+  if (!g_x11_background.is_throttled) {
+    dynamic_resolution_update(&engine->game.config, frame_time_ms,
+                              g_frame_timing.work_seconds * 1000.0f);
+  }
+  if (engine->game.config.prefer_adaptive_fps &&
+      !g_x11_background.is_throttled) {
+    adaptive_fps_update(&engine->game.config, frame_time_ms,
+                        g_frame_timing.work_seconds * 1000.0f);
+  }
+
+  engine_swap_inputs(engine);
+  return true;
+}
+
+// One wave per phase, in this order (see the note above X11Frame)
+de100_file_scoped_fn FrameGraphResult x11_build_frame_graph(FrameGraph *graph,
+                                                          X11Frame *ctx) {
+  struct {
+    const char *name;
+    frame_graph_phase_fn *run;
+    i32 stats_phase;
+  } phases[] = {
+      {"begin", x11_phase_begin, FRAME_PHASE_SLEEP},
+      {"input", x11_phase_input, FRAME_PHASE_INPUT},
+      {"update", x11_phase_update, FRAME_PHASE_UPDATE},
+      {"audio", x11_phase_audio, FRAME_PHASE_AUDIO},
+      {"finish raster", x11_phase_finish_raster, FRAME_PHASE_UPDATE},
+      {"present", x11_phase_present, FRAME_PHASE_PRESENT},
+      {"kick raster", x11_phase_kick_raster, FRAME_PHASE_UPDATE},
+      {"pace", x11_phase_pace, FRAME_PHASE_SLEEP},
+      {"end", x11_phase_end, FRAME_GRAPH_NO_STATS},
+  };
+
+  u32 previous = FRAME_GRAPH_INVALID_PHASE;
+  for (u32 i = 0; i < ArraySize(phases); ++i) {
+    previous = frame_graph_add(
+        graph, (FrameGraphPhase){
+                   .name = phases[i].name,
+                   .run = phases[i].run,
+                   .data = ctx,
+                   .after = previous == FRAME_GRAPH_INVALID_PHASE
+                                ? 0
+                                : FRAME_GRAPH_BIT(previous),
+                   .flags = FRAME_GRAPH_MAIN_THREAD,
+                   .stats_phase = phases[i].stats_phase});
+  }
+  // The display and GL context are this thread's: no work queue
+  return frame_graph_compile(graph, NULL);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Main Platform Entry Point
+// ═══════════════════════════════════════════════════════════════════════════
+
+int platform_main(void) {
+  EngineState engine = {0};
+  engine.platform.game_main_code = (GameMainCode){0};
+
+  if (engine_init(&engine)) {
+    return 1;
+  }
+
+  if (x11_init(&engine) != 0) {
+    engine_shutdown(&engine);
+    return 1;
+  }
+
+  X11PlatformState *x11 = engine_get_backend(&engine, X11PlatformState);
 
-    engine_swap_inputs(&engine);
+  EngineStartupStamp game_init_start = engine_startup_now();
+  DE100_GAME_CALL(&engine.platform.game_bootstrap_code, init)(
+      &engine.game.thread_context, &engine.game.memory, engine.game.inputs,
+      &engine.game.backbuffer);
+  engine_startup_phase(&engine, "game init", game_init_start,
+                       engine_startup_now());
+  engine_startup_report(&engine);
+
+  X11Frame frame = {.engine = &engine, .x11 = x11};
+  FrameGraph graph = {0};
+  FrameGraphResult compiled = x11_build_frame_graph(&graph, &frame);
+  if (!compiled.success) {
+    DE100_LOG_ERROR(DE100_LOG_ENGINE, "Frame graph: %s",
+                    frame_graph_strerror(compiled.error_code));
+    is_game_running = false;
   }
+  frame_graph_log(&graph);
+
+  while (is_game_running) {
+    if (!frame_graph_run(&graph)) {
+      break;
+    }
+  }
+
+#if DE100_INTERNAL
+  // Before shutdown: the profiler lives in engine allocations
+  de100_profiler_print(engine.game.memory.profiler, 15, true);
+#endif
 
   printf("[%.3fs] Exiting, freeing memory...\n",
          de100_get_wall_clock() - g_initial_game_time_ms);
+  // Keep the audio thread from writing into a device torn down at exit
+  linux_audio_thread_stop(&x11->audio_config);
+  render_pipeline_finish(&engine.game.memory);
+  if (present_thread_is_active()) {
+    present_thread_stop();
+    // Teardown's GL calls run here
+    glXMakeCurrent(x11->display, x11->window, g_gl.gl_context);
+  }
+  // Zero-copy hands the engine its backbuffer memory back
+  x11_shm_present_shutdown(&engine.game.backbuffer);
+  x11_event_wait_shutdown();
 #if DE100_SANITIZE_WAVE_1_MEMORY
   x11_shutdown(&engine);
 #endif
@@ -557,6 +2360,8 @@ int platform_main(void) {
 
 #if DE100_INTERNAL
   frame_stats_print();
+  input_latency_print();
+  frame_stats_dump_to_directory(engine.platform.paths.exe_directory.path);
 #endif
 
   printf("Goodbye!\n");
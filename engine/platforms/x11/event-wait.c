@@ -0,0 +1,162 @@
+#include "./event-wait.h"
+#include "../../_common/log.h"
+#include "../../_common/time.h"
+#include "../_common/frame-timing.h"
+#include "./inputs/evdev.h"
+
+#include <errno.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+typedef enum {
+  EVENT_WAIT_TAG_TIMER = 0,
+  EVENT_WAIT_TAG_X11,
+  EVENT_WAIT_TAG_GAMEPAD,
+  EVENT_WAIT_TAG_COUNT
+} EventWaitTag;
+
+typedef struct {
+  Display *display;
+  int epoll_fd;
+  int timer_fd;
+  int gamepad_fd; // eventfd the evdev reader writes on every publish
+  bool is_active;
+} X11EventWait;
+
+de100_file_scoped_global_var X11EventWait g_x11_event_wait = {
+    .epoll_fd = -1,
+    .timer_fd = -1,
+    .gamepad_fd = -1,
+};
+
+de100_file_scoped_fn void event_wait_close_fds(X11EventWait *wait) {
+  if (wait->gamepad_fd >= 0) {
+    close(wait->gamepad_fd);
+  }
+  if (wait->timer_fd >= 0) {
+    close(wait->timer_fd);
+  }
+  if (wait->epoll_fd >= 0) {
+    close(wait->epoll_fd);
+  }
+  wait->epoll_fd = -1;
+  wait->timer_fd = -1;
+  wait->gamepad_fd = -1;
+}
+
+de100_file_scoped_fn bool event_wait_add(X11EventWait *wait, int fd,
+                                         EventWaitTag tag) {
+  struct epoll_event event = {.events = EPOLLIN, .data.u64 = tag};
+  return epoll_ctl(wait->epoll_fd, EPOLL_CTL_ADD, fd, &event) == 0;
+}
+
+// Drain a counter fd (timerfd / eventfd); both are 8-byte reads
+de100_file_scoped_fn void event_wait_drain(int fd) {
+  u64 count;
+  ssize_t read_bytes;
+  do {
+    read_bytes = read(fd, &count, sizeof(count));
+  } while (read_bytes < 0 && errno == EINTR);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// PUBLIC API
+// ═══════════════════════════════════════════════════════════════════════════
+
+bool x11_event_wait_init(Display *display) {
+  X11EventWait *wait = &g_x11_event_wait;
+  if (wait->is_active) {
+    return true;
+  }
+
+  wait->display = display;
+  wait->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+  // Blocking: foreground frames read it directly
+  wait->timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+  wait->gamepad_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (wait->epoll_fd < 0 || wait->timer_fd < 0 || wait->gamepad_fd < 0 ||
+      !event_wait_add(wait, wait->timer_fd, EVENT_WAIT_TAG_TIMER) ||
+      !event_wait_add(wait, ConnectionNumber(display), EVENT_WAIT_TAG_X11) ||
+      !event_wait_add(wait, wait->gamepad_fd, EVENT_WAIT_TAG_GAMEPAD)) {
+    DE100_LOG_WARN(DE100_LOG_PLATFORM,
+                   "Event loop unavailable (errno %d); sleeping instead",
+                   errno);
+    event_wait_close_fds(wait);
+    return false;
+  }
+
+  x11_evdev_set_notify_fd(wait->gamepad_fd);
+  wait->is_active = true;
+  return true;
+}
+
+void x11_event_wait_shutdown(void) {
+  X11EventWait *wait = &g_x11_event_wait;
+  if (!wait->is_active) {
+    return;
+  }
+  x11_evdev_set_notify_fd(-1);
+  event_wait_close_fds(wait);
+  wait->is_active = false;
+}
+
+bool x11_event_wait_is_active(void) { return g_x11_event_wait.is_active; }
+
+X11EventWaitWake x11_event_wait_until_target(f32 target_seconds,
+                                             bool wake_on_input) {
+  X11EventWait *wait = &g_x11_event_wait;
+
+  f32 elapsed = frame_timing_run_idle_jobs(target_seconds);
+  if (elapsed >= target_seconds) {
+    return X11_EVENT_WAIT_WAKE_DEADLINE;
+  }
+
+  // Reads what the socket holds without blocking or flushing; anything
+  // Xlib queued this way would never make the fd readable again
+  if (wake_on_input && XEventsQueued(wait->display, QueuedAfterReading) > 0) {
+    return X11_EVENT_WAIT_WAKE_INPUT;
+  }
+
+  // Re-arming also resets the expiration count a skipped wait left behind
+  De100TimeSpec deadline = de100_timespec_add_seconds(
+      &g_frame_timing.frame_start, (f64)target_seconds);
+  struct itimerspec timer = {
+      .it_value = {.tv_sec = (time_t)deadline.seconds,
+                   .tv_nsec = (long)deadline.nanoseconds},
+  };
+  if (timerfd_settime(wait->timer_fd, TFD_TIMER_ABSTIME, &timer, NULL) != 0) {
+    return X11_EVENT_WAIT_WAKE_ERROR;
+  }
+
+  if (!wake_on_input) {
+    event_wait_drain(wait->timer_fd);
+    return X11_EVENT_WAIT_WAKE_DEADLINE;
+  }
+
+  for (;;) {
+    struct epoll_event ready[EVENT_WAIT_TAG_COUNT];
+    int ready_count = epoll_wait(wait->epoll_fd, ready, EVENT_WAIT_TAG_COUNT,
+                                 -1);
+    if (ready_count < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return X11_EVENT_WAIT_WAKE_ERROR;
+    }
+
+    bool is_deadline = false;
+    for (int i = 0; i < ready_count; ++i) {
+      if (ready[i].data.u64 == EVENT_WAIT_TAG_TIMER) {
+        event_wait_drain(wait->timer_fd);
+        is_deadline = true;
+      } else if (ready[i].data.u64 == EVENT_WAIT_TAG_GAMEPAD) {
+        event_wait_drain(wait->gamepad_fd);
+      }
+      // X11: left readable for the next frame's XPending to read
+    }
+    return is_deadline ? X11_EVENT_WAIT_WAKE_DEADLINE
+                       : X11_EVENT_WAIT_WAKE_INPUT;
+  }
+}
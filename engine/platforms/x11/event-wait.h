@@ -0,0 +1,58 @@
+#ifndef DE100_X11_EVENT_WAIT_H
+#define DE100_X11_EVENT_WAIT_H
+
+#include "../../_common/base.h"
+
+#include <X11/Xlib.h>
+#include <stdbool.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ⏰ EVENT-DRIVEN FRAME WAIT (GameConfig.prefer_event_loop)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// Replaces the sleep-paced frame wait (1ms sleeps + spin, or a timer sleep
+// + spin) with one blocking epoll_wait:
+//
+//   epoll ─┬─ timerfd          absolute CLOCK_MONOTONIC frame deadline
+//          ├─ X connection fd  (ConnectionNumber) window / key / mouse
+//          └─ eventfd          written by the gamepad reader on publish
+//                              (prefer_threaded_joystick, evdev.h)
+//
+// The thread sleeps in the kernel until the deadline, with no spin tail:
+// the timerfd is an hrtimer, late by the thread's timer slack (50us by
+// default) instead of a scheduler tick.
+//
+// Foreground frames wait for the deadline only: input that arrives is
+// picked up by the next frame's pump as before (ending the frame early
+// would break its pacing). Background-throttled frames (10 fps) also end
+// on input, so a click on the window doesn't wait out a 100ms frame.
+// Xlib may already hold read events the fd no longer shows; those are
+// checked (without a round-trip) before blocking.
+//
+// Idle jobs (idle-scheduler.h) still get the slack first. Flip-paced
+// frames don't come here: the swap paces them.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+typedef enum {
+  X11_EVENT_WAIT_WAKE_DEADLINE = 0,
+  X11_EVENT_WAIT_WAKE_INPUT, // Background frame ended early
+  X11_EVENT_WAIT_WAKE_ERROR, // epoll / timerfd failed; caller sleeps instead
+} X11EventWaitWake;
+
+/**
+ * Create the epoll set over `display`'s connection, a timerfd and the
+ * gamepad reader's eventfd. False (and inactive) if any syscall failed.
+ */
+bool x11_event_wait_init(Display *display);
+void x11_event_wait_shutdown(void);
+bool x11_event_wait_is_active(void);
+
+/**
+ * Block until frame_start + `target_seconds`, or, with `wake_on_input`,
+ * until input arrives if that is sooner.
+ */
+X11EventWaitWake x11_event_wait_until_target(f32 target_seconds,
+                                             bool wake_on_input);
+
+#endif // DE100_X11_EVENT_WAIT_H
@@ -8,6 +8,10 @@ void linux_close_joysticks(void);
 void linux_init_joystick(GameControllerInput *controller_old_input,
                          GameControllerInput *controller_new_input);
 void debug_joystick_state(GameInput *game_input);
+// With GameConfig.prefer_threaded_joystick the engine's reader thread owns
+// the devices: read x11_evdev_read() snapshots here instead of the fds
+// (platforms/x11/inputs/evdev.h). Its timestamped events are already in
+// new_input->events.
 void linux_poll_joystick(GameInput *new_input);
 
 #endif // DE100_PLATFORMS_X11_INPUTS_JOYSTICK_H
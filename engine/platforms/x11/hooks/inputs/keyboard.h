@@ -5,6 +5,8 @@
 
 #include <X11/Xlib.h>
 
+// Implemented by the game's adapter. For keysyms or buttons, read the
+// per-keycode tables in ../../inputs/keymap.h rather than mapping per event.
 void handleEventKeyPress(XEvent *event, EngineGameState *game_state,
                          EnginePlatformState *platform_state);
 void handleEventKeyRelease(XEvent *event, EngineGameState *game_state,
@@ -0,0 +1,563 @@
+#include "./evdev.h"
+#include "../../../_common/log.h"
+#include "../../../_common/time.h"
+
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/input.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <sys/ioctl.h>
+#include <time.h>
+#include <unistd.h>
+
+#define EVDEV_INPUT_DIR "/dev/input"
+#define EVDEV_EVENT_RING_MASK (X11_EVDEV_EVENT_RING_SIZE - 1)
+#define EVDEV_READ_BATCH 64
+#define EVDEV_EPOLL_BATCH 8
+
+// epoll_event.data.u64 tags; device slots use 0..X11_EVDEV_MAX_PADS-1
+#define EVDEV_TAG_INOTIFY 0x100
+#define EVDEV_TAG_WAKE 0x101
+
+#define EVDEV_LONG_BITS (sizeof(unsigned long) * 8)
+#define EVDEV_BIT_WORDS(bits) (((bits) + EVDEV_LONG_BITS - 1) / EVDEV_LONG_BITS)
+#define EVDEV_TEST_BIT(words, bit)                                             \
+  (((words)[(bit) / EVDEV_LONG_BITS] >> ((bit) % EVDEV_LONG_BITS)) & 1ul)
+
+typedef struct {
+  int fd; // -1 = slot free
+  char path[64];
+  bool has_monotonic_time; // EVIOCSCLOCKID took; else stamp on read
+  bool has_axis[X11_EVDEV_AXIS_COUNT];
+  struct input_absinfo axis_info[X11_EVDEV_AXIS_COUNT];
+} EvdevDevice;
+
+typedef struct {
+  // Published state (double-buffered seqlock)
+  u32 published;   // __atomic, snapshots[] index readers should use
+  u32 sequence[2]; // __atomic, odd while snapshots[i] is being written
+  X11EvdevSnapshot snapshots[2];
+
+  // Event ring: reader thread produces, frame thread consumes
+  u64 event_write; // __atomic
+  u64 event_read;  // __atomic
+  u64 events_dropped; // __atomic
+  GameInputEvent events[X11_EVDEV_EVENT_RING_SIZE];
+
+  // Reader thread only
+  X11EvdevSnapshot live;
+  EvdevDevice devices[X11_EVDEV_MAX_PADS];
+  int epoll_fd;
+  int inotify_fd;
+  int wake_fd;
+  // Frame thread's eventfd, bumped after each publish (__atomic)
+  int notify_fd;
+  bool has_notify_fd;
+  pthread_t thread;
+  bool thread_started;
+} Evdev;
+
+de100_file_scoped_global_var Evdev g_evdev = {
+    .epoll_fd = -1,
+    .inotify_fd = -1,
+    .wake_fd = -1,
+};
+
+// Indexed by X11EvdevAxis
+de100_file_scoped_global_var const u16 g_evdev_axis_codes[] = {
+    ABS_X, ABS_Y, ABS_Z, ABS_RX, ABS_RY, ABS_RZ, ABS_HAT0X, ABS_HAT0Y,
+};
+
+// ═══════════════════════════════════════════════════════════════════════════
+// PUBLISHING (reader thread)
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn void evdev_publish(Evdev *evdev) {
+  u32 write_index = __atomic_load_n(&evdev->published, __ATOMIC_RELAXED) ^ 1u;
+  u32 sequence = __atomic_load_n(&evdev->sequence[write_index],
+                                 __ATOMIC_RELAXED);
+
+  __atomic_store_n(&evdev->sequence[write_index], sequence + 1,
+                   __ATOMIC_RELAXED);
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+  memcpy(&evdev->snapshots[write_index], &evdev->live,
+         sizeof(X11EvdevSnapshot));
+  __atomic_store_n(&evdev->sequence[write_index], sequence + 2,
+                   __ATOMIC_RELEASE);
+  __atomic_store_n(&evdev->published, write_index, __ATOMIC_RELEASE);
+
+  if (__atomic_load_n(&evdev->has_notify_fd, __ATOMIC_ACQUIRE)) {
+    u64 one = 1;
+    ssize_t written = write(__atomic_load_n(&evdev->notify_fd,
+                                            __ATOMIC_RELAXED),
+                            &one, sizeof(one));
+    (void)written;
+  }
+}
+
+de100_file_scoped_fn void evdev_push_event(Evdev *evdev,
+                                           const GameInputEvent *event) {
+  u64 write = __atomic_load_n(&evdev->event_write, __ATOMIC_RELAXED);
+  u64 read = __atomic_load_n(&evdev->event_read, __ATOMIC_ACQUIRE);
+  if (write - read >= X11_EVDEV_EVENT_RING_SIZE) {
+    __atomic_fetch_add(&evdev->events_dropped, 1, __ATOMIC_RELAXED);
+    return;
+  }
+  evdev->events[write & EVDEV_EVENT_RING_MASK] = *event;
+  __atomic_store_n(&evdev->event_write, write + 1, __ATOMIC_RELEASE);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// DEVICE STATE (reader thread)
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn inline int evdev_button_index(u16 code) {
+  if (code >= BTN_JOYSTICK && code < BTN_JOYSTICK + X11_EVDEV_BUTTON_COUNT) {
+    return code - BTN_JOYSTICK;
+  }
+  return -1;
+}
+
+de100_file_scoped_fn inline int evdev_axis_index(u16 code) {
+  for (int i = 0; i < X11_EVDEV_AXIS_COUNT; ++i) {
+    if (g_evdev_axis_codes[i] == code) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+de100_file_scoped_fn inline f32
+evdev_normalize_axis(const struct input_absinfo *info, i32 value) {
+  if (info->maximum <= info->minimum) {
+    return 0.0f;
+  }
+  f32 t = (f32)(value - info->minimum) /
+          (f32)(info->maximum - info->minimum); // 0..1
+  if (info->minimum == 0) {
+    return t; // Triggers
+  }
+  return t * 2.0f - 1.0f;
+}
+
+de100_file_scoped_fn void evdev_set_button(Evdev *evdev, u32 slot,
+                                           u32 button, bool is_down,
+                                           f64 seconds) {
+  X11EvdevPad *pad = &evdev->live.pads[slot];
+  u32 bit = 1u << button;
+  if (((pad->buttons_down & bit) != 0) == is_down) {
+    return;
+  }
+  pad->buttons_down ^= bit;
+  ++pad->transitions[button];
+
+  GameInputEvent event = {
+      .seconds = seconds,
+      .kind = DE100_INPUT_EVENT_JOYSTICK_BUTTON,
+      .is_down = is_down,
+      .controller = (u8)(slot + MAX_KEYBOARD_COUNT),
+      .code = button,
+  };
+  evdev_push_event(evdev, &event);
+}
+
+de100_file_scoped_fn void evdev_set_axis(Evdev *evdev, u32 slot, u32 axis,
+                                         i32 value, f64 seconds) {
+  EvdevDevice *device = &evdev->devices[slot];
+  X11EvdevPad *pad = &evdev->live.pads[slot];
+  f32 normalized = evdev_normalize_axis(&device->axis_info[axis], value);
+  if (pad->axes[axis] == normalized) {
+    return;
+  }
+  pad->axes[axis] = normalized;
+
+  GameInputEvent event = {
+      .seconds = seconds,
+      .kind = DE100_INPUT_EVENT_JOYSTICK_AXIS,
+      .controller = (u8)(slot + MAX_KEYBOARD_COUNT),
+      .code = axis,
+      .value = normalized,
+  };
+  evdev_push_event(evdev, &event);
+}
+
+/** After SYN_DROPPED: re-read the whole device state, edges included. */
+de100_file_scoped_fn void evdev_resync(Evdev *evdev, u32 slot) {
+  EvdevDevice *device = &evdev->devices[slot];
+  f64 now = de100_get_wall_clock();
+
+  unsigned long keys[EVDEV_BIT_WORDS(KEY_CNT)] = {0};
+  if (ioctl(device->fd, EVIOCGKEY(sizeof(keys)), keys) >= 0) {
+    for (u32 button = 0; button < X11_EVDEV_BUTTON_COUNT; ++button) {
+      evdev_set_button(evdev, slot, button,
+                       EVDEV_TEST_BIT(keys, BTN_JOYSTICK + button), now);
+    }
+  }
+
+  for (u32 axis = 0; axis < X11_EVDEV_AXIS_COUNT; ++axis) {
+    if (device->has_axis[axis] &&
+        ioctl(device->fd, EVIOCGABS(g_evdev_axis_codes[axis]),
+              &device->axis_info[axis]) >= 0) {
+      evdev_set_axis(evdev, slot, axis, device->axis_info[axis].value, now);
+    }
+  }
+}
+
+de100_file_scoped_fn void evdev_disconnect(Evdev *evdev, u32 slot) {
+  EvdevDevice *device = &evdev->devices[slot];
+  if (device->fd < 0) {
+    return;
+  }
+
+  // Release what was held, so the game sees the edges
+  f64 now = de100_get_wall_clock();
+  for (u32 button = 0; button < X11_EVDEV_BUTTON_COUNT; ++button) {
+    evdev_set_button(evdev, slot, button, false, now);
+  }
+  for (u32 axis = 0; axis < X11_EVDEV_AXIS_COUNT; ++axis) {
+    evdev->live.pads[slot].axes[axis] = 0.0f;
+  }
+  evdev->live.pads[slot].is_connected = false;
+
+  DE100_LOG_INFO(DE100_LOG_INPUT, "Gamepad %u disconnected (%s)", slot,
+                 device->path);
+  epoll_ctl(evdev->epoll_fd, EPOLL_CTL_DEL, device->fd, NULL);
+  close(device->fd);
+  device->fd = -1;
+  device->path[0] = '\0';
+}
+
+de100_file_scoped_fn void evdev_read_device(Evdev *evdev, u32 slot) {
+  EvdevDevice *device = &evdev->devices[slot];
+  struct input_event events[EVDEV_READ_BATCH];
+
+  for (;;) {
+    ssize_t bytes = read(device->fd, events, sizeof(events));
+    if (bytes < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      if (errno != EAGAIN) {
+        evdev_disconnect(evdev, slot); // ENODEV: unplugged
+      }
+      return;
+    }
+    if (bytes == 0) {
+      return;
+    }
+
+    u32 count = (u32)((size_t)bytes / sizeof(struct input_event));
+    f64 read_seconds = de100_get_wall_clock();
+    for (u32 i = 0; i < count; ++i) {
+      const struct input_event *event = &events[i];
+      f64 seconds = device->has_monotonic_time
+                        ? (f64)event->input_event_sec +
+                              (f64)event->input_event_usec * 0.000001
+                        : read_seconds;
+
+      if (event->type == EV_KEY) {
+        int button = evdev_button_index(event->code);
+        if (button >= 0 && event->value != 2) { // 2 = autorepeat
+          evdev_set_button(evdev, slot, (u32)button, event->value != 0,
+                           seconds);
+        }
+      } else if (event->type == EV_ABS) {
+        int axis = evdev_axis_index(event->code);
+        if (axis >= 0 && device->has_axis[axis]) {
+          evdev_set_axis(evdev, slot, (u32)axis, event->value, seconds);
+        }
+      } else if (event->type == EV_SYN && event->code == SYN_DROPPED) {
+        evdev_resync(evdev, slot);
+      }
+    }
+
+    if ((size_t)bytes < sizeof(events)) {
+      return; // Drained
+    }
+  }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// HOTPLUG (reader thread)
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn bool evdev_is_gamepad(int fd) {
+  unsigned long keys[EVDEV_BIT_WORDS(KEY_CNT)] = {0};
+  if (ioctl(fd, EVIOCGBIT(EV_KEY, sizeof(keys)), keys) < 0) {
+    return false;
+  }
+  // Keyboards and mice have neither; they stay X11's
+  return EVDEV_TEST_BIT(keys, BTN_GAMEPAD) || EVDEV_TEST_BIT(keys, BTN_JOYSTICK);
+}
+
+de100_file_scoped_fn void evdev_try_open(Evdev *evdev, const char *path) {
+  int free_slot = -1;
+  for (u32 slot = 0; slot < X11_EVDEV_MAX_PADS; ++slot) {
+    if (evdev->devices[slot].fd >= 0) {
+      if (strcmp(evdev->devices[slot].path, path) == 0) {
+        return; // Already open
+      }
+    } else if (free_slot < 0) {
+      free_slot = (int)slot;
+    }
+  }
+  if (free_slot < 0) {
+    return;
+  }
+
+  // EACCES is normal right after creation: udev hasn't chmod'ed the node
+  // yet; the IN_ATTRIB that follows triggers another try
+  int fd = open(path, O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+  if (fd < 0) {
+    return;
+  }
+  if (!evdev_is_gamepad(fd)) {
+    close(fd);
+    return;
+  }
+
+  u32 slot = (u32)free_slot;
+  EvdevDevice *device = &evdev->devices[slot];
+  *device = (EvdevDevice){.fd = fd};
+  snprintf(device->path, sizeof(device->path), "%s", path);
+
+  // Stamp events on de100_get_wall_clock()'s clock
+  int clock_id = CLOCK_MONOTONIC;
+  device->has_monotonic_time = ioctl(fd, EVIOCSCLOCKID, &clock_id) == 0;
+
+  unsigned long abs_bits[EVDEV_BIT_WORDS(ABS_CNT)] = {0};
+  ioctl(fd, EVIOCGBIT(EV_ABS, sizeof(abs_bits)), abs_bits);
+  for (u32 axis = 0; axis < X11_EVDEV_AXIS_COUNT; ++axis) {
+    u16 code = g_evdev_axis_codes[axis];
+    device->has_axis[axis] =
+        EVDEV_TEST_BIT(abs_bits, code) &&
+        ioctl(fd, EVIOCGABS(code), &device->axis_info[axis]) >= 0;
+  }
+
+  struct epoll_event watch = {.events = EPOLLIN, .data.u64 = slot};
+  if (epoll_ctl(evdev->epoll_fd, EPOLL_CTL_ADD, fd, &watch) < 0) {
+    close(fd);
+    device->fd = -1;
+    return;
+  }
+
+  X11EvdevPad *pad = &evdev->live.pads[slot];
+  pad->is_connected = true;
+  ++pad->generation;
+  if (ioctl(fd, EVIOCGNAME(sizeof(pad->name)), pad->name) < 0) {
+    snprintf(pad->name, sizeof(pad->name), "%s", path);
+  }
+
+  DE100_LOG_INFO(DE100_LOG_INPUT, "Gamepad %u connected: %s (%s)", slot,
+                 pad->name, path);
+  evdev_resync(evdev, slot); // Buttons already held, sticks off-center
+}
+
+de100_file_scoped_fn void evdev_scan(Evdev *evdev) {
+  DIR *dir = opendir(EVDEV_INPUT_DIR);
+  if (!dir) {
+    return;
+  }
+
+  struct dirent *entry;
+  while ((entry = readdir(dir)) != NULL) {
+    if (strncmp(entry->d_name, "event", 5) != 0) {
+      continue;
+    }
+    char path[64];
+    int length =
+        snprintf(path, sizeof(path), EVDEV_INPUT_DIR "/%s", entry->d_name);
+    if (length > 0 && (size_t)length < sizeof(path)) {
+      evdev_try_open(evdev, path);
+    }
+  }
+  closedir(dir);
+}
+
+de100_file_scoped_fn void evdev_drain_inotify(Evdev *evdev) {
+  // Contents don't matter: anything under /dev/input means rescan.
+  // Removals show up as read errors on the device itself.
+  char buffer[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+  while (read(evdev->inotify_fd, buffer, sizeof(buffer)) > 0) {
+  }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// THREAD
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn void *evdev_thread_proc(void *param) {
+  Evdev *evdev = (Evdev *)param;
+
+  evdev_scan(evdev);
+  evdev_publish(evdev);
+
+  for (;;) {
+    struct epoll_event ready[EVDEV_EPOLL_BATCH];
+    int count = epoll_wait(evdev->epoll_fd, ready, EVDEV_EPOLL_BATCH, -1);
+    if (count < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      DE100_LOG_WARN(DE100_LOG_INPUT, "Gamepad thread: epoll_wait failed: %s",
+                     strerror(errno));
+      break;
+    }
+
+    bool rescan = false;
+    for (int i = 0; i < count; ++i) {
+      u64 tag = ready[i].data.u64;
+      if (tag == EVDEV_TAG_WAKE) {
+        return NULL;
+      }
+      if (tag == EVDEV_TAG_INOTIFY) {
+        evdev_drain_inotify(evdev);
+        rescan = true;
+      } else if (ready[i].events & (EPOLLHUP | EPOLLERR)) {
+        evdev_disconnect(evdev, (u32)tag);
+      } else {
+        evdev_read_device(evdev, (u32)tag);
+      }
+    }
+    if (rescan) {
+      evdev_scan(evdev);
+    }
+
+    evdev_publish(evdev);
+  }
+
+  return NULL;
+}
+
+de100_file_scoped_fn void evdev_close_fds(Evdev *evdev) {
+  for (u32 slot = 0; slot < X11_EVDEV_MAX_PADS; ++slot) {
+    if (evdev->devices[slot].fd >= 0) {
+      close(evdev->devices[slot].fd);
+      evdev->devices[slot].fd = -1;
+    }
+  }
+  int *fds[] = {&evdev->epoll_fd, &evdev->inotify_fd, &evdev->wake_fd};
+  for (u32 i = 0; i < ArraySize(fds); ++i) {
+    if (*fds[i] >= 0) {
+      close(*fds[i]);
+      *fds[i] = -1;
+    }
+  }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// PUBLIC API
+// ═══════════════════════════════════════════════════════════════════════════
+
+bool x11_evdev_start(void) {
+  Evdev *evdev = &g_evdev;
+  if (evdev->thread_started) {
+    return true;
+  }
+
+  memset(&evdev->live, 0, sizeof(evdev->live));
+  for (u32 slot = 0; slot < X11_EVDEV_MAX_PADS; ++slot) {
+    evdev->devices[slot].fd = -1;
+  }
+
+  evdev->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+  evdev->wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (evdev->epoll_fd < 0 || evdev->wake_fd < 0) {
+    evdev_close_fds(evdev);
+    return false;
+  }
+  struct epoll_event wake = {.events = EPOLLIN, .data.u64 = EVDEV_TAG_WAKE};
+  epoll_ctl(evdev->epoll_fd, EPOLL_CTL_ADD, evdev->wake_fd, &wake);
+
+  // No inotify: still works, just no hotplug
+  evdev->inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (evdev->inotify_fd >= 0 &&
+      inotify_add_watch(evdev->inotify_fd, EVDEV_INPUT_DIR,
+                        IN_CREATE | IN_ATTRIB | IN_DELETE) >= 0) {
+    struct epoll_event watch = {.events = EPOLLIN,
+                                .data.u64 = EVDEV_TAG_INOTIFY};
+    epoll_ctl(evdev->epoll_fd, EPOLL_CTL_ADD, evdev->inotify_fd, &watch);
+  } else {
+    DE100_LOG_WARN(DE100_LOG_INPUT,
+                   "Gamepad thread: no inotify on " EVDEV_INPUT_DIR
+                   ", hotplug disabled");
+  }
+
+  if (pthread_create(&evdev->thread, NULL, evdev_thread_proc, evdev) != 0) {
+    evdev_close_fds(evdev);
+    return false;
+  }
+  evdev->thread_started = true;
+  return true;
+}
+
+void x11_evdev_set_notify_fd(int fd) {
+  Evdev *evdev = &g_evdev;
+  __atomic_store_n(&evdev->has_notify_fd, false, __ATOMIC_RELEASE);
+  if (fd >= 0) {
+    __atomic_store_n(&evdev->notify_fd, fd, __ATOMIC_RELAXED);
+    __atomic_store_n(&evdev->has_notify_fd, true, __ATOMIC_RELEASE);
+  }
+}
+
+void x11_evdev_stop(void) {
+  Evdev *evdev = &g_evdev;
+  if (!evdev->thread_started) {
+    return;
+  }
+
+  u64 one = 1;
+  ssize_t written = write(evdev->wake_fd, &one, sizeof(one));
+  (void)written;
+  pthread_join(evdev->thread, NULL);
+  evdev->thread_started = false;
+  evdev_close_fds(evdev);
+
+  u64 dropped = __atomic_load_n(&evdev->events_dropped, __ATOMIC_RELAXED);
+  if (dropped > 0) {
+    DE100_LOG_INFO(DE100_LOG_INPUT, "Gamepad thread: %llu event(s) dropped",
+                   (unsigned long long)dropped);
+  }
+}
+
+bool x11_evdev_is_running(void) { return g_evdev.thread_started; }
+
+void x11_evdev_read(X11EvdevSnapshot *snapshot) {
+  Evdev *evdev = &g_evdev;
+  for (;;) {
+    u32 index = __atomic_load_n(&evdev->published, __ATOMIC_ACQUIRE);
+    u32 before = __atomic_load_n(&evdev->sequence[index], __ATOMIC_ACQUIRE);
+    if (before & 1u) {
+      continue; // Lapped: the writer is refilling this one
+    }
+    memcpy(snapshot, &evdev->snapshots[index], sizeof(X11EvdevSnapshot));
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    if (__atomic_load_n(&evdev->sequence[index], __ATOMIC_RELAXED) ==
+        before) {
+      return;
+    }
+  }
+}
+
+u32 x11_evdev_drain_events(GameInput *input) {
+  Evdev *evdev = &g_evdev;
+  u64 read = __atomic_load_n(&evdev->event_read, __ATOMIC_RELAXED);
+  u64 write = __atomic_load_n(&evdev->event_write, __ATOMIC_ACQUIRE);
+
+  u32 moved = 0;
+  for (; read != write; ++read) {
+    // A full frame queue counts the drop in input->events_dropped
+    if (de100_input_push_event(input,
+                               &evdev->events[read & EVDEV_EVENT_RING_MASK])) {
+      ++moved;
+    }
+  }
+  __atomic_store_n(&evdev->event_read, read, __ATOMIC_RELEASE);
+  return moved;
+}
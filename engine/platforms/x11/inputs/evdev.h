@@ -0,0 +1,97 @@
+#ifndef DE100_X11_EVDEV_H
+#define DE100_X11_EVDEV_H
+
+#include "../../../_common/base.h"
+#include "../../../game/inputs.h"
+
+// ═══════════════════════════════════════════════════════════════════════════
+// 🎮 BACKGROUND EVDEV GAMEPAD READER (GameConfig.prefer_threaded_joystick)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// One thread owns every gamepad under /dev/input/event*:
+//
+//   epoll ─┬─ eventN fds   → input_event → live state + event ring
+//          ├─ inotify      → /dev/input created/chmod'ed/deleted → rescan
+//          └─ eventfd      → stop
+//
+// The frame thread never touches a device: no read() per frame, and no
+// reconnect scan stalls. State reaches it two ways:
+//
+//   x11_evdev_read()          newest X11EvdevSnapshot, lock-free (seqlock
+//                             over two buffers: the writer fills the one
+//                             readers aren't pointed at, then flips)
+//   x11_evdev_drain_events()  timestamped button/axis events into
+//                             GameInput.events (SPSC ring; see inputs.h)
+//
+// Button edges survive between frames: transitions[] are running counts
+// (kept across reconnects; a disconnect releases held buttons), so the
+// difference between two snapshots is the half-transition count even if
+// a press and release both landed inside one frame.
+//
+// Mapping pads onto the game's buttons stays in the game adapter's
+// linux_poll_joystick(), which reads snapshots instead of devices.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define X11_EVDEV_MAX_PADS MAX_JOYSTICK_COUNT
+#define X11_EVDEV_EVENT_RING_SIZE 256 // Power of two
+
+// Button index = code - BTN_JOYSTICK for BTN_JOYSTICK..BTN_GAMEPAD+15,
+// so BTN_SOUTH (A) = 16, BTN_EAST (B) = 17, ... BTN_THUMBR = 30
+#define X11_EVDEV_BUTTON_COUNT 32
+#define X11_EVDEV_BUTTON_GAMEPAD_FIRST 16
+
+typedef enum {
+  X11_EVDEV_AXIS_LX, // ABS_X
+  X11_EVDEV_AXIS_LY, // ABS_Y
+  X11_EVDEV_AXIS_LT, // ABS_Z
+  X11_EVDEV_AXIS_RX, // ABS_RX
+  X11_EVDEV_AXIS_RY, // ABS_RY
+  X11_EVDEV_AXIS_RT, // ABS_RZ
+  X11_EVDEV_AXIS_HAT_X,
+  X11_EVDEV_AXIS_HAT_Y,
+  X11_EVDEV_AXIS_COUNT
+} X11EvdevAxis;
+
+typedef struct {
+  bool is_connected;
+  u32 generation;   // Bumped on every (re)connect to this slot
+  u32 buttons_down; // Bit per button index
+  u32 transitions[X11_EVDEV_BUTTON_COUNT]; // Running half-transition counts
+  f32 axes[X11_EVDEV_AXIS_COUNT]; // -1..1, or 0..1 for axes with min 0
+  char name[64];
+} X11EvdevPad;
+
+typedef struct {
+  X11EvdevPad pads[X11_EVDEV_MAX_PADS];
+} X11EvdevSnapshot;
+
+/** Start the reader thread. False if epoll/inotify/pthread failed. */
+bool x11_evdev_start(void);
+void x11_evdev_stop(void);
+bool x11_evdev_is_running(void);
+
+/**
+ * Have the reader thread add 1 to eventfd `fd` after every publish, so a
+ * frame thread blocked in epoll wakes on pad input (-1 stops). The fd
+ * must stay open until replaced.
+ */
+void x11_evdev_set_notify_fd(int fd);
+
+/** Copy the newest published state. Never blocks on the reader thread. */
+void x11_evdev_read(X11EvdevSnapshot *snapshot);
+
+/**
+ * Move queued events into input->events (controller = pad slot +
+ * MAX_KEYBOARD_COUNT). Returns how many were moved.
+ */
+u32 x11_evdev_drain_events(GameInput *input);
+
+/** Half transitions of `button` between two snapshots of the same pad. */
+de100_file_scoped_fn inline int
+x11_evdev_button_transitions(const X11EvdevPad *previous,
+                             const X11EvdevPad *current, u32 button) {
+  return (int)(current->transitions[button] - previous->transitions[button]);
+}
+
+#endif // DE100_X11_EVDEV_H
@@ -0,0 +1,51 @@
+#include "./keymap.h"
+#include "../../../_common/log.h"
+
+#include <X11/XKBlib.h>
+#include <string.h>
+
+X11Keymap g_x11_keymap = {0};
+
+void x11_keymap_build(Display *display) {
+  X11Keymap *keymap = &g_x11_keymap;
+  for (u32 i = 0; i < X11_KEYMAP_SIZE; ++i) {
+    keymap->keysyms[i] = NoSymbol;
+  }
+  memset(keymap->buttons, X11_KEYMAP_NO_BUTTON, sizeof(keymap->buttons));
+
+  int min_keycode = 0, max_keycode = 0;
+  XDisplayKeycodes(display, &min_keycode, &max_keycode);
+  if (max_keycode >= X11_KEYMAP_SIZE) {
+    max_keycode = X11_KEYMAP_SIZE - 1;
+  }
+
+  for (int keycode = min_keycode; keycode <= max_keycode; ++keycode) {
+    KeySym keysym = XkbKeycodeToKeysym(display, (KeyCode)keycode, 0, 0);
+    keymap->keysyms[keycode] = keysym;
+    if (keymap->button_of && keysym != NoSymbol) {
+      keymap->buttons[keycode] = keymap->button_of(keysym);
+    }
+  }
+
+  keymap->build_count++;
+  DE100_LOG_DEBUG(DE100_LOG_INPUT, "Keymap built (keycodes %d..%d, #%u)",
+                  min_keycode, max_keycode, keymap->build_count);
+}
+
+void x11_keymap_set_buttons(Display *display,
+                            x11_keymap_button_fn *button_of) {
+  if (g_x11_keymap.button_of == button_of && g_x11_keymap.build_count) {
+    return;
+  }
+  g_x11_keymap.button_of = button_of;
+  x11_keymap_build(display);
+}
+
+void x11_keymap_handle_mapping(XEvent *event) {
+  XMappingEvent *mapping = &event->xmapping;
+  if (mapping->request == MappingPointer) {
+    return;
+  }
+  XRefreshKeyboardMapping(mapping);
+  x11_keymap_build(mapping->display);
+}
@@ -0,0 +1,76 @@
+#ifndef DE100_X11_KEYMAP_H
+#define DE100_X11_KEYMAP_H
+
+#include "../../../_common/base.h"
+#include <X11/Xlib.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// X11 KEYMAP (keycode → keysym / game button, one indexed load per event)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// XLookupKeysym walks the client's copy of the keyboard mapping on every
+// call, and an adapter's switch over keysyms runs after it. Both answers
+// only change when the mapping does, so they are tabled per keycode (X11
+// keycodes are 8..255):
+//
+//   keysyms[keycode]  group 0, level 0 - what XLookupKeysym(event, 0) gave
+//   buttons[keycode]  the game adapter's button for that keysym
+//
+// Built once when the display opens, rebuilt only on MappingNotify
+// (setxkbmap, xmodmap, a layout switch). The game's keyboard adapter
+// registers its keysym → button function once and then reads
+// x11_keymap_button(&event->xkey) instead of mapping per event:
+//
+//   de100_file_scoped_fn u8 tetris_button_of(KeySym keysym) {
+//     switch (keysym) {
+//     case XK_Left: return TETRIS_BUTTON_LEFT;
+//     ...
+//     default:      return X11_KEYMAP_NO_BUTTON;
+//     }
+//   }
+//
+//   // First event, or the adapter's own init:
+//   x11_keymap_set_buttons(event->xkey.display, tetris_button_of);
+//
+// The adapter is linked into the platform executable, so the function
+// pointer survives game code reloads. Main (event) thread only.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define X11_KEYMAP_SIZE 256
+#define X11_KEYMAP_NO_BUTTON 0xFF
+
+/** Adapter's keysym → button index, or X11_KEYMAP_NO_BUTTON. */
+typedef u8 x11_keymap_button_fn(KeySym keysym);
+
+typedef struct {
+  KeySym keysyms[X11_KEYMAP_SIZE]; // NoSymbol where unmapped
+  u8 buttons[X11_KEYMAP_SIZE];     // X11_KEYMAP_NO_BUTTON where unmapped
+  x11_keymap_button_fn *button_of; // NULL until an adapter registers
+  u32 build_count;                 // Init + MappingNotify rebuilds
+} X11Keymap;
+
+extern X11Keymap g_x11_keymap;
+
+/** Fill both tables from the server's mapping (display open). */
+void x11_keymap_build(Display *display);
+
+/** Register the adapter's mapping and rebuild buttons[] with it. */
+void x11_keymap_set_buttons(Display *display,
+                            x11_keymap_button_fn *button_of);
+
+/**
+ * MappingNotify: refresh Xlib's copy of the mapping, then rebuild if the
+ * keyboard or modifier mapping changed (pointer changes are ignored).
+ */
+void x11_keymap_handle_mapping(XEvent *event);
+
+de100_file_scoped_fn inline KeySym x11_keymap_keysym(const XKeyEvent *key) {
+  return g_x11_keymap.keysyms[key->keycode & (X11_KEYMAP_SIZE - 1)];
+}
+
+de100_file_scoped_fn inline u8 x11_keymap_button(const XKeyEvent *key) {
+  return g_x11_keymap.buttons[key->keycode & (X11_KEYMAP_SIZE - 1)];
+}
+
+#endif // DE100_X11_KEYMAP_H
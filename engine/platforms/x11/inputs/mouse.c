@@ -1,30 +1,28 @@
 #include "./mouse.h"
+#include "../../../_common/profiler.h"
 #include "../../../game/inputs.h"
+#include "../../_common/present-scale.h"
 
 #include <X11/Xlib.h>
+#include <X11/extensions/XInput2.h>
 #include <stdio.h>
 
+de100_file_scoped_global_var bool g_x11_raw_mouse_enabled = false;
+
 // ═══════════════════════════════════════════════════════════════════════════
-// POLLING-BASED MOUSE INPUT (Casey's Day 25 Approach)
+// POLLING: RESYNC ONLY
 // ═══════════════════════════════════════════════════════════════════════════
 //
-// WHY POLLING INSTEAD OF EVENTS?
-// ───────────────────────────────
-// Event-based mouse tracking is inherently laggy because:
-//   1. Events are queued and processed after they occur
-//   2. X11 may coalesce multiple MotionNotify events into one
-//   3. Events arrive in batches, not real-time
-//
-// Casey's Windows approach (Day 25):
+// This used to run every frame (Casey's Day 25 GetCursorPos approach):
 //   POINT MouseP;
 //   GetCursorPos(&MouseP);              // Poll current screen position
 //   ScreenToClient(Window, &MouseP);    // Convert to window coordinates
-//   NewInput->MouseX = MouseP.x;
-//   NewInput->MouseY = MouseP.y;
 //
-// Our X11 equivalent:
-//   XQueryPointer() does BOTH in one call - gives us window-relative coords
-//   directly, plus button state as a bonus!
+// XQueryPointer does both in one call, but it is a SYNCHRONOUS round-trip
+// to the X server - the frame blocks until the reply arrives. Events
+// pumped at the start of the frame are just as current and carry the
+// time each change happened, so the per-frame poll is gone; this stays
+// for resyncing state that changed while we weren't getting events.
 //
 // ═══════════════════════════════════════════════════════════════════════════
 
@@ -49,6 +47,7 @@ void x11_poll_mouse(Display *display, Window window, GameInput *input) {
   // This is a SYNCHRONOUS call to the X server - it gets the CURRENT
   // mouse position, not a stale event from the queue.
   // ─────────────────────────────────────────────────────────────────────
+  DE100_PROFILE_INSTANT("x11_round_trip");
   Bool on_same_screen =
       XQueryPointer(display, window,
                     &root_return,  // Root window the pointer is on
@@ -69,9 +68,9 @@ void x11_poll_mouse(Display *display, Window window, GameInput *input) {
   // ─────────────────────────────────────────────────────────────────────
   // POSITION: Direct assignment from current state
   // ─────────────────────────────────────────────────────────────────────
-  // This is the KEY fix for mouse lag - we're getting the position
-  // RIGHT NOW, not from a queued event that happened milliseconds ago.
+  // The position RIGHT NOW, whatever events we missed in between.
   // ─────────────────────────────────────────────────────────────────────
+  present_scale_window_to_backbuffer(&win_x, &win_y);
   input->mouse_x = win_x;
   input->mouse_y = win_y;
   // Note: mouse_z (scroll wheel) cannot be polled - it's event-only
@@ -105,98 +104,192 @@ void x11_poll_mouse(Display *display, Window window, GameInput *input) {
 // ═══════════════════════════════════════════════════════════════════════════
 // EVENT-BASED HANDLERS
 // ═══════════════════════════════════════════════════════════════════════════
-// These are ONLY for things that CANNOT be polled:
-//   1. Scroll wheel (discrete events, no persistent state)
-//   2. XButton1/2 (back/forward, not in standard button mask)
-//
-// We do NOT handle MotionNotify here - polling is better for position!
+// X11 button numbers → mouse_buttons[] (Casey's layout):
+//   Button1 = LMB → [0]    Button2 = MMB → [1]    Button3 = RMB → [2]
+//   8 = XButton1 (Back) → [3]    9 = XButton2 (Forward) → [4]
+//   Button4/5 = scroll wheel up/down → mouse_z
 // ═══════════════════════════════════════════════════════════════════════════
 
-void handle_mouse_button_press(XEvent *event, GameInput *input) {
+de100_file_scoped_fn inline int x11_mouse_button_index(unsigned int button) {
+  switch (button) {
+  case Button1:
+    return 0;
+  case Button2:
+    return 1;
+  case Button3:
+    return 2;
+  case 8:
+    return 3;
+  case 9:
+    return 4;
+  default:
+    return -1;
+  }
+}
+
+de100_file_scoped_fn inline void x11_mouse_button(XEvent *event,
+                                                  GameInput *input,
+                                                  bool is_down, f64 seconds) {
+  int index = x11_mouse_button_index(event->xbutton.button);
+  if (index < 0) {
+    return;
+  }
+  process_game_button_state(is_down, &input->mouse_buttons[index]);
+
+  i32 x = event->xbutton.x;
+  i32 y = event->xbutton.y;
+  present_scale_window_to_backbuffer(&x, &y);
+  GameInputEvent input_event = {
+      .seconds = seconds,
+      .kind = DE100_INPUT_EVENT_MOUSE_BUTTON,
+      .is_down = is_down,
+      .code = (u32)index,
+      .x = (i16)x,
+      .y = (i16)y,
+  };
+  de100_input_push_event(input, &input_event);
+}
+
+void handle_mouse_motion(XEvent *event, GameInput *input, f64 seconds) {
   if (!event || !input) {
     return;
   }
 
-  unsigned int button = event->xbutton.button;
+  i32 x = event->xmotion.x;
+  i32 y = event->xmotion.y;
+  present_scale_window_to_backbuffer(&x, &y);
+  if (!g_x11_raw_mouse_enabled) {
+    input->mouse_dx += (f32)(x - input->mouse_x);
+    input->mouse_dy += (f32)(y - input->mouse_y);
+  }
+  input->mouse_x = x;
+  input->mouse_y = y;
 
-  switch (button) {
-  // ─────────────────────────────────────────────────────────────────
-  // SCROLL WHEEL: Cannot be polled, must use events
-  // ─────────────────────────────────────────────────────────────────
-  // X11 treats scroll wheel as button presses:
-  //   Button4 = Scroll up
-  //   Button5 = Scroll down
-  // There's no "scroll wheel position" to poll - only discrete events.
-  // ─────────────────────────────────────────────────────────────────
-  case Button4: // Scroll up
-    input->mouse_z += 1;
-    break;
+  GameInputEvent input_event = {
+      .seconds = seconds,
+      .kind = DE100_INPUT_EVENT_MOUSE_MOVE,
+      .x = (i16)x,
+      .y = (i16)y,
+  };
+  de100_input_push_event(input, &input_event);
+}
 
-  case Button5: // Scroll down
-    input->mouse_z -= 1;
-    break;
+void handle_mouse_button_press(XEvent *event, GameInput *input, f64 seconds) {
+  if (!event || !input) {
+    return;
+  }
 
   // ─────────────────────────────────────────────────────────────────
-  // EXTRA MOUSE BUTTONS: Not in standard mask, use events
-  // ─────────────────────────────────────────────────────────────────
-  // Button 8 = XButton1 (Back/Thumb1)
-  // Button 9 = XButton2 (Forward/Thumb2)
-  // These map to MouseButtons[3] and [4] to match Casey's layout.
+  // SCROLL WHEEL: X11 reports it as Button4 (up) / Button5 (down)
+  // presses - there's no wheel position, only discrete events.
   // ─────────────────────────────────────────────────────────────────
-  case 8: // XButton1 (Back)
-    process_game_button_state(true, &input->mouse_buttons[3]);
-    break;
-
-  case 9: // XButton2 (Forward)
-    process_game_button_state(true, &input->mouse_buttons[4]);
-    break;
+  unsigned int button = event->xbutton.button;
+  if (button == Button4 || button == Button5) {
+    i32 delta = button == Button4 ? 1 : -1;
+    input->mouse_z += delta;
 
-  // Button1/2/3 (LMB/MMB/RMB) are handled by polling, ignore here
-  default:
-    break;
+    GameInputEvent input_event = {
+        .seconds = seconds,
+        .kind = DE100_INPUT_EVENT_MOUSE_WHEEL,
+        .y = (i16)delta,
+    };
+    de100_input_push_event(input, &input_event);
+    return;
   }
+
+  x11_mouse_button(event, input, true, seconds);
 }
 
-void handle_mouse_button_release(XEvent *event, GameInput *input) {
+void handle_mouse_button_release(XEvent *event, GameInput *input,
+                                 f64 seconds) {
   if (!event || !input) {
     return;
   }
 
+  // Scroll wheel "releases" are meaningless, ignore them
   unsigned int button = event->xbutton.button;
+  if (button == Button4 || button == Button5) {
+    return;
+  }
 
-  switch (button) {
-  // Scroll wheel "releases" are meaningless, ignore them
-  case Button4:
-  case Button5:
-    break;
+  x11_mouse_button(event, input, false, seconds);
+}
 
-  // Extra mouse button releases
-  case 8: // XButton1 (Back)
-    process_game_button_state(false, &input->mouse_buttons[3]);
-    break;
+// ═══════════════════════════════════════════════════════════════════════════
+// RAW MOTION (XInput2)
+// ═══════════════════════════════════════════════════════════════════════════
 
-  case 9: // XButton2 (Forward)
-    process_game_button_state(false, &input->mouse_buttons[4]);
-    break;
+int x11_raw_mouse_enable(Display *display) {
+  int opcode, first_event, first_error;
+  if (!XQueryExtension(display, "XInputExtension", &opcode, &first_event,
+                       &first_error)) {
+    return -1;
+  }
 
-  // Button1/2/3 (LMB/MMB/RMB) are handled by polling, ignore here
-  default:
-    break;
+  int major = 2, minor = 0;
+  if (XIQueryVersion(display, &major, &minor) != Success) {
+    return -1;
+  }
+
+  unsigned char mask_bits[XIMaskLen(XI_LASTEVENT)] = {0};
+  XISetMask(mask_bits, XI_RawMotion);
+  XIEventMask mask = {
+      .deviceid = XIAllMasterDevices,
+      .mask_len = sizeof(mask_bits),
+      .mask = mask_bits,
+  };
+  if (XISelectEvents(display, DefaultRootWindow(display), &mask, 1) !=
+      Success) {
+    return -1;
   }
+
+  g_x11_raw_mouse_enabled = true;
+  return opcode;
 }
 
-// ═══════════════════════════════════════════════════════════════════════════
-// DEPRECATED: Event-based mouse motion
-// ═══════════════════════════════════════════════════════════════════════════
-// This function is NO LONGER USED. Keeping it commented for reference.
-// Polling via x11_poll_mouse() is the correct approach.
-// ═══════════════════════════════════════════════════════════════════════════
-/*
-void handle_mouse_motion(XEvent *event, GameInput *input) {
-    // DON'T USE THIS - it causes lag!
-    // Events are queued and may be coalesced by X11.
-    // Use x11_poll_mouse() instead for responsive mouse tracking.
-    input->mouse_x = event->xmotion.x;
-    input->mouse_y = event->xmotion.y;
+bool handle_mouse_raw_event(Display *display, XEvent *event, int xi_opcode,
+                            GameInput *input,
+                            f64 (*seconds_from_time)(Time time)) {
+  XGenericEventCookie *cookie = &event->xcookie;
+  if (xi_opcode < 0 || cookie->extension != xi_opcode ||
+      cookie->evtype != XI_RawMotion) {
+    return false;
+  }
+  if (!XGetEventData(display, cookie)) {
+    return true;
+  }
+  if (!input) {
+    XFreeEventData(display, cookie); // Not focused: drop it
+    return true;
+  }
+
+  // raw_values holds one entry per SET valuator bit, in bit order;
+  // valuator 0 is X, 1 is Y
+  const XIRawEvent *raw = (const XIRawEvent *)cookie->data;
+  const double *value = raw->raw_values;
+  f64 dx = 0.0, dy = 0.0;
+  for (int axis = 0; axis < 2 && axis < raw->valuators.mask_len * 8; ++axis) {
+    if (XIMaskIsSet(raw->valuators.mask, axis)) {
+      if (axis == 0) {
+        dx = *value;
+      } else {
+        dy = *value;
+      }
+      ++value;
+    }
+  }
+
+  input->mouse_dx += (f32)dx;
+  input->mouse_dy += (f32)dy;
+
+  GameInputEvent input_event = {
+      .seconds = seconds_from_time(raw->time),
+      .kind = DE100_INPUT_EVENT_MOUSE_DELTA,
+      .x = (i16)dx, // Mouse counts are whole; mouse_dx keeps any fraction
+      .y = (i16)dy,
+  };
+  de100_input_push_event(input, &input_event);
+
+  XFreeEventData(display, cookie);
+  return true;
 }
-*/
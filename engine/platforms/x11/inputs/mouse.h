@@ -9,17 +9,21 @@
 // ═══════════════════════════════════════════════════════════════════════════
 //
 // USAGE:
-//   1. Call x11_poll_mouse() ONCE per frame in your main loop
-//   2. Handle ButtonPress/ButtonRelease events for scroll wheel only
-//   3. Do NOT use MotionNotify events - polling is better!
+//   1. Select PointerMotionMask | ButtonPressMask | ButtonReleaseMask
+//   2. Pump events at the START of the frame, before the game update,
+//      and route MotionNotify/ButtonPress/ButtonRelease here
+//   3. Call x11_poll_mouse() only to resync (e.g. on FocusIn) - it is a
+//      blocking round-trip to the X server
+//
+// Every handler also queues a timestamped GameInputEvent.
 //
 // ═══════════════════════════════════════════════════════════════════════════
 
 /**
  * Poll current mouse position and button state.
  *
- * Call this ONCE per frame, BEFORE processing X11 events.
- * This gives you the CURRENT mouse position, not stale event data.
+ * One XQueryPointer round-trip. Events keep the state current while the
+ * window has the pointer; use this to resync after it didn't.
  *
  * Equivalent to Casey's Windows approach:
  *   GetCursorPos(&MouseP);
@@ -33,23 +37,61 @@
  */
 void x11_poll_mouse(Display *display, Window window, GameInput *input);
 
+// ═══════════════════════════════════════════════════════════════════════════
+// RAW MOTION (XInput2, GameConfig.prefer_raw_mouse_input)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// MotionNotify is the pointer after acceleration, clamped to the screen,
+// and the server may coalesce it. XI_RawMotion is every device report,
+// unaccelerated, each with its own timestamp - a 1000Hz mouse gives ~16
+// per 60Hz frame. They accumulate into mouse_dx/dy and queue MOUSE_DELTA
+// events; position still comes from MotionNotify.
+//
+// Raw events go to the root window regardless of focus, so the backend
+// only feeds them in while the window is active.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
 /**
- * Handle mouse button press events.
+ * Select XI_RawMotion on the root window.
  *
- * Only needed for:
- *   - Scroll wheel (Button4/5) - cannot be polled
- *   - XButton1/2 (Button8/9) - not in standard mask
+ * @return The XInputExtension major opcode (match it against
+ *         event->xcookie.extension), or -1 without XInput 2.0
+ */
+int x11_raw_mouse_enable(Display *display);
+
+/**
+ * Handle a GenericEvent cookie. True if it was raw motion (and consumed).
+ * Pass input = NULL to consume without applying (window not focused).
+ *
+ * @param seconds_from_time  Maps the raw event's server Time to wall clock
+ */
+bool handle_mouse_raw_event(Display *display, XEvent *event, int xi_opcode,
+                            GameInput *input,
+                            f64 (*seconds_from_time)(Time time));
+
+/**
+ * Handle mouse motion events: position + a MOUSE_MOVE event.
+ * Without raw motion, also accumulates the pixel delta into mouse_dx/dy.
+ *
+ * @param seconds  event->xmotion.time on the wall-clock timebase
+ */
+void handle_mouse_motion(XEvent *event, GameInput *input, f64 seconds);
+
+/**
+ * Handle mouse button press events.
  *
- * LMB/MMB/RMB are polled, so ButtonPress for those is ignored.
+ * Button1-3 and 8/9 update mouse_buttons[]; Button4/5 (scroll wheel) add
+ * to mouse_z.
  */
-void handle_mouse_button_press(XEvent *event, GameInput *input);
+void handle_mouse_button_press(XEvent *event, GameInput *input, f64 seconds);
 
 /**
  * Handle mouse button release events.
  *
- * Only needed for XButton1/2 releases.
- * Scroll wheel and LMB/MMB/RMB releases are ignored.
+ * Scroll wheel "releases" are ignored.
  */
-void handle_mouse_button_release(XEvent *event, GameInput *input);
+void handle_mouse_button_release(XEvent *event, GameInput *input,
+                                 f64 seconds);
 
 #endif // DE100_X11_MOUSE_H
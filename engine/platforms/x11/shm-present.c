@@ -0,0 +1,632 @@
+#include "shm-present.h"
+#include "../../_common/memory.h"
+#include "../../_common/time.h"
+
+#include <X11/Xutil.h>
+#include <X11/extensions/XShm.h>
+#include <errno.h>
+#include <poll.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/ipc.h>
+#include <sys/shm.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ERROR MESSAGES
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_global_var const char *g_x11_shm_present_error_messages[] = {
+    [X11_SHM_PRESENT_SUCCESS] = "Success",
+    [X11_SHM_PRESENT_ERROR_NULL_ARGUMENT] = "NULL display, visual or "
+                                            "backbuffer",
+    [X11_SHM_PRESENT_ERROR_ALREADY_ACTIVE] = "SHM presenter already active",
+    [X11_SHM_PRESENT_ERROR_VISUAL_FORMAT] =
+        "Window visual doesn't match the backbuffer pixel format",
+    [X11_SHM_PRESENT_ERROR_IMAGE_FAILED] = "Failed to create the XImage",
+};
+
+const char *x11_shm_present_strerror(X11ShmPresentErrorCode code) {
+  if (code >= 0 && code < X11_SHM_PRESENT_ERROR_COUNT) {
+    return g_x11_shm_present_error_messages[code];
+  }
+  return "Unknown SHM present error";
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// STATE
+// ═══════════════════════════════════════════════════════════════════════════
+
+typedef struct {
+  XShmSegmentInfo info;
+  XImage *image;
+  u8 *pixels;
+  u32 pending;     // ShmCompletion events still to come
+  u64 frame;       // Present count of the frame it holds (0 = never used)
+  f64 put_seconds; // Wall clock at the last put that asked for one
+} X11ShmSegment;
+
+typedef struct {
+  Display *display;
+  Window window;
+  GC gc;
+  i32 width; // Backbuffer size the images were made for
+  i32 height;
+
+  bool is_shared;
+  int completion_type; // XShmGetEventBase + ShmCompletion
+  X11ShmSegment segments[X11_SHM_SEGMENT_COUNT];
+  i32 current;    // Zero-copy: the segment the game draws into
+  i32 last_shown; // Newest put segment (-1 = none yet)
+  u64 present_count;
+  GameDirtyRegion damage_history[X11_SHM_DAMAGE_HISTORY];
+
+  // XPutImage fallback: an image header over the engine's backbuffer
+  XImage *put_image;
+  void *put_last_pixels;
+
+  bool is_zero_copy;
+  void *backbuffer_original_base;
+
+  // Bars around the centered image
+  i32 window_width;
+  i32 window_height;
+
+  X11ShmPresentStats stats;
+  bool is_active;
+} X11ShmPresent;
+
+de100_file_scoped_global_var X11ShmPresent g_x11_shm_present = {0};
+de100_file_scoped_global_var bool g_x11_shm_attach_failed = false;
+
+de100_file_scoped_fn inline f32 x11_shm_ewma(f32 average, f32 sample,
+                                             u64 count) {
+  return count <= 1 ? sample
+                    : average + (sample - average) * X11_SHM_STATS_ALPHA;
+}
+
+de100_file_scoped_fn int x11_shm_attach_error_handler(Display *display,
+                                                      XErrorEvent *event) {
+  (void)display;
+  (void)event;
+  g_x11_shm_attach_failed = true;
+  return 0;
+}
+
+/** The visual stores pixels exactly as the game packs them. */
+de100_file_scoped_fn bool x11_shm_visual_matches(Display *display,
+                                                 Visual *visual, int depth) {
+  return (depth == 24 || depth == 32) &&
+         ImageByteOrder(display) == LSBFirst &&
+         visual->red_mask == (0xFFul << DE100_PIXEL_SHIFT_RED) &&
+         visual->green_mask == (0xFFul << DE100_PIXEL_SHIFT_GREEN) &&
+         visual->blue_mask == (0xFFul << DE100_PIXEL_SHIFT_BLUE);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// SEGMENTS
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn void x11_shm_destroy_segment(X11ShmSegment *segment) {
+  if (segment->image) {
+    XDestroyImage(segment->image); // The header only; pixels are shm
+  }
+  if (segment->pixels) {
+    shmdt(segment->pixels);
+  }
+  *segment = (X11ShmSegment){0};
+}
+
+/**
+ * Create one segment and attach it to the server. Attaching fails with
+ * an X error, not a return value (e.g. a remote server that can't see
+ * our memory), so it is synced under a temporary error handler.
+ */
+de100_file_scoped_fn bool x11_shm_create_segment(X11ShmPresent *present,
+                                                 X11ShmSegment *segment,
+                                                 Visual *visual, int depth,
+                                                 int pitch) {
+  Display *display = present->display;
+  segment->image =
+      XShmCreateImage(display, visual, (unsigned int)depth, ZPixmap, NULL,
+                      &segment->info, (unsigned int)present->width,
+                      (unsigned int)present->height);
+  if (!segment->image || segment->image->bits_per_pixel != 32 ||
+      segment->image->bytes_per_line != pitch) {
+    x11_shm_destroy_segment(segment);
+    return false;
+  }
+
+  segment->info.shmid =
+      shmget(IPC_PRIVATE,
+             (size_t)segment->image->bytes_per_line *
+                 (size_t)segment->image->height,
+             IPC_CREAT | 0600);
+  if (segment->info.shmid < 0) {
+    fprintf(stderr, "⚠️  X11 SHM: shmget failed (%s)\n", strerror(errno));
+    x11_shm_destroy_segment(segment);
+    return false;
+  }
+  void *pixels = shmat(segment->info.shmid, NULL, 0);
+  if (pixels == (void *)-1) {
+    fprintf(stderr, "⚠️  X11 SHM: shmat failed (%s)\n", strerror(errno));
+    shmctl(segment->info.shmid, IPC_RMID, NULL);
+    x11_shm_destroy_segment(segment);
+    return false;
+  }
+  segment->pixels = (u8 *)pixels;
+  segment->info.shmaddr = segment->image->data = (char *)pixels;
+  segment->info.readOnly = False;
+
+  XSync(display, False);
+  g_x11_shm_attach_failed = false;
+  XErrorHandler previous = XSetErrorHandler(x11_shm_attach_error_handler);
+  XShmAttach(display, &segment->info);
+  XSync(display, False);
+  XSetErrorHandler(previous);
+
+  // Freed once both sides detach, even if we crash
+  shmctl(segment->info.shmid, IPC_RMID, NULL);
+
+  if (g_x11_shm_attach_failed) {
+    x11_shm_destroy_segment(segment);
+    return false;
+  }
+  return true;
+}
+
+/** Copy `rect` (or everything) between two same-layout buffers. */
+de100_file_scoped_fn void x11_shm_copy_rect(u8 *dest, const u8 *source,
+                                            const GameBackBuffer *backbuffer,
+                                            const De100DirtyRect *rect) {
+  De100DirtyRect all = {0, 0, backbuffer->width, backbuffer->height};
+  if (!rect) {
+    rect = &all;
+  }
+  u64 offset = (u64)rect->y * (u64)backbuffer->pitch +
+               (u64)rect->x * (u64)backbuffer->bytes_per_pixel;
+  u64 row_bytes = (u64)rect->width * (u64)backbuffer->bytes_per_pixel;
+  for (int y = 0; y < rect->height; ++y) {
+    de100_mem_copy(dest + offset, source + offset, row_bytes);
+    offset += (u64)backbuffer->pitch;
+  }
+}
+
+/**
+ * Bring `segment` up to date with `source` for every frame after the one
+ * it holds, up to and including frame `through`.
+ */
+de100_file_scoped_fn void x11_shm_repair(X11ShmPresent *present,
+                                         X11ShmSegment *segment,
+                                         const u8 *source, u64 through,
+                                         const GameBackBuffer *backbuffer) {
+  if (segment->frame == 0 ||
+      through - segment->frame >= X11_SHM_DAMAGE_HISTORY) {
+    x11_shm_copy_rect(segment->pixels, source, backbuffer, NULL);
+    return;
+  }
+  for (u64 frame = segment->frame + 1; frame <= through; ++frame) {
+    const GameDirtyRegion *damage =
+        &present->damage_history[frame % X11_SHM_DAMAGE_HISTORY];
+    if (damage->full_frame) {
+      x11_shm_copy_rect(segment->pixels, source, backbuffer, NULL);
+      return;
+    }
+    for (int i = 0; i < damage->count; ++i) {
+      x11_shm_copy_rect(segment->pixels, source, backbuffer,
+                        &damage->rects[i]);
+    }
+  }
+}
+
+/**
+ * Block until a ShmCompletion arrives or `deadline` passes. Only
+ * completions are taken off the queue; input stays for the next pump.
+ */
+de100_file_scoped_fn bool x11_shm_wait_completion(X11ShmPresent *present,
+                                                  f64 deadline) {
+  XEvent event;
+  for (;;) {
+    // Flushes our puts, then reads whatever the server has sent
+    if (XCheckTypedEvent(present->display, present->completion_type,
+                         &event)) {
+      x11_shm_present_handle_event(&event);
+      return true;
+    }
+    int remaining_ms = (int)((deadline - de100_get_wall_clock()) * 1000.0);
+    if (remaining_ms <= 0) {
+      return false;
+    }
+    struct pollfd connection = {
+        .fd = ConnectionNumber(present->display),
+        .events = POLLIN,
+    };
+    if (poll(&connection, 1, remaining_ms) < 0 && errno != EINTR) {
+      return false;
+    }
+  }
+}
+
+/**
+ * A segment the server is done reading (the one holding the newest
+ * frame, so it needs the least repair), waiting up to `timeout_seconds`
+ * for one. -1 if none came back.
+ */
+de100_file_scoped_fn i32 x11_shm_acquire(X11ShmPresent *present,
+                                         f32 timeout_seconds) {
+  f64 start = de100_get_wall_clock();
+  f64 deadline = start + (f64)timeout_seconds;
+  bool has_waited = false;
+  for (;;) {
+    i32 best = -1;
+    for (i32 i = 0; i < X11_SHM_SEGMENT_COUNT; ++i) {
+      X11ShmSegment *segment = &present->segments[i];
+      if (segment->pending == 0 &&
+          (best < 0 || segment->frame > present->segments[best].frame)) {
+        best = i;
+      }
+    }
+    if (best >= 0) {
+      if (has_waited) {
+        X11ShmPresentStats *stats = &present->stats;
+        stats->waits++;
+        stats->wait_ms = x11_shm_ewma(
+            stats->wait_ms, (f32)((de100_get_wall_clock() - start) * 1000.0),
+            stats->waits);
+      }
+      return best;
+    }
+    has_waited = true;
+    if (!x11_shm_wait_completion(present, deadline)) {
+      return -1;
+    }
+  }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// PUTS
+// ═══════════════════════════════════════════════════════════════════════════
+
+/** Black out the window around the centered image. */
+de100_file_scoped_fn void x11_shm_clear_bars(X11ShmPresent *present, i32 x,
+                                             i32 y) {
+  XRectangle bars[4];
+  int count = 0;
+  i32 right = x + present->width;
+  i32 bottom = y + present->height;
+  if (y > 0) {
+    bars[count++] = (XRectangle){0, 0, (unsigned short)present->window_width,
+                                 (unsigned short)y};
+  }
+  if (bottom < present->window_height) {
+    bars[count++] =
+        (XRectangle){0, (short)bottom, (unsigned short)present->window_width,
+                     (unsigned short)(present->window_height - bottom)};
+  }
+  if (x > 0) {
+    bars[count++] = (XRectangle){0, (short)y, (unsigned short)x,
+                                 (unsigned short)present->height};
+  }
+  if (right < present->window_width) {
+    bars[count++] =
+        (XRectangle){(short)right, (short)y,
+                     (unsigned short)(present->window_width - right),
+                     (unsigned short)present->height};
+  }
+  if (count > 0) {
+    XFillRectangles(present->display, present->window, present->gc, bars,
+                    count);
+  }
+}
+
+/**
+ * Put `rects` (NULL = the whole image) of `segment` (NULL = the
+ * XPutImage fallback) at (x, y). Only the last put asks for a
+ * ShmCompletion: the server handles them in order.
+ */
+de100_file_scoped_fn void x11_shm_put(X11ShmPresent *present,
+                                      X11ShmSegment *segment,
+                                      const GameDirtyRegion *rects, i32 x,
+                                      i32 y) {
+  De100DirtyRect all = {0, 0, present->width, present->height};
+  int count = rects ? rects->count : 1;
+  for (int i = 0; i < count; ++i) {
+    const De100DirtyRect *rect = rects ? &rects->rects[i] : &all;
+    if (!segment) {
+      XPutImage(present->display, present->window, present->gc,
+                present->put_image, rect->x, rect->y, x + rect->x,
+                y + rect->y, (unsigned int)rect->width,
+                (unsigned int)rect->height);
+      continue;
+    }
+    bool is_last = i == count - 1;
+    XShmPutImage(present->display, present->window, present->gc,
+                 segment->image, rect->x, rect->y, x + rect->x, y + rect->y,
+                 (unsigned int)rect->width, (unsigned int)rect->height,
+                 is_last ? True : False);
+  }
+  if (segment && count > 0) {
+    segment->pending++;
+    segment->put_seconds = de100_get_wall_clock();
+  }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// PUBLIC API
+// ═══════════════════════════════════════════════════════════════════════════
+
+X11ShmPresentResult x11_shm_present_init(Display *display, Window window,
+                                         Visual *visual, int depth,
+                                         GameBackBuffer *backbuffer,
+                                         bool zero_copy) {
+  X11ShmPresentResult result = {0};
+  X11ShmPresent *present = &g_x11_shm_present;
+
+  if (!display || !visual || !backbuffer) {
+    result.error_code = X11_SHM_PRESENT_ERROR_NULL_ARGUMENT;
+    return result;
+  }
+  if (present->is_active) {
+    result.error_code = X11_SHM_PRESENT_ERROR_ALREADY_ACTIVE;
+    return result;
+  }
+  if (!x11_shm_visual_matches(display, visual, depth)) {
+    fprintf(stderr,
+            "❌ X11 SHM: visual masks %06lx/%06lx/%06lx aren't %s%s\n",
+            visual->red_mask, visual->green_mask, visual->blue_mask,
+            de100_pixel_format_name(DE100_PIXEL_FORMAT),
+            DE100_PIXEL_FORMAT == DE100_PIXEL_FORMAT_BGRA8
+                ? ""
+                : "; BGRA8 (-DDE100_PIXEL_FORMAT=1) is the usual one");
+    result.error_code = X11_SHM_PRESENT_ERROR_VISUAL_FORMAT;
+    return result;
+  }
+
+  *present = (X11ShmPresent){0};
+  present->display = display;
+  present->window = window;
+  present->width = backbuffer->width;
+  present->height = backbuffer->height;
+  present->current = -1;
+  present->last_shown = -1;
+
+  present->gc = XCreateGC(display, window, 0, NULL);
+  XSetForeground(display, present->gc,
+                 BlackPixel(display, DefaultScreen(display)));
+  XSetGraphicsExposures(display, present->gc, False);
+
+  int major = 0, minor = 0;
+  Bool has_pixmaps = False;
+  if (XShmQueryVersion(display, &major, &minor, &has_pixmaps)) {
+    present->is_shared = true;
+    for (u32 i = 0; i < X11_SHM_SEGMENT_COUNT && present->is_shared; ++i) {
+      present->is_shared =
+          x11_shm_create_segment(present, &present->segments[i], visual,
+                                 depth, backbuffer->pitch);
+    }
+    if (!present->is_shared) {
+      for (u32 i = 0; i < X11_SHM_SEGMENT_COUNT; ++i) {
+        if (present->segments[i].pixels) {
+          XShmDetach(display, &present->segments[i].info);
+        }
+        x11_shm_destroy_segment(&present->segments[i]);
+      }
+      printf("⚠️  X11 SHM: segments unavailable, presenting with "
+             "XPutImage\n");
+    }
+  } else {
+    printf("⚠️  X server lacks MIT-SHM (remote display?), presenting with "
+           "XPutImage\n");
+  }
+
+  if (present->is_shared) {
+    present->completion_type = XShmGetEventBase(display) + ShmCompletion;
+  } else {
+    present->put_image = XCreateImage(
+        display, visual, (unsigned int)depth, ZPixmap, 0, NULL,
+        (unsigned int)present->width, (unsigned int)present->height, 32,
+        backbuffer->pitch);
+    if (!present->put_image || present->put_image->bits_per_pixel != 32) {
+      if (present->put_image) {
+        XDestroyImage(present->put_image);
+      }
+      XFreeGC(display, present->gc);
+      *present = (X11ShmPresent){0};
+      result.error_code = X11_SHM_PRESENT_ERROR_IMAGE_FAILED;
+      return result;
+    }
+    // Our pixels are host-order u32s; Xlib swaps for other servers
+    present->put_image->byte_order = LSBFirst;
+  }
+
+  if (zero_copy && present->is_shared) {
+    present->is_zero_copy = true;
+    present->backbuffer_original_base = backbuffer->memory.base;
+    present->current = 0;
+    backbuffer->memory.base = present->segments[0].pixels;
+  } else if (zero_copy) {
+    printf("⚠️  X11: mapped backbuffer needs MIT-SHM, not using it\n");
+  }
+
+  present->is_active = true;
+  printf("✅ X11 present: %s, %dx%d %s (%s)\n",
+         present->is_shared ? "MIT-SHM XShmPutImage" : "XPutImage",
+         present->width, present->height,
+         de100_pixel_format_name(DE100_PIXEL_FORMAT),
+         present->is_zero_copy ? "game renders into shared memory"
+                               : "copied at present");
+
+  result.success = true;
+  result.error_code = X11_SHM_PRESENT_SUCCESS;
+  return result;
+}
+
+bool x11_shm_present_frame(GameBackBuffer *backbuffer, i32 window_width,
+                           i32 window_height, f32 timeout_seconds) {
+  X11ShmPresent *present = &g_x11_shm_present;
+  if (!present->is_active) {
+    return false;
+  }
+
+  GameDirtyRegion *dirty = &backbuffer->dirty;
+  bool is_full = !dirty->is_tracking || dirty->full_frame;
+  bool is_resized = window_width != present->window_width ||
+                    window_height != present->window_height;
+  if (!is_full && !is_resized && dirty->count == 0) {
+    return false; // Nothing changed; zero-copy keeps its segment
+  }
+  is_full = is_full || is_resized; // The image moved with the center
+
+  i32 x = (window_width - present->width) / 2;
+  i32 y = (window_height - present->height) / 2;
+
+  if (!present->is_shared) {
+    present->put_image->data = (char *)backbuffer->memory.base;
+    if (is_resized) {
+      present->window_width = window_width;
+      present->window_height = window_height;
+      x11_shm_clear_bars(present, x, y);
+    }
+    x11_shm_put(present, NULL, is_full ? NULL : dirty, x, y);
+    present->put_image->data = NULL;
+    present->put_last_pixels = backbuffer->memory.base;
+    present->stats.presented++;
+    de100_backbuffer_clear_dirty(backbuffer);
+    return true;
+  }
+
+  i32 index = present->current;
+  if (!present->is_zero_copy) {
+    index = x11_shm_acquire(present, timeout_seconds);
+    if (index < 0) {
+      present->stats.skipped++;
+      return false; // The dirty region carries over to the next frame
+    }
+  }
+
+  X11ShmSegment *segment = &present->segments[index];
+  u64 frame = ++present->present_count;
+  GameDirtyRegion *history =
+      &present->damage_history[frame % X11_SHM_DAMAGE_HISTORY];
+  *history = *dirty;
+  history->full_frame = is_full;
+
+  if (!present->is_zero_copy) {
+    x11_shm_repair(present, segment, (const u8 *)backbuffer->memory.base,
+                   frame, backbuffer);
+  }
+
+  if (is_resized) {
+    present->window_width = window_width;
+    present->window_height = window_height;
+    x11_shm_clear_bars(present, x, y);
+  }
+  x11_shm_put(present, segment, is_full ? NULL : dirty, x, y);
+  segment->frame = frame;
+  present->last_shown = index;
+  present->stats.presented++;
+  de100_backbuffer_clear_dirty(backbuffer);
+
+  if (present->is_zero_copy) {
+    // The next frame draws into a segment the server is done with; if
+    // none comes back in time, into this one (may tear, never stale)
+    i32 next = x11_shm_acquire(present, timeout_seconds);
+    if (next < 0) {
+      next = index;
+    }
+    X11ShmSegment *next_segment = &present->segments[next];
+    if (next != index && backbuffer->dirty.is_tracking) {
+      x11_shm_repair(present, next_segment, segment->pixels, frame,
+                     backbuffer);
+    }
+    present->current = next;
+    backbuffer->memory.base = next_segment->pixels;
+  }
+  return true;
+}
+
+void x11_shm_present_repaint(i32 window_width, i32 window_height) {
+  X11ShmPresent *present = &g_x11_shm_present;
+  if (!present->is_active) {
+    return;
+  }
+
+  i32 x = (window_width - present->width) / 2;
+  i32 y = (window_height - present->height) / 2;
+  present->window_width = window_width;
+  present->window_height = window_height;
+  x11_shm_clear_bars(present, x, y);
+
+  if (!present->is_shared) {
+    if (present->put_last_pixels) {
+      present->put_image->data = (char *)present->put_last_pixels;
+      x11_shm_put(present, NULL, NULL, x, y);
+      present->put_image->data = NULL;
+    }
+    return;
+  }
+  if (present->last_shown >= 0) {
+    x11_shm_put(present, &present->segments[present->last_shown], NULL, x,
+                y);
+  }
+}
+
+bool x11_shm_present_handle_event(const XEvent *event) {
+  X11ShmPresent *present = &g_x11_shm_present;
+  if (!present->is_active || !present->is_shared ||
+      event->type != present->completion_type) {
+    return false;
+  }
+
+  const XShmCompletionEvent *completion =
+      (const XShmCompletionEvent *)event;
+  for (u32 i = 0; i < X11_SHM_SEGMENT_COUNT; ++i) {
+    X11ShmSegment *segment = &present->segments[i];
+    if (segment->info.shmseg != completion->shmseg || segment->pending == 0) {
+      continue;
+    }
+    segment->pending--;
+    X11ShmPresentStats *stats = &present->stats;
+    stats->completion_ms = x11_shm_ewma(
+        stats->completion_ms,
+        (f32)((de100_get_wall_clock() - segment->put_seconds) * 1000.0),
+        stats->presented);
+    break;
+  }
+  return true;
+}
+
+void x11_shm_present_shutdown(GameBackBuffer *backbuffer) {
+  X11ShmPresent *present = &g_x11_shm_present;
+  if (!present->is_active) {
+    return;
+  }
+
+  if (present->is_zero_copy) {
+    // Give the engine its own backbuffer block back before it frees it
+    backbuffer->memory.base = present->backbuffer_original_base;
+  }
+
+  if (present->is_shared) {
+    // Round-trip: every put has been read before the memory goes away
+    XSync(present->display, False);
+    for (u32 i = 0; i < X11_SHM_SEGMENT_COUNT; ++i) {
+      XShmDetach(present->display, &present->segments[i].info);
+      x11_shm_destroy_segment(&present->segments[i]);
+    }
+  } else if (present->put_image) {
+    present->put_image->data = NULL; // Never ours to free
+    XDestroyImage(present->put_image);
+  }
+  XFreeGC(present->display, present->gc);
+  *present = (X11ShmPresent){0};
+}
+
+bool x11_shm_present_is_active(void) { return g_x11_shm_present.is_active; }
+
+bool x11_shm_present_is_shared(void) {
+  return g_x11_shm_present.is_active && g_x11_shm_present.is_shared;
+}
+
+X11ShmPresentStats x11_shm_present_stats(void) {
+  return g_x11_shm_present.stats;
+}
@@ -0,0 +1,121 @@
+#ifndef DE100_X11_SHM_PRESENT_H
+#define DE100_X11_SHM_PRESENT_H
+
+#include "../../_common/base.h"
+#include "../../game/backbuffer.h"
+
+#include <X11/Xlib.h>
+#include <stdbool.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// MIT-SHM PRESENT (GameConfig.prefer_shm_present, or no usable GLX)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// Presents without OpenGL. X11_SHM_SEGMENT_COUNT backbuffer-sized SysV
+// shared memory segments are attached to the X server; XShmPutImage
+// then only sends a small request and the server reads the pixels
+// straight out of our memory (XPutImage would push every byte through
+// the socket):
+//
+//   game draws → copy dirty rects into a free segment (or none: zero-copy)
+//   → XShmPutImage per rect, the last with send_event → ShmCompletion
+//
+// A segment is busy from its put until the server's ShmCompletion event
+// for it: the server may still be reading it, so nothing writes there.
+// Those events are the pacing: the game never gets more than one frame
+// ahead of the server, and a slow server (or a huge window on a slow
+// machine) shows up as wait time instead of tearing.
+//
+// With GameConfig.prefer_mapped_backbuffer the GameBackBuffer points
+// straight at a segment (zero-copy, like Wayland's wl_shm). After each
+// present it moves to the other one, repaired from the newest frame with
+// the damage of the frames it missed, so the game still sees last
+// frame's pixels. Unlike mapped GL memory it is ordinary cached RAM:
+// reading it back is fine.
+//
+// No scaling: the backbuffer is centered at native size and the bars
+// are cleared to black. No vblank: frame_timing's sleep paces the loop.
+//
+// Without MIT-SHM (a remote display) or when attaching fails, frames go
+// through plain XPutImage from the engine's backbuffer: slow, but shown.
+//
+// The visual's channel masks must match DE100_PIXEL_FORMAT; no swizzle.
+// Usual 24-bit TrueColor visuals are BGRA8 (-DDE100_PIXEL_FORMAT=1).
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define X11_SHM_SEGMENT_COUNT 2
+#define X11_SHM_DAMAGE_HISTORY 4 // > X11_SHM_SEGMENT_COUNT
+#define X11_SHM_STATS_ALPHA 0.1f
+
+typedef enum {
+  X11_SHM_PRESENT_SUCCESS = 0,
+  X11_SHM_PRESENT_ERROR_NULL_ARGUMENT,
+  X11_SHM_PRESENT_ERROR_ALREADY_ACTIVE,
+  X11_SHM_PRESENT_ERROR_VISUAL_FORMAT, // Masks don't match the pixel format
+  X11_SHM_PRESENT_ERROR_IMAGE_FAILED,
+
+  X11_SHM_PRESENT_ERROR_COUNT
+} X11ShmPresentErrorCode;
+
+typedef struct {
+  bool success;
+  X11ShmPresentErrorCode error_code;
+} X11ShmPresentResult;
+
+typedef struct {
+  u64 presented;
+  u64 waits;   // Presents that had to wait for a ShmCompletion
+  u64 skipped; // No segment came back in time; frame not shown
+  // EWMA, ms
+  f32 completion_ms; // XShmPutImage to its ShmCompletion event
+  f32 wait_ms;       // Per wait
+} X11ShmPresentStats;
+
+/**
+ * Create the segments (or the XPutImage fallback) for `backbuffer` on
+ * `window`, whose visual/depth they must match. With `zero_copy` the
+ * backbuffer is pointed into the first segment.
+ */
+X11ShmPresentResult x11_shm_present_init(Display *display, Window window,
+                                         Visual *visual, int depth,
+                                         GameBackBuffer *backbuffer,
+                                         bool zero_copy);
+
+/**
+ * Show `backbuffer` (its dirty rects, or all of it) centered in a
+ * `window_width` × `window_height` window, and clear its dirty region.
+ * Waits at most `timeout_seconds` for a free segment; a frame that
+ * doesn't get one is skipped and its damage carried to the next.
+ *
+ * @return false if nothing was put
+ */
+bool x11_shm_present_frame(GameBackBuffer *backbuffer, i32 window_width,
+                           i32 window_height, f32 timeout_seconds);
+
+/** Show the last presented frame again (Expose) at the given size. */
+void x11_shm_present_repaint(i32 window_width, i32 window_height);
+
+/**
+ * Consume `event` if it is this presenter's ShmCompletion.
+ *
+ * @return true if it was (nothing else should look at it)
+ */
+bool x11_shm_present_handle_event(const XEvent *event);
+
+/**
+ * Detach and free the segments. Zero-copy: the backbuffer gets its own
+ * memory back first, so call this before the engine frees it.
+ */
+void x11_shm_present_shutdown(GameBackBuffer *backbuffer);
+
+bool x11_shm_present_is_active(void);
+
+/** True when frames really go through shared memory (not XPutImage). */
+bool x11_shm_present_is_shared(void);
+
+X11ShmPresentStats x11_shm_present_stats(void);
+
+const char *x11_shm_present_strerror(X11ShmPresentErrorCode code);
+
+#endif // DE100_X11_SHM_PRESENT_H
@@ -0,0 +1,369 @@
+// ═══════════════════════════════════════════════════════════════════════════
+// 📦 ASSET PACKER (.de100pak builder)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// Build-time tool: decodes, converts and lays out assets so the runtime
+// (game/asset-pack.h) only maps the file and hands out pointers.
+//
+//   cc -O2 -o build/asset-packer engine/tools/asset-packer.c
+//   build/asset-packer data/assets.de100pak hero=art/hero.bmp
+//                      music=audio/theme.wav level1=levels/1.bin
+//
+// Each input is `name=path` (or just `path`, named by itself). The asset
+// id is de100_asset_id(name).
+//
+//   .bmp          → BITMAP (24/32-bit, uncompressed or BI_BITFIELDS)
+//   .png .jpg ... → BITMAP when built with -DDE100_ASSET_PACKER_STB_IMAGE
+//                   and stb_image.h on the include path
+//   anything else → RAW (bytes copied as-is, 64-byte aligned)
+//
+// Bitmaps are stored top-down in the backbuffer's byte order, alpha
+// premultiplied, rows padded to DE100_PAK_ROW_ALIGNMENT. Build the packer
+// with the game's DE100_PIXEL_FORMAT (backbuffer.h): R,G,B,A by default,
+// B,G,R,A with -DDE100_PIXEL_FORMAT=1.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#include "../game/asset-pack.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(DE100_ASSET_PACKER_STB_IMAGE)
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
+#endif
+
+typedef struct {
+  const char *name;
+  const char *path;
+  De100PakEntry entry;
+  u8 *data; // Converted payload (malloc)
+} PackerAsset;
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Helpers
+// ─────────────────────────────────────────────────────────────────────────────
+
+static u64 align_up(u64 value, u64 alignment) {
+  return (value + alignment - 1) & ~(alignment - 1);
+}
+
+static u8 *read_file(const char *path, u64 *out_size) {
+  FILE *file = fopen(path, "rb");
+  if (!file) {
+    return NULL;
+  }
+  fseek(file, 0, SEEK_END);
+  long size = ftell(file);
+  fseek(file, 0, SEEK_SET);
+  u8 *data = size >= 0 ? malloc((size_t)size + 1) : NULL;
+  if (data && fread(data, 1, (size_t)size, file) != (size_t)size) {
+    free(data);
+    data = NULL;
+  }
+  fclose(file);
+  *out_size = data ? (u64)size : 0;
+  return data;
+}
+
+static u32 read_u32(const u8 *p) {
+  return (u32)p[0] | ((u32)p[1] << 8) | ((u32)p[2] << 16) | ((u32)p[3] << 24);
+}
+
+static u16 read_u16(const u8 *p) { return (u16)(p[0] | (p[1] << 8)); }
+
+static bool has_extension(const char *path, const char *ext) {
+  size_t path_length = strlen(path);
+  size_t ext_length = strlen(ext);
+  if (path_length < ext_length) {
+    return false;
+  }
+  const char *tail = path + path_length - ext_length;
+  for (size_t i = 0; i < ext_length; ++i) {
+    char c = tail[i];
+    if (c >= 'A' && c <= 'Z') {
+      c = (char)(c - 'A' + 'a');
+    }
+    if (c != ext[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Channel value under `mask`, scaled to 0..255
+static u8 extract_channel(u32 pixel, u32 mask) {
+  if (!mask) {
+    return 0;
+  }
+  u32 shift = 0;
+  while (!((mask >> shift) & 1)) {
+    shift++;
+  }
+  u32 max = mask >> shift;
+  return (u8)((((pixel & mask) >> shift) * 255 + max / 2) / max);
+}
+
+// RGBA8 (straight) → padded, premultiplied, DE100_PIXEL_FORMAT payload
+static bool store_bitmap(PackerAsset *asset, const u8 *rgba, u32 width,
+                         u32 height) {
+  u32 pitch = (u32)align_up((u64)width * 4, DE100_PAK_ROW_ALIGNMENT);
+  asset->data = calloc(1, (size_t)pitch * height + 1);
+  if (!asset->data) {
+    return false;
+  }
+  for (u32 y = 0; y < height; ++y) {
+    const u8 *src = rgba + (size_t)y * width * 4;
+    u8 *dst = asset->data + (size_t)y * pitch;
+    for (u32 x = 0; x < width; ++x) {
+      const u8 *s = src + x * 4;
+      u8 *d = dst + x * 4;
+      u32 a = s[3];
+      d[DE100_PIXEL_BYTE_RED] = (u8)((s[0] * a + 127) / 255);
+      d[DE100_PIXEL_BYTE_GREEN] = (u8)((s[1] * a + 127) / 255);
+      d[DE100_PIXEL_BYTE_BLUE] = (u8)((s[2] * a + 127) / 255);
+      d[DE100_PIXEL_BYTE_ALPHA] = (u8)a;
+    }
+  }
+  asset->entry.type = DE100_PAK_ASSET_BITMAP_NATIVE;
+  asset->entry.width = width;
+  asset->entry.height = height;
+  asset->entry.pitch = pitch;
+  asset->entry.size = (u64)pitch * height;
+  return true;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Decoders
+// ─────────────────────────────────────────────────────────────────────────────
+
+static bool load_bmp(PackerAsset *asset, const u8 *file, u64 size) {
+  if (size < 54 || file[0] != 'B' || file[1] != 'M') {
+    return false;
+  }
+  u32 pixel_offset = read_u32(file + 10);
+  u32 info_size = read_u32(file + 14);
+  i32 width = (i32)read_u32(file + 18);
+  i32 height = (i32)read_u32(file + 22);
+  u16 bits = read_u16(file + 28);
+  u32 compression = read_u32(file + 30);
+
+  bool top_down = height < 0;
+  if (top_down) {
+    height = -height;
+  }
+  if (width <= 0 || height <= 0 || (bits != 24 && bits != 32) ||
+      (compression != 0 && compression != 3)) {
+    fprintf(stderr, "❌ %s: only 24/32-bit uncompressed BMP supported\n",
+            asset->path);
+    return false;
+  }
+
+  u32 red_mask = 0x00FF0000, green_mask = 0x0000FF00, blue_mask = 0x000000FF;
+  u32 alpha_mask = 0;
+  if (compression == 3 && size >= 66) {
+    red_mask = read_u32(file + 54);
+    green_mask = read_u32(file + 58);
+    blue_mask = read_u32(file + 62);
+    alpha_mask = info_size >= 56 && size >= 70 ? read_u32(file + 66) : 0;
+  }
+
+  u32 bytes_per_pixel = bits / 8;
+  u64 row_size = align_up((u64)width * bytes_per_pixel, 4);
+  if ((u64)pixel_offset + row_size * (u64)height > size) {
+    fprintf(stderr, "❌ %s: truncated BMP\n", asset->path);
+    return false;
+  }
+
+  u8 *rgba = malloc((size_t)width * (size_t)height * 4);
+  if (!rgba) {
+    return false;
+  }
+
+  // 32-bit BI_RGB: the 4th byte is alpha only if anything uses it
+  bool implicit_alpha = bits == 32 && compression == 0;
+  bool any_alpha = false;
+
+  for (i32 y = 0; y < height; ++y) {
+    i32 source_row = top_down ? y : height - 1 - y;
+    const u8 *src = file + pixel_offset + (u64)source_row * row_size;
+    u8 *dst = rgba + (size_t)y * (size_t)width * 4;
+    for (i32 x = 0; x < width; ++x) {
+      const u8 *p = src + (size_t)x * bytes_per_pixel;
+      if (bits == 24 || implicit_alpha) {
+        dst[x * 4 + 0] = p[2];
+        dst[x * 4 + 1] = p[1];
+        dst[x * 4 + 2] = p[0];
+        dst[x * 4 + 3] = bits == 32 ? p[3] : 255;
+        any_alpha |= bits == 32 && p[3] != 0;
+      } else {
+        u32 pixel = read_u32(p);
+        dst[x * 4 + 0] = extract_channel(pixel, red_mask);
+        dst[x * 4 + 1] = extract_channel(pixel, green_mask);
+        dst[x * 4 + 2] = extract_channel(pixel, blue_mask);
+        dst[x * 4 + 3] = alpha_mask ? extract_channel(pixel, alpha_mask) : 255;
+      }
+    }
+  }
+
+  if (implicit_alpha && !any_alpha) {
+    for (size_t i = 0; i < (size_t)width * (size_t)height; ++i) {
+      rgba[i * 4 + 3] = 255;
+    }
+  }
+
+  bool ok = store_bitmap(asset, rgba, (u32)width, (u32)height);
+  free(rgba);
+  return ok;
+}
+
+static bool load_asset(PackerAsset *asset) {
+  u64 size = 0;
+  u8 *file = read_file(asset->path, &size);
+  if (!file) {
+    fprintf(stderr, "❌ Can't read %s\n", asset->path);
+    return false;
+  }
+
+  bool ok;
+  if (has_extension(asset->path, ".bmp")) {
+    ok = load_bmp(asset, file, size);
+    free(file);
+#if defined(DE100_ASSET_PACKER_STB_IMAGE)
+  } else if (has_extension(asset->path, ".png") ||
+             has_extension(asset->path, ".jpg") ||
+             has_extension(asset->path, ".jpeg") ||
+             has_extension(asset->path, ".tga")) {
+    int width, height, channels;
+    u8 *rgba = stbi_load_from_memory(file, (int)size, &width, &height,
+                                     &channels, 4);
+    free(file);
+    ok = rgba && store_bitmap(asset, rgba, (u32)width, (u32)height);
+    if (!rgba) {
+      fprintf(stderr, "❌ %s: %s\n", asset->path, stbi_failure_reason());
+    }
+    stbi_image_free(rgba);
+#endif
+  } else {
+    asset->entry.type = DE100_PAK_ASSET_RAW;
+    asset->entry.size = size;
+    asset->data = file;
+    ok = true;
+  }
+  return ok;
+}
+
+static int compare_assets(const void *a, const void *b) {
+  u32 id_a = ((const PackerAsset *)a)->entry.id;
+  u32 id_b = ((const PackerAsset *)b)->entry.id;
+  return id_a < id_b ? -1 : id_a > id_b;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Main
+// ─────────────────────────────────────────────────────────────────────────────
+
+int main(int argc, char **argv) {
+  if (argc < 3) {
+    fprintf(stderr, "Usage: %s out.de100pak [name=]path ...\n", argv[0]);
+    return 1;
+  }
+
+  u32 asset_count = (u32)(argc - 2);
+  PackerAsset *assets = calloc(asset_count, sizeof(PackerAsset));
+  if (!assets) {
+    return 1;
+  }
+
+  u64 names_size = 0;
+  for (u32 i = 0; i < asset_count; ++i) {
+    char *arg = argv[i + 2];
+    char *equals = strchr(arg, '=');
+    if (equals) {
+      *equals = '\0';
+      assets[i].name = arg;
+      assets[i].path = equals + 1;
+    } else {
+      assets[i].name = arg;
+      assets[i].path = arg;
+    }
+    assets[i].entry.id = de100_asset_id(assets[i].name);
+    if (!load_asset(&assets[i])) {
+      return 1;
+    }
+    names_size += strlen(assets[i].name) + 1;
+  }
+
+  qsort(assets, asset_count, sizeof(PackerAsset), compare_assets);
+  for (u32 i = 1; i < asset_count; ++i) {
+    if (assets[i].entry.id == assets[i - 1].entry.id) {
+      fprintf(stderr, "❌ Id collision: '%s' and '%s' (rename one)\n",
+              assets[i - 1].name, assets[i].name);
+      return 1;
+    }
+  }
+
+  // Layout: header | toc | names | aligned blobs
+  De100PakHeader header = {0};
+  header.magic = DE100_PAK_MAGIC;
+  header.version = DE100_PAK_VERSION;
+  header.header_size = sizeof(De100PakHeader);
+  header.asset_count = asset_count;
+  header.toc_offset = (u32)align_up(sizeof(De100PakHeader), 8);
+  header.names_offset =
+      header.toc_offset + asset_count * (u32)sizeof(De100PakEntry);
+  header.names_size = (u32)names_size;
+
+  u64 cursor = header.names_offset + names_size;
+  u32 name_cursor = 0;
+  for (u32 i = 0; i < asset_count; ++i) {
+    cursor = align_up(cursor, DE100_PAK_ALIGNMENT);
+    assets[i].entry.offset = cursor;
+    assets[i].entry.name_offset = name_cursor;
+    cursor += assets[i].entry.size;
+    name_cursor += (u32)strlen(assets[i].name) + 1;
+  }
+  header.file_size = cursor;
+
+  FILE *out = fopen(argv[1], "wb");
+  if (!out) {
+    fprintf(stderr, "❌ Can't write %s\n", argv[1]);
+    return 1;
+  }
+
+  static const u8 zeros[DE100_PAK_ALIGNMENT] = {0};
+  u64 written = 0;
+  fwrite(&header, sizeof(header), 1, out);
+  written += sizeof(header);
+  fwrite(zeros, 1, header.toc_offset - written, out);
+  written = header.toc_offset;
+  for (u32 i = 0; i < asset_count; ++i) {
+    fwrite(&assets[i].entry, sizeof(De100PakEntry), 1, out);
+  }
+  for (u32 i = 0; i < asset_count; ++i) {
+    fwrite(assets[i].name, 1, strlen(assets[i].name) + 1, out);
+  }
+  written = header.names_offset + names_size;
+  for (u32 i = 0; i < asset_count; ++i) {
+    fwrite(zeros, 1, assets[i].entry.offset - written, out);
+    fwrite(assets[i].data, 1, assets[i].entry.size, out);
+    written = assets[i].entry.offset + assets[i].entry.size;
+    printf("   %-24s %08x %s %llu bytes\n", assets[i].name, assets[i].entry.id,
+           assets[i].entry.type == DE100_PAK_ASSET_RAW ? "raw" : "bitmap",
+           (unsigned long long)assets[i].entry.size);
+    free(assets[i].data);
+  }
+
+  bool ok = ferror(out) == 0;
+  ok &= fclose(out) == 0;
+  free(assets);
+  if (!ok) {
+    fprintf(stderr, "❌ Write failed: %s\n", argv[1]);
+    return 1;
+  }
+  printf("✅ %s: %u assets, %llu bytes\n", argv[1], asset_count,
+         (unsigned long long)header.file_size);
+  return 0;
+}
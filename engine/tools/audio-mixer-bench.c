@@ -0,0 +1,218 @@
+// ═══════════════════════════════════════════════════════════════════════════
+// 🎚️ AUDIO MIXER BENCHMARK (engine voice mixer, no game, no device)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// Times the engine's mixing paths on synthetic voice loads, so mixer work
+// can be measured (and regressions caught) without running a game:
+//
+//   cc -O2 -o build/audio-mixer-bench engine/tools/audio-mixer-bench.c
+//      engine/game/audio-bus.c -lm
+//   build/audio-mixer-bench [seconds_of_audio] [seed]
+//
+// For each load (1, 16, 64, 256 concurrent voices at 48kHz, random
+// waveform / pitch / pan, long enough to never end mid-run) and each path:
+//
+//   player     de100_sound_player_mix() → i16 (naive oscillators)
+//   wavetable  same, band-limited wavetables
+//   buses      player into the SFX bus, low-pass + reverb send + master
+//              limiter (audio-bus.h) → i16
+//
+// it renders `seconds_of_audio` in game-sized calls (800 frames, a 60Hz
+// frame) and prints:
+//
+//   ns/sample      wall time per output frame (stereo pair)
+//   x realtime     audio seconds rendered per wall second
+//   voices/core    voices one core could mix in real time at this load
+//                  (voices × realtime factor; falls as per-voice cost
+//                  stops amortising the fixed per-block work)
+//   checksum       sum of the output; same seed ⇒ same value, so it
+//                  doubles as a check that an optimisation didn't change
+//                  the result (kernels round identically, see
+//                  audio-mix-kernels.h)
+//
+// Build with -DDE100_AUDIO_MIX_FORCE_SCALAR to time the reference kernels.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+// Room for the heaviest load; the player's voice array is sized from this
+#define DE100_MAX_SOUND_INSTANCES 256
+
+#include "../game/audio-bus.h"
+#include "../game/audio-helpers.h"
+#include "../game/memory-arena.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_SAMPLE_RATE 48000
+#define BENCH_CALL_FRAMES 800
+
+typedef enum {
+  BENCH_PATH_PLAYER = 0,
+  BENCH_PATH_WAVETABLE,
+  BENCH_PATH_BUSES,
+
+  BENCH_PATH_COUNT
+} BenchPath;
+
+static const char *bench_path_names[BENCH_PATH_COUNT] = {
+    "player",
+    "wavetable",
+    "buses",
+};
+
+static const i32 bench_voice_counts[] = {1, 16, 64, 256};
+
+static u32 bench_rand(u32 *state) {
+  // xorshift32, reproducible across libcs
+  u32 x = *state;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  return *state = x;
+}
+
+static f32 bench_rand_unit(u32 *state) {
+  return (f32)(bench_rand(state) >> 8) / (f32)(1u << 24);
+}
+
+static f64 bench_seconds(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (f64)ts.tv_sec + (f64)ts.tv_nsec * 1e-9;
+}
+
+static void bench_start_voices(De100SoundPlayer *player, i32 voices,
+                               u32 seed) {
+  memset(player->instances, 0, sizeof(player->instances));
+  player->volume = 1.0f;
+  player->max_mixed_voices = 0; // Mix every voice: that's what we're timing
+
+  for (i32 i = 0; i < voices; ++i) {
+    De100SoundInstance *inst = de100_sound_player_start(
+        player, DE100_SOUND_PRIORITY_NORMAL);
+    inst->sound_id = i + 1;
+    inst->phase = bench_rand_unit(&seed);
+    // 110Hz..1760Hz, four octaves above A2
+    inst->frequency = 110.0f * powf(2.0f, 4.0f * bench_rand_unit(&seed));
+    inst->frequency_slide = 0.0f;
+    // Sum stays near full scale whatever the load
+    inst->volume = 0.5f / (f32)voices + 0.5f / (f32)voices *
+                                            bench_rand_unit(&seed);
+    inst->pan_position = bench_rand_unit(&seed) * 2.0f - 1.0f;
+    inst->samples_remaining = 1 << 30;
+    inst->total_samples = inst->samples_remaining;
+    inst->fade_in_samples = 96;
+    inst->fade_out_samples = 0;
+    inst->waveform = (i32)(bench_rand(&seed) % DE100_AUDIO_WAVE_PULSE);
+  }
+}
+
+static void bench_render(BenchPath path, De100SoundPlayer *player,
+                         De100AudioMixer *mixer,
+                         GameAudioOutputBuffer *buffer) {
+  if (path != BENCH_PATH_BUSES) {
+    de100_sound_player_mix(player, (i16 *)buffer->samples,
+                           buffer->sample_count, buffer->samples_per_second);
+    return;
+  }
+
+  for (i32 start = 0; start < buffer->sample_count;) {
+    i32 count = de100_audio_mixer_begin_block(mixer, buffer, start);
+    De100AudioBus *sfx = &mixer->buses[DE100_AUDIO_BUS_SFX];
+    de100_sound_player_mix_block(player, sfx->left, sfx->right, count,
+                                 buffer->samples_per_second, player->volume);
+    de100_audio_mixer_end_block(mixer, buffer, start, count);
+    start += count;
+  }
+}
+
+int main(int argc, char **argv) {
+  f64 audio_seconds = argc > 1 ? atof(argv[1]) : 10.0;
+  u32 seed = argc > 2 ? (u32)strtoul(argv[2], NULL, 10) : 1;
+  if (seed == 0) {
+    seed = 1; // xorshift's only fixed point
+  }
+  if (audio_seconds <= 0.0) {
+    audio_seconds = 10.0;
+  }
+
+  i64 total_frames = (i64)(audio_seconds * BENCH_SAMPLE_RATE);
+  i16 *samples = (i16 *)malloc(sizeof(i16) * 2 * BENCH_CALL_FRAMES);
+  De100Wavetables *wavetables =
+      (De100Wavetables *)malloc(sizeof(De100Wavetables));
+  De100SoundPlayer *player =
+      (De100SoundPlayer *)calloc(1, sizeof(De100SoundPlayer));
+  De100AudioMixer *mixer = (De100AudioMixer *)malloc(sizeof(De100AudioMixer));
+  u64 arena_size = 4u * 1024u * 1024u;
+  void *arena_memory = malloc(arena_size);
+  if (!samples || !wavetables || !player || !mixer || !arena_memory) {
+    fprintf(stderr, "❌ Out of memory\n");
+    return 1;
+  }
+  de100_wavetables_init(wavetables, BENCH_SAMPLE_RATE);
+
+  printf("kernels %s, %.1f s of audio per case, %d-frame calls, seed %u\n\n",
+         de100_audio_mix_kernels_get()->name, audio_seconds,
+         BENCH_CALL_FRAMES, seed);
+  printf("%-10s %6s %12s %12s %12s %14s\n", "path", "voices", "ns/sample",
+         "x realtime", "voices/core", "checksum");
+
+  i32 load_count =
+      (i32)(sizeof(bench_voice_counts) / sizeof(bench_voice_counts[0]));
+  for (i32 path = 0; path < BENCH_PATH_COUNT; ++path) {
+    for (i32 load = 0; load < load_count; ++load) {
+      i32 voices = bench_voice_counts[load];
+
+      bench_start_voices(player, voices, seed);
+      player->wavetables =
+          path == BENCH_PATH_WAVETABLE ? wavetables : NULL;
+
+      De100MemoryArena arena;
+      de100_arena_init(&arena, arena_size, arena_memory);
+      de100_audio_mixer_init(mixer, &arena, BENCH_SAMPLE_RATE);
+      mixer->buses[DE100_AUDIO_BUS_SFX].lowpass_hz = 8000.0f;
+      mixer->buses[DE100_AUDIO_BUS_SFX].reverb_send = 0.2f;
+
+      GameAudioOutputBuffer buffer = {
+          .samples_per_second = BENCH_SAMPLE_RATE,
+          .max_sample_count = BENCH_CALL_FRAMES,
+          .samples = samples,
+          .is_initialized = true,
+      };
+
+      i64 checksum = 0;
+      f64 start = bench_seconds();
+      for (i64 done = 0; done < total_frames;) {
+        i64 left = total_frames - done;
+        buffer.sample_count =
+            (i32)(left < BENCH_CALL_FRAMES ? left : BENCH_CALL_FRAMES);
+        bench_render((BenchPath)path, player, mixer, &buffer);
+        for (i32 i = 0; i < buffer.sample_count * 2; ++i) {
+          checksum += samples[i];
+        }
+        buffer.running_sample_index += (u64)buffer.sample_count;
+        done += buffer.sample_count;
+      }
+      f64 elapsed = bench_seconds() - start;
+      if (elapsed <= 0.0) {
+        elapsed = 1e-9;
+      }
+
+      f64 realtime = audio_seconds / elapsed;
+      printf("%-10s %6d %12.2f %12.1f %12.0f %14lld\n",
+             bench_path_names[path], voices,
+             elapsed * 1e9 / (f64)total_frames, realtime,
+             (f64)voices * realtime, (long long)checksum);
+    }
+  }
+
+  free(arena_memory);
+  free(mixer);
+  free(player);
+  free(wavetables);
+  free(samples);
+  return 0;
+}
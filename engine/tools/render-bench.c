@@ -0,0 +1,422 @@
+// ═══════════════════════════════════════════════════════════════════════════
+// 🖌️ RENDER BENCHMARK (engine draw primitives, no game, no window)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// Times the software rasterizer's primitives on synthetic scenes, so
+// renderer work can be measured (and regressions caught) without running
+// a game:
+//
+//   cc -O2 -o build/render-bench engine/tools/render-bench.c -lm
+//   build/render-bench [frames] [seed]
+//
+// For each backbuffer size (320x240 .. 3840x2160), each overdraw level
+// (every pixel covered 1x / 4x on average) and each primitive:
+//
+//   rect        de100_render_fill_clipped (fill_row kernel)
+//   rect_blend  de100_render_blend_clipped, alpha 128 (blend_row kernel)
+//   rect_linear de100_render_blend_linear_clipped, alpha 128 (linear light)
+//   sprite      64x64 premultiplied blits, soft-edged disc (de100_sprite_*)
+//   sprite_span same sprite with a span table (de100_sprite_build_spans)
+//   alpha_test  same sprite, DE100_SPRITE_BLIT_ALPHA_TEST (1-bit mask)
+//   indexed     64x64 paletted tiles, ~1/4 of indices set (grain fields;
+//               de100_indexed_blit_clipped)
+//   wireframe   de100_raster_line, 1px outlines (vector-ship style)
+//   line_aa     de100_raster_line_aa (Wu lines, two pixels per step)
+//   polygon     de100_raster_polygon, convex hexagons
+//
+// it draws `frames` frames of the same scene and prints, from the fastest
+// frame (the least disturbed by the OS, so the most repeatable):
+//
+//   Mpix/s        pixels touched per second, in millions
+//   cycles/px     __rdtsc ticks per pixel (TSC rate, not core clock:
+//                 compare runs on the same machine only)
+//   checksum      FNV-1a of the frame; same seed ⇒ same value, so it
+//                 doubles as a check that an optimisation didn't change
+//                 the output (every kernel variant is bit-identical, see
+//                 pixel-kernels.h)
+//
+// "Pixels touched" is what each primitive nominally covers: the rect/
+// sprite area, max(|dx|, |dy|) + 1 per line (twice that for line_aa) and
+// the polygon area. Scenes are built so it adds up to overdraw × buffer.
+//
+// Build with -DDE100_PIXEL_KERNELS_FORCE_SCALAR to time the reference
+// kernels.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#include "../game/memory-arena.h"
+#include "../game/raster.h"
+#include "../game/render-group.h"
+#include "../game/sprite.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h> // __rdtsc()
+#endif
+
+#define BENCH_SPRITE_SIZE 64
+#define BENCH_LINE_LENGTH 48
+#define BENCH_POLYGON_RADIUS 24
+
+typedef enum {
+  BENCH_PRIM_RECT = 0,
+  BENCH_PRIM_RECT_BLEND,
+  BENCH_PRIM_RECT_LINEAR,
+  BENCH_PRIM_SPRITE,
+  BENCH_PRIM_SPRITE_SPANS,
+  BENCH_PRIM_ALPHA_TEST,
+  BENCH_PRIM_INDEXED,
+  BENCH_PRIM_WIREFRAME,
+  BENCH_PRIM_LINE_AA,
+  BENCH_PRIM_POLYGON,
+
+  BENCH_PRIM_COUNT
+} BenchPrimitive;
+
+static const char *bench_prim_names[BENCH_PRIM_COUNT] = {
+    "rect",      "rect_blend", "rect_linear", "sprite",  "sprite_span",
+    "alpha_test", "indexed",   "wireframe",   "line_aa", "polygon",
+};
+
+typedef struct {
+  i32 width, height;
+} BenchSize;
+
+static const BenchSize bench_sizes[] = {
+    {320, 240}, {640, 480}, {1280, 720}, {1920, 1080}, {3840, 2160},
+};
+
+static const i32 bench_overdraws[] = {1, 4};
+
+// One primitive instance; lines use (x, y) → (x1, y1)
+typedef struct {
+  i32 x, y;
+  i32 x1, y1;
+  u32 color;
+} BenchItem;
+
+static u32 bench_rand(u32 *state) {
+  // xorshift32, reproducible across libcs
+  u32 x = *state;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  return *state = x;
+}
+
+static f64 bench_seconds(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (f64)ts.tv_sec + (f64)ts.tv_nsec * 1e-9;
+}
+
+static u64 bench_cycles(void) {
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#elif defined(__clang__)
+  return __builtin_readcyclecounter();
+#else
+  return 0; // cycles/px reads 0: no counter on this target
+#endif
+}
+
+static u32 bench_checksum(GameBackBuffer *buffer) {
+  // FNV-1a over the visible pixels (pitch padding excluded)
+  u32 hash = 2166136261u;
+  for (i32 y = 0; y < buffer->height; ++y) {
+    const u8 *row =
+        (const u8 *)buffer->memory.base + (size_t)y * (size_t)buffer->pitch;
+    for (i32 i = 0; i < buffer->width * 4; ++i) {
+      hash = (hash ^ row[i]) * 16777619u;
+    }
+  }
+  return hash;
+}
+
+// Soft-edged disc, premultiplied: an opaque core, a blended rim and
+// transparent corners, like most game sprites
+static void bench_make_sprite(u32 *pixels) {
+  f32 centre = (f32)BENCH_SPRITE_SIZE * 0.5f;
+  for (i32 y = 0; y < BENCH_SPRITE_SIZE; ++y) {
+    for (i32 x = 0; x < BENCH_SPRITE_SIZE; ++x) {
+      f32 dx = (f32)x + 0.5f - centre;
+      f32 dy = (f32)y + 0.5f - centre;
+      f32 edge = (centre - sqrtf(dx * dx + dy * dy)) / 4.0f;
+      f32 alpha = edge < 0.0f ? 0.0f : edge > 1.0f ? 1.0f : edge;
+      u32 a = (u32)(alpha * 255.0f + 0.5f);
+      pixels[y * BENCH_SPRITE_SIZE + x] =
+          DE100_PIXEL_PACK(a * 230 / 255, a * (x * 4) / 255,
+                           a * (y * 4) / 255, a);
+    }
+  }
+}
+
+// Scattered grains: roughly one index in four set, in short runs
+static void bench_make_indexed(u8 *indices, u32 seed) {
+  for (i32 i = 0; i < BENCH_SPRITE_SIZE * BENCH_SPRITE_SIZE;) {
+    i32 run = 1 + (i32)(bench_rand(&seed) % 6);
+    u8 value = bench_rand(&seed) % 4 == 0 ? (u8)(1 + bench_rand(&seed) % 255)
+                                          : 0;
+    for (; run > 0 && i < BENCH_SPRITE_SIZE * BENCH_SPRITE_SIZE; --run) {
+      indices[i++] = value;
+    }
+  }
+}
+
+// Nominal pixels for one item (see the header)
+static i64 bench_item_pixels(BenchPrimitive prim, const BenchItem *item,
+                             i32 rect_w, i32 rect_h) {
+  switch (prim) {
+  case BENCH_PRIM_RECT:
+  case BENCH_PRIM_RECT_BLEND:
+  case BENCH_PRIM_RECT_LINEAR:
+    return (i64)rect_w * rect_h;
+  case BENCH_PRIM_SPRITE:
+  case BENCH_PRIM_SPRITE_SPANS:
+  case BENCH_PRIM_ALPHA_TEST:
+  case BENCH_PRIM_INDEXED:
+    return (i64)BENCH_SPRITE_SIZE * BENCH_SPRITE_SIZE;
+  case BENCH_PRIM_WIREFRAME:
+  case BENCH_PRIM_LINE_AA: {
+    i32 dx = abs_i32(item->x1 - item->x);
+    i32 dy = abs_i32(item->y1 - item->y);
+    i64 steps = (i64)(dx > dy ? dx : dy) + 1;
+    return prim == BENCH_PRIM_LINE_AA ? steps * 2 : steps;
+  }
+  case BENCH_PRIM_POLYGON:
+    // Regular hexagon: (3√3 / 2) r²
+    return (i64)(2.598076f * BENCH_POLYGON_RADIUS * BENCH_POLYGON_RADIUS);
+  default:
+    return 0;
+  }
+}
+
+/**
+ * Fill `items` until they nominally cover overdraw × buffer pixels.
+ * Everything lands inside the buffer so no work is clipped away.
+ */
+static i32 bench_build_scene(BenchPrimitive prim, i32 width, i32 height,
+                             i32 overdraw, u32 seed, BenchItem *items,
+                             i32 max_items, i64 *out_pixels) {
+  i32 rect_w = width / 8;
+  i32 rect_h = height / 8;
+  i32 margin = BENCH_SPRITE_SIZE > BENCH_LINE_LENGTH ? BENCH_SPRITE_SIZE
+                                                     : BENCH_LINE_LENGTH;
+  i64 target = (i64)width * height * overdraw;
+  i64 pixels = 0;
+  i32 count = 0;
+
+  while (pixels < target && count < max_items) {
+    BenchItem *item = &items[count];
+    item->color = DE100_PIXEL_PACK(bench_rand(&seed) & 0xFF,
+                                   bench_rand(&seed) & 0xFF,
+                                   bench_rand(&seed) & 0xFF,
+                                   prim == BENCH_PRIM_RECT_BLEND ||
+                                           prim == BENCH_PRIM_RECT_LINEAR
+                                       ? 128
+                                       : 255);
+    if (prim == BENCH_PRIM_RECT || prim == BENCH_PRIM_RECT_BLEND ||
+        prim == BENCH_PRIM_RECT_LINEAR) {
+      item->x = (i32)(bench_rand(&seed) % (u32)(width - rect_w + 1));
+      item->y = (i32)(bench_rand(&seed) % (u32)(height - rect_h + 1));
+    } else {
+      item->x = margin + (i32)(bench_rand(&seed) % (u32)(width - 2 * margin));
+      item->y =
+          margin + (i32)(bench_rand(&seed) % (u32)(height - 2 * margin));
+    }
+    // Line end: any direction, so every octant is exercised
+    u32 reach = 2 * BENCH_LINE_LENGTH + 1;
+    item->x1 = item->x + (i32)(bench_rand(&seed) % reach) - BENCH_LINE_LENGTH;
+    item->y1 = item->y + (i32)(bench_rand(&seed) % reach) - BENCH_LINE_LENGTH;
+
+    pixels += bench_item_pixels(prim, item, rect_w, rect_h);
+    count++;
+  }
+
+  *out_pixels = pixels;
+  return count;
+}
+
+static void bench_draw(BenchPrimitive prim, GameBackBuffer *buffer,
+                       const BenchItem *items, i32 count,
+                       const De100Sprite *sprite,
+                       const De100Sprite *sprite_spans,
+                       const De100IndexedImage *indexed, const u32 *palette) {
+  De100RenderClipRect clip = de100_raster_buffer_clip(buffer);
+  i32 rect_w = buffer->width / 8;
+  i32 rect_h = buffer->height / 8;
+
+  for (i32 i = 0; i < count; ++i) {
+    const BenchItem *item = &items[i];
+    switch (prim) {
+    case BENCH_PRIM_RECT:
+      de100_render_fill_clipped(buffer, clip, item->x, item->y, rect_w,
+                                rect_h, item->color);
+      break;
+    case BENCH_PRIM_RECT_BLEND:
+      de100_render_blend_clipped(buffer, clip, item->x, item->y, rect_w,
+                                 rect_h, item->color);
+      break;
+    case BENCH_PRIM_RECT_LINEAR:
+      de100_render_blend_linear_clipped(buffer, clip, item->x, item->y,
+                                        rect_w, rect_h, item->color);
+      break;
+    case BENCH_PRIM_SPRITE:
+      de100_sprite_blit_clipped(buffer, clip, sprite, item->x, item->y,
+                                DE100_SPRITE_BLIT_PREMULTIPLIED);
+      break;
+    case BENCH_PRIM_SPRITE_SPANS:
+      de100_sprite_blit_clipped(buffer, clip, sprite_spans, item->x, item->y,
+                                DE100_SPRITE_BLIT_PREMULTIPLIED);
+      break;
+    case BENCH_PRIM_ALPHA_TEST:
+      de100_sprite_blit_clipped(buffer, clip, sprite, item->x, item->y,
+                                DE100_SPRITE_BLIT_ALPHA_TEST);
+      break;
+    case BENCH_PRIM_INDEXED:
+      de100_indexed_blit_clipped(buffer, clip, indexed, palette, item->x,
+                                 item->y);
+      break;
+    case BENCH_PRIM_WIREFRAME:
+      de100_raster_line_clipped(buffer, clip, item->x, item->y, item->x1,
+                                item->y1, item->color);
+      break;
+    case BENCH_PRIM_LINE_AA:
+      de100_raster_line_aa_clipped(buffer, clip, (f32)item->x + 0.25f,
+                                   (f32)item->y + 0.5f, (f32)item->x1,
+                                   (f32)item->y1 + 0.75f, item->color);
+      break;
+    case BENCH_PRIM_POLYGON: {
+      De100RasterPoint points[6];
+      for (i32 p = 0; p < 6; ++p) {
+        f32 angle = (f32)p * (2.0f * (f32)M_PI / 6.0f);
+        points[p].x = (f32)item->x + BENCH_POLYGON_RADIUS * cosf(angle);
+        points[p].y = (f32)item->y + BENCH_POLYGON_RADIUS * sinf(angle);
+      }
+      de100_raster_polygon_clipped(buffer, clip, points, 6, item->color);
+    } break;
+    default:
+      break;
+    }
+  }
+}
+
+int main(int argc, char **argv) {
+  i32 frames = argc > 1 ? atoi(argv[1]) : 10;
+  u32 seed = argc > 2 ? (u32)strtoul(argv[2], NULL, 10) : 1;
+  if (seed == 0) {
+    seed = 1; // xorshift's only fixed point
+  }
+  if (frames <= 0) {
+    frames = 10;
+  }
+
+  const BenchSize largest = bench_sizes[(sizeof(bench_sizes) /
+                                         sizeof(bench_sizes[0])) -
+                                        1];
+  // Worst case is one pixel per item (a zero-length line) at 4x overdraw
+  i32 max_items = largest.width * largest.height * 4;
+  BenchItem *items = (BenchItem *)malloc(sizeof(BenchItem) * (size_t)max_items);
+  u32 *pixels = (u32 *)malloc((size_t)largest.width * largest.height * 4);
+  u32 *sprite_pixels =
+      (u32 *)malloc(sizeof(u32) * BENCH_SPRITE_SIZE * BENCH_SPRITE_SIZE);
+  u8 *indexed_pixels = (u8 *)malloc(BENCH_SPRITE_SIZE * BENCH_SPRITE_SIZE);
+  u64 arena_size = 256u * 1024u;
+  void *arena_memory = malloc(arena_size);
+  if (!items || !pixels || !sprite_pixels || !indexed_pixels ||
+      !arena_memory) {
+    fprintf(stderr, "❌ Out of memory\n");
+    return 1;
+  }
+
+  bench_make_sprite(sprite_pixels);
+  De100Sprite sprite =
+      de100_sprite_make(sprite_pixels, BENCH_SPRITE_SIZE, BENCH_SPRITE_SIZE,
+                        BENCH_SPRITE_SIZE * 4);
+  De100Sprite sprite_spans = sprite;
+
+  u32 palette[256];
+  for (u32 i = 0; i < 256; ++i) {
+    palette[i] = DE100_PIXEL_PACK(i, 255 - i, (i * 7) & 0xFF, 255);
+  }
+  bench_make_indexed(indexed_pixels, seed);
+  De100IndexedImage indexed = de100_indexed_image_make(
+      indexed_pixels, BENCH_SPRITE_SIZE, BENCH_SPRITE_SIZE, BENCH_SPRITE_SIZE);
+  De100MemoryArena arena;
+  de100_arena_init(&arena, arena_size, arena_memory);
+  if (!de100_sprite_build_spans(&sprite_spans, &arena)) {
+    fprintf(stderr, "❌ Sprite span table didn't fit\n");
+    return 1;
+  }
+
+  printf("kernels %s, %d frames per case (fastest kept), seed %u\n\n",
+         de100_pixel_kernels_get()->name, frames, seed);
+  printf("%-10s %8s %-12s %12s %10s %10s\n", "size", "overdraw",
+         "primitive", "Mpix/s", "cycles/px", "checksum");
+
+  i32 size_count = (i32)(sizeof(bench_sizes) / sizeof(bench_sizes[0]));
+  i32 overdraw_count =
+      (i32)(sizeof(bench_overdraws) / sizeof(bench_overdraws[0]));
+  for (i32 s = 0; s < size_count; ++s) {
+    GameBackBuffer buffer = {0};
+    buffer.memory.base = pixels;
+    buffer.width = bench_sizes[s].width;
+    buffer.height = bench_sizes[s].height;
+    buffer.pitch = buffer.width * 4;
+    buffer.bytes_per_pixel = 4;
+    buffer.pixel_format = DE100_PIXEL_FORMAT;
+
+    char size_name[16];
+    snprintf(size_name, sizeof(size_name), "%dx%d", buffer.width,
+             buffer.height);
+
+    for (i32 o = 0; o < overdraw_count; ++o) {
+      for (i32 prim = 0; prim < BENCH_PRIM_COUNT; ++prim) {
+        i64 scene_pixels = 0;
+        i32 count = bench_build_scene((BenchPrimitive)prim, buffer.width,
+                                      buffer.height, bench_overdraws[o], seed,
+                                      items, max_items, &scene_pixels);
+
+        f64 best_seconds = 1e30;
+        u64 best_cycles = ~0ull;
+        u32 checksum = 0;
+        for (i32 frame = 0; frame < frames; ++frame) {
+          // Same starting frame every time, so the checksum is stable
+          memset(pixels, 0x20, (size_t)buffer.pitch * buffer.height);
+
+          f64 start = bench_seconds();
+          u64 start_cycles = bench_cycles();
+          bench_draw((BenchPrimitive)prim, &buffer, items, count, &sprite,
+                     &sprite_spans, &indexed, palette);
+          u64 cycles = bench_cycles() - start_cycles;
+          f64 seconds = bench_seconds() - start;
+
+          best_seconds = seconds < best_seconds ? seconds : best_seconds;
+          best_cycles = cycles < best_cycles ? cycles : best_cycles;
+          if (frame == 0) {
+            checksum = bench_checksum(&buffer);
+          }
+        }
+        if (best_seconds <= 0.0) {
+          best_seconds = 1e-9;
+        }
+
+        printf("%-10s %7dx %-12s %12.1f %10.2f %10u\n", size_name,
+               bench_overdraws[o], bench_prim_names[prim],
+               (f64)scene_pixels / best_seconds * 1e-6,
+               (f64)best_cycles / (f64)scene_pixels, checksum);
+      }
+    }
+  }
+
+  free(arena_memory);
+  free(indexed_pixels);
+  free(sprite_pixels);
+  free(pixels);
+  free(items);
+  return 0;
+}
@@ -44,6 +44,9 @@ case "$(uname -s)" in
     ;;
 esac
 
+BINARY="game"
+OPT_FLAGS="-g -O0"
+
 case "$BACKEND" in
     x11)
         BACKEND_LIBS="$BACKEND_LIBS -lX11 -lxkbcommon -lasound -lGL -lGLX"
@@ -56,16 +59,30 @@ case "$BACKEND" in
             *)       BACKEND_LIBS="$BACKEND_LIBS -lraylib -lpthread -ldl" ;;
         esac
         SOURCES="$SOURCES src/platforms/raylib/main.c"
+        # Raylib textures are R8G8B8A8 only (see src/utils/backbuffer.h)
+        PIXEL_FORMAT_FLAGS="-DGAME_PIXEL_FORMAT_RGBA=1"
+    ;;
+    headless)
+        # Batched env benchmark (src/game/env.h); optimized so the numbers mean something
+        SOURCES="$SOURCES src/game/env.c src/platforms/headless/main.c"
+        BINARY="snake-env-bench"
+        OPT_FLAGS="-g -O2"
+    ;;
+    audio-bench)
+        # Mixer benchmark (game_get_audio_samples under N voices); room for
+        # 256 voices, and the mixer's step/fade printf tracing compiled out
+        SOURCES="$SOURCES src/platforms/audio-bench/main.c"
+        BINARY="snake-audio-bench"
+        OPT_FLAGS="-g -O2 -DMAX_SIMULTANEOUS_SOUNDS=256 -DSNAKE_AUDIO_TRACE=0"
     ;;
     *)
         echo "Error: Unknown backend '$BACKEND'" >&2
-        echo "Available: x11, raylib, auto" >&2
+        echo "Available: x11, raylib, headless, audio-bench, auto" >&2
         exit 1
     ;;
 esac
 
-BINARY="game"
-FLAGS="-Wall -Wextra -g -O0 -DBACKEND=$BACKEND"
+FLAGS="-Wall -Wextra $OPT_FLAGS -DBACKEND=$BACKEND $PIXEL_FORMAT_FLAGS"
 PLATFORM_EXE_PATH="./build/${BINARY}"
 
 clang $FLAGS -o "$PLATFORM_EXE_PATH" $SOURCES $BACKEND_LIBS
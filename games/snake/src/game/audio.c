@@ -34,6 +34,82 @@ static const SoundDef SOUND_DEFS[SOUND_COUNT] = {
     [SOUND_GAME_OVER] = {400.0f, 100.0f, 500, 0.7f}, /* descending sad tone */
 };
 
+/* ═══════════════════════════════════════════════════════════════════════════
+ * Sound Cache (pre-rendered effects)
+ * ═══════════════════════════════════════════════════════════════════════════
+ * A SoundDef always synthesizes the same samples (square wave, pitch
+ * slide, fade-in, linear fade-out), so each one is rendered once per
+ * sample rate into this pool; a playing effect just reads it back.
+ * Static and shared by every GameAudioState (env.c runs many games).
+ * Sized for 96 kHz; the defs add up to 0.83 s.
+ */
+
+#define SOUND_CACHE_MAX_SAMPLES 96000
+#define SOUND_FADE_IN_SAMPLES 88 /* ~2ms fade-in at 44100 Hz */
+
+typedef struct {
+  int offset; /* Into the pool */
+  int length; /* 0 = not rendered yet */
+} SoundCacheEntry;
+
+static struct {
+  float samples[SOUND_CACHE_MAX_SAMPLES];
+  SoundCacheEntry entries[SOUND_COUNT];
+  int samples_per_second; /* Rate the entries were rendered at */
+  int used;
+} g_sound_cache;
+
+static void sound_render(const SoundDef *def, int samples_per_second,
+                         float *out, int total_samples) {
+  float inv_sample_rate = 1.0f / (float)samples_per_second;
+  float phase = 0.0f;
+  float frequency = def->frequency;
+  float frequency_slide =
+      def->frequency_end > 0
+          ? (def->frequency_end - def->frequency) / total_samples
+          : 0.0f;
+
+  for (int i = 0; i < total_samples; i++) {
+    float env = (float)(total_samples - i) / (float)total_samples;
+    if (i < SOUND_FADE_IN_SAMPLES)
+      env *= (float)i / (float)SOUND_FADE_IN_SAMPLES;
+
+    float wave = (phase < 0.5f) ? 1.0f : -1.0f;
+    out[i] = wave * def->volume * env;
+
+    phase += frequency * inv_sample_rate;
+    if (phase >= 1.0f)
+      phase -= 1.0f;
+    frequency += frequency_slide;
+  }
+}
+
+/* Rendered samples of `sound`; NULL if empty or the pool is full */
+static const float *sound_cache_get(SOUND_ID sound, int samples_per_second,
+                                    int *length) {
+  if (g_sound_cache.samples_per_second != samples_per_second) {
+    memset(g_sound_cache.entries, 0, sizeof(g_sound_cache.entries));
+    g_sound_cache.samples_per_second = samples_per_second;
+    g_sound_cache.used = 0;
+  }
+
+  SoundCacheEntry *entry = &g_sound_cache.entries[sound];
+  if (entry->length == 0) {
+    const SoundDef *def = &SOUND_DEFS[sound];
+    int total = (int)(def->duration_ms * samples_per_second / 1000.0f);
+    if (total <= 0 || g_sound_cache.used + total > SOUND_CACHE_MAX_SAMPLES)
+      return NULL;
+    entry->offset = g_sound_cache.used;
+    entry->length = total;
+    g_sound_cache.used += total;
+    sound_render(def, samples_per_second,
+                 g_sound_cache.samples + entry->offset, total);
+  }
+
+  *length = entry->length;
+  return g_sound_cache.samples + entry->offset;
+}
+
 /* ═══════════════════════════════════════════════════════════════════════════
  * Snake Melody Patterns (from Snake course, converted to MIDI notes)
  * ═══════════════════════════════════════════════════════════════════════════
@@ -66,9 +142,7 @@ static const uint8_t SNAKE_PATTERN_D[MUSIC_PATTERN_LENGTH] = {
  */
 
 static inline float midi_to_freq(int note) {
-  if (note == 0)
-    return 0.0f;
-  return 440.0f * powf(2.0f, (note - 69) / 12.0f);
+  return audio_midi_to_freq(note); /* Table lookup, see audio-helpers.h */
 }
 
 /* ═══════════════════════════════════════════════════════════════════════════
@@ -101,6 +175,14 @@ void game_audio_init(GameAudioState *audio) {
   memcpy(audio->music.patterns[2], SNAKE_PATTERN_C, MUSIC_PATTERN_LENGTH);
   memcpy(audio->music.patterns[3], SNAKE_PATTERN_D, MUSIC_PATTERN_LENGTH);
 
+  /* Render the effects now, not on their first play */
+  if (saved_sps > 0) {
+    for (int sound = SOUND_NONE + 1; sound < SOUND_COUNT; sound++) {
+      int length;
+      sound_cache_get((SOUND_ID)sound, saved_sps, &length);
+    }
+  }
+
   printf("[AUDIO_INIT] samples_per_second=%d, step_duration_samples=%d, "
          "music_volume=%.2f\n",
          audio->samples_per_second, audio->music.step_duration_samples,
@@ -128,7 +210,14 @@ void game_music_play(GameAudioState *audio) {
 
 void game_play_sound_at(GameAudioState *audio, SOUND_ID sound,
                         float pan_position) {
-  if (sound == SOUND_NONE || sound >= SOUND_COUNT)
+  if (sound == SOUND_NONE || sound >= SOUND_COUNT ||
+      audio->samples_per_second <= 0)
+    return;
+
+  int length;
+  const float *samples =
+      sound_cache_get(sound, audio->samples_per_second, &length);
+  if (!samples)
     return;
 
   int slot = -1;
@@ -143,17 +232,12 @@ void game_play_sound_at(GameAudioState *audio, SOUND_ID sound,
     slot = 0; /* Steal oldest slot */
   }
 
-  const SoundDef *def = &SOUND_DEFS[sound];
   SoundInstance *inst = &audio->active_sounds[slot];
 
   inst->sound_id = sound;
-  inst->phase = 0.0f;
-  inst->frequency = def->frequency;
-  inst->volume = def->volume;
-  inst->samples_remaining =
-      (int)(def->duration_ms * audio->samples_per_second / 1000.0f);
-  inst->total_samples = inst->samples_remaining;
-  inst->fade_in_samples = 88; /* ~2ms fade-in at 44100 Hz */
+  inst->samples = samples;
+  inst->samples_remaining = length;
+  inst->total_samples = length;
 
   /* Clamp pan position */
   if (pan_position < -1.0f)
@@ -161,13 +245,7 @@ void game_play_sound_at(GameAudioState *audio, SOUND_ID sound,
   if (pan_position > 1.0f)
     pan_position = 1.0f;
   inst->pan_position = pan_position;
-
-  if (def->frequency_end > 0 && inst->samples_remaining > 0) {
-    inst->frequency_slide =
-        (def->frequency_end - def->frequency) / inst->samples_remaining;
-  } else {
-    inst->frequency_slide = 0;
-  }
+  audio_calculate_pan(pan_position, &inst->left_gain, &inst->right_gain);
 }
 
 void game_play_sound(GameAudioState *audio, SOUND_ID sound) {
@@ -198,6 +276,17 @@ void game_audio_update(GameAudioState *audio, float delta_time) {
  * ═══════════════════════════════════════════════════════════════════════════
  */
 
+/* Step/fade tracing from inside the mixer; the audio bench build turns it
+ * off (-DSNAKE_AUDIO_TRACE=0) so it times mixing, not printf */
+#ifndef SNAKE_AUDIO_TRACE
+#define SNAKE_AUDIO_TRACE 1
+#endif
+#if SNAKE_AUDIO_TRACE
+#define AUDIO_TRACE(...) printf(__VA_ARGS__)
+#else
+#define AUDIO_TRACE(...) ((void)0)
+#endif
+
 static int g_step_count = 0;           /* DEBUG: track step changes */
 static int g_sample_call_count = 0;    /* DEBUG: track calls */
 static int g_last_fade_remaining = -1; /* DEBUG: track fade transitions */
@@ -221,29 +310,13 @@ void game_get_audio_samples(GameAudioState *audio, AudioOutputBuffer *buffer) {
       if (inst->samples_remaining <= 0)
         continue;
 
-      float wave = (inst->phase < 0.5f) ? 1.0f : -1.0f;
-
-      float env = (float)inst->samples_remaining / (float)inst->total_samples;
-
-      int samples_played = inst->total_samples - inst->samples_remaining;
-      if (samples_played < inst->fade_in_samples) {
-        float fade_in = (float)samples_played / (float)inst->fade_in_samples;
-        env *= fade_in;
-      }
-
-      float sample = wave * inst->volume * env * audio->sfx_volume;
-
-      float left_vol, right_vol;
-      audio_calculate_pan(inst->pan_position, &left_vol, &right_vol);
-
-      mixed_left += sample * left_vol;
-      mixed_right += sample * right_vol;
+      float sample = inst->samples[inst->total_samples -
+                                   inst->samples_remaining] *
+                     audio->sfx_volume;
 
-      inst->phase += inst->frequency * inv_sample_rate;
-      if (inst->phase >= 1.0f)
-        inst->phase -= 1.0f;
+      mixed_left += sample * inst->left_gain;
+      mixed_right += sample * inst->right_gain;
 
-      inst->frequency += inst->frequency_slide;
       inst->samples_remaining--;
     }
 
@@ -266,27 +339,28 @@ void game_get_audio_samples(GameAudioState *audio, AudioOutputBuffer *buffer) {
 
           /* Only reset phase when coming from silence */
           if (!was_playing || prev_freq == 0.0f) {
-            printf("[STEP %3d] pattern=%d step=%2d note=%d freq=%.1f->%.1f "
-                   "PLAY (from REST, phase reset)\n",
-                   g_step_count, seq->current_pattern, seq->current_step, note,
-                   prev_freq, new_freq);
+            AUDIO_TRACE("[STEP %3d] pattern=%d step=%2d note=%d "
+                        "freq=%.1f->%.1f PLAY (from REST, phase reset)\n",
+                        g_step_count, seq->current_pattern,
+                        seq->current_step, note, prev_freq, new_freq);
             tone->phase = 0.0f;
             tone->fade_samples_remaining = MUSIC_FADE_SAMPLES;
           } else {
-            printf("[STEP %3d] pattern=%d step=%2d note=%d freq=%.1f->%.1f "
-                   "PLAY (continuous, phase=%.4f)\n",
-                   g_step_count, seq->current_pattern, seq->current_step, note,
-                   prev_freq, new_freq, tone->phase);
+            AUDIO_TRACE("[STEP %3d] pattern=%d step=%2d note=%d "
+                        "freq=%.1f->%.1f PLAY (continuous, phase=%.4f)\n",
+                        g_step_count, seq->current_pattern,
+                        seq->current_step, note, prev_freq, new_freq,
+                        tone->phase);
           }
 
           tone->frequency = new_freq;
           tone->is_playing = 1;
         } else {
           /* REST - fade out */
-          printf("[STEP %3d] pattern=%d step=%2d note=REST prev_freq=%.1f STOP "
-                 "fade_start=%d phase=%.4f\n",
-                 g_step_count, seq->current_pattern, seq->current_step,
-                 prev_freq, MUSIC_FADE_SAMPLES, tone->phase);
+          AUDIO_TRACE("[STEP %3d] pattern=%d step=%2d note=REST "
+                      "prev_freq=%.1f STOP fade_start=%d phase=%.4f\n",
+                      g_step_count, seq->current_pattern, seq->current_step,
+                      prev_freq, MUSIC_FADE_SAMPLES, tone->phase);
           tone->is_playing = 0;
           tone->fade_samples_remaining = MUSIC_FADE_SAMPLES;
         }
@@ -300,7 +374,8 @@ void game_get_audio_samples(GameAudioState *audio, AudioOutputBuffer *buffer) {
           seq->current_step = 0;
           seq->current_pattern =
               (seq->current_pattern + 1) % MUSIC_NUM_PATTERNS;
-          printf("[PATTERN] Advanced to pattern %d\n", seq->current_pattern);
+          AUDIO_TRACE("[PATTERN] Advanced to pattern %d\n",
+                      seq->current_pattern);
         }
       }
 
@@ -309,11 +384,11 @@ void game_get_audio_samples(GameAudioState *audio, AudioOutputBuffer *buffer) {
       /* DEBUG: Log fade state changes */
       if (tone->fade_samples_remaining != g_last_fade_remaining) {
         if (tone->fade_samples_remaining == MUSIC_FADE_SAMPLES) {
-          printf("[SAMPLES call=%d] FADE STARTED: is_playing=%d freq=%.1f "
-                 "fade_remaining=%d current_vol=%.4f phase=%.4f\n",
-                 g_sample_call_count, tone->is_playing, tone->frequency,
-                 tone->fade_samples_remaining, tone->current_volume,
-                 tone->phase);
+          AUDIO_TRACE("[SAMPLES call=%d] FADE STARTED: is_playing=%d freq=%.1f "
+                      "fade_remaining=%d current_vol=%.4f phase=%.4f\n",
+                      g_sample_call_count, tone->is_playing, tone->frequency,
+                      tone->fade_samples_remaining, tone->current_volume,
+                      tone->phase);
         }
         g_last_fade_remaining = tone->fade_samples_remaining;
       }
@@ -346,10 +421,11 @@ void game_get_audio_samples(GameAudioState *audio, AudioOutputBuffer *buffer) {
 
         /* DEBUG: Log when fade completes */
         if (tone->fade_samples_remaining == 0) {
-          printf("[SAMPLES call=%d sample=%d] FADE COMPLETE: is_playing=%d "
-                 "fade_env=%.4f current_vol=%.4f phase=%.4f\n",
-                 g_sample_call_count, s, tone->is_playing, fade_env,
-                 tone->current_volume, tone->phase);
+          AUDIO_TRACE("[SAMPLES call=%d sample=%d] FADE COMPLETE: "
+                      "is_playing=%d fade_env=%.4f current_vol=%.4f "
+                      "phase=%.4f\n",
+                      g_sample_call_count, s, tone->is_playing, fade_env,
+                      tone->current_volume, tone->phase);
         }
       } else {
         tone->current_volume = tone->is_playing ? tone->volume : 0.0f;
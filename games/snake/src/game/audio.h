@@ -26,18 +26,21 @@ typedef enum {
  * Sound Instance
  * ═══════════════════════════════════════════════════════════════════════════
  */
+/* Overridable so the audio bench can build with heavier voice loads */
+#ifndef MAX_SIMULTANEOUS_SOUNDS
 #define MAX_SIMULTANEOUS_SOUNDS 4
+#endif
 
+/* A playing effect reads its pre-rendered PCM (the sound cache in
+ * audio.c); no synthesis happens in the mixer */
 typedef struct {
   SOUND_ID sound_id;
-  float phase;
+  const float *samples; /* Mono, envelope and volume baked in */
   int samples_remaining;
-  float volume;
-  float frequency;
-  float frequency_slide;
   int total_samples;
-  int fade_in_samples;
   float pan_position;
+  float left_gain; /* From pan_position, once at play time */
+  float right_gain;
 } SoundInstance;
 
 /* ═══════════════════════════════════════════════════════════════════════════
@@ -3,15 +3,24 @@
 
 #include "audio.h"
 #include <stdbool.h>
+#include <stdint.h>
 
+/* The standard board.  Boards of any size are allocated at runtime
+ * (snake_board_alloc); this one also gets its own compiled-in copy of
+ * the hot paths, with the sizes as constants (see snake_tick). */
 #define GRID_WIDTH 60
 #define GRID_HEIGHT 20
 #define CELL_SIZE 14
 #define HEADER_ROWS 3
 
+/* Smallest board snake_reset can lay the starting snake out on; the
+ * largest keeps cell indexes well inside an int */
+#define GRID_MIN_WIDTH 16
+#define GRID_MIN_HEIGHT 4
+#define GRID_MAX_CELLS (1 << 24)
+
 #define SCREEN_INITIAL_WIDTH (GRID_WIDTH * CELL_SIZE)
 #define SCREEN_INITIAL_HEIGHT ((GRID_HEIGHT + HEADER_ROWS) * CELL_SIZE)
-#define MAX_SNAKE (GRID_WIDTH * GRID_HEIGHT)
 
 /* Typed enum prevents passing a raw int where a direction is expected.
  * Arithmetic still works: (dir + 1) % 4 = turn right (CW).
@@ -88,7 +97,7 @@ typedef struct {
 } GameInput;
 
 typedef struct {
-  Segment segments[MAX_SNAKE];
+  Segment *segments; /* ring of grid.cells entries, from the board arena */
   int head;   /* index of the head segment */
   int tail;   /* index of the tail segment */
   int length; /* number of active segments */
@@ -101,12 +110,73 @@ typedef struct {
       move_repeat; /* auto-repeat for moving forward (always active) */
 } Snake;
 
+/* Which grid cells the snake covers, kept in step with the ring above.
+ *
+ * occupied:   one bit per cell (index = y * width + x), for O(1)
+ *             self-collision.
+ * free_cells: every playable cell NOT under the snake, in no particular
+ *             order, so a uniformly random free cell is one rand().
+ * free_slot:  where each cell sits in free_cells (-1 = occupied or
+ *             wall), so taking a cell out is a swap-remove.
+ *
+ * Walls are never in free_cells; they are not occupied either, the
+ * wall check in game_update stays coordinate based. */
+typedef struct {
+  int width; /* walls included */
+  int height;
+  int cells; /* width * height */
+
+  /* From the board arena (snake_board_alloc), sized by `cells` */
+  uint64_t *occupied; /* [(cells + 63) / 64] */
+  int *free_cells;    /* [cells] */
+  int *free_slot;     /* [cells] */
+  int free_count;
+} SnakeGrid;
+
+/* The per-cell checks take the size as arguments rather than reading it
+ * from the grid, so a caller passing GRID_WIDTH/GRID_HEIGHT gets them
+ * with constant bounds and a constant-multiply index. */
+static inline bool grid_is_wall(int width, int height, int x, int y) {
+  return x < 1 || x >= width - 1 || y < 0 || y >= height - 1;
+}
+
+static inline bool grid_is_occupied(const SnakeGrid *grid, int width, int x,
+                                    int y) {
+  int cell = y * width + x;
+  return (grid->occupied[cell >> 6] >> (cell & 63)) & 1;
+}
+
+static inline bool grid_is_standard(const SnakeGrid *grid) {
+  return grid->width == GRID_WIDTH && grid->height == GRID_HEIGHT;
+}
+
+/* Have the compiler paste a size-generic body into each specialization
+ * instead of leaving one shared, runtime-sized copy */
+#if defined(__GNUC__) || defined(__clang__)
+#define SNAKE_FORCE_INLINE inline __attribute__((always_inline))
+#else
+#define SNAKE_FORCE_INLINE inline
+#endif
+
 typedef struct {
   Snake snake;
+  SnakeGrid grid;
+  int food_x; /* -1 when the board is full */
+  int food_y;
+  int grow_pending; /* segments still to add from food eaten */
+  uint32_t rng_state; /* food placement, see snake_reset */
   bool is_game_over;
   int score;
   int best_score;
   GameAudioState audio;
 } GameState;
 
+/* What one snake_tick did; flags, an eating tick also grows */
+typedef enum {
+  SNAKE_TICK_ATE = 1 << 0,
+  SNAKE_TICK_GREW = 1 << 1,
+  SNAKE_TICK_DIED = 1 << 2,
+} SNAKE_TICK_FLAG;
+typedef int SnakeTickResult;
+
 #endif // GAME_BASE_H
\ No newline at end of file
@@ -0,0 +1,142 @@
+#include "env.h"
+#include "main.h"
+
+/* splitmix32-style mix, so envs seeded seed, seed+1, ... diverge at once */
+static uint32_t env_seed(uint32_t seed, int index) {
+  uint32_t x = seed + (uint32_t)index * 0x9E3779B9u;
+  x = (x ^ (x >> 16)) * 0x85EBCA6Bu;
+  x = (x ^ (x >> 13)) * 0xC2B2AE35u;
+  return x ^ (x >> 16);
+}
+
+static inline bool env_is_danger(const GameState *state, int width,
+                                 int height, int x, int y, SNAKE_DIR dir) {
+  int nx = x + DIRECTION_SNAKE_X[dir];
+  int ny = y + DIRECTION_SNAKE_Y[dir];
+  return grid_is_wall(width, height, nx, ny) ||
+         grid_is_occupied(&state->grid, width, nx, ny);
+}
+
+/* Size passed in like snake_tick_sized, for the same specialization */
+static SNAKE_FORCE_INLINE void env_observe_sized(const GameState *state,
+                                                 int width, int height,
+                                                 uint8_t *obs) {
+  const Snake *snake = &state->snake;
+  int hx = snake->segments[snake->head].x;
+  int hy = snake->segments[snake->head].y;
+  SNAKE_DIR dir = snake->direction;
+
+  obs[0] = env_is_danger(state, width, height, hx, hy, dir);
+  obs[1] = env_is_danger(state, width, height, hx, hy,
+                         (dir + DIRECTION_SNAKE_SIZE - 1) % DIRECTION_SNAKE_SIZE);
+  obs[2] = env_is_danger(state, width, height, hx, hy,
+                         (dir + 1) % DIRECTION_SNAKE_SIZE);
+
+  obs[3] = dir == SNAKE_DIR_UP;
+  obs[4] = dir == SNAKE_DIR_RIGHT;
+  obs[5] = dir == SNAKE_DIR_DOWN;
+  obs[6] = dir == SNAKE_DIR_LEFT;
+
+  /* No food (full board) reads as "nowhere" */
+  bool has_food = state->food_x >= 0;
+  obs[7] = has_food && state->food_x < hx;
+  obs[8] = has_food && state->food_x > hx;
+  obs[9] = has_food && state->food_y < hy;
+  obs[10] = has_food && state->food_y > hy;
+}
+
+static void env_observe_one(const GameState *state, uint8_t *obs) {
+  if (grid_is_standard(&state->grid)) {
+    env_observe_sized(state, GRID_WIDTH, GRID_HEIGHT, obs);
+  } else {
+    env_observe_sized(state, state->grid.width, state->grid.height, obs);
+  }
+}
+
+bool snake_env_init(SnakeEnv *env, int count, uint32_t seed,
+                    int max_idle_steps, int width, int height) {
+  *env = (SnakeEnv){0};
+  size_t board_size = snake_board_size(width, height);
+  if (count <= 0 || board_size == 0)
+    return false;
+
+  /* States, idle counters and every board in one block, sized for
+   * exactly this many boards of exactly this size */
+  size_t total = ARENA_SIZE_OF(sizeof(GameState) * (size_t)count) +
+                 ARENA_SIZE_OF(sizeof(int) * (size_t)count) +
+                 board_size * (size_t)count;
+  if (!arena_init(&env->arena, total))
+    return false;
+  env->states = ARENA_PUSH_ARRAY(&env->arena, GameState, count);
+  env->idle_steps = ARENA_PUSH_ARRAY(&env->arena, int, count);
+
+  env->count = count;
+  env->max_idle_steps = max_idle_steps;
+  for (int i = 0; i < count; i++) {
+    snake_board_alloc(&env->states[i], &env->arena, width, height);
+    snake_reset(&env->states[i], env_seed(seed, i));
+  }
+  return true;
+}
+
+void snake_env_free(SnakeEnv *env) {
+  arena_free(&env->arena);
+  *env = (SnakeEnv){0};
+}
+
+void snake_env_observe(const SnakeEnv *env, uint8_t *observations) {
+  for (int i = 0; i < env->count; i++) {
+    env_observe_one(&env->states[i], observations + i * SNAKE_ENV_OBS_SIZE);
+  }
+}
+
+void snake_env_reset(SnakeEnv *env, uint8_t *observations) {
+  for (int i = 0; i < env->count; i++) {
+    GameState *state = &env->states[i];
+    snake_reset(state, state->rng_state); /* carry on the same stream */
+    env->idle_steps[i] = 0;
+  }
+  snake_env_observe(env, observations);
+}
+
+void snake_env_step(SnakeEnv *env, const uint8_t *actions,
+                    uint8_t *observations, float *rewards, uint8_t *dones) {
+  for (int i = 0; i < env->count; i++) {
+    GameState *state = &env->states[i];
+    Snake *snake = &state->snake;
+
+    /* Relative turns can never reverse, so no 180° guard is needed */
+    if (actions[i] == SNAKE_ACTION_LEFT) {
+      snake->next_direction =
+          (snake->direction + DIRECTION_SNAKE_SIZE - 1) % DIRECTION_SNAKE_SIZE;
+    } else if (actions[i] == SNAKE_ACTION_RIGHT) {
+      snake->next_direction = (snake->direction + 1) % DIRECTION_SNAKE_SIZE;
+    } else {
+      snake->next_direction = snake->direction;
+    }
+
+    SnakeTickResult result = snake_tick(state);
+
+    float reward = 0.0f;
+    bool done = false;
+    if (result & SNAKE_TICK_DIED) {
+      reward = -1.0f;
+      done = true;
+    } else if (result & SNAKE_TICK_ATE) {
+      reward = 1.0f;
+      env->idle_steps[i] = 0;
+    } else if (env->max_idle_steps > 0 &&
+               ++env->idle_steps[i] >= env->max_idle_steps) {
+      done = true; /* Truncated: circling without eating */
+    }
+
+    if (done) {
+      snake_reset(state, state->rng_state);
+      env->idle_steps[i] = 0;
+    }
+
+    rewards[i] = reward;
+    dones[i] = done;
+    env_observe_one(state, observations + i * SNAKE_ENV_OBS_SIZE);
+  }
+}
@@ -0,0 +1,78 @@
+#ifndef GAME_SNAKE_ENV_H
+#define GAME_SNAKE_ENV_H
+
+#include "../utils/arena.h"
+#include "./base.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* ═══════════════════════════════════════════════════════════════════════════
+ * Batched Environment — N snakes stepped together, for RL training
+ * ═══════════════════════════════════════════════════════════════════════════
+ *
+ *   SnakeEnv env;
+ *   snake_env_init(&env, 1024, seed, 500, GRID_WIDTH, GRID_HEIGHT);
+ *   snake_env_reset(&env, obs);
+ *   for (;;) {
+ *     policy(obs, actions);
+ *     snake_env_step(&env, actions, obs, rewards, dones);
+ *   }
+ *   snake_env_free(&env);
+ *
+ * States live in one contiguous array and go straight through snake_tick:
+ * no input pipeline, no timer, no audio, no rendering.  Every env plays
+ * on a board of the same runtime size; the states and all their boards
+ * come from one arena allocated for exactly that size and count.
+ *
+ * An env that ends (death, or `max_idle_steps` without food) is reset in
+ * the same step, so the observation written for it is the first of the
+ * next episode.
+ *
+ * Observation: SNAKE_ENV_OBS_SIZE bytes per env, each 0 or 1:
+ *
+ *   0..2    danger straight / left / right (wall or body next cell)
+ *   3..6    heading up / right / down / left (one-hot)
+ *   7..10   food is left / right / up / down of the head
+ *
+ * Reward: +1 for eating, -1 for dying, 0 otherwise.
+ */
+
+#define SNAKE_ENV_OBS_SIZE 11
+
+/* Relative to the current heading, like the game's turn buttons */
+typedef enum {
+  SNAKE_ACTION_STRAIGHT = 0,
+  SNAKE_ACTION_LEFT = 1,
+  SNAKE_ACTION_RIGHT = 2,
+  SNAKE_ACTION_COUNT
+} SNAKE_ACTION;
+
+typedef struct {
+  int count;
+  int max_idle_steps; /* 0 = episodes only end on death */
+  GameState *states;  /* [count], contiguous */
+  int *idle_steps;    /* [count], steps since the last food */
+  Arena arena;        /* owns all of the above and the boards */
+} SnakeEnv;
+
+/* Allocate `count` envs on width × height boards (walls included, see
+ * GRID_MIN_WIDTH), seeded from `seed`.  False on a bad size or
+ * allocation failure (env left empty, snake_env_free is still safe). */
+bool snake_env_init(SnakeEnv *env, int count, uint32_t seed,
+                    int max_idle_steps, int width, int height);
+void snake_env_free(SnakeEnv *env);
+
+/* Fill observations[count][SNAKE_ENV_OBS_SIZE] for the current states. */
+void snake_env_observe(const SnakeEnv *env, uint8_t *observations);
+
+/* Reset every env and write its first observation. */
+void snake_env_reset(SnakeEnv *env, uint8_t *observations);
+
+/* Apply actions[count] (SNAKE_ACTION), advance every env one tick and
+ * write observations[count][SNAKE_ENV_OBS_SIZE], rewards[count] and
+ * dones[count].  Envs that finished are already reset. */
+void snake_env_step(SnakeEnv *env, const uint8_t *actions,
+                    uint8_t *observations, float *rewards, uint8_t *dones);
+
+#endif // GAME_SNAKE_ENV_H
@@ -2,16 +2,55 @@
 #include "../utils/backbuffer.h"
 #include "../utils/draw-shapes.h"
 #include "../utils/draw-text.h"
-#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
 
-static void draw_cell(Backbuffer *backbuffer, int x, int y, uint32_t color) {
-  int py = (y * CELL_SIZE) + (CELL_SIZE * HEADER_ROWS) + 1;
-  int px = (x * CELL_SIZE) + 1;
-  int size = CELL_SIZE - 2;
-  draw_rect(backbuffer, px, py, size, size, color);
+/* Digits straight into the buffer, and only when the value changes */
+#include "../../../../engine/game/format.h"
+
+/* Board cells per draw_cell_row call; wider boards take several */
+#define DRAW_ROW_CHUNK 256
+
+/* Food, body and head, a board row at a time: a body lying along a row
+ * goes out as one span per scanline instead of a draw_rect per segment.
+ * The occupancy bits are exactly the segments, head included.  Cells get
+ * a 1 px black gutter, the field's own color. */
+static void draw_board(Backbuffer *backbuffer, const GameState *game_state,
+                       uint32_t body_color, uint32_t head_color) {
+  const SnakeGrid *grid = &game_state->grid;
+  const Snake *snake = &game_state->snake;
+  Segment head = snake->segments[snake->head];
+  uint32_t colors[DRAW_ROW_CHUNK];
+
+  for (int y = 0; y < grid->height; y++) {
+    int py = (y + HEADER_ROWS) * CELL_SIZE;
+    for (int x0 = 0; x0 < grid->width; x0 += DRAW_ROW_CHUNK) {
+      int count = grid->width - x0;
+      if (count > DRAW_ROW_CHUNK)
+        count = DRAW_ROW_CHUNK;
+
+      bool is_empty = true;
+      for (int i = 0; i < count; i++) {
+        bool is_body = grid_is_occupied(grid, grid->width, x0 + i, y);
+        colors[i] = is_body ? body_color : DRAW_CELL_SKIP;
+        is_empty = is_empty && !is_body;
+      }
+      if (game_state->food_y == y && game_state->food_x >= x0 &&
+          game_state->food_x < x0 + count) {
+        colors[game_state->food_x - x0] = COLOR_RED;
+        is_empty = false;
+      }
+      if (head.y == y && head.x >= x0 && head.x < x0 + count) {
+        colors[head.x - x0] = head_color;
+        is_empty = false;
+      }
+
+      if (!is_empty)
+        draw_cell_row(backbuffer, x0 * CELL_SIZE, py, CELL_SIZE, 1,
+                      COLOR_BLACK, colors, count);
+    }
+  }
 }
 
 /* Reset transition counts — they're per-frame */
@@ -21,53 +60,125 @@ void prepare_input_frame(GameInput *input) {
   input->restart = 0;
 }
 
-// /* Calculate pan position based on X coordinate */
-// static float calculate_pan(int x) {
-//   float center = GRID_WIDTH / 2.0f;
-//   float offset = (float)x - center;
-//   float pan = (offset / center) * 0.8f;
-//   if (pan < -1.0f)
-//     pan = -1.0f;
-//   if (pan > 1.0f)
-//     pan = 1.0f;
-//   return pan;
-// }
-
-// /* Spawn food at random location not occupied by snake */
-// static void spawn_food(GameState *state) {
-//   Snake *snake = &state->snake;
-//   int ok;
-//   do {
-//     state->food_x = 1 + rand() % (GRID_WIDTH - 2);
-//     state->food_y = rand() % (GRID_HEIGHT - 1);
-
-//     ok = 1;
-//     int idx = snake->tail;
-//     int rem = snake->length;
-//     while (rem > 0) {
-//       if (snake->segments[idx].x == state->food_x &&
-//           snake->segments[idx].y == state->food_y) {
-//         ok = 0;
-//         break;
-//       }
-//       idx = (idx + 1) % MAX_SNAKE;
-//       rem--;
-//     }
-//   } while (!ok);
-// }
+/* Calculate pan position based on X coordinate */
+static float calculate_pan(int x, int grid_width) {
+  float center = grid_width / 2.0f;
+  float offset = (float)x - center;
+  float pan = (offset / center) * 0.8f;
+  if (pan < -1.0f)
+    pan = -1.0f;
+  if (pan > 1.0f)
+    pan = 1.0f;
+  return pan;
+}
 
-void game_init(GameState *game_state,
-               AudioOutputBuffer *game_audio_output_buffer) {
-  int saved_best = game_state->best_score;
-  int saved_sps = game_state->audio.samples_per_second;
+/* ─── Occupancy grid ─────────────────────────────────────────── */
 
-  memset(game_state, 0, sizeof(GameState));
+/* Snake moves onto (x, y): set its bit, swap-remove it from free_cells */
+static inline void grid_occupy(SnakeGrid *grid, int width, int x, int y) {
+  int cell = y * width + x;
+  grid->occupied[cell >> 6] |= 1ull << (cell & 63);
 
-  game_state->best_score = saved_best;
-  game_state->audio.samples_per_second = saved_sps;
+  int slot = grid->free_slot[cell];
+  if (slot < 0)
+    return;
+  int last = grid->free_cells[--grid->free_count];
+  grid->free_cells[slot] = last;
+  grid->free_slot[last] = slot;
+  grid->free_slot[cell] = -1;
+}
+
+/* Snake leaves (x, y): clear its bit, append it to free_cells */
+static inline void grid_vacate(SnakeGrid *grid, int width, int x, int y) {
+  int cell = y * width + x;
+  grid->occupied[cell >> 6] &= ~(1ull << (cell & 63));
+
+  grid->free_slot[cell] = grid->free_count;
+  grid->free_cells[grid->free_count++] = cell;
+}
+
+/* Every playable cell free, nothing occupied */
+static void grid_init(SnakeGrid *grid) {
+  memset(grid->occupied, 0,
+         sizeof(uint64_t) * (size_t)((grid->cells + 63) / 64));
+  grid->free_count = 0;
+  for (int y = 0; y < grid->height; ++y) {
+    for (int x = 0; x < grid->width; ++x) {
+      int cell = y * grid->width + x;
+      grid->free_slot[cell] = -1;
+      if (!grid_is_wall(grid->width, grid->height, x, y)) {
+        grid->free_slot[cell] = grid->free_count;
+        grid->free_cells[grid->free_count++] = cell;
+      }
+    }
+  }
+}
+
+/* xorshift32 — per state, so batched envs are independent and a seed
+ * replays the same food everywhere (rand() is neither) */
+static uint32_t snake_rand(GameState *state) {
+  uint32_t x = state->rng_state;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  return state->rng_state = x;
+}
+
+/* Spawn food on a uniformly random free cell — one random draw, however
+ * long the snake is.  A full board leaves no food (food_x = -1). */
+static inline void spawn_food(GameState *state, int width) {
+  SnakeGrid *grid = &state->grid;
+  if (grid->free_count == 0) {
+    state->food_x = -1;
+    state->food_y = -1;
+    return;
+  }
+  int cell = grid->free_cells[snake_rand(state) % (uint32_t)grid->free_count];
+  state->food_x = cell % width;
+  state->food_y = cell / width;
+}
+
+/* ─── Board storage ──────────────────────────────────────────── */
+
+static bool board_size_is_valid(int width, int height) {
+  return width >= GRID_MIN_WIDTH && height >= GRID_MIN_HEIGHT &&
+         width <= GRID_MAX_CELLS / height;
+}
+
+size_t snake_board_size(int width, int height) {
+  if (!board_size_is_valid(width, height))
+    return 0;
+  size_t cells = (size_t)width * (size_t)height;
+  return ARENA_SIZE_OF(sizeof(Segment) * cells) +
+         ARENA_SIZE_OF(sizeof(uint64_t) * ((cells + 63) / 64)) +
+         2 * ARENA_SIZE_OF(sizeof(int) * cells);
+}
 
+bool snake_board_alloc(GameState *game_state, Arena *arena, int width,
+                       int height) {
+  if (!board_size_is_valid(width, height))
+    return false;
+  size_t needed = snake_board_size(width, height);
+  if (needed > arena->size - arena->used)
+    return false;
+
+  int cells = width * height;
+  SnakeGrid *grid = &game_state->grid;
+  grid->width = width;
+  grid->height = height;
+  grid->cells = cells;
+  game_state->snake.segments = ARENA_PUSH_ARRAY(arena, Segment, cells);
+  grid->occupied = ARENA_PUSH_ARRAY(arena, uint64_t, (cells + 63) / 64);
+  grid->free_cells = ARENA_PUSH_ARRAY(arena, int, cells);
+  grid->free_slot = ARENA_PUSH_ARRAY(arena, int, cells);
+  return true;
+}
+
+void snake_reset(GameState *game_state, uint32_t seed) {
   SNAKE_DIR current_dir = SNAKE_DIR_RIGHT;
+  SnakeGrid *grid = &game_state->grid;
   game_state->snake = (Snake){
+      .segments = game_state->snake.segments,
       .head = 9,
       .tail = 0,
       .length = 10,
@@ -79,17 +190,37 @@ void game_init(GameState *game_state,
 
   game_state->is_game_over = false;
   game_state->score = 0;
-  // game_state->grow_pending = 0;
+  game_state->grow_pending = 0;
+  game_state->rng_state = seed ? seed : 1; /* xorshift's only fixed point */
 
   /* Initialize snake segments */
+  grid_init(grid);
   for (int i = 0; i < game_state->snake.length; ++i) {
-    game_state->snake.segments[i].x = GRID_WIDTH / 2 - 5 + i;
-    game_state->snake.segments[i].y = GRID_HEIGHT / 2;
+    game_state->snake.segments[i].x = grid->width / 2 - 5 + i;
+    game_state->snake.segments[i].y = grid->height / 2;
+    grid_occupy(grid, grid->width, game_state->snake.segments[i].x,
+                game_state->snake.segments[i].y);
   }
 
-  /* Seed random and spawn food */
-  srand((unsigned)time(NULL));
-  // spawn_food(game_state);
+  spawn_food(game_state, grid->width);
+}
+
+void game_init(GameState *game_state,
+               AudioOutputBuffer *game_audio_output_buffer) {
+  int saved_best = game_state->best_score;
+  int saved_sps = game_state->audio.samples_per_second;
+  /* The board storage comes from the platform's arena */
+  Segment *saved_segments = game_state->snake.segments;
+  SnakeGrid saved_grid = game_state->grid;
+
+  memset(game_state, 0, sizeof(GameState));
+
+  game_state->best_score = saved_best;
+  game_state->audio.samples_per_second = saved_sps;
+  game_state->snake.segments = saved_segments;
+  game_state->grid = saved_grid;
+
+  snake_reset(game_state, (uint32_t)time(NULL));
 
   /* Initialize audio */
   if (game_audio_output_buffer->is_initialized) {
@@ -112,47 +243,34 @@ void game_render(GameState *game_state, Backbuffer *backbuffer) {
   draw_rect(backbuffer, 0, (HEADER_ROWS - 1) * CELL_SIZE, backbuffer->width, 2,
             COLOR_LIME_GREEN);
 
-  char buf[64];
+  /* HUD runs: re-formatted only when their number changes */
+  static De100FormatCache score_text, best_text, final_score_text;
   {
     int title_x = (backbuffer->width - 5 * 6 * 2) / 2;
     int text_y = (HEADER_ROWS * CELL_SIZE - 14) / 2;
     draw_text(backbuffer, title_x, text_y, "SNAKE", COLOR_LIME_GREEN, 2);
 
-    snprintf(buf, sizeof(buf), "SCORE:%d", game_state->score);
-    draw_text(backbuffer, 8, text_y, buf, COLOR_WHITE, 2);
+    draw_text(backbuffer, 8, text_y,
+              de100_format_cached_i32(&score_text, "SCORE:", game_state->score),
+              COLOR_WHITE, 2);
 
-    snprintf(buf, sizeof(buf), "BEST:%d", game_state->best_score);
-    draw_text(backbuffer, backbuffer->width - (int)(strlen(buf)) * 12 - 8,
-              text_y, buf, COLOR_YELLOW, 2);
+    const char *best = de100_format_cached_i32(&best_text, "BEST:",
+                                               game_state->best_score);
+    draw_text(backbuffer, backbuffer->width - (int)best_text.length * 12 - 8,
+              text_y, best, COLOR_YELLOW, 2);
   }
 
-  // /* Draw food */
-  // draw_cell(backbuffer, game_state->food_x, game_state->food_y, COLOR_RED);
-
-  /* Draw snake body */
-  Snake *snake = &game_state->snake;
+  /* Draw food, snake body and head */
   uint32_t body_color =
       game_state->is_game_over ? COLOR_DARK_RED : COLOR_LIME_GREEN;
   uint32_t head_color = game_state->is_game_over ? COLOR_DARK_RED : COLOR_WHITE;
-
-  int idx = snake->tail;
-  int rem = snake->length - 1;
-  while (rem > 0) {
-    draw_cell(backbuffer, snake->segments[idx].x, snake->segments[idx].y,
-              body_color);
-    idx = (idx + 1) % MAX_SNAKE;
-    rem--;
-  }
-
-  /* Draw head last */
-  draw_cell(backbuffer, snake->segments[snake->head].x,
-            snake->segments[snake->head].y, head_color);
+  draw_board(backbuffer, game_state, body_color, head_color);
 
   /* Game over overlay */
   if (game_state->is_game_over) {
     int field_y = HEADER_ROWS * CELL_SIZE;
-    int field_w = GRID_WIDTH * CELL_SIZE;
-    int field_h = GRID_HEIGHT * CELL_SIZE;
+    int field_w = game_state->grid.width * CELL_SIZE;
+    int field_h = game_state->grid.height * CELL_SIZE;
     int cx = field_w / 2;
     int cy = field_y + field_h / 2;
 
@@ -171,10 +289,11 @@ void game_render(GameState *game_state, Backbuffer *backbuffer) {
                 scale);
     }
 
-    snprintf(buf, sizeof(buf), "SCORE %d", game_state->score);
     {
-      int sw = (int)(strlen(buf)) * 12;
-      draw_text(backbuffer, cx - sw / 2, cy + 6, buf, COLOR_WHITE, 2);
+      const char *final_score = de100_format_cached_i32(
+          &final_score_text, "SCORE ", game_state->score);
+      int sw = (int)final_score_text.length * 12;
+      draw_text(backbuffer, cx - sw / 2, cy + 6, final_score, COLOR_WHITE, 2);
     }
     {
       int hw = 9 * 12;
@@ -187,6 +306,86 @@ void game_render(GameState *game_state, Backbuffer *backbuffer) {
   }
 }
 
+/* snake_tick for a width × height board; see snake_tick for why the size
+ * is passed in */
+static SNAKE_FORCE_INLINE SnakeTickResult
+snake_tick_sized(GameState *game_state, int width, int height) {
+  Snake *snake = &game_state->snake;
+  SnakeGrid *grid = &game_state->grid;
+  int cells = width * height;
+  SnakeTickResult result = 0;
+
+  /* Commit direction */
+  snake->direction = snake->next_direction;
+
+  /* Calculate new head position */
+  int dx = DIRECTION_SNAKE_X[snake->direction];
+  int dy = DIRECTION_SNAKE_Y[snake->direction];
+  int new_x = snake->segments[snake->head].x + dx;
+  int new_y = snake->segments[snake->head].y + dy;
+
+  /* Wall or self collision (the tail still counts: it moves after) */
+  if (grid_is_wall(width, height, new_x, new_y) ||
+      grid_is_occupied(grid, width, new_x, new_y)) {
+    if (game_state->score > game_state->best_score) {
+      game_state->best_score = game_state->score;
+    }
+    game_state->is_game_over = true;
+    return SNAKE_TICK_DIED;
+  }
+
+  /* Advance head */
+  snake->head = (snake->head + 1) % cells;
+  snake->segments[snake->head].x = new_x;
+  snake->segments[snake->head].y = new_y;
+  snake->length++;
+  grid_occupy(grid, width, new_x, new_y);
+
+  /* Food collision */
+  if (new_x == game_state->food_x && new_y == game_state->food_y) {
+    game_state->score++;
+    game_state->grow_pending += 5;
+    result |= SNAKE_TICK_ATE;
+
+    /* Speed up every 3 points */
+    if (game_state->score % 3 == 0 && snake->move_repeat.interval > 0.05f) {
+      snake->move_repeat.interval -= 0.01f;
+    }
+
+    spawn_food(game_state, width);
+  }
+
+  /* Tail advance (unless growing) */
+  if (game_state->grow_pending > 0) {
+    game_state->grow_pending--;
+    result |= SNAKE_TICK_GREW;
+  } else {
+    grid_vacate(grid, width, snake->segments[snake->tail].x,
+                snake->segments[snake->tail].y);
+    snake->tail = (snake->tail + 1) % cells;
+    snake->length--;
+  }
+
+  /* The board was full and the tail just freed a cell */
+  if (game_state->food_x < 0) {
+    spawn_food(game_state, width);
+  }
+
+  return result;
+}
+
+/* The standard board runs a copy compiled with its size as constants:
+ * the ring wrap, cell index and food position divide by constants, and
+ * the wall test compares against them.  Other sizes take the generic
+ * copy, with the same results. */
+SnakeTickResult snake_tick(GameState *game_state) {
+  const SnakeGrid *grid = &game_state->grid;
+  if (grid_is_standard(grid)) {
+    return snake_tick_sized(game_state, GRID_WIDTH, GRID_HEIGHT);
+  }
+  return snake_tick_sized(game_state, grid->width, grid->height);
+}
+
 void game_update(GameState *game_state, GameInput *input,
                  AudioOutputBuffer *game_audio_output_buffer,
                  float delta_time) {
@@ -225,73 +424,20 @@ void game_update(GameState *game_state, GameInput *input,
   }
   snake->move_repeat.timer -= snake->move_repeat.interval;
 
-  /* Commit direction */
-  snake->direction = snake->next_direction;
-
-  /* Calculate new head position */
-  int dx = DIRECTION_SNAKE_X[snake->direction];
-  int dy = DIRECTION_SNAKE_Y[snake->direction];
-  int new_x = snake->segments[snake->head].x + dx;
-  int new_y = snake->segments[snake->head].y + dy;
+  SnakeTickResult result = snake_tick(game_state);
 
-  /* Wall collision */
-  if (new_x < 1 || new_x >= GRID_WIDTH - 1 || new_y < 0 ||
-      new_y >= GRID_HEIGHT - 1) {
-    if (game_state->score > game_state->best_score) {
-      game_state->best_score = game_state->score;
-    }
-    game_state->is_game_over = true;
+  if (result & SNAKE_TICK_DIED) {
     game_music_stop(&game_state->audio);
     game_play_sound(&game_state->audio, SOUND_GAME_OVER);
     return;
   }
-
-  /* Self collision */
-  int idx = snake->tail;
-  int rem = snake->length;
-  while (rem > 0) {
-    if (snake->segments[idx].x == new_x && snake->segments[idx].y == new_y) {
-      if (game_state->score > game_state->best_score) {
-        game_state->best_score = game_state->score;
-      }
-      game_state->is_game_over = true;
-      game_music_stop(&game_state->audio);
-      game_play_sound(&game_state->audio, SOUND_GAME_OVER);
-      return;
-    }
-    idx = (idx + 1) % MAX_SNAKE;
-    rem--;
+  if (result & SNAKE_TICK_ATE) {
+    /* Spatial audio: pan based on food position (now the head) */
+    float pan = calculate_pan(snake->segments[snake->head].x,
+                              game_state->grid.width);
+    game_play_sound_at(&game_state->audio, SOUND_FOOD_EATEN, pan);
+  }
+  if (result & SNAKE_TICK_GREW) {
+    game_play_sound(&game_state->audio, SOUND_GROW);
   }
-
-  /* Advance head */
-  snake->head = (snake->head + 1) % MAX_SNAKE;
-  snake->segments[snake->head].x = new_x;
-  snake->segments[snake->head].y = new_y;
-  snake->length++;
-
-  // /* Food collision */
-  // if (new_x == game_state->food_x && new_y == game_state->food_y) {
-  //   game_state->score++;
-  //   game_state->grow_pending += 5;
-
-  //   /* Speed up every 3 points */
-  //   if (game_state->score % 3 == 0 && snake->move_repeat.interval > 0.05f) {
-  //     snake->move_repeat.interval -= 0.01f;
-  //   }
-
-  //   /* Spatial audio: pan based on food position */
-  //   float pan = calculate_pan(game_state->food_x);
-  //   game_play_sound_at(&game_state->audio, SOUND_FOOD_EATEN, pan);
-
-  //   spawn_food(game_state);
-  // }
-
-  // /* Tail advance (unless growing) */
-  // if (game_state->grow_pending > 0) {
-  //   game_state->grow_pending--;
-  //   game_play_sound(&game_state->audio, SOUND_GROW);
-  // } else {
-  snake->tail = (snake->tail + 1) % MAX_SNAKE;
-  snake->length--;
-  // }
 }
@@ -4,16 +4,35 @@
 #include "./audio.h"
 #include "./base.h"
 
+#include "../utils/arena.h"
 #include "../utils/backbuffer.h"
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 void prepare_input_frame(GameInput *input);
 
+/* Board storage: the snake ring and occupancy grid of a width × height
+ * board (walls included), carved out of `arena` once.  Call before
+ * game_init or snake_reset; both keep it.  snake_board_size is what the
+ * arena needs (0 when the size is out of range). */
+size_t snake_board_size(int width, int height);
+bool snake_board_alloc(GameState *game_state, Arena *arena, int width,
+                       int height);
+
 void game_init(GameState *game_state,
                AudioOutputBuffer *game_audio_output_buffer);
 void game_update(GameState *game_state, GameInput *input,
                  AudioOutputBuffer *game_audio_output_buffer, float delta_time);
 void game_render(GameState *game_state, Backbuffer *backbuffer);
 
+/* The simulation without input, timing, audio or rendering — shared by
+ * game_update and the batched env (env.h). */
+
+/* New board: snake in the middle, food drawn from `seed`. Keeps
+ * best_score and audio. */
+void snake_reset(GameState *game_state, uint32_t seed);
+/* Move one cell in snake.next_direction. */
+SnakeTickResult snake_tick(GameState *game_state);
+
 #endif // GAME_SNAKE_H
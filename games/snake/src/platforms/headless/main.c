@@ -0,0 +1,117 @@
+/* ═══════════════════════════════════════════════════════════════════════════
+ * Headless Env Benchmark — batched stepping, no window, no audio
+ * ═══════════════════════════════════════════════════════════════════════════
+ *
+ * Build & run:  ./build-dev.sh --backend=headless -r
+ *               ./build/snake-env-bench [envs] [steps] [seed] [width height]
+ *
+ * Steps `envs` snakes `steps` times through snake_env_step with a cheap
+ * greedy policy (head for the food, avoid danger) so episodes last long
+ * enough to look like training, and prints env-steps/sec.  Same seed ⇒
+ * same episodes, so the totals double as a check between runs.  The
+ * board defaults to the game's GRID_WIDTH × GRID_HEIGHT; any other size
+ * runs the generic (not size-specialized) tick.
+ */
+
+#include "../../game/env.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+static uint32_t bench_rand(uint32_t *state) {
+  uint32_t x = *state;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  return *state = x;
+}
+
+static double bench_seconds(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/* Turn toward the food when it's safe, else take any safe move */
+static uint8_t bench_policy(const uint8_t *obs, uint32_t *rng) {
+  /* Food side relative to heading: {ahead, left, right} per heading */
+  static const int AHEAD[4] = {9, 8, 10, 7};  /* up, right, down, left */
+  static const int LEFT_OF[4] = {7, 9, 8, 10};
+  static const int RIGHT_OF[4] = {8, 10, 7, 9};
+  int dir = obs[3] ? 0 : obs[4] ? 1 : obs[5] ? 2 : 3;
+
+  uint8_t wanted = obs[LEFT_OF[dir]]    ? SNAKE_ACTION_LEFT
+                   : obs[RIGHT_OF[dir]] ? SNAKE_ACTION_RIGHT
+                   : obs[AHEAD[dir]]    ? SNAKE_ACTION_STRAIGHT
+                                        : (uint8_t)(bench_rand(rng) % 3);
+  if (!obs[wanted])
+    return wanted; /* obs[0..2] = danger straight/left/right */
+  for (uint8_t a = 0; a < SNAKE_ACTION_COUNT; a++) {
+    if (!obs[a])
+      return a;
+  }
+  return wanted; /* boxed in */
+}
+
+int main(int argc, char **argv) {
+  int envs = argc > 1 ? atoi(argv[1]) : 1024;
+  int steps = argc > 2 ? atoi(argv[2]) : 2000;
+  uint32_t seed = argc > 3 ? (uint32_t)strtoul(argv[3], NULL, 10) : 1;
+  int width = argc > 5 ? atoi(argv[4]) : GRID_WIDTH;
+  int height = argc > 5 ? atoi(argv[5]) : GRID_HEIGHT;
+
+  SnakeEnv env;
+  if (!snake_env_init(&env, envs, seed, 1000, width, height)) {
+    fprintf(stderr, "Failed to allocate %d envs of %dx%d (min %dx%d)\n",
+            envs, width, height, GRID_MIN_WIDTH, GRID_MIN_HEIGHT);
+    return 1;
+  }
+
+  uint8_t *obs = malloc((size_t)envs * SNAKE_ENV_OBS_SIZE);
+  uint8_t *actions = malloc((size_t)envs);
+  float *rewards = malloc((size_t)envs * sizeof(float));
+  uint8_t *dones = malloc((size_t)envs);
+  if (!obs || !actions || !rewards || !dones) {
+    fprintf(stderr, "Failed to allocate step buffers\n");
+    return 1;
+  }
+
+  uint32_t policy_rng = seed ? seed : 1;
+  uint64_t episodes = 0, food = 0;
+  double policy_seconds = 0.0;
+
+  snake_env_reset(&env, obs);
+  double start = bench_seconds();
+  for (int s = 0; s < steps; s++) {
+    double policy_start = bench_seconds();
+    for (int i = 0; i < envs; i++) {
+      actions[i] = bench_policy(obs + i * SNAKE_ENV_OBS_SIZE, &policy_rng);
+    }
+    policy_seconds += bench_seconds() - policy_start;
+
+    snake_env_step(&env, actions, obs, rewards, dones);
+    for (int i = 0; i < envs; i++) {
+      episodes += dones[i];
+      food += rewards[i] > 0.0f;
+    }
+  }
+  double elapsed = bench_seconds() - start;
+  double env_seconds = elapsed - policy_seconds;
+  uint64_t total = (uint64_t)envs * (uint64_t)steps;
+
+  printf("envs            %d (%dx%d)\n", envs, width, height);
+  printf("env-steps       %llu\n", (unsigned long long)total);
+  printf("episodes        %llu\n", (unsigned long long)episodes);
+  printf("food eaten      %llu\n", (unsigned long long)food);
+  printf("elapsed         %.3f s (policy %.3f s)\n", elapsed, policy_seconds);
+  printf("env-steps/sec   %.0f (excluding policy)\n",
+         (double)total / env_seconds);
+
+  free(obs);
+  free(actions);
+  free(rewards);
+  free(dones);
+  snake_env_free(&env);
+  return 0;
+}
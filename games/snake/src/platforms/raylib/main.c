@@ -250,6 +250,13 @@ int main(void) {
 
   GameInput input = {0};
   GameState state = {0};
+  /* The window is sized for the standard board */
+  Arena board_arena;
+  if (!arena_init(&board_arena, snake_board_size(GRID_WIDTH, GRID_HEIGHT)) ||
+      !snake_board_alloc(&state, &board_arena, GRID_WIDTH, GRID_HEIGHT)) {
+    fprintf(stderr, "Failed to allocate the board\n");
+    return 1;
+  }
   state.audio.samples_per_second = props.game.audio.samples_per_second;
   game_init(&state, &props.game.audio);
 
@@ -271,6 +278,7 @@ int main(void) {
     display_backbuffer(&props.game.backbuffer);
   }
 
+  arena_free(&board_arena);
   platform_game_props_free(&props);
   platform_shutdown();
   return 0;
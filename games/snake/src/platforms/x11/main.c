@@ -263,8 +263,9 @@ void platform_get_input(GameInput *input, PlatformGameProps *props) {
 static void display_backbuffer(Backbuffer *bb) {
   glClear(GL_COLOR_BUFFER_BIT);
   glBindTexture(GL_TEXTURE_2D, g_x11.texture_id);
-  glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, bb->width, bb->height, 0, GL_RGBA,
-               GL_UNSIGNED_BYTE, bb->pixels);
+  /* 0xAARRGGBB pixels are desktop GL's native BGRA: no conversion */
+  glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, bb->width, bb->height, 0, GL_BGRA,
+               GL_UNSIGNED_INT_8_8_8_8_REV, bb->pixels);
 
   glBegin(GL_QUADS);
   glTexCoord2f(0, 0);
@@ -318,6 +319,13 @@ int main(void) {
   /* Initialize game */
   GameInput input = {0};
   GameState state = {0};
+  /* The window is sized for the standard board */
+  Arena board_arena;
+  if (!arena_init(&board_arena, snake_board_size(GRID_WIDTH, GRID_HEIGHT)) ||
+      !snake_board_alloc(&state, &board_arena, GRID_WIDTH, GRID_HEIGHT)) {
+    fprintf(stderr, "Failed to allocate the board\n");
+    return 1;
+  }
   state.audio.samples_per_second = props.game.audio.samples_per_second;
   game_init(&state, &props.game.audio);
 
@@ -358,6 +366,7 @@ int main(void) {
   }
 
   /* Cleanup */
+  arena_free(&board_arena);
   platform_game_props_free(&props);
   platform_shutdown();
   return 0;
@@ -0,0 +1,63 @@
+#ifndef UTILS_ARENA_H
+#define UTILS_ARENA_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ═══════════════════════════════════════════════════════════════════════════
+ * Arena - one block, bump-allocated, freed all at once
+ * ═══════════════════════════════════════════════════════════════════════════
+ *
+ *   Arena arena;
+ *   arena_init(&arena, snake_board_size(width, height));
+ *   snake_board_alloc(&state, &arena, width, height);
+ *   ...
+ *   arena_free(&arena);
+ *
+ * Permanent storage sized once from runtime parameters (board size, env
+ * count) instead of arrays sized for the worst case at compile time.
+ * Nothing is freed on its own: the arena lives as long as what it holds.
+ */
+
+typedef struct {
+  uint8_t *base;
+  size_t size;
+  size_t used;
+} Arena;
+
+/* Room for `size` bytes, zeroed.  False on allocation failure. */
+static inline bool arena_init(Arena *arena, size_t size) {
+  arena->base = calloc(1, size ? size : 1);
+  arena->size = arena->base ? size : 0;
+  arena->used = 0;
+  return arena->base != NULL;
+}
+
+static inline void arena_free(Arena *arena) {
+  free(arena->base);
+  *arena = (Arena){0};
+}
+
+/* Round up so every push keeps its alignment (16 covers every type here) */
+#define ARENA_ALIGN 16
+#define ARENA_SIZE_OF(bytes)                                                   \
+  (((size_t)(bytes) + (ARENA_ALIGN - 1)) & ~(size_t)(ARENA_ALIGN - 1))
+
+/* `size` zeroed bytes, or NULL when the arena is full */
+static inline void *arena_push(Arena *arena, size_t size) {
+  size_t aligned = ARENA_SIZE_OF(size);
+  if (aligned > arena->size - arena->used)
+    return NULL;
+  void *result = arena->base + arena->used;
+  arena->used += aligned;
+  memset(result, 0, size);
+  return result;
+}
+
+#define ARENA_PUSH_ARRAY(arena, type, count)                                   \
+  ((type *)arena_push((arena), sizeof(type) * (size_t)(count)))
+
+#endif // UTILS_ARENA_H
@@ -34,11 +34,19 @@
 /* ─── MIDI Conversion ───────────────────────────────────────────────────────
  */
 
-/* Convert MIDI note number to frequency (A4 = 69 = 440Hz) */
+/* 440 * 2^((n - 69) / 12) for n = 0..11; each octave up doubles it */
+static const float AUDIO_SEMITONE_HZ[12] = {
+    8.17579937f, 8.66195679f, 9.17702389f, 9.72271824f,
+    10.3008614f, 10.9133825f, 11.5623255f, 12.2498569f,
+    12.9782715f, 13.75f,      14.5676174f, 15.4338531f,
+};
+
+/* Convert MIDI note number to frequency (A4 = 69 = 440Hz).
+ * A table read and a power-of-two multiply, no powf. */
 static inline float audio_midi_to_freq(int32_t note) {
-  if (note == 0)
+  if (note <= 0 || note > 127)
     return 0.0f; /* 0 = rest/silence */
-  return 440.0f * powf(2.0f, (note - 69) / 12.0f);
+  return AUDIO_SEMITONE_HZ[note % 12] * (float)(1u << (note / 12));
 }
 
 /* Common MIDI note constants */
@@ -7,17 +7,41 @@
  * ═══════════════════════════════════════════════════════════════════════════
  */
 typedef struct {
-  uint32_t *pixels; /* RGBA pixel data (0xAARRGGBB format) */
+  uint32_t *pixels; /* GAME_RGBA-packed pixels, see below */
   int width;
   int height;
   int pitch;           /* Bytes per row (usually width * 4) */
   int bytes_per_pixel; /* Should be 4 for RGBA8888 */
 } Backbuffer;
 
+/* Pixel layout - chosen at compile time to match what the platform
+ * uploads, so neither we nor the driver ever swizzle:
+ *
+ *   X11 (desktop GL)  0xAARRGGBB = bytes B,G,R,A  -> GL_BGRA (default)
+ *   Raylib            0xAABBGGRR = bytes R,G,B,A  -> R8G8B8A8
+ *                     (build-dev.sh passes -DGAME_PIXEL_FORMAT_RGBA=1)
+ *
+ * Always pack with GAME_RGBA and unpack with GAME_COLOR_*; never shift by
+ * hand. */
+#if GAME_PIXEL_FORMAT_RGBA
+#define GAME_SHIFT_R 0
+#define GAME_SHIFT_B 16
+#else
+#define GAME_SHIFT_R 16
+#define GAME_SHIFT_B 0
+#endif
+#define GAME_SHIFT_G 8
+#define GAME_SHIFT_A 24
+
 /* Color helper - pack RGBA into uint32 */
 #define GAME_RGBA(r, g, b, a)                                                  \
-  (((uint32_t)(a) << 24) | ((uint32_t)(r) << 16) | ((uint32_t)(g) << 8) |      \
-   (uint32_t)(b))
+  (((uint32_t)(a) << GAME_SHIFT_A) | ((uint32_t)(r) << GAME_SHIFT_R) |         \
+   ((uint32_t)(g) << GAME_SHIFT_G) | ((uint32_t)(b) << GAME_SHIFT_B))
+
+#define GAME_COLOR_R(c) (((c) >> GAME_SHIFT_R) & 0xFF)
+#define GAME_COLOR_G(c) (((c) >> GAME_SHIFT_G) & 0xFF)
+#define GAME_COLOR_B(c) (((c) >> GAME_SHIFT_B) & 0xFF)
+#define GAME_COLOR_A(c) (((c) >> GAME_SHIFT_A) & 0xFF)
 
 #define GAME_RGB(r, g, b) GAME_RGBA(r, g, b, 255)
 
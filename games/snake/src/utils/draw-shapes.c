@@ -2,87 +2,156 @@
 #include "backbuffer.h"
 #include "math.h"
 
+#include <stdbool.h>
+#include <string.h>
+
+/* The engine's span kernels (SSE2 / AVX2 / NEON, picked at first use) do
+ * the per-pixel work; this game keeps its own Backbuffer and draws through
+ * a view of its pixels. Header-only, so nothing extra to link. */
+#include "../../../../engine/game/raster.h"
+
 /* ═══════════════════════════════════════════════════════════════════════════
  * Drawing Primitives
  * ═══════════════════════════════════════════════════════════════════════════
  */
 
+/* Writes `color` as-is to row[x0, x1), alpha included (no blending here).
+ * Glyph-sized spans stay inline: an indirect call costs more than a few
+ * stores. */
+static inline void fill_span(De100PixelKernels *kernels, uint32_t *row,
+                             int x0, int x1, uint32_t color) {
+  if (x1 - x0 < 16) {
+    for (int px = x0; px < x1; px++) {
+      row[px] = color;
+    }
+  } else {
+    kernels->fill_row(row + x0, x1 - x0, color);
+  }
+}
+
 void draw_rect(Backbuffer *bb, int x, int y, int w, int h, uint32_t color) {
   /* Clip to backbuffer bounds */
   int x0 = MAX(x, 0);
   int y0 = MAX(y, 0);
   int x1 = MIN(x + w, bb->width);
   int y1 = MIN(y + h, bb->height);
+  if (x1 <= x0) {
+    return;
+  }
 
+  De100PixelKernels *kernels = de100_pixel_kernels_get();
   for (int py = y0; py < y1; py++) {
-    uint32_t *row = bb->pixels + py * (bb->pitch / 4);
-    for (int px = x0; px < x1; px++) {
-      row[px] = color;
-    }
+    fill_span(kernels, bb->pixels + py * (bb->pitch / 4), x0, x1, color);
   }
 }
 
 void draw_rect_blend(Backbuffer *bb, int x, int y, int w, int h,
                      uint32_t color) {
-  // Extract alpha
-  uint8_t alpha = (color >> 24) & 0xFF;
+  /* out = (src * alpha + dst * (255 - alpha)) / 255 per channel, output
+   * alpha 255; opaque colors are a plain fill and alpha 0 draws nothing.
+   * Same bytes as the scalar loop this replaced, in either pixel format:
+   * alpha is the top byte in both and the blend treats the other three
+   * channels alike. */
+  GameBackBuffer view =
+      de100_backbuffer_view(bb->pixels, bb->width, bb->height, bb->pitch);
+  de100_raster_rect(&view, x, y, w, h, color);
+}
 
-  // If fully opaque, just draw the rect, we don't need to blend
-  if (alpha == 255) {
-    draw_rect(bb, x, y, w, h, color);
+/* ═══════════════════════════════════════════════════════════════════════════
+ * Cell Rows
+ * ═══════════════════════════════════════════════════════════════════════════
+ *
+ * A run of consecutive painted cells is a STRETCH.  Every scanline through
+ * a stretch's interior is the same, so the first one is built once (one
+ * fill per run of same-colored cells, then the gutters punched in) and
+ * copied to the rest; the gutter scanlines above and below are one fill
+ * each.  A full field row is a handful of long spans instead of a
+ * clipped draw_rect per cell.
+ */
+
+/* [x0, x1) clipped to the buffer; false when nothing is left */
+static inline bool clip_span(const Backbuffer *bb, int *x0, int *x1) {
+  *x0 = MAX(*x0, 0);
+  *x1 = MIN(*x1, bb->width);
+  return *x1 > *x0;
+}
+
+void draw_cell_row(Backbuffer *bb, int x, int y, int cell_size, int gap,
+                   uint32_t gap_color, const uint32_t *colors, int count) {
+  int y0 = MAX(y, 0);
+  int y1 = MIN(y + cell_size, bb->height);
+  if (y1 <= y0 || count <= 0 || cell_size <= 0) {
     return;
   }
+  gap = MIN(MAX(gap, 0), cell_size);
 
-  // If fully transparent, skip drawing
-  if (alpha == 0)
-    return;
+  /* Interior scanlines, and the first visible one (built, then copied) */
+  int inner_y0 = MAX(y + gap, y0);
+  int inner_y1 = MIN(y + cell_size - gap, y1);
+  bool has_inner = inner_y1 > inner_y0;
 
-  // Extract source RGB components
-  uint8_t src_r = (color >> 16) & 0xFF;
-  uint8_t src_g = (color >> 8) & 0xFF;
-  uint8_t src_b = color & 0xFF;
+  int pitch = bb->pitch / 4;
+  De100PixelKernels *kernels = de100_pixel_kernels_get();
 
-  // Clip to backbuffer bounds
-  int x0 = MAX(x, 0);
-  int y0 = MAX(y, 0);
-  int x1 = MIN(x + w, bb->width);
-  int y1 = MIN(y + h, bb->height);
+  int cell = 0;
+  while (cell < count) {
+    if (colors[cell] == DRAW_CELL_SKIP) {
+      cell++;
+      continue;
+    }
+    int first = cell;
+    while (cell < count && colors[cell] != DRAW_CELL_SKIP) {
+      cell++;
+    }
+    int sx0 = x + first * cell_size;
+    int sx1 = x + cell * cell_size;
+    if (!clip_span(bb, &sx0, &sx1)) {
+      continue;
+    }
 
-  // Draw the rectangle
-  for (int py = y0; py < y1; py++) {
-    // Pointer to the start of the current row in the backbuffer
-    uint32_t *row = bb->pixels + py * (bb->pitch / 4);
-    // Iterate over the pixels in the current row
-    for (int px = x0; px < x1; px++) {
-      // Extract the destination RGB components
-      uint32_t dst = row[px];
-      uint8_t dst_r = (dst >> 16) & 0xFF;
-      uint8_t dst_g = (dst >> 8) & 0xFF;
-      uint8_t dst_b = dst & 0xFF;
-
-      // Simple alpha blend: out = src * alpha + dst * (1 - alpha)
-      // How it works?!!
-      //   src * alpha
-      //   + dst * (1 - alpha)
-      //   -----------------------------
-      //   out = (src * alpha + dst * (255 - alpha)) / 255
-      // 255 is the max alpha value, so we divide by it to normalize back to
-      // 0-255 range
-      // Example: if alpha is 128 (50% transparent), then:
-      //   out = (src * 128 + dst * 127) / 255
-      // This means the output color will be a mix of 50% source and 50%
-      // destination colors
-      // If alpha is 64 (75% transparent), then:
-      //   out = (src * 64 + dst * 191) / 255
-      // This means the output color will be a mix of 25% source and 75%
-      // destination colors
-      // This is a simple linear interpolation between the source and
-      // destination colors based on the alpha value
-      uint8_t out_r = (src_r * alpha + dst_r * (255 - alpha)) / 255;
-      uint8_t out_g = (src_g * alpha + dst_g * (255 - alpha)) / 255;
-      uint8_t out_b = (src_b * alpha + dst_b * (255 - alpha)) / 255;
-
-      row[px] = GAME_RGB(out_r, out_g, out_b);
+    uint32_t *built = bb->pixels + inner_y0 * pitch;
+    if (has_inner) {
+      for (int run = first; run < cell;) {
+        int end = run + 1;
+        while (end < cell && colors[end] == colors[run]) {
+          end++;
+        }
+        int rx0 = x + run * cell_size;
+        int rx1 = x + end * cell_size;
+        if (clip_span(bb, &rx0, &rx1)) {
+          fill_span(kernels, built, rx0, rx1, colors[run]);
+        }
+        run = end;
+      }
+      for (int c = first; c < cell && gap > 0; c++) {
+        int cx = x + c * cell_size;
+        int lx0 = cx, lx1 = cx + gap;
+        int rx0 = cx + cell_size - gap, rx1 = cx + cell_size;
+        if (clip_span(bb, &lx0, &lx1)) {
+          fill_span(kernels, built, lx0, lx1, gap_color);
+        }
+        if (clip_span(bb, &rx0, &rx1)) {
+          fill_span(kernels, built, rx0, rx1, gap_color);
+        }
+      }
+    }
+
+    for (int py = y0; py < y1; py++) {
+      uint32_t *row = bb->pixels + py * pitch;
+      if (py < inner_y0 || py >= inner_y1) {
+        fill_span(kernels, row, sx0, sx1, gap_color);
+      } else if (py != inner_y0) {
+        memcpy(row + sx0, built + sx0, (size_t)(sx1 - sx0) * 4);
+      }
     }
   }
-}
\ No newline at end of file
+}
+
+void draw_cell_grid(Backbuffer *bb, int x, int y, int cell_size, int gap,
+                    uint32_t gap_color, const uint32_t *colors, int cols,
+                    int rows) {
+  for (int row = 0; row < rows; row++) {
+    draw_cell_row(bb, x, y + row * cell_size, cell_size, gap, gap_color,
+                  colors + (size_t)row * (size_t)cols, cols);
+  }
+}
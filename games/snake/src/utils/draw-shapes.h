@@ -8,4 +8,20 @@ void draw_rect(Backbuffer *bb, int x, int y, int w, int h, uint32_t color);
 void draw_rect_blend(Backbuffer *bb, int x, int y, int w, int h,
                      uint32_t color);
 
+/* Cells in a draw_cell_row / draw_cell_grid color array that are left
+ * as they are (alpha 0: no cell is ever drawn fully transparent) */
+#define DRAW_CELL_SKIP 0u
+
+/* A row of `count` square cells, `cell_size` pixels apart, starting at
+ * (x, y).  Every cell not DRAW_CELL_SKIP is painted whole: a `gap`-pixel
+ * gutter of `gap_color` on each side around colors[i].  Same pixels as a
+ * draw_rect per cell, in far fewer, longer spans. */
+void draw_cell_row(Backbuffer *bb, int x, int y, int cell_size, int gap,
+                   uint32_t gap_color, const uint32_t *colors, int count);
+
+/* draw_cell_row for each of `rows` rows of colors[rows][cols] */
+void draw_cell_grid(Backbuffer *bb, int x, int y, int cell_size, int gap,
+                    uint32_t gap_color, const uint32_t *colors, int cols,
+                    int rows);
+
 #endif // UTILS_DRAW_SHAPES_H
\ No newline at end of file
@@ -28,7 +28,9 @@ while [[ $# -gt 0 ]]; do
 done
 
 DE100_BACKEND_LIBS="-lm"
-SOURCES="src/game.c src/audio.c src/utils/draw-shapes.c src/utils/draw-text.c"
+SOURCES="src/game.c src/audio.c src/solver.c src/utils/draw-shapes.c src/utils/draw-text.c"
+BINARY="game"
+OPT_FLAGS="-g -O0"
 
 case "$BACKEND" in
     x11)
@@ -42,16 +44,37 @@ case "$BACKEND" in
             *)       DE100_BACKEND_LIBS="$DE100_BACKEND_LIBS -lraylib -lpthread -ldl" ;;
         esac
         SOURCES="$SOURCES src/main_raylib.c"
+        # Raylib textures are R8G8B8A8 only (see src/utils/backbuffer.h)
+        PIXEL_FORMAT_FLAGS="-DGAME_PIXEL_FORMAT_RGBA=1"
+    ;;
+    bench)
+        # Headless solver self-play; optimized so the numbers mean something
+        SOURCES="$SOURCES src/solver_bench.c"
+        BINARY="solver-bench"
+        OPT_FLAGS="-g -O2"
+    ;;
+    audio-bench)
+        # Headless game_get_audio_samples under synthetic voice loads; the
+        # voice cap is raised so the heavier loads fit
+        SOURCES="$SOURCES src/audio_bench.c"
+        BINARY="audio-bench"
+        OPT_FLAGS="-g -O2 -DMAX_SIMULTANEOUS_SOUNDS=256"
+    ;;
+    render-bench)
+        # Headless draw_rect / draw_rect_blend / draw_text throughput over
+        # buffer sizes and overdraw levels
+        SOURCES="$SOURCES src/render_bench.c"
+        BINARY="render-bench"
+        OPT_FLAGS="-g -O2"
     ;;
     *)
         echo "Error: Unknown backend '$BACKEND'" >&2
-        echo "Available: x11, raylib, auto" >&2
+        echo "Available: x11, raylib, bench, audio-bench, render-bench, auto" >&2
         exit 1
     ;;
 esac
 
-BINARY="game"
-FLAGS="-Wall -Wextra -g -O0"
+FLAGS="-Wall -Wextra $OPT_FLAGS $PIXEL_FORMAT_FLAGS"
 PLATFORM_EXE_PATH="./build/${BINARY}"
 
 clang $FLAGS -o "$PLATFORM_EXE_PATH" $SOURCES $DE100_BACKEND_LIBS
@@ -31,6 +31,91 @@ static const SoundDef SOUND_DEFS[SOUND_COUNT] = {
     [SOUND_RESTART] = {600, 1200, 200, 0.5f},
 };
 
+/* ═══════════════════════════════════════════════════════════════════════════
+ * Sound Cache (pre-rendered effects)
+ * ═══════════════════════════════════════════════════════════════════════════
+ * A SoundDef always produces the same samples: a square wave sliding
+ * from frequency to frequency_end, a short fade-in and a linear fade-out
+ * over its duration. So each one is rendered once per sample rate (by
+ * game_audio_init, or the first time it plays) into this pool, and a
+ * playing effect only reads it back with its pan and the sfx volume.
+ *
+ * The pool is static: it depends on nothing but the defs and the rate,
+ * so every GameAudioState shares it. Sized for 96 kHz; the defs add up
+ * to 1.83 s.
+ */
+
+#define SOUND_CACHE_MAX_SAMPLES (96000 * 2)
+#define SOUND_FADE_IN_SAMPLES 96 /* ~2ms fade-in */
+
+typedef struct {
+  int offset; /* Into SoundCache.samples */
+  int length; /* 0 = not rendered yet */
+} SoundCacheEntry;
+
+typedef struct {
+  float samples[SOUND_CACHE_MAX_SAMPLES];
+  SoundCacheEntry entries[SOUND_COUNT];
+  int samples_per_second; /* Rate every entry was rendered at */
+  int used;
+} SoundCache;
+
+static SoundCache g_sound_cache;
+
+/* The synth the mixer used to run per voice, run once */
+static void sound_render(const SoundDef *def, int samples_per_second,
+                         float *out, int total_samples) {
+  float inv_sample_rate = 1.0f / (float)samples_per_second;
+  float phase = 0.0f;
+  float frequency = def->frequency;
+  float frequency_slide =
+      def->frequency_end > 0
+          ? (def->frequency_end - def->frequency) / total_samples
+          : 0.0f;
+
+  for (int i = 0; i < total_samples; i++) {
+    float env = (float)(total_samples - i) / (float)total_samples;
+    if (i < SOUND_FADE_IN_SAMPLES)
+      env *= (float)i / (float)SOUND_FADE_IN_SAMPLES;
+
+    float wave = (phase < 0.5f) ? 1.0f : -1.0f;
+    out[i] = wave * def->volume * env;
+
+    phase += frequency * inv_sample_rate;
+    if (phase >= 1.0f)
+      phase -= 1.0f;
+    frequency += frequency_slide;
+  }
+}
+
+/* `sound`'s samples at `samples_per_second`, rendering them if needed.
+ * NULL (and no sound) if it is empty or doesn't fit the pool. */
+static const float *sound_cache_get(SOUND_ID sound, int samples_per_second,
+                                    int *length) {
+  SoundCache *cache = &g_sound_cache;
+  if (cache->samples_per_second != samples_per_second) {
+    memset(cache->entries, 0, sizeof(cache->entries));
+    cache->samples_per_second = samples_per_second;
+    cache->used = 0;
+  }
+
+  SoundCacheEntry *entry = &cache->entries[sound];
+  if (entry->length == 0) {
+    const SoundDef *def = &SOUND_DEFS[sound];
+    int total = (int)(def->duration_ms * samples_per_second / 1000.0f);
+    if (total <= 0 || cache->used + total > SOUND_CACHE_MAX_SAMPLES)
+      return NULL;
+    entry->offset = cache->used;
+    entry->length = total;
+    cache->used += total;
+    sound_render(def, samples_per_second, cache->samples + entry->offset,
+                 total);
+  }
+
+  *length = entry->length;
+  return cache->samples + entry->offset;
+}
+
 /* ═══════════════════════════════════════════════════════════════════════════
  * Tetris Theme Patterns
  * ═══════════════════════════════════════════════════════════════════════════
@@ -74,6 +159,14 @@ void game_audio_init(GameAudioState *audio, int samples_per_second) {
   memcpy(audio->music.patterns[1], TETRIS_PATTERN_B, MUSIC_PATTERN_LENGTH);
   memcpy(audio->music.patterns[2], TETRIS_PATTERN_C, MUSIC_PATTERN_LENGTH);
   memcpy(audio->music.patterns[3], TETRIS_PATTERN_D, MUSIC_PATTERN_LENGTH);
+
+  /* Render every effect now rather than on its first play */
+  if (samples_per_second > 0) {
+    for (int sound = SOUND_NONE + 1; sound < SOUND_COUNT; sound++) {
+      int length;
+      sound_cache_get((SOUND_ID)sound, samples_per_second, &length);
+    }
+  }
 }
 
 /* ═══════════════════════════════════════════════════════════════════════════
@@ -83,7 +176,14 @@ void game_audio_init(GameAudioState *audio, int samples_per_second) {
 
 void game_play_sound_at(GameAudioState *audio, SOUND_ID sound,
                         float pan_position) {
-  if (sound == SOUND_NONE || sound >= SOUND_COUNT)
+  if (sound == SOUND_NONE || sound >= SOUND_COUNT ||
+      audio->samples_per_second <= 0)
+    return;
+
+  int length;
+  const float *samples =
+      sound_cache_get(sound, audio->samples_per_second, &length);
+  if (!samples)
     return;
 
   int slot = -1;
@@ -98,17 +198,12 @@ void game_play_sound_at(GameAudioState *audio, SOUND_ID sound,
     slot = 0;
   }
 
-  const SoundDef *def = &SOUND_DEFS[sound];
   SoundInstance *inst = &audio->active_sounds[slot];
 
   inst->sound_id = sound;
-  inst->phase = 0.0f;
-  inst->frequency = def->frequency;
-  inst->volume = def->volume;
-  inst->samples_remaining =
-      (int)(def->duration_ms * audio->samples_per_second / 1000.0f);
-  inst->total_samples = inst->samples_remaining;
-  inst->fade_in_samples = 96; /* ~2ms fade-in */
+  inst->samples = samples;
+  inst->samples_remaining = length;
+  inst->total_samples = length;
 
   /* Clamp pan position to valid range */
   if (pan_position < -1.0f)
@@ -116,13 +211,7 @@ void game_play_sound_at(GameAudioState *audio, SOUND_ID sound,
   if (pan_position > 1.0f)
     pan_position = 1.0f;
   inst->pan_position = pan_position;
-
-  if (def->frequency_end > 0 && inst->samples_remaining > 0) {
-    inst->frequency_slide =
-        (def->frequency_end - def->frequency) / inst->samples_remaining;
-  } else {
-    inst->frequency_slide = 0;
-  }
+  calculate_pan_volumes(pan_position, &inst->left_gain, &inst->right_gain);
 }
 
 /* Original function - plays centered */
@@ -184,21 +273,35 @@ void game_audio_update(GameAudioState *audio, float delta_time) {
 /* ═══════════════════════════════════════════════════════════════════════════
  * Generate Audio Samples (with stereo panning!)
  * ═══════════════════════════════════════════════════════════════════════════
+ * Effects are pre-rendered (see the sound cache): a voice is a read of
+ * its PCM times two constant gains. The music's gain is evaluated once
+ * per control block of AUDIO_CONTROL_FRAMES and ramped linearly across
+ * it, so its per-sample work is the oscillator plus a multiply-add per
+ * channel.
  */
 
+#define AUDIO_CONTROL_FRAMES 32
+
 void game_get_audio_samples(GameState *state, AudioOutputBuffer *buffer) {
   GameAudioState *audio = &state->audio;
   int16_t *out = buffer->samples;
   int sample_count = buffer->sample_count;
   float inv_sample_rate = 1.0f / (float)buffer->samples_per_second;
-
-  memset(out, 0, sample_count * 2 * sizeof(int16_t));
+  float master = audio->master_volume * 16000.0f;
+  float sfx_volume = audio->sfx_volume;
 
   const float VOLUME_RAMP_SPEED = 0.002f;
 
-  for (int s = 0; s < sample_count; s++) {
-    float mixed_left = 0.0f;
-    float mixed_right = 0.0f;
+  float mix_left[AUDIO_CONTROL_FRAMES];
+  float mix_right[AUDIO_CONTROL_FRAMES];
+
+  for (int start = 0; start < sample_count; start += AUDIO_CONTROL_FRAMES) {
+    int count = sample_count - start;
+    if (count > AUDIO_CONTROL_FRAMES)
+      count = AUDIO_CONTROL_FRAMES;
+
+    memset(mix_left, 0, sizeof(mix_left));
+    memset(mix_right, 0, sizeof(mix_right));
 
     /* ─── Sound Effects (with panning) ─── */
     for (int i = 0; i < MAX_SIMULTANEOUS_SOUNDS; i++) {
@@ -206,73 +309,71 @@ void game_get_audio_samples(GameState *state, AudioOutputBuffer *buffer) {
       if (inst->samples_remaining <= 0)
         continue;
 
-      float wave = (inst->phase < 0.5f) ? 1.0f : -1.0f;
+      int run = count;
+      if (run > inst->samples_remaining)
+        run = inst->samples_remaining;
 
-      /* Envelope: fade-out at end */
-      float env = (float)inst->samples_remaining / (float)inst->total_samples;
+      const float *pcm =
+          inst->samples + (inst->total_samples - inst->samples_remaining);
+      float left_gain = inst->left_gain * sfx_volume;
+      float right_gain = inst->right_gain * sfx_volume;
 
-      /* Fade-in at start */
-      int samples_played = inst->total_samples - inst->samples_remaining;
-      if (samples_played < inst->fade_in_samples) {
-        float fade_in = (float)samples_played / (float)inst->fade_in_samples;
-        env *= fade_in;
+      for (int s = 0; s < run; s++) {
+        mix_left[s] += pcm[s] * left_gain;
+        mix_right[s] += pcm[s] * right_gain;
       }
-
-      float sample = wave * inst->volume * env * audio->sfx_volume;
-
-      /* Apply panning */
-      float left_vol, right_vol;
-      calculate_pan_volumes(inst->pan_position, &left_vol, &right_vol);
-
-      mixed_left += sample * left_vol;
-      mixed_right += sample * right_vol;
-
-      inst->phase += inst->frequency * inv_sample_rate;
-      if (inst->phase >= 1.0f)
-        inst->phase -= 1.0f;
-
-      inst->frequency += inst->frequency_slide;
-      inst->samples_remaining--;
+      inst->samples_remaining -= run;
     }
 
     /* ─── Music (with optional panning) ─── */
     if (audio->music.is_playing) {
       ToneGenerator *tone = &audio->music.tone;
 
+      /* Same ramp as stepping VOLUME_RAMP_SPEED per sample, taken a block
+       * at a time: it's linear, so only the endpoint needs computing */
       float target_volume = tone->is_playing ? tone->volume : 0.0f;
-
-      if (tone->current_volume < target_volume) {
-        tone->current_volume += VOLUME_RAMP_SPEED;
-        if (tone->current_volume > target_volume)
-          tone->current_volume = target_volume;
-      } else if (tone->current_volume > target_volume) {
-        tone->current_volume -= VOLUME_RAMP_SPEED;
-        if (tone->current_volume < 0.0f)
-          tone->current_volume = 0.0f;
+      float max_change = VOLUME_RAMP_SPEED * (float)count;
+      float volume = tone->current_volume;
+      float volume_end = volume;
+
+      if (volume_end < target_volume) {
+        volume_end += max_change;
+        if (volume_end > target_volume)
+          volume_end = target_volume;
+      } else if (volume_end > target_volume) {
+        volume_end -= max_change;
+        if (volume_end < target_volume)
+          volume_end = target_volume;
       }
+      tone->current_volume = volume_end;
 
-      if (tone->current_volume > 0.0001f || tone->is_playing) {
-        float wave = (tone->phase < 0.5f) ? 1.0f : -1.0f;
-        float sample = wave * tone->current_volume * audio->music_volume;
-
-        /* Apply panning to music */
+      if (volume > 0.0001f || volume_end > 0.0001f || tone->is_playing) {
         float left_vol, right_vol;
         calculate_pan_volumes(tone->pan_position, &left_vol, &right_vol);
 
-        mixed_left += sample * left_vol;
-        mixed_right += sample * right_vol;
+        float gain = volume * audio->music_volume;
+        float gain_step =
+            (volume_end - volume) * audio->music_volume / (float)count;
 
-        tone->phase += tone->frequency * inv_sample_rate;
-        if (tone->phase >= 1.0f)
-          tone->phase -= 1.0f;
+        for (int s = 0; s < count; s++) {
+          float wave = (tone->phase < 0.5f) ? 1.0f : -1.0f;
+          float sample = wave * gain;
+          gain += gain_step;
+
+          mix_left[s] += sample * left_vol;
+          mix_right[s] += sample * right_vol;
+
+          tone->phase += tone->frequency * inv_sample_rate;
+          if (tone->phase >= 1.0f)
+            tone->phase -= 1.0f;
+        }
       }
     }
 
     /* ─── Final Mix ─── */
-    mixed_left *= audio->master_volume * 16000.0f;
-    mixed_right *= audio->master_volume * 16000.0f;
-
-    *out++ = clamp_sample(mixed_left);  /* Left */
-    *out++ = clamp_sample(mixed_right); /* Right */
+    for (int s = 0; s < count; s++) {
+      *out++ = clamp_sample(mix_left[s] * master);  /* Left */
+      *out++ = clamp_sample(mix_right[s] * master); /* Right */
+    }
   }
 }
@@ -0,0 +1,125 @@
+/* ═══════════════════════════════════════════════════════════════════════════
+ * Audio Benchmark — game_get_audio_samples under synthetic voice loads
+ * ═══════════════════════════════════════════════════════════════════════════
+ *
+ * Build & run:  ./build-dev.sh --backend=audio-bench -r
+ *               ./build/audio-bench [seconds_of_audio] [seed]
+ *
+ * For 1, 16, 64 and 256 concurrent sound effects (random sound and pan,
+ * music playing) renders `seconds_of_audio` at 48 kHz in 800-frame calls,
+ * one 60 Hz frame each, and prints ns/sample (per stereo frame), the
+ * realtime factor and voices/core (voices × realtime factor: how many
+ * voices one core could mix in real time at this load).
+ *
+ * Effects are short, so the load is topped back up to N before every call,
+ * the way a busy game would trigger them.  Loads above MAX_SIMULTANEOUS_SOUNDS
+ * are clamped (the build raises it to 256).  Same seed ⇒ same output, so
+ * the checksum doubles as a check that a mixer change didn't alter it.
+ */
+
+#include "game.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define BENCH_SAMPLE_RATE 48000
+#define BENCH_CALL_FRAMES 800
+
+static const int bench_voice_counts[] = {1, 16, 64, 256};
+
+static uint32_t bench_rand(uint32_t *state) {
+  /* xorshift32 — the game's rand() is not reproducible across libcs */
+  uint32_t x = *state;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  return *state = x;
+}
+
+static double bench_seconds(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static void bench_top_up(GameAudioState *audio, int voices, uint32_t *seed) {
+  int active = 0;
+  for (int i = 0; i < MAX_SIMULTANEOUS_SOUNDS; i++) {
+    if (audio->active_sounds[i].samples_remaining > 0)
+      active++;
+  }
+  for (; active < voices; active++) {
+    SOUND_ID sound = (SOUND_ID)(SOUND_NONE + 1 +
+                                bench_rand(seed) % (SOUND_COUNT - 1));
+    float pan = (float)(bench_rand(seed) % 2001) / 1000.0f - 1.0f;
+    game_play_sound_at(audio, sound, pan);
+  }
+}
+
+int main(int argc, char **argv) {
+  double audio_seconds = argc > 1 ? atof(argv[1]) : 10.0;
+  uint32_t seed = argc > 2 ? (uint32_t)strtoul(argv[2], NULL, 10) : 1;
+  if (seed == 0)
+    seed = 1; /* xorshift's only fixed point */
+  if (audio_seconds <= 0.0)
+    audio_seconds = 10.0;
+
+  GameState *state = calloc(1, sizeof(GameState));
+  int16_t *samples = malloc(sizeof(int16_t) * 2 * BENCH_CALL_FRAMES);
+  if (!state || !samples) {
+    fprintf(stderr, "out of memory\n");
+    return 1;
+  }
+
+  long long total_frames = (long long)(audio_seconds * BENCH_SAMPLE_RATE);
+  float call_seconds = (float)BENCH_CALL_FRAMES / BENCH_SAMPLE_RATE;
+
+  printf("%.1f s of audio per load, %d-frame calls, voice cap %d, seed %u\n\n",
+         audio_seconds, BENCH_CALL_FRAMES, MAX_SIMULTANEOUS_SOUNDS, seed);
+  printf("%6s %12s %12s %12s %14s\n", "voices", "ns/sample", "x realtime",
+         "voices/core", "checksum");
+
+  int load_count =
+      (int)(sizeof(bench_voice_counts) / sizeof(bench_voice_counts[0]));
+  for (int load = 0; load < load_count; load++) {
+    int voices = bench_voice_counts[load];
+    if (voices > MAX_SIMULTANEOUS_SOUNDS)
+      voices = MAX_SIMULTANEOUS_SOUNDS;
+
+    uint32_t load_seed = seed;
+    game_audio_init(&state->audio, BENCH_SAMPLE_RATE);
+    game_music_play(&state->audio);
+
+    AudioOutputBuffer buffer = {
+        .samples = samples,
+        .samples_per_second = BENCH_SAMPLE_RATE,
+    };
+
+    long long checksum = 0;
+    double start = bench_seconds();
+    for (long long done = 0; done < total_frames;) {
+      long long left = total_frames - done;
+      buffer.sample_count =
+          (int)(left < BENCH_CALL_FRAMES ? left : BENCH_CALL_FRAMES);
+      bench_top_up(&state->audio, voices, &load_seed);
+      game_audio_update(&state->audio, call_seconds);
+      game_get_audio_samples(state, &buffer);
+      for (int i = 0; i < buffer.sample_count * 2; i++)
+        checksum += samples[i];
+      done += buffer.sample_count;
+    }
+    double elapsed = bench_seconds() - start;
+    if (elapsed <= 0.0)
+      elapsed = 1e-9;
+
+    double realtime = audio_seconds / elapsed;
+    printf("%6d %12.2f %12.1f %12.0f %14lld\n", voices,
+           elapsed * 1e9 / (double)total_frames, realtime,
+           (double)voices * realtime, checksum);
+  }
+
+  free(samples);
+  free(state);
+  return 0;
+}
@@ -7,6 +7,9 @@
 #include <string.h>
 #include <time.h>
 
+/* Digits straight into the buffer, and only when the value changes */
+#include "../../../engine/game/format.h"
+
 /* ═══════════════════════════════════════════════════════════════════════════
  * Tetromino Data
  * ═══════════════════════════════════════════════════════════════════════════
@@ -36,6 +39,64 @@ const char *TETROMINOES[TETROMINOS_COUNT] = {
     TETROMINO_T, //
     TETROMINO_Z, //
 };
+
+/* ═══════════════════════════════════════════════════════════════════════════
+ * Tetromino Bitboards
+ * ═══════════════════════════════════════════════════════════════════════════
+ *
+ * The strings above as 16-bit shapes (bit i = character i is 'X'), then
+ * expanded by the preprocessor into one row mask per rotation and row.
+ * Everything is an integer constant expression, so the table is built
+ * by the compiler — no init code, no runtime string lookups.
+ *
+ *   "..X...X..XX....." (J)  →  0x0644  →  R_0 rows { 0x4, 0x4, 0x6, 0x0 }
+ */
+
+#define TETROMINO_SHAPE_I 0x4444
+#define TETROMINO_SHAPE_J 0x0644
+#define TETROMINO_SHAPE_L 0x0622
+#define TETROMINO_SHAPE_O 0x0660
+#define TETROMINO_SHAPE_S 0x0462
+#define TETROMINO_SHAPE_T 0x0464
+#define TETROMINO_SHAPE_Z 0x0264
+
+/* Same mapping as tetromino_pos_value(), usable in constant expressions */
+#define TETROMINO_POS_VALUE(px, py, r)                                         \
+  ((r) == TETROMINO_R_0    ? (py) * 4 + (px)                                   \
+   : (r) == TETROMINO_R_90  ? 12 + (py) - (px) * 4                             \
+   : (r) == TETROMINO_R_180 ? 15 - (py) * 4 - (px)                             \
+                            : 3 - (py) + (px) * 4)
+
+#define TETROMINO_CELL(shape, px, py, r)                                       \
+  (((shape) >> TETROMINO_POS_VALUE(px, py, r)) & 1)
+
+#define TETROMINO_ROW(shape, r, py)                                            \
+  (uint16_t)(TETROMINO_CELL(shape, 0, py, r) |                                 \
+             TETROMINO_CELL(shape, 1, py, r) << 1 |                            \
+             TETROMINO_CELL(shape, 2, py, r) << 2 |                            \
+             TETROMINO_CELL(shape, 3, py, r) << 3)
+
+#define TETROMINO_ROTATION(shape, r)                                           \
+  {TETROMINO_ROW(shape, r, 0), TETROMINO_ROW(shape, r, 1),                     \
+   TETROMINO_ROW(shape, r, 2), TETROMINO_ROW(shape, r, 3)}
+
+#define TETROMINO_ROTATIONS(shape)                                             \
+  {TETROMINO_ROTATION(shape, TETROMINO_R_0),                                   \
+   TETROMINO_ROTATION(shape, TETROMINO_R_90),                                  \
+   TETROMINO_ROTATION(shape, TETROMINO_R_180),                                 \
+   TETROMINO_ROTATION(shape, TETROMINO_R_270)}
+
+const uint16_t TETROMINO_ROW_MASKS[TETROMINOS_COUNT][TETROMINO_ROTATION_COUNT]
+                                  [TETROMINO_LAYER_COUNT] = {
+    TETROMINO_ROTATIONS(TETROMINO_SHAPE_I), //
+    TETROMINO_ROTATIONS(TETROMINO_SHAPE_J), //
+    TETROMINO_ROTATIONS(TETROMINO_SHAPE_L), //
+    TETROMINO_ROTATIONS(TETROMINO_SHAPE_O), //
+    TETROMINO_ROTATIONS(TETROMINO_SHAPE_S), //
+    TETROMINO_ROTATIONS(TETROMINO_SHAPE_T), //
+    TETROMINO_ROTATIONS(TETROMINO_SHAPE_Z), //
+};
+
 /* ═══════════════════════════════════════════════════════════════════════════
  * Game-Specific Drawing
  * ═══════════════════════════════════════════════════════════════════════════
@@ -62,99 +123,92 @@ static uint32_t get_tetromino_color(TETROMINO_BY_IDX index) {
   }
 }
 
-static void draw_cell(Backbuffer *bb, int col, int row, uint32_t color) {
-  int x = col * CELL_SIZE + 1;
-  int y = row * CELL_SIZE + 1;
-  int w = CELL_SIZE - 2;
-  int h = CELL_SIZE - 2;
-  draw_rect(bb, x, y, w, h, color);
+/* What draw_cell_grid paints for a field cell: a 1 px black gutter
+   around its color.  Empty cells are all black, which repaints a
+   cleared cell; callers pass DRAW_CELL_SKIP where nothing changed. */
+static uint32_t field_cell_color(unsigned char cell_value) {
+  switch (cell_value) {
+  case TETRIS_FIELD_I:
+  case TETRIS_FIELD_J:
+  case TETRIS_FIELD_L:
+  case TETRIS_FIELD_O:
+  case TETRIS_FIELD_S:
+  case TETRIS_FIELD_T:
+  case TETRIS_FIELD_Z:
+    return get_tetromino_color(cell_value - 1);
+  case TETRIS_FIELD_WALL:
+    return COLOR_GRAY;
+  case TETRIS_FIELD_TMP_FLASH:
+    return COLOR_WHITE;
+  default:
+    return COLOR_BLACK;
+  }
 }
 
-static void draw_piece(Backbuffer *bb, int piece_index, int field_col,
-                       int field_row, uint32_t color,
-                       TETROMINO_R_DIR rotation) {
+/* Puts the piece's blocks into cell_colors over the field's.  Blocks
+   outside the field are dropped (a fitting piece has none). */
+static void compose_piece(const GameState *state, uint32_t *cell_colors,
+                          int piece_index, int rotation, int field_col,
+                          int field_row) {
+  uint32_t color = get_tetromino_color(piece_index);
   for (int py = 0; py < TETROMINO_LAYER_COUNT; py++) {
-    for (int px = 0; px < TETROMINO_LAYER_COUNT; px++) {
-      int pi = tetromino_pos_value(px, py, rotation);
-      if (TETROMINOES[piece_index][pi] == TETROMINO_BLOCK) {
-        draw_cell(bb, field_col + px, field_row + py, color);
-      }
+    int row = field_row + py;
+    uint16_t mask = TETROMINO_ROW_MASKS[piece_index][rotation][py];
+    for (int px = 0; mask; px++, mask >>= 1) {
+      int col = field_col + px;
+      if (!(mask & 1) || row < 0 || row >= state->field_height || col < 0 ||
+          col >= state->field_width)
+        continue;
+      cell_colors[row * state->field_width + col] = color;
     }
   }
 }
 
+/* The whole field in one pass: runs of same-colored cells go out as
+   single spans instead of a draw_rect per cell. */
+static void draw_field(Backbuffer *bb, const GameState *state,
+                       const uint32_t *cell_colors) {
+  draw_cell_grid(bb, 0, 0, CELL_SIZE, 1, COLOR_BLACK, cell_colors,
+                 state->field_width, state->field_height);
+}
+
 /* ═══════════════════════════════════════════════════════════════════════════
- * Main Render Function - Called by Platform Layer
+ * HUD Sidebar
  * ═══════════════════════════════════════════════════════════════════════════
  */
 
-void game_render(Backbuffer *backbuffer, GameState *state) {
-  /* Clear to black */
-  for (int i = 0; i < backbuffer->width * backbuffer->height; i++) {
-    backbuffer->pixels[i] = COLOR_BLACK;
-  }
-
-  /* ═══════════════════════════════════════════════════════════════════
-   * Draw the field
-   * ═══════════════════════════════════════════════════════════════════ */
-  for (int row = 0; row < FIELD_HEIGHT; row++) {
-    for (int col = 0; col < FIELD_WIDTH; col++) {
-      unsigned char cell_value = state->field[row * FIELD_WIDTH + col];
-
-      switch (cell_value) {
-      case TETRIS_FIELD_EMPTY:
-        continue;
-      case TETRIS_FIELD_I:
-      case TETRIS_FIELD_J:
-      case TETRIS_FIELD_L:
-      case TETRIS_FIELD_O:
-      case TETRIS_FIELD_S:
-      case TETRIS_FIELD_T:
-      case TETRIS_FIELD_Z:
-        draw_cell(backbuffer, col, row, get_tetromino_color(cell_value - 1));
-        break;
-      case TETRIS_FIELD_WALL:
-        draw_cell(backbuffer, col, row, COLOR_GRAY);
-        break;
-      case TETRIS_FIELD_TMP_FLASH:
-        draw_cell(backbuffer, col, row, COLOR_WHITE);
-        break;
-      }
-    }
-  }
-
-  /* ═══════════════════════════════════════════════════════════════════
-   * Draw the current falling piece
-   * ═══════════════════════════════════════════════════════════════════ */
-  draw_piece(backbuffer, state->current_piece.index, state->current_piece.x,
-             state->current_piece.y,
-             get_tetromino_color(state->current_piece.index),
-             state->current_piece.rotate_x_value);
+#define HUD_X(state) ((state)->field_width * CELL_SIZE + 10)
+#define HUD_Y 10
+#define HUD_HINT_Y(state) ((state)->field_height * CELL_SIZE - 90)
 
-  /* ═══════════════════════════════════════════════════════════════════
-   * Draw the HUD sidebar
-   * ═══════════════════════════════════════════════════════════════════ */
-  int sx = FIELD_WIDTH * CELL_SIZE + 10;
-  int sy = 10;
-  char buf[32];
+/* Score, level, piece count and next-piece preview — everything in the
+   sidebar above the controls hint. */
+static void draw_hud_stats(Backbuffer *bb, const GameState *state) {
+  int sx = HUD_X(state);
+  int sy = HUD_Y;
+  /* Number runs: re-formatted only when their value changes */
+  static De100FormatCache score_text, level_text, pieces_text;
 
   /* Score */
-  draw_text(backbuffer, sx, sy, "SCORE", COLOR_WHITE, 2);
-  snprintf(buf, sizeof(buf), "%d", state->score);
-  draw_text(backbuffer, sx, sy + 16, buf, COLOR_YELLOW, 2);
+  draw_text(bb, sx, sy, "SCORE", COLOR_WHITE, 2);
+  draw_text(bb, sx, sy + 16,
+            de100_format_cached_i32(&score_text, "", state->score),
+            COLOR_YELLOW, 2);
 
   /* Level */
-  draw_text(backbuffer, sx, sy + 40, "LEVEL", COLOR_WHITE, 2);
-  snprintf(buf, sizeof(buf), "%d", state->level);
-  draw_text(backbuffer, sx, sy + 56, buf, COLOR_CYAN, 2);
+  draw_text(bb, sx, sy + 40, "LEVEL", COLOR_WHITE, 2);
+  draw_text(bb, sx, sy + 56,
+            de100_format_cached_i32(&level_text, "", state->level), COLOR_CYAN,
+            2);
 
   /* Pieces */
-  draw_text(backbuffer, sx + 80, sy + 40, "PIECES", COLOR_WHITE, 2);
-  snprintf(buf, sizeof(buf), "%d", state->pieces_count);
-  draw_text(backbuffer, sx + 80, sy + 56, buf, COLOR_CYAN, 2);
+  draw_text(bb, sx + 80, sy + 40, "PIECES", COLOR_WHITE, 2);
+  draw_text(bb, sx + 80, sy + 56,
+            de100_format_cached_i32(&pieces_text, "", state->pieces_count),
+            COLOR_CYAN, 2);
 
   /* Next piece label */
-  draw_text(backbuffer, sx, sy + 85, "NEXT", COLOR_WHITE, 2);
+  draw_text(bb, sx, sy + 85, "NEXT", COLOR_WHITE, 2);
 
   /* Next piece preview */
   int preview_x = sx;
@@ -166,45 +220,232 @@ void game_render(Backbuffer *backbuffer, GameState *state) {
       if (TETROMINOES[state->current_piece.next_index]
                      [tetromino_pos_value(px, py, 0)] == TETROMINO_BLOCK) {
         uint32_t color = get_tetromino_color(state->current_piece.next_index);
-        draw_rect(backbuffer, preview_x + px * preview_cell_size + 1,
+        draw_rect(bb, preview_x + px * preview_cell_size + 1,
                   preview_y + py * preview_cell_size + 1, preview_cell_size - 2,
                   preview_cell_size - 2, color);
       }
     }
   }
+}
+
+static void draw_controls_hint(Backbuffer *bb, const GameState *state) {
+  int sx = HUD_X(state);
+  int hint_y = HUD_HINT_Y(state);
+  draw_text(bb, sx, hint_y, "CONTROLS", COLOR_DARK_GRAY, 1);
+  draw_text(bb, sx, hint_y + 18, "{} MOVE LEFT/RIGHT", COLOR_DARK_GRAY, 1);
+  draw_text(bb, sx, hint_y + 28, "v  SOFT DROP", COLOR_DARK_GRAY, 1);
+  draw_text(bb, sx, hint_y + 38, "Z  ROTATE LEFT", COLOR_DARK_GRAY, 1);
+  draw_text(bb, sx, hint_y + 48, "X  ROTATE RIGHT", COLOR_DARK_GRAY, 1);
+  draw_text(bb, sx, hint_y + 58, "R  RESTART", COLOR_DARK_GRAY, 1);
+  draw_text(bb, sx, hint_y + 68, "Q  QUIT", COLOR_DARK_GRAY, 1);
+}
+
+static void draw_game_over(Backbuffer *bb, const GameState *state) {
+  int cx = state->field_width * CELL_SIZE / 2;
+  int cy = state->field_height * CELL_SIZE / 2;
+
+  /* Semi-transparent overlay */
+  draw_rect_blend(bb, cx - 80, cy - 50, 160, 100, GAME_RGBA(0, 0, 0, 200));
+
+  /* Red border */
+  draw_rect(bb, cx - 80, cy - 50, 160, 3, COLOR_RED);
+  draw_rect(bb, cx - 80, cy + 47, 160, 3, COLOR_RED);
+  draw_rect(bb, cx - 80, cy - 50, 3, 100, COLOR_RED);
+  draw_rect(bb, cx + 77, cy - 50, 3, 100, COLOR_RED);
+
+  /* Game over text */
+  draw_text(bb, cx - 54, cy - 30, "GAME OVER", COLOR_RED, 2);
+  draw_text(bb, cx - 60, cy, "R RESTART", COLOR_WHITE, 2);
+  draw_text(bb, cx - 45, cy + 20, "Q QUIT", COLOR_WHITE, 2);
+}
+
+/* ═══════════════════════════════════════════════════════════════════════════
+ * Render Cache
+ * ═══════════════════════════════════════════════════════════════════════════
+ */
+
+static void render_cache_store(GameRenderCache *cache, const Backbuffer *bb,
+                               const GameState *state) {
+  cache->is_valid = true;
+  cache->pixels = bb->pixels;
+  cache->width = bb->width;
+  cache->height = bb->height;
+
+  memcpy(cache->field, state->field,
+         (size_t)state->field_width * (size_t)state->field_height);
+  cache->piece_index = state->current_piece.index;
+  cache->piece_x = state->current_piece.x;
+  cache->piece_y = state->current_piece.y;
+  cache->piece_rotation = state->current_piece.rotate_x_value;
+
+  cache->score = state->score;
+  cache->level = state->level;
+  cache->pieces_count = state->pieces_count;
+  cache->next_index = state->current_piece.next_index;
+  cache->is_game_over = state->is_game_over;
+}
+
+/* Flags the field cells a piece covers; returns how many were new. */
+static int mark_piece_cells(const GameState *state, bool *is_cell_dirty,
+                            int piece_index, int rotation, int field_col,
+                            int field_row) {
+  int marked = 0;
+  for (int py = 0; py < TETROMINO_LAYER_COUNT; py++) {
+    int row = field_row + py;
+    uint16_t mask = TETROMINO_ROW_MASKS[piece_index][rotation][py];
+    for (int px = 0; mask; px++, mask >>= 1) {
+      int col = field_col + px;
+      if (!(mask & 1) || row < 0 || row >= state->field_height || col < 0 ||
+          col >= state->field_width)
+        continue;
+      int i = row * state->field_width + col;
+      marked += !is_cell_dirty[i];
+      is_cell_dirty[i] = true;
+    }
+  }
+  return marked;
+}
+
+/* ═══════════════════════════════════════════════════════════════════════════
+ * Main Render Function - Called by Platform Layer
+ * ═══════════════════════════════════════════════════════════════════════════
+ */
+
+static void render_full(Backbuffer *backbuffer, GameState *state) {
+  /* Clear to black */
+  for (int i = 0; i < backbuffer->width * backbuffer->height; i++) {
+    backbuffer->pixels[i] = COLOR_BLACK;
+  }
+
+  /* Empty cells are already black */
+  uint32_t *cell_colors = state->render_cache.cell_colors;
+  int field_cells = state->field_width * state->field_height;
+  for (int i = 0; i < field_cells; i++) {
+    cell_colors[i] = state->field[i] == TETRIS_FIELD_EMPTY
+                         ? DRAW_CELL_SKIP
+                         : field_cell_color(state->field[i]);
+  }
+  const CurrentPiece *piece = &state->current_piece;
+  compose_piece(state, cell_colors, piece->index, piece->rotate_x_value,
+                piece->x, piece->y);
+  draw_field(backbuffer, state, cell_colors);
+
+  draw_hud_stats(backbuffer, state);
+  draw_controls_hint(backbuffer, state);
+
+  if (state->is_game_over)
+    draw_game_over(backbuffer, state);
+
+  backbuffer_mark_dirty(backbuffer, 0, 0, backbuffer->width,
+                        backbuffer->height);
+}
+
+/* The backbuffer keeps last frame's pixels, so it doubles as the static
+ * layer: walls, locked cells and the controls hint stay put until
+ * something overwrites them.  Each frame we diff the state against
+ * render_cache and repaint only
+ *
+ *   - field cells whose value changed (lock, line flash, collapse),
+ *   - the cells under the piece's old and new position,
+ *   - the sidebar stats, if any number or the next piece changed.
+ *
+ * The game-over overlay blends over the field, so toggling it (or any
+ * change underneath it) falls back to a full repaint. */
+void game_render(Backbuffer *backbuffer, GameState *state) {
+  GameRenderCache *cache = &state->render_cache;
+  backbuffer_clear_dirty(backbuffer);
+
+  if (!cache->is_valid || cache->pixels != backbuffer->pixels ||
+      cache->width != backbuffer->width ||
+      cache->height != backbuffer->height ||
+      cache->is_game_over != state->is_game_over) {
+    render_full(backbuffer, state);
+    render_cache_store(cache, backbuffer, state);
+    return;
+  }
 
-  /* Controls hint */
-  int hint_y = FIELD_HEIGHT * CELL_SIZE - 90;
-  draw_text(backbuffer, sx, hint_y, "CONTROLS", COLOR_DARK_GRAY, 1);
-  draw_text(backbuffer, sx, hint_y + 18, "{} MOVE LEFT/RIGHT", COLOR_DARK_GRAY,
-            1);
-  draw_text(backbuffer, sx, hint_y + 28, "v  SOFT DROP", COLOR_DARK_GRAY, 1);
-  draw_text(backbuffer, sx, hint_y + 38, "Z  ROTATE LEFT", COLOR_DARK_GRAY, 1);
-  draw_text(backbuffer, sx, hint_y + 48, "X  ROTATE RIGHT", COLOR_DARK_GRAY, 1);
-  draw_text(backbuffer, sx, hint_y + 58, "R  RESTART", COLOR_DARK_GRAY, 1);
-  draw_text(backbuffer, sx, hint_y + 68, "Q  QUIT", COLOR_DARK_GRAY, 1);
   /* ═══════════════════════════════════════════════════════════════════
-   * Game over overlay
+   * Work out what changed
    * ═══════════════════════════════════════════════════════════════════ */
+  int field_cells = state->field_width * state->field_height;
+  bool *is_cell_dirty = cache->is_cell_dirty;
+  memset(is_cell_dirty, 0, (size_t)field_cells * sizeof(bool));
+  int dirty_cells = 0;
+
+  for (int i = 0; i < field_cells; i++) {
+    if (state->field[i] != cache->field[i]) {
+      is_cell_dirty[i] = true;
+      dirty_cells++;
+    }
+  }
+
+  const CurrentPiece *piece = &state->current_piece;
+  bool has_piece_moved =
+      (int)piece->index != cache->piece_index || piece->x != cache->piece_x ||
+      piece->y != cache->piece_y ||
+      (int)piece->rotate_x_value != cache->piece_rotation;
+
+  if (has_piece_moved || dirty_cells) {
+    /* The old footprint needs erasing; the new one is repainted on top
+       of whatever field cells changed beneath it. */
+    dirty_cells += mark_piece_cells(state, is_cell_dirty, cache->piece_index,
+                                    cache->piece_rotation, cache->piece_x,
+                                    cache->piece_y);
+    dirty_cells +=
+        mark_piece_cells(state, is_cell_dirty, piece->index,
+                         piece->rotate_x_value, piece->x, piece->y);
+  }
+
+  bool is_hud_dirty = state->score != cache->score ||
+                      state->level != cache->level ||
+                      state->pieces_count != cache->pieces_count ||
+                      (int)piece->next_index != cache->next_index;
+
+  if (!dirty_cells && !is_hud_dirty)
+    return; /* Idle frame: nothing to draw, nothing to upload */
+
   if (state->is_game_over) {
-    int cx = FIELD_WIDTH * CELL_SIZE / 2;
-    int cy = FIELD_HEIGHT * CELL_SIZE / 2;
-
-    /* Semi-transparent overlay */
-    draw_rect_blend(backbuffer, cx - 80, cy - 50, 160, 100,
-                    GAME_RGBA(0, 0, 0, 200));
-
-    /* Red border */
-    draw_rect(backbuffer, cx - 80, cy - 50, 160, 3, COLOR_RED);
-    draw_rect(backbuffer, cx - 80, cy + 47, 160, 3, COLOR_RED);
-    draw_rect(backbuffer, cx - 80, cy - 50, 3, 100, COLOR_RED);
-    draw_rect(backbuffer, cx + 77, cy - 50, 3, 100, COLOR_RED);
-
-    /* Game over text */
-    draw_text(backbuffer, cx - 54, cy - 30, "GAME OVER", COLOR_RED, 2);
-    draw_text(backbuffer, cx - 60, cy, "R RESTART", COLOR_WHITE, 2);
-    draw_text(backbuffer, cx - 45, cy + 20, "Q QUIT", COLOR_WHITE, 2);
+    render_full(backbuffer, state);
+    render_cache_store(cache, backbuffer, state);
+    return;
+  }
+
+  /* ═══════════════════════════════════════════════════════════════════
+   * Repaint the field cells, then the falling piece over them
+   * ═══════════════════════════════════════════════════════════════════ */
+  if (dirty_cells) {
+    /* The piece's cells are all dirty, so it lands on repainted cells */
+    uint32_t *cell_colors = cache->cell_colors;
+    for (int i = 0; i < field_cells; i++) {
+      cell_colors[i] = is_cell_dirty[i] ? field_cell_color(state->field[i])
+                                        : DRAW_CELL_SKIP;
+    }
+    compose_piece(state, cell_colors, piece->index, piece->rotate_x_value,
+                  piece->x, piece->y);
+    draw_field(backbuffer, state, cell_colors);
+
+    for (int row = 0; row < state->field_height; row++) {
+      for (int col = 0; col < state->field_width; col++) {
+        if (is_cell_dirty[row * state->field_width + col])
+          backbuffer_mark_dirty(backbuffer, col * CELL_SIZE, row * CELL_SIZE,
+                                CELL_SIZE, CELL_SIZE);
+      }
+    }
   }
+
+  /* ═══════════════════════════════════════════════════════════════════
+   * Repaint the HUD stats (the controls hint below never changes)
+   * ═══════════════════════════════════════════════════════════════════ */
+  if (is_hud_dirty) {
+    int hud_x = state->field_width * CELL_SIZE;
+    draw_rect(backbuffer, hud_x, 0, backbuffer->width - hud_x,
+              HUD_HINT_Y(state), COLOR_BLACK);
+    draw_hud_stats(backbuffer, state);
+    backbuffer_mark_dirty(backbuffer, hud_x, 0, backbuffer->width - hud_x,
+                          HUD_HINT_Y(state));
+  }
+
+  render_cache_store(cache, backbuffer, state);
 }
 
 /* ═══════════════════════════════════════════════════════════════════════════
@@ -212,6 +453,43 @@ void game_render(Backbuffer *backbuffer, GameState *state) {
  * ═══════════════════════════════════════════════════════════════════════════
  */
 
+/* ═══════════════════════════════════════════════════════════════════════════
+ * Field Storage
+ * ═══════════════════════════════════════════════════════════════════════════
+ */
+
+static bool field_size_is_valid(int width, int height) {
+  return width >= FIELD_MIN_WIDTH && width <= FIELD_MAX_WIDTH &&
+         height >= FIELD_MIN_HEIGHT && height <= FIELD_MAX_HEIGHT;
+}
+
+size_t tetris_field_size(int width, int height) {
+  if (!field_size_is_valid(width, height))
+    return 0;
+  size_t cells = (size_t)width * (size_t)height;
+  return 2 * ARENA_SIZE_OF(cells) + ARENA_SIZE_OF(sizeof(bool) * cells) +
+         ARENA_SIZE_OF(sizeof(uint32_t) * cells) +
+         ARENA_SIZE_OF(sizeof(uint16_t) * (size_t)height);
+}
+
+bool tetris_field_alloc(GameState *state, Arena *arena, int width,
+                        int height) {
+  size_t needed = tetris_field_size(width, height);
+  if (needed == 0 || needed > arena->size - arena->used)
+    return false;
+
+  int cells = width * height;
+  state->field_width = width;
+  state->field_height = height;
+  state->field = ARENA_PUSH_ARRAY(arena, unsigned char, cells);
+  state->field_rows = ARENA_PUSH_ARRAY(arena, uint16_t, height);
+  state->render_cache.field = ARENA_PUSH_ARRAY(arena, unsigned char, cells);
+  state->render_cache.is_cell_dirty = ARENA_PUSH_ARRAY(arena, bool, cells);
+  state->render_cache.cell_colors = ARENA_PUSH_ARRAY(arena, uint32_t, cells);
+  state->render_cache.is_valid = false;
+  return true;
+}
+
 void game_init(GameState *state) {
   state->score = 0;
   state->is_game_over = false;
@@ -245,14 +523,18 @@ void game_init(GameState *state) {
   state->input_repeat.move_down.interval = 0.03f;
 
   /* Build the boundary walls. */
-  for (int y = 0; y < FIELD_HEIGHT; y++) {
-    for (int x = 0; x < FIELD_WIDTH; x++) {
+  int width = state->field_width;
+  int height = state->field_height;
+  for (int y = 0; y < height; y++) {
+    state->field_rows[y] =
+        y == height - 1 ? FIELD_ROW_FULL(width) : FIELD_ROW_WALLS(width);
+    for (int x = 0; x < width; x++) {
       /* Left wall, right wall, or floor → value 9 */
-      if (x == 0 || x == FIELD_WIDTH - 1 || y == FIELD_HEIGHT - 1) {
-        state->field[y * FIELD_WIDTH + x] = TETRIS_FIELD_WALL;
+      if (x == 0 || x == width - 1 || y == height - 1) {
+        state->field[y * width + x] = TETRIS_FIELD_WALL;
       } else {
         /* Everything else stays 0 (empty) */
-        state->field[y * FIELD_WIDTH + x] = TETRIS_FIELD_EMPTY;
+        state->field[y * width + x] = TETRIS_FIELD_EMPTY;
       }
     }
   }
@@ -261,7 +543,7 @@ void game_init(GameState *state) {
   srand((unsigned int)time(NULL));
   state->current_piece = (CurrentPiece){
       /*  center-ish, start in the middle of the field */
-      .x = (FIELD_WIDTH * 0.5) - (TETROMINO_LAYER_COUNT * 0.5),
+      .x = (width * 0.5) - (TETROMINO_LAYER_COUNT * 0.5),
       .y = 0,
       .index = rand() % TETROMINOS_COUNT,
       .next_index = rand() % TETROMINOS_COUNT,
@@ -292,63 +574,24 @@ int tetromino_does_piece_fit(GameState *state, int piece, int rotation,
   if (piece < 0 || piece >= TETROMINOS_COUNT)
     return 0;
 
-  for (int py = 0; py < 4; py++) {
-    for (int px = 0; px < 4; px++) {
-      /* Which character in the piece string? */
-      int pi = tetromino_pos_value(px, py, rotation);
-
-      /* Skip empty cells in the piece */
-      if (TETROMINOES[piece][pi] == TETROMINO_SPAN)
-        continue;
-
-      /* Where would this cell land in the field? */
-      int field_x = pos_x + px;
-      int field_y = pos_y + py;
-
-      /* Skip if outside the field bounds
-         (piece's 4×4 box can hang outside on the sides) */
-      if (field_x < 0 || field_x >= FIELD_WIDTH)
-        continue;
-      if (field_y < 0 || field_y >= FIELD_HEIGHT)
-        continue;
-
-      /* Field index for this position */
-      int fi = field_y * FIELD_WIDTH + field_x;
-
-      /* If the field cell is not empty → doesn't fit */
-      if (state->field[fi] != 0)
-        return 0;
-    }
-  }
-  return 1; /* all solid cells checked — it fits */
+  /* Checked several times a frame by input and gravity: the standard
+   * field takes the copy with constant bounds */
+  if (tetris_field_is_standard(state->field_width, state->field_height))
+    return tetromino_rows_fit(state->field_rows, FIELD_WIDTH, FIELD_HEIGHT,
+                              piece, rotation, pos_x, pos_y);
+  return tetromino_rows_fit(state->field_rows, state->field_width,
+                            state->field_height, piece, rotation, pos_x,
+                            pos_y);
 }
 
 /* Reset transition counts — they're per-frame */
 void prepare_input_frame(GameInput *old_input, GameInput *current_input) {
-  printf("Before\n");
-  // DEBUG: Print what was copied
-  printf("[PREPARE] current_input->current: left=%d right=%d down=%d\n",
-         current_input->move_left.ended_down,
-         current_input->move_right.ended_down,
-         current_input->move_down.half_transition_count);
-  printf("[PREPARE] old_input->current: left=%d right=%d down=%d\n",
-         old_input->move_left.ended_down, old_input->move_right.ended_down,
-         old_input->move_down.half_transition_count);
-  // Copy button state, reset transitions
+  /* Copy button state, reset transitions */
   for (int btn = 0; btn < BUTTON_COUNT; btn++) {
     current_input->buttons[btn].ended_down = old_input->buttons[btn].ended_down;
     current_input->buttons[btn].half_transition_count = 0;
   }
-  printf("After\n");
-  // DEBUG: Print what was copied
-  printf("[PREPARE] current_input->current: left=%d right=%d down=%d\n",
-         current_input->move_left.ended_down,
-         current_input->move_right.ended_down,
-         current_input->move_down.half_transition_count);
-  printf("[PREPARE] old_input->current: left=%d right=%d down=%d\n",
-         old_input->move_left.ended_down, old_input->move_right.ended_down,
-         old_input->move_down.half_transition_count);
-};
+}
 
 /**
  * Process an action with auto-repeat behavior.
@@ -409,7 +652,7 @@ static void handle_action_with_repeat(GameButtonState *button,
 
 /* Calculate pan position based on piece X position */
 /* Returns -1.0 (left) to 1.0 (right) */
-static float calculate_piece_pan(int piece_x) {
+static float calculate_piece_pan(int piece_x, int field_width) {
   /* Field is 12 wide (including walls)
    * Playable area: columns 1-10 (walls at 0 and 11)
    * Center column: ~5.5
@@ -418,8 +661,8 @@ static float calculate_piece_pan(int piece_x) {
    * piece_x = 5 (center)    → pan = 0.0
    * piece_x = 10 (far right) → pan = 0.8
    */
-  float center = (FIELD_WIDTH - 2) / 2.0f + 1.0f; /* ~6.0 */
-  float max_offset = (FIELD_WIDTH - 2) / 2.0f;    /* ~5.0 */
+  float center = (field_width - 2) / 2.0f + 1.0f; /* ~6.0 */
+  float max_offset = (field_width - 2) / 2.0f;    /* ~5.0 */
 
   float offset = (float)piece_x - center;
   float pan = (offset / max_offset) * 0.8f; /* Scale to ±0.8, not full ±1.0 */
@@ -435,7 +678,7 @@ static float calculate_piece_pan(int piece_x) {
 
 void tetris_apply_input(GameState *state, GameInput *input, float delta_time) {
   /* Calculate current pan position based on piece location */
-  float pan = calculate_piece_pan(state->current_piece.x);
+  float pan = calculate_piece_pan(state->current_piece.x, state->field_width);
 
   /* Rotate clockwise: try rotation + 1. (% 4 wraps 3 back to 0.) */
   if (input->rotate_x.ended_down &&
@@ -565,6 +808,7 @@ void game_update(GameState *state, GameInput *input, float delta_time) {
        * By processing bottom-to-top (row 15 first), we avoid this problem.
        * After collapsing row 15, row 14 is still at row 14.
        */
+      int width = state->field_width;
       for (int i = state->completed_lines.count - 1; i >= 0; i--) {
         int line_index = state->completed_lines.indexes[i];
 
@@ -573,16 +817,18 @@ void game_update(GameState *state, GameInput *input, float delta_time) {
          * We skip row 0 in the copy (nothing above it to copy from).
          */
         for (int py = line_index; py > 0; --py) {
-          for (int px = 1; px < FIELD_WIDTH - 1; ++px) {
-            state->field[py * FIELD_WIDTH + px] =
-                state->field[(py - 1) * FIELD_WIDTH + px];
+          for (int px = 1; px < width - 1; ++px) {
+            state->field[py * width + px] =
+                state->field[(py - 1) * width + px];
           }
+          state->field_rows[py] = state->field_rows[py - 1];
         }
 
         /* Clear the top row (row 0) — it has no row above to copy from */
-        for (int px = 1; px < FIELD_WIDTH - 1; px++) {
+        for (int px = 1; px < width - 1; px++) {
           state->field[px] = TETRIS_FIELD_EMPTY;
         }
+        state->field_rows[0] = FIELD_ROW_WALLS(width);
 
         /* Adjust remaining line indices.
          * All lines we haven't processed yet (indices 0 to i-1) are
@@ -638,6 +884,8 @@ void game_update(GameState *state, GameInput *input, float delta_time) {
       state->current_piece.y++;
     } else {
       /* If it doesn't fit, piece has landed - locking in lesson 09 */
+      int width = state->field_width;
+      int height = state->field_height;
       for (int px = 0; px < TETROMINO_LAYER_COUNT; ++px) {
         for (int py = 0; py < TETROMINO_LAYER_COUNT; ++py) {
           int pi =
@@ -645,15 +893,25 @@ void game_update(GameState *state, GameInput *input, float delta_time) {
           if (TETROMINOES[state->current_piece.index][pi] != TETROMINO_SPAN) {
             int fx = state->current_piece.x + px;
             int fy = state->current_piece.y + py;
-            if (fx >= 0 && fx < FIELD_WIDTH && fy >= 0 && fy < FIELD_HEIGHT) {
-              state->field[fy * FIELD_WIDTH + fx] =
+            if (fx >= 0 && fx < width && fy >= 0 && fy < height) {
+              state->field[fy * width + fx] =
                   state->current_piece.index +
                   1; // Store piece index + 1 (0 is empty) for rendering
             }
           }
         }
       }
-      float pan = calculate_piece_pan(state->current_piece.x);
+      /* Same cells into the bitboard, one OR per piece row */
+      for (int py = 0; py < TETROMINO_LAYER_COUNT; ++py) {
+        int fy = state->current_piece.y + py;
+        if (fy >= 0 && fy < height) {
+          state->field_rows[fy] |= tetromino_row_at(
+              TETROMINO_ROW_MASKS[state->current_piece.index]
+                                 [state->current_piece.rotate_x_value][py],
+              state->current_piece.x, width);
+        }
+      }
+      float pan = calculate_piece_pan(state->current_piece.x, width);
       game_play_sound_at(&state->audio, SOUND_DROP, pan);
 
       state->completed_lines.count = 0;
@@ -662,22 +920,16 @@ void game_update(GameState *state, GameInput *input, float delta_time) {
         int row_y = state->current_piece.y + py;
 
         /* Skip if outside playable area (above top or at/below floor) */
-        if (row_y < 0 || row_y >= FIELD_HEIGHT - 1) {
+        if (row_y < 0 || row_y >= height - 1) {
           continue;
         }
 
-        bool completed = 1;
-        for (int px = 1; px < FIELD_WIDTH - 1; ++px) {
-          /* Tag this row: value `TETRIS_FIELD_EMPTY` = white in the renderer */
-          if (state->field[(row_y)*FIELD_WIDTH + px] == TETRIS_FIELD_EMPTY) {
-            completed = false;
-            break;
-          }
-        }
+        /* Walls included, a complete row is every bit set */
+        bool completed = state->field_rows[row_y] == FIELD_ROW_FULL(width);
 
         if (completed) {
-          for (int px = 1; px < FIELD_WIDTH - 1; ++px) {
-            state->field[(row_y)*FIELD_WIDTH + px] = TETRIS_FIELD_TMP_FLASH;
+          for (int px = 1; px < width - 1; ++px) {
+            state->field[(row_y)*width + px] = TETRIS_FIELD_TMP_FLASH;
           }
 
           state->completed_lines.indexes[state->completed_lines.count++] =
@@ -705,7 +957,7 @@ void game_update(GameState *state, GameInput *input, float delta_time) {
       // reset drop-timer and current piece for next round
       state->input_values.rotate_direction.timer = 0.0f;
       state->current_piece = (CurrentPiece){
-          .x = (FIELD_WIDTH * 0.5) - (TETROMINO_LAYER_COUNT * 0.5),
+          .x = (width * 0.5) - (TETROMINO_LAYER_COUNT * 0.5),
           .y = 0,
           .index = state->current_piece.next_index,
           .next_index = rand() % TETROMINOS_COUNT,
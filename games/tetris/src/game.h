@@ -1,11 +1,17 @@
 #ifndef GAME_H
 #define GAME_H
 
+#include "utils/arena.h"
 #include "utils/audio.h"
 #include "utils/backbuffer.h"
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
+/* The standard field, walls and floor included.  Fields of any size in
+ * the FIELD_MIN/MAX range are allocated at runtime (tetris_field_alloc);
+ * this one also gets compiled-in copies of the hot paths with the size
+ * as constants (see tetromino_does_piece_fit, tetris_solver_best). */
 #define FIELD_WIDTH 12
 #define FIELD_HEIGHT 18
 #define CELL_SIZE 30
@@ -17,6 +23,21 @@
 #define TETROMINO_LAYER_COUNT 4
 #define TETROMINO_SIZE 16
 #define TETROMINOS_COUNT 7
+#define TETROMINO_ROTATION_COUNT 4
+
+/* Bitboard rows: bit x of field_rows[y] is set when field[y][x] is not
+ * empty (block, wall or flashing line).  A row must fit 16 bits; a
+ * field must hold a piece box and floor, and stays small enough for the
+ * solver to copy boards on the stack. */
+#define FIELD_MIN_WIDTH 6
+#define FIELD_MAX_WIDTH 16
+#define FIELD_MIN_HEIGHT 6
+#define FIELD_MAX_HEIGHT 256
+#if FIELD_WIDTH > FIELD_MAX_WIDTH
+#error "FIELD_WIDTH must fit in a 16-bit row mask"
+#endif
+#define FIELD_ROW_FULL(width) ((uint16_t)((1u << (width)) - 1))
+#define FIELD_ROW_WALLS(width) ((uint16_t)(1u | (1u << ((width) - 1))))
 
 /* Predefined colors */
 #define COLOR_BLACK GAME_RGB(0, 0, 0)
@@ -152,8 +173,34 @@ typedef struct {
     }                                                                          \
   } while (0)
 
+/* ── Render cache ───────────────────────────────────── */
+
+/* What the backbuffer currently shows.  The backbuffer itself is the
+   cached static layer: game_render compares this snapshot against the
+   live state and repaints only the cells, piece and sidebar that
+   differ, so a frame where nothing moved touches no pixels at all. */
 typedef struct {
-  unsigned char field[FIELD_WIDTH * FIELD_HEIGHT]; /* the play field */
+  bool is_valid;
+  const uint32_t *pixels; /* backbuffer it was drawn into */
+  int width, height;
+
+  /* From the field arena, field_width * field_height each */
+  unsigned char *field;
+  bool *is_cell_dirty;   /* game_render's scratch */
+  uint32_t *cell_colors; /* ditto: what draw_cell_grid paints per cell */
+  int piece_index, piece_x, piece_y, piece_rotation;
+
+  int score, level, pieces_count, next_index;
+  bool is_game_over;
+} GameRenderCache;
+
+typedef struct {
+  /* Set once by tetris_field_alloc; game_init keeps them */
+  int field_width;  /* walls included */
+  int field_height; /* floor included */
+  unsigned char *field;  /* [field_width * field_height], the play field */
+  uint16_t *field_rows;  /* [field_height], occupancy bitboard of field[] */
+
   CurrentPiece current_piece;
   int score;
   int pieces_count; /* total pieces locked — used for difficulty scaling */
@@ -183,6 +230,8 @@ typedef struct {
   GameAudioState audio;
   int should_quit;    /* 1 if window closed or Escape pressed */
   int should_restart; /* 1 if R pressed this frame */
+
+  GameRenderCache render_cache; /* owned by game_render */
 } GameState;
 
 /* ── Piece data ─────────────────────────────────────── */
@@ -192,6 +241,61 @@ typedef struct {
    "trust me, it exists somewhere else." */
 extern const char *TETROMINOES[7];
 
+/* The same pieces as bitboards: TETROMINO_ROW_MASKS[piece][rotation][py]
+   has bit px set where the rotated piece has a block at (px, py).
+   Built at compile time from the TETROMINO_POS_VALUE rotation rule. */
+extern const uint16_t TETROMINO_ROW_MASKS[TETROMINOS_COUNT]
+                                         [TETROMINO_ROTATION_COUNT]
+                                         [TETROMINO_LAYER_COUNT];
+
+/* A piece row moved to field column `pos_x`.  Columns that fall outside
+ * a `width`-column field are dropped, like the old per-cell bounds skip. */
+static inline uint16_t tetromino_row_at(uint16_t row, int pos_x, int width) {
+  uint32_t shifted =
+      pos_x >= 0 ? (uint32_t)row << pos_x : (uint32_t)row >> -pos_x;
+  return (uint16_t)(shifted & FIELD_ROW_FULL(width));
+}
+
+/* Piece-fit against any occupancy bitboard — the live field or a
+   solver's scratch copy.  One AND per piece row; rows above/below the
+   field are skipped, the same as the old per-cell bounds check.  The
+   size is passed rather than read from a state, so callers passing
+   FIELD_WIDTH/FIELD_HEIGHT get the bounds as constants. */
+static inline int tetromino_rows_fit(const uint16_t *rows, int width,
+                                     int height, int piece, int rotation,
+                                     int pos_x, int pos_y) {
+  const uint16_t *masks = TETROMINO_ROW_MASKS[piece][rotation & 3];
+  for (int py = 0; py < TETROMINO_LAYER_COUNT; py++) {
+    int field_y = pos_y + py;
+    if (field_y < 0 || field_y >= height)
+      continue;
+    if (rows[field_y] & tetromino_row_at(masks[py], pos_x, width))
+      return 0;
+  }
+  return 1;
+}
+
+static inline bool tetris_field_is_standard(int width, int height) {
+  return width == FIELD_WIDTH && height == FIELD_HEIGHT;
+}
+
+/* Have the compiler paste a size-generic body into each specialization
+ * instead of leaving one shared, runtime-sized copy */
+#if defined(__GNUC__) || defined(__clang__)
+#define TETRIS_FORCE_INLINE inline __attribute__((always_inline))
+#else
+#define TETRIS_FORCE_INLINE inline
+#endif
+
+/* Field storage: the play field, its bitboard and the render cache's
+ * copies for a width × height field (walls and floor included), carved
+ * out of `arena` once.  Call before game_init, which keeps it.
+ * tetris_field_size is what the arena needs (0 when the size is out of
+ * range). */
+size_t tetris_field_size(int width, int height);
+bool tetris_field_alloc(GameState *state, Arena *arena, int width,
+                        int height);
+
 /* Initialization */
 void game_init(GameState *state);
 void prepare_input_frame(GameInput *old_input, GameInput *new_input);
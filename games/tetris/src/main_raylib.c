@@ -248,6 +248,14 @@ int main(void) {
   GameInput *old_input = &inputs[1];
 
   GameState game_state = {0};
+  /* The window is sized for the standard field (platform.h) */
+  Arena field_arena;
+  if (!arena_init(&field_arena, tetris_field_size(FIELD_WIDTH, FIELD_HEIGHT)) ||
+      !tetris_field_alloc(&game_state, &field_arena, FIELD_WIDTH,
+                          FIELD_HEIGHT)) {
+    fprintf(stderr, "Failed to allocate the field\n");
+    return 1;
+  }
   game_init(&game_state);
 
   game_audio_init(&game_state.audio,
@@ -322,7 +330,15 @@ int main(void) {
     /* ═══════════════════════════════════════════════════════════════════
      * Display
      * ═══════════════════════════════════════════════════════════════════ */
-    UpdateTexture(g_raylib.texture, platform_game_props.backbuffer.pixels);
+    /* Upload only the rows game_render touched (full-width rows are
+     * contiguous in the backbuffer); idle frames upload nothing */
+    Backbuffer *bb = &platform_game_props.backbuffer;
+    if (backbuffer_is_dirty(bb)) {
+      Rectangle rows = {0, (float)bb->dirty_y0, (float)bb->width,
+                        (float)(bb->dirty_y1 - bb->dirty_y0)};
+      UpdateTextureRec(g_raylib.texture, rows,
+                       bb->pixels + bb->dirty_y0 * (bb->pitch / 4));
+    }
 
     BeginDrawing();
     ClearBackground(BLACK);
@@ -342,6 +358,7 @@ int main(void) {
     platform_swap_input_buffers(old_input, current_input);
   }
 
+  arena_free(&field_arena);
   platform_game_props_free(&platform_game_props);
   platform_shutdown();
   return 0;
@@ -392,6 +392,10 @@ int platform_init(PlatformGameProps *platform_game_props) {
   glBindTexture(GL_TEXTURE_2D, g_x11.texture_id);
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+  /* Allocate storage once; frames only upload their dirty rows */
+  glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, platform_game_props->backbuffer.width,
+               platform_game_props->backbuffer.height, 0, GL_BGRA,
+               GL_UNSIGNED_INT_8_8_8_8_REV, NULL);
 
   setup_vsync();
 
@@ -564,8 +568,15 @@ static void platform_display_backbuffer(Backbuffer *bb) {
   if (offset_y < 0)
     offset_y = 0;
   glBindTexture(GL_TEXTURE_2D, g_x11.texture_id);
-  glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, bb->width, bb->height, 0, GL_RGBA,
-               GL_UNSIGNED_BYTE, bb->pixels);
+  /* 0xAARRGGBB pixels are desktop GL's native BGRA: no conversion.
+   * Only the rows game_render touched go up; an idle frame uploads
+   * nothing and just re-presents the texture. */
+  if (backbuffer_is_dirty(bb)) {
+    int rows = bb->dirty_y1 - bb->dirty_y0;
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, bb->dirty_y0, bb->width, rows,
+                    GL_BGRA, GL_UNSIGNED_INT_8_8_8_8_REV,
+                    bb->pixels + bb->dirty_y0 * (bb->pitch / 4));
+  }
   glBegin(GL_QUADS);
   glTexCoord2f(0.0f, 0.0f);
   glVertex2f(offset_x, offset_y);
@@ -599,6 +610,14 @@ int main(void) {
   GameInput *old_input = &inputs[1];
 
   GameState game_state = {0};
+  /* The window is sized for the standard field (platform.h) */
+  Arena field_arena;
+  if (!arena_init(&field_arena, tetris_field_size(FIELD_WIDTH, FIELD_HEIGHT)) ||
+      !tetris_field_alloc(&game_state, &field_arena, FIELD_WIDTH,
+                          FIELD_HEIGHT)) {
+    fprintf(stderr, "Failed to allocate the field\n");
+    return 1;
+  }
   game_init(&game_state);
 
   if (platform_game_props.audio.is_initialized) {
@@ -617,10 +636,6 @@ int main(void) {
     prepare_input_frame(old_input, current_input);
     platform_get_input(&game_state, current_input, &platform_game_props);
 
-    if (current_input->move_left.ended_down) {
-      printf("Move Left: %d\n", current_input->move_left.half_transition_count);
-    }
-
     if (game_state.should_quit) {
       break;
     }
@@ -640,6 +655,7 @@ int main(void) {
     platform_swap_input_buffers(old_input, current_input);
   }
 
+  arena_free(&field_arena);
   platform_game_props_free(&platform_game_props);
   platform_shutdown();
   return 0;
@@ -0,0 +1,254 @@
+/* ═══════════════════════════════════════════════════════════════════════════
+ * Render Benchmark — draw_rect / draw_rect_blend / draw_text, no window
+ * ═══════════════════════════════════════════════════════════════════════════
+ *
+ * Build & run:  ./build-dev.sh --backend=render-bench -r
+ *               ./build/render-bench [frames] [seed]
+ *
+ * For each backbuffer size (320x240 .. 3840x2160), each overdraw level
+ * (every pixel covered 1x / 4x on average) and each primitive:
+ *
+ *   rect         draw_rect, opaque
+ *   rect_blend   draw_rect_blend, alpha 128
+ *   text_hud     draw_text, short HUD strings (the layout cache path)
+ *   text_glyphs  draw_text, long lines (past the cache: draw_char per glyph)
+ *
+ * draws `frames` frames of the same scene and prints Mpix/s and cycles/px
+ * (__rdtsc ticks, TSC rate: compare runs on one machine only) from the
+ * fastest frame, plus an FNV-1a checksum of the frame.  Same seed ⇒ same
+ * checksum, so a drawing change that alters output shows up in the diff.
+ *
+ * Pixels are what each call nominally covers: the rect area, or a 5x7
+ * glyph box per character at its scale.  Scenes add up to overdraw ×
+ * buffer.  The engine's primitives have their own bench
+ * (engine/tools/render-bench.c).
+ */
+
+#include "utils/draw-shapes.h"
+#include "utils/draw-text.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h> /* __rdtsc() */
+#endif
+
+/* draw-text.c's font: 5x7 glyphs */
+#define BENCH_GLYPH_WIDTH 5
+#define BENCH_GLYPH_HEIGHT 7
+#define BENCH_TEXT_SCALE 2
+
+typedef enum {
+  BENCH_PRIM_RECT = 0,
+  BENCH_PRIM_RECT_BLEND,
+  BENCH_PRIM_TEXT_HUD,
+  BENCH_PRIM_TEXT_GLYPHS,
+  BENCH_PRIM_COUNT
+} BenchPrimitive;
+
+static const char *bench_prim_names[BENCH_PRIM_COUNT] = {
+    "rect", "rect_blend", "text_hud", "text_glyphs"};
+
+static const int bench_sizes[][2] = {
+    {320, 240}, {640, 480}, {1280, 720}, {1920, 1080}, {3840, 2160}};
+
+static const int bench_overdraws[] = {1, 4};
+
+static const char *bench_hud_strings[] = {"SCORE", "LEVEL 3", "LINES 42",
+                                          "NEXT", "PAUSED"};
+
+/* 52 glyphs: longer than the layout cache takes */
+static const char bench_long_string[] =
+    "THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG 0123456789";
+
+typedef struct {
+  int x, y;
+  uint32_t color;
+  const char *text;
+} BenchItem;
+
+static uint32_t bench_rand(uint32_t *state) {
+  uint32_t x = *state;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  return *state = x;
+}
+
+static double bench_seconds(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static uint64_t bench_cycles(void) {
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  return 0; /* cycles/px reads 0: no counter on this target */
+#endif
+}
+
+static uint32_t bench_checksum(const Backbuffer *bb) {
+  uint32_t hash = 2166136261u;
+  for (int y = 0; y < bb->height; y++) {
+    const uint8_t *row = (const uint8_t *)bb->pixels + y * bb->pitch;
+    for (int i = 0; i < bb->width * 4; i++)
+      hash = (hash ^ row[i]) * 16777619u;
+  }
+  return hash;
+}
+
+static long long bench_text_pixels(const char *text) {
+  long long glyphs = 0;
+  for (; *text; text++) {
+    if (*text != ' ')
+      glyphs++;
+  }
+  return glyphs * BENCH_GLYPH_WIDTH * BENCH_GLYPH_HEIGHT * BENCH_TEXT_SCALE *
+         BENCH_TEXT_SCALE;
+}
+
+/* Items until they nominally cover overdraw × buffer; all fully on-screen */
+static int bench_build_scene(BenchPrimitive prim, int width, int height,
+                             int overdraw, uint32_t seed, BenchItem *items,
+                             int max_items, long long *out_pixels) {
+  int rect_w = width / 8;
+  int rect_h = height / 8;
+  long long target = (long long)width * height * overdraw;
+  long long pixels = 0;
+  int count = 0;
+
+  while (pixels < target && count < max_items) {
+    BenchItem *item = &items[count];
+    item->color = GAME_RGBA(bench_rand(&seed) & 0xFF, bench_rand(&seed) & 0xFF,
+                            bench_rand(&seed) & 0xFF,
+                            prim == BENCH_PRIM_RECT_BLEND ? 128 : 255);
+    item->text = prim == BENCH_PRIM_TEXT_GLYPHS
+                     ? bench_long_string
+                     : bench_hud_strings[bench_rand(&seed) % 5];
+
+    int item_w = rect_w;
+    int item_h = rect_h;
+    if (prim == BENCH_PRIM_TEXT_HUD || prim == BENCH_PRIM_TEXT_GLYPHS) {
+      item_w = (int)strlen(item->text) * 6 * BENCH_TEXT_SCALE;
+      item_h = BENCH_GLYPH_HEIGHT * BENCH_TEXT_SCALE;
+      pixels += bench_text_pixels(item->text);
+    } else {
+      pixels += (long long)rect_w * rect_h;
+    }
+    /* Long lines are wider than the smallest buffer; let those clip */
+    int span_x = width - item_w > 0 ? width - item_w + 1 : 1;
+    item->x = (int)(bench_rand(&seed) % (uint32_t)span_x);
+    item->y = (int)(bench_rand(&seed) % (uint32_t)(height - item_h + 1));
+    count++;
+  }
+
+  *out_pixels = pixels;
+  return count;
+}
+
+static void bench_draw(BenchPrimitive prim, Backbuffer *bb,
+                       const BenchItem *items, int count) {
+  int rect_w = bb->width / 8;
+  int rect_h = bb->height / 8;
+  for (int i = 0; i < count; i++) {
+    const BenchItem *item = &items[i];
+    switch (prim) {
+    case BENCH_PRIM_RECT:
+      draw_rect(bb, item->x, item->y, rect_w, rect_h, item->color);
+      break;
+    case BENCH_PRIM_RECT_BLEND:
+      draw_rect_blend(bb, item->x, item->y, rect_w, rect_h, item->color);
+      break;
+    default:
+      draw_text(bb, item->x, item->y, item->text, item->color,
+                BENCH_TEXT_SCALE);
+      break;
+    }
+  }
+}
+
+int main(int argc, char **argv) {
+  int frames = argc > 1 ? atoi(argv[1]) : 10;
+  uint32_t seed = argc > 2 ? (uint32_t)strtoul(argv[2], NULL, 10) : 1;
+  if (seed == 0)
+    seed = 1; /* xorshift's only fixed point */
+  if (frames <= 0)
+    frames = 10;
+
+  int size_count = (int)(sizeof(bench_sizes) / sizeof(bench_sizes[0]));
+  int max_width = bench_sizes[size_count - 1][0];
+  int max_height = bench_sizes[size_count - 1][1];
+  /* Smallest item is a 4-glyph HUD string: 560 px at scale 2 */
+  int max_items = max_width * max_height * 4 / 500;
+
+  BenchItem *items = malloc(sizeof(BenchItem) * (size_t)max_items);
+  uint32_t *pixels = malloc(sizeof(uint32_t) * max_width * max_height);
+  if (!items || !pixels) {
+    fprintf(stderr, "out of memory\n");
+    return 1;
+  }
+
+  printf("%d frames per case (fastest kept), seed %u\n\n", frames, seed);
+  printf("%-10s %8s %-12s %12s %10s %10s\n", "size", "overdraw", "primitive",
+         "Mpix/s", "cycles/px", "checksum");
+
+  int overdraw_count =
+      (int)(sizeof(bench_overdraws) / sizeof(bench_overdraws[0]));
+  for (int s = 0; s < size_count; s++) {
+    Backbuffer bb = {
+        .pixels = pixels,
+        .width = bench_sizes[s][0],
+        .height = bench_sizes[s][1],
+        .pitch = bench_sizes[s][0] * 4,
+        .bytes_per_pixel = 4,
+    };
+    char size_name[16];
+    snprintf(size_name, sizeof(size_name), "%dx%d", bb.width, bb.height);
+
+    for (int o = 0; o < overdraw_count; o++) {
+      for (int prim = 0; prim < BENCH_PRIM_COUNT; prim++) {
+        long long scene_pixels = 0;
+        int count = bench_build_scene((BenchPrimitive)prim, bb.width,
+                                      bb.height, bench_overdraws[o], seed,
+                                      items, max_items, &scene_pixels);
+
+        double best_seconds = 1e30;
+        uint64_t best_cycles = UINT64_MAX;
+        uint32_t checksum = 0;
+        for (int frame = 0; frame < frames; frame++) {
+          /* Same starting frame every time, so the checksum is stable */
+          memset(pixels, 0x20, (size_t)bb.pitch * bb.height);
+
+          double start = bench_seconds();
+          uint64_t start_cycles = bench_cycles();
+          bench_draw((BenchPrimitive)prim, &bb, items, count);
+          uint64_t cycles = bench_cycles() - start_cycles;
+          double seconds = bench_seconds() - start;
+
+          if (seconds < best_seconds)
+            best_seconds = seconds;
+          if (cycles < best_cycles)
+            best_cycles = cycles;
+          if (frame == 0)
+            checksum = bench_checksum(&bb);
+        }
+        if (best_seconds <= 0.0)
+          best_seconds = 1e-9;
+
+        printf("%-10s %7dx %-12s %12.1f %10.2f %10u\n", size_name,
+               bench_overdraws[o], bench_prim_names[prim],
+               (double)scene_pixels / best_seconds * 1e-6,
+               (double)best_cycles / (double)scene_pixels, checksum);
+      }
+    }
+  }
+
+  free(pixels);
+  free(items);
+  return 0;
+}
@@ -0,0 +1,292 @@
+#include "solver.h"
+
+#include <string.h>
+
+/* ═══════════════════════════════════════════════════════════════════════════
+ * Heuristic
+ * ═══════════════════════════════════════════════════════════════════════════
+ *
+ * Weights from the well-known genetic-search tuning of the four-term
+ * linear evaluator (height, holes, bumpiness, lines).  Good enough to
+ * play for tens of thousands of pieces with the preview enabled.
+ */
+
+const TetrisHeuristicWeights TETRIS_DEFAULT_WEIGHTS = {
+    .aggregate_height = -0.510066f,
+    .holes = -0.35663f,
+    .bumpiness = -0.184483f,
+    .lines_cleared = 0.760666f,
+};
+
+float tetris_heuristic_weighted(const TetrisBoardFeatures *features,
+                                const void *user) {
+  const TetrisHeuristicWeights *w = (const TetrisHeuristicWeights *)user;
+  return w->aggregate_height * (float)features->aggregate_height +
+         w->holes * (float)features->holes +
+         w->bumpiness * (float)features->bumpiness +
+         w->lines_cleared * (float)features->lines_cleared;
+}
+
+TetrisSolver tetris_solver_default(void) {
+  return (TetrisSolver){
+      .heuristic = tetris_heuristic_weighted,
+      .heuristic_data = &TETRIS_DEFAULT_WEIGHTS,
+      .use_preview = 1,
+  };
+}
+
+/* ═══════════════════════════════════════════════════════════════════════════
+ * Board Operations
+ * ═══════════════════════════════════════════════════════════════════════════
+ *
+ * Each operation is a size-generic body taking the field size as
+ * arguments.  The public functions pick between two copies of it: one
+ * with FIELD_WIDTH/FIELD_HEIGHT as constants, where the row masks, floor
+ * row and loop bounds fold away, and one that reads them at runtime.
+ */
+
+/* Playable columns of a row (no walls) and playable rows (no floor) */
+#define TETRIS_ROW_INTERIOR(width)                                             \
+  ((uint16_t)(FIELD_ROW_FULL(width) & ~FIELD_ROW_WALLS(width)))
+#define TETRIS_FLOOR_Y(height) ((height) - 1)
+
+static TETRIS_FORCE_INLINE void board_clear_sized(uint16_t *rows, int width,
+                                                   int height) {
+  for (int y = 0; y < TETRIS_FLOOR_Y(height); y++)
+    rows[y] = FIELD_ROW_WALLS(width);
+  rows[TETRIS_FLOOR_Y(height)] = FIELD_ROW_FULL(width);
+}
+
+void tetris_board_clear(uint16_t *rows, int width, int height) {
+  board_clear_sized(rows, width, height);
+}
+
+static TETRIS_FORCE_INLINE int
+board_place_sized(uint16_t *rows, int width, int height,
+                  const TetrisPlacement *placement) {
+  const uint16_t *masks =
+      TETROMINO_ROW_MASKS[placement->piece][placement->rotation & 3];
+  for (int py = 0; py < TETROMINO_LAYER_COUNT; py++) {
+    int y = placement->y + py;
+    if (y >= 0 && y < height)
+      rows[y] |= tetromino_row_at(masks[py], placement->x, width);
+  }
+
+  /* Collapse in one pass: copy kept rows down from the floor up, then
+     refill the top with empty rows.  Only the piece's rows can be full. */
+  uint16_t full = FIELD_ROW_FULL(width);
+  int y_top = placement->y < 0 ? 0 : placement->y;
+  int y_bottom = placement->y + TETROMINO_LAYER_COUNT - 1;
+  if (y_bottom > TETRIS_FLOOR_Y(height) - 1)
+    y_bottom = TETRIS_FLOOR_Y(height) - 1;
+
+  int lines = 0;
+  for (int y = y_top; y <= y_bottom; y++)
+    lines += rows[y] == full;
+  if (lines == 0)
+    return 0;
+
+  int write = y_bottom;
+  for (int read = y_bottom; read >= 0; read--) {
+    if (rows[read] != full)
+      rows[write--] = rows[read];
+  }
+  while (write >= 0)
+    rows[write--] = FIELD_ROW_WALLS(width);
+  return lines;
+}
+
+int tetris_board_place(uint16_t *rows, int width, int height,
+                       const TetrisPlacement *placement) {
+  if (tetris_field_is_standard(width, height))
+    return board_place_sized(rows, FIELD_WIDTH, FIELD_HEIGHT, placement);
+  return board_place_sized(rows, width, height, placement);
+}
+
+static TETRIS_FORCE_INLINE void
+board_features_sized(const uint16_t *rows, int width, int height,
+                     int lines_cleared, TetrisBoardFeatures *out) {
+  int heights[FIELD_MAX_WIDTH] = {0};
+  TetrisBoardFeatures f = {.lines_cleared = lines_cleared};
+
+  /* Top-down sweep: `covered` is every column that already has a block
+     above this row, so an empty covered cell is a hole and a block in
+     an uncovered column is that column's top. */
+  uint16_t covered = 0;
+  for (int y = 0; y < TETRIS_FLOOR_Y(height); y++) {
+    uint16_t row = rows[y] & TETRIS_ROW_INTERIOR(width);
+    uint16_t tops = row & (uint16_t)~covered;
+    int column_height = TETRIS_FLOOR_Y(height) - y;
+    if (tops && f.max_height == 0)
+      f.max_height = column_height;
+    while (tops) {
+      heights[__builtin_ctz(tops)] = column_height;
+      f.aggregate_height += column_height;
+      tops &= tops - 1;
+    }
+    f.holes += __builtin_popcount(covered & (uint16_t)~row);
+    covered |= row;
+  }
+
+  for (int x = 1; x < width - 2; x++) {
+    int d = heights[x] - heights[x + 1];
+    f.bumpiness += d < 0 ? -d : d;
+  }
+  *out = f;
+}
+
+void tetris_board_features(const uint16_t *rows, int width, int height,
+                           int lines_cleared, TetrisBoardFeatures *out) {
+  if (tetris_field_is_standard(width, height))
+    board_features_sized(rows, FIELD_WIDTH, FIELD_HEIGHT, lines_cleared, out);
+  else
+    board_features_sized(rows, width, height, lines_cleared, out);
+}
+
+/* ═══════════════════════════════════════════════════════════════════════════
+ * Placement Enumeration
+ * ═══════════════════════════════════════════════════════════════════════════
+ */
+
+/* A rotation's shape moved to the top-left of its box, packed 4 bits per
+   row.  Equal keys ⇒ the rotations only differ by an offset, so they
+   reach exactly the same boards. */
+static uint16_t tetromino_shape_key(int piece, int rotation) {
+  const uint16_t *masks = TETROMINO_ROW_MASKS[piece][rotation];
+  int top = 0;
+  while (masks[top] == 0)
+    top++;
+  uint16_t cols = masks[0] | masks[1] | masks[2] | masks[3];
+  int left = __builtin_ctz(cols);
+
+  uint16_t key = 0;
+  for (int py = top; py < TETROMINO_LAYER_COUNT; py++)
+    key |= (uint16_t)((masks[py] >> left) << ((py - top) * 4));
+  return key;
+}
+
+static TETRIS_FORCE_INLINE int
+solver_placements_sized(const uint16_t *rows, int width, int height,
+                        int piece, TetrisPlacement out[TETRIS_MAX_PLACEMENTS]) {
+  uint16_t keys[TETROMINO_ROTATION_COUNT];
+  int count = 0;
+
+  for (int r = 0; r < TETROMINO_ROTATION_COUNT; r++) {
+    keys[r] = tetromino_shape_key(piece, r);
+    int duplicate = 0;
+    for (int prev = 0; prev < r; prev++)
+      duplicate |= keys[prev] == keys[r];
+    if (duplicate)
+      continue;
+
+    /* tetromino_rows_fit drops columns outside the field, so keep the
+       whole shape inside it: x + left >= 0 and x + right < width. */
+    const uint16_t *masks = TETROMINO_ROW_MASKS[piece][r];
+    unsigned cols = masks[0] | masks[1] | masks[2] | masks[3];
+    int left = __builtin_ctz(cols);
+    int right = 31 - __builtin_clz(cols);
+
+    for (int x = -left; x < width - right; x++) {
+      /* Spawn row first: a column the piece can't appear in is
+         unreachable from the top. */
+      if (!tetromino_rows_fit(rows, width, height, piece, r, x, 0))
+        continue;
+      int y = 0;
+      while (tetromino_rows_fit(rows, width, height, piece, r, x, y + 1))
+        y++;
+      out[count++] = (TetrisPlacement){piece, r, x, y};
+    }
+  }
+  return count;
+}
+
+int tetris_solver_placements(const uint16_t *rows, int width, int height,
+                             int piece,
+                             TetrisPlacement out[TETRIS_MAX_PLACEMENTS]) {
+  if (tetris_field_is_standard(width, height))
+    return solver_placements_sized(rows, FIELD_WIDTH, FIELD_HEIGHT, piece,
+                                   out);
+  return solver_placements_sized(rows, width, height, piece, out);
+}
+
+/* ═══════════════════════════════════════════════════════════════════════════
+ * Search
+ * ═══════════════════════════════════════════════════════════════════════════
+ */
+
+static TETRIS_FORCE_INLINE float
+solver_score_sized(TetrisSolver *solver, const uint16_t *rows, int width,
+                   int height, int lines_cleared) {
+  TetrisBoardFeatures features;
+  board_features_sized(rows, width, height, lines_cleared, &features);
+  solver->placements_evaluated++;
+  return solver->heuristic(&features, solver->heuristic_data);
+}
+
+/* The whole search inlines into one copy per size, boards included */
+static TETRIS_FORCE_INLINE int
+solver_best_sized(TetrisSolver *solver, const uint16_t *rows, int width,
+                  int height, int piece, int next_piece,
+                  TetrisPlacement *out) {
+  TetrisPlacement first[TETRIS_MAX_PLACEMENTS];
+  TetrisPlacement second[TETRIS_MAX_PLACEMENTS];
+  size_t board_bytes = sizeof(uint16_t) * (size_t)height;
+  int first_count =
+      solver_placements_sized(rows, width, height, piece, first);
+  int best = -1;
+  float best_score = 0.0f;
+
+  for (int i = 0; i < first_count; i++) {
+    uint16_t board[FIELD_MAX_HEIGHT];
+    memcpy(board, rows, board_bytes);
+    int lines = board_place_sized(board, width, height, &first[i]);
+
+    float score;
+    if (!solver->use_preview) {
+      score = solver_score_sized(solver, board, width, height, lines);
+    } else {
+      /* A move that leaves the preview piece nowhere to go is a loss —
+         rank it below every move that survives, but still keep one. */
+      int second_count =
+          solver_placements_sized(board, width, height, next_piece, second);
+      score = second_count ? -1e30f : -1e38f;
+      for (int j = 0; j < second_count; j++) {
+        uint16_t after[FIELD_MAX_HEIGHT];
+        memcpy(after, board, board_bytes);
+        int more = board_place_sized(after, width, height, &second[j]);
+        float s =
+            solver_score_sized(solver, after, width, height, lines + more);
+        if (s > score)
+          score = s;
+      }
+    }
+
+    if (best < 0 || score > best_score) {
+      best = i;
+      best_score = score;
+    }
+  }
+
+  if (best < 0)
+    return 0;
+  *out = first[best];
+  return 1;
+}
+
+int tetris_solver_best(TetrisSolver *solver, const uint16_t *rows, int width,
+                       int height, int piece, int next_piece,
+                       TetrisPlacement *out) {
+  if (tetris_field_is_standard(width, height))
+    return solver_best_sized(solver, rows, FIELD_WIDTH, FIELD_HEIGHT, piece,
+                             next_piece, out);
+  return solver_best_sized(solver, rows, width, height, piece, next_piece,
+                           out);
+}
+
+int tetris_solver_best_for_state(TetrisSolver *solver,
+                                 const GameState *state,
+                                 TetrisPlacement *out) {
+  return tetris_solver_best(solver, state->field_rows, state->field_width,
+                            state->field_height, state->current_piece.index,
+                            state->current_piece.next_index, out);
+}
@@ -0,0 +1,114 @@
+#ifndef SOLVER_H
+#define SOLVER_H
+
+#include "game.h"
+
+#include <stdint.h>
+
+/* ═══════════════════════════════════════════════════════════════════════════
+ * Placement Solver
+ * ═══════════════════════════════════════════════════════════════════════════
+ *
+ * Headless bot for the bitboard field (GameState.field_rows).  A
+ * placement is a rotation + column, hard-dropped from the spawn row.
+ * The solver tries every placement of the current piece, and for each
+ * one every placement of the preview piece, then keeps the first move
+ * of the best-scoring pair.
+ *
+ * Nothing here touches field[], rendering or audio: a board is just
+ * `uint16_t rows[height]` of a width × height field (walls and floor
+ * included, see FIELD_MIN/MAX_*), copied by value while searching.  The
+ * standard FIELD_WIDTH × FIELD_HEIGHT field runs a copy of the search
+ * compiled for that size; other sizes give the same answers, slower.
+ *
+ *   TetrisSolver solver = tetris_solver_default();
+ *   TetrisPlacement move;
+ *   if (tetris_solver_best(&solver, rows, width, height, piece,
+ *                          next_piece, &move))
+ *     tetris_board_place(rows, width, height, &move);
+ */
+
+/* Leftmost column a 4×4 piece box can start at (its left columns may be
+   empty), and how many placements one piece can have at most. */
+#define TETRIS_PLACEMENT_X_MIN (1 - TETROMINO_LAYER_COUNT)
+#define TETRIS_PLACEMENT_X_COUNT (FIELD_MAX_WIDTH - TETRIS_PLACEMENT_X_MIN)
+#define TETRIS_MAX_PLACEMENTS                                                  \
+  (TETROMINO_ROTATION_COUNT * TETRIS_PLACEMENT_X_COUNT)
+
+typedef struct {
+  int piece;    /* TETROMINO_BY_IDX */
+  int rotation; /* TETROMINO_R_DIR */
+  int x;        /* piece box column */
+  int y;        /* landing row (after hard drop) */
+} TetrisPlacement;
+
+/* What a heuristic gets to look at after a placement.  Heights count
+   from the floor; only the playable columns/rows are measured. */
+typedef struct {
+  int aggregate_height; /* sum of column heights            */
+  int max_height;       /* tallest column                   */
+  int holes;            /* empty cells with a block above   */
+  int bumpiness;        /* sum of |height[x] - height[x+1]| */
+  int lines_cleared;    /* lines cleared on the way here    */
+} TetrisBoardFeatures;
+
+/* Higher is better.  `user` is TetrisSolver.heuristic_data. */
+typedef float TetrisHeuristicFn(const TetrisBoardFeatures *features,
+                                const void *user);
+
+/* The classic four-term linear heuristic. */
+typedef struct {
+  float aggregate_height;
+  float holes;
+  float bumpiness;
+  float lines_cleared;
+} TetrisHeuristicWeights;
+
+extern const TetrisHeuristicWeights TETRIS_DEFAULT_WEIGHTS;
+
+/* TetrisHeuristicFn; `user` is a const TetrisHeuristicWeights*. */
+float tetris_heuristic_weighted(const TetrisBoardFeatures *features,
+                                const void *user);
+
+typedef struct {
+  TetrisHeuristicFn *heuristic;
+  const void *heuristic_data;
+  int use_preview; /* 0 = one-ply search (current piece only) */
+
+  /* Stats: boards scored by `heuristic` since the last reset */
+  uint64_t placements_evaluated;
+} TetrisSolver;
+
+/* Weighted heuristic with TETRIS_DEFAULT_WEIGHTS, preview enabled. */
+TetrisSolver tetris_solver_default(void);
+
+/* Empty field: side walls on every row, full floor row. */
+void tetris_board_clear(uint16_t *rows, int width, int height);
+
+/* Every distinct hard-drop placement of `piece` that fits at the spawn
+   row.  Rotations with the same shape (O, and half of I/S/Z) are only
+   listed once.  Returns the count written to `out`. */
+int tetris_solver_placements(const uint16_t *rows, int width, int height,
+                             int piece,
+                             TetrisPlacement out[TETRIS_MAX_PLACEMENTS]);
+
+/* Lock `placement` into `rows` and collapse completed lines.
+   Returns the number of lines cleared. */
+int tetris_board_place(uint16_t *rows, int width, int height,
+                       const TetrisPlacement *placement);
+
+void tetris_board_features(const uint16_t *rows, int width, int height,
+                           int lines_cleared, TetrisBoardFeatures *out);
+
+/* Best placement for `piece` (looking at `next_piece` when
+   solver->use_preview).  Returns 0 when the piece has no placement. */
+int tetris_solver_best(TetrisSolver *solver, const uint16_t *rows, int width,
+                       int height, int piece, int next_piece,
+                       TetrisPlacement *out);
+
+/* tetris_solver_best for the live game's current and preview piece. */
+int tetris_solver_best_for_state(TetrisSolver *solver,
+                                 const GameState *state,
+                                 TetrisPlacement *out);
+
+#endif /* SOLVER_H */
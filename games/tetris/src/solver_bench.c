@@ -0,0 +1,98 @@
+/* ═══════════════════════════════════════════════════════════════════════════
+ * Solver Benchmark — headless self-play
+ * ═══════════════════════════════════════════════════════════════════════════
+ *
+ * Build & run:  ./build-dev.sh --backend=bench -r
+ *               ./build/solver-bench [games] [max_pieces_per_game] [seed]
+ *                                    [width height]
+ *
+ * Plays `games` games with the default solver (a game ends on top-out or
+ * after `max_pieces_per_game`, since a good bot rarely tops out) and
+ * prints placements/sec and games/sec.  Same seed ⇒ same games, so the
+ * pieces/lines totals double as a correctness check between runs.  The
+ * field defaults to FIELD_WIDTH × FIELD_HEIGHT, which runs the solver's
+ * size-specialized copy; other sizes run the generic one.
+ */
+
+#include "solver.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+static uint32_t bench_rand(uint32_t *state) {
+  /* xorshift32 — the game's rand() is not reproducible across libcs */
+  uint32_t x = *state;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  return *state = x;
+}
+
+static double bench_seconds(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+int main(int argc, char **argv) {
+  int games = argc > 1 ? atoi(argv[1]) : 20;
+  int max_pieces = argc > 2 ? atoi(argv[2]) : 2000;
+  uint32_t seed = argc > 3 ? (uint32_t)strtoul(argv[3], NULL, 10) : 1;
+  if (seed == 0)
+    seed = 1; /* xorshift's only fixed point */
+  int width = argc > 5 ? atoi(argv[4]) : FIELD_WIDTH;
+  int height = argc > 5 ? atoi(argv[5]) : FIELD_HEIGHT;
+  if (tetris_field_size(width, height) == 0) {
+    fprintf(stderr, "Field %dx%d outside %dx%d..%dx%d\n", width, height,
+            FIELD_MIN_WIDTH, FIELD_MIN_HEIGHT, FIELD_MAX_WIDTH,
+            FIELD_MAX_HEIGHT);
+    return 1;
+  }
+
+  TetrisSolver solver = tetris_solver_default();
+  const int spawn_x = width / 2 - TETROMINO_LAYER_COUNT / 2;
+  uint64_t total_pieces = 0, total_lines = 0;
+  int topped_out = 0;
+
+  double start = bench_seconds();
+  for (int g = 0; g < games; g++) {
+    uint16_t rows[FIELD_MAX_HEIGHT];
+    tetris_board_clear(rows, width, height);
+    int piece = (int)(bench_rand(&seed) % TETROMINOS_COUNT);
+    int next = (int)(bench_rand(&seed) % TETROMINOS_COUNT);
+
+    int pieces = 0;
+    for (; pieces < max_pieces; pieces++) {
+      /* Same game-over rule as game_update: the spawn must fit */
+      TetrisPlacement move;
+      if (!tetromino_rows_fit(rows, width, height, piece, TETROMINO_R_0,
+                              spawn_x, 0) ||
+          !tetris_solver_best(&solver, rows, width, height, piece, next,
+                              &move)) {
+        topped_out++;
+        break;
+      }
+      total_lines += (uint64_t)tetris_board_place(rows, width, height, &move);
+      piece = next;
+      next = (int)(bench_rand(&seed) % TETROMINOS_COUNT);
+    }
+    total_pieces += (uint64_t)pieces;
+  }
+  double elapsed = bench_seconds() - start;
+  if (elapsed <= 0.0)
+    elapsed = 1e-9;
+
+  printf("games           %d (%d topped out, %dx%d)\n", games, topped_out,
+         width, height);
+  printf("pieces          %llu\n", (unsigned long long)total_pieces);
+  printf("lines           %llu\n", (unsigned long long)total_lines);
+  printf("placements      %llu\n",
+         (unsigned long long)solver.placements_evaluated);
+  printf("elapsed         %.3f s\n", elapsed);
+  printf("placements/sec  %.0f\n",
+         (double)solver.placements_evaluated / elapsed);
+  printf("pieces/sec      %.0f\n", (double)total_pieces / elapsed);
+  printf("games/sec       %.2f\n", (double)games / elapsed);
+  return 0;
+}
@@ -37,18 +37,19 @@ typedef enum {
  * ═══════════════════════════════════════════════════════════════════════════
  * Represents one currently-playing sound effect.
  */
+/* Overridable so the audio bench can build with heavier voice loads */
+#ifndef MAX_SIMULTANEOUS_SOUNDS
 #define MAX_SIMULTANEOUS_SOUNDS 4
+#endif
 
 typedef struct {
   SOUND_ID sound_id;     /* Which sound is playing */
-  float phase;           /* Current phase for oscillator */
+  const float *samples;  /* Pre-rendered mono PCM (sound cache, audio.c) */
   int samples_remaining; /* How many samples left to play */
-  float volume;          /* 0.0 to 1.0 */
-  float frequency;       /* Hz (for procedural sounds) */
-  float frequency_slide; /* Hz per sample (for pitch bend) */
   int total_samples;
-  int fade_in_samples;
   float pan_position; // -1.0 (left) to 1.0 (right)
+  float left_gain;    /* From pan_position, once at play time */
+  float right_gain;
 } SoundInstance;
 
 /* ═══════════════════════════════════════════════════════════════════════════
@@ -109,9 +110,19 @@ typedef struct {
  * ═══════════════════════════════════════════════════════════════════════════
  */
 
-/* Convert MIDI note to frequency: A4 (69) = 440 Hz */
+/* 440 * 2^((n - 69) / 12) for n = 0..11; each octave up doubles it */
+static const float SEMITONE_HZ[12] = {
+    8.17579937f, 8.66195679f, 9.17702389f, 9.72271824f,
+    10.3008614f, 10.9133825f, 11.5623255f, 12.2498569f,
+    12.9782715f, 13.75f,      14.5676174f, 15.4338531f,
+};
+
+/* Convert MIDI note to frequency: A4 (69) = 440 Hz.
+ * A table read and a power-of-two multiply instead of powf. */
 static inline float midi_to_freq(int note) {
-  return 440.0f * powf(2.0f, (note - 69) / 12.0f);
+  if (note < 0 || note > 127)
+    return 0.0f;
+  return SEMITONE_HZ[note % 12] * (float)(1u << (note / 12));
 }
 
 /* Clamp sample to int16 range */
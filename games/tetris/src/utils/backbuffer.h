@@ -7,17 +7,80 @@
  * ═══════════════════════════════════════════════════════════════════════════
  */
 typedef struct {
-  uint32_t *pixels; /* RGBA pixel data (0xAARRGGBB format) */
+  uint32_t *pixels; /* GAME_RGBA-packed pixels, see below */
   int width;
   int height;
   int pitch; /* Bytes per row (usually width * 4) */
   int bytes_per_pixel;
+
+  /* Pixels game_render changed this frame, [x0, x1) × [y0, y1).  Empty
+   * (x1 <= x0) means the frame is identical to the last one and the
+   * platform can skip the upload. */
+  int dirty_x0, dirty_y0, dirty_x1, dirty_y1;
 } Backbuffer;
 
+static inline void backbuffer_clear_dirty(Backbuffer *bb) {
+  bb->dirty_x0 = bb->dirty_y0 = bb->dirty_x1 = bb->dirty_y1 = 0;
+}
+
+static inline int backbuffer_is_dirty(const Backbuffer *bb) {
+  return bb->dirty_x1 > bb->dirty_x0 && bb->dirty_y1 > bb->dirty_y0;
+}
+
+/* Grow the dirty rect to cover (x, y, w, h), clipped to the buffer. */
+static inline void backbuffer_mark_dirty(Backbuffer *bb, int x, int y, int w,
+                                         int h) {
+  int x0 = x < 0 ? 0 : x;
+  int y0 = y < 0 ? 0 : y;
+  int x1 = x + w > bb->width ? bb->width : x + w;
+  int y1 = y + h > bb->height ? bb->height : y + h;
+  if (x1 <= x0 || y1 <= y0)
+    return;
+  if (!backbuffer_is_dirty(bb)) {
+    bb->dirty_x0 = x0;
+    bb->dirty_y0 = y0;
+    bb->dirty_x1 = x1;
+    bb->dirty_y1 = y1;
+    return;
+  }
+  if (x0 < bb->dirty_x0)
+    bb->dirty_x0 = x0;
+  if (y0 < bb->dirty_y0)
+    bb->dirty_y0 = y0;
+  if (x1 > bb->dirty_x1)
+    bb->dirty_x1 = x1;
+  if (y1 > bb->dirty_y1)
+    bb->dirty_y1 = y1;
+}
+
+/* Pixel layout - chosen at compile time to match what the platform
+ * uploads, so neither we nor the driver ever swizzle:
+ *
+ *   X11 (desktop GL)  0xAARRGGBB = bytes B,G,R,A  -> GL_BGRA (default)
+ *   Raylib            0xAABBGGRR = bytes R,G,B,A  -> R8G8B8A8
+ *                     (build-dev.sh passes -DGAME_PIXEL_FORMAT_RGBA=1)
+ *
+ * Always pack with GAME_RGBA and unpack with GAME_COLOR_*; never shift by
+ * hand. */
+#if GAME_PIXEL_FORMAT_RGBA
+#define GAME_SHIFT_R 0
+#define GAME_SHIFT_B 16
+#else
+#define GAME_SHIFT_R 16
+#define GAME_SHIFT_B 0
+#endif
+#define GAME_SHIFT_G 8
+#define GAME_SHIFT_A 24
+
 /* Color helper - pack RGBA into uint32 */
 #define GAME_RGBA(r, g, b, a)                                                  \
-  (((uint32_t)(a) << 24) | ((uint32_t)(r) << 16) | ((uint32_t)(g) << 8) |      \
-   (uint32_t)(b))
+  (((uint32_t)(a) << GAME_SHIFT_A) | ((uint32_t)(r) << GAME_SHIFT_R) |         \
+   ((uint32_t)(g) << GAME_SHIFT_G) | ((uint32_t)(b) << GAME_SHIFT_B))
+
+#define GAME_COLOR_R(c) (((c) >> GAME_SHIFT_R) & 0xFF)
+#define GAME_COLOR_G(c) (((c) >> GAME_SHIFT_G) & 0xFF)
+#define GAME_COLOR_B(c) (((c) >> GAME_SHIFT_B) & 0xFF)
+#define GAME_COLOR_A(c) (((c) >> GAME_SHIFT_A) & 0xFF)
 
 #define GAME_RGB(r, g, b) GAME_RGBA(r, g, b, 255)
 
@@ -101,52 +101,223 @@ const FontSpecialChar FONT_SPECIAL[] = {
     {0, {0}}                                      /* Terminator */
 };
 
+/* ═══════════════════════════════════════════════════════════════════════════
+ * Glyph Cache
+ * ═══════════════════════════════════════════════════════════════════════════
+ *
+ * Built once, on the first draw. Every glyph is pre-split into solid
+ * rectangles (font units): horizontal runs of set bits, merged downwards
+ * while the run below is identical. 'H' becomes 5 rects instead of 17
+ * separate pixels:
+ *
+ *   #...#   ┐ two 1x3 rects
+ *   #...#   │
+ *   #...#   ┘
+ *   #####   ─ one 5x1 rect
+ *   #...#   ┐ two 1x3 rects
+ *   ...
+ *
+ * Rects scale linearly, so one cache serves every scale: each rect is a
+ * single clipped draw_rect() that fills whole rows.
+ * ═══════════════════════════════════════════════════════════════════════════
+ */
+
+#define FONT_GLYPH_WIDTH 5
+#define FONT_GLYPH_HEIGHT 7
+#define FONT_GLYPH_ADVANCE 6
+/* Worst case: 3 runs in each of the 7 rows */
+#define FONT_GLYPH_MAX_RECTS 21
+
+typedef struct {
+  uint16_t x; /* Font units; layouts go past one glyph */
+  uint8_t y, w, h;
+} FontRect;
+
+typedef struct {
+  const unsigned char *bitmap; /* NULL = unknown / space */
+  uint8_t rect_count;
+  FontRect rects[FONT_GLYPH_MAX_RECTS];
+} FontGlyph;
+
+static FontGlyph g_font_glyphs[128];
+static int g_font_glyphs_ready = 0;
+
+static int font_glyph_build_rects(const unsigned char *bitmap,
+                                  FontRect *rects) {
+  int count = 0;
+  for (int row = 0; row < FONT_GLYPH_HEIGHT; row++) {
+    int col = 0;
+    while (col < FONT_GLYPH_WIDTH) {
+      if (!(bitmap[row] & (0x10 >> col))) {
+        col++;
+        continue;
+      }
+      int start = col;
+      while (col < FONT_GLYPH_WIDTH && (bitmap[row] & (0x10 >> col))) {
+        col++;
+      }
+
+      /* Extend the rect ending right above, if it's the same run */
+      int merged = 0;
+      for (int i = 0; i < count; i++) {
+        if (rects[i].x == start && rects[i].w == col - start &&
+            rects[i].y + rects[i].h == row) {
+          rects[i].h++;
+          merged = 1;
+          break;
+        }
+      }
+      if (!merged) {
+        rects[count++] =
+            (FontRect){(uint16_t)start, (uint8_t)row, (uint8_t)(col - start),
+                       1};
+      }
+    }
+  }
+  return count;
+}
+
+static void font_glyphs_init(void) {
+  for (int c = 0; c < 128; c++) {
+    const unsigned char *bitmap = NULL;
+    if (c >= '0' && c <= '9') {
+      bitmap = FONT_DIGITS[c - '0'];
+    } else if (c >= 'A' && c <= 'Z') {
+      bitmap = FONT_LETTERS[c - 'A'];
+    } else if (c >= 'a' && c <= 'z') {
+      bitmap = FONT_LETTERS[c - 'a']; /* Lowercase maps to uppercase */
+    } else if (c != ' ') {
+      for (int i = 0; FONT_SPECIAL[i].character != 0; i++) {
+        if (FONT_SPECIAL[i].character == c) {
+          bitmap = FONT_SPECIAL[i].bitmap;
+          break;
+        }
+      }
+    }
+
+    FontGlyph *glyph = &g_font_glyphs[c];
+    glyph->bitmap = bitmap;
+    glyph->rect_count =
+        bitmap ? (uint8_t)font_glyph_build_rects(bitmap, glyph->rects) : 0;
+  }
+  g_font_glyphs_ready = 1;
+}
+
+static const FontGlyph *font_glyph(char c) {
+  if (!g_font_glyphs_ready) {
+    font_glyphs_init();
+  }
+  unsigned char index = (unsigned char)c;
+  return index < 128 ? &g_font_glyphs[index] : NULL;
+}
+
 /* Helper function to find special character bitmap */
 const unsigned char *find_special_char(char c) {
-  for (int i = 0; FONT_SPECIAL[i].character != 0; i++) {
-    if (FONT_SPECIAL[i].character == c) {
-      return FONT_SPECIAL[i].bitmap;
-    }
+  const FontGlyph *glyph = font_glyph(c);
+  return glyph ? glyph->bitmap : NULL;
+}
+
+static void draw_font_rects(Backbuffer *bb, int x, int y,
+                            const FontRect *rects, int count, uint32_t color,
+                            int scale) {
+  for (int i = 0; i < count; i++) {
+    draw_rect(bb, x + rects[i].x * scale, y + rects[i].y * scale,
+              rects[i].w * scale, rects[i].h * scale, color);
   }
-  return NULL;
 }
 
 void draw_char(Backbuffer *bb, int x, int y, char c, uint32_t color,
                int scale) {
-  const unsigned char *bitmap = NULL;
-
-  if (c >= '0' && c <= '9') {
-    bitmap = FONT_DIGITS[c - '0'];
-  } else if (c >= 'A' && c <= 'Z') {
-    bitmap = FONT_LETTERS[c - 'A'];
-  } else if (c >= 'a' && c <= 'z') {
-    bitmap = FONT_LETTERS[c - 'a']; /* Lowercase maps to uppercase */
-  } else if (c == ' ') {
-    return; /* Space - just advance cursor, draw nothing */
-  } else {
-    /* Try special characters */
-    bitmap = find_special_char(c);
-    if (!bitmap) {
-      return; /* Unknown character - skip */
+  const FontGlyph *glyph = font_glyph(c);
+  if (glyph) {
+    draw_font_rects(bb, x, y, glyph->rects, glyph->rect_count, color, scale);
+  }
+}
+
+/* ═══════════════════════════════════════════════════════════════════════════
+ * Text Layout Cache
+ * ═══════════════════════════════════════════════════════════════════════════
+ *
+ * HUD strings ("SCORE", "PAUSED", "LEVEL 3") are the same frame after
+ * frame. Their whole rect list is cached, keyed by the string's FNV-1a
+ * hash (direct-mapped; the text is compared too, so a collision just
+ * re-lays out). A cached string costs one hash and its rect fills: no
+ * per-character lookups.
+ *
+ * Strings longer than TEXT_LAYOUT_MAX_LENGTH, or with too many rects,
+ * bypass the cache and draw glyph by glyph.
+ * ═══════════════════════════════════════════════════════════════════════════
+ */
+
+#define TEXT_LAYOUT_CACHE_SIZE 32 /* Power of two */
+#define TEXT_LAYOUT_MAX_LENGTH 47
+#define TEXT_LAYOUT_MAX_RECTS 256
+
+typedef struct {
+  uint32_t hash;
+  uint16_t rect_count;
+  char text[TEXT_LAYOUT_MAX_LENGTH + 1]; /* "" = empty slot */
+  FontRect rects[TEXT_LAYOUT_MAX_RECTS];
+} TextLayout;
+
+static TextLayout g_text_layouts[TEXT_LAYOUT_CACHE_SIZE];
+
+static const TextLayout *text_layout_get(const char *text) {
+  uint32_t hash = 2166136261u;
+  size_t length = 0;
+  for (const char *c = text; *c; c++, length++) {
+    if (length == TEXT_LAYOUT_MAX_LENGTH) {
+      return NULL;
     }
+    hash = (hash ^ (unsigned char)*c) * 16777619u;
   }
 
-  /* Draw the 5x7 bitmap */
-  for (int row = 0; row < 7; row++) {
-    for (int col = 0; col < 5; col++) {
-      if (bitmap[row] & (0x10 >> col)) {
-        draw_rect(bb, x + col * scale, y + row * scale, scale, scale, color);
-      }
+  TextLayout *layout = &g_text_layouts[hash & (TEXT_LAYOUT_CACHE_SIZE - 1)];
+  if (layout->hash == hash && layout->text[0] &&
+      strcmp(layout->text, text) == 0) {
+    return layout;
+  }
+
+  int count = 0;
+  for (size_t i = 0; i < length; i++) {
+    const FontGlyph *glyph = font_glyph(text[i]);
+    if (!glyph) {
+      continue;
+    }
+    if (count + glyph->rect_count > TEXT_LAYOUT_MAX_RECTS) {
+      layout->text[0] = '\0';
+      return NULL;
+    }
+    for (int r = 0; r < glyph->rect_count; r++) {
+      FontRect rect = glyph->rects[r];
+      rect.x = (uint16_t)(rect.x + i * FONT_GLYPH_ADVANCE);
+      layout->rects[count++] = rect;
     }
   }
+
+  layout->hash = hash;
+  layout->rect_count = (uint16_t)count;
+  memcpy(layout->text, text, length + 1);
+  return layout;
 }
 
 void draw_text(Backbuffer *bb, int x, int y, const char *text, uint32_t color,
                int scale) {
+  /* Whole line off-screen vertically: nothing to do */
+  if (y >= bb->height || y + FONT_GLYPH_HEIGHT * scale <= 0) {
+    return;
+  }
+
+  const TextLayout *layout = text_layout_get(text);
+  if (layout) {
+    draw_font_rects(bb, x, y, layout->rects, layout->rect_count, color, scale);
+    return;
+  }
+
   int cursor_x = x;
   while (*text) {
     draw_char(bb, cursor_x, y, *text, color, scale);
-    cursor_x += 6 * scale;
+    cursor_x += FONT_GLYPH_ADVANCE * scale;
     text++;
   }
-}
\ No newline at end of file
+}